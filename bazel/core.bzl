@@ -82,6 +82,7 @@ MLN_GENERATED_OPENGL_SHADER_HEADERS = [
     "include/mbgl/shaders/gl/background.hpp",
     "include/mbgl/shaders/gl/background_pattern.hpp",
     "include/mbgl/shaders/gl/circle.hpp",
+    "include/mbgl/shaders/gl/circle_instanced.hpp",
     "include/mbgl/shaders/gl/clipping_mask.hpp",
     "include/mbgl/shaders/gl/collision_box.hpp",
     "include/mbgl/shaders/gl/collision_circle.hpp",
@@ -118,6 +119,7 @@ MLN_GENERATED_OPENGL_SHADER_HEADERS = [
 
 MLN_CORE_SOURCE = [
     "src/mbgl/actor/mailbox.cpp",
+    "src/mbgl/actor/message.cpp",
     "src/mbgl/actor/scheduler.cpp",
     "src/mbgl/algorithm/update_renderables.hpp",
     "src/mbgl/algorithm/update_tile_masks.hpp",
@@ -146,6 +148,7 @@ MLN_CORE_SOURCE = [
     "src/mbgl/geometry/line_atlas.cpp",
     "src/mbgl/geometry/line_atlas.hpp",
     "src/mbgl/gfx/attribute.cpp",
+    "src/mbgl/gfx/context.cpp",
     "src/mbgl/gfx/attribute.hpp",
     "src/mbgl/gfx/cull_face_mode.hpp",
     "src/mbgl/gfx/fill_generator.cpp",
@@ -153,6 +156,10 @@ MLN_CORE_SOURCE = [
     "src/mbgl/gfx/index_vector.hpp",
     "src/mbgl/gfx/offscreen_texture.hpp",
     "src/mbgl/gfx/polyline_generator.cpp",
+    "src/mbgl/gfx/polyline_segments.cpp",
+    "src/mbgl/gfx/polyline_segments.hpp",
+    "src/mbgl/gfx/triangulation_cache.cpp",
+    "src/mbgl/gfx/triangulation_cache.hpp",
     "src/mbgl/gfx/render_pass.hpp",
     "src/mbgl/gfx/renderer_backend.cpp",
     "src/mbgl/gfx/rendering_stats.cpp",
@@ -226,6 +233,8 @@ MLN_CORE_SOURCE = [
     "src/mbgl/renderer/cross_faded_property_evaluator.cpp",
     "src/mbgl/renderer/cross_faded_property_evaluator.hpp",
     "src/mbgl/renderer/data_driven_property_evaluator.hpp",
+    "src/mbgl/renderer/feature_vertex_range_map.cpp",
+    "src/mbgl/renderer/feature_vertex_range_map.hpp",
     "src/mbgl/renderer/group_by_layout.cpp",
     "src/mbgl/renderer/group_by_layout.hpp",
     "src/mbgl/renderer/image_manager.cpp",
@@ -282,7 +291,10 @@ MLN_CORE_SOURCE = [
     "src/mbgl/renderer/renderer.cpp",
     "src/mbgl/renderer/renderer_impl.cpp",
     "src/mbgl/renderer/renderer_impl.hpp",
+    "src/mbgl/renderer/renderer_resource_group.cpp",
     "src/mbgl/renderer/renderer_state.cpp",
+    "src/mbgl/renderer/sources/image_pyramid.cpp",
+    "src/mbgl/renderer/sources/image_pyramid.hpp",
     "src/mbgl/renderer/sources/render_custom_geometry_source.cpp",
     "src/mbgl/renderer/sources/render_custom_geometry_source.hpp",
     "src/mbgl/renderer/sources/render_geojson_source.cpp",
@@ -322,6 +334,7 @@ MLN_CORE_SOURCE = [
     "src/mbgl/storage/asset_file_source.hpp",
     "src/mbgl/storage/mbtiles_file_source.hpp",
     "src/mbgl/storage/file_source_manager.cpp",
+    "src/mbgl/storage/file_source_metrics.cpp",
     "src/mbgl/storage/http_file_source.hpp",
     "src/mbgl/storage/local_file_source.hpp",
     "src/mbgl/storage/main_resource_loader.hpp",
@@ -360,6 +373,7 @@ MLN_CORE_SOURCE = [
     "src/mbgl/style/expression/assertion.cpp",
     "src/mbgl/style/expression/at.cpp",
     "src/mbgl/style/expression/boolean_operator.cpp",
+    "src/mbgl/style/expression/bytecode.cpp",
     "src/mbgl/style/expression/case.cpp",
     "src/mbgl/style/expression/check_subtype.cpp",
     "src/mbgl/style/expression/coalesce.cpp",
@@ -395,6 +409,9 @@ MLN_CORE_SOURCE = [
     "src/mbgl/style/expression/util.hpp",
     "src/mbgl/style/expression/value.cpp",
     "src/mbgl/style/expression/within.cpp",
+    "src/mbgl/style/batch_filter.cpp",
+    "src/mbgl/style/batch_filter.hpp",
+    "src/mbgl/style/evaluated_layout_cache.hpp",
     "src/mbgl/style/filter.cpp",
     "src/mbgl/style/sprite.cpp",
     "src/mbgl/style/image.cpp",
@@ -441,6 +458,8 @@ MLN_CORE_SOURCE = [
     "src/mbgl/style/properties.hpp",
     "src/mbgl/style/property_expression.cpp",
     "src/mbgl/style/rapidjson_conversion.hpp",
+    "src/mbgl/style/resource_prefetcher.cpp",
+    "src/mbgl/style/resource_prefetcher.hpp",
     "src/mbgl/style/source.cpp",
     "src/mbgl/style/source_impl.cpp",
     "src/mbgl/style/source_impl.hpp",
@@ -482,6 +501,7 @@ MLN_CORE_SOURCE = [
     "src/mbgl/text/glyph_manager_observer.hpp",
     "src/mbgl/text/glyph_pbf.cpp",
     "src/mbgl/text/glyph_pbf.hpp",
+    "src/mbgl/text/glyph_store.cpp",
     "src/mbgl/text/language_tag.cpp",
     "src/mbgl/text/language_tag.hpp",
     "src/mbgl/text/local_glyph_rasterizer.hpp",
@@ -504,6 +524,8 @@ MLN_CORE_SOURCE = [
     "src/mbgl/tile/geometry_tile.hpp",
     "src/mbgl/tile/geometry_tile_data.cpp",
     "src/mbgl/tile/geometry_tile_data.hpp",
+    "src/mbgl/tile/geometry_tile_data_cache.cpp",
+    "src/mbgl/tile/geometry_tile_data_cache.hpp",
     "src/mbgl/tile/geometry_tile_worker.cpp",
     "src/mbgl/tile/geometry_tile_worker.hpp",
     "src/mbgl/tile/raster_dem_tile.cpp",
@@ -520,6 +542,7 @@ MLN_CORE_SOURCE = [
     "src/mbgl/tile/tile_cache.hpp",
     "src/mbgl/tile/tile_id_hash.cpp",
     "src/mbgl/tile/tile_id_io.cpp",
+    "src/mbgl/tile/tile_latency.cpp",
     "src/mbgl/tile/tile_loader.hpp",
     "src/mbgl/tile/tile_loader_impl.hpp",
     "src/mbgl/tile/tile_loader_observer.hpp",
@@ -538,12 +561,16 @@ MLN_CORE_SOURCE = [
     "src/mbgl/util/action_journal.cpp",
     "src/mbgl/util/action_journal_impl.hpp",
     "src/mbgl/util/action_journal_impl.cpp",
+    "src/mbgl/util/arena.cpp",
+    "src/mbgl/util/arena.hpp",
     "src/mbgl/util/camera.cpp",
     "src/mbgl/util/camera.hpp",
     "src/mbgl/util/bounding_volumes.hpp",
     "src/mbgl/util/bounding_volumes.cpp",
+    "src/mbgl/util/box_batch.hpp",
     "src/mbgl/util/chrono.cpp",
     "src/mbgl/util/client_options.cpp",
+    "src/mbgl/util/compressed_image.cpp",
     "src/mbgl/util/constants.cpp",
     "src/mbgl/util/convert.cpp",
     "src/mbgl/util/event.cpp",
@@ -581,11 +608,14 @@ MLN_CORE_SOURCE = [
     "src/mbgl/util/mat4.hpp",
     "src/mbgl/util/math.hpp",
     "src/mbgl/util/padding.cpp",
+    "src/mbgl/util/parallel_for.cpp",
+    "src/mbgl/util/parallel_for.hpp",
     "src/mbgl/util/premultiply.cpp",
     "src/mbgl/util/quaternion.cpp",
     "src/mbgl/util/quaternion.hpp",
     "src/mbgl/util/rapidjson.cpp",
     "src/mbgl/util/rapidjson.hpp",
+    "src/mbgl/util/reclamation_queue.hpp",
     "src/mbgl/util/std.hpp",
     "src/mbgl/util/stopwatch.cpp",
     "src/mbgl/util/stopwatch.hpp",
@@ -612,6 +642,7 @@ MLN_CORE_SOURCE = [
     "src/mbgl/util/version.cpp",
     "src/mbgl/util/version.hpp",
     "src/mbgl/util/work_request.cpp",
+    "src/mbgl/util/work_stealing_deque.hpp",
 ] + select({
     "//:rust": [
         "src/mbgl/util/color.rs.cpp",
@@ -689,15 +720,19 @@ MLN_CORE_HEADERS = [
     "include/mbgl/platform/settings.hpp",
     "include/mbgl/platform/thread.hpp",
     "include/mbgl/platform/time.hpp",
+    "include/mbgl/renderer/memory_pressure.hpp",
+    "include/mbgl/renderer/memory_report.hpp",
     "include/mbgl/renderer/query.hpp",
     "include/mbgl/renderer/renderer.hpp",
     "include/mbgl/renderer/renderer_frontend.hpp",
     "include/mbgl/renderer/renderer_observer.hpp",
+    "include/mbgl/renderer/renderer_resource_group.hpp",
     "include/mbgl/renderer/renderer_state.hpp",
     "include/mbgl/shaders/program_parameters.hpp",
     "include/mbgl/storage/database_file_source.hpp",
     "include/mbgl/storage/file_source.hpp",
     "include/mbgl/storage/file_source_manager.hpp",
+    "include/mbgl/storage/file_source_metrics.hpp",
     "include/mbgl/storage/network_status.hpp",
     "include/mbgl/storage/offline.hpp",
     "include/mbgl/storage/online_file_source.hpp",
@@ -729,6 +764,7 @@ MLN_CORE_HEADERS = [
     "include/mbgl/style/expression/assertion.hpp",
     "include/mbgl/style/expression/at.hpp",
     "include/mbgl/style/expression/boolean_operator.hpp",
+    "include/mbgl/style/expression/bytecode.hpp",
     "include/mbgl/style/expression/case.hpp",
     "include/mbgl/style/expression/check_subtype.hpp",
     "include/mbgl/style/expression/coalesce.hpp",
@@ -791,8 +827,10 @@ MLN_CORE_HEADERS = [
     "include/mbgl/style/undefined.hpp",
     "include/mbgl/style/variable_anchor_offset_collection.hpp",
     "include/mbgl/text/glyph.hpp",
+    "include/mbgl/text/glyph_store.hpp",
     "include/mbgl/text/glyph_range.hpp",
     "include/mbgl/tile/tile_id.hpp",
+    "include/mbgl/tile/tile_latency.hpp",
     "include/mbgl/tile/tile_operation.hpp",
     "include/mbgl/tile/tile_necessity.hpp",
     "include/mbgl/util/action_journal.hpp",
@@ -804,6 +842,7 @@ MLN_CORE_HEADERS = [
     "include/mbgl/util/chrono.hpp",
     "include/mbgl/util/client_options.hpp",
     "include/mbgl/util/color.hpp",
+    "include/mbgl/util/compressed_image.hpp",
     "include/mbgl/util/compression.hpp",
     "include/mbgl/util/constants.hpp",
     "include/mbgl/util/containers.hpp",
@@ -828,6 +867,7 @@ MLN_CORE_HEADERS = [
     "include/mbgl/util/interpolate.hpp",
     "include/mbgl/util/logging.hpp",
     "include/mbgl/util/lru_cache.hpp",
+    "include/mbgl/util/memory_usage.hpp",
     "include/mbgl/util/monotonic_timer.hpp",
     "include/mbgl/util/noncopyable.hpp",
     "include/mbgl/util/padding.hpp",
@@ -860,6 +900,7 @@ MLN_CORE_HEADERS = [
 MLN_OPENGL_SOURCE = [
     "src/mbgl/gl/attribute.cpp",
     "src/mbgl/gl/attribute.hpp",
+    "src/mbgl/gl/buffer_storage_extension.hpp",
     "src/mbgl/gl/command_encoder.cpp",
     "src/mbgl/gl/command_encoder.hpp",
     "src/mbgl/gl/context.cpp",
@@ -880,6 +921,9 @@ MLN_OPENGL_SOURCE = [
     "src/mbgl/gl/object.hpp",
     "src/mbgl/gl/offscreen_texture.cpp",
     "src/mbgl/gl/offscreen_texture.hpp",
+    "src/mbgl/gl/parallel_shader_compile_extension.hpp",
+    "src/mbgl/gl/program_binary_cache.cpp",
+    "src/mbgl/gl/program_binary_cache.hpp",
     "src/mbgl/gl/render_pass.cpp",
     "src/mbgl/gl/render_pass.hpp",
     "src/mbgl/gl/renderbuffer_resource.cpp",
@@ -887,6 +931,8 @@ MLN_OPENGL_SOURCE = [
     "src/mbgl/gl/renderer_backend.cpp",
     "src/mbgl/gl/resource_pool.cpp",
     "src/mbgl/gl/resource_pool.hpp",
+    "src/mbgl/gl/staging_buffer.cpp",
+    "src/mbgl/gl/staging_buffer.hpp",
     "src/mbgl/gl/state.hpp",
     "src/mbgl/gl/timestamp_query_extension.cpp",
     "src/mbgl/gl/timestamp_query_extension.hpp",
@@ -0,0 +1,74 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/actor/actor.hpp>
+#include <mbgl/actor/scheduler.hpp>
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using namespace mbgl;
+
+namespace {
+
+constexpr int64_t messagesPerThread = 10000;
+
+// Default constructed, both by Actor and directly for a mailbox of its own
+struct Counter {
+    void count(int64_t) { ++received; }
+    int64_t get() const { return received; }
+
+    int64_t received = 0;
+};
+
+// Messages sent to one actor on the background scheduler by `state.range(0)` threads at once
+void Mailbox_Throughput(benchmark::State& state) {
+    const auto threads = state.range(0);
+    Actor<Counter> actor(Scheduler::GetBackground());
+    int64_t expected = 0;
+
+    for (auto _ : state) {
+        std::vector<std::thread> senders;
+        for (int64_t i = 0; i < threads; ++i) {
+            senders.emplace_back([ref = actor.self()]() mutable {
+                for (int64_t j = 0; j < messagesPerThread; ++j) {
+                    ref.invoke(&Counter::count, j);
+                }
+            });
+        }
+        for (auto& sender : senders) {
+            sender.join();
+        }
+
+        // Processed after everything sent above
+        expected += threads * messagesPerThread;
+        if (actor.self().ask(&Counter::get).get() != expected) {
+            state.SkipWithError("Lost messages");
+            break;
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * threads * messagesPerThread);
+}
+
+// One message at a time, each waited for, so the mailbox never has more than a couple queued
+void Mailbox_RoundTrip(benchmark::State& state) {
+    const auto scheduler = Scheduler::GetBackground();
+    Counter counter;
+    auto mailbox = std::make_shared<Mailbox>(*scheduler);
+    ActorRef<Counter> ref(counter, mailbox);
+
+    for (auto _ : state) {
+        ref.invoke(&Counter::count, 0);
+        benchmark::DoNotOptimize(ref.ask(&Counter::get).get());
+    }
+
+    state.SetItemsProcessed(state.iterations() * 2);
+    state.counters["heapAllocations"] = static_cast<double>(mailbox->messageSlab().overflows());
+    mailbox->close();
+}
+
+} // namespace
+
+BENCHMARK(Mailbox_Throughput)->Arg(1)->Arg(4)->Arg(8)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(Mailbox_RoundTrip)->UseRealTime();
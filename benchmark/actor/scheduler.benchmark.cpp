@@ -0,0 +1,195 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/actor/actor.hpp>
+#include <mbgl/actor/scheduler.hpp>
+#include <mbgl/util/identity.hpp>
+#include <mbgl/util/run_loop.hpp>
+#include <mbgl/util/thread_pool.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <optional>
+#include <utility>
+
+using namespace mbgl;
+
+namespace {
+
+constexpr int64_t tasksPerIteration = 10000;
+
+using Mode = ThreadedSchedulerBase::Mode;
+
+/// `state.range(0)` threads, picking up tasks the way `state.range(1)` says. Used through the
+/// `Scheduler` interface, where `waitForEmpty` is public.
+std::unique_ptr<Scheduler> makeScheduler(const benchmark::State& state) {
+    const auto threads = static_cast<std::size_t>(state.range(0));
+    return std::make_unique<ParallelScheduler>(threads - 1, static_cast<Mode>(state.range(1)));
+}
+
+/// Stands for the work of a task, such as parsing a small part of a tile
+uint64_t work(uint64_t seed, int64_t rounds) {
+    for (int64_t i = 0; i < rounds; ++i) {
+        seed = seed * 6364136223846793005u + 1442695040888963407u;
+    }
+    return seed;
+}
+
+// Tasks with next to no work, so that the scheduler's own cost is what's measured
+void Scheduler_Throughput(benchmark::State& state) {
+    const auto scheduler = makeScheduler(state);
+    const util::SimpleIdentity tag;
+    std::atomic<int64_t> done{0};
+
+    for (auto _ : state) {
+        for (int64_t i = 0; i < tasksPerIteration; ++i) {
+            scheduler->schedule(tag, [&] { done.fetch_add(1, std::memory_order_relaxed); });
+        }
+        scheduler->waitForEmpty(tag);
+    }
+
+    if (done != state.iterations() * tasksPerIteration) {
+        state.SkipWithError("Lost tasks");
+    }
+    state.SetItemsProcessed(state.iterations() * tasksPerIteration);
+}
+
+// The time to wait for a single task of a tag while `state.range(2)` tasks of another tag are queued, as when
+// a map waits for its own tasks on the shared background scheduler
+void Scheduler_WaitForEmpty(benchmark::State& state) {
+    const auto scheduler = makeScheduler(state);
+    const util::SimpleIdentity tag;
+    const util::SimpleIdentity otherTag;
+    const auto otherTasks = state.range(2);
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        for (int64_t i = 0; i < otherTasks; ++i) {
+            scheduler->schedule(otherTag, [i] { benchmark::DoNotOptimize(work(static_cast<uint64_t>(i), 1000)); });
+        }
+        state.ResumeTiming();
+
+        scheduler->schedule(tag, [] {});
+        scheduler->waitForEmpty(tag);
+
+        state.PauseTiming();
+        scheduler->waitForEmpty(otherTag);
+        state.ResumeTiming();
+    }
+}
+
+class Pong;
+
+class Ping {
+public:
+    Ping(ActorRef<Ping> self_)
+        : self(std::move(self_)) {}
+
+    void start(ActorRef<Pong> pong_, int64_t count, std::promise<void> done_);
+    void pong(int64_t remaining);
+
+private:
+    ActorRef<Ping> self;
+    std::optional<ActorRef<Pong>> pongRef;
+    std::promise<void> done;
+};
+
+class Pong {
+public:
+    Pong(ActorRef<Pong>) {}
+
+    void ping(ActorRef<Ping> from, int64_t remaining) { from.invoke(&Ping::pong, remaining); }
+};
+
+void Ping::start(ActorRef<Pong> pong_, int64_t count, std::promise<void> done_) {
+    pongRef = std::move(pong_);
+    done = std::move(done_);
+    pong(count);
+}
+
+void Ping::pong(int64_t remaining) {
+    if (remaining == 0) {
+        done.set_value();
+        return;
+    }
+    pongRef->invoke(&Pong::ping, self, remaining - 1);
+}
+
+constexpr int64_t roundTrips = 1000;
+
+// Messages bounced between two actors, each waiting for the other's reply
+void Actor_PingPong(benchmark::State& state) {
+    const auto scheduler = makeScheduler(state);
+    Actor<Ping> ping(*scheduler);
+    Actor<Pong> pong(*scheduler);
+
+    for (auto _ : state) {
+        std::promise<void> done;
+        auto finished = done.get_future();
+        ping.self().invoke(&Ping::start, pong.self(), roundTrips, std::move(done));
+        finished.get();
+    }
+
+    state.SetItemsProcessed(state.iterations() * roundTrips * 2);
+}
+
+// `state.range(2)` tasks scheduled from a run loop, each replying to it with its result once done, the way the
+// tiles of a frame are parsed and handed back to the render thread
+void Scheduler_FanOutFanIn(benchmark::State& state) {
+    util::RunLoop loop;
+    const auto scheduler = makeScheduler(state);
+    const util::SimpleIdentity tag;
+    const auto tasks = state.range(2);
+
+    for (auto _ : state) {
+        int64_t replies = 0;
+        for (int64_t i = 0; i < tasks; ++i) {
+            scheduler->scheduleAndReplyValue(
+                tag, [i] { return work(static_cast<uint64_t>(i), 20000); }, [&](uint64_t result) {
+                    benchmark::DoNotOptimize(result);
+                    if (++replies == tasks) {
+                        loop.stop();
+                    }
+                });
+        }
+        loop.run();
+    }
+
+    state.SetItemsProcessed(state.iterations() * tasks);
+}
+
+void schedulerArgs(benchmark::internal::Benchmark* benchmark) {
+    for (const auto mode : {Mode::Shared, Mode::WorkStealing}) {
+        for (const int64_t threads : {1, 2, 4, 8}) {
+            benchmark->Args({threads, static_cast<int64_t>(mode)});
+        }
+    }
+}
+
+void loadedSchedulerArgs(benchmark::internal::Benchmark* benchmark) {
+    for (const auto mode : {Mode::Shared, Mode::WorkStealing}) {
+        for (const int64_t tasks : {0, 1000}) {
+            benchmark->Args({4, static_cast<int64_t>(mode), tasks});
+        }
+    }
+}
+
+void fanOutArgs(benchmark::internal::Benchmark* benchmark) {
+    for (const auto mode : {Mode::Shared, Mode::WorkStealing}) {
+        for (const int64_t tasks : {16, 64, 256}) {
+            benchmark->Args({4, static_cast<int64_t>(mode), tasks});
+        }
+    }
+}
+
+} // namespace
+
+BENCHMARK(Scheduler_Throughput)->Apply(schedulerArgs)->ArgNames({"threads", "mode"})->UseRealTime();
+BENCHMARK(Scheduler_WaitForEmpty)->Apply(loadedSchedulerArgs)->ArgNames({"threads", "mode", "other"})->UseRealTime();
+BENCHMARK(Actor_PingPong)->Apply(schedulerArgs)->ArgNames({"threads", "mode"})->UseRealTime();
+BENCHMARK(Scheduler_FanOutFanIn)
+    ->Apply(fanOutArgs)
+    ->ArgNames({"threads", "mode", "tasks"})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
@@ -0,0 +1,194 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/gfx/headless_frontend.hpp>
+#include <mbgl/map/map.hpp>
+#include <mbgl/map/map_observer.hpp>
+#include <mbgl/map/map_options.hpp>
+#include <mbgl/storage/network_status.hpp>
+#include <mbgl/storage/resource_options.hpp>
+#include <mbgl/style/image.hpp>
+#include <mbgl/style/style.hpp>
+#include <mbgl/util/image.hpp>
+#include <mbgl/util/io.hpp>
+#include <mbgl/util/monotonic_timer.hpp>
+#include <mbgl/util/rapidjson.hpp>
+#include <mbgl/util/run_loop.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+using namespace mbgl;
+using namespace std::chrono_literals;
+
+namespace {
+
+const std::string cachePath{"benchmark/fixtures/api/cache.db"};
+constexpr float pixelRatio{1.0f};
+constexpr Size size{1000, 1000};
+// Longest wait for the tiles of the last camera of a path, in case the cache lacks some
+constexpr auto settleTimeout = 10s;
+
+// The cameras of the `onFrameTiming` events of an action journal log, one event per line
+std::vector<CameraOptions> loadJournalCameraPath(const std::string& log) {
+    std::vector<CameraOptions> frames;
+    std::istringstream lines(log);
+    for (std::string line; std::getline(lines, line);) {
+        JSDocument event;
+        event.Parse<0>(line);
+        if (event.HasParseError() || !event.IsObject() || !event.HasMember("name") ||
+            std::string_view(event["name"].GetString()) != "onFrameTiming") {
+            continue;
+        }
+        const auto& frame = event["event"];
+        frames.push_back(CameraOptions()
+                             .withCenter(LatLng{frame["latitude"].GetDouble(), frame["longitude"].GetDouble()})
+                             .withZoom(frame["zoom"].GetDouble())
+                             .withBearing(frame["bearing"].GetDouble())
+                             .withPitch(frame["pitch"].GetDouble()));
+    }
+    return frames;
+}
+
+// A camera path recorded one frame at a time, as `{"frames": [{"center": [lng, lat], "zoom", "bearing", "pitch"}]}`,
+// or an action journal log recorded with frame timing events
+std::vector<CameraOptions> loadCameraPath(const std::string& path) {
+    const auto json = util::read_file(path);
+    JSDocument document;
+    document.Parse<0>(json);
+    if (document.HasParseError() || !document.IsObject() || !document.HasMember("frames") ||
+        !document["frames"].IsArray()) {
+        auto frames = loadJournalCameraPath(json);
+        if (frames.empty()) {
+            throw std::runtime_error("invalid camera path " + path);
+        }
+        return frames;
+    }
+
+    std::vector<CameraOptions> frames;
+    for (const auto& frame : document["frames"].GetArray()) {
+        const auto& center = frame["center"];
+        frames.push_back(CameraOptions()
+                             .withCenter(LatLng{center[1].GetDouble(), center[0].GetDouble()})
+                             .withZoom(frame["zoom"].GetDouble())
+                             .withBearing(frame["bearing"].GetDouble())
+                             .withPitch(frame["pitch"].GetDouble()));
+    }
+    return frames;
+}
+
+class FrameObserver : public MapObserver {
+public:
+    void onDidFinishRenderingFrame(const RenderFrameStatus& status) override {
+        ++frames;
+        full = status.mode == RenderMode::Full;
+        placementTime = status.renderingStats.placementTime;
+    }
+
+    std::size_t frames = 0;
+    bool full = false;
+    double placementTime = 0;
+};
+
+// Nearest-rank percentile of unsorted samples, in milliseconds
+double percentile(std::vector<double> samples, double p) {
+    if (samples.empty()) {
+        return 0;
+    }
+    const auto rank = static_cast<std::size_t>(p / 100.0 * static_cast<double>(samples.size() - 1) + 0.5);
+    std::nth_element(samples.begin(), samples.begin() + rank, samples.end());
+    return samples[rank] * 1000.0;
+}
+
+} // end namespace
+
+// Replays a camera path over the offline fixture tiles in continuous mode, one frame per recorded
+// camera. Besides the replay time, reports the percentiles of the frame times, the time from a camera
+// move until all the tiles it needs are loaded and rendered, and the symbol placement time.
+static void API_renderCameraPath(::benchmark::State& state, const std::string& stylePath, const std::string& path) {
+    NetworkStatus::Set(NetworkStatus::Status::Offline);
+    util::RunLoop loop;
+
+    const auto cameras = loadCameraPath(path);
+    std::vector<double> frameTimes;
+    std::vector<double> loadLatencies;
+    std::vector<double> placementTimes;
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        HeadlessFrontend frontend{size, pixelRatio};
+        FrameObserver observer;
+        Map map{frontend,
+                observer,
+                MapOptions().withMapMode(MapMode::Continuous).withSize(size).withPixelRatio(pixelRatio),
+                ResourceOptions().withCachePath(cachePath).withApiKey("foobar")};
+        map.getStyle().loadJSON(util::read_file(stylePath));
+        map.getStyle().addImage(std::make_unique<style::Image>(
+            "test-icon", decodeImage(util::read_file("benchmark/fixtures/api/default_marker.png")), 1.0f));
+        state.ResumeTiming();
+
+        // Start of the wait for the tiles of the current camera, if they aren't all rendered yet
+        std::optional<std::chrono::duration<double>> loadingSince;
+        const auto renderFrame = [&] {
+            const auto frames = observer.frames;
+            while (observer.frames == frames) {
+                frontend.renderOnce(map);
+            }
+            frameTimes.push_back(frontend.getFrameTime());
+            placementTimes.push_back(observer.placementTime);
+
+            const auto now = util::MonotonicTimer::now();
+            if (!observer.full && !loadingSince) {
+                loadingSince = now;
+            } else if (observer.full && loadingSince) {
+                loadLatencies.push_back((now - *loadingSince).count());
+                loadingSince.reset();
+            }
+        };
+
+        for (const auto& camera : cameras) {
+            map.jumpTo(camera);
+            renderFrame();
+        }
+
+        const auto deadline = util::MonotonicTimer::now() + settleTimeout;
+        while (!observer.full && util::MonotonicTimer::now() < deadline) {
+            renderFrame();
+        }
+    }
+
+    state.counters["frame_p50_ms"] = percentile(frameTimes, 50);
+    state.counters["frame_p95_ms"] = percentile(frameTimes, 95);
+    state.counters["frame_p99_ms"] = percentile(frameTimes, 99);
+    state.counters["tile_load_p50_ms"] = percentile(loadLatencies, 50);
+    state.counters["tile_load_p95_ms"] = percentile(loadLatencies, 95);
+    state.counters["placement_p50_ms"] = percentile(placementTimes, 50);
+    state.counters["placement_p95_ms"] = percentile(placementTimes, 95);
+}
+
+namespace {
+
+const std::string streetsStyle{"benchmark/fixtures/api/style.json"};
+const std::string formattedLabelsStyle{"benchmark/fixtures/api/style_formatted_labels.json"};
+const std::string manhattanPan{"benchmark/fixtures/api/camera_paths/manhattan_pan.json"};
+const std::string manhattanRotate{"benchmark/fixtures/api/camera_paths/manhattan_rotate.json"};
+const std::string barcelonaZoom{"benchmark/fixtures/api/camera_paths/barcelona_zoom.json"};
+
+} // end namespace
+
+BENCHMARK_CAPTURE(API_renderCameraPath, manhattan_pan, streetsStyle, manhattanPan)
+    ->Unit(benchmark::kMillisecond)
+    ->Iterations(5);
+BENCHMARK_CAPTURE(API_renderCameraPath, manhattan_rotate, streetsStyle, manhattanRotate)
+    ->Unit(benchmark::kMillisecond)
+    ->Iterations(5);
+BENCHMARK_CAPTURE(API_renderCameraPath, barcelona_zoom, streetsStyle, barcelonaZoom)
+    ->Unit(benchmark::kMillisecond)
+    ->Iterations(5);
+BENCHMARK_CAPTURE(API_renderCameraPath, manhattan_pan_formatted_labels, formattedLabelsStyle, manhattanPan)
+    ->Unit(benchmark::kMillisecond)
+    ->Iterations(5);
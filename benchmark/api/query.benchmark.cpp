@@ -86,8 +86,35 @@ static void API_queryRenderedFeaturesLayerFromHighDensity(::benchmark::State& st
         bench.frontend.getRenderer()->queryRenderedFeatures(bench.box, {{{"road-street"}}, {}});
     }
 }
+static void API_queryRenderedFeaturesPoint(::benchmark::State& state) {
+    QueryBenchmark bench;
+
+    while (state.KeepRunning()) {
+        bench.frontend.getRenderer()->queryRenderedFeatures(ScreenCoordinate{500, 500}, {});
+    }
+}
+
+static void API_queryRenderedFeaturesBox(::benchmark::State& state) {
+    QueryBenchmark bench;
+
+    while (state.KeepRunning()) {
+        bench.frontend.getRenderer()->queryRenderedFeatures(ScreenBox{{450, 450}, {550, 550}}, {});
+    }
+}
+
+static void API_queryRenderedFeaturesAllLimited(::benchmark::State& state) {
+    QueryBenchmark bench;
+
+    while (state.KeepRunning()) {
+        bench.frontend.getRenderer()->queryRenderedFeatures(bench.box, {{}, {}, 10});
+    }
+}
+
 BENCHMARK(API_queryPixelsForLatLngs);
 BENCHMARK(API_queryLatLngsForPixels);
 BENCHMARK(API_queryRenderedFeaturesAll)->Iterations(50);
 BENCHMARK(API_queryRenderedFeaturesLayerFromLowDensity);
 BENCHMARK(API_queryRenderedFeaturesLayerFromHighDensity);
+BENCHMARK(API_queryRenderedFeaturesPoint);
+BENCHMARK(API_queryRenderedFeaturesBox);
+BENCHMARK(API_queryRenderedFeaturesAllLimited);
@@ -0,0 +1,110 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/gfx/headless_frontend.hpp>
+#include <mbgl/map/map.hpp>
+#include <mbgl/map/map_observer.hpp>
+#include <mbgl/map/map_options.hpp>
+#include <mbgl/storage/network_status.hpp>
+#include <mbgl/storage/resource_options.hpp>
+#include <mbgl/style/image.hpp>
+#include <mbgl/style/layer.hpp>
+#include <mbgl/style/style.hpp>
+#include <mbgl/util/image.hpp>
+#include <mbgl/util/io.hpp>
+#include <mbgl/util/run_loop.hpp>
+
+#include <memory>
+#include <string>
+#include <string_view>
+
+using namespace mbgl;
+
+namespace {
+
+const std::string cachePath{"benchmark/fixtures/api/cache.db"};
+constexpr double pixelRatio{1.0};
+constexpr Size size{1000, 1000};
+
+// The dense POIs, road and place labels of the tiles cached for the fixtures
+const LatLng manhattan{40.726989, -73.992857};
+const LatLng barcelona{41.379800, 2.176810};
+
+class SymbolBenchmark {
+public:
+    SymbolBenchmark() { NetworkStatus::Set(NetworkStatus::Status::Offline); }
+
+    util::RunLoop loop;
+};
+
+/// Loads the fixture style with its symbol layers alone, so that the renders measure their layout and placement
+void prepare(Map& map, const LatLng& center, double pitch) {
+    auto& style = map.getStyle();
+    style.loadJSON(util::read_file("benchmark/fixtures/api/style.json"));
+    for (const auto* layer : style.getLayers()) {
+        if (std::string_view(layer->getTypeInfo()->type) != "symbol") {
+            style.removeLayer(layer->getID());
+        }
+    }
+    map.jumpTo(CameraOptions().withCenter(center).withZoom(15.0).withPitch(pitch));
+
+    auto image = decodeImage(util::read_file("benchmark/fixtures/api/default_marker.png"));
+    style.addImage(std::make_unique<style::Image>("test-icon", std::move(image), 1.0f));
+}
+
+MapOptions mapOptions() {
+    return MapOptions().withMapMode(MapMode::Static).withSize(size).withPixelRatio(pixelRatio);
+}
+
+// A new map for each still, so that the symbols of every tile are laid out again
+void layOutTiles(benchmark::State& state, const LatLng& center) {
+    SymbolBenchmark bench;
+    for (auto _ : state) {
+        HeadlessFrontend frontend{size, pixelRatio};
+        Map map{frontend,
+                MapObserver::nullObserver(),
+                mapOptions(),
+                ResourceOptions().withCachePath(cachePath).withApiKey("foobar")};
+        prepare(map, center, 0.0);
+        frontend.render(map);
+    }
+}
+
+// The same map for each still, its tiles laid out once, so that the symbols are placed again each time
+void placeSymbols(benchmark::State& state, double pitch) {
+    SymbolBenchmark bench;
+    HeadlessFrontend frontend{size, pixelRatio};
+    Map map{frontend,
+            MapObserver::nullObserver(),
+            mapOptions(),
+            ResourceOptions().withCachePath(cachePath).withApiKey("foobar")};
+    prepare(map, manhattan, pitch);
+    frontend.render(map);
+
+    for (auto _ : state) {
+        frontend.render(map);
+    }
+}
+
+} // namespace
+
+static void API_symbolLayout_Manhattan(benchmark::State& state) {
+    layOutTiles(state, manhattan);
+}
+
+static void API_symbolLayout_Barcelona(benchmark::State& state) {
+    layOutTiles(state, barcelona);
+}
+
+static void API_symbolPlacement_Flat(benchmark::State& state) {
+    placeSymbols(state, 0.0);
+}
+
+// Pitched views cover more tiles, and their collision boxes are projected through the pitch
+static void API_symbolPlacement_Pitched(benchmark::State& state) {
+    placeSymbols(state, 45.0);
+}
+
+BENCHMARK(API_symbolLayout_Manhattan)->Unit(benchmark::kMillisecond)->Iterations(20);
+BENCHMARK(API_symbolLayout_Barcelona)->Unit(benchmark::kMillisecond)->Iterations(20);
+BENCHMARK(API_symbolPlacement_Flat)->Unit(benchmark::kMillisecond)->Iterations(50);
+BENCHMARK(API_symbolPlacement_Pitched)->Unit(benchmark::kMillisecond)->Iterations(50);
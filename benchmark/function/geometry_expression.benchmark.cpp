@@ -0,0 +1,90 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/benchmark/stub_geometry_tile_feature.hpp>
+
+#include <mbgl/style/expression/dsl.hpp>
+#include <mbgl/tile/tile_id.hpp>
+#include <mbgl/util/constants.hpp>
+#include <mbgl/util/tile_coordinate.hpp>
+
+#include <cmath>
+#include <numbers>
+#include <string>
+#include <vector>
+
+using namespace mbgl;
+using namespace mbgl::style;
+
+namespace {
+
+const LatLng center{40.758, -73.985};
+constexpr uint8_t zoom = 14;
+
+// A geofence around the center, its radius varying by a tenth so that the edges aren't all alike
+std::string geofence(std::size_t vertices) {
+    std::string coordinates;
+    for (std::size_t i = 0; i <= vertices; ++i) {
+        const double angle = 2 * std::numbers::pi * static_cast<double>(i % vertices) / static_cast<double>(vertices);
+        const double radius = 0.01 * (1.0 + 0.1 * std::sin(angle * 17));
+        coordinates += std::string(i ? "," : "") + "[" + std::to_string(center.longitude() + radius * std::cos(angle)) +
+                       "," + std::to_string(center.latitude() + radius * std::sin(angle)) + "]";
+    }
+    return R"({"type": "Polygon", "coordinates": [[)" + coordinates + "]]}";
+}
+
+CanonicalTileID tileAt(const LatLng& latLng) {
+    const auto coordinate = TileCoordinate::fromLatLng(zoom, latLng);
+    return {zoom, static_cast<uint32_t>(coordinate.p.x), static_cast<uint32_t>(coordinate.p.y)};
+}
+
+// Points in a grid over the tile
+std::vector<StubGeometryTileFeature> gridPoints() {
+    constexpr int32_t step = util::EXTENT / 16;
+    std::vector<StubGeometryTileFeature> features;
+    for (int32_t x = step / 2; x < util::EXTENT; x += step) {
+        for (int32_t y = step / 2; y < util::EXTENT; y += step) {
+            const GeometryCoordinate point{static_cast<int16_t>(x), static_cast<int16_t>(y)};
+            features.emplace_back(
+                FeatureIdentifier(), FeatureType::Point, GeometryCollection{GeometryCoordinates{point}}, PropertyMap());
+        }
+    }
+    return features;
+}
+
+void evaluateGeometryExpression(benchmark::State& state, const char* op, const CanonicalTileID& tile) {
+    const auto json = R"([")" + std::string(op) + R"(", )" + geofence(static_cast<std::size_t>(state.range(0))) + "]";
+    const auto expression = expression::dsl::createExpression(json.c_str());
+    if (!expression) {
+        state.SkipWithError("Failed to parse the expression");
+        return;
+    }
+
+    const auto features = gridPoints();
+    for (auto _ : state) {
+        for (const auto& feature : features) {
+            benchmark::DoNotOptimize(
+                expression->evaluate(expression::EvaluationContext(zoom, &feature).withCanonicalTileID(&tile)));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(features.size()));
+}
+
+} // namespace
+
+// Points of the tile holding the geofence, which the bounding boxes don't rule out
+static void Evaluate_Within(benchmark::State& state) {
+    evaluateGeometryExpression(state, "within", tileAt(center));
+}
+
+// Points of a tile far from the geofence, which the test of the tile bounds rules out
+static void Evaluate_WithinFar(benchmark::State& state) {
+    evaluateGeometryExpression(state, "within", tileAt({center.latitude() + 1, center.longitude()}));
+}
+
+static void Evaluate_Distance(benchmark::State& state) {
+    evaluateGeometryExpression(state, "distance", tileAt(center));
+}
+
+BENCHMARK(Evaluate_Within)->Arg(64)->Arg(4096);
+BENCHMARK(Evaluate_WithinFar)->Arg(64)->Arg(4096);
+BENCHMARK(Evaluate_Distance)->Arg(64)->Arg(4096);
@@ -0,0 +1,53 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/benchmark/stub_geometry_tile_feature.hpp>
+
+#include <mbgl/style/expression/dsl.hpp>
+
+#include <array>
+
+using namespace mbgl;
+using namespace mbgl::style;
+
+namespace {
+
+struct LayerExpression {
+    const char* name;
+    const char* json;
+};
+
+// Paint and layout expressions typical of a vector basemap, one per benchmark argument
+const std::array<LayerExpression, 6> layerExpressions{{
+    {"line-width", R"(["interpolate", ["exponential", 1.5], ["zoom"], 5, 0.5, 10, 1, 14, 4, 18, 20])"},
+    {"fill-color",
+     R"(["match", ["get", "class"], "park", "#d8e8c8", "hospital", "#fde", "school", "#f0e8f8", "#eee"])"},
+    {"text-size", R"(["coalesce", ["get", "size"], 12])"},
+    {"circle-radius", R"(["interpolate", ["linear"], ["zoom"], 10, ["get", "rank"], 16, ["*", 4, ["get", "rank"]]])"},
+    {"line-opacity", R"(["step", ["zoom"], 0, 8, 0.5, 12, 1])"},
+    {"symbol-sort-key", R"(["+", ["get", "rank"], ["*", 10, ["get", "scalerank"]]])"},
+}};
+
+} // namespace
+
+static void Evaluate_LayerExpression(benchmark::State& state) {
+    const auto& layer = layerExpressions.at(state.range(0));
+    const auto expression = expression::dsl::createExpression(layer.json);
+    if (!expression) {
+        state.SkipWithError("Failed to parse the expression");
+        return;
+    }
+
+    const StubGeometryTileFeature feature(PropertyMap{{"class", std::string("school")},
+                                                      {"size", 14.0},
+                                                      {"rank", uint64_t(3)},
+                                                      {"scalerank", int64_t(2)}});
+    float zoom = 0.0f;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(expression->evaluate(expression::EvaluationContext(zoom, &feature)));
+        zoom = zoom >= 20.0f ? 0.0f : zoom + 0.25f;
+    }
+
+    state.SetLabel(layer.name);
+}
+
+BENCHMARK(Evaluate_LayerExpression)->DenseRange(0, static_cast<int>(layerExpressions.size()) - 1);
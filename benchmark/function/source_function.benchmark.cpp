@@ -55,6 +55,28 @@ static void Evaluate_SourceFunction(benchmark::State& state) {
     state.SetLabel(std::to_string(stopCount).c_str());
 }
 
+// The same evaluation through the expression tree, bypassing the compiled bytecode
+static void Evaluate_SourceFunctionTree(benchmark::State& state) {
+    size_t stopCount = state.range(0);
+    auto doc = createFunctionJSON(stopCount);
+    conversion::Error error;
+    std::optional<PropertyValue<float>> function = conversion::convertJSON<PropertyValue<float>>(
+        doc, error, true, false);
+    if (!function) {
+        state.SkipWithError(error.message.c_str());
+    }
+
+    const auto& expression = function->asExpression().getExpression();
+    while (state.KeepRunning()) {
+        const StubGeometryTileFeature feature(PropertyMap{{"x", static_cast<int64_t>(rand() % 100)}});
+        benchmark::DoNotOptimize(expression.evaluate(expression::EvaluationContext(&feature)));
+    }
+
+    state.SetLabel(std::to_string(stopCount).c_str());
+}
+
 BENCHMARK(Parse_SourceFunction)->Arg(1)->Arg(2)->Arg(4)->Arg(6)->Arg(8)->Arg(10)->Arg(12);
 
 BENCHMARK(Evaluate_SourceFunction)->Arg(1)->Arg(2)->Arg(4)->Arg(6)->Arg(8)->Arg(10)->Arg(12);
+
+BENCHMARK(Evaluate_SourceFunctionTree)->Arg(1)->Arg(2)->Arg(4)->Arg(6)->Arg(8)->Arg(10)->Arg(12);
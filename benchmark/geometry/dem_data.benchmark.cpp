@@ -0,0 +1,40 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/geometry/dem_data.hpp>
+#include <mbgl/util/image.hpp>
+#include <mbgl/util/tileset.hpp>
+
+#include <array>
+
+using namespace mbgl;
+
+namespace {
+
+PremultipliedImage demImage(uint8_t seed) {
+    PremultipliedImage image({512, 512});
+    for (std::size_t i = 0; i < image.bytes(); ++i) {
+        image.data[i] = (i + 1) % 4 == 0 ? 255 : static_cast<uint8_t>(i * 7 + seed);
+    }
+    return image;
+}
+
+// Decoding a 512px tile and backfilling its border from all eight neighbours
+void DEMDataDecode(benchmark::State& state, Tileset::RasterEncoding encoding) {
+    const auto image = demImage(0);
+    const DEMData neighbor(demImage(1), encoding);
+    constexpr std::array<std::array<int8_t, 2>, 8> offsets = {
+        {{-1, -1}, {0, -1}, {1, -1}, {-1, 0}, {1, 0}, {-1, 1}, {0, 1}, {1, 1}}};
+
+    for (auto _ : state) {
+        DEMData data(image, encoding);
+        for (const auto& offset : offsets) {
+            data.backfillBorder(neighbor, offset[0], offset[1]);
+        }
+        benchmark::DoNotOptimize(data.getImage()->data.get());
+    }
+}
+
+} // namespace
+
+BENCHMARK_CAPTURE(DEMDataDecode, Mapbox, Tileset::RasterEncoding::Mapbox);
+BENCHMARK_CAPTURE(DEMDataDecode, Terrarium, Tileset::RasterEncoding::Terrarium);
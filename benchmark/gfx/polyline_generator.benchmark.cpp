@@ -0,0 +1,89 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/gfx/polyline_generator.hpp>
+#include <mbgl/gfx/polyline_segments.hpp>
+#include <mbgl/renderer/buckets/line_bucket.hpp>
+#include <mbgl/tile/vector_mvt_tile_data.hpp>
+#include <mbgl/util/io.hpp>
+
+#include <vector>
+
+using namespace mbgl;
+
+namespace {
+
+// The lines of the road layer of a z10 streets tile
+std::vector<GeometryCoordinates> loadRoads() {
+    VectorMVTTileData tile(
+        std::make_shared<std::string>(util::read_file("test/fixtures/api/assets/streets/10-163-395.vector.pbf")));
+    std::vector<GeometryCoordinates> lines;
+    if (const auto layer = tile.getLayer("road")) {
+        for (std::size_t i = 0; i < layer->featureCount(); ++i) {
+            const auto feature = layer->getFeature(i);
+            if (feature->getType() != FeatureType::LineString) {
+                continue;
+            }
+            for (const auto& line : feature->getGeometries()) {
+                lines.push_back(line);
+            }
+        }
+    }
+    return lines;
+}
+
+} // namespace
+
+// Argument 0 is the scalar loop, 1 the vectorized one where available
+static void Polyline_SegmentNormals(benchmark::State& state) {
+    const auto lines = loadRoads();
+    const bool vectorized = state.range(0) != 0;
+
+    gfx::PolylineSegments segments;
+    std::size_t count = 0;
+    for (auto _ : state) {
+        for (const auto& line : lines) {
+            if (vectorized) {
+                segments.compute(line, 0, line.size());
+            } else {
+                segments.computeScalar(line, 0, line.size());
+            }
+            benchmark::DoNotOptimize(segments);
+            count += line.size();
+        }
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(count));
+    state.SetLabel(vectorized ? "vectorized" : "scalar");
+}
+
+static void Polyline_GenerateRoads(benchmark::State& state) {
+    const auto lines = loadRoads();
+
+    gfx::PolylineGeneratorOptions options;
+    options.joinType = style::LineJoinType::Round;
+    options.overscaling = 1;
+
+    for (auto _ : state) {
+        gfx::VertexVector<LineLayoutVertex> vertices;
+        gfx::IndexVector<gfx::Triangles> indexes;
+        std::vector<SegmentBase> segments;
+        gfx::PolylineGenerator<LineLayoutVertex, SegmentBase> generator(
+            vertices,
+            LineBucket::layoutVertex,
+            segments,
+            [](std::size_t vertexOffset, std::size_t indexOffset) -> SegmentBase {
+                return SegmentBase(vertexOffset, indexOffset);
+            },
+            [](auto& segment) -> SegmentBase& { return segment; },
+            indexes);
+        for (const auto& line : lines) {
+            generator.generate(line, options);
+        }
+        benchmark::DoNotOptimize(vertices.elements());
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * lines.size()));
+}
+
+BENCHMARK(Polyline_SegmentNormals)->Arg(0)->Arg(1);
+BENCHMARK(Polyline_GenerateRoads);
@@ -0,0 +1,69 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/benchmark/stub_geometry_tile_feature.hpp>
+
+#include <mbgl/layout/merge_lines.hpp>
+#include <mbgl/layout/symbol_feature.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace mbgl;
+
+namespace {
+
+constexpr int16_t segmentsPerRoad = 8;
+
+// The road labels of a dense city tile, each road cut into short segments that arrive in no particular order
+std::vector<SymbolFeature> makeRoadSegments(std::size_t roads, std::size_t names) {
+    std::vector<std::pair<std::size_t, GeometryCollection>> segments;
+    for (std::size_t road = 0; road < roads; ++road) {
+        const auto y = static_cast<int16_t>(road);
+        for (int16_t segment = 0; segment < segmentsPerRoad; ++segment) {
+            const auto x = static_cast<int16_t>(segment * 2);
+            segments.emplace_back(road % names, GeometryCollection{{{x, y}, {int16_t(x + 1), y}, {int16_t(x + 2), y}}});
+        }
+    }
+    std::shuffle(segments.begin(), segments.end(), std::mt19937(42));
+
+    std::vector<SymbolFeature> features;
+    features.reserve(segments.size());
+    for (auto& [name, geometry] : segments) {
+        features.emplace_back(std::make_unique<StubGeometryTileFeature>(
+            FeatureIdentifier{}, FeatureType::LineString, std::move(geometry), PropertyMap{}));
+        const auto number = std::to_string(name);
+        const auto text = u"Road number " + std::u16string(number.begin(), number.end());
+        features.back().formattedText = TaggedString(text, SectionOptions(1.0, {}, GlyphIDType::FontPBF, 0));
+    }
+    return features;
+}
+
+void mergeRoadLabels(benchmark::State& state, std::size_t names) {
+    const auto roads = static_cast<std::size_t>(state.range(0));
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto features = makeRoadSegments(roads, names);
+        state.ResumeTiming();
+        util::mergeLines(features);
+        benchmark::DoNotOptimize(features.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) * segmentsPerRoad);
+}
+
+} // namespace
+
+// Every road with a name of its own
+static void MergeLines_DistinctNames(benchmark::State& state) {
+    mergeRoadLabels(state, static_cast<std::size_t>(state.range(0)));
+}
+
+// Many roads sharing a few names, as the numbered streets of a grid do
+static void MergeLines_SharedNames(benchmark::State& state) {
+    mergeRoadLabels(state, 10);
+}
+
+BENCHMARK(MergeLines_DistinctNames)->Arg(100)->Arg(1000);
+BENCHMARK(MergeLines_SharedNames)->Arg(100)->Arg(1000);
@@ -0,0 +1,59 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/text/tagged_string.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace mbgl;
+
+namespace {
+
+constexpr std::size_t sectionsPerLabel = 3;
+constexpr std::size_t linesPerLabel = 2;
+
+const FontStack& labelFontStack(std::size_t section) {
+    static const std::vector<FontStack> fontStacks{{"Noto Sans Regular", "Arial Unicode MS Regular"},
+                                                   {"Noto Sans Bold", "Arial Unicode MS Bold"},
+                                                   {"Noto Sans Italic", "Arial Unicode MS Regular"}};
+    return fontStacks[section % fontStacks.size()];
+}
+
+// The formatted labels of a tile, each section named in a font stack of its own, and their sections copied for
+// each line the way shaping does
+template <typename MakeFontStack>
+void layOutLabels(benchmark::State& state, MakeFontStack makeFontStack) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    for (auto _ : state) {
+        std::vector<TaggedString> lines;
+        lines.reserve(count * linesPerLabel);
+        for (std::size_t i = 0; i < count; ++i) {
+            TaggedString label;
+            for (std::size_t section = 0; section < sectionsPerLabel; ++section) {
+                label.addTextSection(u"Section", 1.0, makeFontStack(labelFontStack(section)), GlyphIDType::FontPBF);
+            }
+            for (std::size_t line = 0; line < linesPerLabel; ++line) {
+                lines.emplace_back(label.getStyledText(), label.getSections());
+            }
+        }
+        benchmark::DoNotOptimize(lines.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+} // namespace
+
+// A copy of the font names for each section, as before the font stacks were shared
+static void TaggedString_CopiedFontStacks(benchmark::State& state) {
+    layOutLabels(state, [](const FontStack& fontStack) { return std::make_shared<const FontStack>(fontStack); });
+}
+
+// The font stacks shared by all the sections of the tile
+static void TaggedString_InternedFontStacks(benchmark::State& state) {
+    FontStackInterner interner;
+    layOutLabels(state, [&](const FontStack& fontStack) { return interner.intern(fontStack); });
+}
+
+BENCHMARK(TaggedString_CopiedFontStacks)->Arg(1000)->Arg(10000);
+BENCHMARK(TaggedString_InternedFontStacks)->Arg(1000)->Arg(10000);
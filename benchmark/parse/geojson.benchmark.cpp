@@ -0,0 +1,90 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/actor/scheduler.hpp>
+#include <mbgl/style/conversion/geojson.hpp>
+#include <mbgl/style/sources/geojson_source.hpp>
+#include <mbgl/util/geometry.hpp>
+
+#include <random>
+#include <string>
+
+using namespace mbgl;
+using namespace mbgl::style;
+
+namespace {
+
+GeoJSON makePoints(std::size_t count) {
+    std::mt19937 generator(0);
+    std::uniform_real_distribution<double> longitude(-180.0, 180.0);
+    std::uniform_real_distribution<double> latitude(-85.0, 85.0);
+
+    GeoJSONData::Features features;
+    features.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        features.emplace_back(Point<double>{longitude(generator), latitude(generator)},
+                              PropertyMap{{"rank", uint64_t(i % 10)}},
+                              uint64_t(i));
+    }
+    return features;
+}
+
+std::string makePointsJSON(std::size_t count) {
+    std::mt19937 generator(0);
+    std::uniform_real_distribution<double> longitude(-180.0, 180.0);
+    std::uniform_real_distribution<double> latitude(-85.0, 85.0);
+
+    std::string json = R"({"type": "FeatureCollection", "features": [)";
+    for (std::size_t i = 0; i < count; ++i) {
+        json += i ? "," : "";
+        json += R"({"type": "Feature", "id": )" + std::to_string(i) + R"(, "properties": {"rank": )" +
+                std::to_string(i % 10) + R"(}, "geometry": {"type": "Point", "coordinates": [)" +
+                std::to_string(longitude(generator)) + "," + std::to_string(latitude(generator)) + "]}}";
+    }
+    return json + "]}";
+}
+
+} // namespace
+
+// Building the tile index on a source update, before any tile is requested
+static void GeoJSON_CreateTileIndex(benchmark::State& state) {
+    const auto geoJSON = makePoints(state.range(0));
+    const auto scheduler = Scheduler::GetSequenced();
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(GeoJSONData::create(geoJSON, scheduler));
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(GeoJSON_CreateTileIndex)->Arg(1000)->Arg(20000)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+// Loading GeoJSON from a URL, through a document of the whole text
+static void GeoJSON_ParseDocument(benchmark::State& state) {
+    const auto json = makePointsJSON(state.range(0));
+    const auto scheduler = Scheduler::GetSequenced();
+
+    for (auto _ : state) {
+        style::conversion::Error error;
+        const auto geoJSON = style::conversion::parseGeoJSON(json, error);
+        benchmark::DoNotOptimize(GeoJSONData::create(*geoJSON, scheduler));
+    }
+
+    state.SetBytesProcessed(state.iterations() * json.size());
+}
+
+// Loading GeoJSON from a URL, indexing features while they're read
+static void GeoJSON_ParseStreaming(benchmark::State& state) {
+    const auto json = makePointsJSON(state.range(0));
+    const auto scheduler = Scheduler::GetSequenced();
+
+    for (auto _ : state) {
+        style::conversion::Error error;
+        benchmark::DoNotOptimize(GeoJSONData::parse(json, scheduler, GeoJSONOptions::defaultOptions(), error));
+    }
+
+    state.SetBytesProcessed(state.iterations() * json.size());
+}
+
+BENCHMARK(GeoJSON_ParseDocument)->Arg(1000)->Arg(100000)->Unit(benchmark::kMillisecond);
+BENCHMARK(GeoJSON_ParseStreaming)->Arg(1000)->Arg(100000)->Unit(benchmark::kMillisecond);
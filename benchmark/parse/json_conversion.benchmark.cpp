@@ -0,0 +1,86 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/style/conversion/filter.hpp>
+#include <mbgl/style/conversion/json.hpp>
+#include <mbgl/style/conversion/tileset.hpp>
+#include <mbgl/style/filter.hpp>
+#include <mbgl/util/tileset.hpp>
+
+#include <optional>
+#include <string>
+
+using namespace mbgl;
+using namespace mbgl::style;
+
+namespace {
+
+// A TileJSON with as many vector layers as given, most of it skipped by the conversion as it is by the loaders
+std::string makeTileJSON(std::size_t layerCount) {
+    std::string json = R"({"tilejson": "3.0.0", "name": "benchmark", "minzoom": 0, "maxzoom": 14,)"
+                       R"( "bounds": [-180, -85.0511, 180, 85.0511], "attribution": "benchmark", "scheme": "xyz",)"
+                       R"( "tiles": ["https://a.example.com/{z}/{x}/{y}.pbf",)"
+                       R"( "https://b.example.com/{z}/{x}/{y}.pbf"], "vector_layers": [)";
+    for (std::size_t i = 0; i < layerCount; ++i) {
+        const auto id = std::to_string(i);
+        json += (i ? ", " : "") + R"({"id": "layer-)" + id + R"(", "minzoom": 0, "maxzoom": 14, "fields": {)" +
+                R"("name": "String", "class": "String", "rank": "Number", "height": )" + id + ".5}}";
+    }
+    return json + "]}";
+}
+
+// A filter as style editors generate them, matching any of the given number of values
+std::string makeFilter(std::size_t valueCount) {
+    std::string json = R"(["any")";
+    for (std::size_t i = 0; i < valueCount; ++i) {
+        json += R"(, ["==", ["get", "class"], "class-)" + std::to_string(i) + R"("])";
+    }
+    return json + "]";
+}
+
+template <class T, class Convert>
+void convertAll(benchmark::State& state, const std::string& json, Convert convert) {
+    for (auto _ : state) {
+        conversion::Error error;
+        std::optional<T> result = convert(json, error);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(json.size()));
+}
+
+} // namespace
+
+static void JSONConversion_Tileset(benchmark::State& state) {
+    const auto json = makeTileJSON(static_cast<std::size_t>(state.range(0)));
+    convertAll<Tileset>(state, json, [](const std::string& input, conversion::Error& error) {
+        return conversion::convertRapidJSON<Tileset>(input, error);
+    });
+}
+
+static void JSONConversion_Filter(benchmark::State& state) {
+    const auto json = makeFilter(static_cast<std::size_t>(state.range(0)));
+    convertAll<Filter>(state, json, [](const std::string& input, conversion::Error& error) {
+        return conversion::convertRapidJSON<Filter>(input, error);
+    });
+}
+
+BENCHMARK(JSONConversion_Tileset)->Arg(10)->Arg(1000);
+BENCHMARK(JSONConversion_Filter)->Arg(8)->Arg(64);
+
+#if MLN_WITH_SIMDJSON
+static void JSONConversion_TilesetSimdJSON(benchmark::State& state) {
+    const auto json = makeTileJSON(static_cast<std::size_t>(state.range(0)));
+    convertAll<Tileset>(state, json, [](const std::string& input, conversion::Error& error) {
+        return conversion::convertSimdJSON<Tileset>(input, error);
+    });
+}
+
+static void JSONConversion_FilterSimdJSON(benchmark::State& state) {
+    const auto json = makeFilter(static_cast<std::size_t>(state.range(0)));
+    convertAll<Filter>(state, json, [](const std::string& input, conversion::Error& error) {
+        return conversion::convertSimdJSON<Filter>(input, error);
+    });
+}
+
+BENCHMARK(JSONConversion_TilesetSimdJSON)->Arg(10)->Arg(1000);
+BENCHMARK(JSONConversion_FilterSimdJSON)->Arg(8)->Arg(64);
+#endif
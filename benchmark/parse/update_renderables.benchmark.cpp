@@ -0,0 +1,146 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/algorithm/update_renderables.hpp>
+#include <mbgl/algorithm/update_tile_masks.hpp>
+
+#include <map>
+#include <memory>
+#include <vector>
+
+using namespace mbgl;
+
+namespace {
+
+constexpr uint8_t idealZ = 14;
+constexpr uint32_t originX = 8000;
+constexpr uint32_t originY = 5000;
+
+class FakeTile {
+public:
+    explicit FakeTile(bool renderable_)
+        : renderable(renderable_) {}
+
+    bool isRenderable() const { return renderable; }
+    bool hasTriedCache() const { return false; }
+    bool isLoaded() const { return renderable; }
+    void setMask(TileMask mask_) { mask = std::move(mask_); }
+
+    const bool renderable;
+    const bool usedByRenderedLayers = true;
+    TileMask mask;
+};
+
+using Tiles = std::map<OverscaledTileID, std::unique_ptr<FakeTile>>;
+
+std::vector<OverscaledTileID> idealTiles(uint32_t side) {
+    std::vector<OverscaledTileID> ids;
+    for (uint32_t x = originX; x < originX + side; ++x) {
+        for (uint32_t y = originY; y < originY + side; ++y) {
+            ids.emplace_back(idealZ, 0, CanonicalTileID{idealZ, x, y});
+        }
+    }
+    return ids;
+}
+
+void runUpdateRenderables(benchmark::State& state, const std::vector<OverscaledTileID>& ideal, Tiles& tiles) {
+    for (auto _ : state) {
+        std::size_t rendered = 0;
+        algorithm::updateRenderables(
+            [&](const OverscaledTileID& id) -> FakeTile* {
+                const auto it = tiles.find(id);
+                return it != tiles.end() ? it->second.get() : nullptr;
+            },
+            [](const OverscaledTileID&) -> FakeTile* { return nullptr; },
+            [](FakeTile&, TileNecessity) {},
+            [&](const UnwrappedTileID&, FakeTile&) { ++rendered; },
+            ideal,
+            tiles,
+            Range<uint8_t>{0, 22});
+        benchmark::DoNotOptimize(rendered);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(ideal.size()));
+}
+
+// Every second tile of the pyramid split into three of its children and its parent
+std::map<UnwrappedTileID, FakeTile> renderedPyramid(uint32_t side) {
+    std::map<UnwrappedTileID, FakeTile> renderables;
+    for (const auto& id : idealTiles(side)) {
+        const bool split = (id.canonical.x + id.canonical.y) % 2 == 0;
+        if (!split) {
+            renderables.emplace(id.toUnwrapped(), true);
+            continue;
+        }
+        // One of the children is missing, so that the parent tile is rendered underneath them
+        renderables.emplace(UnwrappedTileID{0, id.canonical.scaledTo(idealZ - 1)}, true);
+        const auto children = id.canonical.children();
+        for (std::size_t i = 0; i < 3; ++i) {
+            renderables.emplace(UnwrappedTileID{0, children[i]}, true);
+        }
+    }
+    return renderables;
+}
+
+} // namespace
+
+// Every second ideal tile loaded, the others covered by their loaded parent
+static void UpdateRenderables_ParentFallback(benchmark::State& state) {
+    const auto ideal = idealTiles(static_cast<uint32_t>(state.range(0)));
+    Tiles tiles;
+    for (const auto& id : ideal) {
+        const bool renderable = (id.canonical.x + id.canonical.y) % 2 == 0;
+        tiles.emplace(id, std::make_unique<FakeTile>(renderable));
+        if (!renderable) {
+            tiles.emplace(id.scaledTo(idealZ - 1), std::make_unique<FakeTile>(true));
+        }
+    }
+    runUpdateRenderables(state, ideal, tiles);
+}
+
+// Tiles as they were prefetched at a higher zoom, then zoomed out of: the ideal
+// tiles still load and only the prefetched tiles two levels below cover them.
+static void UpdateRenderables_PrefetchedFallback(benchmark::State& state) {
+    const auto ideal = idealTiles(static_cast<uint32_t>(state.range(0)));
+    Tiles tiles;
+    for (const auto& id : ideal) {
+        tiles.emplace(id, std::make_unique<FakeTile>(false));
+        const auto first = id.canonical.scaledTo(idealZ + 2);
+        for (uint32_t dx = 0; dx < 4; ++dx) {
+            for (uint32_t dy = 0; dy < 4; ++dy) {
+                const OverscaledTileID prefetched{idealZ + 2, 0, {idealZ + 2, first.x + dx, first.y + dy}};
+                tiles.emplace(prefetched, std::make_unique<FakeTile>(true));
+            }
+        }
+    }
+    runUpdateRenderables(state, ideal, tiles);
+}
+
+// A tile appearing or disappearing each frame, as when panning over a loaded pyramid
+static void TileMasks_Full(benchmark::State& state) {
+    auto renderables = renderedPyramid(static_cast<uint32_t>(state.range(0)));
+    const UnwrappedTileID toggled{idealZ + 2, originX * 4, originY * 4};
+    for (auto _ : state) {
+        if (!renderables.erase(toggled)) {
+            renderables.emplace(toggled, true);
+        }
+        algorithm::updateTileMasks(renderables);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(renderables.size()));
+}
+
+static void TileMasks_Incremental(benchmark::State& state) {
+    auto renderables = renderedPyramid(static_cast<uint32_t>(state.range(0)));
+    const UnwrappedTileID toggled{idealZ + 2, originX * 4, originY * 4};
+    algorithm::TileMaskCache cache;
+    for (auto _ : state) {
+        if (!renderables.erase(toggled)) {
+            renderables.emplace(toggled, true);
+        }
+        algorithm::updateTileMasks(renderables, cache);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(renderables.size()));
+}
+
+BENCHMARK(UpdateRenderables_ParentFallback)->Arg(16)->Arg(32);
+BENCHMARK(UpdateRenderables_PrefetchedFallback)->Arg(16)->Arg(32);
+BENCHMARK(TileMasks_Full)->Arg(16)->Arg(32);
+BENCHMARK(TileMasks_Incremental)->Arg(16)->Arg(32);
@@ -1,7 +1,26 @@
 #include <benchmark/benchmark.h>
 
+#include <mbgl/map/transform_state.hpp>
+#include <mbgl/renderer/image_manager.hpp>
+#include <mbgl/renderer/tile_parameters.hpp>
+#include <mbgl/style/conversion/filter.hpp>
+#include <mbgl/style/conversion/json.hpp>
+#include <mbgl/style/layers/circle_layer.hpp>
+#include <mbgl/style/layers/circle_layer_impl.hpp>
+#include <mbgl/style/layers/fill_layer.hpp>
+#include <mbgl/style/layers/fill_layer_impl.hpp>
+#include <mbgl/style/layers/line_layer.hpp>
+#include <mbgl/style/layers/line_layer_impl.hpp>
+#include <mbgl/text/glyph_manager.hpp>
+#include <mbgl/tile/geometry_tile.hpp>
+#include <mbgl/tile/vector_mlt_tile_data.hpp>
 #include <mbgl/tile/vector_mvt_tile_data.hpp>
 #include <mbgl/util/io.hpp>
+#include <mbgl/util/run_loop.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
 
 using namespace mbgl;
 
@@ -28,3 +47,152 @@ static void Parse_VectorTile(benchmark::State& state) {
 }
 
 BENCHMARK(Parse_VectorTile);
+
+namespace {
+
+enum class Format { MVT, MLT };
+
+// The same tiles encoded in both formats: a street level tile dense in buildings, roads and labels, and the
+// world at zoom 0
+const char* const streetsTile = "metrics/integration/tiles/14-8802-5374";
+const char* const worldTile = "metrics/integration/tiles/0-0-0";
+
+std::shared_ptr<const std::string> readTile(const char* tile, Format format) {
+    const std::string extension = format == Format::MVT ? ".mvt" : ".mlt";
+    return std::make_shared<const std::string>(util::read_file(tile + extension));
+}
+
+/// A new data object each time, so that it's decoded again
+std::unique_ptr<GeometryTileData> decode(const std::shared_ptr<const std::string>& data, Format format) {
+    if (format == Format::MVT) {
+        return std::make_unique<VectorMVTTileData>(data);
+    }
+    return std::make_unique<VectorMLTTileData>(data);
+}
+
+/// The layers of the tile, read from its MVT encoding for both formats to decode the same ones
+std::vector<std::string> layerNames(const char* tile) {
+    return VectorMVTTileData(readTile(tile, Format::MVT)).layerNames();
+}
+
+/// Calls `visit` with every feature of the tile, decoded again, and reports the features per second
+template <typename Visit>
+void forEachFeature(benchmark::State& state, const char* tile, Format format, Visit visit) {
+    const auto data = readTile(tile, format);
+    const auto names = layerNames(tile);
+    std::size_t features = 0;
+    for (auto _ : state) {
+        const auto tileData = decode(data, format);
+        for (const auto& name : names) {
+            if (const auto layer = tileData->getLayer(name)) {
+                const std::size_t count = layer->featureCount();
+                for (std::size_t i = 0; i < count; ++i) {
+                    if (const auto feature = layer->getFeature(i)) {
+                        visit(*feature);
+                        ++features;
+                    }
+                }
+            }
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(features));
+}
+
+void DecodeFeatures(benchmark::State& state, const char* tile, Format format) {
+    forEachFeature(state, tile, format, [](const GeometryTileFeature& feature) {
+        benchmark::DoNotOptimize(feature.getType());
+        benchmark::DoNotOptimize(feature.getID());
+    });
+}
+
+void DecodeGeometries(benchmark::State& state, const char* tile, Format format) {
+    forEachFeature(state, tile, format, [](const GeometryTileFeature& feature) {
+        std::size_t points = 0;
+        for (const auto& geometry : feature.getGeometries()) {
+            points += geometry.size();
+        }
+        benchmark::DoNotOptimize(points);
+    });
+}
+
+void DecodeProperties(benchmark::State& state, const char* tile, Format format) {
+    forEachFeature(state, tile, format, [](const GeometryTileFeature& feature) {
+        benchmark::DoNotOptimize(feature.getProperties().size());
+        benchmark::DoNotOptimize(feature.getValue("class"));
+    });
+}
+
+style::Filter typeFilter(const char* type) {
+    style::conversion::Error error;
+    return *style::conversion::convertJSON<style::Filter>(R"(["==", "$type", ")" + std::string(type) + R"("])",
+                                                          error);
+}
+
+/// A fill, a line and a circle layer for each layer of the tile, each taking the features of its geometry type
+std::vector<Immutable<style::LayerProperties>> bucketLayers(const std::vector<std::string>& names) {
+    std::vector<Immutable<style::LayerProperties>> layers;
+    for (const auto& name : names) {
+        style::FillLayer fill(name + "-fill", "source");
+        fill.setSourceLayer(name);
+        fill.setFilter(typeFilter("Polygon"));
+        layers.push_back(makeMutable<style::FillLayerProperties>(
+            staticImmutableCast<style::FillLayer::Impl>(fill.baseImpl)));
+
+        style::LineLayer line(name + "-line", "source");
+        line.setSourceLayer(name);
+        line.setFilter(typeFilter("LineString"));
+        layers.push_back(makeMutable<style::LineLayerProperties>(
+            staticImmutableCast<style::LineLayer::Impl>(line.baseImpl)));
+
+        style::CircleLayer circle(name + "-circle", "source");
+        circle.setSourceLayer(name);
+        circle.setFilter(typeFilter("Point"));
+        layers.push_back(makeMutable<style::CircleLayerProperties>(
+            staticImmutableCast<style::CircleLayer::Impl>(circle.baseImpl)));
+    }
+    return layers;
+}
+
+// The tile's data decoded and laid out into buckets by its worker, synchronously
+void BuildBuckets(benchmark::State& state, const char* tile, Format format) {
+    util::RunLoop loop;
+    util::SimpleIdentity uniqueID;
+    TransformState transformState;
+    const TileParameters parameters{.pixelRatio = 1.0,
+                                    .debugOptions = MapDebugOptions(),
+                                    .transformState = transformState,
+                                    .fileSource = nullptr,
+                                    .mode = MapMode::Continuous,
+                                    .annotationManager = {},
+                                    .imageManager = ImageManager::create(),
+                                    .glyphManager = std::make_shared<GlyphManager>(),
+                                    .prefetchZoomDelta = 0,
+                                    .threadPool = {Scheduler::GetBackground(), uniqueID},
+                                    .isUpdateSynchronous = true};
+
+    const auto data = readTile(tile, format);
+    const auto layers = bucketLayers(layerNames(tile));
+    for (auto _ : state) {
+        GeometryTile geometryTile(OverscaledTileID(14, 0, 0), "source", parameters);
+        geometryTile.setLayers(layers);
+        geometryTile.setData(decode(data, format));
+        benchmark::DoNotOptimize(geometryTile.isRenderable());
+    }
+}
+
+} // namespace
+
+BENCHMARK_CAPTURE(DecodeFeatures, MVTStreets, streetsTile, Format::MVT);
+BENCHMARK_CAPTURE(DecodeFeatures, MLTStreets, streetsTile, Format::MLT);
+BENCHMARK_CAPTURE(DecodeFeatures, MVTWorld, worldTile, Format::MVT);
+BENCHMARK_CAPTURE(DecodeFeatures, MLTWorld, worldTile, Format::MLT);
+BENCHMARK_CAPTURE(DecodeGeometries, MVTStreets, streetsTile, Format::MVT);
+BENCHMARK_CAPTURE(DecodeGeometries, MLTStreets, streetsTile, Format::MLT);
+BENCHMARK_CAPTURE(DecodeGeometries, MVTWorld, worldTile, Format::MVT);
+BENCHMARK_CAPTURE(DecodeGeometries, MLTWorld, worldTile, Format::MLT);
+BENCHMARK_CAPTURE(DecodeProperties, MVTStreets, streetsTile, Format::MVT);
+BENCHMARK_CAPTURE(DecodeProperties, MLTStreets, streetsTile, Format::MLT);
+BENCHMARK_CAPTURE(BuildBuckets, MVTStreets, streetsTile, Format::MVT)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BuildBuckets, MLTStreets, streetsTile, Format::MLT)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BuildBuckets, MVTWorld, worldTile, Format::MVT)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BuildBuckets, MLTWorld, worldTile, Format::MLT)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,83 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/benchmark/stub_geometry_tile_feature.hpp>
+
+#include <mbgl/renderer/buckets/circle_bucket.hpp>
+#include <mbgl/style/expression/dsl.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace mbgl;
+using namespace mbgl::style;
+
+namespace {
+
+constexpr std::size_t verticesPerFeature = 4;
+
+class StubGeometryTileLayer : public GeometryTileLayer {
+public:
+    explicit StubGeometryTileLayer(std::vector<StubGeometryTileFeature> features_)
+        : features(std::move(features_)) {}
+
+    std::size_t featureCount() const override { return features.size(); }
+    std::unique_ptr<GeometryTileFeature> getFeature(std::size_t i) const override {
+        return std::make_unique<StubGeometryTileFeature>(features[i]);
+    }
+    std::string getName() const override { return "choropleth"; }
+
+private:
+    std::vector<StubGeometryTileFeature> features;
+};
+
+FeatureIdentifier featureID(std::size_t i, bool numeric) {
+    if (numeric) {
+        return static_cast<uint64_t>(i);
+    }
+    return "feature-" + std::to_string(i);
+}
+
+// The hover state of a choropleth, its color changing with the feature state
+void updateFeatureStates(benchmark::State& state, bool numeric) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+
+    CirclePaintProperties::PossiblyEvaluated evaluated;
+    evaluated.get<CircleColor>() = PossiblyEvaluatedPropertyValue<Color>(
+        PropertyExpression<Color>(expression::dsl::createExpression(
+            R"(["case", ["to-boolean", ["feature-state", "hover"]], ["rgb", 255, 0, 0], ["rgb", 0, 0, 255]])")));
+    CircleBinders binders{evaluated, 0};
+
+    std::vector<StubGeometryTileFeature> features;
+    features.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        features.emplace_back(featureID(i, numeric), FeatureType::Point, GeometryCollection{}, PropertyMap());
+        binders.populateVertexVectors(
+            features.back(), (i + 1) * verticesPerFeature, i, {}, {}, CanonicalTileID(0, 0, 0));
+    }
+    const StubGeometryTileLayer layer{std::move(features)};
+
+    // Every tenth feature changes its state, as a hover sweeping over the map would
+    FeatureStates states;
+    for (std::size_t i = 0; i < count; i += 10) {
+        states[*featureIDtoString(featureID(i, numeric))] = FeatureState{{"hover", true}};
+    }
+
+    for (auto _ : state) {
+        binders.updateVertexVectors(states, layer, {});
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(states.size()));
+}
+
+} // namespace
+
+static void FeatureState_UpdateNumericIDs(benchmark::State& state) {
+    updateFeatureStates(state, true);
+}
+
+static void FeatureState_UpdateStringIDs(benchmark::State& state) {
+    updateFeatureStates(state, false);
+}
+
+BENCHMARK(FeatureState_UpdateNumericIDs)->Arg(1000)->Arg(100000);
+BENCHMARK(FeatureState_UpdateStringIDs)->Arg(1000)->Arg(100000);
@@ -0,0 +1,124 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/renderer/buckets/symbol_bucket.hpp>
+#include <mbgl/style/variable_anchor_offset_collection.hpp>
+#include <mbgl/util/constants.hpp>
+
+#include <memory>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace mbgl;
+
+namespace {
+
+SymbolInstance makeSymbolInstance(float x, float y, std::size_t index) {
+    const ShapedTextOrientations shaping{};
+    style::SymbolLayoutProperties::Evaluated layout;
+    IndexedSubfeature subfeature(index, {}, {}, 0);
+    Anchor anchor(x, y, 0, 0);
+    const std::array<float, 2> offset{{0.0f, 0.0f}};
+    const auto placementType = style::SymbolPlacementType::Point;
+
+    auto sharedData = std::make_shared<SymbolInstanceSharedData>(GeometryCoordinates{},
+                                                                 shaping,
+                                                                 std::nullopt,
+                                                                 std::nullopt,
+                                                                 layout,
+                                                                 placementType,
+                                                                 offset,
+                                                                 ImageMap{},
+                                                                 0.0f,
+                                                                 SymbolContent::None,
+                                                                 false,
+                                                                 false);
+    return SymbolInstance(anchor,
+                          std::move(sharedData),
+                          shaping,
+                          std::nullopt,
+                          std::nullopt,
+                          0,
+                          0,
+                          placementType,
+                          offset,
+                          0,
+                          0,
+                          offset,
+                          subfeature,
+                          index,
+                          index,
+                          u"label",
+                          0.0f,
+                          0.0f,
+                          0.0f,
+                          std::nullopt,
+                          false);
+}
+
+std::unique_ptr<SymbolBucket> makeBucket(std::size_t count) {
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<float> coordinate(0.0f, static_cast<float>(util::EXTENT));
+    std::vector<SymbolInstance> instances;
+    instances.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        instances.push_back(makeSymbolInstance(coordinate(generator), coordinate(generator), i));
+    }
+
+    auto bucket = std::make_unique<SymbolBucket>(makeMutable<style::SymbolLayoutProperties::PossiblyEvaluated>(),
+                                                 std::map<std::string, Immutable<style::LayerProperties>>{},
+                                                 16.0f,
+                                                 1.0f,
+                                                 0.0f,
+                                                 false,
+                                                 true,
+                                                 "labels",
+                                                 std::move(instances),
+                                                 std::vector<SortKeyRange>{},
+                                                 1.0f,
+                                                 false,
+                                                 std::vector<style::TextWritingModeType>{},
+                                                 false);
+    for (std::size_t i = 0; i < count; ++i) {
+        bucket->placementFields.crossTileIDs.push_back(static_cast<uint32_t>(i + 1));
+    }
+    return bucket;
+}
+
+} // namespace
+
+// The bearing changing every frame, as while rotating the map, so that the symbols are sorted again each time
+static void SymbolPlacement_SortByViewportY(benchmark::State& state) {
+    const auto bucket = makeBucket(static_cast<std::size_t>(state.range(0)));
+    float angle = 0.0f;
+    for (auto _ : state) {
+        angle += 0.1f;
+        benchmark::DoNotOptimize(bucket->getSortedSymbols(angle));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// The walk placement makes over the sorted symbols, half of them already placed from another tile
+static void SymbolPlacement_SkipPlacedSymbols(benchmark::State& state) {
+    const auto bucket = makeBucket(static_cast<std::size_t>(state.range(0)));
+    const auto sortedSymbols = bucket->getSortedSymbols(0.0f);
+    std::set<uint32_t> seenCrossTileIDs;
+    for (uint32_t id = 1; id <= bucket->symbolInstances.size(); id += 2) {
+        seenCrossTileIDs.insert(id);
+    }
+
+    for (auto _ : state) {
+        std::size_t placed = 0;
+        for (const SymbolInstance& symbol : sortedSymbols) {
+            const auto index = static_cast<std::size_t>(&symbol - bucket->symbolInstances.data());
+            if (seenCrossTileIDs.contains(bucket->placementFields.crossTileIDs[index])) continue;
+            placed += symbol.hasText() ? 1 : 0;
+        }
+        benchmark::DoNotOptimize(placed);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(SymbolPlacement_SortByViewportY)->Arg(1000)->Arg(20000);
+BENCHMARK(SymbolPlacement_SkipPlacedSymbols)->Arg(1000)->Arg(20000);
@@ -0,0 +1,306 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/storage/file_source.hpp>
+#include <mbgl/storage/file_source_manager.hpp>
+#include <mbgl/storage/main_resource_loader.hpp>
+#include <mbgl/storage/mbtiles_file_source.hpp>
+#include <mbgl/storage/pmtiles_file_source.hpp>
+#include <mbgl/storage/resource.hpp>
+#include <mbgl/storage/resource_options.hpp>
+#include <mbgl/storage/response.hpp>
+#include <mbgl/storage/sqlite3.hpp>
+#include <mbgl/util/async_request.hpp>
+#include <mbgl/util/chrono.hpp>
+#include <mbgl/util/client_options.hpp>
+#include <mbgl/util/constants.hpp>
+#include <mbgl/util/io.hpp>
+#include <mbgl/util/run_loop.hpp>
+#include <mbgl/util/string.hpp>
+#include <mbgl/util/timer.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace mbgl;
+
+namespace {
+
+constexpr std::size_t requestsPerIteration = 256;
+const std::string mockHost = "http://bench.test/";
+
+// The latency of the mock network, in milliseconds
+std::atomic<int64_t> networkLatency{0};
+
+/// The files served by the mock network, by URL. Other URLs get a tile of 16 KiB.
+std::map<std::string, std::shared_ptr<const std::string>>& mockFiles() {
+    static std::map<std::string, std::shared_ptr<const std::string>> files;
+    return files;
+}
+
+class MockRequest : public AsyncRequest {
+public:
+    util::Timer timer;
+};
+
+/// Stands in for the network: responds after `networkLatency`, from the run loop of the thread asking, and
+/// honors the byte ranges the PMTiles source reads the archive with
+class MockNetworkFileSource : public FileSource {
+public:
+    MockNetworkFileSource(const ResourceOptions& resourceOptions_, const ClientOptions& clientOptions_)
+        : resourceOptions(resourceOptions_.clone()),
+          clientOptions(clientOptions_.clone()) {}
+
+    std::unique_ptr<AsyncRequest> request(const Resource& resource, Callback callback) override {
+        auto request = std::make_unique<MockRequest>();
+        request->timer.start(
+            Milliseconds(networkLatency.load()), Duration::zero(), [resource, callback = std::move(callback)] {
+                static const auto tile = std::make_shared<const std::string>(16 * 1024, 'x');
+                const auto it = mockFiles().find(resource.url);
+                const auto data = it != mockFiles().end() ? it->second : tile;
+
+                Response response;
+                response.expires = util::now() + std::chrono::hours(1);
+                if (resource.dataRange) {
+                    const auto& [first, last] = *resource.dataRange;
+                    response.data = std::make_shared<const std::string>(data->substr(first, last - first + 1));
+                } else {
+                    response.data = data;
+                }
+                callback(response);
+            });
+        return request;
+    }
+
+    bool canRequest(const Resource& resource) const override { return resource.url.starts_with(mockHost); }
+
+    void setResourceOptions(ResourceOptions options) override { resourceOptions = options; }
+    ResourceOptions getResourceOptions() override { return resourceOptions.clone(); }
+    void setClientOptions(ClientOptions options) override { clientOptions = options; }
+    ClientOptions getClientOptions() override { return clientOptions.clone(); }
+
+private:
+    ResourceOptions resourceOptions;
+    ClientOptions clientOptions;
+};
+
+/// Replaces the network file source with the mock one while it lives
+class MockNetwork {
+public:
+    explicit MockNetwork(Milliseconds latency) {
+        networkLatency = latency.count();
+        previous = FileSourceManager::get()->unRegisterFileSourceFactory(FileSourceType::Network);
+        FileSourceManager::get()->registerFileSourceFactory(
+            FileSourceType::Network, [](const ResourceOptions& resourceOptions, const ClientOptions& clientOptions) {
+                return std::make_unique<MockNetworkFileSource>(resourceOptions, clientOptions);
+            });
+    }
+
+    ~MockNetwork() {
+        FileSourceManager::get()->unRegisterFileSourceFactory(FileSourceType::Network);
+        if (previous) {
+            FileSourceManager::get()->registerFileSourceFactory(FileSourceType::Network, std::move(previous));
+        }
+    }
+
+private:
+    FileSourceManager::FileSourceFactory previous;
+};
+
+/// Tiles of the given zoom levels, picked at random, repeats included
+std::vector<Resource> randomTiles(const std::string& url, uint8_t maxZoom, std::size_t count) {
+    std::mt19937 random(42);
+    std::vector<Resource> tiles;
+    tiles.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto z = static_cast<int8_t>(random() % (maxZoom + 1u));
+        const auto x = static_cast<int32_t>(random() % (1u << z));
+        const auto y = static_cast<int32_t>(random() % (1u << z));
+        tiles.push_back(Resource::tile(url, 1.0f, x, y, z, Tileset::Scheme::XYZ));
+    }
+    return tiles;
+}
+
+/// Requests every resource, keeping `concurrency` requests in flight, and adds the time each took to `latencies`.
+/// Returns the number of requests that failed.
+std::size_t requestAll(util::RunLoop& loop,
+                       FileSource& fileSource,
+                       const std::vector<Resource>& resources,
+                       std::size_t concurrency,
+                       std::vector<Duration>& latencies) {
+    std::vector<std::unique_ptr<AsyncRequest>> requests(resources.size());
+    std::size_t next = 0;
+    std::size_t done = 0;
+    std::size_t errors = 0;
+
+    std::function<void()> requestNext = [&] {
+        const std::size_t index = next++;
+        const TimePoint start = Clock::now();
+        requests[index] = fileSource.request(resources[index], [&, index, start](const Response& response) {
+            latencies.push_back(Clock::now() - start);
+            errors += response.error ? 1 : 0;
+            requests[index].reset();
+            if (next < resources.size()) {
+                requestNext();
+            }
+            if (++done == resources.size()) {
+                loop.stop();
+            }
+        });
+    };
+
+    for (std::size_t i = 0; i < std::min(concurrency, resources.size()); ++i) {
+        requestNext();
+    }
+    loop.run();
+    return errors;
+}
+
+/// Tiles per second, and the median and 99th percentile of the time a request took
+void reportLatencies(benchmark::State& state, std::vector<Duration>& latencies) {
+    state.SetItemsProcessed(static_cast<int64_t>(latencies.size()));
+    if (latencies.empty()) {
+        return;
+    }
+    const auto percentile = [&](double fraction) {
+        const auto nth = latencies.begin() + static_cast<std::ptrdiff_t>(fraction * (latencies.size() - 1));
+        std::nth_element(latencies.begin(), nth, latencies.end());
+        return std::chrono::duration<double, std::milli>(*nth).count();
+    };
+    state.counters["p50_ms"] = percentile(0.5);
+    state.counters["p99_ms"] = percentile(0.99);
+}
+
+/// Runs the requests of each iteration against `fileSource`, skipping with an error if any failed
+void benchmarkRequests(benchmark::State& state,
+                       util::RunLoop& loop,
+                       FileSource& fileSource,
+                       const std::function<std::vector<Resource>()>& resources) {
+    const auto concurrency = static_cast<std::size_t>(state.range(0));
+    std::vector<Duration> latencies;
+    for (auto _ : state) {
+        state.PauseTiming();
+        const auto iterationResources = resources();
+        state.ResumeTiming();
+
+        if (requestAll(loop, fileSource, iterationResources, concurrency, latencies) != 0) {
+            state.SkipWithError("Failed requests");
+            return;
+        }
+    }
+    reportLatencies(state, latencies);
+}
+
+std::string pmtilesPath() {
+    return std::filesystem::absolute("test/fixtures/storage/pmtiles/geography-class-png.pmtiles").string();
+}
+
+// The archive's tiles, of zoom levels 0 and 1, read from the local file
+void FileSource_PMTilesLocal(benchmark::State& state) {
+    util::RunLoop loop;
+    PMTilesFileSource pmtiles(ResourceOptions::Default(), ClientOptions());
+    const auto url = std::string(util::PMTILES_PROTOCOL) + util::FILE_PROTOCOL + pmtilesPath();
+    const auto tiles = randomTiles(url, 1, requestsPerIteration);
+    benchmarkRequests(state, loop, pmtiles, [&] { return tiles; });
+}
+
+// The same archive read through the main resource loader from the mock network, `state.range(1)` ms away. The
+// header and directories are only read in the first iteration.
+void FileSource_PMTilesHTTP(benchmark::State& state) {
+    const MockNetwork network(Milliseconds(state.range(1)));
+    const auto archiveURL = mockHost + "geography-class-png.pmtiles";
+    mockFiles()[archiveURL] = std::make_shared<const std::string>(util::read_file(pmtilesPath()));
+
+    util::RunLoop loop;
+    PMTilesFileSource pmtiles(ResourceOptions::Default().withCachePath(":memory:"), ClientOptions());
+    const auto tiles = randomTiles(util::PMTILES_PROTOCOL + archiveURL, 1, requestsPerIteration);
+    benchmarkRequests(state, loop, pmtiles, [&] { return tiles; });
+
+    mockFiles().erase(archiveURL);
+}
+
+// Random reads of an MBTiles file of zoom levels 0 to 5, 8 KiB a tile
+void FileSource_MBTiles(benchmark::State& state) {
+    constexpr uint8_t maxZoom = 5;
+    const auto path = std::filesystem::absolute("benchmark/fixtures/file_source.mbtiles").string();
+    util::deleteFile(path);
+    {
+        auto db = mapbox::sqlite::Database::open(path, mapbox::sqlite::ReadWriteCreate);
+        db.exec("CREATE TABLE metadata (name TEXT, value TEXT)");
+        db.exec("CREATE TABLE tiles (zoom_level INTEGER, tile_column INTEGER, tile_row INTEGER, tile_data BLOB)");
+        db.exec("CREATE UNIQUE INDEX tile_index ON tiles (zoom_level, tile_column, tile_row)");
+        mapbox::sqlite::Transaction transaction(db);
+        mapbox::sqlite::Statement stmt{db, "INSERT INTO tiles VALUES (?1, ?2, ?3, randomblob(8192))"};
+        for (int32_t z = 0; z <= maxZoom; ++z) {
+            for (int32_t x = 0; x < (1 << z); ++x) {
+                for (int32_t y = 0; y < (1 << z); ++y) {
+                    mapbox::sqlite::Query query{stmt};
+                    query.bind(1, z);
+                    query.bind(2, x);
+                    query.bind(3, y);
+                    query.run();
+                }
+            }
+        }
+        transaction.commit();
+    }
+
+    {
+        util::RunLoop loop;
+        MBTilesFileSource mbtiles(ResourceOptions::Default(), ClientOptions());
+        const auto tiles = randomTiles("mbtiles://" + path + "?file={z}/{x}/{y}.png", maxZoom, requestsPerIteration);
+        benchmarkRequests(state, loop, mbtiles, [&] { return tiles; });
+    }
+
+    util::deleteFile(path);
+}
+
+// Tiles the ambient cache doesn't have yet, fetched from the mock network, `state.range(1)` ms away, and stored
+void FileSource_ResourceLoaderCold(benchmark::State& state) {
+    const MockNetwork network(Milliseconds(state.range(1)));
+    util::RunLoop loop;
+    MainResourceLoader loader(ResourceOptions::Default().withCachePath(":memory:"), ClientOptions());
+
+    // Tiles of another URL each iteration, so that none are cached
+    std::size_t iteration = 0;
+    benchmarkRequests(state, loop, loader, [&] {
+        return randomTiles(mockHost + util::toString(iteration++) + "/{z}/{x}/{y}.pbf", 14, requestsPerIteration);
+    });
+}
+
+// The same tiles again, each fresh in the ambient cache
+void FileSource_ResourceLoaderWarm(benchmark::State& state) {
+    const MockNetwork network(Milliseconds(0));
+    util::RunLoop loop;
+    MainResourceLoader loader(ResourceOptions::Default().withCachePath(":memory:"), ClientOptions());
+
+    const auto tiles = randomTiles(mockHost + "{z}/{x}/{y}.pbf", 14, requestsPerIteration);
+    std::vector<Duration> warmUp;
+    requestAll(loop, loader, tiles, requestsPerIteration, warmUp);
+    benchmarkRequests(state, loop, loader, [&] { return tiles; });
+}
+
+} // namespace
+
+BENCHMARK(FileSource_PMTilesLocal)->ArgName("concurrency")->Arg(1)->Arg(8)->Arg(32)->UseRealTime();
+BENCHMARK(FileSource_PMTilesHTTP)
+    ->ArgNames({"concurrency", "latency"})
+    ->Args({8, 0})
+    ->Args({8, 20})
+    ->Args({32, 20})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK(FileSource_MBTiles)->ArgName("concurrency")->Arg(1)->Arg(8)->Arg(32)->UseRealTime();
+BENCHMARK(FileSource_ResourceLoaderCold)
+    ->ArgNames({"concurrency", "latency"})
+    ->Args({8, 0})
+    ->Args({32, 20})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK(FileSource_ResourceLoaderWarm)->ArgName("concurrency")->Arg(1)->Arg(8)->Arg(32)->UseRealTime();
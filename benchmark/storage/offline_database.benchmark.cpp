@@ -4,6 +4,7 @@
 #include <mbgl/storage/resource.hpp>
 #include <mbgl/storage/response.hpp>
 #include <mbgl/storage/sqlite3.hpp>
+#include <mbgl/util/io.hpp>
 #include <mbgl/util/string.hpp>
 #include <mbgl/util/logging.hpp>
 
@@ -200,3 +201,133 @@ BENCHMARK_F(OfflineDatabase, ResizeDatabase)(benchmark::State& state) {
         }
     }
 }
+
+// Adds tiles to an ambient cache that's already full, so that every put has to evict. The cache
+// is filled with `state.range(0)` GiB of 64 KiB tiles, written directly to speed up the setup.
+static void OfflineDatabase_EvictFromFullCache(benchmark::State& state) {
+    using namespace mbgl;
+
+    const std::string path = "benchmark/fixtures/evict.db";
+    const int64_t tileSize = 64 * 1024;
+    const int64_t tileCount = (state.range(0) << 30) / tileSize;
+
+    util::deleteFile(path);
+    {
+        // Creates the schema
+        mbgl::OfflineDatabase db(path, TileServerOptions::DefaultConfiguration());
+    }
+    {
+        auto db = mapbox::sqlite::Database::open(path, mapbox::sqlite::ReadWriteCreate);
+        // clang-format off
+        mapbox::sqlite::Statement stmt{ db,
+            "WITH RECURSIVE n(i) AS (SELECT 0 UNION ALL SELECT i + 1 FROM n WHERE i + 1 < ?1) "
+            "INSERT INTO tiles (url_template, pixel_ratio, z, x, y, data, accessed) "
+            "SELECT 'mapbox://EvictFromFullCache/fill', 1, 20, i, 0, randomblob(?2), i / 100 FROM n" };
+        // clang-format on
+        mapbox::sqlite::Query query{stmt};
+        query.bind(1, tileCount);
+        query.bind(2, tileSize);
+        query.run();
+    }
+
+    std::string data(tileSize, 0);
+    std::mt19937 random;
+    for (auto& byte : data) {
+        byte = static_cast<char>(random());
+    }
+    Response response;
+    response.data = std::make_shared<std::string>(std::move(data));
+
+    {
+        mbgl::OfflineDatabase db(path, TileServerOptions::DefaultConfiguration());
+        db.setMaximumAmbientCacheSize(tileCount * tileSize);
+
+        while (state.KeepRunning()) {
+            const Resource ambient = Resource::tile(
+                "mapbox://EvictFromFullCache" + util::toString(state.iterations()), 1, 0, 0, 0, Tileset::Scheme::XYZ);
+            db.put(ambient, response);
+        }
+    }
+
+    util::deleteFile(path);
+}
+
+BENCHMARK(OfflineDatabase_EvictFromFullCache)->Arg(1)->Arg(10)->Unit(benchmark::kMillisecond);
+
+namespace {
+
+// Tiles sharing a vocabulary, as the vector tiles of a style do
+std::vector<mbgl::Response> tileLikeResponses(std::size_t count, std::size_t size) {
+    const std::vector<std::string> words{
+        "highway", "residential", "building", "water", "landuse", "name", "class", "rank", "poi", "road"};
+    std::mt19937 random;
+    std::vector<mbgl::Response> responses(count);
+    for (auto& response : responses) {
+        auto data = std::make_shared<std::string>();
+        while (data->size() < size) {
+            *data += words[random() % words.size()] + mbgl::util::toString(random() % 1000);
+        }
+        response.data = std::move(data);
+    }
+    return responses;
+}
+
+mbgl::Resource compressedTile(std::size_t i) {
+    return mbgl::Resource::tile(
+        "mapbox://CompressedTiles/{z}/{x}/{y}", 1, static_cast<int32_t>(i), 0, 20, mbgl::Tileset::Scheme::XYZ);
+}
+
+} // namespace
+
+// Writes tiles compressed with Deflate (0) or with zstd and a trained dictionary (1), reporting the
+// stored size relative to the raw tiles. The first 4 MiB are compressed with Deflate while the
+// dictionary is trained from them.
+static void OfflineDatabase_WriteCompressedTiles(benchmark::State& state) {
+    using namespace mbgl;
+
+    const auto responses = tileLikeResponses(400, 32 * 1024);
+    std::size_t rawBytes = 0;
+    std::size_t storedBytes = 0;
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        mbgl::OfflineDatabase db(":memory:", TileServerOptions::DefaultConfiguration());
+        db.setZstdTileCompression(state.range(0) != 0);
+        state.ResumeTiming();
+
+        for (std::size_t i = 0; i < responses.size(); ++i) {
+            storedBytes += db.put(compressedTile(i), responses[i]).second;
+            rawBytes += responses[i].data->size();
+        }
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(rawBytes));
+    state.counters["stored_ratio"] = static_cast<double>(storedBytes) / static_cast<double>(rawBytes);
+}
+
+// Reads and decompresses tiles stored with Deflate (0) or with zstd and a trained dictionary (1)
+static void OfflineDatabase_ReadCompressedTiles(benchmark::State& state) {
+    using namespace mbgl;
+
+    const auto responses = tileLikeResponses(400, 32 * 1024);
+    mbgl::OfflineDatabase db(":memory:", TileServerOptions::DefaultConfiguration());
+    db.setZstdTileCompression(state.range(0) != 0);
+    for (std::size_t i = 0; i < responses.size(); ++i) {
+        db.put(compressedTile(i), responses[i]);
+    }
+
+    std::size_t rawBytes = 0;
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < responses.size(); ++i) {
+            // Read back decompressed, whichever compression the tile was stored with
+            const auto data = db.get(compressedTile(i))->data;
+            benchmark::DoNotOptimize(data);
+            rawBytes += data->size();
+        }
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(rawBytes));
+}
+
+BENCHMARK(OfflineDatabase_WriteCompressedTiles)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+BENCHMARK(OfflineDatabase_ReadCompressedTiles)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
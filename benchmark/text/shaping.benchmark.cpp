@@ -0,0 +1,169 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/text/bidi.hpp>
+#include <mbgl/text/quads.hpp>
+#include <mbgl/text/shaping.hpp>
+#include <mbgl/text/tagged_string.hpp>
+#include <mbgl/util/constants.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace mbgl;
+
+namespace {
+
+// Stands for a font served as TrueType and shaped through HarfBuzz rather than as glyph PBFs
+const auto harfBuzzType = static_cast<GlyphIDType>(1);
+
+const std::u16string latinText = u"Avenue of the Americas at West Fourteenth Street";
+const std::u16string cjkText = u"東京都千代田区丸の内一丁目九番一号東京駅八重洲中央口";
+const std::u16string arabicText = u"شارع الملك فيصل بالقرب من ميدان التحرير في وسط القاهرة";
+// Devanagari, which the glyph PBFs can't render
+const std::u16string complexText = u"राष्ट्रीय राजमार्ग";
+
+class ShapingFixture {
+public:
+    ShapingFixture()
+        : fontStack(std::make_shared<const FontStack>(FontStack{"Noto Sans Regular"})),
+          fontStackHash(FontStackHasher()(*fontStack)) {}
+
+    /// Gives every character of the text a glyph of the usual size, as the glyph manager would once loaded
+    void addGlyphs(const std::u16string& text, GlyphIDType type = GlyphIDType::FontPBF) {
+        for (const char16_t code : text) {
+            const GlyphID id(code, type);
+            GlyphMetrics metrics;
+            metrics.width = 18;
+            metrics.height = 18;
+            metrics.left = 2;
+            metrics.top = -8;
+            metrics.advance = 21;
+
+            auto glyph = makeMutable<Glyph>();
+            glyph->id = id;
+            glyph->metrics = metrics;
+            glyphs[fontStackHash][id] = Immutable<Glyph>(std::move(glyph));
+            glyphPositions[fontStackHash][id] = GlyphPosition{Rect<uint16_t>(0, 0, 24, 24), metrics};
+        }
+    }
+
+    TaggedString taggedString(const std::u16string& text) const {
+        return {text, SectionOptions(1.0, fontStack, GlyphIDType::FontPBF, 0)};
+    }
+
+    /// A label with a part shaped the way HarfBuzz output is laid out: glyph indices of a font, with adjusts
+    TaggedString mixedString() const {
+        TaggedString string;
+        string.addTextSection(latinText.substr(0, 17), 1.0, fontStack, GlyphIDType::FontPBF);
+        auto adjusts = std::make_shared<std::vector<HBShapeAdjust>>(complexText.size(), HBShapeAdjust(0.5f, 0.0f, 19));
+        string.addTextSection(complexText, 1.0, fontStack, harfBuzzType, adjusts);
+        return string;
+    }
+
+    Shaping shape(const TaggedString& string, WritingModeType writingMode = WritingModeType::Horizontal) {
+        return getShaping(string,
+                          10 * util::ONE_EM,
+                          1.2f * util::ONE_EM,
+                          style::SymbolAnchorType::Center,
+                          style::TextJustifyType::Center,
+                          0.0f,
+                          {{0.0f, 0.0f}},
+                          writingMode,
+                          bidi,
+                          glyphs,
+                          glyphPositions,
+                          imagePositions,
+                          16.0f,
+                          16.0f,
+                          writingMode == WritingModeType::Vertical);
+    }
+
+    const std::shared_ptr<const FontStack> fontStack;
+    const FontStackHash fontStackHash;
+    GlyphMap glyphs;
+    GlyphPositions glyphPositions;
+    ImagePositions imagePositions;
+    BiDi bidi;
+};
+
+void shapeText(benchmark::State& state, const std::u16string& text, WritingModeType writingMode) {
+    ShapingFixture fixture;
+    fixture.addGlyphs(text);
+    const auto string = fixture.taggedString(text);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(fixture.shape(string, writingMode));
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(text.size()));
+}
+
+void glyphQuads(benchmark::State& state, style::SymbolPlacementType placement) {
+    ShapingFixture fixture;
+    fixture.addGlyphs(latinText);
+    const auto shaping = fixture.shape(fixture.taggedString(latinText));
+    style::SymbolLayoutProperties::Evaluated layout;
+    const ImageMap imageMap;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(getGlyphQuads(shaping, {{0.0f, 0.0f}}, layout, placement, imageMap, false));
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(latinText.size()));
+}
+
+} // namespace
+
+// A long road name, broken into lines
+static void Shaping_Latin(benchmark::State& state) {
+    shapeText(state, latinText, WritingModeType::Horizontal);
+}
+
+static void Shaping_CJK(benchmark::State& state) {
+    shapeText(state, cjkText, WritingModeType::Horizontal);
+}
+
+// The upright glyphs of CJK text placed along a vertical line
+static void Shaping_CJKVertical(benchmark::State& state) {
+    shapeText(state, cjkText, WritingModeType::Vertical);
+}
+
+// Shaped into presentation forms the way symbol layout does, then reordered from right to left
+static void Shaping_Arabic(benchmark::State& state) {
+    const auto shaped = applyArabicShaping(arabicText);
+    shapeText(state, shaped, WritingModeType::Horizontal);
+}
+
+// The shaping of the features' text into presentation forms alone
+static void Shaping_ArabicPresentationForms(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(applyArabicShaping(arabicText));
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(arabicText.size()));
+}
+
+// Text HarfBuzz shaped into glyph indices and adjusts, next to text from glyph PBFs
+static void Shaping_HarfBuzzSections(benchmark::State& state) {
+    ShapingFixture fixture;
+    fixture.addGlyphs(latinText);
+    fixture.addGlyphs(complexText, harfBuzzType);
+    const auto string = fixture.mixedString();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(fixture.shape(string));
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(string.length()));
+}
+
+static void GlyphQuads_Point(benchmark::State& state) {
+    glyphQuads(state, style::SymbolPlacementType::Point);
+}
+
+static void GlyphQuads_Line(benchmark::State& state) {
+    glyphQuads(state, style::SymbolPlacementType::Line);
+}
+
+BENCHMARK(Shaping_Latin);
+BENCHMARK(Shaping_CJK);
+BENCHMARK(Shaping_CJKVertical);
+BENCHMARK(Shaping_Arabic);
+BENCHMARK(Shaping_ArabicPresentationForms);
+BENCHMARK(Shaping_HarfBuzzSections);
+BENCHMARK(GlyphQuads_Point);
+BENCHMARK(GlyphQuads_Line);
@@ -0,0 +1,88 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/map/transform_state.hpp>
+#include <mbgl/text/collision_index.hpp>
+
+#include <random>
+#include <vector>
+
+using namespace mbgl;
+
+namespace {
+
+constexpr float viewportSize = 1024;
+
+// Label-sized boxes scattered over the viewport and its padding, in placement order
+std::vector<ProjectedCollisionBox> makeBoxes(std::size_t count, uint32_t seed) {
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<float> position(0, viewportSize + 200);
+    std::uniform_real_distribution<float> width(20, 120);
+    std::uniform_real_distribution<float> height(10, 24);
+
+    std::vector<ProjectedCollisionBox> boxes;
+    boxes.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const float x = position(generator);
+        const float y = position(generator);
+        boxes.emplace_back(x, y, x + width(generator), y + height(generator));
+    }
+    return boxes;
+}
+
+TransformState makeState() {
+    TransformState state;
+    state.setSize({static_cast<uint32_t>(viewportSize), static_cast<uint32_t>(viewportSize)});
+    return state;
+}
+
+// Greedy placement of every box against the ones placed before it, like a placement cycle does
+void CollisionIndexPlace(benchmark::State& state) {
+    const auto transformState = makeState();
+    const auto boxes = makeBoxes(static_cast<std::size_t>(state.range(0)), 1);
+    const IndexedSubfeature subfeature(0, {}, {}, 0);
+    const GeometryCoordinates line;
+    const CollisionFeature feature(line, Anchor(0, 0, 0), std::nullopt, 1.0f, Padding{}, subfeature, 0.0f);
+
+    std::size_t placed = 0;
+    for (auto _ : state) {
+        CollisionIndex index(transformState, MapMode::Continuous);
+        for (const auto& box : boxes) {
+            std::vector<ProjectedCollisionBox> projected{box};
+            if (index.placeShiftedFeature(projected, {0, 0}, false, std::nullopt).first) {
+                index.insertFeature(feature, projected, false, 1, 0);
+                ++placed;
+            }
+        }
+    }
+    benchmark::DoNotOptimize(placed);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Hit tests against a dense grid, most of which collide
+void CollisionIndexHitTest(benchmark::State& state) {
+    const auto transformState = makeState();
+    const IndexedSubfeature subfeature(0, {}, {}, 0);
+    const GeometryCoordinates line;
+    const CollisionFeature feature(line, Anchor(0, 0, 0), std::nullopt, 1.0f, Padding{}, subfeature, 0.0f);
+
+    CollisionIndex index(transformState, MapMode::Continuous);
+    for (const auto& box : makeBoxes(static_cast<std::size_t>(state.range(0)), 2)) {
+        index.insertFeature(feature, {box}, false, 1, 0);
+    }
+    const auto queries = makeBoxes(1000, 3);
+
+    std::size_t hits = 0;
+    for (auto _ : state) {
+        for (const auto& query : queries) {
+            std::vector<ProjectedCollisionBox> projected{query};
+            hits += index.placeShiftedFeature(projected, {0, 0}, false, std::nullopt).first ? 0 : 1;
+        }
+    }
+    benchmark::DoNotOptimize(hits);
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(queries.size()));
+}
+
+} // namespace
+
+BENCHMARK(CollisionIndexPlace)->Arg(1000)->Arg(10000);
+BENCHMARK(CollisionIndexHitTest)->Arg(1000)->Arg(10000);
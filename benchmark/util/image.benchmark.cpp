@@ -0,0 +1,42 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/util/image.hpp>
+#include <mbgl/util/io.hpp>
+#include <mbgl/util/premultiply.hpp>
+
+#include <string>
+
+using namespace mbgl;
+
+namespace {
+
+// A raster tile in each format, and a high density sprite sheet with transparency
+void ImageDecode(benchmark::State& state, const char* path) {
+    const std::string data = util::read_file(path);
+    for (auto _ : state) {
+        auto image = decodeImage(data);
+        benchmark::DoNotOptimize(image.data.get());
+    }
+}
+
+void ImagePremultiply(benchmark::State& state) {
+    UnassociatedImage source({512, 512});
+    for (std::size_t i = 0; i < source.bytes(); ++i) {
+        source.data[i] = static_cast<uint8_t>(i * 7);
+    }
+    UnassociatedImage image(source.size);
+    for (auto _ : state) {
+        UnassociatedImage::copy(source, image, {0, 0}, {0, 0}, source.size);
+        util::premultiply(image.data.get(), image.size.area());
+        benchmark::DoNotOptimize(image.data.get());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * source.bytes()));
+}
+
+} // namespace
+
+BENCHMARK_CAPTURE(ImageDecode, PNGTile, "test/fixtures/image/tile.png");
+BENCHMARK_CAPTURE(ImageDecode, JPEGTile, "test/fixtures/image/tile.jpeg");
+BENCHMARK_CAPTURE(ImageDecode, WebPTile, "test/fixtures/image/tile.webp");
+BENCHMARK_CAPTURE(ImageDecode, PNGSprite, "test/fixtures/resources/versatiles-sprite/sprite@2x.png");
+BENCHMARK(ImagePremultiply);
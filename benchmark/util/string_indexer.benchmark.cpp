@@ -0,0 +1,37 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/util/string_indexer.hpp>
+
+#include <string>
+#include <vector>
+
+namespace {
+
+// Names of the kind looked up during layout and uniform binding, all already indexed
+const std::vector<std::string>& names() {
+    static const std::vector<std::string> result = [] {
+        std::vector<std::string> strings;
+        for (int i = 0; i < 200; ++i) {
+            strings.push_back("u_uniform_" + std::to_string(i));
+        }
+        for (const auto& string : strings) {
+            mbgl::stringIndexer().get(string);
+        }
+        return strings;
+    }();
+    return result;
+}
+
+void StringIndexer_Lookup(benchmark::State& state) {
+    const auto& strings = names();
+    for (auto _ : state) {
+        for (const auto& string : strings) {
+            benchmark::DoNotOptimize(mbgl::stringIndexer().get(string));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(strings.size()));
+}
+
+} // namespace
+
+BENCHMARK(StringIndexer_Lookup)->ThreadRange(1, 8)->UseRealTime();
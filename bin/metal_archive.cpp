@@ -0,0 +1,121 @@
+#include <mbgl/map/map.hpp>
+#include <mbgl/map/map_options.hpp>
+#include <mbgl/util/run_loop.hpp>
+
+#include <mbgl/gfx/backend.hpp>
+#include <mbgl/gfx/headless_frontend.hpp>
+#include <mbgl/mtl/renderer_backend.hpp>
+#include <mbgl/style/style.hpp>
+
+#include <args.hxx>
+
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+
+// Renders a style at a range of zoom levels so that every render pipeline state it needs
+// ends up in a Metal binary archive, which can then be shipped with an app.
+int main(int argc, char* argv[]) {
+    args::ArgumentParser argumentParser("MapLibre Native Metal binary archive tool");
+    args::HelpFlag helpFlag(argumentParser, "help", "Display this help menu", {"help"});
+
+    args::ValueFlag<std::string> apikeyValue(argumentParser, "key", "API key", {'t', "apikey"});
+    args::ValueFlag<std::string> styleValue(argumentParser, "URL", "Map stylesheet", {'s', "style"});
+    args::ValueFlag<std::string> outputValue(
+        argumentParser, "file", "Binary archive file name, extended if it exists", {'o', "output"});
+    args::ValueFlag<std::string> cacheValue(argumentParser, "file", "Cache database file name", {'c', "cache"});
+    args::ValueFlag<std::string> assetsValue(
+        argumentParser, "file", "Directory to which asset:// URLs will resolve", {'a', "assets"});
+
+    args::ValueFlag<double> pixelRatioValue(argumentParser, "number", "Image scale factor", {'r', "ratio"});
+    args::ValueFlag<double> lonValue(argumentParser, "degrees", "Longitude", {'x', "lon"});
+    args::ValueFlag<double> latValue(argumentParser, "degrees", "Latitude", {'y', "lat"});
+    args::ValueFlag<double> minZoomValue(argumentParser, "number", "First zoom level rendered", {"minZoom"});
+    args::ValueFlag<double> maxZoomValue(argumentParser, "number", "Last zoom level rendered", {"maxZoom"});
+    args::ValueFlag<double> pitchValue(argumentParser, "degrees", "Pitch, for styles with 3D layers", {'p', "pitch"});
+    args::ValueFlag<uint32_t> widthValue(argumentParser, "pixels", "Image width", {'w', "width"});
+    args::ValueFlag<uint32_t> heightValue(argumentParser, "pixels", "Image height", {'h', "height"});
+
+    try {
+        argumentParser.ParseCLI(argc, argv);
+    } catch (const args::Help&) {
+        std::cout << argumentParser;
+        exit(0);
+    } catch (const args::ParseError& e) {
+        std::cerr << e.what() << std::endl;
+        std::cerr << argumentParser;
+        exit(1);
+    } catch (const args::ValidationError& e) {
+        std::cerr << e.what() << std::endl;
+        std::cerr << argumentParser;
+        exit(2);
+    }
+
+    const double lat = latValue ? args::get(latValue) : 0;
+    const double lon = lonValue ? args::get(lonValue) : 0;
+    const double minZoom = minZoomValue ? args::get(minZoomValue) : 0;
+    const double maxZoom = maxZoomValue ? args::get(maxZoomValue) : 16;
+    const double pitch = pitchValue ? args::get(pitchValue) : 0;
+    const double pixelRatio = pixelRatioValue ? args::get(pixelRatioValue) : 1;
+
+    const uint32_t width = widthValue ? args::get(widthValue) : 512;
+    const uint32_t height = heightValue ? args::get(heightValue) : 512;
+    const std::string output = outputValue ? args::get(outputValue) : "pipelines.metallib";
+    const std::string cache_file = cacheValue ? args::get(cacheValue) : "cache.sqlite";
+    const std::string asset_root = assetsValue ? args::get(assetsValue) : ".";
+
+    // Try to load the apikey from the environment.
+    const char* apikeyEnv = getenv("MLN_API_KEY");
+    const std::string apikey = apikeyValue ? args::get(apikeyValue) : (apikeyEnv ? apikeyEnv : std::string());
+
+    using namespace mbgl;
+
+    if (gfx::Backend::GetType() != gfx::Backend::Type::Metal) {
+        std::cerr << "Error: this tool requires the Metal rendering backend" << std::endl;
+        exit(1);
+    }
+
+    auto mapTilerConfiguration = mbgl::TileServerOptions::MapTilerConfiguration();
+    std::string style = styleValue ? args::get(styleValue) : mapTilerConfiguration.defaultStyles().at(0).getUrl();
+
+    util::RunLoop loop;
+
+    HeadlessFrontend frontend({width, height}, static_cast<float>(pixelRatio));
+
+    // The archive is opened when the first pipeline is created, so this must precede any rendering
+    auto& backend = static_cast<mtl::RendererBackend&>(*frontend.getBackend());
+    backend.setBinaryArchivePath(std::filesystem::absolute(output).string());
+
+    Map map(frontend,
+            MapObserver::nullObserver(),
+            MapOptions()
+                .withMapMode(MapMode::Static)
+                .withSize(frontend.getSize())
+                .withPixelRatio(static_cast<float>(pixelRatio)),
+            ResourceOptions()
+                .withCachePath(cache_file)
+                .withAssetPath(asset_root)
+                .withApiKey(apikey)
+                .withTileServerOptions(mapTilerConfiguration));
+
+    if (style.find("://") == std::string::npos) {
+        style = std::string("file://") + style;
+    }
+    map.getStyle().loadURL(style);
+
+    try {
+        for (double zoom = minZoom; zoom <= maxZoom; zoom += 1) {
+            std::cout << "Rendering zoom " << zoom << std::endl;
+            map.jumpTo(CameraOptions().withCenter(LatLng{lat, lon}).withZoom(zoom).withPitch(pitch));
+            frontend.render(map);
+        }
+    } catch (std::exception& e) {
+        std::cout << "Error: " << e.what() << std::endl;
+        exit(1);
+    }
+
+    backend.saveBinaryArchive();
+    std::cout << "Wrote " << output << std::endl;
+
+    return 0;
+}
@@ -185,7 +185,12 @@ int main(int argc, char* argv[]) {
         int retCode = 0;
         std::cout << "Start Merge" << std::endl;
         inputSource.mergeOfflineRegions(
-            *mergePath, [&](mbgl::expected<std::vector<OfflineRegion>, std::exception_ptr> result) {
+            *mergePath,
+            [](uint64_t merged, uint64_t total) {
+                std::cout << "\r " << merged << " / " << total << " tiles" << std::flush;
+            },
+            [&](mbgl::expected<std::vector<OfflineRegion>, std::exception_ptr> result) {
+                std::cout << std::endl;
                 if (!result) {
                     std::cerr << "Error merging database: " << util::toString(result.error()) << std::endl;
                     retCode = 1;
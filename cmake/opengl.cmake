@@ -20,6 +20,7 @@ list(APPEND
         ${PROJECT_SOURCE_DIR}/include/mbgl/shaders/gl/background.hpp
         ${PROJECT_SOURCE_DIR}/include/mbgl/shaders/gl/background_pattern.hpp
         ${PROJECT_SOURCE_DIR}/include/mbgl/shaders/gl/circle.hpp
+        ${PROJECT_SOURCE_DIR}/include/mbgl/shaders/gl/circle_instanced.hpp
         ${PROJECT_SOURCE_DIR}/include/mbgl/shaders/gl/clipping_mask.hpp
         ${PROJECT_SOURCE_DIR}/include/mbgl/shaders/gl/collision_box.hpp
         ${PROJECT_SOURCE_DIR}/include/mbgl/shaders/gl/collision_circle.hpp
@@ -56,6 +57,7 @@ list(APPEND
         SRC_FILES
         ${PROJECT_SOURCE_DIR}/src/mbgl/gl/attribute.cpp
         ${PROJECT_SOURCE_DIR}/src/mbgl/gl/attribute.hpp
+        ${PROJECT_SOURCE_DIR}/src/mbgl/gl/buffer_storage_extension.hpp
         ${PROJECT_SOURCE_DIR}/src/mbgl/gl/command_encoder.cpp
         ${PROJECT_SOURCE_DIR}/src/mbgl/gl/command_encoder.hpp
         ${PROJECT_SOURCE_DIR}/src/mbgl/gl/context.cpp
@@ -76,6 +78,9 @@ list(APPEND
         ${PROJECT_SOURCE_DIR}/src/mbgl/gl/object.hpp
         ${PROJECT_SOURCE_DIR}/src/mbgl/gl/offscreen_texture.cpp
         ${PROJECT_SOURCE_DIR}/src/mbgl/gl/offscreen_texture.hpp
+        ${PROJECT_SOURCE_DIR}/src/mbgl/gl/parallel_shader_compile_extension.hpp
+        ${PROJECT_SOURCE_DIR}/src/mbgl/gl/program_binary_cache.cpp
+        ${PROJECT_SOURCE_DIR}/src/mbgl/gl/program_binary_cache.hpp
         ${PROJECT_SOURCE_DIR}/src/mbgl/gl/render_pass.cpp
         ${PROJECT_SOURCE_DIR}/src/mbgl/gl/render_pass.hpp
         ${PROJECT_SOURCE_DIR}/src/mbgl/gl/renderbuffer_resource.cpp
@@ -83,6 +88,8 @@ list(APPEND
         ${PROJECT_SOURCE_DIR}/src/mbgl/gl/renderer_backend.cpp
         ${PROJECT_SOURCE_DIR}/src/mbgl/gl/resource_pool.cpp
         ${PROJECT_SOURCE_DIR}/src/mbgl/gl/resource_pool.hpp
+        ${PROJECT_SOURCE_DIR}/src/mbgl/gl/staging_buffer.cpp
+        ${PROJECT_SOURCE_DIR}/src/mbgl/gl/staging_buffer.hpp
         ${PROJECT_SOURCE_DIR}/src/mbgl/gl/state.hpp
         ${PROJECT_SOURCE_DIR}/src/mbgl/gl/timestamp_query_extension.cpp
         ${PROJECT_SOURCE_DIR}/src/mbgl/gl/timestamp_query_extension.hpp
@@ -77,6 +77,9 @@ public:
 
     ActorRef<std::decay_t<Object>> self() { return parent.self(); }
 
+    /// Set the priority used to schedule the processing of this actor's messages
+    void setPriority(TaskPriority priority) { parent.mailbox->setPriority(priority); }
+
 private:
     const std::shared_ptr<Scheduler> retainer;
     AspiringActor<Object> parent;
@@ -31,7 +31,7 @@ public:
     template <typename Fn, class... Args>
     void invoke(Fn fn, Args&&... args) const {
         if (auto mailbox = weakMailbox.lock()) {
-            mailbox->push(actor::makeMessage(*object, fn, std::forward<Args>(args)...));
+            mailbox->push(actor::makeMessage(mailbox->messageSlab(), *object, fn, std::forward<Args>(args)...));
         }
     }
 
@@ -44,7 +44,8 @@ public:
         auto future = promise.get_future();
 
         if (auto mailbox = weakMailbox.lock()) {
-            mailbox->push(actor::makeMessage(std::move(promise), *object, fn, std::forward<Args>(args)...));
+            mailbox->push(actor::makeMessage(
+                mailbox->messageSlab(), std::move(promise), *object, fn, std::forward<Args>(args)...));
         } else {
             promise.set_exception(std::make_exception_ptr(std::runtime_error("Actor has gone away")));
         }
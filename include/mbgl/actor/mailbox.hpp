@@ -4,15 +4,14 @@
 #include <memory>
 #include <mutex>
 #include <optional>
-#include <queue>
 
 #include <mapbox/std/weak.hpp>
+#include <mbgl/actor/message.hpp>
 #include <mbgl/actor/scheduler.hpp>
 
 namespace mbgl {
 
 class Scheduler;
-class Message;
 
 class Mailbox : public std::enable_shared_from_this<Mailbox> {
 public:
@@ -24,6 +23,7 @@ public:
 
     Mailbox(Scheduler&);
     Mailbox(const TaggedScheduler&);
+    ~Mailbox();
 
     /// Attach the given scheduler to this mailbox and begin processing messages
     /// sent to it. The mailbox must be a "holding" mailbox, as created by the
@@ -37,28 +37,54 @@ public:
 
     bool isOpen() const;
 
+    /// Set the priority used to schedule the processing of subsequent messages
+    void setPriority(TaskPriority priority_) { priority = priority_; }
+    TaskPriority getPriority() const { return priority; }
+
     void push(std::unique_ptr<Message>);
     void receive();
 
+    /// Storage for the messages sent to this mailbox. Messages allocated in it must be pushed to
+    /// this mailbox, which frees them before it's destroyed.
+    actor::MessageSlab& messageSlab() { return slab; }
+
 private:
     void scheduleToRecieve(const std::optional<util::SimpleIdentity>& tag = std::nullopt);
-    enum class State : uint32_t {
-        Idle = 0,
-        Processing,
-        Abandoned
-    };
+
+    // Wait for pushes in progress to finish and hold new ones off, while open() or close() update
+    // the scheduler and the closed flag that pushes read.
+    void lockPushes();
+    void unlockPushes();
+
+    // Intrusive multi-producer, single-consumer queue (Vyukov). Any thread may enqueue; only
+    // receive(), serialized by `receivingMutex`, and the destructor dequeue. Returns null when
+    // empty, or when the push of the next message hasn't linked it in yet.
+    void enqueue(Message*);
+    Message* dequeue();
 
     util::SimpleIdentity schedulerTag = util::SimpleIdentity::Empty;
     mapbox::base::WeakPtr<Scheduler> weakScheduler;
 
     std::recursive_mutex receivingMutex;
-    std::mutex pushingMutex;
 
-    std::atomic<State> state{State::Idle};
-    bool closed{false};
+    // The number of pushes in progress, plus `pushesLocked` while open() or close() run
+    static constexpr uint32_t pushesLocked = 1u << 31;
+    std::atomic<uint32_t> pushes{0};
+
+    std::atomic<bool> abandoned{false};
+    std::atomic<TaskPriority> priority{TaskPriority::Normal};
+    std::atomic<bool> closed{false};
+
+    // Messages pushed and not received yet. A receive is scheduled whenever this becomes
+    // non-zero, and again after each message while it stays so, so at most one is pending.
+    std::atomic<std::size_t> queued{0};
+
+    // Placeholder node, the queue is never empty of nodes
+    const std::unique_ptr<Message> stub;
+    std::atomic<Message*> head;
+    Message* tail;
 
-    std::mutex queueMutex;
-    std::queue<std::unique_ptr<Message>> queue;
+    actor::MessageSlab slab;
 };
 
 } // namespace mbgl
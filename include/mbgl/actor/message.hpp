@@ -1,10 +1,49 @@
 #pragma once
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <future>
+#include <memory>
 #include <utility>
 
 namespace mbgl {
 
+class Mailbox;
+
+namespace actor {
+
+/**
+    Fixed-size blocks owned by a mailbox, handed out to the messages sent to it so that sending
+    the common small message doesn't allocate. Any thread may allocate and release blocks.
+ */
+class MessageSlab {
+public:
+    static constexpr std::size_t blockCount = 16;
+    static constexpr std::size_t blockSize = 128;
+
+    MessageSlab() = default;
+    MessageSlab(const MessageSlab&) = delete;
+    MessageSlab& operator=(const MessageSlab&) = delete;
+
+    /// Returns a free block, or null when `size` doesn't fit one or they are all in use
+    void* allocate(std::size_t size);
+    void release(void*);
+
+    /// The number of allocations that didn't get a block, because they were too large or the slab was
+    /// full, and so went to the heap
+    std::size_t overflows() const { return overflowCount.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr uint32_t allUsed = (1u << blockCount) - 1;
+
+    alignas(std::max_align_t) std::byte blocks[blockCount][blockSize];
+    std::atomic<uint32_t> used{0};
+    std::atomic<std::size_t> overflowCount{0};
+};
+
+} // namespace actor
+
 // A movable type-erasing function wrapper. This allows to store arbitrary
 // invokable things (like std::function<>, or the result of a movable-only
 // std::bind()) in the queue. Source: http://stackoverflow.com/a/29642072/331379
@@ -12,6 +51,18 @@ class Message {
 public:
     virtual ~Message() = default;
     virtual void operator()() = 0;
+
+    // Allocated in `slab` when it has room, on the heap otherwise. Either way, `delete` frees it.
+    static void* operator new(std::size_t size, actor::MessageSlab* slab);
+    static void* operator new(std::size_t size) { return operator new(size, nullptr); }
+    static void operator delete(void* ptr) noexcept;
+    static void operator delete(void* ptr, actor::MessageSlab*) noexcept { operator delete(ptr); }
+
+private:
+    friend class Mailbox;
+
+    // Links the messages queued in a mailbox, so queueing doesn't allocate
+    std::atomic<Message*> next{nullptr};
 };
 
 template <class Object, class MemberFn, class ArgsTuple>
@@ -83,6 +134,23 @@ public:
 
 namespace actor {
 
+template <class Object, class MemberFn, class... Args>
+std::unique_ptr<Message> makeMessage(MessageSlab& slab, Object& object, MemberFn memberFn, Args&&... args) {
+    auto tuple = std::make_tuple(std::forward<Args>(args)...);
+    using Impl = MessageImpl<Object, MemberFn, decltype(tuple)>;
+    static_assert(alignof(Impl) <= alignof(std::max_align_t), "Over-aligned message arguments");
+    return std::unique_ptr<Message>(new (&slab) Impl(object, memberFn, std::move(tuple)));
+}
+
+template <class ResultType, class Object, class MemberFn, class... Args>
+std::unique_ptr<Message> makeMessage(
+    MessageSlab& slab, std::promise<ResultType>&& promise, Object& object, MemberFn memberFn, Args&&... args) {
+    auto tuple = std::make_tuple(std::forward<Args>(args)...);
+    using Impl = AskMessageImpl<ResultType, Object, MemberFn, decltype(tuple)>;
+    static_assert(alignof(Impl) <= alignof(std::max_align_t), "Over-aligned message arguments");
+    return std::unique_ptr<Message>(new (&slab) Impl(std::move(promise), object, memberFn, std::move(tuple)));
+}
+
 template <class Object, class MemberFn, class... Args>
 std::unique_ptr<Message> makeMessage(Object& object, MemberFn memberFn, Args&&... args) {
     auto tuple = std::make_tuple(std::forward<Args>(args)...);
@@ -47,6 +47,13 @@ public:
 
     const OptionalActorRef<Object>& self() { return selfRef; }
 
+    /// Set the priority used to process messages, ignored for synchronous objects
+    void setPriority(TaskPriority priority) {
+        if (actor) {
+            actor->setPriority(priority);
+        }
+    }
+
 private:
     class SyncObject {
     public:
@@ -1,9 +1,11 @@
 #pragma once
 
+#include <mbgl/util/chrono.hpp>
 #include <mbgl/util/identity.hpp>
 
 #include <mapbox/std/weak.hpp>
 
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <type_traits>
@@ -12,6 +14,20 @@ namespace mbgl {
 
 class Mailbox;
 
+/// Urgency of a scheduled task. Schedulers that support priorities run all pending
+/// tasks of a more urgent class before any task of a less urgent class; others
+/// treat every task as `Normal`.
+enum class TaskPriority : uint8_t {
+    /// Work blocking the current frame, e.g., parsing ideal tiles
+    Urgent,
+    /// Default priority
+    Normal,
+    /// Speculative work, e.g., loading tiles outside the current view
+    Prefetch,
+    /// Deferred cleanup, e.g., releasing evicted tiles
+    Housekeeping,
+};
+
 /**
     A `Scheduler` is responsible for coordinating the processing of messages by
     one or more actors via their mailboxes. It's an abstract interface. Currently,
@@ -42,6 +58,12 @@ public:
     virtual void schedule(std::function<void()>&&) = 0;
     virtual void schedule(const util::SimpleIdentity, std::function<void()>&&) = 0;
 
+    /// Enqueues a function for execution with the given priority.
+    /// The default implementation ignores the priority.
+    virtual void scheduleWithPriority(const util::SimpleIdentity tag, TaskPriority, std::function<void()>&& fn) {
+        schedule(tag, std::move(fn));
+    }
+
     /// Makes a weak pointer to this Scheduler.
     virtual mapbox::base::WeakPtr<Scheduler> makeWeakPtr() = 0;
     /// Enqueues a function for execution on the render thread owned by the given tag.
@@ -51,6 +73,18 @@ public:
     /// @param closeQueue Runs all render jobs and then removes the internal queue.
     virtual void runRenderJobs([[maybe_unused]] const util::SimpleIdentity tag,
                                [[maybe_unused]] bool closeQueue = false) {}
+    /// Enqueues a render thread job with the given priority, which orders it with respect to the
+    /// other jobs of the tag when they're run within a budget.
+    /// The default implementation ignores the priority.
+    virtual void runOnRenderThread(const util::SimpleIdentity tag, TaskPriority, std::function<void()>&& fn) {
+        runOnRenderThread(tag, std::move(fn));
+    }
+    /// Run render thread jobs for the given tag, the most urgent first, until `budget` is spent.
+    /// The remaining jobs are left for the next call, except for urgent ones, which always run.
+    /// The default implementation runs all the jobs.
+    virtual void runRenderJobs(const util::SimpleIdentity tag, [[maybe_unused]] Duration budget) {
+        runRenderJobs(tag, false);
+    }
     /// Returns a closure wrapping the given one.
     ///
     /// When the returned closure is invoked for the first time, it schedules
@@ -88,7 +122,8 @@ public:
     /// will lazily initialize a shared worker pool when ran
     /// from the first time.
     /// The scheduled tasks might run in parallel on different
-    /// threads.
+    /// threads. The pool is set up from the EXPERIMENTAL_THREAD_*
+    /// platform settings when it's created.
     /// TODO : Rename to GetPool()
     [[nodiscard]] static std::shared_ptr<Scheduler> GetBackground();
 
@@ -137,8 +172,15 @@ public:
     const std::shared_ptr<Scheduler>& get() const noexcept { return scheduler; }
 
     void schedule(std::function<void()>&& fn) { scheduler->schedule(tag, std::move(fn)); }
+    void schedule(TaskPriority priority, std::function<void()>&& fn) {
+        scheduler->scheduleWithPriority(tag, priority, std::move(fn));
+    }
     void runOnRenderThread(std::function<void()>&& fn) { scheduler->runOnRenderThread(tag, std::move(fn)); }
+    void runOnRenderThread(TaskPriority priority, std::function<void()>&& fn) {
+        scheduler->runOnRenderThread(tag, priority, std::move(fn));
+    }
     void runRenderJobs(bool closeQueue = false) { scheduler->runRenderJobs(tag, closeQueue); }
+    void runRenderJobs(Duration budget) { scheduler->runRenderJobs(tag, budget); }
     void waitForEmpty() const noexcept { scheduler->waitForEmpty(tag); }
 
     /// type. Note: the task result is copied and passed by value.
@@ -10,11 +10,16 @@
 #include <mbgl/gfx/types.hpp>
 
 #include <mbgl/gfx/uniform_buffer.hpp>
+#include <mbgl/util/compressed_image.hpp>
 
+#include <deque>
+#include <map>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <mutex>
 #include <shared_mutex>
+#include <vector>
 
 namespace mbgl {
 
@@ -68,7 +73,7 @@ public:
     Context(const Context&) = delete;
     Context& operator=(Context&& other) = delete;
     Context& operator=(const Context& other) = delete;
-    virtual ~Context() = default;
+    virtual ~Context();
 
     virtual void setObserver(ContextObserver* observer_) { observer = observer_ ? observer_ : &nullObserver; }
 
@@ -83,6 +88,17 @@ public:
 
     virtual std::unique_ptr<OffscreenTexture> createOffscreenTexture(Size, TextureChannelDataType) = 0;
 
+    /// An offscreen texture of the size and type, taken from the pool of released ones if it has one.
+    /// Its contents are undefined, render targets clear them when they render.
+    std::unique_ptr<OffscreenTexture> acquireOffscreenTexture(Size, TextureChannelDataType);
+
+    /// Keep an offscreen texture no longer used, so that render targets recreated on resize or when
+    /// layers are toggled don't allocate new ones. It's destroyed if not acquired again within
+    /// `offscreenTexturePoolFrames` frames.
+    void releaseOffscreenTexture(std::unique_ptr<OffscreenTexture>, TextureChannelDataType);
+
+    static constexpr uint32_t offscreenTexturePoolFrames = 60;
+
     template <RenderbufferPixelType pixelType>
     Renderbuffer<pixelType> createRenderbuffer(const Size size) {
         return {size, createRenderbufferResource(pixelType, size)};
@@ -105,6 +121,18 @@ public:
         return stats;
     }
 
+    /// Measure the GPU time of the commands issued until the matching `endGPUSection`, reported by name
+    /// in `RenderingStats::gpuSectionTimes`. Sections may nest, those of the same name in a frame add up.
+    /// Does nothing unless enabled, or where the backend can't measure it.
+    virtual void beginGPUSection(std::string_view /*name*/) {}
+    virtual void endGPUSection() {}
+
+    /// GPU sections need queries around them, so they're only measured once enabled
+    void setGPUSectionTimingEnabled(bool);
+    bool isGPUSectionTimingEnabled() const { return gpuSectionTimingEnabled; }
+
+    static constexpr std::size_t gpuSectionTimeFrames = 60;
+
 #ifndef NDEBUG
     virtual void visualizeStencilBuffer() = 0;
     virtual void visualizeDepthBuffer(float depthRangeSize) = 0;
@@ -135,6 +163,14 @@ public:
     /// Get the generic shader with the specified name
     virtual gfx::ShaderProgramBasePtr getGenericShader(gfx::ShaderRegistry&, const std::string& name) = 0;
 
+    /// Whether any shader program is still being compiled in the background. Drawables using such a program
+    /// are skipped until it's ready, so another frame is needed once it is.
+    virtual bool hasPendingShaders() const { return false; }
+
+    /// Whether the upload of any texture was put off to keep within the per-frame upload budget, see
+    /// `Texture2D::setDeferrableUpload`. Another frame is needed to draw the drawables using them.
+    virtual bool hasPendingTextureUploads() const { return false; }
+
     /// Create a tile layer group implementation
     virtual TileLayerGroupPtr createTileLayerGroup(int32_t layerIndex,
                                                    std::size_t initialCapacity,
@@ -146,6 +182,9 @@ public:
     /// Create a texture
     virtual Texture2DPtr createTexture2D() = 0;
 
+    /// Whether textures can be given compressed images of this format with `Texture2D::setCompressedImage`
+    virtual bool supportsCompressedImageFormat(CompressedImageFormat) const { return false; }
+
     /// Create a dynamic texture
     virtual DynamicTexturePtr createDynamicTexture(Size size, TexturePixelType pixelType) = 0;
 
@@ -186,6 +225,27 @@ protected:
     virtual std::unique_ptr<RenderbufferResource> createRenderbufferResource(RenderbufferPixelType, Size) = 0;
     virtual std::unique_ptr<DrawScopeResource> createDrawScopeResource() = 0;
 
+    /// Age the pooled offscreen textures and destroy the expired ones, called by `performCleanup`
+    void trimOffscreenTexturePool();
+    /// Destroy all the pooled offscreen textures, which must be done before the backend context goes away
+    void clearOffscreenTexturePool();
+
+    struct PooledOffscreenTexture {
+        Size size;
+        TextureChannelDataType type;
+        std::unique_ptr<OffscreenTexture> texture;
+        uint32_t idleFrames;
+    };
+    std::vector<PooledOffscreenTexture> offscreenTexturePool;
+
+    /// Add the GPU section times of a measured frame to the ones averaged in the stats
+    void addGPUSectionTimes(std::map<std::string, double> frameTimes);
+
+    bool gpuSectionTimingEnabled = false;
+    // The section times of the last measured frames, and their totals and counts by name
+    std::deque<std::map<std::string, double>> gpuSectionWindow;
+    std::map<std::string, std::pair<double, std::size_t>> gpuSectionTotals;
+
     std::shared_mutex renderingStatsMutex;
     gfx::RenderingStats stats;
     ContextObserver* observer;
@@ -254,6 +254,15 @@ public:
     void setUBOIndex(uint32_t uboIndex_) { uboIndex = uboIndex_; }
     uint32_t getUBOIndex() const { return uboIndex; }
 
+    /// Drawables with the same non-zero batch key draw identical geometry with the same pipeline state, and differ
+    /// only in their drawable UBO.
+    /// Runs of them with consecutive UBO indexes can be drawn as instances of a single draw call.
+    void setInstanceBatchKey(std::size_t value) { instanceBatchKey = value; }
+    std::size_t getInstanceBatchKey() const { return instanceBatchKey; }
+
+    /// Whether `other` can be drawn as the given instance of this drawable's draw call
+    bool canBatchInstance(const Drawable& other, uint32_t instance) const;
+
     /// Associate the drawable with a layer tweaker.  This is used to manage the lifetime of the tweaker.
     void setLayerTweaker(LayerTweakerPtr tweaker) { layerTweaker = std::move(tweaker); }
     const LayerTweakerPtr& getLayerTweaker() const { return layerTweaker; }
@@ -309,6 +318,7 @@ protected:
     std::size_t type = 0;
     std::optional<mbgl::Point<double>> origin;
     uint32_t uboIndex = 0;
+    std::size_t instanceBatchKey = 0;
 };
 
 using DrawablePtr = std::shared_ptr<Drawable>;
@@ -50,6 +50,8 @@ public:
     const Texture2DPtr& getTexture() const;
     TexturePixelType getPixelFormat() const;
     bool isEmpty() const;
+    /// Pixels covered by the images currently held, excluding freed regions awaiting reuse
+    std::size_t getOccupiedArea() const;
 
     std::optional<TextureHandle> reserveSize(const Size& size, int32_t uniqueId);
 
@@ -67,7 +69,8 @@ protected:
     mapbox::ShelfPack shelfPack;
     Texture2DPtr texture;
     int numTextures = 0;
-    std::mutex mutex;
+    std::size_t occupiedArea = 0;
+    mutable std::mutex mutex;
 };
 
 } // namespace gfx
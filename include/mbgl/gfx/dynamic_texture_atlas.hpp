@@ -25,8 +25,26 @@ public:
     DynamicTexturePtr dynamicTexture;
 };
 
+/// Packs the glyphs, icons and patterns of every tile into a set of shared textures. Images already
+/// held by a texture are reference counted rather than uploaded again.
+///
+/// Freed regions are only reused by images that fit them, so a long-lived texture fragments. A texture
+/// that can't fit a request it would hold comfortably if compact is retired: nothing new is packed into
+/// it and it's freed once the tiles using it release their images, which move to the remaining textures
+/// as those tiles are laid out again.
 class DynamicTextureAtlas {
 public:
+    struct Stats {
+        /// Textures new images are packed into
+        std::size_t numTextures = 0;
+        /// Retired textures still used by some tiles
+        std::size_t numRetiredTextures = 0;
+        /// Memory of all those textures, in bytes
+        std::size_t textureBytes = 0;
+        /// Part of it holding images in use
+        std::size_t occupiedBytes = 0;
+    };
+
     DynamicTextureAtlas(Context& context_)
         : context(context_) {}
     ~DynamicTextureAtlas() = default;
@@ -38,11 +56,17 @@ public:
 
     void removeTextures(const std::vector<TextureHandle>& textureHandles, const DynamicTexturePtr& dynamicTexture);
 
+    Stats getStats() const;
+
 private:
+    // Retire the texture at `dynTexIndex - 1` if it failed to fit `requiredArea` pixels because of fragmentation
+    void retireIfFragmented(size_t& dynTexIndex, std::size_t requiredArea);
+
     Context& context;
     std::vector<DynamicTexturePtr> dynamicTextures;
+    std::vector<DynamicTexturePtr> retiredTextures;
     std::unordered_map<TexturePixelType, DynamicTexturePtr> dummyDynamicTexture;
-    std::mutex mutex;
+    mutable std::mutex mutex;
 };
 
 } // namespace gfx
@@ -4,17 +4,22 @@
 #include <mbgl/tile/geometry_tile_data.hpp>
 #include <mbgl/gfx/vertex_vector.hpp>
 #include <mbgl/gfx/index_vector.hpp>
+#include <mbgl/gfx/triangulation_cache.hpp>
 #include <mbgl/renderer/buckets/fill_bucket.hpp>
 #include <mbgl/renderer/buckets/line_bucket.hpp>
 
 namespace mbgl {
 namespace gfx {
 
+// The generators take the cached triangulation of the feature's polygons, if any, and fill
+// it in with the polygons that aren't cached yet.
+
 /// Generate fill buffers, without outline
 void generateFillBuffers(const GeometryCollection& geometry,
                          gfx::VertexVector<FillLayoutVertex>& fillVertices,
                          gfx::IndexVector<Triangles>& fillIndexes,
-                         SegmentVector& fillSegments);
+                         SegmentVector& fillSegments,
+                         TriangulationCache::Feature* triangulations = nullptr);
 
 /// Generate fill and outline buffers, with the outline composed of line primitives.
 void generateFillAndOutineBuffers(const GeometryCollection& geometry,
@@ -22,7 +27,8 @@ void generateFillAndOutineBuffers(const GeometryCollection& geometry,
                                   gfx::IndexVector<gfx::Triangles>& fillIndexes,
                                   SegmentVector& fillSegments,
                                   gfx::IndexVector<gfx::Lines>& lineIndexes,
-                                  SegmentVector& lineSegments);
+                                  SegmentVector& lineSegments,
+                                  TriangulationCache::Feature* triangulations = nullptr);
 
 /// Generate fill and outline buffers, where the outlines are built with triangle primitives
 void generateFillAndOutineBuffers(const GeometryCollection& geometry,
@@ -31,7 +37,8 @@ void generateFillAndOutineBuffers(const GeometryCollection& geometry,
                                   SegmentVector& fillSegments,
                                   gfx::VertexVector<LineLayoutVertex>& lineVertices,
                                   gfx::IndexVector<gfx::Triangles>& lineIndexes,
-                                  SegmentVector& lineSegments);
+                                  SegmentVector& lineSegments,
+                                  TriangulationCache::Feature* triangulations = nullptr);
 
 /// Generate fill and outline buffers, where the outlines are built both with triangle primitives AND with simple lines
 void generateFillAndOutineBuffers(const GeometryCollection& geometry,
@@ -42,7 +49,8 @@ void generateFillAndOutineBuffers(const GeometryCollection& geometry,
                                   gfx::IndexVector<gfx::Triangles>& lineIndexes,
                                   SegmentVector& lineSegments,
                                   gfx::IndexVector<gfx::Lines>& basicLineIndexes,
-                                  SegmentVector& basicLineSegments);
+                                  SegmentVector& basicLineSegments,
+                                  TriangulationCache::Feature* triangulations = nullptr);
 
 } // namespace gfx
 } // namespace mbgl
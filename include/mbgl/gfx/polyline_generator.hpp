@@ -2,6 +2,7 @@
 
 #include <mbgl/util/geometry.hpp>
 #include <mbgl/tile/geometry_tile_data.hpp>
+#include <mbgl/util/arena.hpp>
 #include <mbgl/style/types.hpp>
 #include <mbgl/gfx/vertex_vector.hpp>
 #include <mbgl/gfx/index_vector.hpp>
@@ -76,14 +77,14 @@ private:
                           double endRight,
                           bool round,
                           std::size_t startVertex,
-                          std::vector<TriangleElement>& triangleStore,
+                          util::ArenaVector<TriangleElement>& triangleStore,
                           std::optional<PolylineGeneratorDistances> lineDistances);
     void addPieSliceVertex(const GeometryCoordinate& currentVertex,
                            double distance,
                            const Point<double>& extrude,
                            bool lineTurnsLeft,
                            std::size_t startVertex,
-                           std::vector<TriangleElement>& triangleStore,
+                           util::ArenaVector<TriangleElement>& triangleStore,
                            std::optional<PolylineGeneratorDistances> lineDistances);
 
 private:
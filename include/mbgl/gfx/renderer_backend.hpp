@@ -1,6 +1,7 @@
 #pragma once
 
 #include <mbgl/actor/scheduler.hpp>
+#include <mbgl/util/chrono.hpp>
 #include <mbgl/util/util.hpp>
 
 #include <memory>
@@ -37,6 +38,14 @@ public:
     // Return the background thread pool assigned to this backend
     TaggedScheduler& getThreadPool() noexcept { return threadPool; }
 
+    /// Time each frame may spend on the render jobs queued on the thread pool, zero (the default)
+    /// for no limit. Jobs left over run in the following frames, the most urgent first.
+    void setRenderJobBudget(Duration budget) { renderJobBudget = budget; }
+    Duration getRenderJobBudget() const { return renderJobBudget; }
+
+    /// Run the queued render jobs within the budget, called by the context at the start of a frame
+    void runRenderJobs();
+
     /// Returns the device's context.
     Context& getContext();
 
@@ -76,6 +85,7 @@ protected:
     const ContextMode contextMode;
     std::once_flag initialized;
     TaggedScheduler threadPool;
+    Duration renderJobBudget = Duration::zero();
 
     friend class BackendScope;
 };
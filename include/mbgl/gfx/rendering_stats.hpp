@@ -3,6 +3,7 @@
 #include <cstddef>
 #include <string>
 #include <memory>
+#include <vector>
 #include <mbgl/util/color.hpp>
 
 namespace mbgl {
@@ -14,6 +15,13 @@ class SymbolLayer;
 
 namespace gfx {
 
+/// GPU time spent in a section of the frames, a layer or a render pass
+struct GPUSectionTime {
+    std::string name;
+    /// Average per frame (seconds)
+    double time = 0.0;
+};
+
 struct RenderingStats {
     bool isZero() const;
 
@@ -21,6 +29,39 @@ struct RenderingStats {
     double encodingTime = 0.0;
     /// Frame CPU rendering time (seconds)
     double renderingTime = 0.0;
+    /// CPU time spent encoding layer group drawables during the most recent frame, summed over all the
+    /// threads encoding them (seconds). Currently only measured by the Metal backend.
+    double drawableEncodingTime = 0.0;
+    /// CPU time spent waiting for the GPU to finish an earlier frame before the most recent one could
+    /// begin (seconds). Currently only measured by the Vulkan backend.
+    double frameWaitTime = 0.0;
+    /// GPU time of the most recent frame measured, a few frames behind the current one (seconds). Currently
+    /// only measured by the OpenGL backend, where GL_EXT_disjoint_timer_query is available.
+    double gpuTime = 0.0;
+    /// GPU time of each layer and render pass, averaged over the last `Context::gpuSectionTimeFrames` frames
+    /// measured, most expensive first. Only measured while enabled with `Renderer::setGPUSectionTiming`, and
+    /// currently only by the OpenGL backend, where GL_TIMESTAMP queries are available.
+    std::vector<GPUSectionTime> gpuSectionTimes;
+    /// CPU time spent building the render tree of the most recent frame, by phase (seconds): diffing and
+    /// evaluating the style, updating the sources, preparing sources and layers, and symbol placement
+    double styleUpdateTime = 0.0;
+    double sourceUpdateTime = 0.0;
+    double prepareTime = 0.0;
+    double placementTime = 0.0;
+    /// CPU time spent building the whole render tree of the most recent frame, including the phases above
+    /// (seconds)
+    double renderTreeTime = 0.0;
+    /// CPU time spent rendering the most recent frame, by phase (seconds): updating the layer groups from the
+    /// render tree, running the layer tweakers, uploading buffers and textures, and encoding the render passes
+    double layerUpdateTime = 0.0;
+    double tweakerTime = 0.0;
+    double uploadTime = 0.0;
+    double passEncodingTime = 0.0;
+    /// Number of render trees built for updates which didn't change the style, only the camera
+    int numCameraOnlyUpdates = 0;
+    /// Number of layer tweaker executions which kept the drawable uniforms of the previous frame, their inputs
+    /// being unchanged
+    int numSkippedTweakerUpdates = 0;
 
     /// Number of frames rendered
     int numFrames = 0;
@@ -28,6 +69,18 @@ struct RenderingStats {
     int numDrawCalls = 0;
     /// Total number of draw calls executed during all the frames
     int totalDrawCalls = 0;
+    /// Number of triangles drawn during the most recent frame
+    int numTriangles = 0;
+    /// Number of tile drawables skipped during the most recent frame, hidden under an opaque fill covering
+    /// their tile in a layer above
+    int numOccludedDrawables = 0;
+    /// Number of symbols the most recent placement skipped without projecting them, their part of the tile being
+    /// outside the viewport and its collision padding
+    int numCulledSymbols = 0;
+    /// Number of collision tests the most recent placement made for labels at variable anchors, and number of
+    /// those labels placed on their first test at the anchor they had in the placement before
+    int numVariableAnchorTests = 0;
+    int numPreviousAnchorPlacements = 0;
 
     /// Total number of textures created
     int numCreatedTextures = 0;
@@ -40,6 +93,13 @@ struct RenderingStats {
     /// Number of bytes used in texture updates
     std::size_t textureUpdateBytes = 0;
 
+    /// Number of offscreen textures created for render targets
+    int numCreatedOffscreenTextures = 0;
+    /// Number of render targets given a pooled offscreen texture rather than a new one
+    int numReusedOffscreenTextures = 0;
+    /// Number of released offscreen textures currently kept for reuse
+    int numPooledOffscreenTextures = 0;
+
     /// Number of buffers created
     std::size_t totalBuffers = 0;
     /// Number of SDK-specific buffers created
@@ -51,6 +111,12 @@ struct RenderingStats {
     /// Sum of update sizes
     std::size_t bufferUpdateBytes = 0;
 
+    /// Number of buffers and textures sub-allocated from a heap rather than allocated on their own. Currently only
+    /// counted by the Metal backend.
+    int numHeapAllocations = 0;
+    /// Number of heaps that buffers and textures are sub-allocated from
+    int numHeaps = 0;
+
     /// Number of active buffers
     int numBuffers = 0;
     /// Number of active offscreen frame buffers
@@ -72,6 +138,18 @@ struct RenderingStats {
     int numUniformUpdates = 0;
     /// Sum of uniform buffers update sizes
     std::size_t uniformUpdateBytes = 0;
+    /// Sum of uniform buffers update sizes during the most recent frame
+    std::size_t frameUniformUpdateBytes = 0;
+    /// Number of uniform buffer bindings made during the most recent frame
+    int numUniformBindings = 0;
+    /// Number of descriptor sets written during the most recent frame
+    int numDescriptorSetUpdates = 0;
+    /// Number of program, vertex array, texture and uniform buffer bindings skipped during the most recent frame,
+    /// the state being set already. Currently only counted by the OpenGL backend.
+    int numRedundantStateCalls = 0;
+    /// Number of render bundles replayed during the most recent frame, their draw calls included in `numDrawCalls`.
+    /// Currently only recorded by the WebGPU backend.
+    int numRenderBundleReplays = 0;
 
     /// Total texture memory
     int memTextures = 0;
@@ -127,6 +205,8 @@ protected:
     uint32_t frameCount = 0;
     double encodingTime = 0.0;
     double renderingTime = 0.0;
+    double drawableEncodingTime = 0.0;
+    double frameWaitTime = 0.0;
 };
 
 } // namespace gfx
@@ -1,8 +1,10 @@
 #pragma once
 #include <mbgl/gfx/types.hpp>
+#include <mbgl/util/compressed_image.hpp>
 #include <mbgl/util/image.hpp>
 
 #include <cstddef>
+#include <memory>
 #include <vector>
 
 namespace mbgl {
@@ -27,8 +29,15 @@ public:
         /// Wrapping behavior along V coordinate
         TextureWrapType wrapV{TextureWrapType::Clamp};
 
+        /// Maximum anisotropy of the filtering, where the backend and device support it. 1 disables it.
         uint8_t maxAnisotropy{1};
+        /// Whether mip levels are generated when the image is uploaded, and sampled between
         bool mipmapped{false};
+        /// Added to the mip level the sampler picks, positive values favoring the smaller levels. Only the
+        /// Vulkan backend applies it, the OpenGL ES and Metal samplers have no such parameter.
+        float lodBias{0.0f};
+
+        bool operator==(const SamplerState&) const = default;
     };
 
 public:
@@ -55,6 +64,16 @@ public:
     /// @param image_ Image data to transfer
     virtual Texture2D& setImage(std::shared_ptr<PremultipliedImage> image_) noexcept = 0;
 
+    /// @brief Sets a block-compressed image to upload as is, instead of an image set with `setImage`.
+    /// Ignored by backends not supporting its format, see `Context::supportsCompressedImageFormat`.
+    /// @param image_ Image data to transfer
+    virtual Texture2D& setCompressedImage(std::shared_ptr<const CompressedImage>) noexcept { return *this; }
+
+    /// @brief Lets the upload of an image set with `setImage` wait for a later frame once the texture upload
+    /// budget of the current one is spent, see `Context::hasPendingTextureUploads`. Drawables using the
+    /// texture are skipped until it has been uploaded. Ignored by backends without an upload budget.
+    virtual Texture2D& setDeferrableUpload(bool) noexcept { return *this; }
+
     /// @brief Get the pixel format of the texture
     /// @return Pixel format of the texture
     virtual TexturePixelType getFormat() const noexcept = 0;
@@ -53,6 +53,11 @@ public:
     /// @param ref Allocation reference to release
     virtual void release(BufferRef* ref) noexcept = 0;
 
+    /// Upload data written since the last flush. Writes are batched so that the many small updates
+    /// made while preparing a frame cost a handful of buffer mappings, this must be called before
+    /// drawing with them.
+    virtual void flush() noexcept = 0;
+
     /// Defragment the allocator's underlying buffer pool.
     virtual void defragment(const std::shared_ptr<gl::Fence>& fence) = 0;
 
@@ -164,6 +169,7 @@ public:
 
     bool write(const void* data, size_t size, BufferRef*& ref) noexcept override;
     void release(BufferRef* ref) noexcept override;
+    void flush() noexcept override;
     void defragment(const std::shared_ptr<gl::Fence>& fence) override;
     size_t pageSize() const noexcept override;
     int32_t getBufferID(size_t bufferIndex) const noexcept override;
@@ -67,7 +67,6 @@ private:
     void uploadTextures() const;
 
     void bindTextures() const;
-    void unbindTextures() const;
 };
 
 } // namespace gl
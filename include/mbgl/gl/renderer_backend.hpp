@@ -5,6 +5,8 @@
 #include <mbgl/util/size.hpp>
 #include <mbgl/util/util.hpp>
 
+#include <string>
+
 namespace mbgl {
 
 class ProgramParameters;
@@ -26,6 +28,15 @@ public:
     /// One-time shader initialization
     void initShaders(gfx::ShaderRegistry&, const ProgramParameters& programParameters) override;
 
+    /// Directory shader program binaries are cached in, none by default. Takes effect when the
+    /// context is created. The directory must exist.
+    void setProgramBinaryCacheDirectory(std::string directory) { programBinaryCacheDirectory = std::move(directory); }
+
+    /// Compile shader programs on driver threads, if supported, instead of blocking the frame that first needs
+    /// them. Layers are left out of frames until their programs are ready. Meant for continuous rendering.
+    /// Off by default; takes effect when the context is created.
+    void setAsyncShaderCompilation(bool enable) { asyncShaderCompilation = enable; }
+
 protected:
     std::unique_ptr<gfx::Context> createContext() override;
 
@@ -50,6 +61,9 @@ protected:
     /// Returns true when assumed framebuffer binding hasn't changed from the implicit binding.
     bool implicitFramebufferBound();
 
+    std::string programBinaryCacheDirectory;
+    bool asyncShaderCompilation = false;
+
 public:
     /// Triggers an OpenGL state update if the internal assumed state doesn't
     /// match the supplied values.
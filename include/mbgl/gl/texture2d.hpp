@@ -27,6 +27,8 @@ public: // gfx::Texture2D
 
     Texture2D& setImage(std::shared_ptr<PremultipliedImage> image_) noexcept override;
 
+    Texture2D& setCompressedImage(std::shared_ptr<const CompressedImage> image_) noexcept override;
+
     gfx::TexturePixelType getFormat() const noexcept override { return pixelFormat; }
 
     Size getSize() const noexcept override { return size; }
@@ -43,7 +45,15 @@ public: // gfx::Texture2D
     void uploadSubRegion(const void* pixelData, const Size& size, uint16_t xOffset, uint16_t yOffset) noexcept override;
     void upload() override;
 
-    bool needsUpload() const noexcept override { return !!image; };
+    bool needsUpload() const noexcept override { return image || compressedImage; };
+
+    Texture2D& setDeferrableUpload(bool deferrable) noexcept override {
+        deferrableUpload = deferrable;
+        return *this;
+    }
+
+    /// Whether drawables using the texture must wait for the upload of its image
+    bool isUploadPending() const noexcept { return deferrableUpload && image; }
 
 public:
     /// @brief Get the OpenGL handle ID for the underlying resource
@@ -74,9 +84,15 @@ private:
     gfx::TextureChannelDataType channelType{gfx::TextureChannelDataType::UnsignedByte};
 
     std::shared_ptr<PremultipliedImage> image{nullptr};
+    std::shared_ptr<const CompressedImage> compressedImage{nullptr};
+    // Size of the compressed image uploaded, if any
+    std::size_t compressedDataSize{0};
     Size size{0, 0};
     bool samplerStateDirty{false};
     bool storageDirty{false};
+    bool deferrableUpload{false};
+    // Whether the mip levels were generated from the image uploaded, see `SamplerState::mipmapped`
+    bool mipmaps{false};
 
     int32_t boundTextureUnit{-1};
     int32_t boundLocation{-1};
@@ -30,6 +30,9 @@ public:
     /// Returns a new Layer instance on success call; returns `nullptr` otherwise.
     virtual std::unique_ptr<style::Layer> createLayer(const std::string& id,
                                                       const style::conversion::Convertible& value) noexcept = 0;
+    /// Returns a new Layer instance sharing the given impl of this type, or `nullptr` if the type doesn't
+    /// support it.
+    virtual std::unique_ptr<style::Layer> createLayerFromImpl(Immutable<style::Layer::Impl>) noexcept;
     /// Returns a new RenderLayer instance.
     virtual std::unique_ptr<RenderLayer> createRenderLayer(Immutable<style::Layer::Impl>) noexcept = 0;
     /// Returns a new Bucket instance on success call; returns `nullptr` otherwise.
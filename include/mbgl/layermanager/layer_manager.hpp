@@ -39,6 +39,8 @@ public:
                                               const std::string& id,
                                               const style::conversion::Convertible& value,
                                               style::conversion::Error& error) noexcept;
+    /// Returns a new Layer instance sharing the given impl, or `nullptr` if its type doesn't support it.
+    std::unique_ptr<style::Layer> createLayer(Immutable<style::Layer::Impl>) noexcept;
     /// Returns a new RenderLayer instance on success call; returns `nullptr` otherwise.
     std::unique_ptr<RenderLayer> createRenderLayer(Immutable<style::Layer::Impl>) noexcept;
     /// Returns a new Bucket instance on success call; returns `nullptr` otherwise.
@@ -9,6 +9,7 @@ protected:
     const style::LayerTypeInfo* getTypeInfo() const noexcept final;
     std::unique_ptr<style::Layer> createLayer(const std::string& id,
                                               const style::conversion::Convertible& value) noexcept final;
+    std::unique_ptr<style::Layer> createLayerFromImpl(Immutable<style::Layer::Impl>) noexcept final;
     std::unique_ptr<Layout> createLayout(const LayoutParameters& parameters,
                                          std::unique_ptr<GeometryTileLayer> tileLayer,
                                          const std::vector<Immutable<style::LayerProperties>>& group) noexcept final;
@@ -20,6 +20,7 @@
 #include <functional>
 #include <vector>
 #include <memory>
+#include <utility>
 #include <optional>
 
 namespace mbgl {
@@ -133,6 +134,11 @@ public:
     void updateAnnotation(AnnotationID, const Annotation&);
     void removeAnnotation(AnnotationID);
 
+    // Batched annotation changes, which invalidate the annotation tiles once rather than per annotation
+    AnnotationIDs addAnnotations(const std::vector<Annotation>&);
+    void updateAnnotations(const std::vector<std::pair<AnnotationID, Annotation>>&);
+    void removeAnnotations(const AnnotationIDs&);
+
     // Tile prefetching
     //
     /// When loading a map, if `PrefetchZoomDelta` is set to any number greater
@@ -193,7 +199,15 @@ public:
     /// default algorithm, which renders the highest LOD at the center of the
     /// screen. The distance based algorithm observes `TileLodScale` and
     /// `TileLodPitchThreshold` and ignores `TileLodMinRadius` and
-    /// `TileLodZoomShift`.
+    /// `TileLodZoomShift`. When "screen space error" is selected, a tile is
+    /// split into its children only while it would be drawn larger than its
+    /// nominal size on screen, so the zoom level drops with the projected size
+    /// of the tiles toward the horizon. `TileLodScale` scales the size above
+    /// which tiles are split and `TileLodMinRadius` is ignored.
+    /// - `TileLodMaxTiles` caps the number of tiles in the cover of a source.
+    /// Covers above it are coarsened away from the camera by lowering the LOD
+    /// one zoom level at a time, and the farthest tiles are dropped if that's
+    /// not enough. Zero, the default, sets no limit.
     void setTileLodMinRadius(double radius);
     double getTileLodMinRadius() const;
     void setTileLodScale(double scale);
@@ -204,6 +218,15 @@ public:
     double getTileLodZoomShift() const;
     void setTileLodMode(TileLodMode mode);
     TileLodMode getTileLodMode() const;
+    void setTileLodMaxTiles(std::size_t maxTiles);
+    std::size_t getTileLodMaxTiles() const;
+
+    /// Bytes of tile data that may be uploaded to the GPU for tiles rendered for the first
+    /// time in a frame. Tiles past it, those away from the center first, wait for the next
+    /// frames while their parent or child tiles are rendered in their place. At least one
+    /// tile is uploaded each frame. Zero, the default, sets no limit. Continuous mode only.
+    void setTileUploadBudget(std::size_t bytes);
+    std::size_t getTileUploadBudget() const;
 
     ClientOptions getClientOptions() const;
 
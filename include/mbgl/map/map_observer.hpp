@@ -1,6 +1,7 @@
 #pragma once
 
 #include <mbgl/tile/tile_operation.hpp>
+#include <mbgl/tile/tile_latency.hpp>
 #include <mbgl/tile/tile_id.hpp>
 #include <mbgl/style/source.hpp>
 #include <mbgl/style/image.hpp>
@@ -84,6 +85,8 @@ public:
 
     // Tile requests
     virtual void onTileAction(TileOperation, const OverscaledTileID&, const std::string&) {}
+    /// The latencies of the tiles of a source so far, each time some of them are rendered for the first time
+    virtual void onTileLatencies(const std::string& /*sourceID*/, const TileLatencies&) {}
 
     // Sprite requests
     virtual void onSpriteLoaded(const std::optional<style::Sprite>&) {}
@@ -36,8 +36,9 @@ enum class ViewportMode : EnumType {
 };
 
 enum class TileLodMode : uint8_t {
-    Default, ///< Default TileLOD algorithm
-    Distance ///< Distance-based TileLOD algorithm
+    Default,         ///< Default TileLOD algorithm
+    Distance,        ///< Distance-based TileLOD algorithm
+    ScreenSpaceError ///< TileLOD from the projected screen size of each tile
 };
 
 enum class MapDebugOptions : EnumType {
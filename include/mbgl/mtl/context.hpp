@@ -13,6 +13,7 @@
 #include <mbgl/util/containers.hpp>
 
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <unordered_map>
 #include <vector>
@@ -74,13 +75,18 @@ public:
                                       const ProgramParameters& programParameters,
                                       const mbgl::unordered_map<std::string, std::string>& additionalDefines);
 
-    MTLTexturePtr createMetalTexture(MTLTextureDescriptorPtr textureDescriptor) const;
+    /// Create a Metal buffer, sub-allocated from a shared heap if it's small enough
+    /// @param data The raw data to copy, may be `nullptr`
+    MTLBufferPtr createMetalBuffer(const void* data, std::size_t size, MTL::ResourceOptions usage);
+
+    /// Create a Metal texture, sub-allocated from a shared heap if it's small enough and its storage mode allows
+    MTLTexturePtr createMetalTexture(MTLTextureDescriptorPtr textureDescriptor);
     MTLSamplerStatePtr createMetalSamplerState(MTLSamplerDescriptorPtr samplerDescriptor) const;
 
     /// Called at the end of a frame.
     void performCleanup() override;
 
-    void reduceMemoryUsage() override {}
+    void reduceMemoryUsage() override { clearOffscreenTexturePool(); }
 
     gfx::UniqueDrawableBuilder createDrawableBuilder(std::string name) override;
     gfx::UniformBufferPtr createUniformBuffer(const void* data,
@@ -156,7 +162,7 @@ public:
     void bindGlobalUniformBuffers(gfx::RenderPass&) const noexcept override;
 
     /// Unbind the global uniform buffers
-    void unbindGlobalUniformBuffers(gfx::RenderPass&) const noexcept override {}
+    void unbindGlobalUniformBuffers(gfx::RenderPass&) const noexcept override;
 
 private:
     RendererBackend& backend;
@@ -176,6 +182,19 @@ private:
     const gfx::Renderable* stencilStateRenderable = nullptr;
 
     UniformBufferArray globalUniformBuffers;
+
+    /// Heaps the small buffers and textures are sub-allocated from. The memory of a resource returns to its heap
+    /// when it's released, and heaps left empty are released in `performCleanup`, one spare heap being kept.
+    struct HeapPool {
+        std::mutex mutex;
+        std::vector<MTLHeapPtr> heaps;
+    };
+    HeapPool bufferHeaps;
+    HeapPool textureHeaps;
+
+    template <typename Resource, typename Allocate>
+    NS::SharedPtr<Resource> allocateFromHeap(HeapPool&, std::size_t size, std::size_t alignment, Allocate&&);
+    void trimHeaps(HeapPool&);
 };
 
 } // namespace mtl
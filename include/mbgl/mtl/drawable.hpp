@@ -36,6 +36,15 @@ public:
 
     void draw(PaintParameters&) const override;
 
+    /// The first half of `draw`: looks up pipeline and depth/stencil states, on the render thread.
+    /// Returns false if there is nothing to draw.
+    bool prepare(PaintParameters&) const;
+    /// The second half of `draw`: encodes the prepared draw calls, which can be done on any thread
+    void encode(RenderPass&) const;
+    /// Draw `other` as another instance of this drawable's prepared draw calls, if they are compatible.
+    /// Only valid after `prepare`, which resets the instance count.
+    bool batchInstance(const gfx::Drawable& other) const;
+
     struct DrawSegment;
     void setIndexData(gfx::IndexVectorBasePtr, std::vector<UniqueDrawSegment> segments) override;
 
@@ -17,6 +17,7 @@ using UInteger = std::uintptr_t;
 } // namespace NS
 
 namespace MTL {
+class BinaryArchive;
 class BlitCommandEncoder;
 class BlitPassDescriptor;
 class Buffer;
@@ -26,7 +27,10 @@ class CommandQueue;
 class Device;
 class DepthStencilState;
 class Function;
+class Heap;
+class ParallelRenderCommandEncoder;
 class RenderCommandEncoder;
+class RenderPipelineDescriptor;
 class RenderPipelineState;
 class RenderPassDescriptor;
 class Texture;
@@ -44,6 +48,7 @@ namespace mtl {
 using CAMetalDrawablePtr = NS::SharedPtr<CA::MetalDrawable>;
 using CAMetalLayerPtr = NS::SharedPtr<CA::MetalLayer>;
 
+using MTLBinaryArchivePtr = NS::SharedPtr<MTL::BinaryArchive>;
 using MTLBlitCommandEncoderPtr = NS::SharedPtr<MTL::BlitCommandEncoder>;
 using MTLBlitPassDescriptorPtr = NS::SharedPtr<MTL::BlitPassDescriptor>;
 using MTLBufferPtr = NS::SharedPtr<MTL::Buffer>;
@@ -53,6 +58,8 @@ using MTLCommandQueuePtr = NS::SharedPtr<MTL::CommandQueue>;
 using MTLDevicePtr = NS::SharedPtr<MTL::Device>;
 using MTLDepthStencilStatePtr = NS::SharedPtr<MTL::DepthStencilState>;
 using MTLFunctionPtr = NS::SharedPtr<MTL::Function>;
+using MTLHeapPtr = NS::SharedPtr<MTL::Heap>;
+using MTLParallelRenderCommandEncoderPtr = NS::SharedPtr<MTL::ParallelRenderCommandEncoder>;
 using MTLRenderCommandEncoderPtr = NS::SharedPtr<MTL::RenderCommandEncoder>;
 using MTLRenderPassDescriptorPtr = NS::SharedPtr<MTL::RenderPassDescriptor>;
 using MTLRenderPipelineStatePtr = NS::SharedPtr<MTL::RenderPipelineState>;
@@ -7,8 +7,10 @@
 #include <Metal/MTLCommandEncoder.hpp>
 #include <Metal/Metal.hpp>
 
+#include <functional>
 #include <memory>
 #include <optional>
+#include <vector>
 
 namespace mbgl {
 namespace mtl {
@@ -16,6 +18,7 @@ namespace mtl {
 class BufferResource;
 class CommandEncoder;
 class Context;
+class UniformBufferArray;
 
 class RenderPass final : public gfx::RenderPass {
 public:
@@ -64,7 +67,23 @@ public:
     void setFrontFacingWinding(const MTL::Winding);
     void setScissorRect(const MTL::ScissorRect);
 
+    /// Whether this pass uses a parallel render command encoder, see `RendererBackend::setParallelEncoding`
+    bool isEncodingInParallel() const { return parallelEncoder.get() != nullptr; }
+
+    /// Encode commands through a render pass of their own when this pass ends, possibly on another thread.
+    /// They execute after everything encoded before this call and before everything encoded after it.
+    /// Only valid when encoding in parallel; the function must not touch state shared with other encodings.
+    void deferEncoding(std::function<void(RenderPass&)>&&);
+
+    /// The global uniform buffers currently bound, which the encoders of deferred encodings don't inherit
+    void setGlobalUniformBuffers(const UniformBufferArray* buffers) { globalUniformBuffers = buffers; }
+
 private:
+    /// A pass encoding into one of the parent's parallel sub-encoders
+    RenderPass(RenderPass& parent, MTLRenderCommandEncoderPtr);
+
+    void encodeDeferred();
+
     void pushDebugGroup(const char* name) override;
     void popDebugGroup() override;
 
@@ -72,6 +91,8 @@ private:
     gfx::RenderPassDescriptor descriptor;
     mtl::CommandEncoder& commandEncoder;
     MTLRenderCommandEncoderPtr encoder;
+    MTLParallelRenderCommandEncoderPtr parallelEncoder;
+    bool subPass = false;
     MTLDepthStencilStatePtr currentDepthStencilState;
     MTLRenderPipelineStatePtr currentPipelineState;
 
@@ -97,6 +118,13 @@ private:
 
     size_t width;
     size_t height;
+
+    struct DeferredEncoding {
+        std::unique_ptr<RenderPass> renderPass;
+        std::function<void(RenderPass&)> encode;
+    };
+    std::vector<DeferredEncoding> deferredEncodings;
+    const UniformBufferArray* globalUniformBuffers = nullptr;
 };
 
 } // namespace mtl
@@ -10,6 +10,8 @@
 #include <Metal/MTLDevice.hpp>
 #include <Metal/MTLCommandQueue.hpp>
 
+#include <string>
+
 namespace mbgl {
 
 class ProgramParameters;
@@ -34,6 +36,22 @@ public:
     const MTLCommandQueuePtr& getCommandQueue() const { return commandQueue; }
     bool isBaseVertexInstanceDrawingSupported() const { return baseVertexInstanceDrawingSupported; }
 
+    /// File render pipeline states are looked up in before being compiled, none by default. Pipelines that
+    /// are missing are compiled and added, and the archive is written back when the backend is destroyed.
+    /// Must be set before the first pipeline is created. Requires iOS 14 or macOS 11, ignored otherwise.
+    void setBinaryArchivePath(std::string path) { binaryArchivePath = std::move(path); }
+    /// Write the binary archive to its file now, e.g. before the app may get terminated
+    void saveBinaryArchive();
+    /// The archive loaded from the path set with `setBinaryArchivePath`, opened on first use. Null if there's none.
+    MTL::BinaryArchive* getBinaryArchive();
+    /// Add the functions of a pipeline that was missing from the binary archive
+    void addToBinaryArchive(const MTL::RenderPipelineDescriptor*);
+
+    /// Encode the drawables of tile layer groups on the background scheduler, through a parallel render
+    /// command encoder, instead of encoding everything on the render thread. Off by default.
+    void setParallelEncoding(bool value) { parallelEncoding = value; }
+    bool getParallelEncoding() const { return parallelEncoding; }
+
 protected:
     std::unique_ptr<gfx::Context> createContext() override;
 
@@ -63,6 +81,13 @@ protected:
     MTLDevicePtr device;
     MTLCommandQueuePtr commandQueue;
     bool baseVertexInstanceDrawingSupported = false;
+
+    std::string binaryArchivePath;
+    MTLBinaryArchivePtr binaryArchive;
+    bool binaryArchiveOpened = false;
+    bool binaryArchiveModified = false;
+
+    bool parallelEncoding = false;
 };
 
 } // namespace mtl
@@ -52,6 +52,12 @@ public:
     MTL::Texture* getMetalTexture() const noexcept;
 
     void updateSamplerConfiguration();
+    /// Update the sampler state if it was changed after resource creation, which `bind` otherwise does
+    void updateSamplerConfigurationIfDirty() {
+        if (samplerStateDirty) {
+            updateSamplerConfiguration();
+        }
+    }
 
     /// @brief Bind this texture to the specified location
     /// @param renderPass Render pass on which the texture will be assign
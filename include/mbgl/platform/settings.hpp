@@ -15,6 +15,111 @@ DECLARE_MAPLIBRE_SETTING(EXPERIMENTAL_THREAD_PRIORITY_FILE, thread_priority_file
 DECLARE_MAPLIBRE_SETTING(EXPERIMENTAL_THREAD_PRIORITY_NETWORK, thread_priority_network);
 DECLARE_MAPLIBRE_SETTING(EXPERIMENTAL_THREAD_PRIORITY_DATABASE, thread_priority_database);
 
+// The value for EXPERIMENTAL_BATCHED_TILE_READS must be a bool. When set, the tile requests the database
+// file source receives within a couple of milliseconds of each other are looked up together, with a
+// query for each batch of tiles of the same zoom level. Read when the database file source is created.
+DECLARE_MAPLIBRE_SETTING(EXPERIMENTAL_BATCHED_TILE_READS, batched_tile_reads);
+
+// The value for EXPERIMENTAL_THREAD_POOL_WORK_STEALING must be a bool. Read when the shared
+// background scheduler is created, see `Scheduler::GetBackground()`.
+DECLARE_MAPLIBRE_SETTING(EXPERIMENTAL_THREAD_POOL_WORK_STEALING, thread_pool_work_stealing);
+
+// The values for EXPERIMENTAL_THREAD_AFFINITY_* keys must be strings listing CPUs and CPU ranges, such
+// as "4-7" or "0,2-3". The workers of the shared background scheduler run on the WORKER CPUs, the
+// performance cores of a big.LITTLE device for example, and move to the HOUSEKEEPING CPUs while they
+// run housekeeping tasks such as releasing tiles. Read when the shared background scheduler is created.
+// Unsupported on Apple platforms, where the QoS class picked by EXPERIMENTAL_THREAD_PRIORITY_WORKER
+// steers the workers instead.
+DECLARE_MAPLIBRE_SETTING(EXPERIMENTAL_THREAD_AFFINITY_WORKER, thread_affinity_worker);
+DECLARE_MAPLIBRE_SETTING(EXPERIMENTAL_THREAD_AFFINITY_HOUSEKEEPING, thread_affinity_housekeeping);
+
+// The value for TILE_CACHE_MAX_BYTES must be an unsigned integer, the memory budget of each
+// source's tile cache in bytes. Read when a source's tile pyramid is created.
+DECLARE_MAPLIBRE_SETTING(TILE_CACHE_MAX_BYTES, tile_cache_max_bytes);
+
+// The value for TILE_CACHE_EVICTION_POLICY must be one of the strings "lru" (the default),
+// "cost-weighted" or "zoom-distance". Read when a source's tile pyramid is created.
+DECLARE_MAPLIBRE_SETTING(TILE_CACHE_EVICTION_POLICY, tile_cache_eviction_policy);
+
+// The value for EXPERIMENTAL_SHARED_TILE_DATA must be a bool. When set, vector tiles with the same
+// URL templates and identical contents share one decoded copy of their data across all maps in the
+// process. Overscaled tiles always share their parent's data. Read when a vector tile is created.
+DECLARE_MAPLIBRE_SETTING(EXPERIMENTAL_SHARED_TILE_DATA, shared_tile_data);
+
+// The value for EXPERIMENTAL_PARALLEL_PLACEMENT_PRESORT must be a bool. When set, the symbols of every
+// bucket are sorted for placement on the background scheduler before collision detection runs. Collision
+// detection itself stays serial, so symbols are placed as without it. Read when a placement is created.
+DECLARE_MAPLIBRE_SETTING(EXPERIMENTAL_PARALLEL_PLACEMENT_PRESORT, parallel_placement_presort);
+
+// The value for EXPERIMENTAL_PARALLEL_SYMBOL_LAYOUT must be a bool. When set, the text shaping and anchors
+// of a tile's symbol features are computed on the background scheduler, in chunks of features that are
+// then added to the bucket in order. Read each time the symbols of a layer are laid out.
+DECLARE_MAPLIBRE_SETTING(EXPERIMENTAL_PARALLEL_SYMBOL_LAYOUT, parallel_symbol_layout);
+
+// The value for EXPERIMENTAL_PARALLEL_BUCKETS must be a bool. When set, the buckets of a tile's layers other
+// than symbols and those waiting on pattern images are built on the background scheduler, one source layer
+// per task, their features then inserted into the feature index in order. Read each time a tile is parsed.
+DECLARE_MAPLIBRE_SETTING(EXPERIMENTAL_PARALLEL_BUCKETS, parallel_buckets);
+
+// The value for EXPERIMENTAL_STORE_TILE_LAYOUTS must be a bool. When set, the polygon triangulations of
+// vector tiles read from the offline database are stored along with them once laid out, for the tiles
+// of offline regions, and read back with the same data to skip triangulating it again. Read when a vector
+// tile is created.
+DECLARE_MAPLIBRE_SETTING(EXPERIMENTAL_STORE_TILE_LAYOUTS, store_tile_layouts);
+
+// The value for EXPERIMENTAL_INCREMENTAL_PLACEMENT_THRESHOLD must be a double, a distance in pixels.
+// When set, symbols of a bucket whose tile moved on screen by no more than that since the previous
+// placement keep their previous result, as long as their shifted collision boxes still fit. Read
+// when a placement is created.
+DECLARE_MAPLIBRE_SETTING(EXPERIMENTAL_INCREMENTAL_PLACEMENT_THRESHOLD, incremental_placement_threshold);
+
+// The value for EXPERIMENTAL_SCISSOR_TILE_CLIPPING must be a bool. When set, layers clip their tiles to
+// scissor rectangles instead of stencil masks while the view is neither pitched nor rotated off the axes
+// and the tiles don't overlap. Only the OpenGL backend supports it. Read when a renderer is created.
+DECLARE_MAPLIBRE_SETTING(EXPERIMENTAL_SCISSOR_TILE_CLIPPING, scissor_tile_clipping);
+
+// The value for EXPERIMENTAL_PMTILES_MMAP must be a bool. When set, local `pmtiles://file://` archives
+// are memory-mapped and read in place instead of through range requests. The archives must not
+// change while in use. Read when the PMTiles file source is created.
+DECLARE_MAPLIBRE_SETTING(EXPERIMENTAL_PMTILES_MMAP, pmtiles_mmap);
+
+// The value for EXPERIMENTAL_DISCARD_UPLOADED_GEOMETRY must be a bool. When set, the fill, line, circle
+// and fill extrusion buckets of vector tiles free their vertices and indexes once the buffers created
+// from them are uploaded, for memory-constrained devices. Read when a geometry tile is created.
+DECLARE_MAPLIBRE_SETTING(EXPERIMENTAL_DISCARD_UPLOADED_GEOMETRY, discard_uploaded_geometry);
+
+// The value for EXPERIMENTAL_STYLE_RESOURCE_PREFETCH must be a bool. When set, the sprites and TileJSON
+// of a style are requested from a quick scan of its JSON before it's parsed, and the first glyph range
+// of its font stacks to warm the cache. Read when a style is created.
+DECLARE_MAPLIBRE_SETTING(EXPERIMENTAL_STYLE_RESOURCE_PREFETCH, style_resource_prefetch);
+
+// The value for EXPERIMENTAL_RASTER_MIPMAPS must be a bool. When set, raster layers generate the mip levels
+// of their tile textures on upload, against the aliasing and texture bandwidth of zoomed out and pitched
+// views. The OpenGL and Vulkan backends support it. The value for EXPERIMENTAL_RASTER_MAX_ANISOTROPY must
+// be a double, the maximum anisotropy of their filtering, up to 16 and to what the device supports. The
+// value for EXPERIMENTAL_RASTER_LOD_BIAS must be a double, added to the mip level sampled, positive values
+// trading sharpness for bandwidth. Only the Vulkan backend applies it. Read when a raster layer is created.
+DECLARE_MAPLIBRE_SETTING(EXPERIMENTAL_RASTER_MIPMAPS, raster_mipmaps);
+DECLARE_MAPLIBRE_SETTING(EXPERIMENTAL_RASTER_MAX_ANISOTROPY, raster_max_anisotropy);
+DECLARE_MAPLIBRE_SETTING(EXPERIMENTAL_RASTER_LOD_BIAS, raster_lod_bias);
+
+// The value for EXPERIMENTAL_IMAGE_SOURCE_TILE_SIZE must be an unsigned integer, a size in pixels. Image
+// sources whose image is larger than that on either side are cut into tiles of that size, along with
+// halved levels of the image, and only the tiles in view at the level the zoom needs are prepared, off
+// the render thread, and uploaded. Read when an image source is first rendered.
+DECLARE_MAPLIBRE_SETTING(EXPERIMENTAL_IMAGE_SOURCE_TILE_SIZE, image_source_tile_size);
+
+// The value for EXPRESSION_TREE_EVALUATION must be a bool. When set, number and color style expressions
+// are evaluated by walking the expression tree rather than as compiled bytecode, as a fallback should the
+// two disagree. Read when a property expression is created.
+DECLARE_MAPLIBRE_SETTING(EXPRESSION_TREE_EVALUATION, expression_tree_evaluation);
+
+// The value for HTTP_MAX_HOST_CONNECTIONS must be an unsigned integer, the number of connections the
+// curl HTTP file source keeps open to any one host. Further requests wait for one of them, or share
+// it when the host speaks HTTP/2. Zero or unset means no limit. Read when the HTTP file source is
+// created.
+DECLARE_MAPLIBRE_SETTING(HTTP_MAX_HOST_CONNECTIONS, http_max_host_connections);
+
 /// Settings class provides non-persistent, in-process key-value storage.
 class Settings final {
 public:
@@ -8,6 +8,7 @@
 
 #include <array>
 #include <memory>
+#include <optional>
 #include <string>
 
 namespace mbgl {
@@ -62,6 +63,11 @@ protected:
     /// Determine whether this tweaker should apply to the given drawable
     bool checkTweakDrawable(const gfx::Drawable&) const;
 
+    /// Whether the inputs of the drawable uniforms are the same as in the previous execution, so that those uniforms
+    /// can be kept. The inputs are the camera, the drawables of the layer group, the evaluated properties and a seed
+    /// for any other inputs of the tweaker. Must be called before `propertiesUpdated` is reset.
+    bool drawableInputsUnchanged(LayerGroupBase&, const PaintParameters&, std::size_t seed = 0);
+
     /// Multiplies with the projection matrix (either default, near clipped or aligned) for the given drawable
     static void multiplyWithProjectionMatrix(/*in-out*/ mat4& matrix,
                                              const PaintParameters& parameters,
@@ -74,6 +80,9 @@ protected:
 
     // Indicates that the evaluated properties have changed
     bool propertiesUpdated = true;
+
+    /// The fingerprint of the inputs of the drawable uniforms, see `drawableInputsUnchanged`
+    std::optional<std::size_t> drawableInputsHash;
 };
 
 } // namespace mbgl
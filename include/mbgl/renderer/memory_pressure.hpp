@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace mbgl {
+
+/// How urgently memory is to be given back, for platforms to map their low memory notifications to
+enum class MemoryPressureLevel : uint8_t {
+    /// Halve the tile caches and the text shaping cache, and remove the style images no longer used
+    Moderate,
+    /// Empty those caches, and release the pooled render targets and staging memory of the context
+    Critical,
+};
+
+/// What a response to memory pressure freed, see `Renderer::onMemoryPressure`
+struct MemoryPressureReport {
+    struct Step {
+        std::string name;
+        /// The memory held by what the step releases before it less that held after, as `MemoryReport`
+        /// measures it. Style images are removed on the map thread, so that step usually frees nothing by the
+        /// time it's reported.
+        std::size_t freedBytes = 0;
+    };
+
+    MemoryPressureLevel level = MemoryPressureLevel::Moderate;
+    /// In the order they ran
+    std::vector<Step> steps;
+
+    std::size_t freedBytes() const {
+        std::size_t total = 0;
+        for (const auto& step : steps) {
+            total += step.freedBytes;
+        }
+        return total;
+    }
+};
+
+} // namespace mbgl
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <mbgl/util/memory_usage.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace mbgl {
+
+/// Approximate memory held by a renderer, see `Renderer::getMemoryReport`
+struct MemoryReport {
+    struct Source {
+        std::string id;
+        /// Tiles held, including the cached ones
+        std::size_t tiles = 0;
+        /// Decoded tile data, raster images and the glyph and icon atlases of the tiles
+        MemoryUsage tileData;
+        /// Vertex, index and segment vectors of the buckets, and the device buffers they were uploaded to
+        MemoryUsage buckets;
+        /// Feature indexes used to query rendered features
+        MemoryUsage featureIndexes;
+
+        MemoryUsage total() const { return tileData + buckets + featureIndexes; }
+    };
+
+    struct Layer {
+        std::string id;
+        /// The buckets of the layer in all the tiles held. Layers with identical layout properties share
+        /// buckets, which are counted once, under one of them.
+        MemoryUsage buckets;
+    };
+
+    /// Both most memory first
+    std::vector<Source> sources;
+    std::vector<Layer> layers;
+
+    /// Glyph bitmaps loaded for the font stacks in use
+    MemoryUsage glyphs;
+    /// Style images, from sprites and added at runtime
+    MemoryUsage images;
+    /// Dash patterns of lines
+    MemoryUsage lineAtlas;
+    /// Images of pattern properties
+    MemoryUsage patternAtlas;
+    /// Textures glyphs and icons are packed into, shared by the tiles
+    MemoryUsage textureAtlas;
+
+    /// Device memory allocated by the context, from the counters of `gfx::RenderingStats`. It includes
+    /// what's attributed above, as well as the uniform buffers and render targets that aren't.
+    std::size_t contextTextureBytes = 0;
+    std::size_t contextVertexBufferBytes = 0;
+    std::size_t contextIndexBufferBytes = 0;
+    std::size_t contextUniformBufferBytes = 0;
+};
+
+} // namespace mbgl
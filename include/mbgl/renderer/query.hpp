@@ -1,7 +1,9 @@
 #pragma once
 
 #include <mbgl/style/filter.hpp>
+#include <mbgl/util/geo.hpp>
 
+#include <cstddef>
 #include <string>
 #include <vector>
 #include <optional>
@@ -14,14 +16,23 @@ namespace mbgl {
 class RenderedQueryOptions {
 public:
     RenderedQueryOptions(std::optional<std::vector<std::string>> layerIDs_ = std::nullopt,
-                         std::optional<style::Filter> filter_ = std::nullopt)
+                         std::optional<style::Filter> filter_ = std::nullopt,
+                         std::optional<std::size_t> limit_ = std::nullopt)
         : layerIDs(std::move(layerIDs_)),
-          filter(std::move(filter_)) {}
+          filter(std::move(filter_)),
+          limit(limit_) {}
 
     /** layerIDs to include in the query */
     std::optional<std::vector<std::string>> layerIDs;
 
     std::optional<style::Filter> filter;
+
+    /**
+     * Maximum number of features returned. The query stops looking once it has found this many,
+     * so a limited query returns the topmost features of the tiles and sources it visited first
+     * rather than the topmost ones overall.
+     */
+    std::optional<std::size_t> limit;
 };
 
 /**
@@ -30,14 +41,25 @@ public:
 class SourceQueryOptions {
 public:
     SourceQueryOptions(std::optional<std::vector<std::string>> sourceLayers_ = std::nullopt,
-                       std::optional<style::Filter> filter_ = std::nullopt)
+                       std::optional<style::Filter> filter_ = std::nullopt,
+                       std::optional<LatLngBounds> bounds_ = std::nullopt,
+                       bool deduplicate_ = false)
         : sourceLayers(std::move(sourceLayers_)),
-          filter(std::move(filter_)) {}
+          filter(std::move(filter_)),
+          bounds(std::move(bounds_)),
+          deduplicate(deduplicate_) {}
 
     /// Required for VectorSource, ignored for GeoJSONSource
     std::optional<std::vector<std::string>> sourceLayers;
 
     std::optional<style::Filter> filter;
+
+    /// Only tiles overlapping these bounds are searched, and only features whose geometry envelope does
+    std::optional<LatLngBounds> bounds;
+
+    /// Return features found in several tiles, such as those split at tile edges, only once.
+    /// Features are told apart by source layer and ID, features without an ID are all returned.
+    bool deduplicate;
 };
 
 } // namespace mbgl
@@ -78,11 +78,21 @@ public:
     /// Render the layer groups
     void render(RenderOrchestrator&, const RenderTree&, PaintParameters&);
 
+    /// @brief Only render the layer groups again once invalidated, for targets whose contents only
+    /// depend on their input textures. Rendering is repeated while shaders are still being compiled.
+    void setRenderOnDemand(bool onDemand) { renderOnDemand = onDemand; }
+
+    /// Render the layer groups again in the next frame
+    void invalidate() { dirty = true; }
+
 protected:
     gfx::Context& context;
+    const gfx::TextureChannelDataType type;
     std::unique_ptr<gfx::OffscreenTexture> offscreenTexture;
     using LayerGroupMap = std::map<int32_t, LayerGroupBasePtr>;
     LayerGroupMap layerGroupsByLayerIndex;
+    bool renderOnDemand = false;
+    bool dirty = true;
 };
 
 } // namespace mbgl
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <mbgl/gfx/rendering_stats.hpp>
+#include <mbgl/renderer/memory_pressure.hpp>
+#include <mbgl/renderer/memory_report.hpp>
 #include <mbgl/renderer/query.hpp>
 #include <mbgl/annotation/annotation.hpp>
 #include <mbgl/util/geo.hpp>
@@ -13,6 +16,7 @@
 namespace mbgl {
 
 class RendererObserver;
+class RendererResourceGroup;
 class RenderedQueryOptions;
 class SourceQueryOptions;
 class UpdateParameters;
@@ -51,6 +55,10 @@ public:
 
     void setObserver(RendererObserver*);
 
+    /// Shares the shader programs of the renderers given the same group, see `RendererResourceGroup`. To be set
+    /// before the first frame is rendered, the shaders of a renderer aren't replaced once created.
+    void setResourceGroup(std::shared_ptr<RendererResourceGroup>);
+
     void render(const std::shared_ptr<UpdateParameters>&);
 
     /// Feature queries
@@ -76,6 +84,11 @@ public:
                          const std::string& featureID,
                          const FeatureState& state);
 
+    /// Set the states of many features of a source layer at once, keyed by feature ID
+    void setFeatureStates(const std::string& sourceID,
+                          const std::optional<std::string>& sourceLayerID,
+                          const FeatureStates& states);
+
     void getFeatureState(FeatureState& state,
                          const std::string& sourceID,
                          const std::optional<std::string>& sourceLayerID,
@@ -110,7 +123,36 @@ public:
     // Memory
     void setTileCacheEnabled(bool);
     bool getTileCacheEnabled() const;
+
+    // Fill rate
+    /// Size of the textures heatmap densities are accumulated in, relative to the viewport. They are
+    /// scaled up bilinearly when colored. Clamped to [1/8, 1], defaults to 1/2.
+    void setHeatmapResolutionScale(float);
+    float getHeatmapResolutionScale() const;
+    /// Fill extrusion tiles whose small buildings would be narrower than this many pixels are drawn
+    /// without the walls of those buildings and of the ones adjoining a neighbour. Zero, the
+    /// default, always draws every wall.
+    void setFillExtrusionLODThreshold(float pixels);
+    float getFillExtrusionLODThreshold() const;
+
+    // Profiling
+    /// Measures the GPU time of each layer and render pass, averaged over the last frames, with timer
+    /// queries that have a small cost of their own. Disabled by default. Currently only supported by
+    /// the OpenGL backend, where GL_TIMESTAMP queries are available.
+    void setGPUSectionTiming(bool enable);
+    bool getGPUSectionTiming() const;
+    /// The GPU section times measured so far, most expensive first. Also in the rendering stats.
+    std::vector<gfx::GPUSectionTime> getGPUSectionTimes() const;
+
+    /// Approximate memory held by each source and layer, and by the resources they share. Walks every
+    /// tile held, so it's meant for diagnostics rather than to be called each frame.
+    MemoryReport getMemoryReport() const;
+
     void reduceMemoryUse();
+    /// Gives memory back in steps, more of it at the critical level, for platforms to call on their low
+    /// memory notifications. Each step reports how much it freed. Whatever is released is rebuilt or
+    /// reloaded when needed again.
+    MemoryPressureReport onMemoryPressure(MemoryPressureLevel);
     void clearData();
 
 #if MLN_RENDER_BACKEND_OPENGL
@@ -5,6 +5,7 @@
 #include <mbgl/gfx/rendering_stats.hpp>
 #include <mbgl/text/glyph_range.hpp>
 #include <mbgl/tile/tile_operation.hpp>
+#include <mbgl/tile/tile_latency.hpp>
 #include <mbgl/gfx/backend.hpp>
 #include <mbgl/shaders/shader_source.hpp>
 
@@ -52,6 +53,8 @@ public:
         onDidFinishRenderingFrame(mode, repaint, placementChanged);
     }
 
+    /// End of frame, with the stats of the frame. They include the CPU time of each phase of the frame,
+    /// which is measured in every build, unlike the trace zones.
     virtual void onDidFinishRenderingFrame(RenderMode mode,
                                            bool repaint,
                                            bool placementChanged,
@@ -80,6 +83,8 @@ public:
 
     // Tile loading
     virtual void onTileAction(TileOperation, const OverscaledTileID&, const std::string&) {}
+    /// The latencies of the tiles of a source so far, each time some of them are rendered for the first time
+    virtual void onTileLatencies(const std::string& /*sourceID*/, const TileLatencies&) {}
 
     /// Render layer or drawable failed
     virtual void onRenderError(std::exception_ptr) {}
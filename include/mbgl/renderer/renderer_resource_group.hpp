@@ -0,0 +1,38 @@
+#pragma once
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace mbgl {
+
+namespace gfx {
+class ShaderRegistry;
+} // namespace gfx
+
+/**
+ * @brief Shader programs shared by renderers, for apps showing several maps at once, see `Renderer::setResourceGroup`.
+ *
+ * Only for renderers whose backends can use each other's programs: GL contexts of the same share group, or Vulkan and
+ * Metal backends on the same device. The programs, and the pipelines they cache, keep referring to the backend that
+ * compiled them, so that one has to outlive the group. Static buffers and atlases are not shared, as their lifetime is
+ * tracked by the context that uploaded them.
+ */
+class RendererResourceGroup {
+public:
+    RendererResourceGroup();
+    ~RendererResourceGroup();
+
+    /// The shaders for renderers with the given pixel ratio, `initialize` fills them in for the first one to ask
+    /// (internal core use only)
+    std::shared_ptr<gfx::ShaderRegistry> getShaders(float pixelRatio,
+                                                    const std::function<void(gfx::ShaderRegistry&)>& initialize);
+
+private:
+    std::mutex mutex;
+    /// Shaders are compiled for a pixel ratio
+    std::map<float, std::shared_ptr<gfx::ShaderRegistry>> shaders;
+};
+
+} // namespace mbgl
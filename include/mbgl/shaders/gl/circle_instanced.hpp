@@ -0,0 +1,16 @@
+// Generated code, do not modify this file!
+#pragma once
+#include <mbgl/shaders/shader_source.hpp>
+
+namespace mbgl {
+namespace shaders {
+
+template <>
+struct ShaderSource<BuiltIn::CircleInstancedShader, gfx::Backend::Type::OpenGL> {
+    static constexpr const char* name = "CircleInstancedShader";
+    static constexpr const char* vertex = R"()";
+    static constexpr const char* fragment = R"()";
+};
+
+} // namespace shaders
+} // namespace mbgl
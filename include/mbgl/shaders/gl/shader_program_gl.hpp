@@ -6,6 +6,7 @@
 #include <mbgl/shaders/shader_program_base.hpp>
 #include <mbgl/shaders/gl/shader_info.hpp>
 
+#include <memory>
 #include <unordered_map>
 
 namespace mbgl {
@@ -21,7 +22,7 @@ public:
     ShaderProgramGL(UniqueProgram&& glProgram_);
     ShaderProgramGL(UniqueProgram&&, VertexAttributeArrayGL&& attributes, SamplerLocationArray&& samplerLocations);
     ShaderProgramGL(ShaderProgramGL&& other);
-    ~ShaderProgramGL() noexcept override = default;
+    ~ShaderProgramGL() noexcept override;
 
     static constexpr std::string_view Name{"GenericGLShader"};
     const std::string_view typeName() const noexcept override { return Name; }
@@ -44,8 +45,24 @@ public:
 
     ProgramID getGLProgramID() const { return glProgram; }
 
+    /// Whether the program can be used for drawing. With asynchronous compilation, this is false until the
+    /// driver has finished linking, and stays false if compilation failed.
+    bool isReady() {
+        if (pendingLink) {
+            finishLink();
+        }
+        return !pendingLink && !linkFailed;
+    }
+
 protected:
+    struct PendingLink;
+
+    /// Complete the introspection of a program linked in the background, if the driver is done with it
+    void finishLink();
+
     UniqueProgram glProgram;
+    std::unique_ptr<PendingLink> pendingLink;
+    bool linkFailed = false;
 
     VertexAttributeArrayGL vertexAttributes;
     VertexAttributeArrayGL instanceAttributes;
@@ -95,10 +95,11 @@ struct FragmentStage {
 };
 
 FragmentStage vertex vertexMain(VertexStage in [[stage_in]],
+                                uint instanceID [[instance_id]],
                                 device const uint32_t& uboIndex [[buffer(idGlobalUBOIndex)]],
                                 device const BackgroundDrawableUnionUBO* drawableVector [[buffer(idBackgroundDrawableUBO)]]) {
 
-    device const BackgroundDrawableUBO& drawable = drawableVector[uboIndex].backgroundDrawableUBO;
+    device const BackgroundDrawableUBO& drawable = drawableVector[uboIndex + instanceID].backgroundDrawableUBO;
 
     return {
         .position = drawable.matrix * float4(float2(in.position.xy), 0, 1)
@@ -140,11 +141,12 @@ struct FragmentStage {
 };
 
 FragmentStage vertex vertexMain(VertexStage in [[stage_in]],
+                                uint instanceID [[instance_id]],
                                 device const uint32_t& uboIndex [[buffer(idGlobalUBOIndex)]],
                                 device const BackgroundDrawableUnionUBO* drawableVector [[buffer(idBackgroundDrawableUBO)]],
                                 device const BackgroundPatternPropsUBO& props [[buffer(idBackgroundPropsUBO)]]) {
 
-    device const BackgroundPatternDrawableUBO& drawable = drawableVector[uboIndex].backgroundPatternDrawableUBO;
+    device const BackgroundPatternDrawableUBO& drawable = drawableVector[uboIndex + instanceID].backgroundPatternDrawableUBO;
 
     const float2 pos = float2(in.position);
     const float2 pos_a = get_pattern_pos(drawable.pixel_coord_upper,
@@ -363,6 +363,9 @@ enum {
 
 enum {
     idCirclePosVertexAttribute,
+#if MLN_USE_CIRCLE_INSTANCING
+    idCircleCenterAttribute,
+#endif
 
     // Data driven
     idCircleColorVertexAttribute,
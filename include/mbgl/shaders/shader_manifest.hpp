@@ -8,6 +8,7 @@
 #include <mbgl/shaders/gl/background.hpp>
 #include <mbgl/shaders/gl/background_pattern.hpp>
 #include <mbgl/shaders/gl/circle.hpp>
+#include <mbgl/shaders/gl/circle_instanced.hpp>
 #include <mbgl/shaders/gl/collision_box.hpp>
 #include <mbgl/shaders/gl/collision_circle.hpp>
 #include <mbgl/shaders/gl/custom_geometry.hpp>
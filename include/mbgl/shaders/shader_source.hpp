@@ -14,6 +14,7 @@ enum class BuiltIn {
     BackgroundShader,
     BackgroundPatternShader,
     CircleShader,
+    CircleInstancedShader,
     CollisionBoxShader,
     CollisionCircleShader,
     CustomGeometryShader,
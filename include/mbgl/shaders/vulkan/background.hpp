@@ -41,7 +41,7 @@ layout(std140, set = LAYER_SET_INDEX, binding = idBackgroundDrawableUBO) readonl
 } drawableVector;
 
 void main() {
-    const BackgroundDrawableUBO drawable = drawableVector.drawable_ubo[constant.ubo_index];
+    const BackgroundDrawableUBO drawable = drawableVector.drawable_ubo[constant.ubo_index + gl_InstanceIndex];
 
     gl_Position = drawable.matrix * vec4(in_position, 0.0, 1.0);
     applySurfaceTransform();
@@ -118,7 +118,7 @@ layout(location = 0) out vec2 frag_pos_a;
 layout(location = 1) out vec2 frag_pos_b;
 
 void main() {
-    const BackgroundPatternDrawableUBO drawable = drawableVector.drawable_ubo[constant.ubo_index];
+    const BackgroundPatternDrawableUBO drawable = drawableVector.drawable_ubo[constant.ubo_index + gl_InstanceIndex];
 
     frag_pos_a = get_pattern_pos(drawable.pixel_coord_upper,
                                  drawable.pixel_coord_lower,
@@ -18,6 +18,7 @@ public:
     /// FileSource overrides
     std::unique_ptr<AsyncRequest> request(const Resource&, Callback) override;
     void forward(const Resource&, const Response&, std::function<void()> callback) override;
+    void putTileLayout(const Resource&, std::shared_ptr<const std::string> data, std::string layout) override;
     bool canRequest(const Resource&) const override;
     void setProperty(const std::string&, const mapbox::base::Value&) override;
     void pause() override;
@@ -211,6 +212,16 @@ public:
     virtual void mergeOfflineRegions(const std::string& sideDatabasePath,
                                      std::function<void(expected<OfflineRegions, std::exception_ptr>)>);
 
+    /**
+     * Like the above, also reporting the progress of the merge, which for large
+     * secondary databases is dominated by copying their tiles. `progress` is
+     * called on the database thread with the number of tiles of the secondary
+     * database processed so far and their total.
+     */
+    virtual void mergeOfflineRegions(const std::string& sideDatabasePath,
+                                     std::function<void(uint64_t, uint64_t)> progress,
+                                     std::function<void(expected<OfflineRegions, std::exception_ptr>)>);
+
     /**
      * Remove an offline region from the database and perform any resources
      * evictions necessary as a result.
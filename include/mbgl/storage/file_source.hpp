@@ -44,7 +44,9 @@ public:
     /// same thread as the request was made. This thread must have an active
     /// RunLoop. The request may be cancelled before completion by releasing the
     /// returned AsyncRequest. If the request is cancelled before the callback
-    /// is executed, the callback will not be executed.
+    /// is executed, the callback will not be executed. Data that the file
+    /// source stores compressed, like the tiles of MBTiles and PMTiles files
+    /// or of the offline database, is decompressed before it is passed on.
     virtual std::unique_ptr<AsyncRequest> request(const Resource&, Callback) = 0;
 
     /// Allows to forward response from one source to another.
@@ -54,6 +56,12 @@ public:
     // NOLINTNEXTLINE(performance-unnecessary-value-param)
     virtual void forward(const Resource&, const Response&, std::function<void()>) {}
 
+    /// Stores what layout produced from the data of a tile, for a later response with the same data
+    /// to carry it in `Response::layout`. File sources without storage ignore it.
+    //
+    // NOLINTNEXTLINE(performance-unnecessary-value-param)
+    virtual void putTileLayout(const Resource&, std::shared_ptr<const std::string>, std::string) {}
+
     /// When a file source supports consulting a local cache only, it must
     /// return true. Cache-only requests are requests that aren't as urgent, but
     /// could be useful, e.g. to cover part of the map while loading. The
@@ -112,10 +120,62 @@ constexpr const char* API_BASE_URL_KEY = "api-base-url";
 /// type: unsigned
 constexpr const char* MAX_CONCURRENT_REQUESTS_KEY = "max-concurrent-requests";
 
+/// Property name to set / get the maximum number of concurrent revalidations, i.e. conditional
+/// requests for data the requester already has, such as expired tiles that are still shown. When
+/// set, these requests queue behind the regular ones and at most this many of them are sent at
+/// once, so a burst of expirations after resuming the app can't delay the tiles that are missing.
+/// 0, the default, treats them like any other request. type: unsigned
+constexpr const char* MAX_CONCURRENT_REVALIDATIONS_KEY = "max-concurrent-revalidations";
+
+/// Property name to set / get whether the number of concurrent requests adapts to the bandwidth
+/// and round-trip time estimated from the completed requests, up to `MAX_CONCURRENT_REQUESTS_KEY`.
+/// When set, queued requests of similar rank are also sent by increasing expected size, so large
+/// raster tiles don't hold up small vector tiles on slow links. type: bool
+constexpr const char* ADAPTIVE_CONCURRENCY_KEY = "adaptive-concurrency";
+
+/// Property name to get the network estimates: "rtt-ms", "bandwidth" in bytes per second, the
+/// current "concurrency" limit, and per request class (the resource kind, or "tile:" and the URL
+/// template for tiles) the "requests" and "bytes" so far with their smoothed "average-bytes" and
+/// "latency-ms". type: object, read-only
+constexpr const char* NETWORK_METRICS_KEY = "network-metrics";
+
 // Properties that may be supported by database file sources:
 
 /// Property to set database mode. When set, database opens in read-only mode;
 /// database opens in read-write-create mode otherwise. type: bool
 constexpr const char* READ_ONLY_MODE_KEY = "read-only-mode";
 
+/// Property to set the durability profile of ambient cache writes. When set, the database uses
+/// WAL journaling with NORMAL sync and commits ambient cache writes in batches, so a crash or
+/// power loss may drop the most recent cache entries. Offline region writes stay fully synced
+/// either way. type: bool
+constexpr const char* CACHE_GRADE_DURABILITY_KEY = "cache-grade-durability";
+
+/// Property to compress tiles with zstd and a dictionary trained from the tiles of the database,
+/// rather than with Deflate. Only supported by builds with zstd. type: bool
+constexpr const char* ZSTD_TILE_COMPRESSION_KEY = "zstd-tile-compression";
+
+/// Property to serve expired cached resources right away even when their Cache-Control headers
+/// require revalidation, leaving the requester to revalidate them in the background. Meant to be
+/// paired with `MAX_CONCURRENT_REVALIDATIONS_KEY` on the online file source. type: bool
+constexpr const char* STALE_WHILE_REVALIDATE_KEY = "stale-while-revalidate";
+
+// Properties that may be supported by PMTiles file sources:
+
+/// Property name to get the number of range requests sent for remote archives so far. Sampling it
+/// once per frame gives the round-trips each frame needed. type: uint64_t, read-only
+constexpr const char* PMTILES_RANGE_REQUESTS_KEY = "pmtiles-range-requests";
+
+/// Property name to set / get the byte budget of the decoded directories cached for all PMTiles
+/// archives in the process. type: uint64_t
+constexpr const char* PMTILES_DIRECTORY_CACHE_SIZE_KEY = "pmtiles-directory-cache-size";
+
+/// Property name to get the bytes currently used by the directory cache. type: uint64_t, read-only
+constexpr const char* PMTILES_DIRECTORY_CACHE_USAGE_KEY = "pmtiles-directory-cache-usage";
+
+/// Property names to get how many directory lookups were served by the cache, or had to fetch
+/// the directory, in the process so far. type: uint64_t, read-only
+constexpr const char* PMTILES_DIRECTORY_CACHE_HITS_KEY = "pmtiles-directory-cache-hits";
+constexpr const char* PMTILES_DIRECTORY_CACHE_MISSES_KEY = "pmtiles-directory-cache-misses";
+
 } // namespace mbgl
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <mbgl/storage/file_source.hpp>
+#include <mbgl/storage/file_source_metrics.hpp>
 
 namespace mbgl {
 
@@ -43,6 +44,10 @@ public:
     // a FileSourceType invocation has no effect.
     virtual FileSourceFactory unRegisterFileSourceFactory(FileSourceType) noexcept;
 
+    // Telemetry of the cache lookups and network requests of all file sources
+    // in the process, per resource kind and host.
+    FileSourceMetrics& getMetrics() noexcept;
+
 protected:
     FileSourceManager();
     class Impl;
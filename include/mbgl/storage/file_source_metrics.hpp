@@ -0,0 +1,93 @@
+#pragma once
+
+#include <mbgl/storage/resource.hpp>
+#include <mbgl/util/chrono.hpp>
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <tuple>
+
+namespace mbgl {
+
+class Response;
+
+/**
+ * @brief Telemetry of the requests served by the file sources of the process.
+ *
+ * Responses are accounted per resource kind, host and origin: the cache
+ * lookups of the database file source, and the requests sent by the online
+ * file source. Each class keeps counters and latency histograms with fixed
+ * buckets, so recording a response is a map lookup under a mutex.
+ */
+class FileSourceMetrics {
+public:
+    enum class Origin : uint8_t {
+        Cache,
+        Network,
+    };
+
+    /// Latencies counted in buckets of exponentially growing width
+    class Histogram {
+    public:
+        /// Upper bounds of the buckets, in milliseconds, but for the last one which takes the rest
+        static constexpr std::array<double, 12> bounds{1, 2, 5, 10, 20, 50, 100, 200, 500, 1000, 2000, 5000};
+
+        void add(Duration);
+
+        /// The upper bound of the bucket holding the given percentile (0-100) of the latencies, in
+        /// milliseconds. The last bucket reports the largest latency recorded.
+        double percentile(double) const;
+
+        uint64_t count = 0;
+        double totalMilliseconds = 0;
+        double maxMilliseconds = 0;
+        std::array<uint64_t, bounds.size() + 1> buckets{};
+    };
+
+    struct Key {
+        Resource::Kind kind;
+        /// Host and port of the URL, empty for URLs without one
+        std::string host;
+        Origin origin;
+
+        bool operator<(const Key& other) const {
+            return std::tie(kind, host, origin) < std::tie(other.kind, other.host, other.origin);
+        }
+    };
+
+    struct Entry {
+        /// Responses, including the ones counted below
+        uint64_t responses = 0;
+        /// Cache lookups that found no usable data
+        uint64_t misses = 0;
+        /// Network responses confirming the data the requester had
+        uint64_t notModified = 0;
+        /// Responses with any other error
+        uint64_t errors = 0;
+        /// Bytes of the response data
+        uint64_t bytes = 0;
+        /// From the request until its response
+        Histogram latency;
+        /// Network requests only: waiting for a free connection, which is part of the latency
+        Histogram queueWait;
+    };
+
+    using Snapshot = std::map<Key, Entry>;
+
+    void record(const Resource&, Origin, const Response&, Duration latency, Duration queueWait = Duration::zero());
+
+    /// A copy of the metrics recorded since the last reset
+    Snapshot snapshot() const;
+    void reset();
+
+    static std::string host(const std::string& url);
+
+private:
+    mutable std::mutex mutex;
+    Snapshot entries;
+};
+
+} // namespace mbgl
@@ -138,6 +138,14 @@ public:
      */
     uint64_t requiredTileCount = 0;
 
+    /**
+     * An estimate of the cumulative size, in bytes, of the tiles that are known
+     * to be required for this region, from the mean size per zoom level of the
+     * tiles of the same sources already in the database, e.g. in the ambient
+     * cache. Zero when no such tiles are stored.
+     */
+    uint64_t requiredTileSizeEstimate = 0;
+
     /**
      * The cumulative size, in bytes, of all tiles that have been fully
      * downloaded. This is a subset of `completedResourceSize`.
@@ -165,6 +173,30 @@ public:
     bool complete() const { return completedResourceCount >= requiredResourceCount; }
 };
 
+/*
+ * Throughput of an active download, measured over the last window of responses
+ * received from the network. Resources that were already stored in the database
+ * don't count towards it.
+ */
+class OfflineRegionDownloadRate {
+public:
+    /**
+     * The number of bytes per second received over the window.
+     */
+    double bytesPerSecond = 0;
+
+    /**
+     * The number of tiles per second received over the window.
+     */
+    double tilesPerSecond = 0;
+
+    /**
+     * The number of requests the download keeps in flight from now on, after
+     * adjusting to the latency and error rate seen over the window.
+     */
+    uint32_t concurrentRequests = 0;
+};
+
 /*
  * A region can have a single observer, which gets notified whenever a change
  * to the region's status occurs.
@@ -211,6 +243,16 @@ public:
      * that re-executes the user-provided implementation on the main thread.
      */
     virtual void mapboxTileCountLimitExceeded(uint64_t /* limit */) {}
+
+    /*
+     * Implement this method to be notified of the download throughput each time
+     * a window of network responses has been received and stored.
+     *
+     * Note that this method will be executed on the database thread; it is the
+     * responsibility of the SDK bindings to wrap this object in an interface
+     * that re-executes the user-provided implementation on the main thread.
+     */
+    virtual void downloadRateChanged(OfflineRegionDownloadRate) {}
 };
 
 class OfflineRegion {
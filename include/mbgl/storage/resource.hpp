@@ -5,6 +5,8 @@
 #include <mbgl/util/font_stack.hpp>
 #include <mbgl/util/tileset.hpp>
 
+#include <atomic>
+#include <memory>
 #include <string>
 #include <optional>
 
@@ -91,6 +93,10 @@ public:
     LoadingMethod loadingMethod;
     Usage usage{Usage::Online};
     Priority priority{Priority::Regular};
+    // Orders pending requests of the same priority, lower non-negative ranks are sent first.
+    // Shared with the requester, which may update it while the request waits, e.g. when the
+    // camera moves.
+    std::shared_ptr<std::atomic<float>> rank;
     std::string url;
 
     // Includes auxiliary data if this is a tile request.
@@ -33,6 +33,10 @@ public:
     // The actual data of the response. Present only for non-error, non-notModified responses.
     std::shared_ptr<const std::string> data;
 
+    // For tiles of offline regions read from the offline database, what was stored with
+    // `FileSource::putTileLayout` for this same data, if anything.
+    std::shared_ptr<const std::string> layout;
+
     std::optional<Timestamp> modified;
     std::optional<Timestamp> expires;
     std::optional<std::string> etag;
@@ -3,6 +3,8 @@
 #include <mbgl/util/geojson.hpp>
 #include <mbgl/style/conversion.hpp>
 
+#include <cstddef>
+#include <functional>
 #include <optional>
 
 namespace mbgl {
@@ -12,6 +14,17 @@ namespace conversion {
 // Workaround until https://github.com/mapbox/mapbox-gl-native/issues/5623 is done.
 std::optional<GeoJSON> parseGeoJSON(const std::string&, Error&);
 
+using GeoJSONFeaturesCallback = std::function<void(mapbox::geojson::feature_collection&&, std::size_t bytesRead)>;
+
+// Parses GeoJSON without building a document of the whole text first. The features of a
+// FeatureCollection whose "type" precedes its "features" are handed to `onFeatures` in chunks of
+// `chunkSize` as they're read, the returned collection is then left empty. Anything else is
+// returned whole, as `parseGeoJSON` would.
+std::optional<GeoJSON> parseGeoJSON(const std::string&,
+                                    std::size_t chunkSize,
+                                    const GeoJSONFeaturesCallback& onFeatures,
+                                    Error&);
+
 template <>
 struct Converter<GeoJSON> {
 public:
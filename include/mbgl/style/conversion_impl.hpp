@@ -216,6 +216,9 @@ private:
 #elif __QT__
     // Qt:          JSValue* or QVariant
     using Storage = std::aligned_storage_t<32, 8>;
+#elif MLN_WITH_SIMDJSON
+    // simdjson:    JSValue* or simdjson::dom::element
+    using Storage = std::aligned_storage_t<16, 8>;
 #else
     // Node:        JSValue* or v8::Local<v8::Value>
     // iOS/macOS:   JSValue* or id
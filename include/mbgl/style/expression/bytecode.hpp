@@ -0,0 +1,109 @@
+#pragma once
+
+#include <mbgl/style/expression/expression.hpp>
+#include <mbgl/util/color.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace mbgl {
+namespace style {
+namespace expression {
+
+class Interpolate;
+
+/**
+    A number or color expression lowered into a flat list of register instructions, evaluated
+    without the virtual calls and `Value` conversions of the expression tree.
+
+    Only a subset is covered: number literals, `zoom`, `get` of a number property, arithmetic
+    and the unary math operators, and `interpolate`/`step` producing numbers or colors. `compile`
+    returns null for anything else, in which case the tree remains the evaluator; it's also kept
+    as the reference the bytecode is checked against. Results match the tree's, with any error
+    reported as an empty result rather than an `EvaluationError`.
+ */
+class Bytecode {
+public:
+    enum class Op : uint8_t {
+        Constant,
+        Zoom,
+        Get,
+        Add,
+        Subtract,
+        Multiply,
+        Divide,
+        Modulo,
+        Power,
+        Min,
+        Max,
+        Negate,
+        Abs,
+        Floor,
+        Ceil,
+        Round,
+        Sqrt,
+        Curve,
+        ColorConstant,
+        ColorCurve,
+    };
+
+    struct Instruction {
+        Op op;
+        uint8_t dst;
+        uint8_t a = 0;
+        uint8_t b = 0;
+        /// Constant, key or curve index, depending on the operation
+        uint32_t index = 0;
+    };
+
+    /// Returns null when the expression uses anything the bytecode doesn't cover
+    static std::unique_ptr<Bytecode> compile(const Expression&);
+
+    bool isColor() const noexcept { return color; }
+
+    std::optional<double> evaluateNumber(const EvaluationContext&) const;
+    std::optional<Color> evaluateColor(const EvaluationContext&) const;
+
+    const std::vector<Instruction>& getInstructions() const noexcept { return code; }
+
+    static constexpr std::size_t maxRegisters = 32;
+    static constexpr std::size_t maxColorRegisters = 8;
+
+private:
+    friend class BytecodeCompiler;
+
+    struct Block {
+        uint32_t begin;
+        uint32_t end;
+        uint8_t result;
+    };
+
+    /// An `interpolate` or `step`; its stop outputs are compiled into the blocks that follow the
+    /// instruction, and only the ones selected by the input are run.
+    struct Curve {
+        const Interpolate* interpolate = nullptr;
+        std::vector<double> inputs;
+        std::vector<Block> blocks;
+        uint32_t end = 0;
+    };
+
+    struct Registers;
+
+    bool run(uint32_t begin, uint32_t end, const EvaluationContext&, Registers&) const;
+    bool runCurve(const Instruction&, const EvaluationContext&, Registers&) const;
+
+    std::vector<Instruction> code;
+    std::vector<double> constants;
+    std::vector<Color> colors;
+    std::vector<std::string> keys;
+    std::vector<Curve> curves;
+    uint8_t result = 0;
+    bool color = false;
+};
+
+} // namespace expression
+} // namespace style
+} // namespace mbgl
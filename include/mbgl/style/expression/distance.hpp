@@ -15,7 +15,13 @@
 #include <mbgl/style/expression/expression.hpp>
 #include <mbgl/util/geojson.hpp>
 
+#include <vector>
+
 namespace mbgl {
+
+template <typename T>
+class PolygonEdgeIndex;
+
 namespace style {
 namespace expression {
 
@@ -40,6 +46,8 @@ public:
 private:
     GeoJSON geoJSONSource;
     Feature::geometry_type geometries;
+    // Of each polygon of the geometries
+    std::vector<PolygonEdgeIndex<double>> polygonIndexes;
 };
 
 } // namespace expression
@@ -3,6 +3,9 @@
 #include <mbgl/style/expression/expression.hpp>
 #include <mbgl/util/geojson.hpp>
 
+#include <map>
+#include <memory>
+#include <mutex>
 #include <optional>
 
 namespace mbgl {
@@ -28,9 +31,18 @@ public:
     mbgl::Value serialize() const override;
     std::string getOperator() const override { return "within"; }
 
+    // The polygons in the tile coordinates of a zoom level, indexed for the point and line tests
+    struct TilePolygons;
+
 private:
+    std::shared_ptr<const TilePolygons> getTilePolygons(uint8_t z) const;
+
     GeoJSON geoJSONSource;
     Feature::geometry_type geometries;
+
+    // Built on the first evaluation at each zoom level, as the layout of tiles runs on several threads
+    mutable std::mutex tilePolygonsMutex;
+    mutable std::map<uint8_t, std::shared_ptr<const TilePolygons>> tilePolygons;
 };
 
 } // namespace expression
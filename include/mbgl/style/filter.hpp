@@ -13,6 +13,8 @@
 namespace mbgl {
 namespace style {
 
+class BatchFilter;
+
 class Filter {
 public:
     std::optional<std::shared_ptr<const expression::Expression>> expression;
@@ -20,14 +22,15 @@ public:
 private:
     std::optional<mbgl::Value> legacyFilter;
 
+    friend class BatchFilter;
+    struct BatchFilterCache;
+    // The `BatchFilter` compiled from the expression on first use, shared by the copies of the filter
+    std::shared_ptr<BatchFilterCache> batchFilterCache;
+
 public:
     Filter() = default;
 
-    Filter(expression::ParseResult _expression, std::optional<mbgl::Value> _filter = std::nullopt)
-        : expression(std::move(*_expression)),
-          legacyFilter(std::move(_filter)) {
-        assert(!expression || *expression != nullptr);
-    }
+    Filter(expression::ParseResult _expression, std::optional<mbgl::Value> _filter = std::nullopt);
 
     bool operator()(const expression::EvaluationContext& context) const;
 
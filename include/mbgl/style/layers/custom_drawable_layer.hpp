@@ -13,6 +13,7 @@
 #include <array>
 #include <memory>
 #include <optional>
+#include <vector>
 
 namespace mbgl {
 namespace style {
@@ -82,6 +83,10 @@ public:
     using SymbolTweakerCallback = TweakerCallback<SymbolOptions>;
     using GeometryTweakerCallback = TweakerCallback<GeometryOptions>;
 
+    /// A fill tessellated ahead of being added, see `prepareFill`
+    struct PreparedFill;
+    using PreparedFillPtr = std::shared_ptr<const PreparedFill>;
+
 public:
     /// @brief Construct a new Interface object (internal core use only)
     Interface(RenderLayer& layer,
@@ -167,6 +172,30 @@ public:
      */
     util::SimpleIdentity addFill(const GeometryCollection& geometry);
 
+    /**
+     * @brief Add a multipolygon area fill tessellated with `prepareFill`
+     *
+     * @param fill
+     * @return a valid util::SimpleIdentity if the fill was added
+     */
+    util::SimpleIdentity addFill(const PreparedFillPtr& fill);
+
+    /**
+     * @brief Add many multipolygon area fills, tessellated on the background threads
+     *
+     * @param geometries
+     * @return the identities of the fills, in the same order, valid if the fill was added
+     */
+    std::vector<util::SimpleIdentity> addFills(const std::vector<GeometryCollection>& geometries);
+
+    /**
+     * @brief Tessellate a multipolygon area fill, on any thread, for `addFill` or `updateFill`
+     *
+     * @param geometry a collection of rings with optional holes
+     * @return PreparedFillPtr
+     */
+    static PreparedFillPtr prepareFill(const GeometryCollection& geometry);
+
     /**
      * @brief Add a symbol
      *
@@ -189,6 +218,50 @@ public:
 
     void removeDrawable(const util::SimpleIdentity& id);
 
+    /**
+     * @brief Replace the vertices of a fill added in a previous update, keeping its identity and options
+     *
+     * @param id returned by `addFill`
+     * @param fill
+     * @return true if the fill was found
+     */
+    bool updateFill(const util::SimpleIdentity& id, const PreparedFillPtr& fill);
+
+    /**
+     * @brief Move a symbol added in a previous update, rewriting its four vertices only
+     *
+     * @param id returned by `addSymbol`
+     * @param point
+     * @param textureCoordinates (optional mapping)
+     * @return true if the symbol was found
+     */
+    bool updateSymbol(const util::SimpleIdentity& id,
+                      const GeometryCoordinate& point,
+                      const std::array<std::array<float, 2>, 2>& textureCoordinates = {{{0, 0}, {1, 1}}});
+
+    /**
+     * @brief Replace the vertices and indices of a geometry added in a previous update
+     *
+     * @param id returned by `addGeometry`
+     * @param vertices
+     * @param indices
+     * @return true if the geometry was found
+     */
+    bool updateGeometry(const util::SimpleIdentity& id,
+                        std::shared_ptr<gfx::VertexVector<GeometryVertex>> vertices,
+                        std::shared_ptr<gfx::IndexVector<gfx::Triangles>> indices);
+
+    /**
+     * @brief Offset a line, fill or symbol added in a previous update, without touching its vertices
+     *
+     * Geometries are placed by the matrix of their options instead.
+     *
+     * @param id
+     * @param offset in tile units, or none to draw it where it was built
+     * @return true if the drawable was found
+     */
+    bool moveDrawable(const util::SimpleIdentity& id, std::optional<Point<double>> offset);
+
 public:
     RenderLayer& layer;
     LayerGroupBasePtr& layerGroup;
@@ -217,6 +290,7 @@ private:
 
     std::unique_ptr<gfx::DrawableBuilder> createBuilder(const std::string& name, gfx::ShaderPtr shader) const;
     bool updateBuilder(BuilderType type, const std::string& name, gfx::ShaderPtr shader);
+    gfx::Drawable* findDrawable(const util::SimpleIdentity& id) const;
 
     std::unique_ptr<gfx::DrawableBuilder> builder;
     std::optional<OverscaledTileID> tileID;
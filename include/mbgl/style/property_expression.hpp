@@ -1,6 +1,7 @@
 #pragma once
 
 #include <mbgl/style/expression/expression.hpp>
+#include <mbgl/style/expression/bytecode.hpp>
 #include <mbgl/style/expression/is_constant.hpp>
 #include <mbgl/style/expression/interpolate.hpp>
 #include <mbgl/style/expression/step.hpp>
@@ -56,9 +57,15 @@ public:
 
     const ZoomCurvePtr& getZoomCurve() const { return zoomCurve; }
 
+    /// The compiled form used by `evaluate`, or null if the expression is evaluated as a tree.
+    const expression::Bytecode* getBytecode() const noexcept { return bytecode.get(); }
+
 protected:
     std::shared_ptr<const Expression> expression;
 
+    // Shared along with the expression it points into
+    std::shared_ptr<const expression::Bytecode> bytecode;
+
     ZoomCurvePtr zoomCurve;
 
     bool useIntegerZoom_ = false;
@@ -82,6 +89,18 @@ public:
           defaultValue(std::move(defaultValue_)) {}
 
     T evaluate(const expression::EvaluationContext& context, T finalDefaultValue = T()) const {
+        if constexpr (std::is_same_v<T, float>) {
+            if (bytecode && !bytecode->isColor()) {
+                const auto result = bytecode->evaluateNumber(context);
+                return result ? static_cast<float>(*result) : (defaultValue ? *defaultValue : finalDefaultValue);
+            }
+        } else if constexpr (std::is_same_v<T, Color>) {
+            if (bytecode && bytecode->isColor()) {
+                const auto result = bytecode->evaluateColor(context);
+                return result ? *result : (defaultValue ? *defaultValue : finalDefaultValue);
+            }
+        }
+
         const expression::EvaluationResult result = expression->evaluate(context);
         if (result) {
             const std::optional<T> typed = expression::fromExpressionValue<T>(*result);
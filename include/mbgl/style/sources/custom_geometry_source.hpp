@@ -6,6 +6,9 @@
 #include <mbgl/util/range.hpp>
 #include <mbgl/util/constants.hpp>
 
+#include <utility>
+#include <vector>
+
 namespace mbgl {
 
 class OverscaledTileID;
@@ -23,6 +26,9 @@ class CustomTileLoader;
 // NOTE: Any derived class must invalidate `weakFactory` in the destructor
 class CustomGeometrySource final : public Source {
 public:
+    /// Features in tile coordinates, from 0 to `util::EXTENT`
+    using TileFeatures = mapbox::feature::feature_collection<int16_t>;
+
     struct TileOptions {
         double tolerance = 0.375;
         uint16_t tileSize = util::tileSize_I;
@@ -36,6 +42,10 @@ public:
         TileFunction cancelTileFunction;
         Range<uint8_t> zoomRange = {0, 18};
         TileOptions tileOptions;
+        /// Call `fetchTileFunction` and `cancelTileFunction` on a pool of threads rather than one call after the
+        /// other on the loader's thread. Both functions must then be thread-safe, and a tile may be cancelled
+        /// while its fetch is still running.
+        bool threadedFetch = false;
     };
 
 public:
@@ -43,6 +53,11 @@ public:
     ~CustomGeometrySource() final;
     void loadDescription(FileSource&) final;
     void setTileData(const CanonicalTileID&, const GeoJSON&);
+    /// Sets the data of several tiles at once, with a single message to the loader
+    void setTileData(const std::vector<std::pair<CanonicalTileID, GeoJSON>>&);
+    /// Sets the features of a tile as they are to be rendered, skipping the conversion from GeoJSON: they
+    /// aren't clipped, simplified or buffered. The features are shared with the tiles, not copied.
+    void setTileFeatures(const CanonicalTileID&, TileFeatures);
     void invalidateTile(const CanonicalTileID&);
     void invalidateRegion(const LatLngBounds&);
     // Private implementation
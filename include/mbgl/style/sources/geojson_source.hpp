@@ -1,14 +1,17 @@
 #pragma once
 
+#include <mbgl/style/conversion.hpp>
 #include <mbgl/style/expression/expression.hpp>
 #include <mbgl/style/source.hpp>
 #include <mbgl/tile/tile_id.hpp>
 #include <mbgl/util/constants.hpp>
+#include <mbgl/util/feature.hpp>
 #include <mbgl/util/geojson.hpp>
 
 #include <map>
 #include <memory>
 #include <utility>
+#include <vector>
 
 namespace mbgl {
 
@@ -40,13 +43,31 @@ struct GeoJSONOptions {
 
     static Immutable<GeoJSONOptions> defaultOptions();
 };
-class GeoJSONData {
+
+/// Changes to the features of a GeoJSON source, applied in order: removals, updates, then additions.
+struct GeoJSONDiff {
+    /// Ids of the features to remove
+    std::vector<FeatureIdentifier> remove;
+    /// Replacements for existing features, matched by id; features whose id isn't found are ignored
+    mapbox::feature::feature_collection<double> update;
+    /// New features, replacing any existing feature with the same id in place, appended otherwise
+    mapbox::feature::feature_collection<double> add;
+};
+
+class GeoJSONData : public std::enable_shared_from_this<GeoJSONData> {
 public:
     using TileFeatures = mapbox::feature::feature_collection<int16_t>;
     using Features = mapbox::feature::feature_collection<double>;
     static std::shared_ptr<GeoJSONData> create(const GeoJSON&,
                                                std::shared_ptr<Scheduler> sequencedScheduler,
                                                const Immutable<GeoJSONOptions>& = GeoJSONOptions::defaultOptions());
+    /// Parses GeoJSON text into data without building a document of it. The features of a
+    /// FeatureCollection are indexed in the background while the rest of the text is read.
+    /// Returns null and sets the error if the text isn't valid GeoJSON.
+    static std::shared_ptr<GeoJSONData> parse(const std::string&,
+                                              std::shared_ptr<Scheduler> sequencedScheduler,
+                                              const Immutable<GeoJSONOptions>&,
+                                              conversion::Error&);
 
     virtual ~GeoJSONData() = default;
     virtual void getTile(const CanonicalTileID&, const std::function<void(TileFeatures)>&, bool runSynchronously) = 0;
@@ -55,6 +76,24 @@ public:
     virtual Features getChildren(std::uint32_t) = 0;
     virtual Features getLeaves(std::uint32_t, std::uint32_t limit, std::uint32_t offset) = 0;
     virtual std::uint8_t getClusterExpansionZoom(std::uint32_t) = 0;
+    /// Calls `fn` with the leaves of a cluster from `offset` on, in the order `getLeaves` returns them, until
+    /// it returns false. The leaves aren't copied and are only valid during the call, in which this data must
+    /// not be queried again.
+    virtual void forEachLeaf(std::uint32_t,
+                             std::uint32_t /* offset */,
+                             const std::function<bool(const Features::value_type&)>&) {}
+
+    /// Returns new data with the diff applied, sharing whatever is unchanged with this data, or
+    /// null if the data doesn't keep the features it was made from.
+    virtual std::shared_ptr<GeoJSONData> update(const GeoJSONDiff&,
+                                                std::shared_ptr<Scheduler> /* sequencedScheduler */,
+                                                const Immutable<GeoJSONOptions>&) {
+        return nullptr;
+    }
+
+    /// Whether the features of the given tile may differ from those in `previous`, in which case
+    /// they need to be requested again; true unless this data is known to derive from `previous`.
+    virtual bool isTileChanged(const GeoJSONData& /* previous */, const CanonicalTileID&) const { return true; }
 };
 
 // NOTE: Any derived class must invalidate `weakFactory` in the destructor
@@ -66,6 +105,8 @@ public:
     void setURL(const std::string& url);
     void setGeoJSON(const GeoJSON&);
     void setGeoJSONData(std::shared_ptr<GeoJSONData>);
+    /// Applies the diff to the current data, only re-requesting the tiles the changed features are in.
+    void updateGeoJSON(const GeoJSONDiff&);
 
     std::optional<std::string> getURL() const;
     const GeoJSONOptions& getOptions() const;
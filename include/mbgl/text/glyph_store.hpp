@@ -0,0 +1,88 @@
+#pragma once
+
+#include <mbgl/text/glyph.hpp>
+#include <mbgl/text/glyph_range.hpp>
+#include <mbgl/util/font_stack.hpp>
+#include <mbgl/util/immutable.hpp>
+
+#include <cstddef>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace mbgl {
+
+/**
+ * @brief Parsed glyph ranges shared by the glyph managers of every map in the process
+ *
+ * Maps loading the same range of a font stack from the same glyph URL take the glyphs
+ * parsed by whichever map fetched it first, rather than requesting and parsing it again.
+ * The glyphs are immutable and reference counted, so maps holding a range keep it alive
+ * after the store evicts it.
+ *
+ * Disabled until given a budget, which should be done before any map is created.
+ *
+ * Separately, the store can keep the SDF bitmaps of glyphs rasterized locally, from system
+ * fonts or from downloaded font faces, in a directory so that later runs skip rasterizing them.
+ */
+class GlyphStore {
+public:
+    using RangeGlyphs = std::vector<Immutable<Glyph>>;
+
+    static GlyphStore& get();
+
+    /// Glyph bitmap bytes the store may hold on to, the least recently used ranges are
+    /// evicted beyond it. Zero, the default, disables the store and empties it.
+    void setBudget(std::size_t bytes);
+    std::size_t getBudget() const;
+    bool isEnabled() const { return getBudget() > 0; }
+
+    /// Bytes currently held by the store
+    std::size_t getBytes() const;
+
+    /// The glyphs of a range, or null if the store doesn't have it
+    std::shared_ptr<const RangeGlyphs> find(const std::string& url, const FontStack&, const GlyphRange&);
+
+    /// Add the glyphs parsed from a range, ignored while the store is disabled
+    void insert(const std::string& url, const FontStack&, const GlyphRange&, std::shared_ptr<const RangeGlyphs>);
+
+    void clear();
+
+    /// Directory for the on-disk cache of rasterized SDF glyphs, created if missing. Empty, the
+    /// default, disables it. The directory should be specific to the local font configuration.
+    void setSDFCachePath(const std::string& path);
+    bool isSDFCacheEnabled() const;
+
+    /// A cached SDF glyph of the face with the given hash, if any
+    std::optional<Glyph> readSDF(std::size_t faceHash, GlyphID) const;
+    void writeSDF(std::size_t faceHash, const Glyph&) const;
+
+private:
+    GlyphStore() = default;
+
+    void evict();
+
+    using Key = std::tuple<std::string, FontStack, GlyphRange>;
+    struct Item {
+        Key key;
+        std::shared_ptr<const RangeGlyphs> glyphs;
+        std::size_t bytes;
+    };
+
+    std::string sdfPath(std::size_t faceHash, GlyphID) const;
+
+    mutable std::mutex mutex;
+    std::string sdfCachePath;
+    std::size_t budget = 0;
+    std::size_t bytes = 0;
+    // Most recently used first
+    std::list<Item> items;
+    std::map<Key, std::list<Item>::iterator> index;
+};
+
+} // namespace mbgl
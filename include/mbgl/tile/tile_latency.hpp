@@ -0,0 +1,51 @@
+#pragma once
+
+#include <mbgl/util/chrono.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace mbgl {
+
+/// A distribution of latencies, in buckets of powers of two milliseconds
+class LatencyHistogram {
+public:
+    static constexpr std::size_t bucketCount = 16;
+
+    /// Bucket 0 counts the latencies under 1 ms, bucket `i` those from 2^(i-1) ms to under 2^i ms, and the last
+    /// bucket those of 2^14 ms and more
+    std::array<uint32_t, bucketCount> buckets{};
+    uint32_t count = 0;
+    Duration total = Duration::zero();
+    Duration max = Duration::zero();
+
+    void add(Duration);
+    /// The latency that the given fraction of them are under, at the resolution of the buckets
+    Duration percentile(double fraction) const;
+    Duration mean() const { return count ? total / count : Duration::zero(); }
+};
+
+/**
+ * @brief Where the time went from the tiles of a source being created to their first frame, see
+ * `RendererObserver::onTileLatencies`.
+ *
+ * Tiles are counted once they're first rendered, tiles dropped before that and later reloads of the same tile
+ * aren't. Stages a tile skipped, such as the parse of a tile without data, aren't counted for it.
+ */
+struct TileLatencies {
+    /// From the tile being created to the last of its data arriving from the cache or the network before it was
+    /// parsed
+    LatencyHistogram load;
+    /// From the data being handed to the workers to the tile being laid out
+    LatencyHistogram parse;
+    /// The part of the parse not spent working on the tile: queued behind the work of other tiles, or waiting
+    /// for glyphs and images
+    LatencyHistogram parseWait;
+    /// From the tile being laid out to the first frame rendering it, its upload included
+    LatencyHistogram render;
+    /// From the tile being created to the first frame rendering it
+    LatencyHistogram total;
+};
+
+} // namespace mbgl
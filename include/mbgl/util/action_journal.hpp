@@ -15,6 +15,8 @@ class ActionJournalOptions;
 /**
  * @brief Logs map events in a persistent rolling file format.
  * Each event is stored as a serialized json object with the event data.
+ * Events are encoded in a compact binary form into a buffer of the thread raising
+ * them, and written to the log in the background.
  * Example
  *  {
  *      "name" : "onTileAction",
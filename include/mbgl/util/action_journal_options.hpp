@@ -104,6 +104,44 @@ public:
      */
     uint32_t renderingStatsReportInterval() const { return renderingStatsReportInterval_; }
 
+    /**
+     * @brief Set the size of the buffer the events are encoded into, for each
+     * thread raising them, before they're written to the log in the background.
+     * Events are dropped while the buffer is full.
+     *
+     * @param size buffer size in bytes.
+     * @return ActionJournalOptions for chaining options together.
+     */
+    ActionJournalOptions& withBufferSize(const uint32_t size) {
+        bufferSize_ = size;
+        return *this;
+    }
+
+    /**
+     * @brief Gets the previously set (or default) buffer size.
+     * @return Returns the buffer size in bytes
+     */
+    uint32_t bufferSize() const { return bufferSize_; }
+
+    /**
+     * @brief Log an `onFrameTiming` event for every rendered frame, with its
+     * timing and camera, defaults to false. A log of those events can be
+     * replayed by the camera path benchmarks.
+     *
+     * @param value true to enable, false to disable.
+     * @return ActionJournalOptions for chaining options together.
+     */
+    ActionJournalOptions& withFrameTimingEvents(bool value = true) {
+        frameTimingEvents_ = value;
+        return *this;
+    }
+
+    /**
+     * @brief Gets the previously set (or default) value.
+     * @return Returns whether frame timing events are logged
+     */
+    bool frameTimingEvents() const { return frameTimingEvents_; }
+
 protected:
     bool enable_ = false;
     // path of the log
@@ -114,6 +152,10 @@ protected:
     uint32_t logFileCount_ = 5;
     // the wait time (seconds) between rendering reports
     uint32_t renderingStatsReportInterval_ = 60;
+    // size of the event buffer of each thread
+    uint32_t bufferSize_ = 64 * 1024;
+    // log the timing of every frame
+    bool frameTimingEvents_ = false;
 };
 
 } // namespace util
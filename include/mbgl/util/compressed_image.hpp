@@ -0,0 +1,36 @@
+#pragma once
+
+#include <mbgl/util/size.hpp>
+
+#include <cstdint>
+#include <string>
+
+namespace mbgl {
+
+/// GPU block-compressed pixel formats, all with 4x4 blocks
+enum class CompressedImageFormat : uint8_t {
+    ETC2RGB8,  ///< ETC2 RGB, 8 bytes per block
+    ETC2RGBA8, ///< ETC2 RGBA with EAC alpha, 16 bytes per block
+    ASTC4x4,   ///< ASTC LDR 4x4, 16 bytes per block
+    BC7,       ///< BC7 (BPTC) RGBA, 16 bytes per block
+};
+
+/// An image left in a GPU block-compressed format, uploaded as is by the backends that support it
+class CompressedImage {
+public:
+    CompressedImageFormat format;
+    Size size;
+    /// The blocks of the first mipmap level
+    std::string data;
+
+    std::size_t bytes() const { return data.size(); }
+};
+
+/// Whether `data` starts with the KTX 1.1 file identifier
+bool isKTX(const std::string& data);
+
+/// The first mipmap level of a KTX 1.1 texture in one of the `CompressedImageFormat`s.
+/// Throws `std::runtime_error` for malformed files and any other format.
+CompressedImage decodeKTX(const std::string& data);
+
+} // namespace mbgl
@@ -2,6 +2,7 @@
 
 #include <cstdint>
 #include <string>
+#include <string_view>
 
 namespace mbgl {
 namespace util {
@@ -13,9 +14,12 @@ enum CompressionFormat {
     DETECT = 15 + 32
 };
 
-bool is_compressed(const std::string&);
+/// Whether the data starts like a gzip, zlib or zstd stream
+bool is_compressed(std::string_view);
 std::string compress(const std::string& raw, int windowBits = CompressionFormat::ZLIB);
-std::string decompress(const std::string& raw, int windowBits = CompressionFormat::DETECT);
+/// Throws `std::runtime_error` for corrupt data. With `DETECT`, zstd frames are decompressed too when
+/// the build has zstd support.
+std::string decompress(std::string_view raw, int windowBits = CompressionFormat::DETECT);
 
 std::uint32_t crc32(const void* raw, size_t size) noexcept;
 
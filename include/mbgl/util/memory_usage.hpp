@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstddef>
+
+namespace mbgl {
+
+/// Approximate number of bytes held by an object, split by where the memory lives.
+struct MemoryUsage {
+    /// Heap memory owned by the CPU-side representation
+    std::size_t cpu = 0;
+    /// Memory uploaded to device buffers and textures
+    std::size_t gpu = 0;
+
+    std::size_t total() const { return cpu + gpu; }
+
+    MemoryUsage& operator+=(const MemoryUsage& other) {
+        cpu += other.cpu;
+        gpu += other.gpu;
+        return *this;
+    }
+
+    friend MemoryUsage operator+(MemoryUsage lhs, const MemoryUsage& rhs) { return lhs += rhs; }
+    bool operator==(const MemoryUsage&) const = default;
+};
+
+} // namespace mbgl
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cstddef>
 #include <string>
+#include <vector>
 
 namespace mbgl {
 namespace platform {
@@ -26,5 +28,9 @@ void makeThreadLowPriority();
 /// must validate provided value.
 void setCurrentThreadPriority(double priority);
 
+/// Restricts the current thread to the given CPUs, or lets it run on any if
+/// empty. A no-op where the platform doesn't support it.
+void setCurrentThreadAffinity(const std::vector<std::size_t> &cpus);
+
 } // namespace platform
 } // namespace mbgl
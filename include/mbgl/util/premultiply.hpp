@@ -6,7 +6,11 @@ namespace mbgl {
 namespace util {
 
 PremultipliedImage premultiply(UnassociatedImage&&);
+// Premultiplies `pixels` RGBA pixels in place, for decoders to run on each row as it's decoded
+void premultiply(uint8_t* rgba, std::size_t pixels);
 UnassociatedImage unpremultiply(PremultipliedImage&&);
+// Unpremultiplies `pixels` RGBA pixels in place
+void unpremultiply(uint8_t* rgba, std::size_t pixels);
 
 } // namespace util
 } // namespace mbgl
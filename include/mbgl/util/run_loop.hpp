@@ -2,11 +2,13 @@
 
 #include <mbgl/actor/scheduler.hpp>
 #include <mbgl/actor/mailbox.hpp>
+#include <mbgl/util/chrono.hpp>
 #include <mbgl/util/noncopyable.hpp>
 #include <mbgl/util/util.hpp>
 #include <mbgl/util/work_task.hpp>
 #include <mbgl/util/work_request.hpp>
 
+#include <cstdint>
 #include <functional>
 #include <mutex>
 #include <queue>
@@ -37,6 +39,15 @@ public:
         ReadWrite = Read | Write,
     };
 
+    /// How the queued tasks were run, to tell how well the wakeups are batched
+    struct Stats {
+        /// The times the loop woke up and found tasks to run
+        std::uint64_t wakeups = 0;
+        std::uint64_t tasks = 0;
+
+        double tasksPerWakeup() const { return wakeups ? double(tasks) / double(wakeups) : 0.0; }
+    };
+
     RunLoop(Type type = Type::Default);
     ~RunLoop() override;
 
@@ -49,6 +60,18 @@ public:
 
     void updateTime();
 
+    /// Limits the time spent running queued tasks per wakeup, the loop wakes up again for those left so that
+    /// timers and watches get their turn. Zero, the default, runs until the queues are empty.
+    void setTimeSlice(Duration slice) {
+        std::scoped_lock lock(mutex);
+        timeSlice = slice;
+    }
+
+    Stats getStats() {
+        std::scoped_lock lock(mutex);
+        return stats;
+    }
+
     /// Platform integration callback for platforms that do not have full
     /// run loop integration or don't want to block at the Mapbox GL Native
     /// loop. It will be called from any thread and is up to the platform
@@ -100,7 +123,8 @@ private:
     // Wakes up the RunLoop so that it starts processing items in the queue.
     void wake();
 
-    // Adds a WorkTask to the queue, and wakes it up.
+    // Adds a WorkTask to the queue, and wakes it up unless a wakeup is already on its way: the tasks pushed
+    // until it arrives are run together.
     void push(Priority priority, std::shared_ptr<WorkTask> task) {
         std::scoped_lock lock(mutex);
         if (priority == Priority::High) {
@@ -108,7 +132,10 @@ private:
         } else {
             defaultQueue.emplace(std::move(task));
         }
-        wake();
+        if (!wakePending) {
+            wakePending = true;
+            wake();
+        }
 
         if (platformCallback) {
             platformCallback();
@@ -118,6 +145,8 @@ private:
     void process() {
         std::shared_ptr<WorkTask> task;
         std::unique_lock<std::mutex> lock(mutex);
+        const auto deadline = timeSlice > Duration::zero() ? Clock::now() + timeSlice : TimePoint::max();
+        bool first = true;
         while (true) {
             if (!highPriorityQueue.empty()) {
                 task = std::move(highPriorityQueue.front());
@@ -126,12 +155,25 @@ private:
                 task = std::move(defaultQueue.front());
                 defaultQueue.pop();
             } else {
+                // Only cleared once the queues are drained, the tasks pushed meanwhile don't wake the loop again
+                wakePending = false;
                 break;
             }
+            if (first) {
+                stats.wakeups++;
+                first = false;
+            }
+            stats.tasks++;
             lock.unlock();
             (*task)();
             task.reset();
             lock.lock();
+            if (deadline != TimePoint::max() && Clock::now() >= deadline &&
+                !(highPriorityQueue.empty() && defaultQueue.empty())) {
+                // The wakeup stays pending, sent again for the rest
+                wake();
+                break;
+            }
         }
     }
 
@@ -140,6 +182,9 @@ private:
     Queue defaultQueue;
     Queue highPriorityQueue;
     std::mutex mutex;
+    bool wakePending = false;
+    Duration timeSlice = Duration::zero();
+    Stats stats;
 
     std::unique_ptr<Impl> impl;
     ::mapbox::base::WeakPtrFactory<Scheduler> weakFactory{this};
@@ -1,18 +1,24 @@
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <cstdint>
 #include <cstddef>
+#include <memory>
 #include <string>
 #include <string_view>
-#include <unordered_map>
 #include <vector>
 #include <mutex>
-#include <shared_mutex>
 
 namespace mbgl {
 
 using StringIdentity = std::size_t;
 
+/**
+    Assigns a dense identity to each distinct string. Lookups don't lock or write to any shared
+    state: strings are never removed or moved once added, and the hash table is replaced by a
+    larger copy rather than changed in place when it fills up. Adding a string takes a mutex.
+ */
 class StringIndexer {
 protected:
     StringIndexer();
@@ -21,7 +27,7 @@ public:
     StringIndexer(StringIndexer const&) = delete;
     StringIndexer(StringIndexer&&) = delete;
     void operator=(StringIndexer const&) = delete;
-    ~StringIndexer() = default;
+    ~StringIndexer();
 
     StringIdentity get(std::string_view);
 
@@ -32,11 +38,46 @@ public:
 protected:
     friend StringIndexer& stringIndexer();
 
-    std::unordered_map<std::string_view, StringIdentity> stringToIdentity;
-    std::vector<StringIdentity> identityToString;
-    std::vector<char> buffer;
+    struct Entry {
+        std::string_view string;
+        std::size_t hash = 0;
+        StringIdentity id = 0;
+    };
 
-    std::shared_mutex sharedMutex;
+    // Open-addressed, linearly probed table of entries
+    struct Table {
+        explicit Table(std::size_t capacity);
+
+        const std::size_t mask;
+        const std::unique_ptr<std::atomic<const Entry*>[]> slots;
+    };
+
+    const Entry* find(std::string_view, std::size_t hash) const;
+    const Entry* insert(std::string_view, std::size_t hash);
+    void insert(Table&, const Entry&);
+
+    // Entry `id` is in segment `k` when `id / segmentBase + 1` has `k + 1` bits, segment `k`
+    // holding `segmentBase << k` entries
+    static constexpr std::size_t segmentBase = 64;
+    static constexpr std::size_t segmentCount = 48;
+    Entry& entry(StringIdentity) const;
+
+    std::array<std::atomic<Entry*>, segmentCount> segments{};
+    std::atomic<std::size_t> count{0};
+
+    std::atomic<const Table*> table;
+
+    // Only used while holding `writerMutex`. Replaced tables are kept, as readers may still be
+    // probing them.
+    std::vector<std::unique_ptr<Table>> tables;
+    std::vector<std::unique_ptr<char[]>> buffers;
+    std::size_t bufferUsed = 0;
+    std::size_t bufferCapacity = 0;
+    std::mutex writerMutex;
+
+    // Distinguishes the entries of this indexer in the per-thread lookup caches, and is never
+    // reused by another one
+    const uint64_t instance;
 };
 
 /// StringIndexer singleton
@@ -22,7 +22,7 @@ public:
 
     vulkan::Context& getContext() { return context; }
     const vulkan::Context& getContext() const { return context; }
-    const vk::UniqueCommandBuffer& getCommandBuffer() const { return commandBuffer; }
+    const vk::UniqueCommandBuffer& getCommandBuffer() const { return *commandBuffer; }
 
     std::unique_ptr<gfx::UploadPass> createUploadPass(const char* name, gfx::Renderable&) override;
     std::unique_ptr<gfx::RenderPass> createRenderPass(const char* name, const gfx::RenderPassDescriptor&) override;
@@ -39,7 +39,9 @@ private:
     friend class UploadPass;
 
     vulkan::Context& context;
-    const vk::UniqueCommandBuffer& commandBuffer;
+    // Switched by a render pass recording into secondary command buffers
+    const vk::UniqueCommandBuffer* commandBuffer;
+    bool debugGroups{true};
 };
 
 } // namespace vulkan
@@ -15,6 +15,7 @@
 #include <mbgl/vulkan/descriptor_set.hpp>
 #include <mbgl/util/util.hpp>
 
+#include <deque>
 #include <memory>
 #include <optional>
 #include <unordered_map>
@@ -75,7 +76,7 @@ public:
 
     /// Called at the end of a frame.
     void performCleanup() override;
-    void reduceMemoryUsage() override {}
+    void reduceMemoryUsage() override { clearOffscreenTexturePool(); }
 
     gfx::UniqueDrawableBuilder createDrawableBuilder(std::string name) override;
     gfx::UniformBufferPtr createUniformBuffer(const void* data,
@@ -134,7 +135,7 @@ public:
     void bindGlobalUniformBuffers(gfx::RenderPass&) const noexcept override;
 
     /// Unbind the global uniform buffers
-    void unbindGlobalUniformBuffers(gfx::RenderPass&) const noexcept override {}
+    void unbindGlobalUniformBuffers(gfx::RenderPass&) const noexcept override;
 
     bool renderTileClippingMasks(gfx::RenderPass& renderPass,
                                  RenderStaticData& staticData,
@@ -157,13 +158,27 @@ public:
 
     void requestSurfaceUpdate(bool useDelay = true);
 
+    /// A secondary command buffer for the current frame. Each one has a command pool of its own, so
+    /// different buffers can be recorded on different threads. They are reset when the frame is reused.
+    const vk::UniqueCommandBuffer& acquireSecondaryCommandBuffer();
+
 private:
     struct FrameResources {
         vk::UniqueCommandBuffer commandBuffer;
         vk::UniqueFence flightFrameFence;
+        // Value the frame timeline reaches once the GPU is done with the frame, if one is used
+        uint64_t timelineValue{0};
 
         DeletionQueue deletionQueue;
 
+        struct SecondaryCommandBuffer {
+            vk::UniqueCommandPool pool;
+            vk::UniqueCommandBuffer buffer;
+        };
+        // A deque keeps the buffers handed out earlier in the frame in place
+        std::deque<SecondaryCommandBuffer> secondaryCommandBuffers;
+        std::size_t usedSecondaryCommandBuffers{0};
+
         FrameResources(vk::UniqueCommandBuffer& cb, vk::UniqueFence&& flight)
             : commandBuffer(std::move(cb)),
               flightFrameFence(std::move(flight)) {}
@@ -198,6 +213,9 @@ private:
 
     uint8_t frameResourceIndex = 0;
     std::vector<FrameResources> frameResources;
+    // Signaled with increasing values as frames complete, replacing the per-frame fences when supported
+    vk::UniqueSemaphore frameTimeline;
+    uint64_t frameTimelineValue{0};
     bool surfaceUpdateRequested{false};
     int32_t surfaceUpdateLatency{0};
     int32_t currentFrameCount{0};
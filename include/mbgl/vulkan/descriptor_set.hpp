@@ -66,12 +66,26 @@ public:
 protected:
     void createDescriptorPool(DescriptorPoolGrowable& growablePool);
 
+    /// Write the descriptors into the current frame's set, unless the set already holds the same descriptors.
+    /// Either way, the set is no longer dirty.
+    void write(std::span<const vk::WriteDescriptorSet> writes);
+
 protected:
     Context& context;
     DescriptorSetType type;
 
     std::vector<bool> dirty;
     std::vector<vk::DescriptorSet> descriptorSets;
+    struct WrittenDescriptor {
+        vk::DescriptorType type;
+        vk::DescriptorBufferInfo bufferInfo;
+        vk::DescriptorImageInfo imageInfo;
+
+        bool operator==(const WrittenDescriptor&) const = default;
+    };
+
+    // What was last written to each set, by binding, since most sets are marked dirty without their content changing
+    std::vector<std::vector<WrittenDescriptor>> writtenContent;
     int32_t descriptorPoolIndex{-1};
 };
 
@@ -18,6 +18,7 @@ class StencilMode;
 namespace vulkan {
 
 class CommandEncoder;
+class Context;
 class UploadPass;
 
 class Drawable : public gfx::Drawable {
@@ -28,6 +29,15 @@ public:
     void upload(gfx::UploadPass&);
     void draw(PaintParameters&) const override;
 
+    /// The first half of `draw`: updates descriptor sets and looks up pipelines, on the render thread.
+    /// Returns false if there is nothing to draw.
+    bool prepare(PaintParameters&) const;
+    /// The second half of `draw`: records the prepared draw calls, which can be done on any thread
+    void record(CommandEncoder&) const;
+    /// Draw `other` as another instance of this drawable's prepared draw calls, if they are compatible.
+    /// Only valid after `prepare`, which resets the instance count.
+    bool batchInstance(const gfx::Drawable& other) const;
+
     void setIndexData(gfx::IndexVectorBasePtr, std::vector<UniqueDrawSegment> segments) override;
     void setVertices(std::vector<uint8_t>&&, std::size_t, gfx::AttributeDataType) override;
 
@@ -54,8 +64,9 @@ public:
 protected:
     void buildVulkanInputBindings();
 
-    bool bindAttributes(CommandEncoder&) const;
-    bool bindDescriptors(CommandEncoder&) const;
+    void bindAttributes(CommandEncoder&) const;
+    void updateDescriptors(Context&) const;
+    void bindDescriptors(CommandEncoder&) const;
 
     void uploadTextures(UploadPass&) const;
 
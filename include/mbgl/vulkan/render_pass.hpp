@@ -1,9 +1,12 @@
 #pragma once
 
 #include <mbgl/gfx/render_pass.hpp>
+#include <mbgl/vulkan/renderer_backend.hpp>
 
+#include <functional>
 #include <memory>
 #include <optional>
+#include <vector>
 
 namespace mbgl {
 namespace vulkan {
@@ -11,6 +14,7 @@ namespace vulkan {
 class BufferResource;
 class CommandEncoder;
 class Context;
+class UniformBufferArray;
 
 class RenderPass final : public gfx::RenderPass {
 public:
@@ -23,15 +27,42 @@ public:
 
     void clearStencil(uint32_t value = 0) const;
 
+    /// Whether this pass records into secondary command buffers, see `RendererBackend::setParallelRecording`
+    bool isRecordingInParallel() const { return parallel; }
+
+    /// Record commands into a secondary command buffer of their own when the pass ends, possibly on another
+    /// thread. They execute after everything recorded before this call and before everything recorded after.
+    /// Only valid when recording in parallel; the function must not touch state shared with other recordings.
+    void deferRecording(std::function<void(CommandEncoder&)>&&);
+
+    /// The global uniform buffers currently bound, which secondary command buffers don't inherit
+    void setGlobalUniformBuffers(UniformBufferArray* buffers) { globalUniformBuffers = buffers; }
+
     void addDebugSignpost(const char* name) override;
 
 private:
     void pushDebugGroup(const char* name) override;
     void popDebugGroup() override;
 
+    void beginSecondaryCommandBuffer();
+    void recordDeferred();
+
 private:
     gfx::RenderPassDescriptor descriptor;
     vulkan::CommandEncoder& commandEncoder;
+
+    struct Recording {
+        const vk::UniqueCommandBuffer& commandBuffer;
+        // Empty for the buffers recorded directly through the encoder
+        std::function<void(CommandEncoder&)> record;
+        UniformBufferArray* globalUniformBuffers;
+    };
+
+    bool parallel{false};
+    const vk::UniqueCommandBuffer* primaryCommandBuffer{nullptr};
+    vk::CommandBufferInheritanceInfo inheritanceInfo;
+    std::vector<Recording> recordings;
+    UniformBufferArray* globalUniformBuffers{nullptr};
 };
 
 } // namespace vulkan
@@ -40,11 +40,33 @@ public:
     void initShaders(gfx::ShaderRegistry&, const ProgramParameters& programParameters) override;
     void init();
 
+    /// File the pipeline cache is loaded from during `init` and saved to when the backend is
+    /// destroyed, none by default. Data saved by a different device or driver is ignored.
+    void setPipelineCachePath(std::string path) { pipelineCachePath = std::move(path); }
+    /// Write the pipeline cache to its file now, e.g. before the app may get terminated
+    void savePipelineCache() const;
+
+    /// Record each layer group's drawables into a secondary command buffer of its own, in parallel on the
+    /// background scheduler, instead of recording everything into the frame's command buffer. Off by default.
+    void setParallelRecording(bool value) { parallelRecording = value; }
+    bool getParallelRecording() const { return parallelRecording; }
+
+    /// Number of frames the CPU may record ahead of the GPU when rendering to a surface, 2 by default.
+    /// Per-frame resources are sized from it during `init`, so changes take effect when the backend is
+    /// next initialized. Headless rendering always uses a single frame.
+    void setFramesInFlight(uint32_t value) { framesInFlight = value > 0 ? value : 1; }
+    uint32_t getFramesInFlight() const { return framesInFlight; }
+
+    /// Whether the device supports `VK_KHR_timeline_semaphore`, which is then used to wait for frames
+    /// instead of a fence per frame
+    bool isTimelineSemaphoreSupported() const { return timelineSemaphoreSupported; }
+
     const vk::DispatchLoaderDynamic& getDispatcher() const { return dispatcher; }
     const vk::UniqueInstance& getInstance() const { return instance; }
     const vk::PhysicalDevice& getPhysicalDevice() const { return physicalDevice; }
     const vk::UniqueDevice& getDevice() const { return device; }
     const vk::UniqueCommandPool& getCommandPool() const { return commandPool; }
+    const vk::UniquePipelineCache& getPipelineCache() const { return pipelineCache; }
     const vk::Queue& getGraphicsQueue() const { return graphicsQueue; }
     const vk::Queue& getPresentQueue() const { return presentQueue; }
     uint32_t getMaxFrames() const { return maxFrames; }
@@ -92,6 +114,7 @@ protected:
     virtual void initAllocator();
     virtual void initSwapchain();
     virtual void initCommandPool();
+    virtual void initPipelineCache();
     virtual void initFrameCapture();
 
     void destroyResources();
@@ -117,6 +140,13 @@ protected:
 
     vk::UniqueCommandPool commandPool;
     uint32_t maxFrames = 1;
+    uint32_t framesInFlight = 2;
+    bool timelineSemaphoreSupported = false;
+
+    std::string pipelineCachePath;
+    vk::UniquePipelineCache pipelineCache;
+
+    bool parallelRecording{false};
 
     VmaAllocator allocator;
 
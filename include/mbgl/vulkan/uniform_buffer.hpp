@@ -69,6 +69,11 @@ public:
     void bind(gfx::RenderPass& renderPass) override;
 
     void bindDescriptorSets(CommandEncoder& encoder);
+
+    /// The first half of `bindDescriptorSets`, which updates the descriptor set on the render thread
+    void prepareDescriptorSets(Context& context);
+    /// The second half of `bindDescriptorSets`, which only records commands and can run on any thread
+    void bindPreparedDescriptorSets(CommandEncoder& encoder);
     void freeDescriptorSets() { descriptorSet.reset(); }
 
 private:
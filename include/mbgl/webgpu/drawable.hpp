@@ -4,6 +4,7 @@
 #include <mbgl/gfx/draw_mode.hpp>
 #include <webgpu/webgpu.h>
 #include <memory>
+#include <optional>
 #include <vector>
 
 // Forward declare WebGPU types
@@ -30,6 +31,19 @@ public:
     void upload(gfx::UploadPass&);
     void draw(PaintParameters&) const override;
 
+    /// Prepares the bind groups, the pipeline and the buffers of a draw, returning false if there is nothing to draw.
+    /// A prepared draw is encoded into the render pass, or into a render bundle that the layer group replays.
+    bool prepare(PaintParameters&) const;
+    void encode(WGPURenderPassEncoder) const;
+    void encode(WGPURenderBundleEncoder) const;
+
+    /// A hash of the commands of the prepared draw, for which a render bundle recording them stays valid
+    std::size_t getCommandHash() const;
+    /// The stencil reference of the prepared draw, which isn't part of a render bundle
+    std::optional<uint32_t> getStencilReference() const;
+    /// The number of draw calls of the prepared draw
+    std::size_t getDrawCallCount() const;
+
     void setIndexData(gfx::IndexVectorBasePtr, std::vector<UniqueDrawSegment> segments) override;
     void setVertices(std::vector<uint8_t>&&, std::size_t, gfx::AttributeDataType) override;
 
@@ -9,6 +9,7 @@ typedef struct WGPURenderPassEncoderImpl* WGPURenderPassEncoder;
 namespace mbgl {
 namespace gfx {
 class CommandEncoder;
+class ScissorRect;
 class UniformBufferArray;
 } // namespace gfx
 
@@ -29,6 +30,9 @@ public:
     WGPURenderPassEncoder getEncoder() const;
     const gfx::RenderPassDescriptor& getDescriptor() const { return descriptor; }
 
+    /// Set the scissor rectangle, clamped to the size of the pass's renderable
+    void setScissorRect(const gfx::ScissorRect&);
+
     // Set/get global uniform buffers for drawables to access
     void setGlobalUniformBuffers(const gfx::UniformBufferArray* buffers);
     const gfx::UniformBufferArray* getGlobalUniformBuffers() const;
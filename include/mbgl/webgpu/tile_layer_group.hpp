@@ -3,19 +3,27 @@
 #include <mbgl/renderer/layer_group.hpp>
 #include <mbgl/webgpu/uniform_buffer.hpp>
 
+#include <optional>
+#include <vector>
+
+// Forward declare WebGPU types
+typedef struct WGPURenderBundleImpl* WGPURenderBundle;
+
 namespace mbgl {
 
 class PaintParameters;
 
 namespace webgpu {
 
+class Drawable;
+
 /**
  * A layer group for tile-based drawables
  */
 class TileLayerGroup : public mbgl::TileLayerGroup {
 public:
     TileLayerGroup(int32_t layerIndex, std::size_t initialCapacity, std::string name);
-    ~TileLayerGroup() override {}
+    ~TileLayerGroup() override;
 
     void upload(gfx::UploadPass&) override;
     void render(RenderOrchestrator&, PaintParameters&) override;
@@ -24,7 +32,27 @@ public:
     gfx::UniformBufferArray& mutableUniformBuffers() override { return uniformBuffers; }
 
 protected:
+    /// The drawables of one render pass recorded into render bundles, which are replayed while the commands of the
+    /// drawables stay the same. Render bundles can't set the stencil reference, so the drawables are recorded in runs
+    /// sharing one.
+    struct RenderBundles {
+        struct Run {
+            std::optional<uint32_t> stencilReference;
+            WGPURenderBundle bundle = nullptr;
+        };
+
+        mbgl::RenderPass pass;
+        std::size_t commandHash = 0;
+        std::vector<Run> runs;
+        std::size_t drawCallCount = 0;
+    };
+
+    RenderBundles& getRenderBundles(mbgl::RenderPass);
+    void recordRenderBundles(RenderBundles&, const std::vector<const Drawable*>&, PaintParameters&);
+    static void releaseRenderBundles(RenderBundles&);
+
     webgpu::UniformBufferArray uniformBuffers;
+    std::vector<RenderBundles> renderBundles;
 };
 
 } // namespace webgpu
@@ -2,9 +2,11 @@
 #include <mbgl/util/platform.hpp>
 #include <mbgl/platform/thread.hpp>
 
+#include <sched.h>
 #include <sys/prctl.h>
 #include <sys/resource.h>
 
+#include <algorithm>
 #include <cassert>
 #include "jni.hpp"
 
@@ -48,6 +50,19 @@ void setCurrentThreadPriority(double priority) {
     setpriority(PRIO_PROCESS, 0, int(priority));
 }
 
+void setCurrentThreadAffinity(const std::vector<std::size_t>& cpus) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (std::size_t cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+        if (cpus.empty() || std::ranges::find(cpus, cpu) != cpus.end()) {
+            CPU_SET(cpu, &set);
+        }
+    }
+    if (sched_setaffinity(0, sizeof(set), &set) != 0) {
+        Log::Warning(Event::General, "Couldn't set thread affinity");
+    }
+}
+
 void attachThread() {
     using namespace android;
     assert(env == nullptr);
@@ -42,6 +42,10 @@ void setCurrentThreadPriority(double priority) {
   }
 }
 
+void setCurrentThreadAffinity(const std::vector<std::size_t>&) {
+  // There's no affinity API, the QoS class set by `setCurrentThreadPriority` steers threads to cores
+}
+
 void attachThread() {}
 
 void detachThread() {}
@@ -23,6 +23,16 @@ public:
     }
 
     virtual PremultipliedImage readStillImage() = 0;
+    /// Read the last frame into `image`, reusing its storage when it already has the right size
+    virtual void readStillImageInto(PremultipliedImage& image) { image = readStillImage(); }
+
+    /// Start reading the last frame back without waiting for it, so the next one can be rendered in
+    /// the meantime. Returns false, doing nothing, where the backend can't, in which case the frame
+    /// has to be read with `readStillImage`.
+    virtual bool beginReadStillImage() { return false; }
+    /// Wait for the oldest read begun with `beginReadStillImage` and write it into `image`, reusing
+    /// its storage when it already has the right size. Returns false when no read was pending.
+    virtual bool finishReadStillImage(PremultipliedImage&) { return false; }
     virtual RendererBackend* getRendererBackend() = 0;
     void setSize(Size);
 
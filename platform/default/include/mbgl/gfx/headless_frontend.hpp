@@ -4,11 +4,14 @@
 #include <mbgl/gfx/rendering_stats.hpp>
 #include <mbgl/map/camera.hpp>
 #include <mbgl/renderer/renderer_frontend.hpp>
+#include <mbgl/tile/tile_id.hpp>
 #include <mbgl/util/async_task.hpp>
 
 #include <atomic>
+#include <deque>
 #include <memory>
 #include <optional>
+#include <vector>
 
 namespace mbgl {
 
@@ -23,6 +26,14 @@ public:
         gfx::RenderingStats stats;
     };
 
+    struct MetatileResult {
+        /// The tiles row by row, starting from the north west
+        std::vector<PremultipliedImage> tiles;
+        gfx::RenderingStats stats;
+        /// Tiles rendered per second, reading back and slicing included
+        double tilesPerSecond = 0;
+    };
+
     HeadlessFrontend(float pixelRatio_,
                      gfx::HeadlessBackend::SwapBehaviour swapBehavior = gfx::HeadlessBackend::SwapBehaviour::NoFlush,
                      gfx::ContextMode mode = gfx::ContextMode::Unique,
@@ -56,7 +67,25 @@ public:
     LatLng latLngForPixel(const ScreenCoordinate&);
 
     PremultipliedImage readStillImage();
+    /// Read the last frame into `image`, reusing its storage across frames of the same size
+    void readStillImage(PremultipliedImage& image);
     RenderResult render(Map&);
+
+    /// Render a still frame and start reading it back without waiting for the pixels, where the
+    /// backend supports it, so the next frame can be rendered while this one is read back.
+    /// Each call must be matched by a `finishRender`, which collects the frames in order.
+    void beginRender(Map&);
+    /// Write the oldest frame begun with `beginRender` into `image`, reusing its storage when it
+    /// already has the right size, and return the statistics of that frame
+    gfx::RenderingStats finishRender(PremultipliedImage& image);
+    std::size_t pendingRenderCount() const { return pendingRenders.size(); }
+
+    /// Render the `count` x `count` tiles of `tileSize` logical pixels starting at `tile` and going
+    /// south east in a single frame, then slice it into them. Saves the setup of a frame per tile,
+    /// and labels line up across the tiles of a metatile. The frontend and the map are left at the
+    /// size of the metatile, so that rendering the next one doesn't resize the framebuffer.
+    /// Throws `std::invalid_argument` when the tiles don't all lie within the world.
+    MetatileResult renderMetatile(Map&, const CanonicalTileID& tile, uint32_t count, uint32_t tileSize = 256);
     void renderOnce(Map&);
     void renderFrame();
 
@@ -73,6 +102,13 @@ private:
 
     std::unique_ptr<Renderer> renderer;
     std::shared_ptr<UpdateParameters> updateParameters;
+
+    struct PendingRender {
+        gfx::RenderingStats stats;
+        // Read back synchronously when the backend couldn't begin an asynchronous read
+        std::optional<PremultipliedImage> image;
+    };
+    std::deque<PendingRender> pendingRenders;
 };
 
 } // namespace mbgl
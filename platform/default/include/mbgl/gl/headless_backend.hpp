@@ -17,6 +17,9 @@ public:
     void updateAssumedState() override;
     gfx::Renderable& getDefaultRenderable() override;
     PremultipliedImage readStillImage() override;
+    void readStillImageInto(PremultipliedImage&) override;
+    bool beginReadStillImage() override;
+    bool finishReadStillImage(PremultipliedImage&) override;
     RendererBackend* getRendererBackend() override;
 
     void swap();
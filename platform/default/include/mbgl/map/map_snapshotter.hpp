@@ -5,8 +5,10 @@
 #include <mbgl/util/geo.hpp>
 #include <mbgl/annotation/annotation.hpp>
 #include <mbgl/style/image.hpp>
+#include <mbgl/storage/resource_options.hpp>
 
 #include <exception>
+#include <list>
 #include <memory>
 #include <string>
 #include <vector>
@@ -18,7 +20,6 @@ namespace mbgl {
 struct CameraOptions;
 class ClientOptions;
 class LatLngBounds;
-class ResourceOptions;
 
 namespace style {
 class Style;
@@ -78,9 +79,53 @@ public:
     void snapshot(Callback);
     void cancel();
 
+    /// Cancels a pending snapshot and removes the annotations, annotation images, region and padding
+    /// set since the snapshotter was created or last reset. The loaded style and the renderer, with
+    /// its GPU context, shader programs, glyphs and sprites, are kept for the next snapshot.
+    void reset();
+
 private:
     class Impl;
     std::unique_ptr<Impl> impl;
 };
 
+/// Keeps idle snapshotters of the same style URL and size warm between snapshots, so that share
+/// images rendered in a row don't each start a renderer thread, compile shaders and fetch the style,
+/// glyphs and sprites again. Must be used on the thread that runs the snapshotters.
+class MapSnapshotterPool {
+public:
+    MapSnapshotterPool(std::size_t capacity,
+                       float pixelRatio,
+                       const ResourceOptions&,
+                       const ClientOptions& = ClientOptions());
+    ~MapSnapshotterPool();
+
+    /// An idle snapshotter of the style and size if the pool has one, otherwise a new one loading the style
+    std::unique_ptr<MapSnapshotter> acquire(const std::string& styleURL, Size size);
+
+    /// Resets a snapshotter and keeps it for a later `acquire`, destroying the least recently released
+    /// ones beyond the capacity. Snapshotters without a style URL aren't kept. Neither should be those
+    /// whose style was changed through `getStyle()`, as the next user would get the changed style.
+    void release(std::unique_ptr<MapSnapshotter>);
+
+    /// Number of idle snapshotters
+    std::size_t size() const { return idle.size(); }
+
+    void clear();
+
+private:
+    struct Entry {
+        std::string styleURL;
+        Size size;
+        std::unique_ptr<MapSnapshotter> snapshotter;
+    };
+
+    const std::size_t capacity;
+    const float pixelRatio;
+    const ResourceOptions resourceOptions;
+    const ClientOptions clientOptions;
+    // Most recently released first
+    std::list<Entry> idle;
+};
+
 } // namespace mbgl
@@ -2,6 +2,10 @@
 
 #include <mbgl/util/string.hpp>
 
+#include <memory>
+#include <optional>
+#include <utility>
+
 namespace mbgl {
 
 template <typename>
@@ -12,4 +16,22 @@ void requestLocalFile(const std::string& path,
                       const ActorRef<FileSourceRequest>& req,
                       const std::optional<std::pair<uint64_t, uint64_t>>& dataRange = std::nullopt);
 
+/// Reads local files for a file source without blocking its thread, so that many
+/// reads can be in flight. Uses io_uring in Linux builds with liburing, and reads
+/// on the background scheduler otherwise or when the kernel doesn't support it.
+/// Must be created and used on a thread with a RunLoop.
+class LocalFileReader {
+public:
+    LocalFileReader();
+    ~LocalFileReader();
+
+    void read(const std::string& path,
+              const ActorRef<FileSourceRequest>& req,
+              const std::optional<std::pair<uint64_t, uint64_t>>& dataRange = std::nullopt);
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> impl;
+};
+
 } // namespace mbgl
@@ -10,16 +10,7 @@ CREATE TEMPORARY TABLE region_mapping AS
     FROM side.regions sr
     JOIN regions r ON sr.definition = r.definition  AND sr.description IS r.description;
 
---Insert /Update tiles
-REPLACE INTO tiles
-    SELECT t.id, -- use the old ID in case we run a REPLACE. If it doesn't exist yet, it'll be NULL which will auto-assign a new ID.
-        st.url_template, st.pixel_ratio, st.z, st.x, st.y,
-        st.expires, st.modified, st.etag, st.data, st.compressed, st.accessed, st.must_revalidate
-    FROM (SELECT DISTINCT sti.* FROM side.region_tiles srt JOIN side.tiles sti ON srt.tile_id = sti.id)   -- ensure that we're only considering region tiles, and not ambient tiles.
-    AS st
-    LEFT JOIN tiles t ON st.url_template = t.url_template AND st.pixel_ratio = t.pixel_ratio AND st.z = t.z AND st.x = t.x AND st.y = t.y
-        WHERE t.id IS NULL -- only consider tiles that don't exist yet in the original database.
-        OR st.modified > t.modified; -- ...or tiles that are newer in the side loaded DB.
+-- The tiles are copied beforehand in batches, see OfflineDatabase::mergeTiles
 
 -- Update region_tiles usage
 INSERT OR IGNORE INTO region_tiles
@@ -35,10 +26,11 @@ REPLACE INTO resources
     SELECT r.id,
         sr.url, sr.kind, sr.expires, sr.modified, sr.etag,
         sr.data, sr.compressed, sr.accessed, sr.must_revalidate
-    FROM side.region_resources srr JOIN side.resources sr ON srr.resource_id = sr.id   --only consider region resources, and not ambient resources.
+    FROM side.resources sr
     LEFT JOIN resources r ON sr.url = r.url
-        WHERE r.id IS NULL -- only consider resources that don't exist yet in the main database
-        OR sr.modified > r.modified; -- ...or resources that are newer in the side loaded DB.
+        WHERE EXISTS (SELECT 1 FROM side.region_resources srr WHERE srr.resource_id = sr.id) --only consider region resources, and not ambient resources.
+        AND (r.id IS NULL -- only consider resources that don't exist yet in the main database
+        OR sr.modified > r.modified); -- ...or resources that are newer in the side loaded DB.
 
 -- Update region_resources usage
 INSERT OR IGNORE INTO region_resources
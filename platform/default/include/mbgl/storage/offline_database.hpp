@@ -8,11 +8,14 @@
 #include <mbgl/util/mapbox.hpp>
 #include <mbgl/util/expected.hpp>
 
+#include <array>
+#include <functional>
 #include <list>
 #include <map>
 #include <memory>
 #include <string>
 #include <optional>
+#include <vector>
 
 namespace mapbox {
 namespace sqlite {
@@ -20,6 +23,7 @@ class Database;
 class Statement;
 class Query;
 class Exception;
+class Transaction;
 } // namespace sqlite
 } // namespace mapbox
 
@@ -47,9 +51,23 @@ public:
 
     std::optional<Response> get(const Resource&);
 
+    // Look up several tiles at once, as `get` would each of them, with one
+    // query for up to `maxBatchedTiles` tiles of the same URL template, pixel
+    // ratio and zoom level. The responses come in the order of the resources.
+    static constexpr std::size_t maxBatchedTiles = 16;
+    std::vector<std::optional<Response>> getTiles(const std::vector<Resource>&);
+
+    // Store what layout produced from `data` for a tile of an offline region, returned with the
+    // tile for as long as it keeps the same data. Ignored for tiles that aren't part of a region.
+    void putTileLayout(const Resource&, const std::string& data, const std::string& layout);
+
     // Return value is (inserted, stored size)
     std::pair<bool, uint64_t> put(const Resource&, const Response&);
 
+    // Write several resources to the ambient cache in one transaction.
+    // Return value is the number of resources inserted.
+    std::size_t put(const std::list<std::tuple<Resource, Response>>&);
+
     // Force Mapbox GL Native to revalidate tiles stored in the ambient
     // cache with the tile server before using them, making sure they
     // are the latest version. This is more efficient than cleaning the
@@ -69,7 +87,9 @@ public:
     expected<OfflineRegion, std::exception_ptr> createRegion(const OfflineRegionDefinition&,
                                                              const OfflineRegionMetadata&);
 
-    expected<OfflineRegions, std::exception_ptr> mergeDatabase(const std::string& sideDatabasePath);
+    // Calls `progress`, if any, with the number of side database tiles merged so far and their total.
+    expected<OfflineRegions, std::exception_ptr> mergeDatabase(
+        const std::string& sideDatabasePath, const std::function<void(uint64_t, uint64_t)>& progress = {});
 
     expected<OfflineRegionMetadata, std::exception_ptr> updateMetadata(int64_t regionID, const OfflineRegionMetadata&);
 
@@ -85,7 +105,21 @@ public:
     expected<OfflineRegionDefinition, std::exception_ptr> getRegionDefinition(int64_t regionID);
     expected<OfflineRegionStatus, std::exception_ptr> getRegionCompletedStatus(int64_t regionID);
 
+    // Mean stored size of the tiles of a URL template, for each zoom level of the range that has
+    // any, sampled from a few hundred tiles per zoom level at most.
+    std::map<uint8_t, double> getMeanTileSizes(const std::string& urlTemplate,
+                                               uint8_t pixelRatio,
+                                               uint8_t minZoom,
+                                               uint8_t maxZoom);
+
     std::exception_ptr setMaximumAmbientCacheSize(uint64_t);
+
+    // Add up the ambient cache size a few thousand rows at a time, when it
+    // isn't known from the last time the database was closed. Returns true
+    // while there is more to add up, for the caller to call it again once
+    // other requests had their turn. Until it's done, ambient cache writes
+    // evict against the part added up so far rather than wait for the rest.
+    bool continueAmbientCacheSizing();
     void setOfflineMapboxTileCountLimit(uint64_t);
     uint64_t getOfflineMapboxTileCountLimit();
     bool offlineMapboxTileCountLimitExceeded();
@@ -97,8 +131,31 @@ public:
 
     void reopenDatabaseReadOnly(bool readOnly);
 
+    // Switch between the default durability profile (rollback journal, FULL
+    // sync, every write committed on its own) and the cache-grade profile
+    // (WAL journal, NORMAL sync, ambient cache writes committed in batches).
+    // Offline region writes are committed immediately and fully synced in
+    // both profiles; batched ambient cache writes may be lost on a crash.
+    // Selecting the default profile also switches a database left in WAL
+    // mode by the cache-grade profile back to the rollback journal.
+    void setCacheGradeDurability(bool);
+
+    // Commit the ambient cache writes batched since the last commit. Callers
+    // in the cache-grade profile should call this once writes go idle.
+    void commitAmbientWrites();
+    bool hasPendingAmbientWrites() const { return ambientBatch != nullptr; }
+
+    // Compress tiles with zstd and a dictionary trained from the first few
+    // megabytes of tiles written, rather than with Deflate. The tiles of a
+    // style share much of their structure, so they compress far better with a
+    // dictionary. Tiles already stored keep their compression. Only supported
+    // by builds with zstd, which databases with zstd tiles then require.
+    void setZstdTileCompression(bool);
+
 private:
     class DatabaseSizeChangeStats;
+    class RegionWrite;
+    class TileCompressor;
 
     void initialize();
     void handleError(const mapbox::sqlite::Exception&, const char* action);
@@ -112,16 +169,38 @@ private:
     void migrateToVersion5();
     void migrateToVersion3();
     void migrateToVersion6();
+    void migrateToVersion7();
+    void migrateToVersion8();
+    void migrateToVersion9();
+    void migrateToVersion10();
     void cleanup();
     bool disabled();
     void vacuum();
     void checkFlags();
+    void applyDurability();
+    void trainTileCompression();
+    void commitAmbientBatch();
+    void discardAmbientBatch();
+    // Run an ambient cache write in a transaction of its own, or as part of
+    // the pending batch in the cache-grade profile.
+    template <typename Fn>
+    auto writeAmbient(std::size_t writes, Fn&& write);
 
     mapbox::sqlite::Statement& getStatement(const char*);
 
     std::optional<std::pair<Response, uint64_t>> getTile(const Resource::TileData&);
+    // The tiles of `indices`, at most `maxBatchedTiles` of the same template, pixel ratio and zoom level
+    void getTileBatch(const std::vector<Resource>&,
+                      const std::vector<std::size_t>& indices,
+                      std::vector<std::optional<Response>>& responses);
+    // The response of a tile row, from the etag, expires, must_revalidate, modified, data, compressed,
+    // layout data_hash and layout columns starting at `column`. Return value is (response, stored size).
+    std::pair<Response, uint64_t> readTile(mapbox::sqlite::Query&, int column);
     std::optional<int64_t> hasTile(const Resource::TileData&);
-    bool putTile(const Resource::TileData&, const Response&, const std::string&, bool compressed);
+    bool putTile(const Resource::TileData&, const Response&, const std::string&, int32_t compression);
+    // Returns the ID of the shared payload identical to the given one, stored first if needed.
+    int64_t putTileBlob(const std::string&);
+    void mergeTiles(int sideUserVersion, const std::function<void(uint64_t, uint64_t)>& progress);
 
     std::optional<std::pair<Response, uint64_t>> getResource(const Resource&);
     std::optional<int64_t> hasResource(const Resource&);
@@ -184,8 +263,30 @@ private:
     std::optional<uint64_t> currentAmbientCacheSize;
     void updateAmbientCacheSize(DatabaseSizeChangeStats&);
 
+    // The ambient cache size stored on close, if the database didn't change since
+    bool loadAmbientCacheSize();
+    void storeAmbientCacheSize();
+    // Adds up the next IDs of the table being sized, returns true once all are
+    bool sizeAmbientCache(int64_t chunk);
+
+    struct AmbientCacheSizing {
+        // Tiles, shared tile payloads and resources, added up in turn
+        std::size_t table = 0u;
+        int64_t lastID = 0;
+        // Rows written after the sizing started are counted as they're written
+        std::array<int64_t, 3> maxIDs{};
+        int64_t size = 0;
+    };
+    std::optional<AmbientCacheSizing> ambientCacheSizing;
+
     bool autopack = true;
     bool readOnly = false;
+
+    bool cacheGradeDurability = false;
+    std::unique_ptr<mapbox::sqlite::Transaction> ambientBatch;
+    std::size_t ambientBatchWrites = 0u;
+
+    std::unique_ptr<TileCompressor> tileCompressor;
 };
 
 } // namespace mbgl
@@ -4,10 +4,12 @@
 #include <mbgl/storage/offline.hpp>
 #include <mbgl/storage/resource.hpp>
 
+#include <chrono>
 #include <list>
 #include <unordered_set>
 #include <memory>
 #include <deque>
+#include <optional>
 
 namespace mbgl {
 
@@ -42,6 +44,21 @@ private:
     void deactivateDownload();
     bool flushResourcesBuffer();
 
+    uint32_t maxConcurrentRequests() const;
+
+    /*
+     * Account a network response to the current window, returning true once the
+     * window is complete. Failed responses are the ones that will be retried.
+     */
+    bool recordResponse(std::chrono::duration<double> latency, bool failed, uint64_t bytes, bool tile);
+
+    /*
+     * Adjust the concurrency to the window that just completed and report its
+     * throughput: one more request in flight after a clean window, half as many
+     * after a window with errors or with latency well above the best seen so far.
+     */
+    void completeWindow();
+
     /*
      * Ensure that the resource is stored in the database, requesting it if necessary.
      * While the request is in progress, it is recorded in `requests`. If the download
@@ -64,6 +81,19 @@ private:
     std::list<Resource> resourcesToBeMarkedAsUsed;
     std::list<std::tuple<Resource, Response>> buffer;
 
+    struct RequestWindow {
+        std::chrono::duration<double> start{};
+        std::chrono::duration<double> latency{};
+        uint32_t responses = 0;
+        uint32_t failures = 0;
+        uint64_t bytes = 0;
+        uint64_t tiles = 0;
+    };
+
+    uint32_t concurrency = 0;
+    RequestWindow window;
+    std::optional<std::chrono::duration<double>> baselineLatency;
+
     void queueResource(Resource&&);
     void queueTiles(style::SourceType, uint16_t tileSize, const Tileset&);
     void markPendingUsedResources();
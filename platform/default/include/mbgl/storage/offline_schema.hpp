@@ -19,6 +19,11 @@ static constexpr const char* offlineDatabaseSchema =
     "  must_revalidate INTEGER NOT NULL DEFAULT 0,\n"
     "  UNIQUE (url)\n"
     ");\n"
+    "CREATE TABLE tile_blobs (\n"
+    "  id INTEGER NOT NULL PRIMARY KEY AUTOINCREMENT,\n"
+    "  hash INTEGER NOT NULL,\n"
+    "  data BLOB NOT NULL\n"
+    ");\n"
     "CREATE TABLE tiles (\n"
     "  id INTEGER NOT NULL PRIMARY KEY AUTOINCREMENT,\n"
     "  url_template TEXT NOT NULL,\n"
@@ -33,8 +38,14 @@ static constexpr const char* offlineDatabaseSchema =
     "  compressed INTEGER NOT NULL DEFAULT 0,\n"
     "  accessed INTEGER NOT NULL,\n"
     "  must_revalidate INTEGER NOT NULL DEFAULT 0,\n"
+    "  blob_id INTEGER REFERENCES tile_blobs(id),\n"
     "  UNIQUE (url_template, pixel_ratio, z, x, y)\n"
     ");\n"
+    "CREATE TABLE compression_dictionaries (\n"
+    "  id INTEGER NOT NULL PRIMARY KEY,\n"
+    "  dictionary BLOB NOT NULL,\n"
+    "  created INTEGER NOT NULL\n"
+    ");\n"
     "CREATE TABLE regions (\n"
     "  id INTEGER NOT NULL PRIMARY KEY AUTOINCREMENT,\n"
     "  definition TEXT NOT NULL,\n"
@@ -50,6 +61,18 @@ static constexpr const char* offlineDatabaseSchema =
     "  tile_id INTEGER NOT NULL REFERENCES tiles(id),\n"
     "  UNIQUE (region_id, tile_id)\n"
     ");\n"
+    "CREATE TABLE tile_layouts (\n"
+    "  tile_id INTEGER NOT NULL PRIMARY KEY\n"
+    "    REFERENCES tiles(id) ON DELETE CASCADE,\n"
+    "  data_hash INTEGER NOT NULL,\n"
+    "  layout BLOB NOT NULL\n"
+    ");\n"
+    "CREATE TABLE ambient_cache_size (\n"
+    "  id INTEGER NOT NULL PRIMARY KEY CHECK (id = 1),\n"
+    "  size INTEGER,\n"
+    "  page_count INTEGER NOT NULL,\n"
+    "  freelist_count INTEGER NOT NULL\n"
+    ");\n"
     "CREATE INDEX resources_accessed\n"
     "ON resources (accessed);\n"
     "CREATE INDEX tiles_accessed\n"
@@ -57,6 +80,23 @@ static constexpr const char* offlineDatabaseSchema =
     "CREATE INDEX region_resources_resource_id\n"
     "ON region_resources (resource_id);\n"
     "CREATE INDEX region_tiles_tile_id\n"
-    "ON region_tiles (tile_id);\n";
+    "ON region_tiles (tile_id);\n"
+    "CREATE INDEX tile_blobs_hash\n"
+    "ON tile_blobs (hash);\n"
+    "CREATE INDEX tiles_blob_id\n"
+    "ON tiles (blob_id);\n"
+    "CREATE TRIGGER tiles_delete_blob\n"
+    "AFTER DELETE ON tiles\n"
+    "WHEN OLD.blob_id IS NOT NULL AND NOT EXISTS (SELECT 1 FROM tiles WHERE blob_id = OLD.blob_id)\n"
+    "BEGIN\n"
+    "  DELETE FROM tile_blobs WHERE id = OLD.blob_id;\n"
+    "END;\n"
+    "CREATE TRIGGER tiles_update_blob\n"
+    "AFTER UPDATE OF blob_id ON tiles\n"
+    "WHEN OLD.blob_id IS NOT NULL AND OLD.blob_id IS NOT NEW.blob_id\n"
+    "  AND NOT EXISTS (SELECT 1 FROM tiles WHERE blob_id = OLD.blob_id)\n"
+    "BEGIN\n"
+    "  DELETE FROM tile_blobs WHERE id = OLD.blob_id;\n"
+    "END;\n";
 
 } // namespace mbgl
@@ -42,6 +42,19 @@ CREATE TABLE resources (
   UNIQUE (url)
 );
 
+--
+-- Table containing tile payloads shared by several tiles, stored once. Ocean
+-- and empty land tiles are often identical across a whole region.
+--
+CREATE TABLE tile_blobs (
+  id INTEGER NOT NULL PRIMARY KEY AUTOINCREMENT,   -- Primary key.
+
+  hash INTEGER NOT NULL,                           -- Hash of the stored payload, used to find an identical one.
+
+  data BLOB NOT NULL                               -- The payload as stored, compressed as the tiles referring to it
+                                                   -- say.
+);
+
 --
 -- Table containing all tiles, both vector and raster.
 --
@@ -74,19 +87,40 @@ CREATE TABLE tiles (
 
   data BLOB,                                       -- Contents of the tile.
 
-  compressed INTEGER NOT NULL DEFAULT 0,           -- If the tile is compressed with Deflate or not. Compression is
-                                                   -- optional and should be used when the compression ratio is
-                                                   -- significant. Using compression will make decoding time slower
-                                                   -- because it will add an extra decompression step.
+  compressed INTEGER NOT NULL DEFAULT 0,           -- How the tile is compressed:
+                                                   -- uncompressed         = 0
+                                                   -- Deflate              = 1
+                                                   -- zstd with dictionary = 2
+                                                   -- Compression is optional and should be used when the
+                                                   -- compression ratio is significant. Using compression will make
+                                                   -- decoding time slower because it will add an extra
+                                                   -- decompression step.
 
   accessed INTEGER NOT NULL,                       -- Last time the tile was used by GL Native. Useful for when
                                                    -- evicting the least used tiles from the cache.
 
   must_revalidate INTEGER NOT NULL DEFAULT 0,      -- When set to true, the tile will not be used unless it gets
                                                    -- first revalidated by the server.
+
+  blob_id INTEGER REFERENCES tile_blobs(id),       -- The shared payload of the tile, in which case data is NULL.
+                                                   -- Deleted by the triggers below with the last tile using it.
   UNIQUE (url_template, pixel_ratio, z, x, y)
 );
 
+--
+-- Table containing the zstd dictionaries trained from the tiles of the database,
+-- used to compress the tiles with zstd. Tiles refer to their dictionary by the
+-- dictionary ID recorded in their zstd frames.
+--
+CREATE TABLE compression_dictionaries (
+  id INTEGER NOT NULL PRIMARY KEY,                 -- The zstd dictionary ID.
+
+  dictionary BLOB NOT NULL,                        -- The trained zstd dictionary.
+
+  created INTEGER NOT NULL                         -- When the dictionary was trained, new tiles are compressed with
+                                                   -- the most recent one.
+);
+
 --
 -- Regions define the offline regions, which could be a GeoJSON geometry,
 -- or a bounding box like this example:
@@ -148,6 +182,35 @@ CREATE TABLE region_tiles (
   UNIQUE (region_id, tile_id)
 );
 
+--
+-- Table containing what layout produced from the tiles of regions that can be
+-- stored and used again, for as long as the data of the tile stays the same.
+--
+CREATE TABLE tile_layouts (
+  tile_id INTEGER NOT NULL PRIMARY KEY             -- The tile laid out.
+    REFERENCES tiles(id) ON DELETE CASCADE,
+
+  data_hash INTEGER NOT NULL,                      -- Hash of the tile data laid out, as read from the database. The
+                                                   -- layout is ignored once the tile has other data.
+
+  layout BLOB NOT NULL                             -- The layout, in the format of the renderer.
+);
+
+--
+-- Single row table holding the ambient cache size when the database was last
+-- closed, so that it needn't be added up again on the next open.
+--
+CREATE TABLE ambient_cache_size (
+  id INTEGER NOT NULL PRIMARY KEY CHECK (id = 1),  -- There is only one row.
+
+  size INTEGER,                                    -- The ambient cache size. Set to NULL while the database is open,
+                                                   -- so that a crash doesn't leave a stale size behind.
+
+  page_count INTEGER NOT NULL,                     -- The page count and free page count of the database when the size
+                                                   -- was stored. The size is only used if they didn't change since.
+  freelist_count INTEGER NOT NULL
+);
+
 --
 -- Indexes for efficient eviction queries.
 --
@@ -163,3 +226,28 @@ ON region_resources (resource_id);
 
 CREATE INDEX region_tiles_tile_id
 ON region_tiles (tile_id);
+
+--
+-- Indexes and triggers for the shared tile payloads.
+--
+
+CREATE INDEX tile_blobs_hash
+ON tile_blobs (hash);
+
+CREATE INDEX tiles_blob_id
+ON tiles (blob_id);
+
+CREATE TRIGGER tiles_delete_blob
+AFTER DELETE ON tiles
+WHEN OLD.blob_id IS NOT NULL AND NOT EXISTS (SELECT 1 FROM tiles WHERE blob_id = OLD.blob_id)
+BEGIN
+  DELETE FROM tile_blobs WHERE id = OLD.blob_id;
+END;
+
+CREATE TRIGGER tiles_update_blob
+AFTER UPDATE OF blob_id ON tiles
+WHEN OLD.blob_id IS NOT NULL AND OLD.blob_id IS NOT NEW.blob_id
+  AND NOT EXISTS (SELECT 1 FROM tiles WHERE blob_id = OLD.blob_id)
+BEGIN
+  DELETE FROM tile_blobs WHERE id = OLD.blob_id;
+END;
@@ -6,9 +6,15 @@
 #include <mbgl/renderer/renderer.hpp>
 #include <mbgl/renderer/renderer_state.hpp>
 #include <mbgl/renderer/update_parameters.hpp>
+#include <mbgl/util/constants.hpp>
 #include <mbgl/util/monotonic_timer.hpp>
+#include <mbgl/util/projection.hpp>
 #include <mbgl/util/run_loop.hpp>
 
+#include <cassert>
+#include <cmath>
+#include <stdexcept>
+
 namespace mbgl {
 
 HeadlessFrontend::HeadlessFrontend(float pixelRatio_,
@@ -132,6 +138,11 @@ PremultipliedImage HeadlessFrontend::readStillImage() {
     return backend->readStillImage();
 }
 
+void HeadlessFrontend::readStillImage(PremultipliedImage& image) {
+    gfx::BackendScope guard{*getBackend()};
+    backend->readStillImageInto(image);
+}
+
 HeadlessFrontend::RenderResult HeadlessFrontend::render(Map& map) {
     HeadlessFrontend::RenderResult result;
     std::exception_ptr error;
@@ -157,6 +168,100 @@ HeadlessFrontend::RenderResult HeadlessFrontend::render(Map& map) {
     return result;
 }
 
+void HeadlessFrontend::beginRender(Map& map) {
+    std::exception_ptr error;
+    bool rendered = false;
+    gfx::BackendScope guard{*getBackend()};
+
+    map.renderStill([&](const std::exception_ptr& e) {
+        if (e) {
+            error = e;
+            return;
+        }
+        PendingRender pending{.stats = getBackend()->getContext().renderingStats(), .image = std::nullopt};
+        if (!backend->beginReadStillImage()) {
+            pending.image = backend->readStillImage();
+        }
+        pendingRenders.push_back(std::move(pending));
+        rendered = true;
+    });
+
+    while (!rendered && !error) {
+        util::RunLoop::Get()->runOnce();
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+gfx::RenderingStats HeadlessFrontend::finishRender(PremultipliedImage& image) {
+    assert(!pendingRenders.empty());
+    if (pendingRenders.empty()) {
+        return {};
+    }
+    auto pending = std::move(pendingRenders.front());
+    pendingRenders.pop_front();
+
+    if (pending.image) {
+        image = std::move(*pending.image);
+    } else {
+        gfx::BackendScope guard{*getBackend()};
+        backend->finishReadStillImage(image);
+    }
+    return pending.stats;
+}
+
+HeadlessFrontend::MetatileResult HeadlessFrontend::renderMetatile(Map& map,
+                                                                  const CanonicalTileID& tile,
+                                                                  uint32_t count,
+                                                                  uint32_t tileSize) {
+    const uint64_t worldTiles = uint64_t(1) << tile.z;
+    if (count == 0 || tileSize == 0 || tile.x + uint64_t(count) > worldTiles ||
+        tile.y + uint64_t(count) > worldTiles) {
+        throw std::invalid_argument("metatile out of range");
+    }
+
+    const auto startTime = util::MonotonicTimer::now();
+
+    const Size metatileSize{count * tileSize, count * tileSize};
+    if (size != metatileSize) {
+        setSize(metatileSize);
+        map.setSize(metatileSize);
+    }
+
+    // Tile pixels of the world at the zoom level of the tiles
+    const double scale = static_cast<double>(worldTiles) * tileSize / util::tileSize_D;
+    const double halfSize = count * tileSize * 0.5;
+    const Point<double> center{tile.x * static_cast<double>(tileSize) + halfSize,
+                               tile.y * static_cast<double>(tileSize) + halfSize};
+    map.jumpTo(CameraOptions()
+                   .withCenter(Projection::unproject(center, scale))
+                   .withZoom(tile.z + std::log2(tileSize / util::tileSize_D))
+                   .withPadding(EdgeInsets{})
+                   .withBearing(0.0)
+                   .withPitch(0.0));
+
+    auto frame = render(map);
+
+    MetatileResult result;
+    result.stats = frame.stats;
+    const auto slice = static_cast<uint32_t>(tileSize * pixelRatio);
+    assert(frame.image.size.width >= count * slice && frame.image.size.height >= count * slice);
+    result.tiles.reserve(static_cast<std::size_t>(count) * count);
+    for (uint32_t row = 0; row < count; ++row) {
+        for (uint32_t column = 0; column < count; ++column) {
+            PremultipliedImage image({slice, slice});
+            PremultipliedImage::copy(frame.image, image, {column * slice, row * slice}, {0, 0}, {slice, slice});
+            result.tiles.push_back(std::move(image));
+        }
+    }
+
+    const std::chrono::duration<double> elapsed = util::MonotonicTimer::now() - startTime;
+    result.tilesPerSecond = elapsed.count() > 0 ? result.tiles.size() / elapsed.count() : 0.0;
+    return result;
+}
+
 void HeadlessFrontend::renderOnce(Map&) {
     util::RunLoop::Get()->runOnce();
 }
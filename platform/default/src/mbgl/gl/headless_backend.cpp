@@ -118,6 +118,34 @@ PremultipliedImage HeadlessBackend::readStillImage() {
     return static_cast<gl::Context&>(getContext()).readFramebuffer<PremultipliedImage>(size);
 }
 
+void HeadlessBackend::readStillImageInto(PremultipliedImage& image) {
+    MLN_TRACE_FUNC();
+
+    auto& context = static_cast<gl::Context&>(getContext());
+    // Reads are finished oldest first, so this one can't go through the pixel pack buffers while
+    // asynchronous ones are pending
+    if (context.pendingFramebufferReads() == 0) {
+        context.beginReadFramebuffer(size);
+        if (context.finishReadFramebuffer(image)) {
+            return;
+        }
+    }
+    image = context.readFramebuffer<PremultipliedImage>(size);
+}
+
+bool HeadlessBackend::beginReadStillImage() {
+    MLN_TRACE_FUNC();
+
+    static_cast<gl::Context&>(getContext()).beginReadFramebuffer(size);
+    return true;
+}
+
+bool HeadlessBackend::finishReadStillImage(PremultipliedImage& image) {
+    MLN_TRACE_FUNC();
+
+    return static_cast<gl::Context&>(getContext()).finishReadFramebuffer(image);
+}
+
 RendererBackend* HeadlessBackend::getRendererBackend() {
     return this;
 }
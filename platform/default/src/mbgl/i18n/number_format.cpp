@@ -5,38 +5,72 @@
 #include <unicode/uvernum.h>
 #endif
 
+#include <optional>
 #include <string>
+#include <unordered_map>
 
 namespace mbgl {
 namespace platform {
 
 #if !defined(MBGL_USE_BUILTIN_ICU)
+namespace {
+
+// Styles format the labels of a layer with a handful of distinct options at most
+constexpr std::size_t maxCachedFormatters = 32;
+
+/// No formatter for an invalid currency code, which formats numbers as empty strings
+std::optional<icu::number::LocalizedNumberFormatter> createFormatter(const std::string& localeId,
+                                                                     const std::string& currency,
+                                                                     uint8_t minFractionDigits,
+                                                                     uint8_t maxFractionDigits) {
+    icu::Locale locale = icu::Locale(localeId.c_str());
+    // Print the value as currency
+    if (!currency.empty()) {
+        UErrorCode status = U_ZERO_ERROR;
+        icu::UnicodeString ucurrency = icu::UnicodeString::fromUTF8(currency);
+        icu::CurrencyUnit unit(ucurrency.getBuffer(), status);
+        if (U_FAILURE(status)) {
+            return std::nullopt;
+        }
+        return icu::number::NumberFormatter::with().unit(unit).locale(locale);
+    }
+    return icu::number::NumberFormatter::with()
+        .precision(icu::number::Precision::minMaxFraction(minFractionDigits, maxFractionDigits))
+        .locale(locale);
+}
+
+} // namespace
+
 std::string formatNumber(double number,
                          const std::string& localeId,
                          const std::string& currency,
                          uint8_t minFractionDigits,
                          uint8_t maxFractionDigits) {
-    UErrorCode status = U_ZERO_ERROR;
-    icu::UnicodeString ustr;
-    std::string formatted;
+    // Formatters are immutable once created, so each thread keeps the ones it used, by their options
+    thread_local std::unordered_map<std::string, std::optional<icu::number::LocalizedNumberFormatter>> formatters;
+    std::string key = localeId;
+    key += '\0';
+    key += currency;
+    key += '\0';
+    key += static_cast<char>(minFractionDigits);
+    key += static_cast<char>(maxFractionDigits);
 
-    icu::Locale locale = icu::Locale(localeId.c_str());
-    // Print the value as currency
-    if (!currency.empty()) {
-        icu::UnicodeString ucurrency = icu::UnicodeString::fromUTF8(currency);
-        ustr = icu::number::NumberFormatter::with()
-                   .unit(icu::CurrencyUnit(ucurrency.getBuffer(), status))
-                   .locale(locale)
-                   .formatDouble(number, status)
-                   .toString(status);
-    } else {
-        ustr = icu::number::NumberFormatter::with()
-                   .precision(icu::number::Precision::minMaxFraction(minFractionDigits, maxFractionDigits))
-                   .locale(locale)
-                   .formatDouble(number, status)
-                   .toString(status);
+    auto it = formatters.find(key);
+    if (it == formatters.end()) {
+        if (formatters.size() >= maxCachedFormatters) {
+            formatters.clear();
+        }
+        it = formatters
+                 .emplace(std::move(key), createFormatter(localeId, currency, minFractionDigits, maxFractionDigits))
+                 .first;
+    }
+
+    if (!it->second) {
+        return {};
     }
-    return ustr.toUTF8String(formatted);
+    UErrorCode status = U_ZERO_ERROR;
+    std::string formatted;
+    return it->second->formatDouble(number, status).toString(status).toUTF8String(formatted);
 }
 #else
 std::string formatNumber(double number, const std::string&, const std::string&, uint8_t, uint8_t) {
@@ -14,6 +14,8 @@
 #include <mbgl/util/exception.hpp>
 #include <mbgl/util/logging.hpp>
 #include <mbgl/util/thread.hpp>
+
+#include <algorithm>
 #include <utility>
 
 namespace mbgl {
@@ -210,9 +212,24 @@ public:
 
     mbgl::EdgeInsets getPadding() const { return regionInsets; }
 
-    void addAnnotationImage(std::unique_ptr<style::Image> image) { map.addAnnotationImage(std::move(image)); }
+    void addAnnotationImage(std::unique_ptr<style::Image> image) {
+        annotationImages.push_back(image->getID());
+        map.addAnnotationImage(std::move(image));
+    }
+
+    void addAnnotation(const Annotation& annotation) { annotations.push_back(map.addAnnotation(annotation)); }
 
-    void addAnnotation(const Annotation& annotation) { map.addAnnotation(annotation); }
+    void reset() {
+        cancel();
+        map.removeAnnotations(annotations);
+        annotations.clear();
+        for (const auto& id : annotationImages) {
+            map.removeAnnotationImage(id);
+        }
+        annotationImages.clear();
+        region = LatLngBounds::empty();
+        regionInsets = {0, 0, 0, 0};
+    }
 
     void snapshot(MapSnapshotter::Callback callback) {
         if (!callback) {
@@ -297,6 +314,8 @@ private:
     Map map;
     LatLngBounds region;
     mbgl::EdgeInsets regionInsets;
+    AnnotationIDs annotations;
+    std::vector<std::string> annotationImages;
 };
 
 MapSnapshotter::MapSnapshotter(Size size,
@@ -394,4 +413,55 @@ void MapSnapshotter::cancel() {
     impl->cancel();
 }
 
+void MapSnapshotter::reset() {
+    impl->reset();
+}
+
+MapSnapshotterPool::MapSnapshotterPool(std::size_t capacity_,
+                                       float pixelRatio_,
+                                       const ResourceOptions& resourceOptions_,
+                                       const ClientOptions& clientOptions_)
+    : capacity(capacity_),
+      pixelRatio(pixelRatio_),
+      resourceOptions(resourceOptions_.clone()),
+      clientOptions(clientOptions_.clone()) {}
+
+MapSnapshotterPool::~MapSnapshotterPool() = default;
+
+std::unique_ptr<MapSnapshotter> MapSnapshotterPool::acquire(const std::string& styleURL, Size size) {
+    const auto it = std::find_if(idle.begin(), idle.end(), [&](const Entry& entry) {
+        return entry.styleURL == styleURL && entry.size == size;
+    });
+    if (it != idle.end()) {
+        auto snapshotter = std::move(it->snapshotter);
+        idle.erase(it);
+        return snapshotter;
+    }
+
+    auto snapshotter = std::make_unique<MapSnapshotter>(size, pixelRatio, resourceOptions, clientOptions);
+    snapshotter->setStyleURL(styleURL);
+    return snapshotter;
+}
+
+void MapSnapshotterPool::release(std::unique_ptr<MapSnapshotter> snapshotter) {
+    if (!snapshotter || capacity == 0) {
+        return;
+    }
+    auto styleURL = snapshotter->getStyleURL();
+    if (styleURL.empty()) {
+        return;
+    }
+
+    snapshotter->reset();
+    const auto size = snapshotter->getSize();
+    idle.push_front(Entry{std::move(styleURL), size, std::move(snapshotter)});
+    while (idle.size() > capacity) {
+        idle.pop_back();
+    }
+}
+
+void MapSnapshotterPool::clear() {
+    idle.clear();
+}
+
 } // namespace mbgl
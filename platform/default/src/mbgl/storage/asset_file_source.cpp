@@ -38,7 +38,7 @@ public:
         const auto path = root + "/" +
                           mbgl::util::percentDecode(
                               resource.url.substr(std::char_traits<char>::length(util::ASSET_PROTOCOL)));
-        requestLocalFile(path, req, resource.dataRange);
+        reader.read(path, req, resource.dataRange);
     }
 
     void setResourceOptions(ResourceOptions options) {
@@ -63,6 +63,7 @@ public:
 
 private:
     std::string root;
+    LocalFileReader reader;
     mutable std::mutex resourceOptionsMutex;
     mutable std::mutex clientOptionsMutex;
     ResourceOptions resourceOptions;
@@ -9,29 +9,73 @@
 #include <mbgl/util/client_options.hpp>
 #include <mbgl/util/constants.hpp>
 #include <mbgl/util/logging.hpp>
+#include <mbgl/util/monotonic_timer.hpp>
 #include <mbgl/util/platform.hpp>
 #include <mbgl/util/thread.hpp>
+#include <mbgl/util/timer.hpp>
 
+#include <list>
 #include <map>
+#include <tuple>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 namespace mbgl {
+
+namespace {
+
+// Upper bound on how long batched cache-grade ambient cache writes stay uncommitted
+constexpr Duration ambientCommitDelay = Milliseconds(500);
+
+// Ambient cache writes are queued and written together once this many have
+// queued up, or this long after the first one
+constexpr std::size_t maxPendingWrites = 64;
+constexpr Duration pendingWriteDelay = Milliseconds(100);
+
+// With EXPERIMENTAL_BATCHED_TILE_READS, tile requests are looked up together once this many have queued up,
+// or this long after the first one, a map showing a new area asking for all of its tiles at once
+constexpr std::size_t maxPendingReads = 64;
+constexpr Duration pendingReadDelay = Milliseconds(2);
+
+// Pause between the steps of adding up the ambient cache size, in which requests are served
+constexpr Duration ambientCacheSizingInterval = Milliseconds(1);
+
+} // namespace
+
 class DatabaseFileSourceThread {
 public:
     DatabaseFileSourceThread(std::shared_ptr<FileSource> onlineFileSource_, const std::string& cachePath)
         : db(std::make_unique<OfflineDatabase>(cachePath, onlineFileSource_->getResourceOptions().tileServerOptions())),
-          onlineFileSource(std::move(onlineFileSource_)) {}
+          onlineFileSource(std::move(onlineFileSource_)) {
+        const auto value = platform::Settings::getInstance().get(platform::EXPERIMENTAL_BATCHED_TILE_READS);
+        if (const auto* enabled = value.getBool()) {
+            batchTileReads = *enabled;
+        }
+    }
+
+    ~DatabaseFileSourceThread() {
+        // Closing the database commits whatever it batched
+        db->put(pendingWrites);
+    }
 
     void request(const Resource& resource, const ActorRef<FileSourceRequest>& req) {
-        std::optional<Response> offlineResponse = (resource.storagePolicy != Resource::StoragePolicy::Volatile)
-                                                      ? db->get(resource)
-                                                      : std::nullopt;
+        if (resource.storagePolicy == Resource::StoragePolicy::Volatile) {
+            respond(std::nullopt, req);
+        } else if (batchTileReads && resource.kind == Resource::Kind::Tile && resource.tileData) {
+            queueRead(resource, req);
+        } else {
+            respond(get(resource), req);
+        }
+    }
+
+    void respond(std::optional<Response> offlineResponse, const ActorRef<FileSourceRequest>& req) {
         if (!offlineResponse) {
             offlineResponse.emplace();
             offlineResponse->noContent = true;
             offlineResponse->error = std::make_unique<Response::Error>(Response::Error::Reason::NotFound,
                                                                        "Not found in offline database");
-        } else if (!offlineResponse->isUsable()) {
+        } else if (!staleWhileRevalidate && !offlineResponse->isUsable()) {
             offlineResponse->error = std::make_unique<Response::Error>(Response::Error::Reason::NotFound,
                                                                        "Cached resource is unusable");
         }
@@ -39,6 +83,8 @@ public:
     }
 
     void setDatabasePath(const std::string& path, const std::function<void()>& callback) {
+        flushPendingReads();
+        flushPendingWrites();
         db->changePath(path);
         if (callback) {
             callback();
@@ -46,29 +92,46 @@ public:
     }
 
     void forward(const Resource& resource, const Response& response, const std::function<void()>& callback) {
-        db->put(resource, response);
+        queueWrite(resource, response);
         if (callback) {
             callback();
         }
     }
 
-    void resetDatabase(const std::function<void(std::exception_ptr)>& callback) { callback(db->resetDatabase()); }
+    void putTileLayout(const Resource& resource,
+                       const std::shared_ptr<const std::string>& data,
+                       const std::string& layout) {
+        db->putTileLayout(resource, *data, layout);
+    }
 
-    void packDatabase(const std::function<void(std::exception_ptr)>& callback) { callback(db->pack()); }
+    void resetDatabase(const std::function<void(std::exception_ptr)>& callback) {
+        flushPendingReads();
+        discardPendingWrites();
+        callback(db->resetDatabase());
+    }
+
+    void packDatabase(const std::function<void(std::exception_ptr)>& callback) {
+        flushPendingWrites();
+        callback(db->pack());
+    }
 
     void runPackDatabaseAutomatically(bool autopack) { db->runPackDatabaseAutomatically(autopack); }
 
-    void put(const Resource& resource, const Response& response) { db->put(resource, response); }
+    void put(const Resource& resource, const Response& response) { queueWrite(resource, response); }
 
     void invalidateAmbientCache(const std::function<void(std::exception_ptr)>& callback) {
+        flushPendingWrites();
         callback(db->invalidateAmbientCache());
     }
 
     void clearAmbientCache(const std::function<void(std::exception_ptr)>& callback) {
+        flushPendingReads();
+        discardPendingWrites();
         callback(db->clearAmbientCache());
     }
 
     void setMaximumAmbientCacheSize(uint64_t size, const std::function<void(std::exception_ptr)>& callback) {
+        flushPendingWrites();
         callback(db->setMaximumAmbientCacheSize(size));
     }
 
@@ -84,12 +147,15 @@ public:
     void createRegion(const OfflineRegionDefinition& definition,
                       const OfflineRegionMetadata& metadata,
                       const std::function<void(expected<OfflineRegion, std::exception_ptr>)>& callback) {
+        flushPendingWrites();
         callback(db->createRegion(definition, metadata));
     }
 
     void mergeOfflineRegions(const std::string& sideDatabasePath,
+                             const std::function<void(uint64_t, uint64_t)>& progress,
                              const std::function<void(expected<OfflineRegions, std::exception_ptr>)>& callback) {
-        callback(db->mergeDatabase(sideDatabasePath));
+        flushPendingWrites();
+        callback(db->mergeDatabase(sideDatabasePath, progress));
     }
 
     void updateMetadata(const int64_t regionID,
@@ -109,10 +175,12 @@ public:
 
     void deleteRegion(OfflineRegion region, const std::function<void(std::exception_ptr)>& callback) {
         downloads.erase(region.getID());
+        flushPendingWrites();
         callback(db->deleteRegion(std::move(region)));
     }
 
     void invalidateRegion(int64_t regionID, const std::function<void(std::exception_ptr)>& callback) {
+        flushPendingWrites();
         callback(db->invalidateRegion(regionID));
     }
 
@@ -123,6 +191,8 @@ public:
     }
 
     void setRegionDownloadState(int64_t regionID, OfflineRegionDownloadState state) {
+        // Downloads write to the database directly
+        flushPendingWrites();
         if (auto download = getDownload(regionID)) {
             download.value()->setState(state);
         }
@@ -130,9 +200,158 @@ public:
 
     void setOfflineMapboxTileCountLimit(uint64_t limit) { db->setOfflineMapboxTileCountLimit(limit); }
 
-    void reopenDatabaseReadOnly(bool readOnly) { db->reopenDatabaseReadOnly(readOnly); }
+    void reopenDatabaseReadOnly(bool readOnly) {
+        flushPendingWrites();
+        db->reopenDatabaseReadOnly(readOnly);
+    }
+
+    void setCacheGradeDurability(bool enable) {
+        flushPendingWrites();
+        db->setCacheGradeDurability(enable);
+    }
+
+    void setZstdTileCompression(bool enable) {
+        flushPendingWrites();
+        db->setZstdTileCompression(enable);
+    }
+
+    void setStaleWhileRevalidate(bool enable) { staleWhileRevalidate = enable; }
 
 private:
+    // Pending writes take precedence over the database, so reads see them right away
+    std::optional<Response> get(const Resource& resource) {
+        const auto it = pendingWriteIndex.find(resource.url);
+        if (it == pendingWriteIndex.end()) {
+            return db->get(resource);
+        }
+
+        const auto& pending = std::get<1>(*it->second);
+        if (!pending.notModified) {
+            return pending;
+        }
+
+        // Only the expiration is pending, the rest is in the database
+        auto response = db->get(resource);
+        if (response) {
+            response->expires = pending.expires;
+            response->mustRevalidate = pending.mustRevalidate;
+        }
+        return response;
+    }
+
+    void queueRead(const Resource& resource, const ActorRef<FileSourceRequest>& req) {
+        pendingReads.emplace_back(resource, req);
+        if (pendingReads.size() >= maxPendingReads) {
+            flushPendingReads();
+        } else if (pendingReads.size() == 1) {
+            pendingReadTimer.start(pendingReadDelay, Duration::zero(), [this] { flushPendingReads(); });
+        }
+    }
+
+    void flushPendingReads() {
+        if (pendingReads.empty()) {
+            return;
+        }
+
+        pendingReadTimer.stop();
+        const auto reads = std::move(pendingReads);
+        pendingReads.clear();
+
+        // Tiles with a pending write are read as other resources are
+        std::vector<Resource> resources;
+        std::vector<const ActorRef<FileSourceRequest>*> requests;
+        resources.reserve(reads.size());
+        requests.reserve(reads.size());
+        for (const auto& [resource, req] : reads) {
+            if (pendingWriteIndex.contains(resource.url)) {
+                respond(get(resource), req);
+            } else {
+                resources.push_back(resource);
+                requests.push_back(&req);
+            }
+        }
+        if (resources.empty()) {
+            return;
+        }
+
+        auto responses = db->getTiles(resources);
+        for (std::size_t i = 0; i < responses.size(); ++i) {
+            respond(std::move(responses[i]), *requests[i]);
+        }
+    }
+
+    void queueWrite(const Resource& resource, const Response& response) {
+        // The database doesn't store errors either
+        if (response.error) {
+            return;
+        }
+
+        const auto it = pendingWriteIndex.find(resource.url);
+        if (it != pendingWriteIndex.end()) {
+            auto& pending = std::get<1>(*it->second);
+            if (response.notModified && !pending.notModified) {
+                pending.expires = response.expires;
+                pending.mustRevalidate = response.mustRevalidate;
+            } else {
+                pending = response;
+            }
+            return;
+        }
+
+        pendingWrites.emplace_back(resource, response);
+        pendingWriteIndex.emplace(resource.url, std::prev(pendingWrites.end()));
+
+        if (pendingWrites.size() >= maxPendingWrites) {
+            flushPendingWrites();
+        } else if (pendingWrites.size() == 1) {
+            pendingWriteTimer.start(pendingWriteDelay, Duration::zero(), [this] { flushPendingWrites(); });
+        }
+    }
+
+    void flushPendingWrites() {
+        if (pendingWrites.empty()) {
+            return;
+        }
+
+        const auto writes = std::move(pendingWrites);
+        discardPendingWrites();
+        // The first writes start adding up the ambient cache size, if the database doesn't know it from the last
+        // time it was closed, rather than wait for it
+        scheduleAmbientCacheSizing();
+        db->put(writes);
+        scheduleAmbientCommit();
+    }
+
+    void discardPendingWrites() {
+        pendingWriteTimer.stop();
+        pendingWrites.clear();
+        pendingWriteIndex.clear();
+    }
+
+    void scheduleAmbientCommit() {
+        if (ambientCommitScheduled || !db->hasPendingAmbientWrites()) {
+            return;
+        }
+        ambientCommitScheduled = true;
+        ambientCommitTimer.start(ambientCommitDelay, Duration::zero(), [this] {
+            ambientCommitScheduled = false;
+            db->commitAmbientWrites();
+        });
+    }
+
+    void scheduleAmbientCacheSizing() {
+        if (ambientCacheSizingScheduled || !db->continueAmbientCacheSizing()) {
+            return;
+        }
+        ambientCacheSizingScheduled = true;
+        ambientCacheSizingTimer.start(ambientCacheSizingInterval, ambientCacheSizingInterval, [this] {
+            if (!db->continueAmbientCacheSizing()) {
+                ambientCacheSizingScheduled = false;
+                ambientCacheSizingTimer.stop();
+            }
+        });
+    }
+
     expected<OfflineDownload*, std::exception_ptr> getDownload(int64_t regionID) {
         if (!onlineFileSource) {
             return unexpected<std::exception_ptr>(
@@ -155,6 +374,19 @@ private:
     std::unique_ptr<OfflineDatabase> db;
     std::map<int64_t, std::unique_ptr<OfflineDownload>> downloads;
     std::shared_ptr<FileSource> onlineFileSource;
+    util::Timer ambientCommitTimer;
+    bool ambientCommitScheduled = false;
+    util::Timer ambientCacheSizingTimer;
+    bool ambientCacheSizingScheduled = false;
+    bool staleWhileRevalidate = false;
+    bool batchTileReads = false;
+
+    std::vector<std::pair<Resource, ActorRef<FileSourceRequest>>> pendingReads;
+    util::Timer pendingReadTimer;
+
+    std::list<std::tuple<Resource, Response>> pendingWrites;
+    std::unordered_map<std::string, std::list<std::tuple<Resource, Response>>::iterator> pendingWriteIndex;
+    util::Timer pendingWriteTimer;
 };
 
 class DatabaseFileSource::Impl {
@@ -212,7 +444,13 @@ DatabaseFileSource::DatabaseFileSource(const ResourceOptions& resourceOptions, c
 DatabaseFileSource::~DatabaseFileSource() = default;
 
 std::unique_ptr<AsyncRequest> DatabaseFileSource::request(const Resource& resource, Callback callback) {
-    auto req = std::make_unique<FileSourceRequest>(std::move(callback));
+    auto req = std::make_unique<FileSourceRequest>(
+        [callback = std::move(callback), resource, start = util::MonotonicTimer::now()](const Response& response) {
+            const auto latency = std::chrono::duration_cast<Duration>(util::MonotonicTimer::now() - start);
+            FileSourceManager::get()->getMetrics().record(
+                resource, FileSourceMetrics::Origin::Cache, response, latency);
+            callback(response);
+        });
     impl->actor().invoke(&DatabaseFileSourceThread::request, resource, req->actor());
     return req;
 }
@@ -227,6 +465,14 @@ void DatabaseFileSource::forward(const Resource& res, const Response& response,
     impl->actor().invoke(&DatabaseFileSourceThread::forward, res, response, std::move(wrapper));
 }
 
+void DatabaseFileSource::putTileLayout(const Resource& res,
+                                       std::shared_ptr<const std::string> data,
+                                       std::string layout) {
+    if (!data || res.storagePolicy == Resource::StoragePolicy::Volatile) return;
+
+    impl->actor().invoke(&DatabaseFileSourceThread::putTileLayout, res, std::move(data), std::move(layout));
+}
+
 bool DatabaseFileSource::canRequest(const Resource& resource) const {
     return resource.hasLoadingMethod(Resource::LoadingMethod::Cache) &&
            resource.url.rfind(mbgl::util::ASSET_PROTOCOL, 0) == std::string::npos &&
@@ -284,7 +530,15 @@ void DatabaseFileSource::createOfflineRegion(
 
 void DatabaseFileSource::mergeOfflineRegions(
     const std::string& sideDatabasePath, std::function<void(expected<OfflineRegions, std::exception_ptr>)> callback) {
-    impl->actor().invoke(&DatabaseFileSourceThread::mergeOfflineRegions, sideDatabasePath, std::move(callback));
+    mergeOfflineRegions(sideDatabasePath, {}, std::move(callback));
+}
+
+void DatabaseFileSource::mergeOfflineRegions(
+    const std::string& sideDatabasePath,
+    std::function<void(uint64_t, uint64_t)> progress,
+    std::function<void(expected<OfflineRegions, std::exception_ptr>)> callback) {
+    impl->actor().invoke(
+        &DatabaseFileSourceThread::mergeOfflineRegions, sideDatabasePath, std::move(progress), std::move(callback));
 }
 
 void DatabaseFileSource::updateOfflineMetadata(
@@ -326,6 +580,12 @@ void DatabaseFileSource::setOfflineMapboxTileCountLimit(uint64_t limit) const {
 void DatabaseFileSource::setProperty(const std::string& key, const mapbox::base::Value& value) {
     if (key == READ_ONLY_MODE_KEY && value.getBool()) {
         impl->actor().invoke(&DatabaseFileSourceThread::reopenDatabaseReadOnly, *value.getBool());
+    } else if (key == CACHE_GRADE_DURABILITY_KEY && value.getBool()) {
+        impl->actor().invoke(&DatabaseFileSourceThread::setCacheGradeDurability, *value.getBool());
+    } else if (key == ZSTD_TILE_COMPRESSION_KEY && value.getBool()) {
+        impl->actor().invoke(&DatabaseFileSourceThread::setZstdTileCompression, *value.getBool());
+    } else if (key == STALE_WHILE_REVALIDATE_KEY && value.getBool()) {
+        impl->actor().invoke(&DatabaseFileSourceThread::setStaleWhileRevalidate, *value.getBool());
     } else {
         std::string message = "Resource provider does not support property " + key;
         Log::Error(Event::General, message.c_str());
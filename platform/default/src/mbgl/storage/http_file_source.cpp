@@ -1,4 +1,5 @@
 #include <algorithm>
+#include <mbgl/platform/settings.hpp>
 #include <mbgl/storage/http_file_source.hpp>
 #include <mbgl/storage/resource_options.hpp>
 #include <mbgl/storage/resource.hpp>
@@ -16,10 +17,12 @@
 #include <curl/curl.h>
 
 #include <dlfcn.h>
+#include <array>
 #include <queue>
 #include <cassert>
 #include <cstring>
 #include <cstdio>
+#include <mutex>
 #include <optional>
 
 namespace {
@@ -34,6 +37,59 @@ void handleError(CURLcode code) {
         throw std::runtime_error(std::string("CURL easy error: ") + curl_easy_strerror(code));
     }
 }
+
+void handleError(CURLSHcode code) {
+    if (code != CURLSHE_OK) {
+        throw std::runtime_error(std::string("CURL share error: ") + curl_share_strerror(code));
+    }
+}
+
+// Resolved host names and TLS sessions, shared by the handles of all HTTPFileSource instances in
+// the process, which may run on different threads. Connections stay with each instance's multi
+// handle, as libcurl can't multiplex over connections shared between multi handles.
+class SharedSession {
+public:
+    // Never destroyed, since file sources may still be running during static destruction.
+    // Requires `curl_global_init` to have been called.
+    static CURLSH *get() {
+        static auto *session = new SharedSession();
+        return session->share;
+    }
+
+private:
+    SharedSession()
+        : share(curl_share_init()) {
+        if (!share) {
+            throw std::runtime_error("Could not init cURL share");
+        }
+        handleError(curl_share_setopt(share, CURLSHOPT_LOCKFUNC, lock));
+        handleError(curl_share_setopt(share, CURLSHOPT_UNLOCKFUNC, unlock));
+        handleError(curl_share_setopt(share, CURLSHOPT_USERDATA, this));
+        handleError(curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS));
+        handleError(curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION));
+    }
+
+    static void lock(CURL * /* handle */, curl_lock_data data, curl_lock_access /* access */, void *userp) {
+        reinterpret_cast<SharedSession *>(userp)->mutexes[data].lock();
+    }
+
+    static void unlock(CURL * /* handle */, curl_lock_data data, void *userp) {
+        reinterpret_cast<SharedSession *>(userp)->mutexes[data].unlock();
+    }
+
+    CURLSH *const share;
+    std::array<std::mutex, CURL_LOCK_DATA_LAST> mutexes;
+};
+
+long getMaxHostConnections() {
+    const auto value = mbgl::platform::Settings::getInstance().get(mbgl::platform::HTTP_MAX_HOST_CONNECTIONS);
+    if (const auto *maxConnections = value.getUint()) {
+        return static_cast<long>(*maxConnections);
+    } else if (const auto *signedMaxConnections = value.getInt(); signedMaxConnections && *signedMaxConnections > 0) {
+        return static_cast<long>(*signedMaxConnections);
+    }
+    return 0;
+}
 } // namespace
 
 namespace mbgl {
@@ -59,9 +115,12 @@ public:
     // without having to block and spawn threads.
     CURLM *multi = nullptr;
 
-    // CURL share handles are used for sharing session state (e.g.)
+    // CURL share handle for the DNS and TLS session caches of the whole process.
     CURLSH *share = nullptr;
 
+    // Whether libcurl was built with HTTP/2 support, so requests can be multiplexed.
+    bool http2 = false;
+
     // A queue that we use for storing reusable CURL easy handles to avoid
     // creating and destroying them all the time.
     std::queue<CURL *> handles;
@@ -114,13 +173,22 @@ HTTPFileSource::Impl::Impl(const ResourceOptions &resourceOptions_, const Client
         throw std::runtime_error("Could not init cURL");
     }
 
-    share = curl_share_init();
+    share = SharedSession::get();
+    http2 = (curl_version_info(CURLVERSION_NOW)->features & CURL_VERSION_HTTP2) != 0;
 
     multi = curl_multi_init();
     handleError(curl_multi_setopt(multi, CURLMOPT_SOCKETFUNCTION, handleSocket));
     handleError(curl_multi_setopt(multi, CURLMOPT_SOCKETDATA, this));
     handleError(curl_multi_setopt(multi, CURLMOPT_TIMERFUNCTION, startTimeout));
     handleError(curl_multi_setopt(multi, CURLMOPT_TIMERDATA, this));
+#if LIBCURL_VERSION_NUM >= ((7) << 16 | (43) << 8 | 0) // Added in 7.43.0
+    if (http2) {
+        handleError(curl_multi_setopt(multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX));
+    }
+#endif
+    if (const long maxHostConnections = getMaxHostConnections()) {
+        handleError(curl_multi_setopt(multi, CURLMOPT_MAX_HOST_CONNECTIONS, maxHostConnections));
+    }
 }
 
 HTTPFileSource::Impl::~Impl() {
@@ -132,7 +200,7 @@ HTTPFileSource::Impl::~Impl() {
     curl_multi_cleanup(multi);
     multi = nullptr;
 
-    curl_share_cleanup(share);
+    // The share handle belongs to the process
     share = nullptr;
 
     timeout.stop();
@@ -305,6 +373,14 @@ HTTPRequest::HTTPRequest(HTTPFileSource::Impl *context_, Resource resource_, Fil
 #endif
     handleError(curl_easy_setopt(handle, CURLOPT_USERAGENT, "MapLibreNative/1.0"));
     handleError(curl_easy_setopt(handle, CURLOPT_SHARE, context->share));
+#if LIBCURL_VERSION_NUM >= ((7) << 16 | (47) << 8 | 0) // CURL_HTTP_VERSION_2TLS added in 7.47.0
+    if (context->http2) {
+        // Prefer HTTP/2 over TLS, and wait for a connection that's being set up to a host rather than
+        // opening another one, so that requests to the same host get multiplexed.
+        handleError(curl_easy_setopt(handle, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS));
+        handleError(curl_easy_setopt(handle, CURLOPT_PIPEWAIT, 1L));
+    }
+#endif
 
     // Start requesting the information.
     handleError(curl_multi_add_handle(context->multi, handle));
@@ -1,10 +1,25 @@
+#include <mbgl/actor/scheduler.hpp>
 #include <mbgl/storage/file_source_request.hpp>
+#include <mbgl/storage/local_file_request.hpp>
 #include <mbgl/storage/response.hpp>
 #include <mbgl/util/io.hpp>
+#include <mbgl/util/logging.hpp>
 
 #include <sys/types.h>
 #include <sys/stat.h>
 
+#if MLN_WITH_LIBURING
+#include <mbgl/util/run_loop.hpp>
+
+#include <cstring>
+#include <deque>
+
+#include <fcntl.h>
+#include <liburing.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#endif
+
 #if defined(_WIN32) && !defined(S_ISDIR)
 #define S_ISDIR(m) (((m) & S_IFMT) == S_IFDIR)
 #endif
@@ -35,4 +50,205 @@ void requestLocalFile(const std::string& path,
     req.invoke(&FileSourceRequest::setResponse, response);
 }
 
+#if MLN_WITH_LIBURING
+
+namespace {
+
+// Submission queue size and the most reads in flight, further reads wait for one to complete
+constexpr unsigned ringEntries = 64;
+
+} // namespace
+
+// Reads straight into the string that becomes the response data. Completions are
+// signalled on an eventfd watched by the RunLoop of the thread owning the reader.
+class LocalFileReader::Impl {
+public:
+    Impl() {
+        if (io_uring_queue_init(ringEntries, &ring, 0) < 0) {
+            Log::Info(Event::General, "io_uring isn't available, reading local files on the background scheduler");
+            return;
+        }
+        eventFD = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (eventFD < 0 || io_uring_register_eventfd(&ring, eventFD) < 0) {
+            if (eventFD >= 0) {
+                close(eventFD);
+            }
+            io_uring_queue_exit(&ring);
+            return;
+        }
+        ready = true;
+        util::RunLoop::Get()->addWatch(eventFD, util::RunLoop::Event::Read, [this](int, util::RunLoop::Event) {
+            reap();
+        });
+    }
+
+    ~Impl() {
+        if (!ready) {
+            return;
+        }
+        util::RunLoop::Get()->removeWatch(eventFD);
+        // The kernel may still be writing into the buffers of reads in flight
+        while (inFlight > 0) {
+            io_uring_cqe* cqe = nullptr;
+            if (io_uring_wait_cqe(&ring, &cqe) < 0) {
+                break;
+            }
+            std::unique_ptr<PendingRead> pending(static_cast<PendingRead*>(io_uring_cqe_get_data(cqe)));
+            io_uring_cqe_seen(&ring, cqe);
+            close(pending->fd);
+            inFlight--;
+        }
+        for (const auto& pending : waiting) {
+            close(pending->fd);
+        }
+        io_uring_queue_exit(&ring);
+        close(eventFD);
+    }
+
+    bool read(const std::string& path,
+              const ActorRef<FileSourceRequest>& req,
+              const std::optional<std::pair<uint64_t, uint64_t>>& dataRange) {
+        if (!ready) {
+            return false;
+        }
+
+        // Opening and checking the file are cheap compared to reading it
+        const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        struct stat buf;
+        if (fd < 0 || fstat(fd, &buf) < 0 || S_ISDIR(buf.st_mode)) {
+            Response response;
+            if (fd < 0 && errno != ENOENT) {
+                response.error = std::make_unique<Response::Error>(Response::Error::Reason::Other,
+                                                                   std::string("Cannot read file ") + path);
+            } else {
+                response.error = std::make_unique<Response::Error>(Response::Error::Reason::NotFound);
+            }
+            if (fd >= 0) {
+                close(fd);
+            }
+            req.invoke(&FileSourceRequest::setResponse, response);
+            return true;
+        }
+
+        // Ranges past the end of the file are zero-filled, as util::readFile does
+        const auto offset = dataRange ? dataRange->first : 0;
+        const auto size = dataRange ? dataRange->second - dataRange->first + 1 : static_cast<uint64_t>(buf.st_size);
+        auto pending = std::make_unique<PendingRead>(
+            PendingRead{fd, offset, std::make_shared<std::string>(static_cast<std::size_t>(size), '\0'), 0, req});
+        if (size == 0) {
+            complete(std::move(pending));
+        } else {
+            submit(std::move(pending));
+            io_uring_submit(&ring);
+        }
+        return true;
+    }
+
+private:
+    struct PendingRead {
+        int fd;
+        uint64_t offset;
+        std::shared_ptr<std::string> data;
+        std::size_t done;
+        ActorRef<FileSourceRequest> req;
+    };
+
+    void submit(std::unique_ptr<PendingRead> pending) {
+        // Keeps the completions within the completion queue
+        io_uring_sqe* sqe = inFlight < ringEntries ? io_uring_get_sqe(&ring) : nullptr;
+        if (!sqe) {
+            waiting.push_back(std::move(pending));
+            return;
+        }
+        io_uring_prep_read(sqe,
+                           pending->fd,
+                           pending->data->data() + pending->done,
+                           static_cast<unsigned>(pending->data->size() - pending->done),
+                           pending->offset + pending->done);
+        io_uring_sqe_set_data(sqe, pending.release());
+        inFlight++;
+    }
+
+    void reap() {
+        uint64_t count = 0;
+        [[maybe_unused]] const auto result = ::read(eventFD, &count, sizeof(count));
+
+        io_uring_cqe* cqe = nullptr;
+        while (io_uring_peek_cqe(&ring, &cqe) == 0) {
+            std::unique_ptr<PendingRead> pending(static_cast<PendingRead*>(io_uring_cqe_get_data(cqe)));
+            const int res = cqe->res;
+            io_uring_cqe_seen(&ring, cqe);
+            inFlight--;
+
+            if (res == -EAGAIN || res == -EINTR) {
+                submit(std::move(pending));
+            } else if (res < 0) {
+                fail(std::move(pending), -res);
+            } else {
+                pending->done += static_cast<std::size_t>(res);
+                // Short reads continue where they stopped, until the end of the file
+                if (res > 0 && pending->done < pending->data->size()) {
+                    submit(std::move(pending));
+                } else {
+                    complete(std::move(pending));
+                }
+            }
+        }
+
+        while (!waiting.empty() && inFlight < ringEntries) {
+            auto pending = std::move(waiting.front());
+            waiting.pop_front();
+            submit(std::move(pending));
+        }
+        io_uring_submit(&ring);
+    }
+
+    void complete(std::unique_ptr<PendingRead> pending) {
+        close(pending->fd);
+        Response response;
+        response.data = std::move(pending->data);
+        pending->req.invoke(&FileSourceRequest::setResponse, response);
+    }
+
+    void fail(std::unique_ptr<PendingRead> pending, int error) {
+        close(pending->fd);
+        Response response;
+        response.error = std::make_unique<Response::Error>(Response::Error::Reason::Other,
+                                                           std::string("Cannot read file: ") + std::strerror(error));
+        pending->req.invoke(&FileSourceRequest::setResponse, response);
+    }
+
+    io_uring ring;
+    int eventFD = -1;
+    bool ready = false;
+    std::size_t inFlight = 0;
+    std::deque<std::unique_ptr<PendingRead>> waiting;
+};
+
+#else
+
+class LocalFileReader::Impl {
+public:
+    bool read(const std::string&,
+              const ActorRef<FileSourceRequest>&,
+              const std::optional<std::pair<uint64_t, uint64_t>>&) {
+        return false;
+    }
+};
+
+#endif
+
+LocalFileReader::LocalFileReader()
+    : impl(std::make_unique<Impl>()) {}
+
+LocalFileReader::~LocalFileReader() = default;
+
+void LocalFileReader::read(const std::string& path,
+                           const ActorRef<FileSourceRequest>& req,
+                           const std::optional<std::pair<uint64_t, uint64_t>>& dataRange) {
+    if (!impl->read(path, req, dataRange)) {
+        Scheduler::GetBackground()->schedule([path, req, dataRange] { requestLocalFile(path, req, dataRange); });
+    }
+}
+
 } // namespace mbgl
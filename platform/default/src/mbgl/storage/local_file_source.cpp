@@ -36,7 +36,7 @@ public:
         // Cut off the protocol and prefix with path.
         const auto path = mbgl::util::percentDecode(
             resource.url.substr(std::char_traits<char>::length(util::FILE_PROTOCOL)));
-        requestLocalFile(path, req, resource.dataRange);
+        reader.read(path, req, resource.dataRange);
     }
 
     void setResourceOptions(ResourceOptions options) {
@@ -60,6 +60,7 @@ public:
     }
 
 private:
+    LocalFileReader reader;
     mutable std::mutex resourceOptionsMutex;
     mutable std::mutex clientOptionsMutex;
     ResourceOptions resourceOptions;
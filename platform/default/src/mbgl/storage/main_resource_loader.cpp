@@ -89,7 +89,9 @@ public:
 
                     // Resource is in the cache
                     if (!response.noContent) {
-                        if (response.isUsable()) {
+                        // The database flags the responses that it doesn't allow serving
+                        // while they are revalidated.
+                        if (!response.error) {
                             callback(response);
                             // Set the priority of existing resource to low if it's expired but usable.
                             res.setPriority(Resource::Priority::Low);
@@ -188,6 +190,12 @@ public:
                (pmtilesFileSource && pmtilesFileSource->canRequest(resource));
     }
 
+    void putTileLayout(const Resource& resource, std::shared_ptr<const std::string> data, std::string layout) {
+        if (databaseFileSource) {
+            databaseFileSource->putTileLayout(resource, std::move(data), std::move(layout));
+        }
+    }
+
     bool supportsCacheOnlyRequests() const { return supportsCacheOnlyRequests_; }
 
     void pause() { thread->pause(); }
@@ -266,6 +274,12 @@ bool MainResourceLoader::canRequest(const Resource& resource) const {
     return impl->canRequest(resource);
 }
 
+void MainResourceLoader::putTileLayout(const Resource& resource,
+                                       std::shared_ptr<const std::string> data,
+                                       std::string layout) {
+    impl->putTileLayout(resource, std::move(data), std::move(layout));
+}
+
 void MainResourceLoader::pause() {
     impl->pause();
 }
@@ -1,6 +1,9 @@
 #include <sstream>
 #include <map>
+#include <mutex>
+#include <vector>
 
+#include <mbgl/actor/scheduler.hpp>
 #include <mbgl/platform/settings.hpp>
 #include <mbgl/storage/mbtiles_file_source.hpp>
 #include <mbgl/storage/file_source_request.hpp>
@@ -35,11 +38,99 @@ bool acceptsURL(const std::string &url) {
 std::string url_to_path(const std::string &url) {
     return mbgl::util::percentDecode(url.substr(std::char_traits<char>::length(mbgl::util::MBTILES_PROTOCOL)));
 }
+
+std::string db_path(const std::string &path) {
+    return path.substr(0, path.find('?'));
+}
+
 } // namespace
 
 namespace mbgl {
 using namespace rapidjson;
 
+// Read-only connections to the .mbtiles files, each with its tile query prepared once, shared by the
+// tile reads running on the background threads. Connections are only used by one read at a time.
+class MBTilesFileSource::ConnectionPool {
+public:
+    struct Connection {
+        explicit Connection(const std::string &path)
+            : db(mapbox::sqlite::Database::open(path, mapbox::sqlite::ReadOnly)) {
+            // Tile blobs are read from the mapped file rather than copied through the page cache
+            db.exec("PRAGMA mmap_size = " + std::to_string(mmapSize));
+            tileStatement = std::make_unique<mapbox::sqlite::Statement>(
+                db, "SELECT tile_data FROM tiles WHERE zoom_level = ?1 AND tile_column = ?2 AND tile_row = ?3");
+        }
+
+        mapbox::sqlite::Database db;
+        std::unique_ptr<mapbox::sqlite::Statement> tileStatement;
+    };
+
+    /// An idle connection to the file, or a new one. Throws `mapbox::sqlite::Exception` if it can't be opened.
+    std::unique_ptr<Connection> acquire(const std::string &path) {
+        {
+            std::scoped_lock lock(mutex);
+            auto &connections = idle[path];
+            if (!connections.empty()) {
+                auto connection = std::move(connections.back());
+                connections.pop_back();
+                return connection;
+            }
+        }
+        return std::make_unique<Connection>(path);
+    }
+
+    void release(const std::string &path, std::unique_ptr<Connection> connection) {
+        std::scoped_lock lock(mutex);
+        auto &connections = idle[path];
+        if (connections.size() < maxIdleConnections) {
+            connections.push_back(std::move(connection));
+        }
+    }
+
+    // Load data for specific tile
+    void request_tile(const Resource &resource, ActorRef<FileSourceRequest> req) {
+        const std::string path = db_path(url_to_path(resource.url));
+        const auto &tile = *resource.tileData;
+        // MBTiles rows are numbered from the south, in the TMS scheme
+        const int32_t row = (1 << tile.z) - 1 - tile.y;
+
+        Response response;
+        response.noContent = true;
+
+        try {
+            auto connection = acquire(path);
+            {
+                mapbox::sqlite::Query query(*connection->tileStatement);
+                query.bind(1, static_cast<int32_t>(tile.z));
+                query.bind(2, static_cast<int32_t>(tile.x));
+                query.bind(3, row);
+                if (query.run()) {
+                    if (auto data = query.get<std::optional<std::string>>(0)) {
+                        response.data = util::is_compressed(*data)
+                                            ? std::make_shared<std::string>(util::decompress(*data))
+                                            : std::make_shared<std::string>(std::move(*data));
+                        response.noContent = false;
+                        response.expires = Timestamp::max();
+                        response.etag = resource.url;
+                    }
+                }
+            }
+            release(path, std::move(connection));
+        } catch (const mapbox::sqlite::Exception &ex) {
+            response.error = std::make_unique<Response::Error>(Response::Error::Reason::Other, ex.what());
+        }
+
+        req.invoke(&FileSourceRequest::setResponse, response);
+    }
+
+private:
+    static constexpr std::size_t maxIdleConnections = 4;
+    static constexpr std::size_t mmapSize = 256 * 1024 * 1024;
+
+    std::mutex mutex;
+    std::map<std::string, std::vector<std::unique_ptr<Connection>>> idle;
+};
+
 class MBTilesFileSource::Impl {
 public:
     explicit Impl(const ActorRef<Impl> &, const ResourceOptions &resourceOptions_, const ClientOptions &clientOptions_)
@@ -70,8 +161,6 @@ public:
         return std::string(buffer.GetString(), buffer.GetSize());
     }
 
-    std::string db_path(const std::string &path) { return path.substr(0, path.find('?')); }
-
     // Generate a tilejson resource from .mbtiles file
     void request_tilejson(const Resource &resource, ActorRef<FileSourceRequest> req) {
         const auto path = url_to_path(resource.url);
@@ -186,42 +275,6 @@ public:
         req.invoke(&FileSourceRequest::setResponse, response);
     }
 
-    // Load data for specific tile
-    void request_tile(const Resource &resource, ActorRef<FileSourceRequest> req) {
-        std::string base_path = url_to_path(resource.url);
-        std::string path = db_path(base_path);
-        auto &db = get_db(path);
-
-        int iy = resource.tileData->y;
-        int iz = resource.tileData->z;
-
-        auto x = std::to_string(resource.tileData->x);
-        auto y = std::to_string((int)(pow(2, iz) - 1) - iy);
-        auto z = std::to_string(iz);
-
-        std::string sql = "SELECT tile_data FROM tiles where zoom_level = " + z + " AND tile_column = " + x +
-                          " AND tile_row = " + y;
-        mapbox::sqlite::Statement stmt(db, sql.c_str());
-
-        Response response;
-        response.noContent = true;
-
-        for (mapbox::sqlite::Query q(stmt); q.run();) {
-            std::optional<std::string> data = q.get<std::optional<std::string>>(0);
-            if (data) {
-                response.data = std::make_shared<std::string>(*data);
-                response.noContent = false;
-                response.expires = Timestamp::max();
-                response.etag = resource.url;
-
-                if (util::is_compressed(*response.data)) {
-                    response.data = std::make_shared<std::string>(util::decompress(*response.data));
-                }
-            }
-        }
-        req.invoke(&FileSourceRequest::setResponse, response);
-    }
-
     void setResourceOptions(ResourceOptions options) {
         std::scoped_lock lock(resourceOptionsMutex);
         resourceOptions = options;
@@ -243,29 +296,6 @@ public:
     }
 
 private:
-    std::map<std::string, mapbox::sqlite::Database> db_cache;
-
-    void close_db(const std::string &path) {
-        auto ptr = db_cache.find(path);
-        if (ptr != db_cache.end()) {
-            db_cache.erase(path);
-        }
-    }
-
-    void close_all() { db_cache.clear(); }
-
-    // Multiple databases open simultaneously, to effectively support multiple .mbtiles maps
-    mapbox::sqlite::Database &get_db(const std::string &path) {
-        auto ptr = db_cache.find(path);
-        if (ptr != db_cache.end()) {
-            return ptr->second;
-        };
-
-        auto ptr2 = db_cache.insert(std::pair<std::string, mapbox::sqlite::Database>(
-            path, mapbox::sqlite::Database::open(path, mapbox::sqlite::ReadOnly)));
-        return ptr2.first->second;
-    }
-
     mutable std::mutex resourceOptionsMutex;
     mutable std::mutex clientOptionsMutex;
     ResourceOptions resourceOptions;
@@ -277,14 +307,16 @@ MBTilesFileSource::MBTilesFileSource(const ResourceOptions &resourceOptions, con
           util::makeThreadPrioritySetter(platform::EXPERIMENTAL_THREAD_PRIORITY_FILE),
           "MBTilesFileSource",
           resourceOptions.clone(),
-          clientOptions.clone())) {}
+          clientOptions.clone())),
+      pool(std::make_shared<ConnectionPool>()) {}
 
 std::unique_ptr<AsyncRequest> MBTilesFileSource::request(const Resource &resource, FileSource::Callback callback) {
     auto req = std::make_unique<FileSourceRequest>(std::move(callback));
 
     // assume if there is a tile request, that the mbtiles file has been validated
     if (resource.kind == Resource::Tile) {
-        thread->actor().invoke(&Impl::request_tile, resource, req->actor());
+        Scheduler::GetBackground()->schedule(
+            [pool_ = pool, resource, ref = req->actor()] { pool_->request_tile(resource, ref); });
         return req;
     }
 
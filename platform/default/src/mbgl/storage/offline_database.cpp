@@ -11,11 +11,519 @@
 #include <mbgl/storage/offline_schema.hpp>
 #include <mbgl/storage/merge_sideloaded.hpp>
 
+#include <array>
+#include <limits>
+#include <string_view>
+#include <tuple>
+
+#if MLN_WITH_ZSTD
+#include <zdict.h>
+#include <zstd.h>
+#endif
+
 namespace mbgl {
 
+namespace {
+
+// Cache-grade ambient cache writes are committed after this many puts at the
+// latest; the database file source commits them sooner once writes go idle.
+constexpr std::size_t maxAmbientBatchWrites = 64;
+
+// Values of the `compressed` column of tiles
+enum class TileCompression : int32_t {
+    Uncompressed = 0,
+    Deflate = 1,
+    ZstdDictionary = 2,
+};
+
+// Tile payloads at least this large are stored once in `tile_blobs` and shared
+// by the tiles with identical payloads. Smaller ones stay inline, where they
+// take less room than the reference and the hash index entry.
+constexpr std::size_t minSharedTileSize = 64;
+
+// Side database tiles copied per statement when merging, and the page cache
+// size (in KiB) used meanwhile for the many index pages a bulk copy touches
+constexpr int64_t mergeTileBatchSize = 1024;
+constexpr int64_t mergeCacheSizeKiB = 64 * 1024;
+
+// Tiles read per zoom level to estimate the mean tile size of a source
+constexpr int64_t meanTileSizeSamples = 256;
+
+// IDs of a table added up per step of the ambient cache sizing, a range scan
+// of the primary key short enough for requests not to wait on it
+constexpr int64_t ambientCacheSizingChunk = 4096;
+
+// The largest ID of each table the ambient cache sizing walks, and the size of
+// its ambient rows whose IDs are in (?1, ?2]
+struct AmbientCacheTable {
+    const char* maxID;
+    const char* size;
+};
+
+// clang-format off
+constexpr std::array<AmbientCacheTable, 3> ambientCacheTables{{
+    {"SELECT IFNULL(MAX(id), 0) FROM tiles",
+     "SELECT IFNULL(SUM(IFNULL(LENGTH(data), 0) "
+     "                  + IFNULL(LENGTH(id), 0) "
+     "                  + IFNULL(LENGTH(url_template), 0) "
+     "                  + IFNULL(LENGTH(pixel_ratio), 0) "
+     "                  + IFNULL(LENGTH(x), 0) "
+     "                  + IFNULL(LENGTH(y), 0) "
+     "                  + IFNULL(LENGTH(z), 0) "
+     "                  + IFNULL(LENGTH(expires), 0) "
+     "                  + IFNULL(LENGTH(modified), 0) "
+     "                  + IFNULL(LENGTH(etag), 0) "
+     "                  + IFNULL(LENGTH(compressed), 0) "
+     "                  + IFNULL(LENGTH(accessed), 0) "
+     "                  + IFNULL(LENGTH(must_revalidate), 0) "
+     "                  + IFNULL(LENGTH(blob_id), 0)), 0) "
+     "FROM tiles "
+     "LEFT JOIN region_tiles "
+     "ON tile_id = tiles.id "
+     "WHERE tile_id IS NULL AND tiles.id > ?1 AND tiles.id <= ?2"},
+    // Shared payloads of ambient tiles that no region tile uses
+    {"SELECT IFNULL(MAX(id), 0) FROM tile_blobs",
+     "SELECT IFNULL(SUM(LENGTH(data) + LENGTH(id) + LENGTH(hash)), 0) "
+     "FROM tile_blobs "
+     "WHERE id > ?1 AND id <= ?2 AND NOT EXISTS ( "
+     "  SELECT 1 FROM tiles "
+     "  JOIN region_tiles ON tile_id = tiles.id "
+     "  WHERE blob_id = tile_blobs.id)"},
+    {"SELECT IFNULL(MAX(id), 0) FROM resources",
+     "SELECT IFNULL(SUM(IFNULL(LENGTH(data), 0) "
+     "                  + IFNULL(LENGTH(id), 0) "
+     "                  + IFNULL(LENGTH(url), 0) "
+     "                  + IFNULL(LENGTH(kind), 0) "
+     "                  + IFNULL(LENGTH(expires), 0) "
+     "                  + IFNULL(LENGTH(modified), 0) "
+     "                  + IFNULL(LENGTH(etag), 0) "
+     "                  + IFNULL(LENGTH(compressed), 0) "
+     "                  + IFNULL(LENGTH(accessed), 0) "
+     "                  + IFNULL(LENGTH(must_revalidate), 0)), 0) "
+     "FROM resources "
+     "LEFT JOIN region_resources "
+     "ON resource_id = resources.id "
+     "WHERE resource_id IS NULL AND resources.id > ?1 AND resources.id <= ?2"},
+}};
+// clang-format on
+
+// 64-bit FNV-1a, stored in the database so it must not depend on the platform
+int64_t tileBlobHash(const std::string& data) {
+    uint64_t hash = 14695981039346656037u;
+    for (const char c : data) {
+        hash = (hash ^ static_cast<uint8_t>(c)) * 1099511628211u;
+    }
+    return static_cast<int64_t>(hash);
+}
+
+uint32_t readLittleEndian(const std::string& data, std::size_t offset, std::size_t size) {
+    uint32_t value = 0;
+    for (std::size_t i = 0; i < size; ++i) {
+        value |= static_cast<uint32_t>(static_cast<uint8_t>(data[offset + i])) << (8 * i);
+    }
+    return value;
+}
+
+void writeLittleEndian(std::string& data, std::size_t offset, std::size_t size, uint32_t value) {
+    for (std::size_t i = 0; i < size; ++i) {
+        data[offset + i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+    }
+}
+
+// Bytes taken by a zstd dictionary ID in frame headers, which write it as small as it fits
+std::size_t dictionaryIDSize(uint32_t id) {
+    return id < 256 ? 1 : (id < 65536 ? 2 : 4);
+}
+
+// Sets the ID recorded in the header of a zstd dictionary, which compressed frames copy
+void setDictionaryID(std::string& dictionary, uint32_t id) {
+    constexpr uint32_t dictionaryMagic = 0xEC30A437;
+    if (dictionary.size() < 8 || readLittleEndian(dictionary, 0, 4) != dictionaryMagic) {
+        throw std::runtime_error("invalid tile compression dictionary");
+    }
+    writeLittleEndian(dictionary, 4, 4, id);
+}
+
+// Rewrites the dictionary ID in the header of a zstd frame if it's `from`, returning
+// whether it was. `to` must take as many bytes as `from`.
+bool renumberFrameDictionary(std::string& frame, uint32_t from, uint32_t to) {
+    constexpr uint32_t frameMagic = 0xFD2FB528;
+    if (frame.size() < 6 || readLittleEndian(frame, 0, 4) != frameMagic) {
+        return false;
+    }
+    const auto descriptor = static_cast<uint8_t>(frame[4]);
+    const std::size_t idSize = std::array<std::size_t, 4>{0, 1, 2, 4}[descriptor & 0x3];
+    // The window descriptor precedes the ID unless the frame is a single segment
+    const std::size_t idOffset = (descriptor & 0x20) ? 5 : 6;
+    if (idSize == 0 || frame.size() < idOffset + idSize || readLittleEndian(frame, idOffset, idSize) != from) {
+        return false;
+    }
+    assert(dictionaryIDSize(to) == idSize);
+    writeLittleEndian(frame, idOffset, idSize, to);
+    return true;
+}
+
+} // namespace
+
+// Compresses tiles with zstd and a dictionary trained from the first tiles
+// written once enabled. Dictionaries are stored in the database, tiles find
+// theirs by the dictionary ID recorded in their zstd frames.
+class OfflineDatabase::TileCompressor {
+public:
+    void setEnabled(bool enabled_) { enabled = enabled_; }
+
+    // Forget the dictionaries of the previous database file
+    void reset() {
+#if MLN_WITH_ZSTD
+        cdict.reset();
+        ddicts.clear();
+#endif
+        samples.clear();
+        sampleBytes = 0;
+        loaded = false;
+        trainingFailed = false;
+    }
+
+    // The zstd frame of a tile, or nothing while the dictionary is still being
+    // trained or if zstd compression isn't enabled
+    std::optional<std::string> compress([[maybe_unused]] OfflineDatabase& offlineDb,
+                                        [[maybe_unused]] const std::string& data) {
+#if MLN_WITH_ZSTD
+        if (!enabled) {
+            return std::nullopt;
+        }
+        if (!loaded) {
+            loadLatestDictionary(offlineDb);
+        }
+        if (!cdict) {
+            if (!trainingFailed && sampleBytes < trainingSampleBytes && data.size() <= maxSampleSize) {
+                samples.push_back(data);
+                sampleBytes += data.size();
+            }
+            return std::nullopt;
+        }
+
+        if (!cctx) {
+            cctx = {ZSTD_createCCtx(), &ZSTD_freeCCtx};
+        }
+        std::string result(ZSTD_compressBound(data.size()), '\0');
+        const auto size = ZSTD_compress_usingCDict(
+            cctx.get(), result.data(), result.size(), data.data(), data.size(), cdict.get());
+        if (ZSTD_isError(size)) {
+            return std::nullopt;
+        }
+        result.resize(size);
+        return result;
+#else
+        return std::nullopt;
+#endif
+    }
+
+    bool readyToTrain() const { return !trainingFailed && sampleBytes >= trainingSampleBytes; }
+
+    // Trains a dictionary from the sampled tiles and stores it, outside of
+    // any transaction so that it's never rolled back with the tiles using it
+    void train([[maybe_unused]] OfflineDatabase& offlineDb) {
+#if MLN_WITH_ZSTD
+        std::string buffer;
+        buffer.reserve(sampleBytes);
+        std::vector<std::size_t> sizes;
+        for (const auto& sample : samples) {
+            buffer += sample;
+            sizes.push_back(sample.size());
+        }
+        samples.clear();
+        sampleBytes = 0;
+
+        std::string dictionary(maxDictionarySize, '\0');
+        const auto size = ZDICT_trainFromBuffer(
+            dictionary.data(), dictionary.size(), buffer.data(), sizes.data(), static_cast<unsigned>(sizes.size()));
+        if (ZDICT_isError(size)) {
+            Log::Warning(Event::Database,
+                         std::string("Can't train the tile compression dictionary: ") + ZDICT_getErrorName(size));
+            trainingFailed = true;
+            return;
+        }
+        dictionary.resize(size);
+        auto id = ZDICT_getDictID(dictionary.data(), dictionary.size());
+
+        // The ID is a hash of the dictionary, tiles must not find another dictionary by it
+        {
+            // clang-format off
+            mapbox::sqlite::Query query{ offlineDb.getStatement(
+                "SELECT dictionary FROM compression_dictionaries WHERE id = ?1") };
+            // clang-format on
+            query.bind(1, static_cast<int64_t>(id));
+            if (query.run() && query.get<std::string>(0) != dictionary) {
+                query.reset();
+                id = freeDictionaryID(offlineDb, id, false);
+                setDictionaryID(dictionary, id);
+            }
+        }
+
+        // clang-format off
+        mapbox::sqlite::Query query{ offlineDb.getStatement(
+            "INSERT OR REPLACE INTO compression_dictionaries (id, dictionary, created) "
+            "VALUES (?1, ?2, ?3)") };
+        // clang-format on
+        query.bind(1, static_cast<int64_t>(id));
+        query.bindBlob(2, dictionary.data(), dictionary.size(), false);
+        query.bind(3, util::now());
+        query.run();
+
+        use(id, dictionary);
+#endif
+    }
+
+    // Gives the dictionaries of this database that the attached side database has
+    // different ones for under the same ID a new ID, along with the tiles using
+    // them, so that the merged tiles find their own dictionaries
+    void renumberMergeCollisions(OfflineDatabase& offlineDb) {
+        std::vector<uint32_t> ids;
+        {
+            // clang-format off
+            mapbox::sqlite::Query query{ offlineDb.getStatement(
+                "SELECT d.id FROM compression_dictionaries d "
+                "JOIN side.compression_dictionaries sd ON sd.id = d.id "
+                "WHERE sd.dictionary != d.dictionary") };
+            // clang-format on
+            while (query.run()) {
+                ids.push_back(static_cast<uint32_t>(query.get<int64_t>(0)));
+            }
+        }
+        for (const auto id : ids) {
+            renumber(offlineDb, id, freeDictionaryID(offlineDb, id, true));
+        }
+    }
+
+    // Throws `std::runtime_error` if the tile can't be decompressed
+    std::string decompress([[maybe_unused]] OfflineDatabase& offlineDb, [[maybe_unused]] const std::string& data) {
+#if MLN_WITH_ZSTD
+        const auto id = ZSTD_getDictID_fromFrame(data.data(), data.size());
+        auto it = ddicts.find(id);
+        if (it == ddicts.end()) {
+            // clang-format off
+            mapbox::sqlite::Query query{ offlineDb.getStatement(
+                "SELECT dictionary FROM compression_dictionaries WHERE id = ?1") };
+            // clang-format on
+            query.bind(1, static_cast<int64_t>(id));
+            if (!query.run()) {
+                throw std::runtime_error("missing tile compression dictionary " + std::to_string(id));
+            }
+            const auto dictionary = query.get<std::string>(0);
+            it = ddicts.emplace(id, DDict{ZSTD_createDDict(dictionary.data(), dictionary.size()), &ZSTD_freeDDict})
+                     .first;
+        }
+
+        const auto contentSize = ZSTD_getFrameContentSize(data.data(), data.size());
+        if (contentSize == ZSTD_CONTENTSIZE_ERROR || contentSize == ZSTD_CONTENTSIZE_UNKNOWN) {
+            throw std::runtime_error("invalid zstd tile");
+        }
+        if (!dctx) {
+            dctx = {ZSTD_createDCtx(), &ZSTD_freeDCtx};
+        }
+        std::string result(contentSize, '\0');
+        const auto size = ZSTD_decompress_usingDDict(
+            dctx.get(), result.data(), result.size(), data.data(), data.size(), it->second.get());
+        if (ZSTD_isError(size)) {
+            throw std::runtime_error(ZSTD_getErrorName(size));
+        }
+        result.resize(size);
+        return result;
+#else
+        throw std::runtime_error("zstd-compressed tiles aren't supported by this build");
+#endif
+    }
+
+private:
+    // An ID that no dictionary of the database, or of the side database when merging,
+    // has. It takes as many bytes in frame headers as `id`, so frames can be renumbered in place.
+    static uint32_t freeDictionaryID(OfflineDatabase& offlineDb, uint32_t id, bool merging) {
+        const auto size = dictionaryIDSize(id);
+        const uint32_t first = size == 1 ? 1 : (size == 2 ? 256 : 65536);
+        const uint32_t end = size == 1 ? 256 : (size == 2 ? 65536 : 1u << 31);
+        // clang-format off
+        mapbox::sqlite::Query query{ offlineDb.getStatement(merging
+            ? "SELECT EXISTS (SELECT 1 FROM compression_dictionaries WHERE id = ?1) "
+              "    OR EXISTS (SELECT 1 FROM side.compression_dictionaries WHERE id = ?1)"
+            : "SELECT EXISTS (SELECT 1 FROM compression_dictionaries WHERE id = ?1)") };
+        // clang-format on
+        for (uint32_t candidate = id + 1;; ++candidate) {
+            if (candidate >= end) {
+                candidate = first;
+            }
+            if (candidate == id) {
+                throw std::runtime_error("no free tile compression dictionary ID");
+            }
+            query.bind(1, static_cast<int64_t>(candidate));
+            query.run();
+            const bool used = query.get<int64_t>(0) != 0;
+            query.reset();
+            if (!used) {
+                return candidate;
+            }
+        }
+    }
+
+    // Moves a dictionary to a new ID, rewriting the frame headers of the tiles compressed with it
+    void renumber(OfflineDatabase& offlineDb, uint32_t id, uint32_t newID) {
+        {
+            // clang-format off
+            mapbox::sqlite::Query query{ offlineDb.getStatement(
+                "SELECT dictionary FROM compression_dictionaries WHERE id = ?1") };
+            // clang-format on
+            query.bind(1, static_cast<int64_t>(id));
+            if (!query.run()) {
+                return;
+            }
+            auto dictionary = query.get<std::string>(0);
+            query.reset();
+            setDictionaryID(dictionary, newID);
+
+            // clang-format off
+            mapbox::sqlite::Query update{ offlineDb.getStatement(
+                "UPDATE compression_dictionaries SET id = ?1, dictionary = ?2 WHERE id = ?3") };
+            // clang-format on
+            update.bind(1, static_cast<int64_t>(newID));
+            update.bindBlob(2, dictionary.data(), dictionary.size(), false);
+            update.bind(3, static_cast<int64_t>(id));
+            update.run();
+        }
+
+        // Collected first, rather than updating the rows being read
+        std::vector<std::pair<int64_t, std::string>> tiles;
+        std::vector<std::pair<int64_t, std::string>> blobs;
+        {
+            // clang-format off
+            mapbox::sqlite::Query query{ offlineDb.getStatement(
+                "SELECT id, data FROM tiles WHERE compressed = ?1 AND data IS NOT NULL") };
+            // clang-format on
+            query.bind(1, static_cast<int>(TileCompression::ZstdDictionary));
+            while (query.run()) {
+                auto data = query.get<std::string>(1);
+                if (renumberFrameDictionary(data, id, newID)) {
+                    tiles.emplace_back(query.get<int64_t>(0), std::move(data));
+                }
+            }
+        }
+        {
+            // clang-format off
+            mapbox::sqlite::Query query{ offlineDb.getStatement(
+                "SELECT id, data FROM tile_blobs "
+                "WHERE id IN (SELECT blob_id FROM tiles WHERE compressed = ?1)") };
+            // clang-format on
+            query.bind(1, static_cast<int>(TileCompression::ZstdDictionary));
+            while (query.run()) {
+                auto data = query.get<std::string>(1);
+                if (renumberFrameDictionary(data, id, newID)) {
+                    blobs.emplace_back(query.get<int64_t>(0), std::move(data));
+                }
+            }
+        }
+
+        mapbox::sqlite::Query updateTile{offlineDb.getStatement("UPDATE tiles SET data = ?1 WHERE id = ?2")};
+        for (const auto& [tileID, data] : tiles) {
+            updateTile.bindBlob(1, data.data(), data.size(), false);
+            updateTile.bind(2, tileID);
+            updateTile.run();
+            updateTile.reset();
+        }
+        mapbox::sqlite::Query updateBlob{
+            offlineDb.getStatement("UPDATE tile_blobs SET hash = ?1, data = ?2 WHERE id = ?3")};
+        for (const auto& [blobID, data] : blobs) {
+            updateBlob.bind(1, tileBlobHash(data));
+            updateBlob.bindBlob(2, data.data(), data.size(), false);
+            updateBlob.bind(3, blobID);
+            updateBlob.run();
+            updateBlob.reset();
+        }
+
+        // The cached dictionaries still carry the old ID
+#if MLN_WITH_ZSTD
+        cdict.reset();
+        ddicts.clear();
+#endif
+        loaded = false;
+    }
+
+#if MLN_WITH_ZSTD
+    void loadLatestDictionary(OfflineDatabase& offlineDb) {
+        loaded = true;
+        // clang-format off
+        mapbox::sqlite::Query query{ offlineDb.getStatement(
+            "SELECT id, dictionary FROM compression_dictionaries ORDER BY created DESC LIMIT 1") };
+        // clang-format on
+        if (query.run()) {
+            use(static_cast<unsigned>(query.get<int64_t>(0)), query.get<std::string>(1));
+        }
+    }
+
+    void use(unsigned id, const std::string& dictionary) {
+        cdict = {ZSTD_createCDict(dictionary.data(), dictionary.size(), compressionLevel), &ZSTD_freeCDict};
+        ddicts.insert_or_assign(id, DDict{ZSTD_createDDict(dictionary.data(), dictionary.size()), &ZSTD_freeDDict});
+    }
+
+    using DDict = std::unique_ptr<ZSTD_DDict, decltype(&ZSTD_freeDDict)>;
+
+    std::unique_ptr<ZSTD_CDict, decltype(&ZSTD_freeCDict)> cdict{nullptr, &ZSTD_freeCDict};
+    std::map<unsigned, DDict> ddicts;
+    std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)> cctx{nullptr, &ZSTD_freeCCtx};
+    std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)> dctx{nullptr, &ZSTD_freeDCtx};
+#endif
+
+    static constexpr int compressionLevel = 3;
+    // zstd's default dictionary size, trained from about 40 times as much data
+    static constexpr std::size_t maxDictionarySize = 110 * 1024;
+    static constexpr std::size_t trainingSampleBytes = 4 * 1024 * 1024;
+    static constexpr std::size_t maxSampleSize = 256 * 1024;
+
+    bool enabled = false;
+    bool loaded = false;
+    bool trainingFailed = false;
+    std::vector<std::string> samples;
+    std::size_t sampleBytes = 0;
+};
+
+// Offline regions keep the default durability profile regardless of how the
+// ambient cache is written: batched ambient cache writes are committed before
+// the region write, and in the cache-grade profile the database is fully
+// synced while the region write is in scope.
+class OfflineDatabase::RegionWrite {
+public:
+    explicit RegionWrite(OfflineDatabase& offlineDb_)
+        : offlineDb(offlineDb_) {
+        offlineDb.commitAmbientWrites();
+        if (offlineDb.cacheGradeDurability && !offlineDb.readOnly) {
+            if (!offlineDb.db) {
+                offlineDb.initialize();
+            }
+            offlineDb.db->exec("PRAGMA synchronous = FULL");
+            fullSync = true;
+        }
+    }
+
+    ~RegionWrite() {
+        if (fullSync && offlineDb.db) {
+            try {
+                offlineDb.db->exec("PRAGMA synchronous = NORMAL");
+            } catch (...) {
+                offlineDb.handleError("restore synchronous mode");
+            }
+        }
+    }
+
+    RegionWrite(const RegionWrite&) = delete;
+    RegionWrite& operator=(const RegionWrite&) = delete;
+
+private:
+    OfflineDatabase& offlineDb;
+    bool fullSync = false;
+};
+
 OfflineDatabase::OfflineDatabase(std::string path_, const TileServerOptions& options)
     : path(std::move(path_)),
-      tileServerOptions(options) {
+      tileServerOptions(options),
+      tileCompressor(std::make_unique<TileCompressor>()) {
     try {
         initialize();
     } catch (...) {
@@ -53,7 +561,7 @@ void OfflineDatabase::initialize() {
             // Newly created database, or old cache-only database; remove old table if it exists.
             removeOldCacheTable();
             createSchema();
-            return;
+            break;
         case 2:
             migrateToVersion3();
             // fall through
@@ -67,12 +575,31 @@ void OfflineDatabase::initialize() {
             migrateToVersion6();
             // fall through
         case 6:
+            migrateToVersion7();
+            // fall through
+        case 7:
+            migrateToVersion8();
+            // fall through
+        case 8:
+            migrateToVersion9();
+            // fall through
+        case 9:
+            migrateToVersion10();
+            // fall through
+        case 10:
             // Happy path; we're done
-            return;
+            break;
         default:
             // Downgrade: delete the database and try to reinitialize.
             removeExisting();
             initialize();
+            return;
+    }
+
+    // The default profile leaves the database as it is, so that opening it
+    // doesn't need to touch more than the user version
+    if (cacheGradeDurability) {
+        applyDurability();
     }
 }
 
@@ -84,6 +611,10 @@ void OfflineDatabase::changePath(const std::string& path_) {
 }
 
 void OfflineDatabase::cleanup() {
+    commitAmbientWrites();
+    storeAmbientCacheSize();
+    tileCompressor->reset();
+
     // Deleting these SQLite objects may result in exceptions
     try {
         statements.clear();
@@ -91,6 +622,9 @@ void OfflineDatabase::cleanup() {
     } catch (...) {
         handleError("close database");
     }
+
+    currentAmbientCacheSize = std::nullopt;
+    ambientCacheSizing = std::nullopt;
 }
 
 bool OfflineDatabase::disabled() {
@@ -150,8 +684,12 @@ void OfflineDatabase::handleError(const char* action) {
 void OfflineDatabase::removeExisting() {
     Log::Warning(Event::Database, "Removing existing incompatible offline database");
 
+    discardAmbientBatch();
+    tileCompressor->reset();
     statements.clear();
     db.reset();
+    currentAmbientCacheSize = std::nullopt;
+    ambientCacheSizing = std::nullopt;
 
     util::deleteFile(path);
 }
@@ -173,8 +711,10 @@ void OfflineDatabase::createSchema() {
     db->exec("PRAGMA synchronous = FULL");
     mapbox::sqlite::Transaction transaction(*db);
     db->exec(offlineDatabaseSchema);
-    db->exec("PRAGMA user_version = 6");
+    db->exec("PRAGMA user_version = 10");
     transaction.commit();
+
+    currentAmbientCacheSize = 0u;
 }
 
 void OfflineDatabase::migrateToVersion3() {
@@ -215,10 +755,90 @@ void OfflineDatabase::migrateToVersion6() {
     transaction.commit();
 }
 
+void OfflineDatabase::migrateToVersion7() {
+    assert(db);
+    checkFlags();
+
+    mapbox::sqlite::Transaction transaction(*db);
+    db->exec(
+        "CREATE TABLE compression_dictionaries ("
+        "  id INTEGER NOT NULL PRIMARY KEY,"
+        "  dictionary BLOB NOT NULL,"
+        "  created INTEGER NOT NULL)");
+    db->exec("PRAGMA user_version = 7");
+    transaction.commit();
+}
+
+void OfflineDatabase::migrateToVersion8() {
+    assert(db);
+    checkFlags();
+
+    // Existing tiles keep their payloads inline, only new writes are shared
+    mapbox::sqlite::Transaction transaction(*db);
+    db->exec(
+        "CREATE TABLE tile_blobs ("
+        "  id INTEGER NOT NULL PRIMARY KEY AUTOINCREMENT,"
+        "  hash INTEGER NOT NULL,"
+        "  data BLOB NOT NULL)");
+    db->exec("ALTER TABLE tiles ADD COLUMN blob_id INTEGER REFERENCES tile_blobs(id)");
+    db->exec("CREATE INDEX tile_blobs_hash ON tile_blobs (hash)");
+    db->exec("CREATE INDEX tiles_blob_id ON tiles (blob_id)");
+    db->exec(
+        "CREATE TRIGGER tiles_delete_blob "
+        "AFTER DELETE ON tiles "
+        "WHEN OLD.blob_id IS NOT NULL AND NOT EXISTS (SELECT 1 FROM tiles WHERE blob_id = OLD.blob_id) "
+        "BEGIN "
+        "  DELETE FROM tile_blobs WHERE id = OLD.blob_id; "
+        "END");
+    db->exec(
+        "CREATE TRIGGER tiles_update_blob "
+        "AFTER UPDATE OF blob_id ON tiles "
+        "WHEN OLD.blob_id IS NOT NULL AND OLD.blob_id IS NOT NEW.blob_id "
+        "  AND NOT EXISTS (SELECT 1 FROM tiles WHERE blob_id = OLD.blob_id) "
+        "BEGIN "
+        "  DELETE FROM tile_blobs WHERE id = OLD.blob_id; "
+        "END");
+    db->exec("PRAGMA user_version = 8");
+    transaction.commit();
+}
+
+void OfflineDatabase::migrateToVersion9() {
+    assert(db);
+    checkFlags();
+
+    // The ambient cache size is added up once more, and stored from then on
+    mapbox::sqlite::Transaction transaction(*db);
+    db->exec(
+        "CREATE TABLE ambient_cache_size ("
+        "  id INTEGER NOT NULL PRIMARY KEY CHECK (id = 1),"
+        "  size INTEGER,"
+        "  page_count INTEGER NOT NULL,"
+        "  freelist_count INTEGER NOT NULL)");
+    db->exec("PRAGMA user_version = 9");
+    transaction.commit();
+}
+
+void OfflineDatabase::migrateToVersion10() {
+    assert(db);
+    checkFlags();
+
+    mapbox::sqlite::Transaction transaction(*db);
+    db->exec(
+        "CREATE TABLE tile_layouts ("
+        "  tile_id INTEGER NOT NULL PRIMARY KEY REFERENCES tiles(id) ON DELETE CASCADE,"
+        "  data_hash INTEGER NOT NULL,"
+        "  layout BLOB NOT NULL)");
+    db->exec("PRAGMA user_version = 10");
+    transaction.commit();
+}
+
 void OfflineDatabase::vacuum() {
     assert(db);
     checkFlags();
 
+    // VACUUM can't run inside a transaction
+    commitAmbientBatch();
+
     if (getPragma<int64_t>("PRAGMA auto_vacuum") != 2 /*INCREMENTAL*/) {
         db->exec("PRAGMA auto_vacuum = INCREMENTAL");
         db->exec("VACUUM");
@@ -233,6 +853,85 @@ void OfflineDatabase::checkFlags() {
     }
 }
 
+void OfflineDatabase::applyDurability() {
+    assert(db);
+    if (readOnly) return;
+
+    // The journal mode is stored in the database file, so it also applies to
+    // the offline regions sharing it; region writes are synced by RegionWrite.
+    if (cacheGradeDurability) {
+        db->exec("PRAGMA journal_mode = WAL");
+        db->exec("PRAGMA synchronous = NORMAL");
+    } else if (getPragma<std::string>("PRAGMA journal_mode") == "wal") {
+        db->exec("PRAGMA journal_mode = DELETE");
+        db->exec("PRAGMA synchronous = FULL");
+    }
+}
+
+void OfflineDatabase::setCacheGradeDurability(bool enable) try {
+    commitAmbientBatch();
+    cacheGradeDurability = enable;
+    if (db) {
+        applyDurability();
+    }
+} catch (...) {
+    handleError("change durability");
+}
+
+void OfflineDatabase::setZstdTileCompression(bool enable) {
+#if !MLN_WITH_ZSTD
+    if (enable) {
+        Log::Warning(Event::Database, "zstd tile compression isn't supported by this build");
+    }
+#endif
+    tileCompressor->setEnabled(enable);
+}
+
+void OfflineDatabase::trainTileCompression() {
+    if (tileCompressor->readyToTrain()) {
+        commitAmbientBatch();
+        tileCompressor->train(*this);
+    }
+}
+
+void OfflineDatabase::commitAmbientWrites() try {
+    commitAmbientBatch();
+} catch (...) {
+    handleError("commit ambient cache writes");
+}
+
+void OfflineDatabase::commitAmbientBatch() {
+    if (!ambientBatch) return;
+
+    try {
+        ambientBatch->commit();
+    } catch (...) {
+        // A failed COMMIT may leave the transaction open
+        try {
+            ambientBatch->rollback();
+        } catch (...) {
+            [[maybe_unused]] auto eptr = std::current_exception();
+        }
+        discardAmbientBatch();
+        throw;
+    }
+
+    ambientBatch.reset();
+    ambientBatchWrites = 0;
+}
+
+void OfflineDatabase::discardAmbientBatch() {
+    if (!ambientBatch) return;
+
+    // Rolls back the transaction, if it's still open
+    ambientBatch.reset();
+    ambientBatchWrites = 0;
+
+    // The ambient cache size has already counted the rolled back writes
+    currentAmbientCacheSize = std::nullopt;
+    ambientCacheSizing = std::nullopt;
+}
+
 mapbox::sqlite::Statement& OfflineDatabase::getStatement(const char* sql) {
     if (!db) {
         initialize();
@@ -256,6 +955,40 @@ std::optional<Response> OfflineDatabase::get(const Resource& resource) try {
     return std::nullopt;
 }
 
+void OfflineDatabase::putTileLayout(const Resource& resource,
+                                    const std::string& data,
+                                    const std::string& layout) try {
+    if (readOnly || !db || disabled() || resource.kind != Resource::Kind::Tile) {
+        return;
+    }
+    assert(resource.tileData);
+    const auto& tile = *resource.tileData;
+
+    // clang-format off
+    mapbox::sqlite::Query query{ getStatement(
+        "INSERT OR REPLACE INTO tile_layouts (tile_id, data_hash, layout) "
+        "SELECT id, ?6, ?7 "
+        "FROM tiles "
+        "WHERE url_template = ?1 "
+        "  AND pixel_ratio  = ?2 "
+        "  AND x            = ?3 "
+        "  AND y            = ?4 "
+        "  AND z            = ?5 "
+        "  AND EXISTS (SELECT 1 FROM region_tiles WHERE tile_id = tiles.id)") };
+    // clang-format on
+
+    query.bind(1, tile.urlTemplate);
+    query.bind(2, tile.pixelRatio);
+    query.bind(3, tile.x);
+    query.bind(4, tile.y);
+    query.bind(5, tile.z);
+    query.bind(6, tileBlobHash(data));
+    query.bindBlob(7, layout.data(), layout.size(), false);
+    query.run();
+} catch (...) {
+    handleError("write tile layout");
+}
+
 std::optional<std::pair<Response, uint64_t>> OfflineDatabase::getInternal(const Resource& resource) {
     if (resource.kind == Resource::Kind::Tile) {
         assert(resource.tileData);
@@ -274,6 +1007,34 @@ std::optional<int64_t> OfflineDatabase::hasInternal(const Resource& resource) {
     }
 }
 
+template <typename Fn>
+auto OfflineDatabase::writeAmbient(std::size_t writes, Fn&& write) {
+    if (!cacheGradeDurability) {
+        mapbox::sqlite::Transaction transaction(*db, mapbox::sqlite::Transaction::Immediate);
+        auto result = write();
+        transaction.commit();
+        return result;
+    }
+
+    if (!ambientBatch) {
+        ambientBatch = std::make_unique<mapbox::sqlite::Transaction>(*db, mapbox::sqlite::Transaction::Immediate);
+    }
+
+    std::optional<decltype(write())> result;
+    try {
+        result = write();
+    } catch (...) {
+        discardAmbientBatch();
+        throw;
+    }
+
+    ambientBatchWrites += writes;
+    if (ambientBatchWrites >= maxAmbientBatchWrites) {
+        commitAmbientBatch();
+    }
+    return std::move(*result);
+}
+
 std::pair<bool, uint64_t> OfflineDatabase::put(const Resource& resource, const Response& response) try {
     if (readOnly) return {false, 0};
 
@@ -285,15 +1046,39 @@ std::pair<bool, uint64_t> OfflineDatabase::put(const Resource& resource, const R
         return {false, 0};
     }
 
-    mapbox::sqlite::Transaction transaction(*db, mapbox::sqlite::Transaction::Immediate);
-    auto result = putInternal(resource, response, true);
-    transaction.commit();
-    return result;
+    trainTileCompression();
+    return writeAmbient(1, [&] { return putInternal(resource, response, true); });
 } catch (...) {
     handleError("write resource");
     return {false, 0};
 }
 
+std::size_t OfflineDatabase::put(const std::list<std::tuple<Resource, Response>>& resources) try {
+    if (readOnly || resources.empty()) return 0;
+
+    if (!db) {
+        initialize();
+    }
+
+    if (disabled()) {
+        return 0;
+    }
+
+    trainTileCompression();
+    return writeAmbient(resources.size(), [&] {
+        std::size_t inserted = 0;
+        for (const auto& [resource, response] : resources) {
+            if (putInternal(resource, response, true).first) {
+                inserted++;
+            }
+        }
+        return inserted;
+    });
+} catch (...) {
+    handleError("write resources");
+    return 0;
+}
+
 std::pair<bool, uint64_t> OfflineDatabase::putInternal(const Resource& resource,
                                                        const Response& response,
                                                        bool evict_) {
@@ -304,14 +1089,26 @@ std::pair<bool, uint64_t> OfflineDatabase::putInternal(const Resource& resource,
     }
 
     std::string compressedData;
-    bool compressed = false;
+    auto compression = TileCompression::Uncompressed;
     uint64_t size = 0;
 
     if (response.data) {
-        compressedData = util::compress(*response.data);
-        compressed = compressedData.size() < response.data->size();
-        size = compressed ? compressedData.size() : response.data->size();
+        if (resource.kind == Resource::Kind::Tile) {
+            auto zstdData = tileCompressor->compress(*this, *response.data);
+            if (zstdData && zstdData->size() < response.data->size()) {
+                compressedData = std::move(*zstdData);
+                compression = TileCompression::ZstdDictionary;
+            }
+        }
+        if (compression == TileCompression::Uncompressed) {
+            compressedData = util::compress(*response.data);
+            if (compressedData.size() < response.data->size()) {
+                compression = TileCompression::Deflate;
+            }
+        }
+        size = compression != TileCompression::Uncompressed ? compressedData.size() : response.data->size();
     }
+    const bool compressed = compression != TileCompression::Uncompressed;
 
     std::optional<DatabaseSizeChangeStats> stats;
     if (evict_) {
@@ -331,7 +1128,7 @@ std::pair<bool, uint64_t> OfflineDatabase::putInternal(const Resource& resource,
                            compressed      ? compressedData
                            : response.data ? *response.data
                                            : "",
-                           compressed);
+                           static_cast<int32_t>(compression));
     } else {
         inserted = putResource(resource,
                                response,
@@ -535,9 +1332,13 @@ std::optional<std::pair<Response, uint64_t>> OfflineDatabase::getTile(const Reso
 
     // clang-format off
     mapbox::sqlite::Query query{ getStatement(
-        //        0      1           2,            3,      4,      5
-        "SELECT etag, expires, must_revalidate, modified, data, compressed "
+        //        0      1           2,            3,                   4,                    5
+        "SELECT etag, expires, must_revalidate, modified, IFNULL(tiles.data, tile_blobs.data), compressed, "
+        //          6                         7
+        "  tile_layouts.data_hash, tile_layouts.layout "
         "FROM tiles "
+        "LEFT JOIN tile_blobs ON tile_blobs.id = blob_id "
+        "LEFT JOIN tile_layouts ON tile_layouts.tile_id = tiles.id "
         "WHERE url_template = ?1 "
         "  AND pixel_ratio  = ?2 "
         "  AND x            = ?3 "
@@ -555,33 +1356,157 @@ std::optional<std::pair<Response, uint64_t>> OfflineDatabase::getTile(const Reso
         return std::nullopt;
     }
 
+    return readTile(query, 0);
+}
+
+std::pair<Response, uint64_t> OfflineDatabase::readTile(mapbox::sqlite::Query& query, const int column) {
     Response response;
     uint64_t size = 0;
 
-    response.etag = query.get<std::optional<std::string>>(0);
-    response.expires = query.get<std::optional<Timestamp>>(1);
-    response.mustRevalidate = query.get<bool>(2);
-    response.modified = query.get<std::optional<Timestamp>>(3);
+    response.etag = query.get<std::optional<std::string>>(column);
+    response.expires = query.get<std::optional<Timestamp>>(column + 1);
+    response.mustRevalidate = query.get<bool>(column + 2);
+    response.modified = query.get<std::optional<Timestamp>>(column + 3);
 
-    std::optional<std::string> data = query.get<std::optional<std::string>>(4);
+    std::optional<std::string> data = query.get<std::optional<std::string>>(column + 4);
     if (!data) {
         response.noContent = true;
-    } else if (query.get<bool>(5)) {
-        response.data = std::make_shared<std::string>(util::decompress(*data));
-        size = data->length();
     } else {
-        response.data = std::make_shared<std::string>(*data);
         size = data->length();
+        switch (static_cast<TileCompression>(query.get<int>(column + 5))) {
+            case TileCompression::ZstdDictionary:
+                response.data = std::make_shared<std::string>(tileCompressor->decompress(*this, *data));
+                break;
+            case TileCompression::Deflate:
+                response.data = std::make_shared<std::string>(util::decompress(*data));
+                break;
+            default:
+                response.data = std::make_shared<std::string>(std::move(*data));
+                break;
+        }
+    }
+
+    // A layout stored for other data than the tile has now is left to be replaced
+    if (response.data) {
+        const auto dataHash = query.get<std::optional<int64_t>>(column + 6);
+        if (dataHash && *dataHash == tileBlobHash(*response.data)) {
+            response.layout = std::make_shared<std::string>(query.get<std::string>(column + 7));
+        }
     }
 
     return std::make_pair(response, size);
 }
 
+std::vector<std::optional<Response>> OfflineDatabase::getTiles(const std::vector<Resource>& resources) try {
+    std::vector<std::optional<Response>> responses(resources.size());
+    if (disabled()) {
+        return responses;
+    }
+
+    std::map<std::tuple<std::string_view, uint8_t, int8_t>, std::vector<std::size_t>> groups;
+    for (std::size_t i = 0; i < resources.size(); ++i) {
+        assert(resources[i].kind == Resource::Kind::Tile && resources[i].tileData);
+        const auto& tile = *resources[i].tileData;
+        groups[{tile.urlTemplate, tile.pixelRatio, tile.z}].push_back(i);
+    }
+
+    for (const auto& group : groups) {
+        const auto& indices = group.second;
+        for (std::size_t begin = 0; begin < indices.size(); begin += maxBatchedTiles) {
+            const auto end = std::min(begin + maxBatchedTiles, indices.size());
+            getTileBatch(resources, {indices.begin() + begin, indices.begin() + end}, responses);
+        }
+    }
+    return responses;
+} catch (...) {
+    handleError("read resources");
+    return std::vector<std::optional<Response>>(resources.size());
+}
+
+void OfflineDatabase::getTileBatch(const std::vector<Resource>& resources,
+                                   const std::vector<std::size_t>& indices,
+                                   std::vector<std::optional<Response>>& responses) {
+    assert(!indices.empty() && indices.size() <= maxBatchedTiles);
+    const auto& first = *resources[indices.front()].tileData;
+
+    // The x and y columns are matched separately, rows of the other pairs of them are skipped before their data
+    // is read. Slots past the last tile repeat the first one, so that the statement is always the same.
+    // clang-format off
+    mapbox::sqlite::Query query{ getStatement(
+        //      0      1  2   3      4           5             6
+        "SELECT tiles.id, x, y, etag, expires, must_revalidate, modified, "
+        //                 7                    8             9                   10
+        "  IFNULL(tiles.data, tile_blobs.data), compressed, tile_layouts.data_hash, tile_layouts.layout "
+        "FROM tiles "
+        "LEFT JOIN tile_blobs ON tile_blobs.id = blob_id "
+        "LEFT JOIN tile_layouts ON tile_layouts.tile_id = tiles.id "
+        "WHERE url_template = ?1 "
+        "  AND pixel_ratio  = ?2 "
+        "  AND z            = ?3 "
+        "  AND x IN (?4, ?5, ?6, ?7, ?8, ?9, ?10, ?11, ?12, ?13, ?14, ?15, ?16, ?17, ?18, ?19) "
+        "  AND y IN (?20, ?21, ?22, ?23, ?24, ?25, ?26, ?27, ?28, ?29, ?30, ?31, ?32, ?33, ?34, ?35) ") };
+    // clang-format on
+
+    query.bind(1, first.urlTemplate);
+    query.bind(2, first.pixelRatio);
+    query.bind(3, first.z);
+    for (std::size_t slot = 0; slot < maxBatchedTiles; ++slot) {
+        const auto& tile = *resources[indices[slot < indices.size() ? slot : 0]].tileData;
+        query.bind(4 + static_cast<int>(slot), tile.x);
+        query.bind(20 + static_cast<int>(slot), tile.y);
+    }
+
+    std::vector<int64_t> found;
+    while (query.run()) {
+        const auto x = query.get<int>(1);
+        const auto y = query.get<int>(2);
+        std::optional<Response> response;
+        for (const auto index : indices) {
+            const auto& tile = *resources[index].tileData;
+            if (tile.x != x || tile.y != y) {
+                continue;
+            }
+            if (!response) {
+                response = readTile(query, 3).first;
+                found.push_back(query.get<int64_t>(0));
+            }
+            responses[index] = response;
+        }
+    }
+
+    // Update accessed timestamp used for LRU eviction.
+    if (readOnly || found.empty()) {
+        return;
+    }
+    try {
+        // clang-format off
+        mapbox::sqlite::Query accessedQuery{ getStatement(
+            "UPDATE tiles "
+            "SET accessed = ?1 "
+            "WHERE id IN (?2, ?3, ?4, ?5, ?6, ?7, ?8, ?9, ?10, ?11, ?12, ?13, ?14, ?15, ?16, ?17)") };
+        // clang-format on
+
+        accessedQuery.bind(1, util::now());
+        for (std::size_t slot = 0; slot < maxBatchedTiles; ++slot) {
+            accessedQuery.bind(2 + static_cast<int>(slot), found[slot < found.size() ? slot : 0]);
+        }
+        accessedQuery.run();
+    } catch (const mapbox::sqlite::Exception& ex) {
+        if (ex.code == mapbox::sqlite::ResultCode::NotADB || ex.code == mapbox::sqlite::ResultCode::Corrupt) {
+            throw;
+        }
+
+        // If we don't have any indication that the database is corrupt, continue as usual.
+        Log::Warning(Event::Database, static_cast<int>(ex.code), std::string("Can't update timestamp: ") + ex.what());
+    }
+}
+
 std::optional<int64_t> OfflineDatabase::hasTile(const Resource::TileData& tile) {
     // clang-format off
     mapbox::sqlite::Query size{ getStatement(
-        "SELECT length(data) "
+        "SELECT LENGTH(IFNULL(tiles.data, tile_blobs.data)) "
         "FROM tiles "
+        "LEFT JOIN tile_blobs ON tile_blobs.id = blob_id "
         "WHERE url_template = ?1 "
         "  AND pixel_ratio  = ?2 "
         "  AND x            = ?3 "
@@ -605,7 +1530,7 @@ std::optional<int64_t> OfflineDatabase::hasTile(const Resource::TileData& tile)
 bool OfflineDatabase::putTile(const Resource::TileData& tile,
                               const Response& response,
                               const std::string& data,
-                              bool compressed) {
+                              int32_t compression) {
     checkFlags();
 
     if (response.notModified) {
@@ -634,6 +1559,11 @@ bool OfflineDatabase::putTile(const Resource::TileData& tile,
         return false;
     }
 
+    std::optional<int64_t> blobID;
+    if (!response.noContent && data.size() >= minSharedTileSize) {
+        blobID = putTileBlob(data);
+    }
+
     // We can't use REPLACE because it would change the id value.
 
     // clang-format off
@@ -645,7 +1575,8 @@ bool OfflineDatabase::putTile(const Resource::TileData& tile,
         "    must_revalidate = ?4, "
         "    accessed        = ?5, "
         "    data            = ?6, "
-        "    compressed      = ?7 "
+        "    compressed      = ?7, "
+        "    blob_id         = ?13 "
         "WHERE url_template  = ?8 "
         "  AND pixel_ratio   = ?9 "
         "  AND x             = ?10 "
@@ -666,10 +1597,16 @@ bool OfflineDatabase::putTile(const Resource::TileData& tile,
 
     if (response.noContent) {
         updateQuery.bind(6, nullptr);
-        updateQuery.bind(7, false);
+        updateQuery.bind(7, static_cast<int32_t>(TileCompression::Uncompressed));
+        updateQuery.bind(13, nullptr);
+    } else if (blobID) {
+        updateQuery.bind(6, nullptr);
+        updateQuery.bind(7, compression);
+        updateQuery.bind(13, *blobID);
     } else {
         updateQuery.bindBlob(6, data.data(), data.size(), false);
-        updateQuery.bind(7, compressed);
+        updateQuery.bind(7, compression);
+        updateQuery.bind(13, nullptr);
     }
 
     updateQuery.run();
@@ -679,8 +1616,8 @@ bool OfflineDatabase::putTile(const Resource::TileData& tile,
 
     // clang-format off
     mapbox::sqlite::Query insertQuery{ getStatement(
-        "INSERT INTO tiles (url_template, pixel_ratio, x,  y,  z,  modified, must_revalidate, etag, expires, accessed,  data, compressed) "
-        "VALUES            (?1,           ?2,          ?3, ?4, ?5, ?6,       ?7,              ?8,   ?9,      ?10,       ?11,  ?12)") };
+        "INSERT INTO tiles (url_template, pixel_ratio, x,  y,  z,  modified, must_revalidate, etag, expires, accessed,  data, compressed, blob_id) "
+        "VALUES            (?1,           ?2,          ?3, ?4, ?5, ?6,       ?7,              ?8,   ?9,      ?10,       ?11,  ?12,        ?13)") };
     // clang-format on
 
     insertQuery.bind(1, tile.urlTemplate);
@@ -696,10 +1633,16 @@ bool OfflineDatabase::putTile(const Resource::TileData& tile,
 
     if (response.noContent) {
         insertQuery.bind(11, nullptr);
-        insertQuery.bind(12, false);
+        insertQuery.bind(12, static_cast<int32_t>(TileCompression::Uncompressed));
+        insertQuery.bind(13, nullptr);
+    } else if (blobID) {
+        insertQuery.bind(11, nullptr);
+        insertQuery.bind(12, compression);
+        insertQuery.bind(13, *blobID);
     } else {
         insertQuery.bindBlob(11, data.data(), data.size(), false);
-        insertQuery.bind(12, compressed);
+        insertQuery.bind(12, compression);
+        insertQuery.bind(13, nullptr);
     }
 
     insertQuery.run();
@@ -707,8 +1650,32 @@ bool OfflineDatabase::putTile(const Resource::TileData& tile,
     return true;
 }
 
+int64_t OfflineDatabase::putTileBlob(const std::string& data) {
+    const auto hash = tileBlobHash(data);
+
+    // Hash collisions are told apart by comparing the payloads
+    // clang-format off
+    mapbox::sqlite::Query selectQuery{ getStatement(
+        "SELECT id FROM tile_blobs "
+        "WHERE hash = ?1 "
+        "  AND data = ?2 ") };
+    // clang-format on
+    selectQuery.bind(1, hash);
+    selectQuery.bindBlob(2, data.data(), data.size(), false);
+    if (selectQuery.run()) {
+        return selectQuery.get<int64_t>(0);
+    }
+
+    mapbox::sqlite::Query insertQuery{getStatement("INSERT INTO tile_blobs (hash, data) VALUES (?1, ?2)")};
+    insertQuery.bind(1, hash);
+    insertQuery.bindBlob(2, data.data(), data.size(), false);
+    insertQuery.run();
+    return insertQuery.lastInsertRowId();
+}
+
 std::exception_ptr OfflineDatabase::invalidateAmbientCache() try {
     checkFlags();
+    commitAmbientBatch();
 
     // clang-format off
     mapbox::sqlite::Query tileQuery{ getStatement(
@@ -742,6 +1709,7 @@ std::exception_ptr OfflineDatabase::invalidateAmbientCache() try {
 
 std::exception_ptr OfflineDatabase::clearAmbientCache() try {
     checkFlags();
+    commitAmbientBatch();
 
     // clang-format off
     mapbox::sqlite::Query tileQuery{ getStatement(
@@ -775,6 +1743,7 @@ std::exception_ptr OfflineDatabase::clearAmbientCache() try {
 
 std::exception_ptr OfflineDatabase::invalidateRegion(int64_t regionID) try {
     checkFlags();
+    RegionWrite regionWrite(*this);
 
     {
         // clang-format off
@@ -858,6 +1827,7 @@ expected<std::optional<OfflineRegion>, std::exception_ptr> OfflineDatabase::getR
 expected<OfflineRegion, std::exception_ptr> OfflineDatabase::createRegion(const OfflineRegionDefinition& definition,
                                                                           const OfflineRegionMetadata& metadata) try {
     checkFlags();
+    RegionWrite regionWrite(*this);
 
     // clang-format off
     mapbox::sqlite::Query query{ getStatement(
@@ -874,8 +1844,10 @@ expected<OfflineRegion, std::exception_ptr> OfflineDatabase::createRegion(const
     return unexpected<std::exception_ptr>(std::current_exception());
 }
 
-expected<OfflineRegions, std::exception_ptr> OfflineDatabase::mergeDatabase(const std::string& sideDatabasePath) {
+expected<OfflineRegions, std::exception_ptr> OfflineDatabase::mergeDatabase(
+    const std::string& sideDatabasePath, const std::function<void(uint64_t, uint64_t)>& progress) {
     checkFlags();
+    RegionWrite regionWrite(*this);
 
     try {
         // clang-format off
@@ -892,12 +1864,13 @@ expected<OfflineRegions, std::exception_ptr> OfflineDatabase::mergeDatabase(cons
         return unexpected<std::exception_ptr>(std::current_exception());
     }
     try {
-        // Support sideloaded databases at user_version = 6. Future schema
-        // version changes will need to implement migration paths for sideloaded
-        // databases at version 6.
+        // Support sideloaded databases at user_version = 6 to 10. Version 7 only
+        // added the compression dictionaries, which version 6 databases lack,
+        // version 8 the shared tile payloads, version 9 the stored ambient
+        // cache size and version 10 the stored tile layouts, which aren't merged.
         auto sideUserVersion = static_cast<int>(getPragma<int64_t>("PRAGMA side.user_version"));
         const auto mainUserVersion = getPragma<int64_t>("PRAGMA user_version");
-        if (sideUserVersion < 6 || sideUserVersion != mainUserVersion) {
+        if (sideUserVersion < 6 || sideUserVersion > mainUserVersion) {
             throw std::runtime_error("Merge database has incorrect user_version");
         }
 
@@ -924,9 +1897,34 @@ expected<OfflineRegions, std::exception_ptr> OfflineDatabase::mergeDatabase(cons
         }
         queryTiles.reset();
 
-        mapbox::sqlite::Transaction transaction(*db);
-        db->exec(mergeSideloadedDatabaseSQL);
-        transaction.commit();
+        // Everything is copied by set-based statements in a single transaction, with a
+        // page cache large enough for the index updates of multi-GB side databases
+        const auto cacheSize = getPragma<int64_t>("PRAGMA cache_size");
+        db->exec("PRAGMA cache_size = -" + std::to_string(mergeCacheSizeKiB));
+        try {
+            mapbox::sqlite::Transaction transaction(*db);
+            if (sideUserVersion >= 7) {
+                tileCompressor->renumberMergeCollisions(*this);
+            }
+            mergeTiles(sideUserVersion, progress);
+            db->exec(mergeSideloadedDatabaseSQL);
+            // REPLACE doesn't run the delete triggers, release the payloads of the replaced tiles here
+            db->exec("DELETE FROM tile_blobs WHERE id NOT IN (SELECT blob_id FROM tiles WHERE blob_id IS NOT NULL)");
+            if (sideUserVersion >= 7) {
+                // Dictionaries of the merged zstd-compressed tiles
+                db->exec("INSERT OR IGNORE INTO compression_dictionaries SELECT * FROM side.compression_dictionaries");
+            }
+            transaction.commit();
+        } catch (...) {
+            db->exec("PRAGMA cache_size = " + std::to_string(cacheSize));
+            throw;
+        }
+        db->exec("PRAGMA cache_size = " + std::to_string(cacheSize));
+
+        // Sizes are recomputed when next needed rather than tracked through the merge
+        currentAmbientCacheSize = std::nullopt;
+        ambientCacheSizing = std::nullopt;
+        offlineMapboxTileCount = std::nullopt;
 
         // clang-format off
         mapbox::sqlite::Query queryRegions{ getStatement(
@@ -955,9 +1953,79 @@ expected<OfflineRegions, std::exception_ptr> OfflineDatabase::mergeDatabase(cons
     return {};
 }
 
+// Copies the region tiles of the attached side database that are new or newer than
+// ours, in batches of side tile IDs so that the progress of large merges can be reported
+void OfflineDatabase::mergeTiles(int sideUserVersion, const std::function<void(uint64_t, uint64_t)>& progress) {
+    uint64_t total = 0;
+    {
+        mapbox::sqlite::Query query{getStatement("SELECT COUNT(*) FROM side.tiles")};
+        query.run();
+        total = static_cast<uint64_t>(query.get<int64_t>(0));
+    }
+
+    // clang-format off
+    mapbox::sqlite::Query batchQuery{ getStatement(
+        "SELECT MAX(id), COUNT(*) "
+        "FROM (SELECT id FROM side.tiles WHERE id > ?1 ORDER BY id LIMIT ?2) ") };
+
+    // Ambient side tiles are skipped, shared side payloads are stored inline
+    static constexpr const char* copyTilesSQL =
+        "REPLACE INTO tiles (id, url_template, pixel_ratio, z, x, y, "
+        "                    expires, modified, etag, data, compressed, accessed, must_revalidate) "
+        "SELECT t.id, st.url_template, st.pixel_ratio, st.z, st.x, st.y, "
+        "       st.expires, st.modified, st.etag, st.data, st.compressed, st.accessed, st.must_revalidate "
+        "FROM side.tiles st "
+        "LEFT JOIN tiles t ON st.url_template = t.url_template AND st.pixel_ratio = t.pixel_ratio "
+        "  AND st.z = t.z AND st.x = t.x AND st.y = t.y "
+        "WHERE st.id > ?1 AND st.id <= ?2 "
+        "  AND EXISTS (SELECT 1 FROM side.region_tiles srt WHERE srt.tile_id = st.id) "
+        "  AND (t.id IS NULL OR st.modified > t.modified) ";
+    static constexpr const char* copySharedTilesSQL =
+        "REPLACE INTO tiles (id, url_template, pixel_ratio, z, x, y, "
+        "                    expires, modified, etag, data, compressed, accessed, must_revalidate) "
+        "SELECT t.id, st.url_template, st.pixel_ratio, st.z, st.x, st.y, "
+        "       st.expires, st.modified, st.etag, IFNULL(st.data, b.data), st.compressed, st.accessed, "
+        "       st.must_revalidate "
+        "FROM side.tiles st "
+        "LEFT JOIN side.tile_blobs b ON b.id = st.blob_id "
+        "LEFT JOIN tiles t ON st.url_template = t.url_template AND st.pixel_ratio = t.pixel_ratio "
+        "  AND st.z = t.z AND st.x = t.x AND st.y = t.y "
+        "WHERE st.id > ?1 AND st.id <= ?2 "
+        "  AND EXISTS (SELECT 1 FROM side.region_tiles srt WHERE srt.tile_id = st.id) "
+        "  AND (t.id IS NULL OR st.modified > t.modified) ";
+    // clang-format on
+    mapbox::sqlite::Query copyQuery{getStatement(sideUserVersion >= 8 ? copySharedTilesSQL : copyTilesSQL)};
+
+    uint64_t merged = 0;
+    int64_t lastID = 0;
+    while (true) {
+        batchQuery.bind(1, lastID);
+        batchQuery.bind(2, mergeTileBatchSize);
+        batchQuery.run();
+        const auto count = batchQuery.get<int64_t>(1);
+        const auto batchLastID = count ? batchQuery.get<int64_t>(0) : lastID;
+        batchQuery.reset();
+        if (count == 0) {
+            break;
+        }
+
+        copyQuery.bind(1, lastID);
+        copyQuery.bind(2, batchLastID);
+        copyQuery.run();
+        copyQuery.reset();
+
+        lastID = batchLastID;
+        merged += static_cast<uint64_t>(count);
+        if (progress) {
+            progress(merged, total);
+        }
+    }
+}
+
 expected<OfflineRegionMetadata, std::exception_ptr> OfflineDatabase::updateMetadata(
     const int64_t regionID, const OfflineRegionMetadata& metadata) try {
     checkFlags();
+    RegionWrite regionWrite(*this);
 
     // clang-format off
     mapbox::sqlite::Query query{ getStatement(
@@ -976,6 +2044,7 @@ expected<OfflineRegionMetadata, std::exception_ptr> OfflineDatabase::updateMetad
 
 std::exception_ptr OfflineDatabase::deleteRegion(OfflineRegion&& region) try {
     checkFlags();
+    RegionWrite regionWrite(*this);
 
     {
         mapbox::sqlite::Query query{getStatement("DELETE FROM regions WHERE id = ?")};
@@ -1013,10 +2082,12 @@ std::optional<int64_t> OfflineDatabase::hasRegionResource(const Resource& resour
 
 uint64_t OfflineDatabase::putRegionResource(int64_t regionID, const Resource& resource, const Response& response) try {
     checkFlags();
+    RegionWrite regionWrite(*this);
 
     if (!db) {
         initialize();
     }
+    trainTileCompression();
     mapbox::sqlite::Transaction transaction(*db);
     auto size = putRegionResourceInternal(regionID, resource, response);
     transaction.commit();
@@ -1030,10 +2101,12 @@ void OfflineDatabase::putRegionResources(int64_t regionID,
                                          const std::list<std::tuple<Resource, Response>>& resources,
                                          OfflineRegionStatus& status) try {
     checkFlags();
+    RegionWrite regionWrite(*this);
 
     if (!db) {
         initialize();
     }
+    trainTileCompression();
     mapbox::sqlite::Transaction transaction(*db);
 
     // Accumulate all statistics locally first before adding them to the
@@ -1203,6 +2276,40 @@ expected<OfflineRegionStatus, std::exception_ptr> OfflineDatabase::getRegionComp
     return unexpected<std::exception_ptr>(std::current_exception());
 }
 
+std::map<uint8_t, double> OfflineDatabase::getMeanTileSizes(const std::string& urlTemplate,
+                                                            uint8_t pixelRatio,
+                                                            uint8_t minZoom,
+                                                            uint8_t maxZoom) try {
+    std::map<uint8_t, double> result;
+    for (unsigned z = minZoom; z <= maxZoom; z++) {
+        // Bounded by the sample size, as the tiles of a zoom level are a range of the tiles index
+        // clang-format off
+        mapbox::sqlite::Query query{ getStatement(
+            "SELECT COUNT(*), AVG(size) FROM ("
+            "SELECT LENGTH(IFNULL(tiles.data, tile_blobs.data)) AS size "
+            "FROM tiles "
+            "LEFT JOIN tile_blobs ON tile_blobs.id = blob_id "
+            "WHERE url_template = ?1 "
+            "AND pixel_ratio = ?2 "
+            "AND z = ?3 "
+            "AND (tiles.data IS NOT NULL OR blob_id IS NOT NULL) "
+            "LIMIT ?4)") };
+        // clang-format on
+        query.bind(1, urlTemplate);
+        query.bind(2, pixelRatio);
+        query.bind(3, static_cast<int64_t>(z));
+        query.bind(4, meanTileSizeSamples);
+        query.run();
+        if (query.get<int64_t>(0) > 0) {
+            result.emplace(static_cast<uint8_t>(z), query.get<double>(1));
+        }
+    }
+    return result;
+} catch (...) {
+    handleError("get mean tile sizes");
+    return {};
+}
+
 std::pair<int64_t, int64_t> OfflineDatabase::getCompletedResourceCountAndSize(int64_t regionID) {
     // clang-format off
     mapbox::sqlite::Query query{ getStatement(
@@ -1219,10 +2326,11 @@ std::pair<int64_t, int64_t> OfflineDatabase::getCompletedResourceCountAndSize(in
 std::pair<int64_t, int64_t> OfflineDatabase::getCompletedTileCountAndSize(int64_t regionID) {
     // clang-format off
     mapbox::sqlite::Query query{ getStatement(
-        "SELECT COUNT(*), SUM(LENGTH(data)) "
-        "FROM region_tiles, tiles "
-        "WHERE region_id = ?1 "
-        "AND tile_id = tiles.id ") };
+        "SELECT COUNT(*), SUM(LENGTH(IFNULL(tiles.data, tile_blobs.data))) "
+        "FROM region_tiles "
+        "JOIN tiles ON tile_id = tiles.id "
+        "LEFT JOIN tile_blobs ON tile_blobs.id = blob_id "
+        "WHERE region_id = ?1 ") };
     // clang-format on
     query.bind(1, regionID);
     query.run();
@@ -1248,75 +2356,105 @@ T OfflineDatabase::getPragma(const char* sql) {
 // saves us from calling VACUUM or keeping a running total, which can be costly.
 bool OfflineDatabase::evict(uint64_t neededFreeSize, DatabaseSizeChangeStats& stats) {
     checkFlags();
-    uint64_t ambientCacheSize = (initAmbientCacheSize() == nullptr) ? *currentAmbientCacheSize
-                                                                    : maximumAmbientCacheSize;
-    uint64_t newAmbientCacheSize = ambientCacheSize + neededFreeSize + stats.pageSize();
+    uint64_t ambientCacheSize = 0u;
+    if (ambientCacheSizing) {
+        // Evict against the part added up so far, which may leave the cache above its
+        // maximum for a while, rather than wait for the rest
+        ambientCacheSize = std::max<int64_t>(ambientCacheSizing->size, 0);
+    } else {
+        ambientCacheSize = (initAmbientCacheSize() == nullptr) ? *currentAmbientCacheSize : maximumAmbientCacheSize;
+    }
+    const uint64_t requiredAmbientCacheSize = ambientCacheSize + neededFreeSize + stats.pageSize();
+    uint64_t newAmbientCacheSize = requiredAmbientCacheSize;
 
     while (newAmbientCacheSize > maximumAmbientCacheSize) {
-        // clang-format off
-        mapbox::sqlite::Query accessedQuery{ getStatement(
-            "SELECT max(accessed) "
-            "FROM ( "
-            "    SELECT accessed "
-            "    FROM resources "
-            "    LEFT JOIN region_resources "
-            "    ON resource_id = resources.id "
-            "    WHERE resource_id IS NULL "
-            "  UNION ALL "
-            "    SELECT accessed "
-            "    FROM tiles "
-            "    LEFT JOIN region_tiles "
-            "    ON tile_id = tiles.id "
-            "    WHERE tile_id IS NULL "
-            "  ORDER BY accessed ASC LIMIT ?1 "
-            ") "
-        ) };
-        accessedQuery.bind(1, 50);
-        // clang-format on
-        if (!accessedQuery.run()) {
+        // Walk the unused resources and tiles from the least recently used one, adding up their
+        // sizes until they cover the excess. Both walks follow the `accessed` indexes and stop
+        // early, so the cost depends on how much gets evicted rather than on the cache size.
+        // Shared tile payloads are counted in full, though only their last tile releases them.
+        const uint64_t excess = newAmbientCacheSize - maximumAmbientCacheSize;
+        uint64_t evictedSize = 0;
+        int64_t resourceCount = 0;
+        int64_t tileCount = 0;
+        {
+            // clang-format off
+            mapbox::sqlite::Query lruQuery{ getStatement(
+                "SELECT size, tile "
+                "FROM ( "
+                "    SELECT accessed, resources.id AS id, IFNULL(LENGTH(data), 0) AS size, 0 AS tile "
+                "    FROM resources "
+                "    LEFT JOIN region_resources "
+                "    ON resource_id = resources.id "
+                "    WHERE resource_id IS NULL "
+                "  UNION ALL "
+                "    SELECT accessed, tiles.id AS id, "
+                "           IFNULL(LENGTH(IFNULL(tiles.data, tile_blobs.data)), 0) AS size, 1 AS tile "
+                "    FROM tiles "
+                "    LEFT JOIN region_tiles "
+                "    ON tile_id = tiles.id "
+                "    LEFT JOIN tile_blobs "
+                "    ON tile_blobs.id = blob_id "
+                "    WHERE tile_id IS NULL "
+                "  ORDER BY accessed ASC, id ASC "
+                ") "
+            ) };
+            // clang-format on
+            while (evictedSize < excess && lruQuery.run()) {
+                evictedSize += lruQuery.get<int64_t>(0);
+                if (lruQuery.get<bool>(1)) {
+                    tileCount++;
+                } else {
+                    resourceCount++;
+                }
+            }
+        }
+
+        if (resourceCount == 0 && tileCount == 0) {
             return false;
         }
-        Timestamp accessed = accessedQuery.get<Timestamp>(0);
 
-        // clang-format off
-        mapbox::sqlite::Query resourceQuery{ getStatement(
-            "DELETE FROM resources "
-            "WHERE id IN ( "
-            "  SELECT id FROM resources "
-            "  LEFT JOIN region_resources "
-            "  ON resource_id = resources.id "
-            "  WHERE resource_id IS NULL "
-            "  AND accessed <= ?1 "
-            ") ") };
-        // clang-format on
-        resourceQuery.bind(1, accessed);
-        resourceQuery.run();
-        const uint64_t resourceChanges = resourceQuery.changes();
+        // Delete exactly the rows walked above, which are a prefix of each table's walk
+        if (resourceCount > 0) {
+            // clang-format off
+            mapbox::sqlite::Query resourceQuery{ getStatement(
+                "DELETE FROM resources "
+                "WHERE id IN ( "
+                "  SELECT resources.id FROM resources "
+                "  LEFT JOIN region_resources "
+                "  ON resource_id = resources.id "
+                "  WHERE resource_id IS NULL "
+                "  ORDER BY accessed ASC, resources.id ASC "
+                "  LIMIT ?1 "
+                ") ") };
+            // clang-format on
+            resourceQuery.bind(1, resourceCount);
+            resourceQuery.run();
+        }
 
-        // clang-format off
-        mapbox::sqlite::Query tileQuery{ getStatement(
-            "DELETE FROM tiles "
-            "WHERE id IN ( "
-            "  SELECT id FROM tiles "
-            "  LEFT JOIN region_tiles "
-            "  ON tile_id = tiles.id "
-            "  WHERE tile_id IS NULL "
-            "  AND accessed <= ?1 "
-            ") ") };
-        // clang-format on
-        tileQuery.bind(1, accessed);
-        tileQuery.run();
-        const uint64_t tileChanges = tileQuery.changes();
+        if (tileCount > 0) {
+            // clang-format off
+            mapbox::sqlite::Query tileQuery{ getStatement(
+                "DELETE FROM tiles "
+                "WHERE id IN ( "
+                "  SELECT tiles.id FROM tiles "
+                "  LEFT JOIN region_tiles "
+                "  ON tile_id = tiles.id "
+                "  WHERE tile_id IS NULL "
+                "  ORDER BY accessed ASC, tiles.id ASC "
+                "  LIMIT ?1 "
+                ") ") };
+            // clang-format on
+            tileQuery.bind(1, tileCount);
+            tileQuery.run();
+        }
 
-        // Update current ambient cache size, based on how many bytes were released.
+        // Update current ambient cache size, based on how many bytes were released. Page slack
+        // can leave it slightly above the maximum, in which case the walk repeats.
         newAmbientCacheSize = std::max<int64_t>(
-            static_cast<int64_t>(newAmbientCacheSize) - static_cast<int64_t>(stats.bytesReleased()), 0u);
+            static_cast<int64_t>(requiredAmbientCacheSize) - static_cast<int64_t>(stats.bytesReleased()), 0u);
 
         // The cached value of offlineTileCount does not need to be updated
         // here because only non-offline tiles can be removed by eviction.
-        if (resourceChanges == 0 && tileChanges == 0) {
-            return false;
-        }
     }
 
     return true;
@@ -1325,49 +2463,13 @@ bool OfflineDatabase::evict(uint64_t neededFreeSize, DatabaseSizeChangeStats& st
 std::exception_ptr OfflineDatabase::initAmbientCacheSize() {
     if (!currentAmbientCacheSize) {
         try {
-            // clang-format off
-            mapbox::sqlite::Query query{ getStatement(
-            "SELECT SUM(data) "
-            "FROM ( "
-            "    SELECT SUM(IFNULL(LENGTH(data), 0) "
-            "               + IFNULL(LENGTH(id), 0) "
-            "               + IFNULL(LENGTH(url_template), 0) "
-            "               + IFNULL(LENGTH(pixel_ratio), 0) "
-            "               + IFNULL(LENGTH(x), 0) "
-            "               + IFNULL(LENGTH(y), 0) "
-            "               + IFNULL(LENGTH(z), 0) "
-            "               + IFNULL(LENGTH(expires), 0) "
-            "               + IFNULL(LENGTH(modified), 0) "
-            "               + IFNULL(LENGTH(etag), 0) "
-            "               + IFNULL(LENGTH(compressed), 0) "
-            "               + IFNULL(LENGTH(accessed), 0) "
-            "               + IFNULL(LENGTH(must_revalidate), 0) "
-            "               ) as data "
-            "    FROM tiles "
-            "    LEFT JOIN region_tiles "
-            "    ON tile_id = tiles.id "
-            "    WHERE tile_id IS NULL "
-            "  UNION ALL "
-            "    SELECT SUM(IFNULL(LENGTH(data), 0) "
-            "               + IFNULL(LENGTH(id), 0) "
-            "               + IFNULL(LENGTH(url), 0) "
-            "               + IFNULL(LENGTH(kind), 0) "
-            "               + IFNULL(LENGTH(expires), 0) "
-            "               + IFNULL(LENGTH(modified), 0) "
-            "               + IFNULL(LENGTH(etag), 0) "
-            "               + IFNULL(LENGTH(compressed), 0) "
-            "               + IFNULL(LENGTH(accessed), 0) "
-            "               + IFNULL(LENGTH(must_revalidate), 0) "
-            "               ) as data "
-            "    FROM resources "
-            "    LEFT JOIN region_resources "
-            "    ON resource_id = resources.id "
-            "    WHERE resource_id IS NULL "
-            ") ") };
-            // clang-format on
-            query.run();
-            currentAmbientCacheSize = query.get<int64_t>(0);
+            // Whatever the background sizing left is added up at once
+            if (ambientCacheSizing || !loadAmbientCacheSize()) {
+                while (!sizeAmbientCache(std::numeric_limits<int64_t>::max())) {
+                }
+            }
         } catch (const mapbox::sqlite::Exception& ex) {
+            ambientCacheSizing = std::nullopt;
             handleError(ex, "cannot get current ambient cache size");
             return std::current_exception();
         }
@@ -1376,6 +2478,103 @@ std::exception_ptr OfflineDatabase::initAmbientCacheSize() {
     return nullptr;
 }
 
+bool OfflineDatabase::continueAmbientCacheSizing() {
+    if (currentAmbientCacheSize || readOnly) {
+        return false;
+    }
+
+    try {
+        if (!ambientCacheSizing && loadAmbientCacheSize()) {
+            return false;
+        }
+        return !sizeAmbientCache(ambientCacheSizingChunk);
+    } catch (...) {
+        ambientCacheSizing = std::nullopt;
+        handleError("size ambient cache");
+        return false;
+    }
+}
+
+bool OfflineDatabase::loadAmbientCacheSize() {
+    // Read-only databases aren't migrated, and don't store the size either
+    if (readOnly) {
+        return false;
+    }
+
+    mapbox::sqlite::Query query{getStatement("SELECT size, page_count, freelist_count FROM ambient_cache_size")};
+    if (!query.run()) {
+        return false;
+    }
+    const auto size = query.get<std::optional<int64_t>>(0);
+    // The cheapest sign of another writer, or of a merge, since the size was stored
+    const bool unchanged = size && query.get<int64_t>(1) == getPragma<int64_t>("PRAGMA page_count") &&
+                           query.get<int64_t>(2) == getPragma<int64_t>("PRAGMA freelist_count");
+    query.reset();
+
+    if (size) {
+        // Stored again on close, so that a crash leaves no stale size behind
+        mapbox::sqlite::Query clearQuery{getStatement("UPDATE ambient_cache_size SET size = NULL")};
+        clearQuery.run();
+    }
+
+    if (unchanged) {
+        currentAmbientCacheSize = std::max<int64_t>(*size, 0);
+    }
+    return unchanged;
+}
+
+void OfflineDatabase::storeAmbientCacheSize() {
+    if (!db || readOnly || !currentAmbientCacheSize) {
+        return;
+    }
+
+    try {
+        // Rewriting the single row in place leaves the page counts as they are
+        mapbox::sqlite::Query query{
+            getStatement("INSERT OR REPLACE INTO ambient_cache_size (id, size, page_count, freelist_count) "
+                         "VALUES (1, ?1, ?2, ?3)")};
+        query.bind(1, static_cast<int64_t>(*currentAmbientCacheSize));
+        query.bind(2, getPragma<int64_t>("PRAGMA page_count"));
+        query.bind(3, getPragma<int64_t>("PRAGMA freelist_count"));
+        query.run();
+    } catch (...) {
+        handleError("store ambient cache size");
+    }
+}
+
+bool OfflineDatabase::sizeAmbientCache(int64_t chunk) {
+    if (!ambientCacheSizing) {
+        ambientCacheSizing.emplace();
+        for (std::size_t i = 0; i < ambientCacheTables.size(); ++i) {
+            mapbox::sqlite::Query query{getStatement(ambientCacheTables[i].maxID)};
+            query.run();
+            ambientCacheSizing->maxIDs[i] = query.get<int64_t>(0);
+        }
+    }
+
+    auto& sizing = *ambientCacheSizing;
+    while (sizing.table < ambientCacheTables.size() && sizing.lastID >= sizing.maxIDs[sizing.table]) {
+        ++sizing.table;
+        sizing.lastID = 0;
+    }
+
+    if (sizing.table < ambientCacheTables.size()) {
+        const int64_t maxID = sizing.maxIDs[sizing.table];
+        const int64_t endID = maxID - sizing.lastID > chunk ? sizing.lastID + chunk : maxID;
+        mapbox::sqlite::Query query{getStatement(ambientCacheTables[sizing.table].size)};
+        query.bind(1, sizing.lastID);
+        query.bind(2, endID);
+        query.run();
+        sizing.size += query.get<int64_t>(0);
+        sizing.lastID = endID;
+        return false;
+    }
+
+    currentAmbientCacheSize = std::max<int64_t>(sizing.size, 0);
+    ambientCacheSizing = std::nullopt;
+    return true;
+}
+
 std::exception_ptr OfflineDatabase::setMaximumAmbientCacheSize(uint64_t size) {
     uint64_t previousMaximumAmbientCacheSize = maximumAmbientCacheSize;
 
@@ -1446,6 +2645,7 @@ bool OfflineDatabase::exceedsOfflineMapboxTileCountLimit(const Resource& resourc
 }
 
 void OfflineDatabase::markUsedResources(int64_t regionID, const std::list<Resource>& resources) try {
+    RegionWrite regionWrite(*this);
     if (!db) {
         initialize();
     }
@@ -1511,9 +2711,11 @@ uint64_t OfflineDatabase::DatabaseSizeChangeStats::bytesReleased() const {
 }
 
 void OfflineDatabase::updateAmbientCacheSize(DatabaseSizeChangeStats& stats) {
-    assert(currentAmbientCacheSize);
+    assert(currentAmbientCacheSize || ambientCacheSizing);
     if (currentAmbientCacheSize) {
         *currentAmbientCacheSize = std::max<int64_t>(static_cast<int64_t>(*currentAmbientCacheSize) + stats.diff(), 0u);
+    } else if (ambientCacheSizing) {
+        ambientCacheSizing->size += stats.diff();
     }
 }
 
@@ -15,10 +15,12 @@
 #include <mbgl/text/glyph.hpp>
 #include <mbgl/util/i18n.hpp>
 #include <mbgl/util/mapbox.hpp>
+#include <mbgl/util/monotonic_timer.hpp>
 #include <mbgl/util/run_loop.hpp>
 #include <mbgl/util/tile_cover.hpp>
 #include <mbgl/util/tileset.hpp>
 
+#include <algorithm>
 #include <set>
 
 namespace {
@@ -26,6 +28,11 @@ namespace {
 const size_t kResourcesBatchSize = 64;
 const size_t kMarkBatchSize = 200;
 
+// A window is considered congested when more than one response in ten failed, or
+// when its average latency exceeds twice the best window average plus this slack,
+// which keeps jitter on fast links from halving the concurrency.
+const std::chrono::duration<double> kLatencySlack = std::chrono::milliseconds(20);
+
 } // namespace
 
 namespace mbgl {
@@ -75,6 +82,15 @@ void tileCover(const OfflineRegionDefinition& definition,
     }
 }
 
+uint64_t tileCount(const OfflineRegionDefinition& definition, uint8_t z) {
+    return std::visit(
+        overloaded{[&](const OfflineTilePyramidRegionDefinition& reg) { return util::tileCount(reg.bounds, z); },
+                   [&](const OfflineGeometryRegionDefinition& reg) {
+                       return util::tileCount(reg.geometry, z);
+                   }},
+        definition);
+}
+
 uint64_t tileCount(const OfflineRegionDefinition& definition,
                    style::SourceType type,
                    uint16_t tileSize,
@@ -84,17 +100,47 @@ uint64_t tileCount(const OfflineRegionDefinition& definition,
 
     uint64_t result{};
     for (uint8_t z = clampedZoomRange.min; z <= clampedZoomRange.max; z++) {
-        result += std::visit(
-            overloaded{[&](const OfflineTilePyramidRegionDefinition& reg) { return util::tileCount(reg.bounds, z); },
-                       [&](const OfflineGeometryRegionDefinition& reg) {
-                           return util::tileCount(reg.geometry, z);
-                       }},
-            definition);
+        result += tileCount(definition, z);
     }
 
     return result;
 }
 
+// Bytes the tiles of a source are expected to take, from the mean size of its tiles already in
+// the database. Zoom levels without any use the nearest zoom level that has some.
+uint64_t tileSizeEstimate(OfflineDatabase& offlineDatabase,
+                          const OfflineRegionDefinition& definition,
+                          style::SourceType type,
+                          uint16_t tileSize,
+                          const Tileset& tileset) {
+    if (tileset.tiles.empty()) {
+        return 0;
+    }
+
+    const Range<uint8_t> zoomRange = std::visit(
+        [&](auto& reg) { return coveringZoomRange(reg, type, tileSize, tileset.zoomRange); }, definition);
+    // The pixel ratio the tiles are stored with
+    const auto sample = Resource::tile(
+        tileset.tiles[0], std::visit([](auto& def) { return def.pixelRatio; }, definition), 0, 0, 0, tileset.scheme);
+    const auto meanSizes = offlineDatabase.getMeanTileSizes(
+        tileset.tiles[0], sample.tileData->pixelRatio, zoomRange.min, zoomRange.max);
+    if (meanSizes.empty()) {
+        return 0;
+    }
+
+    double result = 0;
+    for (uint8_t z = zoomRange.min; z <= zoomRange.max; z++) {
+        auto nearest = meanSizes.lower_bound(z);
+        if (nearest == meanSizes.end() || (nearest->first != z && nearest != meanSizes.begin() &&
+                                           z - std::prev(nearest)->first < nearest->first - z)) {
+            nearest = std::prev(nearest);
+        }
+        result += nearest->second * static_cast<double>(tileCount(definition, z));
+    }
+
+    return static_cast<uint64_t>(result);
+}
+
 // OfflineDownload
 
 OfflineDownload::OfflineDownload(int64_t id_,
@@ -162,6 +208,8 @@ OfflineRegionStatus OfflineDownload::getStatus() const {
                 uint64_t tileSourceCount = tileCount(definition, type, tileSize, urlOrTileset.get<Tileset>().zoomRange);
                 result->requiredTileCount += tileSourceCount;
                 result->requiredResourceCount += tileSourceCount;
+                result->requiredTileSizeEstimate += tileSizeEstimate(
+                    offlineDatabase, definition, type, tileSize, urlOrTileset.get<Tileset>());
             } else {
                 result->requiredResourceCount += 1;
                 const auto& url = urlOrTileset.get<std::string>();
@@ -174,6 +222,8 @@ OfflineRegionStatus OfflineDownload::getStatus() const {
                         uint64_t tileSourceCount = tileCount(definition, type, tileSize, (*tileset).zoomRange);
                         result->requiredTileCount += tileSourceCount;
                         result->requiredResourceCount += tileSourceCount;
+                        result->requiredTileSizeEstimate += tileSizeEstimate(
+                            offlineDatabase, definition, type, tileSize, *tileset);
                     }
                 } else {
                     result->requiredResourceCountIsPrecise = false;
@@ -244,6 +294,11 @@ void OfflineDownload::activateDownload() {
     status.downloadState = OfflineRegionDownloadState::Active;
     status.requiredResourceCount++;
 
+    concurrency = maxConcurrentRequests();
+    window = RequestWindow();
+    window.start = util::MonotonicTimer::now();
+    baselineLatency = std::nullopt;
+
     auto styleResource = Resource::style(std::visit([](auto& reg) { return reg.styleURL; }, definition));
     styleResource.setPriority(Resource::Priority::Low);
     styleResource.setUsage(Resource::Usage::Offline);
@@ -405,13 +460,10 @@ void OfflineDownload::continueDownload() {
 
     if (resourcesToBeMarkedAsUsed.size() >= kMarkBatchSize) markPendingUsedResources();
 
-    uint32_t maxConcurrentRequests = util::DEFAULT_MAXIMUM_CONCURRENT_REQUESTS;
-    auto value = onlineFileSource.getProperty(MAX_CONCURRENT_REQUESTS_KEY);
-    if (uint64_t* maxRequests = value.getUint()) {
-        maxConcurrentRequests = static_cast<uint32_t>(*maxRequests);
-    }
+    // The online file source may have been reconfigured since the last window
+    const uint32_t concurrentRequests = std::min(std::max(concurrency, 1u), maxConcurrentRequests());
 
-    while (!resourcesRemaining.empty() && requests.size() < maxConcurrentRequests) {
+    while (!resourcesRemaining.empty() && requests.size() < concurrentRequests) {
         ensureResource(std::move(resourcesRemaining.front()));
         resourcesRemaining.pop_front();
     }
@@ -424,6 +476,62 @@ void OfflineDownload::deactivateDownload() {
     buffer.clear();
 }
 
+uint32_t OfflineDownload::maxConcurrentRequests() const {
+    uint32_t maxConcurrentRequests = util::DEFAULT_MAXIMUM_CONCURRENT_REQUESTS;
+    auto value = onlineFileSource.getProperty(MAX_CONCURRENT_REQUESTS_KEY);
+    if (uint64_t* maxRequests = value.getUint()) {
+        maxConcurrentRequests = static_cast<uint32_t>(*maxRequests);
+    }
+    return maxConcurrentRequests;
+}
+
+bool OfflineDownload::recordResponse(std::chrono::duration<double> latency, bool failed, uint64_t bytes, bool tile) {
+    window.latency += latency;
+    window.responses++;
+    if (failed) {
+        window.failures++;
+    } else {
+        window.bytes += bytes;
+        window.tiles += tile ? 1 : 0;
+    }
+    return window.responses >= std::max<std::size_t>(concurrency, kResourcesBatchSize);
+}
+
+void OfflineDownload::completeWindow() {
+    const auto now = util::MonotonicTimer::now();
+    const double elapsed = (now - window.start).count();
+    const auto averageLatency = window.latency / window.responses;
+
+    bool congested = window.failures * 10 > window.responses;
+    if (window.failures < window.responses) {
+        // Windows full of errors don't say anything about the latency of the link
+        if (baselineLatency && averageLatency > 2 * *baselineLatency + kLatencySlack) {
+            congested = true;
+        }
+        if (!baselineLatency || averageLatency < *baselineLatency) {
+            baselineLatency = averageLatency;
+        }
+    }
+
+    if (congested) {
+        concurrency = std::max(concurrency / 2, 1u);
+    } else {
+        concurrency = std::min(concurrency + 1, maxConcurrentRequests());
+    }
+
+    OfflineRegionDownloadRate rate;
+    if (elapsed > 0) {
+        rate.bytesPerSecond = static_cast<double>(window.bytes) / elapsed;
+        rate.tilesPerSecond = static_cast<double>(window.tiles) / elapsed;
+    }
+    rate.concurrentRequests = concurrency;
+
+    window = RequestWindow();
+    window.start = now;
+
+    observer->downloadRateChanged(rate);
+}
+
 bool OfflineDownload::flushResourcesBuffer() {
     if (buffer.empty()) return true;
     try {
@@ -448,6 +556,7 @@ void OfflineDownload::queueResource(Resource&& resource) {
 }
 
 void OfflineDownload::queueTiles(SourceType type, uint16_t tileSize, const Tileset& tileset) {
+    status.requiredTileSizeEstimate += tileSizeEstimate(offlineDatabase, definition, type, tileSize, tileset);
     tileCover(definition, type, tileSize, tileset.zoomRange, [&](const auto& tile) {
         status.requiredResourceCount++;
         status.requiredTileCount++;
@@ -515,15 +624,27 @@ void OfflineDownload::ensureResource(Resource&& resource, std::function<void(Res
             return;
         }
 
+        const auto requested = util::MonotonicTimer::now();
         auto fileRequestsIt = requests.insert(requests.begin(), nullptr);
         *fileRequestsIt = onlineFileSource.request(resource, [=, this](const Response& onlineResponse) {
+            const auto latency = util::MonotonicTimer::now() - requested;
+
             if (onlineResponse.error) {
                 observer->responseError(*onlineResponse.error);
-                if (onlineResponse.error->reason == Response::Error::Reason::NotFound) {
+                const bool notFound = onlineResponse.error->reason == Response::Error::Reason::NotFound;
+                // Anything but a 404 is retried by the online file source and counts as a failure
+                const bool windowComplete = recordResponse(latency, !notFound, 0, false);
+                if (notFound) {
                     // On error 404, we skip this request and go further.
                     requests.erase(fileRequestsIt);
                     assert(status.requiredResourceCount > 0);
                     status.requiredResourceCount--;
+                }
+                if (windowComplete) {
+                    if (!flushResourcesBuffer()) return;
+                    completeWindow();
+                }
+                if (notFound) {
                     continueDownload();
                 }
                 return;
@@ -538,11 +659,19 @@ void OfflineDownload::ensureResource(Resource&& resource, std::function<void(Res
             // Queue up for batched insertion
             buffer.emplace_back(resource, onlineResponse);
 
-            // Flush buffer periodically.
+            const bool windowComplete = recordResponse(latency,
+                                                       false,
+                                                       onlineResponse.data ? onlineResponse.data->size() : 0,
+                                                       resource.kind == Resource::Kind::Tile);
+
+            // Flush buffer once per window of responses.
             // Have to keep `resourcesRemaining.empty()` as the following
             // condition would fail otherwise.
             // TODO: Simplify the tile count limit check code path!
-            if ((buffer.size() == kResourcesBatchSize || resourcesRemaining.empty()) && !flushResourcesBuffer()) return;
+            if ((windowComplete || resourcesRemaining.empty()) && !flushResourcesBuffer()) return;
+            if (windowComplete) {
+                completeWindow();
+            }
 
             if (offlineDatabase.exceedsOfflineMapboxTileCountLimit(resource)) {
                 onMapboxTileCountLimitExceeded();
@@ -1,4 +1,5 @@
 #include <mbgl/platform/settings.hpp>
+#include <mbgl/storage/file_source_manager.hpp>
 #include <mbgl/storage/file_source_request.hpp>
 #include <mbgl/storage/http_file_source.hpp>
 #include <mbgl/storage/network_status.hpp>
@@ -17,16 +18,20 @@
 #include <mbgl/util/exception.hpp>
 #include <mbgl/util/http_timeout.hpp>
 #include <mbgl/util/mapbox.hpp>
+#include <mbgl/util/monotonic_timer.hpp>
 #include <mbgl/util/noncopyable.hpp>
 #include <mbgl/util/platform.hpp>
 #include <mbgl/util/run_loop.hpp>
+#include <mbgl/util/string.hpp>
 #include <mbgl/util/thread.hpp>
 #include <mbgl/util/timer.hpp>
 
 #include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <list>
 #include <map>
+#include <mutex>
 #include <utility>
 
 namespace mbgl {
@@ -54,6 +59,13 @@ struct OnlineFileRequest {
     Duration getUpdateInterval(std::optional<Timestamp> expires) const;
     OnlineFileSourceThread& impl;
     Resource resource;
+    // Whether the request was queued or activated as a revalidation, see `isRevalidation()`
+    bool revalidation = false;
+    // The class the network metrics of the request are accounted to, see `NetworkEstimator`
+    const std::string requestClass;
+    // When the request was ready to be sent, and when it was
+    std::chrono::duration<double> queuedAt{};
+    std::chrono::duration<double> activatedAt{};
     std::unique_ptr<AsyncRequest> request;
     util::Timer timer;
     Callback callback;
@@ -73,11 +85,228 @@ struct OnlineFileRequest {
     std::optional<Timestamp> retryAfter;
 };
 
+/*
+   Network requests for the same URL, range and validators that are in flight at
+   the same time share one HTTP request, e.g. when several maps or sources ask for
+   the same tile. Its response, and the data it holds, are passed to every waiting
+   request. The HTTP request is cancelled once all of them have been cancelled.
+*/
+class CoalescedHTTPRequests {
+public:
+    explicit CoalescedHTTPRequests(FileSource& httpFileSource_)
+        : httpFileSource(httpFileSource_) {}
+
+    std::unique_ptr<AsyncRequest> request(const Resource& resource, FileSource::Callback callback) {
+        auto key = makeKey(resource);
+        auto it = inFlight.find(key);
+        if (it == inFlight.end()) {
+            auto shared = std::make_shared<Shared>();
+            it = inFlight.emplace(key, shared).first;
+            shared->request = httpFileSource.request(resource, [this, key](const Response& response) {
+                respond(key, response);
+            });
+        }
+        return std::make_unique<Waiter>(*this, it->first, it->second, std::move(callback));
+    }
+
+private:
+    class Waiter;
+
+    struct Shared {
+        std::unique_ptr<AsyncRequest> request;
+        std::list<Waiter*> waiters;
+    };
+
+    class Waiter : public AsyncRequest {
+    public:
+        Waiter(CoalescedHTTPRequests& parent_,
+               std::string key_,
+               std::shared_ptr<Shared> shared_,
+               FileSource::Callback callback_)
+            : parent(parent_),
+              key(std::move(key_)),
+              shared(std::move(shared_)),
+              link(shared->waiters.insert(shared->waiters.end(), this)),
+              callback(std::move(callback_)) {}
+
+        ~Waiter() override {
+            if (shared) {
+                shared->waiters.erase(link);
+                if (shared->waiters.empty() && shared->request) {
+                    parent.inFlight.erase(key);
+                }
+            }
+        }
+
+        CoalescedHTTPRequests& parent;
+        const std::string key;
+        // Reset once the response is being delivered
+        std::shared_ptr<Shared> shared;
+        std::list<Waiter*>::iterator link;
+        FileSource::Callback callback;
+    };
+
+    static std::string makeKey(const Resource& resource) {
+        std::string key = resource.url;
+        key += '\n';
+        if (resource.dataRange) {
+            key += util::toString(resource.dataRange->first) + '-' + util::toString(resource.dataRange->second);
+        }
+        key += '\n';
+        if (resource.priorEtag) {
+            key += *resource.priorEtag;
+        } else if (resource.priorModified) {
+            key += util::rfc1123(*resource.priorModified);
+        }
+        return key;
+    }
+
+    void respond(std::string key, const Response& response) {
+        auto it = inFlight.find(key);
+        assert(it != inFlight.end());
+        // Keep the state alive while waiters cancel each other from their callbacks
+        auto shared = it->second;
+        inFlight.erase(it);
+        shared->request.reset();
+
+        while (!shared->waiters.empty()) {
+            Waiter* waiter = shared->waiters.front();
+            shared->waiters.pop_front();
+            waiter->shared.reset();
+            // Calling `callback` may result in deleting the waiter
+            auto callback = waiter->callback;
+            callback(response);
+        }
+    }
+
+    FileSource& httpFileSource;
+    std::map<std::string, std::shared_ptr<Shared>> inFlight;
+};
+
+/*
+   Estimates the round-trip time and bandwidth of the network from the requests that
+   completed, and keeps their latency and size per request class: the resource kind, or
+   the URL template for tiles, so that the tiles of a raster source and of a vector source
+   are told apart. The estimates are read on other threads for the metrics property.
+
+   The round-trip time follows the latency of small responses. The bandwidth follows the
+   throughput of large ones, multiplied by the number of requests sharing the link when
+   they completed.
+*/
+class NetworkEstimator {
+public:
+    static std::string requestClass(const Resource& resource) {
+        switch (resource.kind) {
+            case Resource::Kind::Style:
+                return "style";
+            case Resource::Kind::Source:
+                return "source";
+            case Resource::Kind::Tile:
+                return resource.tileData ? "tile:" + resource.tileData->urlTemplate : "tile";
+            case Resource::Kind::Glyphs:
+                return "glyphs";
+            case Resource::Kind::SpriteImage:
+                return "sprite-image";
+            case Resource::Kind::SpriteJSON:
+                return "sprite-json";
+            case Resource::Kind::Image:
+                return "image";
+            case Resource::Kind::Unknown:
+                break;
+        }
+        return "unknown";
+    }
+
+    void add(const std::string& requestClass, std::size_t bytes, double seconds, std::size_t concurrentRequests) {
+        std::scoped_lock lock(mutex);
+        auto& stats = classes[requestClass];
+        stats.requests++;
+        stats.bytes += bytes;
+        stats.averageBytes = average(stats.averageBytes, static_cast<double>(bytes));
+        stats.averageLatency = average(stats.averageLatency, seconds);
+        averageBytes = average(averageBytes, static_cast<double>(bytes));
+
+        if (bytes <= smallResponseBytes || (rtt > 0 && seconds < rtt)) {
+            rtt = average(rtt, seconds);
+        }
+        if (bytes >= largeResponseBytes) {
+            // Leave out the round trip, but don't let a bad estimate of it inflate the sample
+            const double transfer = std::max(seconds - rtt, seconds * 0.1);
+            if (transfer > 0) {
+                bandwidth = average(bandwidth, static_cast<double>(bytes * concurrentRequests) / transfer);
+            }
+        }
+    }
+
+    // Enough requests to fill the bandwidth-delay product of the link with responses of the
+    // average size, with some headroom for the noise of the estimates. More only queue up at
+    // the bottleneck and delay the responses that are needed first.
+    uint32_t concurrencyLimit(uint32_t maximum) const {
+        std::scoped_lock lock(mutex);
+        if (rtt <= 0 || bandwidth <= 0 || averageBytes <= 0) {
+            return maximum;
+        }
+        const double limit = 2.0 * std::ceil(1.0 + bandwidth * rtt / averageBytes);
+        return static_cast<uint32_t>(
+            std::clamp<double>(limit, std::min(minimumConcurrency, maximum), std::max(maximum, 1u)));
+    }
+
+    // Seconds a request of the class is expected to take, 0 until the estimates are known
+    double expectedTime(const std::string& requestClass) const {
+        std::scoped_lock lock(mutex);
+        const auto it = classes.find(requestClass);
+        const double bytes = it != classes.end() ? it->second.averageBytes : averageBytes;
+        return rtt + (bandwidth > 0 ? bytes / bandwidth : 0.0);
+    }
+
+    mapbox::base::Value metrics(uint32_t concurrency) const {
+        std::scoped_lock lock(mutex);
+        mapbox::base::ValueObject perClass;
+        for (const auto& [name, stats] : classes) {
+            perClass.emplace(name,
+                             mapbox::base::ValueObject{{"requests", stats.requests},
+                                                       {"bytes", stats.bytes},
+                                                       {"average-bytes", stats.averageBytes},
+                                                       {"latency-ms", stats.averageLatency * 1000.0}});
+        }
+        return mapbox::base::ValueObject{{"rtt-ms", rtt * 1000.0},
+                                         {"bandwidth", bandwidth},
+                                         {"concurrency", uint64_t{concurrency}},
+                                         {"classes", std::move(perClass)}};
+    }
+
+private:
+    struct ClassStats {
+        uint64_t requests = 0;
+        uint64_t bytes = 0;
+        double averageBytes = 0;
+        double averageLatency = 0;
+    };
+
+    static double average(double current, double sample) {
+        return current > 0 ? current + smoothing * (sample - current) : sample;
+    }
+
+    static constexpr double smoothing = 0.2;
+    static constexpr std::size_t smallResponseBytes = 2 * 1024;
+    static constexpr std::size_t largeResponseBytes = 16 * 1024;
+    static constexpr uint32_t minimumConcurrency = 2;
+
+    mutable std::mutex mutex;
+    std::map<std::string, ClassStats> classes;
+    double rtt = 0;          // seconds
+    double bandwidth = 0;    // bytes per second
+    double averageBytes = 0; // of all responses
+};
+
 class OnlineFileSourceThread {
 public:
-    OnlineFileSourceThread(const ResourceOptions& resourceOptions_, const ClientOptions& clientOptions_)
+    OnlineFileSourceThread(const ResourceOptions& resourceOptions_,
+                           const ClientOptions& clientOptions_,
+                           std::shared_ptr<NetworkEstimator> estimator_)
         : resourceOptions(resourceOptions_.clone()),
           clientOptions(clientOptions_.clone()),
+          estimator(std::move(estimator_)),
           httpFileSource(resourceOptions_, clientOptions_) {
         NetworkStatus::Subscribe(&reachability);
         setMaximumConcurrentRequests(util::DEFAULT_MAXIMUM_CONCURRENT_REQUESTS);
@@ -117,6 +346,9 @@ public:
     void remove(OnlineFileRequest* req) {
         allRequests.erase(req);
         if (activeRequests.erase(req)) {
+            if (req->revalidation) {
+                activeRevalidations--;
+            }
             activatePendingRequest();
         } else {
             pendingRequests.remove(req);
@@ -128,7 +360,10 @@ public:
         assert(!activeRequests.contains(req));
         assert(!req->request);
 
-        if (activeRequests.size() >= getMaximumConcurrentRequests()) {
+        req->revalidation = isRevalidation(*req);
+        req->queuedAt = util::MonotonicTimer::now();
+        if (activeRequests.size() >= getConcurrencyLimit() ||
+            (req->revalidation && activeRevalidations >= maximumConcurrentRevalidations)) {
             queueRequest(req);
         } else {
             activateRequest(req);
@@ -139,16 +374,34 @@ public:
 
     void activateRequest(OnlineFileRequest* req) {
         auto callback = [=, this](const Response& response) {
+            const auto now = util::MonotonicTimer::now();
+            if (online && !response.error) {
+                const std::size_t bytes = response.data ? response.data->size() : 0;
+                estimator->add(req->requestClass, bytes, (now - req->activatedAt).count(), activeRequests.size());
+            }
+            FileSourceManager::get()->getMetrics().record(
+                req->resource,
+                FileSourceMetrics::Origin::Network,
+                response,
+                std::chrono::duration_cast<Duration>(now - req->queuedAt),
+                std::chrono::duration_cast<Duration>(req->activatedAt - req->queuedAt));
             activeRequests.erase(req);
+            if (req->revalidation) {
+                activeRevalidations--;
+            }
             req->request.reset();
             req->completed(response);
             activatePendingRequest();
         };
 
         activeRequests.insert(req);
+        if (req->revalidation) {
+            activeRevalidations++;
+        }
+        req->activatedAt = util::MonotonicTimer::now();
 
         if (online) {
-            req->request = httpFileSource.request(req->resource, callback);
+            req->request = coalescedRequests.request(req->resource, callback);
         } else {
             Response response;
             response.error = std::make_unique<Response::Error>(Response::Error::Reason::Connection,
@@ -158,9 +411,13 @@ public:
     }
 
     void activatePendingRequest() {
-        auto req = pendingRequests.pop();
-
-        if (req) {
+        // Revalidations held back by their own limit may leave more than one connection free
+        while (activeRequests.size() < getConcurrencyLimit()) {
+            auto req = pendingRequests.pop(activeRevalidations < maximumConcurrentRevalidations,
+                                           adaptiveConcurrency ? estimator.get() : nullptr);
+            if (!req) {
+                break;
+            }
             activateRequest(*req);
         }
     }
@@ -192,6 +449,22 @@ public:
         maximumConcurrentRequests = maximumConcurrentRequests_;
     }
 
+    // The maximum, or fewer when adapting to the estimated bandwidth-delay product
+    uint32_t getConcurrencyLimit() const {
+        return adaptiveConcurrency ? estimator->concurrencyLimit(maximumConcurrentRequests)
+                                   : maximumConcurrentRequests;
+    }
+
+    void setAdaptiveConcurrency(bool enable) {
+        adaptiveConcurrency = enable;
+        activatePendingRequest();
+    }
+
+    void setMaximumConcurrentRevalidations(uint32_t maximumConcurrentRevalidations_) {
+        maximumConcurrentRevalidations = maximumConcurrentRevalidations_;
+        activatePendingRequest();
+    }
+
     void setAPIBaseURL(std::string t) {
         resourceOptions.withTileServerOptions(TileServerOptions().withBaseURL(std::move(t)));
     }
@@ -204,6 +477,14 @@ public:
 private:
     friend struct OnlineFileRequest;
 
+    // A conditional request for data that the requester already has, e.g. an expired tile that
+    // is still shown. These only have their own limit when one is set.
+    bool isRevalidation(const OnlineFileRequest& req) const {
+        const auto& resource = req.resource;
+        return maximumConcurrentRevalidations > 0 && (resource.priorEtag || resource.priorModified) &&
+               !resource.priorData;
+    }
+
     void networkIsReachableAgain() {
         // Notify regular priority requests.
         for (auto& req : allRequests) {
@@ -223,13 +504,22 @@ private:
     // Using Pending Requests as an priority queue which processes
     // file requests in a FIFO manner but prefers regular requests
     // over offline requests with a low priority such that low priority
-    // requests do not throttle regular requests.
+    // requests do not throttle regular requests. Revalidations are queued
+    // with the low priority requests.
     //
     // The order of a queue is therefore:
     //
     // hi0 -- hi1 -- hi2 -- hi3 -- lo0 -- lo1 --lo2
     //                              ^
     //                              firstLowPriorityRequest
+    //
+    // Within each of the two groups, the request with the lowest rank is
+    // popped first, ties going to the oldest. Ranks are shared with the
+    // requesters and may change while queued, so they are read when popping
+    // rather than kept sorted; the scan is linear in the group's length.
+    // Revalidations are skipped while their limit is reached. With adaptive
+    // concurrency, ranks are weighed by the time the request is expected to
+    // take, so that small resources go ahead of large ones of similar rank.
 
     struct PendingRequests {
         PendingRequests()
@@ -249,7 +539,7 @@ private:
         }
 
         void insert(OnlineFileRequest* request) {
-            if (request->resource.priority == Resource::Priority::Regular) {
+            if (request->resource.priority == Resource::Priority::Regular && !request->revalidation) {
                 firstLowPriorityRequest = queue.insert(firstLowPriorityRequest, request);
                 firstLowPriorityRequest++;
             } else {
@@ -261,23 +551,48 @@ private:
             }
         }
 
-        std::optional<OnlineFileRequest*> pop() {
-            if (queue.empty()) {
+        std::optional<OnlineFileRequest*> pop(bool allowRevalidations, const NetworkEstimator* estimator) {
+            auto next = queue.end();
+            float nextRank = 0.0f;
+            for (auto it = queue.begin(); it != queue.end(); ++it) {
+                if (next != queue.end() && (it == firstLowPriorityRequest || nextRank <= 0.0f)) {
+                    break;
+                }
+                if ((*it)->revalidation && !allowRevalidations) {
+                    continue;
+                }
+                if (const float itRank = rank(*it, estimator); next == queue.end() || itRank < nextRank) {
+                    next = it;
+                    nextRank = itRank;
+                }
+            }
+
+            if (next == queue.end()) {
                 return {};
             }
 
-            if (queue.begin() == firstLowPriorityRequest) {
+            if (next == firstLowPriorityRequest) {
                 firstLowPriorityRequest++;
             }
 
-            OnlineFileRequest* next = queue.front();
-            queue.pop_front();
-            return {next};
+            OnlineFileRequest* request = *next;
+            queue.erase(next);
+            return {request};
         }
 
         bool contains(OnlineFileRequest* request) const {
             return (std::find(queue.begin(), queue.end(), request) != queue.end());
         }
+
+        static float rank(const OnlineFileRequest* request, const NetworkEstimator* estimator) {
+            const float rank = request->resource.rank ? request->resource.rank->load(std::memory_order_relaxed)
+                                                      : 0.0f;
+            if (!estimator) {
+                return rank;
+            }
+            const auto expectedTime = static_cast<float>(estimator->expectedTime(request->requestClass));
+            return (rank + 1.0f) * std::max(expectedTime, std::numeric_limits<float>::min());
+        }
     };
 
     ResourceTransform resourceTransform;
@@ -302,9 +617,15 @@ private:
 
     std::set<OnlineFileRequest*> activeRequests;
 
+    const std::shared_ptr<NetworkEstimator> estimator;
+
     bool online = true;
+    bool adaptiveConcurrency = false;
     uint32_t maximumConcurrentRequests;
+    uint32_t maximumConcurrentRevalidations = 0;
+    uint32_t activeRevalidations = 0;
     HTTPFileSource httpFileSource;
+    CoalescedHTTPRequests coalescedRequests{httpFileSource};
     util::AsyncTask reachability{std::bind(&OnlineFileSourceThread::networkIsReachableAgain, this)};
     std::map<AsyncRequest*, std::unique_ptr<OnlineFileRequest>> tasks;
 };
@@ -318,7 +639,8 @@ public:
               util::makeThreadPrioritySetter(platform::EXPERIMENTAL_THREAD_PRIORITY_NETWORK),
               "OnlineFileSource",
               resourceOptions.clone(),
-              clientOptions.clone())) {}
+              clientOptions.clone(),
+              estimator)) {}
 
     std::unique_ptr<AsyncRequest> request(Callback callback, Resource res) {
         auto req = std::make_unique<FileSourceRequest>(std::move(callback));
@@ -383,6 +705,50 @@ public:
         return cachedMaximumConcurrentRequests;
     }
 
+    void setMaximumConcurrentRevalidations(const mapbox::base::Value& value) {
+        if (auto* maximumConcurrentRevalidations = value.getUint()) {
+            assert(*maximumConcurrentRevalidations < std::numeric_limits<uint32_t>::max());
+            const auto maxConcurrentRevalidations = static_cast<uint32_t>(*maximumConcurrentRevalidations);
+            thread->actor().invoke(&OnlineFileSourceThread::setMaximumConcurrentRevalidations,
+                                   maxConcurrentRevalidations);
+            {
+                std::scoped_lock lock(maximumConcurrentRequestsMutex);
+                cachedMaximumConcurrentRevalidations = maxConcurrentRevalidations;
+            }
+        } else {
+            Log::Error(Event::General, "Invalid max-concurrent-revalidations property value type.");
+        }
+    }
+
+    uint32_t getMaximumConcurrentRevalidations() const {
+        std::scoped_lock lock(maximumConcurrentRequestsMutex);
+        return cachedMaximumConcurrentRevalidations;
+    }
+
+    void setAdaptiveConcurrency(const mapbox::base::Value& value) {
+        if (auto* adaptiveConcurrency = value.getBool()) {
+            thread->actor().invoke(&OnlineFileSourceThread::setAdaptiveConcurrency, *adaptiveConcurrency);
+            {
+                std::scoped_lock lock(maximumConcurrentRequestsMutex);
+                cachedAdaptiveConcurrency = *adaptiveConcurrency;
+            }
+        } else {
+            Log::Error(Event::General, "Invalid adaptive-concurrency property value type.");
+        }
+    }
+
+    bool getAdaptiveConcurrency() const {
+        std::scoped_lock lock(maximumConcurrentRequestsMutex);
+        return cachedAdaptiveConcurrency;
+    }
+
+    mapbox::base::Value getNetworkMetrics() const {
+        std::scoped_lock lock(maximumConcurrentRequestsMutex);
+        return estimator->metrics(cachedAdaptiveConcurrency
+                                      ? estimator->concurrencyLimit(cachedMaximumConcurrentRequests)
+                                      : cachedMaximumConcurrentRequests);
+    }
+
     void setApiKey(const mapbox::base::Value& value) {
         if (auto* apiKey = value.getString()) {
             thread->actor().invoke(&OnlineFileSourceThread::setApiKey, *apiKey);
@@ -426,12 +792,16 @@ private:
 
     mutable std::mutex maximumConcurrentRequestsMutex;
     uint32_t cachedMaximumConcurrentRequests = util::DEFAULT_MAXIMUM_CONCURRENT_REQUESTS;
+    uint32_t cachedMaximumConcurrentRevalidations = 0;
+    bool cachedAdaptiveConcurrency = false;
+    const std::shared_ptr<NetworkEstimator> estimator = std::make_shared<NetworkEstimator>();
     const std::unique_ptr<util::Thread<OnlineFileSourceThread>> thread;
 };
 
 OnlineFileRequest::OnlineFileRequest(Resource resource_, Callback callback_, OnlineFileSourceThread& impl_)
     : impl(impl_),
       resource(std::move(resource_)),
+      requestClass(NetworkEstimator::requestClass(resource)),
       callback(std::move(callback_)) {
     impl.add(this);
 }
@@ -674,6 +1044,10 @@ void OnlineFileSource::setProperty(const std::string& key, const mapbox::base::V
         impl->setAPIBaseURL(value);
     } else if (key == MAX_CONCURRENT_REQUESTS_KEY) {
         impl->setMaximumConcurrentRequests(value);
+    } else if (key == MAX_CONCURRENT_REVALIDATIONS_KEY) {
+        impl->setMaximumConcurrentRevalidations(value);
+    } else if (key == ADAPTIVE_CONCURRENCY_KEY) {
+        impl->setAdaptiveConcurrency(value);
     } else if (key == ONLINE_STATUS_KEY) {
         // For testing only
         if (auto* boolValue = value.getBool()) {
@@ -692,6 +1066,12 @@ mapbox::base::Value OnlineFileSource::getProperty(const std::string& key) const
         return impl->getAPIBaseURL();
     } else if (key == MAX_CONCURRENT_REQUESTS_KEY) {
         return impl->getMaximumConcurrentRequests();
+    } else if (key == MAX_CONCURRENT_REVALIDATIONS_KEY) {
+        return impl->getMaximumConcurrentRevalidations();
+    } else if (key == ADAPTIVE_CONCURRENCY_KEY) {
+        return impl->getAdaptiveConcurrency();
+    } else if (key == NETWORK_METRICS_KEY) {
+        return impl->getNetworkMetrics();
     }
     std::string message = "Resource provider does not support property " + key;
     Log::Error(Event::General, message.c_str());
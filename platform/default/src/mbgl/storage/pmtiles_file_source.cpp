@@ -1,5 +1,11 @@
+#include <algorithm>
+#include <atomic>
 #include <sstream>
+#include <list>
 #include <map>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
 
 #include <mbgl/platform/settings.hpp>
 #include <mbgl/storage/file_source_manager.hpp>
@@ -17,12 +23,20 @@
 #include <mbgl/util/chrono.hpp>
 #include <mbgl/util/compression.hpp>
 #include <mbgl/util/filesystem.hpp>
+#include <mbgl/util/hash.hpp>
+#include <mbgl/util/logging.hpp>
 
 #include <pmtiles.hpp>
 
 #include <sys/types.h>
 #include <sys/stat.h>
 
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 #if defined(__QT__) && (defined(_WIN32) || defined(__EMSCRIPTEN__))
 #include <QtZlib/zlib.h>
 #else
@@ -33,10 +47,17 @@ namespace {
 // https://github.com/protomaps/PMTiles/blob/main/spec/v3/spec.md#3-header
 constexpr int pmtilesHeaderOffset = 0;
 constexpr int pmtilesHeaderLength = 127;
+// The root directory is required to fit in the first 16 KiB, so remote archives fetch both at once
+constexpr int pmtilesHeaderAndRootLength = 16384;
+
+// Default byte budget of the decoded directories shared by all sources, enough for the root and a
+// few hundred leaf directories of a planet-scale archive
+constexpr uint64_t DEFAULT_DIRECTORY_CACHE_SIZE = 64 * 1024 * 1024;
 
-// To avoid allocating lots of memory with PMTiles directory caching,
-// set a limit so it doesn't grow unlimited
-constexpr int MAX_DIRECTORY_CACHE_ENTRIES = 100;
+// Remote ranges requested together are merged into a single range request when they're at most
+// this far apart, such as the tiles of a visible tile cover in a clustered archive
+constexpr uint64_t MAX_COALESCED_RANGE_GAP = 16 * 1024;
+constexpr uint64_t MAX_COALESCED_RANGE_LENGTH = 1024 * 1024;
 
 bool acceptsURL(const std::string& url) {
     return url.starts_with(mbgl::util::PMTILES_PROTOCOL);
@@ -45,6 +66,173 @@ bool acceptsURL(const std::string& url) {
 std::string extract_url(const std::string& url) {
     return url.substr(std::char_traits<char>::length(mbgl::util::PMTILES_PROTOCOL));
 }
+
+// A read-only mapping of a whole local archive. PMTiles archives are treated as immutable while
+// in use, like the header and directory caches already do.
+class MappedFile {
+public:
+    static std::shared_ptr<const MappedFile> open(const std::string& path) {
+#if defined(_WIN32)
+        (void)path;
+        return nullptr;
+#else
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            return nullptr;
+        }
+
+        struct stat info {};
+        void* address = MAP_FAILED;
+        if (::fstat(fd, &info) == 0 && info.st_size > 0) {
+            address = ::mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        }
+        // The mapping stays valid after the descriptor is closed
+        ::close(fd);
+        if (address == MAP_FAILED) {
+            return nullptr;
+        }
+
+        // Tiles and leaf directories are read in no particular order
+        ::madvise(address, static_cast<size_t>(info.st_size), MADV_RANDOM);
+
+        return std::make_shared<const MappedFile>(static_cast<const char*>(address),
+                                                  static_cast<uint64_t>(info.st_size),
+                                                  mbgl::Timestamp(mbgl::Seconds(info.st_mtime)));
+#endif
+    }
+
+    MappedFile(const char* data_, uint64_t size_, mbgl::Timestamp modified_)
+        : data(data_),
+          size(size_),
+          modified(modified_) {}
+
+    ~MappedFile() {
+#if !defined(_WIN32)
+        ::munmap(const_cast<char*>(data), static_cast<size_t>(size));
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /// The requested bytes, or nothing if they reach past the end of the file
+    std::optional<std::string_view> read(uint64_t offset, uint64_t length) const {
+        if (offset > size || length > size - offset) {
+            return std::nullopt;
+        }
+        return std::string_view(data + offset, static_cast<size_t>(length));
+    }
+
+    const char* const data;
+    const uint64_t size;
+    const mbgl::Timestamp modified;
+};
+
+// Identifies a directory by its archive and byte range
+struct DirectoryKey {
+    std::string archive;
+    uint64_t offset;
+    uint64_t length;
+
+    bool operator==(const DirectoryKey&) const = default;
+};
+
+struct DirectoryKeyHash {
+    std::size_t operator()(const DirectoryKey& key) const noexcept {
+        return mbgl::util::hash(key.archive, key.offset, key.length);
+    }
+};
+
+using Directory = std::shared_ptr<const std::vector<pmtiles::entryv3>>;
+
+// Decoded directories of every archive in the process, shared by all PMTiles file sources. Once
+// their total size exceeds the budget, the least recently used directories are evicted; sources
+// keep using the directories they hold.
+class DirectoryCache {
+public:
+    static DirectoryCache& getInstance() {
+        static DirectoryCache instance;
+        return instance;
+    }
+
+    Directory get(const DirectoryKey& key) {
+        std::scoped_lock lock(mutex);
+        const auto it = index.find(key);
+        if (it == index.end()) {
+            misses++;
+            return nullptr;
+        }
+
+        hits++;
+        entries.splice(entries.end(), entries, it->second);
+        return it->second->directory;
+    }
+
+    void put(const DirectoryKey& key, Directory directory) {
+        const uint64_t entrySize = key.archive.size() + directory->size() * sizeof(pmtiles::entryv3);
+
+        std::scoped_lock lock(mutex);
+        // Another source may have decoded it in the meantime
+        if (entrySize > maximumSize || index.contains(key)) {
+            return;
+        }
+
+        entries.push_back({.key = key, .directory = std::move(directory), .size = entrySize});
+        index.emplace(key, std::prev(entries.end()));
+        size += entrySize;
+        evict();
+    }
+
+    void setMaximumSize(uint64_t maximumSize_) {
+        std::scoped_lock lock(mutex);
+        maximumSize = maximumSize_;
+        evict();
+    }
+
+    uint64_t getMaximumSize() const {
+        std::scoped_lock lock(mutex);
+        return maximumSize;
+    }
+
+    uint64_t getSize() const {
+        std::scoped_lock lock(mutex);
+        return size;
+    }
+
+    uint64_t getHits() const {
+        std::scoped_lock lock(mutex);
+        return hits;
+    }
+
+    uint64_t getMisses() const {
+        std::scoped_lock lock(mutex);
+        return misses;
+    }
+
+private:
+    struct Entry {
+        DirectoryKey key;
+        Directory directory;
+        uint64_t size;
+    };
+
+    void evict() {
+        while (size > maximumSize) {
+            size -= entries.front().size;
+            index.erase(entries.front().key);
+            entries.pop_front();
+        }
+    }
+
+    mutable std::mutex mutex;
+    // Least recently used first
+    std::list<Entry> entries;
+    std::unordered_map<DirectoryKey, std::list<Entry>::iterator, DirectoryKeyHash> index;
+    uint64_t maximumSize = DEFAULT_DIRECTORY_CACHE_SIZE;
+    uint64_t size = 0;
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+};
 } // namespace
 
 // temporary, remove this when it's available in `pmtiles.hpp`
@@ -56,19 +244,32 @@ namespace mbgl {
 using namespace rapidjson;
 
 using AsyncCallback = std::function<void(std::unique_ptr<Response::Error>)>;
+using AsyncDirectoryCallback = std::function<void(Directory, std::unique_ptr<Response::Error>)>;
 using AsyncTileCallback = std::function<void(std::pair<uint64_t, uint32_t>, std::unique_ptr<Response::Error>)>;
+// Receives the response to a range request along with its data, which is only valid during the call
+using AsyncRangeCallback = std::function<void(const Response&, std::string_view)>;
 
 class PMTilesFileSource::Impl {
 public:
-    explicit Impl(const ActorRef<Impl>&, const ResourceOptions& resourceOptions_, const ClientOptions& clientOptions_)
-        : resourceOptions(resourceOptions_.clone()),
-          clientOptions(clientOptions_.clone()) {}
+    explicit Impl(const ActorRef<Impl>& self_,
+                  const ResourceOptions& resourceOptions_,
+                  const ClientOptions& clientOptions_,
+                  std::shared_ptr<std::atomic<uint64_t>> rangeRequests_)
+        : self(self_),
+          resourceOptions(resourceOptions_.clone()),
+          clientOptions(clientOptions_.clone()),
+          rangeRequests(std::move(rangeRequests_)) {
+        const auto value = platform::Settings::getInstance().get(platform::EXPERIMENTAL_PMTILES_MMAP);
+        if (const auto* mmap = value.getBool()) {
+            mapLocalFiles = *mmap;
+        }
+    }
 
     // Generate a tilejson resource from .pmtiles file
-    void request_tilejson(AsyncRequest* req, const Resource& resource, const ActorRef<FileSourceRequest>& ref) {
+    void request_tilejson(const Resource& resource, const ActorRef<FileSourceRequest>& ref) {
         auto url = extract_url(resource.url);
 
-        getMetadata(url, req, [=, this](std::unique_ptr<Response::Error> error) {
+        getMetadata(url, [=, this](std::unique_ptr<Response::Error> error) {
             Response response;
 
             if (error) {
@@ -83,10 +284,10 @@ public:
     }
 
     // Load data for specific tile
-    void request_tile(AsyncRequest* req, const Resource& resource, ActorRef<FileSourceRequest> ref) {
+    void request_tile(const Resource& resource, ActorRef<FileSourceRequest> ref) {
         auto url = extract_url(resource.url);
 
-        getHeader(url, req, [=, this](std::unique_ptr<Response::Error> error) {
+        getHeader(url, [=, this](std::unique_ptr<Response::Error> error) {
             if (error) {
                 Response response;
                 response.noContent = true;
@@ -121,7 +322,6 @@ public:
 
             getTileAddress(
                 url,
-                req,
                 tileID,
                 header.root_dir_offset,
                 static_cast<std::uint32_t>(header.root_dir_bytes),
@@ -142,12 +342,7 @@ public:
                         return;
                     }
 
-                    Resource tileResource(Resource::Kind::Source, url);
-                    tileResource.loadingMethod = Resource::LoadingMethod::Network;
-                    tileResource.dataRange = std::make_pair(tileAddress.first,
-                                                            tileAddress.first + tileAddress.second - 1);
-
-                    tasks[req] = getFileSource()->request(tileResource, [=](const Response& tileResponse) {
+                    auto onTileData = [=](const Response& tileResponse, std::string_view tileData) {
                         Response response;
                         response.noContent = true;
 
@@ -159,30 +354,30 @@ public:
                             return;
                         }
 
-                        response.data = tileResponse.data;
                         response.noContent = false;
                         response.modified = tileResponse.modified;
                         response.expires = tileResponse.expires;
                         response.etag = tileResponse.etag;
 
-                        if (header.tile_compression == pmtiles::COMPRESSION_GZIP) {
-                            // Support uncompressed tiles
-                            if (util::is_compressed(*tileResponse.data)) {
-                                try {
-                                    response.data = std::make_shared<std::string>(util::decompress(*tileResponse.data));
-                                } catch (const std::exception& e) {
-                                    response.error = std::make_unique<Response::Error>(
-                                        Response::Error::Reason::Other,
-                                        std::string("Error decompressing PMTiles tile: ") + e.what());
-                                }
-                            } else {
-                                response.data = tileResponse.data;
+                        // Support uncompressed tiles
+                        if (header.tile_compression == pmtiles::COMPRESSION_GZIP && util::is_compressed(tileData)) {
+                            try {
+                                response.data = std::make_shared<std::string>(util::decompress(tileData));
+                            } catch (const std::exception& e) {
+                                response.error = std::make_unique<Response::Error>(
+                                    Response::Error::Reason::Other,
+                                    std::string("Error decompressing PMTiles tile: ") + e.what());
                             }
+                        } else if (tileResponse.data) {
+                            response.data = tileResponse.data;
+                        } else {
+                            response.data = std::make_shared<std::string>(tileData);
                         }
 
                         ref.invoke(&FileSourceRequest::setResponse, response);
                         return;
-                    });
+                    };
+                    requestRange(url, tileAddress.first, tileAddress.second, std::move(onTileData));
                 });
         });
     }
@@ -208,17 +403,30 @@ public:
     }
 
 private:
+    // A remote range waiting to be merged with the others requested before the next flush
+    struct PendingRange {
+        uint64_t offset;
+        uint64_t length;
+        AsyncRangeCallback callback;
+    };
+
+    ActorRef<Impl> self;
     mutable std::mutex resourceOptionsMutex;
     mutable std::mutex clientOptionsMutex;
     ResourceOptions resourceOptions;
     ClientOptions clientOptions;
+    std::shared_ptr<std::atomic<uint64_t>> rangeRequests;
 
     std::shared_ptr<FileSource> fileSource;
     std::map<std::string, pmtiles::headerv3> header_cache;
     std::map<std::string, std::string> metadata_cache;
-    std::map<std::string, std::map<std::string, std::vector<pmtiles::entryv3>>> directory_cache;
-    std::map<std::string, std::vector<std::string>> directory_cache_control;
-    std::map<AsyncRequest*, std::unique_ptr<AsyncRequest>> tasks;
+    std::unordered_map<DirectoryKey, std::vector<AsyncDirectoryCallback>, DirectoryKeyHash> pending_directories;
+    std::map<std::string, std::vector<PendingRange>> pending_ranges;
+    std::map<uint64_t, std::unique_ptr<AsyncRequest>> range_tasks;
+    uint64_t nextRangeTaskID = 0;
+    bool flushScheduled = false;
+    std::map<std::string, std::shared_ptr<const MappedFile>> mapped_files;
+    bool mapLocalFiles = false;
 
     std::shared_ptr<FileSource> getFileSource() {
         if (!fileSource) {
@@ -229,19 +437,137 @@ private:
         return fileSource;
     }
 
-    void getHeader(const std::string& url, AsyncRequest* req, AsyncCallback callback) {
-        if (header_cache.contains(url)) {
-            callback(std::unique_ptr<Response::Error>());
+    // Returns the mapping of a local archive, when enabled and the file can be mapped
+    std::shared_ptr<const MappedFile> getMappedFile(const std::string& url) {
+        if (!mapLocalFiles || !url.starts_with(util::FILE_PROTOCOL)) {
+            return nullptr;
+        }
+
+        if (auto it = mapped_files.find(url); it != mapped_files.end()) {
+            return it->second;
+        }
+
+        // Failures aren't cached, the regular file source reports them and the file may show up later
+        auto mappedFile = MappedFile::open(
+            util::percentDecode(url.substr(std::char_traits<char>::length(util::FILE_PROTOCOL))));
+        if (mappedFile) {
+            mapped_files.emplace(url, mappedFile);
+        }
+        return mappedFile;
+    }
+
+    // Reads `length` bytes at `offset` of the archive. Local archives are read straight from their
+    // mapping when enabled, synchronously and without going through the file source. Other ranges
+    // are queued and fetched once the requests already in the mailbox have been handled, so the
+    // ranges needed for a whole tile cover can share range requests.
+    void requestRange(const std::string& url, uint64_t offset, uint64_t length, AsyncRangeCallback callback) {
+        if (auto mappedFile = getMappedFile(url)) {
+            Response response;
+            const auto data = mappedFile->read(offset, length);
+            if (data) {
+                response.modified = mappedFile->modified;
+            } else {
+                response.error = std::make_unique<Response::Error>(Response::Error::Reason::Other,
+                                                                   "range is outside of the file");
+            }
+            callback(response, data.value_or(std::string_view()));
+            return;
+        }
+
+        pending_ranges[url].push_back({.offset = offset, .length = length, .callback = std::move(callback)});
+        if (!flushScheduled) {
+            flushScheduled = true;
+            self.invoke(&Impl::flushRanges);
         }
+    }
+
+    void flushRanges() {
+        flushScheduled = false;
+        auto pending = std::move(pending_ranges);
+        pending_ranges.clear();
+
+        for (auto& [url, ranges] : pending) {
+            std::sort(ranges.begin(), ranges.end(), [](const PendingRange& a, const PendingRange& b) {
+                return a.offset < b.offset;
+            });
 
+            for (std::size_t first = 0; first < ranges.size();) {
+                const uint64_t begin = ranges[first].offset;
+                uint64_t end = begin + ranges[first].length;
+                std::size_t last = first + 1;
+                for (; last < ranges.size(); ++last) {
+                    const uint64_t rangeEnd = std::max(end, ranges[last].offset + ranges[last].length);
+                    if (ranges[last].offset > end + MAX_COALESCED_RANGE_GAP ||
+                        rangeEnd - begin > MAX_COALESCED_RANGE_LENGTH) {
+                        break;
+                    }
+                    end = rangeEnd;
+                }
+
+                fetchRanges(url,
+                            begin,
+                            end,
+                            std::vector<PendingRange>(std::make_move_iterator(ranges.begin() + first),
+                                                      std::make_move_iterator(ranges.begin() + last)));
+                first = last;
+            }
+        }
+    }
+
+    // Fetches `[begin, end)` with a single range request and hands each of `ranges` its part
+    void fetchRanges(const std::string& url, uint64_t begin, uint64_t end, std::vector<PendingRange> ranges) {
         Resource resource(Resource::Kind::Source, url);
         resource.loadingMethod = Resource::LoadingMethod::Network;
+        resource.dataRange = std::make_pair(begin, end - 1);
 
-        resource.dataRange = std::make_pair<uint64_t, uint64_t>(pmtilesHeaderOffset,
-                                                                pmtilesHeaderOffset + pmtilesHeaderLength - 1);
+        const uint64_t taskID = nextRangeTaskID++;
+        auto onResponse = [=, this, ranges = std::move(ranges)](const Response& response) {
+            const auto data = response.data ? std::string_view(*response.data) : std::string_view();
 
-        tasks[req] = getFileSource()->request(
-            resource, [=, this](const Response& response) { // NOLINT(clang-analyzer-cplusplus.NewDeleteLeaks)
+            if (response.error || ranges.size() == 1) {
+                // A lone range can use the response as is and share its data
+                for (const auto& range : ranges) {
+                    range.callback(response, data);
+                }
+            } else {
+                for (const auto& range : ranges) {
+                    Response part;
+                    part.modified = response.modified;
+                    part.expires = response.expires;
+                    part.etag = response.etag;
+
+                    const uint64_t offset = range.offset - begin;
+                    if (offset > data.size() || range.length > data.size() - offset) {
+                        part.error = std::make_unique<Response::Error>(Response::Error::Reason::Other,
+                                                                       "range is outside of the response");
+                        range.callback(part, std::string_view());
+                    } else {
+                        range.callback(part, data.substr(offset, range.length));
+                    }
+                }
+            }
+
+            range_tasks.erase(taskID);
+        };
+        rangeRequests->fetch_add(1, std::memory_order_relaxed);
+        range_tasks[taskID] = getFileSource()->request(resource, std::move(onResponse));
+    }
+
+    void getHeader(const std::string& url, AsyncCallback callback) {
+        if (header_cache.contains(url)) {
+            callback(std::unique_ptr<Response::Error>());
+            return;
+        }
+
+        // Mapped archives read the root directory from the mapping when it's needed instead
+        const uint64_t headerLength = getMappedFile(url) ? pmtilesHeaderLength : pmtilesHeaderAndRootLength;
+
+        requestRange(
+            url,
+            pmtilesHeaderOffset,
+            headerLength,
+            [=, this](const Response& response,
+                      std::string_view data) { // NOLINT(clang-analyzer-cplusplus.NewDeleteLeaks)
                 if (response.error) {
                     std::string message = std::string("Error fetching PMTiles header: ") + response.error->message;
 
@@ -261,7 +587,8 @@ private:
                 }
 
                 try {
-                    pmtiles::headerv3 header = pmtiles::deserialize_header(response.data->substr(0, 127));
+                    pmtiles::headerv3 header = pmtiles::deserialize_header(
+                        std::string(data.substr(0, pmtilesHeaderLength)));
 
                     if ((header.internal_compression != pmtiles::COMPRESSION_NONE &&
                          header.internal_compression != pmtiles::COMPRESSION_GZIP) ||
@@ -270,7 +597,22 @@ private:
                         throw std::runtime_error("Compression method not supported");
                     }
 
-                    header_cache.emplace(url, header);
+                    // Concurrent requests for the header share a range request and all end up here
+                    const bool inserted = header_cache.emplace(url, header).second;
+
+                    if (inserted && header.root_dir_offset + header.root_dir_bytes <= data.size()) {
+                        const auto rootData = data.substr(header.root_dir_offset, header.root_dir_bytes);
+                        try {
+                            storeDirectory({.archive = url,
+                                            .offset = header.root_dir_offset,
+                                            .length = header.root_dir_bytes},
+                                           header.internal_compression == pmtiles::COMPRESSION_GZIP
+                                               ? util::decompress(rootData)
+                                               : std::string(rootData));
+                        } catch (const std::exception&) {
+                            // Fetched and reported on its own when a tile needs it
+                        }
+                    }
 
                     callback(std::unique_ptr<Response::Error>());
                 } catch (const std::exception& e) {
@@ -280,14 +622,14 @@ private:
             });
     }
 
-    void getMetadata(std::string& url, AsyncRequest* req, AsyncCallback callback) {
+    void getMetadata(std::string& url, AsyncCallback callback) {
         if (metadata_cache.contains(url)) {
             callback(std::unique_ptr<Response::Error>());
+            return;
         }
 
         getHeader(
             url,
-            req,
             [=, this](std::unique_ptr<Response::Error> error) { // NOLINT(clang-analyzer-cplusplus.NewDeleteLeaks)
                 if (error) {
                     callback(std::move(error));
@@ -396,12 +738,7 @@ private:
                 };
 
                 if (header.json_metadata_bytes > 0) {
-                    Resource resource(Resource::Kind::Source, url);
-                    resource.loadingMethod = Resource::LoadingMethod::Network;
-                    resource.dataRange = std::make_pair(header.json_metadata_offset,
-                                                        header.json_metadata_offset + header.json_metadata_bytes - 1);
-
-                    tasks[req] = getFileSource()->request(resource, [=](const Response& responseMetadata) {
+                    auto onMetadata = [=](const Response& responseMetadata, std::string_view metadataData) {
                         if (responseMetadata.error) {
                             callback(std::make_unique<Response::Error>(
                                 responseMetadata.error->reason,
@@ -410,14 +747,11 @@ private:
                             return;
                         }
 
-                        std::string data = *responseMetadata.data;
-
-                        if (header.internal_compression == pmtiles::COMPRESSION_GZIP) {
-                            data = util::decompress(data);
-                        }
-
-                        parse_callback(data);
-                    });
+                        parse_callback(header.internal_compression == pmtiles::COMPRESSION_GZIP
+                                           ? util::decompress(metadataData)
+                                           : std::string(metadataData));
+                    };
+                    requestRange(url, header.json_metadata_offset, header.json_metadata_bytes, std::move(onMetadata));
 
                     return;
                 }
@@ -426,93 +760,78 @@ private:
             });
     }
 
-    void storeDirectory(const std::string& url,
-                        uint64_t directoryOffset,
-                        uint64_t directoryLength,
-                        const std::string& directoryData) {
-        if (!directory_cache.contains(url)) {
-            directory_cache.emplace(url, std::map<std::string, std::vector<pmtiles::entryv3>>());
-            directory_cache_control.emplace(url, std::vector<std::string>());
-        }
-
-        std::string directory_cache_key = url + "|" + std::to_string(directoryOffset) + "|" +
-                                          std::to_string(directoryLength);
-        directory_cache.at(url).emplace(directory_cache_key, pmtiles::deserialize_directory(directoryData));
-        directory_cache_control.at(url).emplace_back(directory_cache_key);
-
-        if (directory_cache_control.at(url).size() > MAX_DIRECTORY_CACHE_ENTRIES) {
-            directory_cache.at(url).erase(directory_cache_control.at(url).front());
-            directory_cache_control.at(url).erase(directory_cache_control.at(url).begin());
-        }
+    Directory storeDirectory(const DirectoryKey& key, const std::string& directoryData) {
+        auto directory = std::make_shared<const std::vector<pmtiles::entryv3>>(
+            pmtiles::deserialize_directory(directoryData));
+        DirectoryCache::getInstance().put(key, directory);
+        return directory;
     }
 
     void getDirectory(const std::string& url,
-                      AsyncRequest* req,
                       uint64_t directoryOffset,
                       uint32_t directoryLength,
-                      AsyncCallback callback) {
-        std::string directory_cache_key = url + "|" + std::to_string(directoryOffset) + "|" +
-                                          std::to_string(directoryLength);
-
-        if (directory_cache.contains(url) && directory_cache.at(url).contains(directory_cache_key)) {
-            if (directory_cache_control.at(url).back() != directory_cache_key) {
-                directory_cache_control.at(url).emplace_back(directory_cache_key);
-
-                for (auto it = directory_cache_control.at(url).begin(); it != directory_cache_control.at(url).end();
-                     ++it) {
-                    if (*it == directory_cache_key) {
-                        directory_cache_control.at(url).erase(it);
-                        break;
-                    }
-                }
-            }
+                      AsyncDirectoryCallback callback) {
+        const DirectoryKey key{.archive = url, .offset = directoryOffset, .length = directoryLength};
 
-            callback(std::unique_ptr<Response::Error>());
+        if (auto directory = DirectoryCache::getInstance().get(key)) {
+            callback(std::move(directory), std::unique_ptr<Response::Error>());
             return;
         }
 
-        getHeader(url, req, [=, this](std::unique_ptr<Response::Error> error) {
+        // Tiles sharing a directory that's already being fetched wait for that fetch
+        auto& waiters = pending_directories[key];
+        waiters.push_back(std::move(callback));
+        if (waiters.size() > 1) {
+            return;
+        }
+
+        auto done = [=, this](const Directory& directory, std::unique_ptr<Response::Error> error) {
+            auto node = pending_directories.extract(key);
+            if (node.empty()) {
+                return;
+            }
+            for (auto& waiter : node.mapped()) {
+                waiter(directory,
+                       error ? std::make_unique<Response::Error>(*error) : std::unique_ptr<Response::Error>());
+            }
+        };
+
+        getHeader(url, [=, this](std::unique_ptr<Response::Error> error) {
             if (error) {
-                callback(std::move(error));
+                done(nullptr, std::move(error));
                 return;
             }
 
             pmtiles::headerv3 header = header_cache.at(url);
 
-            Resource resource(Resource::Kind::Source, url);
-            resource.loadingMethod = Resource::LoadingMethod::Network;
-            resource.dataRange = std::make_pair(directoryOffset, directoryOffset + directoryLength - 1);
-
-            tasks[req] = getFileSource()->request(resource, [=, this](const Response& response) {
+            auto onDirectoryData = [=, this](const Response& response, std::string_view data) {
                 if (response.error) {
-                    callback(std::make_unique<Response::Error>(
-                        response.error->reason,
-                        std::string("Error fetching PMTiles directory: ") + response.error->message));
+                    done(nullptr,
+                         std::make_unique<Response::Error>(
+                             response.error->reason,
+                             std::string("Error fetching PMTiles directory: ") + response.error->message));
 
                     return;
                 }
 
                 try {
-                    std::string directoryData = *response.data;
-
-                    if (header.internal_compression == pmtiles::COMPRESSION_GZIP) {
-                        directoryData = util::decompress(directoryData);
-                    }
-
-                    storeDirectory(url, directoryOffset, directoryLength, directoryData);
-
-                    callback(std::unique_ptr<Response::Error>());
+                    done(storeDirectory(key,
+                                        header.internal_compression == pmtiles::COMPRESSION_GZIP
+                                            ? util::decompress(data)
+                                            : std::string(data)),
+                         std::unique_ptr<Response::Error>());
                 } catch (const std::exception& e) {
-                    callback(std::make_unique<Response::Error>(
-                        Response::Error::Reason::Other,
-                        std::string(std::string("Error parsing PMTiles directory: ") + e.what())));
+                    done(nullptr,
+                         std::make_unique<Response::Error>(
+                             Response::Error::Reason::Other,
+                             std::string(std::string("Error parsing PMTiles directory: ") + e.what())));
                 }
-            });
+            };
+            requestRange(url, directoryOffset, directoryLength, std::move(onDirectoryData));
         });
     }
 
     void getTileAddress(const std::string& url,
-                        AsyncRequest* req,
                         uint64_t tileID,
                         uint64_t directoryOffset,
                         uint32_t directoryLength,
@@ -529,20 +848,17 @@ private:
 
         getDirectory(
             url,
-            req,
             directoryOffset,
             directoryLength,
-            [=, this](std::unique_ptr<Response::Error> error) { // NOLINT(clang-analyzer-cplusplus.NewDeleteLeaks)
+            [=, this](const Directory& directory,
+                      std::unique_ptr<Response::Error> error) { // NOLINT(clang-analyzer-cplusplus.NewDeleteLeaks)
                 if (error) {
                     callback(std::make_pair(0, 0), std::move(error));
                     return;
                 }
 
                 pmtiles::headerv3 header = header_cache.at(url);
-                std::vector<pmtiles::entryv3> directory = directory_cache.at(url).at(
-                    url + "|" + std::to_string(directoryOffset) + "|" + std::to_string(directoryLength));
-
-                pmtiles::entryv3 entry = pmtiles::find_tile(directory, tileID);
+                pmtiles::entryv3 entry = pmtiles::find_tile(*directory, tileID);
 
                 if (entry.length > 0) {
                     if (entry.run_length > 0) {
@@ -551,7 +867,6 @@ private:
                     }
 
                     getTileAddress(url,
-                                   req,
                                    tileID,
                                    header.leaf_dirs_offset + entry.offset,
                                    entry.length,
@@ -574,23 +889,25 @@ private:
 };
 
 PMTilesFileSource::PMTilesFileSource(const ResourceOptions& resourceOptions, const ClientOptions& clientOptions)
-    : thread(std::make_unique<util::Thread<Impl>>(
+    : rangeRequests(std::make_shared<std::atomic<uint64_t>>(0)),
+      thread(std::make_unique<util::Thread<Impl>>(
           util::makeThreadPrioritySetter(platform::EXPERIMENTAL_THREAD_PRIORITY_FILE),
           "PMTilesFileSource",
           resourceOptions.clone(),
-          clientOptions.clone())) {}
+          clientOptions.clone(),
+          rangeRequests)) {}
 
 std::unique_ptr<AsyncRequest> PMTilesFileSource::request(const Resource& resource, FileSource::Callback callback) {
     auto req = std::make_unique<FileSourceRequest>(std::move(callback));
 
     // assume if there is a tile request, that the pmtiles file has been validated
     if (resource.kind == Resource::Tile) {
-        thread->actor().invoke(&Impl::request_tile, req.get(), resource, req->actor());
+        thread->actor().invoke(&Impl::request_tile, resource, req->actor());
         return req;
     }
 
     // return TileJSON
-    thread->actor().invoke(&Impl::request_tilejson, req.get(), resource, req->actor());
+    thread->actor().invoke(&Impl::request_tilejson, resource, req->actor());
     return req;
 }
 
@@ -600,6 +917,32 @@ bool PMTilesFileSource::canRequest(const Resource& resource) const {
 
 PMTilesFileSource::~PMTilesFileSource() = default;
 
+void PMTilesFileSource::setProperty(const std::string& key, const mapbox::base::Value& value) {
+    if (key == PMTILES_DIRECTORY_CACHE_SIZE_KEY && value.getUint()) {
+        DirectoryCache::getInstance().setMaximumSize(*value.getUint());
+    } else {
+        std::string message = "Resource provider does not support property " + key;
+        Log::Error(Event::General, message.c_str());
+    }
+}
+
+mapbox::base::Value PMTilesFileSource::getProperty(const std::string& key) const {
+    if (key == PMTILES_RANGE_REQUESTS_KEY) {
+        return rangeRequests->load(std::memory_order_relaxed);
+    } else if (key == PMTILES_DIRECTORY_CACHE_SIZE_KEY) {
+        return DirectoryCache::getInstance().getMaximumSize();
+    } else if (key == PMTILES_DIRECTORY_CACHE_USAGE_KEY) {
+        return DirectoryCache::getInstance().getSize();
+    } else if (key == PMTILES_DIRECTORY_CACHE_HITS_KEY) {
+        return DirectoryCache::getInstance().getHits();
+    } else if (key == PMTILES_DIRECTORY_CACHE_MISSES_KEY) {
+        return DirectoryCache::getInstance().getMisses();
+    }
+    std::string message = "Resource provider does not support property " + key;
+    Log::Error(Event::General, message.c_str());
+    return {};
+}
+
 void PMTilesFileSource::setResourceOptions(ResourceOptions options) {
     thread->actor().invoke(&Impl::setResourceOptions, options.clone());
 }
@@ -23,6 +23,12 @@ bool PMTilesFileSource::canRequest(const Resource& resource) const {
 
 PMTilesFileSource::~PMTilesFileSource() = default;
 
+void PMTilesFileSource::setProperty(const std::string& key, const mapbox::base::Value& value) {}
+
+mapbox::base::Value PMTilesFileSource::getProperty(const std::string& key) const {
+    return {};
+}
+
 void PMTilesFileSource::setResourceOptions(ResourceOptions options) {}
 
 ResourceOptions PMTilesFileSource::getResourceOptions() {
@@ -6,8 +6,19 @@
 #include <zlib.h>
 #endif
 
+#if MLN_WITH_LIBDEFLATE
+#include <libdeflate.h>
+#endif
+
+#if MLN_WITH_ZSTD
+#include <zstd.h>
+#endif
+
+#include <algorithm>
 #include <cstdio>
 #include <cstring>
+#include <memory>
+#include <optional>
 #include <stdexcept>
 
 // Check zlib library version.
@@ -31,7 +42,203 @@ namespace util {
 // cause a link error.
 #undef compress
 
-bool is_compressed(const std::string &v) {
+namespace {
+
+bool isGzip(std::string_view v) {
+    return v.size() > 2 && static_cast<uint8_t>(v[0]) == 0x1f && static_cast<uint8_t>(v[1]) == 0x8b;
+}
+
+bool isZstd(std::string_view v) {
+    // Little-endian frame magic number 0xFD2FB528
+    return v.size() > 4 && static_cast<uint8_t>(v[0]) == 0x28 && static_cast<uint8_t>(v[1]) == 0xb5 &&
+           static_cast<uint8_t>(v[2]) == 0x2f && static_cast<uint8_t>(v[3]) == 0xfd;
+}
+
+// Initial size of the output buffer. Gzip streams end with their uncompressed size, modulo 2^32, which is
+// trusted up to a sanity limit, other streams are assumed to compress about 4:1 as vector tiles do.
+std::size_t outputSizeHint(std::string_view raw, int windowBits) {
+    constexpr std::size_t minSize = 16384;
+    constexpr std::size_t maxTrailerSize = 256 * 1024 * 1024;
+    if (windowBits != CompressionFormat::ZLIB && windowBits != CompressionFormat::DEFLATE && isGzip(raw) &&
+        raw.size() > 18) {
+        const auto* trailer = reinterpret_cast<const uint8_t *>(raw.data() + raw.size() - 4);
+        const std::size_t size = trailer[0] | (trailer[1] << 8) | (trailer[2] << 16) |
+                                 (static_cast<std::size_t>(trailer[3]) << 24);
+        if (size > 0 && size <= maxTrailerSize) {
+            return size;
+        }
+    }
+    return std::max(minSize, raw.size() * 4);
+}
+
+// Inflate state reused by the decompressions of a thread, rather than allocated for each
+class InflateStream {
+public:
+    InflateStream() = default;
+    InflateStream(const InflateStream &) = delete;
+    ~InflateStream() {
+        if (initialized) {
+            inflateEnd(&stream);
+        }
+    }
+
+    z_stream &reset(int windowBits) {
+        if (!initialized) {
+            memset(&stream, 0, sizeof(stream));
+            if (inflateInit2(&stream, windowBits) != Z_OK) {
+                throw std::runtime_error("failed to initialize inflate");
+            }
+            initialized = true;
+        } else if (inflateReset2(&stream, windowBits) != Z_OK) {
+            throw std::runtime_error("failed to reset inflate");
+        }
+        return stream;
+    }
+
+private:
+    z_stream stream;
+    bool initialized = false;
+};
+
+std::string inflateZlib(std::string_view raw, int windowBits) {
+    thread_local InflateStream inflateStream;
+    z_stream &stream = inflateStream.reset(windowBits);
+
+    stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(raw.data()));
+    stream.avail_in = uInt(raw.size());
+
+    // Inflate straight into the result, growing it as needed
+    std::string result(outputSizeHint(raw, windowBits), '\0');
+    int code;
+    do {
+        if (stream.total_out == result.size()) {
+            result.resize(result.size() * 2);
+        }
+        stream.next_out = reinterpret_cast<Bytef *>(result.data() + stream.total_out);
+        stream.avail_out = uInt(result.size() - stream.total_out);
+        code = inflate(&stream, Z_NO_FLUSH);
+    } while (code == Z_OK);
+
+    if (code != Z_STREAM_END) {
+        throw std::runtime_error(stream.msg ? stream.msg : "decompression error");
+    }
+
+    result.resize(stream.total_out);
+    return result;
+}
+
+#if MLN_WITH_LIBDEFLATE
+// libdeflate inflates whole buffers, several times faster than zlib, but needs an output buffer large
+// enough for all of it. Returns nothing for the window sizes it doesn't support.
+std::optional<std::string> inflateLibdeflate(std::string_view raw, int windowBits) {
+    enum class Container {
+        Raw,
+        Zlib,
+        Gzip
+    };
+    Container container;
+    if (windowBits == CompressionFormat::DEFLATE) {
+        container = Container::Raw;
+    } else if (windowBits == CompressionFormat::ZLIB) {
+        container = Container::Zlib;
+    } else if (windowBits == CompressionFormat::GZIP) {
+        container = Container::Gzip;
+    } else if (windowBits == CompressionFormat::DETECT) {
+        container = isGzip(raw) ? Container::Gzip : Container::Zlib;
+    } else {
+        return std::nullopt;
+    }
+
+    thread_local std::unique_ptr<libdeflate_decompressor, decltype(&libdeflate_free_decompressor)> decompressor{
+        libdeflate_alloc_decompressor(), &libdeflate_free_decompressor};
+    if (!decompressor) {
+        throw std::runtime_error("failed to initialize inflate");
+    }
+
+    std::string result(outputSizeHint(raw, windowBits), '\0');
+    while (true) {
+        std::size_t size = 0;
+        libdeflate_result code;
+        switch (container) {
+            case Container::Raw:
+                code = libdeflate_deflate_decompress(
+                    decompressor.get(), raw.data(), raw.size(), result.data(), result.size(), &size);
+                break;
+            case Container::Zlib:
+                code = libdeflate_zlib_decompress(
+                    decompressor.get(), raw.data(), raw.size(), result.data(), result.size(), &size);
+                break;
+            case Container::Gzip:
+                code = libdeflate_gzip_decompress(
+                    decompressor.get(), raw.data(), raw.size(), result.data(), result.size(), &size);
+                break;
+        }
+        if (code == LIBDEFLATE_SUCCESS) {
+            result.resize(size);
+            return result;
+        } else if (code == LIBDEFLATE_INSUFFICIENT_SPACE) {
+            result.resize(result.size() * 2);
+        } else {
+            throw std::runtime_error("decompression error");
+        }
+    }
+}
+#endif
+
+#if MLN_WITH_ZSTD
+std::string decompressZstd(std::string_view raw) {
+    thread_local std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)> context{ZSTD_createDCtx(), &ZSTD_freeDCtx};
+    if (!context) {
+        throw std::runtime_error("failed to initialize zstd");
+    }
+
+    const auto contentSize = ZSTD_getFrameContentSize(raw.data(), raw.size());
+    if (contentSize == ZSTD_CONTENTSIZE_ERROR) {
+        throw std::runtime_error("invalid zstd frame");
+    }
+
+    if (contentSize != ZSTD_CONTENTSIZE_UNKNOWN) {
+        std::string result(contentSize, '\0');
+        const auto size = ZSTD_decompressDCtx(context.get(), result.data(), result.size(), raw.data(), raw.size());
+        if (ZSTD_isError(size)) {
+            throw std::runtime_error(ZSTD_getErrorName(size));
+        }
+        result.resize(size);
+        return result;
+    }
+
+    // Frames written by streaming compressors don't record their size
+    ZSTD_DCtx_reset(context.get(), ZSTD_reset_session_only);
+    ZSTD_inBuffer input{raw.data(), raw.size(), 0};
+    std::string result(outputSizeHint(raw, CompressionFormat::DETECT), '\0');
+    std::size_t size = 0;
+    while (true) {
+        if (size == result.size()) {
+            result.resize(result.size() * 2);
+        }
+        ZSTD_outBuffer output{result.data() + size, result.size() - size, 0};
+        const auto code = ZSTD_decompressStream(context.get(), &output, &input);
+        if (ZSTD_isError(code)) {
+            throw std::runtime_error(ZSTD_getErrorName(code));
+        }
+        size += output.pos;
+        if (code == 0) {
+            break;
+        } else if (input.pos == input.size && output.pos < output.size) {
+            throw std::runtime_error("truncated zstd frame");
+        }
+    }
+    result.resize(size);
+    return result;
+}
+#endif
+
+} // namespace
+
+bool is_compressed(std::string_view v) {
+    if (isZstd(v)) {
+        return true;
+    }
     if (v.size() > 2) {
         const auto byte0 = static_cast<uint8_t>(v[0]);
         const auto byte1 = static_cast<uint8_t>(v[1]);
@@ -89,38 +296,21 @@ std::string compress(const std::string &raw, int windowBits) {
     return result;
 }
 
-std::string decompress(const std::string &raw, int windowBits) {
-    z_stream inflate_stream;
-    memset(&inflate_stream, 0, sizeof(inflate_stream));
-
-    // TODO: reuse z_streams
-    if (inflateInit2(&inflate_stream, windowBits) != Z_OK) {
-        throw std::runtime_error("failed to initialize inflate");
+std::string decompress(std::string_view raw, int windowBits) {
+    if (windowBits == CompressionFormat::DETECT && isZstd(raw)) {
+#if MLN_WITH_ZSTD
+        return decompressZstd(raw);
+#else
+        throw std::runtime_error("zstd decompression isn't supported by this build");
+#endif
     }
 
-    inflate_stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(raw.data()));
-    inflate_stream.avail_in = uInt(raw.size());
-
-    std::string result;
-    char out[16384];
-
-    int code;
-    do {
-        inflate_stream.next_out = reinterpret_cast<Bytef *>(out);
-        inflate_stream.avail_out = sizeof(out);
-        code = inflate(&inflate_stream, 0);
-        if (result.size() < inflate_stream.total_out) {
-            result.append(out, inflate_stream.total_out - result.size());
-        }
-    } while (code == Z_OK);
-
-    inflateEnd(&inflate_stream);
-
-    if (code != Z_STREAM_END) {
-        throw std::runtime_error(inflate_stream.msg ? inflate_stream.msg : "decompression error");
+#if MLN_WITH_LIBDEFLATE
+    if (auto result = inflateLibdeflate(raw, windowBits)) {
+        return std::move(*result);
     }
-
-    return result;
+#endif
+    return inflateZlib(raw, windowBits);
 }
 
 std::uint32_t crc32(const void *raw, size_t size) noexcept {
@@ -101,6 +101,17 @@ PremultipliedImage decodeJPEG(const uint8_t* data, size_t size) {
     int ret = jpeg_read_header(&cinfo, TRUE);
     if (ret != JPEG_HEADER_OK) throw std::runtime_error("JPEG Reader: failed to read header");
 
+#ifdef JCS_ALPHA_EXTENSIONS
+    // libjpeg-turbo writes opaque RGBA rows itself, saving the expansion below
+    const bool decodeRGBA = cinfo.jpeg_color_space == JCS_YCbCr || cinfo.jpeg_color_space == JCS_RGB ||
+                            cinfo.jpeg_color_space == JCS_GRAYSCALE;
+    if (decodeRGBA) {
+        cinfo.out_color_space = JCS_EXT_RGBA;
+    }
+#else
+    const bool decodeRGBA = false;
+#endif
+
     jpeg_start_decompress(&cinfo);
 
     if (cinfo.out_color_space == JCS_UNKNOWN)
@@ -117,6 +128,15 @@ PremultipliedImage decodeJPEG(const uint8_t* data, size_t size) {
     PremultipliedImage image({static_cast<uint32_t>(width), static_cast<uint32_t>(height)});
     uint8_t* dst = image.data.get();
 
+    if (decodeRGBA) {
+        while (cinfo.output_scanline < cinfo.output_height) {
+            JSAMPROW row = dst + static_cast<size_t>(cinfo.output_scanline) * width * 4;
+            jpeg_read_scanlines(&cinfo, &row, 1);
+        }
+        jpeg_finish_decompress(&cinfo);
+        return image;
+    }
+
     JSAMPARRAY buffer = (*cinfo.mem->alloc_sarray)(
         reinterpret_cast<j_common_ptr>(&cinfo), JPOOL_IMAGE, static_cast<JDIMENSION>(rowStride), 1);
 
@@ -2,6 +2,7 @@
 #include <mbgl/platform/thread.hpp>
 #include <mbgl/util/logging.hpp>
 
+#include <algorithm>
 #include <string>
 
 #include <pthread.h>
@@ -55,6 +56,21 @@ void setCurrentThreadPriority(double priority) {
 #endif
 }
 
+void setCurrentThreadAffinity([[maybe_unused]] const std::vector<std::size_t>& cpus) {
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (std::size_t cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+        if (cpus.empty() || std::ranges::find(cpus, cpu) != cpus.end()) {
+            CPU_SET(cpu, &set);
+        }
+    }
+    if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0) {
+        Log::Warning(Event::General, "Couldn't set thread affinity");
+    }
+#endif
+}
+
 void attachThread() {}
 
 void detachThread() {}
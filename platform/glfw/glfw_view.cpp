@@ -106,6 +106,7 @@ enum class TileLodProfile {
     Reduced,       // Reduce LOD away from camera
     Aggressive,    // Aggressively reduce LOD away from camera at the detriment of quality
     DistanceBased, // Use distance-based algorithm
+    ScreenSpace,   // Use screen-space-error algorithm with a tile budget
 };
 
 constexpr TileLodProfile nextTileLodProfile(TileLodProfile current) {
@@ -119,6 +120,8 @@ constexpr TileLodProfile nextTileLodProfile(TileLodProfile current) {
         case TileLodProfile::Aggressive:
             return TileLodProfile::DistanceBased;
         case TileLodProfile::DistanceBased:
+            return TileLodProfile::ScreenSpace;
+        case TileLodProfile::ScreenSpace:
             return TileLodProfile::Default;
         default:
             return TileLodProfile::Default;
@@ -131,6 +134,7 @@ void cycleTileLodProfile(mbgl::Map &map) {
     static const auto defaultScale = map.getTileLodScale();
     static const auto defaultTilePitchThreshold = map.getTileLodPitchThreshold();
     static const auto defaultTileLodMode = map.getTileLodMode();
+    static const auto defaultTileLodMaxTiles = map.getTileLodMaxTiles();
 
     static TileLodProfile profile = TileLodProfile::Default;
     profile = nextTileLodProfile(profile);
@@ -141,6 +145,7 @@ void cycleTileLodProfile(mbgl::Map &map) {
             map.setTileLodScale(defaultScale);
             map.setTileLodPitchThreshold(defaultTilePitchThreshold);
             map.setTileLodMode(defaultTileLodMode);
+            map.setTileLodMaxTiles(defaultTileLodMaxTiles);
             mbgl::Log::Info(mbgl::Event::General, "Tile LOD profile: default");
             break;
         case TileLodProfile::NoLod:
@@ -166,6 +171,13 @@ void cycleTileLodProfile(mbgl::Map &map) {
             map.setTileLodMode(mbgl::TileLodMode::Distance);
             mbgl::Log::Info(mbgl::Event::General, "Tile LOD profile: distance-based");
             break;
+        case TileLodProfile::ScreenSpace:
+            map.setTileLodScale(1);
+            map.setTileLodPitchThreshold(0);
+            map.setTileLodMode(mbgl::TileLodMode::ScreenSpaceError);
+            map.setTileLodMaxTiles(64);
+            mbgl::Log::Info(mbgl::Event::General, "Tile LOD profile: screen-space-error");
+            break;
     }
     map.triggerRepaint();
 }
@@ -1163,7 +1175,12 @@ void GLFWView::onWindowFocus(GLFWwindow *window, int focused) {
 
     if (focused == GLFW_FALSE) { // Focus lost.
         auto *view = reinterpret_cast<GLFWView *>(glfwGetWindowUserPointer(window));
-        view->rendererFrontend->getRenderer()->reduceMemoryUse();
+        const auto report = view->rendererFrontend->getRenderer()->onMemoryPressure(
+            mbgl::MemoryPressureLevel::Critical);
+        for (const auto &step : report.steps) {
+            mbgl::Log::Info(mbgl::Event::General,
+                            "Memory pressure: " + step.name + " freed " + std::to_string(step.freedBytes) + " bytes");
+        }
     }
 }
 
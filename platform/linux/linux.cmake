@@ -14,6 +14,9 @@ pkg_search_module(WEBP libwebp REQUIRED)
 pkg_search_module(LIBUV libuv REQUIRED)
 pkg_search_module(ICUUC icu-uc)
 pkg_search_module(ICUI18N icu-i18n)
+pkg_search_module(LIBDEFLATE libdeflate)
+pkg_search_module(ZSTD libzstd)
+pkg_search_module(LIBURING liburing)
 find_program(ARMERGE NAMES armerge)
 
 if(MLN_WITH_WAYLAND AND NOT MLN_WITH_VULKAN)
@@ -181,6 +184,29 @@ target_link_libraries(
         mbgl-vendor-sqlite
 )
 
+# Optional faster inflate and zstd-compressed tiles, zlib is used otherwise
+if(LIBDEFLATE_FOUND)
+    message(STATUS "Found libdeflate, using it to decompress tiles.")
+    target_compile_definitions(mbgl-core PRIVATE MLN_WITH_LIBDEFLATE=1)
+    target_include_directories(mbgl-core PRIVATE ${LIBDEFLATE_INCLUDE_DIRS})
+    target_link_libraries(mbgl-core PRIVATE ${LIBDEFLATE_LIBRARIES})
+endif()
+
+if(ZSTD_FOUND)
+    message(STATUS "Found libzstd, zstd-compressed tiles are supported.")
+    target_compile_definitions(mbgl-core PRIVATE MLN_WITH_ZSTD=1)
+    target_include_directories(mbgl-core PRIVATE ${ZSTD_INCLUDE_DIRS})
+    target_link_libraries(mbgl-core PRIVATE ${ZSTD_LIBRARIES})
+endif()
+
+# Optional io_uring reads of local files, read on the background scheduler otherwise
+if(LIBURING_FOUND)
+    message(STATUS "Found liburing, reading local files with io_uring.")
+    target_compile_definitions(mbgl-core PRIVATE MLN_WITH_LIBURING=1)
+    target_include_directories(mbgl-core PRIVATE ${LIBURING_INCLUDE_DIRS})
+    target_link_libraries(mbgl-core PRIVATE ${LIBURING_LIBRARIES})
+endif()
+
 if(MLN_CREATE_AMALGAMATION)
     if ("${ARMERGE}" STREQUAL "MLN_CREATE_AMALGAMATION")
         message(FATAL_ERROR "armerge required when MLN_CREATE_AMALGAMATION=ON")
@@ -197,6 +223,15 @@ if(MLN_CREATE_AMALGAMATION)
     find_static_library(STATIC_LIBS NAMES ssl)
     find_static_library(STATIC_LIBS NAMES crypto)
     find_static_library(STATIC_LIBS NAMES bz2 bzip2)
+    if(LIBDEFLATE_FOUND)
+        find_static_library(STATIC_LIBS NAMES deflate)
+    endif()
+    if(ZSTD_FOUND)
+        find_static_library(STATIC_LIBS NAMES zstd)
+    endif()
+    if(LIBURING_FOUND)
+        find_static_library(STATIC_LIBS NAMES uring)
+    endif()
 
     if(MLN_WITH_VULKAN)
         find_static_library(STATIC_LIBS NAMES glslang)
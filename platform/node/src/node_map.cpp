@@ -48,6 +48,7 @@ struct NodeMap::RenderOptions {
     double ySkew = 1;
     std::vector<std::string> classes;
     mbgl::MapDebugOptions debugOptions = mbgl::MapDebugOptions::NoDebug;
+    bool premultiplied = true;
 };
 
 Nan::Persistent<v8::Function> NodeMap::constructor;
@@ -341,6 +342,11 @@ NodeMap::RenderOptions NodeMap::ParseOptions(v8::Local<v8::Object> obj) {
         }
     }
 
+    if (Nan::Has(obj, Nan::New("premultiplied").ToLocalChecked()).FromJust()) {
+        options.premultiplied =
+            Nan::To<bool>(Nan::Get(obj, Nan::New("premultiplied").ToLocalChecked()).ToLocalChecked()).ToChecked();
+    }
+
     if (Nan::Has(obj, Nan::New("axonometric").ToLocalChecked()).FromJust()) {
         options.axonometric =
             Nan::To<bool>(Nan::Get(obj, Nan::New("axonometric").ToLocalChecked()).ToLocalChecked()).ToChecked();
@@ -450,6 +456,8 @@ public:
  * of the map
  * @param {number} [options.bearing=0] rotation
  * @param {Array<string>} [options.classes=[]] style classes
+ * @param {boolean} [options.premultiplied=true] if false, the pixels are
+ * unpremultiplied natively before being passed to the callback
  * @param {Function} callback
  * @returns {undefined} calls callback
  * @throws {Error} if stylesheet is not loaded or if map is already rendering
@@ -536,13 +544,17 @@ void NodeMap::startRender(const NodeMap::RenderOptions& options) {
 
     map->setProjectionMode(projectionOptions);
 
-    map->renderStill(camera, options.debugOptions, [this](const std::exception_ptr& eptr) {
+    const bool premultiplied = options.premultiplied;
+    map->renderStill(camera, options.debugOptions, [this, premultiplied](const std::exception_ptr& eptr) {
         if (eptr) {
             error = eptr;
             uv_async_send(async);
         } else {
             assert(!image.data);
             image = frontend->readStillImage();
+            if (!premultiplied) {
+                mbgl::util::unpremultiply(image.data.get(), image.size.area());
+            }
             uv_async_send(async);
         }
     });
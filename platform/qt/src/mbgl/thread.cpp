@@ -16,6 +16,8 @@ void makeThreadLowPriority() {}
 
 void setCurrentThreadPriority(double) {}
 
+void setCurrentThreadAffinity(const std::vector<std::size_t>&) {}
+
 void attachThread() {}
 
 void detachThread() {}
@@ -61,6 +61,7 @@ std::string getCurrentThreadName();
 void setCurrentThreadName(const std::string& name);
 void makeThreadLowPriority();
 void setCurrentThreadPriority(double priority);
+void setCurrentThreadAffinity(const std::vector<std::size_t>& cpus);
 } // namespace platform
 } // namespace mbgl
 
@@ -82,6 +82,22 @@ void setCurrentThreadPriority(double priority) {
     }
 }
 
+void setCurrentThreadAffinity(const std::vector<std::size_t>& cpus) {
+    DWORD_PTR mask = 0;
+    if (cpus.empty()) {
+        DWORD_PTR systemMask = 0;
+        GetProcessAffinityMask(GetCurrentProcess(), &mask, &systemMask);
+    }
+    for (const auto cpu : cpus) {
+        if (cpu < sizeof(DWORD_PTR) * 8) {
+            mask |= DWORD_PTR(1) << cpu;
+        }
+    }
+    if (!mask || !SetThreadAffinityMask(GetCurrentThread(), mask)) {
+        Log::Warning(Event::General, "Couldn't set thread affinity");
+    }
+}
+
 void attachThread() {}
 
 void detachThread() {}
@@ -11,6 +11,7 @@
 
 #include <list>
 #include <map>
+#include <optional>
 
 namespace mbgl {
 
@@ -96,6 +97,21 @@ struct FpsProbe {
     float tolerance = 0.0f;
 };
 
+/// Frame timings and work of a whole test, recorded in perf metrics mode, see `TestRunner::setPerfMetrics`
+struct PerfProbe {
+    int frames = 0;
+    /// CPU time of the frames, encoding and rendering (milliseconds)
+    float frameTimeAverage = 0.0f;
+    float frameTimeMax = 0.0f;
+    int drawCalls = 0;
+    /// Bytes uploaded to buffers and textures
+    uint64_t uploadBytes = 0;
+    /// Symbol placement time over all the frames (milliseconds)
+    float placementTime = 0.0f;
+    /// Regression allowed as a fraction of the expected values, the runner's default if unset
+    std::optional<float> tolerance;
+};
+
 struct NetworkProbe {
     NetworkProbe() = default;
     NetworkProbe(size_t requests_, size_t transferred_)
@@ -132,12 +148,15 @@ struct GfxProbe {
 
 class TestMetrics {
 public:
-    bool isEmpty() const { return fileSize.empty() && memory.empty() && network.empty() && fps.empty() && gfx.empty(); }
+    bool isEmpty() const {
+        return fileSize.empty() && memory.empty() && network.empty() && fps.empty() && gfx.empty() && perf.empty();
+    }
     std::map<std::string, FileSizeProbe> fileSize;
     std::map<std::string, MemoryProbe> memory;
     std::map<std::string, NetworkProbe> network;
     std::map<std::string, FpsProbe> fps;
     std::map<std::string, GfxProbe> gfx;
+    std::map<std::string, PerfProbe> perf;
 };
 
 struct TestMetadata {
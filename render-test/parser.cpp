@@ -291,6 +291,29 @@ std::string serializeMetrics(const TestMetrics& metrics) {
         // End gfx section
     }
 
+    if (!metrics.perf.empty()) {
+        // Start perf section
+        writer.Key("perf");
+        writer.StartArray();
+        for (const auto& perfProbe : metrics.perf) {
+            assert(!perfProbe.first.empty());
+            writer.StartArray();
+            writer.String(perfProbe.first.c_str());
+            writer.Int(perfProbe.second.frames);
+            writer.Double(perfProbe.second.frameTimeAverage);
+            writer.Double(perfProbe.second.frameTimeMax);
+            writer.Int(perfProbe.second.drawCalls);
+            writer.Uint64(perfProbe.second.uploadBytes);
+            writer.Double(perfProbe.second.placementTime);
+            if (perfProbe.second.tolerance) {
+                writer.Double(*perfProbe.second.tolerance);
+            }
+            writer.EndArray();
+        }
+        writer.EndArray();
+        // End perf section
+    }
+
     writer.EndObject();
 
     return s.GetString();
@@ -446,6 +469,38 @@ TestMetrics readExpectedMetrics(const mbgl::filesystem::path& path) {
         }
     }
 
+    if (document.HasMember("perf")) {
+        const mbgl::JSValue& perfValue = document["perf"];
+        assert(perfValue.IsArray());
+        for (auto& probeValue : perfValue.GetArray()) {
+            assert(probeValue.IsArray());
+            assert(probeValue.Size() >= 7u);
+            assert(probeValue[0].IsString());
+            assert(probeValue[1].IsInt());    // Frames
+            assert(probeValue[2].IsNumber()); // Average frame time
+            assert(probeValue[3].IsNumber()); // Maximum frame time
+            assert(probeValue[4].IsInt());    // Draw calls
+            assert(probeValue[5].IsNumber()); // Upload bytes
+            assert(probeValue[6].IsNumber()); // Placement time
+
+            const std::string mark{probeValue[0].GetString(), probeValue[0].GetStringLength()};
+            assert(!mark.empty());
+
+            PerfProbe probe;
+            probe.frames = probeValue[1].GetInt();
+            probe.frameTimeAverage = probeValue[2].GetFloat();
+            probe.frameTimeMax = probeValue[3].GetFloat();
+            probe.drawCalls = probeValue[4].GetInt();
+            probe.uploadBytes = probeValue[5].GetUint64();
+            probe.placementTime = probeValue[6].GetFloat();
+            if (probeValue.Size() > 7u && probeValue[7].IsNumber()) {
+                probe.tolerance = probeValue[7].GetFloat(); // Tolerance
+            }
+
+            result.perf.insert({mark, std::move(probe)});
+        }
+    }
+
     return result;
 }
 
@@ -59,7 +59,8 @@ void operator delete(void* ptr, size_t) noexcept {
 
 namespace {
 
-using ArgumentsTuple = std::tuple<bool, bool, bool, uint32_t, std::string, TestRunner::UpdateResults, std::string>;
+using ArgumentsTuple =
+    std::tuple<bool, bool, bool, uint32_t, std::string, TestRunner::UpdateResults, std::string, bool, float>;
 ArgumentsTuple parseArguments(int argc, char** argv) {
     const static std::unordered_map<std::string, TestRunner::UpdateResults> updateResultsFlags = {
         {"default", TestRunner::UpdateResults::DEFAULT},
@@ -88,6 +89,16 @@ ArgumentsTuple parseArguments(int argc, char** argv) {
                                                          \n\"rebaseline\" Updates or creates expected metrics for configuration defined by a manifest.",
         {'u', "update"},
         updateResultsFlags);
+    args::Flag perfMetricsFlag(argumentParser,
+                               "perf metrics",
+                               "Record the frame timings, draw calls, upload bytes and placement time of each test and "
+                               "compare them to the expected metrics",
+                               {"perf-metrics"});
+    args::ValueFlag<float> perfToleranceValue(
+        argumentParser,
+        "tolerance",
+        "Regression allowed in perf metrics, as a fraction of the expected values (default: 0.25)",
+        {"perf-tolerance"});
 
     try {
         argumentParser.ParseCLI(argc, argv);
@@ -129,7 +140,9 @@ ArgumentsTuple parseArguments(int argc, char** argv) {
                           seed,
                           manifestPath.generic_string(),
                           updateResults,
-                          std::move(testFilter)};
+                          std::move(testFilter),
+                          perfMetricsFlag ? args::get(perfMetricsFlag) : false,
+                          perfToleranceValue ? args::get(perfToleranceValue) : 0.25f};
 }
 
 void runWithAlternateSources(TestRunner& runner, TestMetadata& metadata, bool& errored, bool& passed) {
@@ -193,11 +206,14 @@ int runRenderTests(int argc, char** argv, std::function<void(TestStatus)> testSt
     uint32_t seed;
     std::string manifestPath;
     std::string testFilter;
+    bool perfMetrics;
+    float perfTolerance;
 
     Log::useLogThread(false);
     TestRunner::UpdateResults updateResults;
 
-    std::tie(recycleMap, shuffle, online, seed, manifestPath, updateResults, testFilter) = parseArguments(argc, argv);
+    std::tie(recycleMap, shuffle, online, seed, manifestPath, updateResults, testFilter, perfMetrics, perfTolerance) =
+        parseArguments(argc, argv);
 
     ProxyFileSource::setOffline(!online);
 
@@ -207,6 +223,7 @@ int runRenderTests(int argc, char** argv, std::function<void(TestStatus)> testSt
     }
     mbgl::util::RunLoop runLoop;
     TestRunner runner(std::move(*manifestData), updateResults);
+    runner.setPerfMetrics(perfMetrics, perfTolerance);
     if (shuffle) {
         printf(ANSI_COLOR_YELLOW "Shuffle seed: %d" ANSI_COLOR_RESET "\n", seed);
         runner.doShuffle(seed);
@@ -1,3 +1,5 @@
+#include <mbgl/gfx/backend_scope.hpp>
+#include <mbgl/gfx/context.hpp>
 #include <mbgl/map/camera.hpp>
 #include <mbgl/map/map_observer.hpp>
 #include <mbgl/renderer/renderer.hpp>
@@ -96,6 +98,11 @@ TestRunner::TestRunner(Manifest manifest_, UpdateResults updateResults_)
     registerProxyFileSource();
 }
 
+void TestRunner::setPerfMetrics(bool enable, float tolerance) {
+    perfMetrics = enable;
+    perfTolerance = tolerance;
+}
+
 void TestRunner::registerProxyFileSource() {
     static std::once_flag registerProxyFlag;
     std::call_once(registerProxyFlag, [] {
@@ -536,11 +543,51 @@ void TestRunner::checkProbingResults(TestMetadata& resultMetadata) {
         }
     };
 
+    // Check perf metrics, only for regressions. Times are given an extra millisecond, as the shortest ones
+    // are mostly noise.
+    auto checkPerf = [this](TestMetadata& metadata) {
+        if (metadata.metrics.perf.empty()) return;
+        for (const auto& expected : metadata.expectedMetrics.perf) {
+            auto actual = metadata.metrics.perf.find(expected.first);
+            if (actual == metadata.metrics.perf.end()) {
+                metadata.errorMessage = "Failed to find perf probe: " + expected.first;
+                metadata.metricsErrored++;
+                return;
+            }
+
+            const auto& probeName = expected.first;
+            const auto& expectedValue = expected.second;
+            const auto& actualValue = actual->second;
+            const float tolerance = expectedValue.tolerance.value_or(perfTolerance);
+            std::stringstream ss;
+
+            const auto check = [&](const char* name, double expectedMetric, double actualMetric, double slack) {
+                if (actualMetric <= expectedMetric * (1.0 + tolerance) + slack) return;
+                if (!metadata.errorMessage.empty() || ss.tellp() > 0) ss << std::endl;
+                ss << name << " at probe \"" << probeName << "\" is " << actualMetric << ", expected at most "
+                   << expectedMetric << " with tolerance of " << tolerance;
+                metadata.metricsFailed++;
+            };
+            check("Number of frames", expectedValue.frames, actualValue.frames, 0.0);
+            check("Average frame time (ms)", expectedValue.frameTimeAverage, actualValue.frameTimeAverage, 1.0);
+            check("Maximum frame time (ms)", expectedValue.frameTimeMax, actualValue.frameTimeMax, 1.0);
+            check("Number of draw calls", expectedValue.drawCalls, actualValue.drawCalls, 0.0);
+            check("Uploaded bytes",
+                  static_cast<double>(expectedValue.uploadBytes),
+                  static_cast<double>(actualValue.uploadBytes),
+                  0.0);
+            check("Placement time (ms)", expectedValue.placementTime, actualValue.placementTime, 1.0);
+
+            metadata.errorMessage += metadata.errorMessage.empty() ? ss.str() : "\n" + ss.str();
+        }
+    };
+
     checkFileSize(resultMetadata);
     checkMemory(resultMetadata);
     checkNetwork(resultMetadata);
     checkFps(resultMetadata);
     checkGfx(resultMetadata);
+    checkPerf(resultMetadata);
 
     if (resultMetadata.ignoredTest) {
         return;
@@ -667,6 +714,33 @@ void resetContext(const TestMetadata& metadata, TestContext& ctx) {
     map.getStyle().loadJSON(serializeJsonValue(metadata.document));
 }
 
+gfx::RenderingStats contextRenderingStats(TestContext& ctx) {
+    auto& backend = *ctx.getFrontend().getBackend();
+    gfx::BackendScope guard{backend};
+    return backend.getContext().renderingStats();
+}
+
+PerfProbe makePerfProbe(const TestRunnerMapObserver& observer,
+                        const gfx::RenderingStats& before,
+                        const gfx::RenderingStats& after) {
+    PerfProbe probe;
+    const auto& frameTimes = observer.frameTimes;
+    probe.frames = static_cast<int>(frameTimes.size());
+    if (!frameTimes.empty()) {
+        double total = 0.0;
+        for (const auto frameTime : frameTimes) {
+            total += frameTime;
+        }
+        probe.frameTimeAverage = static_cast<float>(total / static_cast<double>(frameTimes.size()) * 1000.0);
+        probe.frameTimeMax = static_cast<float>(*std::max_element(frameTimes.begin(), frameTimes.end()) * 1000.0);
+    }
+    probe.drawCalls = after.totalDrawCalls - before.totalDrawCalls;
+    probe.uploadBytes = (after.bufferUpdateBytes - before.bufferUpdateBytes) +
+                        (after.textureUpdateBytes - before.textureUpdateBytes);
+    probe.placementTime = static_cast<float>(observer.placementTime * 1000.0);
+    return probe;
+}
+
 LatLng getTileCenterCoordinates(const UnwrappedTileID& tileId) {
     double scale = (1 << tileId.canonical.z);
     Point<double> tileCenter{(tileId.canonical.x + 0.5) * util::tileSize_D,
@@ -767,6 +841,10 @@ void TestRunner::run(TestMetadata& metadata) {
     auto& frontend = ctx.getFrontend();
     auto& map = ctx.getMap();
 
+    ctx.getObserver().frameTimes.clear();
+    ctx.getObserver().placementTime = 0.0;
+    const auto perfStatsBefore = perfMetrics ? contextRenderingStats(ctx) : gfx::RenderingStats();
+
     resetContext(metadata, ctx);
     auto camera = map.getStyle().getDefaultCamera();
 
@@ -894,6 +972,11 @@ void TestRunner::run(TestMetadata& metadata) {
         result = runTest(metadata, ctx);
     }
 
+    if (perfMetrics && !metadata.ignoredTest) {
+        metadata.metrics.perf.insert(
+            {"test", makePerfProbe(ctx.getObserver(), perfStatsBefore, contextRenderingStats(ctx))});
+    }
+
     if (!metadata.ignoredTest) {
         ctx.activeGfxProbe = GfxProbe(result.stats, ctx.activeGfxProbe);
         for (const auto& operation : getAfterOperations(manifest)) {
@@ -902,7 +985,7 @@ void TestRunner::run(TestMetadata& metadata) {
     }
 
     if (metadata.renderTest) {
-        if (!metadata.ignoreProbing) {
+        if (!metadata.ignoreProbing || perfMetrics) {
             checkProbingResults(metadata);
         }
         appendLabelCutOffResults(metadata, cutOffLabelsReport, duplicationsReport);
@@ -8,6 +8,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 class TestRunnerMapObserver;
 struct TestMetadata;
@@ -23,6 +24,12 @@ public:
 
     void onDidBecomeIdle() override final { idle = true; }
 
+    void onDidFinishRenderingFrame(const RenderFrameStatus& status) override final {
+        const auto& stats = status.renderingStats;
+        frameTimes.push_back(stats.encodingTime + stats.renderingTime);
+        placementTime += stats.placementTime;
+    }
+
     void reset() {
         mapLoadFailure = false;
         finishRenderingMap = false;
@@ -32,6 +39,10 @@ public:
     bool mapLoadFailure;
     bool finishRenderingMap;
     bool idle;
+
+    // Frames rendered since the start of the test, not cleared by `reset` (seconds)
+    std::vector<double> frameTimes;
+    double placementTime = 0.0;
 };
 
 class TestRunner {
@@ -45,6 +56,12 @@ public:
     };
 
     TestRunner(Manifest, UpdateResults);
+
+    /// Records the frame timings, draw calls, upload bytes and placement time of every test in its "perf"
+    /// metrics, which are compared to the expected ones. A metric regresses beyond `tolerance`, a fraction
+    /// of its expected value, unless the expected probe sets its own tolerance.
+    void setPerfMetrics(bool enable, float tolerance);
+
     void run(TestMetadata&);
     void reset();
 
@@ -74,4 +91,6 @@ private:
     std::unordered_map<std::string, std::unique_ptr<Impl>> maps;
     Manifest manifest;
     UpdateResults updateResults;
+    bool perfMetrics = false;
+    float perfTolerance = 0.0f;
 };
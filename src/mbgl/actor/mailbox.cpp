@@ -5,17 +5,41 @@
 #include <mbgl/util/scoped.hpp>
 
 #include <cassert>
+#include <thread>
 
 namespace mbgl {
 
-Mailbox::Mailbox() = default;
+namespace {
+
+class StubMessage final : public Message {
+public:
+    void operator()() override { assert(false); }
+};
+
+} // namespace
+
+Mailbox::Mailbox()
+    : stub(std::make_unique<StubMessage>()),
+      head(stub.get()),
+      tail(stub.get()) {}
 
 Mailbox::Mailbox(Scheduler& scheduler_)
-    : weakScheduler(scheduler_.makeWeakPtr()) {}
+    : Mailbox() {
+    weakScheduler = scheduler_.makeWeakPtr();
+}
 
 Mailbox::Mailbox(const TaggedScheduler& scheduler_)
-    : schedulerTag(scheduler_.tag),
-      weakScheduler(scheduler_.get()->makeWeakPtr()) {}
+    : Mailbox() {
+    schedulerTag = scheduler_.tag;
+    weakScheduler = scheduler_.get()->makeWeakPtr();
+}
+
+Mailbox::~Mailbox() {
+    // Nothing can push anymore, so every queued message is linked in
+    while (Message* message = dequeue()) {
+        delete message;
+    }
+}
 
 void Mailbox::open(const TaggedScheduler& scheduler_) {
     assert(!weakScheduler);
@@ -27,9 +51,12 @@ void Mailbox::open(Scheduler& scheduler_) {
     assert(!weakScheduler);
 
     // As with close(), block until neither receive() nor push() are in
-    // progress, and acquire the two mutexes in the same order.
+    // progress, and acquire the receiving mutex first.
     std::scoped_lock receivingLock(receivingMutex);
-    std::scoped_lock pushingLock(pushingMutex);
+    lockPushes();
+    Scoped pushesLock{[this]() {
+        unlockPushes();
+    }};
 
     if (closed) {
         return;
@@ -37,7 +64,7 @@ void Mailbox::open(Scheduler& scheduler_) {
 
     weakScheduler = scheduler_.makeWeakPtr();
 
-    if (!queue.empty()) {
+    if (queued.load(std::memory_order_acquire) > 0) {
         scheduleToRecieve();
     }
 }
@@ -45,112 +72,150 @@ void Mailbox::open(Scheduler& scheduler_) {
 void Mailbox::close() {
     abandon();
 
-    // Block until neither receive() nor push() are in progress. Two mutexes are
-    // used because receive() must not block send(). Of the two, the receiving
-    // mutex must be acquired first, because that is the order that an actor
-    // will obtain them when it self-sends a message, and consistent lock
-    // acquisition order prevents deadlocks. The receiving mutex is recursive to
-    // allow a mailbox (and thus the actor) to close itself.
+    // Block until neither receive() nor push() are in progress. Pushes only
+    // ever wait for open() and close(), which is what keeps receive() from
+    // blocking send(). The receiving mutex must be acquired first, because an
+    // actor that self-sends a message pushes while receiving, and a consistent
+    // order prevents deadlocks. It is recursive to allow a mailbox (and thus
+    // the actor) to close itself.
     std::scoped_lock receivingLock(receivingMutex);
-    std::scoped_lock pushingLock(pushingMutex);
+    lockPushes();
 
     closed = true;
 
     weakScheduler = {};
+
+    unlockPushes();
 }
 
 void Mailbox::abandon() {
-    auto idleValue = State::Idle;
-    while (!state.compare_exchange_strong(idleValue, State::Abandoned)) {
-        if (state == State::Abandoned) {
-            break;
-        }
-    }
+    abandoned.store(true, std::memory_order_release);
 }
 
 bool Mailbox::isOpen() const {
     return !closed && weakScheduler;
 }
 
-void Mailbox::push(std::unique_ptr<Message> message) {
-    MLN_TRACE_FUNC();
-    auto idleState = State::Idle;
-    while (!state.compare_exchange_strong(idleState, State::Processing)) {
-        if (state == State::Abandoned) {
-            return;
+void Mailbox::lockPushes() {
+    uint32_t current = pushes.load(std::memory_order_relaxed);
+    while ((current & pushesLocked) ||
+           !pushes.compare_exchange_weak(current, current | pushesLocked, std::memory_order_acquire)) {
+        if (current & pushesLocked) {
+            // Another thread is opening or closing the mailbox
+            std::this_thread::yield();
+            current = pushes.load(std::memory_order_relaxed);
         }
     }
+    while (pushes.load(std::memory_order_acquire) != pushesLocked) {
+        std::this_thread::yield();
+    }
+}
 
-    Scoped activityFlag{[this]() {
-        if (state == State::Processing) {
-            state = State::Idle;
-        }
-    }};
+void Mailbox::unlockPushes() {
+    pushes.fetch_and(~pushesLocked, std::memory_order_release);
+}
 
-    {
-        MLN_TRACE_ZONE(push lock);
-        std::scoped_lock pushingLock(pushingMutex);
+void Mailbox::push(std::unique_ptr<Message> message) {
+    MLN_TRACE_FUNC();
+    if (abandoned.load(std::memory_order_acquire)) {
+        return;
+    }
 
+    while (pushes.fetch_add(1, std::memory_order_acq_rel) & pushesLocked) {
+        pushes.fetch_sub(1, std::memory_order_relaxed);
         if (closed) {
-            state = State::Abandoned;
             return;
         }
+        std::this_thread::yield();
+    }
 
-        bool wasEmpty = false;
-        {
-            MLN_TRACE_ZONE(queue lock);
-            std::scoped_lock queueLock(queueMutex);
-            wasEmpty = queue.empty();
-            queue.push(std::move(message));
-        }
+    Scoped pushed{[this]() {
+        pushes.fetch_sub(1, std::memory_order_release);
+    }};
 
-        if (wasEmpty) {
-            MLN_TRACE_ZONE(schedule);
-            scheduleToRecieve(schedulerTag);
-        }
+    if (closed) {
+        abandon();
+        return;
+    }
+
+    enqueue(message.release());
+
+    if (queued.fetch_add(1, std::memory_order_acq_rel) == 0) {
+        MLN_TRACE_ZONE(schedule);
+        scheduleToRecieve(schedulerTag);
     }
 }
 
 void Mailbox::receive() {
-    auto idleState = State::Idle;
-    while (!state.compare_exchange_strong(idleState, State::Processing)) {
-        if (state == State::Abandoned) {
-            return;
-        }
+    if (abandoned.load(std::memory_order_acquire)) {
+        return;
     }
 
-    Scoped activityFlag{[this]() {
-        if (state == State::Processing) {
-            state = State::Idle;
-        }
-    }};
     std::scoped_lock receivingLock(receivingMutex);
 
     if (closed) {
-        state = State::Abandoned;
+        abandon();
         return;
     }
 
-    std::unique_ptr<Message> message;
-    bool wasEmpty = false;
-
-    {
-        std::scoped_lock queueLock(queueMutex);
-        assert(!queue.empty());
-        message = std::move(queue.front());
-        queue.pop();
-        wasEmpty = queue.empty();
+    assert(queued > 0);
+    Message* next = dequeue();
+    while (!next) {
+        // The message was counted, but its push hasn't linked it in yet
+        std::this_thread::yield();
+        next = dequeue();
     }
+    std::unique_ptr<Message> message(next);
 
     (*message)();
 
     // If there are more messages in the queue and the scheduler
-    // is still active, create a new task to handle the next one
-    if (!wasEmpty) {
+    // is still active, create a new task to handle the next one.
+    // Messages pushed while this one ran didn't schedule one.
+    if (queued.fetch_sub(1, std::memory_order_acq_rel) > 1) {
         scheduleToRecieve();
     }
 }
 
+void Mailbox::enqueue(Message* message) {
+    message->next.store(nullptr, std::memory_order_relaxed);
+    Message* previous = head.exchange(message, std::memory_order_acq_rel);
+    previous->next.store(message, std::memory_order_release);
+}
+
+Message* Mailbox::dequeue() {
+    Message* first = tail;
+    Message* next = first->next.load(std::memory_order_acquire);
+
+    if (first == stub.get()) {
+        if (!next) {
+            return nullptr;
+        }
+        tail = next;
+        first = next;
+        next = next->next.load(std::memory_order_acquire);
+    }
+
+    if (next) {
+        tail = next;
+        return first;
+    }
+
+    if (first != head.load(std::memory_order_acquire)) {
+        // A push swapped the head, but hasn't linked it in
+        return nullptr;
+    }
+
+    // `first` is the last message, put the stub behind it so it can be taken
+    enqueue(stub.get());
+    next = first->next.load(std::memory_order_acquire);
+    if (next) {
+        tail = next;
+        return first;
+    }
+    return nullptr;
+}
+
 void Mailbox::scheduleToRecieve(const std::optional<util::SimpleIdentity>& tag) {
     if (auto guard = weakScheduler.lock(); weakScheduler) {
         std::weak_ptr<Mailbox> mailbox = shared_from_this();
@@ -159,7 +224,10 @@ void Mailbox::scheduleToRecieve(const std::optional<util::SimpleIdentity>& tag)
                 locked->receive();
             }
         };
-        if (tag) {
+        if (const auto priority_ = priority.load(); priority_ != TaskPriority::Normal) {
+            // Without a tag, this is the untagged queue, which `waitForEmpty()` covers like `schedule(fn)`
+            weakScheduler->scheduleWithPriority(tag.value_or(schedulerTag), priority_, std::move(setToRecieve));
+        } else if (tag) {
             weakScheduler->schedule(*tag, std::move(setToRecieve));
         } else {
             weakScheduler->schedule(std::move(setToRecieve));
@@ -0,0 +1,67 @@
+#include <mbgl/actor/message.hpp>
+
+#include <bit>
+#include <cassert>
+#include <new>
+
+namespace mbgl {
+
+namespace {
+
+// Stored in front of every message, to tell `delete` where it came from
+struct alignas(std::max_align_t) MessageHeader {
+    actor::MessageSlab* slab;
+};
+
+} // namespace
+
+namespace actor {
+
+void* MessageSlab::allocate(std::size_t size) {
+    if (size > blockSize) {
+        overflowCount.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    uint32_t current = used.load(std::memory_order_relaxed);
+    while (current != allUsed) {
+        const auto index = std::countr_one(current);
+        if (used.compare_exchange_weak(
+                current, current | (1u << index), std::memory_order_acquire, std::memory_order_relaxed)) {
+            return blocks[index];
+        }
+    }
+    overflowCount.fetch_add(1, std::memory_order_relaxed);
+    return nullptr;
+}
+
+void MessageSlab::release(void* block) {
+    const auto index = static_cast<std::size_t>(static_cast<std::byte*>(block) - blocks[0]) / blockSize;
+    assert(index < blockCount);
+    used.fetch_and(~(1u << index), std::memory_order_release);
+}
+
+} // namespace actor
+
+void* Message::operator new(std::size_t size, actor::MessageSlab* slab) {
+    void* block = slab ? slab->allocate(sizeof(MessageHeader) + size) : nullptr;
+    if (!block) {
+        block = ::operator new(sizeof(MessageHeader) + size);
+        slab = nullptr;
+    }
+    return new (block) MessageHeader{slab} + 1;
+}
+
+void Message::operator delete(void* ptr) noexcept {
+    if (!ptr) {
+        return;
+    }
+    auto* header = static_cast<MessageHeader*>(ptr) - 1;
+    if (header->slab) {
+        header->slab->release(header);
+    } else {
+        ::operator delete(header);
+    }
+}
+
+} // namespace mbgl
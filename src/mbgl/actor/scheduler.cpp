@@ -1,4 +1,5 @@
 #include <mbgl/actor/scheduler.hpp>
+#include <mbgl/platform/settings.hpp>
 #include <mbgl/util/thread_local.hpp>
 #include <mbgl/util/thread_pool.hpp>
 #include <mbgl/util/run_loop.hpp>
@@ -41,7 +42,12 @@ std::shared_ptr<Scheduler> Scheduler::GetBackground() {
     std::shared_ptr<Scheduler> scheduler = weak.lock();
 
     if (!scheduler) {
-        weak = scheduler = std::make_shared<ThreadPool>();
+        auto mode = ThreadPool::Mode::Shared;
+        const auto value = platform::Settings::getInstance().get(platform::EXPERIMENTAL_THREAD_POOL_WORK_STEALING);
+        if (const auto* workStealing = value.getBool(); workStealing && *workStealing) {
+            mode = ThreadPool::Mode::WorkStealing;
+        }
+        weak = scheduler = std::make_shared<ThreadPool>(mode, ThreadPool::ThreadOptions::fromSettings());
     }
 
     return scheduler;
@@ -4,12 +4,54 @@
 #include <mbgl/tile/tile_necessity.hpp>
 #include <mbgl/util/range.hpp>
 
+#include <unordered_map>
 #include <unordered_set>
 #include <optional>
+#include <vector>
 
 namespace mbgl {
 namespace algorithm {
 
+/// The prefetched tiles grouped by their ancestor at the zoom level of the ideal tiles, so that an ideal tile left
+/// uncovered only checks the tiles below it instead of all of them. Built on first use, and again when tiles were
+/// added to the map since, as the tile pyramid passes the same map its tiles are created in.
+template <typename PrefetchedTileMap>
+class PrefetchedTileIndex {
+public:
+    using Entry = typename PrefetchedTileMap::value_type;
+
+    explicit PrefetchedTileIndex(const PrefetchedTileMap& prefetchedTiles_)
+        : prefetchedTiles(prefetchedTiles_) {}
+
+    /// The prefetched tiles at or below the given tile, in the order of the map
+    const std::vector<const Entry*>& below(const OverscaledTileID& tileID) {
+        if (!indexedZ || *indexedZ != tileID.canonical.z || indexedSize != prefetchedTiles.size()) {
+            rebuild(tileID.canonical.z);
+        }
+        const auto it = index.find(tileID.toUnwrapped());
+        return it != index.end() ? it->second : none;
+    }
+
+private:
+    void rebuild(uint8_t z) {
+        index.clear();
+        for (const auto& entry : prefetchedTiles) {
+            const OverscaledTileID& id = entry.first;
+            if (id.canonical.z >= z) {
+                index[UnwrappedTileID{id.wrap, id.canonical.scaledTo(z)}].push_back(&entry);
+            }
+        }
+        indexedZ = z;
+        indexedSize = prefetchedTiles.size();
+    }
+
+    const PrefetchedTileMap& prefetchedTiles;
+    std::unordered_map<UnwrappedTileID, std::vector<const Entry*>> index;
+    std::optional<uint8_t> indexedZ;
+    std::size_t indexedSize = 0;
+    const std::vector<const Entry*> none;
+};
+
 template <typename GetTileFn,
           typename CreateTileFn,
           typename RetainTileFn,
@@ -25,6 +67,7 @@ void updateRenderables(GetTileFn getTile,
                        const Range<uint8_t>& zoomRange,
                        const std::optional<uint8_t>& maxParentOverscaleFactor = std::nullopt) {
     std::unordered_set<OverscaledTileID> checked;
+    PrefetchedTileIndex<PrefetchedTileMap> prefetchedTileIndex(prefetchedTiles);
     bool covered = false;
     bool parentOrChildTileFound = false;
     int32_t overscaledZ = 0;
@@ -143,10 +186,10 @@ void updateRenderables(GetTileFn getTile,
 
                 if (!parentOrChildTileFound) {
                     // Reuse prefetched tiles in order to avoid empty screen
-                    for (auto& prefetchedTileEntry : prefetchedTiles) {
-                        const auto& prefetchedDataTileID = prefetchedTileEntry.first;
+                    for (const auto* prefetchedTileEntry : prefetchedTileIndex.below(idealDataTileID)) {
+                        const auto& prefetchedDataTileID = prefetchedTileEntry->first;
                         const UnwrappedTileID prefetchedRenderTileID = prefetchedDataTileID.toUnwrapped();
-                        auto* prefetchedTile = prefetchedTileEntry.second.get();
+                        auto* prefetchedTile = prefetchedTileEntry->second.get();
                         if (prefetchedTile->isRenderable() && prefetchedDataTileID.canonical.z <= zoomRange.max &&
                             prefetchedDataTileID.isChildOf(idealDataTileID)) {
                             retainTile(*prefetchedTile, TileNecessity::Optional);
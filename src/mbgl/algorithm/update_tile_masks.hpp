@@ -5,6 +5,8 @@
 #include <vector>
 #include <functional>
 #include <algorithm>
+#include <map>
+#include <unordered_set>
 
 namespace mbgl {
 namespace algorithm {
@@ -60,6 +62,25 @@ void computeTileMasks(
     mask.emplace(diffZ, ref.canonical.x - (root.x << diffZ), ref.canonical.y - (root.y << diffZ));
 }
 
+// Computes the TileMask of the tile at `it`, see below.
+template <typename Iterator>
+void computeTileMask(const Iterator it, const Iterator end, TileMask& mask) {
+    const UnwrappedTileID& id = it->first;
+    // Try to add all remaining ids as children. We sorted the tile list
+    // by z earlier, so all preceding items cannot be children of the
+    // current tile. We also compute the lower bound of the next wrap,
+    // because items of the next wrap can never be children of the current
+    // wrap.
+    const auto child_it = std::next(it);
+    const auto children_end = std::lower_bound(
+        child_it, end, UnwrappedTileID{static_cast<int16_t>(id.wrap + 1), {0, 0, 0}}, [](auto& a, auto& b) {
+            return a.first < b;
+        });
+
+    mask.clear();
+    computeTileMasks(id.canonical, id, child_it, children_end, mask);
+}
+
 // Updates the TileMasks for all renderable tiles. Each renderable tile has a
 // corresponding UnwrappedTileID indicating where it should be rendered on the
 // screen. A TileMask describes all regions within a renderable tile that are
@@ -122,22 +143,73 @@ void updateTileMasks(RenderableTilesMap& renderables) {
         if (!tileNeedsMask(it->second)) {
             continue;
         }
-        // Try to add all remaining ids as children. We sorted the tile list
-        // by z earlier, so all preceding items cannot be children of the
-        // current tile. We also compute the lower bound of the next wrap,
-        // because items of the next wrap can never be children of the current
-        // wrap.
-        auto child_it = std::next(it);
-        const auto children_end = std::lower_bound(
-            child_it, end, UnwrappedTileID{static_cast<int16_t>(id.wrap + 1), {0, 0, 0}}, [](auto& a, auto& b) {
-                return a.first < b;
-            });
-
-        mask.clear();
-        computeTileMasks(id.canonical, id, child_it, children_end, mask);
+        computeTileMask(it, end, mask);
         setTileMask(it->second, std::move(mask));
     }
 }
 
+/// The TileMasks of the previous `updateTileMasks` call made with it, by tile
+struct TileMaskCache {
+    std::map<UnwrappedTileID, TileMask> masks;
+};
+
+// As above, but only computes the TileMasks of the tiles that are new, or that
+// a tile below them appeared or disappeared under, since the mask of a tile
+// only depends on the renderable tiles it covers. The others get the mask they
+// had in the previous call, which is the common case while panning or once the
+// tiles of a zoom level have loaded. The masks are set on all the tiles, as the
+// tile rendered for an ID may have changed.
+template <typename RenderableTilesMap>
+void updateTileMasks(RenderableTilesMap& renderables, TileMaskCache& cache) {
+    // Walk the previous and current IDs side by side, both sorted, and mark
+    // the ancestors of those found in only one of them.
+    std::unordered_set<UnwrappedTileID> dirty;
+    const auto markAncestors = [&](const UnwrappedTileID& id) {
+        for (int z = id.canonical.z - 1; z >= 0; --z) {
+            if (!dirty.emplace(id.wrap, id.canonical.scaledTo(static_cast<uint8_t>(z))).second) {
+                // Its ancestors were marked along with it
+                break;
+            }
+        }
+    };
+
+    const auto end = renderables.end();
+    auto previous = cache.masks.begin();
+    for (auto it = renderables.begin(); it != end; ++it) {
+        if (!tileNeedsMask(it->second)) {
+            continue;
+        }
+        for (; previous != cache.masks.end() && previous->first < it->first; ++previous) {
+            markAncestors(previous->first);
+        }
+        if (previous != cache.masks.end() && previous->first == it->first) {
+            ++previous;
+        } else {
+            markAncestors(it->first);
+        }
+    }
+    for (; previous != cache.masks.end(); ++previous) {
+        markAncestors(previous->first);
+    }
+
+    std::map<UnwrappedTileID, TileMask> masks;
+    for (auto it = renderables.begin(); it != end; ++it) {
+        const UnwrappedTileID& id = it->first;
+        if (!tileNeedsMask(it->second)) {
+            continue;
+        }
+        TileMask mask;
+        const auto cached = cache.masks.find(id);
+        if (cached != cache.masks.end() && !dirty.contains(id)) {
+            mask = std::move(cached->second);
+        } else {
+            computeTileMask(it, end, mask);
+        }
+        setTileMask(it->second, TileMask(mask));
+        masks.emplace_hint(masks.end(), id, std::move(mask));
+    }
+    cache.masks = std::move(masks);
+}
+
 } // namespace algorithm
 } // namespace mbgl
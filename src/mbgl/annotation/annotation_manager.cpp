@@ -11,9 +11,17 @@
 #include <mbgl/style/layers/symbol_layer_impl.hpp>
 #include <mbgl/style/style.hpp>
 #include <mbgl/style/style_impl.hpp>
+#include <mbgl/math/clamp.hpp>
+#include <mbgl/util/constants.hpp>
+#include <mbgl/util/projection.hpp>
+
+#include <mapbox/geometry/envelope.hpp>
 
 #include <boost/iterator/function_output_iterator.hpp>
 
+#include <algorithm>
+#include <cmath>
+
 // Note: LayerManager::annotationsEnabled is defined
 // at compile time, so that linker (with LTO on) is able
 // to optimize out the unreachable code.
@@ -56,6 +64,7 @@ AnnotationID AnnotationManager::addAnnotation(const Annotation& annotation) {
     std::scoped_lock lock(mutex);
     AnnotationID id = nextID++;
     Annotation::visit(annotation, [&](const auto& annotation_) { this->add(id, annotation_); });
+    index(id);
     dirty = true;
     return id;
 }
@@ -74,10 +83,48 @@ void AnnotationManager::removeAnnotation(const AnnotationID& id) {
     dirty = true;
 }
 
+AnnotationIDs AnnotationManager::addAnnotations(const std::vector<Annotation>& annotations) {
+    CHECK_ANNOTATIONS_ENABLED_AND_RETURN({});
+    std::scoped_lock lock(mutex);
+    AnnotationIDs ids;
+    ids.reserve(annotations.size());
+    // Packing the indexes anew beats inserting into them one by one once the batch outnumbers them
+    const bool repack = annotations.size() > symbolAnnotations.size() + shapeAnnotations.size();
+    for (const auto& annotation : annotations) {
+        const AnnotationID id = nextID++;
+        Annotation::visit(annotation, [&](const auto& annotation_) { this->add(id, annotation_); });
+        if (!repack) {
+            index(id);
+        }
+        ids.push_back(id);
+    }
+    if (repack) {
+        reindex();
+    }
+    dirty = true;
+    return ids;
+}
+
+bool AnnotationManager::updateAnnotations(const std::vector<std::pair<AnnotationID, Annotation>>& annotations) {
+    CHECK_ANNOTATIONS_ENABLED_AND_RETURN(true);
+    std::scoped_lock lock(mutex);
+    for (const auto& [id, annotation] : annotations) {
+        Annotation::visit(annotation, [&](const auto& annotation_) { this->update(id, annotation_); });
+    }
+    return dirty;
+}
+
+void AnnotationManager::removeAnnotations(const AnnotationIDs& ids) {
+    CHECK_ANNOTATIONS_ENABLED_AND_RETURN_NOARG();
+    std::scoped_lock lock(mutex);
+    for (const auto& id : ids) {
+        remove(id);
+    }
+    dirty = true;
+}
+
 void AnnotationManager::add(const AnnotationID& id, const SymbolAnnotation& annotation) {
-    auto impl = std::make_shared<SymbolAnnotationImpl>(id, annotation);
-    symbolTree.insert(impl);
-    symbolAnnotations.emplace(id, impl);
+    symbolAnnotations.emplace(id, std::make_shared<SymbolAnnotationImpl>(id, annotation));
 }
 
 void AnnotationManager::add(const AnnotationID& id, const LineAnnotation& annotation) {
@@ -106,6 +153,7 @@ void AnnotationManager::update(const AnnotationID& id, const SymbolAnnotation& a
 
         remove(id);
         add(id, annotation);
+        index(id);
     }
 }
 
@@ -116,8 +164,12 @@ void AnnotationManager::update(const AnnotationID& id, const LineAnnotation& ann
         return;
     }
 
+    if (const auto entry = shapeEntry(*it->second)) {
+        shapeTree.remove(*entry);
+    }
     shapeAnnotations.erase(it);
     add(id, annotation);
+    index(id);
     dirty = true;
 }
 
@@ -128,8 +180,12 @@ void AnnotationManager::update(const AnnotationID& id, const FillAnnotation& ann
         return;
     }
 
+    if (const auto entry = shapeEntry(*it->second)) {
+        shapeTree.remove(*entry);
+    }
     shapeAnnotations.erase(it);
     add(id, annotation);
+    index(id);
     dirty = true;
 }
 
@@ -140,6 +196,9 @@ void AnnotationManager::remove(const AnnotationID& id) {
         symbolAnnotations.erase(id);
     } else if (shapeAnnotations.contains(id)) {
         auto it = shapeAnnotations.find(id);
+        if (const auto entry = shapeEntry(*it->second)) {
+            shapeTree.remove(*entry);
+        }
         (void)*style.get().impl->removeLayer(it->second->layerID);
         shapeAnnotations.erase(it);
     } else {
@@ -147,6 +206,58 @@ void AnnotationManager::remove(const AnnotationID& id) {
     }
 }
 
+void AnnotationManager::index(const AnnotationID& id) {
+    if (const auto symbol = symbolAnnotations.find(id); symbol != symbolAnnotations.end()) {
+        symbolTree.insert(symbol->second);
+    } else if (const auto shape = shapeAnnotations.find(id); shape != shapeAnnotations.end()) {
+        if (const auto entry = shapeEntry(*shape->second)) {
+            shapeTree.insert(*entry);
+        }
+    }
+}
+
+void AnnotationManager::reindex() {
+    std::vector<SymbolAnnotationTree::value_type> symbols;
+    symbols.reserve(symbolAnnotations.size());
+    for (const auto& symbol : symbolAnnotations) {
+        symbols.emplace_back(symbol.second);
+    }
+    symbolTree = SymbolAnnotationTree(symbols);
+
+    std::vector<ShapeAnnotationTree::value_type> shapes;
+    shapes.reserve(shapeAnnotations.size());
+    for (const auto& shape : shapeAnnotations) {
+        if (auto entry = shapeEntry(*shape.second)) {
+            shapes.push_back(std::move(*entry));
+        }
+    }
+    shapeTree = ShapeAnnotationTree(shapes);
+}
+
+std::optional<AnnotationManager::ShapeAnnotationTree::value_type> AnnotationManager::shapeEntry(
+    const ShapeAnnotationImpl& shape) {
+    const auto bounds = ShapeAnnotationGeometry::visit(
+        shape.geometry(), [](const auto& geometry) { return mapbox::geometry::envelope(geometry); });
+    if (bounds.min.x > bounds.max.x || bounds.min.y > bounds.max.y) {
+        // Empty geometries are in no tile
+        return std::nullopt;
+    }
+
+    const auto project = [](double longitude, double latitude) {
+        const double clamped = util::clamp(latitude, -util::LATITUDE_MAX, util::LATITUDE_MAX);
+        return Projection::project(LatLng(clamped, longitude), 0);
+    };
+    const auto northwest = project(bounds.min.x, bounds.max.y);
+    const auto southeast = project(bounds.max.x, bounds.min.y);
+    ShapeBox box{{northwest.x, northwest.y}, {southeast.x, southeast.y}};
+    if (northwest.x < 0 || southeast.x > 1) {
+        // The tiler wraps shapes crossing the antimeridian into the other side of the world
+        box.min_corner().set<0>(0);
+        box.max_corner().set<0>(1);
+    }
+    return std::make_pair(box, shape.id);
+}
+
 std::unique_ptr<AnnotationTileData> AnnotationManager::getTileData(const CanonicalTileID& tileID) {
     if (symbolAnnotations.empty() && shapeAnnotations.empty()) return nullptr;
 
@@ -166,8 +277,30 @@ std::unique_ptr<AnnotationTileData> AnnotationManager::getTileData(const Canonic
         boost::geometry::index::intersects(tileBounds),
         boost::make_function_output_iterator([&](const auto& val) { val->updateLayer(tileID, *pointLayer); }));
 
-    for (const auto& shape : shapeAnnotations) {
-        shape.second->updateTileData(tileID, *tileData);
+    // Shape tiles include a buffer around the tile, as set up in ShapeAnnotationImpl::updateTileData
+    const double scale = std::pow(2.0, tileID.z);
+    const double buffer = static_cast<double>(ShapeAnnotationImpl::tileBuffer) / util::EXTENT;
+    const ShapeBox tileBox{{(tileID.x - buffer) / scale, (tileID.y - buffer) / scale},
+                           {(tileID.x + 1 + buffer) / scale, (tileID.y + 1 + buffer) / scale}};
+    AnnotationIDs shapeIDs;
+    const auto collect = boost::make_function_output_iterator(
+        [&](const ShapeAnnotationTree::value_type& entry) { shapeIDs.push_back(entry.second); });
+    shapeTree.query(boost::geometry::index::intersects(tileBox), collect);
+    for (const double offset : {-1.0, 1.0}) {
+        // The buffer of tiles at the edge of the world reaches into its other side
+        ShapeBox wrapped = tileBox;
+        wrapped.min_corner().set<0>(tileBox.min_corner().get<0>() + offset);
+        wrapped.max_corner().set<0>(tileBox.max_corner().get<0>() + offset);
+        if (wrapped.max_corner().get<0>() > 0 && wrapped.min_corner().get<0>() < 1) {
+            shapeTree.query(boost::geometry::index::intersects(wrapped), collect);
+        }
+    }
+
+    // Keep the shapes in ID order, like the layers they're drawn with
+    std::sort(shapeIDs.begin(), shapeIDs.end());
+    shapeIDs.erase(std::unique(shapeIDs.begin(), shapeIDs.end()), shapeIDs.end());
+    for (const auto& id : shapeIDs) {
+        shapeAnnotations.at(id)->updateTileData(tileID, *tileData);
     }
 
     return tileData;
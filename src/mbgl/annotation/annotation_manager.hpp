@@ -8,9 +8,12 @@
 #include <mapbox/std/weak.hpp>
 
 #include <mutex>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
 namespace mbgl {
 
@@ -34,6 +37,11 @@ public:
     bool updateAnnotation(const AnnotationID&, const Annotation&);
     void removeAnnotation(const AnnotationID&);
 
+    // Batched variants, which take the lock and invalidate the tiles once for all the annotations
+    AnnotationIDs addAnnotations(const std::vector<Annotation>&);
+    bool updateAnnotations(const std::vector<std::pair<AnnotationID, Annotation>>&);
+    void removeAnnotations(const AnnotationIDs&);
+
     void addImage(std::unique_ptr<style::Image>);
     void removeImage(const std::string&);
     double getTopOffsetPixelsForImage(const std::string&);
@@ -63,6 +71,9 @@ private:
 
     void remove(const AnnotationID&);
 
+    void index(const AnnotationID&);
+    void reindex();
+
     void updateStyle();
 
     std::unique_ptr<AnnotationTileData> getTileData(const CanonicalTileID&);
@@ -84,7 +95,15 @@ private:
     using ShapeAnnotationMap = std::map<AnnotationID, std::unique_ptr<ShapeAnnotationImpl>>;
     using ImageMap = std::unordered_map<std::string, style::Image>;
 
+    // Shapes are indexed by their bounds in projected coordinates, with the world spanning [0, 1]
+    using ShapePoint = boost::geometry::model::point<double, 2, boost::geometry::cs::cartesian>;
+    using ShapeBox = boost::geometry::model::box<ShapePoint>;
+    using ShapeAnnotationTree =
+        boost::geometry::index::rtree<std::pair<ShapeBox, AnnotationID>, boost::geometry::index::rstar<16, 4>>;
+    static std::optional<ShapeAnnotationTree::value_type> shapeEntry(const ShapeAnnotationImpl&);
+
     SymbolAnnotationTree symbolTree;
+    ShapeAnnotationTree shapeTree;
     SymbolAnnotationMap symbolAnnotations;
     ShapeAnnotationMap shapeAnnotations;
     ImageMap images;
@@ -25,6 +25,9 @@ public:
 
     void updateTileData(const CanonicalTileID &, AnnotationTileData &);
 
+    /// Tile units of geometry kept around each tile's edges
+    static constexpr uint16_t tileBuffer = 255;
+
     const AnnotationID id;
     const std::string layerID;
     std::unique_ptr<mapbox::geojsonvt::GeoJSONVT> shapeTiler;
@@ -1,6 +1,8 @@
 #include <mbgl/geometry/dem_data.hpp>
 #include <mbgl/math/clamp.hpp>
 
+#include <cstring>
+
 namespace mbgl {
 
 DEMData::DEMData(const PremultipliedImage& _image, Tileset::RasterEncoding _encoding)
@@ -8,18 +10,13 @@ DEMData::DEMData(const PremultipliedImage& _image, Tileset::RasterEncoding _enco
       // extra two pixels per row for border backfilling on either edge
       stride(dim + 2),
       encoding(_encoding) {
-    image = std::make_shared<PremultipliedImage>(Size(static_cast<uint32_t>(stride), static_cast<uint32_t>(stride)));
     if (_image.size.height != _image.size.width) {
         throw std::runtime_error("raster-dem tiles must be square.");
     }
 
-    auto* dest = reinterpret_cast<uint32_t*>(image->data.get()) + stride + 1;
-    auto* source = reinterpret_cast<uint32_t*>(_image.data.get());
-    for (int32_t y = 0; y < dim; y++) {
-        memcpy(dest, source, dim * 4);
-        dest += stride;
-        source += dim;
-    }
+    // Every pixel is written below, so skip the zero fill of a default constructed image
+    const Size size(static_cast<uint32_t>(stride), static_cast<uint32_t>(stride));
+    image = std::make_shared<PremultipliedImage>(size, std::unique_ptr<uint8_t[]>(new uint8_t[size.area() * 4]));
 
     // in order to avoid flashing seams between tiles, here we are initially
     // populating a 1px border of pixels around the image with the data of the
@@ -28,13 +25,14 @@ DEMData::DEMData(const PremultipliedImage& _image, Tileset::RasterEncoding _enco
     // backfilled using DEMData#backfillBorder
 
     auto* data = reinterpret_cast<uint32_t*>(image->data.get());
-    for (int32_t x = 0; x < dim; x++) {
-        auto rowOffset = stride * (x + 1);
-        // left vertical border
-        data[rowOffset] = data[rowOffset + 1];
-
-        // right vertical border
-        data[rowOffset + dim + 1] = data[rowOffset + dim];
+    const auto* source = reinterpret_cast<const uint32_t*>(_image.data.get());
+    for (int32_t y = 0; y < dim; y++) {
+        auto* row = data + stride * (y + 1);
+        memcpy(row + 1, source, dim * 4);
+        // left and right vertical borders, filled along with the row while it's in cache
+        row[0] = source[0];
+        row[dim + 1] = source[dim - 1];
+        source += dim;
     }
 
     // top horizontal border with corners
@@ -78,12 +76,12 @@ void DEMData::backfillBorder(const DEMData& borderTileData, int8_t dx, int8_t dy
     int32_t oy = -dy * dim;
 
     auto* dest = reinterpret_cast<uint32_t*>(image->data.get());
-    auto* source = reinterpret_cast<uint32_t*>(o.image->data.get());
+    const auto* source = reinterpret_cast<const uint32_t*>(o.image->data.get());
 
+    // Rows are contiguous, so the top and bottom edges take a single copy
+    const auto width = static_cast<size_t>(xMax - xMin) * 4;
     for (int32_t y = yMin; y < yMax; y++) {
-        for (int32_t x = xMin; x < xMax; x++) {
-            dest[idx(x, y)] = source[idx(x + ox, y + oy)];
-        }
+        memcpy(dest + idx(xMin, y), source + idx(xMin + ox, y + oy), width);
     }
 }
 
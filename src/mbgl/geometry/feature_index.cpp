@@ -14,7 +14,11 @@
 
 #include <mapbox/geometry/envelope.hpp>
 
+#include <boost/iterator/function_output_iterator.hpp>
+
+#include <algorithm>
 #include <cassert>
+#include <optional>
 #include <string>
 
 namespace {
@@ -29,6 +33,26 @@ mbgl::Point<double> project(const mbgl::LatLng& coordinate, const mbgl::Transfor
     unwrappedLatLng.unwrapForShortestPath(state.getLatLng(mbgl::LatLng::Wrapped));
     return mbgl::Projection::project(unwrappedLatLng, state.getScale());
 }
+
+/// The envelope of a ring, unless it's empty or outside of the tile
+std::optional<mapbox::geometry::box<int16_t>> ringEnvelope(std::span<const mbgl::GeometryCoordinate> ring) {
+    if (ring.empty()) {
+        return std::nullopt;
+    }
+    // Rings may be viewed in place, without the `coordinate_type` that `mapbox::geometry::envelope` needs
+    mapbox::geometry::box<int16_t> envelope{ring.front(), ring.front()};
+    for (const auto& point : ring) {
+        envelope.min.x = std::min(envelope.min.x, point.x);
+        envelope.min.y = std::min(envelope.min.y, point.y);
+        envelope.max.x = std::max(envelope.max.x, point.x);
+        envelope.max.y = std::max(envelope.max.y, point.y);
+    }
+    if (envelope.min.x < mbgl::util::EXTENT && envelope.min.y < mbgl::util::EXTENT && envelope.max.x >= 0 &&
+        envelope.max.y >= 0) {
+        return envelope;
+    }
+    return std::nullopt;
+}
 } // namespace
 
 namespace mbgl {
@@ -117,14 +141,54 @@ IndexedSubfeature& IndexedSubfeature::operator=(IndexedSubfeature&& other) {
     return *this;
 }
 
+std::size_t featureCount(const std::unordered_map<std::string, std::vector<Feature>>& result) {
+    std::size_t count = 0;
+    for (const auto& [layerID, features] : result) {
+        count += features.size();
+    }
+    return count;
+}
+
 FeatureIndex::FeatureIndex(std::unique_ptr<const GeometryTileData> tileData_)
-    : grid(util::EXTENT, util::EXTENT, util::EXTENT / 16), // 16x16 grid -> 32px cell
-      tileData(std::move(tileData_)) {}
+    : tileData(std::move(tileData_)) {}
+
+MemoryUsage FeatureIndex::getIndexMemoryUsage() const {
+    MemoryUsage usage{.cpu = subfeatures.capacity() * sizeof(RefIndexedSubfeature) +
+                             (unpacked.capacity() + tree.size()) * sizeof(Entry)};
+    for (const auto& [id, layerIDs] : bucketLayerIDs) {
+        usage.cpu += id.capacity() + layerIDs.capacity() * sizeof(std::string);
+    }
+    return usage;
+}
+
+MemoryUsage FeatureIndex::getMemoryUsage() const {
+    auto usage = getIndexMemoryUsage();
+    if (tileData) {
+        usage += tileData->getMemoryUsage();
+    }
+    return usage;
+}
 
 void FeatureIndex::insert(const GeometryCollection& geometries,
                           std::size_t index,
                           const std::string& sourceLayerName,
                           const std::string& bucketLeaderID) {
+    const auto subfeature = makeSubfeature(index, sourceLayerName, bucketLeaderID);
+    for (const auto& ring : geometries) {
+        insertRing(ring, subfeature);
+    }
+}
+
+void FeatureIndex::insert(std::span<const GeometryCoordinate> points,
+                          std::size_t index,
+                          const std::string& sourceLayerName,
+                          const std::string& bucketLeaderID) {
+    insertRing(points, makeSubfeature(index, sourceLayerName, bucketLeaderID));
+}
+
+RefIndexedSubfeature FeatureIndex::makeSubfeature(std::size_t index,
+                                                  const std::string& sourceLayerName,
+                                                  const std::string& bucketLeaderID) {
     if (uniqueLayerIDs.empty()) {
         uniqueLayerIDs.reserve(expectedUniqueLayerIDs);
     }
@@ -135,15 +199,61 @@ void FeatureIndex::insert(const GeometryCollection& geometries,
     const std::string& emplacedLeaderID =
         bucketLayerIDs.insert(std::make_pair(bucketLeaderID, std::vector<std::string>{})).first->first;
 
-    auto featureSortIndex = sortIndex++;
+    return {index, emplacedLayerName, emplacedLeaderID, sortIndex++};
+}
+
+void FeatureIndex::insert(const FeatureIndexBatch& batch,
+                          const std::string& sourceLayerName,
+                          const std::string& bucketLeaderID) {
+    std::size_t envelope = 0;
+    for (const auto& record : batch.records) {
+        // Every feature takes a sort index, whether or not any of its rings made it into the batch
+        const auto subfeature = makeSubfeature(record.index, sourceLayerName, bucketLeaderID);
+        for (; envelope < record.envelopesEnd; ++envelope) {
+            insertEnvelope(batch.envelopes[envelope], subfeature);
+        }
+    }
+}
+
+void FeatureIndex::insertRing(std::span<const GeometryCoordinate> ring, const RefIndexedSubfeature& subfeature) {
+    if (const auto envelope = ringEnvelope(ring)) {
+        insertEnvelope(*envelope, subfeature);
+    }
+}
+
+void FeatureIndex::insertEnvelope(const mapbox::geometry::box<int16_t>& envelope,
+                                  const RefIndexedSubfeature& subfeature) {
+    unpacked.emplace_back(Box{{envelope.min.x, envelope.min.y}, {envelope.max.x, envelope.max.y}}, subfeatures.size());
+    subfeatures.push_back(subfeature);
+}
+
+void FeatureIndexBatch::add(const GeometryCollection& geometries, std::size_t index) {
     for (const auto& ring : geometries) {
-        const auto envelope = mapbox::geometry::envelope(ring);
-        if (envelope.min.x < util::EXTENT && envelope.min.y < util::EXTENT && envelope.max.x >= 0 &&
-            envelope.max.y >= 0) {
-            grid.insert(RefIndexedSubfeature(index, emplacedLayerName, emplacedLeaderID, featureSortIndex),
-                        {convertPoint<float>(envelope.min), convertPoint<float>(envelope.max)});
+        if (const auto envelope = ringEnvelope(ring)) {
+            envelopes.push_back(*envelope);
         }
     }
+    records.push_back({.index = index, .envelopesEnd = envelopes.size()});
+}
+
+void FeatureIndexBatch::add(std::span<const GeometryCoordinate> points, std::size_t index) {
+    if (const auto envelope = ringEnvelope(points)) {
+        envelopes.push_back(*envelope);
+    }
+    records.push_back({.index = index, .envelopesEnd = envelopes.size()});
+}
+
+void FeatureIndex::pack() {
+    if (unpacked.empty()) {
+        return;
+    }
+    // Bulk loading gives a better tree than inserting entries one by one, and is faster too
+    if (!tree.empty()) {
+        unpacked.insert(unpacked.end(), tree.begin(), tree.end());
+    }
+    tree = Tree(unpacked);
+    unpacked.clear();
+    unpacked.shrink_to_fit();
 }
 
 void FeatureIndex::query(std::unordered_map<std::string, std::vector<Feature>>& result,
@@ -166,30 +276,45 @@ void FeatureIndex::query(std::unordered_map<std::string, std::vector<Feature>>&
     const int16_t additionalPadding = static_cast<int16_t>(
         std::min(static_cast<float>(util::EXTENT), additionalQueryPadding * pixelsToTileUnits));
 
-    // Query the grid index
-    mapbox::geometry::box<int16_t> box = mapbox::geometry::envelope(queryGeometry);
-    std::vector<RefIndexedSubfeature> features = grid.query(
-        {convertPoint<float>(box.min - additionalPadding), convertPoint<float>(box.max + additionalPadding)});
+    // Query the index
+    const mapbox::geometry::box<int16_t> envelope = mapbox::geometry::envelope(queryGeometry);
+    const Box box{{static_cast<float>(envelope.min.x - additionalPadding),
+                   static_cast<float>(envelope.min.y - additionalPadding)},
+                  {static_cast<float>(envelope.max.x + additionalPadding),
+                   static_cast<float>(envelope.max.y + additionalPadding)}};
+    std::vector<std::reference_wrapper<const RefIndexedSubfeature>> features;
+    tree.query(boost::geometry::index::intersects(box),
+               boost::make_function_output_iterator(
+                   [&](const Entry& entry) { features.emplace_back(subfeatures[entry.second]); }));
+    for (const auto& entry : unpacked) {
+        if (boost::geometry::intersects(entry.first, box)) {
+            features.emplace_back(subfeatures[entry.second]);
+        }
+    }
 
     std::ranges::sort(features, [](const RefIndexedSubfeature& a, const RefIndexedSubfeature& b) {
         return a.getSortIndex() > b.getSortIndex();
     });
+    std::size_t count = queryOptions.limit ? featureCount(result) : 0;
     size_t previousSortIndex = std::numeric_limits<size_t>::max();
-    for (const auto& indexedFeature : features) {
+    for (const RefIndexedSubfeature& indexedFeature : features) {
+        // Stop once the topmost features reach the limit
+        if (queryOptions.limit && count >= *queryOptions.limit) break;
+
         // If this feature is the same as the previous feature, skip it.
         if (indexedFeature.getSortIndex() == previousSortIndex) continue;
         previousSortIndex = indexedFeature.getSortIndex();
 
-        addFeature(result,
-                   indexedFeature,
-                   queryOptions,
-                   tileID.canonical,
-                   layers,
-                   queryGeometry,
-                   transformState,
-                   pixelsToTileUnits,
-                   posMatrix,
-                   &sourceFeatureState);
+        count += addFeature(result,
+                            indexedFeature,
+                            queryOptions,
+                            tileID.canonical,
+                            layers,
+                            queryGeometry,
+                            transformState,
+                            pixelsToTileUnits,
+                            posMatrix,
+                            &sourceFeatureState);
     }
 }
 
@@ -229,32 +354,35 @@ std::unordered_map<std::string, std::vector<Feature>> FeatureIndex::lookupSymbol
         }
     });
 
+    std::size_t count = 0;
     for (const auto& symbolFeature : sortedFeatures) {
+        if (queryOptions.limit && count >= *queryOptions.limit) break;
         mat4 unusedMatrix;
-        addFeature(result,
-                   symbolFeature,
-                   queryOptions,
-                   tileID.canonical,
-                   layers,
-                   GeometryCoordinates(),
-                   {},
-                   0,
-                   unusedMatrix,
-                   nullptr);
+        count += addFeature(result,
+                            symbolFeature,
+                            queryOptions,
+                            tileID.canonical,
+                            layers,
+                            GeometryCoordinates(),
+                            {},
+                            0,
+                            unusedMatrix,
+                            nullptr);
     }
     return result;
 }
 
-void FeatureIndex::addFeature(std::unordered_map<std::string, std::vector<Feature>>& result,
-                              const RefIndexedSubfeature& indexedFeature,
-                              const RenderedQueryOptions& options,
-                              const CanonicalTileID& tileID,
-                              const std::unordered_map<std::string, const RenderLayer*>& layers,
-                              const GeometryCoordinates& queryGeometry,
-                              const TransformState& transformState,
-                              const float pixelsToTileUnits,
-                              const mat4& posMatrix,
-                              const SourceFeatureState* sourceFeatureState) const {
+std::size_t FeatureIndex::addFeature(std::unordered_map<std::string, std::vector<Feature>>& result,
+                                     const RefIndexedSubfeature& indexedFeature,
+                                     const RenderedQueryOptions& options,
+                                     const CanonicalTileID& tileID,
+                                     const std::unordered_map<std::string, const RenderLayer*>& layers,
+                                     const GeometryCoordinates& queryGeometry,
+                                     const TransformState& transformState,
+                                     const float pixelsToTileUnits,
+                                     const mat4& posMatrix,
+                                     const SourceFeatureState* sourceFeatureState) const {
+    std::size_t added = 0;
     // Lazily calculated.
     std::unique_ptr<GeometryTileLayer> sourceLayer;
     std::unique_ptr<GeometryTileFeature> geometryTileFeature;
@@ -300,7 +428,9 @@ void FeatureIndex::addFeature(std::unordered_map<std::string, std::vector<Featur
         feature.sourceLayer = sourceLayer->getName();
         feature.state = state;
         result[layerID].emplace_back(feature);
+        added++;
     }
+    return added;
 }
 
 std::optional<GeometryCoordinates> FeatureIndex::translateQueryGeometry(const GeometryCoordinates& queryGeometry,
@@ -5,12 +5,19 @@
 #include <mbgl/tile/tile_id.hpp>
 #include <mbgl/util/feature.hpp>
 #include <mbgl/util/geo.hpp>
-#include <mbgl/util/grid_index.hpp>
 #include <mbgl/util/mat4.hpp>
 
+#include <mapbox/geometry/box.hpp>
+
+#include <boost/geometry/geometries/box.hpp>
+#include <boost/geometry/geometries/point.hpp>
+#include <boost/geometry/index/rtree.hpp>
+
+#include <span>
 #include <vector>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 
 namespace mbgl {
 
@@ -86,6 +93,9 @@ private:
 
 using FeatureSortOrder = std::shared_ptr<const std::vector<size_t>>;
 
+/// Total number of features in query results grouped by layer
+std::size_t featureCount(const std::unordered_map<std::string, std::vector<Feature>>&);
+
 class DynamicFeatureIndex {
 public:
     ~DynamicFeatureIndex();
@@ -104,19 +114,52 @@ protected:
     std::vector<FeatureRecord> features;
 };
 
+/// The ring envelopes of features to be inserted into a `FeatureIndex` later, in the order they were added. Filled
+/// away from the index, so that buckets can be built on other threads and their features inserted in order after.
+class FeatureIndexBatch {
+public:
+    void add(const GeometryCollection&, std::size_t index);
+    void add(std::span<const GeometryCoordinate> points, std::size_t index);
+
+private:
+    friend class FeatureIndex;
+
+    struct Record {
+        std::size_t index;
+        /// The end of the feature's envelopes in `envelopes`, which follow those of the previous record
+        std::size_t envelopesEnd;
+    };
+
+    std::vector<Record> records;
+    std::vector<mapbox::geometry::box<int16_t>> envelopes;
+};
+
 class FeatureIndex {
 public:
     FeatureIndex(std::unique_ptr<const GeometryTileData> tileData_);
 
     const GeometryTileData* getData() { return tileData.get(); }
 
-    /// Set the expected number of elements per cell to avoid small re-allocations for populated cells
-    void reserve(std::size_t value) { grid.reserve(value); }
+    /// Approximate memory used by the index and the tile data it retains
+    MemoryUsage getMemoryUsage() const;
+    /// Approximate memory used by the index alone
+    MemoryUsage getIndexMemoryUsage() const;
 
     void insert(const GeometryCollection&,
                 std::size_t index,
                 const std::string& sourceLayerName,
                 const std::string& bucketLeaderID);
+    /// Inserts the points of a point feature, read in place, as the one ring of its geometry
+    void insert(std::span<const GeometryCoordinate> points,
+                std::size_t index,
+                const std::string& sourceLayerName,
+                const std::string& bucketLeaderID);
+    /// Inserts the features of a batch, as if each had been inserted on its own in the order of the batch
+    void insert(const FeatureIndexBatch&, const std::string& sourceLayerName, const std::string& bucketLeaderID);
+
+    /// Bulk load the features inserted so far into the R-tree, done on the worker once the tile is laid out.
+    /// Features inserted afterwards are still found, but by a linear scan.
+    void pack();
 
     void query(std::unordered_map<std::string, std::vector<Feature>>& result,
                const GeometryCoordinates& queryGeometry,
@@ -146,18 +189,33 @@ public:
         const FeatureSortOrder& featureSortOrder) const;
 
 private:
-    void addFeature(std::unordered_map<std::string, std::vector<Feature>>& result,
-                    const RefIndexedSubfeature&,
-                    const RenderedQueryOptions& options,
-                    const CanonicalTileID&,
-                    const std::unordered_map<std::string, const RenderLayer*>&,
-                    const GeometryCoordinates& queryGeometry,
-                    const TransformState& transformState,
-                    float pixelsToTileUnits,
-                    const mat4& posMatrix,
-                    const SourceFeatureState* sourceFeatureState) const;
-
-    GridIndex<RefIndexedSubfeature> grid;
+    /// The subfeature the rings of a feature being inserted refer to
+    RefIndexedSubfeature makeSubfeature(std::size_t index,
+                                        const std::string& sourceLayerName,
+                                        const std::string& bucketLeaderID);
+    void insertRing(std::span<const GeometryCoordinate> ring, const RefIndexedSubfeature&);
+    void insertEnvelope(const mapbox::geometry::box<int16_t>&, const RefIndexedSubfeature&);
+
+    /// Returns the number of features added to `result`
+    std::size_t addFeature(std::unordered_map<std::string, std::vector<Feature>>& result,
+                           const RefIndexedSubfeature&,
+                           const RenderedQueryOptions& options,
+                           const CanonicalTileID&,
+                           const std::unordered_map<std::string, const RenderLayer*>&,
+                           const GeometryCoordinates& queryGeometry,
+                           const TransformState& transformState,
+                           float pixelsToTileUnits,
+                           const mat4& posMatrix,
+                           const SourceFeatureState* sourceFeatureState) const;
+
+    // Ring envelopes in tile units, each referring to an element of `subfeatures`
+    using Box = boost::geometry::model::box<boost::geometry::model::point<float, 2, boost::geometry::cs::cartesian>>;
+    using Entry = std::pair<Box, std::size_t>;
+    using Tree = boost::geometry::index::rtree<Entry, boost::geometry::index::rstar<16>>;
+
+    std::vector<RefIndexedSubfeature> subfeatures;
+    std::vector<Entry> unpacked;
+    Tree tree;
     unsigned int sortIndex = 0;
 
     // mbgl::unordered_* cannot be used here, as we rely on holding references to elements:
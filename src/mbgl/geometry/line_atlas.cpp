@@ -1,4 +1,6 @@
+#include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <mbgl/geometry/line_atlas.hpp>
 #include <mbgl/gfx/upload_pass.hpp>
 #include <mbgl/gfx/context.hpp>
@@ -137,47 +139,136 @@ void addRegularDash(std::vector<DashRange>& ranges, uint32_t yOffset, AlphaImage
     }
 }
 
-LinePatternPos addDashPattern(AlphaImage& image,
-                              uint32_t yOffset,
-                              const std::vector<float>& dasharray,
-                              const LinePatternCap patternCap) {
-    const uint8_t n = patternCap == LinePatternCap::Round ? 7 : 0;
+// The rows of a pattern, a single one for square caps
+uint32_t getPatternHeight(const LinePatternCap patternCap) {
+    return patternCap == LinePatternCap::Round ? 15 : 1;
+}
+
+constexpr uint32_t atlasWidth = 256;
+
+} // namespace
+
+DashPatternTexture::DashPatternTexture(const LineAtlas& atlas_,
+                                       uint32_t fromRow_,
+                                       float fromLength_,
+                                       uint32_t toRow_,
+                                       float toLength_,
+                                       uint32_t patternHeight_)
+    : atlas(atlas_),
+      fromRow(fromRow_),
+      toRow(toRow_),
+      fromLength(fromLength_),
+      toLength(toLength_),
+      patternHeight(patternHeight_) {
+    updatePositions(atlas.image.size.height);
+}
+
+void DashPatternTexture::updatePositions(const uint32_t atlasHeight) {
+    const auto position = [&](uint32_t row, float length) {
+        if (length == 0) {
+            // An invalid pattern
+            return LinePatternPos{};
+        }
+        LinePatternPos pos;
+        pos.y = (0.5f + row + static_cast<float>(patternHeight / 2)) / atlasHeight;
+        pos.height = static_cast<float>(patternHeight) / atlasHeight;
+        pos.width = length;
+        return pos;
+    };
+    from = position(fromRow, fromLength);
+    to = position(toRow, toLength);
+}
+
+const std::shared_ptr<gfx::Texture2D>& DashPatternTexture::getTexture() const {
+    return atlas.texture;
+}
+
+Size DashPatternTexture::getSize() const {
+    return atlas.image.size;
+}
+
+LineAtlas::LineAtlas() = default;
+
+LineAtlas::~LineAtlas() = default;
+
+MemoryUsage LineAtlas::getMemoryUsage() const {
+    return {.cpu = image.bytes(), .gpu = texture ? texture->getDataSize() : 0};
+}
+
+DashPatternTexture& LineAtlas::getDashPatternTexture(const std::vector<float>& from,
+                                                     const std::vector<float>& to,
+                                                     const LinePatternCap cap) {
+    const size_t hash = util::hash(getDashPatternHash(from, cap), getDashPatternHash(to, cap));
+
+    // Note: We're not handling hash collisions here.
+    const auto it = textures.find(hash);
+    if (it != textures.end()) {
+        return it->second;
+    }
+
+    float fromLength = 0;
+    float toLength = 0;
+    const uint32_t fromRow = addDashPattern(from, cap, fromLength);
+    uint32_t toRow = fromRow;
+    if (from == to) {
+        toLength = fromLength;
+    } else {
+        toRow = addDashPattern(to, cap, toLength);
+    }
+
+    auto inserted = textures.emplace(
+        std::piecewise_construct,
+        std::forward_as_tuple(hash),
+        std::forward_as_tuple(*this, fromRow, fromLength, toRow, toLength, getPatternHeight(cap)));
+    assert(inserted.second);
+    return inserted.first->second;
+}
 
+uint32_t LineAtlas::addDashPattern(const std::vector<float>& dasharray,
+                                   const LinePatternCap patternCap,
+                                   float& length) {
+    length = 0;
     if (dasharray.size() < 2) {
         Log::Warning(Event::ParseStyle, "line dasharray requires at least two elements");
-        return {};
+        return 0;
     }
 
-    float length = 0;
     for (const float part : dasharray) {
         length += part;
     }
 
-    float stretch = image.size.width / length;
-    std::vector<DashRange> ranges = getDashRanges(dasharray, stretch);
+    const uint32_t patternHeight = getPatternHeight(patternCap);
+    reserveRows(patternHeight + 2);
+    const uint32_t row = nextRow + 1;
 
+    const float stretch = atlasWidth / length;
+    std::vector<DashRange> ranges = getDashRanges(dasharray, stretch);
     if (patternCap == LinePatternCap::Round) {
-        addRoundDash(ranges, yOffset, stretch, n, image);
+        addRoundDash(ranges, row, stretch, static_cast<int>(patternHeight / 2), image);
     } else {
-        addRegularDash(ranges, yOffset, image);
+        addRegularDash(ranges, row, image);
     }
 
-    LinePatternPos position;
-    position.y = (0.5f + yOffset + n) / image.size.height;
-    position.height = (2.0f * n + 1) / image.size.height;
-    position.width = length;
-
-    return position;
+    // Linear sampling of the edge rows of the pattern blends them with the rows
+    // next to them. Copies of the edge rows clamp it the way a texture of its own
+    // would, instead of blending with the neighbouring patterns.
+    const auto rowData = [&](uint32_t y) {
+        return image.data.get() + static_cast<size_t>(y) * atlasWidth;
+    };
+    std::memcpy(rowData(row - 1), rowData(row), atlasWidth);
+    std::memcpy(rowData(row + patternHeight), rowData(row + patternHeight - 1), atlasWidth);
+
+    if (!firstDirtyRow) {
+        firstDirtyRow = nextRow;
+    }
+    nextRow += patternHeight + 2;
+    return row;
 }
 
-} // namespace
-
-DashPatternTexture::DashPatternTexture(const std::vector<float>& from_,
-                                       const std::vector<float>& to_,
-                                       const LinePatternCap cap) {
-    const bool patternsIdentical = from_ == to_;
-    const uint32_t patternHeight = cap == LinePatternCap::Round ? 15 : 1;
-    const uint32_t height = (patternsIdentical ? 1 : 2) * patternHeight;
+void LineAtlas::reserveRows(const uint32_t rows) {
+    if (nextRow + rows <= image.size.height) {
+        return;
+    }
 
     // The OpenGL ES 2.0 spec, section 3.8.2 states:
     //
@@ -194,71 +285,35 @@ DashPatternTexture::DashPatternTexture(const std::vector<float>& from_,
     // use GL_CLAMP_TO_EDGE. We're using GL_CLAMP_TO_EDGE for the vertical
     // direction, but GL_REPEAT for the horizontal direction, which means that
     // we need a power-of-two texture for our line dash patterns to work on
-    // OpenGL ES 2.0 conforming implementations. Fortunately, this just means
-    // changing the height from 15 to 16, and from 30 to 32, so we don't waste
-    // many pixels.
-    const uint32_t textureHeight = 1 << util::ceil_log2(height);
-    AlphaImage image({256, textureHeight});
-
-    from = addDashPattern(image, 0, from_, cap);
-    to = patternsIdentical ? from : addDashPattern(image, patternHeight, to_, cap);
-
-    texture = std::move(image);
-}
-
-void DashPatternTexture::upload(gfx::UploadPass& uploadPass) {
-    if (std::holds_alternative<AlphaImage>(texture)) {
-        auto tempTexture = uploadPass.getContext().createTexture2D();
-        tempTexture->upload(std::get<AlphaImage>(texture));
-        tempTexture->setSamplerConfiguration({.filter = gfx::TextureFilterType::Linear,
-                                              .wrapU = gfx::TextureWrapType::Repeat,
-                                              .wrapV = gfx::TextureWrapType::Clamp});
-        texture = std::move(tempTexture);
+    // OpenGL ES 2.0 conforming implementations.
+    const uint32_t height = std::max(32u, 1u << util::ceil_log2(nextRow + rows));
+    image.resize({atlasWidth, height});
+    for (auto& [hash, dashPattern] : textures) {
+        dashPattern.updatePositions(height);
     }
 }
 
-static const gfx::Texture2DPtr noTexture;
-const std::shared_ptr<gfx::Texture2D>& DashPatternTexture::getTexture() const {
-    return (std::holds_alternative<gfx::Texture2DPtr>(texture)) ? std::get<gfx::Texture2DPtr>(texture) : noTexture;
-}
-
-Size DashPatternTexture::getSize() const {
-    if (std::holds_alternative<AlphaImage>(texture)) {
-        return std::get<AlphaImage>(texture).size;
+void LineAtlas::upload(gfx::UploadPass& uploadPass) {
+    if (!firstDirtyRow) {
+        return;
     }
-    return std::get<gfx::Texture2DPtr>(texture)->getSize();
-}
 
-LineAtlas::LineAtlas() = default;
-
-LineAtlas::~LineAtlas() = default;
-
-DashPatternTexture& LineAtlas::getDashPatternTexture(const std::vector<float>& from,
-                                                     const std::vector<float>& to,
-                                                     const LinePatternCap cap) {
-    const size_t hash = util::hash(getDashPatternHash(from, cap), getDashPatternHash(to, cap));
-
-    // Note: We're not handling hash collisions here.
-    const auto it = textures.find(hash);
-    if (it == textures.end()) {
-        auto inserted = textures.emplace(
-            std::piecewise_construct, std::forward_as_tuple(hash), std::forward_as_tuple(from, to, cap));
-        assert(inserted.second);
-        needsUpload.emplace_back(hash);
-        return inserted.first->second;
-    } else {
-        return it->second;
+    if (!texture) {
+        texture = uploadPass.getContext().createTexture2D();
+        texture->setSamplerConfiguration({.filter = gfx::TextureFilterType::Linear,
+                                          .wrapU = gfx::TextureWrapType::Repeat,
+                                          .wrapV = gfx::TextureWrapType::Clamp});
     }
-}
 
-void LineAtlas::upload(gfx::UploadPass& uploadPass) {
-    for (const size_t hash : needsUpload) {
-        const auto it = textures.find(hash);
-        if (it != textures.end()) {
-            it->second.upload(uploadPass);
-        }
+    if (texture->getSize() != image.size) {
+        texture->upload(image);
+    } else {
+        // Only the rows added since the last upload
+        AlphaImage rows({atlasWidth, nextRow - *firstDirtyRow});
+        AlphaImage::copy(image, rows, {0, *firstDirtyRow}, {0, 0}, rows.size);
+        texture->uploadSubRegion(rows, 0, static_cast<uint16_t>(*firstDirtyRow));
     }
-    needsUpload.clear();
+    firstDirtyRow.reset();
 }
 
 } // namespace mbgl
@@ -2,11 +2,12 @@
 
 #include <mbgl/gfx/context.hpp>
 #include <mbgl/util/image.hpp>
+#include <mbgl/util/memory_usage.hpp>
 #include <mbgl/gfx/texture2d.hpp>
 
-#include <variant>
 #include <map>
 #include <memory>
+#include <optional>
 #include <vector>
 
 namespace mbgl {
@@ -34,50 +35,72 @@ struct DashRange {
     bool isZeroLength;
 };
 
+class LineAtlas;
+
+// The rows of a pair of dash patterns within the line atlas.
 class DashPatternTexture {
 public:
-    DashPatternTexture(const std::vector<float>& from, const std::vector<float>& to, LinePatternCap);
-
-    // Uploads the texture to the GPU to be available when we need it. This is a
-    // lazy operation; the texture is only bound when the data is uploaded for
-    // the first time.
-    void upload(gfx::UploadPass&);
+    DashPatternTexture(const LineAtlas&, uint32_t fromRow, float fromLength, uint32_t toRow, float toLength, uint32_t);
 
-    // Binds the atlas texture to the GPU, and uploads data if it is out of date.
+    // The atlas texture, shared by all the dash patterns. It is null until the
+    // atlas is uploaded for the first time.
     const std::shared_ptr<gfx::Texture2D>& getTexture() const;
 
-    // Returns the size of the texture image.
+    // Returns the size of the atlas image.
     Size getSize() const;
 
+    // The positions are relative to the atlas height, updated as it grows.
     const LinePatternPos& getFrom() const { return from; }
     const LinePatternPos& getTo() const { return to; }
 
 private:
+    friend class LineAtlas;
+    void updatePositions(uint32_t atlasHeight);
+
+    const LineAtlas& atlas;
+    // The first row of each pattern, its length, and the rows of each one
+    uint32_t fromRow, toRow;
+    float fromLength, toLength;
+    uint32_t patternHeight;
     LinePatternPos from, to;
-
-    std::variant<AlphaImage, gfx::Texture2DPtr> texture;
 };
 
+// Packs the dash patterns of all the line layers into the rows of one texture,
+// so that dashed layers share a texture and the patterns are told apart by the
+// positions passed in the uniforms.
 class LineAtlas {
 public:
     LineAtlas();
     ~LineAtlas();
 
-    // Obtains or creates a texture that has both line patterns in it
+    // Obtains or adds the rows of both line patterns
     DashPatternTexture& getDashPatternTexture(const std::vector<float>& from,
                                               const std::vector<float>& to,
                                               LinePatternCap);
 
-    // Uploads the textures to the GPU to be available when we need it.
+    // Uploads the rows added since the last upload, or the whole atlas if it grew.
     void upload(gfx::UploadPass&);
 
     bool isEmpty() const { return textures.empty(); }
 
+    MemoryUsage getMemoryUsage() const;
+
+    const AlphaImage& getAtlasImageForTests() const { return image; }
+
 private:
+    friend class DashPatternTexture;
+
+    // Adds a pattern, with a copy of its edge rows above and below it, returning its first row
+    uint32_t addDashPattern(const std::vector<float>& dasharray, LinePatternCap, float& length);
+    void reserveRows(uint32_t rows);
+
     std::map<size_t, DashPatternTexture> textures;
 
-    // Stores a list of hashes of texture objects that need uploading.
-    std::vector<size_t> needsUpload;
+    AlphaImage image;
+    gfx::Texture2DPtr texture;
+    uint32_t nextRow = 0;
+    // The rows added since the last upload
+    std::optional<uint32_t> firstDirtyRow;
 };
 
 } // namespace mbgl
@@ -0,0 +1,87 @@
+#include <mbgl/gfx/context.hpp>
+#include <mbgl/gfx/offscreen_texture.hpp>
+
+#include <algorithm>
+
+namespace mbgl {
+namespace gfx {
+
+Context::~Context() = default;
+
+std::unique_ptr<OffscreenTexture> Context::acquireOffscreenTexture(const Size size, const TextureChannelDataType type) {
+    const auto it = std::ranges::find_if(offscreenTexturePool, [&](const PooledOffscreenTexture& pooled) {
+        return pooled.size == size && pooled.type == type;
+    });
+    if (it == offscreenTexturePool.end()) {
+        stats.numCreatedOffscreenTextures++;
+        return createOffscreenTexture(size, type);
+    }
+
+    auto texture = std::move(it->texture);
+    offscreenTexturePool.erase(it);
+    stats.numReusedOffscreenTextures++;
+    stats.numPooledOffscreenTextures--;
+    return texture;
+}
+
+void Context::releaseOffscreenTexture(std::unique_ptr<OffscreenTexture> texture, const TextureChannelDataType type) {
+    if (!texture) {
+        return;
+    }
+    const auto size = texture->getSize();
+    offscreenTexturePool.push_back({size, type, std::move(texture), 0});
+    stats.numPooledOffscreenTextures++;
+}
+
+void Context::trimOffscreenTexturePool() {
+    const auto erased = std::erase_if(offscreenTexturePool, [](PooledOffscreenTexture& pooled) {
+        return ++pooled.idleFrames > offscreenTexturePoolFrames;
+    });
+    stats.numPooledOffscreenTextures -= static_cast<int>(erased);
+}
+
+void Context::setGPUSectionTimingEnabled(const bool enabled) {
+    gpuSectionTimingEnabled = enabled;
+    if (!enabled) {
+        gpuSectionWindow.clear();
+        gpuSectionTotals.clear();
+        stats.gpuSectionTimes.clear();
+    }
+}
+
+void Context::addGPUSectionTimes(std::map<std::string, double> frameTimes) {
+    for (const auto& [name, time] : frameTimes) {
+        auto& total = gpuSectionTotals[name];
+        total.first += time;
+        total.second++;
+    }
+    gpuSectionWindow.push_back(std::move(frameTimes));
+
+    if (gpuSectionWindow.size() > gpuSectionTimeFrames) {
+        for (const auto& [name, time] : gpuSectionWindow.front()) {
+            const auto it = gpuSectionTotals.find(name);
+            if (--it->second.second == 0) {
+                gpuSectionTotals.erase(it);
+            } else {
+                it->second.first -= time;
+            }
+        }
+        gpuSectionWindow.pop_front();
+    }
+
+    // Sections missing from some frames, like layers hidden at some zoom levels, count as zero in those
+    stats.gpuSectionTimes.clear();
+    stats.gpuSectionTimes.reserve(gpuSectionTotals.size());
+    for (const auto& [name, total] : gpuSectionTotals) {
+        stats.gpuSectionTimes.push_back({name, total.first / static_cast<double>(gpuSectionWindow.size())});
+    }
+    std::ranges::sort(stats.gpuSectionTimes, std::ranges::greater{}, &GPUSectionTime::time);
+}
+
+void Context::clearOffscreenTexturePool() {
+    stats.numPooledOffscreenTextures -= static_cast<int>(offscreenTexturePool.size());
+    offscreenTexturePool.clear();
+}
+
+} // namespace gfx
+} // namespace mbgl
@@ -64,6 +64,16 @@ void Drawable::setTexture(std::shared_ptr<gfx::Texture2D> texture, size_t id) {
     textures[id] = std::move(texture);
 }
 
+bool Drawable::canBatchInstance(const Drawable& other, uint32_t instance) const {
+    // Stencil clipping uses a different reference value for each tile, and instance
+    // attributes already use the instance index, so neither can be batched.
+    return instanceBatchKey != 0 && other.instanceBatchKey == instanceBatchKey &&
+           other.uboIndex == uboIndex + instance && !enableStencil && !other.enableStencil && !is3D && !other.is3D &&
+           !instanceAttributes && !other.instanceAttributes && shader == other.shader &&
+           renderPass == other.renderPass && textures == other.textures && enableDepth == other.enableDepth &&
+           subLayerIndex == other.subLayerIndex && depthType == other.depthType;
+}
+
 PaintPropertyBindersBase* Drawable::getBinders() {
     return impl->binders;
 }
@@ -31,6 +31,11 @@ bool DynamicTexture::isEmpty() const {
     return (numTextures == 0);
 }
 
+std::size_t DynamicTexture::getOccupiedArea() const {
+    std::scoped_lock lock(mutex);
+    return occupiedArea;
+}
+
 std::optional<TextureHandle> DynamicTexture::reserveSize(const Size& size, int32_t uniqueId) {
     std::scoped_lock lock(mutex);
     mapbox::Bin* bin = shelfPack.packOne(uniqueId, size.width, size.height);
@@ -39,6 +44,7 @@ std::optional<TextureHandle> DynamicTexture::reserveSize(const Size& size, int32
     }
     if (bin->refcount() == 1) {
         numTextures++;
+        occupiedArea += static_cast<std::size_t>(bin->w) * bin->h;
     }
     return TextureHandle(*bin);
 }
@@ -66,6 +72,7 @@ bool DynamicTexture::removeTexture(const TextureHandle& texHandle) {
     auto refcount = shelfPack.unref(*bin);
     if (refcount == 0) {
         numTextures--;
+        occupiedArea -= static_cast<std::size_t>(bin->w) * bin->h;
         return true;
     }
     return false;
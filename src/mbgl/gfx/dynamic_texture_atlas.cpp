@@ -1,5 +1,6 @@
 #include <mbgl/gfx/dynamic_texture_atlas.hpp>
 #include <mbgl/gfx/context.hpp>
+#include <mbgl/gfx/texture2d.hpp>
 
 #include <algorithm>
 #include <cmath>
@@ -11,14 +12,42 @@ constexpr const uint16_t extraPadding = 1;
 constexpr const uint16_t padding = ImagePosition::padding + extraPadding;
 constexpr const Size startSize = {512, 512};
 constexpr const Size dummySize = {1, 1};
+// A texture that can't fit a request is considered fragmented if, compacted, it would be at most this full
+constexpr const double fragmentedOccupancy = 0.75;
 
 namespace {
 Rect<uint16_t> rectWithoutExtraPadding(const Rect<uint16_t>& rect) {
     return Rect<uint16_t>(
         rect.x + extraPadding, rect.y + extraPadding, rect.w - 2 * extraPadding, rect.h - 2 * extraPadding);
 }
+
+Size paddedSize(const Size& size) {
+    return Size(size.width + 2 * padding, size.height + 2 * padding);
+}
+
+std::size_t textureBytes(const DynamicTexture& dynamicTexture) {
+    const auto& texture = dynamicTexture.getTexture();
+    return texture->getSize().area() * texture->getPixelStride();
+}
 } // namespace
 
+void DynamicTextureAtlas::retireIfFragmented(size_t& dynTexIndex, std::size_t requiredArea) {
+    // Only textures this atlas packed before, a new texture too small for the request isn't fragmented
+    if (dynTexIndex == 0 || dynTexIndex > dynamicTextures.size()) {
+        return;
+    }
+    const auto& dynamicTexture = dynamicTextures[dynTexIndex - 1];
+    const auto occupiedArea = dynamicTexture->getOccupiedArea();
+    const auto area = dynamicTexture->getTexture()->getSize().area();
+    if (occupiedArea == 0 || static_cast<double>(occupiedArea + requiredArea) > fragmentedOccupancy * area) {
+        return;
+    }
+
+    retiredTextures.emplace_back(dynamicTexture);
+    dynamicTextures.erase(dynamicTextures.begin() + (dynTexIndex - 1));
+    dynTexIndex--;
+}
+
 GlyphAtlas DynamicTextureAtlas::uploadGlyphs(const GlyphMap& glyphs) {
     using GlyphsToUpload = std::vector<std::tuple<TextureHandle, Immutable<Glyph>, FontStackHash>>;
     std::scoped_lock lock(mutex);
@@ -39,6 +68,15 @@ GlyphAtlas DynamicTextureAtlas::uploadGlyphs(const GlyphMap& glyphs) {
     size_t dynTexIndex = 0;
     Size dynTexSize = startSize;
     GlyphsToUpload glyphsToUpload;
+    std::size_t requiredArea = 0;
+    for (const auto& glyphMapEntry : glyphs) {
+        for (const auto& glyphEntry : glyphMapEntry.second) {
+            const auto& glyph = glyphEntry.second;
+            if (glyph.has_value() && glyph.value()->bitmap.valid()) {
+                requiredArea += paddedSize(glyph.value()->bitmap.size).area();
+            }
+        }
+    }
 
     while (!glyphAtlas.dynamicTexture) {
         if (dynTexIndex < dynamicTextures.size()) {
@@ -63,8 +101,7 @@ GlyphAtlas DynamicTextureAtlas::uploadGlyphs(const GlyphMap& glyphs) {
 
                 if (glyph.has_value() && glyph.value()->bitmap.valid()) {
                     int32_t uniqueId = static_cast<int32_t>(sqrt(fontStack) / 2 + glyph.value()->id.hash);
-                    const auto size = Size(glyph.value()->bitmap.size.width + 2 * padding,
-                                           glyph.value()->bitmap.size.height + 2 * padding);
+                    const auto size = paddedSize(glyph.value()->bitmap.size);
                     const auto& texHandle = glyphAtlas.dynamicTexture->reserveSize(size, uniqueId);
                     if (!texHandle) {
                         hasSpace = false;
@@ -79,6 +116,7 @@ GlyphAtlas DynamicTextureAtlas::uploadGlyphs(const GlyphMap& glyphs) {
                 }
                 glyphsToUpload.clear();
                 glyphAtlas.dynamicTexture = nullptr;
+                retireIfFragmented(dynTexIndex, requiredArea);
                 break;
             }
         }
@@ -130,6 +168,13 @@ ImageAtlas DynamicTextureAtlas::uploadIconsAndPatterns(const ImageMap& icons,
 
     iconsToUpload.reserve(icons.size());
     patternsToUpload.reserve(patterns.size());
+    std::size_t requiredArea = 0;
+    for (const auto& iconEntry : icons) {
+        requiredArea += paddedSize(iconEntry.second->image.size).area();
+    }
+    for (const auto& patternEntry : patterns) {
+        requiredArea += paddedSize(patternEntry.second->image.size).area();
+    }
     while (!imageAtlas.dynamicTexture) {
         if (dynTexIndex < dynamicTextures.size()) {
             imageAtlas.dynamicTexture = dynamicTextures[dynTexIndex++];
@@ -150,7 +195,7 @@ ImageAtlas DynamicTextureAtlas::uploadIconsAndPatterns(const ImageMap& icons,
 
             auto imageHash = util::hash(icon->id);
             int32_t uniqueId = static_cast<int32_t>(sqrt(imageHash) / 2 + icon->image.size.area());
-            const auto size = Size(icon->image.size.width + 2 * padding, icon->image.size.height + 2 * padding);
+            const auto size = paddedSize(icon->image.size);
             const auto& texHandle = imageAtlas.dynamicTexture->reserveSize(size, uniqueId);
             if (!texHandle) {
                 hasSpace = false;
@@ -164,8 +209,7 @@ ImageAtlas DynamicTextureAtlas::uploadIconsAndPatterns(const ImageMap& icons,
 
                 auto patternHash = util::hash(pattern->id);
                 int32_t uniqueId = static_cast<int32_t>(sqrt(patternHash) / 2 + pattern->image.size.area());
-                const auto size = Size(pattern->image.size.width + 2 * padding,
-                                       pattern->image.size.height + 2 * padding);
+                const auto size = paddedSize(pattern->image.size);
                 const auto& texHandle = imageAtlas.dynamicTexture->reserveSize(size, uniqueId);
                 if (!texHandle) {
                     hasSpace = false;
@@ -184,6 +228,7 @@ ImageAtlas DynamicTextureAtlas::uploadIconsAndPatterns(const ImageMap& icons,
             }
             patternsToUpload.clear();
             imageAtlas.dynamicTexture = nullptr;
+            retireIfFragmented(dynTexIndex, requiredArea);
             continue;
         }
     }
@@ -255,7 +300,26 @@ void DynamicTextureAtlas::removeTextures(const std::vector<TextureHandle>& textu
         if (iterator != dynamicTextures.end()) {
             dynamicTextures.erase(iterator);
         }
+        auto retired = std::ranges::find(retiredTextures, dynamicTexture);
+        if (retired != retiredTextures.end()) {
+            retiredTextures.erase(retired);
+        }
+    }
+}
+
+DynamicTextureAtlas::Stats DynamicTextureAtlas::getStats() const {
+    std::scoped_lock lock(mutex);
+    Stats stats;
+    stats.numTextures = dynamicTextures.size();
+    stats.numRetiredTextures = retiredTextures.size();
+    for (const auto* textures : {&dynamicTextures, &retiredTextures}) {
+        for (const auto& dynamicTexture : *textures) {
+            const auto& texture = dynamicTexture->getTexture();
+            stats.textureBytes += textureBytes(*dynamicTexture);
+            stats.occupiedBytes += dynamicTexture->getOccupiedArea() * texture->getPixelStride();
+        }
     }
+    return stats;
 }
 
 } // namespace gfx
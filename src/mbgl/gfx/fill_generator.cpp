@@ -43,7 +43,7 @@ std::size_t addRingVertices(gfx::VertexVector<FillLayoutVertex>& vertices, const
     return ring.size();
 }
 
-std::size_t totalVerticesCheck(const GeometryCollection& polygon) {
+std::size_t totalVerticesCheck(const PolygonRingRefs& polygon) {
     std::size_t totalVertices = 0;
     for (const auto& ring : polygon) {
         totalVertices += ring.size();
@@ -52,9 +52,10 @@ std::size_t totalVerticesCheck(const GeometryCollection& polygon) {
     return totalVertices;
 }
 
+template <typename Index>
 void addFillIndices(SegmentVector& fillSegments,
                     gfx::IndexVector<gfx::Triangles>& fillIndexes,
-                    const std::span<const uint32_t>& indices,
+                    const std::span<const Index>& indices,
                     const std::size_t startVertices,
                     const std::size_t totalVertices) {
     const std::size_t nIndices = indices.size();
@@ -81,6 +82,28 @@ void addFillIndices(SegmentVector& fillSegments,
     triangleSegment.indexLength += nIndices;
 }
 
+// Triangulates a polygon into the fill indices, reusing the feature's cached triangulation if it has one
+void addPolygonFillIndices(SegmentVector& fillSegments,
+                           gfx::IndexVector<gfx::Triangles>& fillIndexes,
+                           const PolygonRingRefs& polygon,
+                           const std::size_t polygonIndex,
+                           TriangulationCache::Feature* triangulations,
+                           const std::size_t startVertices,
+                           const std::size_t totalVertices) {
+    if (triangulations) {
+        if (const auto* cached = triangulations->find(polygonIndex, totalVertices)) {
+            addFillIndices(fillSegments, fillIndexes, std::span<const uint16_t>(*cached), startVertices, totalVertices);
+            return;
+        }
+    }
+
+    const std::vector<uint32_t> indices = mapbox::earcut(polygon);
+    if (triangulations) {
+        triangulations->insert(polygonIndex, totalVertices, indices);
+    }
+    addFillIndices(fillSegments, fillIndexes, std::span<const uint32_t>(indices), startVertices, totalVertices);
+}
+
 void addOutlineIndices(const std::size_t base,
                        const std::size_t nVertices,
                        SegmentVector& lineSegments,
@@ -109,8 +132,10 @@ void addOutlineIndices(const std::size_t base,
 void generateFillBuffers(const GeometryCollection& geometry,
                          gfx::VertexVector<FillLayoutVertex>& fillVertices,
                          gfx::IndexVector<Triangles>& fillIndexes,
-                         SegmentVector& fillSegments) {
-    for (auto& polygon : classifyRings(geometry)) {
+                         SegmentVector& fillSegments,
+                         TriangulationCache::Feature* triangulations) {
+    std::size_t polygonIndex = 0;
+    for (auto& polygon : classifyRingRefs(geometry)) {
         // Optimize polygons with many interior rings for earcut tesselation.
         limitHoles(polygon, 500);
 
@@ -121,8 +146,8 @@ void generateFillBuffers(const GeometryCollection& geometry,
             addRingVertices(fillVertices, ring);
         }
 
-        std::vector<uint32_t> indices = mapbox::earcut(polygon);
-        addFillIndices(fillSegments, fillIndexes, indices, startVertices, totalVertices);
+        addPolygonFillIndices(
+            fillSegments, fillIndexes, polygon, polygonIndex++, triangulations, startVertices, totalVertices);
     }
 }
 
@@ -131,8 +156,10 @@ void generateFillAndOutineBuffers(const GeometryCollection& geometry,
                                   gfx::IndexVector<gfx::Triangles>& fillIndexes,
                                   SegmentVector& fillSegments,
                                   gfx::IndexVector<gfx::Lines>& lineIndexes,
-                                  SegmentVector& lineSegments) {
-    for (auto& polygon : classifyRings(geometry)) {
+                                  SegmentVector& lineSegments,
+                                  TriangulationCache::Feature* triangulations) {
+    std::size_t polygonIndex = 0;
+    for (auto& polygon : classifyRingRefs(geometry)) {
         // Optimize polygons with many interior rings for earcut tesselation.
         limitHoles(polygon, 500);
 
@@ -145,8 +172,8 @@ void generateFillAndOutineBuffers(const GeometryCollection& geometry,
             addOutlineIndices(base, nVertices, lineSegments, lineIndexes);
         }
 
-        std::vector<uint32_t> indices = mapbox::earcut(polygon);
-        addFillIndices(fillSegments, fillIndexes, indices, startVertices, totalVertices);
+        addPolygonFillIndices(
+            fillSegments, fillIndexes, polygon, polygonIndex++, triangulations, startVertices, totalVertices);
     }
 }
 
@@ -156,7 +183,8 @@ void generateFillAndOutineBuffers(const GeometryCollection& geometry,
                                   SegmentVector& fillSegments,
                                   gfx::VertexVector<LineLayoutVertex>& lineVertices,
                                   gfx::IndexVector<gfx::Triangles>& lineIndexes,
-                                  SegmentVector& lineSegments) {
+                                  SegmentVector& lineSegments,
+                                  TriangulationCache::Feature* triangulations) {
     gfx::PolylineGenerator<LineLayoutVertex, SegmentBase> lineGenerator(
         lineVertices,
         LineBucket::layoutVertex,
@@ -170,7 +198,8 @@ void generateFillAndOutineBuffers(const GeometryCollection& geometry,
     gfx::PolylineGeneratorOptions lineOptions;
     lineOptions.type = FeatureType::Polygon;
 
-    for (auto& polygon : classifyRings(geometry)) {
+    std::size_t polygonIndex = 0;
+    for (auto& polygon : classifyRingRefs(geometry)) {
         // Optimize polygons with many interior rings for earcut tesselation.
         limitHoles(polygon, 500);
 
@@ -182,8 +211,8 @@ void generateFillAndOutineBuffers(const GeometryCollection& geometry,
             lineGenerator.generate(ring, lineOptions);
         }
 
-        std::vector<uint32_t> indices = mapbox::earcut(polygon);
-        addFillIndices(fillSegments, fillIndexes, indices, startVertices, totalVertices);
+        addPolygonFillIndices(
+            fillSegments, fillIndexes, polygon, polygonIndex++, triangulations, startVertices, totalVertices);
     }
 }
 
@@ -195,7 +224,8 @@ void generateFillAndOutineBuffers(const GeometryCollection& geometry,
                                   gfx::IndexVector<gfx::Triangles>& lineIndexes,
                                   SegmentVector& lineSegments,
                                   gfx::IndexVector<gfx::Lines>& basicLineIndexes,
-                                  SegmentVector& basicLineSegments) {
+                                  SegmentVector& basicLineSegments,
+                                  TriangulationCache::Feature* triangulations) {
     gfx::PolylineGenerator<LineLayoutVertex, SegmentBase> lineGenerator(
         lineVertices,
         LineBucket::layoutVertex,
@@ -222,7 +252,8 @@ void generateFillAndOutineBuffers(const GeometryCollection& geometry,
         return;
     }
 
-    for (auto& polygon : classifyRings(geometry)) {
+    std::size_t polygonIndex = 0;
+    for (auto& polygon : classifyRingRefs(geometry)) {
         // Optimize polygons with many interior rings for earcut tesselation.
         limitHoles(polygon, 500);
 
@@ -237,9 +268,8 @@ void generateFillAndOutineBuffers(const GeometryCollection& geometry,
         }
 
         // tessellate, if no triangles are provided
-        std::vector<uint32_t> indices = mapbox::earcut(polygon);
-
-        addFillIndices(fillSegments, fillIndexes, indices, startVertices, totalVertices);
+        addPolygonFillIndices(
+            fillSegments, fillIndexes, polygon, polygonIndex++, triangulations, startVertices, totalVertices);
     }
 }
 
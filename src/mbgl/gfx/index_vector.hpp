@@ -2,6 +2,7 @@
 
 #include <mbgl/gfx/draw_mode.hpp>
 #include <mbgl/util/ignore.hpp>
+#include <mbgl/util/memory_usage.hpp>
 
 #include <memory>
 #include <vector>
@@ -28,29 +29,41 @@ public:
     IndexVectorBase(IndexVectorBase&& other)
         : v(std::move(other.v)),
           buffer(std::move(other.buffer)),
+          bufferBytes(other.bufferBytes),
           dirty(other.dirty),
-          released(other.released) {}
+          released(other.released),
+          discarded(other.discarded),
+          discardedCount(other.discardedCount) {}
     virtual ~IndexVectorBase() = default;
 
     IndexBufferBase* getBuffer() const { return buffer.get(); }
-    void setBuffer(std::unique_ptr<IndexBufferBase>&& value) { buffer = std::move(value); }
+    void setBuffer(std::unique_ptr<IndexBufferBase>&& value) {
+        buffer = std::move(value);
+        bufferBytes = buffer ? bytes() : 0;
+    }
+
+    /// Bytes held by the raw index data and by the uploaded buffer, if any
+    MemoryUsage getMemoryUsage() const { return {.cpu = v.size() * sizeof(uint16_t), .gpu = bufferBytes}; }
 
     bool getDirty() const { return dirty; }
     void setDirty(bool value = true) { dirty = value; }
 
     bool isReleased() const { return released; }
 
+    /// Whether the raw indexes were freed once uploaded, see `discardUploadedData`
+    bool isDiscarded() const { return discarded; }
+
     void reserve(std::size_t count) { v.reserve(count); }
 
     void extend(std::size_t n, const uint16_t val) {
-        assert(!released);
+        assert(!released && !discarded);
         v.resize(v.size() + n, val);
         dirty = true;
     }
 
     uint16_t& at(std::size_t n) {
         assert(n < v.size());
-        assert(!released);
+        assert(!released && !discarded);
         dirty = true;
         return v.at(n);
     }
@@ -59,14 +72,16 @@ public:
         return v.at(n);
     }
 
-    std::size_t elements() const { return v.size(); }
+    std::size_t elements() const { return discarded ? discardedCount : v.size(); }
 
-    std::size_t bytes() const { return v.size() * sizeof(uint16_t); }
+    std::size_t bytes() const { return elements() * sizeof(uint16_t); }
 
-    bool empty() const { return v.empty(); }
+    bool empty() const { return elements() == 0; }
 
     void clear() {
         dirty = true;
+        discarded = false;
+        discardedCount = 0;
         v.clear();
         buffer.reset();
     }
@@ -80,14 +95,27 @@ public:
         released = true;
     }
 
+    /// Free the raw indexes if they're uploaded and unmodified since, keeping their count for the drawables built
+    /// from them. The indexes can't be modified afterwards, their buffer being reused as is.
+    void discardUploadedData() {
+        if (buffer && !dirty && !discarded) {
+            discardedCount = v.size();
+            std::vector<uint16_t>().swap(v);
+            discarded = true;
+        }
+    }
+
     const uint16_t* data() const { return v.data(); }
 
     const std::vector<uint16_t>& vector() const { return v; }
 
 protected:
     std::unique_ptr<IndexBufferBase> buffer;
+    std::size_t bufferBytes = 0;
     bool dirty = true;
     bool released = false;
+    bool discarded = false;
+    std::size_t discardedCount = 0;
 };
 
 using IndexVectorBasePtr = std::shared_ptr<IndexVectorBase>;
@@ -100,7 +128,7 @@ public:
     template <class... Args>
     void emplace_back(Args&&... args) {
         static_assert(sizeof...(args) % groupSize == 0, "wrong buffer element count");
-        assert(!released);
+        assert(!released && !discarded);
         util::ignore({(v.emplace_back(std::forward<Args>(args)), 0)...});
         dirty = true;
     }
@@ -1,4 +1,5 @@
 #include <mbgl/gfx/polyline_generator.hpp>
+#include <mbgl/gfx/polyline_segments.hpp>
 
 #include <mbgl/style/types.hpp>
 #include <mbgl/util/constants.hpp>
@@ -136,12 +137,18 @@ void PolylineGenerator<PLV, PS>::generate(const GeometryCoordinates& coordinates
     }
 
     const std::size_t startVertex = vertices.elements();
-    std::vector<TriangleElement> triangleStore;
+    util::ArenaVector<TriangleElement> triangleStore;
 
     // Pre-allocate for triangles based on measuring benchmark execution
     constexpr auto approxTrianglesPerSegment = 6;
     triangleStore.reserve((len - first) * approxTrianglesPerSegment);
 
+    // Normals and lengths of the segments between consecutive coordinates, computed in batches
+    PolylineSegments segmentData;
+    segmentData.compute(coordinates, first, len);
+    // The segment ending at the current vertex, while it's still the one from prevCoordinate
+    std::optional<std::size_t> prevSegment;
+
     // Vertex count depends on length rather than segment count, and two elements often generates
     // thousands of vertices, so we allocate some extra memory to skip the next 10 allocations.
     if (vertices.empty()) {
@@ -177,8 +184,14 @@ void PolylineGenerator<PLV, PS>::generate(const GeometryCoordinates& coordinates
         // Calculate the normal towards the next vertex in this line. In case
         // there is no next vertex, pretend that the line is continuing
         // straight, meaning that we are just using the previous normal.
-        nextNormal = nextCoordinate ? util::perp(util::unit(convertPoint<double>(*nextCoordinate - *currentCoordinate)))
-                                    : prevNormal;
+        if (!nextCoordinate) {
+            nextNormal = prevNormal;
+        } else if (i + 1 < len) {
+            nextNormal = segmentData.normal(i);
+        } else {
+            // The closing segment of a polygon
+            nextNormal = util::perp(util::unit(convertPoint<double>(*nextCoordinate - *currentCoordinate)));
+        }
 
         // If we still don't have a previous normal, this is the beginning of a
         // non-closed line, so we're doing a straight "join".
@@ -239,6 +252,7 @@ void PolylineGenerator<PLV, PS>::generate(const GeometryCoordinates& coordinates
                                  triangleStore,
                                  options.clipDistances);
                 prevCoordinate = newPrevVertex;
+                prevSegment = {};
             }
         }
 
@@ -277,7 +291,11 @@ void PolylineGenerator<PLV, PS>::generate(const GeometryCoordinates& coordinates
         }
 
         // Calculate how far along the line the currentVertex is
-        if (prevCoordinate) distance += util::dist<double>(*currentCoordinate, *prevCoordinate);
+        if (prevSegment) {
+            distance += segmentData.length(*prevSegment);
+        } else if (prevCoordinate) {
+            distance += util::dist<double>(*currentCoordinate, *prevCoordinate);
+        }
 
         if (middleVertex && currentJoin == style::LineJoinType::Miter) {
             joinNormal = joinNormal * miterLength;
@@ -507,7 +525,7 @@ void PolylineGenerator<PLV, PS>::generate(const GeometryCoordinates& coordinates
         }
 
         if (isSharpCorner && i < len - 1) {
-            const auto nextSegmentLength = util::dist<double>(*currentCoordinate, *nextCoordinate);
+            const auto nextSegmentLength = segmentData.length(i);
             if (nextSegmentLength > 2 * sharpCornerOffset) {
                 GeometryCoordinate newCurrentVertex = *currentCoordinate +
                                                       convertPoint<int16_t>(util::round(
@@ -527,6 +545,9 @@ void PolylineGenerator<PLV, PS>::generate(const GeometryCoordinates& coordinates
             }
         }
 
+        prevSegment = nextCoordinate && i + 1 < len && *currentCoordinate == coordinates[i]
+                          ? std::optional<std::size_t>(i)
+                          : std::nullopt;
         startOfLine = false;
     }
 
@@ -562,7 +583,7 @@ void PolylineGenerator<PLV, PS>::addCurrentVertex(const GeometryCoordinate& curr
                                                   double endRight,
                                                   bool round,
                                                   std::size_t startVertex,
-                                                  std::vector<TriangleElement>& triangleStore,
+                                                  util::ArenaVector<TriangleElement>& triangleStore,
                                                   std::optional<PolylineGeneratorDistances> lineDistances) {
     Point<double> extrude = normal;
     const double scaledDistance = lineDistances ? lineDistances->scaleToMaxLineDistance(distance) : distance;
@@ -613,7 +634,7 @@ void PolylineGenerator<PLV, PS>::addPieSliceVertex(const GeometryCoordinate& cur
                                                    const Point<double>& extrude,
                                                    bool lineTurnsLeft,
                                                    std::size_t startVertex,
-                                                   std::vector<TriangleElement>& triangleStore,
+                                                   util::ArenaVector<TriangleElement>& triangleStore,
                                                    std::optional<PolylineGeneratorDistances> lineDistances) {
     Point<double> flippedExtrude = extrude * (lineTurnsLeft ? -1.0 : 1.0);
     if (lineDistances) {
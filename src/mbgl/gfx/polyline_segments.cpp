@@ -0,0 +1,131 @@
+#include <mbgl/gfx/polyline_segments.hpp>
+
+#include <mbgl/util/math.hpp>
+
+#include <cassert>
+#include <cstdint>
+
+// Define MLN_POLYLINE_SEGMENTS_SCALAR to build the portable code path only
+#if defined(MLN_POLYLINE_SEGMENTS_SCALAR)
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MLN_POLYLINE_SEGMENTS_SSE2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define MLN_POLYLINE_SEGMENTS_NEON 1
+#endif
+
+namespace mbgl {
+namespace gfx {
+
+namespace {
+
+static_assert(sizeof(GeometryCoordinate) == 2 * sizeof(int16_t), "coordinates are loaded as pairs of int16");
+
+// Coordinates as interleaved x, y pairs, for the vector loads
+const int16_t* coordinateData(const GeometryCoordinates& coordinates, std::size_t i) {
+    return reinterpret_cast<const int16_t*>(coordinates.data() + i);
+}
+
+} // namespace
+
+void PolylineSegments::resize(std::size_t begin, std::size_t end) {
+    assert(begin <= end);
+    const std::size_t count = end > begin ? end - begin - 1 : 0;
+    offset = begin;
+    normalXs.resize(count);
+    normalYs.resize(count);
+    lengths.resize(count);
+}
+
+void PolylineSegments::computeSegment(const GeometryCoordinates& coordinates, std::size_t i) {
+    const GeometryCoordinate& current = coordinates[i];
+    const GeometryCoordinate& next = coordinates[i + 1];
+    const Point<double> normal = util::perp(util::unit(convertPoint<double>(next - current)));
+    normalXs[i - offset] = normal.x;
+    normalYs[i - offset] = normal.y;
+    lengths[i - offset] = util::dist<double>(current, next);
+}
+
+void PolylineSegments::computeScalar(const GeometryCoordinates& coordinates, std::size_t begin, std::size_t end) {
+    assert(end <= coordinates.size());
+    resize(begin, end);
+
+    for (std::size_t i = begin; i + 1 < end; ++i) {
+        computeSegment(coordinates, i);
+    }
+}
+
+void PolylineSegments::compute(const GeometryCoordinates& coordinates, std::size_t begin, std::size_t end) {
+    assert(end <= coordinates.size());
+    resize(begin, end);
+
+    std::size_t i = begin;
+#if defined(MLN_POLYLINE_SEGMENTS_SSE2)
+    const __m128d zero = _mm_setzero_pd();
+    const __m128d one = _mm_set1_pd(1.0);
+    const __m128d signBit = _mm_set1_pd(-0.0);
+    const auto load = [&](std::size_t j) {
+        // (x0, y0, x1, y1), sign extended
+        const __m128i points = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(coordinateData(coordinates, j)));
+        return _mm_srai_epi32(_mm_unpacklo_epi16(points, points), 16);
+    };
+    for (; i + 2 < end; i += 2) {
+        // (dx0, dx1, dy0, dy1)
+        const __m128i delta = _mm_shuffle_epi32(_mm_sub_epi32(load(i + 1), load(i)), _MM_SHUFFLE(3, 1, 2, 0));
+        // Normals come from the difference wrapped to 16 bits, like the point subtraction
+        const __m128i wrapped = _mm_srai_epi32(_mm_slli_epi32(delta, 16), 16);
+
+        const __m128d dx = _mm_cvtepi32_pd(delta);
+        const __m128d dy = _mm_cvtepi32_pd(_mm_unpackhi_epi64(delta, delta));
+        const __m128d length = _mm_sqrt_pd(_mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy)));
+
+        const __m128d wx = _mm_cvtepi32_pd(wrapped);
+        const __m128d wy = _mm_cvtepi32_pd(_mm_unpackhi_epi64(wrapped, wrapped));
+        const __m128d magnitude = _mm_sqrt_pd(_mm_add_pd(_mm_mul_pd(wx, wx), _mm_mul_pd(wy, wy)));
+        const __m128d scale = _mm_and_pd(_mm_cmpgt_pd(magnitude, zero), _mm_div_pd(one, magnitude));
+
+        _mm_storeu_pd(&normalXs[i - offset], _mm_xor_pd(_mm_mul_pd(wy, scale), signBit));
+        _mm_storeu_pd(&normalYs[i - offset], _mm_mul_pd(wx, scale));
+        _mm_storeu_pd(&lengths[i - offset], length);
+    }
+#elif defined(MLN_POLYLINE_SEGMENTS_NEON)
+    const float64x2_t zero = vdupq_n_f64(0.0);
+    const float64x2_t one = vdupq_n_f64(1.0);
+    const auto load = [&](std::size_t j) {
+        // (x0, y0, x1, y1), sign extended
+        return vmovl_s16(vld1_s16(coordinateData(coordinates, j)));
+    };
+    const auto toDouble = [](int32x2_t v) {
+        return vcvtq_f64_s64(vmovl_s32(v));
+    };
+    for (; i + 2 < end; i += 2) {
+        const int32x4_t difference = vsubq_s32(load(i + 1), load(i));
+        // (dx0, dx1, dy0, dy1)
+        const int32x4_t delta = vcombine_s32(vget_low_s32(vuzp1q_s32(difference, difference)),
+                                             vget_low_s32(vuzp2q_s32(difference, difference)));
+        // Normals come from the difference wrapped to 16 bits, like the point subtraction
+        const int32x4_t wrapped = vshrq_n_s32(vshlq_n_s32(delta, 16), 16);
+
+        const float64x2_t dx = toDouble(vget_low_s32(delta));
+        const float64x2_t dy = toDouble(vget_high_s32(delta));
+        const float64x2_t length = vsqrtq_f64(vaddq_f64(vmulq_f64(dx, dx), vmulq_f64(dy, dy)));
+
+        const float64x2_t wx = toDouble(vget_low_s32(wrapped));
+        const float64x2_t wy = toDouble(vget_high_s32(wrapped));
+        const float64x2_t magnitude = vsqrtq_f64(vaddq_f64(vmulq_f64(wx, wx), vmulq_f64(wy, wy)));
+        const float64x2_t scale = vreinterpretq_f64_u64(
+            vandq_u64(vcgtq_f64(magnitude, zero), vreinterpretq_u64_f64(vdivq_f64(one, magnitude))));
+
+        vst1q_f64(&normalXs[i - offset], vnegq_f64(vmulq_f64(wy, scale)));
+        vst1q_f64(&normalYs[i - offset], vmulq_f64(wx, scale));
+        vst1q_f64(&lengths[i - offset], length);
+    }
+#endif
+    for (; i + 1 < end; ++i) {
+        computeSegment(coordinates, i);
+    }
+}
+
+} // namespace gfx
+} // namespace mbgl
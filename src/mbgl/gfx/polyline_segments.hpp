@@ -0,0 +1,43 @@
+#pragma once
+
+#include <mbgl/tile/geometry_tile_data.hpp>
+#include <mbgl/util/arena.hpp>
+#include <mbgl/util/geometry.hpp>
+
+#include <cstddef>
+
+namespace mbgl {
+namespace gfx {
+
+/**
+    The unit normals and lengths of the segments of a line, computed for a whole run of
+    coordinates ahead of tessellation.
+
+    Segment `i` goes from `coordinates[i]` to `coordinates[i + 1]`. Its normal is
+    `perp(unit(next - current))` and its length the distance between the two, the same values
+    `PolylineGenerator` would compute vertex by vertex. `compute` processes two segments per step
+    with SSE2 or NEON where available, defining MLN_POLYLINE_SEGMENTS_SCALAR builds the portable
+    loop only. A segment of length zero has a zero normal.
+ */
+class PolylineSegments {
+public:
+    /// Computes segments `[begin, end - 1)`, replacing any previous ones
+    void compute(const GeometryCoordinates& coordinates, std::size_t begin, std::size_t end);
+    /// Same as `compute`, one segment at a time
+    void computeScalar(const GeometryCoordinates& coordinates, std::size_t begin, std::size_t end);
+
+    Point<double> normal(std::size_t i) const { return {normalXs[i - offset], normalYs[i - offset]}; }
+    double length(std::size_t i) const { return lengths[i - offset]; }
+
+private:
+    void resize(std::size_t begin, std::size_t end);
+    void computeSegment(const GeometryCoordinates& coordinates, std::size_t i);
+
+    util::ArenaVector<double> normalXs;
+    util::ArenaVector<double> normalYs;
+    util::ArenaVector<double> lengths;
+    std::size_t offset = 0;
+};
+
+} // namespace gfx
+} // namespace mbgl
@@ -15,6 +15,14 @@ RendererBackend::RendererBackend(const ContextMode contextMode_, const TaggedSch
 
 RendererBackend::~RendererBackend() = default;
 
+void RendererBackend::runRenderJobs() {
+    if (renderJobBudget > Duration::zero()) {
+        threadPool.runRenderJobs(renderJobBudget);
+    } else {
+        threadPool.runRenderJobs();
+    }
+}
+
 gfx::Context& RendererBackend::getContext() {
     assert(BackendScope::exists());
     std::call_once(initialized, [this] { context = createContext(); });
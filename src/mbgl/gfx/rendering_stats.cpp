@@ -31,19 +31,43 @@ bool RenderingStats::isZero() const {
 RenderingStats& RenderingStats::operator+=(const RenderingStats& r) {
     encodingTime += r.encodingTime;
     renderingTime += r.renderingTime;
+    drawableEncodingTime += r.drawableEncodingTime;
+    frameWaitTime += r.frameWaitTime;
+    gpuTime += r.gpuTime;
+    styleUpdateTime += r.styleUpdateTime;
+    sourceUpdateTime += r.sourceUpdateTime;
+    prepareTime += r.prepareTime;
+    placementTime += r.placementTime;
+    renderTreeTime += r.renderTreeTime;
+    layerUpdateTime += r.layerUpdateTime;
+    tweakerTime += r.tweakerTime;
+    uploadTime += r.uploadTime;
+    passEncodingTime += r.passEncodingTime;
+    numCameraOnlyUpdates += r.numCameraOnlyUpdates;
+    numSkippedTweakerUpdates += r.numSkippedTweakerUpdates;
     numFrames += r.numFrames;
     numDrawCalls += r.numDrawCalls;
     totalDrawCalls += r.totalDrawCalls;
+    numTriangles += r.numTriangles;
+    numOccludedDrawables += r.numOccludedDrawables;
+    numCulledSymbols += r.numCulledSymbols;
+    numVariableAnchorTests += r.numVariableAnchorTests;
+    numPreviousAnchorPlacements += r.numPreviousAnchorPlacements;
     numCreatedTextures += r.numCreatedTextures;
     numActiveTextures += r.numActiveTextures;
     numTextureBindings += r.numTextureBindings;
     numTextureUpdates += r.numTextureUpdates;
     textureUpdateBytes += r.textureUpdateBytes;
+    numCreatedOffscreenTextures += r.numCreatedOffscreenTextures;
+    numReusedOffscreenTextures += r.numReusedOffscreenTextures;
+    numPooledOffscreenTextures += r.numPooledOffscreenTextures;
     totalBuffers += r.totalBuffers;
     totalBufferObjs += r.totalBufferObjs;
     bufferUpdates += r.bufferUpdates;
     bufferObjUpdates += r.bufferObjUpdates;
     bufferUpdateBytes += r.bufferUpdateBytes;
+    numHeapAllocations += r.numHeapAllocations;
+    numHeaps += r.numHeaps;
     numBuffers += r.numBuffers;
     numFrameBuffers += r.numFrameBuffers;
     numIndexBuffers += r.numIndexBuffers;
@@ -53,6 +77,11 @@ RenderingStats& RenderingStats::operator+=(const RenderingStats& r) {
     numUniformBuffers += r.numUniformBuffers;
     numUniformUpdates += r.numUniformUpdates;
     uniformUpdateBytes += r.uniformUpdateBytes;
+    frameUniformUpdateBytes += r.frameUniformUpdateBytes;
+    numUniformBindings += r.numUniformBindings;
+    numDescriptorSetUpdates += r.numDescriptorSetUpdates;
+    numRedundantStateCalls += r.numRedundantStateCalls;
+    numRenderBundleReplays += r.numRenderBundleReplays;
     memTextures += r.memTextures;
     memBuffers += r.memBuffers;
     memIndexBuffers += r.memIndexBuffers;
@@ -77,19 +106,46 @@ std::string RenderingStats::toString(std::string_view sep) const {
 
     optionalStatLine(ss, encodingTime, "encodingTime", sep);
     optionalStatLine(ss, renderingTime, "renderingTime", sep);
+    optionalStatLine(ss, drawableEncodingTime, "drawableEncodingTime", sep);
+    optionalStatLine(ss, frameWaitTime, "frameWaitTime", sep);
+    optionalStatLine(ss, gpuTime, "gpuTime", sep);
+    for (const auto& section : gpuSectionTimes) {
+        optionalStatLine(ss, section.time, "gpuTime[" + section.name + "]", sep);
+    }
+    optionalStatLine(ss, styleUpdateTime, "styleUpdateTime", sep);
+    optionalStatLine(ss, sourceUpdateTime, "sourceUpdateTime", sep);
+    optionalStatLine(ss, prepareTime, "prepareTime", sep);
+    optionalStatLine(ss, placementTime, "placementTime", sep);
+    optionalStatLine(ss, renderTreeTime, "renderTreeTime", sep);
+    optionalStatLine(ss, layerUpdateTime, "layerUpdateTime", sep);
+    optionalStatLine(ss, tweakerTime, "tweakerTime", sep);
+    optionalStatLine(ss, uploadTime, "uploadTime", sep);
+    optionalStatLine(ss, passEncodingTime, "passEncodingTime", sep);
+    optionalStatLine(ss, numCameraOnlyUpdates, "numCameraOnlyUpdates", sep);
+    optionalStatLine(ss, numSkippedTweakerUpdates, "numSkippedTweakerUpdates", sep);
     optionalStatLine(ss, numFrames, "numFrames", sep);
     optionalStatLine(ss, numDrawCalls, "numDrawCalls", sep);
     optionalStatLine(ss, totalDrawCalls, "totalDrawCalls", sep);
+    optionalStatLine(ss, numTriangles, "numTriangles", sep);
+    optionalStatLine(ss, numOccludedDrawables, "numOccludedDrawables", sep);
+    optionalStatLine(ss, numCulledSymbols, "numCulledSymbols", sep);
+    optionalStatLine(ss, numVariableAnchorTests, "numVariableAnchorTests", sep);
+    optionalStatLine(ss, numPreviousAnchorPlacements, "numPreviousAnchorPlacements", sep);
     optionalStatLine(ss, numCreatedTextures, "numCreatedTextures", sep);
     optionalStatLine(ss, numActiveTextures, "numActiveTextures", sep);
     optionalStatLine(ss, numTextureBindings, "numTextureBindings", sep);
     optionalStatLine(ss, numTextureUpdates, "numTextureUpdates", sep);
     optionalStatLine(ss, textureUpdateBytes, "textureUpdateBytes", sep);
+    optionalStatLine(ss, numCreatedOffscreenTextures, "numCreatedOffscreenTextures", sep);
+    optionalStatLine(ss, numReusedOffscreenTextures, "numReusedOffscreenTextures", sep);
+    optionalStatLine(ss, numPooledOffscreenTextures, "numPooledOffscreenTextures", sep);
     optionalStatLine(ss, totalBuffers, "totalBuffers", sep);
     optionalStatLine(ss, totalBufferObjs, "totalBufferObjs", sep);
     optionalStatLine(ss, bufferUpdates, "bufferUpdates", sep);
     optionalStatLine(ss, bufferObjUpdates, "bufferObjUpdates", sep);
     optionalStatLine(ss, bufferUpdateBytes, "bufferUpdateBytes", sep);
+    optionalStatLine(ss, numHeapAllocations, "numHeapAllocations", sep);
+    optionalStatLine(ss, numHeaps, "numHeaps", sep);
     optionalStatLine(ss, numBuffers, "numBuffers", sep);
     optionalStatLine(ss, numFrameBuffers, "numFrameBuffers", sep);
     optionalStatLine(ss, numIndexBuffers, "numIndexBuffers", sep);
@@ -99,6 +155,11 @@ std::string RenderingStats::toString(std::string_view sep) const {
     optionalStatLine(ss, numUniformBuffers, "numUniformBuffers", sep);
     optionalStatLine(ss, numUniformUpdates, "numUniformUpdates", sep);
     optionalStatLine(ss, uniformUpdateBytes, "uniformUpdateBytes", sep);
+    optionalStatLine(ss, frameUniformUpdateBytes, "frameUniformUpdateBytes", sep);
+    optionalStatLine(ss, numUniformBindings, "numUniformBindings", sep);
+    optionalStatLine(ss, numDescriptorSetUpdates, "numDescriptorSetUpdates", sep);
+    optionalStatLine(ss, numRedundantStateCalls, "numRedundantStateCalls", sep);
+    optionalStatLine(ss, numRenderBundleReplays, "numRenderBundleReplays", sep);
     optionalStatLine(ss, memTextures, "memTextures", sep);
     optionalStatLine(ss, memBuffers, "memBuffers", sep);
     optionalStatLine(ss, memIndexBuffers, "memIndexBuffers", sep);
@@ -234,6 +295,8 @@ void RenderingStatsView::update(style::Style& style, const gfx::RenderingStats&
     ++frameCount;
     encodingTime += stats.encodingTime;
     renderingTime += stats.renderingTime;
+    drawableEncodingTime += stats.drawableEncodingTime;
+    frameWaitTime += stats.frameWaitTime;
 
     const auto currentTime = util::MonotonicTimer::now().count();
     if (currentTime - lastUpdate < options.updateInterval) {
@@ -245,10 +308,17 @@ void RenderingStatsView::update(style::Style& style, const gfx::RenderingStats&
 
     ss << "Encoding time (ms): " << std::setw(7) << encodingTime / frameCount * 1000 << "\n";
     ss << "Rendering time (ms): " << std::setw(7) << renderingTime / frameCount * 1000 << "\n";
+    if (drawableEncodingTime > 0.0) {
+        ss << "Drawable encoding time (ms): " << std::setw(7) << drawableEncodingTime / frameCount * 1000 << "\n";
+    }
+    if (frameWaitTime > 0.0) {
+        ss << "Frame wait time (ms): " << std::setw(7) << frameWaitTime / frameCount * 1000 << "\n";
+    }
 
     printNumber(ss, "Frame count", stats.numFrames, true);
     printNumber(ss, "Draw calls", stats.numDrawCalls, true);
     printNumber(ss, "Total draw calls", stats.totalDrawCalls, options.verbose);
+    printNumber(ss, "Triangles", stats.numTriangles, true);
 
     printNumber(ss, "Textures", stats.numActiveTextures, true);
     printNumber(ss, "Total textures", stats.numCreatedTextures, options.verbose);
@@ -257,6 +327,8 @@ void RenderingStatsView::update(style::Style& style, const gfx::RenderingStats&
 
     printNumber(ss, "Buffers", stats.numBuffers, true);
     printNumber(ss, "Total buffers", stats.totalBuffers, options.verbose);
+    printNumber(ss, "Heap allocations", stats.numHeapAllocations, options.verbose);
+    printNumber(ss, "Heaps", stats.numHeaps, options.verbose);
     printNumber(ss, "Total buffer updates", stats.bufferUpdates, options.verbose);
     printMemory(ss, "Total buffer updates", stats.bufferUpdateBytes, options.verbose);
 
@@ -269,6 +341,11 @@ void RenderingStatsView::update(style::Style& style, const gfx::RenderingStats&
     printNumber(ss, "Uniform buffers", stats.numUniformBuffers, true);
     printNumber(ss, "Uniform buffer updates", stats.numUniformUpdates, options.verbose);
     printMemory(ss, "Uniform buffer updates", stats.uniformUpdateBytes, options.verbose);
+    printMemory(ss, "Frame uniform updates", stats.frameUniformUpdateBytes, true);
+    printNumber(ss, "Frame uniform bindings", stats.numUniformBindings, true);
+    printNumber(ss, "Frame descriptor set updates", stats.numDescriptorSetUpdates, options.verbose);
+    printNumber(ss, "Frame redundant state calls", stats.numRedundantStateCalls, options.verbose);
+    printNumber(ss, "Frame render bundle replays", stats.numRenderBundleReplays, options.verbose);
 
     printMemory(ss, "Texture memory", stats.memTextures, true);
     printMemory(ss, "Buffer memory", stats.memBuffers, true);
@@ -284,6 +361,8 @@ void RenderingStatsView::update(style::Style& style, const gfx::RenderingStats&
     frameCount = 0;
     encodingTime = 0.0;
     renderingTime = 0.0;
+    drawableEncodingTime = 0.0;
+    frameWaitTime = 0.0;
     lastUpdate = currentTime;
 }
 
@@ -0,0 +1,169 @@
+#include <mbgl/gfx/triangulation_cache.hpp>
+
+#include <cassert>
+#include <cstring>
+#include <limits>
+
+namespace mbgl {
+namespace gfx {
+
+namespace {
+
+thread_local void* currentLayer = nullptr;
+
+// Bumped whenever the layout of `serialize` changes, older data then being ignored
+constexpr uint32_t serializationVersion = 1;
+
+template <typename T>
+void write(std::string& out, T value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+class Reader {
+public:
+    explicit Reader(std::string_view data_)
+        : data(data_) {}
+
+    template <typename T>
+    bool read(T& value) {
+        if (data.size() < sizeof(T)) {
+            return false;
+        }
+        std::memcpy(&value, data.data(), sizeof(T));
+        data.remove_prefix(sizeof(T));
+        return true;
+    }
+
+    bool read(std::string& value, std::size_t length) {
+        if (data.size() < length) {
+            return false;
+        }
+        value.assign(data.substr(0, length));
+        data.remove_prefix(length);
+        return true;
+    }
+
+    /// Whether `count` items of `size` bytes at least could still follow, checked before reserving room for them
+    bool fits(std::size_t count, std::size_t size) const { return count <= data.size() / size; }
+    bool done() const { return data.empty(); }
+
+private:
+    std::string_view data;
+};
+
+} // namespace
+
+const std::vector<uint16_t>* TriangulationCache::Feature::find(std::size_t i, std::size_t vertexCount) const {
+    if (i < polygons.size() && polygons[i].vertexCount == vertexCount) {
+        return &polygons[i].indices;
+    }
+    return nullptr;
+}
+
+void TriangulationCache::Feature::insert(std::size_t i,
+                                         std::size_t vertexCount,
+                                         const std::vector<uint32_t>& indices) {
+    assert(vertexCount <= std::numeric_limits<uint16_t>::max());
+    if (i >= polygons.size()) {
+        polygons.resize(i + 1);
+    }
+    auto& polygon = polygons[i];
+    polygon.vertexCount = vertexCount;
+    polygon.indices.assign(indices.begin(), indices.end());
+}
+
+std::string TriangulationCache::serialize() const {
+    std::string out;
+    write(out, serializationVersion);
+    write(out, static_cast<uint32_t>(layers.size()));
+    for (const auto& [name, layer] : layers) {
+        write(out, static_cast<uint32_t>(name.size()));
+        out.append(name);
+        write(out, static_cast<uint32_t>(layer.size()));
+        for (const auto& [index, feature] : layer) {
+            write(out, static_cast<uint64_t>(index));
+            write(out, static_cast<uint32_t>(feature.polygons.size()));
+            for (const auto& polygon : feature.polygons) {
+                write(out, static_cast<uint32_t>(polygon.vertexCount));
+                write(out, static_cast<uint32_t>(polygon.indices.size()));
+                out.append(reinterpret_cast<const char*>(polygon.indices.data()),
+                           polygon.indices.size() * sizeof(uint16_t));
+            }
+        }
+    }
+    return out;
+}
+
+bool TriangulationCache::load(std::string_view data) {
+    Reader reader(data);
+    uint32_t version = 0;
+    uint32_t layerCount = 0;
+    if (!reader.read(version) || version != serializationVersion || !reader.read(layerCount)) {
+        return false;
+    }
+
+    std::unordered_map<std::string, Layer> loaded;
+    for (uint32_t l = 0; l < layerCount; ++l) {
+        uint32_t nameLength = 0;
+        std::string name;
+        uint32_t featureCount = 0;
+        if (!reader.read(nameLength) || !reader.read(name, nameLength) || !reader.read(featureCount)) {
+            return false;
+        }
+        Layer& layer = loaded[name];
+        for (uint32_t f = 0; f < featureCount; ++f) {
+            uint64_t index = 0;
+            uint32_t polygonCount = 0;
+            if (!reader.read(index) || !reader.read(polygonCount) || !reader.fits(polygonCount, 2 * sizeof(uint32_t))) {
+                return false;
+            }
+            auto& polygons = layer[static_cast<std::size_t>(index)].polygons;
+            polygons.resize(polygonCount);
+            for (auto& polygon : polygons) {
+                uint32_t vertexCount = 0;
+                uint32_t indexCount = 0;
+                if (!reader.read(vertexCount) || !reader.read(indexCount) ||
+                    !reader.fits(indexCount, sizeof(uint16_t))) {
+                    return false;
+                }
+                polygon.vertexCount = vertexCount;
+                polygon.indices.resize(indexCount);
+                for (auto& i : polygon.indices) {
+                    reader.read(i);
+                }
+            }
+        }
+    }
+    if (!reader.done()) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(layersMutex);
+    layers = std::move(loaded);
+    return true;
+}
+
+TriangulationCache::Scope::Scope(TriangulationCache* cache, const std::string& sourceLayer)
+    : previous(currentLayer) {
+    if (cache) {
+        // Layers stay where they are as others are added
+        std::lock_guard<std::mutex> lock(cache->layersMutex);
+        currentLayer = &cache->layers[sourceLayer];
+    } else {
+        currentLayer = nullptr;
+    }
+}
+
+TriangulationCache::Scope::~Scope() {
+    currentLayer = previous;
+}
+
+TriangulationCache::Feature* TriangulationCache::current(std::size_t index) {
+    if (!currentLayer) {
+        return nullptr;
+    }
+    return &(*static_cast<Layer*>(currentLayer))[index];
+}
+
+} // namespace gfx
+} // namespace mbgl
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace mbgl {
+namespace gfx {
+
+/**
+    Earcut triangulations of the polygons of a tile's features, kept across the layout passes over
+    the same tile data, so that relayouts after style changes reuse them instead of triangulating
+    every polygon again.
+
+    Features are identified by source layer and index, which only holds for as long as the tile
+    data stays the same: the owner clears the cache whenever the data changes. Polygons also record
+    their vertex count, and a polygon whose count doesn't match is triangulated again.
+ */
+class TriangulationCache {
+public:
+    /// The polygons of a feature, in the order `classifyRingRefs` returns them
+    class Feature {
+    public:
+        /// The indices of polygon `i`, if it's cached with `vertexCount` vertices
+        const std::vector<uint16_t>* find(std::size_t i, std::size_t vertexCount) const;
+        void insert(std::size_t i, std::size_t vertexCount, const std::vector<uint32_t>& indices);
+
+    private:
+        friend class TriangulationCache;
+
+        struct Polygon {
+            std::size_t vertexCount = 0;
+            std::vector<uint16_t> indices;
+        };
+
+        std::vector<Polygon> polygons;
+    };
+
+    void clear() { layers.clear(); }
+    bool empty() const { return layers.empty(); }
+
+    /// The cache in a compact binary form, for `load` to read back, in the byte order of the device
+    std::string serialize() const;
+    /// Replaces the cache with one from `serialize`. Returns false, leaving the cache as it was, for data that
+    /// can't be read.
+    bool load(std::string_view);
+
+    /// Makes a source layer of `cache` the one `current()` refers to on the calling thread, for the
+    /// lifetime of the scope. Passing a null cache disables caching within the scope. Scopes of different
+    /// source layers may be opened on several threads at once.
+    class Scope {
+    public:
+        Scope(TriangulationCache* cache, const std::string& sourceLayer);
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+        ~Scope();
+
+    private:
+        void* previous;
+    };
+
+    /// The entry of feature `index` in the current scope's source layer, added if missing. Null
+    /// outside of a scope.
+    static Feature* current(std::size_t index);
+
+private:
+    using Layer = std::unordered_map<std::size_t, Feature>;
+
+    std::mutex layersMutex;
+    std::unordered_map<std::string, Layer> layers;
+};
+
+} // namespace gfx
+} // namespace mbgl
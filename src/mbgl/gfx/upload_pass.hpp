@@ -56,7 +56,7 @@ public:
     template <class Vertex>
     void updateVertexBuffer(VertexBuffer<Vertex>& buffer, const VertexVector<Vertex>& v) {
         assert(v.elements() == buffer.elements);
-        updateVertexBufferResource(buffer.getResource(), v.data(), v.bytes());
+        updateVertexBufferResource(buffer.getResource(), v.data(), v.bytes(), /*offset=*/0);
     }
 
     template <class DrawMode>
@@ -88,7 +88,11 @@ protected:
                                                                              std::size_t size,
                                                                              BufferUsageType,
                                                                              bool persistent = false) = 0;
-    virtual void updateVertexBufferResource(VertexBufferResource&, const void* data, std::size_t size) = 0;
+    /// Replace `size` bytes of the buffer starting at `offset` with `data`
+    virtual void updateVertexBufferResource(VertexBufferResource&,
+                                            const void* data,
+                                            std::size_t size,
+                                            std::size_t offset) = 0;
 
 public:
     virtual std::unique_ptr<IndexBufferResource> createIndexBufferResource(const void* data,
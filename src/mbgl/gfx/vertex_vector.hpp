@@ -1,9 +1,14 @@
 #pragma once
 
 #include <mbgl/util/ignore.hpp>
+#include <mbgl/util/memory_usage.hpp>
 #include <mbgl/util/monotonic_timer.hpp>
 
+#include <algorithm>
+#include <cstring>
 #include <memory>
+#include <optional>
+#include <utility>
 #include <vector>
 
 namespace mbgl {
@@ -19,8 +24,10 @@ public:
     VertexVectorBase(const VertexVectorBase&) {} // buffer is not copied
     VertexVectorBase(VertexVectorBase&& other)
         : buffer(std::move(other.buffer)),
+          bufferBytes(other.bufferBytes),
           dirty(other.dirty),
-          released(other.released) {}
+          released(other.released),
+          discarded(other.discarded) {}
     virtual ~VertexVectorBase() = default;
 
     virtual const void* getRawData() const = 0;
@@ -28,7 +35,15 @@ public:
     virtual std::size_t getRawCount() const = 0;
 
     VertexBufferBase* getBuffer() const { return buffer.get(); }
-    void setBuffer(std::unique_ptr<VertexBufferBase>&& value) { buffer = std::move(value); }
+    void setBuffer(std::unique_ptr<VertexBufferBase>&& value) {
+        buffer = std::move(value);
+        bufferBytes = buffer ? getRawSize() * getRawCount() : 0;
+    }
+
+    /// Bytes held by the raw vertex data and by the uploaded buffer, if any
+    MemoryUsage getMemoryUsage() const {
+        return {.cpu = discarded ? 0 : getRawSize() * getRawCount(), .gpu = bufferBytes};
+    }
 
     std::chrono::duration<double> getLastModified() const { return lastModified; }
     bool isModifiedAfter(std::chrono::duration<double> t) const { return t < lastModified; }
@@ -43,10 +58,43 @@ public:
     // Indicates that the owner/producer will not modify this again
     bool isReleased() const { return released; }
 
+    /// Whether the raw vertices were freed once uploaded, see `VertexVector::discardUploadedData`
+    bool isDiscarded() const { return discarded; }
+
+    /// The range of bytes modified since `clearModifiedRange`, or nothing if any of them may have been
+    std::optional<std::pair<std::size_t, std::size_t>> getModifiedRange() const {
+        if (allModified) {
+            return std::nullopt;
+        }
+        return std::make_pair(modifiedBegin, modifiedEnd);
+    }
+
+    /// Called once the modifications have been copied into the buffer
+    void clearModifiedRange() {
+        allModified = false;
+        modifiedBegin = modifiedEnd = 0;
+    }
+
 protected:
+    void markModified(std::size_t begin, std::size_t end) {
+        if (modifiedBegin == modifiedEnd) {
+            modifiedBegin = begin;
+            modifiedEnd = end;
+        } else {
+            modifiedBegin = std::min(modifiedBegin, begin);
+            modifiedEnd = std::max(modifiedEnd, end);
+        }
+        dirty = true;
+    }
+
     std::unique_ptr<VertexBufferBase> buffer;
+    std::size_t bufferBytes = 0;
     bool dirty = true;
     bool released = false;
+    bool discarded = false;
+    bool allModified = true;
+    std::size_t modifiedBegin = 0;
+    std::size_t modifiedEnd = 0;
 
     std::chrono::duration<double> lastModified = util::MonotonicTimer::now();
 };
@@ -63,26 +111,63 @@ public:
           v(other.v) {}
     VertexVector(VertexVector<V>&& other)
         : VertexVectorBase(static_cast<VertexVectorBase&&>(other)),
-          v(std::move(other.v)) {}
+          v(std::move(other.v)),
+          discardedCount(other.discardedCount) {}
     ~VertexVector() override = default;
 
     template <class... Args>
     void emplace_back(Args&&... args) {
-        assert(!released);
+        assert(!released && !discarded);
         util::ignore({(v.emplace_back(std::forward<Args>(args)), 0)...});
-        dirty = true;
+        dirty = allModified = true;
     }
 
     void extend(std::size_t n, const Vertex& val) {
-        assert(!released);
+        assert(!released && !discarded);
         v.resize(v.size() + n, val);
-        dirty = true;
+        dirty = allModified = true;
+    }
+
+    /// Set the `n` vertices starting at `index` to `val`, growing the vector if needed.
+    /// Unlike `at`, only the vertices whose value changes are recorded as modified.
+    void assign(std::size_t index, std::size_t n, const Vertex& val) {
+        assert(!released && !discarded);
+        const auto oldSize = v.size();
+        if (oldSize < index + n) {
+            v.resize(index + n, val);
+            markModified(std::max(index, oldSize) * sizeof(Vertex), (index + n) * sizeof(Vertex));
+        }
+        for (auto i = index; i < std::min(index + n, oldSize); ++i) {
+            if (std::memcmp(&v[i], &val, sizeof(Vertex)) != 0) {
+                v[i] = val;
+                markModified(i * sizeof(Vertex), (i + 1) * sizeof(Vertex));
+            }
+        }
+    }
+
+    /// Overwrite `size` bytes of the existing vertices at byte `offset`, recording them as modified if they differ
+    void write(std::size_t offset, const void* value, std::size_t size) {
+        assert(!discarded && offset + size <= bytes());
+        auto* target = reinterpret_cast<uint8_t*>(v.data()) + offset;
+        if (std::memcmp(target, value, size) != 0) {
+            std::memcpy(target, value, size);
+            markModified(offset, offset + size);
+        }
+    }
+
+    /// Drop the vertices past `count`, the remaining ones are unchanged
+    void truncate(std::size_t count) {
+        assert(!discarded);
+        if (count < v.size()) {
+            v.resize(count);
+            dirty = true;
+        }
     }
 
     Vertex& at(std::size_t n) {
         assert(n < v.size());
-        assert(!released);
-        dirty = true;
+        assert(!released && !discarded);
+        dirty = allModified = true;
         return v.at(n);
     }
     const Vertex& at(std::size_t n) const {
@@ -90,14 +175,16 @@ public:
         return v.at(n);
     }
 
-    std::size_t elements() const { return v.size(); }
+    std::size_t elements() const { return discarded ? discardedCount : v.size(); }
 
-    std::size_t bytes() const { return v.size() * sizeof(Vertex); }
+    std::size_t bytes() const { return elements() * sizeof(Vertex); }
 
-    bool empty() const { return v.empty(); }
+    bool empty() const { return elements() == 0; }
 
     void clear() {
-        dirty = true;
+        dirty = allModified = true;
+        discarded = false;
+        discardedCount = 0;
         v.clear();
     }
 
@@ -112,16 +199,27 @@ public:
         released = true;
     }
 
+    /// Free the raw vertices if they're uploaded and unmodified since, keeping their count for the drawables built
+    /// from them. The vertices can't be modified afterwards, their buffer being reused as is.
+    void discardUploadedData() {
+        if (buffer && !discarded && !allModified && modifiedBegin == modifiedEnd) {
+            discardedCount = v.size();
+            std::vector<Vertex>().swap(v);
+            discarded = true;
+        }
+    }
+
     const Vertex* data() const { return v.data(); }
 
     const std::vector<Vertex>& vector() const { return v; }
 
     const void* getRawData() const override { return v.data(); }
     std::size_t getRawSize() const override { return sizeof(Vertex); }
-    std::size_t getRawCount() const override { return v.size(); }
+    std::size_t getRawCount() const override { return elements(); }
 
 private:
     std::vector<Vertex> v;
+    std::size_t discardedCount = 0;
 };
 
 template <typename T>
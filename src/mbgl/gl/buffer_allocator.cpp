@@ -260,32 +260,51 @@ public:
             assert(0);
             return false;
         }
-        MBGL_CHECK_ERROR(glBindBuffer(type, buffer->id));
-
-        // Map the next available slice of memory
-        auto* buf = MBGL_CHECK_ERROR(
-            glMapBufferRange(type,
-                             buffer->pointer,
-                             alignedSize,
-                             GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_WRITE_BIT));
+        // Stage the data, it's uploaded along with its neighbours before the next draw
         const auto writtenIndex = buffer->pointer;
+        stage(recordingBuffer, writtenIndex, data, size);
 
-        if (buf) {
-            std::memcpy(buf, data, size);
-            MBGL_CHECK_ERROR(glUnmapBuffer(type));
+        residentBuffer = buffer->addRef(nullptr, writtenIndex, size);
+        buffer->pointer += alignedSize;
+        return true;
+    }
 
-            residentBuffer = buffer->addRef(nullptr, writtenIndex, size);
-            buffer->pointer += alignedSize;
-        } else {
-            assert(0);
-            return false;
+    /// Upload all the staged writes, one mapping per contiguous run of allocations
+    void flush() noexcept override {
+        if (pendingWrites.empty()) {
+            return;
+        }
+        MLN_TRACE_FUNC();
+
+        for (const auto& pending : pendingWrites) {
+            const auto& buffer = buffers[pending.bufferIndex];
+            if (buffer.id == 0) {
+                continue;
+            }
+            const auto* source = pendingData.data() + pending.dataOffset;
+
+            MBGL_CHECK_ERROR(glBindBuffer(type, buffer.id));
+            // Runs only ever cover fresh allocations, nothing in use by the GPU is overwritten
+            auto* buf = MBGL_CHECK_ERROR(
+                glMapBufferRange(type,
+                                 pending.offset,
+                                 pending.size,
+                                 GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_WRITE_BIT));
+            if (buf) {
+                std::memcpy(buf, source, pending.size);
+                MBGL_CHECK_ERROR(glUnmapBuffer(type));
+            } else {
+                assert(0);
+                MBGL_CHECK_ERROR(glBufferSubData(type, pending.offset, pending.size, source));
+            }
         }
 
 #ifndef NDEBUG
         MBGL_CHECK_ERROR(glBindBuffer(type, 0));
 #endif
 
-        return true;
+        pendingWrites.clear();
+        pendingData.clear();
     }
 
     /// Release a living reference
@@ -306,11 +325,13 @@ public:
         }
         intptr_t recycleIndex = recordingBuffer;
 
+        // Staged writes must land before the buffers they target are recycled
+        flush();
+
         // Phase one: Mark free buffers
         updateInFlight();
 
         // Phase two: Consolidate fragmentation
-        MBGL_CHECK_ERROR(glBindBuffer(type, buffers[recycleIndex].id));
 
         for (auto it = inFlightBuffers.begin(); it != inFlightBuffers.end();) {
             auto& fragBuffer = buffers[*it];
@@ -344,18 +365,10 @@ public:
                         // No more buffers available, we're done.
                         break;
                     }
-
-                    MBGL_CHECK_ERROR(glBindBuffer(type, buffers[recycleIndex].id));
                 }
 
                 // 2.b: Copy into recycle buffer
-                if (!moveRef(*refIt, recycleIndex, alignedSize)) {
-                    // Relocation failure, stop trying to defrag.
-#ifndef NDEBUG
-                    MBGL_CHECK_ERROR(glBindBuffer(GL_UNIFORM_BUFFER, 0));
-#endif
-                    return;
-                }
+                moveRef(*refIt, recycleIndex, alignedSize);
             }
 
             // All refs have relocated, clear this buffer.
@@ -375,9 +388,7 @@ public:
             }
         }
 
-#ifndef NDEBUG
-        MBGL_CHECK_ERROR(glBindBuffer(GL_UNIFORM_BUFFER, 0));
-#endif
+        flush();
 
         if (recordingBuffer == -1) {
             recordingBuffer = newBuffer();
@@ -432,24 +443,15 @@ private:
     }
 
     // Move a buffer reference (An allocation from a UniformBufferGL instance) to a new buffer
-    bool moveRef(RefTy& ref, size_t toIndex, size_t alignedSize) {
+    void moveRef(RefTy& ref, size_t toIndex, size_t alignedSize) {
         auto& destBuffer = buffers[toIndex];
         const auto recycledWriteIndex = destBuffer.pointer;
 
-        auto* buf = MBGL_CHECK_ERROR(
-            glMapBufferRange(type,
-                             recycledWriteIndex,
-                             alignedSize,
-                             GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_WRITE_BIT));
-
-        if (buf) {
-            std::memcpy(buf, ref.getOwner()->getManagedBuffer().getContents().data(), ref.getOwner()->getSize());
-            MBGL_CHECK_ERROR(glUnmapBuffer(type));
-            destBuffer.pointer += alignedSize;
-        } else {
-            assert(0);
-            return false;
-        }
+        stage(toIndex,
+              recycledWriteIndex,
+              ref.getOwner()->getManagedBuffer().getContents().data(),
+              ref.getOwner()->getSize());
+        destBuffer.pointer += alignedSize;
 
         // 2.c: Now the ref must be made aware of the relocation of its contents.
         // Note that this means defragmentation can never run on refs that are
@@ -462,7 +464,23 @@ private:
         const auto newRef = destBuffer.addRef(owner, recycledWriteIndex, refSize);
         buffers[oldIndex].decRef(&ref);
         owner->getManagedBuffer().relocRef(newRef);
-        return true;
+    }
+
+    // Queue `size` bytes to be written at `offset` in a buffer by the next `flush`, extending the
+    // last run when it's for the same buffer. Allocations only move forward, so the gap left by
+    // alignment is never live data.
+    void stage(size_t bufferIndex, ptrdiff_t offset, const void* data, size_t size) {
+        auto start = pendingData.size();
+        if (!pendingWrites.empty() && pendingWrites.back().bufferIndex == bufferIndex &&
+            pendingWrites.back().offset + static_cast<ptrdiff_t>(pendingWrites.back().size) <= offset) {
+            auto& pending = pendingWrites.back();
+            start += static_cast<size_t>(offset - pending.offset) - pending.size;
+            pending.size = static_cast<size_t>(offset - pending.offset) + size;
+        } else {
+            pendingWrites.push_back({bufferIndex, offset, size, start});
+        }
+        pendingData.resize(start + size);
+        std::memcpy(pendingData.data() + start, data, size);
     }
 
 private:
@@ -482,6 +500,17 @@ private:
     // after the copy operation(s) to ensure the GPU is done with it before we reuse it.
     std::list<InFlightBuffer> waitingFree;
 
+    // A run of allocations in one buffer, waiting for `flush`
+    struct PendingWrite {
+        size_t bufferIndex;
+        ptrdiff_t offset;
+        size_t size;
+        // Where the run's contents start in `pendingData`
+        size_t dataOffset;
+    };
+    std::vector<PendingWrite> pendingWrites;
+    std::vector<std::byte> pendingData;
+
 public:
     // All buffers allocated so far
     std::vector<Buffer> buffers;
@@ -505,6 +534,10 @@ void UniformBufferAllocator::release(BufferRef* ref) noexcept {
     impl->release(ref);
 }
 
+void UniformBufferAllocator::flush() noexcept {
+    impl->flush();
+}
+
 void UniformBufferAllocator::defragment(const std::shared_ptr<gl::Fence>& fence) {
     impl->defragment(fence);
 }
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <mbgl/gl/extension.hpp>
+#include <mbgl/gl/defines.hpp>
+#include <mbgl/platform/gl_functions.hpp>
+
+#define GL_MAP_PERSISTENT_BIT 0x0040
+#define GL_MAP_COHERENT_BIT 0x0080
+#define GL_DYNAMIC_STORAGE_BIT 0x0100
+#define GL_CLIENT_STORAGE_BIT 0x0200
+
+namespace mbgl {
+namespace gl {
+namespace extension {
+
+using namespace platform;
+
+/// Immutable buffer storage, which is what allows a buffer to stay mapped while the GPU reads it.
+/// Core in desktop GL 4.4, an extension on GLES 3.x.
+class BufferStorage {
+public:
+    template <typename Fn>
+    BufferStorage(const Fn& loadExtension)
+        : bufferStorage(loadExtension(
+              {{"GL_ARB_buffer_storage", "glBufferStorage"}, {"GL_EXT_buffer_storage", "glBufferStorageEXT"}})) {}
+
+    const ExtensionFunction<void(GLenum target, GLsizeiptr size, const void* data, GLbitfield flags)> bufferStorage;
+};
+
+} // namespace extension
+} // namespace gl
+} // namespace mbgl
@@ -9,6 +9,10 @@
 #include <mbgl/gl/renderbuffer_resource.hpp>
 #include <mbgl/gl/offscreen_texture.hpp>
 #include <mbgl/gl/debugging_extension.hpp>
+#include <mbgl/gl/buffer_storage_extension.hpp>
+#include <mbgl/gl/parallel_shader_compile_extension.hpp>
+#include <mbgl/gl/program_binary_cache.hpp>
+#include <mbgl/gl/staging_buffer.hpp>
 #include <mbgl/gl/timestamp_query_extension.hpp>
 #include <mbgl/renderer/paint_parameters.hpp>
 #include <mbgl/util/traits.hpp>
@@ -26,6 +30,7 @@
 #include <mbgl/renderer/render_target.hpp>
 #include <mbgl/shaders/gl/shader_program_gl.hpp>
 
+#include <algorithm>
 #include <cstring>
 #include <iterator>
 
@@ -70,6 +75,20 @@ GLint getMaxVertexAttribs() {
     return value;
 }
 
+GLenum compressedTextureFormat(CompressedImageFormat format) {
+    switch (format) {
+        case CompressedImageFormat::ETC2RGB8:
+            return GL_COMPRESSED_RGB8_ETC2;
+        case CompressedImageFormat::ETC2RGBA8:
+            return GL_COMPRESSED_RGBA8_ETC2_EAC;
+        case CompressedImageFormat::ASTC4x4:
+            return GL_COMPRESSED_RGBA_ASTC_4x4_KHR;
+        case CompressedImageFormat::BC7:
+            return GL_COMPRESSED_RGBA_BPTC_UNORM_EXT;
+    }
+    return 0;
+}
+
 // Currently renderBufferByteSize is only used when Tracy profiling is enabled
 #ifdef MLN_TRACY_ENABLE
 constexpr size_t renderBufferByteSize(const gfx::RenderbufferPixelType type, const Size size) noexcept {
@@ -94,15 +113,32 @@ Context::Context(RendererBackend& backend_)
       backend(backend_) {
     uboAllocator = std::make_unique<gl::UniformBufferAllocator>();
 
+    uniformBuffer.reserve(shaders::maxUBOCountPerShader);
+    for (std::size_t index = 0; index < shaders::maxUBOCountPerShader; index++) {
+        uniformBuffer.emplace_back(static_cast<uint32_t>(index));
+    }
+
     texturePool = std::make_unique<Texture2DPool>(this);
 }
 
 Context::~Context() noexcept {
+    // Abandon the pixel pack buffers and pooled textures while the lists they go to are still alive
+    framebufferReads.clear();
+    idleFramebufferReads.clear();
+    clearOffscreenTexturePool();
+
     if (cleanupOnDestruction) {
         backend.getThreadPool().runRenderJobs(true /* closeQueue */);
 
         glUseProgram(0);
 
+        if (frameTimers[0]) {
+            extension::glDeleteQueries(static_cast<GLsizei>(frameTimers.size()), frameTimers.data());
+        }
+        if (!timestampQueries.empty()) {
+            extension::glDeleteQueries(static_cast<GLsizei>(timestampQueries.size()), timestampQueries.data());
+        }
+
         for (size_t i = 0; i < globalUniformBuffers.allocatedSize(); i++) {
             globalUniformBuffers.set(i, nullptr);
         }
@@ -112,6 +148,7 @@ Context::~Context() noexcept {
         // Delete all pooled resources while the context is still valid
         texturePool.reset();
         uboAllocator.reset();
+        stagingBuffer.reset();
 
 #if !defined(NDEBUG)
         Log::Debug(Event::General, "Rendering Stats:\n" + stats.toString("\n"));
@@ -123,9 +160,17 @@ Context::~Context() noexcept {
 void Context::beginFrame() {
     MLN_TRACE_FUNC();
 
-    backend.getThreadPool().runRenderJobs();
+    backend.runRenderJobs();
 
     frameInFlightFence = std::make_shared<gl::Fence>();
+    frameTextureUploadBytes = 0;
+    // The uniform buffer allocator may have deleted the buffers bound in earlier frames
+    for (auto& binding : uniformBuffer) {
+        binding.setDirty();
+    }
+    deferredTextureUploads = 0;
+    beginFrameTimer();
+    readGPUSections();
 
     // Run allocator defragmentation on this frame interval.
     constexpr auto defragFreq = 4;
@@ -141,6 +186,8 @@ void Context::beginFrame() {
 void Context::endFrame() {
     MLN_TRACE_FUNC();
 
+    endFrameTimer();
+
     if (!frameInFlightFence) {
         return;
     }
@@ -148,6 +195,122 @@ void Context::endFrame() {
     frameInFlightFence->insert();
 }
 
+void Context::beginFrameTimer() {
+    if (!frameTimersSupported) {
+        return;
+    }
+    if (!frameTimers[0]) {
+        MBGL_CHECK_ERROR(extension::glGenQueries(static_cast<GLsizei>(frameTimers.size()), frameTimers.data()));
+    }
+
+    // Read back the result of the query about to be reused, issued a few frames ago
+    if (frameTimerPending[frameTimer]) {
+        GLuint available = GL_FALSE;
+        MBGL_CHECK_ERROR(
+            extension::glGetQueryObjectuiv(frameTimers[frameTimer], GL_QUERY_RESULT_AVAILABLE, &available));
+        if (!available) {
+            // The GPU is further behind than the queries we have, leave this frame unmeasured
+            return;
+        }
+        GLuint64 elapsed = 0;
+        MBGL_CHECK_ERROR(extension::glGetQueryObjectui64v(frameTimers[frameTimer], GL_QUERY_RESULT, &elapsed));
+        // Measurements spanning a disjoint event, e.g. a change of the GPU clock, are meaningless
+        GLint disjoint = 0;
+        MBGL_CHECK_ERROR(glGetIntegerv(GL_GPU_DISJOINT, &disjoint));
+        if (!disjoint) {
+            stats.gpuTime = static_cast<double>(elapsed) * 1e-9;
+        }
+        frameTimerPending[frameTimer] = false;
+    }
+
+    MBGL_CHECK_ERROR(extension::glBeginQuery(GL_TIME_ELAPSED, frameTimers[frameTimer]));
+    frameTimerActive = true;
+}
+
+void Context::endFrameTimer() {
+    if (!frameTimerActive) {
+        return;
+    }
+    MBGL_CHECK_ERROR(extension::glEndQuery(GL_TIME_ELAPSED));
+    frameTimerPending[frameTimer] = true;
+    frameTimer = (frameTimer + 1) % frameTimers.size();
+    frameTimerActive = false;
+}
+
+void Context::beginGPUSection(std::string_view name) {
+    if (!gpuSectionTimingEnabled || !timestampQueriesSupported ||
+        pendingGPUSections.size() >= maxPendingGPUSectionFrames) {
+        return;
+    }
+    openGPUSections.push_back(frameGPUSections.size());
+    frameGPUSections.push_back({std::string(name), issueTimestampQuery(), 0});
+}
+
+void Context::endGPUSection() {
+    if (openGPUSections.empty()) {
+        return;
+    }
+    frameGPUSections[openGPUSections.back()].end = issueTimestampQuery();
+    openGPUSections.pop_back();
+}
+
+GLuint Context::issueTimestampQuery() {
+    GLuint query = 0;
+    if (idleTimestampQueries.empty()) {
+        MBGL_CHECK_ERROR(extension::glGenQueries(1, &query));
+        timestampQueries.push_back(query);
+    } else {
+        query = idleTimestampQueries.back();
+        idleTimestampQueries.pop_back();
+    }
+    MBGL_CHECK_ERROR(extension::glQueryCounter(query, GL_TIMESTAMP));
+    return query;
+}
+
+void Context::readGPUSections() {
+    // Sections left open at the end of the previous frame are dropped
+    for (const auto index : openGPUSections) {
+        idleTimestampQueries.push_back(frameGPUSections[index].begin);
+    }
+    std::erase_if(frameGPUSections, [](const GPUSection& section) { return section.end == 0; });
+    openGPUSections.clear();
+    if (!frameGPUSections.empty()) {
+        pendingGPUSections.push_back(std::move(frameGPUSections));
+        frameGPUSections.clear();
+    }
+
+    while (!pendingGPUSections.empty()) {
+        auto& sections = pendingGPUSections.front();
+        const bool available = std::ranges::all_of(sections, [](const GPUSection& section) {
+            GLuint result = GL_FALSE;
+            MBGL_CHECK_ERROR(extension::glGetQueryObjectuiv(section.end, GL_QUERY_RESULT_AVAILABLE, &result));
+            return result != GL_FALSE;
+        });
+        if (!available) {
+            return;
+        }
+
+        std::map<std::string, double> times;
+        for (auto& section : sections) {
+            GLuint64 begin = 0;
+            GLuint64 end = 0;
+            MBGL_CHECK_ERROR(extension::glGetQueryObjectui64v(section.begin, GL_QUERY_RESULT, &begin));
+            MBGL_CHECK_ERROR(extension::glGetQueryObjectui64v(section.end, GL_QUERY_RESULT, &end));
+            times[std::move(section.name)] += static_cast<double>(end > begin ? end - begin : 0) * 1e-9;
+            idleTimestampQueries.push_back(section.begin);
+            idleTimestampQueries.push_back(section.end);
+        }
+        pendingGPUSections.pop_front();
+
+        // Measurements spanning a disjoint event are meaningless, and so are those finishing once disabled
+        GLint disjoint = 0;
+        MBGL_CHECK_ERROR(glGetIntegerv(GL_GPU_DISJOINT, &disjoint));
+        if (!disjoint && gpuSectionTimingEnabled) {
+            addGPUSectionTimes(std::move(times));
+        }
+    }
+}
+
 void Context::initializeExtensions(const std::function<gl::ProcAddress(const char*)>& getProcAddress) {
     MLN_TRACE_FUNC();
 
@@ -174,10 +337,27 @@ void Context::initializeExtensions(const std::function<gl::ProcAddress(const cha
             debugging = std::make_unique<extension::Debugging>(fn);
         }
 
-// Currently GL timestamp queries are only used when Tracy profiling is enabled
-#ifdef MLN_TRACY_ENABLE
+        bufferStorage = std::make_unique<extension::BufferStorage>(fn);
+        parallelShaderCompile = std::make_unique<extension::ParallelShaderCompile>(fn);
+
+        // Used to measure the GPU time of frames, and by Tracy profiling
         extension::loadTimeStampQueryExtension(fn);
-#endif
+        frameTimersSupported = extension::timeElapsedQueriesSupported();
+        timestampQueriesSupported = extension::timestampQueriesSupported();
+
+        if (strstr(extensions, "GL_EXT_texture_filter_anisotropic") != nullptr) {
+            MBGL_CHECK_ERROR(glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT, &maxTextureAnisotropy));
+        }
+    }
+
+    GLint numCompressedTextureFormats = 0;
+    MBGL_CHECK_ERROR(glGetIntegerv(GL_NUM_COMPRESSED_TEXTURE_FORMATS, &numCompressedTextureFormats));
+    if (numCompressedTextureFormats > 0) {
+        std::vector<GLint> formats(static_cast<std::size_t>(numCompressedTextureFormats));
+        MBGL_CHECK_ERROR(glGetIntegerv(GL_COMPRESSED_TEXTURE_FORMATS, formats.data()));
+        for (const auto format : formats) {
+            compressedTextureFormats.push_back(static_cast<GLenum>(format));
+        }
     }
     MLN_TRACE_GL_CONTEXT();
 }
@@ -202,32 +382,47 @@ void Context::enableDebugging() {
     MBGL_CHECK_ERROR(debugging->debugMessageCallback(extension::Debugging::DebugCallback, nullptr));
 }
 
-UniqueShader Context::createShader(ShaderType type, const std::initializer_list<const char*>& sources) {
+UniqueShader Context::createShader(ShaderType type, const std::initializer_list<const char*>& sources, bool verify) {
     UniqueShader result{MBGL_CHECK_ERROR(glCreateShader(static_cast<GLenum>(type))), {this}};
 
     MBGL_CHECK_ERROR(glShaderSource(result, static_cast<GLsizei>(sources.size()), sources.begin(), nullptr));
     MBGL_CHECK_ERROR(glCompileShader(result));
 
+    if (verify) {
+        verifyShaderCompilation(result);
+    }
+    return result;
+}
+
+void Context::verifyShaderCompilation(ShaderID shader) {
     GLint status = 0;
-    MBGL_CHECK_ERROR(glGetShaderiv(result, GL_COMPILE_STATUS, &status));
+    MBGL_CHECK_ERROR(glGetShaderiv(shader, GL_COMPILE_STATUS, &status));
     if (status != 0) {
-        return result;
+        return;
     }
 
     GLint logLength;
-    MBGL_CHECK_ERROR(glGetShaderiv(result, GL_INFO_LOG_LENGTH, &logLength));
+    MBGL_CHECK_ERROR(glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &logLength));
     if (logLength > 0) {
         const auto log = std::make_unique<GLchar[]>(logLength);
-        MBGL_CHECK_ERROR(glGetShaderInfoLog(result, logLength, &logLength, log.get()));
+        MBGL_CHECK_ERROR(glGetShaderInfoLog(shader, logLength, &logLength, log.get()));
         Log::Error(Event::Shader, std::string("Shader failed to compile: ") + log.get());
     }
 
     throw std::runtime_error("shader failed to compile");
 }
 
-UniqueProgram Context::createProgram(ShaderID vertexShader, ShaderID fragmentShader, const char* location0AttribName) {
+UniqueProgram Context::createProgram(ShaderID vertexShader,
+                                     ShaderID fragmentShader,
+                                     const char* location0AttribName,
+                                     bool retrievableBinary,
+                                     bool verify) {
     UniqueProgram result{MBGL_CHECK_ERROR(glCreateProgram()), {this}};
 
+    if (retrievableBinary) {
+        MBGL_CHECK_ERROR(glProgramParameteri(result, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE));
+    }
+
     MBGL_CHECK_ERROR(glAttachShader(result, vertexShader));
     MBGL_CHECK_ERROR(glAttachShader(result, fragmentShader));
 
@@ -237,7 +432,11 @@ UniqueProgram Context::createProgram(ShaderID vertexShader, ShaderID fragmentSha
     // AttributeLocations::getFirstAttribName.
     MBGL_CHECK_ERROR(glBindAttribLocation(result, 0, location0AttribName));
 
-    linkProgram(result);
+    if (verify) {
+        linkProgram(result);
+    } else {
+        MBGL_CHECK_ERROR(glLinkProgram(result));
+    }
 
     return result;
 }
@@ -348,6 +547,68 @@ std::unique_ptr<uint8_t[]> Context::readFramebuffer(const Size size,
     return data;
 }
 
+void Context::beginReadFramebuffer(const Size size) {
+    MLN_TRACE_FUNC();
+    MLN_TRACE_FUNC_GL();
+
+    if (idleFramebufferReads.empty()) {
+        BufferID id = 0;
+        MBGL_CHECK_ERROR(glGenBuffers(1, &id));
+        // NOLINTNEXTLINE(performance-move-const-arg)
+        idleFramebufferReads.push_back({.buffer = UniqueBuffer{std::move(id), {*this}}, .capacity = 0, .size = {}});
+        stats.numBuffers++;
+    }
+    auto read = std::move(idleFramebufferReads.back());
+    idleFramebufferReads.pop_back();
+
+    const std::size_t bytes = size.area() * 4;
+    MBGL_CHECK_ERROR(glBindBuffer(GL_PIXEL_PACK_BUFFER, read.buffer));
+    if (read.capacity != bytes) {
+        MBGL_CHECK_ERROR(glBufferData(GL_PIXEL_PACK_BUFFER, bytes, nullptr, GL_STREAM_READ));
+        read.capacity = bytes;
+    }
+
+    pixelStorePack = {1};
+    // With a pixel pack buffer bound, the pointer is an offset into it and the call doesn't wait
+    MBGL_CHECK_ERROR(glReadPixels(0, 0, size.width, size.height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr));
+    MBGL_CHECK_ERROR(glBindBuffer(GL_PIXEL_PACK_BUFFER, 0));
+
+    read.size = size;
+    framebufferReads.push_back(std::move(read));
+}
+
+bool Context::finishReadFramebuffer(PremultipliedImage& image) {
+    MLN_TRACE_FUNC();
+    MLN_TRACE_FUNC_GL();
+
+    if (framebufferReads.empty()) {
+        return false;
+    }
+    auto read = std::move(framebufferReads.front());
+    framebufferReads.pop_front();
+
+    const Size size = read.size;
+    const std::size_t stride = size.width * 4;
+    if (image.size != size || !image.valid()) {
+        image = PremultipliedImage(size);
+    }
+
+    MBGL_CHECK_ERROR(glBindBuffer(GL_PIXEL_PACK_BUFFER, read.buffer));
+    // Mapping waits for the copy to complete
+    const auto* pixels = static_cast<const uint8_t*>(
+        MBGL_CHECK_ERROR(glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, read.capacity, GL_MAP_READ_BIT)));
+    if (pixels) {
+        for (std::size_t row = 0; row < size.height; ++row) {
+            std::memcpy(image.data.get() + (size.height - 1 - row) * stride, pixels + row * stride, stride);
+        }
+        MBGL_CHECK_ERROR(glUnmapBuffer(GL_PIXEL_PACK_BUFFER));
+    }
+    MBGL_CHECK_ERROR(glBindBuffer(GL_PIXEL_PACK_BUFFER, 0));
+
+    idleFramebufferReads.push_back(std::move(read));
+    return pixels != nullptr;
+}
+
 namespace {
 
 void checkFramebuffer() {
@@ -532,6 +793,9 @@ void Context::setDirtyState() {
     vertexBuffer.setDirty();
     bindVertexArray.setDirty();
     globalVertexArrayState.setDirty();
+    for (auto& binding : uniformBuffer) {
+        binding.setDirty();
+    }
 }
 
 gfx::UniqueDrawableBuilder Context::createDrawableBuilder(std::string name) {
@@ -585,6 +849,42 @@ gfx::Texture2DPtr Context::createTexture2D() {
     return std::make_shared<gl::Texture2D>(*this);
 }
 
+bool Context::supportsCompressedImageFormat(CompressedImageFormat format) const {
+    return std::ranges::find(compressedTextureFormats, compressedTextureFormat(format)) !=
+           compressedTextureFormats.end();
+}
+
+UniqueTexture Context::createUniqueCompressedTexture(const CompressedImage& image) {
+    MLN_TRACE_FUNC();
+    assert(supportsCompressedImageFormat(image.format));
+
+    TextureID id = 0;
+    MBGL_CHECK_ERROR(glGenTextures(1, &id));
+    assert(id != 0);
+
+    // Bind to TU 0 and upload
+    activeTextureUnit = 0;
+    texture[0] = id;
+    MBGL_CHECK_ERROR(glCompressedTexImage2D(GL_TEXTURE_2D,
+                                            0,
+                                            compressedTextureFormat(image.format),
+                                            image.size.width,
+                                            image.size.height,
+                                            0,
+                                            static_cast<GLsizei>(image.bytes()),
+                                            image.data.data()));
+
+    compressedTextures.emplace(id, image.bytes());
+    renderingStats().numCreatedTextures++;
+    renderingStats().numActiveTextures++;
+    renderingStats().memTextures += static_cast<int>(image.bytes());
+    renderingStats().numTextureUpdates++;
+    renderingStats().textureUpdateBytes += image.bytes();
+
+    // NOLINTNEXTLINE(performance-move-const-arg)
+    return UniqueTexture{std::move(id), {this}};
+}
+
 gfx::DynamicTexturePtr Context::createDynamicTexture(Size size, gfx::TexturePixelType pixelType) {
     MLN_TRACE_FUNC();
 
@@ -642,7 +942,30 @@ void Context::clear(std::optional<mbgl::Color> color, std::optional<float> depth
     MBGL_CHECK_ERROR(glClear(mask));
 
     stats.numDrawCalls = 0;
+    stats.numTriangles = 0;
     stats.numFrames++;
+    stats.frameUniformUpdateBytes = 0;
+    stats.numUniformBindings = 0;
+    stats.numRedundantStateCalls = 0;
+}
+
+void Context::bindUniformBuffer(uint32_t index, BufferID buffer, std::size_t offset, std::size_t size) {
+    assert(index < uniformBuffer.size());
+    setState(uniformBuffer[index], {buffer, offset, size});
+}
+
+void Context::unbindUniformBuffer(uint32_t index) {
+    assert(index < uniformBuffer.size());
+    setState(uniformBuffer[index], value::BindUniformBuffer::Default);
+}
+
+void Context::uniformBufferDeleted(BufferID buffer) {
+    // Deleting a buffer unbinds it, so a new buffer given the same ID would look bound already
+    for (auto& binding : uniformBuffer) {
+        if (binding.getCurrentValue().buffer == buffer) {
+            binding.setDirty();
+        }
+    }
 }
 
 void Context::setCullFaceMode(const gfx::CullFaceMode& mode) {
@@ -727,10 +1050,41 @@ void Context::finish() {
     MBGL_CHECK_ERROR(glFinish());
 }
 
+bool Context::reserveTextureUpload(std::size_t bytes) {
+    if (textureUploadBudget && frameTextureUploadBytes > 0 && frameTextureUploadBytes + bytes > textureUploadBudget) {
+        ++deferredTextureUploads;
+        return false;
+    }
+    frameTextureUploadBytes += bytes;
+    return true;
+}
+
 std::shared_ptr<gl::Fence> Context::getCurrentFrameFence() const {
     return frameInFlightFence;
 }
 
+gl::StagingBuffer& Context::getStagingBuffer() {
+    if (!stagingBuffer) {
+        stagingBuffer = std::make_unique<gl::StagingBuffer>(*this, bufferStorage.get());
+    }
+    return *stagingBuffer;
+}
+
+void Context::enableProgramBinaryCache(std::string directory) {
+    programBinaryCache = gl::ProgramBinaryCache::create(*this, std::move(directory));
+}
+
+void Context::enableAsyncShaderCompilation() {
+    if (!parallelShaderCompile || !parallelShaderCompile->maxShaderCompilerThreads) {
+        Log::Info(Event::Shader, "Parallel shader compilation is not supported, shaders are compiled on first use");
+        return;
+    }
+
+    // Let the driver pick the number of compiler threads
+    MBGL_CHECK_ERROR(parallelShaderCompile->maxShaderCompilerThreads(0xFFFFFFFF));
+    asyncShaderCompilation = true;
+}
+
 void Context::draw(const gfx::DrawMode& drawMode, std::size_t indexOffset, std::size_t indexLength) {
     MLN_TRACE_FUNC();
     MLN_TRACE_FUNC_GL();
@@ -747,6 +1101,9 @@ void Context::draw(const gfx::DrawMode& drawMode, std::size_t indexOffset, std::
             break;
     }
 
+    // Uniform data written since the last draw is uploaded in one go
+    uboAllocator->flush();
+
     MBGL_CHECK_ERROR(glDrawElements(Enum<gfx::DrawModeType>::to(drawMode.type),
                                     static_cast<GLsizei>(indexLength),
                                     GL_UNSIGNED_SHORT,
@@ -754,10 +1111,14 @@ void Context::draw(const gfx::DrawMode& drawMode, std::size_t indexOffset, std::
 
     stats.numDrawCalls++;
     stats.totalDrawCalls++;
+    if (drawMode.type == gfx::DrawModeType::Triangles) {
+        stats.numTriangles += static_cast<int>(indexLength / 3);
+    }
 }
 
 void Context::performCleanup() {
     MLN_TRACE_FUNC();
+    trimOffscreenTexturePool();
 #ifndef NDEBUG
     // In debug builds, un-bind all texture units so that any incorrect use results in an
     // error rather than using whatever texture happened to have been bound previously.
@@ -805,7 +1166,14 @@ void Context::performCleanup() {
                     binding.setDirty();
                 }
             }
-            texturePool->release(id);
+            if (const auto it = compressedTextures.find(id); it != compressedTextures.end()) {
+                renderingStats().memTextures -= static_cast<int>(it->second);
+                renderingStats().numCreatedTextures--;
+                compressedTextures.erase(it);
+                MBGL_CHECK_ERROR(glDeleteTextures(1, &id));
+            } else {
+                texturePool->release(id);
+            }
         }
         abandonedTextures.clear();
     }
@@ -842,9 +1210,11 @@ void Context::reduceMemoryUsage() {
     MLN_TRACE_FUNC();
     MLN_TRACE_FUNC_GL();
 
+    clearOffscreenTexturePool();
     performCleanup();
     assert(texturePool);
     texturePool->shrink();
+    stagingBuffer.reset();
 
     // Ensure that all pending actions are executed to ensure that they happen
     // before the app goes to the background.
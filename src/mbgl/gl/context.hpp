@@ -14,6 +14,7 @@
 #include <mbgl/gl/vertex_array.hpp>
 #include <mbgl/gl/types.hpp>
 #include <mbgl/platform/gl_functions.hpp>
+#include <mbgl/util/image.hpp>
 #include <mbgl/util/noncopyable.hpp>
 
 #include <mbgl/gl/fence.hpp>
@@ -22,7 +23,10 @@
 #include <mbgl/gl/uniform_buffer_gl.hpp>
 
 #include <array>
+#include <cassert>
+#include <deque>
 #include <functional>
+#include <unordered_map>
 #include <vector>
 
 namespace mbgl {
@@ -30,10 +34,14 @@ namespace gl {
 
 using ProcAddress = void (*)();
 class RendererBackend;
+class StagingBuffer;
+class ProgramBinaryCache;
 
 namespace extension {
 class VertexArray;
 class Debugging;
+class BufferStorage;
+class ParallelShaderCompile;
 } // namespace extension
 
 class Context final : public gfx::Context {
@@ -54,11 +62,21 @@ public:
 
     void enableDebugging();
 
-    UniqueShader createShader(ShaderType type, const std::initializer_list<const char*>& sources);
-    UniqueProgram createProgram(ShaderID vertexShader, ShaderID fragmentShader, const char* location0AttribName);
+    /// Without `verify`, compilation errors are only reported by a later `verifyShaderCompilation`
+    UniqueShader createShader(ShaderType type, const std::initializer_list<const char*>& sources, bool verify = true);
+    void verifyShaderCompilation(ShaderID);
+    /// `retrievableBinary` hints the driver that the binary of the program will be read back.
+    /// Without `verify`, link errors are only reported by a later `verifyProgramLinkage`.
+    UniqueProgram createProgram(ShaderID vertexShader,
+                                ShaderID fragmentShader,
+                                const char* location0AttribName,
+                                bool retrievableBinary = false,
+                                bool verify = true);
     void verifyProgramLinkage(ProgramID);
     void linkProgram(ProgramID);
     UniqueTexture createUniqueTexture(const Size& size, gfx::TexturePixelType format, gfx::TextureChannelDataType type);
+    /// Create a texture holding a compressed image. These aren't pooled, as each is only ever used for one image.
+    UniqueTexture createUniqueCompressedTexture(const CompressedImage&);
 
     Framebuffer createFramebuffer(const gfx::Renderbuffer<gfx::RenderbufferPixelType::RGBA>&,
                                   const gfx::Renderbuffer<gfx::RenderbufferPixelType::DepthStencil>&);
@@ -72,6 +90,14 @@ public:
         return {size, readFramebuffer(size, format, flip)};
     }
 
+    /// Start copying the RGBA pixels of the framebuffer into a pixel pack buffer without waiting for
+    /// them, so the GPU can go on with the next frame while they're read back
+    void beginReadFramebuffer(Size);
+    /// Wait for the oldest read begun and write its pixels, flipped, into `image`, reusing its storage
+    /// if it already has the right size. Returns false when no read is pending or it failed.
+    bool finishReadFramebuffer(PremultipliedImage& image);
+    std::size_t pendingFramebufferReads() const { return framebufferReads.size(); }
+
     void clear(std::optional<mbgl::Color> color, std::optional<float> depth, std::optional<int32_t> stencil);
 
     void setDepthMode(const gfx::DepthMode&);
@@ -80,12 +106,62 @@ public:
     void setCullFaceMode(const gfx::CullFaceMode&);
     void setScissorTest(const gfx::ScissorRect&);
 
+    /// Assign a piece of cached state, counting the call as redundant if it already has the value
+    template <typename T, typename... Args>
+    void setState(State<T, Args...>& state, const typename T::Type& value) {
+        if (state == value) {
+            stats.numRedundantStateCalls++;
+        } else {
+            state = value;
+        }
+    }
+
+    /// Bind a range of a uniform buffer to a binding point, unless it's bound there already
+    void bindUniformBuffer(uint32_t index, BufferID buffer, std::size_t offset, std::size_t size);
+    void unbindUniformBuffer(uint32_t index);
+    /// Forget the uniform buffers bound to the binding points of a buffer about to be deleted
+    void uniformBufferDeleted(BufferID);
+
     void draw(const gfx::DrawMode&, std::size_t indexOffset, std::size_t indexLength);
 
     void finish();
 
     std::shared_ptr<gl::Fence> getCurrentFrameFence() const;
 
+    /// Ring used to stream vertex and index buffer updates, created on first use
+    gl::StagingBuffer& getStagingBuffer();
+
+    /// Save linked programs in `directory` and reuse them in later runs, if the driver allows it
+    void enableProgramBinaryCache(std::string directory);
+    /// Null unless `enableProgramBinaryCache` was called and the driver supports program binaries
+    gl::ProgramBinaryCache* getProgramBinaryCache() const { return programBinaryCache.get(); }
+
+    /// Let the driver compile and link programs in the background, if it supports that.
+    /// Drawables are skipped until their program has finished linking.
+    void enableAsyncShaderCompilation();
+    bool getAsyncShaderCompilation() const { return asyncShaderCompilation; }
+
+    /// Track the programs still being linked by the driver
+    void addPendingProgram() { ++pendingPrograms; }
+    void removePendingProgram() {
+        assert(pendingPrograms > 0);
+        --pendingPrograms;
+    }
+    bool hasPendingShaders() const override { return pendingPrograms > 0; }
+
+    /// Bytes of deferrable texture images uploaded per frame, beyond which their upload waits for a
+    /// later frame. The first of a frame always goes ahead, however large. Zero lifts the limit.
+    void setTextureUploadBudget(std::size_t bytes) { textureUploadBudget = bytes; }
+    std::size_t getTextureUploadBudget() const { return textureUploadBudget; }
+
+    /// Count a deferrable texture upload against the budget of the current frame.
+    /// Returns false, noting the upload as pending, if it doesn't fit.
+    bool reserveTextureUpload(std::size_t bytes);
+    bool hasPendingTextureUploads() const override { return deferredTextureUploads > 0; }
+
+    void beginGPUSection(std::string_view name) override;
+    void endGPUSection() override;
+
     // Actually remove the objects we marked as abandoned with the above methods.
     // Only call this while the OpenGL context is exclusive to this thread.
     // Pooled textures are retained
@@ -128,6 +204,11 @@ public:
 
     gfx::Texture2DPtr createTexture2D() override;
 
+    bool supportsCompressedImageFormat(CompressedImageFormat) const override;
+
+    /// The maximum anisotropy of texture filtering, 1 without GL_EXT_texture_filter_anisotropic
+    float getMaxTextureAnisotropy() const { return maxTextureAnisotropy; }
+
     gfx::DynamicTexturePtr createDynamicTexture(Size size, gfx::TexturePixelType pixelType) override;
 
     RenderTargetPtr createRenderTarget(const Size size, const gfx::TextureChannelDataType type) override;
@@ -160,12 +241,62 @@ public:
     Texture2DPool& getTexturePool();
 
 private:
+    /// Measure the GPU time of the frame into the rendering stats, when timer queries are supported
+    void beginFrameTimer();
+    void endFrameTimer();
+    /// Read back the GPU sections of the earlier frames whose queries are done
+    void readGPUSections();
+    platform::GLuint issueTimestampQuery();
+
     RendererBackend& backend;
     bool cleanupOnDestruction = true;
 
     std::unique_ptr<extension::Debugging> debugging;
+    std::unique_ptr<extension::BufferStorage> bufferStorage;
+    std::unique_ptr<extension::ParallelShaderCompile> parallelShaderCompile;
+    std::unique_ptr<gl::StagingBuffer> stagingBuffer;
+    std::unique_ptr<gl::ProgramBinaryCache> programBinaryCache;
+    bool asyncShaderCompilation = false;
+    std::size_t pendingPrograms = 0;
+    std::size_t textureUploadBudget = 4 * 1024 * 1024;
+    // Deferrable texture bytes uploaded and uploads put off in the current frame
+    std::size_t frameTextureUploadBytes = 0;
+    std::size_t deferredTextureUploads = 0;
     std::shared_ptr<gl::Fence> frameInFlightFence;
+    struct FramebufferRead {
+        UniqueBuffer buffer;
+        std::size_t capacity;
+        Size size;
+    };
+    // Reads begun, oldest first, and the pixel pack buffers of the finished ones for reuse
+    std::deque<FramebufferRead> framebufferReads;
+    std::vector<FramebufferRead> idleFramebufferReads;
+    // GL_TIME_ELAPSED queries of the last frames, used in turn and read back when they're reused
+    bool frameTimersSupported = false;
+    bool frameTimerActive = false;
+    std::size_t frameTimer = 0;
+    std::array<platform::GLuint, 3> frameTimers{};
+    std::array<bool, 3> frameTimerPending{};
+    // GL_TIMESTAMP queries around the GPU sections of the current frame and of the earlier ones not read
+    // back yet. The sections of a frame are dropped while that many frames are pending.
+    struct GPUSection {
+        std::string name;
+        platform::GLuint begin;
+        platform::GLuint end;
+    };
+    static constexpr std::size_t maxPendingGPUSectionFrames = 3;
+    bool timestampQueriesSupported = false;
+    std::vector<GPUSection> frameGPUSections;
+    std::vector<std::size_t> openGPUSections;
+    std::deque<std::vector<GPUSection>> pendingGPUSections;
+    std::vector<platform::GLuint> timestampQueries;
+    std::vector<platform::GLuint> idleTimestampQueries;
     std::unique_ptr<gl::UniformBufferAllocator> uboAllocator;
+    float maxTextureAnisotropy = 1.0f;
+    // Reported by GL_COMPRESSED_TEXTURE_FORMATS
+    std::vector<platform::GLenum> compressedTextureFormats;
+    // The compressed textures alive, with their sizes in bytes
+    std::unordered_map<TextureID, std::size_t> compressedTextures;
     size_t frameNum = 0;
     UniformBufferArrayGL globalUniformBuffers;
 
@@ -179,6 +310,8 @@ public:
     State<value::BindVertexBuffer> vertexBuffer;
 
     State<value::BindVertexArray> bindVertexArray;
+    // The uniform buffer ranges bound to each binding point
+    std::vector<State<value::BindUniformBuffer, uint32_t>> uniformBuffer;
     VertexArrayState globalVertexArrayState{UniqueVertexArray(0, {const_cast<Context*>(this)})};
 
     State<value::PixelStorePack> pixelStorePack;
@@ -729,3 +729,6 @@
 /* OpenGL ES Extensions */
 
 #define GL_TEXTURE_MAX_ANISOTROPY_EXT 0x84FE
+#define GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT 0x84FF
+#define GL_COMPRESSED_RGBA_ASTC_4x4_KHR 0x93B0
+#define GL_COMPRESSED_RGBA_BPTC_UNORM_EXT 0x8E8C
@@ -30,11 +30,14 @@ void DrawableGL::draw(PaintParameters& parameters) const {
 
     auto& context = static_cast<gl::Context&>(parameters.context);
 
+    // Layer groups hold back drawables with pending programs, but not those whose program failed to link
+    if (shader && !static_cast<ShaderProgramGL&>(*shader).isReady()) {
+        return;
+    }
+
     if (shader) {
         const auto& shaderGL = static_cast<const ShaderProgramGL&>(*shader);
-        if (shaderGL.getGLProgramID() != context.program.getCurrentValue()) {
-            context.program = shaderGL.getGLProgramID();
-        }
+        context.setState(context.program, shaderGL.getGLProgramID());
     }
     if (!shader || context.program.getCurrentValue() == 0) {
         mbgl::Log::Warning(Event::General, "Missing shader for drawable " + util::toString(getID()) + "/" + getName());
@@ -42,6 +45,14 @@ void DrawableGL::draw(PaintParameters& parameters) const {
         return;
     }
 
+    // Wait for textures held back by the upload budget rather than drawing without them
+    const auto uploadPending = [](const auto& texture) {
+        return texture && static_cast<const gl::Texture2D&>(*texture).isUploadPending();
+    };
+    if (std::any_of(textures.begin(), textures.end(), uploadPending)) {
+        return;
+    }
+
     if (enableDepth) {
         context.setDepthMode(getIs3D() ? parameters.depthModeFor3D()
                                        : parameters.depthModeForSublayer(getSubLayerIndex(), getDepthType()));
@@ -52,15 +63,24 @@ void DrawableGL::draw(PaintParameters& parameters) const {
     // force disable depth test for debugging
     // context.setDepthMode({gfx::DepthFunctionType::Always, gfx::DepthMaskType::ReadOnly, {0,1}});
 
+    // Tiles are clipped either by the stencil or by a scissor rectangle, see `TileLayerGroupGL::render`
+    const bool scissorClipped = enableStencil && !is3D && tileID && parameters.tileScissorClipping;
+    const auto scissorRect = scissorClipped ? parameters.scissorRectForTile(tileID->toUnwrapped())
+                                            : parameters.scissorRect;
+    if (scissorClipped && (!scissorRect.width || !scissorRect.height)) {
+        // An empty rectangle would disable the scissor test rather than clip everything
+        return;
+    }
+
     // For 3D mode, stenciling is handled by the layer group
     if (!is3D) {
-        context.setStencilMode(makeStencilMode(parameters));
+        context.setStencilMode(scissorClipped ? gfx::StencilMode::disabled() : makeStencilMode(parameters));
     }
 
     context.setColorMode(getColorMode());
     context.setCullFaceMode(getCullFaceMode());
 
-    context.setScissorTest(parameters.scissorRect);
+    context.setScissorTest(scissorRect);
 
     impl->uniformBuffers.bind();
     bindTextures();
@@ -69,15 +89,12 @@ void DrawableGL::draw(PaintParameters& parameters) const {
         const auto& glSeg = static_cast<DrawSegmentGL&>(*seg);
         const auto& mlSeg = glSeg.getSegment();
         if (mlSeg.indexLength > 0 && glSeg.getVertexArray().isValid()) {
-            context.bindVertexArray = glSeg.getVertexArray().getID();
+            context.setState(context.bindVertexArray, glSeg.getVertexArray().getID());
             context.draw(glSeg.getMode(), mlSeg.indexOffset, mlSeg.indexLength);
         }
     }
-    // Unbind the VAO so that future buffer commands outside Drawable do not change the current VAO state
-    context.bindVertexArray = value::BindVertexArray::Default;
-
-    unbindTextures();
-    impl->uniformBuffers.unbind();
+    // The VAO, textures and uniform buffers are left bound for the next drawable, which is likely to use some of
+    // them again. The layer group unbinds the VAO once done, see `TileLayerGroupGL::render`.
 }
 
 void DrawableGL::setIndexData(gfx::IndexVectorBasePtr indexes, std::vector<UniqueDrawSegment> segments) {
@@ -150,6 +167,10 @@ void DrawableGL::upload(gfx::UploadPass& uploadPass) {
         assert(false);
         return;
     }
+    // The attribute layout comes from the program, wait until it has been linked
+    if (!static_cast<ShaderProgramGL&>(*shader).isReady()) {
+        return;
+    }
 
     MLN_TRACE_FUNC();
 #ifdef MLN_TRACY_ENABLE
@@ -272,13 +293,5 @@ void DrawableGL::bindTextures() const {
     }
 }
 
-void DrawableGL::unbindTextures() const {
-    for (const auto& texture : textures) {
-        if (texture) {
-            static_cast<gl::Texture2D&>(*texture).unbind();
-        }
-    }
-}
-
 } // namespace gl
 } // namespace mbgl
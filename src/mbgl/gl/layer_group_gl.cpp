@@ -5,6 +5,7 @@
 #include <mbgl/gfx/renderable.hpp>
 #include <mbgl/gfx/renderer_backend.hpp>
 #include <mbgl/gfx/upload_pass.hpp>
+#include <mbgl/gl/context.hpp>
 #include <mbgl/gl/drawable_gl.hpp>
 #include <mbgl/renderer/paint_parameters.hpp>
 #include <mbgl/shaders/gl/shader_program_gl.hpp>
@@ -16,6 +17,27 @@ namespace gl {
 
 using namespace platform;
 
+namespace {
+
+/// Whether all the programs a layer group draws with have been linked. A layer is left out of the frame until
+/// they all are, rather than being drawn in part.
+template <typename LayerGroupType>
+bool shadersReady(LayerGroupType& layerGroup, const gl::Context& context) {
+    if (!context.hasPendingShaders()) {
+        return true;
+    }
+
+    bool ready = true;
+    layerGroup.visitDrawables([&](gfx::Drawable& drawable) {
+        if (ready && drawable.getEnabled() && drawable.getShader()) {
+            ready = static_cast<ShaderProgramGL&>(*drawable.getShader()).isReady();
+        }
+    });
+    return ready;
+}
+
+} // namespace
+
 TileLayerGroupGL::TileLayerGroupGL(int32_t layerIndex_, std::size_t initialCapacity, std::string name_)
     : TileLayerGroup(layerIndex_, initialCapacity, std::move(name_)) {}
 
@@ -56,6 +78,10 @@ void TileLayerGroupGL::render(RenderOrchestrator&, PaintParameters& parameters)
 
     auto& context = static_cast<gl::Context&>(parameters.context);
 
+    if (!shadersReady(*this, context)) {
+        return;
+    }
+
     // `stencilModeFor3D` uses a different stencil mask value each time its called, so if the
     // drawables in this layer use 3D stencil mode, we need to set it up here so that all the
     // drawables end up using the same mode value.
@@ -63,6 +89,7 @@ void TileLayerGroupGL::render(RenderOrchestrator&, PaintParameters& parameters)
     bool features3d = false;
     bool stencil3d = false;
     gfx::StencilMode stencilMode3d;
+    parameters.tileScissorClipping = false;
 
     if (getDrawableCount()) {
         MLN_TRACE_ZONE(clip masks);
@@ -90,7 +117,11 @@ void TileLayerGroupGL::render(RenderOrchestrator&, PaintParameters& parameters)
         if (features3d) {
             stencilMode3d = stencil3d ? parameters.stencilModeFor3D() : gfx::StencilMode::disabled();
         } else if (stencilTiles && !stencilTiles->empty()) {
-            parameters.renderTileClippingMasks(stencilTiles);
+            if (parameters.canClipTilesWithScissor(stencilTiles)) {
+                parameters.tileScissorClipping = true;
+            } else {
+                parameters.renderTileClippingMasks(stencilTiles);
+            }
         }
     }
 
@@ -134,9 +165,13 @@ void TileLayerGroupGL::render(RenderOrchestrator&, PaintParameters& parameters)
         drawable.draw(parameters);
     });
 
+    // Unbind the VAO left bound by the drawables so that buffer commands outside them don't change its state
+    context.bindVertexArray = value::BindVertexArray::Default;
+
     if (bindUBOs) {
         uniformBuffers.unbind();
     }
+    parameters.tileScissorClipping = false;
 }
 
 LayerGroupGL::LayerGroupGL(int32_t layerIndex_, std::size_t initialCapacity, std::string name_)
@@ -163,7 +198,7 @@ void LayerGroupGL::upload(gfx::UploadPass& uploadPass) {
 }
 
 void LayerGroupGL::render(RenderOrchestrator&, PaintParameters& parameters) {
-    if (!enabled) {
+    if (!enabled || !shadersReady(*this, static_cast<const gl::Context&>(parameters.context))) {
         return;
     }
 
@@ -188,6 +223,9 @@ void LayerGroupGL::render(RenderOrchestrator&, PaintParameters& parameters) {
         drawable.draw(parameters);
     });
 
+    // Unbind the VAO left bound by the drawables so that buffer commands outside them don't change its state
+    static_cast<gl::Context&>(parameters.context).bindVertexArray = value::BindVertexArray::Default;
+
     if (bindUBOs) {
         uniformBuffers.unbind();
     }
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <mbgl/gl/extension.hpp>
+#include <mbgl/gl/defines.hpp>
+#include <mbgl/platform/gl_functions.hpp>
+
+#define GL_MAX_SHADER_COMPILER_THREADS_KHR 0x91B0
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+
+namespace mbgl {
+namespace gl {
+namespace extension {
+
+using namespace platform;
+
+/// Lets the driver compile and link on its own threads. While that runs, `GL_COMPLETION_STATUS_KHR`
+/// can be polled without blocking; querying anything else about the program waits for it.
+class ParallelShaderCompile {
+public:
+    template <typename Fn>
+    ParallelShaderCompile(const Fn& loadExtension)
+        : maxShaderCompilerThreads(
+              loadExtension({{"GL_KHR_parallel_shader_compile", "glMaxShaderCompilerThreadsKHR"},
+                             {"GL_ARB_parallel_shader_compile", "glMaxShaderCompilerThreadsARB"}})) {}
+
+    const ExtensionFunction<void(GLuint count)> maxShaderCompilerThreads;
+};
+
+} // namespace extension
+} // namespace gl
+} // namespace mbgl
@@ -0,0 +1,123 @@
+#include <mbgl/gl/program_binary_cache.hpp>
+
+#include <mbgl/gl/context.hpp>
+#include <mbgl/gl/defines.hpp>
+#include <mbgl/util/hash.hpp>
+#include <mbgl/util/io.hpp>
+#include <mbgl/util/logging.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+namespace mbgl {
+namespace gl {
+
+using namespace platform;
+
+namespace {
+
+struct BinaryHeader {
+    std::uint32_t magic;
+    std::uint32_t format;
+    std::uint64_t key;
+};
+
+constexpr std::uint32_t binaryMagic = 0x4D4C5042; // "MLPB"
+
+std::string_view getString(GLenum name) {
+    const auto* value = reinterpret_cast<const char*>(MBGL_CHECK_ERROR(glGetString(name)));
+    return value ? std::string_view(value) : std::string_view();
+}
+
+} // namespace
+
+std::unique_ptr<ProgramBinaryCache> ProgramBinaryCache::create(Context& context, std::string directory) {
+    GLint count = 0;
+    MBGL_CHECK_ERROR(glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &count));
+    if (count <= 0) {
+        Log::Info(Event::Shader, "No program binary formats supported, shaders are always compiled");
+        return nullptr;
+    }
+
+    std::vector<GLint> formats(count);
+    MBGL_CHECK_ERROR(glGetIntegerv(GL_PROGRAM_BINARY_FORMATS, formats.data()));
+    return std::make_unique<ProgramBinaryCache>(
+        context, std::move(directory), std::vector<GLenum>(formats.begin(), formats.end()));
+}
+
+ProgramBinaryCache::ProgramBinaryCache(Context& context_, std::string directory_, std::vector<GLenum> formats_)
+    : context(context_),
+      directory(std::move(directory_)),
+      formats(std::move(formats_)),
+      driverHash(util::hash(getString(GL_VENDOR), getString(GL_RENDERER), getString(GL_VERSION))) {}
+
+std::size_t ProgramBinaryCache::key(std::initializer_list<std::string_view> sources) const {
+    std::size_t seed = driverHash;
+    for (const auto source : sources) {
+        util::hash_combine(seed, source);
+    }
+    return seed;
+}
+
+std::string ProgramBinaryCache::path(std::size_t key) const {
+    return directory + "/program-" + std::to_string(key) + ".bin";
+}
+
+std::optional<UniqueProgram> ProgramBinaryCache::load(std::size_t key) {
+    const auto file = util::readFile(path(key));
+    if (!file || file->size() <= sizeof(BinaryHeader)) {
+        return std::nullopt;
+    }
+
+    BinaryHeader header;
+    std::memcpy(&header, file->data(), sizeof(header));
+    if (header.magic != binaryMagic || header.key != key ||
+        std::find(formats.begin(), formats.end(), header.format) == formats.end()) {
+        return std::nullopt;
+    }
+
+    UniqueProgram program{MBGL_CHECK_ERROR(glCreateProgram()), {&context}};
+    MBGL_CHECK_ERROR(glProgramBinary(program,
+                                     header.format,
+                                     file->data() + sizeof(header),
+                                     static_cast<GLsizei>(file->size() - sizeof(header))));
+
+    GLint status = 0;
+    MBGL_CHECK_ERROR(glGetProgramiv(program, GL_LINK_STATUS, &status));
+    if (status != GL_TRUE) {
+        Log::Info(Event::Shader, "Program binary rejected by the driver, compiling from source");
+        return std::nullopt;
+    }
+    return std::optional<UniqueProgram>(std::move(program));
+}
+
+void ProgramBinaryCache::store(ProgramID program, std::size_t key) const {
+    GLint length = 0;
+    MBGL_CHECK_ERROR(glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length));
+    if (length <= 0) {
+        return;
+    }
+
+    std::string file(sizeof(BinaryHeader) + length, '\0');
+    GLsizei written = 0;
+    GLenum format = 0;
+    MBGL_CHECK_ERROR(glGetProgramBinary(program, length, &written, &format, file.data() + sizeof(BinaryHeader)));
+    if (written <= 0) {
+        return;
+    }
+    file.resize(sizeof(BinaryHeader) + written);
+
+    const BinaryHeader header{binaryMagic, format, key};
+    std::memcpy(file.data(), &header, sizeof(header));
+
+    try {
+        util::write_file(path(key), file);
+    } catch (const std::exception& e) {
+        Log::Warning(Event::Shader, std::string("Failed to save program binary: ") + e.what());
+    }
+}
+
+} // namespace gl
+} // namespace mbgl
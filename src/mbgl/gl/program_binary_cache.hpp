@@ -0,0 +1,54 @@
+#pragma once
+
+#include <mbgl/gl/object.hpp>
+#include <mbgl/gl/types.hpp>
+#include <mbgl/platform/gl_functions.hpp>
+
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace mbgl {
+namespace gl {
+
+class Context;
+
+/**
+    Linked shader programs saved as driver binaries, so later launches can skip compiling them.
+
+    A program is stored in `directory` under a key hashed from its sources, including the
+    defines, and from the vendor, renderer and version strings of the driver, so updating either
+    one misses the cache rather than loading a stale binary. A binary the driver rejects anyway
+    is ignored and replaced once the program has been compiled from source again.
+ */
+class ProgramBinaryCache {
+public:
+    /// Returns null when the driver supports no program binary formats
+    static std::unique_ptr<ProgramBinaryCache> create(Context&, std::string directory);
+
+    ProgramBinaryCache(Context&, std::string directory, std::vector<platform::GLenum> formats);
+
+    /// Key of a program built from `sources`, in order, with the current driver
+    std::size_t key(std::initializer_list<std::string_view> sources) const;
+
+    /// The program saved under `key`, if there is one and the driver accepts it
+    std::optional<UniqueProgram> load(std::size_t key);
+
+    /// Saves the binary of a linked program under `key`. Failures are logged and otherwise ignored.
+    void store(ProgramID program, std::size_t key) const;
+
+private:
+    std::string path(std::size_t key) const;
+
+    Context& context;
+    const std::string directory;
+    const std::vector<platform::GLenum> formats;
+    std::size_t driverHash;
+};
+
+} // namespace gl
+} // namespace mbgl
@@ -28,6 +28,12 @@ std::unique_ptr<gfx::Context> RendererBackend::createContext() {
         *this); // Tagged background thread pool will be owned by the RendererBackend
     result->enableDebugging();
     result->initializeExtensions(std::bind(&RendererBackend::getExtensionFunctionPointer, this, std::placeholders::_1));
+    if (!programBinaryCacheDirectory.empty()) {
+        result->enableProgramBinaryCache(programBinaryCacheDirectory);
+    }
+    if (asyncShaderCompilation) {
+        result->enableAsyncShaderCompilation();
+    }
     return result;
 }
 
@@ -0,0 +1,173 @@
+#include <mbgl/gl/staging_buffer.hpp>
+
+#include <mbgl/gl/buffer_storage_extension.hpp>
+#include <mbgl/gl/context.hpp>
+#include <mbgl/gl/defines.hpp>
+#include <mbgl/util/instrumentation.hpp>
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+
+namespace mbgl {
+namespace gl {
+
+using namespace platform;
+
+namespace {
+
+constexpr GLbitfield persistentFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+// Keep copies aligned for the benefit of memcpy and the driver
+constexpr std::size_t alignment = 16;
+
+std::size_t align(std::size_t pointer) {
+    return (pointer + alignment - 1) & ~(alignment - 1);
+}
+
+} // namespace
+
+StagingBuffer::StagingBuffer(Context& context_, const extension::BufferStorage* bufferStorage_)
+    : context(context_),
+      bufferStorage(bufferStorage_),
+      persistent(bufferStorage_ && bufferStorage_->bufferStorage) {
+    if (!createPage() && persistent) {
+        // Storage without a usable mapping, fall back to orphaning
+        persistent = false;
+        createPage();
+    }
+}
+
+StagingBuffer::~StagingBuffer() {
+    for (auto& page : pages) {
+        // Deleting a buffer also unmaps it
+        if (page.id != 0) {
+            glDeleteBuffers(1, &page.id);
+        }
+    }
+}
+
+bool StagingBuffer::createPage() {
+    Page page;
+    MBGL_CHECK_ERROR(glGenBuffers(1, &page.id));
+    MBGL_CHECK_ERROR(glBindBuffer(GL_COPY_READ_BUFFER, page.id));
+
+    if (persistent) {
+        MBGL_CHECK_ERROR(bufferStorage->bufferStorage(GL_COPY_READ_BUFFER, PageSize, nullptr, persistentFlags));
+        page.mapped = MBGL_CHECK_ERROR(glMapBufferRange(GL_COPY_READ_BUFFER, 0, PageSize, persistentFlags));
+        if (!page.mapped) {
+            glDeleteBuffers(1, &page.id);
+            return false;
+        }
+    } else {
+        MBGL_CHECK_ERROR(glBufferData(GL_COPY_READ_BUFFER, PageSize, nullptr, GL_STREAM_DRAW));
+    }
+
+    pages.push_back(std::move(page));
+    return true;
+}
+
+bool StagingBuffer::nextPage() {
+    if (!persistent) {
+        // Orphan the storage, the driver keeps the old one alive until the GPU is done with it
+        auto& page = pages[currentPage];
+        MBGL_CHECK_ERROR(glBindBuffer(GL_COPY_READ_BUFFER, page.id));
+        MBGL_CHECK_ERROR(glBufferData(GL_COPY_READ_BUFFER, PageSize, nullptr, GL_STREAM_DRAW));
+        page.pointer = 0;
+        return true;
+    }
+
+    std::size_t next = 0;
+    if (!inFlight.empty() && pages[inFlight.front()].fence->isSignaled()) {
+        // Fences signal in order, so the oldest page is the one to check
+        next = inFlight.front();
+        inFlight.pop_front();
+    } else if (pages.size() < MaxPages && createPage()) {
+        next = pages.size() - 1;
+    } else {
+        // Everything is still in use, keep the full page current and try again later
+        return false;
+    }
+
+    // Everything written to the full page so far is used by the current frame at the latest
+    pages[currentPage].fence = context.getCurrentFrameFence();
+    inFlight.push_back(currentPage);
+
+    currentPage = next;
+    pages[currentPage].pointer = 0;
+    pages[currentPage].fence.reset();
+    return true;
+}
+
+bool StagingBuffer::write(const void* data, std::size_t size, std::size_t& writtenAt) {
+    auto& page = pages[currentPage];
+    writtenAt = align(page.pointer);
+    assert(writtenAt + size <= PageSize);
+
+    if (page.mapped) {
+        std::memcpy(static_cast<std::uint8_t*>(page.mapped) + writtenAt, data, size);
+    } else {
+        MBGL_CHECK_ERROR(glBindBuffer(GL_COPY_READ_BUFFER, page.id));
+        // Nothing written since the last orphaning overlaps this range, no need to synchronize
+        auto* buf = MBGL_CHECK_ERROR(glMapBufferRange(GL_COPY_READ_BUFFER,
+                                                      writtenAt,
+                                                      size,
+                                                      GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT |
+                                                          GL_MAP_UNSYNCHRONIZED_BIT));
+        if (!buf) {
+            return false;
+        }
+        std::memcpy(buf, data, size);
+        MBGL_CHECK_ERROR(glUnmapBuffer(GL_COPY_READ_BUFFER));
+    }
+
+    page.pointer = writtenAt + size;
+    return true;
+}
+
+bool StagingBuffer::stage(const void* data, std::size_t size, std::size_t& writtenAt) {
+    if (pages.empty() || size == 0 || size > PageSize) {
+        return false;
+    }
+    // Pages can only be recycled once the frame using them has been fenced
+    if (persistent && !context.getCurrentFrameFence()) {
+        return false;
+    }
+
+    if (align(pages[currentPage].pointer) + size > PageSize && !nextPage()) {
+        return false;
+    }
+
+    return write(data, size, writtenAt);
+}
+
+bool StagingBuffer::copy(GLenum target, std::size_t offset, const void* data, std::size_t size) {
+    MLN_TRACE_FUNC();
+
+    std::size_t writtenAt = 0;
+    if (!stage(data, size, writtenAt)) {
+        return false;
+    }
+
+    MBGL_CHECK_ERROR(glBindBuffer(GL_COPY_READ_BUFFER, pages[currentPage].id));
+    MBGL_CHECK_ERROR(glCopyBufferSubData(GL_COPY_READ_BUFFER, target, writtenAt, offset, size));
+    return true;
+}
+
+bool StagingBuffer::unpack(const void* data, std::size_t size, const std::function<void(const void*)>& upload) {
+    MLN_TRACE_FUNC();
+
+    std::size_t writtenAt = 0;
+    if (!stage(data, size, writtenAt)) {
+        return false;
+    }
+
+    // The context doesn't track this binding, so leave it unbound for everything else
+    MBGL_CHECK_ERROR(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pages[currentPage].id));
+    upload(reinterpret_cast<const void*>(writtenAt));
+    MBGL_CHECK_ERROR(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0));
+    return true;
+}
+
+} // namespace gl
+} // namespace mbgl
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <mbgl/gl/fence.hpp>
+#include <mbgl/gl/types.hpp>
+#include <mbgl/platform/gl_functions.hpp>
+
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace mbgl {
+namespace gl {
+
+class Context;
+
+namespace extension {
+class BufferStorage;
+} // namespace extension
+
+/**
+    Streams vertex and index data into GPU buffers through a ring of staging pages, so updating
+    a buffer the GPU may still be reading doesn't make the driver wait for it. Texture images go
+    the same way, as a pixel unpack buffer, so the driver can copy them into the texture while the
+    frame goes on rather than reading them from client memory on the spot.
+
+    Data is written into the next free range of a staging page and copied into its destination on
+    the GPU with `glCopyBufferSubData`, or by the texture upload reading from it. Where buffer
+    storage is available, pages are mapped once and stay mapped; a full page is retired with the
+    fence of the current frame and recycled once that fence has signaled. Otherwise a single page
+    is mapped range by range and orphaned when full, leaving the driver to keep the old contents
+    alive for as long as they're in use.
+ */
+class StagingBuffer {
+public:
+    static constexpr std::size_t PageSize = 1024 * 1024;
+    /// Pages of persistent storage in use at once, beyond which uploads aren't staged
+    static constexpr std::size_t MaxPages = 8;
+
+    StagingBuffer(Context&, const extension::BufferStorage*);
+    StagingBuffer(const StagingBuffer&) = delete;
+    StagingBuffer& operator=(const StagingBuffer&) = delete;
+    ~StagingBuffer();
+
+    /// Copies `size` bytes from `data` to `offset` in the buffer bound to `target`.
+    /// Returns false, without doing anything, when the data can't be staged right now, in which
+    /// case the caller uploads it directly.
+    bool copy(platform::GLenum target, std::size_t offset, const void* data, std::size_t size);
+
+    /// Stages `size` bytes of pixel data and calls `upload` with the page bound as the pixel unpack
+    /// buffer, passing the offset to use in place of the pixel pointer.
+    /// Returns false, without calling `upload`, when the data can't be staged right now.
+    bool unpack(const void* data, std::size_t size, const std::function<void(const void*)>& upload);
+
+    bool isPersistent() const { return persistent; }
+
+private:
+    struct Page {
+        platform::GLuint id = 0;
+        // Start of the persistent mapping, if any
+        void* mapped = nullptr;
+        // Next unused byte
+        std::size_t pointer = 0;
+        // Signaled once the GPU is done with everything written so far
+        std::shared_ptr<gl::Fence> fence;
+    };
+
+    bool createPage();
+    // Makes a page with room for a full page of data current, if there is one
+    bool nextPage();
+    // Writes to the current page, which must have room, storing the offset written at
+    bool write(const void* data, std::size_t size, std::size_t& writtenAt);
+    // Writes to the current page or the next one, if there's room anywhere
+    bool stage(const void* data, std::size_t size, std::size_t& writtenAt);
+
+    Context& context;
+    const extension::BufferStorage* bufferStorage;
+    bool persistent;
+
+    std::vector<Page> pages;
+    std::size_t currentPage = 0;
+    // Full pages waiting for their fence, oldest first
+    std::deque<std::size_t> inFlight;
+};
+
+} // namespace gl
+} // namespace mbgl
@@ -2,12 +2,22 @@
 #include <mbgl/gl/context.hpp>
 #include <mbgl/gl/defines.hpp>
 #include <mbgl/gl/enum.hpp>
+#include <mbgl/gl/staging_buffer.hpp>
 #include <mbgl/platform/gl_functions.hpp>
 #include <mbgl/util/instrumentation.hpp>
 
+#include <algorithm>
+
 namespace mbgl {
 namespace gl {
 
+namespace {
+
+// Smaller updates, like atlas regions, are cheaper to upload from client memory than to stage
+constexpr std::size_t minStagedUploadBytes = 64 * 1024;
+
+} // namespace
+
 Texture2D::Texture2D(gl::Context& context_)
     : context(context_) {}
 
@@ -39,10 +49,20 @@ Texture2D& Texture2D::setSize(mbgl::Size size_) noexcept {
 
 Texture2D& Texture2D::setImage(std::shared_ptr<PremultipliedImage> image_) noexcept {
     image = std::move(image_);
+    compressedImage.reset();
+    return *this;
+}
+
+Texture2D& Texture2D::setCompressedImage(std::shared_ptr<const CompressedImage> image_) noexcept {
+    compressedImage = std::move(image_);
+    image.reset();
     return *this;
 }
 
 size_t Texture2D::getDataSize() const noexcept {
+    if (compressedDataSize) {
+        return compressedDataSize;
+    }
     return size.width * size.height * getPixelStride();
 }
 
@@ -74,6 +94,8 @@ void Texture2D::allocateTexture() {
     MLN_TRACE_FUNC();
 
     // Create a new texture object
+    compressedDataSize = 0;
+    mipmaps = false;
     auto obj = context.createUniqueTexture(size, pixelFormat, channelType);
     texture = std::make_unique<UniqueTexture>(std::move(obj));
 }
@@ -82,6 +104,12 @@ void Texture2D::updateTextureData(const void* data) noexcept {
     MLN_TRACE_FUNC();
     if (data) {
         uploadSubRegion(data, size, 0, 0);
+
+        // From the level just uploaded, the texture being still bound
+        mipmaps = samplerState.mipmapped;
+        if (mipmaps) {
+            MBGL_CHECK_ERROR(glGenerateMipmap(GL_TEXTURE_2D));
+        }
     }
 
     storageDirty = false;
@@ -103,9 +131,10 @@ void Texture2D::updateSamplerConfiguration() noexcept {
     using namespace platform;
     samplerStateDirty = false;
 
-    MBGL_CHECK_ERROR(glTexParameteri(GL_TEXTURE_2D,
-                                     GL_TEXTURE_MIN_FILTER,
-                                     samplerState.filter == gfx::TextureFilterType::Nearest ? GL_NEAREST : GL_LINEAR));
+    const bool nearest = samplerState.filter == gfx::TextureFilterType::Nearest;
+    const auto minFilter = !mipmaps ? (nearest ? GL_NEAREST : GL_LINEAR)
+                                    : (nearest ? GL_NEAREST_MIPMAP_NEAREST : GL_LINEAR_MIPMAP_LINEAR);
+    MBGL_CHECK_ERROR(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, minFilter));
     MBGL_CHECK_ERROR(glTexParameteri(GL_TEXTURE_2D,
                                      GL_TEXTURE_MAG_FILTER,
                                      samplerState.filter == gfx::TextureFilterType::Nearest ? GL_NEAREST : GL_LINEAR));
@@ -115,6 +144,12 @@ void Texture2D::updateSamplerConfiguration() noexcept {
     MBGL_CHECK_ERROR(glTexParameteri(GL_TEXTURE_2D,
                                      GL_TEXTURE_WRAP_T,
                                      samplerState.wrapV == gfx::TextureWrapType::Clamp ? GL_CLAMP_TO_EDGE : GL_REPEAT));
+    // Set even when 1, as pooled textures keep the value of their previous use
+    if (const auto maxAnisotropy = context.getMaxTextureAnisotropy(); maxAnisotropy > 1.0f) {
+        MBGL_CHECK_ERROR(glTexParameterf(GL_TEXTURE_2D,
+                                         GL_TEXTURE_MAX_ANISOTROPY_EXT,
+                                         std::min(static_cast<float>(samplerState.maxAnisotropy), maxAnisotropy)));
+    }
 }
 
 void Texture2D::bind(int32_t location, int32_t textureUnit) noexcept {
@@ -123,9 +158,15 @@ void Texture2D::bind(int32_t location, int32_t textureUnit) noexcept {
     assert(gfx::MaxActiveTextureUnits > textureUnit);
     if (gfx::MaxActiveTextureUnits <= textureUnit) return;
 
-    // Bind to the texture unit
-    context.activeTextureUnit = static_cast<uint8_t>(textureUnit);
-    context.texture[static_cast<size_t>(textureUnit)] = getTextureID();
+    // Bind to the texture unit, unless it's bound there already. Updating the sampler state below needs the unit
+    // to be the active one.
+    auto& unitTexture = context.texture[static_cast<size_t>(textureUnit)];
+    if (unitTexture != getTextureID() || samplerStateDirty) {
+        context.activeTextureUnit = static_cast<uint8_t>(textureUnit);
+        unitTexture = getTextureID();
+    } else {
+        context.renderingStats().numRedundantStateCalls++;
+    }
     boundTextureUnit = textureUnit;
 
     // Update the sampler state if it was changed after resource creation
@@ -180,22 +221,48 @@ void Texture2D::uploadSubRegion(const void* pixelData, const Size& size_, uint16
     context.activeTextureUnit = 0;
     context.texture[0] = getTextureID();
     context.pixelStoreUnpack = {1};
-    MBGL_CHECK_ERROR(glTexSubImage2D(GL_TEXTURE_2D,
-                                     0,
-                                     xOffset,
-                                     yOffset,
-                                     size_.width,
-                                     size_.height,
-                                     Enum<gfx::TexturePixelType>::to(pixelFormat),
-                                     Enum<gfx::TextureChannelDataType>::to(channelType),
-                                     pixelData));
+    const auto texSubImage = [&](const void* pixels) {
+        MBGL_CHECK_ERROR(glTexSubImage2D(GL_TEXTURE_2D,
+                                         0,
+                                         xOffset,
+                                         yOffset,
+                                         size_.width,
+                                         size_.height,
+                                         Enum<gfx::TexturePixelType>::to(pixelFormat),
+                                         Enum<gfx::TextureChannelDataType>::to(channelType),
+                                         pixels));
+    };
+
+    // Larger images go through a pixel unpack buffer, leaving the driver to copy them asynchronously
+    const auto bytes = static_cast<size_t>(getPixelStride() * size_.width * size_.height);
+    if (!pixelData || bytes < minStagedUploadBytes ||
+        !context.getStagingBuffer().unpack(pixelData, bytes, texSubImage)) {
+        texSubImage(pixelData);
+    }
 
     context.renderingStats().numTextureUpdates++;
-    context.renderingStats().textureUpdateBytes += static_cast<size_t>(getPixelStride() * size_.width * size_.height);
+    context.renderingStats().textureUpdateBytes += bytes;
 }
 
 void Texture2D::upload() {
+    if (compressedImage) {
+        if (context.supportsCompressedImageFormat(compressedImage->format)) {
+            size = compressedImage->size;
+            compressedDataSize = compressedImage->bytes();
+            // Compressed images come with a single level
+            mipmaps = false;
+            texture = std::make_unique<UniqueTexture>(context.createUniqueCompressedTexture(*compressedImage));
+            storageDirty = false;
+            updateSamplerConfiguration();
+        }
+        compressedImage.reset();
+        return;
+    }
     if (image && image->valid()) {
+        if (deferrableUpload && !context.reserveTextureUpload(image->bytes())) {
+            // Over the budget of this frame, try again in the next one
+            return;
+        }
         setFormat(gfx::TexturePixelType::RGBA, gfx::TextureChannelDataType::UnsignedByte);
         upload(image->data.get(), image->size);
         image.reset();
@@ -117,6 +117,17 @@ void loadTimeStampQueryExtension(const GlContexsLoader &loadExtension) {
     loader = std::make_unique<TimestampQueryLoader>(loadExtension);
 }
 
+bool timeElapsedQueriesSupported() {
+    const auto &loader = singleton();
+    return loader && loader->glGenQueries && loader->glDeleteQueries && loader->glBeginQuery && loader->glEndQuery &&
+           loader->glGetQueryObjectuiv && loader->glGetQueryObjectui64v;
+}
+
+bool timestampQueriesSupported() {
+    const auto &loader = singleton();
+    return timeElapsedQueriesSupported() && loader->glQueryCounter;
+}
+
 } // namespace extension
 } // namespace gl
 } // namespace mbgl
@@ -36,6 +36,12 @@ using GlContexsLoader = std::function<ProcAddress(std::initializer_list<std::pai
 
 void loadTimeStampQueryExtension(const GlContexsLoader &loadExtension);
 
+/// Whether the functions needed to measure elapsed GPU time were loaded
+bool timeElapsedQueriesSupported();
+
+/// Whether the functions needed to record GL_TIMESTAMP queries were loaded
+bool timestampQueriesSupported();
+
 } // namespace extension
 } // namespace gl
 } // namespace mbgl
@@ -113,6 +113,7 @@ UniformBufferGL::~UniformBufferGL() {
     }
 
     if (localID) {
+        context.uniformBufferDeleted(localID);
         MBGL_CHECK_ERROR(glDeleteBuffers(1, &localID));
         localID = 0;
     }
@@ -152,6 +153,7 @@ void UniformBufferGL::update(const void* data, std::size_t dataSize) {
     context.renderingStats().bufferUpdates++;
     context.renderingStats().bufferObjUpdates++;
     context.renderingStats().uniformUpdateBytes += dataSize;
+    context.renderingStats().frameUniformUpdateBytes += dataSize;
     context.renderingStats().bufferUpdateBytes += dataSize;
 }
 
@@ -161,13 +163,13 @@ void UniformBufferArrayGL::bind() const {
     for (size_t id = 0; id < allocatedSize(); id++) {
         const auto& uniformBuffer = get(id);
         if (!uniformBuffer) continue;
-        GLint binding = static_cast<GLint>(id);
         const auto& uniformBufferGL = static_cast<const UniformBufferGL&>(*uniformBuffer);
-        MBGL_CHECK_ERROR(glBindBufferRange(GL_UNIFORM_BUFFER,
-                                           binding,
-                                           uniformBufferGL.getID(),
-                                           uniformBufferGL.getManagedBuffer().getBindingOffset(),
-                                           uniformBufferGL.getSize()));
+        uniformBufferGL.context.bindUniformBuffer(
+            static_cast<uint32_t>(id),
+            uniformBufferGL.getID(),
+            static_cast<std::size_t>(uniformBufferGL.getManagedBuffer().getBindingOffset()),
+            uniformBufferGL.getSize());
+        uniformBufferGL.context.renderingStats().numUniformBindings++;
     }
 }
 
@@ -177,8 +179,7 @@ void UniformBufferArrayGL::unbind() const {
     for (size_t id = 0; id < allocatedSize(); id++) {
         const auto& uniformBuffer = get(id);
         if (!uniformBuffer) continue;
-        GLint binding = static_cast<GLint>(id);
-        MBGL_CHECK_ERROR(glBindBufferBase(GL_UNIFORM_BUFFER, binding, 0));
+        static_cast<const UniformBufferGL&>(*uniformBuffer).context.unbindUniformBuffer(static_cast<uint32_t>(id));
     }
 }
 
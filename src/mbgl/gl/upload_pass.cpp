@@ -8,6 +8,7 @@
 #include <mbgl/gl/command_encoder.hpp>
 #include <mbgl/gl/vertex_buffer_resource.hpp>
 #include <mbgl/gl/index_buffer_resource.hpp>
+#include <mbgl/gl/staging_buffer.hpp>
 #include <mbgl/util/instrumentation.hpp>
 #include <mbgl/util/logging.hpp>
 
@@ -42,9 +43,16 @@ std::unique_ptr<gfx::VertexBufferResource> UploadPass::createVertexBufferResourc
     return std::make_unique<gl::VertexBufferResource>(std::move(result), static_cast<int>(size));
 }
 
-void UploadPass::updateVertexBufferResource(gfx::VertexBufferResource& resource, const void* data, std::size_t size) {
+void UploadPass::updateVertexBufferResource(gfx::VertexBufferResource& resource,
+                                            const void* data,
+                                            std::size_t size,
+                                            std::size_t offset) {
     commandEncoder.context.vertexBuffer = static_cast<gl::VertexBufferResource&>(resource).getBuffer();
-    MBGL_CHECK_ERROR(glBufferSubData(GL_ARRAY_BUFFER, 0, size, data));
+    // The GPU may still be drawing from this buffer, copy through the staging ring rather than
+    // having the driver wait on it
+    if (!commandEncoder.context.getStagingBuffer().copy(GL_ARRAY_BUFFER, offset, data, size)) {
+        MBGL_CHECK_ERROR(glBufferSubData(GL_ARRAY_BUFFER, offset, size, data));
+    }
 
     commandEncoder.context.renderingStats().vertexUpdateBytes += size;
     commandEncoder.context.renderingStats().bufferUpdateBytes += size;
@@ -75,7 +83,9 @@ void UploadPass::updateIndexBufferResource(gfx::IndexBufferResource& resource, c
     // index buffer so that we don't mess up another VAO
     commandEncoder.context.bindVertexArray = 0;
     commandEncoder.context.globalVertexArrayState.indexBuffer = static_cast<gl::IndexBufferResource&>(resource).buffer;
-    MBGL_CHECK_ERROR(glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, size, data));
+    if (!commandEncoder.context.getStagingBuffer().copy(GL_ELEMENT_ARRAY_BUFFER, 0, data, size)) {
+        MBGL_CHECK_ERROR(glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, size, data));
+    }
 
     commandEncoder.context.renderingStats().indexUpdateBytes += size;
     commandEncoder.context.renderingStats().bufferUpdateBytes += size;
@@ -106,7 +116,18 @@ const gfx::UniqueVertexBufferResource& UploadPass::getBuffer(const gfx::VertexVe
             if (rawBufSize <= resource.getByteSize()) {
                 // If the source changed, update the buffer contents
                 if (vec->isModifiedAfter(resource.getLastUpdated())) {
-                    updateVertexBufferResource(resource, rawBufPtr, rawBufSize);
+                    // Only upload the span that changed, if the producer tracked it
+                    if (const auto range = vec->getModifiedRange()) {
+                        if (range->second > range->first) {
+                            updateVertexBufferResource(resource,
+                                                       static_cast<const uint8_t*>(rawBufPtr) + range->first,
+                                                       range->second - range->first,
+                                                       range->first);
+                        }
+                    } else {
+                        updateVertexBufferResource(resource, rawBufPtr, rawBufSize, /*offset=*/0);
+                    }
+                    vec->clearModifiedRange();
                     resource.setLastUpdated(vec->getLastModified());
                 }
                 return rawData->resource;
@@ -117,6 +138,7 @@ const gfx::UniqueVertexBufferResource& UploadPass::getBuffer(const gfx::VertexVe
             auto buffer = std::make_unique<VertexBufferGL>();
             buffer->resource = createVertexBufferResource(rawBufPtr, rawBufSize, usage, /*persistent=*/false);
             vec->setBuffer(std::move(buffer));
+            vec->clearModifiedRange();
             return static_cast<VertexBufferGL*>(vec->getBuffer())->resource;
         }
     }
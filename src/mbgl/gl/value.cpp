@@ -515,6 +515,22 @@ BindVertexArray::Type BindVertexArray::Get() {
     return binding;
 }
 
+const constexpr BindUniformBuffer::Type BindUniformBuffer::Default;
+
+void BindUniformBuffer::Set(const Type& value, uint32_t index) {
+    MLN_TRACE_ZONE(BindUniformBuffer::Set);
+    MLN_TRACE_FUNC_GL();
+    if (value.buffer) {
+        MBGL_CHECK_ERROR(glBindBufferRange(GL_UNIFORM_BUFFER,
+                                           index,
+                                           value.buffer,
+                                           static_cast<GLintptr>(value.offset),
+                                           static_cast<GLsizeiptr>(value.size)));
+    } else {
+        MBGL_CHECK_ERROR(glBindBufferBase(GL_UNIFORM_BUFFER, index, 0));
+    }
+}
+
 const VertexAttribute::Type VertexAttribute::Default{};
 
 namespace {
@@ -267,6 +267,20 @@ struct BindVertexArray {
     static Type Get();
 };
 
+struct BindUniformBuffer {
+    struct Type {
+        gl::BufferID buffer;
+        std::size_t offset;
+        std::size_t size;
+    };
+    static const constexpr Type Default = {0, 0, 0};
+    static void Set(const Type&, uint32_t index);
+};
+
+constexpr bool operator!=(const BindUniformBuffer::Type& a, const BindUniformBuffer::Type& b) {
+    return a.buffer != b.buffer || a.offset != b.offset || a.size != b.size;
+}
+
 struct VertexAttribute {
     using Type = std::optional<gfx::AttributeBinding>;
     static const Type Default;
@@ -16,6 +16,12 @@ std::unique_ptr<style::Layer> BackgroundLayerFactory::createLayer(
     return std::unique_ptr<style::Layer>(new (std::nothrow) style::BackgroundLayer(id));
 }
 
+std::unique_ptr<style::Layer> BackgroundLayerFactory::createLayerFromImpl(Immutable<style::Layer::Impl> impl) noexcept {
+    assert(impl->getTypeInfo() == getTypeInfo());
+    return std::unique_ptr<style::Layer>(
+        new (std::nothrow) style::BackgroundLayer(staticImmutableCast<style::BackgroundLayer::Impl>(impl)));
+}
+
 std::unique_ptr<RenderLayer> BackgroundLayerFactory::createRenderLayer(Immutable<style::Layer::Impl> impl) noexcept {
     assert(impl->getTypeInfo() == getTypeInfo());
     return std::make_unique<RenderBackgroundLayer>(staticImmutableCast<style::BackgroundLayer::Impl>(impl));
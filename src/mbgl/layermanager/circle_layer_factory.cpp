@@ -25,6 +25,12 @@ std::unique_ptr<Layout> CircleLayerFactory::createLayout(const LayoutParameters&
                                        CircleLayout(parameters.bucketParameters, group, std::move(layer)));
 }
 
+std::unique_ptr<style::Layer> CircleLayerFactory::createLayerFromImpl(Immutable<style::Layer::Impl> impl) noexcept {
+    assert(impl->getTypeInfo() == getTypeInfo());
+    return std::unique_ptr<style::Layer>(
+        new (std::nothrow) style::CircleLayer(staticImmutableCast<style::CircleLayer::Impl>(impl)));
+}
+
 std::unique_ptr<RenderLayer> CircleLayerFactory::createRenderLayer(Immutable<style::Layer::Impl> impl) noexcept {
     assert(impl->getTypeInfo() == getTypeInfo());
     return std::unique_ptr<RenderLayer>(new (std::nothrow)
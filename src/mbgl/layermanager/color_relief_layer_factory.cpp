@@ -19,6 +19,13 @@ std::unique_ptr<style::Layer> ColorReliefLayerFactory::createLayer(
     return std::unique_ptr<style::Layer>(new (std::nothrow) style::ColorReliefLayer(id, *source));
 }
 
+std::unique_ptr<style::Layer> ColorReliefLayerFactory::createLayerFromImpl(
+    Immutable<style::Layer::Impl> impl) noexcept {
+    assert(impl->getTypeInfo() == getTypeInfo());
+    return std::unique_ptr<style::Layer>(
+        new (std::nothrow) style::ColorReliefLayer(staticImmutableCast<style::ColorReliefLayer::Impl>(impl)));
+}
+
 std::unique_ptr<RenderLayer> ColorReliefLayerFactory::createRenderLayer(Immutable<style::Layer::Impl> impl) noexcept {
     assert(impl->getTypeInfo() == getTypeInfo());
     return std::make_unique<RenderColorReliefLayer>(staticImmutableCast<style::ColorReliefLayer::Impl>(impl));
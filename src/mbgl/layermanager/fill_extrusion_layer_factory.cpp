@@ -27,6 +27,13 @@ std::unique_ptr<Layout> FillExtrusionLayerFactory::createLayout(
                                        LayoutType(parameters.bucketParameters, group, std::move(layer), parameters));
 }
 
+std::unique_ptr<style::Layer> FillExtrusionLayerFactory::createLayerFromImpl(
+    Immutable<style::Layer::Impl> impl) noexcept {
+    assert(impl->getTypeInfo() == getTypeInfo());
+    return std::unique_ptr<style::Layer>(
+        new (std::nothrow) style::FillExtrusionLayer(staticImmutableCast<style::FillExtrusionLayer::Impl>(impl)));
+}
+
 std::unique_ptr<RenderLayer> FillExtrusionLayerFactory::createRenderLayer(Immutable<style::Layer::Impl> impl) noexcept {
     assert(impl->getTypeInfo() == getTypeInfo());
     auto renderImpl = staticImmutableCast<style::FillExtrusionLayer::Impl>(impl);
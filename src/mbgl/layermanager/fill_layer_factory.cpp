@@ -33,6 +33,12 @@ std::unique_ptr<Layout> FillLayerFactory::createLayout(const LayoutParameters& p
         new (std::nothrow) LayoutTypeSorted(parameters.bucketParameters, group, std::move(layer), parameters));
 }
 
+std::unique_ptr<style::Layer> FillLayerFactory::createLayerFromImpl(Immutable<style::Layer::Impl> impl) noexcept {
+    assert(impl->getTypeInfo() == getTypeInfo());
+    return std::unique_ptr<style::Layer>(
+        new (std::nothrow) style::FillLayer(staticImmutableCast<style::FillLayer::Impl>(impl)));
+}
+
 std::unique_ptr<RenderLayer> FillLayerFactory::createRenderLayer(Immutable<style::Layer::Impl> impl) noexcept {
     assert(impl->getTypeInfo() == getTypeInfo());
     auto fillImpl = staticImmutableCast<style::FillLayer::Impl>(impl);
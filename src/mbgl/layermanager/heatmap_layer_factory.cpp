@@ -25,6 +25,12 @@ std::unique_ptr<Bucket> HeatmapLayerFactory::createBucket(
     return std::make_unique<HeatmapBucket>(parameters, layers);
 }
 
+std::unique_ptr<style::Layer> HeatmapLayerFactory::createLayerFromImpl(Immutable<style::Layer::Impl> impl) noexcept {
+    assert(impl->getTypeInfo() == getTypeInfo());
+    return std::unique_ptr<style::Layer>(
+        new (std::nothrow) style::HeatmapLayer(staticImmutableCast<style::HeatmapLayer::Impl>(impl)));
+}
+
 std::unique_ptr<RenderLayer> HeatmapLayerFactory::createRenderLayer(Immutable<style::Layer::Impl> impl) noexcept {
     assert(impl->getTypeInfo() == getTypeInfo());
     return std::make_unique<RenderHeatmapLayer>(staticImmutableCast<style::HeatmapLayer::Impl>(impl));
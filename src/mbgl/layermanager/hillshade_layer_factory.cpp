@@ -19,6 +19,12 @@ std::unique_ptr<style::Layer> HillshadeLayerFactory::createLayer(const std::stri
     return std::unique_ptr<style::Layer>(new (std::nothrow) style::HillshadeLayer(id, *source));
 }
 
+std::unique_ptr<style::Layer> HillshadeLayerFactory::createLayerFromImpl(Immutable<style::Layer::Impl> impl) noexcept {
+    assert(impl->getTypeInfo() == getTypeInfo());
+    return std::unique_ptr<style::Layer>(
+        new (std::nothrow) style::HillshadeLayer(staticImmutableCast<style::HillshadeLayer::Impl>(impl)));
+}
+
 std::unique_ptr<RenderLayer> HillshadeLayerFactory::createRenderLayer(Immutable<style::Layer::Impl> impl) noexcept {
     assert(impl->getTypeInfo() == getTypeInfo());
     return std::make_unique<RenderHillshadeLayer>(staticImmutableCast<style::HillshadeLayer::Impl>(impl));
@@ -25,6 +25,10 @@ std::optional<std::string> LayerFactory::getSource(const style::conversion::Conv
     return source;
 }
 
+std::unique_ptr<style::Layer> LayerFactory::createLayerFromImpl(Immutable<style::Layer::Impl>) noexcept {
+    return nullptr;
+}
+
 std::unique_ptr<Bucket> LayerFactory::createBucket(const BucketParameters&,
                                                    const std::vector<Immutable<style::LayerProperties>>&) noexcept {
     assert(false);
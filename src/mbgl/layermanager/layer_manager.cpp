@@ -31,6 +31,11 @@ std::unique_ptr<style::Layer> LayerManager::createLayer(const std::string& type,
     return nullptr;
 }
 
+std::unique_ptr<style::Layer> LayerManager::createLayer(Immutable<style::Layer::Impl> impl) noexcept {
+    LayerFactory* factory = getFactory(impl->getTypeInfo());
+    return factory ? factory->createLayerFromImpl(std::move(impl)) : nullptr;
+}
+
 std::unique_ptr<Bucket> LayerManager::createBucket(const BucketParameters& parameters,
                                                    const std::vector<Immutable<style::LayerProperties>>& layers) {
     assert(!layers.empty());
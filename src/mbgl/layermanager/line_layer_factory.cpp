@@ -34,6 +34,12 @@ std::unique_ptr<Layout> LineLayerFactory::createLayout(
         new (std::nothrow) LayoutTypeSorted(parameters.bucketParameters, group, std::move(layer), parameters));
 }
 
+std::unique_ptr<style::Layer> LineLayerFactory::createLayerFromImpl(Immutable<style::Layer::Impl> impl) noexcept {
+    assert(impl->getTypeInfo() == getTypeInfo());
+    return std::unique_ptr<style::Layer>(
+        new (std::nothrow) style::LineLayer(staticImmutableCast<style::LineLayer::Impl>(impl)));
+}
+
 std::unique_ptr<RenderLayer> LineLayerFactory::createRenderLayer(Immutable<style::Layer::Impl> impl) noexcept {
     assert(impl->getTypeInfo() == getTypeInfo());
     auto lineImpl = staticImmutableCast<style::LineLayer::Impl>(impl);
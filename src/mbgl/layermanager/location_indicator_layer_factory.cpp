@@ -15,6 +15,14 @@ std::unique_ptr<style::Layer> LocationIndicatorLayerFactory::createLayer(
     return std::unique_ptr<style::Layer>(new style::LocationIndicatorLayer(id));
 }
 
+std::unique_ptr<style::Layer> LocationIndicatorLayerFactory::createLayerFromImpl(
+    Immutable<style::Layer::Impl> impl) noexcept {
+    assert(impl->getTypeInfo() == getTypeInfo());
+    auto locationIndicatorImpl = staticImmutableCast<style::LocationIndicatorLayer::Impl>(impl);
+    return std::unique_ptr<style::Layer>(
+        new (std::nothrow) style::LocationIndicatorLayer(std::move(locationIndicatorImpl)));
+}
+
 std::unique_ptr<RenderLayer> LocationIndicatorLayerFactory::createRenderLayer(
     Immutable<style::Layer::Impl> impl) noexcept {
     assert(impl->getTypeInfo() == getTypeInfo());
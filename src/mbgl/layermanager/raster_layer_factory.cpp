@@ -19,6 +19,12 @@ std::unique_ptr<style::Layer> RasterLayerFactory::createLayer(const std::string&
     return std::unique_ptr<style::Layer>(new (std::nothrow) style::RasterLayer(id, *source));
 }
 
+std::unique_ptr<style::Layer> RasterLayerFactory::createLayerFromImpl(Immutable<style::Layer::Impl> impl) noexcept {
+    assert(impl->getTypeInfo() == getTypeInfo());
+    return std::unique_ptr<style::Layer>(
+        new (std::nothrow) style::RasterLayer(staticImmutableCast<style::RasterLayer::Impl>(impl)));
+}
+
 std::unique_ptr<RenderLayer> RasterLayerFactory::createRenderLayer(Immutable<style::Layer::Impl> impl) noexcept {
     assert(impl->getTypeInfo() == getTypeInfo());
     return std::make_unique<RenderRasterLayer>(staticImmutableCast<style::RasterLayer::Impl>(impl));
@@ -24,6 +24,12 @@ std::unique_ptr<Layout> SymbolLayerFactory::createLayout(const LayoutParameters&
         new (std::nothrow) SymbolLayout(parameters.bucketParameters, group, std::move(tileLayer), parameters));
 }
 
+std::unique_ptr<style::Layer> SymbolLayerFactory::createLayerFromImpl(Immutable<style::Layer::Impl> impl) noexcept {
+    assert(impl->getTypeInfo() == getTypeInfo());
+    return std::unique_ptr<style::Layer>(
+        new (std::nothrow) style::SymbolLayer(staticImmutableCast<style::SymbolLayer::Impl>(impl)));
+}
+
 std::unique_ptr<RenderLayer> SymbolLayerFactory::createRenderLayer(Immutable<style::Layer::Impl> impl) noexcept {
     assert(impl->getTypeInfo() == getTypeInfo());
     return std::make_unique<RenderSymbolLayer>(staticImmutableCast<style::SymbolLayer::Impl>(impl));
@@ -7,6 +7,9 @@
 #include <mbgl/style/layers/circle_layer_impl.hpp>
 #include <mbgl/util/containers.hpp>
 
+#include <array>
+#include <span>
+
 namespace mbgl {
 
 class CircleLayout final : public Layout {
@@ -19,9 +22,13 @@ public:
           mode(parameters.mode) {
         assert(!group.empty());
         auto leaderLayerProperties = staticImmutableCast<style::CircleLayerProperties>(group.front());
-        const auto& unevaluatedLayout = leaderLayerProperties->layerImpl().layout;
-        const bool sortFeaturesByKey = !unevaluatedLayout.get<style::CircleSortKey>().isUndefined();
-        const auto& layout = unevaluatedLayout.evaluate(PropertyEvaluationParameters(zoom));
+        const auto& leaderImpl = leaderLayerProperties->layerImpl();
+        const bool sortFeaturesByKey = !leaderImpl.layout.get<style::CircleSortKey>().isUndefined();
+        const auto evaluatedLayout = leaderImpl.evaluatedLayout.get(zoom, [&] {
+            return makeMutable<style::CircleLayoutProperties::PossiblyEvaluated>(
+                leaderImpl.layout.evaluate(PropertyEvaluationParameters(zoom)));
+        });
+        const auto& layout = *evaluatedLayout;
         sourceLayerID = leaderLayerProperties->layerImpl().sourceLayer;
         bucketLeaderID = leaderLayerProperties->layerImpl().id;
 
@@ -54,24 +61,40 @@ public:
 
     bool hasDependencies() const override { return false; }
 
-    void createBucket(const ImagePositions&,
-                      std::unique_ptr<FeatureIndex>& featureIndex,
-                      mbgl::unordered_map<std::string, LayerRenderData>& renderData,
-                      const bool,
-                      const bool,
-                      const CanonicalTileID& canonical) override {
+    std::shared_ptr<Bucket> buildBucket(const ImagePositions&,
+                                        FeatureIndexBatch& featureIndexBatch,
+                                        const CanonicalTileID& canonical) override {
         auto bucket = std::make_shared<CircleBucket>(layerPropertiesMap, mode, zoom);
 
         for (auto& circleFeature : features) {
             const auto i = circleFeature.i;
             const std::unique_ptr<GeometryTileFeature>& feature = circleFeature.feature;
+            if (const auto points = feature->getPoints()) {
+                // Circle buckets take their geometry from `addCircle` alone
+                addCircle(*bucket, *feature, std::array{*points}, i, circleFeature.sortKey, canonical);
+                featureIndexBatch.add(*points, i);
+                continue;
+            }
+
             const GeometryCollection& geometries = feature->getGeometries();
 
             addCircle(*bucket, *feature, geometries, i, circleFeature.sortKey, canonical);
 
             bucket->addFeature(*feature, geometries, {}, PatternLayerMap(), i, canonical);
-            featureIndex->insert(geometries, i, sourceLayerID, bucketLeaderID);
+            featureIndexBatch.add(geometries, i);
         }
+        return bucket;
+    }
+
+    void createBucket(const ImagePositions& imagePositions,
+                      std::unique_ptr<FeatureIndex>& featureIndex,
+                      mbgl::unordered_map<std::string, LayerRenderData>& renderData,
+                      const bool,
+                      const bool,
+                      const CanonicalTileID& canonical) override {
+        FeatureIndexBatch featureIndexBatch;
+        const auto bucket = buildBucket(imagePositions, featureIndexBatch, canonical);
+        featureIndex->insert(featureIndexBatch, sourceLayerID, bucketLeaderID);
 
         if (!bucket->hasData()) return;
 
@@ -89,17 +112,20 @@ private:
         float sortKey;
     };
 
+    // Rings of points, those of a GeometryCollection or a single ring viewed in place
+    template <class Rings>
     void addCircle(CircleBucket& bucket,
                    const GeometryTileFeature& feature,
-                   const GeometryCollection& geometry,
+                   const Rings& geometry,
                    std::size_t featureIndex,
                    float sortKey,
                    const CanonicalTileID& canonical) {
-        constexpr const uint16_t vertexLength = 4;
-
         auto& segments = bucket.segments;
         auto& vertices = bucket.vertices;
+#if !MLN_USE_CIRCLE_INSTANCING
+        constexpr const uint16_t vertexLength = 4;
         auto& triangles = bucket.triangles;
+#endif
 
         for (auto& circle : geometry) {
             for (auto& point : circle) {
@@ -112,6 +138,14 @@ private:
                 if ((mode == MapMode::Continuous) && (x < 0 || x >= util::EXTENT || y < 0 || y >= util::EXTENT))
                     continue;
 
+#if MLN_USE_CIRCLE_INSTANCING
+                // Instances aren't indexed, a single segment holds them all
+                if (segments.empty()) {
+                    segments.emplace_back(vertices.elements(), 0ul, 0ul, 0ul, sortKey);
+                }
+                vertices.emplace_back(CircleBucket::instance(point));
+                segments.back().vertexLength += 1;
+#else
                 if (segments.empty() ||
                     segments.back().vertexLength + vertexLength > std::numeric_limits<uint16_t>::max()) {
                     // Move to a new segments because the old one can't hold the geometry.
@@ -143,6 +177,7 @@ private:
 
                 segment.vertexLength += vertexLength;
                 segment.indexLength += 6;
+#endif
             }
         }
 
@@ -9,10 +9,15 @@
 
 namespace mbgl {
 
+namespace gfx {
+class TriangulationCache;
+} // namespace gfx
+
 class Bucket;
 class BucketParameters;
 class RenderLayer;
 class FeatureIndex;
+class FeatureIndexBatch;
 class LayerRenderData;
 class GlyphManager;
 
@@ -27,6 +32,14 @@ public:
                               bool,
                               const CanonicalTileID&) = 0;
 
+    /// Builds the bucket on its own, recording its features in `featureIndexBatch`, for the caller to add to the
+    /// feature index and render data in place of `createBucket`. Safe to call on another thread than the worker's,
+    /// and for several layouts at once as long as they read different source layers. Returns null for layouts that
+    /// only build their bucket in `createBucket`.
+    virtual std::shared_ptr<Bucket> buildBucket(const ImagePositions&, FeatureIndexBatch&, const CanonicalTileID&) {
+        return nullptr;
+    }
+
     virtual void prepareSymbols(const GlyphMap&, const GlyphPositions&, const ImageMap&, const ImagePositions&) {}
 
     virtual void finalizeSymbols(HBShapeResults&) {}
@@ -45,6 +58,8 @@ public:
     GlyphDependencies& glyphDependencies;
     ImageDependencies& imageDependencies;
     std::set<std::string>& availableImages;
+    /// Triangulations kept by the tile across layout passes over the same data, if any
+    gfx::TriangulationCache* triangulations = nullptr;
 };
 
 } // namespace mbgl
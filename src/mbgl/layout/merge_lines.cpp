@@ -1,17 +1,20 @@
 #include <mbgl/layout/merge_lines.hpp>
 #include <mbgl/layout/symbol_feature.hpp>
-#include <mbgl/util/hash.hpp>
+#include <mbgl/util/containers.hpp>
+
+#include <cstdint>
+#include <string_view>
 
 namespace mbgl {
 namespace util {
 
 // Map of key -> index into features
-using Index = std::unordered_map<size_t, size_t>;
+using Index = mbgl::unordered_map<uint64_t, size_t>;
 namespace {
 size_t mergeFromRight(std::vector<SymbolFeature>& features,
                       Index& rightIndex,
                       Index::iterator left,
-                      size_t rightKey,
+                      uint64_t rightKey,
                       GeometryCollection& geom) {
     const size_t index = left->second;
     rightIndex.erase(left);
@@ -25,7 +28,7 @@ size_t mergeFromRight(std::vector<SymbolFeature>& features,
 size_t mergeFromLeft(std::vector<SymbolFeature>& features,
                      Index& leftIndex,
                      Index::iterator right,
-                     size_t leftKey,
+                     uint64_t leftKey,
                      GeometryCollection& geom) {
     const size_t index = right->second;
     leftIndex.erase(right);
@@ -37,13 +40,17 @@ size_t mergeFromLeft(std::vector<SymbolFeature>& features,
     return index;
 }
 
-size_t getKey(const std::u16string& text, const GeometryCoordinate& coord) {
-    return util::hash(text, coord.x, coord.y);
+// The text's ID and the coordinate, packed so that keys are exact rather than hashes that may collide
+uint64_t getKey(uint32_t textID, const GeometryCoordinate& coord) {
+    return (uint64_t{textID} << 32) | (uint64_t{static_cast<uint16_t>(coord.x)} << 16) |
+           uint64_t{static_cast<uint16_t>(coord.y)};
 }
 } // namespace
 void mergeLines(std::vector<SymbolFeature>& features) {
     Index leftIndex;
     Index rightIndex;
+    // Views of the features' own text, which outlives the merge as only geometries change
+    mbgl::unordered_map<std::u16string_view, uint32_t> textIDs;
 
     for (size_t k = 0; k < features.size(); k++) {
         SymbolFeature& feature = features[k];
@@ -56,8 +63,12 @@ void mergeLines(std::vector<SymbolFeature>& features) {
         // TODO: Key should include formatting options (see
         // https://github.com/mapbox/mapbox-gl-js/issues/3645)
 
-        const size_t leftKey = getKey(feature.formattedText->rawText(), geometry[0].front());
-        const size_t rightKey = getKey(feature.formattedText->rawText(), geometry[0].back());
+        const uint32_t textID = textIDs
+                                    .emplace(std::u16string_view(feature.formattedText->rawText()),
+                                             static_cast<uint32_t>(textIDs.size()))
+                                    .first->second;
+        const uint64_t leftKey = getKey(textID, geometry[0].front());
+        const uint64_t rightKey = getKey(textID, geometry[0].back());
 
         const auto left = rightIndex.find(leftKey);
         const auto right = leftIndex.find(rightKey);
@@ -70,7 +81,7 @@ void mergeLines(std::vector<SymbolFeature>& features) {
 
             leftIndex.erase(leftKey);
             rightIndex.erase(rightKey);
-            rightIndex[getKey(feature.formattedText->rawText(), features[i].geometry[0].back())] = i;
+            rightIndex[getKey(textID, features[i].geometry[0].back())] = i;
 
         } else if (left != rightIndex.end()) {
             // found mergeable line adjacent to the start of the current line, merge
@@ -1,5 +1,6 @@
 #pragma once
 #include <mbgl/geometry/feature_index.hpp>
+#include <mbgl/gfx/triangulation_cache.hpp>
 #include <mbgl/layout/layout.hpp>
 #include <mbgl/renderer/bucket_parameters.hpp>
 #include <mbgl/renderer/render_layer.hpp>
@@ -98,10 +99,16 @@ public:
         : sourceLayer(std::move(sourceLayer_)),
           zoom(parameters.tileID.overscaledZ),
           overscaling(parameters.tileID.overscaleFactor()),
+          cancelled(parameters.cancelled),
+          triangulations(layoutParameters.triangulations),
           hasPattern(false) {
         assert(!group.empty());
         auto leaderLayerProperties = staticImmutableCast<LayerPropertiesType>(group.front());
-        layout = leaderLayerProperties->layerImpl().layout.evaluate(PropertyEvaluationParameters(zoom));
+        const auto& leaderImpl = leaderLayerProperties->layerImpl();
+        layout = *leaderImpl.evaluatedLayout.get(zoom, [&] {
+            return makeMutable<typename LayoutPropertiesType::PossiblyEvaluated>(
+                leaderImpl.layout.evaluate(PropertyEvaluationParameters(zoom)));
+        });
         sourceLayerID = leaderLayerProperties->layerImpl().sourceLayer;
         bucketLeaderID = leaderLayerProperties->layerImpl().id;
 
@@ -125,6 +132,12 @@ public:
 
         const size_t featureCount = sourceLayer->featureCount();
         for (size_t i = 0; i < featureCount; ++i) {
+            if (parameters.isCancelled()) {
+                // The tile is obsolete, nothing we produce here will be used
+                features.clear();
+                return;
+            }
+
             auto feature = sourceLayer->getFeature(i);
             if (!leaderLayerProperties->layerImpl().filter(
                     style::expression::EvaluationContext(this->zoom, feature.get())
@@ -181,22 +194,41 @@ public:
 
     bool hasDependencies() const override { return hasPattern; }
 
-    void createBucket(const ImagePositions& patternPositions,
-                      std::unique_ptr<FeatureIndex>& featureIndex,
-                      mbgl::unordered_map<std::string, LayerRenderData>& renderData,
-                      const bool /*firstLoad*/,
-                      const bool /*showCollisionBoxes*/,
-                      const CanonicalTileID& canonical) override {
+    std::shared_ptr<Bucket> buildBucket(const ImagePositions& patternPositions,
+                                        FeatureIndexBatch& featureIndexBatch,
+                                        const CanonicalTileID& canonical) override {
         auto bucket = std::make_shared<BucketType>(layout, layerPropertiesMap, zoom, overscaling);
+        const gfx::TriangulationCache::Scope triangulationScope(triangulations, sourceLayerID);
         for (auto& patternFeature : features) {
+            if (cancelled && cancelled->load(std::memory_order_relaxed)) {
+                return bucket;
+            }
+
             const auto i = patternFeature.i;
             std::unique_ptr<GeometryTileFeature> feature = std::move(patternFeature.feature);
             const PatternLayerMap& patterns = patternFeature.getPatterns();
             const GeometryCollection& geometries = feature->getGeometries();
 
             bucket->addFeature(*feature, geometries, patternPositions, patterns, i, canonical);
-            featureIndex->insert(geometries, i, sourceLayerID, bucketLeaderID);
+            featureIndexBatch.add(geometries, i);
         }
+        bucket->compactPaintAttributes();
+        return bucket;
+    }
+
+    void createBucket(const ImagePositions& patternPositions,
+                      std::unique_ptr<FeatureIndex>& featureIndex,
+                      mbgl::unordered_map<std::string, LayerRenderData>& renderData,
+                      const bool /*firstLoad*/,
+                      const bool /*showCollisionBoxes*/,
+                      const CanonicalTileID& canonical) override {
+        FeatureIndexBatch featureIndexBatch;
+        const auto bucket = buildBucket(patternPositions, featureIndexBatch, canonical);
+        if (cancelled && cancelled->load(std::memory_order_relaxed)) {
+            return;
+        }
+
+        featureIndex->insert(featureIndexBatch, sourceLayerID, bucketLeaderID);
         if (bucket->hasData()) {
             for (const auto& pair : layerPropertiesMap) {
                 renderData.emplace(pair.first, LayerRenderData{bucket, pair.second});
@@ -214,6 +246,8 @@ protected:
 
     const float zoom;
     const uint32_t overscaling;
+    const std::atomic<bool>* cancelled;
+    gfx::TriangulationCache* const triangulations;
     std::string sourceLayerID;
     bool hasPattern;
 };
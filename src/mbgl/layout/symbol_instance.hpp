@@ -183,7 +183,7 @@ public:
     std::optional<size_t> getPlacedIconIndex() const { return placedIconIndex; }
     std::optional<size_t> getPlacedVerticalIconIndex() const { return placedVerticalIconIndex; }
     float getTextBoxScale() const { return textBoxScale; }
-    std::optional<VariableAnchorOffsetCollection> getTextVariableAnchorOffset() const {
+    const std::optional<VariableAnchorOffsetCollection>& getTextVariableAnchorOffset() const {
         return textVariableAnchorOffset;
     }
     bool getSingleLine() const { return singleLine; }
@@ -3,6 +3,7 @@
 #include <mbgl/layout/merge_lines.hpp>
 #include <mbgl/layout/clip_lines.hpp>
 #include <mbgl/math/angles.hpp>
+#include <mbgl/platform/settings.hpp>
 #include <mbgl/renderer/bucket_parameters.hpp>
 #include <mbgl/renderer/layers/render_symbol_layer.hpp>
 #include <mbgl/text/get_anchors.hpp>
@@ -16,10 +17,14 @@
 #include <mbgl/util/i18n.hpp>
 #include <mbgl/util/platform.hpp>
 #include <mbgl/util/containers.hpp>
+#include <mbgl/util/instrumentation.hpp>
+#include <mbgl/util/parallel_for.hpp>
 
 #include <mapbox/polylabel.hpp>
 
 #include <numbers>
+#include <type_traits>
+#include <unordered_map>
 
 using namespace std::numbers;
 
@@ -125,9 +130,12 @@ SymbolLayout::SymbolLayout(const BucketParameters& parameters,
       canonicalID(parameters.tileID.canonical),
       mode(parameters.mode),
       pixelRatio(parameters.pixelRatio),
+      cancelled(parameters.cancelled),
       tileSize(static_cast<uint32_t>(util::tileSize_D * overscaling)),
       tilePixelRatio(static_cast<float>(util::EXTENT) / tileSize),
-      layout(createLayout(toSymbolLayerProperties(layers.at(0)).layerImpl().layout, zoom)) {
+      layout(toSymbolLayerProperties(layers.at(0)).layerImpl().evaluatedLayout.get(zoom, [&] {
+          return createLayout(toSymbolLayerProperties(layers.at(0)).layerImpl().layout, zoom);
+      })) {
     const SymbolLayer::Impl& leader = toSymbolLayerProperties(layers.at(0)).layerImpl();
 
     textSize = leader.layout.get<TextSize>();
@@ -169,6 +177,12 @@ SymbolLayout::SymbolLayout(const BucketParameters& parameters,
     // Determine glyph dependencies
     const size_t featureCount = sourceLayer->featureCount();
     for (size_t i = 0; i < featureCount; ++i) {
+        if (isCancelled()) {
+            // The tile is obsolete, nothing we produce here will be used
+            features.clear();
+            return;
+        }
+
         auto feature = sourceLayer->getFeature(i);
         if (!leader.filter(expression::EvaluationContext(this->zoom, feature.get())
                                .withCanonicalTileID(&parameters.tileID.canonical)))
@@ -202,7 +216,8 @@ SymbolLayout::SymbolLayout(const BucketParameters& parameters,
                         const char16_t* u16Char = u16String.data();
                         std::u16string subString;
                         auto sectionScale = section.fontScale ? *section.fontScale : 1.0;
-                        auto sectionFontStack = section.fontStack ? *section.fontStack : baseFontStack;
+                        const FontStack& sectionFontStack = section.fontStack ? *section.fontStack : baseFontStack;
+                        const auto sharedFontStack = fontStackInterner.intern(sectionFontStack);
 
                         GlyphIDType subStringtype = getCharGlyphIDType(
                             *u16Char, sectionFontStack, layoutParameters.fontFaces, GlyphIDType::FontPBF);
@@ -214,16 +229,14 @@ SymbolLayout::SymbolLayout(const BucketParameters& parameters,
                                 if (subString.length()) {
                                     ft.formattedText->addTextSection(subString,
                                                                      sectionScale,
-                                                                     sectionFontStack,
+                                                                     sharedFontStack,
                                                                      subStringtype,
                                                                      false,
                                                                      section.textColor);
                                     sectionTable[ft.formattedText->getSections().size() - 1] = sectionIndex;
                                     if (subStringtype != GlyphIDType::FontPBF) {
-                                        layoutParameters.glyphDependencies
-                                            .shapes[section.fontStack ? *section.fontStack : baseFontStack]
-                                                   [subStringtype]
-                                            .insert(subString);
+                                        layoutParameters.glyphDependencies.shapes[sectionFontStack][subStringtype]
+                                        .insert(subString);
                                     }
                                 }
 
@@ -238,16 +251,15 @@ SymbolLayout::SymbolLayout(const BucketParameters& parameters,
 
                         if (subString.length()) {
                             ft.formattedText->addTextSection(subString,
-                                                             section.fontScale ? *section.fontScale : 1.0,
-                                                             section.fontStack ? *section.fontStack : baseFontStack,
+                                                             sectionScale,
+                                                             sharedFontStack,
                                                              subStringtype,
                                                              true,
                                                              section.textColor);
                             sectionTable[ft.formattedText->getSections().size() - 1] = sectionIndex;
                             if (subStringtype != GlyphIDType::FontPBF) {
-                                layoutParameters.glyphDependencies
-                                    .shapes[section.fontStack ? *section.fontStack : baseFontStack][subStringtype]
-                                    .insert(subString);
+                                layoutParameters.glyphDependencies.shapes[sectionFontStack][subStringtype].insert(
+                                    subString);
                             }
                         }
                     } catch (...) {
@@ -344,7 +356,7 @@ void SymbolLayout::finalizeSymbols(HBShapeResults& results) {
                                                     section.keySection,
                                                     section.textColor);
                     } else {
-                        auto& fontstackResults = results[section.fontStack];
+                        auto& fontstackResults = results[*section.fontStack];
                         auto& typeResults = fontstackResults[section.type];
                         auto& result = typeResults[subString];
 
@@ -471,6 +483,69 @@ std::array<float, 2> evaluateRadialOffset(style::SymbolAnchorType anchor, float
     return result;
 }
 
+template <typename T>
+void appendToKey(std::string& key, const T& value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    key.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+// Identifies the result of `getShaping` among the features of one tile, which all share the same
+// glyph and image positions. Text shaped with HarfBuzz carries per-feature adjustments and isn't keyed.
+std::optional<std::string> shapingKey(const TaggedString& text,
+                                      float maxWidth,
+                                      float lineHeight,
+                                      SymbolAnchorType textAnchor,
+                                      TextJustifyType textJustify,
+                                      float spacing,
+                                      const std::array<float, 2>& translate,
+                                      WritingModeType writingMode,
+                                      float layoutTextSize,
+                                      float layoutTextSizeAtBucketZoomLevel) {
+    if (text.hbShaped()) {
+        return std::nullopt;
+    }
+
+    std::string key;
+    const auto& styledText = text.getStyledText();
+    key.reserve(styledText.first.size() * 3 + text.sectionCount() * 48 + 48);
+    appendToKey(key, styledText.first.size());
+    key.append(reinterpret_cast<const char*>(styledText.first.data()), styledText.first.size() * sizeof(char16_t));
+    key.append(reinterpret_cast<const char*>(styledText.second.data()), styledText.second.size());
+
+    for (const auto& section : text.getSections()) {
+        if (section.adjusts) {
+            return std::nullopt;
+        }
+        appendToKey(key, section.scale);
+        appendToKey(key, section.fontStackHash);
+        appendToKey(key, section.type);
+        appendToKey(key, section.startIndex);
+        appendToKey(key, section.keySection);
+        appendToKey(key, section.imageID ? section.imageID->size() + 1 : 0);
+        if (section.imageID) {
+            key.append(*section.imageID);
+        }
+        appendToKey(key, section.textColor.has_value());
+        if (section.textColor) {
+            appendToKey(key, section.textColor->r);
+            appendToKey(key, section.textColor->g);
+            appendToKey(key, section.textColor->b);
+            appendToKey(key, section.textColor->a);
+        }
+    }
+
+    appendToKey(key, maxWidth);
+    appendToKey(key, lineHeight);
+    appendToKey(key, textAnchor);
+    appendToKey(key, textJustify);
+    appendToKey(key, spacing);
+    appendToKey(key, translate);
+    appendToKey(key, writingMode);
+    appendToKey(key, layoutTextSize);
+    appendToKey(key, layoutTextSizeAtBucketZoomLevel);
+    return key;
+}
+
 } // namespace
 
 // static
@@ -519,7 +594,8 @@ std::array<float, 2> SymbolLayout::evaluateVariableOffset(style::SymbolAnchorTyp
     return result;
 }
 
-std::optional<VariableAnchorOffsetCollection> SymbolLayout::getTextVariableAnchorOffset(const SymbolFeature& feature) {
+std::optional<VariableAnchorOffsetCollection> SymbolLayout::getTextVariableAnchorOffset(
+    const SymbolFeature& feature) const {
     std::optional<VariableAnchorOffsetCollection> result;
 
     // If style specifies text-variable-anchor-offset, just return it
@@ -582,231 +658,296 @@ std::optional<VariableAnchorOffsetCollection> SymbolLayout::getTextVariableAncho
     return result;
 }
 
+struct SymbolLayout::PreparedFeature {
+    ShapedTextOrientations shapedTextOrientations;
+    std::optional<PositionedIcon> shapedIcon;
+    std::optional<PositionedIcon> verticallyShapedIcon;
+    std::array<float, 2> textOffset{{0.0f, 0.0f}};
+    float layoutTextSize = 0.0f;
+    float layoutIconSize = 0.0f;
+    SymbolContent iconType = SymbolContent::None;
+    bool iconsNeedLinear = false;
+    // The anchors of the feature's symbol instances, in the order they're added, with the quads they share
+    std::vector<std::pair<Anchor, std::shared_ptr<SymbolInstanceSharedData>>> anchors;
+};
+
 void SymbolLayout::prepareSymbols(const GlyphMap& glyphMap,
                                   const GlyphPositions& glyphPositions,
                                   const ImageMap& imageMap,
                                   const ImagePositions& imagePositions) {
+    MLN_TRACE_FUNC();
+
+    // Features are prepared a block at a time, several chunks of a block in parallel if enabled, and added to the
+    // layout in order once the block is done, so the symbol instances are the same either way
+    constexpr std::size_t blockSize = 1024;
+    constexpr std::size_t chunkSize = 64;
+
+    bool parallel = false;
+    const auto parallelValue = platform::Settings::getInstance().get(platform::EXPERIMENTAL_PARALLEL_SYMBOL_LAYOUT);
+    if (const auto* enabled = parallelValue.getBool()) {
+        parallel = *enabled;
+    }
+
+    // Repeated labels, like road names and house numbers, are shaped once per tile, or once per chunk in parallel
+    Shapings shapings;
+
+    for (std::size_t blockBegin = 0; blockBegin < features.size(); blockBegin += blockSize) {
+        if (isCancelled()) {
+            return;
+        }
+
+        const std::size_t blockEnd = std::min(blockBegin + blockSize, features.size());
+        std::vector<PreparedFeature> prepared(blockEnd - blockBegin);
+        const auto prepare = [&](std::size_t begin, std::size_t end, BiDi& bidi_, Shapings& shapings_) {
+            for (std::size_t i = begin; i < end; ++i) {
+                prepareFeature(features[i],
+                               prepared[i - blockBegin],
+                               bidi_,
+                               shapings_,
+                               glyphMap,
+                               glyphPositions,
+                               imageMap,
+                               imagePositions);
+            }
+        };
+
+        const std::size_t chunkCount = (blockEnd - blockBegin + chunkSize - 1) / chunkSize;
+        if (parallel && chunkCount > 1) {
+            // BiDi objects are confined to one thread. A chunk that throws is rethrown here once the others have
+            // finished with `prepared`, and fails the tile like the serial path.
+            std::vector<BiDi> bidis(chunkCount);
+            std::vector<Shapings> chunkShapings(chunkCount);
+            util::parallelFor(chunkCount, [&](std::size_t chunk) {
+                const std::size_t begin = blockBegin + chunk * chunkSize;
+                prepare(begin, std::min(begin + chunkSize, blockEnd), bidis[chunk], chunkShapings[chunk]);
+            });
+        } else {
+            prepare(blockBegin, blockEnd, bidi, shapings);
+        }
+
+        for (std::size_t i = blockBegin; i < blockEnd; ++i) {
+            auto& preparedFeature = prepared[i - blockBegin];
+            iconsNeedLinear |= preparedFeature.iconsNeedLinear;
+            const Shaping& defaultShaping = getDefaultHorizontalShaping(preparedFeature.shapedTextOrientations);
+            iconsInText |= defaultShaping && defaultShaping.iconsInText;
+            addFeature(i, features[i], preparedFeature);
+            features[i].geometry.clear();
+        }
+    }
+
+    compareText.clear();
+}
+
+void SymbolLayout::prepareFeature(SymbolFeature& feature,
+                                  PreparedFeature& prepared,
+                                  BiDi& bidi_,
+                                  Shapings& shapings,
+                                  const GlyphMap& glyphMap,
+                                  const GlyphPositions& glyphPositions,
+                                  const ImageMap& imageMap,
+                                  const ImagePositions& imagePositions) const {
+    if (feature.geometry.empty()) return;
+
     const bool isPointPlacement = layout->get<SymbolPlacement>() == SymbolPlacementType::Point;
     const bool textAlongLine = layout->get<TextRotationAlignment>() == AlignmentType::Map && !isPointPlacement;
 
-    for (auto it = features.begin(); it != features.end(); ++it) {
-        auto& feature = *it;
-        if (feature.geometry.empty()) continue;
-
-        ShapedTextOrientations shapedTextOrientations;
-        std::optional<PositionedIcon> shapedIcon;
-        std::array<float, 2> textOffset{{0.0f, 0.0f}};
-        const float layoutTextSize = layout->evaluate<TextSize>(zoom + 1, feature, canonicalID);
-        const float layoutTextSizeAtBucketZoomLevel = layout->evaluate<TextSize>(zoom, feature, canonicalID);
-        const float layoutIconSize = layout->evaluate<IconSize>(zoom + 1, feature, canonicalID);
-
-        // if feature has text, shape the text
-        if (feature.formattedText && layoutTextSize > 0.0f) {
-            const float lineHeight = layout->get<TextLineHeight>() * util::ONE_EM;
-            const float spacing = util::i18n::allowsLetterSpacing(feature.formattedText->rawText())
-                                      ? layout->evaluate<TextLetterSpacing>(zoom, feature, canonicalID) * util::ONE_EM
-                                      : 0.0f;
-
-            auto applyShaping = [&](const TaggedString& formattedText,
-                                    WritingModeType writingMode,
-                                    SymbolAnchorType textAnchor,
-                                    TextJustifyType textJustify) {
-                Shaping result = getShaping(
-                    /* string */ formattedText,
-                    /* maxWidth: ems */
-                    isPointPlacement ? layout->evaluate<TextMaxWidth>(zoom, feature, canonicalID) * util::ONE_EM : 0.0f,
-                    /* ems */ lineHeight,
-                    textAnchor,
-                    textJustify,
-                    /* ems */ spacing,
-                    /* translate */ textOffset,
-                    /* writingMode */ writingMode,
-                    /* bidirectional algorithm object */ bidi,
-                    glyphMap,
-                    /* glyphs */ glyphPositions,
-                    /* images */ imagePositions,
-                    layoutTextSize,
-                    layoutTextSizeAtBucketZoomLevel,
-                    allowVerticalPlacement);
-
-                return result;
-            };
-
-            const auto variableAnchorOffsets = getTextVariableAnchorOffset(feature);
-            const SymbolAnchorType textAnchor = layout->evaluate<TextAnchor>(zoom, feature, canonicalID);
-            if (!variableAnchorOffsets || variableAnchorOffsets->empty()) {
-                // Layers with variable anchors use the `text-radial-offset`
-                // property and the [x, y] offset vector is calculated at
-                // placement time instead of layout time
-                const float radialOffset = layout->evaluate<TextRadialOffset>(zoom, feature, canonicalID);
-                if (radialOffset > 0.0f) {
-                    // The style spec says don't use `text-offset` and
-                    // `text-radial-offset` together but doesn't actually
-                    // specify what happens if you use both. We go with the
-                    // radial offset.
-                    textOffset = evaluateRadialOffset(textAnchor, radialOffset * util::ONE_EM);
-                } else {
-                    textOffset = {{layout->evaluate<TextOffset>(zoom, feature, canonicalID)[0] * util::ONE_EM,
-                                   layout->evaluate<TextOffset>(zoom, feature, canonicalID)[1] * util::ONE_EM}};
+    ShapedTextOrientations& shapedTextOrientations = prepared.shapedTextOrientations;
+    std::optional<PositionedIcon>& shapedIcon = prepared.shapedIcon;
+    std::array<float, 2>& textOffset = prepared.textOffset;
+    const float layoutTextSize = layout->evaluate<TextSize>(zoom + 1, feature, canonicalID);
+    const float layoutTextSizeAtBucketZoomLevel = layout->evaluate<TextSize>(zoom, feature, canonicalID);
+    const float layoutIconSize = layout->evaluate<IconSize>(zoom + 1, feature, canonicalID);
+    prepared.layoutTextSize = layoutTextSize;
+    prepared.layoutIconSize = layoutIconSize;
+
+    // if feature has text, shape the text
+    if (feature.formattedText && layoutTextSize > 0.0f) {
+        const float lineHeight = layout->get<TextLineHeight>() * util::ONE_EM;
+        const float spacing = util::i18n::allowsLetterSpacing(feature.formattedText->rawText())
+                                  ? layout->evaluate<TextLetterSpacing>(zoom, feature, canonicalID) * util::ONE_EM
+                                  : 0.0f;
+
+        auto applyShaping = [&](const TaggedString& formattedText,
+                                WritingModeType writingMode,
+                                SymbolAnchorType textAnchor,
+                                TextJustifyType textJustify) {
+            const float maxWidth = isPointPlacement
+                                       ? layout->evaluate<TextMaxWidth>(zoom, feature, canonicalID) * util::ONE_EM
+                                       : 0.0f;
+            auto key = shapingKey(formattedText,
+                                  maxWidth,
+                                  lineHeight,
+                                  textAnchor,
+                                  textJustify,
+                                  spacing,
+                                  textOffset,
+                                  writingMode,
+                                  layoutTextSize,
+                                  layoutTextSizeAtBucketZoomLevel);
+            if (key) {
+                if (const auto cached = shapings.find(*key); cached != shapings.end()) {
+                    return cached->second;
                 }
             }
-            TextJustifyType textJustify = textAlongLine ? TextJustifyType::Center
-                                                        : layout->evaluate<TextJustify>(zoom, feature, canonicalID);
-
-            const auto addVerticalShapingForPointLabelIfNeeded = [&] {
-                if (allowVerticalPlacement && feature.formattedText->allowsVerticalWritingMode()) {
-                    feature.formattedText->verticalizePunctuation();
-                    // Vertical POI label placement is meant to be used for
-                    // scripts that support vertical writing mode, thus, default
-                    // style::TextJustifyType::Left justification is used. If
-                    // Latin scripts would need to be supported, this should
-                    // take into account other justifications.
-                    shapedTextOrientations.vertical = applyShaping(
-                        *feature.formattedText, WritingModeType::Vertical, textAnchor, style::TextJustifyType::Left);
-                }
-            };
 
-            // If this layer uses text-variable-anchor, generate shapings for
-            // all justification possibilities.
-            if (!textAlongLine && variableAnchorOffsets && !variableAnchorOffsets->empty()) {
-                std::vector<TextJustifyType> justifications;
-                if (textJustify != TextJustifyType::Auto) {
-                    justifications.push_back(textJustify);
-                } else {
-                    for (const auto& anchorOffset : *variableAnchorOffsets) {
-                        justifications.push_back(getAnchorJustification(anchorOffset.anchorType));
-                    }
-                }
-                for (TextJustifyType justification : justifications) {
-                    Shaping& shapingForJustification = shapingForTextJustifyType(shapedTextOrientations, justification);
-                    if (shapingForJustification) {
-                        continue;
-                    }
-                    // If using text-variable-anchor for the layer, we use a
-                    // center anchor for all shapings and apply the offsets for
-                    // the anchor in the placement step.
-                    Shaping shaping = applyShaping(
-                        *feature.formattedText, WritingModeType::Horizontal, SymbolAnchorType::Center, justification);
-                    if (shaping) {
-                        shapingForJustification = std::move(shaping);
-                        if (shapingForJustification.positionedLines.size() == 1u) {
-                            shapedTextOrientations.singleLine = true;
-                            break;
-                        }
-                    }
-                }
+            Shaping result = getShaping(
+                /* string */ formattedText,
+                /* maxWidth: ems */ maxWidth,
+                /* ems */ lineHeight,
+                textAnchor,
+                textJustify,
+                /* ems */ spacing,
+                /* translate */ textOffset,
+                /* writingMode */ writingMode,
+                /* bidirectional algorithm object */ bidi_,
+                glyphMap,
+                /* glyphs */ glyphPositions,
+                /* images */ imagePositions,
+                layoutTextSize,
+                layoutTextSizeAtBucketZoomLevel,
+                allowVerticalPlacement);
+
+            if (key) {
+                shapings.emplace(std::move(*key), result);
+            }
+            return result;
+        };
 
-                // Vertical point label shaping if allowVerticalPlacement is enabled.
-                addVerticalShapingForPointLabelIfNeeded();
+        const auto variableAnchorOffsets = getTextVariableAnchorOffset(feature);
+        const SymbolAnchorType textAnchor = layout->evaluate<TextAnchor>(zoom, feature, canonicalID);
+        if (!variableAnchorOffsets || variableAnchorOffsets->empty()) {
+            // Layers with variable anchors use the `text-radial-offset`
+            // property and the [x, y] offset vector is calculated at
+            // placement time instead of layout time
+            const float radialOffset = layout->evaluate<TextRadialOffset>(zoom, feature, canonicalID);
+            if (radialOffset > 0.0f) {
+                // The style spec says don't use `text-offset` and
+                // `text-radial-offset` together but doesn't actually
+                // specify what happens if you use both. We go with the
+                // radial offset.
+                textOffset = evaluateRadialOffset(textAnchor, radialOffset * util::ONE_EM);
             } else {
-                if (textJustify == TextJustifyType::Auto) {
-                    textJustify = getAnchorJustification(textAnchor);
-                }
+                textOffset = {{layout->evaluate<TextOffset>(zoom, feature, canonicalID)[0] * util::ONE_EM,
+                               layout->evaluate<TextOffset>(zoom, feature, canonicalID)[1] * util::ONE_EM}};
+            }
+        }
+        TextJustifyType textJustify = textAlongLine ? TextJustifyType::Center
+                                                    : layout->evaluate<TextJustify>(zoom, feature, canonicalID);
+
+        const auto addVerticalShapingForPointLabelIfNeeded = [&] {
+            if (allowVerticalPlacement && feature.formattedText->allowsVerticalWritingMode()) {
+                feature.formattedText->verticalizePunctuation();
+                // Vertical POI label placement is meant to be used for
+                // scripts that support vertical writing mode, thus, default
+                // style::TextJustifyType::Left justification is used. If
+                // Latin scripts would need to be supported, this should
+                // take into account other justifications.
+                shapedTextOrientations.vertical = applyShaping(
+                    *feature.formattedText, WritingModeType::Vertical, textAnchor, style::TextJustifyType::Left);
+            }
+        };
 
-                // Horizontal point or line label.
+        // If this layer uses text-variable-anchor, generate shapings for
+        // all justification possibilities.
+        if (!textAlongLine && variableAnchorOffsets && !variableAnchorOffsets->empty()) {
+            std::vector<TextJustifyType> justifications;
+            if (textJustify != TextJustifyType::Auto) {
+                justifications.push_back(textJustify);
+            } else {
+                for (const auto& anchorOffset : *variableAnchorOffsets) {
+                    justifications.push_back(getAnchorJustification(anchorOffset.anchorType));
+                }
+            }
+            for (TextJustifyType justification : justifications) {
+                Shaping& shapingForJustification = shapingForTextJustifyType(shapedTextOrientations, justification);
+                if (shapingForJustification) {
+                    continue;
+                }
+                // If using text-variable-anchor for the layer, we use a
+                // center anchor for all shapings and apply the offsets for
+                // the anchor in the placement step.
                 Shaping shaping = applyShaping(
-                    *feature.formattedText, WritingModeType::Horizontal, textAnchor, textJustify);
+                    *feature.formattedText, WritingModeType::Horizontal, SymbolAnchorType::Center, justification);
                 if (shaping) {
-                    shapedTextOrientations.horizontal = std::move(shaping);
+                    shapingForJustification = std::move(shaping);
+                    if (shapingForJustification.positionedLines.size() == 1u) {
+                        shapedTextOrientations.singleLine = true;
+                        break;
+                    }
                 }
+            }
 
-                // Vertical point label shaping if allowVerticalPlacement is enabled.
-                addVerticalShapingForPointLabelIfNeeded();
+            // Vertical point label shaping if allowVerticalPlacement is enabled.
+            addVerticalShapingForPointLabelIfNeeded();
+        } else {
+            if (textJustify == TextJustifyType::Auto) {
+                textJustify = getAnchorJustification(textAnchor);
+            }
 
-                // Verticalized line label.
-                if (textAlongLine && feature.formattedText->allowsVerticalWritingMode()) {
-                    feature.formattedText->verticalizePunctuation();
-                    shapedTextOrientations.vertical = applyShaping(
-                        *feature.formattedText, WritingModeType::Vertical, textAnchor, textJustify);
-                }
+            // Horizontal point or line label.
+            Shaping shaping = applyShaping(
+                *feature.formattedText, WritingModeType::Horizontal, textAnchor, textJustify);
+            if (shaping) {
+                shapedTextOrientations.horizontal = std::move(shaping);
             }
-        }
 
-        // if feature has icon, get sprite atlas position
-        SymbolContent iconType{SymbolContent::None};
-        if (feature.icon) {
-            auto image = imageMap.find(feature.icon->id());
-            if (image != imageMap.end()) {
-                iconType = SymbolContent::IconRGBA;
-                shapedIcon = PositionedIcon::shapeIcon(imagePositions.at(feature.icon->id()),
-                                                       layout->evaluate<IconOffset>(zoom, feature, canonicalID),
-                                                       layout->evaluate<IconAnchor>(zoom, feature, canonicalID));
-                if (image->second->sdf) {
-                    iconType = SymbolContent::IconSDF;
-                }
-                if (image->second->pixelRatio != pixelRatio) {
-                    iconsNeedLinear = true;
-                } else if (layout->get<IconRotate>().constantOr(1) != 0) {
-                    iconsNeedLinear = true;
-                }
+            // Vertical point label shaping if allowVerticalPlacement is enabled.
+            addVerticalShapingForPointLabelIfNeeded();
+
+            // Verticalized line label.
+            if (textAlongLine && feature.formattedText->allowsVerticalWritingMode()) {
+                feature.formattedText->verticalizePunctuation();
+                shapedTextOrientations.vertical = applyShaping(
+                    *feature.formattedText, WritingModeType::Vertical, textAnchor, textJustify);
             }
         }
+    }
 
-        // if either shapedText or icon position is present, add the feature
-        const Shaping& defaultShaping = getDefaultHorizontalShaping(shapedTextOrientations);
-        iconsInText |= defaultShaping && defaultShaping.iconsInText;
-        if (defaultShaping || shapedIcon) {
-            addFeature(std::distance(features.begin(), it),
-                       feature,
-                       shapedTextOrientations,
-                       std::move(shapedIcon),
-                       imageMap,
-                       textOffset,
-                       layoutTextSize,
-                       layoutIconSize,
-                       iconType);
+    // if feature has icon, get sprite atlas position
+    SymbolContent& iconType = prepared.iconType;
+    if (feature.icon) {
+        auto image = imageMap.find(feature.icon->id());
+        if (image != imageMap.end()) {
+            iconType = SymbolContent::IconRGBA;
+            shapedIcon = PositionedIcon::shapeIcon(imagePositions.at(feature.icon->id()),
+                                                   layout->evaluate<IconOffset>(zoom, feature, canonicalID),
+                                                   layout->evaluate<IconAnchor>(zoom, feature, canonicalID));
+            if (image->second->sdf) {
+                iconType = SymbolContent::IconSDF;
+            }
+            if (image->second->pixelRatio != pixelRatio) {
+                prepared.iconsNeedLinear = true;
+            } else if (layout->get<IconRotate>().constantOr(1) != 0) {
+                prepared.iconsNeedLinear = true;
+            }
         }
-
-        feature.geometry.clear();
     }
 
-    compareText.clear();
-}
+    // if either shapedText or icon position is present, the feature gets symbols
+    if (!getDefaultHorizontalShaping(shapedTextOrientations) && !shapedIcon) return;
 
-void SymbolLayout::addFeature(const std::size_t layoutFeatureIndex,
-                              const SymbolFeature& feature,
-                              const ShapedTextOrientations& shapedTextOrientations,
-                              std::optional<PositionedIcon> shapedIcon,
-                              const ImageMap& imageMap,
-                              std::array<float, 2> textOffset,
-                              float layoutTextSize,
-                              float layoutIconSize,
-                              const SymbolContent iconType) {
-    const float minScale = 0.5f;
     const float glyphSize = 24.0f;
-
+    const float minScale = 0.5f;
     const std::array<float, 2> iconOffset = layout->evaluate<IconOffset>(zoom, feature, canonicalID);
-
+    const float fontScale = layoutTextSize / glyphSize;
     // To reduce the number of labels that jump around when zooming we need
     // to use a text-size value that is the same for all zoom levels.
     // This calculates text-size at a high zoom level so that all tiles can
     // use the same value when calculating anchor positions.
     const float textMaxSize = layout->evaluate<TextSize>(18, feature, canonicalID);
-
-    const float fontScale = layoutTextSize / glyphSize;
-    const float textBoxScale = tilePixelRatio * fontScale;
     const float textMaxBoxScale = tilePixelRatio * textMaxSize / glyphSize;
-    const float iconBoxScale = tilePixelRatio * layoutIconSize;
     const float symbolSpacing = tilePixelRatio * layout->get<SymbolSpacing>();
-    const float textPadding = layout->get<TextPadding>() * tilePixelRatio;
-    const Padding iconPadding = layout->evaluate<IconPadding>(zoom, feature, canonicalID) * tilePixelRatio;
     const float textMaxAngle = util::deg2radf(layout->get<TextMaxAngle>());
     const float iconRotation = layout->evaluate<IconRotate>(zoom, feature, canonicalID);
-    const float textRotation = layout->evaluate<TextRotate>(zoom, feature, canonicalID);
-    const auto variableAnchorOffsets = getTextVariableAnchorOffset(feature);
-
     const SymbolPlacementType textPlacement = layout->get<TextRotationAlignment>() != AlignmentType::Map
                                                   ? SymbolPlacementType::Point
                                                   : layout->get<SymbolPlacement>();
-
-    const float textRepeatDistance = symbolSpacing / 2;
     const auto evaluatedLayoutProperties = layout->evaluate(zoom, feature);
-    IndexedSubfeature indexedFeature(feature.index, sourceLayer->getName(), bucketLeaderID, symbolInstances.size());
 
     const auto iconTextFit = evaluatedLayoutProperties.get<style::IconTextFit>();
     const bool hasIconTextFit = iconTextFit != IconTextFitType::None;
     // Adjust shaped icon size when icon-text-fit is used.
-    std::optional<PositionedIcon> verticallyShapedIcon;
+    std::optional<PositionedIcon>& verticallyShapedIcon = prepared.verticallyShapedIcon;
     if (shapedIcon && hasIconTextFit) {
         // Create vertically shaped icon for vertical writing mode if needed.
         if (allowVerticalPlacement && shapedTextOrientations.vertical) {
@@ -821,50 +962,6 @@ void SymbolLayout::addFeature(const std::size_t layoutFeatureIndex,
         }
     }
 
-    auto addSymbolInstance = [&](Anchor& anchor, std::shared_ptr<SymbolInstanceSharedData> sharedData) {
-        assert(sharedData);
-        const bool anchorInsideTile = anchor.point.x >= 0 && anchor.point.x < util::EXTENT && anchor.point.y >= 0 &&
-                                      anchor.point.y < util::EXTENT;
-
-        if (mode == MapMode::Tile || anchorInsideTile) {
-            // For static/continuous rendering, only add symbols anchored within this tile:
-            //  neighboring symbols will be added as part of the neighboring tiles.
-            // In tiled rendering mode, add all symbols in the buffers so that we can:
-            //  (1) render symbols that overlap into this tile
-            //  (2) approximate collision detection effects from neighboring symbols
-            symbolInstances.emplace_back(anchor,
-                                         std::move(sharedData),
-                                         shapedTextOrientations,
-                                         shapedIcon,
-                                         verticallyShapedIcon,
-                                         textBoxScale,
-                                         textPadding,
-                                         textPlacement,
-                                         textOffset,
-                                         iconBoxScale,
-                                         iconPadding,
-                                         iconOffset,
-                                         indexedFeature,
-                                         layoutFeatureIndex,
-                                         feature.index,
-                                         feature.formattedText ? feature.formattedText->rawText() : std::u16string(),
-                                         overscaling,
-                                         iconRotation,
-                                         textRotation,
-                                         variableAnchorOffsets,
-                                         allowVerticalPlacement,
-                                         iconType);
-
-            if (sortFeaturesByKey) {
-                if (!sortKeyRanges.empty() && sortKeyRanges.back().sortKey == feature.sortKey) {
-                    sortKeyRanges.back().end = symbolInstances.size();
-                } else {
-                    sortKeyRanges.push_back({feature.sortKey, symbolInstances.size() - 1, symbolInstances.size()});
-                }
-            }
-        }
-    };
-
     const auto createSymbolInstanceSharedData = [&](GeometryCoordinates line) {
         return std::make_shared<SymbolInstanceSharedData>(std::move(line),
                                                           shapedTextOrientations,
@@ -880,12 +977,13 @@ void SymbolLayout::addFeature(const std::size_t layoutFeatureIndex,
                                                           allowVerticalPlacement);
     };
 
+    auto& anchors = prepared.anchors;
     const auto& type = feature.getType();
 
     if (layout->get<SymbolPlacement>() == SymbolPlacementType::Line) {
         auto clippedLines = util::clipLines(feature.geometry, 0, 0, util::EXTENT, util::EXTENT);
         for (auto& line : clippedLines) {
-            Anchors anchors = getAnchors(
+            Anchors lineAnchors = getAnchors(
                 line,
                 symbolSpacing,
                 textMaxAngle,
@@ -901,11 +999,8 @@ void SymbolLayout::addFeature(const std::size_t layoutFeatureIndex,
                 textMaxBoxScale,
                 overscaling);
             auto sharedData = createSymbolInstanceSharedData(std::move(line));
-            for (auto& anchor : anchors) {
-                if (!feature.formattedText ||
-                    !anchorIsTooClose(feature.formattedText->rawText(), textRepeatDistance, anchor)) {
-                    addSymbolInstance(anchor, sharedData);
-                }
+            for (auto& anchor : lineAnchors) {
+                anchors.emplace_back(anchor, sharedData);
             }
         }
     } else if (layout->get<SymbolPlacement>() == SymbolPlacementType::LineCenter) {
@@ -927,12 +1022,12 @@ void SymbolLayout::addFeature(const std::size_t layoutFeatureIndex,
                     glyphSize,
                     textMaxBoxScale);
                 if (anchor) {
-                    addSymbolInstance(*anchor, createSymbolInstanceSharedData(line));
+                    anchors.emplace_back(*anchor, createSymbolInstanceSharedData(line));
                 }
             }
         }
     } else if (type == FeatureType::Polygon) {
-        for (const auto& polygon : classifyRings(feature.geometry)) {
+        for (const auto& polygon : classifyRingRefs(feature.geometry)) {
             Polygon<double> poly;
             for (const auto& ring : polygon) {
                 LinearRing<double> r;
@@ -945,7 +1040,7 @@ void SymbolLayout::addFeature(const std::size_t layoutFeatureIndex,
             // 1 pixel worth of precision, in tile coordinates
             auto poi = mapbox::polylabel(poly, util::EXTENT / util::tileSize_D);
             Anchor anchor(static_cast<float>(poi.x), static_cast<float>(poi.y), 0.0f, static_cast<size_t>(minScale));
-            addSymbolInstance(anchor, createSymbolInstanceSharedData(polygon[0]));
+            anchors.emplace_back(anchor, createSymbolInstanceSharedData(polygon[0]));
         }
     } else if (type == FeatureType::LineString) {
         for (const auto& line : feature.geometry) {
@@ -954,14 +1049,90 @@ void SymbolLayout::addFeature(const std::size_t layoutFeatureIndex,
 
             Anchor anchor(
                 static_cast<float>(line[0].x), static_cast<float>(line[0].y), 0.0f, static_cast<size_t>(minScale));
-            addSymbolInstance(anchor, createSymbolInstanceSharedData(line));
+            anchors.emplace_back(anchor, createSymbolInstanceSharedData(line));
         }
     } else if (type == FeatureType::Point) {
         for (const auto& points : feature.geometry) {
             for (const auto& point : points) {
                 Anchor anchor(
                     static_cast<float>(point.x), static_cast<float>(point.y), 0.0f, static_cast<size_t>(minScale));
-                addSymbolInstance(anchor, createSymbolInstanceSharedData({point}));
+                anchors.emplace_back(anchor, createSymbolInstanceSharedData({point}));
+            }
+        }
+    }
+}
+
+void SymbolLayout::addFeature(const std::size_t layoutFeatureIndex,
+                              const SymbolFeature& feature,
+                              PreparedFeature& prepared) {
+    if (prepared.anchors.empty()) return;
+
+    const float glyphSize = 24.0f;
+
+    const std::array<float, 2> iconOffset = layout->evaluate<IconOffset>(zoom, feature, canonicalID);
+    const float fontScale = prepared.layoutTextSize / glyphSize;
+    const float textBoxScale = tilePixelRatio * fontScale;
+    const float iconBoxScale = tilePixelRatio * prepared.layoutIconSize;
+    const float symbolSpacing = tilePixelRatio * layout->get<SymbolSpacing>();
+    const float textPadding = layout->get<TextPadding>() * tilePixelRatio;
+    const Padding iconPadding = layout->evaluate<IconPadding>(zoom, feature, canonicalID) * tilePixelRatio;
+    const float iconRotation = layout->evaluate<IconRotate>(zoom, feature, canonicalID);
+    const float textRotation = layout->evaluate<TextRotate>(zoom, feature, canonicalID);
+    const auto variableAnchorOffsets = getTextVariableAnchorOffset(feature);
+
+    const SymbolPlacementType textPlacement = layout->get<TextRotationAlignment>() != AlignmentType::Map
+                                                  ? SymbolPlacementType::Point
+                                                  : layout->get<SymbolPlacement>();
+
+    const float textRepeatDistance = symbolSpacing / 2;
+    IndexedSubfeature indexedFeature(feature.index, sourceLayer->getName(), bucketLeaderID, symbolInstances.size());
+    // Line labels repeat along the line, but not too close to the same label
+    const bool checkRepeatDistance = layout->get<SymbolPlacement>() == SymbolPlacementType::Line &&
+                                     feature.formattedText;
+
+    for (auto& [anchor, sharedData] : prepared.anchors) {
+        assert(sharedData);
+        if (checkRepeatDistance && anchorIsTooClose(feature.formattedText->rawText(), textRepeatDistance, anchor)) {
+            continue;
+        }
+
+        const bool anchorInsideTile = anchor.point.x >= 0 && anchor.point.x < util::EXTENT && anchor.point.y >= 0 &&
+                                      anchor.point.y < util::EXTENT;
+        if (mode == MapMode::Tile || anchorInsideTile) {
+            // For static/continuous rendering, only add symbols anchored within this tile:
+            //  neighboring symbols will be added as part of the neighboring tiles.
+            // In tiled rendering mode, add all symbols in the buffers so that we can:
+            //  (1) render symbols that overlap into this tile
+            //  (2) approximate collision detection effects from neighboring symbols
+            symbolInstances.emplace_back(anchor,
+                                         std::move(sharedData),
+                                         prepared.shapedTextOrientations,
+                                         prepared.shapedIcon,
+                                         prepared.verticallyShapedIcon,
+                                         textBoxScale,
+                                         textPadding,
+                                         textPlacement,
+                                         prepared.textOffset,
+                                         iconBoxScale,
+                                         iconPadding,
+                                         iconOffset,
+                                         indexedFeature,
+                                         layoutFeatureIndex,
+                                         feature.index,
+                                         feature.formattedText ? feature.formattedText->rawText() : std::u16string(),
+                                         overscaling,
+                                         iconRotation,
+                                         textRotation,
+                                         variableAnchorOffsets,
+                                         allowVerticalPlacement,
+                                         prepared.iconType);
+
+            if (sortFeaturesByKey) {
+                if (!sortKeyRanges.empty() && sortKeyRanges.back().sortKey == feature.sortKey) {
+                    sortKeyRanges.back().end = symbolInstances.size();
+                } else {
+                    sortKeyRanges.push_back({feature.sortKey, symbolInstances.size() - 1, symbolInstances.size()});
+                }
             }
         }
     }
@@ -10,8 +10,11 @@
 #include <mbgl/renderer/buckets/symbol_bucket.hpp>
 #include <mbgl/util/containers.hpp>
 
+#include <atomic>
 #include <memory>
 #include <map>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace mbgl {
@@ -72,15 +75,24 @@ public:
     static std::vector<float> calculateTileDistances(const GeometryCoordinates& line, const Anchor& anchor);
 
 private:
-    void addFeature(size_t,
-                    const SymbolFeature&,
-                    const ShapedTextOrientations& shapedTextOrientations,
-                    std::optional<PositionedIcon> shapedIcon,
-                    const ImageMap&,
-                    std::array<float, 2> textOffset,
-                    float layoutTextSize,
-                    float layoutIconSize,
-                    SymbolContent iconType);
+    // What a feature needs to be added to the layout, computed on any thread
+    struct PreparedFeature;
+    using Shapings = std::unordered_map<std::string, Shaping>;
+
+    // Shapes the feature's text and icon and finds its anchors. Only writes to the feature and the given objects,
+    // so features can be prepared in parallel.
+    void prepareFeature(SymbolFeature&,
+                        PreparedFeature&,
+                        BiDi&,
+                        Shapings&,
+                        const GlyphMap&,
+                        const GlyphPositions&,
+                        const ImageMap&,
+                        const ImagePositions&) const;
+    // Adds the symbol instances of a prepared feature, in feature order
+    void addFeature(size_t, const SymbolFeature&, PreparedFeature&);
+
+    bool isCancelled() const { return cancelled && cancelled->load(std::memory_order_relaxed); }
 
     bool anchorIsTooClose(const std::u16string& text, float repeatDistance, const Anchor&);
     std::map<std::u16string, std::vector<Anchor>> compareText;
@@ -119,7 +131,7 @@ private:
 
     // Helper to support both text-variable-anchor and text-variable-anchor-offset.
     // Offset values converted from EMs to PXs.
-    std::optional<VariableAnchorOffsetCollection> getTextVariableAnchorOffset(const SymbolFeature&);
+    std::optional<VariableAnchorOffsetCollection> getTextVariableAnchorOffset(const SymbolFeature&) const;
 
     // Stores the layer so that we can hold on to GeometryTileFeature instances
     // in SymbolFeature, which may reference data from this object.
@@ -129,6 +141,7 @@ private:
     const CanonicalTileID canonicalID;
     const MapMode mode;
     const float pixelRatio;
+    const std::atomic<bool>* cancelled;
 
     const uint32_t tileSize;
     const float tilePixelRatio;
@@ -146,6 +159,8 @@ private:
     style::TextVariableAnchorOffset::UnevaluatedType textVariableAnchorOffset;
     Immutable<style::SymbolLayoutProperties::PossiblyEvaluated> layout;
     std::vector<SymbolFeature> features;
+    /// The font stacks the text sections of the features share
+    FontStackInterner fontStackInterner;
 
     BiDi bidi; // Consider moving this up to geometry tile worker to reduce
                // reinstantiation costs; use of BiDi/ubiditransform object must
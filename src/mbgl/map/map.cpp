@@ -505,6 +505,30 @@ void Map::removeAnnotation(AnnotationID annotation) {
     }
 }
 
+AnnotationIDs Map::addAnnotations(const std::vector<Annotation>& annotations) {
+    if (LayerManager::annotationsEnabled) {
+        auto result = impl->annotationManager.addAnnotations(annotations);
+        impl->onUpdate();
+        return result;
+    }
+    return {};
+}
+
+void Map::updateAnnotations(const std::vector<std::pair<AnnotationID, Annotation>>& annotations) {
+    if (LayerManager::annotationsEnabled) {
+        if (impl->annotationManager.updateAnnotations(annotations)) {
+            impl->onUpdate();
+        }
+    }
+}
+
+void Map::removeAnnotations(const AnnotationIDs& annotations) {
+    if (LayerManager::annotationsEnabled) {
+        impl->annotationManager.removeAnnotations(annotations);
+        impl->onUpdate();
+    }
+}
+
 // MARK: - Toggles
 
 void Map::setDebug(MapDebugOptions debugOptions) {
@@ -596,6 +620,22 @@ TileLodMode Map::getTileLodMode() const {
     return impl->tileLodMode;
 }
 
+void Map::setTileLodMaxTiles(std::size_t maxTiles) {
+    impl->tileLodMaxTiles = maxTiles;
+}
+
+std::size_t Map::getTileLodMaxTiles() const {
+    return impl->tileLodMaxTiles;
+}
+
+void Map::setTileUploadBudget(std::size_t bytes) {
+    impl->tileUploadBudget = bytes;
+}
+
+std::size_t Map::getTileUploadBudget() const {
+    return impl->tileUploadBudget;
+}
+
 ClientOptions Map::getClientOptions() const {
     return impl->fileSource ? impl->fileSource->getClientOptions() : ClientOptions();
 }
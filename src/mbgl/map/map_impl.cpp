@@ -119,6 +119,7 @@ void Map::Impl::onUpdate() {
                                .debugOptions = debugOptions,
                                .timePoint = timePoint,
                                .transformState = transform.getState(),
+                               .transitionTargetState = transform.getTransitionTargetState(),
                                .glyphURL = style->impl->getGlyphURL(),
                                .fontFaces = style->impl->getFontFaces(),
                                .spriteLoaded = style->impl->areSpritesLoaded(),
@@ -127,6 +128,8 @@ void Map::Impl::onUpdate() {
                                .images = style->impl->getImageImpls(),
                                .sources = style->impl->getSourceImpls(),
                                .layers = style->impl->getLayerImpls(),
+                               .sourceJournal = style->impl->takeSourceJournal(),
+                               .layerJournal = style->impl->takeLayerJournal(),
                                .annotationManager = annotationManager.makeWeakPtr(),
                                .fileSource = fileSource,
                                .prefetchZoomDelta = prefetchZoomDelta,
@@ -136,7 +139,9 @@ void Map::Impl::onUpdate() {
                                .tileLodScale = tileLodScale,
                                .tileLodPitchThreshold = tileLodPitchThreshold,
                                .tileLodZoomShift = tileLodZoomShift,
-                               .tileLodMode = tileLodMode};
+                               .tileLodMode = tileLodMode,
+                               .tileLodMaxTiles = tileLodMaxTiles,
+                               .tileUploadBudget = tileUploadBudget};
 
     rendererFrontend.update(std::make_shared<UpdateParameters>(std::move(params)));
 }
@@ -428,6 +433,10 @@ void Map::Impl::onTileAction(TileOperation op, const OverscaledTileID& id, const
     }
 }
 
+void Map::Impl::onTileLatencies(const std::string& sourceID, const TileLatencies& latencies) {
+    observer.onTileLatencies(sourceID, latencies);
+}
+
 void Map::Impl::onRenderError(std::exception_ptr error) {
     observer.onRenderError(error);
 }
@@ -74,6 +74,7 @@ public:
     void onGlyphsError(const FontStack&, const GlyphRange&, std::exception_ptr) final;
     void onGlyphsRequested(const FontStack&, const GlyphRange&) final;
     void onTileAction(TileOperation op, const OverscaledTileID&, const std::string&) final;
+    void onTileLatencies(const std::string& sourceID, const TileLatencies&) final;
     void onRenderError(std::exception_ptr) final;
 
     // Map
@@ -113,6 +114,8 @@ public:
     double tileLodPitchThreshold = (60.0 / 180.0) * std::numbers::pi;
     double tileLodZoomShift = 0;
     TileLodMode tileLodMode = TileLodMode::Default;
+    std::size_t tileLodMaxTiles = 0;
+    std::size_t tileUploadBudget = 0;
 };
 
 // Forward declaration of this method is required for the MapProjection class
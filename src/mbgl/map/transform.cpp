@@ -590,6 +590,16 @@ void Transform::startTransition(const CameraOptions& camera,
         anchorLatLng = state.screenCoordinateToLatLng(*anchor);
     }
 
+    if (isAnimated) {
+        // Play the last frame on the side so that the destination is known up front, which lets
+        // the renderer request its tiles while the camera is still on the way.
+        const TransformState current = state;
+        frame(1.0);
+        if (anchor) state.moveLatLng(anchorLatLng, *anchor);
+        transitionTargetState = state;
+        state = current;
+    }
+
     transitionStart = Clock::now();
     transitionDuration = duration;
 
@@ -618,6 +628,7 @@ void Transform::startTransition(const CameraOptions& camera,
     };
 
     transitionFinishFn = [isAnimated, animation, this] {
+        transitionTargetState.reset();
         state.setProperties(
             TransformStateProperties().withPanningInProgress(false).withScalingInProgress(false).withRotatingInProgress(
                 false));
@@ -116,6 +116,8 @@ public:
     TimePoint getTransitionStart() const { return transitionStart; }
     Duration getTransitionDuration() const { return transitionDuration; }
     void cancelTransitions();
+    /// Where the camera ends up once the animated transition in progress finishes, if any
+    const std::optional<TransformState>& getTransitionTargetState() const { return transitionTargetState; }
 
     // Gesture
     void setGestureInProgress(bool);
@@ -154,6 +156,7 @@ private:
     Duration transitionDuration;
     std::function<bool(const TimePoint)> transitionFrameFn;
     std::function<void()> transitionFinishFn;
+    std::optional<TransformState> transitionTargetState;
 };
 
 } // namespace mbgl
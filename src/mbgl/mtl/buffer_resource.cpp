@@ -39,9 +39,7 @@ BufferResource::BufferResource(Context& context_,
         }
         assert(raw.size() == size);
     } else {
-        auto& device = context.getBackend().getDevice();
-        buffer = NS::TransferPtr((data && size) ? device->newBuffer(data, size, usage)
-                                                : device->newBuffer(size, usage));
+        buffer = context.createMetalBuffer(data, size, usage);
 
         if (!buffer) {
             throw std::bad_alloc();
@@ -118,7 +116,6 @@ void BufferResource::update(const void* newData, std::size_t updateSize, std::si
             }
         }
 
-        auto& device = context.getBackend().getDevice();
         // `[MTLBuffer contents]` may involve memory mapping and/or synchronization.  If the entire
         // buffer is being replaced, avoid accessing the old one by creating the new buffer directly
         // from the given data. If it's just being updated, apply the update to a local buffer to
@@ -138,7 +135,7 @@ void BufferResource::update(const void* newData, std::size_t updateSize, std::si
         }
 
         if (newBufferSource) {
-            auto newBuffer = NS::TransferPtr(device->newBuffer(newBufferSource, size, usage));
+            auto newBuffer = context.createMetalBuffer(newBufferSource, size, usage);
             if (!newBuffer) {
                 throw std::bad_alloc();
             }
@@ -31,6 +31,7 @@
 
 #include <algorithm>
 #include <cstring>
+#include <utility>
 
 namespace mbgl {
 namespace mtl {
@@ -39,11 +40,18 @@ namespace mtl {
 // 31 for Apple2-8, Mac2, per https://developer.apple.com/metal/Metal-Feature-Set-Tables.pdf
 constexpr uint32_t maximumVertexBindingCount = 31;
 
+namespace {
+// Small resources are sub-allocated from heaps of this size, larger ones getting their own allocation
+constexpr NS::UInteger heapSize = 4 * 1024 * 1024;
+constexpr NS::UInteger maxHeapResourceSize = heapSize / 4;
+} // namespace
+
 Context::Context(RendererBackend& backend_)
     : gfx::Context(mtl::maximumVertexBindingCount),
       backend(backend_) {}
 
 Context::~Context() noexcept {
+    clearOffscreenTexturePool();
     if (cleanupOnDestruction) {
         backend.getThreadPool().runRenderJobs(true /* closeQueue */);
         performCleanup();
@@ -69,7 +77,7 @@ Context::~Context() noexcept {
 }
 
 void Context::beginFrame() {
-    backend.getThreadPool().runRenderJobs();
+    backend.runRenderJobs();
 }
 
 void Context::endFrame() {}
@@ -185,8 +193,92 @@ UniqueShaderProgram Context::createProgram(shaders::BuiltIn shaderID,
     return shader;
 }
 
-MTLTexturePtr Context::createMetalTexture(MTLTextureDescriptorPtr textureDescriptor) const {
-    return NS::TransferPtr(backend.getDevice()->newTexture(textureDescriptor.get()));
+template <typename Resource, typename Allocate>
+NS::SharedPtr<Resource> Context::allocateFromHeap(HeapPool& pool,
+                                                  std::size_t size,
+                                                  std::size_t alignment,
+                                                  Allocate&& allocate) {
+    // Resources are created from any thread
+    std::scoped_lock lock(pool.mutex);
+    for (const auto& heap : pool.heaps) {
+        if (heap->maxAvailableSize(alignment) >= size) {
+            if (auto resource = NS::TransferPtr(allocate(heap.get()))) {
+                threadSafeAccessRenderingStats([](gfx::RenderingStats& stats) { stats.numHeapAllocations++; });
+                return resource;
+            }
+        }
+    }
+
+    auto descriptor = NS::TransferPtr(MTL::HeapDescriptor::alloc()->init());
+    descriptor->setSize(heapSize);
+    descriptor->setStorageMode(MTL::StorageModeShared);
+    descriptor->setType(MTL::HeapTypeAutomatic);
+    // Resources of heaps aren't tracked by default, while the rest of the renderer relies on Metal tracking them
+    descriptor->setHazardTrackingMode(MTL::HazardTrackingModeTracked);
+    auto heap = NS::TransferPtr(backend.getDevice()->newHeap(descriptor.get()));
+    if (!heap) {
+        return {};
+    }
+    auto resource = NS::TransferPtr(allocate(heap.get()));
+    pool.heaps.push_back(std::move(heap));
+    threadSafeAccessRenderingStats([&](gfx::RenderingStats& stats) {
+        stats.numHeaps++;
+        if (resource) {
+            stats.numHeapAllocations++;
+        }
+    });
+    return resource;
+}
+
+void Context::trimHeaps(HeapPool& pool) {
+    std::scoped_lock lock(pool.mutex);
+    // Keep one empty heap for the resources of the next tiles loaded
+    bool spare = false;
+    const auto removed = std::erase_if(pool.heaps, [&](const MTLHeapPtr& heap) {
+        if (heap->usedSize() > 0) {
+            return false;
+        }
+        return std::exchange(spare, true);
+    });
+    if (removed) {
+        threadSafeAccessRenderingStats(
+            [&](gfx::RenderingStats& stats) { stats.numHeaps -= static_cast<int>(removed); });
+    }
+}
+
+MTLBufferPtr Context::createMetalBuffer(const void* data, std::size_t size, MTL::ResourceOptions options) {
+    const auto& device = backend.getDevice();
+    // Buffers are all created in shared storage, see `BufferResource`, which the heaps use too
+    if (size <= maxHeapResourceSize) {
+        const auto required = device->heapBufferSizeAndAlign(size, options);
+        auto buffer = allocateFromHeap<MTL::Buffer>(bufferHeaps, required.size, required.align, [&](MTL::Heap* heap) {
+            return heap->newBuffer(size, options);
+        });
+        if (buffer) {
+            if (data && size) {
+                std::memcpy(buffer->contents(), data, size);
+            }
+            return buffer;
+        }
+    }
+    return NS::TransferPtr((data && size) ? device->newBuffer(data, size, options) : device->newBuffer(size, options));
+}
+
+MTLTexturePtr Context::createMetalTexture(MTLTextureDescriptorPtr textureDescriptor) {
+    const auto& device = backend.getDevice();
+    // Heaps can't hold managed textures, the default on devices without unified memory
+    if (device->hasUnifiedMemory() && textureDescriptor->storageMode() == MTL::StorageModeShared) {
+        const auto required = device->heapTextureSizeAndAlign(textureDescriptor.get());
+        if (required.size <= maxHeapResourceSize) {
+            if (auto texture = allocateFromHeap<MTL::Texture>(
+                    textureHeaps, required.size, required.align, [&](MTL::Heap* heap) {
+                        return heap->newTexture(textureDescriptor.get());
+                    })) {
+                return texture;
+            }
+        }
+    }
+    return NS::TransferPtr(device->newTexture(textureDescriptor.get()));
 }
 
 MTLSamplerStatePtr Context::createMetalSamplerState(MTLSamplerDescriptorPtr samplerDescriptor) const {
@@ -194,8 +286,15 @@ MTLSamplerStatePtr Context::createMetalSamplerState(MTLSamplerDescriptorPtr samp
 }
 
 void Context::performCleanup() {
+    trimOffscreenTexturePool();
+    trimHeaps(bufferHeaps);
+    trimHeaps(textureHeaps);
     stats.numDrawCalls = 0;
+    stats.numTriangles = 0;
     stats.numFrames++;
+    stats.frameUniformUpdateBytes = 0;
+    stats.numUniformBindings = 0;
+    stats.drawableEncodingTime = 0.0;
     clipMaskUniformsBufferUsed = false;
 }
 
@@ -634,6 +733,11 @@ MTLDepthStencilStatePtr Context::makeDepthStencilState(const gfx::DepthMode& dep
 void Context::bindGlobalUniformBuffers(gfx::RenderPass& renderPass) const noexcept {
     auto& mtlRenderPass = static_cast<mtl::RenderPass&>(renderPass);
     globalUniformBuffers.bindMtl(mtlRenderPass);
+    mtlRenderPass.setGlobalUniformBuffers(&globalUniformBuffers);
+}
+
+void Context::unbindGlobalUniformBuffers(gfx::RenderPass& renderPass) const noexcept {
+    static_cast<mtl::RenderPass&>(renderPass).setGlobalUniformBuffers(nullptr);
 }
 
 } // namespace mtl
@@ -161,22 +161,27 @@ void Drawable::setShader(gfx::ShaderProgramBasePtr value) {
 }
 
 void Drawable::draw(PaintParameters& parameters) const {
+    if (prepare(parameters)) {
+        encode(static_cast<RenderPass&>(*parameters.renderPass));
+    }
+}
+
+bool Drawable::prepare(PaintParameters& parameters) const {
     if (isCustom) {
-        return;
+        return false;
     }
 
     auto& context = static_cast<Context&>(parameters.context);
     auto& renderPass = static_cast<RenderPass&>(*parameters.renderPass);
-    const auto& encoder = renderPass.getMetalEncoder();
-    if (!encoder) {
+    if (!renderPass.getMetalEncoder()) {
         assert(false);
-        return;
+        return false;
     }
 
     if (!shader) {
         Log::Warning(Event::General, "Missing shader for drawable " + util::toString(getID()) + "/" + getName());
         assert(false);
-        return;
+        return false;
     }
 
     const auto& descriptor = renderPass.getDescriptor();
@@ -191,40 +196,17 @@ void Drawable::draw(PaintParameters& parameters) const {
 
     const auto& shaderMTL = static_cast<const ShaderProgram&>(*shader);
 
-#if !defined(NDEBUG)
-    const auto debugGroup = parameters.encoder->createDebugGroup(debugLabel(*this));
-#endif
-
-    renderPass.unbindVertex(shaders::idGlobalUBOIndex);
-    renderPass.unbindFragment(shaders::idGlobalUBOIndex);
-    encoder->setVertexBytes(&uboIndex, sizeof(uboIndex), shaders::idGlobalUBOIndex);
-    encoder->setFragmentBytes(&uboIndex, sizeof(uboIndex), shaders::idGlobalUBOIndex);
-
-    bindAttributes(renderPass);
-    bindInstanceAttributes(renderPass);
-    bindTextures(renderPass);
-    impl->uniformBuffers.bind(renderPass);
-
-    if (!impl->indexes->getBuffer() || impl->indexes->getDirty()) {
-        assert(!"Index buffer not uploaded");
-        return;
-    }
-
-    const auto* indexBuffer = getMetalBuffer(impl->indexes);
-    if (!indexBuffer || impl->indexes->getDirty()) {
+    if (!impl->indexes->getBuffer() || impl->indexes->getDirty() || !getMetalBuffer(impl->indexes)) {
         assert(!"Index buffer not uploaded");
-        return;
+        return false;
     }
 
     if (!impl->vertexDesc) {
         assert(!"Vertex descriptor missing");
     }
 
-    const auto& cullMode = getCullFaceMode();
-    renderPass.setCullMode(cullMode.enabled ? mapCullMode(cullMode.side) : MTL::CullModeNone);
-    renderPass.setFrontFacingWinding(mapWindingMode(cullMode.winding));
-
-    renderPass.setScissorRect(getMetalScissorRect(parameters.scissorRect));
+    impl->scissorRect = getMetalScissorRect(parameters.scissorRect);
+    impl->batchedInstances = 1;
 
     if (!impl->pipelineState) {
         impl->pipelineState = shaderMTL.getRenderPipelineState(
@@ -233,11 +215,9 @@ void Drawable::draw(PaintParameters& parameters) const {
             getColorMode(),
             mbgl::util::hash(getColorMode().hash(), impl->vertexDescHash));
     }
-    if (impl->pipelineState) {
-        renderPass.setRenderPipelineState(impl->pipelineState);
-    } else {
+    if (!impl->pipelineState) {
         assert(!"Failed to create render pipeline state");
-        return;
+        return false;
     }
 
     // For 3D mode, stenciling is handled by the layer group
@@ -266,6 +246,65 @@ void Drawable::draw(PaintParameters& parameters) const {
             // FIXME: https://github.com/maplibre/maplibre-native/issues/3248
             if (newStencilMode) impl->previousStencilMode = *newStencilMode;
         }
+    }
+
+    for (const auto& texture : textures) {
+        if (texture) {
+            static_cast<mtl::Texture2D&>(*texture).updateSamplerConfigurationIfDirty();
+        }
+    }
+
+    const auto instances = instanceAttributes ? instanceAttributes->getMinCount() : 1;
+    for (const auto& seg_ : impl->segments) {
+        if (seg_->getSegment().indexLength > 0) {
+            context.renderingStats().numDrawCalls++;
+            if (seg_->getMode().type == gfx::DrawModeType::Triangles) {
+                context.renderingStats().numTriangles += static_cast<int>(seg_->getSegment().indexLength / 3 *
+                                                                          instances);
+            }
+        }
+    }
+
+    return true;
+}
+
+bool Drawable::batchInstance(const gfx::Drawable& other) const {
+    if (!canBatchInstance(other, impl->batchedInstances)) {
+        return false;
+    }
+    impl->batchedInstances++;
+    return true;
+}
+
+void Drawable::encode(RenderPass& renderPass) const {
+    const auto& encoder = renderPass.getMetalEncoder();
+    auto& context = renderPass.getCommandEncoder().getContext();
+
+#if !defined(NDEBUG)
+    const auto debugGroup = renderPass.createDebugGroup(debugLabel(*this));
+#endif
+
+    renderPass.unbindVertex(shaders::idGlobalUBOIndex);
+    renderPass.unbindFragment(shaders::idGlobalUBOIndex);
+    encoder->setVertexBytes(&uboIndex, sizeof(uboIndex), shaders::idGlobalUBOIndex);
+    encoder->setFragmentBytes(&uboIndex, sizeof(uboIndex), shaders::idGlobalUBOIndex);
+
+    bindAttributes(renderPass);
+    bindInstanceAttributes(renderPass);
+    bindTextures(renderPass);
+    impl->uniformBuffers.bindMtl(renderPass);
+
+    const auto* indexBuffer = getMetalBuffer(impl->indexes);
+
+    const auto& cullMode = getCullFaceMode();
+    renderPass.setCullMode(cullMode.enabled ? mapCullMode(cullMode.side) : MTL::CullModeNone);
+    renderPass.setFrontFacingWinding(mapWindingMode(cullMode.winding));
+
+    renderPass.setScissorRect(impl->scissorRect);
+
+    renderPass.setRenderPipelineState(impl->pipelineState);
+
+    if (!is3D) {
         renderPass.setDepthStencilState(impl->depthStencilState);
         renderPass.setStencilReference(impl->previousStencilMode.ref);
     }
@@ -279,7 +318,8 @@ void Drawable::draw(PaintParameters& parameters) const {
             const auto primitiveType = getPrimitiveType(mode.type);
             constexpr auto indexType = MTL::IndexType::IndexTypeUInt16;
             constexpr auto indexSize = sizeof(std::uint16_t);
-            const NS::UInteger instanceCount = instanceAttributes ? instanceAttributes->getMinCount() : 1;
+            const NS::UInteger instanceCount = instanceAttributes ? instanceAttributes->getMinCount()
+                                                                  : impl->batchedInstances;
             constexpr NS::UInteger baseInstance = 0;
             const NS::UInteger indexOffset = static_cast<NS::UInteger>(indexSize *
                                                                        mlSegment.indexOffset); // in bytes, not indexes
@@ -322,8 +362,6 @@ void Drawable::draw(PaintParameters& parameters) const {
                 encoder->drawIndexedPrimitives(
                     primitiveType, mlSegment.indexLength, indexType, indexBuffer, indexOffset, instanceCount);
             }
-
-            context.renderingStats().numDrawCalls++;
         }
     }
 
@@ -62,6 +62,9 @@ public:
     std::optional<gfx::RenderPassDescriptor> renderPassDescriptor;
 
     MTLDepthStencilStatePtr depthStencilState;
+    // Set by `prepare` for `encode`
+    MTL::ScissorRect scissorRect;
+    uint32_t batchedInstances = 1;
     gfx::StencilMode previousStencilMode;
 };
 
@@ -10,6 +10,7 @@
 #include <mbgl/renderer/paint_parameters.hpp>
 #include <mbgl/shaders/mtl/shader_program.hpp>
 #include <mbgl/util/convert.hpp>
+#include <mbgl/util/monotonic_timer.hpp>
 
 namespace mbgl {
 namespace mtl {
@@ -44,6 +45,7 @@ void LayerGroup::render(RenderOrchestrator&, PaintParameters& parameters) {
 #endif
 
     auto& renderPass = static_cast<RenderPass&>(*parameters.renderPass);
+    const auto startEncoding = util::MonotonicTimer::now();
 
     bool bindUBOs = false;
     visitDrawables([&](gfx::Drawable& drawable) {
@@ -62,6 +64,10 @@ void LayerGroup::render(RenderOrchestrator&, PaintParameters& parameters) {
 
         drawable.draw(parameters);
     });
+
+    const auto encodingTime = (util::MonotonicTimer::now() - startEncoding).count();
+    parameters.context.threadSafeAccessRenderingStats(
+        [&](gfx::RenderingStats& stats) { stats.drawableEncodingTime += encodingTime; });
 }
 
 } // namespace mtl
@@ -3,7 +3,10 @@
 #include <mbgl/mtl/command_encoder.hpp>
 #include <mbgl/mtl/renderable_resource.hpp>
 #include <mbgl/mtl/context.hpp>
+#include <mbgl/mtl/renderer_backend.hpp>
+#include <mbgl/mtl/uniform_buffer.hpp>
 #include <mbgl/util/logging.hpp>
+#include <mbgl/util/parallel_for.hpp>
 
 #include <Metal/Metal.hpp>
 
@@ -29,7 +32,13 @@ RenderPass::RenderPass(CommandEncoder& commandEncoder_, const char* name, const
                     }
                 }
             }
-            encoder = NS::RetainPtr(buffer->renderCommandEncoder(rpd.get()));
+            if (commandEncoder.getContext().getBackend().getParallelEncoding()) {
+                // Sub-encoders execute in the order they're created, the first one is for the render thread
+                parallelEncoder = NS::RetainPtr(buffer->parallelRenderCommandEncoder(rpd.get()));
+                encoder = NS::RetainPtr(parallelEncoder->renderCommandEncoder());
+            } else {
+                encoder = NS::RetainPtr(buffer->renderCommandEncoder(rpd.get()));
+            }
 
             const auto& texture = rpd->colorAttachments()->object(0)->texture();
             width = texture->width();
@@ -53,8 +62,23 @@ RenderPass::RenderPass(CommandEncoder& commandEncoder_, const char* name, const
     commandEncoder.context.performCleanup();
 }
 
+RenderPass::RenderPass(RenderPass& parent, MTLRenderCommandEncoderPtr encoder_)
+    : descriptor(parent.descriptor),
+      commandEncoder(parent.commandEncoder),
+      encoder(std::move(encoder_)),
+      subPass(true),
+      width(parent.width),
+      height(parent.height),
+      globalUniformBuffers(parent.globalUniformBuffers) {
+    if (globalUniformBuffers) {
+        globalUniformBuffers->bindMtl(*this);
+    }
+}
+
 RenderPass::~RenderPass() {
-    commandEncoder.forgetRenderPass(this);
+    if (!subPass) {
+        commandEncoder.forgetRenderPass(this);
+    }
     endEncoding();
 }
 
@@ -66,9 +90,42 @@ void RenderPass::endEncoding() {
         encoder.reset();
     }
 
+    if (parallelEncoder) {
+        encodeDeferred();
+        parallelEncoder->endEncoding();
+        parallelEncoder.reset();
+    }
+
     resetState();
 }
 
+void RenderPass::deferEncoding(std::function<void(RenderPass&)>&& encode) {
+    assert(parallelEncoder);
+
+    // Finish the render thread's sub-encoder, so that the deferred one comes next, and start another
+    encoder->endEncoding();
+    auto deferred = std::unique_ptr<RenderPass>(
+        new RenderPass(*this, NS::RetainPtr(parallelEncoder->renderCommandEncoder())));
+    deferredEncodings.push_back({std::move(deferred), std::move(encode)});
+
+    encoder = NS::RetainPtr(parallelEncoder->renderCommandEncoder());
+    resetState();
+    if (globalUniformBuffers) {
+        globalUniformBuffers->bindMtl(*this);
+    }
+}
+
+void RenderPass::encodeDeferred() {
+    util::parallelFor(deferredEncodings.size(), [&](std::size_t i) {
+        const auto pool = NS::TransferPtr(NS::AutoreleasePool::alloc()->init());
+
+        auto& deferred = deferredEncodings[i];
+        deferred.encode(*deferred.renderPass);
+        deferred.renderPass->endEncoding();
+    });
+    deferredEncodings.clear();
+}
+
 void RenderPass::resetState() {
     currentPipelineState.reset();
     currentDepthStencilState.reset();
@@ -92,16 +149,22 @@ NS::String* toNSString(const char* str) {
 }
 } // namespace
 
+// Groups pushed on the render thread's sub-encoders could span several of them, so they go to the parallel
+// encoder instead, and deferred encodings only push groups of their own.
 void RenderPass::pushDebugGroup(const char* name) {
     assert(encoder);
-    if (encoder) {
+    if (parallelEncoder) {
+        parallelEncoder->pushDebugGroup(toNSString(name));
+    } else if (encoder) {
         encoder->pushDebugGroup(toNSString(name));
     }
 }
 
 void RenderPass::popDebugGroup() {
     assert(encoder);
-    if (encoder) {
+    if (parallelEncoder) {
+        parallelEncoder->popDebugGroup();
+    } else if (encoder) {
         encoder->popDebugGroup();
     }
 }
@@ -31,11 +31,21 @@
 #include <mbgl/shaders/mtl/symbol.hpp>
 #include <mbgl/shaders/mtl/widevector.hpp>
 
+#include <Metal/MTLBinaryArchive.hpp>
+
 #include <cassert>
+#include <filesystem>
 #include <string>
 
+using namespace std::string_literals;
+
 namespace mbgl {
 namespace mtl {
+namespace {
+NS::URL* fileURL(const std::string& path) {
+    return NS::URL::fileURLWithPath(NS::String::string(path.c_str(), NS::UTF8StringEncoding));
+}
+} // namespace
 
 RendererBackend::RendererBackend(const gfx::ContextMode contextMode_)
     : gfx::RendererBackend(contextMode_),
@@ -50,7 +60,9 @@ RendererBackend::RendererBackend(const gfx::ContextMode contextMode_)
 #endif
 }
 
-RendererBackend::~RendererBackend() = default;
+RendererBackend::~RendererBackend() {
+    saveBinaryArchive();
+}
 
 std::unique_ptr<gfx::Context> RendererBackend::createContext() {
     return std::make_unique<mtl::Context>(*this);
@@ -76,6 +88,71 @@ void RendererBackend::setViewport(int32_t, int32_t, const Size&) {}
 
 void RendererBackend::setScissorTest(bool) {}
 
+MTL::BinaryArchive* RendererBackend::getBinaryArchive() {
+    if (binaryArchiveOpened || binaryArchivePath.empty()) {
+        return binaryArchive.get();
+    }
+    binaryArchiveOpened = true;
+
+    if (__builtin_available(iOS 14.0, macOS 11.0, tvOS 14.0, *)) {
+        auto pool = NS::TransferPtr(NS::AutoreleasePool::alloc()->init());
+
+        auto desc = NS::TransferPtr(MTL::BinaryArchiveDescriptor::alloc()->init());
+        std::error_code ec;
+        if (std::filesystem::exists(binaryArchivePath, ec)) {
+            desc->setUrl(fileURL(binaryArchivePath));
+        }
+
+        NS::Error* error = nullptr;
+        binaryArchive = NS::TransferPtr(device->newBinaryArchive(desc.get(), &error));
+        if (!binaryArchive && desc->url()) {
+            // Written by a different OS or GPU, or damaged. Start over with an empty archive.
+            Log::Warning(Event::Shader, "Ignoring unreadable binary archive " + binaryArchivePath);
+            desc->setUrl(nullptr);
+            error = nullptr;
+            binaryArchive = NS::TransferPtr(device->newBinaryArchive(desc.get(), &error));
+        }
+        if (!binaryArchive) {
+            const auto errPtr = error ? error->localizedDescription()->utf8String() : nullptr;
+            Log::Error(Event::Shader, "newBinaryArchive failed"s + (errPtr ? ": "s + errPtr : std::string()));
+        }
+    } else {
+        Log::Info(Event::Shader, "Binary archives are not supported on this OS version");
+    }
+    return binaryArchive.get();
+}
+
+void RendererBackend::addToBinaryArchive(const MTL::RenderPipelineDescriptor* desc) {
+    if (!binaryArchive) {
+        return;
+    }
+
+    NS::Error* error = nullptr;
+    if (binaryArchive->addRenderPipelineFunctions(desc, &error)) {
+        binaryArchiveModified = true;
+    } else {
+        const auto errPtr = error ? error->localizedDescription()->utf8String() : nullptr;
+        Log::Warning(Event::Shader, "addRenderPipelineFunctions failed"s + (errPtr ? ": "s + errPtr : std::string()));
+    }
+}
+
+void RendererBackend::saveBinaryArchive() {
+    if (!binaryArchive || !binaryArchiveModified) {
+        return;
+    }
+
+    auto pool = NS::TransferPtr(NS::AutoreleasePool::alloc()->init());
+
+    NS::Error* error = nullptr;
+    if (binaryArchive->serializeToURL(fileURL(binaryArchivePath), &error)) {
+        binaryArchiveModified = false;
+    } else {
+        const auto errPtr = error ? error->localizedDescription()->utf8String() : nullptr;
+        Log::Error(Event::Shader,
+                   "Failed to save binary archive " + binaryArchivePath + (errPtr ? ": "s + errPtr : std::string()));
+    }
+}
+
 /// @brief Register a list of types with a shader registry instance
 /// @tparam ...ShaderID Pack of BuiltIn:: shader IDs
 /// @param registry A shader registry instance
@@ -105,6 +182,7 @@ void RendererBackend::initShaders(gfx::ShaderRegistry& shaders, const ProgramPar
     registerTypes<shaders::BuiltIn::BackgroundShader,
                   shaders::BuiltIn::BackgroundPatternShader,
                   shaders::BuiltIn::CircleShader,
+                  shaders::BuiltIn::CircleInstancedShader,
                   shaders::BuiltIn::ClippingMaskProgram,
                   shaders::BuiltIn::CollisionBoxShader,
                   shaders::BuiltIn::CollisionCircleShader,
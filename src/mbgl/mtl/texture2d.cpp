@@ -18,8 +18,7 @@ Texture2D::~Texture2D() {
 }
 
 gfx::Texture2D& Texture2D::setSamplerConfiguration(const SamplerState& samplerState_) noexcept {
-    if (samplerState.filter == samplerState_.filter && samplerState.wrapU == samplerState_.wrapU &&
-        samplerState.wrapV == samplerState_.wrapV) {
+    if (samplerState == samplerState_) {
         return *this;
     }
 
@@ -241,6 +240,7 @@ void Texture2D::updateSamplerConfiguration() {
     samplerDescriptor->setTAddressMode(samplerState.wrapV == gfx::TextureWrapType::Clamp
                                            ? MTL::SamplerAddressModeClampToEdge
                                            : MTL::SamplerAddressModeRepeat);
+    samplerDescriptor->setMaxAnisotropy(samplerState.maxAnisotropy);
     metalSamplerState = context.createMetalSamplerState(samplerDescriptor);
     if (!metalSamplerState) {
         throw std::bad_alloc();
@@ -252,10 +252,7 @@ void Texture2D::updateSamplerConfiguration() {
 void Texture2D::bind(RenderPass& renderPass, int32_t location) {
     assert(!textureDirty);
 
-    // Update the sampler state if it was changed after resource creation
-    if (samplerStateDirty) {
-        updateSamplerConfiguration();
-    }
+    updateSamplerConfigurationIfDirty();
 
     renderPass.setFragmentTexture(metalTexture, location);
     renderPass.setFragmentSamplerState(metalSamplerState, location);
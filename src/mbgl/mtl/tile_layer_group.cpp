@@ -10,6 +10,7 @@
 #include <mbgl/renderer/paint_parameters.hpp>
 #include <mbgl/util/convert.hpp>
 #include <mbgl/util/logging.hpp>
+#include <mbgl/util/monotonic_timer.hpp>
 
 #include <Metal/Metal.hpp>
 
@@ -43,7 +44,6 @@ void TileLayerGroup::render(RenderOrchestrator&, PaintParameters& parameters) {
 
     auto& context = static_cast<Context&>(parameters.context);
     auto& renderPass = static_cast<RenderPass&>(*parameters.renderPass);
-    const auto& encoder = renderPass.getMetalEncoder();
     const auto& renderable = renderPass.getDescriptor().renderable;
 
     // `stencilModeFor3D` uses a different stencil mask value each time its called, so if the
@@ -66,9 +66,7 @@ void TileLayerGroup::render(RenderOrchestrator&, PaintParameters& parameters) {
         });
     }
 
-#if !defined(NDEBUG)
-    const auto debugGroupRender = parameters.encoder->createDebugGroup(getName() + "-render");
-#endif
+    const auto startEncoding = util::MonotonicTimer::now();
 
     // If we're doing 3D stenciling and have any features to draw, set up the single-value stencil mask.
     // If we're doing 2D stenciling and have any drawables with tile IDs, render each tile into the stencil buffer with
@@ -113,37 +111,89 @@ void TileLayerGroup::render(RenderOrchestrator&, PaintParameters& parameters) {
 
         if (stencil3d) {
             stencilMode3d = parameters.stencilModeFor3D();
-            encoder->setStencilReferenceValue(stencilMode3d.ref);
         }
     } else if (stencilTiles && !stencilTiles->empty()) {
         parameters.renderTileClippingMasks(stencilTiles);
     }
 
-    bool bindUBOs = false;
+    // Everything that reads the parameters or shared caches happens here, on the render thread,
+    // so that encoding the drawables can be deferred to another one.
+    struct PreparedDrawable {
+        const Drawable* drawable;
+        // Group-wide state for 3D features
+        MTLDepthStencilStatePtr depthStencilState;
+    };
+    std::vector<PreparedDrawable> prepared;
     visitDrawables([&](gfx::Drawable& drawable) {
         if (!drawable.getEnabled() || !drawable.hasRenderPass(parameters.pass)) {
             return;
         }
 
-        if (!bindUBOs) {
-            uniformBuffers.bindMtl(renderPass);
-            bindUBOs = true;
-        }
-
         for (const auto& tweaker : drawable.getTweakers()) {
             tweaker->execute(drawable, parameters);
         }
 
+        // Tiles that differ only in their drawable UBO are drawn as instances of the previous one
+        if (!prepared.empty() && prepared.back().drawable->batchInstance(drawable)) {
+            return;
+        }
+
+        const auto& drawableMTL = static_cast<const Drawable&>(drawable);
+        if (!drawableMTL.prepare(parameters)) {
+            return;
+        }
+
         // For layer groups with 3D features, enable either the single-value
         // stencil mode for features with stencil enabled or disable stenciling.
-        // 2D drawables will set their own stencil mode within `draw`.
+        // 2D drawables will set their own stencil mode within `encode`.
+        MTLDepthStencilStatePtr state;
         if (features3d) {
-            const auto& state = getDepthStencilState(drawable.getEnableDepth(), drawable.getEnableStencil());
-            renderPass.setDepthStencilState(state);
+            state = getDepthStencilState(drawable.getEnableDepth(), drawable.getEnableStencil());
         }
-
-        drawable.draw(parameters);
+        prepared.push_back({&drawableMTL, std::move(state)});
     });
+
+    const auto preparationTime = (util::MonotonicTimer::now() - startEncoding).count();
+    context.threadSafeAccessRenderingStats(
+        [&](gfx::RenderingStats& stats) { stats.drawableEncodingTime += preparationTime; });
+
+    if (prepared.empty()) {
+        return;
+    }
+
+    std::optional<int32_t> stencilRef3d;
+    if (stencil3d) {
+        stencilRef3d = stencilMode3d.ref;
+    }
+
+    auto encode = [this, &context, prepared = std::move(prepared), stencilRef3d](RenderPass& renderPass_) {
+        const auto startDrawables = util::MonotonicTimer::now();
+#if !defined(NDEBUG)
+        const auto debugGroup = renderPass_.createDebugGroup(getName() + "-render");
+#endif
+
+        uniformBuffers.bindMtl(renderPass_);
+        if (stencilRef3d) {
+            renderPass_.setStencilReference(*stencilRef3d);
+        }
+
+        for (const auto& item : prepared) {
+            if (item.depthStencilState) {
+                renderPass_.setDepthStencilState(item.depthStencilState);
+            }
+            item.drawable->encode(renderPass_);
+        }
+
+        const auto encodingTime = (util::MonotonicTimer::now() - startDrawables).count();
+        context.threadSafeAccessRenderingStats(
+            [&](gfx::RenderingStats& stats) { stats.drawableEncodingTime += encodingTime; });
+    };
+
+    if (renderPass.isEncodingInParallel()) {
+        renderPass.deferEncoding(std::move(encode));
+    } else {
+        encode(renderPass);
+    }
 }
 
 } // namespace mtl
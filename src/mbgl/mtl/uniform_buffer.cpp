@@ -1,4 +1,5 @@
 #include <mbgl/mtl/uniform_buffer.hpp>
+#include <mbgl/mtl/command_encoder.hpp>
 #include <mbgl/mtl/render_pass.hpp>
 #include <mbgl/mtl/context.hpp>
 #include <mbgl/shaders/layer_ubo.hpp>
@@ -36,10 +37,12 @@ void UniformBuffer::update(const void* data, std::size_t dataSize) {
 
     buffer.getContext().renderingStats().numUniformUpdates++;
     buffer.getContext().renderingStats().uniformUpdateBytes += dataSize;
+    buffer.getContext().renderingStats().frameUniformUpdateBytes += dataSize;
     buffer.update(data, dataSize, /*offset=*/0);
 }
 
 void UniformBufferArray::bindMtl(RenderPass& renderPass) const noexcept {
+    int bindings = 0;
     for (size_t id = 0; id < allocatedSize(); id++) {
         const auto& uniformBuffer = get(id);
         if (!uniformBuffer) continue;
@@ -51,6 +54,13 @@ void UniformBufferArray::bindMtl(RenderPass& renderPass) const noexcept {
         if (id != shaders::idDrawableReservedVertexOnlyUBO) {
             renderPass.bindFragment(resource, 0, id);
         }
+        ++bindings;
+    }
+
+    // Drawables may be encoded on several threads at once, see `RendererBackend::setParallelEncoding`
+    if (bindings) {
+        renderPass.getCommandEncoder().getContext().threadSafeAccessRenderingStats(
+            [&](gfx::RenderingStats& stats) { stats.numUniformBindings += bindings; });
     }
 }
 
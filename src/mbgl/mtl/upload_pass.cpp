@@ -65,8 +65,11 @@ std::unique_ptr<gfx::VertexBufferResource> UploadPass::createVertexBufferResourc
         commandEncoder.context.createBuffer(data, size, usage, /*isIndexBuffer=*/false, persistent));
 }
 
-void UploadPass::updateVertexBufferResource(gfx::VertexBufferResource& resource, const void* data, std::size_t size) {
-    static_cast<VertexBufferResource&>(resource).get().update(data, size, /*offset=*/0);
+void UploadPass::updateVertexBufferResource(gfx::VertexBufferResource& resource,
+                                            const void* data,
+                                            std::size_t size,
+                                            std::size_t offset) {
+    static_cast<VertexBufferResource&>(resource).get().update(data, size, offset);
 }
 
 std::unique_ptr<gfx::IndexBufferResource> UploadPass::createIndexBufferResource(const void* data,
@@ -105,7 +108,17 @@ const gfx::UniqueVertexBufferResource& UploadPass::getBuffer(const gfx::VertexVe
             if (rawBufSize <= resource.getSizeInBytes()) {
                 // If the source changed, update the buffer contents
                 if (forceUpdate || vec->isModifiedAfter(resource.getLastUpdated())) {
-                    updateVertexBufferResource(resource, rawBufPtr, rawBufSize);
+                    const auto range = forceUpdate ? std::nullopt : vec->getModifiedRange();
+                    if (!range) {
+                        updateVertexBufferResource(resource, rawBufPtr, rawBufSize, /*offset=*/0);
+                    } else if (range->second > range->first) {
+                        // Only upload the span that changed
+                        updateVertexBufferResource(resource,
+                                                   static_cast<const uint8_t*>(rawBufPtr) + range->first,
+                                                   range->second - range->first,
+                                                   range->first);
+                    }
+                    vec->clearModifiedRange();
                     resource.setLastUpdated(vec->getLastModified());
                 }
                 return rawData->resource;
@@ -116,6 +129,7 @@ const gfx::UniqueVertexBufferResource& UploadPass::getBuffer(const gfx::VertexVe
             auto buffer_ = std::make_unique<VertexBuffer>();
             buffer_->resource = createVertexBufferResource(rawBufPtr, rawBufSize, usage, /*persistent=*/false);
             vec->setBuffer(std::move(buffer_));
+            vec->clearModifiedRange();
             return static_cast<VertexBuffer*>(vec->getBuffer())->resource;
         }
     }
@@ -1,9 +1,12 @@
 #pragma once
 
 #include <mbgl/style/layer.hpp>
+#include <mbgl/map/transform_state.hpp>
 #include <mbgl/renderer/paint_parameters.hpp>
 #include <mbgl/renderer/render_layer.hpp>
 
+#include <memory>
+
 namespace mbgl {
 
 namespace style {
@@ -29,6 +32,17 @@ public:
     using OnUpdateLayer = std::function<void(const LayerPrepareParameters&)>;
     using OnUpdateLayerProperties = std::function<void(const std::string& properties)>;
 
+    /// What a prepare function gets to work from, copied as it runs on a background thread
+    struct PrepareParameters {
+        TransformState state;
+        /// Counts the prepare calls of the layer, starting at zero
+        uint64_t sequence = 0;
+    };
+    /// Called on a background thread, one call at a time, the result is handed to the upload function
+    using OnPrepareLayer = std::function<std::shared_ptr<void>(const PrepareParameters&)>;
+    /// Called on the render thread with each prepared result, once, in the first frame after it's ready
+    using OnUploadLayer = std::function<void(gfx::UploadPass&, const std::shared_ptr<void>& prepared)>;
+
     void* _platformReference = nullptr;
 
 protected:
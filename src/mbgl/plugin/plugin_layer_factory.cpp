@@ -181,6 +181,8 @@ std::unique_ptr<RenderLayer> PluginLayerFactory::createRenderLayer(Immutable<sty
     tempResult->setRenderFunction(localImpl->_renderFunction);
     tempResult->setUpdateFunction(localImpl->_updateFunction);
     tempResult->setUpdatePropertiesFunction(localImpl->_updateLayerPropertiesFunction);
+    tempResult->setPrepareFunction(localImpl->_prepareFunction);
+    tempResult->setUploadFunction(localImpl->_uploadFunction);
     return tempResult;
 }
 
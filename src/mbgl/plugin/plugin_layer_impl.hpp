@@ -99,6 +99,10 @@ public:
         _updateLayerPropertiesFunction = updateLayerPropertiesFunction;
     }
 
+    void setPrepareFunction(OnPrepareLayer prepareFunction) { _prepareFunction = prepareFunction; }
+
+    void setUploadFunction(OnUploadLayer uploadFunction) { _uploadFunction = uploadFunction; }
+
     //! The property manager handles all of the custom properties for this layer type / instance
     PluginLayerPropertyManager _propertyManager;
 
@@ -106,10 +110,16 @@ public:
     OnRenderLayer _renderFunction;
 
     //! Optional: Called when the layer is expected to update it's animations/etc.
-    // TODO: Does this need to be here or can it be done via the render function.  Potentially, we could
-    // have this method called on a background thread/etc or use another way to parallalize work
+    // Runs on the render thread, heavy work belongs in the prepare function instead.
     OnUpdateLayer _updateFunction;
 
+    //! Optional: Called on a background thread to compute what the layer draws, ahead of the frames using it.
+    // While a call runs, the frames keep the last result; the next call starts once it's done.
+    OnPrepareLayer _prepareFunction;
+
+    //! Optional: Called with each result of the prepare function, to upload it before it's rendered
+    OnUploadLayer _uploadFunction;
+
     //! Optional: Called when the layer properties change.  The properties are passed as JSON for now
     OnUpdateLayerProperties _updateLayerPropertiesFunction;
 
@@ -12,6 +12,7 @@
 #include <mbgl/gfx/drawable.hpp>
 #include <mbgl/gfx/renderer_backend.hpp>
 #include <mbgl/style/properties.hpp>
+#include <mbgl/actor/scheduler.hpp>
 
 using namespace mbgl;
 
@@ -116,7 +117,12 @@ void RenderPluginLayer::update([[maybe_unused]] gfx::ShaderRegistry& shaderRegis
     }
 }
 
-void RenderPluginLayer::upload([[maybe_unused]] gfx::UploadPass& uploadPass) {}
+void RenderPluginLayer::upload(gfx::UploadPass& uploadPass) {
+    if (_uploadFunction && !preparedUploaded) {
+        _uploadFunction(uploadPass, prepared);
+    }
+    preparedUploaded = true;
+}
 
 void RenderPluginLayer::render(PaintParameters& paintParameters) {
     if (_renderFunction) {
@@ -128,6 +134,30 @@ void RenderPluginLayer::prepare(const LayerPrepareParameters& layerParameters) {
     if (_updateFunction) {
         _updateFunction(layerParameters);
     }
+
+    if (!_prepareFunction) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(prepareState->mutex);
+    if (prepareState->ready) {
+        // Swap in the finished result, this frame uploads it
+        prepared = std::move(prepareState->ready);
+        preparedUploaded = false;
+    }
+    if (!prepareState->running) {
+        prepareState->running = true;
+        Scheduler::GetBackground()->schedule(
+            [state = prepareState,
+             prepareFunction = _prepareFunction,
+             parameters = style::PluginLayer::PrepareParameters{.state = layerParameters.state,
+                                                                .sequence = prepareSequence++}] {
+                auto result = prepareFunction(parameters);
+                std::lock_guard<std::mutex> resultLock(state->mutex);
+                state->ready = std::move(result);
+                state->running = false;
+            });
+    }
 }
 
 // --- Private methods
@@ -5,6 +5,8 @@
 #include <mbgl/plugin/plugin_layer_impl.hpp>
 #include <mbgl/plugin/plugin_layer_properties.hpp>
 
+#include <memory>
+#include <mutex>
 #include <optional>
 
 namespace mbgl {
@@ -34,6 +36,8 @@ public:
     void setUpdatePropertiesFunction(style::PluginLayer::OnUpdateLayerProperties updateLayerPropertiesFunction) {
         _updateLayerPropertiesFunction = updateLayerPropertiesFunction;
     }
+    void setPrepareFunction(style::PluginLayer::OnPrepareLayer prepareFunction) { _prepareFunction = prepareFunction; }
+    void setUploadFunction(style::PluginLayer::OnUploadLayer uploadFunction) { _uploadFunction = uploadFunction; }
 
 private:
     void transition(const TransitionParameters&) override;
@@ -67,6 +71,24 @@ private:
     style::PluginLayer::OnUpdateLayer _updateFunction = nullptr;
 
     style::PluginLayer::OnUpdateLayerProperties _updateLayerPropertiesFunction = nullptr;
+
+    style::PluginLayer::OnPrepareLayer _prepareFunction = nullptr;
+
+    style::PluginLayer::OnUploadLayer _uploadFunction = nullptr;
+
+    /// The back buffer of the prepared results, shared with the prepare task, which may outlive the layer
+    struct PrepareState {
+        std::mutex mutex;
+        /// The result of the last call not taken by a frame yet
+        std::shared_ptr<void> ready;
+        bool running = false;
+    };
+    std::shared_ptr<PrepareState> prepareState = std::make_shared<PrepareState>();
+    uint64_t prepareSequence = 0;
+
+    /// The front buffer, the result the current frame uploads and renders with
+    std::shared_ptr<void> prepared;
+    bool preparedUploaded = true;
 };
 
 } // namespace mbgl
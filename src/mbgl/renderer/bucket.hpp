@@ -6,6 +6,7 @@
 #include <mbgl/tile/geometry_tile_data.hpp>
 
 #include <mbgl/util/identity.hpp>
+#include <mbgl/util/memory_usage.hpp>
 
 #include <atomic>
 
@@ -42,8 +43,23 @@ public:
                             std::size_t,
                             const CanonicalTileID&) {}
 
+    // Adds a point feature whose points are read in place, see `GeometryTileFeature::getPoints()`. Buckets
+    // that only need the points override this; the others get them as a collection of one ring.
+    virtual void addPointFeature(const GeometryTileFeature& feature,
+                                 std::span<const GeometryCoordinate> points,
+                                 std::size_t index,
+                                 const CanonicalTileID& canonical) {
+        GeometryCollection geometry;
+        geometry.emplace_back(points.begin(), points.end());
+        addFeature(feature, geometry, {}, {}, index, canonical);
+    }
+
     virtual void update(const FeatureStates&, const GeometryTileLayer&, const std::string&, const ImagePositions&) {}
 
+    // Called once all the features are added. Buckets whose drawables may choose per tile between paint
+    // attributes and uniforms drop the attributes that hold the layer default everywhere.
+    virtual void compactPaintAttributes() {}
+
     // As long as this bucket has a Prepare render pass, this function is
     // getting called. Typically, this only happens once when the bucket is
     // being rendered for the first time.
@@ -53,8 +69,16 @@ public:
 
     virtual float getQueryRadius(const RenderLayer&) const { return 0; };
 
+    // Approximate memory held by the layout geometry, both the CPU-side
+    // vectors and any buffers created from them on upload.
+    virtual MemoryUsage getMemoryUsage() const { return {}; }
+
     bool needsUpload() const { return hasData() && !uploaded; }
 
+    // Frees the CPU-side layout geometry whose buffers are uploaded, keeping what the drawables
+    // are built from. Only called in the `EXPERIMENTAL_DISCARD_UPLOADED_GEOMETRY` mode.
+    virtual void discardUploadedData() {}
+
     // The following methods are implemented by buckets that require cross-tile indexing and placement.
 
     // Returns a pair, the first element of which is a bucket cross-tile id
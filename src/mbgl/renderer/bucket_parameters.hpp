@@ -3,6 +3,8 @@
 #include <mbgl/map/mode.hpp>
 #include <mbgl/tile/tile_id.hpp>
 
+#include <atomic>
+
 namespace mbgl {
 namespace style {
 struct LayerTypeInfo;
@@ -14,6 +16,11 @@ public:
     const MapMode mode;
     const float pixelRatio;
     const style::LayerTypeInfo* layerType;
+
+    /// Set when the tile is no longer needed. Long-running layout work checks it to abandon early.
+    const std::atomic<bool>* cancelled = nullptr;
+
+    bool isCancelled() const { return cancelled && cancelled->load(std::memory_order_relaxed); }
 };
 
 } // namespace mbgl
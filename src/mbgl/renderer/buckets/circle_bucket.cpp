@@ -32,6 +32,16 @@ bool CircleBucket::hasData() const {
     return !segments.empty();
 }
 
+MemoryUsage CircleBucket::getMemoryUsage() const {
+    return vertices.getMemoryUsage() + triangles.getMemoryUsage() +
+           MemoryUsage{.cpu = segments.capacity() * sizeof(SegmentBase)};
+}
+
+void CircleBucket::discardUploadedData() {
+    vertices.discardUploadedData();
+    triangles.discardUploadedData();
+}
+
 namespace {
 template <class Property>
 float get(const CirclePaintProperties::PossiblyEvaluated& evaluated,
@@ -67,4 +77,10 @@ void CircleBucket::update(const FeatureStates& states,
     }
 }
 
+void CircleBucket::compactPaintAttributes() {
+    for (auto& pair : paintPropertyBinders) {
+        pair.second.compactVertexVectors();
+    }
+}
+
 } // namespace mbgl
@@ -26,6 +26,9 @@ public:
     ~CircleBucket() override;
 
     bool hasData() const override;
+    MemoryUsage getMemoryUsage() const override;
+
+    void discardUploadedData() override;
 
     void upload(gfx::UploadPass&) override;
 
@@ -33,6 +36,12 @@ public:
 
     void update(const FeatureStates&, const GeometryTileLayer&, const std::string&, const ImagePositions&) override;
 
+    void compactPaintAttributes() override;
+
+#if MLN_USE_CIRCLE_INSTANCING
+    /// The instance record of a circle, its center. The corners come from a unit quad shared by all circles.
+    static CircleLayoutVertex instance(Point<int16_t> p) { return CircleLayoutVertex{{{p.x, p.y}}}; }
+#else
     /*
      * @param {number} x vertex position
      * @param {number} y vertex position
@@ -43,7 +52,10 @@ public:
         return CircleLayoutVertex{
             {{static_cast<int16_t>((p.x * 2) + ((ex + 1) / 2)), static_cast<int16_t>((p.y * 2) + ((ey + 1) / 2))}}};
     }
+#endif
 
+    /// With instancing, one instance record per circle, and the paint attributes follow suit.
+    /// `triangles` is then left empty and `segments` counts the instances.
     using VertexVector = gfx::VertexVector<CircleLayoutVertex>;
     const std::shared_ptr<VertexVector> sharedVertices = std::make_shared<VertexVector>();
     VertexVector& vertices = *sharedVertices;
@@ -2,11 +2,57 @@
 #include <mbgl/renderer/bucket_parameters.hpp>
 #include <mbgl/style/layers/fill_layer_impl.hpp>
 #include <mbgl/renderer/layers/render_fill_layer.hpp>
+#include <mbgl/util/constants.hpp>
 #include <mbgl/util/math.hpp>
 #include <mbgl/gfx/fill_generator.hpp>
 
+#include <algorithm>
+#include <cstdlib>
+
 namespace mbgl {
 
+namespace {
+
+// Whether the ring is a rectangle containing the tile, its edges all lying along its bounding box
+bool ringCoversTile(const GeometryCoordinates& ring) {
+    if (ring.size() < 4) {
+        return false;
+    }
+    const auto minX = std::ranges::min(ring, {}, &GeometryCoordinate::x).x;
+    const auto maxX = std::ranges::max(ring, {}, &GeometryCoordinate::x).x;
+    const auto minY = std::ranges::min(ring, {}, &GeometryCoordinate::y).y;
+    const auto maxY = std::ranges::max(ring, {}, &GeometryCoordinate::y).y;
+    if (minX > 0 || minY > 0 || maxX < util::EXTENT || maxY < util::EXTENT) {
+        return false;
+    }
+
+    int64_t doubleArea = 0;
+    for (std::size_t i = 0; i < ring.size(); ++i) {
+        const auto& a = ring[i];
+        const auto& b = ring[(i + 1) % ring.size()];
+        const bool alongBounds = (a.x == b.x && (a.x == minX || a.x == maxX)) ||
+                                 (a.y == b.y && (a.y == minY || a.y == maxY));
+        if (!alongBounds) {
+            return false;
+        }
+        doubleArea += int64_t(a.x) * b.y - int64_t(b.x) * a.y;
+    }
+    // Rules out rings doubling back along the bounds
+    return std::abs(doubleArea) == 2 * int64_t(maxX - minX) * int64_t(maxY - minY);
+}
+
+bool geometryCoversTile(const GeometryCollection& geometry) {
+    // Classify the rings only once one of them is found to cover the tile, which it mustn't as a hole
+    if (std::ranges::none_of(geometry, ringCoversTile)) {
+        return false;
+    }
+    return std::ranges::any_of(classifyRingRefs(geometry), [](const PolygonRingRefs& polygon) {
+        return polygon.size() == 1 && ringCoversTile(polygon.front());
+    });
+}
+
+} // namespace
+
 FillBucket::FillBucket(const FillBucket::PossiblyEvaluatedLayoutProperties&,
                        const std::map<std::string, Immutable<style::LayerProperties>>& layerPaintProperties,
                        const float zoom,
@@ -40,7 +86,9 @@ void FillBucket::addFeature(const GeometryTileFeature& feature,
                                       lineIndexes,
                                       lineSegments,
                                       basicLines,
-                                      basicLineSegments);
+                                      basicLineSegments,
+                                      gfx::TriangulationCache::current(index));
+    coversTile = coversTile || geometryCoversTile(geometry);
 
     for (auto& pair : paintPropertyBinders) {
         const auto it = patternDependencies.find(pair.first);
@@ -60,7 +108,14 @@ void FillBucket::addFeature(const GeometryTileFeature& feature,
                             std::size_t index,
                             const CanonicalTileID& canonical) {
     // generate buffers
-    gfx::generateFillAndOutineBuffers(geometry, vertices, triangles, triangleSegments, basicLines, basicLineSegments);
+    gfx::generateFillAndOutineBuffers(geometry,
+                                      vertices,
+                                      triangles,
+                                      triangleSegments,
+                                      basicLines,
+                                      basicLineSegments,
+                                      gfx::TriangulationCache::current(index));
+    coversTile = coversTile || geometryCoversTile(geometry);
 
     for (auto& pair : paintPropertyBinders) {
         const auto it = patternDependencies.find(pair.first);
@@ -82,6 +137,21 @@ bool FillBucket::hasData() const {
     return !triangleSegments.empty() || !basicLineSegments.empty();
 }
 
+MemoryUsage FillBucket::getMemoryUsage() const {
+    return vertices.getMemoryUsage() + triangles.getMemoryUsage() + lineVertices.getMemoryUsage() +
+           lineIndexes.getMemoryUsage() + basicLines.getMemoryUsage() +
+           MemoryUsage{.cpu = (triangleSegments.capacity() + lineSegments.capacity() + basicLineSegments.capacity()) *
+                              sizeof(SegmentBase)};
+}
+
+void FillBucket::discardUploadedData() {
+    vertices.discardUploadedData();
+    triangles.discardUploadedData();
+    lineVertices.discardUploadedData();
+    lineIndexes.discardUploadedData();
+    basicLines.discardUploadedData();
+}
+
 float FillBucket::getQueryRadius(const RenderLayer& layer) const {
     using namespace style;
     const auto& evaluated = getEvaluated<FillLayerProperties>(layer.evaluatedProperties);
@@ -102,4 +172,10 @@ void FillBucket::update(const FeatureStates& states,
     }
 }
 
+void FillBucket::compactPaintAttributes() {
+    for (auto& pair : paintPropertyBinders) {
+        pair.second.compactVertexVectors();
+    }
+}
+
 } // namespace mbgl
@@ -45,6 +45,9 @@ public:
                     const CanonicalTileID&) override;
 
     bool hasData() const override;
+    MemoryUsage getMemoryUsage() const override;
+
+    void discardUploadedData() override;
 
     void upload(gfx::UploadPass&) override;
 
@@ -52,6 +55,8 @@ public:
 
     void update(const FeatureStates&, const GeometryTileLayer&, const std::string&, const ImagePositions&) override;
 
+    void compactPaintAttributes() override;
+
     static FillLayoutVertex layoutVertex(Point<int16_t> p) { return FillLayoutVertex{{{p.x, p.y}}}; }
 
 #if MLN_TRIANGULATE_FILL_OUTLINES
@@ -82,6 +87,9 @@ public:
 
     SegmentVector triangleSegments;
 
+    /// Whether a polygon without holes covers the whole tile, as tile clipping leaves those spanning it
+    bool coversTile = false;
+
     std::map<std::string, FillBinders> paintPropertyBinders;
 };
 
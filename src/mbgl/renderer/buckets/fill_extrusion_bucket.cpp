@@ -1,5 +1,6 @@
 #include <mbgl/renderer/buckets/fill_extrusion_bucket.hpp>
 #include <mbgl/renderer/bucket_parameters.hpp>
+#include <mbgl/gfx/triangulation_cache.hpp>
 #include <mbgl/style/layers/fill_extrusion_layer_impl.hpp>
 #include <mbgl/renderer/layers/render_fill_extrusion_layer.hpp>
 #include <mbgl/map/transform_state.hpp>
@@ -39,6 +40,17 @@ using namespace style;
 
 struct GeometryTooLongException : std::exception {};
 
+namespace {
+
+uint64_t edgeKey(const GeometryCoordinate& from, const GeometryCoordinate& to) {
+    return (static_cast<uint64_t>(static_cast<uint16_t>(from.x)) << 48) |
+           (static_cast<uint64_t>(static_cast<uint16_t>(from.y)) << 32) |
+           (static_cast<uint64_t>(static_cast<uint16_t>(to.x)) << 16) |
+           static_cast<uint64_t>(static_cast<uint16_t>(to.y));
+}
+
+} // namespace
+
 FillExtrusionBucket::FillExtrusionBucket(
     const FillExtrusionBucket::PossiblyEvaluatedLayoutProperties&,
     const std::map<std::string, Immutable<style::LayerProperties>>& layerPaintProperties,
@@ -62,7 +74,11 @@ void FillExtrusionBucket::addFeature(const GeometryTileFeature& feature,
                                      const PatternLayerMap& patternDependencies,
                                      std::size_t index,
                                      const CanonicalTileID& canonical) {
-    for (auto& polygon : classifyRings(geometry)) {
+    gfx::TriangulationCache::Feature* const triangulations = gfx::TriangulationCache::current(index);
+    std::size_t nextPolygon = 0;
+    for (auto& polygon : classifyRingRefs(geometry)) {
+        const std::size_t polygonIndex = nextPolygon++;
+
         // Optimize polygons with many interior rings for earcut tesselation.
         limitHoles(polygon, 500);
 
@@ -75,7 +91,7 @@ void FillExtrusionBucket::addFeature(const GeometryTileFeature& feature,
 
         if (totalVertices == 0) continue;
 
-        std::vector<uint32_t> flatIndices;
+        util::ArenaVector<uint32_t> flatIndices;
         flatIndices.reserve(totalVertices);
 
         std::size_t startVertices = vertices.elements();
@@ -83,6 +99,9 @@ void FillExtrusionBucket::addFeature(const GeometryTileFeature& feature,
         if (triangleSegments.empty() || triangleSegments.back().vertexLength + (5 * (totalVertices - 1) + 1) >
                                             std::numeric_limits<uint16_t>::max()) {
             triangleSegments.emplace_back(startVertices, triangles.elements());
+#if !MLN_USE_FILL_EXTRUSION_INSTANCING
+            lodTriangleSegments.emplace_back(startVertices, lodTriangles.elements());
+#endif
         }
 
         auto& triangleSegment = triangleSegments.back();
@@ -91,6 +110,22 @@ void FillExtrusionBucket::addFeature(const GeometryTileFeature& feature,
 
         assert(triangleIndex + (5 * (totalVertices - 1) + 1) <= std::numeric_limits<uint16_t>::max());
 
+#if !MLN_USE_FILL_EXTRUSION_INSTANCING
+        auto& lodTriangleSegment = lodTriangleSegments.back();
+
+        // Small buildings can lose their walls when seen from afar
+        bool smallFootprint = false;
+        if (!polygon[0].empty()) {
+            GeometryCoordinate minCorner = polygon[0][0];
+            GeometryCoordinate maxCorner = minCorner;
+            for (const auto& p : polygon[0]) {
+                minCorner = {std::min(minCorner.x, p.x), std::min(minCorner.y, p.y)};
+                maxCorner = {std::max(maxCorner.x, p.x), std::max(maxCorner.y, p.y)};
+            }
+            smallFootprint = std::max(maxCorner.x - minCorner.x, maxCorner.y - minCorner.y) < lodFootprintExtent;
+        }
+#endif
+
         for (const auto& ring : polygon) {
             std::size_t nVertices = ring.size();
 
@@ -149,35 +184,56 @@ void FillExtrusionBucket::addFeature(const GeometryTileFeature& feature,
                     vertices.emplace_back(FillExtrusionBucket::layoutVertex(
                         p2, perp.x, perp.y, 0, 1, static_cast<uint16_t>(edgeDistance)));
 
+                    // A wall running the other way along the same edge belongs to an adjacent building
+                    const bool sharedEdge = layoutEdges.contains(edgeKey(p2, p1));
+                    layoutEdges.insert(edgeKey(p1, p2));
+                    auto& wallTriangles = (smallFootprint || sharedEdge) ? lodTriangles : triangles;
+                    auto& wallSegment = (smallFootprint || sharedEdge) ? lodTriangleSegment : triangleSegment;
+
                     // ┌──────┐
                     // │ 0  1 │ Counter-Clockwise winding order.
                     // │      │ Triangle 1: 0 => 2 => 1
                     // │ 2  3 │ Triangle 2: 1 => 2 => 3
                     // └──────┘
-                    triangles.emplace_back(triangleIndex, triangleIndex + 2, triangleIndex + 1);
-                    triangles.emplace_back(triangleIndex + 1, triangleIndex + 2, triangleIndex + 3);
+                    wallTriangles.emplace_back(triangleIndex, triangleIndex + 2, triangleIndex + 1);
+                    wallTriangles.emplace_back(triangleIndex + 1, triangleIndex + 2, triangleIndex + 3);
                     triangleIndex += 4;
                     triangleSegment.vertexLength += 4;
-                    triangleSegment.indexLength += 6;
+                    wallSegment.indexLength += 6;
                 }
 #endif
             }
         }
 
-        std::vector<uint32_t> indices = mapbox::earcut(polygon);
+        const auto addTriangles = [&](const auto& indices) {
+            const std::size_t count = indices.size();
+            assert(count % 3 == 0);
 
-        std::size_t nIndices = indices.size();
-        assert(nIndices % 3 == 0);
+            for (std::size_t i = 0; i < count; i += 3) {
+                // Counter-Clockwise winding order.
+                triangles.emplace_back(static_cast<uint16_t>(flatIndices[indices[i]]),
+                                       static_cast<uint16_t>(flatIndices[indices[i + 2]]),
+                                       static_cast<uint16_t>(flatIndices[indices[i + 1]]));
+            }
+            return count;
+        };
 
-        for (std::size_t i = 0; i < nIndices; i += 3) {
-            // Counter-Clockwise winding order.
-            triangles.emplace_back(static_cast<uint16_t>(flatIndices[indices[i]]),
-                                   static_cast<uint16_t>(flatIndices[indices[i + 2]]),
-                                   static_cast<uint16_t>(flatIndices[indices[i + 1]]));
+        std::size_t nIndices = 0;
+        if (const auto* cached = triangulations ? triangulations->find(polygonIndex, totalVertices) : nullptr) {
+            nIndices = addTriangles(*cached);
+        } else {
+            const std::vector<uint32_t> indices = mapbox::earcut(polygon);
+            if (triangulations) {
+                triangulations->insert(polygonIndex, totalVertices, indices);
+            }
+            nIndices = addTriangles(indices);
         }
 
         triangleSegment.vertexLength += totalVertices;
         triangleSegment.indexLength += nIndices;
+#if !MLN_USE_FILL_EXTRUSION_INSTANCING
+        lodTriangleSegment.vertexLength = triangleSegment.vertexLength;
+#endif
     }
 
     for (auto& pair : paintPropertyBinders) {
@@ -192,6 +248,8 @@ void FillExtrusionBucket::addFeature(const GeometryTileFeature& feature,
 }
 
 void FillExtrusionBucket::upload([[maybe_unused]] gfx::UploadPass& uploadPass) {
+    // Layout is over by the time the bucket is uploaded
+    layoutEdges = {};
     uploaded = true;
 }
 
@@ -199,6 +257,17 @@ bool FillExtrusionBucket::hasData() const {
     return !triangleSegments.empty();
 }
 
+MemoryUsage FillExtrusionBucket::getMemoryUsage() const {
+    return vertices.getMemoryUsage() + triangles.getMemoryUsage() + lodTriangles.getMemoryUsage() +
+           MemoryUsage{.cpu = (triangleSegments.capacity() + lodTriangleSegments.capacity()) * sizeof(SegmentBase)};
+}
+
+void FillExtrusionBucket::discardUploadedData() {
+    vertices.discardUploadedData();
+    triangles.discardUploadedData();
+    lodTriangles.discardUploadedData();
+}
+
 float FillExtrusionBucket::getQueryRadius(const RenderLayer& layer) const {
     const auto& evaluated = getEvaluated<FillExtrusionLayerProperties>(layer.evaluatedProperties);
     const std::array<float, 2>& translate = evaluated.get<FillExtrusionTranslate>();
@@ -218,6 +287,12 @@ void FillExtrusionBucket::update(const FeatureStates& states,
     }
 }
 
+void FillExtrusionBucket::compactPaintAttributes() {
+    for (auto& pair : paintPropertyBinders) {
+        pair.second.compactVertexVectors();
+    }
+}
+
 std::array<float, 3> FillExtrusionBucket::lightColor(const EvaluatedLight& light) {
     const auto color = light.get<LightColor>();
     return {{color.r, color.g, color.b}};
@@ -9,6 +9,8 @@
 #include <mbgl/shaders/segment.hpp>
 #include <mbgl/style/layers/fill_extrusion_layer_properties.hpp>
 
+#include <unordered_set>
+
 namespace mbgl {
 
 class BucketParameters;
@@ -42,6 +44,9 @@ public:
                     const CanonicalTileID&) override;
 
     bool hasData() const override;
+    MemoryUsage getMemoryUsage() const override;
+
+    void discardUploadedData() override;
 
     void upload(gfx::UploadPass&) override;
 
@@ -49,6 +54,8 @@ public:
 
     void update(const FeatureStates&, const GeometryTileLayer&, const std::string&, const ImagePositions&) override;
 
+    void compactPaintAttributes() override;
+
 #if MLN_USE_FILL_EXTRUSION_INSTANCING
     static FillExtrusionLayoutVertex layoutVertex(Point<int16_t> p, uint16_t edgeDistance, bool isDiscarded) {
         return FillExtrusionLayoutVertex{{p.x, p.y},
@@ -89,7 +96,23 @@ public:
 
     SegmentVector triangleSegments;
 
+    /// Footprints narrower than this, in tile units, have their walls in the level of detail triangles
+    static constexpr int16_t lodFootprintExtent = 256;
+
+    /// Walls that can be left out when the tile is shown small: those of buildings narrower than
+    /// `lodFootprintExtent` and those against a building laid out earlier, which merge into one
+    /// block from afar. Their segments match `triangleSegments` one to one, sharing the vertices.
+    /// Always empty with instanced extrusions, whose walls are generated from the outlines.
+    const std::shared_ptr<TriangleIndexVector> sharedLodTriangles = std::make_shared<TriangleIndexVector>();
+    TriangleIndexVector& lodTriangles = *sharedLodTriangles;
+
+    SegmentVector lodTriangleSegments;
+
     std::unordered_map<std::string, FillExtrusionBinders> paintPropertyBinders;
+
+private:
+    // Wall edges laid out so far, as ring ordered endpoints, released on upload
+    std::unordered_set<uint64_t> layoutEdges;
 };
 
 } // namespace mbgl
@@ -32,63 +32,82 @@ bool HeatmapBucket::hasData() const {
     return !segments.empty();
 }
 
+MemoryUsage HeatmapBucket::getMemoryUsage() const {
+    return vertices.getMemoryUsage() + triangles.getMemoryUsage() +
+           MemoryUsage{.cpu = segments.capacity() * sizeof(SegmentBase)};
+}
+
 void HeatmapBucket::addFeature(const GeometryTileFeature& feature,
                                const GeometryCollection& geometry,
                                const ImagePositions&,
                                const PatternLayerMap&,
                                std::size_t featureIndex,
                                const CanonicalTileID& canonical) {
-    constexpr const uint16_t vertexLength = 4;
+    for (const auto& points : geometry) {
+        addPoints(points);
+    }
 
-    for (auto& points : geometry) {
-        for (auto& point : points) {
-            auto x = point.x;
-            auto y = point.y;
-
-            // Do not include points that are outside the tile boundaries.
-            if (x < 0 || x >= util::EXTENT || y < 0 || y >= util::EXTENT) {
-                continue;
-            }
-
-            if (segments.empty() ||
-                segments.back().vertexLength + vertexLength > std::numeric_limits<uint16_t>::max()) {
-                // Move to a new segments because the old one can't hold the geometry.
-                segments.emplace_back(vertices.elements(), triangles.elements());
-            }
-
-            // this geometry will be of the Point type, and we'll derive
-            // two triangles from it.
-            //
-            // ┌─────────┐
-            // │ 4     3 │
-            // │         │
-            // │ 1     2 │
-            // └─────────┘
-            //
-            vertices.emplace_back(HeatmapBucket::vertex(point, -1, -1)); // 1
-            vertices.emplace_back(HeatmapBucket::vertex(point, 1, -1));  // 2
-            vertices.emplace_back(HeatmapBucket::vertex(point, 1, 1));   // 3
-            vertices.emplace_back(HeatmapBucket::vertex(point, -1, 1));  // 4
-
-            auto& segment = segments.back();
-            assert(segment.vertexLength <= std::numeric_limits<uint16_t>::max());
-            const auto index = static_cast<uint16_t>(segment.vertexLength);
-
-            // 1, 2, 3
-            // 1, 4, 3
-            triangles.emplace_back(index, index + 1, index + 2);
-            triangles.emplace_back(index, index + 3, index + 2);
-
-            segment.vertexLength += vertexLength;
-            segment.indexLength += 6;
-        }
+    for (auto& pair : paintPropertyBinders) {
+        pair.second.populateVertexVectors(feature, vertices.elements(), featureIndex, {}, {}, canonical);
     }
+}
+
+void HeatmapBucket::addPointFeature(const GeometryTileFeature& feature,
+                                    std::span<const GeometryCoordinate> points,
+                                    std::size_t featureIndex,
+                                    const CanonicalTileID& canonical) {
+    addPoints(points);
 
     for (auto& pair : paintPropertyBinders) {
         pair.second.populateVertexVectors(feature, vertices.elements(), featureIndex, {}, {}, canonical);
     }
 }
 
+void HeatmapBucket::addPoints(std::span<const GeometryCoordinate> points) {
+    constexpr const uint16_t vertexLength = 4;
+
+    for (const auto& point : points) {
+        auto x = point.x;
+        auto y = point.y;
+
+        // Do not include points that are outside the tile boundaries.
+        if (x < 0 || x >= util::EXTENT || y < 0 || y >= util::EXTENT) {
+            continue;
+        }
+
+        if (segments.empty() || segments.back().vertexLength + vertexLength > std::numeric_limits<uint16_t>::max()) {
+            // Move to a new segments because the old one can't hold the geometry.
+            segments.emplace_back(vertices.elements(), triangles.elements());
+        }
+
+        // this geometry will be of the Point type, and we'll derive
+        // two triangles from it.
+        //
+        // ┌─────────┐
+        // │ 4     3 │
+        // │         │
+        // │ 1     2 │
+        // └─────────┘
+        //
+        vertices.emplace_back(HeatmapBucket::vertex(point, -1, -1)); // 1
+        vertices.emplace_back(HeatmapBucket::vertex(point, 1, -1));  // 2
+        vertices.emplace_back(HeatmapBucket::vertex(point, 1, 1));   // 3
+        vertices.emplace_back(HeatmapBucket::vertex(point, -1, 1));  // 4
+
+        auto& segment = segments.back();
+        assert(segment.vertexLength <= std::numeric_limits<uint16_t>::max());
+        const auto index = static_cast<uint16_t>(segment.vertexLength);
+
+        // 1, 2, 3
+        // 1, 4, 3
+        triangles.emplace_back(index, index + 1, index + 2);
+        triangles.emplace_back(index, index + 3, index + 2);
+
+        segment.vertexLength += vertexLength;
+        segment.indexLength += 6;
+    }
+}
+
 float HeatmapBucket::getQueryRadius(const RenderLayer& layer) const {
     (void)layer;
     return 0;
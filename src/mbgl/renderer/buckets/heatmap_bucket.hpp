@@ -28,7 +28,12 @@ public:
                     const PatternLayerMap&,
                     std::size_t,
                     const CanonicalTileID&) override;
+    void addPointFeature(const GeometryTileFeature&,
+                         std::span<const GeometryCoordinate>,
+                         std::size_t,
+                         const CanonicalTileID&) override;
     bool hasData() const override;
+    MemoryUsage getMemoryUsage() const override;
 
     void upload(gfx::UploadPass&) override;
 
@@ -62,6 +67,9 @@ public:
     std::map<std::string, HeatmapBinders> paintPropertyBinders;
 
     const MapMode mode;
+
+private:
+    void addPoints(std::span<const GeometryCoordinate>);
 };
 
 } // namespace mbgl
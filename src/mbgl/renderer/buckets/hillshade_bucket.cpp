@@ -107,4 +107,15 @@ bool HillshadeBucket::hasData() const {
     return demdata.getImage()->valid();
 }
 
+MemoryUsage HillshadeBucket::getMemoryUsage() const {
+    auto usage = vertices.getMemoryUsage() + indices.getMemoryUsage();
+    if (const auto* image = demdata.getImage()) {
+        usage.cpu += image->bytes();
+        if (uploaded) {
+            usage.gpu += image->bytes();
+        }
+    }
+    return usage;
+}
+
 } // namespace mbgl
@@ -14,6 +14,11 @@
 
 namespace mbgl {
 
+namespace gfx {
+class Texture2D;
+using Texture2DPtr = std::shared_ptr<Texture2D>;
+} // namespace gfx
+
 using HillshadeBinders = PaintPropertyBinders<style::HillshadePaintProperties::DataDrivenProperties>;
 using HillshadeLayoutVertex = gfx::Vertex<TypeList<attributes::pos, attributes::texture_pos>>;
 
@@ -26,11 +31,16 @@ public:
 
     void upload(gfx::UploadPass&) override;
     bool hasData() const override;
+    MemoryUsage getMemoryUsage() const override;
 
     void clear();
     void setMask(TileMask&&);
 
+    /// The prepared slope texture, shared by every hillshade layer of the source
     RenderTargetPtr renderTarget;
+    /// The DEM texture read by the prepare pass
+    gfx::Texture2DPtr demTexture;
+    /// Cleared when the DEM data changes after the render target was prepared
     bool renderTargetPrepared = false;
 
     TileMask mask{{0, 0, 0}};
@@ -137,6 +137,16 @@ bool LineBucket::hasData() const {
     return !segments.empty();
 }
 
+MemoryUsage LineBucket::getMemoryUsage() const {
+    return vertices.getMemoryUsage() + triangles.getMemoryUsage() +
+           MemoryUsage{.cpu = segments.capacity() * sizeof(SegmentBase)};
+}
+
+void LineBucket::discardUploadedData() {
+    vertices.discardUploadedData();
+    triangles.discardUploadedData();
+}
+
 namespace {
 template <class Property>
 float get(const LinePaintProperties::PossiblyEvaluated& evaluated,
@@ -177,4 +187,10 @@ void LineBucket::update(const FeatureStates& states,
     }
 }
 
+void LineBucket::compactPaintAttributes() {
+    for (auto& pair : paintPropertyBinders) {
+        pair.second.compactVertexVectors();
+    }
+}
+
 } // namespace mbgl
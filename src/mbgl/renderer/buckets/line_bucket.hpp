@@ -34,6 +34,9 @@ public:
                     const CanonicalTileID&) override;
 
     bool hasData() const override;
+    MemoryUsage getMemoryUsage() const override;
+
+    void discardUploadedData() override;
 
     void upload(gfx::UploadPass&) override;
 
@@ -41,6 +44,8 @@ public:
 
     void update(const FeatureStates&, const GeometryTileLayer&, const std::string&, const ImagePositions&) override;
 
+    void compactPaintAttributes() override;
+
     /*
      * @param p vertex position
      * @param e extrude normal
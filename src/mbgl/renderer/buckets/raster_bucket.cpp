@@ -1,5 +1,6 @@
 #include <mbgl/renderer/buckets/raster_bucket.hpp>
 #include <mbgl/renderer/layers/render_raster_layer.hpp>
+#include <mbgl/gfx/texture2d.hpp>
 #include <mbgl/gfx/upload_pass.hpp>
 
 namespace mbgl {
@@ -12,6 +13,9 @@ RasterBucket::RasterBucket(PremultipliedImage&& image_)
 RasterBucket::RasterBucket(std::shared_ptr<PremultipliedImage> image_)
     : image(std::move(image_)) {}
 
+RasterBucket::RasterBucket(CompressedImage&& image_)
+    : compressedImage(std::make_shared<const CompressedImage>(std::move(image_))) {}
+
 RasterBucket::~RasterBucket() {
     clear();
     setImage({});
@@ -36,6 +40,7 @@ void RasterBucket::clear() {
 
 void RasterBucket::setImage(std::shared_ptr<PremultipliedImage> image_) {
     image = std::move(image_);
+    compressedImage.reset();
     texture2d.reset();
     uploaded = false;
 }
@@ -102,7 +107,21 @@ void RasterBucket::setMask(TileMask&& mask_) {
 }
 
 bool RasterBucket::hasData() const {
-    return !!image;
+    return image || compressedImage;
+}
+
+MemoryUsage RasterBucket::getMemoryUsage() const {
+    auto usage = vertices.getMemoryUsage() + indices.getMemoryUsage();
+    if (image) {
+        usage.cpu += image->bytes();
+    }
+    if (compressedImage) {
+        usage.cpu += compressedImage->bytes();
+    }
+    if (texture2d) {
+        usage.gpu += texture2d->getDataSize();
+    }
+    return usage;
 }
 
 } // namespace mbgl
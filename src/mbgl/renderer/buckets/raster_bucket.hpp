@@ -7,6 +7,7 @@
 #include <mbgl/renderer/paint_property_binder.hpp>
 #include <mbgl/renderer/tile_mask.hpp>
 #include <mbgl/style/layers/raster_layer_properties.hpp>
+#include <mbgl/util/compressed_image.hpp>
 #include <mbgl/util/image.hpp>
 #include <mbgl/util/mat4.hpp>
 
@@ -27,10 +28,12 @@ class RasterBucket final : public Bucket {
 public:
     RasterBucket(PremultipliedImage&&);
     RasterBucket(std::shared_ptr<PremultipliedImage>);
+    RasterBucket(CompressedImage&&);
     ~RasterBucket() override;
 
     void upload(gfx::UploadPass&) override;
     bool hasData() const override;
+    MemoryUsage getMemoryUsage() const override;
 
     void clear();
     void setImage(std::shared_ptr<PremultipliedImage>);
@@ -41,6 +44,8 @@ public:
     }
 
     std::shared_ptr<PremultipliedImage> image;
+    // Set instead of `image` for tiles delivered in a GPU block-compressed format
+    std::shared_ptr<const CompressedImage> compressedImage;
     gfx::Texture2DPtr texture2d;
     TileMask mask{{0, 0, 0}};
 
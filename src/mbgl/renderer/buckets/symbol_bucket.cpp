@@ -1,3 +1,4 @@
+#include <mbgl/map/transform_state.hpp>
 #include <mbgl/renderer/bucket_parameters.hpp>
 #include <mbgl/renderer/buckets/symbol_bucket.hpp>
 #include <mbgl/renderer/layers/render_symbol_layer.hpp>
@@ -5,8 +6,12 @@
 #include <mbgl/style/layers/symbol_layer_impl.hpp>
 #include <mbgl/text/cross_tile_symbol_index.hpp>
 #include <mbgl/text/placement.hpp>
+#include <mbgl/util/constants.hpp>
+#include <mbgl/util/hash.hpp>
 
 #include <algorithm>
+#include <cmath>
+#include <numeric>
 #include <utility>
 
 namespace mbgl {
@@ -14,6 +19,50 @@ namespace mbgl {
 using namespace style;
 namespace {
 std::atomic<uint32_t> maxBucketInstanceId;
+
+/// The farthest the collision boxes of the symbol reach from its anchor on either axis, in box units
+float collisionReach(const SymbolInstance& symbolInstance) {
+    float reach = 0.0f;
+    const auto addFeature = [&](const CollisionFeature& feature) {
+        for (const CollisionBox& box : feature.boxes) {
+            reach = std::max({reach, std::abs(box.x1), std::abs(box.y1), std::abs(box.x2), std::abs(box.y2)});
+        }
+    };
+    addFeature(symbolInstance.getTextCollisionFeature());
+    addFeature(symbolInstance.getIconCollisionFeature());
+    if (const auto& feature = symbolInstance.getVerticalTextCollisionFeature()) addFeature(*feature);
+    if (const auto& feature = symbolInstance.getVerticalIconCollisionFeature()) addFeature(*feature);
+
+    // Variable anchors shift the text, and an icon fit to it, by up to half the text box plus the anchor's offset
+    // on each axis, see calculateVariableLayoutOffset(). Rotated with the map, the shift may fall on either axis.
+    const auto& variableOffsets = symbolInstance.getTextVariableAnchorOffset();
+    if (variableOffsets && !variableOffsets->empty()) {
+        float shift = 0.0f;
+        const auto addShift = [&](const CollisionFeature& feature) {
+            if (!feature.boxes.empty()) {
+                const CollisionBox& box = feature.boxes.front();
+                shift = std::max(shift, (box.x2 - box.x1 + box.y2 - box.y1) / 2.0f);
+            }
+        };
+        addShift(symbolInstance.getTextCollisionFeature());
+        if (const auto& feature = symbolInstance.getVerticalTextCollisionFeature()) addShift(*feature);
+        float offset = 0.0f;
+        for (const auto& anchorOffset : *variableOffsets) {
+            offset = std::max(offset, std::abs(anchorOffset.offset[0]) + std::abs(anchorOffset.offset[1]));
+        }
+        reach += shift + offset * symbolInstance.getTextBoxScale();
+    }
+    return reach;
+}
+
+std::size_t cullingCellIndex(Point<float> anchor) {
+    constexpr float cellSize = static_cast<float>(util::EXTENT) / SymbolBucket::cullingGridSize;
+    const auto axis = [](float coordinate) {
+        return static_cast<std::size_t>(
+            std::clamp(coordinate / cellSize, 0.0f, static_cast<float>(SymbolBucket::cullingGridSize - 1)));
+    };
+    return axis(anchor.y) * SymbolBucket::cullingGridSize + axis(anchor.x);
+}
 } // namespace
 
 std::unique_ptr<SymbolSizeBinder> SymbolSizeBinder::create(const float tileZoom,
@@ -71,6 +120,22 @@ SymbolBucket::SymbolBucket(Immutable<style::SymbolLayoutProperties::PossiblyEval
       bucketInstanceId(++maxBucketInstanceId),
       allowVerticalPlacement(allowVerticalPlacement_),
       placementModes(std::move(placementModes_)) {
+    placementFields.anchors.reserve(symbolInstances.size());
+    placementFields.dataFeatureIndexes.reserve(symbolInstances.size());
+    placementFields.cells.reserve(symbolInstances.size());
+    for (const SymbolInstance& symbolInstance : symbolInstances) {
+        const Point<float> anchor = symbolInstance.getAnchor().point;
+        placementFields.anchors.push_back(anchor);
+        placementFields.dataFeatureIndexes.push_back(symbolInstance.getDataFeatureIndex());
+
+        const std::size_t cellIndex = cullingCellIndex(anchor);
+        placementFields.cells.push_back(static_cast<uint8_t>(cellIndex));
+        CullingCell& cell = cullingCells[cellIndex];
+        cell.min = {std::min(cell.min.x, anchor.x), std::min(cell.min.y, anchor.y)};
+        cell.max = {std::max(cell.max.x, anchor.x), std::max(cell.max.y, anchor.y)};
+        cell.reach = std::max(cell.reach, collisionReach(symbolInstance));
+    }
+
     for (const auto& pair : paintProperties_) {
         const auto& evaluated = getEvaluated<SymbolLayerProperties>(pair.second);
         paintProperties.emplace(std::piecewise_construct,
@@ -96,6 +161,40 @@ bool SymbolBucket::hasData() const {
            hasTextCollisionBoxData() || hasIconCollisionCircleData() || hasTextCollisionCircleData();
 }
 
+MemoryUsage SymbolBucket::getMemoryUsage() const {
+    MemoryUsage usage{.cpu = symbolInstances.capacity() * sizeof(SymbolInstance) +
+                             placementFields.anchors.capacity() * sizeof(Point<float>) +
+                             placementFields.dataFeatureIndexes.capacity() * sizeof(std::size_t) +
+                             placementFields.crossTileIDs.capacity() * sizeof(uint32_t) +
+                             placementFields.cells.capacity() * sizeof(uint8_t)};
+    for (const Buffer* buffer : {&text, &icon, &sdfIcon}) {
+        usage += buffer->vertices().getMemoryUsage();
+        usage += buffer->dynamicVertices().getMemoryUsage();
+        usage += buffer->opacityVertices().getMemoryUsage();
+        usage += buffer->triangles.getMemoryUsage();
+        usage.cpu += buffer->segments.capacity() * sizeof(SegmentBase) +
+                     buffer->placedSymbols.capacity() * sizeof(PlacedSymbol);
+    }
+    const auto addCollision = [&](const CollisionBuffer& buffer) {
+        usage += buffer.vertices().getMemoryUsage();
+        usage += buffer.dynamicVertices().getMemoryUsage();
+        usage.cpu += buffer.segments.capacity() * sizeof(SegmentBase);
+    };
+    for (const auto* buffer : {iconCollisionBox.get(), textCollisionBox.get()}) {
+        if (buffer) {
+            addCollision(*buffer);
+            usage += buffer->lines.getMemoryUsage();
+        }
+    }
+    for (const auto* buffer : {iconCollisionCircle.get(), textCollisionCircle.get()}) {
+        if (buffer) {
+            addCollision(*buffer);
+            usage += buffer->triangles.getMemoryUsage();
+        }
+    }
+    return usage;
+}
+
 bool SymbolBucket::hasTextData() const {
     return !text.segments.empty();
 }
@@ -207,20 +306,42 @@ void SymbolBucket::sortFeatures(const float angle) {
 }
 
 SymbolInstanceReferences SymbolBucket::getSortedSymbols(const float angle) const {
-    SymbolInstanceReferences result(symbolInstances.begin(), symbolInstances.end());
+    std::lock_guard<std::mutex> lock(sortedSymbolsMutex);
+    if (sortedSymbolsAngle == angle && sortedSymbols.size() == symbolInstances.size()) {
+        return sortedSymbols;
+    }
+
+    // The rotated positions are computed once from the packed anchors, the comparisons only read two arrays
     const float sin = std::sin(angle);
     const float cos = std::cos(angle);
+    const auto& anchors = placementFields.anchors;
+    const auto& dataFeatureIndexes = placementFields.dataFeatureIndexes;
+    std::vector<long> rotated(anchors.size());
+    for (std::size_t i = 0; i < anchors.size(); ++i) {
+        rotated[i] = std::lround(sin * anchors[i].x + cos * anchors[i].y);
+    }
+    const auto compare = [&](uint32_t a, uint32_t b) {
+        if (rotated[a] != rotated[b]) {
+            return rotated[a] < rotated[b];
+        }
+        return dataFeatureIndexes[a] > dataFeatureIndexes[b]; // rotated[a] == rotated[b]
+    };
 
-    std::ranges::sort(result, [sin, cos](const SymbolInstance& a, const SymbolInstance& b) {
-        const auto aRotated = std::lround(sin * a.getAnchor().point.x + cos * a.getAnchor().point.y);
-        const auto bRotated = std::lround(sin * b.getAnchor().point.x + cos * b.getAnchor().point.y);
-        if (aRotated != bRotated) {
-            return aRotated < bRotated;
+    // A small rotation rarely changes the order, checking that is linear where sorting is not
+    if (sortedSymbolIndexes.size() != symbolInstances.size() || !std::ranges::is_sorted(sortedSymbolIndexes, compare)) {
+        sortedSymbolIndexes.resize(symbolInstances.size());
+        std::iota(sortedSymbolIndexes.begin(), sortedSymbolIndexes.end(), 0u);
+        std::ranges::sort(sortedSymbolIndexes, compare);
+
+        sortedSymbols.clear();
+        sortedSymbols.reserve(sortedSymbolIndexes.size());
+        for (const auto index : sortedSymbolIndexes) {
+            sortedSymbols.emplace_back(symbolInstances[index]);
         }
-        return a.getDataFeatureIndex() > b.getDataFeatureIndex(); // aRotated == bRotated
-    });
+    }
+    sortedSymbolsAngle = angle;
 
-    return result;
+    return sortedSymbols;
 }
 
 SymbolInstanceReferences SymbolBucket::getSymbols(const std::optional<SortKeyRange>& range) const {
@@ -281,6 +402,13 @@ bool SymbolBucket::hasVariableTextAnchors() const {
 std::pair<uint32_t, bool> SymbolBucket::registerAtCrossTileIndex(CrossTileSymbolLayerIndex& index,
                                                                  const RenderTile& renderTile) {
     bool firstTimeAdded = index.addBucket(renderTile.getOverscaledTileID(), renderTile.matrix, *this);
+    if (firstTimeAdded) {
+        // The index only assigns cross-tile IDs when it adds the bucket
+        placementFields.crossTileIDs.resize(symbolInstances.size());
+        for (std::size_t i = 0; i < symbolInstances.size(); ++i) {
+            placementFields.crossTileIDs[i] = symbolInstances[i].getCrossTileID();
+        }
+    }
     return std::make_pair(bucketInstanceId, firstTimeAdded);
 }
 
@@ -288,6 +416,22 @@ void SymbolBucket::place(Placement& placement, const BucketPlacementData& data,
     placement.placeSymbolBucket(data, seenIds);
 }
 
+namespace {
+// Everything about the camera that line labels are projected with, see `reprojectLineLabels`
+std::size_t lineLabelProjectionKey(const TransformState& state, const RenderTile& tile) {
+    std::size_t seed = util::hash(state.getZoom(),
+                                  state.getBearing(),
+                                  state.getPitch(),
+                                  state.getCameraToCenterDistance(),
+                                  state.getSize().width,
+                                  state.getSize().height);
+    for (const auto value : tile.matrix) {
+        util::hash_combine(seed, value);
+    }
+    return seed;
+}
+} // namespace
+
 void SymbolBucket::updateVertices(const Placement& placement,
                                   bool updateOpacities,
                                   const TransformState& state,
@@ -299,7 +443,16 @@ void SymbolBucket::updateVertices(const Placement& placement,
         uploaded = false;
     }
 
-    if (placement.updateBucketDynamicVertices(*this, state, tile)) {
+    // Line labels are reprojected on every frame, but while the camera is still and the placement hasn't
+    // changed which of them are hidden, the vertices from the previous frame are still valid and uploaded.
+    std::optional<std::size_t> projection;
+    if (layout->get<style::SymbolPlacement>() != style::SymbolPlacementType::Point) {
+        projection = lineLabelProjectionKey(state, tile);
+    }
+    const bool reproject = updateOpacities || !projection || projection != lineLabelProjection;
+    lineLabelProjection = projection;
+
+    if (reproject && placement.updateBucketDynamicVertices(*this, state, tile)) {
         dynamicUploaded = false;
         uploaded = false;
     }
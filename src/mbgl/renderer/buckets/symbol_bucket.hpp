@@ -12,7 +12,9 @@
 #include <mbgl/style/layers/symbol_layer_properties.hpp>
 #include <mbgl/text/glyph_range.hpp>
 
+#include <array>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 namespace mbgl {
@@ -228,6 +230,7 @@ public:
 
     void upload(gfx::UploadPass&) override;
     bool hasData() const override;
+    MemoryUsage getMemoryUsage() const override;
     std::pair<uint32_t, bool> registerAtCrossTileIndex(CrossTileSymbolLayerIndex&, const RenderTile&) override;
     void place(Placement&, const BucketPlacementData&, std::set<uint32_t>&) override;
     void updateVertices(
@@ -244,6 +247,7 @@ public:
 
     void sortFeatures(float angle);
     // Returns references to the `symbolInstances` items, sorted by viewport Y.
+    // The order is cached and reused while it remains sorted for the given angle.
     SymbolInstanceReferences getSortedSymbols(float angle) const;
     // Returns references to the `symbolInstances` items, which belong to the
     // `sortKeyRange` range; returns references to all the symbols if
@@ -310,6 +314,33 @@ public:
     std::vector<SymbolInstance> symbolInstances;
     const std::vector<SortKeyRange> sortKeyRanges;
 
+    // The fields of `symbolInstances` that sorting and placement read for every symbol, one array each and in the
+    // same order, so that walking them doesn't pull whole symbol instances into the cache
+    struct PlacementFields {
+        std::vector<Point<float>> anchors;
+        std::vector<std::size_t> dataFeatureIndexes;
+        // Copied from the symbol instances once the bucket is added to the cross-tile index, empty before
+        std::vector<uint32_t> crossTileIDs;
+        // Index into `cullingCells` of the cell each symbol's anchor falls in
+        std::vector<uint8_t> cells;
+    };
+    PlacementFields placementFields;
+
+    // The tile split into `cullingGridSize` x `cullingGridSize` cells by symbol anchor, so that placement can skip
+    // the symbols of the cells projected outside the collision grid without projecting each of them
+    static constexpr std::size_t cullingGridSize = 8;
+    struct CullingCell {
+        // Bounds of the anchors in the cell, in tile units, inverted while the cell is empty
+        Point<float> min{std::numeric_limits<float>::max(), std::numeric_limits<float>::max()};
+        Point<float> max{std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest()};
+        // The farthest any collision box of the cell's symbols reaches from its anchor, on either axis and for
+        // any variable anchor, in the units of the collision boxes
+        float reach = 0.0f;
+
+        bool empty() const { return min.x > max.x; }
+    };
+    std::array<CullingCell, cullingGridSize * cullingGridSize> cullingCells;
+
     struct PaintProperties {
         SymbolIconBinders iconBinders;
         SymbolTextBinders textBinders;
@@ -441,7 +472,18 @@ public:
     const std::vector<style::TextWritingModeType> placementModes;
     mutable std::optional<bool> hasFormatSectionOverrides_;
 
+    // Camera the line labels' dynamic vertices were last projected for
+    std::optional<std::size_t> lineLabelProjection;
+
     FeatureSortOrder featureSortOrder;
+
+private:
+    // Symbols sorted by viewport Y at `sortedSymbolsAngle`, shared by placement and `sortFeatures`.
+    // Placement may sort the buckets of several layers at once, and layers can share a bucket.
+    mutable std::mutex sortedSymbolsMutex;
+    mutable std::vector<uint32_t> sortedSymbolIndexes;
+    mutable SymbolInstanceReferences sortedSymbols;
+    mutable float sortedSymbolsAngle = std::numeric_limits<float>::max();
 };
 
 } // namespace mbgl
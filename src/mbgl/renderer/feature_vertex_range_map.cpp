@@ -0,0 +1,115 @@
+#include <mbgl/renderer/feature_vertex_range_map.hpp>
+#include <mbgl/util/string.hpp>
+
+#include <charconv>
+#include <limits>
+
+namespace mbgl {
+
+void FeatureVertexRangeMap::add(const FeatureIdentifier& id, const FeatureVertexRange& range) {
+    const auto featureSlot = id.match(
+        [&](uint64_t value) -> std::optional<uint32_t> {
+            if (value <= static_cast<uint64_t>(std::numeric_limits<int64_t>::max())) {
+                return slot(static_cast<int64_t>(value));
+            }
+            return slot(util::toString(value));
+        },
+        [&](int64_t value) -> std::optional<uint32_t> { return slot(value); },
+        [&](double value) -> std::optional<uint32_t> { return slot(util::toString(value)); },
+        [&](const std::string& value) -> std::optional<uint32_t> { return slot(value); },
+        [](const auto&) -> std::optional<uint32_t> { return std::nullopt; });
+    if (featureSlot) {
+        pending.push_back({*featureSlot, range});
+    }
+}
+
+std::span<const FeatureVertexRange> FeatureVertexRangeMap::find(const std::string& id) {
+    if (!pending.empty()) {
+        index();
+    }
+
+    std::optional<uint32_t> featureSlot;
+    if (const auto integer = integerID(id)) {
+        if (const auto it = integerSlots.find(*integer); it != integerSlots.end()) {
+            featureSlot = it->second;
+        }
+    } else if (const auto it = stringSlots.find(id); it != stringSlots.end()) {
+        featureSlot = it->second;
+    }
+    if (!featureSlot) {
+        return {};
+    }
+    return {ranges.data() + offsets[*featureSlot], ranges.data() + offsets[*featureSlot + 1]};
+}
+
+void FeatureVertexRangeMap::clear() {
+    integerSlots.clear();
+    stringSlots.clear();
+    ranges.clear();
+    offsets.assign(1, 0);
+    pending.clear();
+}
+
+std::optional<int64_t> FeatureVertexRangeMap::integerID(std::string_view id) {
+    // Leading zeros and "-0" aren't what an integer converts to, so such IDs remain strings
+    const bool negative = !id.empty() && id.front() == '-';
+    const auto digits = id.substr(negative ? 1 : 0);
+    if (digits.empty() || (digits.front() == '0' && (digits.size() > 1 || negative))) {
+        return std::nullopt;
+    }
+
+    int64_t value = 0;
+    const auto end = id.data() + id.size();
+    const auto result = std::from_chars(id.data(), end, value);
+    if (result.ec != std::errc() || result.ptr != end) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+uint32_t FeatureVertexRangeMap::slot(int64_t id) {
+    const auto next = static_cast<uint32_t>(integerSlots.size() + stringSlots.size());
+    return integerSlots.try_emplace(id, next).first->second;
+}
+
+uint32_t FeatureVertexRangeMap::slot(const std::string& id) {
+    // A string ID matching the string form of an integer ID is the same feature state key
+    if (const auto integer = integerID(id)) {
+        return slot(*integer);
+    }
+    const auto next = static_cast<uint32_t>(integerSlots.size() + stringSlots.size());
+    return stringSlots.try_emplace(id, next).first->second;
+}
+
+void FeatureVertexRangeMap::index() {
+    // Counting sort of the indexed and the pending ranges by slot, keeping the order of each feature's ranges
+    const std::size_t slots = integerSlots.size() + stringSlots.size();
+    std::vector<uint32_t> grouped(slots + 1, 0);
+    for (std::size_t i = 0; i + 1 < offsets.size(); ++i) {
+        grouped[i + 1] = offsets[i + 1] - offsets[i];
+    }
+    for (const auto& added : pending) {
+        grouped[added.slot + 1]++;
+    }
+    for (std::size_t i = 0; i < slots; ++i) {
+        grouped[i + 1] += grouped[i];
+    }
+
+    std::vector<FeatureVertexRange> sorted(ranges.size() + pending.size());
+    std::vector<uint32_t> cursors(grouped.begin(), grouped.end() - 1);
+    for (std::size_t i = 0; i + 1 < offsets.size(); ++i) {
+        for (auto j = offsets[i]; j < offsets[i + 1]; ++j) {
+            sorted[cursors[i]++] = ranges[j];
+        }
+    }
+    for (const auto& added : pending) {
+        sorted[cursors[added.slot]++] = added.range;
+    }
+
+    ranges = std::move(sorted);
+    offsets = std::move(grouped);
+    pending.clear();
+    pending.shrink_to_fit();
+}
+
+} // namespace mbgl
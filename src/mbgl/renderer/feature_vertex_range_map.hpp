@@ -0,0 +1,62 @@
+#pragma once
+
+#include <mbgl/util/feature.hpp>
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace mbgl {
+
+// Maps vertex range to feature index
+struct FeatureVertexRange {
+    std::size_t featureIndex;
+    std::size_t start;
+    std::size_t end;
+};
+
+/**
+ * @brief The vertex ranges of the features of a bucket by feature ID, to update them as the feature state changes.
+ *
+ * Feature states are keyed by the string form of the IDs. IDs whose string form is an integer are kept as
+ * integers, so the numeric IDs of choropleths take neither string allocations nor string hashing, and the
+ * other IDs are kept once each. The ranges are stored contiguously, grouped by feature once looked up.
+ */
+class FeatureVertexRangeMap {
+public:
+    /// Adds a range of the feature with the given ID. Features without an ID are ignored.
+    void add(const FeatureIdentifier&, const FeatureVertexRange&);
+
+    /// The ranges of the feature whose ID has the given string form, in the order they were added
+    std::span<const FeatureVertexRange> find(const std::string& id);
+
+    bool empty() const { return ranges.empty() && pending.empty(); }
+    void clear();
+
+    /// The integer a string converts back to, if it is the string form of one
+    static std::optional<int64_t> integerID(std::string_view);
+
+private:
+    uint32_t slot(int64_t);
+    uint32_t slot(const std::string&);
+    void index();
+
+    struct PendingRange {
+        uint32_t slot;
+        FeatureVertexRange range;
+    };
+
+    std::unordered_map<int64_t, uint32_t> integerSlots;
+    std::unordered_map<std::string, uint32_t> stringSlots;
+    /// The ranges grouped by slot, those of slot `i` starting at `offsets[i]`
+    std::vector<FeatureVertexRange> ranges;
+    std::vector<uint32_t> offsets{0};
+    /// Ranges added since the last lookup
+    std::vector<PendingRange> pending;
+};
+
+} // namespace mbgl
@@ -315,6 +315,15 @@ void ImageManager::dumpDebugLogs() const {
     Log::Info(Event::General, "ImageManager::loaded: " + std::string(loaded ? "1" : "0"));
 }
 
+MemoryUsage ImageManager::getMemoryUsage() const {
+    std::scoped_lock readWriteLock(rwLock);
+    MemoryUsage usage;
+    for (const auto& [id, image] : images) {
+        usage.cpu += image->image.bytes();
+    }
+    return usage;
+}
+
 ImageRequestor::ImageRequestor(std::shared_ptr<ImageManager> imageManager_)
     : imageManager(std::move(imageManager_)) {}
 
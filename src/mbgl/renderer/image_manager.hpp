@@ -2,6 +2,7 @@
 
 #include <mbgl/style/image_impl.hpp>
 #include <mbgl/util/immutable.hpp>
+#include <mbgl/util/memory_usage.hpp>
 
 #include <map>
 #include <memory>
@@ -39,6 +40,9 @@ public:
 
     void dumpDebugLogs() const;
 
+    /// Approximate memory held by the images added
+    MemoryUsage getMemoryUsage() const;
+
     const style::Image::Impl* getImage(const std::string&) const;
     const Immutable<style::Image::Impl>* getSharedImage(const std::string&) const;
 
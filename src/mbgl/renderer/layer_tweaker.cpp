@@ -1,12 +1,17 @@
 #include <mbgl/renderer/layer_tweaker.hpp>
 
+#include <mbgl/gfx/context.hpp>
+#include <mbgl/gfx/drawable.hpp>
 #include <mbgl/map/transform_state.hpp>
 #include <mbgl/style/layer_properties.hpp>
+#include <mbgl/renderer/layer_group.hpp>
+#include <mbgl/renderer/paint_parameters.hpp>
 #include <mbgl/renderer/render_tree.hpp>
 #include <mbgl/renderer/render_tile.hpp>
 #include <mbgl/shaders/layer_ubo.hpp>
 #include <mbgl/util/mat4.hpp>
 #include <mbgl/util/containers.hpp>
+#include <mbgl/util/hash.hpp>
 
 #if MLN_RENDER_BACKEND_METAL
 #include <mbgl/util/monotonic_timer.hpp>
@@ -15,6 +20,19 @@
 
 namespace mbgl {
 
+namespace {
+
+// Whether the projection of the drawable is offset in depth for its layer and sublayer
+bool hasDepthOffset([[maybe_unused]] const gfx::Drawable& drawable) {
+#if MLN_RENDER_BACKEND_OPENGL
+    return false;
+#else
+    return !drawable.getIs3D() && drawable.getEnableDepth();
+#endif
+}
+
+} // namespace
+
 LayerTweaker::LayerTweaker(std::string id_, Immutable<style::LayerProperties> properties)
     : id(std::move(id_)),
       evaluatedProperties(std::move(properties)) {}
@@ -25,6 +43,34 @@ bool LayerTweaker::checkTweakDrawable(const gfx::Drawable& drawable) const {
     return !tweaker || tweaker.get() == this;
 }
 
+bool LayerTweaker::drawableInputsUnchanged(LayerGroupBase& layerGroup,
+                                           const PaintParameters& parameters,
+                                           std::size_t seed) {
+    const auto& transform = parameters.transformParams;
+    std::size_t hash = util::hash(seed, parameters.state.getZoom(), parameters.currentLayer);
+    for (const auto* matrix : {&transform.projMatrix, &transform.nearClippedProjMatrix, &transform.alignedProjMatrix}) {
+        for (const auto value : *matrix) {
+            util::hash_combine(hash, value);
+        }
+    }
+    // The drawables, their order giving their UBO indexes
+    visitLayerGroupDrawables(layerGroup, [&](const gfx::Drawable& drawable) {
+        util::hash_combine(hash,
+                           util::hash(drawable.getID().id(),
+                                      drawable.getRenderTile(),
+                                      drawable.getSubLayerIndex(),
+                                      drawable.getEnableDepth(),
+                                      drawable.getIs3D()));
+    });
+
+    const bool unchanged = !propertiesUpdated && drawableInputsHash == hash;
+    drawableInputsHash = hash;
+    if (unchanged) {
+        parameters.context.renderingStats().numSkippedTweakerUpdates++;
+    }
+    return unchanged;
+}
+
 mat4 LayerTweaker::getTileMatrix(const UnwrappedTileID& tileID,
                                  const PaintParameters& parameters,
                                  const std::array<float, 2>& translation,
@@ -35,11 +81,17 @@ mat4 LayerTweaker::getTileMatrix(const UnwrappedTileID& tileID,
                                  bool aligned) {
     // from RenderTile::prepare
     mat4 tileMatrix;
-    parameters.state.matrixFor(/*out*/ tileMatrix, tileID);
-    if (const auto& origin{drawable.getOrigin()}; origin.has_value()) {
-        matrix::translate(tileMatrix, tileMatrix, origin->x, origin->y, 0);
+    const auto& origin{drawable.getOrigin()};
+    if (!origin && !hasDepthOffset(drawable)) {
+        // the same for all the layers of the tile
+        tileMatrix = parameters.projectedTileMatrix(tileID, nearClipped, aligned);
+    } else {
+        tileMatrix = parameters.tileMatrix(tileID);
+        if (origin) {
+            matrix::translate(tileMatrix, tileMatrix, origin->x, origin->y, 0);
+        }
+        multiplyWithProjectionMatrix(/*in-out*/ tileMatrix, parameters, drawable, nearClipped, aligned);
     }
-    multiplyWithProjectionMatrix(/*in-out*/ tileMatrix, parameters, drawable, nearClipped, aligned);
     return RenderTile::translateVtxMatrix(
         tileID, tileMatrix, translation, anchor, parameters.state, inViewportPixelUnits);
 }
@@ -51,17 +103,16 @@ void LayerTweaker::updateProperties(Immutable<style::LayerProperties> newProps)
 
 void LayerTweaker::multiplyWithProjectionMatrix(/*in-out*/ mat4& matrix,
                                                 const PaintParameters& parameters,
-                                                [[maybe_unused]] const gfx::Drawable& drawable,
+                                                const gfx::Drawable& drawable,
                                                 bool nearClipped,
                                                 bool aligned) {
     // nearClippedMatrix has near plane moved further, to enhance depth buffer precision
     const auto& projMatrixRef = aligned ? parameters.transformParams.alignedProjMatrix
                                         : (nearClipped ? parameters.transformParams.nearClippedProjMatrix
                                                        : parameters.transformParams.projMatrix);
-#if !MLN_RENDER_BACKEND_OPENGL
     // If this drawable is participating in depth testing, offset the
     // projection matrix NDC depth range for the drawable's layer and sublayer.
-    if (!drawable.getIs3D() && drawable.getEnableDepth()) {
+    if (hasDepthOffset(drawable)) {
         // copy and adjust the projection matrix
         mat4 projMatrix = projMatrixRef;
         projMatrix[14] -= ((1 + parameters.currentLayer) * PaintParameters::numSublayers -
@@ -72,7 +123,6 @@ void LayerTweaker::multiplyWithProjectionMatrix(/*in-out*/ mat4& matrix,
         // early return
         return;
     }
-#endif
     matrix::multiply(matrix, projMatrixRef, matrix);
 }
 
@@ -10,6 +10,7 @@
 #include <mbgl/shaders/shader_source.hpp>
 #include <mbgl/style/layers/circle_layer_properties.hpp>
 #include <mbgl/util/convert.hpp>
+#include <mbgl/util/hash.hpp>
 
 #if MLN_RENDER_BACKEND_METAL
 #include <mbgl/shaders/mtl/circle.hpp>
@@ -38,6 +39,8 @@ void CircleLayerTweaker::execute(LayerGroupBase& layerGroup, const PaintParamete
     const auto zoom = static_cast<float>(parameters.state.getZoom());
     const bool pitchWithMap = evaluated.get<CirclePitchAlignment>() == AlignmentType::Map;
     const bool scaleWithMap = evaluated.get<CirclePitchScale>() == CirclePitchScaleType::Map;
+    const bool drawablesUnchanged = drawableInputsUnchanged(
+        layerGroup, parameters, util::hash(parameters.pixelsToGLUnits[0], parameters.pixelsToGLUnits[1]));
 
     // Updated only with evaluated properties
     if (!evaluatedPropsUniformBuffer || propertiesUpdated) {
@@ -58,6 +61,13 @@ void CircleLayerTweaker::execute(LayerGroupBase& layerGroup, const PaintParamete
     auto& layerUniforms = layerGroup.mutableUniformBuffers();
     layerUniforms.set(idCircleEvaluatedPropsUBO, evaluatedPropsUniformBuffer);
 
+    if (drawablesUnchanged) {
+#if MLN_UBO_CONSOLIDATION
+        layerUniforms.set(idCircleDrawableUBO, drawableUniformBuffer);
+#endif
+        return;
+    }
+
 #if MLN_UBO_CONSOLIDATION
     int i = 0;
     std::vector<CircleDrawableUBO> drawableUBOVector(layerGroup.getDrawableCount());
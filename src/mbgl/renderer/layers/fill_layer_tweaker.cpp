@@ -37,6 +37,8 @@ void FillLayerTweaker::execute(LayerGroupBase& layerGroup, const PaintParameters
     const auto debugGroup = parameters.encoder->createDebugGroup(label.c_str());
 #endif
 
+    const bool drawablesUnchanged = drawableInputsUnchanged(layerGroup, parameters);
+
     if (!evaluatedPropsUniformBuffer || propertiesUpdated) {
         const FillEvaluatedPropsUBO propsUBO = {
             .color = evaluated.get<FillColor>().constantOr(FillColor::defaultValue()),
@@ -52,6 +54,14 @@ void FillLayerTweaker::execute(LayerGroupBase& layerGroup, const PaintParameters
     auto& layerUniforms = layerGroup.mutableUniformBuffers();
     layerUniforms.set(idFillEvaluatedPropsUBO, evaluatedPropsUniformBuffer);
 
+    if (drawablesUnchanged) {
+#if MLN_UBO_CONSOLIDATION
+        layerUniforms.set(idFillDrawableUBO, drawableUniformBuffer);
+        layerUniforms.set(idFillTilePropsUBO, tilePropsUniformBuffer);
+#endif
+        return;
+    }
+
     const auto& translation = evaluated.get<FillTranslate>();
     const auto anchor = evaluated.get<FillTranslateAnchor>();
     const auto zoom = static_cast<float>(parameters.state.getZoom());
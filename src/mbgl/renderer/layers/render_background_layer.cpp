@@ -41,6 +41,7 @@ RenderBackgroundLayer::RenderBackgroundLayer(Immutable<style::BackgroundLayer::I
     : RenderLayer(makeMutable<BackgroundLayerProperties>(std::move(_impl))),
       unevaluated(impl_cast(baseImpl).paint.untransitioned()) {
     styleDependencies = unevaluated.getDependencies();
+    zoomDependent = unevaluated.isZoomDependent();
 }
 
 RenderBackgroundLayer::~RenderBackgroundLayer() = default;
@@ -48,6 +49,7 @@ RenderBackgroundLayer::~RenderBackgroundLayer() = default;
 void RenderBackgroundLayer::transition(const TransitionParameters& parameters) {
     unevaluated = impl_cast(baseImpl).paint.transitioned(parameters, std::move(unevaluated));
     styleDependencies = unevaluated.getDependencies();
+    zoomDependent = unevaluated.isZoomDependent();
 }
 
 void RenderBackgroundLayer::evaluate(const PropertyEvaluationParameters& parameters) {
@@ -111,6 +113,8 @@ void RenderBackgroundLayer::prepare(const LayerPrepareParameters& params) {
 
 static constexpr std::string_view BackgroundPlainShaderName = "BackgroundShader";
 static constexpr std::string_view BackgroundPatternShaderName = "BackgroundPatternShader";
+// Every tile draws the same quad, so the backends can draw them as instances of one another
+static constexpr std::size_t BackgroundInstanceBatchKey = 1;
 
 void RenderBackgroundLayer::update(gfx::ShaderRegistry& shaders,
                                    gfx::Context& context,
@@ -125,7 +129,8 @@ void RenderBackgroundLayer::update(gfx::ShaderRegistry& shaders,
                                             .tileLodMinRadius = updateParameters->tileLodMinRadius,
                                             .tileLodScale = updateParameters->tileLodScale,
                                             .tileLodPitchThreshold = updateParameters->tileLodPitchThreshold,
-                                            .tileLodMode = updateParameters->tileLodMode},
+                                            .tileLodMode = updateParameters->tileLodMode,
+                                            .tileLodMaxTiles = updateParameters->tileLodMaxTiles},
                                            zoom,
                                            zoomRange);
 
@@ -226,6 +231,7 @@ void RenderBackgroundLayer::update(gfx::ShaderRegistry& shaders,
         for (auto& drawable : builder->clearDrawables()) {
             drawable->setTileID(tileID);
             drawable->setLayerTweaker(layerTweaker);
+            drawable->setInstanceBatchKey(BackgroundInstanceBatchKey);
             tileLayerGroup->addDrawable(drawPasses, tileID, std::move(drawable));
             ++stats.drawablesAdded;
         }
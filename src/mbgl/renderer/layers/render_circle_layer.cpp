@@ -5,6 +5,7 @@
 #include <mbgl/gfx/shader_group.hpp>
 #include <mbgl/gfx/shader_registry.hpp>
 #include <mbgl/renderer/buckets/circle_bucket.hpp>
+#include <mbgl/renderer/render_static_data.hpp>
 #include <mbgl/renderer/render_tile.hpp>
 #include <mbgl/renderer/paint_parameters.hpp>
 #include <mbgl/style/layers/circle_layer_impl.hpp>
@@ -37,11 +38,13 @@ RenderCircleLayer::RenderCircleLayer(Immutable<style::CircleLayer::Impl> _impl)
     : RenderLayer(makeMutable<CircleLayerProperties>(std::move(_impl))),
       unevaluated(impl_cast(baseImpl).paint.untransitioned()) {
     styleDependencies = unevaluated.getDependencies();
+    zoomDependent = unevaluated.isZoomDependent();
 }
 
 void RenderCircleLayer::transition(const TransitionParameters& parameters) {
     unevaluated = impl_cast(baseImpl).paint.transitioned(parameters, std::move(unevaluated));
     styleDependencies = unevaluated.getDependencies();
+    zoomDependent = unevaluated.isZoomDependent();
 }
 
 void RenderCircleLayer::evaluate(const PropertyEvaluationParameters& parameters) {
@@ -155,7 +158,11 @@ bool RenderCircleLayer::queryIntersectsFeature(const GeometryCoordinates& queryG
 
 namespace {
 
+#if MLN_USE_CIRCLE_INSTANCING
+constexpr auto CircleShaderGroupName = "CircleInstancedShader";
+#else
 constexpr auto CircleShaderGroupName = "CircleShader";
+#endif
 
 } // namespace
 
@@ -194,6 +201,18 @@ void RenderCircleLayer::update(gfx::ShaderRegistry& shaders,
         return;
     }
 
+#if MLN_USE_CIRCLE_INSTANCING
+    if (!staticDataVertices) {
+        staticDataVertices = std::make_shared<CircleBucket::VertexVector>(RenderStaticData::circleVertices());
+    }
+    if (!staticDataIndices) {
+        staticDataIndices = std::make_shared<TriangleIndexVector>(RenderStaticData::quadTriangleIndices());
+    }
+    if (!staticDataSegments) {
+        staticDataSegments = std::make_shared<SegmentVector>(RenderStaticData::tileTriangleSegments());
+    }
+#endif
+
     std::unique_ptr<gfx::DrawableBuilder> circleBuilder;
     constexpr auto renderPass = RenderPass::Translucent;
 
@@ -217,7 +236,6 @@ void RenderCircleLayer::update(gfx::ShaderRegistry& shaders,
         }
 
         auto& bucket = static_cast<CircleBucket&>(*renderData->bucket);
-        const auto vertexCount = bucket.vertices.elements();
         auto& paintPropertyBinders = bucket.paintPropertyBinders.at(getID());
 
         const auto prevBucketID = getRenderTileBucketID(tileID);
@@ -257,6 +275,26 @@ void RenderCircleLayer::update(gfx::ShaderRegistry& shaders,
             continue;
         }
 
+#if MLN_USE_CIRCLE_INSTANCING
+        // The centers and paint attributes advance per circle, the quad corners per vertex
+        auto circleInstanceAttrs = std::move(circleVertexAttrs);
+        if (const auto& attr = circleInstanceAttrs->set(idCircleCenterAttribute)) {
+            attr->setSharedRawData(bucket.sharedVertices,
+                                   offsetof(CircleLayoutVertex, a1),
+                                   0,
+                                   sizeof(CircleLayoutVertex),
+                                   gfx::AttributeDataType::Short2);
+        }
+
+        circleVertexAttrs = context.createVertexAttributeArray();
+        if (const auto& attr = circleVertexAttrs->set(idCirclePosVertexAttribute)) {
+            attr->setSharedRawData(staticDataVertices,
+                                   offsetof(CircleLayoutVertex, a1),
+                                   0,
+                                   sizeof(CircleLayoutVertex),
+                                   gfx::AttributeDataType::Short2);
+        }
+#else
         if (const auto& attr = circleVertexAttrs->set(idCirclePosVertexAttribute)) {
             attr->setSharedRawData(bucket.sharedVertices,
                                    offsetof(CircleLayoutVertex, a1),
@@ -264,6 +302,7 @@ void RenderCircleLayer::update(gfx::ShaderRegistry& shaders,
                                    sizeof(CircleLayoutVertex),
                                    gfx::AttributeDataType::Short2);
         }
+#endif
 
         circleBuilder = context.createDrawableBuilder("circle");
         circleBuilder->setShader(std::static_pointer_cast<gfx::ShaderProgramBase>(circleShader));
@@ -274,9 +313,16 @@ void RenderCircleLayer::update(gfx::ShaderRegistry& shaders,
         circleBuilder->setRenderPass(renderPass);
         circleBuilder->setVertexAttributes(std::move(circleVertexAttrs));
 
-        circleBuilder->setRawVertices({}, vertexCount, gfx::AttributeDataType::Short2);
+#if MLN_USE_CIRCLE_INSTANCING
+        circleBuilder->setInstanceAttributes(std::move(circleInstanceAttrs));
+        circleBuilder->setRawVertices({}, staticDataVertices->elements(), gfx::AttributeDataType::Short2);
+        circleBuilder->setSegments(
+            gfx::Triangles(), staticDataIndices, staticDataSegments->data(), staticDataSegments->size());
+#else
+        circleBuilder->setRawVertices({}, bucket.vertices.elements(), gfx::AttributeDataType::Short2);
         circleBuilder->setSegments(
             gfx::Triangles(), bucket.sharedTriangles, bucket.segments.data(), bucket.segments.size());
+#endif
 
         circleBuilder->flush(context);
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <mbgl/renderer/render_layer.hpp>
+#include <mbgl/renderer/buckets/circle_bucket.hpp>
 #include <mbgl/style/layers/circle_layer_impl.hpp>
 #include <mbgl/style/layers/circle_layer_properties.hpp>
 
@@ -41,6 +42,15 @@ private:
     style::CirclePaintProperties::Unevaluated unevaluated;
 
     gfx::ShaderGroupPtr circleShaderGroup;
+
+#if MLN_USE_CIRCLE_INSTANCING
+    using TriangleIndexVector = gfx::IndexVector<gfx::Triangles>;
+
+    // The unit quad every circle is an instance of
+    std::shared_ptr<CircleBucket::VertexVector> staticDataVertices;
+    std::shared_ptr<TriangleIndexVector> staticDataIndices;
+    std::shared_ptr<SegmentVector> staticDataSegments;
+#endif
 };
 
 } // namespace mbgl
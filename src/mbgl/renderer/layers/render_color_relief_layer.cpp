@@ -23,6 +23,9 @@
 #include <mbgl/util/premultiply.hpp>
 #include <vector>
 #include <cstring>
+#include <map>
+#include <mutex>
+#include <tuple>
 
 namespace mbgl {
 
@@ -36,12 +39,56 @@ inline const ColorReliefLayer::Impl& impl_cast(const Immutable<Layer::Impl>& imp
     return static_cast<const ColorReliefLayer::Impl&>(*impl);
 }
 
+/// The ramp textures of the color relief layers, shared by the layers of a context drawing the same ramp. Entries
+/// are weak, the textures living as long as some layer uses them.
+class ColorRampTextureCache {
+public:
+    using Textures = std::pair<std::shared_ptr<gfx::Texture2D>, std::shared_ptr<gfx::Texture2D>>;
+
+    static ColorRampTextureCache& getInstance() {
+        static ColorRampTextureCache instance;
+        return instance;
+    }
+
+    /// The elevation stops and color stops textures for the given ramp, created with `create` if no layer of the
+    /// context holds them
+    template <class Create>
+    Textures get(const gfx::Context& context,
+                 const std::vector<float>& elevationStops,
+                 const PremultipliedImage& colorStops,
+                 Create&& create) {
+        const std::vector<uint8_t> colors(colorStops.data.get(), colorStops.data.get() + colorStops.bytes());
+        Key key{&context, elevationStops, colors};
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (const auto it = entries.find(key); it != entries.end()) {
+            Textures textures{it->second.first.lock(), it->second.second.lock()};
+            if (textures.first && textures.second) {
+                return textures;
+            }
+        }
+
+        std::erase_if(entries,
+                      [](const auto& entry) { return entry.second.first.expired() || entry.second.second.expired(); });
+        Textures textures = create();
+        entries.insert_or_assign(std::move(key), std::make_pair(textures.first, textures.second));
+        return textures;
+    }
+
+private:
+    using Key = std::tuple<const gfx::Context*, std::vector<float>, std::vector<uint8_t>>;
+
+    std::mutex mutex;
+    std::map<Key, std::pair<std::weak_ptr<gfx::Texture2D>, std::weak_ptr<gfx::Texture2D>>> entries;
+};
+
 } // namespace
 
 RenderColorReliefLayer::RenderColorReliefLayer(Immutable<ColorReliefLayer::Impl> _impl)
     : RenderLayer(makeMutable<ColorReliefLayerProperties>(std::move(_impl))),
       unevaluated(impl_cast(baseImpl).paint.untransitioned()) {
     styleDependencies = unevaluated.getDependencies();
+    zoomDependent = unevaluated.isZoomDependent();
 
     // Initialize color ramp data with RGBA format (4 floats per stop)
     colorRampSize = 256;
@@ -57,6 +104,7 @@ RenderColorReliefLayer::~RenderColorReliefLayer() = default;
 void RenderColorReliefLayer::transition(const TransitionParameters& parameters) {
     unevaluated = impl_cast(baseImpl).paint.transitioned(parameters, std::move(unevaluated));
     styleDependencies = unevaluated.getDependencies();
+    zoomDependent = unevaluated.isZoomDependent();
     updateColorRamp();
 }
 
@@ -104,6 +152,12 @@ void RenderColorReliefLayer::updateColorRamp() {
         }
     }
 
+    // Transitions of the other properties leave the ramp as it is
+    if (colorValue == colorRampValue) {
+        return;
+    }
+    colorRampValue = colorValue;
+
     std::vector<float> elevationStopsVector;
     std::vector<Color> colorStopsVector;
 
@@ -244,29 +298,33 @@ void RenderColorReliefLayer::update(gfx::ShaderRegistry& shaders,
     const auto staticDataIndices = RenderStaticData::quadTriangleIndices();
     const auto staticDataSegments = RenderStaticData::rasterSegments();
 
-    // Update color ramp textures if changed
+    // Update color ramp textures if changed, taking those of another layer drawing the same ramp
     if (colorRampChanged && elevationStopsData && colorStops) {
-        if (!elevationStopsTexture) {
-            elevationStopsTexture = context.createTexture2D();
-        }
-
-        // Use RGBA32F instead of R32F for llvmpipe compatibility
-        elevationStopsTexture->setFormat(gfx::TexturePixelType::RGBA, gfx::TextureChannelDataType::Float);
-        elevationStopsTexture->upload(elevationStopsData->data(), Size{colorRampSize, 1});
-        elevationStopsTexture->setSamplerConfiguration({.filter = gfx::TextureFilterType::Nearest,
-                                                        .wrapU = gfx::TextureWrapType::Clamp,
-                                                        .wrapV = gfx::TextureWrapType::Clamp});
-
-        if (!colorStopsTexture) {
-            colorStopsTexture = context.createTexture2D();
-        }
-
-        colorStopsTexture->setImage(colorStops);
-        colorStopsTexture->setSamplerConfiguration({.filter = gfx::TextureFilterType::Linear,
-                                                    .wrapU = gfx::TextureWrapType::Clamp,
-                                                    .wrapV = gfx::TextureWrapType::Clamp});
+        std::tie(elevationStopsTexture, colorStopsTexture) = ColorRampTextureCache::getInstance().get(
+            context, *elevationStopsData, *colorStops, [&]() -> ColorRampTextureCache::Textures {
+                auto elevationTexture = context.createTexture2D();
+                auto colorTexture = context.createTexture2D();
+                if (!elevationTexture || !colorTexture) {
+                    return {};
+                }
 
-        colorRampChanged = false;
+                // Use RGBA32F instead of R32F for llvmpipe compatibility
+                elevationTexture->setFormat(gfx::TexturePixelType::RGBA, gfx::TextureChannelDataType::Float);
+                elevationTexture->upload(elevationStopsData->data(), Size{colorRampSize, 1});
+                elevationTexture->setSamplerConfiguration({.filter = gfx::TextureFilterType::Nearest,
+                                                           .wrapU = gfx::TextureWrapType::Clamp,
+                                                           .wrapV = gfx::TextureWrapType::Clamp});
+
+                // Copied, as the image of the layer is rebuilt in place when its ramp changes
+                colorTexture->setImage(std::make_shared<PremultipliedImage>(colorStops->clone()));
+                colorTexture->setSamplerConfiguration({.filter = gfx::TextureFilterType::Linear,
+                                                       .wrapU = gfx::TextureWrapType::Clamp,
+                                                       .wrapV = gfx::TextureWrapType::Clamp});
+                return {std::move(elevationTexture), std::move(colorTexture)};
+            });
+
+        // Tried again next time if the textures couldn't be created
+        colorRampChanged = !elevationStopsTexture || !colorStopsTexture;
     }
 
     // Skip rendering if color ramp textures aren't ready
@@ -48,7 +48,8 @@ private:
     // Paint properties
     style::ColorReliefPaintProperties::Unevaluated unevaluated;
 
-    // Color ramp data
+    // Color ramp data, rebuilt only when the expression changes
+    style::ColorRampPropertyValue colorRampValue;
     uint32_t colorRampSize = 256;
     bool colorRampChanged = true;
 
@@ -57,7 +58,7 @@ private:
 
     std::shared_ptr<PremultipliedImage> colorStops; // RGB colors for each stop
 
-    // GPU textures
+    // GPU textures, shared with the other layers of the context drawing the same ramp
     std::shared_ptr<gfx::Texture2D> elevationStopsTexture;
     std::shared_ptr<gfx::Texture2D> colorStopsTexture;
 
@@ -26,6 +26,8 @@
 #include <mbgl/shaders/fill_extrusion_layer_ubo.hpp>
 #include <mbgl/shaders/shader_program_base.hpp>
 
+#include <cmath>
+
 namespace mbgl {
 
 using namespace style;
@@ -38,12 +40,21 @@ inline const FillExtrusionLayer::Impl& impl_cast(const Immutable<style::Layer::I
     return static_cast<const FillExtrusionLayer::Impl&>(*impl);
 }
 
+const std::string lodSuffix = "LOD";
+
+bool isLodDrawable(const gfx::Drawable& drawable) {
+    const auto& name = drawable.getName();
+    return name.size() >= lodSuffix.size() &&
+           name.compare(name.size() - lodSuffix.size(), lodSuffix.size(), lodSuffix) == 0;
+}
+
 } // namespace
 
 RenderFillExtrusionLayer::RenderFillExtrusionLayer(Immutable<style::FillExtrusionLayer::Impl> _impl)
     : RenderLayer(makeMutable<FillExtrusionLayerProperties>(std::move(_impl))),
       unevaluated(impl_cast(baseImpl).paint.untransitioned()) {
     styleDependencies = unevaluated.getDependencies();
+    zoomDependent = unevaluated.isZoomDependent();
 }
 
 RenderFillExtrusionLayer::~RenderFillExtrusionLayer() = default;
@@ -51,6 +62,7 @@ RenderFillExtrusionLayer::~RenderFillExtrusionLayer() = default;
 void RenderFillExtrusionLayer::transition(const TransitionParameters& parameters) {
     unevaluated = impl_cast(baseImpl).paint.transitioned(parameters, std::move(unevaluated));
     styleDependencies = unevaluated.getDependencies();
+    zoomDependent = unevaluated.isZoomDependent();
 }
 
 void RenderFillExtrusionLayer::evaluate(const PropertyEvaluationParameters& parameters) {
@@ -101,9 +113,14 @@ bool RenderFillExtrusionLayer::queryIntersectsFeature(const GeometryCoordinates&
                                                feature.getGeometries());
 }
 
+void RenderFillExtrusionLayer::prepare(const LayerPrepareParameters& params) {
+    RenderLayer::prepare(params);
+    lodThreshold = params.fillExtrusionLODThreshold;
+}
+
 void RenderFillExtrusionLayer::update(gfx::ShaderRegistry& shaders,
                                       gfx::Context& context,
-                                      const TransformState&,
+                                      const TransformState& state,
                                       const std::shared_ptr<UpdateParameters>&,
                                       const RenderTree&,
                                       UniqueChangeRequestVec& changes) {
@@ -224,12 +241,20 @@ void RenderFillExtrusionLayer::update(gfx::ShaderRegistry& shaders,
         const auto vertexCount = bucket.vertices.elements();
         auto& binders = bucket.paintPropertyBinders.at(getID());
 
+        // Leave out the walls of small and adjoining buildings once the small ones shrink below the threshold
+        const auto lodFootprintPixels = FillExtrusionBucket::lodFootprintExtent * util::tileSize_D *
+                                        std::pow(2.0, state.getZoom() - tileID.overscaledZ) / util::EXTENT;
+        const bool drawLodWalls = lodThreshold <= 0 || lodFootprintPixels >= lodThreshold;
+
         // If we already have drawables for this tile, update them.
         auto updateExisting = [&](gfx::Drawable& drawable) {
             if (drawable.getLayerTweaker() != layerTweaker) {
                 // This drawable was produced on a previous style/bucket, and should not be updated.
                 return false;
             }
+            if (isLodDrawable(drawable)) {
+                drawable.setEnabled(drawLodWalls);
+            }
             return true;
         };
         if (updateTile(drawPass, tileID, std::move(updateExisting))) {
@@ -356,23 +381,20 @@ void RenderFillExtrusionLayer::update(gfx::ShaderRegistry& shaders,
         }
 #endif
 
-        if (doDepthPass) {
-            depthBuilder->setRawVertices({}, vertexCount, gfx::AttributeDataType::Short2);
-            depthBuilder->setVertexAttributes(vertexAttrs);
-        }
-
         colorBuilder->setEnableStencil(doDepthPass);
-        colorBuilder->setRawVertices({}, vertexCount, gfx::AttributeDataType::Short2);
-        colorBuilder->setVertexAttributes(std::move(vertexAttrs));
 
-        const auto finish = [&](gfx::DrawableBuilder& builder) {
-            if (!bucket.sharedTriangles->elements()) {
+        // The level of detail walls get drawables of their own, sharing the vertices, which are
+        // disabled while the tile is shown too small
+        const auto finish = [&](gfx::DrawableBuilder& builder,
+                                const std::shared_ptr<FillExtrusionBucket::TriangleIndexVector>& triangles,
+                                const SegmentVector& segments,
+                                bool lod) {
+            if (!triangles->elements()) {
                 return;
             }
-            builder.setSegments(gfx::Triangles(),
-                                bucket.sharedTriangles,
-                                bucket.triangleSegments.data(),
-                                bucket.triangleSegments.size());
+            builder.setRawVertices({}, vertexCount, gfx::AttributeDataType::Short2);
+            builder.setVertexAttributes(vertexAttrs);
+            builder.setSegments(gfx::Triangles(), triangles, segments.data(), segments.size());
 
             builder.flush(context);
 
@@ -382,15 +404,21 @@ void RenderFillExtrusionLayer::update(gfx::ShaderRegistry& shaders,
                 drawable->setLayerTweaker(layerTweaker);
                 drawable->setBinders(renderData.bucket, &binders);
                 drawable->setRenderTile(renderTilesOwner, &tile);
+                if (lod) {
+                    drawable->setName(drawable->getName() + lodSuffix);
+                    drawable->setEnabled(drawLodWalls);
+                }
 
                 tileLayerGroup->addDrawable(drawPass, tileID, std::move(drawable));
                 ++stats.drawablesAdded;
             }
         };
         if (doDepthPass) {
-            finish(*depthBuilder);
+            finish(*depthBuilder, bucket.sharedTriangles, bucket.triangleSegments, false);
+            finish(*depthBuilder, bucket.sharedLodTriangles, bucket.lodTriangleSegments, true);
         }
-        finish(*colorBuilder);
+        finish(*colorBuilder, bucket.sharedTriangles, bucket.triangleSegments, false);
+        finish(*colorBuilder, bucket.sharedLodTriangles, bucket.lodTriangleSegments, true);
 
 #if MLN_USE_FILL_EXTRUSION_INSTANCING
         if (doDepthPass && !instancedDepthBuilder) {
@@ -18,6 +18,7 @@ private:
     bool hasTransition() const override;
     bool hasCrossfade() const override;
     bool is3D() const override;
+    void prepare(const LayerPrepareParameters&) override;
 
     /// Generate any changes needed by the layer
     void update(gfx::ShaderRegistry&,
@@ -41,6 +42,9 @@ private:
     gfx::ShaderGroupPtr fillExtrusionGroup;
     gfx::ShaderGroupPtr fillExtrusionPatternGroup;
 
+    // Pixels below which the bucket's level of detail walls are left out, zero for never
+    float lodThreshold = 0.0f;
+
 #if MLN_USE_FILL_EXTRUSION_INSTANCING
     gfx::ShaderGroupPtr fillExtrusionInstancedGroup;
     gfx::ShaderGroupPtr fillExtrusionPatternInstancedGroup;
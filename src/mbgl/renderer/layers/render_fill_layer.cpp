@@ -29,6 +29,8 @@
 #include <mbgl/shaders/fill_layer_ubo.hpp>
 #include <mbgl/shaders/shader_program_base.hpp>
 
+#include <algorithm>
+
 namespace mbgl {
 
 using namespace style;
@@ -55,6 +57,7 @@ RenderFillLayer::RenderFillLayer(Immutable<style::FillLayer::Impl> _impl)
     : RenderLayer(makeMutable<FillLayerProperties>(std::move(_impl))),
       unevaluated(impl_cast(baseImpl).paint.untransitioned()) {
     styleDependencies = unevaluated.getDependencies();
+    zoomDependent = unevaluated.isZoomDependent();
 }
 
 RenderFillLayer::~RenderFillLayer() = default;
@@ -62,6 +65,7 @@ RenderFillLayer::~RenderFillLayer() = default;
 void RenderFillLayer::transition(const TransitionParameters& parameters) {
     unevaluated = impl_cast(baseImpl).paint.transitioned(parameters, std::move(unevaluated));
     styleDependencies = unevaluated.getDependencies();
+    zoomDependent = unevaluated.isZoomDependent();
 }
 
 void RenderFillLayer::evaluate(const PropertyEvaluationParameters& parameters) {
@@ -99,6 +103,42 @@ bool RenderFillLayer::hasCrossfade() const {
     return getCrossfade<FillLayerProperties>(evaluatedProperties).t != 1;
 }
 
+void RenderFillLayer::collectOpaqueTiles(std::vector<UnwrappedTileID>& opaqueTiles) const {
+    if (!renderTiles || !layerGroup || !layerGroup->getEnabled() || !unevaluated.get<FillPattern>().isUndefined()) {
+        return;
+    }
+    const auto& tileGroup = static_cast<const TileLayerGroup&>(*layerGroup);
+
+    for (const RenderTile& tile : *renderTiles) {
+        const auto& tileID = tile.getOverscaledTileID();
+        const LayerRenderData* renderData = getRenderDataForPass(tile, RenderPass::Translucent);
+        if (!renderData || !renderData->bucket || !static_cast<const FillBucket&>(*renderData->bucket).coversTile ||
+            tileGroup.getDrawableCount(RenderPass::Translucent, tileID) == 0) {
+            continue;
+        }
+
+        const auto& evaluated = getEvaluated<FillLayerProperties>(renderData->layerProperties);
+        const auto& color = evaluated.get<FillColor>();
+        const auto& opacity = evaluated.get<FillOpacity>();
+        const auto& translate = evaluated.get<FillTranslate>();
+        if (!color.isConstant() || color.constant()->a < 1.0f || !opacity.isConstant() ||
+            *opacity.constant() < 1.0f || translate[0] != 0.0f || translate[1] != 0.0f) {
+            continue;
+        }
+
+        // Stencil clipping keeps the tile from drawing where another tile of the layer overlaps it
+        const auto unwrapped = tileID.toUnwrapped();
+        const bool overlapped = std::ranges::any_of(*renderTiles, [&](const RenderTile& other) {
+            const auto otherID = other.getOverscaledTileID().toUnwrapped();
+            return &other != &tile && (otherID == unwrapped || otherID.isChildOf(unwrapped) ||
+                                       unwrapped.isChildOf(otherID));
+        });
+        if (!overlapped) {
+            opaqueTiles.push_back(unwrapped);
+        }
+    }
+}
+
 bool RenderFillLayer::queryIntersectsFeature(const GeometryCoordinates& queryGeometry,
                                              const GeometryTileFeature& feature,
                                              const float,
@@ -36,6 +36,8 @@ public:
                 const RenderTree&,
                 UniqueChangeRequestVec&) override;
 
+    void collectOpaqueTiles(std::vector<UnwrappedTileID>&) const override;
+
 private:
     void transition(const TransitionParameters&) override;
     void evaluate(const PropertyEvaluationParameters&) override;
@@ -23,6 +23,8 @@
 #include <mbgl/gfx/shader_group.hpp>
 #include <mbgl/gfx/shader_registry.hpp>
 
+#include <algorithm>
+
 namespace mbgl {
 
 using namespace style;
@@ -40,6 +42,7 @@ RenderHeatmapLayer::RenderHeatmapLayer(Immutable<HeatmapLayer::Impl> _impl)
     : RenderLayer(makeMutable<HeatmapLayerProperties>(std::move(_impl))),
       unevaluated(impl_cast(baseImpl).paint.untransitioned()) {
     styleDependencies = unevaluated.getDependencies();
+    zoomDependent = unevaluated.isZoomDependent();
     colorRamp = std::make_shared<PremultipliedImage>(Size(256, 1));
 }
 
@@ -48,6 +51,7 @@ RenderHeatmapLayer::~RenderHeatmapLayer() = default;
 void RenderHeatmapLayer::transition(const TransitionParameters& parameters) {
     unevaluated = impl_cast(baseImpl).paint.transitioned(parameters, std::move(unevaluated));
     styleDependencies = unevaluated.getDependencies();
+    zoomDependent = unevaluated.isZoomDependent();
     updateColorRamp();
 }
 
@@ -72,6 +76,10 @@ void RenderHeatmapLayer::evaluate(const PropertyEvaluationParameters& parameters
     if (layerTweaker) {
         layerTweaker->updateProperties(evaluatedProperties);
     }
+    if (renderTarget) {
+        // Weight, radius or intensity may have changed
+        renderTarget->invalidate();
+    }
     if (textureTweaker) {
         textureTweaker->updateProperties(evaluatedProperties);
     }
@@ -85,6 +93,11 @@ bool RenderHeatmapLayer::hasCrossfade() const {
     return false;
 }
 
+void RenderHeatmapLayer::prepare(const LayerPrepareParameters& params) {
+    RenderLayer::prepare(params);
+    resolutionScale = params.heatmapResolutionScale;
+}
+
 void RenderHeatmapLayer::updateColorRamp() {
     if (colorRamp) {
         auto colorValue = unevaluated.get<HeatmapColor>().getValue();
@@ -170,7 +183,8 @@ void RenderHeatmapLayer::update(gfx::ShaderRegistry& shaders,
     }
 
     const auto& viewportSize = state.getSize();
-    const auto size = Size{viewportSize.width / 2, viewportSize.height / 2};
+    const auto size = Size{std::max(1u, static_cast<uint32_t>(viewportSize.width * resolutionScale)),
+                           std::max(1u, static_cast<uint32_t>(viewportSize.height * resolutionScale))};
 
     // Set up a render target
     if (!renderTarget) {
@@ -178,6 +192,8 @@ void RenderHeatmapLayer::update(gfx::ShaderRegistry& shaders,
         if (!renderTarget) {
             return;
         }
+        // The densities are kept from one frame to the next while neither the camera nor the data change
+        renderTarget->setRenderOnDemand(true);
         activateRenderTarget(renderTarget, isRenderable, changes);
 
         // Set up tile layer group
@@ -191,8 +207,17 @@ void RenderHeatmapLayer::update(gfx::ShaderRegistry& shaders,
 
     if (renderTarget->getTexture()->getSize() != size) {
         renderTarget->getTexture()->setSize(size);
+        renderTarget->invalidate();
     }
 
+    mat4 projMatrix;
+    state.getProjMatrix(projMatrix);
+    if (projMatrix != accumulatedProjMatrix) {
+        accumulatedProjMatrix = projMatrix;
+        renderTarget->invalidate();
+    }
+    const auto drawablesChanged = stats.drawablesAdded + stats.drawablesRemoved;
+
     auto* tileLayerGroup = static_cast<TileLayerGroup*>(renderTarget->getLayerGroup(0).get());
 
     if (!heatmapShaderGroup) {
@@ -319,6 +344,11 @@ void RenderHeatmapLayer::update(gfx::ShaderRegistry& shaders,
         }
     }
 
+    if (stats.drawablesAdded + stats.drawablesRemoved != drawablesChanged) {
+        // Tiles came or went
+        renderTarget->invalidate();
+    }
+
     // Set up texture layer group
     if (!layerGroup) {
         if (auto layerGroup_ = context.createLayerGroup(layerIndex, /*initialCapacity=*/1, getID())) {
@@ -42,6 +42,7 @@ private:
                                 float,
                                 const mat4&,
                                 const FeatureState&) const override;
+    void prepare(const LayerPrepareParameters&) override;
     void updateColorRamp();
 
     void layerChanged(const TransitionParameters& parameters,
@@ -65,6 +66,9 @@ private:
     gfx::ShaderGroupPtr heatmapShaderGroup;
     gfx::ShaderProgramBasePtr heatmapTextureShader;
     RenderTargetPtr renderTarget;
+    float resolutionScale = 0.5f;
+    // The camera the density texture was last accumulated for
+    mat4 accumulatedProjMatrix{};
 
     using TextureVertexVector = gfx::VertexVector<HeatmapTextureLayoutVertex>;
     std::shared_ptr<TextureVertexVector> sharedTextureVertices;
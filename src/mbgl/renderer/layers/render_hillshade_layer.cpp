@@ -25,6 +25,8 @@
 #include <mbgl/gfx/shader_group.hpp>
 #include <mbgl/gfx/shader_registry.hpp>
 
+#include <algorithm>
+
 namespace mbgl {
 
 using namespace style;
@@ -43,6 +45,7 @@ RenderHillshadeLayer::RenderHillshadeLayer(Immutable<style::HillshadeLayer::Impl
     : RenderLayer(makeMutable<HillshadeLayerProperties>(std::move(_impl))),
       unevaluated(impl_cast(baseImpl).paint.untransitioned()) {
     styleDependencies = unevaluated.getDependencies();
+    zoomDependent = unevaluated.isZoomDependent();
 }
 
 RenderHillshadeLayer::~RenderHillshadeLayer() = default;
@@ -69,6 +72,7 @@ std::array<float, 2> RenderHillshadeLayer::getLight(const PaintParameters& param
 void RenderHillshadeLayer::transition(const TransitionParameters& parameters) {
     unevaluated = impl_cast(baseImpl).paint.transitioned(parameters, std::move(unevaluated));
     styleDependencies = unevaluated.getDependencies();
+    zoomDependent = unevaluated.isZoomDependent();
 }
 
 void RenderHillshadeLayer::layerChanged(const TransitionParameters& parameters,
@@ -141,6 +145,10 @@ void RenderHillshadeLayer::addRenderTarget(const RenderTargetPtr& renderTarget,
     activatedRenderTargets.emplace_back(renderTarget);
 }
 
+bool RenderHillshadeLayer::hasRenderTarget(const RenderTargetPtr& renderTarget) const {
+    return std::ranges::find(activatedRenderTargets, renderTarget) != activatedRenderTargets.end();
+}
+
 void RenderHillshadeLayer::removeRenderTargets(UniqueChangeRequestVec& changes) {
     for (const auto& renderTarget : activatedRenderTargets) {
         activateRenderTarget(renderTarget, false, changes);
@@ -249,7 +257,18 @@ void RenderHillshadeLayer::update(gfx::ShaderRegistry& shaders,
         }
         setRenderTileBucketID(tileID, bucket.getID());
 
-        if (!bucket.renderTargetPrepared) {
+        if (bucket.renderTarget && !bucket.renderTargetPrepared) {
+            // The border was backfilled from a neighbouring tile, prepare the same target again
+            bucket.demTexture->setImage(bucket.getDEMData().getImagePtr());
+            bucket.renderTarget->invalidate();
+            bucket.renderTargetPrepared = true;
+        }
+        if (bucket.renderTarget && !hasRenderTarget(bucket.renderTarget)) {
+            // Prepared by another layer of the source, or before this layer was last hidden
+            addRenderTarget(bucket.renderTarget, changes);
+        }
+
+        if (!bucket.renderTarget) {
             // Set up tile render target
             const uint16_t tilesize = bucket.getDEMData().dim;
             auto renderTarget = context.createRenderTarget({tilesize, tilesize},
@@ -257,6 +276,8 @@ void RenderHillshadeLayer::update(gfx::ShaderRegistry& shaders,
             if (!renderTarget) {
                 continue;
             }
+            // The slopes only change along with the DEM data, so don't render them every frame
+            renderTarget->setRenderOnDemand(true);
             bucket.renderTarget = renderTarget;
             bucket.renderTargetPrepared = true;
             addRenderTarget(renderTarget, changes);
@@ -291,6 +312,7 @@ void RenderHillshadeLayer::update(gfx::ShaderRegistry& shaders,
                                               .wrapU = gfx::TextureWrapType::Clamp,
                                               .wrapV = gfx::TextureWrapType::Clamp});
             hillshadePrepareBuilder->setTexture(texture, idHillshadeImageTexture);
+            bucket.demTexture = std::move(texture);
 
             hillshadePrepareBuilder->flush(context);
 
@@ -43,6 +43,7 @@ private:
     void prepare(const LayerPrepareParameters&) override;
 
     void addRenderTarget(const RenderTargetPtr&, UniqueChangeRequestVec&);
+    bool hasRenderTarget(const RenderTargetPtr&) const;
     void removeRenderTargets(UniqueChangeRequestVec&);
 
     // Paint properties
@@ -50,6 +50,7 @@ RenderLineLayer::RenderLineLayer(Immutable<style::LineLayer::Impl> _impl)
       unevaluated(impl_cast(baseImpl).paint.untransitioned()),
       colorRamp(std::make_shared<PremultipliedImage>(Size(256, 1))) {
     styleDependencies = unevaluated.getDependencies();
+    zoomDependent = unevaluated.isZoomDependent();
 }
 
 RenderLineLayer::~RenderLineLayer() = default;
@@ -57,6 +58,7 @@ RenderLineLayer::~RenderLineLayer() = default;
 void RenderLineLayer::transition(const TransitionParameters& parameters) {
     unevaluated = impl_cast(baseImpl).paint.transitioned(parameters, std::move(unevaluated));
     styleDependencies = unevaluated.getDependencies();
+    zoomDependent = unevaluated.isZoomDependent();
     updateColorRamp();
 
 #if MLN_RENDER_BACKEND_METAL
@@ -8,6 +8,7 @@
 #include <mbgl/gfx/context.hpp>
 #include <mbgl/gfx/cull_face_mode.hpp>
 #include <mbgl/math/angles.hpp>
+#include <mbgl/platform/settings.hpp>
 #include <mbgl/style/layers/raster_layer_impl.hpp>
 #include <mbgl/util/logging.hpp>
 
@@ -19,6 +20,9 @@
 #include <mbgl/renderer/update_parameters.hpp>
 #include <mbgl/shaders/shader_program_base.hpp>
 
+#include <algorithm>
+#include <mutex>
+
 namespace mbgl {
 
 using namespace style;
@@ -31,12 +35,40 @@ inline const RasterLayer::Impl& impl_cast(const Immutable<style::Layer::Impl>& i
     return static_cast<const RasterLayer::Impl&>(*impl);
 }
 
+void warnUnsupportedCompressedImage() {
+    static std::once_flag warned;
+    std::call_once(warned, [] {
+        Log::Warning(Event::Render, "Raster tiles in a compressed format this GPU doesn't support aren't drawn");
+    });
+}
+
+// The sampling the EXPERIMENTAL_RASTER_* settings ask for, the filter being left to `raster-resampling`
+gfx::Texture2D::SamplerState settingsSamplerState() {
+    const auto& settings = platform::Settings::getInstance();
+    gfx::Texture2D::SamplerState state;
+    const auto mipmapsValue = settings.get(platform::EXPERIMENTAL_RASTER_MIPMAPS);
+    if (const auto* mipmaps = mipmapsValue.getBool()) {
+        state.mipmapped = *mipmaps;
+    }
+    const auto anisotropyValue = settings.get(platform::EXPERIMENTAL_RASTER_MAX_ANISOTROPY);
+    if (const auto* anisotropy = anisotropyValue.getDouble()) {
+        state.maxAnisotropy = static_cast<uint8_t>(std::clamp(*anisotropy, 1.0, 16.0));
+    }
+    const auto lodBiasValue = settings.get(platform::EXPERIMENTAL_RASTER_LOD_BIAS);
+    if (const auto* lodBias = lodBiasValue.getDouble()) {
+        state.lodBias = static_cast<float>(*lodBias);
+    }
+    return state;
+}
+
 } // namespace
 
 RenderRasterLayer::RenderRasterLayer(Immutable<style::RasterLayer::Impl> _impl)
     : RenderLayer(makeMutable<RasterLayerProperties>(std::move(_impl))),
-      unevaluated(impl_cast(baseImpl).paint.untransitioned()) {
+      unevaluated(impl_cast(baseImpl).paint.untransitioned()),
+      samplerSettings(settingsSamplerState()) {
     styleDependencies = unevaluated.getDependencies();
+    zoomDependent = unevaluated.isZoomDependent();
 }
 
 RenderRasterLayer::~RenderRasterLayer() = default;
@@ -44,6 +76,7 @@ RenderRasterLayer::~RenderRasterLayer() = default;
 void RenderRasterLayer::transition(const TransitionParameters& parameters) {
     unevaluated = impl_cast(baseImpl).paint.transitioned(parameters, std::move(unevaluated));
     styleDependencies = unevaluated.getDependencies();
+    zoomDependent = unevaluated.isZoomDependent();
 }
 
 void RenderRasterLayer::evaluate(const PropertyEvaluationParameters& parameters) {
@@ -156,10 +189,19 @@ void RenderRasterLayer::update(gfx::ShaderRegistry& shaders,
     };
 
     const auto setTextures = [&](gfx::UniqueDrawableBuilder& builder, RasterBucket& bucket) {
-        if (bucket.image) {
+        if (bucket.image || bucket.compressedImage) {
             if (!bucket.texture2d) {
+                if (bucket.compressedImage && !context.supportsCompressedImageFormat(bucket.compressedImage->format)) {
+                    warnUnsupportedCompressedImage();
+                    return;
+                }
                 if (auto tex = context.createTexture2D()) {
-                    tex->setImage(bucket.image);
+                    if (bucket.compressedImage) {
+                        tex->setCompressedImage(bucket.compressedImage);
+                    } else {
+                        tex->setImage(bucket.image);
+                        tex->setDeferrableUpload(true);
+                    }
                     bucket.texture2d = std::move(tex);
                 }
             }
@@ -167,10 +209,9 @@ void RenderRasterLayer::update(gfx::ShaderRegistry& shaders,
             if (bucket.texture2d) {
                 const auto& evaluated = static_cast<const RasterLayerProperties&>(*evaluatedProperties).evaluated;
                 const bool nearest = evaluated.get<RasterResampling>() == RasterResamplingType::Nearest;
-                const auto filter = nearest ? gfx::TextureFilterType::Nearest : gfx::TextureFilterType::Linear;
-
-                bucket.texture2d->setSamplerConfiguration(
-                    {.filter = filter, .wrapU = gfx::TextureWrapType::Clamp, .wrapV = gfx::TextureWrapType::Clamp});
+                auto samplerState = samplerSettings;
+                samplerState.filter = nearest ? gfx::TextureFilterType::Nearest : gfx::TextureFilterType::Linear;
+                bucket.texture2d->setSamplerConfiguration(samplerState);
 
                 builder->setTexture(bucket.texture2d, idRasterImage0Texture);
                 builder->setTexture(bucket.texture2d, idRasterImage1Texture);
@@ -240,8 +281,11 @@ void RenderRasterLayer::update(gfx::ShaderRegistry& shaders,
             stats.drawablesRemoved += imageLayerGroup->clearDrawables();
         }
 
-        RasterBucket& bucket = *imageData->bucket;
-        if (!bucket.vertices.empty()) {
+        for (const auto& bucketPtr : imageData->buckets) {
+            RasterBucket& bucket = *bucketPtr;
+            if (bucket.vertices.empty()) {
+                continue;
+            }
             if (!imageLayerGroup) {
                 // Set up a layer group
                 imageLayerGroup = context.createLayerGroup(layerIndex, /*initialCapacity=*/64, getID());
@@ -251,7 +295,9 @@ void RenderRasterLayer::update(gfx::ShaderRegistry& shaders,
 
             // Create a drawable for each transformation
             // TODO: Share textures
-            builder = createBuilder();
+            if (!builder) {
+                builder = createBuilder();
+            }
             for (const auto& matrix_ : imageData->matrices) {
                 buildVertexData(builder, /*drawable=*/nullptr, bucket);
                 setTextures(builder, bucket);
@@ -347,7 +393,7 @@ void RenderRasterLayer::update(gfx::ShaderRegistry& shaders,
                 builder = createBuilder();
             }
 
-            if (bucket.image && !builder->getTexture(idRasterImage0Texture) &&
+            if ((bucket.image || bucket.compressedImage) && !builder->getTexture(idRasterImage0Texture) &&
                 !builder->getTexture(idRasterImage1Texture)) {
                 setTextures(builder, bucket);
             };
@@ -5,6 +5,7 @@
 #include <mbgl/style/layers/raster_layer_impl.hpp>
 #include <mbgl/style/layers/raster_layer_properties.hpp>
 #include <mbgl/gfx/context.hpp>
+#include <mbgl/gfx/texture2d.hpp>
 
 namespace mbgl {
 
@@ -48,6 +49,8 @@ private:
 
     // Paint properties
     style::RasterPaintProperties::Unevaluated unevaluated;
+    /// The mipmapping, anisotropy and LOD bias of the tile textures, see EXPERIMENTAL_RASTER_MIPMAPS
+    const gfx::Texture2D::SamplerState samplerSettings;
     const ImageSourceRenderData* imageData = nullptr;
 
     gfx::ShaderProgramBasePtr rasterShader;
@@ -8,6 +8,7 @@
 #include <mbgl/renderer/render_source.hpp>
 #include <mbgl/renderer/render_tile.hpp>
 #include <mbgl/renderer/update_parameters.hpp>
+#include <mbgl/util/constants.hpp>
 #include <mbgl/util/convert.hpp>
 #include <mbgl/util/logging.hpp>
 
@@ -31,6 +32,13 @@
 #include <mbgl/vulkan/context.hpp>
 #endif // MLN_RENDER_BACKEND_VULKAN
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <utility>
+
 namespace mbgl {
 
 TransformParameters::TransformParameters(const TransformState& state_)
@@ -96,10 +104,103 @@ PaintParameters::PaintParameters(gfx::Context& context_,
 PaintParameters::~PaintParameters() = default;
 
 mat4 PaintParameters::matrixForTile(const UnwrappedTileID& tileID, bool aligned) const {
-    mat4 matrix;
-    state.matrixFor(matrix, tileID);
-    matrix::multiply(matrix, aligned ? transformParams.alignedProjMatrix : transformParams.projMatrix, matrix);
-    return matrix;
+    return projectedTileMatrix(tileID, false, aligned);
+}
+
+PaintParameters::TileMatrices& PaintParameters::getTileMatrices(const UnwrappedTileID& tileID) const {
+    auto [it, inserted] = tileMatrices.try_emplace(tileID);
+    if (inserted) {
+        state.matrixFor(it->second.tile, tileID);
+    }
+    return it->second;
+}
+
+const mat4& PaintParameters::tileMatrix(const UnwrappedTileID& tileID) const {
+    return getTileMatrices(tileID).tile;
+}
+
+const mat4& PaintParameters::projectedTileMatrix(const UnwrappedTileID& tileID, bool nearClipped, bool aligned) const {
+    auto& matrices = getTileMatrices(tileID);
+    auto& projected = matrices.projected[aligned ? 2 : (nearClipped ? 1 : 0)];
+    if (!projected) {
+        const auto& projMatrix = aligned ? transformParams.alignedProjMatrix
+                                         : (nearClipped ? transformParams.nearClippedProjMatrix
+                                                        : transformParams.projMatrix);
+        projected.emplace();
+        matrix::multiply(*projected, projMatrix, matrices.tile);
+    }
+    return *projected;
+}
+
+bool PaintParameters::canClipTilesWithScissor(const RenderTiles& renderTiles) const {
+    if (!allowTileScissorClipping || !renderTiles || state.getPitch() != 0.0) {
+        return false;
+    }
+    const double quarterTurns = state.getBearing() / (std::numbers::pi / 2);
+    if (std::abs(quarterTurns - std::round(quarterTurns)) > 1e-9) {
+        return false;
+    }
+
+    const auto& tiles = *renderTiles;
+    for (std::size_t i = 0; i < tiles.size(); ++i) {
+        const auto& a = tiles[i].get().id;
+        for (std::size_t j = i + 1; j < tiles.size(); ++j) {
+            const auto& b = tiles[j].get().id;
+            if (a == b || a.isChildOf(b) || b.isChildOf(a)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+gfx::ScissorRect PaintParameters::scissorRectForTile(const UnwrappedTileID& tileID) const {
+    const auto matrix = matrixForTile(tileID);
+    const auto& size = staticData.backendSize;
+
+    double left = std::numeric_limits<double>::infinity();
+    double right = -left;
+    double bottom = left;
+    double top = -left;
+    constexpr std::array<std::pair<int32_t, int32_t>, 4> corners{
+        {{0, 0}, {util::EXTENT, 0}, {0, util::EXTENT}, {util::EXTENT, util::EXTENT}}};
+    for (const auto& [x, y] : corners) {
+        vec4 corner;
+        matrix::transformMat4(corner, {{static_cast<double>(x), static_cast<double>(y), 0.0, 1.0}}, matrix);
+        const double pixelX = (corner[0] / corner[3] + 1.0) / 2.0 * size.width;
+#if MLN_RENDER_BACKEND_OPENGL
+        const double pixelY = (corner[1] / corner[3] + 1.0) / 2.0 * size.height;
+#else
+        const double pixelY = (1.0 - corner[1] / corner[3]) / 2.0 * size.height;
+#endif
+        left = std::min(left, pixelX);
+        right = std::max(right, pixelX);
+        bottom = std::min(bottom, pixelY);
+        top = std::max(top, pixelY);
+    }
+
+    // The pixels whose centers the tile covers, as rasterizing its stencil mask would
+    auto x0 = static_cast<int64_t>(std::ceil(left - 0.5));
+    auto x1 = static_cast<int64_t>(std::ceil(right - 0.5));
+    auto y0 = static_cast<int64_t>(std::ceil(bottom - 0.5));
+    auto y1 = static_cast<int64_t>(std::ceil(top - 0.5));
+    if (scissorRect.width && scissorRect.height) {
+        x0 = std::max<int64_t>(x0, scissorRect.x);
+        x1 = std::min<int64_t>(x1, scissorRect.x + static_cast<int64_t>(scissorRect.width));
+        y0 = std::max<int64_t>(y0, scissorRect.y);
+        y1 = std::min<int64_t>(y1, scissorRect.y + static_cast<int64_t>(scissorRect.height));
+    }
+    x0 = std::max<int64_t>(x0, 0);
+    y0 = std::max<int64_t>(y0, 0);
+    x1 = std::min<int64_t>(x1, size.width);
+    y1 = std::min<int64_t>(y1, size.height);
+    if (x1 <= x0 || y1 <= y0) {
+        return {.x = 0, .y = 0, .width = 0, .height = 0};
+    }
+    return {.x = static_cast<int32_t>(x0),
+            .y = static_cast<int32_t>(y0),
+            .width = static_cast<uint32_t>(x1 - x0),
+            .height = static_cast<uint32_t>(y1 - y0)};
 }
 
 gfx::DepthMode PaintParameters::depthModeForSublayer([[maybe_unused]] uint8_t n, gfx::DepthMaskType mask) const {
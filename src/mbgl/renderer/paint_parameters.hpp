@@ -5,6 +5,7 @@
 #include <mbgl/renderer/render_source.hpp>
 #include <mbgl/map/mode.hpp>
 #include <mbgl/map/transform_state.hpp>
+#include <mbgl/tile/tile_id.hpp>
 #include <mbgl/gfx/depth_mode.hpp>
 #include <mbgl/gfx/stencil_mode.hpp>
 #include <mbgl/gfx/color_mode.hpp>
@@ -15,7 +16,9 @@
 #include <functional>
 #include <iterator>
 #include <map>
+#include <optional>
 #include <set>
+#include <unordered_map>
 #include <vector>
 
 namespace mbgl {
@@ -95,6 +98,13 @@ public:
 
     mat4 matrixForTile(const UnwrappedTileID&, bool aligned = false) const;
 
+    /// The matrix of a tile before projection, see `TransformState::matrixFor`. Computed once per frame, and
+    /// shared by the layers drawing the tile; like the rest of the parameters, only used on the render thread.
+    const mat4& tileMatrix(const UnwrappedTileID&) const;
+    /// The matrix of a tile with the default, near clipped or aligned projection, aligned taking precedence.
+    /// Computed once per frame for each tile and projection.
+    const mat4& projectedTileMatrix(const UnwrappedTileID&, bool nearClipped, bool aligned) const;
+
     // Stencil handling
 public:
     void renderTileClippingMasks(const RenderTiles&);
@@ -112,12 +122,28 @@ public:
     /// @return The stencil mode, each value is unique.
     gfx::StencilMode stencilModeFor3D();
 
+    /// Whether the tiles can be clipped to scissor rectangles instead of stencil masks, which requires an
+    /// unpitched view aligned with the axes, so that tiles are screen rectangles, and tiles not overlapping
+    /// one another, which the stencil masks would carve out of each other.
+    bool canClipTilesWithScissor(const RenderTiles&) const;
+
+    /// The pixels of the framebuffer a tile covers, within `scissorRect`. Empty if it covers none.
+    gfx::ScissorRect scissorRectForTile(const UnwrappedTileID&) const;
+
 private:
     template <typename TIter>
     using GetTileIDFunc = const UnwrappedTileID& (*)(const typename TIter::value_type&);
     template <typename TIter>
     void renderTileClippingMasks(TIter beg, TIter end, GetTileIDFunc<TIter> unwrap);
 
+    struct TileMatrices {
+        mat4 tile;
+        /// Default, near clipped and aligned
+        std::array<std::optional<mat4>, 3> projected;
+    };
+    TileMatrices& getTileMatrices(const UnwrappedTileID&) const;
+    mutable std::unordered_map<UnwrappedTileID, TileMatrices> tileMatrices;
+
     // This needs to be an ordered map so that we have the same order as the renderTiles.
     std::map<UnwrappedTileID, int32_t> tileClippingMaskIDs;
     int32_t nextStencilID = 1;
@@ -127,6 +153,10 @@ public:
     float depthRangeSize;
     uint32_t opaquePassCutoff = 0;
     float symbolFadeChange;
+    /// Whether layer groups may clip their tiles with `scissorRectForTile`, see `EXPERIMENTAL_SCISSOR_TILE_CLIPPING`
+    bool allowTileScissorClipping = false;
+    /// Whether the drawables of the layer group being rendered clip their tiles with `scissorRectForTile`
+    bool tileScissorClipping = false;
     const uint64_t frameCount;
 
     static constexpr int numSublayers = 3;
@@ -7,8 +7,10 @@
 #include <mbgl/layout/pattern_layout.hpp>
 #include <mbgl/shaders/attributes.hpp>
 #include <mbgl/renderer/cross_faded_property_evaluator.hpp>
+#include <mbgl/renderer/feature_vertex_range_map.hpp>
 #include <mbgl/renderer/paint_property_statistics.hpp>
 #include <mbgl/renderer/possibly_evaluated_property_value.hpp>
+#include <mbgl/style/expression/is_constant.hpp>
 #include <mbgl/util/indexed_tuple.hpp>
 #include <mbgl/util/literal.hpp>
 #include <mbgl/util/type_list.hpp>
@@ -17,15 +19,6 @@
 
 namespace mbgl {
 
-// Maps vertex range to feature index
-struct FeatureVertexRange {
-    std::size_t featureIndex;
-    std::size_t start;
-    std::size_t end;
-};
-
-using FeatureVertexRangeMap = std::map<std::string, std::vector<FeatureVertexRange>>;
-
 struct InterleavedVertexBuffer {
     std::size_t stride = 0;
     std::size_t vertexCount = 0;
@@ -34,9 +27,7 @@ struct InterleavedVertexBuffer {
 
     template <typename T>
     void set(std::size_t index, std::size_t offset, const T& value) {
-        assert(stride * index + offset + sizeof(T) <= sharedVertexVector->bytes());
-        const void* data = reinterpret_cast<const void*>(sharedVertexVector->data() + stride * index + offset);
-        memcpy(const_cast<void*>(data), &value, sizeof(value));
+        sharedVertexVector->write(stride * index + offset, &value, sizeof(value));
     }
 
     template <typename T>
@@ -174,17 +165,24 @@ public:
     template <typename VertexFormat>
     void setInterleavedBuffer(InterleavedVertexBuffer& buffer) {
         interleavedVertexBuffer = &buffer;
+        vertexSize = sizeof(VertexFormat);
 
         if (vertexOffset == 0) {
             vertexOffset = interleavedVertexBuffer->extendVertexFormat<VertexFormat>();
         }
     }
 
+    /// Drops the vertex data if every vertex got the default value, which the layer uniforms supply for the
+    /// data-driven properties, and feature state can't change it. Returns true if the data was dropped.
+    virtual bool collapseToUniform() { return false; }
+
     static std::unique_ptr<PaintPropertyBinder> create(const PossiblyEvaluatedType& value, float zoom, T defaultValue);
 
     PaintPropertyStatistics<T> statistics;
     InterleavedVertexBuffer* interleavedVertexBuffer = nullptr;
     std::size_t vertexOffset = 0;
+    /// Bytes of the vertex data within the interleaved stride
+    std::size_t vertexSize = 0;
 };
 
 namespace detail {
@@ -280,7 +278,8 @@ public:
 
     SourceFunctionPaintPropertyBinder(style::PropertyExpression<T> expression_, T defaultValue_)
         : expression(std::move(expression_)),
-          defaultValue(std::move(defaultValue_)) {}
+          defaultValue(std::move(defaultValue_)),
+          onlyDefault(style::expression::isFeatureStateConstant(expression.getExpression())) {}
     ~SourceFunctionPaintPropertyBinder() override {}
 
     void setPatternParameters(const std::optional<ImagePosition>&,
@@ -298,6 +297,7 @@ public:
             EvaluationContext(&feature).withFormattedSection(&formattedSection).withCanonicalTileID(&canonical),
             defaultValue);
         this->statistics.add(evaluated);
+        onlyDefault = onlyDefault && evaluated == defaultValue;
         auto value = attributeValue(evaluated);
 
         const std::size_t elements = this->getVertexCount();
@@ -305,22 +305,17 @@ public:
         for (std::size_t i = elements; i < length; ++i) {
             this->interleavedVertexBuffer->set(i, this->vertexOffset, BaseVertex{value});
         }
-        std::optional<std::string> idStr = featureIDtoString(feature.getID());
-        if (idStr) {
-            featureMap[*idStr].emplace_back(FeatureVertexRange{index, elements, length});
-        }
+        featureMap.add(feature.getID(), FeatureVertexRange{index, elements, length});
     }
 
     void updateVertexVectors(const FeatureStates& states,
                              const GeometryTileLayer& layer,
                              const ImagePositions&) override {
+        if (featureMap.empty()) {
+            return;
+        }
         for (const auto& it : states) {
-            const auto positions = featureMap.find(it.first);
-            if (positions == featureMap.end()) {
-                continue;
-            }
-
-            for (const auto& pos : positions->second) {
+            for (const auto& pos : featureMap.find(it.first)) {
                 std::unique_ptr<GeometryTileFeature> feature = layer.getFeature(pos.featureIndex);
                 if (feature) {
                     updateVertexVector(pos.start, pos.end, *feature, it.second);
@@ -362,13 +357,28 @@ public:
 
     using PaintPropertyBinder<T, T, PossiblyEvaluatedPropertyValue<T>, A>::setInterleavedBuffer;
     void setInterleavedBuffer(InterleavedVertexBuffer& buffer) override {
-        this->template setInterleavedBuffer<BaseVertex>(buffer);
+        if (!collapsed) {
+            this->template setInterleavedBuffer<BaseVertex>(buffer);
+        }
+    }
+
+    bool collapseToUniform() override {
+        if (!onlyDefault || collapsed || this->getVertexCount() == 0) {
+            return false;
+        }
+        collapsed = true;
+        this->interleavedVertexBuffer = nullptr;
+        featureMap.clear();
+        return true;
     }
 
 private:
     style::PropertyExpression<T> expression;
     T defaultValue;
     FeatureVertexRangeMap featureMap;
+    /// Whether every vertex so far got the default value, which the feature state can't change
+    bool onlyDefault;
+    bool collapsed = false;
 };
 
 template <class T, class A>
@@ -382,7 +392,8 @@ public:
     CompositeFunctionPaintPropertyBinder(style::PropertyExpression<T> expression_, float zoom, T defaultValue_)
         : expression(std::move(expression_)),
           defaultValue(std::move(defaultValue_)),
-          zoomRange({zoom, zoom + 1}) {}
+          zoomRange({zoom, zoom + 1}),
+          onlyDefault(style::expression::isFeatureStateConstant(expression.getExpression())) {}
     ~CompositeFunctionPaintPropertyBinder() override {}
 
     void setPatternParameters(const std::optional<ImagePosition>&,
@@ -408,6 +419,7 @@ public:
         };
         this->statistics.add(range.min);
         this->statistics.add(range.max);
+        onlyDefault = onlyDefault && range.min == defaultValue && range.max == defaultValue;
         const AttributeValue value = zoomInterpolatedAttributeValue(attributeValue(range.min),
                                                                     attributeValue(range.max));
         const std::size_t elements = this->getVertexCount();
@@ -415,21 +427,17 @@ public:
         for (std::size_t i = elements; i < length; ++i) {
             this->interleavedVertexBuffer->set(i, this->vertexOffset, Vertex{value});
         }
-        if (auto idStr = featureIDtoString(feature.getID())) {
-            featureMap[*idStr].emplace_back(FeatureVertexRange{index, elements, length});
-        }
+        featureMap.add(feature.getID(), FeatureVertexRange{index, elements, length});
     }
 
     void updateVertexVectors(const FeatureStates& states,
                              const GeometryTileLayer& layer,
                              const ImagePositions&) override {
+        if (featureMap.empty()) {
+            return;
+        }
         for (const auto& it : states) {
-            const auto positions = featureMap.find(it.first);
-            if (positions == featureMap.end()) {
-                continue;
-            }
-
-            for (const auto& pos : positions->second) {
+            for (const auto& pos : featureMap.find(it.first)) {
                 std::unique_ptr<GeometryTileFeature> feature = layer.getFeature(pos.featureIndex);
                 if (feature) {
                     updateVertexVector(pos.start, pos.end, *feature, it.second);
@@ -478,7 +486,19 @@ public:
 
     using PaintPropertyBinder<T, T, PossiblyEvaluatedPropertyValue<T>, A>::setInterleavedBuffer;
     void setInterleavedBuffer(InterleavedVertexBuffer& buffer) override {
-        this->template setInterleavedBuffer<Vertex>(buffer);
+        if (!collapsed) {
+            this->template setInterleavedBuffer<Vertex>(buffer);
+        }
+    }
+
+    bool collapseToUniform() override {
+        if (!onlyDefault || collapsed || this->getVertexCount() == 0) {
+            return false;
+        }
+        collapsed = true;
+        this->interleavedVertexBuffer = nullptr;
+        featureMap.clear();
+        return true;
     }
 
     std::tuple<ZoomInterpolatedVertexType<A>> getVertexValue(std::size_t index) const override {
@@ -490,6 +510,10 @@ private:
     T defaultValue;
     Range<float> zoomRange;
     FeatureVertexRangeMap featureMap;
+    /// Whether every vertex so far got the default value at both ends of the zoom range, which the feature state
+    /// can't change
+    bool onlyDefault;
+    bool collapsed = false;
 };
 
 template <class T, class A1, class A2>
@@ -728,7 +752,8 @@ public:
                              const GeometryTileLayer& layer,
                              const ImagePositions& imagePositions) {
         util::ignore({(binders.template get<Ps>()->updateVertexVectors(states, layer, imagePositions), 0)...});
-        interleavedVertexBuffer.sharedVertexVector->updateModified(true);
+        // Only the vertices of features whose attributes changed are uploaded again, if any
+        interleavedVertexBuffer.sharedVertexVector->updateModified();
     }
 
     void setPatternParameters(const std::optional<ImagePosition>& posA,
@@ -738,6 +763,49 @@ public:
         interleavedVertexBuffer.sharedVertexVector->updateModified(true);
     }
 
+    /// Once the features are populated, drops the vertex data of the binders whose every vertex got the value the
+    /// layer uniforms supply, and packs the remaining attributes into a narrower interleaved stride.
+    void compactVertexVectors() {
+        bool collapsed = false;
+        util::ignore({(collapsed = binders.template get<Ps>()->collapseToUniform() || collapsed, 0)...});
+        if (!collapsed) {
+            return;
+        }
+
+        struct Relocation {
+            std::size_t from;
+            std::size_t to;
+            std::size_t size;
+        };
+        std::vector<Relocation> relocations;
+
+        const InterleavedVertexBuffer previous = interleavedVertexBuffer;
+        interleavedVertexBuffer.stride = 0;
+        interleavedVertexBuffer.sharedVertexVector = std::make_shared<gfx::VertexVector<uint8_t>>();
+        (([&] {
+             auto& binder = *binders.template get<Ps>();
+             if (binder.interleavedVertexBuffer) {
+                 const auto from = binder.vertexOffset;
+                 binder.vertexOffset = 0;
+                 binder.setInterleavedBuffer(interleavedVertexBuffer);
+                 relocations.push_back({from, binder.vertexOffset, binder.vertexSize});
+             }
+         }()),
+         ...);
+
+        auto& vertices = *interleavedVertexBuffer.sharedVertexVector;
+        vertices.extend(previous.vertexCount * interleavedVertexBuffer.stride, {});
+        const uint8_t* source = previous.sharedVertexVector->data();
+        for (std::size_t i = 0; i < previous.vertexCount; ++i) {
+            for (const auto& relocation : relocations) {
+                vertices.write(i * interleavedVertexBuffer.stride + relocation.to,
+                               source + i * previous.stride + relocation.from,
+                               relocation.size);
+            }
+        }
+        vertices.updateModified(true);
+    }
+
     template <class P>
     using ZoomInterpolatedAttributeList = typename Property<P>::ZoomInterpolatedAttributeList;
     template <class P>
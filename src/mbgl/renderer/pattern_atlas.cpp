@@ -3,6 +3,9 @@
 #include <mbgl/gfx/context.hpp>
 #include <mbgl/gfx/texture2d.hpp>
 
+#include <algorithm>
+#include <vector>
+
 namespace mbgl {
 
 namespace {
@@ -14,11 +17,20 @@ namespace {
 const uint16_t padding = 1;
 
 mapbox::ShelfPack::ShelfPackOptions shelfPackOptions() {
+    // Resized by `pack` once the unused patterns can't make room
     mapbox::ShelfPack::ShelfPackOptions options;
-    options.autoResize = true;
+    options.autoResize = false;
     return options;
 }
 
+Rect<uint32_t> unite(const Rect<uint32_t>& a, const Rect<uint32_t>& b) {
+    const uint32_t left = std::min(a.x, b.x);
+    const uint32_t top = std::min(a.y, b.y);
+    const uint32_t right = std::max(a.x + a.w, b.x + b.w);
+    const uint32_t bottom = std::max(a.y + a.h, b.y + b.h);
+    return {left, top, right - left, bottom - top};
+}
+
 } // namespace
 
 PatternAtlas::PatternAtlas()
@@ -29,6 +41,7 @@ PatternAtlas::~PatternAtlas() = default;
 std::optional<ImagePosition> PatternAtlas::getPattern(const std::string& id) const {
     auto it = patterns.find(id);
     if (it != patterns.end()) {
+        it->second.lastUsed = frame;
         return it->second.position;
     }
     return std::nullopt;
@@ -41,7 +54,7 @@ std::optional<ImagePosition> PatternAtlas::addPattern(const style::Image::Impl&
     const uint16_t width = image.image.size.width + padding * 2;
     const uint16_t height = image.image.size.height + padding * 2;
 
-    mapbox::Bin* bin = shelfPack.packOne(-1, width, height);
+    mapbox::Bin* bin = pack(width, height);
     if (!bin) {
         return std::nullopt;
     }
@@ -63,13 +76,59 @@ std::optional<ImagePosition> PatternAtlas::addPattern(const style::Image::Impl&
     PremultipliedImage::copy(src, atlasImage, {w - 1, 0}, {x - 1, y}, {1, h}); // L
     PremultipliedImage::copy(src, atlasImage, {0, 0}, {x + w, y}, {1, h});     // R
 
-    dirty = true;
+    const Rect<uint32_t> binRect(bin->x, bin->y, bin->w, bin->h);
+    dirtyRect = dirtyRect ? unite(*dirtyRect, binRect) : binRect;
 
     return patterns
-        .emplace(image.id, Pattern{.bin = bin, .position = {Rect<uint16_t>(bin->x, bin->y, bin->w, bin->h), image}})
+        .emplace(image.id,
+                 Pattern{.bin = bin,
+                         .position = {Rect<uint16_t>(bin->x, bin->y, bin->w, bin->h), image},
+                         .lastUsed = frame})
         .first->second.position;
 }
 
+mapbox::Bin* PatternAtlas::pack(int32_t width, int32_t height) {
+    if (mapbox::Bin* bin = shelfPack.packOne(-1, width, height)) {
+        return bin;
+    }
+
+    // Make room from the patterns unused in this frame, least recently used first, before growing the atlas
+    std::vector<decltype(patterns)::iterator> unused;
+    for (auto it = patterns.begin(); it != patterns.end(); ++it) {
+        if (it->second.lastUsed < frame) {
+            unused.push_back(it);
+        }
+    }
+    std::sort(unused.begin(), unused.end(), [](const auto& a, const auto& b) {
+        return a->second.lastUsed < b->second.lastUsed;
+    });
+    for (const auto& it : unused) {
+        shelfPack.unref(*it->second.bin);
+        patterns.erase(it);
+        if (mapbox::Bin* bin = shelfPack.packOne(-1, width, height)) {
+            return bin;
+        }
+    }
+
+    // Grow the way the shelf packer's own automatic resizing does
+    while (true) {
+        int32_t newWidth = shelfPack.width();
+        int32_t newHeight = shelfPack.height();
+        if (newWidth <= newHeight || width > newWidth) {
+            newWidth = std::max(width, newWidth) * 2;
+        }
+        if (newHeight < newWidth || height > newHeight) {
+            newHeight = std::max(height, newHeight) * 2;
+        }
+        if (!shelfPack.resize(newWidth, newHeight)) {
+            return nullptr;
+        }
+        if (mapbox::Bin* bin = shelfPack.packOne(-1, width, height)) {
+            return bin;
+        }
+    }
+}
+
 void PatternAtlas::removePattern(const std::string& id) {
     auto it = patterns.find(id);
     if (it != patterns.end()) {
@@ -95,14 +154,27 @@ void PatternAtlas::upload([[maybe_unused]] gfx::UploadPass& uploadPass) {
         if (atlasTexture2D) {
             atlasTexture2D->upload(atlasImage);
         }
-    } else if (dirty) {
-        atlasTexture2D->upload(atlasImage);
+    } else if (dirtyRect) {
+        if (atlasTexture2D->getSize() != atlasImage.size) {
+            atlasTexture2D->upload(atlasImage);
+        } else {
+            // Only the region of the patterns added since the last upload
+            PremultipliedImage region({dirtyRect->w, dirtyRect->h});
+            PremultipliedImage::copy(atlasImage, region, {dirtyRect->x, dirtyRect->y}, {0, 0}, region.size);
+            atlasTexture2D->uploadSubRegion(
+                region, static_cast<uint16_t>(dirtyRect->x), static_cast<uint16_t>(dirtyRect->y));
+        }
     }
-    dirty = false;
+    dirtyRect.reset();
+    frame++;
 }
 
 const std::shared_ptr<gfx::Texture2D>& PatternAtlas::texture() const {
     return atlasTexture2D;
 }
 
+MemoryUsage PatternAtlas::getMemoryUsage() const {
+    return {.cpu = atlasImage.bytes(), .gpu = atlasTexture2D ? atlasTexture2D->getDataSize() : 0};
+}
+
 } // namespace mbgl
@@ -2,6 +2,8 @@
 
 #include <mapbox/shelf-pack.hpp>
 #include <mbgl/style/image_impl.hpp>
+#include <mbgl/util/memory_usage.hpp>
+#include <mbgl/util/rect.hpp>
 
 #include <unordered_map>
 #include <string>
@@ -17,6 +19,13 @@ class Texture2D;
 class UploadPass;
 } // namespace gfx
 
+/**
+ * @brief The long-lived atlas of the pattern images, shelf-packed into one texture.
+ *
+ * Patterns added since the last upload are uploaded as the region bounding them, unless the atlas grew. When a
+ * pattern doesn't fit, the least recently used patterns that weren't used since the last upload make room for it
+ * before the atlas grows.
+ */
 class PatternAtlas {
 public:
     PatternAtlas();
@@ -24,15 +33,20 @@ public:
     PatternAtlas& operator=(const PatternAtlas&) = delete;
     ~PatternAtlas();
 
+    /// Also marks the pattern as used in the current frame
     std::optional<ImagePosition> getPattern(const std::string&) const;
     std::optional<ImagePosition> addPattern(const style::Image::Impl&);
     void removePattern(const std::string&);
 
     const std::shared_ptr<gfx::Texture2D>& texture() const;
 
+    /// Uploads the patterns added since the previous call, which ends the frame
     void upload(gfx::UploadPass&);
     Size getPixelSize() const;
 
+    /// Approximate memory held by the atlas image and its texture
+    MemoryUsage getMemoryUsage() const;
+
     const PremultipliedImage& getAtlasImageForTests() const { return atlasImage; }
 
     bool isEmpty() const { return patterns.empty(); }
@@ -41,12 +55,19 @@ private:
     struct Pattern {
         mapbox::Bin* bin;
         ImagePosition position;
+        /// The frame the pattern was last used in
+        mutable uint64_t lastUsed;
     };
+
+    mapbox::Bin* pack(int32_t width, int32_t height);
+
     mapbox::ShelfPack shelfPack;
     std::unordered_map<std::string, Pattern> patterns;
     PremultipliedImage atlasImage;
     std::shared_ptr<gfx::Texture2D> atlasTexture2D{nullptr};
-    bool dirty = true;
+    /// The region of the atlas image changed since the last upload
+    std::optional<Rect<uint32_t>> dirtyRect;
+    uint64_t frame = 0;
 };
 
 } // namespace mbgl
@@ -13,6 +13,8 @@
 
 #include <mbgl/renderer/layer_group.hpp>
 
+#include <algorithm>
+
 namespace mbgl {
 
 using namespace style;
@@ -155,6 +157,39 @@ std::size_t RenderLayer::removeAllDrawables() {
     return 0;
 }
 
+std::size_t RenderLayer::skipOccludedDrawables(const std::vector<UnwrappedTileID>& opaqueTiles) {
+    if (!layerGroup || layerGroup->getType() != LayerGroupBase::Type::TileLayerGroup) {
+        return 0;
+    }
+    if (opaqueTiles.empty() && occludedDrawables.empty()) {
+        return 0;
+    }
+
+    // Rebuilt on each pass, which drops the drawables removed since the last one
+    std::unordered_set<util::SimpleIdentity> stillOccluded;
+    static_cast<TileLayerGroup&>(*layerGroup).visitDrawables([&](gfx::Drawable& drawable) {
+        // Only drawables clipped to their tile are sure not to show outside of it
+        const auto& tileID = drawable.getTileID();
+        if (!tileID || !drawable.getEnableStencil() || drawable.getIs3D()) {
+            return;
+        }
+        const auto unwrapped = tileID->toUnwrapped();
+        const bool occluded = std::ranges::any_of(opaqueTiles, [&](const UnwrappedTileID& opaqueTile) {
+            return unwrapped == opaqueTile || unwrapped.isChildOf(opaqueTile);
+        });
+        // Leave the drawables disabled for other reasons alone
+        const bool wasOccluded = occludedDrawables.contains(drawable.getID());
+        if (occluded && (wasOccluded || drawable.getEnabled())) {
+            drawable.setEnabled(false);
+            stillOccluded.insert(drawable.getID());
+        } else if (!occluded && wasOccluded) {
+            drawable.setEnabled(true);
+        }
+    });
+    occludedDrawables = std::move(stillOccluded);
+    return occludedDrawables.size();
+}
+
 void RenderLayer::updateRenderTileIDs() {
     if (!renderTiles || renderTiles->empty()) {
         renderTileIDs.clear();
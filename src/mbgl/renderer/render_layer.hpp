@@ -14,6 +14,8 @@
 #include <list>
 #include <memory>
 #include <string>
+#include <unordered_set>
+#include <vector>
 
 namespace mbgl {
 class Bucket;
@@ -81,6 +83,10 @@ public:
     PatternAtlas& patternAtlas;
     LineAtlas& lineAtlas;
     const TransformState& state;
+    /// Size of the heatmap density textures relative to the viewport
+    float heatmapResolutionScale;
+    /// On-screen size, in pixels, below which fill extrusion walls are left out, zero for never
+    float fillExtrusionLODThreshold;
 };
 
 class RenderLayer {
@@ -188,9 +194,22 @@ public:
     /// Remove all the drawables for tiles
     virtual std::size_t removeAllDrawables();
 
+    /// Add the tiles whose whole area this layer paints over with opaque color as of the last
+    /// `update`, hiding the layers below it there
+    virtual void collectOpaqueTiles(std::vector<UnwrappedTileID>&) const {}
+
+    /// Skip the tile-clipped drawables of the tiles lying within the given opaque tiles of the layers
+    /// above, and restore those no longer hidden.
+    /// @return The number of drawables skipped
+    std::size_t skipOccludedDrawables(const std::vector<UnwrappedTileID>& opaqueTiles);
+
     using Dependency = style::expression::Dependency;
     Dependency getStyleDependencies() const { return styleDependencies; }
 
+    /// Whether a change of zoom may change the evaluated properties, so that `evaluate` is only called for it
+    /// when it does
+    bool isZoomDependent() const { return zoomDependent; }
+
 protected:
     // Checks whether the current hardware can render this layer. If it can't,
     // we'll show a warning in the console to inform the developer.
@@ -313,10 +332,14 @@ protected:
     int32_t layerIndex{0};
 
     Dependency styleDependencies = Dependency::None;
+    bool zoomDependent = false;
 
     // Current renderable status as specified by the markLayerRenderable event
     bool isRenderable{false};
 
+    // Drawables disabled by `skipOccludedDrawables`, to be enabled again once uncovered
+    std::unordered_set<util::SimpleIdentity> occludedDrawables;
+
     struct Stats {
         size_t propertyEvaluations = 0;
         size_t drawablesAdded = 0;
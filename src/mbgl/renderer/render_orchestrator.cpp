@@ -19,11 +19,13 @@
 #include <mbgl/renderer/style_diff.hpp>
 #include <mbgl/renderer/query.hpp>
 #include <mbgl/renderer/image_manager.hpp>
+#include <mbgl/geometry/feature_index.hpp>
 #include <mbgl/geometry/line_atlas.hpp>
 #include <mbgl/style/source_impl.hpp>
 #include <mbgl/style/transition_options.hpp>
 #include <mbgl/text/glyph_manager.hpp>
 #include <mbgl/tile/tile.hpp>
+#include <mbgl/math/clamp.hpp>
 #include <mbgl/util/instrumentation.hpp>
 #include <mbgl/util/math.hpp>
 #include <mbgl/util/string.hpp>
@@ -116,7 +118,8 @@ RenderOrchestrator::RenderOrchestrator(bool backgroundLayerAsColor_,
                                        TaggedScheduler& threadPool_,
                                        const std::optional<std::string>& localFontFamily_)
     : observer(&nullObserver()),
-      glyphManager(std::make_unique<GlyphManager>(std::make_unique<LocalGlyphRasterizer>(localFontFamily_))),
+      glyphManager(
+          std::make_unique<GlyphManager>(std::make_unique<LocalGlyphRasterizer>(localFontFamily_), localFontFamily_)),
       imageManager(ImageManager::create()),
       lineAtlas(std::make_unique<LineAtlas>()),
       patternAtlas(std::make_unique<PatternAtlas>()),
@@ -201,7 +204,12 @@ std::unique_ptr<RenderTree> RenderOrchestrator::createRenderTree(
                                   .tileLodPitchThreshold = updateParameters->tileLodPitchThreshold,
                                   .tileLodZoomShift = updateParameters->tileLodZoomShift,
                                   .tileLodMode = updateParameters->tileLodMode,
-                                  .dynamicTextureAtlas = dynamicTextureAtlas};
+                                  .tileLodMaxTiles = updateParameters->tileLodMaxTiles,
+                                  .tileUploadBudget = updateParameters->tileUploadBudget,
+                                  .dynamicTextureAtlas = dynamicTextureAtlas,
+                                  .transitionTargetState = updateParameters->transitionTargetState
+                                                               ? &*updateParameters->transitionTargetState
+                                                               : nullptr};
 
     glyphManager->setURL(updateParameters->glyphURL);
     glyphManager->setFontFaces(updateParameters->fontFaces);
@@ -218,7 +226,13 @@ std::unique_ptr<RenderTree> RenderOrchestrator::createRenderTree(
         renderLight.evaluate(evaluationParameters);
     }
 
-    const ImageDifference imageDiff = diffImages(imageImpls, updateParameters->images);
+    // Updates that only move the camera keep the same style immutables, so diffing them can be skipped
+    const bool imagesChanged = imageImpls != updateParameters->images;
+    const bool layersChanged = layerImpls != updateParameters->layers;
+    const bool sourcesChanged = sourceImpls != updateParameters->sources;
+
+    const ImageDifference imageDiff = imagesChanged ? diffImages(imageImpls, updateParameters->images)
+                                                    : ImageDifference();
     imageImpls = updateParameters->images;
 
     // Only trigger tile reparse for changed images. Changed images only need a
@@ -247,7 +261,9 @@ std::unique_ptr<RenderTree> RenderOrchestrator::createRenderTree(
     imageManager->notifyIfMissingImageAdded();
     imageManager->setLoaded(updateParameters->spriteLoaded);
 
-    const LayerDifference layerDiff = diffLayers(layerImpls, updateParameters->layers);
+    const LayerDifference layerDiff =
+        layersChanged ? diffLayers(layerImpls, updateParameters->layers, updateParameters->layerJournal.get())
+                      : LayerDifference();
     layerImpls = updateParameters->layers;
     const bool layersAddedOrRemoved = !layerDiff.added.empty() || !layerDiff.removed.empty();
 
@@ -299,6 +315,18 @@ std::unique_ptr<RenderTree> RenderOrchestrator::createRenderTree(
 
     if (layersAddedOrRemoved || !layerDiff.changed.empty()) {
         glyphManager->evict(fontStacks(*layerImpls));
+
+        // A changed layer may have moved to another source
+        layerIndicesBySource.clear();
+        sourcelessLayerIndices.clear();
+        for (std::size_t index = 0; index < orderedLayers.size(); ++index) {
+            const RenderLayer& layer = orderedLayers[index];
+            if (layer.baseImpl->getTypeInfo()->source != LayerTypeInfo::Source::NotRequired) {
+                layerIndicesBySource[layer.baseImpl->source].push_back(index);
+            } else {
+                sourcelessLayerIndices.push_back(index);
+            }
+        }
     }
 
     // Update layers for class and zoom changes.
@@ -310,10 +338,9 @@ std::unique_ptr<RenderTree> RenderOrchestrator::createRenderTree(
         evaluationParameters.layerChanged = layerAddedOrChanged;
         evaluationParameters.hasCrossfade = layer.hasCrossfade();
 
-        // Only re-evaluate on change of zoom if the style has some reference to it
-        using Dependency = expression::Dependency;
-        const bool zoomChangedAndMatters = zoomChanged && !layerAddedOrChanged &&
-                                           (layer.getStyleDependencies() & Dependency::Zoom);
+        // Only re-evaluate on change of zoom if some property evaluates to another value at another zoom, and
+        // not for the data-driven expressions that evaluate per feature
+        const bool zoomChangedAndMatters = zoomChanged && !layerAddedOrChanged && layer.isZoomDependent();
 
         if (layerAddedOrChanged || zoomChangedAndMatters || evaluationParameters.hasCrossfade ||
             layer.hasTransition()) {
@@ -325,7 +352,9 @@ std::unique_ptr<RenderTree> RenderOrchestrator::createRenderTree(
         }
     }
 
-    const SourceDifference sourceDiff = diffSources(sourceImpls, updateParameters->sources);
+    const SourceDifference sourceDiff =
+        sourcesChanged ? diffSources(sourceImpls, updateParameters->sources, updateParameters->sourceJournal.get())
+                       : SourceDifference();
     sourceImpls = updateParameters->sources;
 
     // Remove render layers for removed sources.
@@ -363,6 +392,14 @@ std::unique_ptr<RenderTree> RenderOrchestrator::createRenderTree(
     // Track which layers are flagged for rendering
     std::vector<bool> updateList(orderedLayers.size());
 
+    if (!sourceImpls->empty()) {
+        for (const RenderLayer& layer : orderedLayers) {
+            renderTreeParameters->has3D |= (layer.baseImpl->getTypeInfo()->pass3d == LayerTypeInfo::Pass3D::Required);
+        }
+    }
+
+    const auto styleEndTime = util::MonotonicTimer::now().count();
+
     // Update all sources and initialize renderItems.
     for (const auto& sourceImpl : *sourceImpls) {
         MLN_TRACE_ZONE(update source);
@@ -372,34 +409,32 @@ std::unique_ptr<RenderTree> RenderOrchestrator::createRenderTree(
         bool sourceNeedsRendering = false;
         bool sourceNeedsRelayout = false;
 
-        for (std::size_t index = 0; index < orderedLayers.size(); ++index) {
-            RenderLayer& layer = orderedLayers[index];
-            const auto* layerInfo = layer.baseImpl->getTypeInfo();
-            const bool layerIsVisible = layer.baseImpl->visibility != style::VisibilityType::None;
-            const bool zoomFitsLayer = layer.supportsZoom(zoomHistory.lastZoom);
-            renderTreeParameters->has3D |= (layerInfo->pass3d == LayerTypeInfo::Pass3D::Required);
-
-            if (layerInfo->source != LayerTypeInfo::Source::NotRequired) {
-                if (layer.baseImpl->source == sourceImpl->id) {
-                    const std::string& layerId = layer.getID();
-                    sourceNeedsRelayout = (sourceNeedsRelayout || hasImageDiff ||
-                                           constantsMaskChanged.contains(layerId) ||
-                                           hasLayoutDifference(layerDiff, layerId));
-                    if (layerIsVisible) {
-                        filteredLayersForSource.push_back(layer.evaluatedProperties);
-                        if (zoomFitsLayer) {
-                            sourceNeedsRendering = true;
-                            renderItemsEmplaceHint = layerRenderItems.emplace_hint(
-                                renderItemsEmplaceHint, layer, source, static_cast<uint32_t>(index));
-                            updateList[index] = true;
-                        }
+        if (const auto it = layerIndicesBySource.find(sourceImpl->id); it != layerIndicesBySource.end()) {
+            for (const std::size_t index : it->second) {
+                RenderLayer& layer = orderedLayers[index];
+                const std::string& layerId = layer.getID();
+                sourceNeedsRelayout = (sourceNeedsRelayout || hasImageDiff || constantsMaskChanged.contains(layerId) ||
+                                       hasLayoutDifference(layerDiff, layerId));
+                if (layer.baseImpl->visibility != style::VisibilityType::None) {
+                    filteredLayersForSource.push_back(layer.evaluatedProperties);
+                    if (layer.supportsZoom(zoomHistory.lastZoom)) {
+                        sourceNeedsRendering = true;
+                        renderItemsEmplaceHint = layerRenderItems.emplace_hint(
+                            renderItemsEmplaceHint, layer, source, static_cast<uint32_t>(index));
+                        updateList[index] = true;
                     }
                 }
-                continue;
             }
+        }
 
-            // Handle layers without source.
-            if (layerIsVisible && zoomFitsLayer && sourceImpl.get() == sourceImpls->at(0).get()) {
+        // Handle layers without source.
+        if (sourceImpl.get() == sourceImpls->at(0).get()) {
+            for (const std::size_t index : sourcelessLayerIndices) {
+                RenderLayer& layer = orderedLayers[index];
+                if (layer.baseImpl->visibility == style::VisibilityType::None ||
+                    !layer.supportsZoom(zoomHistory.lastZoom)) {
+                    continue;
+                }
                 if (backgroundLayerAsColor && layer.baseImpl == layerImpls->front()) {
                     const auto& solidBackground = layer.getSolidBackground();
                     if (solidBackground) {
@@ -416,6 +451,9 @@ std::unique_ptr<RenderTree> RenderOrchestrator::createRenderTree(
         tileParameters.isUpdateSynchronous = sourceImpl->isUpdateSynchronous();
         source->update(sourceImpl, filteredLayersForSource, sourceNeedsRendering, sourceNeedsRelayout, tileParameters);
         filteredLayersForSource.clear();
+        if (const auto* latencies = source->takeTileLatencyUpdate()) {
+            observer->onTileLatencies(sourceImpl->id, *latencies);
+        }
 
         // Update all layers with their new renderability status, if it changed.
         for (size_t i = 0; i < updateList.size(); i++) {
@@ -426,6 +464,8 @@ std::unique_ptr<RenderTree> RenderOrchestrator::createRenderTree(
         addChanges(changes);
     }
 
+    const auto sourcesEndTime = util::MonotonicTimer::now().count();
+
     renderTreeParameters->loaded = updateParameters->styleLoaded && isLoaded();
     if (!isMapModeContinuous && !renderTreeParameters->loaded) {
         return nullptr;
@@ -452,7 +492,9 @@ std::unique_ptr<RenderTree> RenderOrchestrator::createRenderTree(
                              .imageManager = *imageManager,
                              .patternAtlas = *patternAtlas,
                              .lineAtlas = *lineAtlas,
-                             .state = updateParameters->transformState});
+                             .state = updateParameters->transformState,
+                             .heatmapResolutionScale = heatmapResolutionScale,
+                             .fillExtrusionLODThreshold = fillExtrusionLODThreshold});
         if (renderLayer.needsPlacement()) {
             layersNeedPlacement.emplace_back(renderLayer);
         }
@@ -464,6 +506,8 @@ std::unique_ptr<RenderTree> RenderOrchestrator::createRenderTree(
         }
     }
 
+    const auto prepareEndTime = util::MonotonicTimer::now().count();
+
     // Symbol placement.
     assert((updateParameters->mode == MapMode::Tile) || !placedSymbolDataCollected);
     bool symbolBucketsChanged = false;
@@ -532,6 +576,13 @@ std::unique_ptr<RenderTree> RenderOrchestrator::createRenderTree(
         renderTreeParameters->needsRepaint = false;
     }
 
+    const auto placementEndTime = util::MonotonicTimer::now().count();
+    renderTreeParameters->cameraOnlyUpdate = !imagesChanged && !layersChanged && !sourcesChanged && !lightChanged;
+    renderTreeParameters->styleUpdateTime = styleEndTime - startTime;
+    renderTreeParameters->sourceUpdateTime = sourcesEndTime - styleEndTime;
+    renderTreeParameters->prepareTime = prepareEndTime - sourcesEndTime;
+    renderTreeParameters->placementTime = placementEndTime - prepareEndTime;
+
     if (!renderTreeParameters->needsRepaint && renderTreeParameters->loaded) {
         MLN_TRACE_ZONE(reduce);
         // Notify observer about unused images when map is fully loaded
@@ -546,6 +597,7 @@ std::unique_ptr<RenderTree> RenderOrchestrator::createRenderTree(
         }
     }
 
+    renderTreeParameters->renderTreeTime = util::MonotonicTimer::now().count() - startTime;
     return std::make_unique<RenderTreeImpl>(std::move(renderTreeParameters),
                                             std::move(layerRenderItems),
                                             std::move(sourceRenderItems),
@@ -610,6 +662,9 @@ void RenderOrchestrator::queryRenderedSymbols(std::unordered_map<std::string, st
     });
 
     for (auto wrappedQueryData : bucketQueryData) {
+        if (options.limit && featureCount(resultsByLayer) >= *options.limit) {
+            break;
+        }
         auto& queryData = wrappedQueryData.get();
         auto bucketSymbols = queryData.featureIndex->lookupSymbolFeatures(renderedSymbols[queryData.bucketInstanceId],
                                                                           options,
@@ -645,6 +700,9 @@ std::vector<Feature> RenderOrchestrator::queryRenderedFeatures(
 
     std::unordered_map<std::string, std::vector<Feature>> resultsByLayer;
     for (const auto& sourceID : sourceIDs) {
+        if (options.limit && featureCount(resultsByLayer) >= *options.limit) {
+            break;
+        }
         if (RenderSource* renderSource = getRenderSource(sourceID)) {
             auto sourceResults = renderSource->queryRenderedFeatures(
                 geometry, transformState, filteredLayers, options, projMatrix);
@@ -674,6 +732,11 @@ std::vector<Feature> RenderOrchestrator::queryRenderedFeatures(
         }
     }
 
+    // A feature matching several layers is added for all of them, which can overshoot the limit
+    if (options.limit && result.size() > *options.limit) {
+        result.resize(*options.limit);
+    }
+
     return result;
 }
 
@@ -733,6 +796,16 @@ void RenderOrchestrator::setFeatureState(const std::string& sourceID,
     }
 }
 
+void RenderOrchestrator::setFeatureStates(const std::string& sourceID,
+                                          const std::optional<std::string>& sourceLayerID,
+                                          const FeatureStates& states) {
+    MLN_TRACE_FUNC();
+
+    if (RenderSource* renderSource = getRenderSource(sourceID)) {
+        renderSource->setFeatureStates(sourceLayerID, states);
+    }
+}
+
 void RenderOrchestrator::getFeatureState(FeatureState& state,
                                          const std::string& sourceID,
                                          const std::optional<std::string>& sourceLayerID,
@@ -767,6 +840,22 @@ bool RenderOrchestrator::getTileCacheEnabled() const {
     return tileCacheEnabled;
 }
 
+void RenderOrchestrator::setHeatmapResolutionScale(float scale) {
+    heatmapResolutionScale = util::clamp(scale, 1.0f / 8.0f, 1.0f);
+}
+
+float RenderOrchestrator::getHeatmapResolutionScale() const {
+    return heatmapResolutionScale;
+}
+
+void RenderOrchestrator::setFillExtrusionLODThreshold(float pixels) {
+    fillExtrusionLODThreshold = std::max(pixels, 0.0f);
+}
+
+float RenderOrchestrator::getFillExtrusionLODThreshold() const {
+    return fillExtrusionLODThreshold;
+}
+
 void RenderOrchestrator::reduceMemoryUse() {
     MLN_TRACE_FUNC();
 
@@ -778,6 +867,51 @@ void RenderOrchestrator::reduceMemoryUse() {
     observer->onInvalidate();
 }
 
+void RenderOrchestrator::reduceMemoryUse(MemoryPressureLevel level, MemoryPressureReport& report) {
+    MLN_TRACE_FUNC();
+
+    const bool critical = level == MemoryPressureLevel::Critical;
+    const auto step = [&](std::string name, const auto& measure, const auto& release) {
+        const std::size_t before = measure();
+        release();
+        const std::size_t after = measure();
+        report.steps.push_back({.name = std::move(name), .freedBytes = before > after ? before - after : 0});
+    };
+
+    step(
+        "tile caches",
+        [&] {
+            MemoryReport::Source usage;
+            std::map<std::string, MemoryUsage> layers;
+            for (const auto& entry : renderSources) {
+                entry.second->reportMemoryUsage(usage, layers);
+            }
+            return usage.total().total();
+        },
+        [&] {
+            for (const auto& entry : renderSources) {
+                if (critical) {
+                    entry.second->reduceMemoryUse();
+                } else {
+                    entry.second->trimCache();
+                }
+            }
+        });
+    step(
+        "text shaping cache",
+        [&] { return glyphManager->getShapingCacheStats().bytes; },
+        [&] { glyphManager->trimShapingCache(critical ? 0 : glyphManager->getShapingCacheStats().bytes / 2); });
+    step(
+        "style images",
+        [&] { return imageManager->getMemoryUsage().total(); },
+        [&] { imageManager->reduceMemoryUse(); });
+
+    if (critical) {
+        filteredLayersForSource.shrink_to_fit();
+    }
+    observer->onInvalidate();
+}
+
 void RenderOrchestrator::dumpDebugLogs() {
     MLN_TRACE_FUNC();
 
@@ -788,6 +922,36 @@ void RenderOrchestrator::dumpDebugLogs() {
     imageManager->dumpDebugLogs();
 }
 
+MemoryReport RenderOrchestrator::getMemoryReport() const {
+    MLN_TRACE_FUNC();
+
+    MemoryReport report;
+    std::map<std::string, MemoryUsage> layers;
+    report.sources.reserve(renderSources.size());
+    for (const auto& [id, source] : renderSources) {
+        MemoryReport::Source sourceReport{.id = id};
+        source->reportMemoryUsage(sourceReport, layers);
+        report.sources.push_back(std::move(sourceReport));
+    }
+    std::sort(report.sources.begin(), report.sources.end(), [](const auto& a, const auto& b) {
+        return a.total().total() > b.total().total();
+    });
+
+    report.layers.reserve(layers.size());
+    for (auto& [id, buckets] : layers) {
+        report.layers.push_back({.id = id, .buckets = buckets});
+    }
+    std::stable_sort(report.layers.begin(), report.layers.end(), [](const auto& a, const auto& b) {
+        return a.buckets.total() > b.buckets.total();
+    });
+
+    report.glyphs = glyphManager->getMemoryUsage();
+    report.images = imageManager->getMemoryUsage();
+    report.lineAtlas = lineAtlas->getMemoryUsage();
+    report.patternAtlas = patternAtlas->getMemoryUsage();
+    return report;
+}
+
 void RenderOrchestrator::collectPlacedSymbolData(bool enable) {
     placedSymbolDataCollected = enable;
 }
@@ -827,7 +991,7 @@ bool RenderOrchestrator::hasTransitions(TimePoint timePoint) const {
     }
 
     for (const auto& entry : renderSources) {
-        if (entry.second->hasFadingTiles()) {
+        if (entry.second->hasFadingTiles() || entry.second->hasDeferredUploads()) {
             return true;
         }
     }
@@ -984,6 +1148,15 @@ void RenderOrchestrator::updateLayers(gfx::ShaderRegistry& shaders,
         }
     }
     addChanges(changes);
+
+    // From the top down, skip what lies under tiles fully covered by opaque fills
+    std::vector<UnwrappedTileID> opaqueTiles;
+    occludedDrawables = 0;
+    for (auto it = items.rbegin(); it != items.rend(); ++it) {
+        auto& renderLayer = it->layer.get();
+        occludedDrawables += renderLayer.skipOccludedDrawables(opaqueTiles);
+        renderLayer.collectOpaqueTiles(opaqueTiles);
+    }
 }
 
 void RenderOrchestrator::processChanges() {
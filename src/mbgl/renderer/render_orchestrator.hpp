@@ -83,6 +83,10 @@ public:
                          const std::string& featureID,
                          const FeatureState& state);
 
+    void setFeatureStates(const std::string& sourceID,
+                          const std::optional<std::string>& layerID,
+                          const FeatureStates& states);
+
     void getFeatureState(FeatureState& state,
                          const std::string& sourceID,
                          const std::optional<std::string>& layerID,
@@ -95,8 +99,16 @@ public:
 
     void setTileCacheEnabled(bool);
     bool getTileCacheEnabled() const;
+    void setHeatmapResolutionScale(float);
+    float getHeatmapResolutionScale() const;
+    void setFillExtrusionLODThreshold(float);
+    float getFillExtrusionLODThreshold() const;
     void reduceMemoryUse();
+    /// The steps of `Renderer::onMemoryPressure` that release the memory of sources and shared resources
+    void reduceMemoryUse(MemoryPressureLevel, MemoryPressureReport&);
     void dumpDebugLogs();
+    /// The sources, layers and shared resources of the report, without the context totals
+    MemoryReport getMemoryReport() const;
     void collectPlacedSymbolData(bool);
     const std::vector<PlacedSymbolData>& getPlacedSymbolsData() const;
     void clearData();
@@ -140,6 +152,21 @@ public:
                       const std::shared_ptr<UpdateParameters>&,
                       const RenderTree&);
 
+    /// Number of drawables the last `updateLayers` skipped, hidden under opaque fills covering their tile
+    std::size_t numOccludedDrawables() const noexcept { return occludedDrawables; }
+
+    /// Number of symbols the current placement skipped, being too far outside the viewport to be placed
+    std::size_t numCulledSymbols() const { return placementController.getPlacement()->getCulledSymbolCount(); }
+
+    /// Number of collision tests the current placement made for labels at variable anchors, and of the labels it
+    /// placed at their previous anchor on the first test
+    std::size_t numVariableAnchorTests() const {
+        return placementController.getPlacement()->getVariableAnchorTestCount();
+    }
+    std::size_t numPreviousAnchorPlacements() const {
+        return placementController.getPlacement()->getPreviousAnchorPlacementCount();
+    }
+
     void processChanges();
 
     bool addRenderTarget(RenderTargetPtr);
@@ -224,6 +251,9 @@ private:
     bool contextLost = false;
     bool placedSymbolDataCollected = false;
     bool tileCacheEnabled = true;
+    float heatmapResolutionScale = 0.5f;
+    float fillExtrusionLODThreshold = 0.0f;
+    std::size_t occludedDrawables = 0;
 
 #if MLN_RENDER_BACKEND_OPENGL
     bool androidGoldfishMitigationEnabled{false};
@@ -233,6 +263,9 @@ private:
     // reallocation on each frame.
     std::vector<Immutable<style::LayerProperties>> filteredLayersForSource;
     RenderLayerReferences orderedLayers;
+    // Indices into orderedLayers, rebuilt when the layers change rather than on every frame
+    std::unordered_map<std::string, std::vector<std::size_t>> layerIndicesBySource;
+    std::vector<std::size_t> sourcelessLayerIndices;
     RenderLayerReferences layersNeedPlacement;
 
     TaggedScheduler threadPool;
@@ -2,6 +2,7 @@
 
 #include <mbgl/actor/scheduler.hpp>
 #include <mbgl/map/mode.hpp>
+#include <mbgl/renderer/memory_report.hpp>
 #include <mbgl/tile/tile_id.hpp>
 #include <mbgl/tile/tile_observer.hpp>
 #include <mbgl/util/mat4.hpp>
@@ -31,6 +32,7 @@ class Scheduler;
 class SourceQueryOptions;
 class Tile;
 class TileParameters;
+struct TileLatencies;
 class TransformParameters;
 class TransformState;
 
@@ -67,6 +69,10 @@ public:
     virtual void prepare(const SourcePrepareParameters&) = 0;
     virtual void updateFadingTiles() = 0;
     virtual bool hasFadingTiles() const = 0;
+    // Whether some tiles are waiting for a later frame to be uploaded
+    virtual bool hasDeferredUploads() const { return false; }
+    // The latencies of the source's tiles, if some were rendered for the first time since the last call
+    virtual const TileLatencies* takeTileLatencyUpdate() { return nullptr; }
     // If supported, returns a shared list of RenderTiles, sorted by tile id and
     // excluding tiles hold for fade; returns nullptr otherwise.
     virtual RenderTiles getRenderTiles() const { return nullptr; }
@@ -97,6 +103,12 @@ public:
 
     virtual void setFeatureState(const std::optional<std::string>&, const std::string&, const FeatureState&) {}
 
+    virtual void setFeatureStates(const std::optional<std::string>& sourceLayerID, const FeatureStates& states) {
+        for (const auto& [featureID, state] : states) {
+            setFeatureState(sourceLayerID, featureID, state);
+        }
+    }
+
     virtual void getFeatureState(FeatureState&, const std::optional<std::string>&, const std::string&) const {}
 
     virtual void removeFeatureState(const std::optional<std::string>&,
@@ -107,8 +119,14 @@ public:
 
     virtual void reduceMemoryUse() = 0;
 
+    /// Evict half of the memory of the cached tiles, see `MemoryPressureLevel::Moderate`
+    virtual void trimCache() {}
+
     virtual void dumpDebugLogs() const = 0;
 
+    /// Add the memory held by the source to its report, and the memory of its buckets to the layers using them
+    virtual void reportMemoryUsage(MemoryReport::Source&, std::map<std::string, MemoryUsage>& /*layers*/) const {}
+
     virtual uint8_t getMaxZoom() const;
 
     void setObserver(RenderSourceObserver*);
@@ -5,7 +5,7 @@
 
 namespace mbgl {
 
-RenderStaticData::RenderStaticData(std::unique_ptr<gfx::ShaderRegistry>&& shaders_)
+RenderStaticData::RenderStaticData(std::shared_ptr<gfx::ShaderRegistry> shaders_)
     : shaders(std::move(shaders_)),
       clippingMaskSegments(tileTriangleSegments()) {}
 
@@ -56,6 +56,15 @@ gfx::VertexVector<FillExtrusionStaticVertex> RenderStaticData::fillExtrusionVert
     return vertices;
 }
 
+gfx::VertexVector<CircleLayoutVertex> RenderStaticData::circleVertices() {
+    gfx::VertexVector<CircleLayoutVertex> vertices;
+    vertices.emplace_back(CircleLayoutVertex{{{-1, -1}}});
+    vertices.emplace_back(CircleLayoutVertex{{{1, -1}}});
+    vertices.emplace_back(CircleLayoutVertex{{{-1, 1}}});
+    vertices.emplace_back(CircleLayoutVertex{{{1, 1}}});
+    return vertices;
+}
+
 gfx::IndexVector<gfx::Triangles> RenderStaticData::quadTriangleIndices() {
     gfx::IndexVector<gfx::Triangles> indices;
     indices.emplace_back(0, 1, 2);
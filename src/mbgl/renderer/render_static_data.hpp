@@ -4,6 +4,7 @@
 #include <mbgl/gfx/index_buffer.hpp>
 #include <mbgl/gfx/renderbuffer.hpp>
 #include <mbgl/gfx/shader_registry.hpp>
+#include <mbgl/renderer/buckets/circle_bucket.hpp>
 #include <mbgl/renderer/buckets/heatmap_bucket.hpp>
 #include <mbgl/renderer/buckets/raster_bucket.hpp>
 #include <mbgl/renderer/buckets/fill_extrusion_bucket.hpp>
@@ -19,7 +20,7 @@ class UploadPass;
 
 class RenderStaticData {
 public:
-    RenderStaticData(std::unique_ptr<gfx::ShaderRegistry>&& shaders_);
+    RenderStaticData(std::shared_ptr<gfx::ShaderRegistry> shaders_);
 
     void upload(gfx::UploadPass&);
 
@@ -30,6 +31,8 @@ public:
     static gfx::VertexVector<RasterLayoutVertex> rasterVertices();
     static gfx::VertexVector<HeatmapTextureLayoutVertex> heatmapTextureVertices();
     static gfx::VertexVector<FillExtrusionStaticVertex> fillExtrusionVertices();
+    /// Unit quad the circle instances are drawn with, in `quadTriangleIndices` order
+    static gfx::VertexVector<CircleLayoutVertex> circleVertices();
 
     static gfx::IndexVector<gfx::Triangles> quadTriangleIndices();
     static gfx::IndexVector<gfx::LineStrip> tileLineStripIndices();
@@ -46,7 +49,8 @@ public:
     bool uploaded = false;
     Size backendSize;
 
-    std::unique_ptr<gfx::ShaderRegistry> shaders;
+    /// Shared with other renderers when they are in the same `RendererResourceGroup`
+    std::shared_ptr<gfx::ShaderRegistry> shaders;
 
     const SegmentVector clippingMaskSegments;
 };
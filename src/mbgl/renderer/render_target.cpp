@@ -10,12 +10,15 @@
 
 namespace mbgl {
 
-RenderTarget::RenderTarget(gfx::Context& context_, const Size size, const gfx::TextureChannelDataType type)
-    : context(context_) {
-    offscreenTexture = context.createOffscreenTexture(size, type);
+RenderTarget::RenderTarget(gfx::Context& context_, const Size size, const gfx::TextureChannelDataType type_)
+    : context(context_),
+      type(type_) {
+    offscreenTexture = context.acquireOffscreenTexture(size, type);
 }
 
-RenderTarget::~RenderTarget() {}
+RenderTarget::~RenderTarget() {
+    context.releaseOffscreenTexture(std::move(offscreenTexture), type);
+}
 
 const gfx::Texture2DPtr& RenderTarget::getTexture() {
     return offscreenTexture->getTexture();
@@ -65,6 +68,10 @@ void RenderTarget::upload(gfx::UploadPass& uploadPass) {
 }
 
 void RenderTarget::render(RenderOrchestrator& orchestrator, const RenderTree& renderTree, PaintParameters& parameters) {
+    if (renderOnDemand && !dirty) {
+        return;
+    }
+
     parameters.renderPass = parameters.encoder->createRenderPass("render target",
                                                                  {.renderable = *offscreenTexture,
                                                                   .clearColor = Color{0.0f, 0.0f, 0.0f, 1.0f},
@@ -110,6 +117,9 @@ void RenderTarget::render(RenderOrchestrator& orchestrator, const RenderTree& re
     parameters.encoder->present(*offscreenTexture);
 
     parameters.scissorRect = prevScissorRect;
+
+    // Drawables waiting for their shader or textures were skipped, so the contents may be incomplete
+    dirty = context.hasPendingShaders() || context.hasPendingTextureUploads();
 }
 
 } // namespace mbgl
@@ -145,4 +145,8 @@ void RenderTile::setFeatureState(const LayerFeatureStates& states) {
     tile.setFeatureState(states);
 }
 
+bool RenderTile::needsAllFeatureStates() const {
+    return tile.needsAllFeatureStates();
+}
+
 } // namespace mbgl
@@ -80,6 +80,7 @@ public:
                             bool inViewportPixelUnits) const;
 
     void setFeatureState(const LayerFeatureStates&);
+    bool needsAllFeatureStates() const;
 
 private:
     Tile& tile;
@@ -83,6 +83,15 @@ public:
     bool needsRepaint = false;
     bool loaded = false;
     bool placementChanged = false;
+    // Neither the style images, layers, sources nor light changed since the previous tree
+    bool cameraOnlyUpdate = false;
+    // Time spent in each phase of building the tree (seconds)
+    double styleUpdateTime = 0.0;
+    double sourceUpdateTime = 0.0;
+    double prepareTime = 0.0;
+    double placementTime = 0.0;
+    // Time spent building the whole tree, including the phases above (seconds)
+    double renderTreeTime = 0.0;
 };
 
 class RenderTree {
@@ -2,6 +2,7 @@
 
 #include <mbgl/annotation/annotation_manager.hpp>
 #include <mbgl/gfx/backend_scope.hpp>
+#include <mbgl/gfx/context.hpp>
 #include <mbgl/gfx/dynamic_texture_atlas.hpp>
 #include <mbgl/gfx/renderer_backend.hpp>
 #include <mbgl/layermanager/layer_manager.hpp>
@@ -32,6 +33,10 @@ void Renderer::setObserver(RendererObserver* observer) {
     impl->orchestrator.setObserver(observer);
 }
 
+void Renderer::setResourceGroup(std::shared_ptr<RendererResourceGroup> group) {
+    impl->resourceGroup = std::move(group);
+}
+
 void Renderer::render(const std::shared_ptr<UpdateParameters>& updateParameters) {
     MLN_TRACE_FUNC();
     assert(updateParameters);
@@ -117,6 +122,12 @@ void Renderer::setFeatureState(const std::string& sourceID,
     impl->orchestrator.setFeatureState(sourceID, sourceLayerID, featureID, state);
 }
 
+void Renderer::setFeatureStates(const std::string& sourceID,
+                                const std::optional<std::string>& sourceLayerID,
+                                const FeatureStates& states) {
+    impl->orchestrator.setFeatureStates(sourceID, sourceLayerID, states);
+}
+
 void Renderer::getFeatureState(FeatureState& state,
                                const std::string& sourceID,
                                const std::optional<std::string>& sourceLayerID,
@@ -151,12 +162,77 @@ bool Renderer::getTileCacheEnabled() const {
     return impl->orchestrator.getTileCacheEnabled();
 }
 
+void Renderer::setHeatmapResolutionScale(float scale) {
+    impl->orchestrator.setHeatmapResolutionScale(scale);
+}
+
+float Renderer::getHeatmapResolutionScale() const {
+    return impl->orchestrator.getHeatmapResolutionScale();
+}
+
+void Renderer::setFillExtrusionLODThreshold(float pixels) {
+    impl->orchestrator.setFillExtrusionLODThreshold(pixels);
+}
+
+float Renderer::getFillExtrusionLODThreshold() const {
+    return impl->orchestrator.getFillExtrusionLODThreshold();
+}
+
+void Renderer::setGPUSectionTiming(bool enable) {
+    impl->gpuSectionTiming = enable;
+}
+
+bool Renderer::getGPUSectionTiming() const {
+    return impl->gpuSectionTiming;
+}
+
+std::vector<gfx::GPUSectionTime> Renderer::getGPUSectionTimes() const {
+    gfx::BackendScope guard{impl->backend};
+    return impl->backend.getContext().threadSafeCopyRenderingStats().gpuSectionTimes;
+}
+
+MemoryReport Renderer::getMemoryReport() const {
+    auto report = impl->orchestrator.getMemoryReport();
+    if (impl->dynamicTextureAtlas) {
+        report.textureAtlas.gpu = impl->dynamicTextureAtlas->getStats().textureBytes;
+    }
+
+    gfx::BackendScope guard{impl->backend};
+    const auto stats = impl->backend.getContext().threadSafeCopyRenderingStats();
+    report.contextTextureBytes = static_cast<std::size_t>(stats.memTextures);
+    report.contextVertexBufferBytes = static_cast<std::size_t>(stats.memVertexBuffers);
+    report.contextIndexBufferBytes = static_cast<std::size_t>(stats.memIndexBuffers);
+    report.contextUniformBufferBytes = static_cast<std::size_t>(stats.memUniformBuffers);
+    return report;
+}
+
 void Renderer::reduceMemoryUse() {
     gfx::BackendScope guard{impl->backend};
     impl->reduceMemoryUse();
     impl->orchestrator.reduceMemoryUse();
 }
 
+MemoryPressureReport Renderer::onMemoryPressure(MemoryPressureLevel level) {
+    MLN_TRACE_FUNC();
+
+    gfx::BackendScope guard{impl->backend};
+    MemoryPressureReport report{.level = level};
+    impl->orchestrator.reduceMemoryUse(level, report);
+
+    if (level == MemoryPressureLevel::Critical) {
+        const auto contextBytes = [&] {
+            const auto stats = impl->backend.getContext().threadSafeCopyRenderingStats();
+            return static_cast<std::size_t>(stats.memTextures) + static_cast<std::size_t>(stats.memVertexBuffers) +
+                   static_cast<std::size_t>(stats.memIndexBuffers) + static_cast<std::size_t>(stats.memUniformBuffers);
+        };
+        const auto before = contextBytes();
+        impl->reduceMemoryUse();
+        const auto after = contextBytes();
+        report.steps.push_back({.name = "render targets", .freedBytes = before > after ? before - after : 0});
+    }
+    return report;
+}
+
 void Renderer::clearData() {
     impl->orchestrator.clearData();
 }
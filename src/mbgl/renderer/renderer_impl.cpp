@@ -8,9 +8,11 @@
 #include <mbgl/gfx/renderer_backend.hpp>
 #include <mbgl/gfx/renderable.hpp>
 #include <mbgl/gfx/upload_pass.hpp>
+#include <mbgl/platform/settings.hpp>
 #include <mbgl/renderer/paint_parameters.hpp>
 #include <mbgl/renderer/pattern_atlas.hpp>
 #include <mbgl/renderer/renderer_observer.hpp>
+#include <mbgl/renderer/renderer_resource_group.hpp>
 #include <mbgl/renderer/render_static_data.hpp>
 #include <mbgl/renderer/render_tree.hpp>
 #include <mbgl/renderer/update_parameters.hpp>
@@ -44,6 +46,12 @@ using namespace style;
 
 namespace {
 
+bool isScissorTileClippingEnabled() {
+    const auto value = platform::Settings::getInstance().get(platform::EXPERIMENTAL_SCISSOR_TILE_CLIPPING);
+    const auto* enabled = value.getBool();
+    return enabled && *enabled;
+}
+
 RendererObserver& nullObserver() {
     static RendererObserver observer;
     return observer;
@@ -57,7 +65,8 @@ Renderer::Impl::Impl(gfx::RendererBackend& backend_,
     : orchestrator(!backend_.contextIsShared(), backend_.getThreadPool(), localFontFamily_),
       backend(backend_),
       observer(&nullObserver()),
-      pixelRatio(pixelRatio_) {}
+      pixelRatio(pixelRatio_),
+      scissorTileClipping(isScissorTileClippingEnabled()) {}
 
 Renderer::Impl::~Impl() {
     assert(gfx::BackendScope::exists());
@@ -166,17 +175,26 @@ void Renderer::Impl::render(const RenderTree& renderTree, const std::shared_ptr<
 
     // Blocks execution until the renderable is available.
     backend.getDefaultRenderable().wait();
+    context.setGPUSectionTimingEnabled(gpuSectionTiming);
     context.beginFrame();
 
     if (!staticData) {
-        staticData = std::make_unique<RenderStaticData>(std::make_unique<gfx::ShaderRegistry>());
-
-        // Initialize shaders for drawables
-        const auto programParameters = ProgramParameters{pixelRatio, false};
-        backend.initShaders(*staticData->shaders, programParameters);
-
-        // Notify post-shader registration
-        observer->onRegisterShaders(*staticData->shaders);
+        const auto initializeShaders = [&](gfx::ShaderRegistry& shaders) {
+            // Initialize shaders for drawables
+            const auto programParameters = ProgramParameters{pixelRatio, false};
+            backend.initShaders(shaders, programParameters);
+
+            // Notify post-shader registration
+            observer->onRegisterShaders(shaders);
+        };
+
+        if (resourceGroup) {
+            // Only the first renderer of the group compiles them and gets to register its own
+            staticData = std::make_unique<RenderStaticData>(resourceGroup->getShaders(pixelRatio, initializeShaders));
+        } else {
+            staticData = std::make_unique<RenderStaticData>(std::make_shared<gfx::ShaderRegistry>());
+            initializeShaders(*staticData->shaders);
+        }
     }
 
     const auto& renderTreeParameters = renderTree.getParameters();
@@ -225,10 +243,13 @@ void Renderer::Impl::render(const RenderTree& renderTree, const std::shared_ptr<
 
     parameters.symbolFadeChange = renderTreeParameters.symbolFadeChange;
     parameters.opaquePassCutoff = renderTreeParameters.opaquePassCutOff;
+    parameters.allowTileScissorClipping = scissorTileClipping;
     const auto& sourceRenderItems = renderTree.getSourceRenderItems();
 
     const auto& layerRenderItems = renderTree.getLayerRenderItemMap();
 
+    const auto uploadStartTime = util::MonotonicTimer::now().count();
+
     // - UPLOAD PASS -------------------------------------------------------------------------------
     // Uploads all required buffers and images before we do any actual rendering.
     {
@@ -250,6 +271,8 @@ void Renderer::Impl::render(const RenderTree& renderTree, const std::shared_ptr<
         renderTree.getPatternAtlas().upload(*uploadPass);
     }
 
+    const auto layerUpdateStartTime = util::MonotonicTimer::now().count();
+
     // - LAYER GROUP UPDATE ------------------------------------------------------------------------
     // Updates all layer groups and process changes
     if (staticData && staticData->shaders) {
@@ -259,6 +282,9 @@ void Renderer::Impl::render(const RenderTree& renderTree, const std::shared_ptr<
 
     orchestrator.processChanges();
 
+    const auto layerUpdateEndTime = util::MonotonicTimer::now().count();
+    double tweakerTime = 0.0;
+
     // Upload layer groups
     {
         const auto uploadPass = parameters.encoder->createUploadPass("layerGroup-upload",
@@ -271,6 +297,7 @@ void Renderer::Impl::render(const RenderTree& renderTree, const std::shared_ptr<
         orchestrator.updateDebugLayerGroups(renderTree, parameters);
 
         // Tweakers are run in the upload pass so they can set up uniforms.
+        const auto tweakerStartTime = util::MonotonicTimer::now().count();
         parameters.currentLayer = 0;
         orchestrator.visitLayerGroups([&](LayerGroupBase& layerGroup) {
             layerGroup.runTweakers(renderTree, parameters);
@@ -281,6 +308,7 @@ void Renderer::Impl::render(const RenderTree& renderTree, const std::shared_ptr<
             layerGroup.runTweakers(renderTree, parameters);
             parameters.currentLayer++;
         });
+        tweakerTime = util::MonotonicTimer::now().count() - tweakerStartTime;
 
         // Give the layers a chance to upload
         orchestrator.visitLayerGroups([&](LayerGroupBase& layerGroup) { layerGroup.upload(*uploadPass); });
@@ -292,6 +320,8 @@ void Renderer::Impl::render(const RenderTree& renderTree, const std::shared_ptr<
         orchestrator.visitDebugLayerGroups([&](LayerGroupBase& layerGroup) { layerGroup.upload(*uploadPass); });
     }
 
+    const auto passesStartTime = util::MonotonicTimer::now().count();
+
     const Size atlasSize = parameters.patternAtlas.getPixelSize();
     const auto& worldSize = parameters.staticData.backendSize;
     const shaders::GlobalPaintParamsUBO globalPaintParamsUBO = {
@@ -335,19 +365,25 @@ void Renderer::Impl::render(const RenderTree& renderTree, const std::shared_ptr<
         assert(parameters.pass == RenderPass::Pass3D);
 
         // draw layer groups, 3D pass
+        context.beginGPUSection("3d pass");
         parameters.currentLayer = static_cast<uint32_t>(orchestrator.numLayerGroups()) - 1;
         orchestrator.visitLayerGroups([&](LayerGroupBase& layerGroup) {
+            context.beginGPUSection(layerGroup.getName());
             layerGroup.render(orchestrator, parameters);
+            context.endGPUSection();
             if (parameters.currentLayer > 0) {
                 parameters.currentLayer--;
             }
         });
+        context.endGPUSection();
     };
 
     const auto drawableTargetsPass = [&] {
         // draw render targets
+        context.beginGPUSection("render targets");
         orchestrator.visitRenderTargets(
             [&](RenderTarget& renderTarget) { renderTarget.render(orchestrator, renderTree, parameters); });
+        context.endGPUSection();
     };
 
     const auto commonClearPass = [&] {
@@ -380,11 +416,15 @@ void Renderer::Impl::render(const RenderTree& renderTree, const std::shared_ptr<
                                             PaintParameters::depthEpsilon;
 
         // draw layer groups, opaque pass
+        context.beginGPUSection("opaque pass");
         parameters.currentLayer = 0;
         orchestrator.visitLayerGroupsReversed([&](LayerGroupBase& layerGroup) {
+            context.beginGPUSection(layerGroup.getName());
             layerGroup.render(orchestrator, parameters);
+            context.endGPUSection();
             parameters.currentLayer++;
         });
+        context.endGPUSection();
     };
 
     const auto drawableTranslucentPass = [&] {
@@ -394,9 +434,12 @@ void Renderer::Impl::render(const RenderTree& renderTree, const std::shared_ptr<
                                             PaintParameters::depthEpsilon;
 
         // draw layer groups, translucent pass
+        context.beginGPUSection("translucent pass");
         parameters.currentLayer = static_cast<uint32_t>(orchestrator.numLayerGroups()) - 1;
         orchestrator.visitLayerGroups([&](LayerGroupBase& layerGroup) {
+            context.beginGPUSection(layerGroup.getName());
             layerGroup.render(orchestrator, parameters);
+            context.endGPUSection();
             if (parameters.currentLayer > 0) {
                 parameters.currentLayer--;
             }
@@ -411,20 +454,25 @@ void Renderer::Impl::render(const RenderTree& renderTree, const std::shared_ptr<
             parameters.currentLayer = i;
             const RenderItem& item = *it;
             if (item.hasRenderPass(parameters.pass)) {
+                context.beginGPUSection(item.getName());
                 item.render(parameters);
+                context.endGPUSection();
             }
         }
+        context.endGPUSection();
     };
 
     const auto drawableDebugOverlays = [&] {
         // Renders debug overlays.
         {
             const auto debugGroup(parameters.renderPass->createDebugGroup("debug"));
+            context.beginGPUSection("debug");
             parameters.currentLayer = 0;
             orchestrator.visitDebugLayerGroups([&](LayerGroupBase& layerGroup) {
                 layerGroup.render(orchestrator, parameters);
                 parameters.currentLayer++;
             });
+            context.endGPUSection();
         }
     };
 
@@ -446,6 +494,13 @@ void Renderer::Impl::render(const RenderTree& renderTree, const std::shared_ptr<
     // Ends the RenderPass
     parameters.renderPass.reset();
 
+    auto& phaseStats = context.renderingStats();
+    phaseStats.renderTreeTime = renderTreeParameters.renderTreeTime;
+    phaseStats.layerUpdateTime = layerUpdateEndTime - layerUpdateStartTime;
+    phaseStats.tweakerTime = tweakerTime;
+    phaseStats.uploadTime = passesStartTime - uploadStartTime - phaseStats.layerUpdateTime - tweakerTime;
+    phaseStats.passEncodingTime = util::MonotonicTimer::now().count() - passesStartTime;
+
     const auto startRendering = util::MonotonicTimer::now().count();
     // present submits render commands
     parameters.encoder->present(parameters.backend.getDefaultRenderable());
@@ -468,14 +523,30 @@ void Renderer::Impl::render(const RenderTree& renderTree, const std::shared_ptr<
 #endif // MLN_RENDER_BACKEND_METAL
 
     context.renderingStats().encodingTime = renderTree.getElapsedTime() - context.renderingStats().renderingTime;
+    context.renderingStats().styleUpdateTime = renderTreeParameters.styleUpdateTime;
+    context.renderingStats().sourceUpdateTime = renderTreeParameters.sourceUpdateTime;
+    context.renderingStats().prepareTime = renderTreeParameters.prepareTime;
+    context.renderingStats().placementTime = renderTreeParameters.placementTime;
+    if (renderTreeParameters.cameraOnlyUpdate) {
+        context.renderingStats().numCameraOnlyUpdates++;
+    }
+    context.renderingStats().numOccludedDrawables = static_cast<int>(orchestrator.numOccludedDrawables());
+    context.renderingStats().numCulledSymbols = static_cast<int>(orchestrator.numCulledSymbols());
+    context.renderingStats().numVariableAnchorTests = static_cast<int>(orchestrator.numVariableAnchorTests());
+    context.renderingStats().numPreviousAnchorPlacements = static_cast<int>(
+        orchestrator.numPreviousAnchorPlacements());
+
+    // Layers waiting for their shaders or textures were left out of this frame
+    const bool resourcesPending = context.hasPendingShaders() || context.hasPendingTextureUploads();
+    const bool loaded = renderTreeParameters.loaded && !resourcesPending;
 
     observer->onDidFinishRenderingFrame(
-        renderTreeParameters.loaded ? RendererObserver::RenderMode::Full : RendererObserver::RenderMode::Partial,
-        renderTreeParameters.needsRepaint,
+        loaded ? RendererObserver::RenderMode::Full : RendererObserver::RenderMode::Partial,
+        renderTreeParameters.needsRepaint || resourcesPending,
         renderTreeParameters.placementChanged,
         context.threadSafeCopyRenderingStats());
 
-    if (!renderTreeParameters.loaded) {
+    if (!loaded) {
         renderState = RenderState::Partial;
     } else if (renderState != RenderState::Fully) {
         renderState = RenderState::Fully;
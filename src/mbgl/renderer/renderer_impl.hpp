@@ -14,6 +14,7 @@
 namespace mbgl {
 
 class RendererObserver;
+class RendererResourceGroup;
 class RenderStaticData;
 class RenderTree;
 
@@ -52,8 +53,11 @@ private:
     RendererObserver* observer;
 
     const float pixelRatio;
+    const bool scissorTileClipping;
     std::unique_ptr<RenderStaticData> staticData;
+    std::shared_ptr<RendererResourceGroup> resourceGroup;
     gfx::DynamicTextureAtlasPtr dynamicTextureAtlas;
+    bool gpuSectionTiming = false;
     bool styleLoaded = false;
 
     enum class RenderState {
@@ -0,0 +1,22 @@
+#include <mbgl/renderer/renderer_resource_group.hpp>
+#include <mbgl/gfx/shader_registry.hpp>
+
+namespace mbgl {
+
+RendererResourceGroup::RendererResourceGroup() = default;
+
+RendererResourceGroup::~RendererResourceGroup() = default;
+
+std::shared_ptr<gfx::ShaderRegistry> RendererResourceGroup::getShaders(
+    float pixelRatio, const std::function<void(gfx::ShaderRegistry&)>& initialize) {
+    // Held while compiling, so that a renderer starting at the same time waits instead of compiling them again
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& registry = shaders[pixelRatio];
+    if (!registry) {
+        registry = std::make_shared<gfx::ShaderRegistry>();
+        initialize(*registry);
+    }
+    return registry;
+}
+
+} // namespace mbgl
@@ -17,6 +17,12 @@ void SourceFeatureState::updateState(const std::optional<std::string>& sourceLay
     }
 }
 
+void SourceFeatureState::updateStates(const std::optional<std::string>& sourceLayerID, const FeatureStates& newStates) {
+    for (const auto& [featureID, newState] : newStates) {
+        updateState(sourceLayerID, featureID, newState);
+    }
+}
+
 void SourceFeatureState::getState(FeatureState& result,
                                   const std::optional<std::string>& sourceLayerID,
                                   const std::string& featureID) const {
@@ -97,14 +103,15 @@ void SourceFeatureState::coalesceChanges(std::vector<RenderTile>& tiles) {
     stateChanges.clear();
     deletedStates.clear();
 
-    changes.insert(currentStates.begin(), currentStates.end());
-
-    if (changes.empty()) {
-        return;
-    }
-
+    // Tiles that already have the current states only need the features that changed since
     for (auto& tile : tiles) {
-        tile.setFeatureState(changes);
+        if (tile.needsAllFeatureStates()) {
+            if (!currentStates.empty()) {
+                tile.setFeatureState(currentStates);
+            }
+        } else if (!changes.empty()) {
+            tile.setFeatureState(changes);
+        }
     }
 }
 
@@ -15,6 +15,7 @@ public:
     void updateState(const std::optional<std::string>& sourceLayerID,
                      const std::string& featureID,
                      const FeatureState& newState);
+    void updateStates(const std::optional<std::string>& sourceLayerID, const FeatureStates& newStates);
     void getState(FeatureState& result,
                   const std::optional<std::string>& sourceLayerID,
                   const std::string& featureID) const;
@@ -0,0 +1,153 @@
+#include <mbgl/renderer/sources/image_pyramid.hpp>
+
+#include <mbgl/actor/scheduler.hpp>
+#include <mbgl/util/instrumentation.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+
+namespace mbgl {
+
+ImagePyramid::ImagePyramid(std::shared_ptr<const PremultipliedImage> image_,
+                           uint32_t tileSize_,
+                           std::function<void()> onTileReady_)
+    : image(std::move(image_)),
+      tileSize(tileSize_),
+      onTileReady(std::move(onTileReady_)) {
+    assert(image && image->valid() && tileSize > 0);
+    while (levels < 32 && std::max(levelSize(levels - 1).width, levelSize(levels - 1).height) > tileSize) {
+        ++levels;
+    }
+}
+
+Size ImagePyramid::levelSize(uint8_t level) const {
+    // Rounded up, the last pixel of an odd level is averaged from a single row or column
+    return {((image->size.width - 1) >> level) + 1, ((image->size.height - 1) >> level) + 1};
+}
+
+uint8_t ImagePyramid::levelFor(double screenPixels) const {
+    const auto imagePixels = static_cast<double>(std::max(image->size.width, image->size.height));
+    if (!(screenPixels > 0.0)) {
+        return levels - 1;
+    }
+    const double level = std::floor(std::log2(imagePixels / screenPixels));
+    return static_cast<uint8_t>(std::clamp(level, 0.0, static_cast<double>(levels - 1)));
+}
+
+std::vector<ImagePyramid::TileID> ImagePyramid::tiles(uint8_t level) const {
+    const Size size = levelSize(level);
+    const uint32_t columns = (size.width + tileSize - 1) / tileSize;
+    const uint32_t rows = (size.height + tileSize - 1) / tileSize;
+
+    std::vector<TileID> result;
+    result.reserve(static_cast<std::size_t>(columns) * rows);
+    for (uint32_t y = 0; y < rows; ++y) {
+        for (uint32_t x = 0; x < columns; ++x) {
+            result.push_back({level, x, y});
+        }
+    }
+    return result;
+}
+
+mapbox::geometry::box<double> ImagePyramid::bounds(const TileID& id) const {
+    const Size size = levelSize(id.level);
+    // In pixels of the image rather than of the level, so that the tiles of all levels line up
+    const auto edge = [&](uint32_t index, uint32_t levelLength, uint32_t imageLength) {
+        const uint64_t pixel = std::min<uint64_t>(static_cast<uint64_t>(index) * tileSize, levelLength);
+        return static_cast<double>(std::min<uint64_t>(pixel << id.level, imageLength)) / imageLength;
+    };
+    return {{edge(id.x, size.width, image->size.width), edge(id.y, size.height, image->size.height)},
+            {edge(id.x + 1, size.width, image->size.width), edge(id.y + 1, size.height, image->size.height)}};
+}
+
+std::shared_ptr<PremultipliedImage> ImagePyramid::get(const TileID& id) {
+    if (auto tile = peek(id)) {
+        return tile;
+    }
+    if (pendingTiles.insert(id).second) {
+        Scheduler::GetBackground()->scheduleAndReplyValue(
+            util::SimpleIdentity::Empty,
+            [image_ = image, tileSize_ = tileSize, id] { return prepare(*image_, tileSize_, id); },
+            [weak = weak_from_this(), id](std::shared_ptr<PremultipliedImage> tile) {
+                if (auto self = weak.lock()) {
+                    self->ready(id, std::move(tile));
+                }
+            });
+    }
+    return nullptr;
+}
+
+std::shared_ptr<PremultipliedImage> ImagePyramid::peek(const TileID& id) const {
+    const auto it = readyTiles.find(id);
+    return it != readyTiles.end() ? it->second : nullptr;
+}
+
+void ImagePyramid::retain(const std::set<TileID>& ids) {
+    const auto dropped = [&](const TileID& id) {
+        return id.level != levels - 1 && !ids.contains(id);
+    };
+    std::erase_if(readyTiles, [&](const auto& entry) { return dropped(entry.first); });
+    std::erase_if(pendingTiles, dropped);
+}
+
+void ImagePyramid::ready(const TileID& id, std::shared_ptr<PremultipliedImage> tile) {
+    // Tiles dropped while they were prepared are thrown away
+    if (pendingTiles.erase(id) == 0) {
+        return;
+    }
+    readyTiles.emplace(id, std::move(tile));
+    if (onTileReady) {
+        onTileReady();
+    }
+}
+
+std::shared_ptr<PremultipliedImage> ImagePyramid::prepare(const PremultipliedImage& source,
+                                                          uint32_t tileSize_,
+                                                          const TileID& id) {
+    MLN_TRACE_FUNC();
+
+    const uint32_t levelWidth = ((source.size.width - 1) >> id.level) + 1;
+    const uint32_t levelHeight = ((source.size.height - 1) >> id.level) + 1;
+    const uint32_t left = id.x * tileSize_;
+    const uint32_t top = id.y * tileSize_;
+    auto tile = std::make_shared<PremultipliedImage>(
+        Size{std::min(tileSize_, levelWidth - left), std::min(tileSize_, levelHeight - top)});
+
+    if (id.level == 0) {
+        PremultipliedImage::copy(source, *tile, {left, top}, {0, 0}, tile->size);
+        return tile;
+    }
+
+    // A box filter over the pixels of the image each one covers, their colors being premultiplied
+    const uint32_t scale = 1u << id.level;
+    for (uint32_t y = 0; y < tile->size.height; ++y) {
+        const uint32_t sourceTop = (top + y) * scale;
+        const uint32_t sourceBottom = std::min(sourceTop + scale, source.size.height);
+        for (uint32_t x = 0; x < tile->size.width; ++x) {
+            const uint32_t sourceLeft = (left + x) * scale;
+            const uint32_t sourceRight = std::min(sourceLeft + scale, source.size.width);
+
+            std::array<uint64_t, 4> sum{};
+            for (uint32_t sy = sourceTop; sy < sourceBottom; ++sy) {
+                const uint8_t* pixel = source.data.get() + (static_cast<std::size_t>(sy) * source.stride() +
+                                                            static_cast<std::size_t>(sourceLeft) * 4);
+                for (uint32_t sx = sourceLeft; sx < sourceRight; ++sx, pixel += 4) {
+                    for (std::size_t c = 0; c < 4; ++c) {
+                        sum[c] += pixel[c];
+                    }
+                }
+            }
+
+            const uint64_t count = static_cast<uint64_t>(sourceBottom - sourceTop) * (sourceRight - sourceLeft);
+            uint8_t* out = tile->data.get() + (static_cast<std::size_t>(y) * tile->stride() + x * 4);
+            for (std::size_t c = 0; c < 4; ++c) {
+                out[c] = static_cast<uint8_t>((sum[c] + count / 2) / count);
+            }
+        }
+    }
+    return tile;
+}
+
+} // namespace mbgl
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <mbgl/util/geometry.hpp>
+#include <mbgl/util/image.hpp>
+
+#include <mapbox/geometry/box.hpp>
+
+#include <compare>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <set>
+#include <vector>
+
+namespace mbgl {
+
+/**
+ * @brief The tiles of a large image and of its halved levels, for `RenderImageSource` to upload only the ones in
+ * view, see EXPERIMENTAL_IMAGE_SOURCE_TILE_SIZE.
+ *
+ * Level 0 is the image itself, and the last level fits in a single tile. Tiles are cut out of the image, and
+ * downsampled for the levels above 0, on the background scheduler the first time they're asked for. Used from a
+ * single thread, which must have a scheduler: the tiles are handed back to it.
+ */
+class ImagePyramid : public std::enable_shared_from_this<ImagePyramid> {
+public:
+    struct TileID {
+        uint8_t level;
+        uint32_t x;
+        uint32_t y;
+
+        auto operator<=>(const TileID&) const = default;
+    };
+
+    /// `onTileReady` is called once a tile asked for is ready
+    ImagePyramid(std::shared_ptr<const PremultipliedImage>, uint32_t tileSize, std::function<void()> onTileReady);
+
+    const std::shared_ptr<const PremultipliedImage>& getImage() const { return image; }
+    uint8_t levelCount() const { return levels; }
+
+    /// The coarsest level with at least one pixel for each screen pixel, the long side of the image covering the
+    /// given number of them
+    uint8_t levelFor(double screenPixels) const;
+    std::vector<TileID> tiles(uint8_t level) const;
+    /// The part of the image a tile covers, in coordinates from 0 to 1
+    mapbox::geometry::box<double> bounds(const TileID&) const;
+
+    /// The image of a tile, or null until it's ready. Its preparation starts the first time it's asked for.
+    std::shared_ptr<PremultipliedImage> get(const TileID&);
+    /// The image of a tile, without starting its preparation
+    std::shared_ptr<PremultipliedImage> peek(const TileID&) const;
+    /// Drops the tiles not listed, ready or not, but the one of the last level
+    void retain(const std::set<TileID>&);
+
+private:
+    Size levelSize(uint8_t level) const;
+    void ready(const TileID&, std::shared_ptr<PremultipliedImage>);
+
+    static std::shared_ptr<PremultipliedImage> prepare(const PremultipliedImage&, uint32_t tileSize_, const TileID&);
+
+    const std::shared_ptr<const PremultipliedImage> image;
+    const uint32_t tileSize;
+    const std::function<void()> onTileReady;
+    uint8_t levels = 1;
+
+    std::map<TileID, std::shared_ptr<PremultipliedImage>> readyTiles;
+    std::set<TileID> pendingTiles;
+};
+
+} // namespace mbgl
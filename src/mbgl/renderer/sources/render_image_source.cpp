@@ -1,5 +1,6 @@
 #include <mbgl/map/transform_state.hpp>
 #include <mbgl/math/log2.hpp>
+#include <mbgl/platform/settings.hpp>
 #include <mbgl/renderer/buckets/raster_bucket.hpp>
 #include <mbgl/renderer/paint_parameters.hpp>
 #include <mbgl/renderer/render_tile.hpp>
@@ -13,20 +14,72 @@
 #include <mbgl/util/tile_coordinate.hpp>
 #include <mbgl/util/tile_cover.hpp>
 
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <ranges>
+#include <set>
+
 namespace mbgl {
 
 using namespace style;
 
+namespace {
+
+uint32_t settingsTileSize() {
+    const auto value = platform::Settings::getInstance().get(platform::EXPERIMENTAL_IMAGE_SOURCE_TILE_SIZE);
+    if (const auto* size = value.getUint()) {
+        return static_cast<uint32_t>(std::min<uint64_t>(*size, std::numeric_limits<uint32_t>::max()));
+    } else if (const auto* signedSize = value.getInt(); signedSize && *signedSize > 0) {
+        return static_cast<uint32_t>(std::min<int64_t>(*signedSize, std::numeric_limits<uint32_t>::max()));
+    }
+    return 0;
+}
+
+/// The point of the image at the given coordinates from 0 to 1, interpolated between its corners
+TileCoordinatePoint pointAt(const std::array<TileCoordinatePoint, 4>& corners, double u, double v) {
+    const auto lerp = [&](auto member) {
+        return (1 - v) * ((1 - u) * corners[0].*member + u * corners[1].*member) +
+               v * ((1 - u) * corners[3].*member + u * corners[2].*member);
+    };
+    return {lerp(&TileCoordinatePoint::x), lerp(&TileCoordinatePoint::y)};
+}
+
+/// Adds the two triangles of an image with the given corners, clockwise from the top left one
+void addQuad(RasterBucket& bucket, const UnwrappedTileID& tileID, const std::array<TileCoordinatePoint, 4>& corners) {
+    std::array<GeometryCoordinate, 4> geomCoords;
+    std::ranges::transform(corners, geomCoords.begin(), [&](const TileCoordinatePoint& point) {
+        return TileCoordinate::toGeometryCoordinate(tileID, point);
+    });
+
+    bucket.vertices.emplace_back(RasterBucket::layoutVertex({geomCoords[0].x, geomCoords[0].y}, {0, 0}));
+    bucket.vertices.emplace_back(RasterBucket::layoutVertex({geomCoords[1].x, geomCoords[1].y}, {util::EXTENT, 0}));
+    bucket.vertices.emplace_back(RasterBucket::layoutVertex({geomCoords[3].x, geomCoords[3].y}, {0, util::EXTENT}));
+    bucket.vertices.emplace_back(
+        RasterBucket::layoutVertex({geomCoords[2].x, geomCoords[2].y}, {util::EXTENT, util::EXTENT}));
+
+    bucket.indices.emplace_back(0, 1, 2);
+    bucket.indices.emplace_back(1, 2, 3);
+
+    bucket.segments.emplace_back(0, 0, 4, 6);
+}
+
+} // namespace
+
 ImageSourceRenderData::~ImageSourceRenderData() = default;
 
 void ImageSourceRenderData::upload(gfx::UploadPass& uploadPass) const {
-    if (bucket && bucket->needsUpload()) {
-        bucket->upload(uploadPass);
+    for (const auto& bucket : buckets) {
+        if (bucket && bucket->needsUpload()) {
+            bucket->upload(uploadPass);
+        }
     }
 }
 
 RenderImageSource::RenderImageSource(Immutable<style::ImageSource::Impl> impl_)
-    : RenderSource(std::move(impl_)) {}
+    : RenderSource(std::move(impl_)),
+      pyramidTileSize(settingsTileSize()) {}
 
 RenderImageSource::~RenderImageSource() = default;
 
@@ -35,7 +88,7 @@ const style::ImageSource::Impl& RenderImageSource::impl() const {
 }
 
 bool RenderImageSource::isLoaded() const {
-    return !!bucket;
+    return bucket || !tileBuckets.empty();
 }
 
 std::unique_ptr<RenderItem> RenderImageSource::createRenderItem() {
@@ -46,8 +99,15 @@ std::unique_ptr<RenderItem> RenderImageSource::createRenderItem() {
 void RenderImageSource::prepare(const SourcePrepareParameters& parameters) {
     MLN_TRACE_FUNC();
     assert(!renderData);
+    std::vector<std::shared_ptr<RasterBucket>> buckets;
+    if (bucket) {
+        buckets.push_back(bucket);
+    }
+    for (const auto& entry : tileBuckets) {
+        buckets.push_back(entry.second);
+    }
     if (!isLoaded()) {
-        renderData = std::make_unique<ImageSourceRenderData>(bucket, std::vector<mat4>{}, baseImpl->id);
+        renderData = std::make_unique<ImageSourceRenderData>(std::move(buckets), std::vector<mat4>{}, baseImpl->id);
         return;
     }
 
@@ -58,7 +118,7 @@ void RenderImageSource::prepare(const SourcePrepareParameters& parameters) {
         matrix::identity(matrix);
         transformParams.state.matrixFor(matrix, tileIds[i]);
     }
-    renderData = std::make_unique<ImageSourceRenderData>(bucket, std::move(matrices), baseImpl->id);
+    renderData = std::make_unique<ImageSourceRenderData>(std::move(buckets), std::move(matrices), baseImpl->id);
 }
 
 std::unordered_map<std::string, std::vector<Feature>> RenderImageSource::queryRenderedFeatures(
@@ -98,10 +158,10 @@ void RenderImageSource::update(Immutable<style::Source::Impl> baseImpl_,
     // Compute the z0 tile coordinates for the given LatLngs
     TileCoordinatePoint nePoint = {-INFINITY, -INFINITY};
     TileCoordinatePoint swPoint = {INFINITY, INFINITY};
-    std::vector<TileCoordinatePoint> tileCoordinates;
-    for (LatLng latLng : coords) {
-        auto point = TileCoordinate::fromLatLng(0, latLng).p;
-        tileCoordinates.push_back(point);
+    std::array<TileCoordinatePoint, 4> tileCoordinates;
+    for (size_t i = 0; i < coords.size(); ++i) {
+        auto point = TileCoordinate::fromLatLng(0, coords[i]).p;
+        tileCoordinates[i] = point;
         swPoint.x = std::min(swPoint.x, point.x);
         nePoint.x = std::max(nePoint.x, point.x);
         swPoint.y = std::min(swPoint.y, point.y);
@@ -119,7 +179,8 @@ void RenderImageSource::update(Immutable<style::Source::Impl> baseImpl_,
     // A tile coordinate unit represents the length of one tile (tileSize) at a given zoom.
     // To convert a tile coordinate to pixels, multiply by tileSize.
     // Here dMax is in z0 tile units, so we also scale by 2^z to match current zoom.
-    enabled = dMax * std::pow(2.0, transformState.getZoom()) * util::tileSize_D > 2.0;
+    const double zoomedSize = dMax * std::pow(2.0, transformState.getZoom()) * util::tileSize_D;
+    enabled = zoomedSize > 2.0;
     if (!enabled) {
         return;
     }
@@ -138,7 +199,8 @@ void RenderImageSource::update(Immutable<style::Source::Impl> baseImpl_,
                                        .tileLodMinRadius = parameters.tileLodMinRadius,
                                        .tileLodScale = parameters.tileLodScale,
                                        .tileLodPitchThreshold = parameters.tileLodPitchThreshold,
-                                       .tileLodMode = parameters.tileLodMode},
+                                       .tileLodMode = parameters.tileLodMode,
+                                       .tileLodMaxTiles = parameters.tileLodMaxTiles},
                                       static_cast<uint8_t>(transformState.getZoom()),
                                       zoomRange);
     for (auto tile : idealTiles) {
@@ -160,12 +222,14 @@ void RenderImageSource::update(Immutable<style::Source::Impl> baseImpl_,
         return;
     }
 
-    // Calculate Geometry Coordinates based on tile cover at ideal zoom
-    GeometryCoordinates geomCoords;
-    for (auto tileCoords : tileCoordinates) {
-        auto gc = TileCoordinate::toGeometryCoordinate(tileIds[0], tileCoords);
-        geomCoords.push_back(gc);
+    if (pyramidTileSize > 0 && std::max(image->size.width, image->size.height) > pyramidTileSize) {
+        bucket.reset();
+        updateTiles(image, tileCoordinates, zoomedSize, parameters);
+        return;
     }
+    pyramid.reset();
+    tileBuckets.clear();
+
     if (!bucket) {
         bucket = std::make_shared<RasterBucket>(image);
     } else {
@@ -175,17 +239,97 @@ void RenderImageSource::update(Immutable<style::Source::Impl> baseImpl_,
         }
     }
 
-    // Set Bucket Vertices, Indices, and segments
-    bucket->vertices.emplace_back(RasterBucket::layoutVertex({geomCoords[0].x, geomCoords[0].y}, {0, 0}));
-    bucket->vertices.emplace_back(RasterBucket::layoutVertex({geomCoords[1].x, geomCoords[1].y}, {util::EXTENT, 0}));
-    bucket->vertices.emplace_back(RasterBucket::layoutVertex({geomCoords[3].x, geomCoords[3].y}, {0, util::EXTENT}));
-    bucket->vertices.emplace_back(
-        RasterBucket::layoutVertex({geomCoords[2].x, geomCoords[2].y}, {util::EXTENT, util::EXTENT}));
+    // Set Bucket Vertices, Indices, and segments, in the frame of the tile cover at ideal zoom
+    addQuad(*bucket, tileIds[0], tileCoordinates);
+}
+
+void RenderImageSource::updateTiles(const std::shared_ptr<PremultipliedImage>& image,
+                                    const std::array<TileCoordinatePoint, 4>& corners,
+                                    const double zoomedSize,
+                                    const TileParameters& parameters) {
+    if (!pyramid || pyramid->getImage() != image) {
+        tileBuckets.clear();
+        // The pyramid only calls back while it's alive, so while this source is
+        pyramid = std::make_shared<ImagePyramid>(image, pyramidTileSize, [this] {
+            observer->onTileChanged(*this, OverscaledTileID{0, 0, 0});
+        });
+    }
+
+    // The tiles of the map in view, at its own zoom rather than the one the image is placed at
+    const auto& transformState = parameters.transformState;
+    const auto zoom = static_cast<uint8_t>(std::max(0.0, transformState.getZoom()));
+    const auto visibleTiles = util::tileCover({.transformState = transformState,
+                                               .tileLodMinRadius = parameters.tileLodMinRadius,
+                                               .tileLodScale = parameters.tileLodScale,
+                                               .tileLodPitchThreshold = parameters.tileLodPitchThreshold,
+                                               .tileLodMode = parameters.tileLodMode,
+                                               .tileLodMaxTiles = parameters.tileLodMaxTiles},
+                                              zoom,
+                                              Range<uint8_t>(0, zoom));
 
-    bucket->indices.emplace_back(0, 1, 2);
-    bucket->indices.emplace_back(1, 2, 3);
+    const auto cornersOf = [&](const ImagePyramid::TileID& id) {
+        const auto box = pyramid->bounds(id);
+        return std::array<TileCoordinatePoint, 4>{pointAt(corners, box.min.x, box.min.y),
+                                                  pointAt(corners, box.max.x, box.min.y),
+                                                  pointAt(corners, box.max.x, box.max.y),
+                                                  pointAt(corners, box.min.x, box.max.y)};
+    };
+    const auto isVisible = [&](const ImagePyramid::TileID& id) {
+        // The tile lies within the bounding box of its corners
+        const auto tileCorners = cornersOf(id);
+        const auto [minX, maxX] = std::ranges::minmax(tileCorners | std::views::transform(&TileCoordinatePoint::x));
+        const auto [minY, maxY] = std::ranges::minmax(tileCorners | std::views::transform(&TileCoordinatePoint::y));
+        return std::ranges::any_of(visibleTiles, [&](const OverscaledTileID& tile) {
+            const double size = std::ldexp(1.0, -tile.canonical.z);
+            const double left = tile.canonical.x * size;
+            const double top = tile.canonical.y * size;
+            return minX < left + size && maxX > left && minY < top + size && maxY > top;
+        });
+    };
+    const auto visibleIn = [&](uint8_t level) {
+        std::vector<ImagePyramid::TileID> ids;
+        std::ranges::copy_if(pyramid->tiles(level), std::back_inserter(ids), isVisible);
+        return ids;
+    };
 
-    bucket->segments.emplace_back(0, 0, 4, 6);
+    // The level with at least a pixel for each screen pixel, its tiles in view prepared if they aren't yet. The
+    // last level, a single tile, is always kept to fall back on.
+    const uint8_t lastLevel = pyramid->levelCount() - 1;
+    const uint8_t targetLevel = pyramid->levelFor(zoomedSize * parameters.pixelRatio);
+    const auto targetTiles = visibleIn(targetLevel);
+    for (const auto& id : targetTiles) {
+        pyramid->get(id);
+    }
+    pyramid->get({lastLevel, 0, 0});
+
+    // Until they're all ready, the finest level above whose tiles in view are. Levels aren't mixed, as their
+    // tiles would overlap.
+    std::vector<ImagePyramid::TileID> drawnTiles;
+    for (uint8_t level = targetLevel; level <= lastLevel; ++level) {
+        auto ids = level == targetLevel ? targetTiles : visibleIn(level);
+        if (std::ranges::all_of(ids, [&](const auto& id) { return pyramid->peek(id) != nullptr; })) {
+            drawnTiles = std::move(ids);
+            break;
+        }
+    }
+
+    std::set<ImagePyramid::TileID> retained(targetTiles.begin(), targetTiles.end());
+    retained.insert(drawnTiles.begin(), drawnTiles.end());
+    pyramid->retain(retained);
+
+    std::map<ImagePyramid::TileID, std::shared_ptr<RasterBucket>> buckets;
+    for (const auto& id : drawnTiles) {
+        auto tileImage = pyramid->peek(id);
+        auto& tileBucket = buckets[id];
+        if (auto it = tileBuckets.find(id); it != tileBuckets.end() && it->second->image == tileImage) {
+            tileBucket = std::move(it->second);
+            tileBucket->clear();
+        } else {
+            tileBucket = std::make_shared<RasterBucket>(std::move(tileImage));
+        }
+        addQuad(*tileBucket, tileIds[0], cornersOf(id));
+    }
+    tileBuckets = std::move(buckets);
 }
 
 void RenderImageSource::dumpDebugLogs() const {
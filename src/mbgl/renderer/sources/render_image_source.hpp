@@ -3,7 +3,12 @@
 #include <mbgl/renderer/render_source.hpp>
 #include <mbgl/renderer/render_tile.hpp>
 #include <mbgl/renderer/render_tree.hpp>
+#include <mbgl/renderer/sources/image_pyramid.hpp>
 #include <mbgl/style/sources/image_source_impl.hpp>
+#include <mbgl/util/tile_coordinate.hpp>
+
+#include <array>
+#include <map>
 
 namespace mbgl {
 
@@ -11,12 +16,15 @@ class RasterBucket;
 
 class ImageSourceRenderData final : public RenderItem {
 public:
-    ImageSourceRenderData(std::shared_ptr<RasterBucket> bucket_, std::vector<mat4> matrices_, std::string name_)
-        : bucket(std::move(bucket_)),
+    ImageSourceRenderData(std::vector<std::shared_ptr<RasterBucket>> buckets_,
+                          std::vector<mat4> matrices_,
+                          std::string name_)
+        : buckets(std::move(buckets_)),
           matrices(std::move(matrices_)),
           name(std::move(name_)) {}
     ~ImageSourceRenderData() override;
-    const std::shared_ptr<RasterBucket> bucket;
+    /// The whole image, or the tiles of it in view when it's tiled
+    const std::vector<std::shared_ptr<RasterBucket>> buckets;
     const std::vector<mat4> matrices;
 
 private:
@@ -64,7 +72,17 @@ private:
     friend class RenderRasterLayer;
     const style::ImageSource::Impl& impl() const;
 
+    /// Picks the tiles of the image to draw, given its corners in z0 tile coordinates
+    void updateTiles(const std::shared_ptr<PremultipliedImage>&,
+                     const std::array<TileCoordinatePoint, 4>& corners,
+                     double zoomedSize,
+                     const TileParameters&);
+
     std::shared_ptr<RasterBucket> bucket;
+    /// Zero unless images larger than that are tiled, see EXPERIMENTAL_IMAGE_SOURCE_TILE_SIZE
+    const uint32_t pyramidTileSize;
+    std::shared_ptr<ImagePyramid> pyramid;
+    std::map<ImagePyramid::TileID, std::shared_ptr<RasterBucket>> tileBuckets;
     std::unique_ptr<ImageSourceRenderData> renderData;
     std::vector<UnwrappedTileID> tileIds;
 };
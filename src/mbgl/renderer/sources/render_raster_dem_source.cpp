@@ -38,7 +38,7 @@ void RenderRasterDEMSource::updateInternal(const Tileset& tileset,
                        [&](const OverscaledTileID& tileID, TileObserver* observer_) {
                            return std::make_unique<RasterDEMTile>(tileID, baseImpl->id, parameters, tileset, observer_);
                        });
-    algorithm::updateTileMasks(tilePyramid.getRenderedTiles());
+    algorithm::updateTileMasks(tilePyramid.getRenderedTiles(), tileMaskCache);
 }
 
 void RenderRasterDEMSource::onTileChanged(Tile& tile) {
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <mbgl/algorithm/update_tile_masks.hpp>
 #include <mbgl/renderer/sources/render_tile_source.hpp>
 #include <mbgl/style/sources/tile_source_impl.hpp>
 
@@ -29,6 +30,8 @@ private:
 
     const style::TileSource::Impl& impl() const;
 
+    algorithm::TileMaskCache tileMaskCache;
+
     void onTileChanged(Tile&) override;
 };
 
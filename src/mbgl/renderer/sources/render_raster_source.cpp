@@ -35,7 +35,7 @@ void RenderRasterSource::updateInternal(const Tileset& tileset,
                        [&](const OverscaledTileID& tileID, TileObserver* observer_) {
                            return std::make_unique<RasterTile>(tileID, baseImpl->id, parameters, tileset, observer_);
                        });
-    algorithm::updateTileMasks(tilePyramid.getRenderedTiles());
+    algorithm::updateTileMasks(tilePyramid.getRenderedTiles(), tileMaskCache);
 }
 
 void RenderRasterSource::prepare(const SourcePrepareParameters& parameters) {
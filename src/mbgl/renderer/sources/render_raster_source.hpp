@@ -1,5 +1,6 @@
 #pragma once
 
+#include <mbgl/algorithm/update_tile_masks.hpp>
 #include <mbgl/renderer/sources/render_tile_source.hpp>
 #include <mbgl/style/sources/tile_source_impl.hpp>
 
@@ -30,6 +31,8 @@ private:
     const std::optional<Tileset>& getTileset() const override;
 
     const style::TileSource::Impl& impl() const;
+
+    algorithm::TileMaskCache tileMaskCache;
 };
 
 } // namespace mbgl
@@ -486,6 +486,14 @@ bool RenderTileSource::hasFadingTiles() const {
     return tilePyramid.hasFadingTiles();
 }
 
+bool RenderTileSource::hasDeferredUploads() const {
+    return tilePyramid.hasDeferredUploads();
+}
+
+const TileLatencies* RenderTileSource::takeTileLatencyUpdate() {
+    return tilePyramid.takeLatencyUpdate();
+}
+
 RenderTiles RenderTileSource::getRenderTiles() const {
     if (!filteredRenderTiles) {
         auto result = std::make_shared<std::vector<std::reference_wrapper<const RenderTile>>>();
@@ -546,6 +554,10 @@ void RenderTileSource::setFeatureState(const std::optional<std::string>& sourceL
     featureState.updateState(sourceLayerID, featureID, state);
 }
 
+void RenderTileSource::setFeatureStates(const std::optional<std::string>& sourceLayerID, const FeatureStates& states) {
+    featureState.updateStates(sourceLayerID, states);
+}
+
 void RenderTileSource::getFeatureState(FeatureState& state,
                                        const std::optional<std::string>& sourceLayerID,
                                        const std::string& featureID) const {
@@ -566,10 +578,19 @@ void RenderTileSource::reduceMemoryUse() {
     tilePyramid.reduceMemoryUse();
 }
 
+void RenderTileSource::trimCache() {
+    tilePyramid.trimCache();
+}
+
 void RenderTileSource::dumpDebugLogs() const {
     tilePyramid.dumpDebugLogs();
 }
 
+void RenderTileSource::reportMemoryUsage(MemoryReport::Source& source,
+                                         std::map<std::string, MemoryUsage>& layers) const {
+    tilePyramid.reportMemoryUsage(source, layers);
+}
+
 // RenderTileSetSource implementation
 
 RenderTileSetSource::RenderTileSetSource(Immutable<style::Source::Impl> impl_, const TaggedScheduler& threadPool_)
@@ -23,6 +23,8 @@ public:
     void prepare(const SourcePrepareParameters&) override;
     void updateFadingTiles() override;
     bool hasFadingTiles() const override;
+    bool hasDeferredUploads() const override;
+    const TileLatencies* takeTileLatencyUpdate() override;
 
     RenderTiles getRenderTiles() const override;
     RenderTiles getRenderTilesSortedByYPosition() const override;
@@ -40,6 +42,8 @@ public:
 
     void setFeatureState(const std::optional<std::string>&, const std::string&, const FeatureState&) override;
 
+    void setFeatureStates(const std::optional<std::string>&, const FeatureStates&) override;
+
     void getFeatureState(FeatureState& state, const std::optional<std::string>&, const std::string&) const override;
 
     void removeFeatureState(const std::optional<std::string>&,
@@ -48,7 +52,9 @@ public:
 
     void setCacheEnabled(bool) override;
     void reduceMemoryUse() override;
+    void trimCache() override;
     void dumpDebugLogs() const override;
+    void reportMemoryUsage(MemoryReport::Source&, std::map<std::string, MemoryUsage>& layers) const override;
 
 protected:
     RenderTileSource(Immutable<style::Source::Impl>, const TaggedScheduler&);
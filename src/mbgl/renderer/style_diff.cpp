@@ -42,21 +42,47 @@ StyleDifference<T> diff(const Immutable<std::vector<T>>& a, const Immutable<std:
     return result;
 }
 
+template <class Impl, class Eq>
+StyleDifference<Immutable<Impl>> diff(const Immutable<std::vector<Immutable<Impl>>>& a,
+                                      const Immutable<std::vector<Immutable<Impl>>>& b,
+                                      const style::CollectionJournal<Impl>* journal,
+                                      const Eq& eq) {
+    if (!journal || journal->base != a || journal->target != b) {
+        return diff(a, b, eq);
+    }
+
+    StyleDifference<Immutable<Impl>> result;
+    for (const auto& [id, entry] : journal->entries) {
+        if (entry.before && entry.after && !entry.reinserted && eq(*entry.before, *entry.after)) {
+            if (entry.before->get() != entry.after->get()) {
+                result.changed.emplace(id, StyleChange<Immutable<Impl>>{*entry.before, *entry.after});
+            }
+        } else {
+            // Moved, replaced by another type, or added and removed
+            if (entry.before) result.removed.emplace(id, *entry.before);
+            if (entry.after) result.added.emplace(id, *entry.after);
+        }
+    }
+    return result;
+}
+
 ImageDifference diffImages(const Immutable<std::vector<ImmutableImage>>& a,
                            const Immutable<std::vector<ImmutableImage>>& b) {
     return diff(a, b, [](const ImmutableImage& lhs, const ImmutableImage& rhs) { return lhs->id == rhs->id; });
 }
 
 SourceDifference diffSources(const Immutable<std::vector<ImmutableSource>>& a,
-                             const Immutable<std::vector<ImmutableSource>>& b) {
-    return diff(a, b, [](const ImmutableSource& lhs, const ImmutableSource& rhs) {
+                             const Immutable<std::vector<ImmutableSource>>& b,
+                             const style::CollectionJournal<style::Source::Impl>* journal) {
+    return diff(a, b, journal, [](const ImmutableSource& lhs, const ImmutableSource& rhs) {
         return std::tie(lhs->id, lhs->type) == std::tie(rhs->id, rhs->type);
     });
 }
 
 LayerDifference diffLayers(const Immutable<std::vector<ImmutableLayer>>& a,
-                           const Immutable<std::vector<ImmutableLayer>>& b) {
-    return diff(a, b, [](const ImmutableLayer& lhs, const ImmutableLayer& rhs) {
+                           const Immutable<std::vector<ImmutableLayer>>& b,
+                           const style::CollectionJournal<style::Layer::Impl>* journal) {
+    return diff(a, b, journal, [](const ImmutableLayer& lhs, const ImmutableLayer& rhs) {
         return (lhs->id == rhs->id) && (lhs->getTypeInfo() == rhs->getTypeInfo());
     });
 }
@@ -3,6 +3,7 @@
 #include <mbgl/style/image_impl.hpp>
 #include <mbgl/style/source_impl.hpp>
 #include <mbgl/style/layer_impl.hpp>
+#include <mbgl/style/collection.hpp>
 #include <mbgl/util/immutable.hpp>
 #include <mbgl/util/variant.hpp>
 
@@ -31,17 +32,23 @@ using ImageDifference = StyleDifference<ImmutableImage>;
 ImageDifference diffImages(const Immutable<std::vector<ImmutableImage>>&,
                            const Immutable<std::vector<ImmutableImage>>&);
 
+// The source and layer diffs take the journal of the changes between the two versions, when available,
+// and only look at the changed elements. Without it, or if it's for other versions, they compare the
+// whole vectors.
+
 using ImmutableSource = Immutable<style::Source::Impl>;
 using SourceDifference = StyleDifference<ImmutableSource>;
 
 SourceDifference diffSources(const Immutable<std::vector<ImmutableSource>>&,
-                             const Immutable<std::vector<ImmutableSource>>&);
+                             const Immutable<std::vector<ImmutableSource>>&,
+                             const style::CollectionJournal<style::Source::Impl>* = nullptr);
 
 using ImmutableLayer = Immutable<style::Layer::Impl>;
 using LayerDifference = StyleDifference<ImmutableLayer>;
 
 LayerDifference diffLayers(const Immutable<std::vector<ImmutableLayer>>&,
-                           const Immutable<std::vector<ImmutableLayer>>&);
+                           const Immutable<std::vector<ImmutableLayer>>&,
+                           const style::CollectionJournal<style::Layer::Impl>* = nullptr);
 
 bool hasLayoutDifference(const LayerDifference&, const std::string& layerID);
 
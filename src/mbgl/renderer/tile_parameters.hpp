@@ -38,8 +38,13 @@ public:
     double tileLodPitchThreshold = (60.0 / 180.0) * std::numbers::pi;
     double tileLodZoomShift = 0;
     TileLodMode tileLodMode = TileLodMode::Default;
+    std::size_t tileLodMaxTiles = 0;
+    // Bytes of tile data uploaded for the first time per frame, zero for no limit
+    std::size_t tileUploadBudget = 0;
     gfx::DynamicTextureAtlasPtr dynamicTextureAtlas;
     bool isUpdateSynchronous = false;
+    // Set while the camera is moving towards a known destination, whose tiles are prefetched
+    const TransformState* transitionTargetState = nullptr;
 };
 
 } // namespace mbgl
@@ -3,13 +3,17 @@
 #include <mbgl/renderer/render_source.hpp>
 #include <mbgl/renderer/tile_parameters.hpp>
 #include <mbgl/renderer/query.hpp>
+#include <mbgl/geometry/feature_index.hpp>
 #include <mbgl/map/transform.hpp>
 #include <mbgl/math/clamp.hpp>
+#include <mbgl/platform/settings.hpp>
 #include <mbgl/actor/scheduler.hpp>
+#include <mbgl/util/tile_coordinate.hpp>
 #include <mbgl/util/tile_cover.hpp>
 #include <mbgl/util/tile_range.hpp>
 #include <mbgl/util/enum.hpp>
 #include <mbgl/util/logging.hpp>
+#include <mbgl/util/parallel_for.hpp>
 
 #include <mbgl/algorithm/update_renderables.hpp>
 
@@ -17,6 +21,7 @@
 
 #include <cmath>
 #include <algorithm>
+#include <unordered_set>
 
 namespace mbgl {
 
@@ -25,15 +30,64 @@ using namespace style;
 namespace {
 TileObserver nullObserver;
 const std::map<OverscaledTileID, std::unique_ptr<Tile>> emptyPrefetchedTiles;
+
+size_t getTileCacheMaxBytes() {
+    const auto value = platform::Settings::getInstance().get(platform::TILE_CACHE_MAX_BYTES);
+    if (const auto* maxBytes = value.getUint()) {
+        return static_cast<size_t>(*maxBytes);
+    } else if (const auto* signedMaxBytes = value.getInt(); signedMaxBytes && *signedMaxBytes > 0) {
+        return static_cast<size_t>(*signedMaxBytes);
+    }
+    return 0;
+}
+
+TileCache::EvictionPolicy getTileCacheEvictionPolicy() {
+    const auto value = platform::Settings::getInstance().get(platform::TILE_CACHE_EVICTION_POLICY);
+    if (const auto* name = value.getString()) {
+        if (*name == "cost-weighted") {
+            return TileCache::EvictionPolicy::CostWeighted;
+        } else if (*name == "zoom-distance") {
+            return TileCache::EvictionPolicy::ZoomDistance;
+        } else if (*name != "lru") {
+            Log::Warning(Event::General, "Unknown tile cache eviction policy '" + *name + "', using LRU");
+        }
+    }
+    return TileCache::EvictionPolicy::LRU;
+}
+
+// A tile one zoom level away from the ideal one ranks as though it were this many tiles away from
+// the centre of the viewport, and terrain tiles as though they were this much farther.
+constexpr float zoomLevelRank = 4.0f;
+constexpr float rasterDEMRank = 2.0f;
+
+// Ranks the network request of a tile, the lowest going out first: tiles at the ideal zoom near the
+// centre of the viewport, then those farther away, parent tiles and prefetched tiles. `center` is in
+// tile units at zoom 0.
+float getRequestRank(const OverscaledTileID& id, const TileCoordinatePoint& center, int32_t tileZoom, SourceType type) {
+    const double scale = std::pow(2.0, id.canonical.z);
+    const double x = id.canonical.x + static_cast<double>(id.wrap) * scale + 0.5;
+    const double y = id.canonical.y + 0.5;
+    const auto distance = static_cast<float>(std::hypot(x - center.x * scale, y - center.y * scale));
+    const auto zoomDelta = static_cast<float>(std::abs(tileZoom - id.overscaledZ));
+    return distance + zoomDelta * zoomLevelRank + (type == SourceType::RasterDEM ? rasterDEMRank : 0.0f);
+}
+
 } // namespace
 
 TilePyramid::TilePyramid(const TaggedScheduler& threadPool_)
     : cache(threadPool_),
-      observer(&nullObserver) {}
+      observer(&nullObserver) {
+    cache.setMaxBytes(getTileCacheMaxBytes());
+    cache.setEvictionPolicy(getTileCacheEvictionPolicy());
+}
 
 TilePyramid::~TilePyramid() = default;
 
 bool TilePyramid::isLoaded() const {
+    if (deferredUploads) {
+        return false;
+    }
+
     for (const auto& pair : tiles) {
         if (!pair.second->isComplete()) {
             return false;
@@ -76,6 +130,7 @@ void TilePyramid::update(const std::vector<Immutable<style::LayerProperties>>& l
                 // for them and thus suppress network requests on
                 // tiles expiration (see `OnlineFileRequest`).
                 entry.second->setNecessity(TileNecessity::Optional);
+                entry.second->setTaskPriority(TaskPriority::Prefetch);
                 cache.add(entry.first, std::move(entry.second));
             } else {
                 cache.deferredRelease(std::move(entry.second));
@@ -109,12 +164,15 @@ void TilePyramid::update(const std::vector<Immutable<style::LayerProperties>>& l
 
     std::vector<OverscaledTileID> idealTiles;
     std::vector<OverscaledTileID> panTiles;
+    std::vector<OverscaledTileID> targetTiles;
+    int32_t targetTileZoom = tileZoom;
 
     util::TileCoverParameters tileCoverParameters = {.transformState = parameters.transformState,
                                                      .tileLodMinRadius = parameters.tileLodMinRadius,
                                                      .tileLodScale = parameters.tileLodScale,
                                                      .tileLodPitchThreshold = parameters.tileLodPitchThreshold,
-                                                     .tileLodMode = parameters.tileLodMode};
+                                                     .tileLodMode = parameters.tileLodMode,
+                                                     .tileLodMaxTiles = parameters.tileLodMaxTiles};
 
     if (std::cmp_greater_equal(overscaledZoom, zoomRange.min)) {
         int32_t idealZoom = std::min<int32_t>(zoomRange.max, overscaledZoom);
@@ -138,6 +196,24 @@ void TilePyramid::update(const std::vector<Immutable<style::LayerProperties>>& l
             if (panZoom < idealZoom) {
                 panTiles = util::tileCover(tileCoverParameters, panZoom, zoomRange);
             }
+
+            // Request the tiles at the destination of a camera animation before it gets there.
+            // They're dropped again, and their requests cancelled, once the destination changes.
+            if (const auto* targetState = parameters.transitionTargetState) {
+                const double targetZoom = util::clamp<double>(targetState->getZoom() + parameters.tileLodZoomShift,
+                                                              targetState->getMinZoom(),
+                                                              targetState->getMaxZoom());
+                targetTileZoom = util::coveringZoomLevel(targetZoom, type, tileSize);
+                if (std::cmp_greater_equal(targetTileZoom, zoomRange.min)) {
+                    const int32_t targetIdealZoom = std::min<int32_t>(zoomRange.max, targetTileZoom);
+                    if (type == SourceType::Raster) {
+                        targetTileZoom = targetIdealZoom;
+                    }
+                    auto targetCoverParameters = tileCoverParameters;
+                    targetCoverParameters.transformState = *targetState;
+                    targetTiles = util::tileCover(targetCoverParameters, targetIdealZoom, zoomRange, targetTileZoom);
+                }
+            }
         }
 
         idealTiles = util::tileCover(tileCoverParameters, idealZoom, zoomRange, tileZoom);
@@ -157,12 +233,26 @@ void TilePyramid::update(const std::vector<Immutable<style::LayerProperties>>& l
     // using, e.g. as a replacement for tile that aren't loaded yet.
     std::set<OverscaledTileID> retain;
 
+    // Work on the tiles needed for the current view takes precedence over prefetching.
+    // Tiles retained in both passes end up with the priority of the ideal pass.
+    bool idealPass = false;
+    const auto center = TileCoordinate::fromLatLng(0, parameters.transformState.getLatLng()).p;
     auto retainTileFn = [&](Tile& tile, TileNecessity necessity) -> void {
         if (retain.emplace(tile.id).second) {
             tile.setUpdateParameters({.minimumUpdateInterval = minimumUpdateInterval, .isVolatile = isVolatile});
+            // Set before the necessity, which may start the network request
+            tile.setRequestRank(getRequestRank(tile.id, center, tileZoom, type));
             tile.setNecessity(necessity);
         }
 
+        if (!idealPass) {
+            tile.setTaskPriority(TaskPriority::Prefetch);
+        } else if (necessity == TileNecessity::Required) {
+            tile.setTaskPriority(TaskPriority::Urgent);
+        } else {
+            tile.setTaskPriority(TaskPriority::Normal);
+        }
+
         if (needsRelayout) {
             tile.setLayers(layers);
         }
@@ -179,15 +269,58 @@ void TilePyramid::update(const std::vector<Immutable<style::LayerProperties>>& l
     if (bounds) {
         int32_t maxZoom = (parameters.tileLodMode == TileLodMode::Distance)
                               ? zoomRange.max
-                              : std::min(tileZoom, static_cast<int32_t>(zoomRange.max));
+                              : std::min(std::max(tileZoom, targetTileZoom), static_cast<int32_t>(zoomRange.max));
         tileRange = util::TileRange::fromLatLngBounds(*bounds, zoomRange.min, maxZoom);
     }
+    // Tiles rendered for the first time are uploaded within a per-frame budget. The ideal tiles are
+    // admitted first, nearest to the center first, and the tiles that don't fit wait for the next frames,
+    // while updateRenderables renders their parents or children in their place.
+    const bool uploadBudgeted = parameters.tileUploadBudget > 0 && parameters.mode == MapMode::Continuous;
+    deferredUploads = false;
+    if (uploadBudgeted) {
+        std::size_t uploadBytes = 0;
+        bool admitted = false;
+        const auto admit = [&](Tile& tile) {
+            if (tile.uploaded || !tile.uploadDeferred) {
+                return;
+            }
+            const auto bytes = tile.getMemoryUsage().total();
+            if (!admitted || uploadBytes + bytes <= parameters.tileUploadBudget) {
+                tile.uploadDeferred = false;
+                uploadBytes += bytes;
+                admitted = true;
+            }
+        };
+
+        // Hold back every tile awaiting its upload, then admit them in priority order
+        for (auto& entry : tiles) {
+            entry.second->uploadDeferred = entry.second->awaitsUpload();
+        }
+        for (const auto& tileID : idealTiles) {
+            if (auto it = tiles.find(tileID); it != tiles.end()) {
+                admit(*it->second);
+            }
+        }
+        for (auto& entry : tiles) {
+            admit(*entry.second);
+            deferredUploads |= entry.second->uploadDeferred;
+        }
+    } else {
+        for (auto& entry : tiles) {
+            entry.second->uploadDeferred = false;
+        }
+    }
+
     auto createTileFn = [&](const OverscaledTileID& tileID) -> Tile* {
         if (tileRange && !tileRange->contains(tileID.canonical)) {
             return nullptr;
         }
         std::unique_ptr<Tile> tile = cache.pop(tileID);
-        if (!tile) {
+        if (tile) {
+            // Not admitted above, so it waits for the next frame if it has to be uploaded
+            tile->uploadDeferred = uploadBudgeted && tile->awaitsUpload();
+            deferredUploads |= tile->uploadDeferred;
+        } else {
             tile = createTile(tileID, observer);
             if (!tile) return nullptr;
             tile->setLayers(layers);
@@ -218,6 +351,19 @@ void TilePyramid::update(const std::vector<Immutable<style::LayerProperties>>& l
             maxParentTileOverscaleFactor);
     }
 
+    if (!targetTiles.empty()) {
+        algorithm::updateRenderables(
+            getTileFn,
+            createTileFn,
+            retainTileFn,
+            [](const UnwrappedTileID&, Tile&) {},
+            targetTiles,
+            emptyPrefetchedTiles,
+            zoomRange,
+            maxParentTileOverscaleFactor);
+    }
+
+    idealPass = true;
     algorithm::updateRenderables(getTileFn,
                                  createTileFn,
                                  retainTileFn,
@@ -243,6 +389,7 @@ void TilePyramid::update(const std::vector<Immutable<style::LayerProperties>>& l
             std::max(static_cast<double>(parameters.transformState.getSize().width) / tileSize, 1.0) *
             std::max(static_cast<double>(parameters.transformState.getSize().height) / tileSize, 1.0) *
             (parameters.transformState.getMaxZoom() - parameters.transformState.getMinZoom() + 1) * 0.5);
+        cache.setCameraZoom(parameters.transformState.getZoom());
         cache.setSize(conservativeCacheSize);
     } else {
         cache.setSize(0);
@@ -264,6 +411,7 @@ void TilePyramid::update(const std::vector<Immutable<style::LayerProperties>>& l
                         cache.deferredRelease(std::move(tile));
                     } else {
                         tile->setNecessity(TileNecessity::Optional);
+                        tile->setTaskPriority(TaskPriority::Prefetch);
                         cache.add(key, std::move(tile));
                     }
                 }
@@ -281,10 +429,16 @@ void TilePyramid::update(const std::vector<Immutable<style::LayerProperties>>& l
     }
 
     // Initialize renderable tiles and update the contained layer render data.
+    const TimePoint now = Clock::now();
     for (auto& entry : renderedTiles) {
         Tile& tile = entry.second;
         assert(tile.isRenderable());
         tile.usedByRenderedLayers = false;
+        if (!tile.uploaded) {
+            tile.addLatencies(latencies, now);
+            latenciesChanged = true;
+        }
+        tile.uploaded = true;
 
         const bool holdForFade = tile.holdForFade();
         for (const auto& layerProperties : layers) {
@@ -371,6 +525,10 @@ std::unordered_map<std::string, std::vector<Feature>> TilePyramid::queryRendered
 
     auto maxPitchScaleFactor = transformState.maxPitchScaleFactor();
 
+    // The tiles the query reaches, in the order their results are merged
+    std::vector<std::pair<std::reference_wrapper<Tile>, GeometryCoordinates>> queriedTiles;
+    queriedTiles.reserve(sortedTiles.size());
+
     for (const auto& entry : sortedTiles) {
         const UnwrappedTileID& id = entry.first;
         Tile& tile = entry.second;
@@ -398,8 +556,41 @@ std::unordered_map<std::string, std::vector<Feature>> TilePyramid::queryRendered
             tileSpaceQueryGeometry.push_back(TileCoordinate::toGeometryCoordinate(id, c));
         }
 
-        tile.queryRenderedFeatures(
-            result, tileSpaceQueryGeometry, transformState, layers, options, projMatrix, featureState);
+        queriedTiles.emplace_back(tile, std::move(tileSpaceQueryGeometry));
+    }
+
+    const auto queryTile = [&](std::size_t i, std::unordered_map<std::string, std::vector<Feature>>& tileResult) {
+        queriedTiles[i].first.get().queryRenderedFeatures(
+            tileResult, queriedTiles[i].second, transformState, layers, options, projMatrix, featureState);
+    };
+
+    // A limited query stops at the first tiles that fill it, so it isn't worth spreading out
+    if (options.limit || queriedTiles.size() < 2) {
+        for (std::size_t i = 0; i < queriedTiles.size(); ++i) {
+            queryTile(i, result);
+            if (options.limit && featureCount(result) >= *options.limit) {
+                break;
+            }
+        }
+        return result;
+    }
+
+    // Tiles only read their own data and the shared layer properties, so they can be queried concurrently.
+    // Merging the results in tile order gives the same feature order as querying them one by one.
+    std::vector<std::unordered_map<std::string, std::vector<Feature>>> tileResults(queriedTiles.size());
+    util::parallelFor(queriedTiles.size(), [&](std::size_t i) {
+        queryTile(i, tileResults[i]);
+    });
+
+    for (auto& tileResult : tileResults) {
+        for (auto& [layerID, features] : tileResult) {
+            auto& layerFeatures = result[layerID];
+            if (layerFeatures.empty()) {
+                layerFeatures = std::move(features);
+            } else {
+                std::ranges::move(features, std::back_inserter(layerFeatures));
+            }
+        }
     }
 
     return result;
@@ -409,9 +600,20 @@ std::vector<Feature> TilePyramid::querySourceFeatures(const SourceQueryOptions&
     std::vector<Feature> result;
 
     for (const auto& pair : tiles) {
+        if (options.bounds && !options.bounds->intersects(LatLngBounds(pair.first.canonical))) {
+            continue;
+        }
         pair.second->querySourceFeatures(result, options);
     }
 
+    if (options.deduplicate) {
+        std::unordered_set<std::string> seen;
+        std::erase_if(result, [&](const Feature& feature) {
+            const auto id = featureIDtoString(feature.id);
+            return id && !seen.insert(feature.sourceLayer + '\0' + *id).second;
+        });
+    }
+
     return result;
 }
 
@@ -423,6 +625,10 @@ void TilePyramid::reduceMemoryUse() {
     cache.clear();
 }
 
+void TilePyramid::trimCache() {
+    cache.trim(cache.getBytes() / 2);
+}
+
 void TilePyramid::setObserver(TileObserver* observer_) {
     observer = observer_;
 }
@@ -433,13 +639,33 @@ void TilePyramid::dumpDebugLogs() const {
     }
 }
 
+void TilePyramid::reportMemoryUsage(MemoryReport::Source& source, std::map<std::string, MemoryUsage>& layers) const {
+    const auto report = [&](const Tile& tile) {
+        tile.reportMemoryUsage(source, layers);
+        ++source.tiles;
+    };
+    for (const auto& pair : tiles) {
+        report(*pair.second);
+    }
+    cache.forEachTile(report);
+}
+
 void TilePyramid::clearAll() {
     fadingTiles = false;
+    deferredUploads = false;
     tiles.clear();
     renderedTiles.clear();
     cache.clear();
 }
 
+const TileLatencies* TilePyramid::takeLatencyUpdate() {
+    if (!latenciesChanged) {
+        return nullptr;
+    }
+    latenciesChanged = false;
+    return &latencies;
+}
+
 void TilePyramid::addRenderTile(const UnwrappedTileID& tileID, Tile& tile) {
     assert(tile.isRenderable());
     renderedTiles.emplace(tileID, tile);
@@ -62,15 +62,24 @@ public:
 
     void setCacheEnabled(bool);
     void reduceMemoryUse();
+    /// Evict cached tiles until the cache takes half the memory it did
+    void trimCache();
 
     void setObserver(TileObserver*);
     void dumpDebugLogs() const;
 
+    /// Add the memory of the tiles held, including the cached ones, to the report of the source
+    void reportMemoryUsage(MemoryReport::Source&, std::map<std::string, MemoryUsage>& layers) const;
+
     const std::map<OverscaledTileID, std::unique_ptr<Tile>>& getTiles() const { return tiles; }
     void clearAll();
 
     void updateFadingTiles();
     bool hasFadingTiles() const { return fadingTiles; }
+    /// Whether some renderable tiles were held back by the upload budget in the last update
+    bool hasDeferredUploads() const { return deferredUploads; }
+    /// The latencies of the tiles rendered so far, if tiles were rendered for the first time since the last call
+    const TileLatencies* takeLatencyUpdate();
 
 private:
     void addRenderTile(const UnwrappedTileID& tileID, Tile& tile);
@@ -84,7 +93,11 @@ private:
     float prevLng = 0;
 
     bool fadingTiles = false;
+    bool deferredUploads = false;
     bool cacheEnabled = true;
+
+    TileLatencies latencies;
+    bool latenciesChanged = false;
 };
 
 } // namespace mbgl
@@ -6,11 +6,13 @@
 #include <mbgl/style/image.hpp>
 #include <mbgl/style/source.hpp>
 #include <mbgl/style/layer.hpp>
+#include <mbgl/style/collection.hpp>
 #include <mbgl/text/glyph.hpp>
 #include <mbgl/util/chrono.hpp>
 #include <mbgl/util/immutable.hpp>
 
 #include <numbers>
+#include <optional>
 #include <vector>
 
 #include <mapbox/std/weak.hpp>
@@ -28,6 +30,8 @@ public:
     const MapDebugOptions debugOptions;
     const TimePoint timePoint;
     const TransformState transformState;
+    // The camera at the end of the transition in progress, if any
+    const std::optional<TransformState> transitionTargetState;
 
     const std::string glyphURL;
     std::shared_ptr<FontFaces> fontFaces;
@@ -37,6 +41,9 @@ public:
     const Immutable<std::vector<Immutable<style::Image::Impl>>> images;
     const Immutable<std::vector<Immutable<style::Source::Impl>>> sources;
     const Immutable<std::vector<Immutable<style::Layer::Impl>>> layers;
+    // The changes since the previous update, null if they weren't all recorded
+    std::shared_ptr<const style::CollectionJournal<style::Source::Impl>> sourceJournal;
+    std::shared_ptr<const style::CollectionJournal<style::Layer::Impl>> layerJournal;
 
     mapbox::base::WeakPtr<AnnotationManager> annotationManager;
     std::shared_ptr<FileSource> fileSource;
@@ -53,6 +60,8 @@ public:
     double tileLodPitchThreshold = (60.0 / 180.0) * std::numbers::pi;
     double tileLodZoomShift = 0;
     TileLodMode tileLodMode = TileLodMode::Default;
+    std::size_t tileLodMaxTiles = 0;
+    std::size_t tileUploadBudget = 0;
 };
 
 } // namespace mbgl
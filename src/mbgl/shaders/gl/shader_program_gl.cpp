@@ -1,13 +1,17 @@
 #include <mbgl/shaders/gl/shader_program_gl.hpp>
 
 #include <mbgl/gl/defines.hpp>
+#include <mbgl/gl/parallel_shader_compile_extension.hpp>
+#include <mbgl/gl/program_binary_cache.hpp>
 #include <mbgl/gl/types.hpp>
 #include <mbgl/gl/vertex_attribute_gl.hpp>
 #include <mbgl/platform/gl_functions.hpp>
 #include <mbgl/shaders/program_parameters.hpp>
 #include <mbgl/shaders/shader_manifest.hpp>
+#include <mbgl/util/instrumentation.hpp>
 
 #include <cstring>
+#include <optional>
 #include <utility>
 
 namespace mbgl {
@@ -81,8 +85,64 @@ void addAttr(VertexAttributeArrayGL& attrs, const size_t id, GLint index, GLsize
     }
 }
 
+/// Look up the uniform blocks, samplers and attributes of a linked program
+void introspect(ProgramID program,
+                const std::vector<shaders::UniformBlockInfo>& uniformBlocksInfo,
+                const std::vector<shaders::TextureInfo>& texturesInfo,
+                const std::vector<shaders::AttributeInfo>& attributesInfo,
+                VertexAttributeArrayGL& attrs,
+                ShaderProgramGL::SamplerLocationArray& samplerLocations) {
+    for (const auto& blockInfo : uniformBlocksInfo) {
+        GLint index = MBGL_CHECK_ERROR(glGetUniformBlockIndex(program, blockInfo.name.data()));
+        GLint size = 0;
+        MBGL_CHECK_ERROR(glGetActiveUniformBlockiv(program, index, GL_UNIFORM_BLOCK_DATA_SIZE, &size));
+        assert(size > 0);
+        GLint binding = static_cast<GLint>(blockInfo.binding);
+        MBGL_CHECK_ERROR(glUniformBlockBinding(program, index, binding));
+    }
+
+    for (const auto& textureInfo : texturesInfo) {
+        GLint location = MBGL_CHECK_ERROR(glGetUniformLocation(program, textureInfo.name.data()));
+        assert(location != -1);
+        if (location != -1) {
+            samplerLocations[textureInfo.id] = location;
+        }
+    }
+
+    GLint count = 0;
+    GLint maxLength = 0;
+    MBGL_CHECK_ERROR(glGetProgramiv(program, GL_ACTIVE_ATTRIBUTES, &count));
+    MBGL_CHECK_ERROR(glGetProgramiv(program, GL_ACTIVE_ATTRIBUTE_MAX_LENGTH, &maxLength));
+    auto name = std::vector<GLchar>(maxLength);
+    for (GLint index = 0; index < count; ++index) {
+        GLsizei length = 0; // "number of characters actually written in name (excluding the null terminator)"
+        GLint size = 0;     // "size of the attribute variable, in units of the type returned in type"
+        GLenum glType = 0;
+        MBGL_CHECK_ERROR(glGetActiveAttrib(program, index, maxLength, &length, &size, &glType, name.data()));
+        if (!strncmp(name.data(), "gl_", 3)) { // Is there a better way to detect built-in attributes?
+            continue;
+        }
+        const GLint location = MBGL_CHECK_ERROR(glGetAttribLocation(program, name.data()));
+        assert(attributesInfo[location].name == std::string_view(name.data()));
+        addAttr(attrs, attributesInfo[location].id, location, length, size, glType);
+    }
+}
+
 } // namespace
 
+/// What is needed to finish a program whose compilation and linking was left to the driver's threads
+struct ShaderProgramGL::PendingLink {
+    Context& context;
+    UniqueShader vertexShader;
+    UniqueShader fragmentShader;
+    shaders::BuiltIn programType;
+    std::string additionalDefines;
+    std::size_t binaryKey;
+    std::vector<shaders::UniformBlockInfo> uniformBlocksInfo;
+    std::vector<shaders::TextureInfo> texturesInfo;
+    std::vector<shaders::AttributeInfo> attributesInfo;
+};
+
 ShaderProgramGL::ShaderProgramGL(UniqueProgram&& glProgram_)
     : ShaderProgramBase(),
       glProgram(std::move(glProgram_)) {}
@@ -98,9 +158,17 @@ ShaderProgramGL::ShaderProgramGL(UniqueProgram&& program,
 ShaderProgramGL::ShaderProgramGL(ShaderProgramGL&& other)
     : ShaderProgramBase(std::forward<ShaderProgramBase&&>(other)),
       glProgram(std::move(other.glProgram)),
+      pendingLink(std::move(other.pendingLink)),
+      linkFailed(other.linkFailed),
       vertexAttributes(std::move(other.vertexAttributes)),
       samplerLocations(std::move(other.samplerLocations)) {}
 
+ShaderProgramGL::~ShaderProgramGL() noexcept {
+    if (pendingLink) {
+        pendingLink->context.removePendingProgram();
+    }
+}
+
 std::optional<size_t> ShaderProgramGL::getSamplerLocation(const size_t id) const {
     return (id < samplerLocations.size()) ? samplerLocations[id] : std::nullopt;
 }
@@ -119,63 +187,74 @@ std::shared_ptr<ShaderProgramGL> ShaderProgramGL::create(
         context.getObserver().onPreCompileShader(
             programParameters.getProgramType(), gfx::Backend::Type::OpenGL, additionalDefines);
 
-        // throws on compile error
-        auto vertProg = context.createShader(
-            ShaderType::Vertex,
-            std::initializer_list<const char*>{
-                "#version 300 es\n",
-                programParameters.getDefinesString().c_str(),
-                additionalDefines.c_str(),
-                shaders::ShaderSource<shaders::BuiltIn::Prelude, gfx::Backend::Type::OpenGL>::vertex,
-                vertexSource.c_str()});
-        auto fragProg = context.createShader(
-            ShaderType::Fragment,
-            {"#version 300 es\n",
-             programParameters.getDefinesString().c_str(),
-             additionalDefines.c_str(),
-             shaders::ShaderSource<shaders::BuiltIn::Prelude, gfx::Backend::Type::OpenGL>::fragment,
-             fragmentSource.c_str()});
-        auto program = context.createProgram(vertProg, fragProg, firstAttribName.data());
+        const auto& defines = programParameters.getDefinesString();
+        using Prelude = shaders::ShaderSource<shaders::BuiltIn::Prelude, gfx::Backend::Type::OpenGL>;
 
-        context.getObserver().onPostCompileShader(
-            programParameters.getProgramType(), gfx::Backend::Type::OpenGL, additionalDefines);
+        auto* binaryCache = context.getProgramBinaryCache();
+        const auto binaryKey = binaryCache ? binaryCache->key({defines,
+                                                               additionalDefines,
+                                                               Prelude::vertex,
+                                                               vertexSource,
+                                                               Prelude::fragment,
+                                                               fragmentSource,
+                                                               firstAttribName})
+                                           : 0;
+        auto cachedProgram = binaryCache ? binaryCache->load(binaryKey) : std::nullopt;
 
-        for (const auto& blockInfo : uniformBlocksInfo) {
-            GLint index = MBGL_CHECK_ERROR(glGetUniformBlockIndex(program, blockInfo.name.data()));
-            GLint size = 0;
-            MBGL_CHECK_ERROR(glGetActiveUniformBlockiv(program, index, GL_UNIFORM_BLOCK_DATA_SIZE, &size));
-            assert(size > 0);
-            GLint binding = static_cast<GLint>(blockInfo.binding);
-            MBGL_CHECK_ERROR(glUniformBlockBinding(program, index, binding));
-        }
+        // Programs restored from a binary are ready at once, there's nothing to leave to the driver
+        const bool deferLink = !cachedProgram && context.getAsyncShaderCompilation();
 
-        SamplerLocationArray samplerLocations;
-        for (const auto& textureInfo : texturesInfo) {
-            GLint location = MBGL_CHECK_ERROR(glGetUniformLocation(program, textureInfo.name.data()));
-            assert(location != -1);
-            if (location != -1) {
-                samplerLocations[textureInfo.id] = location;
+        std::optional<UniqueShader> vertProg;
+        std::optional<UniqueShader> fragProg;
+        auto program = cachedProgram ? std::move(*cachedProgram) : [&] {
+            // throws on compile error, unless the link is deferred
+            vertProg = context.createShader(ShaderType::Vertex,
+                                            std::initializer_list<const char*>{"#version 300 es\n",
+                                                                               defines.c_str(),
+                                                                               additionalDefines.c_str(),
+                                                                               Prelude::vertex,
+                                                                               vertexSource.c_str()},
+                                            !deferLink);
+            fragProg = context.createShader(ShaderType::Fragment,
+                                            {"#version 300 es\n",
+                                             defines.c_str(),
+                                             additionalDefines.c_str(),
+                                             Prelude::fragment,
+                                             fragmentSource.c_str()},
+                                            !deferLink);
+            auto linked = context.createProgram(*vertProg,
+                                                *fragProg,
+                                                firstAttribName.data(),
+                                                /*retrievableBinary=*/binaryCache != nullptr,
+                                                /*verify=*/!deferLink);
+            if (binaryCache && !deferLink) {
+                binaryCache->store(linked, binaryKey);
             }
+            return linked;
+        }();
+
+        if (deferLink) {
+            // Hand out the program now, `isReady` picks up the results once the driver is done
+            auto shader = std::make_shared<ShaderProgramGL>(std::move(program));
+            shader->pendingLink = std::make_unique<PendingLink>(PendingLink{context,
+                                                                            std::move(*vertProg),
+                                                                            std::move(*fragProg),
+                                                                            programParameters.getProgramType(),
+                                                                            additionalDefines,
+                                                                            binaryKey,
+                                                                            uniformBlocksInfo,
+                                                                            texturesInfo,
+                                                                            attributesInfo});
+            context.addPendingProgram();
+            return shader;
         }
 
+        context.getObserver().onPostCompileShader(
+            programParameters.getProgramType(), gfx::Backend::Type::OpenGL, additionalDefines);
+
         VertexAttributeArrayGL attrs;
-        GLint count = 0;
-        GLint maxLength = 0;
-        MBGL_CHECK_ERROR(glGetProgramiv(program, GL_ACTIVE_ATTRIBUTES, &count));
-        MBGL_CHECK_ERROR(glGetProgramiv(program, GL_ACTIVE_ATTRIBUTE_MAX_LENGTH, &maxLength));
-        auto name = std::vector<GLchar>(maxLength);
-        for (GLint index = 0; index < count; ++index) {
-            GLsizei length = 0; // "number of characters actually written in name (excluding the null terminator)"
-            GLint size = 0;     // "size of the attribute variable, in units of the type returned in type"
-            GLenum glType = 0;
-            MBGL_CHECK_ERROR(glGetActiveAttrib(program, index, maxLength, &length, &size, &glType, name.data()));
-            if (!strncmp(name.data(), "gl_", 3)) { // Is there a better way to detect built-in attributes?
-                continue;
-            }
-            const GLint location = MBGL_CHECK_ERROR(glGetAttribLocation(program, name.data()));
-            assert(attributesInfo[location].name == std::string_view(name.data()));
-            addAttr(attrs, attributesInfo[location].id, location, length, size, glType);
-        }
+        SamplerLocationArray samplerLocations;
+        introspect(program, uniformBlocksInfo, texturesInfo, attributesInfo, attrs, samplerLocations);
 
         return std::make_shared<ShaderProgramGL>(std::move(program), std::move(attrs), std::move(samplerLocations));
     } catch (const std::exception& e) {
@@ -185,5 +264,45 @@ std::shared_ptr<ShaderProgramGL> ShaderProgramGL::create(
     }
 }
 
+void ShaderProgramGL::finishLink() {
+    MLN_TRACE_FUNC();
+
+    GLint completed = GL_FALSE;
+    MBGL_CHECK_ERROR(glGetProgramiv(glProgram, GL_COMPLETION_STATUS_KHR, &completed));
+    if (completed != GL_TRUE) {
+        return;
+    }
+
+    const auto link = std::move(pendingLink);
+    auto& context = link->context;
+    context.removePendingProgram();
+
+    try {
+        context.verifyShaderCompilation(link->vertexShader);
+        context.verifyShaderCompilation(link->fragmentShader);
+        context.verifyProgramLinkage(glProgram);
+
+        if (auto* binaryCache = context.getProgramBinaryCache()) {
+            binaryCache->store(glProgram, link->binaryKey);
+        }
+
+        context.getObserver().onPostCompileShader(
+            link->programType, gfx::Backend::Type::OpenGL, link->additionalDefines);
+
+        introspect(glProgram,
+                   link->uniformBlocksInfo,
+                   link->texturesInfo,
+                   link->attributesInfo,
+                   vertexAttributes,
+                   samplerLocations);
+    } catch (const std::exception&) {
+        // Already logged. Unlike the synchronous path there's no caller to throw to, so drawables
+        // using this program are skipped from now on.
+        linkFailed = true;
+        context.getObserver().onShaderCompileFailed(
+            link->programType, gfx::Backend::Type::OpenGL, link->additionalDefines);
+    }
+}
+
 } // namespace gl
 } // namespace mbgl
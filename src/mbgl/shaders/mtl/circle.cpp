@@ -20,5 +20,24 @@ const std::array<AttributeInfo, 8> CircleShaderSource::attributes = {
 };
 const std::array<TextureInfo, 0> CircleShaderSource::textures = {};
 
+using CircleInstancedShaderSource = ShaderSource<BuiltIn::CircleInstancedShader, gfx::Backend::Type::Metal>;
+
+const std::array<AttributeInfo, 1> CircleInstancedShaderSource::attributes = {
+    AttributeInfo{0, gfx::AttributeDataType::Short2, circleUBOCount + 0, idCirclePosVertexAttribute},
+};
+const std::array<AttributeInfo, 8> CircleInstancedShaderSource::instanceAttributes = {
+    AttributeInfo{1, gfx::AttributeDataType::Short2, circleUBOCount + 1, idCircleCenterAttribute},
+
+    // Data driven
+    AttributeInfo{2, gfx::AttributeDataType::Float4, circleUBOCount + 2, idCircleColorVertexAttribute},
+    AttributeInfo{3, gfx::AttributeDataType::Float2, circleUBOCount + 2, idCircleRadiusVertexAttribute},
+    AttributeInfo{4, gfx::AttributeDataType::Float2, circleUBOCount + 2, idCircleBlurVertexAttribute},
+    AttributeInfo{5, gfx::AttributeDataType::Float2, circleUBOCount + 2, idCircleOpacityVertexAttribute},
+    AttributeInfo{6, gfx::AttributeDataType::Float4, circleUBOCount + 2, idCircleStrokeColorVertexAttribute},
+    AttributeInfo{7, gfx::AttributeDataType::Float2, circleUBOCount + 2, idCircleStrokeWidthVertexAttribute},
+    AttributeInfo{8, gfx::AttributeDataType::Float2, circleUBOCount + 2, idCircleStrokeOpacityVertexAttribute},
+};
+const std::array<TextureInfo, 0> CircleInstancedShaderSource::textures = {};
+
 } // namespace shaders
 } // namespace mbgl
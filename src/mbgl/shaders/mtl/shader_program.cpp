@@ -10,6 +10,7 @@
 #include <mbgl/shaders/shader_manifest.hpp>
 #include <mbgl/util/logging.hpp>
 
+#include <Metal/MTLBinaryArchive.hpp>
 #include <Metal/MTLLibrary.hpp>
 #include <Metal/MTLRenderPass.hpp>
 #include <Metal/MTLRenderPipeline.hpp>
@@ -162,7 +163,21 @@ MTLRenderPipelineStatePtr ShaderProgram::getRenderPipelineState(const gfx::Rende
 
     NS::Error* error = nullptr;
     const auto& device = backend.getDevice();
-    auto rps = NS::TransferPtr(device->newRenderPipelineState(desc.get(), &error));
+
+    // Look the pipeline up in the binary archive first, and only compile it if it's missing there
+    MTLRenderPipelineStatePtr rps;
+    if (auto* archive = backend.getBinaryArchive()) {
+        desc->setBinaryArchives(NS::Array::array(archive));
+        rps = NS::TransferPtr(device->newRenderPipelineState(
+            desc.get(), MTL::PipelineOptionFailOnBinaryArchiveMiss, nullptr, &error));
+        if (!rps) {
+            error = nullptr;
+            backend.addToBinaryArchive(desc.get());
+        }
+    }
+    if (!rps) {
+        rps = NS::TransferPtr(device->newRenderPipelineState(desc.get(), &error));
+    }
 
     if (!rps || error) {
         const auto errPtr = error ? error->localizedDescription()->utf8String() : nullptr;
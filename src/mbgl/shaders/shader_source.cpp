@@ -13,6 +13,7 @@ MBGL_DEFINE_ENUM(BuiltIn,
                   {BuiltIn::BackgroundShader, "BackgroundShader"},
                   {BuiltIn::BackgroundPatternShader, "BackgroundPatternShader"},
                   {BuiltIn::CircleShader, "CircleShader"},
+                  {BuiltIn::CircleInstancedShader, "CircleInstancedShader"},
                   {BuiltIn::CollisionBoxShader, "CollisionBoxShader"},
                   {BuiltIn::CollisionCircleShader, "CollisionCircleShader"},
                   {BuiltIn::CustomGeometryShader, "CustomGeometryShader"},
@@ -233,7 +233,9 @@ const vk::UniquePipeline& ShaderProgram::getPipeline(const PipelineInfo& pipelin
                                         .setLayout(pipelineLayout.get())
                                         .setRenderPass(pipelineInfo.renderPass);
 
-    pipeline = std::move(device->createGraphicsPipelineUnique(nullptr, pipelineCreateInfo, nullptr, dispatcher).value);
+    pipeline = std::move(
+        device->createGraphicsPipelineUnique(backend.getPipelineCache().get(), pipelineCreateInfo, nullptr, dispatcher)
+            .value);
     backend.setDebugName(pipeline.get(), shaderName + "_pipeline");
 
     return pipeline;
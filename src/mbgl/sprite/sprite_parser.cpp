@@ -6,6 +6,7 @@
 #include <mbgl/util/logging.hpp>
 
 #include <mbgl/util/image.hpp>
+#include <mbgl/util/parallel_for.hpp>
 #include <mbgl/util/rapidjson.hpp>
 #include <mbgl/util/string.hpp>
 
@@ -68,6 +69,25 @@ std::unique_ptr<style::Image> createStyleImage(const std::string& id,
 
 namespace {
 
+// Sprites with fewer images than this are sliced on the calling thread
+constexpr std::size_t minParallelImages = 64;
+
+// The metadata of one sprite image, read before any of them is sliced out of the sprite
+struct SpriteImageEntry {
+    std::string id;
+    uint16_t x;
+    uint16_t y;
+    uint16_t width;
+    uint16_t height;
+    double pixelRatio;
+    bool sdf;
+    style::ImageStretches stretchX;
+    style::ImageStretches stretchY;
+    std::optional<style::ImageContent> content;
+    std::optional<style::TextFit> textFitWidth;
+    std::optional<style::TextFit> textFitHeight;
+};
+
 uint16_t getUInt16(const JSValue& value, const char* property, const char* name, const uint16_t def = 0) {
     if (value.HasMember(property)) {
         auto& v = value[property];
@@ -213,8 +233,8 @@ std::vector<Immutable<style::Image::Impl>> parseSprite(const std::string& id,
     }
 
     const auto& properties = doc.GetObject();
-    std::vector<Immutable<style::Image::Impl>> images;
-    images.reserve(properties.MemberCount());
+    std::vector<SpriteImageEntry> entries;
+    entries.reserve(properties.MemberCount());
     for (const auto& property : properties) {
         const std::string name = {property.name.GetString(), property.name.GetStringLength()};
         std::string completeName = name;
@@ -225,34 +245,52 @@ std::vector<Immutable<style::Image::Impl>> parseSprite(const std::string& id,
         const JSValue& value = property.value;
 
         if (value.IsObject()) {
-            const uint16_t x = getUInt16(value, "x", name.c_str(), 0);
-            const uint16_t y = getUInt16(value, "y", name.c_str(), 0);
-            const uint16_t width = getUInt16(value, "width", name.c_str(), 0);
-            const uint16_t height = getUInt16(value, "height", name.c_str(), 0);
-            const double pixelRatio = getDouble(value, "pixelRatio", name.c_str(), 1);
-            const bool sdf = getBoolean(value, "sdf", name.c_str(), false);
-            style::ImageStretches stretchX = getStretches(value, "stretchX", name.c_str());
-            style::ImageStretches stretchY = getStretches(value, "stretchY", name.c_str());
-            std::optional<style::ImageContent> content = getContent(value, "content", name.c_str());
-            std::optional<style::TextFit> textFitWidth = getTextFit(value, "textFitWidth", name.c_str());
-            std::optional<style::TextFit> textFitHeight = getTextFit(value, "textFitHeight", name.c_str());
-
-            auto image = createStyleImage(completeName,
-                                          raster,
-                                          x,
-                                          y,
-                                          width,
-                                          height,
-                                          pixelRatio,
-                                          sdf,
-                                          std::move(stretchX),
-                                          std::move(stretchY),
-                                          content,
-                                          textFitWidth,
-                                          textFitHeight);
-            if (image) {
-                images.push_back(std::move(image->baseImpl));
-            }
+            entries.push_back({.id = std::move(completeName),
+                               .x = getUInt16(value, "x", name.c_str(), 0),
+                               .y = getUInt16(value, "y", name.c_str(), 0),
+                               .width = getUInt16(value, "width", name.c_str(), 0),
+                               .height = getUInt16(value, "height", name.c_str(), 0),
+                               .pixelRatio = getDouble(value, "pixelRatio", name.c_str(), 1),
+                               .sdf = getBoolean(value, "sdf", name.c_str(), false),
+                               .stretchX = getStretches(value, "stretchX", name.c_str()),
+                               .stretchY = getStretches(value, "stretchY", name.c_str()),
+                               .content = getContent(value, "content", name.c_str()),
+                               .textFitWidth = getTextFit(value, "textFitWidth", name.c_str()),
+                               .textFitHeight = getTextFit(value, "textFitHeight", name.c_str())});
+        }
+    }
+
+    // Copying the images out of the sprite dominates for large sprites, and each copy is independent
+    std::vector<std::unique_ptr<style::Image>> sliced(entries.size());
+    const auto slice = [&](std::size_t i) {
+        auto& entry = entries[i];
+        sliced[i] = createStyleImage(entry.id,
+                                     raster,
+                                     entry.x,
+                                     entry.y,
+                                     entry.width,
+                                     entry.height,
+                                     entry.pixelRatio,
+                                     entry.sdf,
+                                     std::move(entry.stretchX),
+                                     std::move(entry.stretchY),
+                                     entry.content,
+                                     entry.textFitWidth,
+                                     entry.textFitHeight);
+    };
+    if (entries.size() >= minParallelImages) {
+        util::parallelFor(entries.size(), slice);
+    } else {
+        for (std::size_t i = 0; i < entries.size(); ++i) {
+            slice(i);
+        }
+    }
+
+    std::vector<Immutable<style::Image::Impl>> images;
+    images.reserve(sliced.size());
+    for (auto& image : sliced) {
+        if (image) {
+            images.push_back(std::move(image->baseImpl));
         }
     }
 
@@ -27,6 +27,7 @@ public:
     std::list<FileSourceInfo> fileSources;
     std::map<FileSourceType, FileSourceFactory> fileSourceFactories;
     std::recursive_mutex mutex;
+    FileSourceMetrics metrics;
 };
 
 FileSourceManager::FileSourceManager()
@@ -75,6 +76,10 @@ void FileSourceManager::registerFileSourceFactory(FileSourceType type, FileSourc
     impl->fileSourceFactories[type] = std::move(factory);
 }
 
+FileSourceMetrics& FileSourceManager::getMetrics() noexcept {
+    return impl->metrics;
+}
+
 FileSourceManager::FileSourceFactory FileSourceManager::unRegisterFileSourceFactory(FileSourceType type) noexcept {
     std::scoped_lock lock(impl->mutex);
     auto it = impl->fileSourceFactories.find(type);
@@ -0,0 +1,77 @@
+#include <mbgl/storage/file_source_metrics.hpp>
+#include <mbgl/storage/response.hpp>
+#include <mbgl/util/url.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace mbgl {
+
+void FileSourceMetrics::Histogram::add(Duration duration) {
+    const double milliseconds = std::chrono::duration<double, std::milli>(duration).count();
+    const auto bucket = std::lower_bound(bounds.begin(), bounds.end(), milliseconds) - bounds.begin();
+    buckets[bucket]++;
+    count++;
+    totalMilliseconds += milliseconds;
+    maxMilliseconds = std::max(maxMilliseconds, milliseconds);
+}
+
+double FileSourceMetrics::Histogram::percentile(double percent) const {
+    if (count == 0) {
+        return 0;
+    }
+    const auto rank = static_cast<uint64_t>(std::ceil(percent / 100.0 * static_cast<double>(count)));
+    uint64_t seen = 0;
+    for (std::size_t i = 0; i < bounds.size(); i++) {
+        seen += buckets[i];
+        if (seen >= std::max<uint64_t>(rank, 1)) {
+            return std::min(bounds[i], maxMilliseconds);
+        }
+    }
+    return maxMilliseconds;
+}
+
+void FileSourceMetrics::record(
+    const Resource& resource, Origin origin, const Response& response, Duration latency, Duration queueWait) {
+    Key key{resource.kind, host(resource.url), origin};
+
+    std::scoped_lock lock(mutex);
+    auto& entry = entries[std::move(key)];
+    entry.responses++;
+    if (response.error) {
+        if (origin == Origin::Cache && response.error->reason == Response::Error::Reason::NotFound) {
+            entry.misses++;
+        } else {
+            entry.errors++;
+        }
+    } else if (response.notModified) {
+        entry.notModified++;
+    }
+    if (response.data) {
+        entry.bytes += response.data->size();
+    }
+    entry.latency.add(latency);
+    if (origin == Origin::Network) {
+        entry.queueWait.add(queueWait);
+    }
+}
+
+FileSourceMetrics::Snapshot FileSourceMetrics::snapshot() const {
+    std::scoped_lock lock(mutex);
+    return entries;
+}
+
+void FileSourceMetrics::reset() {
+    std::scoped_lock lock(mutex);
+    entries.clear();
+}
+
+std::string FileSourceMetrics::host(const std::string& url) {
+    const util::URL parsed(url);
+    if (parsed.scheme.second == 0) {
+        return {};
+    }
+    return url.substr(parsed.domain.first, parsed.domain.second);
+}
+
+} // namespace mbgl
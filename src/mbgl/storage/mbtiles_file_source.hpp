@@ -25,6 +25,10 @@ public:
 private:
     class Impl;
     std::unique_ptr<util::Thread<Impl>> thread; // impl
+
+    // Tile reads run on the background threads, sharing the connections of the pool
+    class ConnectionPool;
+    std::shared_ptr<ConnectionPool> pool;
 };
 
 } // namespace mbgl
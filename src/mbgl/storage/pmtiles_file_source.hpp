@@ -5,6 +5,8 @@
 #include <mbgl/util/client_options.hpp>
 #include <mbgl/util/thread.hpp>
 
+#include <atomic>
+
 namespace mbgl {
 // File source for supporting .pmtiles maps
 class PMTilesFileSource : public FileSource {
@@ -15,6 +17,9 @@ public:
     std::unique_ptr<AsyncRequest> request(const Resource&, Callback) override;
     bool canRequest(const Resource&) const override;
 
+    void setProperty(const std::string&, const mapbox::base::Value&) override;
+    mapbox::base::Value getProperty(const std::string&) const override;
+
     void setResourceOptions(ResourceOptions) override;
     ResourceOptions getResourceOptions() override;
 
@@ -23,6 +28,7 @@ public:
 
 private:
     class Impl;
+    std::shared_ptr<std::atomic<uint64_t>> rangeRequests;
     std::unique_ptr<util::Thread<Impl>> thread; // impl
 };
 
@@ -12,6 +12,7 @@ Response& Response::operator=(const Response& res) {
     notModified = res.notModified;
     mustRevalidate = res.mustRevalidate;
     data = res.data;
+    layout = res.layout;
     modified = res.modified;
     expires = res.expires;
     etag = res.etag;
@@ -0,0 +1,225 @@
+#include <mbgl/style/batch_filter.hpp>
+
+#include <mbgl/style/expression/literal.hpp>
+#include <mbgl/tile/geometry_tile_data.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <string_view>
+#include <utility>
+
+namespace mbgl {
+namespace style {
+
+using expression::Dependency;
+using expression::EvaluationContext;
+using expression::Expression;
+using expression::Kind;
+using expression::Literal;
+
+namespace {
+
+// Beyond this many distinct values of a property, further ones are evaluated without caching
+constexpr std::size_t maxCachedValues = 16;
+
+// Compound expressions reading the feature property whose name is their first argument
+bool readsProperty(const std::string& op, std::size_t argumentCount) {
+    static constexpr std::array<std::string_view, 7> filterOperators = {
+        "filter-==", "filter-<", "filter->", "filter-<=", "filter->=", "filter-has", "filter-in"};
+    if (op == "get" || op == "has") {
+        // With a second argument, they read an object instead
+        return argumentCount == 1;
+    }
+    return std::ranges::find(filterOperators, op) != filterOperators.end();
+}
+
+// Finds the one property `expression` reads, if any. Returns false if it reads several, or depends
+// on anything else about the feature.
+bool findProperty(const Expression& expression, std::optional<std::string>& key) {
+    if (!expression.has(Dependency::Feature)) {
+        return true;
+    }
+
+    std::vector<const Expression*> children;
+    expression.eachChild([&](const Expression& child) { children.push_back(&child); });
+
+    bool reads = false;
+    if (expression.getKind() == Kind::CompoundExpression && readsProperty(expression.getOperator(), children.size())) {
+        if (children.empty() || children.front()->getKind() != Kind::Literal) {
+            return false;
+        }
+        const auto& name = static_cast<const Literal*>(children.front())->getValue();
+        if (!name.is<std::string>() || (key && *key != name.get<std::string>())) {
+            return false;
+        }
+        key = name.get<std::string>();
+        reads = true;
+    }
+
+    bool childrenRead = false;
+    for (const auto* child : children) {
+        childrenRead = childrenRead || child->has(Dependency::Feature);
+        if (!findProperty(*child, key)) {
+            return false;
+        }
+    }
+
+    // Otherwise the feature dependency is the expression's own, like `geometry-type` or `id`
+    return reads || childrenRead;
+}
+
+// A feature with nothing but one property, to evaluate an expression that reads only that
+class PropertyFeature final : public GeometryTileFeature {
+public:
+    FeatureType getType() const override { return FeatureType::Unknown; }
+    std::optional<mbgl::Value> getValue(const std::string& name) const override {
+        return key && name == *key ? value : std::nullopt;
+    }
+
+    const std::string* key = nullptr;
+    std::optional<mbgl::Value> value;
+};
+
+} // namespace
+
+std::optional<BatchFilter> BatchFilter::compile(const Filter& filter) {
+    if (!filter.expression) {
+        return std::nullopt;
+    }
+
+    auto root = compile(**filter.expression);
+    if (!root) {
+        return std::nullopt;
+    }
+
+    BatchFilter result;
+    result.expression = *filter.expression;
+    result.root = std::move(*root);
+    return result;
+}
+
+const BatchFilter* BatchFilter::get(const Filter& filter) {
+    if (!filter.batchFilterCache) {
+        return nullptr;
+    }
+    auto& cache = *filter.batchFilterCache;
+    std::call_once(cache.once, [&] { cache.compiled = compile(filter); });
+    return cache.compiled ? &*cache.compiled : nullptr;
+}
+
+std::optional<BatchFilter::Node> BatchFilter::compile(const Expression& expression) {
+    if (expression.getKind() == Kind::All || expression.getKind() == Kind::Any) {
+        Node node;
+        node.kind = expression.getKind() == Kind::All ? Node::Kind::All : Node::Kind::Any;
+        bool compiled = true;
+        expression.eachChild([&](const Expression& child) {
+            if (auto childNode = compiled ? compile(child) : std::nullopt) {
+                node.children.push_back(std::move(*childNode));
+            } else {
+                compiled = false;
+            }
+        });
+        if (compiled) {
+            return node;
+        }
+    }
+
+    std::optional<std::string> key;
+    if (!findProperty(expression, key)) {
+        return std::nullopt;
+    }
+    Node node;
+    node.expression = &expression;
+    node.key = std::move(key);
+    return node;
+}
+
+std::optional<std::vector<bool>> BatchFilter::evaluate(const GeometryTileLayer& layer,
+                                                       float zoom,
+                                                       const CanonicalTileID& canonical) const {
+    std::vector<Result> results;
+    if (!evaluate(root, layer, zoom, canonical, results)) {
+        return std::nullopt;
+    }
+
+    std::vector<bool> selected(results.size());
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        selected[i] = results[i] == Result::True;
+    }
+    return selected;
+}
+
+bool BatchFilter::evaluate(const Node& node,
+                           const GeometryTileLayer& layer,
+                           float zoom,
+                           const CanonicalTileID& canonical,
+                           std::vector<Result>& results) const {
+    const auto count = layer.featureCount();
+
+    if (node.kind == Node::Kind::Property) {
+        std::optional<std::vector<std::optional<mbgl::Value>>> column;
+        if (node.key) {
+            column = layer.getPropertyColumn(*node.key);
+            if (!column) {
+                return false;
+            }
+            assert(column->size() == count);
+        }
+
+        PropertyFeature feature;
+        feature.key = node.key ? &*node.key : nullptr;
+        const auto evaluateWith = [&](const std::optional<mbgl::Value>& value) {
+            feature.value = value;
+            const auto result = node.expression->evaluate(
+                EvaluationContext(zoom, &feature).withCanonicalTileID(&canonical));
+            if (!result) {
+                return Result::Error;
+            }
+            const auto typed = expression::fromExpressionValue<bool>(*result);
+            return typed && *typed ? Result::True : Result::False;
+        };
+
+        if (!column) {
+            // Doesn't read the feature at all
+            results.assign(count, evaluateWith(std::nullopt));
+            return true;
+        }
+
+        results.resize(count);
+        std::vector<std::pair<std::optional<mbgl::Value>, Result>> cached;
+        for (std::size_t i = 0; i < count; ++i) {
+            const auto& value = (*column)[i];
+            const auto hit = std::ranges::find_if(cached, [&](const auto& entry) { return entry.first == value; });
+            if (hit != cached.end()) {
+                results[i] = hit->second;
+            } else {
+                results[i] = evaluateWith(value);
+                if (cached.size() < maxCachedValues) {
+                    cached.emplace_back(value, results[i]);
+                }
+            }
+        }
+        return true;
+    }
+
+    // Like the expressions, stop at the first child that errors, or that decides the result.
+    // Undecided features are the ones still holding the initial value.
+    const auto undecided = node.kind == Node::Kind::All ? Result::True : Result::False;
+    results.assign(count, undecided);
+    std::vector<Result> childResults;
+    for (const auto& child : node.children) {
+        if (!evaluate(child, layer, zoom, canonical, childResults)) {
+            return false;
+        }
+        for (std::size_t i = 0; i < count; ++i) {
+            if (results[i] == undecided) {
+                results[i] = childResults[i];
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace style
+} // namespace mbgl
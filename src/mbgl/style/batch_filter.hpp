@@ -0,0 +1,81 @@
+#pragma once
+
+#include <mbgl/style/filter.hpp>
+#include <mbgl/util/feature.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace mbgl {
+
+class CanonicalTileID;
+class GeometryTileLayer;
+
+namespace style {
+
+/**
+    A filter compiled for evaluation over all the features of a layer at once, for layers that
+    store their properties by column.
+
+    The filter is split along its `all` and `any` expressions into parts that each read at most
+    one feature property, such as `==`, `in`, `match`, `has` or numeric comparisons of a `get`.
+    Each part is evaluated once per distinct value of its property rather than once per feature,
+    so the result matches evaluating the whole filter feature by feature.
+ */
+class BatchFilter {
+public:
+    /// Returns nothing for filters with a part that depends on more than one property, or on
+    /// anything else about the feature, such as its type, id or geometry.
+    static std::optional<BatchFilter> compile(const Filter&);
+
+    /// The filter compiled once and kept with it, or null if it can't be compiled.
+    static const BatchFilter* get(const Filter&);
+
+    /// Whether each feature of the layer passes the filter, or nothing if the layer doesn't
+    /// provide property columns.
+    std::optional<std::vector<bool>> evaluate(const GeometryTileLayer&, float zoom, const CanonicalTileID&) const;
+
+private:
+    enum class Result : uint8_t {
+        False,
+        True,
+        Error
+    };
+
+    struct Node {
+        enum class Kind : uint8_t {
+            All,
+            Any,
+            Property,
+        } kind = Kind::Property;
+
+        std::vector<Node> children;
+
+        // For properties: the expression, reading at most the single property `key`
+        const expression::Expression* expression = nullptr;
+        std::optional<std::string> key;
+    };
+
+    static std::optional<Node> compile(const expression::Expression&);
+    bool evaluate(const Node&,
+                  const GeometryTileLayer&,
+                  float zoom,
+                  const CanonicalTileID&,
+                  std::vector<Result>& results) const;
+
+    // Keeps the expressions the nodes point into alive
+    std::shared_ptr<const expression::Expression> expression;
+    Node root;
+};
+
+struct Filter::BatchFilterCache {
+    std::once_flag once;
+    std::optional<BatchFilter> compiled;
+};
+
+} // namespace style
+} // namespace mbgl
@@ -7,11 +7,34 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace mbgl {
 namespace style {
 
+/*
+    The changes made to a collection between two versions of its impls, `base`
+   and `target`. Lets the renderer diff the two in the number of changes rather
+   than the size of the collection.
+*/
+template <class Impl>
+class CollectionJournal {
+public:
+    struct Entry {
+        // The impl in `base`, if it was there
+        std::optional<Immutable<Impl>> before;
+        // The impl in `target`, if it's there
+        std::optional<Immutable<Impl>> after;
+        // Removed and added again, possibly at another position
+        bool reinserted = false;
+    };
+
+    Immutable<std::vector<Immutable<Impl>>> base;
+    Immutable<std::vector<Immutable<Impl>>> target;
+    std::unordered_map<std::string, Entry> entries;
+};
+
 /*
     Manages an ordered collection of elements and their `Immutable<Impl>`s. The
    latter is itself stored in an Immutable container. Using immutability at the
@@ -31,6 +54,7 @@ public:
     using Impl = typename T::Impl;
     using WrapperVector = std::vector<std::unique_ptr<T>>;
     using ImmutableVector = Immutable<std::vector<Immutable<Impl>>>;
+    using Journal = CollectionJournal<Impl>;
 
     CollectionBase();
 
@@ -45,6 +69,9 @@ public:
 
     void clear();
 
+    // The changes made since the previous call, or null if they weren't all recorded
+    std::shared_ptr<const Journal> takeJournal();
+
 protected:
     std::size_t index(const std::string&) const;
     T* add(std::size_t wrapperIndex, std::size_t implIndex, std::unique_ptr<T> wrapper);
@@ -56,6 +83,13 @@ protected:
 
     WrapperVector wrappers;
     ImmutableVector impls;
+
+private:
+    void record(const std::string& id, std::optional<Immutable<Impl>> current, std::optional<Immutable<Impl>> after);
+
+    ImmutableVector journalBase;
+    std::unordered_map<std::string, typename Journal::Entry> journalEntries;
+    bool journalComplete = true;
 };
 
 template <class T, bool persistentImplsOrder = false>
@@ -104,7 +138,8 @@ using CollectionWithPersistentOrder = Collection<T, true>;
 
 template <class T>
 CollectionBase<T>::CollectionBase()
-    : impls(makeMutable<std::vector<Immutable<Impl>>>()) {}
+    : impls(makeMutable<std::vector<Immutable<Impl>>>()),
+      journalBase(impls) {}
 
 template <class T>
 std::size_t CollectionBase<T>::size() const {
@@ -140,12 +175,44 @@ void CollectionBase<T>::clear() {
     mutate(impls, [&](auto& impls_) { impls_.clear(); });
 
     wrappers.clear();
+
+    // Not worth recording, the whole collection is replaced
+    journalEntries.clear();
+    journalComplete = false;
+}
+
+template <class T>
+std::shared_ptr<const typename CollectionBase<T>::Journal> CollectionBase<T>::takeJournal() {
+    std::shared_ptr<const Journal> result;
+    if (journalComplete) {
+        result = std::make_shared<const Journal>(Journal{journalBase, impls, std::move(journalEntries)});
+    }
+    journalBase = impls;
+    journalEntries.clear();
+    journalComplete = true;
+    return result;
+}
+
+template <class T>
+void CollectionBase<T>::record(const std::string& id,
+                               std::optional<Immutable<Impl>> current,
+                               std::optional<Immutable<Impl>> after) {
+    auto [it, inserted] = journalEntries.try_emplace(id);
+    auto& entry = it->second;
+    if (inserted) {
+        // First change since the base, so the current impl is the one in it
+        entry.before = std::move(current);
+    } else if (!current && after && entry.before) {
+        entry.reinserted = true;
+    }
+    entry.after = std::move(after);
 }
 
 template <class T>
 T* CollectionBase<T>::add(std::size_t wrapperIndex, std::size_t implIndex, std::unique_ptr<T> wrapper) {
     assert(wrapperIndex <= size());
     assert(implIndex <= size());
+    record(wrapper->getID(), std::nullopt, wrapper->baseImpl);
     mutate(impls, [&](auto& impls_) { impls_.emplace(impls_.begin() + implIndex, wrapper->baseImpl); });
 
     return wrappers.emplace(wrappers.begin() + wrapperIndex, std::move(wrapper))->get();
@@ -160,6 +227,7 @@ std::unique_ptr<T> CollectionBase<T>::remove(std::size_t wrapperIndex, std::size
 
     auto source = std::move(wrappers[wrapperIndex]);
 
+    record(source->getID(), impls->at(implIndex), std::nullopt);
     mutate(impls, [&](auto& impls_) { impls_.erase(impls_.begin() + implIndex); });
 
     wrappers.erase(wrappers.begin() + wrapperIndex);
@@ -173,6 +241,7 @@ void CollectionBase<T>::update(std::size_t implIndex, const T& wrapper) {
         assert(false);
         return;
     }
+    record(wrapper.getID(), impls->at(implIndex), wrapper.baseImpl);
     mutate(impls, [&](auto& impls_) { impls_.at(implIndex) = wrapper.baseImpl; });
 }
 
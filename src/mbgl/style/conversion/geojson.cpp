@@ -1,17 +1,177 @@
 #include <mbgl/style/conversion/geojson.hpp>
 #include <mbgl/style/conversion/json.hpp>
 #include <mbgl/style/conversion_impl.hpp>
+#include <mbgl/util/string.hpp>
+
+#include <string_view>
+#include <vector>
 
 namespace mbgl {
 namespace style {
 namespace conversion {
 
+namespace {
+
+// Builds JSON values out of SAX events the way a document does, except for the elements of the
+// `features` array of a FeatureCollection: these are converted as soon as they're complete, so
+// that only one feature at a time exists as JSON.
+class StreamingGeoJSONHandler {
+public:
+    StreamingGeoJSONHandler(const rapidjson::StringStream& stream_,
+                            std::size_t chunkSize_,
+                            const GeoJSONFeaturesCallback& onFeatures_)
+        : stream(stream_),
+          chunkSize(chunkSize_),
+          onFeatures(onFeatures_) {}
+
+    bool Null() { return add(JSValue()); }
+    bool Bool(bool value) { return add(JSValue(value)); }
+    bool Int(int value) { return add(JSValue(value)); }
+    bool Uint(unsigned value) { return add(JSValue(value)); }
+    bool Int64(int64_t value) { return add(JSValue(value)); }
+    bool Uint64(uint64_t value) { return add(JSValue(value)); }
+    bool Double(double value) { return add(JSValue(value)); }
+    // Only produced with kParseNumbersAsStringsFlag
+    bool RawNumber(const char*, rapidjson::SizeType, bool) { return false; }
+
+    bool String(const char* value, rapidjson::SizeType length, bool) {
+        if (levels.size() == 1 && isKey("type") && std::string_view(value, length) == "FeatureCollection") {
+            isFeatureCollection = true;
+        }
+        return add(JSValue(value, length, allocator));
+    }
+
+    bool StartObject() {
+        levels.emplace_back(rapidjson::kObjectType);
+        return true;
+    }
+
+    bool Key(const char* key, rapidjson::SizeType length, bool) {
+        levels.back().key.SetString(key, length, allocator);
+        return true;
+    }
+
+    bool EndObject(rapidjson::SizeType) { return end(); }
+
+    bool StartArray() {
+        if (levels.size() == 1 && isFeatureCollection && isKey("features")) {
+            inFeatures = true;
+        }
+        levels.emplace_back(rapidjson::kArrayType);
+        return true;
+    }
+
+    bool EndArray(rapidjson::SizeType) {
+        if (inFeatures && levels.size() == 2) {
+            inFeatures = false;
+            flush();
+        }
+        return end();
+    }
+
+    JSValue root;
+    std::optional<std::string> error;
+
+private:
+    struct Level {
+        explicit Level(rapidjson::Type type)
+            : value(type) {}
+        JSValue value;
+        JSValue key;
+    };
+
+    bool isKey(std::string_view name) const {
+        const auto& key = levels.back().key;
+        return key.IsString() && std::string_view(key.GetString(), key.GetStringLength()) == name;
+    }
+
+    bool end() {
+        JSValue value(std::move(levels.back().value));
+        levels.pop_back();
+        return add(std::move(value));
+    }
+
+    bool add(JSValue&& value) {
+        if (levels.empty()) {
+            root = std::move(value);
+            return true;
+        }
+        if (inFeatures && levels.size() == 2) {
+            return addFeature(value);
+        }
+
+        auto& parent = levels.back();
+        if (parent.value.IsArray()) {
+            parent.value.PushBack(value, allocator);
+        } else {
+            parent.value.AddMember(parent.key, value, allocator);
+        }
+        return true;
+    }
+
+    bool addFeature(const JSValue& value) {
+        try {
+            chunk.push_back(mapbox::geojson::convert<mapbox::geojson::feature>(value));
+        } catch (const std::exception& ex) {
+            error = ex.what();
+            return false;
+        }
+        if (chunk.size() >= chunkSize) {
+            flush();
+        }
+        return true;
+    }
+
+    void flush() {
+        if (!chunk.empty()) {
+            mapbox::geojson::feature_collection features;
+            features.reserve(chunkSize);
+            std::swap(features, chunk);
+            onFeatures(std::move(features), stream.Tell());
+        }
+    }
+
+    const rapidjson::StringStream& stream;
+    const std::size_t chunkSize;
+    const GeoJSONFeaturesCallback& onFeatures;
+    rapidjson::CrtAllocator allocator;
+    std::vector<Level> levels;
+    mapbox::geojson::feature_collection chunk;
+    bool isFeatureCollection = false;
+    bool inFeatures = false;
+};
+
+} // namespace
+
 std::optional<GeoJSON> Converter<GeoJSON>::operator()(const Convertible& value, Error& error) const {
     return toGeoJSON(value, error);
 }
 
 std::optional<GeoJSON> parseGeoJSON(const std::string& value, Error& error) {
-    return convertJSON<GeoJSON>(value, error);
+    // mapbox::geojson reads rapidjson values, whichever backend convertJSON uses
+    return convertRapidJSON<GeoJSON>(value, error);
+}
+
+std::optional<GeoJSON> parseGeoJSON(const std::string& value,
+                                    std::size_t chunkSize,
+                                    const GeoJSONFeaturesCallback& onFeatures,
+                                    Error& error) {
+    rapidjson::StringStream stream(value.c_str());
+    StreamingGeoJSONHandler handler(stream, chunkSize, onFeatures);
+    rapidjson::Reader reader;
+    reader.Parse<0>(stream, handler);
+
+    if (handler.error) {
+        error = {*handler.error};
+        return {};
+    }
+    if (reader.HasParseError()) {
+        error = {std::string{rapidjson::GetParseError_En(reader.GetParseErrorCode())} + " at offset " +
+                 util::toString(reader.GetErrorOffset())};
+        return {};
+    }
+
+    return convert<GeoJSON>(handler.root, error);
 }
 
 } // namespace conversion
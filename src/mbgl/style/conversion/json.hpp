@@ -3,6 +3,10 @@
 #include <mbgl/style/conversion_impl.hpp>
 #include <mbgl/style/rapidjson_conversion.hpp>
 
+#if MLN_WITH_SIMDJSON
+#include <mbgl/style/simdjson_conversion.hpp>
+#endif
+
 #include <string>
 
 namespace mbgl {
@@ -10,7 +14,7 @@ namespace style {
 namespace conversion {
 
 template <class T, class... Args>
-std::optional<T> convertJSON(const std::string& json, Error& error, Args&&... args) {
+std::optional<T> convertRapidJSON(const std::string& json, Error& error, Args&&... args) {
     JSDocument document;
     document.Parse<0>(json.c_str());
 
@@ -22,6 +26,31 @@ std::optional<T> convertJSON(const std::string& json, Error& error, Args&&... ar
     return convert<T>(document, error, std::forward<Args>(args)...);
 }
 
+#if MLN_WITH_SIMDJSON
+template <class T, class... Args>
+std::optional<T> convertSimdJSON(const std::string& json, Error& error, Args&&... args) {
+    // A parser per call: the elements converted refer to its document, and conversions may parse JSON themselves
+    simdjson::dom::parser parser;
+    simdjson::dom::element root;
+    if (const auto result = parser.parse(json).get(root); result != simdjson::SUCCESS) {
+        error = {simdjson::error_message(result)};
+        return {};
+    }
+
+    return convert<T>(Convertible(root), error, std::forward<Args>(args)...);
+}
+#endif
+
+/// Parses JSON and converts it, with simdjson when built with MLN_WITH_SIMDJSON and rapidjson otherwise
+template <class T, class... Args>
+std::optional<T> convertJSON(const std::string& json, Error& error, Args&&... args) {
+#if MLN_WITH_SIMDJSON
+    return convertSimdJSON<T>(json, error, std::forward<Args>(args)...);
+#else
+    return convertRapidJSON<T>(json, error, std::forward<Args>(args)...);
+#endif
+}
+
 } // namespace conversion
 } // namespace style
 } // namespace mbgl
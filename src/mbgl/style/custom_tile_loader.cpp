@@ -1,11 +1,15 @@
 #include <mbgl/style/custom_tile_loader.hpp>
+#include <mbgl/actor/scheduler.hpp>
 #include <mbgl/tile/custom_geometry_tile.hpp>
 #include <mbgl/util/tile_range.hpp>
 
 namespace mbgl {
 namespace style {
 
-CustomTileLoader::CustomTileLoader(const TileFunction& fetchTileFn, const TileFunction& cancelTileFn) {
+CustomTileLoader::CustomTileLoader(const TileFunction& fetchTileFn,
+                                   const TileFunction& cancelTileFn,
+                                   std::shared_ptr<Scheduler> fetchScheduler_)
+    : fetchScheduler(std::move(fetchScheduler_)) {
     fetchTileFunction = fetchTileFn;
     cancelTileFunction = cancelTileFn;
 }
@@ -14,7 +18,7 @@ void CustomTileLoader::fetchTile(const OverscaledTileID& tileID, const ActorRef<
     std::scoped_lock guard(dataMutex);
     auto cachedTileData = dataCache.find(tileID.canonical);
     if (cachedTileData != dataCache.end()) {
-        tileRef.invoke(&CustomGeometryTile::setTileData, *(cachedTileData->second));
+        sendData(tileRef, cachedTileData->second);
     }
     auto tileCallbacks = tileCallbackMap.find(tileID.canonical);
     if (tileCallbacks == tileCallbackMap.end()) {
@@ -60,14 +64,39 @@ void CustomTileLoader::removeTile(const OverscaledTileID& tileID) {
 
 void CustomTileLoader::setTileData(const CanonicalTileID& tileID, const GeoJSON& data) {
     std::scoped_lock guard(dataMutex);
+    setData(tileID, [&] { return std::make_shared<const GeoJSON>(data); });
+}
+
+void CustomTileLoader::setTilesData(const std::vector<std::pair<CanonicalTileID, GeoJSON>>& data) {
+    std::scoped_lock guard(dataMutex);
+    for (const auto& [tileID, geoJSON] : data) {
+        setData(tileID, [&] { return std::make_shared<const GeoJSON>(geoJSON); });
+    }
+}
+
+void CustomTileLoader::setTileFeatures(const CanonicalTileID& tileID,
+                                       std::shared_ptr<const CustomGeometrySource::TileFeatures> features) {
+    std::scoped_lock guard(dataMutex);
+    setData(tileID, [&] { return std::move(features); });
+}
+
+void CustomTileLoader::setData(const CanonicalTileID& tileID, const std::function<TileData()>& makeData) {
     auto iter = tileCallbackMap.find(tileID);
     if (iter == tileCallbackMap.end()) return;
-    auto dataPtr = std::make_unique<mapbox::geojson::geojson>(data);
-    for (auto tuple : iter->second) {
-        auto actor = std::get<2>(tuple);
-        actor.invoke(&CustomGeometryTile::setTileData, *dataPtr);
+    auto data = makeData();
+    for (const auto& tuple : iter->second) {
+        sendData(std::get<2>(tuple), data);
+    }
+    dataCache[tileID] = std::move(data);
+}
+
+void CustomTileLoader::sendData(const ActorRef<CustomGeometryTile>& tileRef, const TileData& data) {
+    if (const auto* geoJSON = std::get_if<std::shared_ptr<const GeoJSON>>(&data)) {
+        tileRef.invoke(&CustomGeometryTile::setTileData, **geoJSON);
+    } else {
+        tileRef.invoke(&CustomGeometryTile::setTileFeatures,
+                       std::get<std::shared_ptr<const CustomGeometrySource::TileFeatures>>(data));
     }
-    dataCache[tileID] = std::move(dataPtr);
 }
 
 void CustomTileLoader::invalidateTile(const CanonicalTileID& tileID) {
@@ -108,13 +137,21 @@ void CustomTileLoader::invalidateRegion(const LatLngBounds& bounds, Range<uint8_
 
 void CustomTileLoader::invokeTileFetch(const CanonicalTileID& tileID) {
     if (fetchTileFunction != nullptr) {
-        fetchTileFunction(tileID);
+        if (fetchScheduler) {
+            fetchScheduler->schedule([fn = fetchTileFunction, tileID] { fn(tileID); });
+        } else {
+            fetchTileFunction(tileID);
+        }
     }
 }
 
 void CustomTileLoader::invokeTileCancel(const CanonicalTileID& tileID) {
     if (cancelTileFunction != nullptr) {
-        cancelTileFunction(tileID);
+        if (fetchScheduler) {
+            fetchScheduler->schedule([fn = cancelTileFunction, tileID] { fn(tileID); });
+        } else {
+            cancelTileFunction(tileID);
+        }
     }
 }
 
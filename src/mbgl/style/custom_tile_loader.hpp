@@ -6,11 +6,16 @@
 #include <mbgl/util/geojson.hpp>
 
 #include <map>
+#include <memory>
 #include <mutex>
+#include <utility>
+#include <variant>
+#include <vector>
 
 namespace mbgl {
 
 class CustomGeometryTile;
+class Scheduler;
 
 namespace style {
 
@@ -21,26 +26,40 @@ public:
 
     using OverscaledIDFunctionTuple = std::tuple<uint8_t, int16_t, ActorRef<CustomGeometryTile>>;
 
-    CustomTileLoader(const TileFunction& fetchTileFn, const TileFunction& cancelTileFn);
+    /// With a scheduler, the fetch and cancel functions are called on it rather than on the loader's thread
+    CustomTileLoader(const TileFunction& fetchTileFn,
+                     const TileFunction& cancelTileFn,
+                     std::shared_ptr<Scheduler> fetchScheduler = nullptr);
 
     void fetchTile(const OverscaledTileID& tileID, const ActorRef<CustomGeometryTile>& tileRef);
     void cancelTile(const OverscaledTileID& tileID);
 
     void removeTile(const OverscaledTileID& tileID);
     void setTileData(const CanonicalTileID& tileID, const GeoJSON& data);
+    void setTilesData(const std::vector<std::pair<CanonicalTileID, GeoJSON>>& data);
+    void setTileFeatures(const CanonicalTileID& tileID,
+                         std::shared_ptr<const CustomGeometrySource::TileFeatures> features);
 
     void invalidateTile(const CanonicalTileID&);
     void invalidateRegion(const LatLngBounds&, Range<uint8_t>);
 
 private:
+    // GeoJSON to convert, or features ready to render
+    using TileData = std::variant<std::shared_ptr<const GeoJSON>,
+                                  std::shared_ptr<const CustomGeometrySource::TileFeatures>>;
+
+    void setData(const CanonicalTileID& tileID, const std::function<TileData()>& makeData);
+    static void sendData(const ActorRef<CustomGeometryTile>&, const TileData&);
+
     void invokeTileFetch(const CanonicalTileID& tileID);
     void invokeTileCancel(const CanonicalTileID& tileID);
 
     TileFunction fetchTileFunction;
     TileFunction cancelTileFunction;
+    std::shared_ptr<Scheduler> fetchScheduler;
     std::unordered_map<CanonicalTileID, std::vector<OverscaledIDFunctionTuple>> tileCallbackMap;
     // Keep around a cache of tile data to serve back for wrapped and over-zooomed tiles
-    std::map<CanonicalTileID, std::unique_ptr<GeoJSON>> dataCache;
+    std::map<CanonicalTileID, TileData> dataCache;
     std::mutex dataMutex;
 };
 
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <mbgl/util/immutable.hpp>
+
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace mbgl {
+namespace style {
+
+/**
+    Layout properties of a layer evaluated at a zoom level, shared by all the tiles laid out at
+    that zoom, with one entry per zoom level seen.
+
+    Evaluation only depends on the layer's unevaluated layout properties and the zoom, so a layer
+    impl keeps the results for as long as it lives. Copies start out empty, since an impl is only
+    copied in order to be changed.
+ */
+template <class PossiblyEvaluated>
+class EvaluatedLayoutCache {
+public:
+    EvaluatedLayoutCache() = default;
+    EvaluatedLayoutCache(const EvaluatedLayoutCache&) noexcept {}
+    EvaluatedLayoutCache& operator=(const EvaluatedLayoutCache&) noexcept {
+        std::lock_guard<std::mutex> lock(mutex);
+        entries.clear();
+        return *this;
+    }
+
+    /// Returns the properties evaluated at `zoom`, calling `evaluate()` to produce them if they
+    /// aren't cached yet. Concurrent callers may both evaluate; the first result stored wins.
+    template <typename Fn>
+    Immutable<PossiblyEvaluated> get(float zoom, Fn&& evaluate) const {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (const auto* entry = find(zoom)) {
+                return *entry;
+            }
+        }
+
+        Immutable<PossiblyEvaluated> evaluated = evaluate();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (const auto* entry = find(zoom)) {
+            return *entry;
+        }
+        entries.emplace_back(zoom, evaluated);
+        return evaluated;
+    }
+
+private:
+    const Immutable<PossiblyEvaluated>* find(float zoom) const {
+        for (const auto& entry : entries) {
+            if (entry.first == zoom) {
+                return &entry.second;
+            }
+        }
+        return nullptr;
+    }
+
+    mutable std::mutex mutex;
+    mutable std::vector<std::pair<float, Immutable<PossiblyEvaluated>>> entries;
+};
+
+} // namespace style
+} // namespace mbgl
@@ -0,0 +1,436 @@
+#include <mbgl/style/expression/bytecode.hpp>
+
+#include <mbgl/style/expression/assertion.hpp>
+#include <mbgl/style/expression/compound_expression.hpp>
+#include <mbgl/style/expression/interpolate.hpp>
+#include <mbgl/style/expression/literal.hpp>
+#include <mbgl/style/expression/step.hpp>
+#include <mbgl/tile/geometry_tile_data.hpp>
+#include <mbgl/util/interpolate.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+namespace mbgl {
+namespace style {
+namespace expression {
+
+namespace {
+
+std::vector<const Expression*> childrenOf(const Expression& expression) {
+    std::vector<const Expression*> children;
+    expression.eachChild([&](const Expression& child) { children.push_back(&child); });
+    return children;
+}
+
+} // namespace
+
+struct Bytecode::Registers {
+    std::array<double, maxRegisters> numbers{};
+    std::array<Color, maxColorRegisters> colors;
+};
+
+class BytecodeCompiler {
+public:
+    using Op = Bytecode::Op;
+    using Register = std::optional<uint8_t>;
+
+    explicit BytecodeCompiler(Bytecode& bytecode_)
+        : bytecode(bytecode_) {}
+
+    Register number(const Expression& expression) {
+        if (!expression.getType().is<type::NumberType>()) {
+            return {};
+        }
+
+        switch (expression.getKind()) {
+            case Kind::Literal: {
+                const auto& value = static_cast<const Literal&>(expression).getValue();
+                return value.is<double>() ? constant(value.get<double>()) : Register{};
+            }
+            case Kind::Assertion:
+                return get(expression);
+            case Kind::CompoundExpression:
+                return compound(expression);
+            case Kind::Interpolate:
+            case Kind::Step:
+                return curve(expression, false);
+            default:
+                return {};
+        }
+    }
+
+    Register color(const Expression& expression) {
+        if (!expression.getType().is<type::ColorType>()) {
+            return {};
+        }
+
+        switch (expression.getKind()) {
+            case Kind::Literal: {
+                const auto& value = static_cast<const Literal&>(expression).getValue();
+                if (!value.is<Color>()) {
+                    return {};
+                }
+                const auto dst = allocate(true);
+                if (dst) {
+                    bytecode.code.push_back({Op::ColorConstant, *dst, 0, 0, index(bytecode.colors)});
+                    bytecode.colors.push_back(value.get<Color>());
+                }
+                return dst;
+            }
+            case Kind::Interpolate:
+            case Kind::Step:
+                return curve(expression, true);
+            default:
+                return {};
+        }
+    }
+
+private:
+    template <typename T>
+    static uint32_t index(const std::vector<T>& v) {
+        return static_cast<uint32_t>(v.size());
+    }
+
+    Register allocate(bool isColor) {
+        auto& count = isColor ? colorCount : numberCount;
+        if (count == (isColor ? Bytecode::maxColorRegisters : Bytecode::maxRegisters)) {
+            return {};
+        }
+        return static_cast<uint8_t>(count++);
+    }
+
+    Register emit(Op op, Register a = uint8_t(0), Register b = uint8_t(0), uint32_t index_ = 0) {
+        if (!a || !b) {
+            return {};
+        }
+        const auto dst = allocate(false);
+        if (dst) {
+            bytecode.code.push_back({op, *dst, *a, *b, index_});
+        }
+        return dst;
+    }
+
+    Register constant(double value) {
+        const auto i = index(bytecode.constants);
+        bytecode.constants.push_back(value);
+        return emit(Op::Constant, uint8_t(0), uint8_t(0), i);
+    }
+
+    // `["number", ["get", key]]`, which is how a number property read looks once parsed
+    Register get(const Expression& assertion) {
+        const auto inputs = childrenOf(assertion);
+        if (inputs.size() != 1 || inputs[0]->getKind() != Kind::CompoundExpression ||
+            inputs[0]->getOperator() != "get") {
+            return {};
+        }
+        const auto args = childrenOf(*inputs[0]);
+        if (args.size() != 1 || args[0]->getKind() != Kind::Literal) {
+            return {};
+        }
+        const auto& key = static_cast<const Literal&>(*args[0]).getValue();
+        if (!key.is<std::string>()) {
+            return {};
+        }
+        const auto i = index(bytecode.keys);
+        bytecode.keys.push_back(key.get<std::string>());
+        return emit(Op::Get, uint8_t(0), uint8_t(0), i);
+    }
+
+    // Folds the arguments left to right from `identity`, the same way the variadic
+    // implementations do, so that NaN and signed zero come out identically.
+    Register fold(Op op, double identity, const std::vector<const Expression*>& args) {
+        Register accumulator = constant(identity);
+        for (const auto* arg : args) {
+            accumulator = emit(op, accumulator, number(*arg));
+        }
+        return accumulator;
+    }
+
+    Register compound(const Expression& expression) {
+        const auto op = expression.getOperator();
+        const auto args = childrenOf(expression);
+
+        if (args.empty()) {
+            return op == "zoom" ? emit(Op::Zoom) : Register{};
+        }
+        if (op == "+") return fold(Op::Add, 0.0, args);
+        if (op == "*") return fold(Op::Multiply, 1.0, args);
+        if (op == "min") return fold(Op::Min, std::numeric_limits<double>::infinity(), args);
+        if (op == "max") return fold(Op::Max, -std::numeric_limits<double>::infinity(), args);
+
+        if (args.size() == 1) {
+            const auto unary = [&](Op code) { return emit(code, number(*args[0])); };
+            if (op == "-") return unary(Op::Negate);
+            if (op == "abs") return unary(Op::Abs);
+            if (op == "floor") return unary(Op::Floor);
+            if (op == "ceil") return unary(Op::Ceil);
+            if (op == "round") return unary(Op::Round);
+            if (op == "sqrt") return unary(Op::Sqrt);
+            return {};
+        }
+
+        if (args.size() == 2) {
+            const auto binary = [&](Op code) {
+                const auto a = number(*args[0]);
+                return emit(code, a, number(*args[1]));
+            };
+            if (op == "-") return binary(Op::Subtract);
+            if (op == "/") return binary(Op::Divide);
+            if (op == "%") return binary(Op::Modulo);
+            if (op == "^") return binary(Op::Power);
+        }
+        return {};
+    }
+
+    Register curve(const Expression& expression, bool isColor) {
+        const Expression* input = nullptr;
+        std::vector<std::pair<double, const Expression*>> stops;
+        const auto collect = [&](double stop, const Expression& output) { stops.emplace_back(stop, &output); };
+
+        const Interpolate* interpolate = nullptr;
+        if (expression.getKind() == Kind::Interpolate) {
+            interpolate = static_cast<const Interpolate*>(&expression);
+            input = interpolate->getInput().get();
+            interpolate->eachStop(collect);
+        } else {
+            const auto& step = static_cast<const Step&>(expression);
+            input = step.getInput().get();
+            step.eachStop(collect);
+        }
+
+        const auto inputRegister = number(*input);
+        const auto dst = allocate(isColor);
+        if (!inputRegister || !dst || stops.empty()) {
+            return {};
+        }
+
+        const auto curveIndex = index(bytecode.curves);
+        bytecode.curves.emplace_back();
+        bytecode.curves.back().interpolate = interpolate;
+        bytecode.code.push_back({isColor ? Op::ColorCurve : Op::Curve, *dst, *inputRegister, 0, curveIndex});
+
+        for (const auto& [stop, output] : stops) {
+            const auto begin = index(bytecode.code);
+            const auto outputRegister = isColor ? color(*output) : number(*output);
+            if (!outputRegister) {
+                return {};
+            }
+            // Compiling the outputs may have added curves, don't hold on to a reference
+            auto& compiled = bytecode.curves[curveIndex];
+            compiled.inputs.push_back(stop);
+            compiled.blocks.push_back({begin, index(bytecode.code), *outputRegister});
+        }
+        bytecode.curves[curveIndex].end = index(bytecode.code);
+        return dst;
+    }
+
+    Bytecode& bytecode;
+    std::size_t numberCount = 0;
+    std::size_t colorCount = 0;
+};
+
+std::unique_ptr<Bytecode> Bytecode::compile(const Expression& expression) {
+    auto bytecode = std::make_unique<Bytecode>();
+    BytecodeCompiler compiler(*bytecode);
+
+    std::optional<uint8_t> result;
+    if (expression.getType().is<type::ColorType>()) {
+        bytecode->color = true;
+        result = compiler.color(expression);
+    } else {
+        result = compiler.number(expression);
+    }
+
+    if (!result) {
+        return {};
+    }
+    bytecode->result = *result;
+    return bytecode;
+}
+
+std::optional<double> Bytecode::evaluateNumber(const EvaluationContext& params) const {
+    assert(!color);
+    Registers registers;
+    if (!run(0, static_cast<uint32_t>(code.size()), params, registers)) {
+        return {};
+    }
+    return registers.numbers[result];
+}
+
+std::optional<Color> Bytecode::evaluateColor(const EvaluationContext& params) const {
+    assert(color);
+    Registers registers;
+    if (!run(0, static_cast<uint32_t>(code.size()), params, registers)) {
+        return {};
+    }
+    return registers.colors[result];
+}
+
+bool Bytecode::run(uint32_t begin, uint32_t end, const EvaluationContext& params, Registers& registers) const {
+    auto& n = registers.numbers;
+    for (uint32_t pc = begin; pc < end; ++pc) {
+        const Instruction& instruction = code[pc];
+        const double a = n[instruction.a];
+        const double b = n[instruction.b];
+        double& dst = n[instruction.dst];
+
+        switch (instruction.op) {
+            case Op::Constant:
+                dst = constants[instruction.index];
+                break;
+            case Op::Zoom:
+                if (!params.zoom) {
+                    return false;
+                }
+                dst = *params.zoom;
+                break;
+            case Op::Get: {
+                if (!params.feature) {
+                    return false;
+                }
+                const auto value = params.feature->getValue(keys[instruction.index]);
+                if (!value) {
+                    return false;
+                }
+                if (value->is<double>()) {
+                    dst = value->get<double>();
+                } else if (value->is<int64_t>()) {
+                    dst = static_cast<double>(value->get<int64_t>());
+                } else if (value->is<uint64_t>()) {
+                    dst = static_cast<double>(value->get<uint64_t>());
+                } else {
+                    return false;
+                }
+                break;
+            }
+            case Op::Add:
+                dst = a + b;
+                break;
+            case Op::Subtract:
+                dst = a - b;
+                break;
+            case Op::Multiply:
+                dst = a * b;
+                break;
+            case Op::Divide:
+                if (b == 0 && a == 0) {
+                    dst = std::numeric_limits<double>::quiet_NaN();
+                } else if (b == 0 && a > 0) {
+                    dst = std::numeric_limits<double>::infinity();
+                } else if (b == 0 && a < 0) {
+                    dst = -std::numeric_limits<double>::infinity();
+                } else {
+                    dst = a / b;
+                }
+                break;
+            case Op::Modulo:
+                dst = std::fmod(a, b);
+                break;
+            case Op::Power:
+                dst = std::pow(a, b);
+                break;
+            case Op::Min:
+                dst = std::fmin(b, a);
+                break;
+            case Op::Max:
+                dst = std::fmax(b, a);
+                break;
+            case Op::Negate:
+                dst = -a;
+                break;
+            case Op::Abs:
+                dst = std::abs(a);
+                break;
+            case Op::Floor:
+                dst = std::floor(a);
+                break;
+            case Op::Ceil:
+                dst = std::ceil(a);
+                break;
+            case Op::Round:
+                dst = std::round(a);
+                break;
+            case Op::Sqrt:
+                dst = std::sqrt(a);
+                break;
+            case Op::Curve:
+            case Op::ColorCurve:
+                if (!runCurve(instruction, params, registers)) {
+                    return false;
+                }
+                // Skip over the stop outputs, runCurve has evaluated the ones it needed
+                pc = curves[instruction.index].end - 1;
+                break;
+            case Op::ColorConstant:
+                registers.colors[instruction.dst] = colors[instruction.index];
+                break;
+        }
+    }
+    return true;
+}
+
+bool Bytecode::runCurve(const Instruction& instruction, const EvaluationContext& params, Registers& registers) const {
+    const Curve& curve = curves[instruction.index];
+    const bool isColor = instruction.op == Op::ColorCurve;
+
+    // Same narrowing and lookup as Interpolate/Step::evaluate
+    const auto x = static_cast<float>(registers.numbers[instruction.a]);
+    if (std::isnan(x)) {
+        return false;
+    }
+
+    const auto runBlock = [&](std::size_t i) {
+        return run(curve.blocks[i].begin, curve.blocks[i].end, params, registers);
+    };
+    const auto select = [&](std::size_t i) {
+        if (!runBlock(i)) {
+            return false;
+        }
+        const auto output = curve.blocks[i].result;
+        if (isColor) {
+            registers.colors[instruction.dst] = registers.colors[output];
+        } else {
+            registers.numbers[instruction.dst] = registers.numbers[output];
+        }
+        return true;
+    };
+
+    const auto count = curve.inputs.size();
+    const auto upper = static_cast<std::size_t>(std::upper_bound(curve.inputs.begin(), curve.inputs.end(), x) -
+                                                curve.inputs.begin());
+    if (upper == count) {
+        return select(count - 1);
+    } else if (upper == 0) {
+        return select(0);
+    } else if (!curve.interpolate) {
+        return select(upper - 1);
+    }
+
+    const double t = curve.interpolate->interpolationFactor({curve.inputs[upper - 1], curve.inputs[upper]}, x);
+    if (t == 0.0) {
+        return select(upper - 1);
+    }
+    if (t == 1.0) {
+        return select(upper);
+    }
+
+    if (!runBlock(upper - 1) || !runBlock(upper)) {
+        return false;
+    }
+    const auto lower = curve.blocks[upper - 1].result;
+    const auto higher = curve.blocks[upper].result;
+    if (isColor) {
+        registers.colors[instruction.dst] = util::interpolate(registers.colors[lower], registers.colors[higher], t);
+    } else {
+        registers.numbers[instruction.dst] = util::interpolate(registers.numbers[lower], registers.numbers[higher], t);
+    }
+    return true;
+}
+
+} // namespace expression
+} // namespace style
+} // namespace mbgl
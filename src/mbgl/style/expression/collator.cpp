@@ -1,11 +1,44 @@
 #include <mbgl/style/expression/collator.hpp>
 
+#include <unordered_map>
+
 namespace mbgl {
 namespace style {
 namespace expression {
 
+namespace {
+
+// Collator expressions name a handful of distinct locales at most
+constexpr std::size_t maxCachedCollators = 32;
+
+/// Platform collators are immutable handles, and some platforms load locale data to create one, so the collators
+/// a thread evaluates are kept by their options rather than created for every feature.
+platform::Collator cachedCollator(bool caseSensitive,
+                                  bool diacriticSensitive,
+                                  const std::optional<std::string>& locale) {
+    thread_local std::unordered_map<std::string, platform::Collator> collators;
+    std::string key{static_cast<char>(caseSensitive), static_cast<char>(diacriticSensitive)};
+    if (locale) {
+        key += *locale;
+    } else {
+        // Without a locale the platform default applies, unlike with an empty one
+        key += '\0';
+    }
+
+    auto it = collators.find(key);
+    if (it == collators.end()) {
+        if (collators.size() >= maxCachedCollators) {
+            collators.clear();
+        }
+        it = collators.emplace(std::move(key), platform::Collator(caseSensitive, diacriticSensitive, locale)).first;
+    }
+    return it->second;
+}
+
+} // namespace
+
 Collator::Collator(bool caseSensitive, bool diacriticSensitive, const std::optional<std::string>& locale)
-    : collator(platform::Collator(caseSensitive, diacriticSensitive, locale)) {}
+    : collator(cachedCollator(caseSensitive, diacriticSensitive, locale)) {}
 
 bool Collator::operator==(const Collator& other) const {
     return collator == other.collator;
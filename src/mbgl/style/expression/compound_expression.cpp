@@ -2,6 +2,7 @@
 #include <mbgl/style/expression/collator.hpp>
 #include <mbgl/style/expression/compound_expression.hpp>
 #include <mbgl/style/expression/check_subtype.hpp>
+#include <mbgl/style/expression/literal.hpp>
 #include <mbgl/style/expression/util.hpp>
 #include <mbgl/style/conversion_impl.hpp>
 #include <mbgl/tile/geometry_tile_data.hpp>
@@ -1146,6 +1147,46 @@ std::string expectedTypesError(const Definitions& definitions, const std::vector
     return "Expected arguments of type " + signatures + ", but found (" + actualTypes + ") instead.";
 }
 
+// `["get", key]` with a literal key, by far the most common way of reading a feature property.
+// It reads the property directly, without evaluating the key and converting it to a string on
+// every call; everything else, including how it compares and serializes, is the generic "get".
+class GetPropertyExpression final : public CompoundExpression {
+public:
+    GetPropertyExpression(const detail::SignatureBase& signature_,
+                          std::vector<std::unique_ptr<Expression>> args_,
+                          std::string key_)
+        : CompoundExpression(signature_, std::move(args_)),
+          key(std::move(key_)) {}
+
+    EvaluationResult evaluate(const EvaluationContext& params) const override {
+        if (!params.feature) {
+            return EvaluationError{"Feature data is unavailable in the current evaluation context."};
+        }
+
+        auto propertyValue = params.feature->getValue(key);
+        if (!propertyValue) {
+            return Null;
+        }
+        return Value(toExpressionValue(*propertyValue));
+    }
+
+private:
+    const std::string key;
+};
+
+std::unique_ptr<Expression> specializeCompoundExpression(const detail::SignatureBase& signature,
+                                                         std::vector<std::unique_ptr<Expression>> args) {
+    if (&signature == getContextCompoundExpression().get() && args.size() == 1 &&
+        args[0]->getKind() == Kind::Literal) {
+        const auto& key = static_cast<const Literal&>(*args[0]).getValue();
+        if (key.is<std::string>()) {
+            auto keyString = key.get<std::string>();
+            return std::make_unique<GetPropertyExpression>(signature, std::move(args), std::move(keyString));
+        }
+    }
+    return std::make_unique<CompoundExpression>(signature, std::move(args));
+}
+
 ParseResult createCompoundExpression(const Definitions& definitions,
                                      std::vector<std::unique_ptr<Expression>> args,
                                      ParsingContext& ctx) {
@@ -1182,7 +1223,7 @@ ParseResult createCompoundExpression(const Definitions& definitions,
         }
 
         if (signatureContext.getErrors().empty()) {
-            return ParseResult(std::make_unique<CompoundExpression>(*signature, std::move(args)));
+            return ParseResult(specializeCompoundExpression(*signature, std::move(args)));
         }
     }
 
@@ -29,6 +29,8 @@ constexpr mapbox::cheap_ruler::CheapRuler::Unit UnitInMeters = mapbox::cheap_rul
 // Inclusive index range for multipoint or linestring container
 using IndexRange = std::pair<std::size_t, std::size_t>;
 
+using PolygonIndex = PolygonEdgeIndex<double>;
+
 inline std::size_t getRangeSize(const IndexRange& range) noexcept {
     return range.second - range.first + 1;
 }
@@ -89,16 +91,6 @@ DistanceBBox getBBox(const mapbox::geometry::line_string<double>& line, const In
     return bbox;
 }
 
-DistanceBBox getBBox(const mapbox::geometry::polygon<double>& polygon) noexcept {
-    DistanceBBox bbox = DefaultDistanceBBox;
-    for (const auto& ring : polygon) {
-        for (const auto& p : ring) {
-            updateBBox(bbox, p);
-        }
-    }
-    return bbox;
-}
-
 bool isMultiPointValid(const mapbox::geometry::multi_point<double>& points) noexcept {
     if (points.empty()) {
         mbgl::Log::Error(mbgl::Event::Style, "Invalid MultiPoint with empty geometry points");
@@ -229,10 +221,38 @@ double pointsToPointsDistance(const mapbox::geometry::multi_point<double>& point
     return dist;
 }
 
+// Distance to the nearest edge of the index, visiting its bands outwards from the one of the point. The
+// edges of a band n bands away are at least n - 1 band heights away in latitude, which bounds the search.
+double pointToEdgesDistance(const mapbox::geometry::point<double>& point,
+                            const PolygonIndex& index,
+                            const mapbox::cheap_ruler::CheapRuler& ruler,
+                            double dist) noexcept {
+    const auto bandCount = index.getBandCount();
+    const auto bandHeight = index.getBandHeight();
+    const auto first = index.band(point.y);
+    const auto visit = [&](std::size_t band) {
+        index.eachEdge(band, [&](const auto& q1, const auto& q2) {
+            dist = std::min(dist, pointToLineDistance(point, mapbox::geometry::line_string<double>{q1, q2}, ruler));
+        });
+    };
+    visit(first);
+    for (std::size_t step = 1; step < bandCount && dist > 0.0; ++step) {
+        const auto gap = static_cast<double>(step - 1) * bandHeight;
+        if (ruler.distance(mapbox::geometry::point<double>{0.0, 0.0}, mapbox::geometry::point<double>{0.0, gap}) >=
+            dist) {
+            break;
+        }
+        if (first >= step) visit(first - step);
+        if (first + step < bandCount) visit(first + step);
+    }
+    return dist;
+}
+
 double pointToPolygonDistance(const mapbox::geometry::point<double>& point,
                               const mapbox::geometry::polygon<double>& polygon,
+                              const PolygonIndex& index,
                               const mapbox::cheap_ruler::CheapRuler& ruler) noexcept {
-    if (pointWithinPolygon(point, polygon, true /*trueOnBoundary*/)) {
+    if (index.contains(point, true /*trueOnBoundary*/)) {
         return 0.0;
     }
     double dist = InfiniteDistance;
@@ -245,25 +265,21 @@ double pointToPolygonDistance(const mapbox::geometry::point<double>& point,
                 return dist;
             }
         }
-        const auto nearestPoint = std::get<0>(ruler.pointOnLine(ring, point));
-        dist = std::min(dist, ruler.distance(point, nearestPoint));
-        if (dist == 0.0) {
-            return dist;
-        }
     }
-    return dist;
+    return pointToEdgesDistance(point, index, ruler, dist);
 }
 
 double lineToPolygonDistance(const mapbox::geometry::line_string<double>& line,
                              const IndexRange& range,
                              const mapbox::geometry::polygon<double>& polygon,
+                             const PolygonIndex& index,
                              const mapbox::cheap_ruler::CheapRuler& ruler) noexcept {
     if (!isRangeSafe(range, line.size())) {
         return InvalidDistance;
     }
 
     for (std::size_t i = range.first; i <= range.second; ++i) {
-        if (pointWithinPolygon(line[i], polygon, true /*trueOnBoundary*/)) {
+        if (index.contains(line[i], true /*trueOnBoundary*/)) {
             return 0.0;
         }
     }
@@ -289,19 +305,21 @@ double lineToPolygonDistance(const mapbox::geometry::line_string<double>& line,
 // TODO: Currently the time complexity for polygon to polygon distance is
 // quadratic, performance improvement is needed.
 double polygonToPolygonDistance(const mapbox::geometry::polygon<double>& polygon1,
+                                const PolygonIndex& index1,
                                 const mapbox::geometry::polygon<double>& polygon2,
+                                const PolygonIndex& index2,
                                 const mapbox::cheap_ruler::CheapRuler& ruler,
                                 double currentMiniDist = InfiniteDistance) {
-    const auto bbox1 = getBBox(polygon1);
-    const auto bbox2 = getBBox(polygon2);
+    const auto& bbox1 = index1.getBBox();
+    const auto& bbox2 = index2.getBBox();
     if (currentMiniDist != InfiniteDistance && bboxToBBoxDistance(bbox1, bbox2, ruler) >= currentMiniDist) {
         return currentMiniDist;
     }
     const auto polygonIntersect = [](const mapbox::geometry::polygon<double>& poly1,
-                                     const mapbox::geometry::polygon<double>& poly2) noexcept {
+                                     const PolygonIndex& poly2) noexcept {
         for (const auto& ring : poly1) {
             for (std::size_t i = 0; i <= ring.size() - 1; ++i) {
-                if (pointWithinPolygon(ring[i], poly2, true /*trueOnBoundary*/)) {
+                if (poly2.contains(ring[i], true /*trueOnBoundary*/)) {
                     return true;
                 }
             }
@@ -309,10 +327,10 @@ double polygonToPolygonDistance(const mapbox::geometry::polygon<double>& polygon
         return false;
     };
     if (boxWithinBox(bbox1, bbox2)) {
-        if (polygonIntersect(polygon1, polygon2)) {
+        if (polygonIntersect(polygon1, index2)) {
             return 0.0;
         }
-    } else if (polygonIntersect(polygon2, polygon1)) {
+    } else if (polygonIntersect(polygon2, index1)) {
         return 0.0;
     }
 
@@ -349,6 +367,7 @@ using DistQueue = std::priority_queue<DistPair, std::deque<DistPair>, Comparator
 
 double pointsToPolygonDistance(const mapbox::geometry::multi_point<double>& points,
                                const mapbox::geometry::polygon<double>& polygon,
+                               const PolygonIndex& index,
                                const mapbox::cheap_ruler::CheapRuler& ruler,
                                double currentMiniDist = InfiniteDistance) {
     auto miniDist = std::min(ruler.distance(points[0], polygon[0][0]), currentMiniDist);
@@ -359,7 +378,7 @@ double pointsToPolygonDistance(const mapbox::geometry::multi_point<double>& poin
     DistQueue distQueue;
     distQueue.push(std::forward_as_tuple(0, IndexRange(0, points.size() - 1), IndexRange(0, 0)));
 
-    const auto polyBBox = getBBox(polygon);
+    const auto& polyBBox = index.getBBox();
     while (!distQueue.empty()) {
         const auto distPair = distQueue.top();
         distQueue.pop();
@@ -376,7 +395,7 @@ double pointsToPolygonDistance(const mapbox::geometry::multi_point<double>& poin
                 return InvalidDistance;
             }
             for (std::size_t i = range.first; i <= range.second; ++i) {
-                const auto tempDist = pointToPolygonDistance(points[i], polygon, ruler);
+                const auto tempDist = pointToPolygonDistance(points[i], polygon, index, ruler);
                 miniDist = std::min(miniDist, tempDist);
                 if (miniDist == 0.0) {
                     return 0.0;
@@ -405,6 +424,7 @@ double pointsToPolygonDistance(const mapbox::geometry::multi_point<double>& poin
 
 double lineToPolygonDistance(const mapbox::geometry::line_string<double>& line,
                              const mapbox::geometry::polygon<double>& polygon,
+                             const PolygonIndex& index,
                              const mapbox::cheap_ruler::CheapRuler& ruler,
                              double currentMiniDist = InfiniteDistance) {
     auto miniDist = std::min(ruler.distance(line[0], polygon[0][0]), currentMiniDist);
@@ -415,7 +435,7 @@ double lineToPolygonDistance(const mapbox::geometry::line_string<double>& line,
     DistQueue distQueue;
     distQueue.push(std::forward_as_tuple(0, IndexRange(0, line.size() - 1), IndexRange(0, 0)));
 
-    const auto polyBBox = getBBox(polygon);
+    const auto& polyBBox = index.getBBox();
     while (!distQueue.empty()) {
         const auto distPair = distQueue.top();
         distQueue.pop();
@@ -427,7 +447,7 @@ double lineToPolygonDistance(const mapbox::geometry::line_string<double>& line,
 
         // In case the set size are relatively small, we could use brute-force directly
         if (getRangeSize(range) <= MinLinePointsSize) {
-            const auto tempDist = lineToPolygonDistance(line, range, polygon, ruler);
+            const auto tempDist = lineToPolygonDistance(line, range, polygon, index, ruler);
             if (std::isnan(tempDist) || tempDist == 0.0) {
                 return tempDist;
             }
@@ -649,7 +669,8 @@ double lineToLinesDistance(const mapbox::geometry::line_string<double>& line,
 }
 
 double pointsToGeometryDistance(const mapbox::geometry::multi_point<double>& points,
-                                const Feature::geometry_type& geoSet) {
+                                const Feature::geometry_type& geoSet,
+                                const std::vector<PolygonIndex>& polygonIndexes) {
     if (!isMultiPointValid(points)) {
         return InvalidDistance;
     }
@@ -672,15 +693,16 @@ double pointsToGeometryDistance(const mapbox::geometry::multi_point<double>& poi
             }
             return pointsToLinesDistance(points, lines, ruler);
         },
-        [&points, &ruler](const mapbox::geometry::polygon<double>& polygon) -> double {
+        [&points, &ruler, &polygonIndexes](const mapbox::geometry::polygon<double>& polygon) -> double {
             if (!isPolygonValid(polygon)) return InvalidDistance;
-            return pointsToPolygonDistance(points, polygon, ruler);
+            return pointsToPolygonDistance(points, polygon, polygonIndexes[0], ruler);
         },
-        [&points, &ruler](const mapbox::geometry::multi_polygon<double>& polygons) -> double {
+        [&points, &ruler, &polygonIndexes](const mapbox::geometry::multi_polygon<double>& polygons) -> double {
             double dist = InfiniteDistance;
-            for (const auto& polygon : polygons) {
+            for (std::size_t i = 0; i < polygons.size(); ++i) {
+                const auto& polygon = polygons[i];
                 if (!isPolygonValid(polygon)) return InvalidDistance;
-                auto tempDist = pointsToPolygonDistance(points, polygon, ruler, dist);
+                auto tempDist = pointsToPolygonDistance(points, polygon, polygonIndexes[i], ruler, dist);
                 if (std::isnan(tempDist)) return tempDist;
                 dist = std::min(dist, tempDist);
                 if (dist == 0.0) return dist;
@@ -690,7 +712,9 @@ double pointsToGeometryDistance(const mapbox::geometry::multi_point<double>& poi
         [](const auto&) { return InvalidDistance; });
 }
 
-double lineToGeometryDistance(const mapbox::geometry::line_string<double>& line, const Feature::geometry_type& geoSet) {
+double lineToGeometryDistance(const mapbox::geometry::line_string<double>& line,
+                              const Feature::geometry_type& geoSet,
+                              const std::vector<PolygonIndex>& polygonIndexes) {
     if (!isLineStringValid(line)) {
         return InvalidDistance;
     }
@@ -713,15 +737,16 @@ double lineToGeometryDistance(const mapbox::geometry::line_string<double>& line,
             }
             return lineToLinesDistance(line, lines, ruler);
         },
-        [&line, &ruler](const mapbox::geometry::polygon<double>& polygon) -> double {
+        [&line, &ruler, &polygonIndexes](const mapbox::geometry::polygon<double>& polygon) -> double {
             if (!isPolygonValid(polygon)) return InvalidDistance;
-            return lineToPolygonDistance(line, polygon, ruler);
+            return lineToPolygonDistance(line, polygon, polygonIndexes[0], ruler);
         },
-        [&line, &ruler](const mapbox::geometry::multi_polygon<double>& polygons) -> double {
+        [&line, &ruler, &polygonIndexes](const mapbox::geometry::multi_polygon<double>& polygons) -> double {
             double dist = InfiniteDistance;
-            for (const auto& polygon : polygons) {
+            for (std::size_t i = 0; i < polygons.size(); ++i) {
+                const auto& polygon = polygons[i];
                 if (!isPolygonValid(polygon)) return InvalidDistance;
-                auto tempDist = lineToPolygonDistance(line, polygon, ruler, dist);
+                auto tempDist = lineToPolygonDistance(line, polygon, polygonIndexes[i], ruler, dist);
                 if (std::isnan(tempDist)) return tempDist;
                 dist = std::min(dist, tempDist);
                 if (dist == 0.0) return dist;
@@ -732,28 +757,31 @@ double lineToGeometryDistance(const mapbox::geometry::line_string<double>& line,
 }
 
 double polygonToGeometryDistance(const mapbox::geometry::polygon<double>& polygon,
-                                 const Feature::geometry_type& geoSet) {
+                                 const Feature::geometry_type& geoSet,
+                                 const std::vector<PolygonIndex>& polygonIndexes) {
     if (!isPolygonValid(polygon)) {
         return InvalidDistance;
     }
     mapbox::cheap_ruler::CheapRuler ruler(polygon.front().front().y, UnitInMeters);
+    const PolygonIndex index(polygon);
     return geoSet.match(
-        [&polygon, &ruler](const mapbox::geometry::point<double>& p) {
-            return pointToPolygonDistance(p, polygon, ruler);
+        [&polygon, &index, &ruler](const mapbox::geometry::point<double>& p) {
+            return pointToPolygonDistance(p, polygon, index, ruler);
         },
-        [&polygon, &ruler](const mapbox::geometry::multi_point<double>& points) {
-            return isMultiPointValid(points) ? pointsToPolygonDistance(points, polygon, ruler) : InvalidDistance;
+        [&polygon, &index, &ruler](const mapbox::geometry::multi_point<double>& points) {
+            return isMultiPointValid(points) ? pointsToPolygonDistance(points, polygon, index, ruler)
+                                             : InvalidDistance;
         },
-        [&polygon, &ruler](const mapbox::geometry::line_string<double>& line) {
-            return isLineStringValid(line) ? lineToPolygonDistance(line, polygon, ruler) : InvalidDistance;
+        [&polygon, &index, &ruler](const mapbox::geometry::line_string<double>& line) {
+            return isLineStringValid(line) ? lineToPolygonDistance(line, polygon, index, ruler) : InvalidDistance;
         },
-        [&polygon, &ruler](const mapbox::geometry::multi_line_string<double>& lines) {
+        [&polygon, &index, &ruler](const mapbox::geometry::multi_line_string<double>& lines) {
             double dist = InfiniteDistance;
             for (const auto& line : lines) {
                 if (!isLineStringValid(line)) {
                     return InvalidDistance;
                 }
-                const auto tempDist = lineToPolygonDistance(line, polygon, ruler, dist);
+                const auto tempDist = lineToPolygonDistance(line, polygon, index, ruler, dist);
                 if (std::isnan(tempDist) || tempDist == 0.0) {
                     return tempDist;
                 }
@@ -761,16 +789,20 @@ double polygonToGeometryDistance(const mapbox::geometry::polygon<double>& polygo
             }
             return dist;
         },
-        [&polygon, &ruler](const mapbox::geometry::polygon<double>& polygon1) {
-            return isPolygonValid(polygon1) ? polygonToPolygonDistance(polygon, polygon1, ruler) : InvalidDistance;
+        [&polygon, &index, &ruler, &polygonIndexes](const mapbox::geometry::polygon<double>& polygon1) {
+            return isPolygonValid(polygon1)
+                       ? polygonToPolygonDistance(polygon, index, polygon1, polygonIndexes[0], ruler)
+                       : InvalidDistance;
         },
-        [&polygon, &ruler](const mapbox::geometry::multi_polygon<double>& polygons) {
+        [&polygon, &index, &ruler, &polygonIndexes](const mapbox::geometry::multi_polygon<double>& polygons) {
             double dist = InfiniteDistance;
-            for (const auto& polygon1 : polygons) {
+            for (std::size_t i = 0; i < polygons.size(); ++i) {
+                const auto& polygon1 = polygons[i];
                 if (!isPolygonValid(polygon1)) {
                     return InvalidDistance;
                 }
-                const auto tempDist = polygonToPolygonDistance(polygon, polygon1, ruler, dist);
+                const auto tempDist =
+                    polygonToPolygonDistance(polygon, index, polygon1, polygonIndexes[i], ruler, dist);
                 if (std::isnan(tempDist) || tempDist == 0.0) {
                     return tempDist;
                 }
@@ -783,22 +815,23 @@ double polygonToGeometryDistance(const mapbox::geometry::polygon<double>& polygo
 
 double calculateDistance(const GeometryTileFeature& feature,
                          const CanonicalTileID& canonical,
-                         const Feature::geometry_type& geoSet) {
+                         const Feature::geometry_type& geoSet,
+                         const std::vector<PolygonIndex>& polygonIndexes) {
     return convertGeometry(feature, canonical)
         .match(
-            [&geoSet](const mapbox::geometry::point<double>& point) -> double {
-                return pointsToGeometryDistance(mapbox::geometry::multi_point<double>{point}, geoSet);
+            [&geoSet, &polygonIndexes](const mapbox::geometry::point<double>& point) -> double {
+                return pointsToGeometryDistance(mapbox::geometry::multi_point<double>{point}, geoSet, polygonIndexes);
             },
-            [&geoSet](const mapbox::geometry::multi_point<double>& points) -> double {
-                return pointsToGeometryDistance(points, geoSet);
+            [&geoSet, &polygonIndexes](const mapbox::geometry::multi_point<double>& points) -> double {
+                return pointsToGeometryDistance(points, geoSet, polygonIndexes);
             },
-            [&geoSet](const mapbox::geometry::line_string<double>& line) -> double {
-                return lineToGeometryDistance(line, geoSet);
+            [&geoSet, &polygonIndexes](const mapbox::geometry::line_string<double>& line) -> double {
+                return lineToGeometryDistance(line, geoSet, polygonIndexes);
             },
-            [&geoSet](const mapbox::geometry::multi_line_string<double>& lines) -> double {
+            [&geoSet, &polygonIndexes](const mapbox::geometry::multi_line_string<double>& lines) -> double {
                 double dist = InfiniteDistance;
                 for (const auto& line : lines) {
-                    const auto tempDist = lineToGeometryDistance(line, geoSet);
+                    const auto tempDist = lineToGeometryDistance(line, geoSet, polygonIndexes);
                     if (std::isnan(tempDist) || tempDist == 0.0) {
                         return tempDist;
                     }
@@ -806,13 +839,13 @@ double calculateDistance(const GeometryTileFeature& feature,
                 }
                 return dist;
             },
-            [&geoSet](const mapbox::geometry::polygon<double>& polygon) -> double {
-                return polygonToGeometryDistance(polygon, geoSet);
+            [&geoSet, &polygonIndexes](const mapbox::geometry::polygon<double>& polygon) -> double {
+                return polygonToGeometryDistance(polygon, geoSet, polygonIndexes);
             },
-            [&geoSet](const mapbox::geometry::multi_polygon<double>& polygons) -> double {
+            [&geoSet, &polygonIndexes](const mapbox::geometry::multi_polygon<double>& polygons) -> double {
                 double dist = InfiniteDistance;
                 for (const auto& polygon : polygons) {
-                    const auto tempDist = polygonToGeometryDistance(polygon, geoSet);
+                    const auto tempDist = polygonToGeometryDistance(polygon, geoSet, polygonIndexes);
                     if (std::isnan(tempDist) || tempDist == 0.0) {
                         return tempDist;
                     }
@@ -869,7 +902,17 @@ namespace expression {
 Distance::Distance(GeoJSON geojson, Feature::geometry_type geometries_)
     : Expression(Kind::Distance, type::Number, Dependency::Feature),
       geoJSONSource(std::move(geojson)),
-      geometries(std::move(geometries_)) {}
+      geometries(std::move(geometries_)) {
+    geometries.match(
+        [this](const mapbox::geometry::polygon<double>& polygon) { polygonIndexes.emplace_back(polygon); },
+        [this](const mapbox::geometry::multi_polygon<double>& polygons) {
+            polygonIndexes.reserve(polygons.size());
+            for (const auto& polygon : polygons) {
+                polygonIndexes.emplace_back(polygon);
+            }
+        },
+        [](const auto&) {});
+}
 
 Distance::~Distance() = default;
 
@@ -884,7 +927,7 @@ EvaluationResult Distance::evaluate(const EvaluationContext& params) const {
     auto geometryType = params.feature->getType();
     if (geometryType == FeatureType::Point || geometryType == FeatureType::LineString ||
         geometryType == FeatureType::Polygon) {
-        auto distance = calculateDistance(*params.feature, *params.canonical, geometries);
+        auto distance = calculateDistance(*params.feature, *params.canonical, geometries, polygonIndexes);
         if (!std::isnan(distance)) {
             assert(distance >= 0.0);
             return distance;
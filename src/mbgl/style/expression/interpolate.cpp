@@ -1,7 +1,10 @@
 #include <mbgl/style/expression/interpolate.hpp>
+#include <mbgl/style/expression/literal.hpp>
 #include <mbgl/style/conversion_impl.hpp>
 #include <mbgl/util/string.hpp>
 
+#include <algorithm>
+
 namespace mbgl {
 namespace style {
 namespace expression {
@@ -18,6 +21,24 @@ public:
                     std::map<double, std::unique_ptr<Expression>> stops_)
         : Interpolate(type_, interpolator_, std::move(input_), std::move(stops_)) {
         static_assert(util::Interpolatable<T>::value, "Interpolate expression requires an interpolatable value type.");
+
+        // Stop outputs are nearly always literals, in which case they're copied into a flat table
+        // so that evaluation neither walks the map nor evaluates the output expressions.
+        std::vector<double> inputs;
+        std::vector<T> outputs;
+        for (const auto& stop : stops) {
+            if (stop.second->getKind() != Kind::Literal) {
+                return;
+            }
+            const auto& value = static_cast<const Literal&>(*stop.second).getValue();
+            if (!value.template is<T>()) {
+                return;
+            }
+            inputs.push_back(stop.first);
+            outputs.push_back(value.template get<T>());
+        }
+        stopInputs = std::move(inputs);
+        stopOutputs = std::move(outputs);
     }
 
     EvaluationResult evaluate(const EvaluationContext& params) const override {
@@ -31,6 +52,10 @@ public:
             return EvaluationError{"Input is not a number."};
         }
 
+        if (!stopOutputs.empty()) {
+            return evaluateStopTable(x);
+        }
+
         if (stops.empty()) {
             return EvaluationError{"No stops in exponential curve."};
         }
@@ -71,6 +96,30 @@ public:
             return util::interpolate(lower->get<T>(), upper->get<T>(), t);
         }
     }
+
+private:
+    // Same stop selection as above, over the literal stop table
+    EvaluationResult evaluateStopTable(const float x) const {
+        const auto upper = static_cast<std::size_t>(std::upper_bound(stopInputs.begin(), stopInputs.end(), x) -
+                                                    stopInputs.begin());
+        if (upper == stopInputs.size()) {
+            return stopOutputs.back();
+        } else if (upper == 0) {
+            return stopOutputs.front();
+        }
+
+        const double t = interpolationFactor({stopInputs[upper - 1], stopInputs[upper]}, x);
+        if (t == 0.0) {
+            return stopOutputs[upper - 1];
+        }
+        if (t == 1.0) {
+            return stopOutputs[upper];
+        }
+        return util::interpolate(stopOutputs[upper - 1], stopOutputs[upper], t);
+    }
+
+    std::vector<double> stopInputs;
+    std::vector<T> stopOutputs;
 };
 
 ParseResult parseInterpolate(const Convertible& value, ParsingContext& ctx) {
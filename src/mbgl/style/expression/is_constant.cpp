@@ -54,11 +54,16 @@ bool isFeatureConstant(const Expression& expression) {
 
 namespace {
 const auto zoomProperty = std::array<std::string_view, 1>{"zoom"};
-}
+const auto featureStateProperty = std::array<std::string_view, 1>{"feature-state"};
+} // namespace
 bool isZoomConstant(const Expression& e) {
     return isGlobalPropertyConstant(e, zoomProperty);
 }
 
+bool isFeatureStateConstant(const Expression& e) {
+    return isGlobalPropertyConstant(e, featureStateProperty);
+}
+
 bool isRuntimeConstant(const Expression& expression) {
     if (expression.getKind() == Kind::ImageExpression) {
         return false;
@@ -20,8 +20,8 @@ using namespace std::numbers;
 namespace mbgl {
 namespace {
 
-Point<int64_t> latLonToTileCoodinates(const Point<double>& point, const mbgl::CanonicalTileID& canonical) noexcept {
-    const double size = util::EXTENT * std::pow(2, canonical.z);
+Point<int64_t> latLonToTileCoodinates(const Point<double>& point, const uint8_t z) noexcept {
+    const double size = util::EXTENT * std::pow(2, z);
 
     const auto x = (point.x + util::LONGITUDE_MAX) * size / util::DEGREES_MAX;
     const auto y = (util::LONGITUDE_MAX -
@@ -38,16 +38,14 @@ Point<int64_t> latLonToTileCoodinates(const Point<double>& point, const mbgl::Ca
 };
 
 using WithinBBox = GeometryBBox<int64_t>;
-Polygon<int64_t> getTilePolygon(const Polygon<double>& polygon,
-                                const mbgl::CanonicalTileID& canonical,
-                                WithinBBox& bbox) {
+Polygon<int64_t> getTilePolygon(const Polygon<double>& polygon, const uint8_t z, WithinBBox& bbox) {
     Polygon<int64_t> result;
     result.reserve(polygon.size());
     for (const auto& ring : polygon) {
         LinearRing<int64_t> temp;
         temp.reserve(ring.size());
         for (const auto& p : ring) {
-            const auto coord = latLonToTileCoodinates(p, canonical);
+            const auto coord = latLonToTileCoodinates(p, z);
             temp.push_back(coord);
             updateBBox(bbox, coord);
         }
@@ -56,21 +54,19 @@ Polygon<int64_t> getTilePolygon(const Polygon<double>& polygon,
     return result;
 }
 
-MultiPolygon<int64_t> getTilePolygons(const Feature::geometry_type& polygonGeoSet,
-                                      const mbgl::CanonicalTileID& canonical,
-                                      WithinBBox& bbox) {
+MultiPolygon<int64_t> getTilePolygons(const Feature::geometry_type& polygonGeoSet, const uint8_t z, WithinBBox& bbox) {
     return polygonGeoSet.match(
-        [&canonical, &bbox](const mapbox::geometry::multi_polygon<double>& polygons) {
+        [z, &bbox](const mapbox::geometry::multi_polygon<double>& polygons) {
             MultiPolygon<int64_t> result;
             result.reserve(polygons.size());
             for (const auto& pg : polygons) {
-                result.push_back(getTilePolygon(pg, canonical, bbox));
+                result.push_back(getTilePolygon(pg, z, bbox));
             }
             return result;
         },
-        [&canonical, &bbox](const mapbox::geometry::polygon<double>& polygon) {
+        [z, &bbox](const mapbox::geometry::polygon<double>& polygon) {
             MultiPolygon<int64_t> result;
-            result.push_back(getTilePolygon(polygon, canonical, bbox));
+            result.push_back(getTilePolygon(polygon, z, bbox));
             return result;
         },
         [](const auto&) { return MultiPolygon<int64_t>(); });
@@ -144,11 +140,42 @@ MultiLineString<int64_t> getTileLines(const GeometryCollection& lines,
     return results;
 }
 
+// Feature coordinates are 16 bit integers relative to the tile, which getTilePoints and getTileLines only
+// ever move by the width of the world, so no feature of a tile whose reach misses the polygons is within them.
+bool tileMayBeWithin(const CanonicalTileID& canonical, const WithinBBox& polyBBox) noexcept {
+    constexpr int64_t reach = std::numeric_limits<int16_t>::max() + 1;
+    const int64_t minX = int64_t(util::EXTENT) * canonical.x - reach;
+    const int64_t minY = int64_t(util::EXTENT) * canonical.y - reach;
+    const int64_t maxX = int64_t(util::EXTENT) * (canonical.x + 1) + reach;
+    const int64_t maxY = int64_t(util::EXTENT) * (canonical.y + 1) + reach;
+    if (maxY < polyBBox[1] || minY > polyBBox[3]) {
+        return false;
+    }
+    const auto worldSize = static_cast<int64_t>(util::EXTENT * std::pow(2, canonical.z));
+    for (const int64_t shift : {-worldSize, int64_t(0), worldSize}) {
+        if (maxX + shift >= polyBBox[0] && minX + shift <= polyBBox[2]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+struct style::expression::Within::TilePolygons {
+    WithinBBox bbox = DefaultWithinBBox;
+    std::vector<PolygonEdgeIndex<int64_t>> polygons;
+};
+
+namespace {
+
+using TilePolygons = style::expression::Within::TilePolygons;
+
 bool featureWithinPolygons(const GeometryTileFeature& feature,
                            const CanonicalTileID& canonical,
-                           const Feature::geometry_type& polygonGeoSet) {
-    WithinBBox polyBBox = DefaultWithinBBox;
-    const auto polygons = getTilePolygons(polygonGeoSet, canonical, polyBBox);
+                           const TilePolygons& tilePolygons) {
+    const WithinBBox& polyBBox = tilePolygons.bbox;
+    const auto& polygons = tilePolygons.polygons;
     assert(!polygons.empty());
     const GeometryCollection& geometries = feature.getGeometries();
     switch (feature.getType()) {
@@ -159,7 +186,8 @@ bool featureWithinPolygons(const GeometryTileFeature& feature,
             if (!boxWithinBox(pointBBox, polyBBox)) return false;
 
             return std::all_of(points.begin(), points.end(), [&polygons](const auto& p) {
-                return pointWithinPolygons<int64_t>(p, polygons);
+                return std::any_of(
+                    polygons.begin(), polygons.end(), [&p](const auto& polygon) { return polygon.contains(p); });
             });
         }
         case FeatureType::LineString: {
@@ -168,7 +196,9 @@ bool featureWithinPolygons(const GeometryTileFeature& feature,
             if (!boxWithinBox(lineBBox, polyBBox)) return false;
 
             return std::all_of(multiLineString.begin(), multiLineString.end(), [&polygons](const auto& line) {
-                return lineStringWithinPolygons<int64_t>(line, polygons);
+                return std::any_of(polygons.begin(), polygons.end(), [&line](const auto& polygon) {
+                    return polygon.contains(line);
+                });
             });
         }
         default:
@@ -225,7 +255,11 @@ EvaluationResult Within::evaluate(const EvaluationContext& params) const {
     auto geometryType = params.feature->getType();
     // Currently only support Point and LineString types in Polygon/Polygons
     if (geometryType == FeatureType::Point || geometryType == FeatureType::LineString) {
-        return featureWithinPolygons(*params.feature, *params.canonical, geometries);
+        const auto polygons = getTilePolygons(params.canonical->z);
+        if (!tileMayBeWithin(*params.canonical, polygons->bbox)) {
+            return false;
+        }
+        return featureWithinPolygons(*params.feature, *params.canonical, *polygons);
     }
     mbgl::Log::Warning(mbgl::Event::General,
                        "within expression currently only support Point/LineString geometry "
@@ -234,6 +268,19 @@ EvaluationResult Within::evaluate(const EvaluationContext& params) const {
     return false;
 }
 
+std::shared_ptr<const Within::TilePolygons> Within::getTilePolygons(uint8_t z) const {
+    std::scoped_lock lock(tilePolygonsMutex);
+    auto& polygons = tilePolygons[z];
+    if (!polygons) {
+        auto result = std::make_shared<TilePolygons>();
+        for (const auto& polygon : mbgl::getTilePolygons(geometries, z, result->bbox)) {
+            result->polygons.emplace_back(polygon);
+        }
+        polygons = std::move(result);
+    }
+    return polygons;
+}
+
 ParseResult Within::parse(const Convertible& value, ParsingContext& ctx) {
     if (isArray(value)) {
         // object value, quoted with ["within", value]
@@ -1,9 +1,17 @@
 #include <mbgl/style/filter.hpp>
+#include <mbgl/style/batch_filter.hpp>
 #include <mbgl/tile/geometry_tile_data.hpp>
 
 namespace mbgl {
 namespace style {
 
+Filter::Filter(expression::ParseResult _expression, std::optional<mbgl::Value> _filter)
+    : expression(std::move(*_expression)),
+      legacyFilter(std::move(_filter)),
+      batchFilterCache(std::make_shared<BatchFilterCache>()) {
+    assert(!expression || *expression != nullptr);
+}
+
 bool Filter::operator()(const expression::EvaluationContext &context) const {
     if (!this->expression) return true;
 
@@ -30,6 +30,7 @@
 #include <mbgl/util/mat4.hpp>
 #include <mbgl/renderer/render_tile.hpp>
 #include <mbgl/gfx/uniform_buffer.hpp>
+#include <mbgl/util/parallel_for.hpp>
 
 #include <cmath>
 
@@ -47,8 +48,101 @@ const LayerTypeInfo typeInfoCustomDrawable{.type = "custom-drawable",
                                            .fadingTiles = LayerTypeInfo::FadingTiles::NotRequired,
                                            .crossTileIndex = LayerTypeInfo::CrossTileIndex::NotRequired,
                                            .tileKind = LayerTypeInfo::TileKind::NotRequired};
+
+struct CustomSymbolIcon {
+    std::array<float, 2> a_pos;
+    std::array<float, 2> a_tex;
+};
+
+struct SymbolBuffers {
+    std::shared_ptr<gfx::VertexVector<CustomSymbolIcon>> vertices;
+    std::shared_ptr<gfx::IndexVector<gfx::Triangles>> indices;
+    SegmentVector segments;
+};
+
+SymbolBuffers makeSymbolBuffers(const GeometryCoordinate& point,
+                                const std::array<std::array<float, 2>, 2>& textureCoordinates) {
+    SymbolBuffers buffers{.vertices = std::make_shared<gfx::VertexVector<CustomSymbolIcon>>(),
+                          .indices = std::make_shared<gfx::IndexVector<gfx::Triangles>>(),
+                          .segments = {}};
+
+    // encode center and extrude direction into vertices
+    for (int y = 0; y <= 1; ++y) {
+        for (int x = 0; x <= 1; ++x) {
+            buffers.vertices->emplace_back(
+                CustomSymbolIcon{.a_pos = {static_cast<float>(point.x * 2 + x), static_cast<float>(point.y * 2 + y)},
+                                 .a_tex = {textureCoordinates[x][0], textureCoordinates[y][1]}});
+        }
+    }
+
+    buffers.indices->emplace_back(0, 1, 2, 1, 2, 3);
+    buffers.segments.emplace_back(0, 0, 4, 6);
+    return buffers;
+}
+
+gfx::VertexAttributeArrayPtr symbolAttributes(gfx::Context& context,
+                                              const std::shared_ptr<gfx::VertexVector<CustomSymbolIcon>>& vertices) {
+    auto attrs = context.createVertexAttributeArray();
+    if (const auto& attr = attrs->set(idCustomSymbolPosVertexAttribute)) {
+        attr->setSharedRawData(vertices,
+                               offsetof(CustomSymbolIcon, a_pos),
+                               /*vertexOffset=*/0,
+                               sizeof(CustomSymbolIcon),
+                               gfx::AttributeDataType::Float2);
+    }
+    if (const auto& attr = attrs->set(idCustomSymbolTexVertexAttribute)) {
+        attr->setSharedRawData(vertices,
+                               offsetof(CustomSymbolIcon, a_tex),
+                               /*vertexOffset=*/0,
+                               sizeof(CustomSymbolIcon),
+                               gfx::AttributeDataType::Float2);
+    }
+    return attrs;
+}
+
+gfx::VertexAttributeArrayPtr geometryAttributes(
+    gfx::Context& context,
+    const std::shared_ptr<gfx::VertexVector<CustomDrawableLayerHost::Interface::GeometryVertex>>& vertices) {
+    using GeometryVertex = CustomDrawableLayerHost::Interface::GeometryVertex;
+    auto attrs = context.createVertexAttributeArray();
+    if (const auto& attr = attrs->set(idCustomGeometryPosVertexAttribute)) {
+        attr->setSharedRawData(vertices,
+                               offsetof(GeometryVertex, position),
+                               /*vertexOffset=*/0,
+                               sizeof(GeometryVertex),
+                               gfx::AttributeDataType::Float3);
+    }
+
+    if (const auto& attr = attrs->set(idCustomGeometryTexVertexAttribute)) {
+        attr->setSharedRawData(vertices,
+                               offsetof(GeometryVertex, texcoords),
+                               /*vertexOffset=*/0,
+                               sizeof(GeometryVertex),
+                               gfx::AttributeDataType::Float2);
+    }
+    return attrs;
+}
+
 } // namespace
 
+struct CustomDrawableLayerHost::Interface::PreparedFill {
+    std::shared_ptr<gfx::VertexVector<FillLayoutVertex>> vertices;
+    std::shared_ptr<gfx::IndexVector<gfx::Triangles>> indices;
+    SegmentVector segments;
+
+    gfx::VertexAttributeArrayPtr attributes(gfx::Context& context) const {
+        auto attrs = context.createVertexAttributeArray();
+        if (const auto& attr = attrs->set(idFillPosVertexAttribute)) {
+            attr->setSharedRawData(vertices,
+                                   offsetof(FillLayoutVertex, a1),
+                                   /*vertexOffset=*/0,
+                                   sizeof(FillLayoutVertex),
+                                   gfx::AttributeDataType::Short2);
+        }
+        return attrs;
+    }
+};
+
 CustomDrawableLayer::CustomDrawableLayer(const std::string& layerID, std::unique_ptr<CustomDrawableLayerHost> host)
     : Layer(makeMutable<Impl>(layerID, std::move(host))) {}
 
@@ -583,38 +677,48 @@ util::SimpleIdentity CustomDrawableLayerHost::Interface::addPolyline(const Geome
     return builder->getCurrentDrawable(true)->getID();
 }
 
-util::SimpleIdentity CustomDrawableLayerHost::Interface::addFill(const GeometryCollection& geometry) {
-    // build fill
-    if (!updateBuilder(BuilderType::Fill, "custom-fill", fillShaderDefault())) {
-        return util::SimpleIdentity::Empty;
-    }
-
+CustomDrawableLayerHost::Interface::PreparedFillPtr CustomDrawableLayerHost::Interface::prepareFill(
+    const GeometryCollection& geometry) {
     // provision buffers for fill vertices, indexes and segments
-    using VertexVector = gfx::VertexVector<FillLayoutVertex>;
-    const std::shared_ptr<VertexVector> sharedVertices = std::make_shared<VertexVector>();
-    VertexVector& vertices = *sharedVertices;
+    auto fill = std::make_shared<PreparedFill>();
+    fill->vertices = std::make_shared<gfx::VertexVector<FillLayoutVertex>>();
+    fill->indices = std::make_shared<gfx::IndexVector<gfx::Triangles>>();
 
-    using TriangleIndexVector = gfx::IndexVector<gfx::Triangles>;
-    const std::shared_ptr<TriangleIndexVector> sharedTriangles = std::make_shared<TriangleIndexVector>();
-    TriangleIndexVector& triangles = *sharedTriangles;
+    // generate fill geometry into buffers
+    gfx::generateFillBuffers(geometry, *fill->vertices, *fill->indices, fill->segments);
+    return fill;
+}
 
-    SegmentVector triangleSegments;
+util::SimpleIdentity CustomDrawableLayerHost::Interface::addFill(const GeometryCollection& geometry) {
+    return addFill(prepareFill(geometry));
+}
 
-    // generate fill geometry into buffers
-    gfx::generateFillBuffers(geometry, vertices, triangles, triangleSegments);
+std::vector<util::SimpleIdentity> CustomDrawableLayerHost::Interface::addFills(
+    const std::vector<GeometryCollection>& geometries) {
+    // Tessellation only reads the geometry, the drawables are then built here in order
+    std::vector<PreparedFillPtr> fills(geometries.size());
+    util::parallelFor(geometries.size(), [&](std::size_t i) {
+        fills[i] = prepareFill(geometries[i]);
+    });
+
+    std::vector<util::SimpleIdentity> ids;
+    ids.reserve(fills.size());
+    for (const auto& fill : fills) {
+        ids.push_back(addFill(fill));
+    }
+    return ids;
+}
 
-    // add to builder
-    auto attrs = context.createVertexAttributeArray();
-    if (const auto& attr = attrs->set(idFillPosVertexAttribute)) {
-        attr->setSharedRawData(sharedVertices,
-                               offsetof(FillLayoutVertex, a1),
-                               /*vertexOffset=*/0,
-                               sizeof(FillLayoutVertex),
-                               gfx::AttributeDataType::Short2);
+util::SimpleIdentity CustomDrawableLayerHost::Interface::addFill(const PreparedFillPtr& fill) {
+    // build fill
+    if (!fill || !updateBuilder(BuilderType::Fill, "custom-fill", fillShaderDefault())) {
+        return util::SimpleIdentity::Empty;
     }
-    builder->setVertexAttributes(std::move(attrs));
-    builder->setRawVertices({}, vertices.elements(), gfx::AttributeDataType::Short2);
-    builder->setSegments(gfx::Triangles(), sharedTriangles, triangleSegments.data(), triangleSegments.size());
+
+    // add to builder
+    builder->setVertexAttributes(fill->attributes(context));
+    builder->setRawVertices({}, fill->vertices->elements(), gfx::AttributeDataType::Short2);
+    builder->setSegments(gfx::Triangles(), fill->indices, fill->segments.data(), fill->segments.size());
 
     const auto& id = builder->getCurrentDrawable(true)->getID();
 
@@ -631,55 +735,13 @@ util::SimpleIdentity CustomDrawableLayerHost::Interface::addSymbol(
         return util::SimpleIdentity::Empty;
     }
 
-    // temporary: buffers
-    struct CustomSymbolIcon {
-        std::array<float, 2> a_pos;
-        std::array<float, 2> a_tex;
-    };
-
-    // vertices
-    using VertexVector = gfx::VertexVector<CustomSymbolIcon>;
-    const std::shared_ptr<VertexVector> sharedVertices = std::make_shared<VertexVector>();
-    VertexVector& vertices = *sharedVertices;
-
-    // encode center and extrude direction into vertices
-    for (int y = 0; y <= 1; ++y) {
-        for (int x = 0; x <= 1; ++x) {
-            vertices.emplace_back(
-                CustomSymbolIcon{.a_pos = {static_cast<float>(point.x * 2 + x), static_cast<float>(point.y * 2 + y)},
-                                 .a_tex = {textureCoordinates[x][0], textureCoordinates[y][1]}});
-        }
-    }
-
-    // indexes
-    using TriangleIndexVector = gfx::IndexVector<gfx::Triangles>;
-    const std::shared_ptr<TriangleIndexVector> sharedTriangles = std::make_shared<TriangleIndexVector>();
-    TriangleIndexVector& triangles = *sharedTriangles;
-
-    triangles.emplace_back(0, 1, 2, 1, 2, 3);
-
-    SegmentVector triangleSegments;
-    triangleSegments.emplace_back(0, 0, 4, 6);
+    // vertices, indexes and segments
+    const auto buffers = makeSymbolBuffers(point, textureCoordinates);
 
     // add to builder
-    auto attrs = context.createVertexAttributeArray();
-    if (const auto& attr = attrs->set(idCustomSymbolPosVertexAttribute)) {
-        attr->setSharedRawData(sharedVertices,
-                               offsetof(CustomSymbolIcon, a_pos),
-                               /*vertexOffset=*/0,
-                               sizeof(CustomSymbolIcon),
-                               gfx::AttributeDataType::Float2);
-    }
-    if (const auto& attr = attrs->set(idCustomSymbolTexVertexAttribute)) {
-        attr->setSharedRawData(sharedVertices,
-                               offsetof(CustomSymbolIcon, a_tex),
-                               /*vertexOffset=*/0,
-                               sizeof(CustomSymbolIcon),
-                               gfx::AttributeDataType::Float2);
-    }
-    builder->setVertexAttributes(std::move(attrs));
-    builder->setRawVertices({}, vertices.elements(), gfx::AttributeDataType::Float2);
-    builder->setSegments(gfx::Triangles(), sharedTriangles, triangleSegments.data(), triangleSegments.size());
+    builder->setVertexAttributes(symbolAttributes(context, buffers.vertices));
+    builder->setRawVertices({}, buffers.vertices->elements(), gfx::AttributeDataType::Float2);
+    builder->setSegments(gfx::Triangles(), buffers.indices, buffers.segments.data(), buffers.segments.size());
 
     // texture
     if (symbolOptions.texture) {
@@ -717,24 +779,7 @@ util::SimpleIdentity CustomDrawableLayerHost::Interface::addGeometry(
     triangleSegments.emplace_back(0, 0, vertices->elements(), indices->elements());
 
     // add to builder
-    auto attrs = context.createVertexAttributeArray();
-    if (const auto& attr = attrs->set(idCustomGeometryPosVertexAttribute)) {
-        attr->setSharedRawData(vertices,
-                               offsetof(GeometryVertex, position),
-                               /*vertexOffset=*/0,
-                               sizeof(GeometryVertex),
-                               gfx::AttributeDataType::Float3);
-    }
-
-    if (const auto& attr = attrs->set(idCustomGeometryTexVertexAttribute)) {
-        attr->setSharedRawData(vertices,
-                               offsetof(GeometryVertex, texcoords),
-                               /*vertexOffset=*/0,
-                               sizeof(GeometryVertex),
-                               gfx::AttributeDataType::Float2);
-    }
-
-    builder->setVertexAttributes(std::move(attrs));
+    builder->setVertexAttributes(geometryAttributes(context, vertices));
     builder->setRawVertices({}, vertices->elements(), gfx::AttributeDataType::Float3);
     builder->setSegments(gfx::Triangles(), indices, triangleSegments.data(), triangleSegments.size());
 
@@ -834,6 +879,78 @@ void CustomDrawableLayerHost::Interface::removeDrawable(const util::SimpleIdenti
     tileLayerGroup->removeDrawablesIf([&](gfx::Drawable& drawable) { return drawable.getID() == id; });
 }
 
+gfx::Drawable* CustomDrawableLayerHost::Interface::findDrawable(const util::SimpleIdentity& id) const {
+    gfx::Drawable* found = nullptr;
+    if (layerGroup) {
+        TileLayerGroup* tileLayerGroup = static_cast<TileLayerGroup*>(layerGroup.get());
+        tileLayerGroup->visitDrawables([&](gfx::Drawable& drawable) {
+            if (drawable.getID() == id) {
+                found = &drawable;
+            }
+        });
+    }
+    return found;
+}
+
+bool CustomDrawableLayerHost::Interface::updateFill(const util::SimpleIdentity& id, const PreparedFillPtr& fill) {
+    gfx::Drawable* drawable = findDrawable(id);
+    if (!drawable || !fill) {
+        return false;
+    }
+    drawable->updateVertexAttributes(fill->attributes(context),
+                                     fill->vertices->elements(),
+                                     gfx::Triangles(),
+                                     fill->indices,
+                                     fill->segments.data(),
+                                     fill->segments.size());
+    return true;
+}
+
+bool CustomDrawableLayerHost::Interface::updateSymbol(const util::SimpleIdentity& id,
+                                                      const GeometryCoordinate& point,
+                                                      const std::array<std::array<float, 2>, 2>& textureCoordinates) {
+    gfx::Drawable* drawable = findDrawable(id);
+    if (!drawable) {
+        return false;
+    }
+    const auto buffers = makeSymbolBuffers(point, textureCoordinates);
+    drawable->updateVertexAttributes(symbolAttributes(context, buffers.vertices),
+                                     buffers.vertices->elements(),
+                                     gfx::Triangles(),
+                                     buffers.indices,
+                                     buffers.segments.data(),
+                                     buffers.segments.size());
+    return true;
+}
+
+bool CustomDrawableLayerHost::Interface::updateGeometry(const util::SimpleIdentity& id,
+                                                        std::shared_ptr<gfx::VertexVector<GeometryVertex>> vertices,
+                                                        std::shared_ptr<gfx::IndexVector<gfx::Triangles>> indices) {
+    gfx::Drawable* drawable = findDrawable(id);
+    if (!drawable || !vertices || !indices) {
+        return false;
+    }
+    SegmentVector triangleSegments;
+    triangleSegments.emplace_back(0, 0, vertices->elements(), indices->elements());
+    drawable->updateVertexAttributes(geometryAttributes(context, vertices),
+                                     vertices->elements(),
+                                     gfx::Triangles(),
+                                     std::move(indices),
+                                     triangleSegments.data(),
+                                     triangleSegments.size());
+    return true;
+}
+
+bool CustomDrawableLayerHost::Interface::moveDrawable(const util::SimpleIdentity& id,
+                                                      std::optional<Point<double>> offset) {
+    gfx::Drawable* drawable = findDrawable(id);
+    if (!drawable) {
+        return false;
+    }
+    drawable->setOrigin(std::move(offset));
+    return true;
+}
+
 gfx::ShaderPtr CustomDrawableLayerHost::Interface::lineShaderDefault() const {
     gfx::ShaderGroupPtr shaderGroup = shaders.getShaderGroup("LineShader");
     assert(shaderGroup);
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <mbgl/style/evaluated_layout_cache.hpp>
 #include <mbgl/style/layer_impl.hpp>
 #include <mbgl/style/layers/fill_extrusion_layer.hpp>
 #include <mbgl/style/layers/fill_extrusion_layer_properties.hpp>
@@ -15,6 +16,7 @@ public:
     void stringifyLayout(rapidjson::Writer<rapidjson::StringBuffer>&) const override;
 
     Properties<>::Unevaluated layout;
+    EvaluatedLayoutCache<Properties<>::PossiblyEvaluated> evaluatedLayout;
     FillExtrusionPaintProperties::Transitionable paint;
 
     DECLARE_LAYER_TYPE_INFO;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <mbgl/style/evaluated_layout_cache.hpp>
 #include <mbgl/style/layer_impl.hpp>
 #include <mbgl/style/layers/fill_layer.hpp>
 #include <mbgl/style/layers/fill_layer_properties.hpp>
@@ -15,6 +16,7 @@ public:
     void stringifyLayout(rapidjson::Writer<rapidjson::StringBuffer>&) const override;
 
     FillLayoutProperties::Unevaluated layout;
+    EvaluatedLayoutCache<FillLayoutProperties::PossiblyEvaluated> evaluatedLayout;
     FillPaintProperties::Transitionable paint;
 
     DECLARE_LAYER_TYPE_INFO;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <mbgl/style/evaluated_layout_cache.hpp>
 #include <mbgl/style/layer_impl.hpp>
 #include <mbgl/style/layers/line_layer.hpp>
 #include <mbgl/style/layers/line_layer_properties.hpp>
@@ -19,6 +20,7 @@ public:
     }
 
     LineLayoutProperties::Unevaluated layout;
+    EvaluatedLayoutCache<LineLayoutProperties::PossiblyEvaluated> evaluatedLayout;
     LinePaintProperties::Transitionable paint;
 
     DECLARE_LAYER_TYPE_INFO;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <mbgl/style/evaluated_layout_cache.hpp>
 #include <mbgl/style/layer_impl.hpp>
 #include <mbgl/style/layers/symbol_layer.hpp>
 #include <mbgl/style/layers/symbol_layer_properties.hpp>
@@ -130,6 +131,7 @@ public:
     void populateFontStack(std::set<FontStack>& fontStack) const final;
 
     SymbolLayoutProperties::Unevaluated layout;
+    EvaluatedLayoutCache<SymbolLayoutProperties::PossiblyEvaluated> evaluatedLayout;
     SymbolPaintProperties::Transitionable paint;
 
     DECLARE_LAYER_TYPE_INFO;
@@ -1,4 +1,5 @@
 #include <mbgl/style/parser.hpp>
+#include <mbgl/layermanager/layer_manager.hpp>
 #include <mbgl/style/layer_impl.hpp>
 #include <mbgl/style/rapidjson_conversion.hpp>
 #include <mbgl/style/conversion/coordinate.hpp>
@@ -10,6 +11,7 @@
 #include <mbgl/style/conversion_impl.hpp>
 
 #include <mbgl/util/logging.hpp>
+#include <mbgl/util/parallel_for.hpp>
 #include <mbgl/util/string.hpp>
 #include <mbgl/util/convert.hpp>
 
@@ -19,13 +21,73 @@
 #include <rapidjson/error/en.h>
 
 #include <algorithm>
+#include <functional>
+#include <list>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <set>
 #include <unordered_set>
+#include <utility>
 
 namespace mbgl {
 namespace style {
 
+namespace {
+
+// Styles with fewer layers are parsed quickly enough without the cache
+constexpr std::size_t minCachedLayers = 64;
+
+// Layers converted on the calling thread alone below this count
+constexpr std::size_t minParallelLayers = 32;
+
+// The layers of recently parsed large styles, so that parsing the same style again, for another
+// map or when switching back to it, shares their impls instead of converting every property and
+// expression again.
+class ParsedLayerCache {
+public:
+    using Layers = std::vector<Immutable<Layer::Impl>>;
+
+    static ParsedLayerCache& get() {
+        static ParsedLayerCache cache;
+        return cache;
+    }
+
+    std::optional<Layers> find(std::size_t hash, const std::string& json) {
+        std::scoped_lock lock(mutex);
+        for (auto it = entries.begin(); it != entries.end(); ++it) {
+            if (it->hash == hash && it->json == json) {
+                entries.splice(entries.begin(), entries, it);
+                return it->layers;
+            }
+        }
+        return std::nullopt;
+    }
+
+    void insert(std::size_t hash, const std::string& json, Layers layers) {
+        std::scoped_lock lock(mutex);
+        entries.push_front({hash, json, std::move(layers)});
+        if (entries.size() > capacity) {
+            entries.pop_back();
+        }
+    }
+
+private:
+    static constexpr std::size_t capacity = 4;
+
+    struct Entry {
+        std::size_t hash;
+        std::string json;
+        Layers layers;
+    };
+
+    std::mutex mutex;
+    // Most recently used first
+    std::list<Entry> entries;
+};
+
+} // namespace
+
 Parser::~Parser() = default;
 
 StyleParseResult Parser::parse(const std::string& json) {
@@ -117,7 +179,18 @@ StyleParseResult Parser::parse(const std::string& json) {
     }
 
     if (document.HasMember("layers")) {
-        parseLayers(document["layers"]);
+        const auto hash = std::hash<std::string>()(json);
+        if (!restoreLayers(hash, json)) {
+            parseLayers(document["layers"]);
+            if (layers.size() >= minCachedLayers) {
+                ParsedLayerCache::Layers impls;
+                impls.reserve(layers.size());
+                for (const auto& layer : layers) {
+                    impls.emplace_back(layer->baseImpl);
+                }
+                ParsedLayerCache::get().insert(hash, json, std::move(impls));
+            }
+        }
     }
 
     if (document.HasMember("sprite")) {
@@ -291,6 +364,24 @@ void Parser::parseSprites(const JSValue& value) {
     }
 }
 
+bool Parser::restoreLayers(std::size_t hash, const std::string& json) {
+    const auto impls = ParsedLayerCache::get().find(hash, json);
+    if (!impls) {
+        return false;
+    }
+
+    layers.reserve(impls->size());
+    for (const auto& impl : *impls) {
+        auto layer = LayerManager::get()->createLayer(impl);
+        if (!layer) {
+            layers.clear();
+            return false;
+        }
+        layers.emplace_back(std::move(layer));
+    }
+    return true;
+}
+
 void Parser::parseLayers(const JSValue& value) {
     std::vector<std::string> ids;
 
@@ -326,6 +417,8 @@ void Parser::parseLayers(const JSValue& value) {
         ids.push_back(layerID);
     }
 
+    convertLayers(ids);
+
     for (const auto& id : ids) {
         auto it = layersMap.find(id);
 
@@ -341,6 +434,38 @@ void Parser::parseLayers(const JSValue& value) {
     }
 }
 
+void Parser::convertLayers(const std::vector<std::string>& ids) {
+    // Layers with a `ref` are cloned from the layer they reference afterwards, in parseLayer
+    std::vector<std::pair<const JSValue*, std::unique_ptr<Layer>*>> pending;
+    for (const auto& id : ids) {
+        auto& entry = layersMap.find(id)->second;
+        if (!entry.first.HasMember("ref")) {
+            pending.emplace_back(&entry.first, &entry.second);
+        }
+    }
+    if (pending.size() < minParallelLayers) {
+        return;
+    }
+
+    // The errors are logged by parseLayer, in layer order, rather than as the conversions finish
+    std::vector<std::optional<std::string>> errors(pending.size());
+    util::parallelFor(pending.size(), [&](std::size_t i) {
+        conversion::Error error;
+        auto converted = conversion::convert<std::unique_ptr<Layer>>(*pending[i].first, error);
+        if (converted) {
+            *pending[i].second = std::move(*converted);
+        } else {
+            errors[i] = std::move(error.message);
+        }
+    });
+
+    for (std::size_t i = 0; i < pending.size(); ++i) {
+        if (errors[i]) {
+            conversionErrors.emplace(pending[i].first, std::move(*errors[i]));
+        }
+    }
+}
+
 void Parser::parseLayer(const std::string& id, const JSValue& value, std::unique_ptr<Layer>& layer) {
     if (layer) {
         // Skip parsing this again. We already have a valid layer definition.
@@ -380,6 +505,9 @@ void Parser::parseLayer(const std::string& id, const JSValue& value, std::unique
 
         layer = reference->cloneRef(id);
         conversion::setPaintProperties(*layer, conversion::Convertible(&value));
+    } else if (auto it = conversionErrors.find(&value); it != conversionErrors.end()) {
+        Log::Warning(Event::ParseStyle, it->second);
+        conversionErrors.erase(it);
     } else {
         conversion::Error error;
         std::optional<std::unique_ptr<Layer>> converted = conversion::convert<std::unique_ptr<Layer>>(value, error);
@@ -56,10 +56,16 @@ private:
     void parseLight(const JSValue&);
     void parseSources(const JSValue&);
     void parseSprites(const JSValue&);
+    // Takes the layers of the same style parsed before, if they're still cached
+    bool restoreLayers(std::size_t hash, const std::string& json);
     void parseLayers(const JSValue&);
+    // Converts the layers without a `ref` of large styles concurrently, ahead of parseLayer
+    void convertLayers(const std::vector<std::string>& ids);
     void parseLayer(const std::string& id, const JSValue&, std::unique_ptr<Layer>&);
 
     std::unordered_map<std::string, std::pair<const JSValue&, std::unique_ptr<Layer>>> layersMap;
+    // Errors of the layers that convertLayers failed to convert, reported by parseLayer
+    std::unordered_map<const JSValue*, std::string> conversionErrors;
 
     // Store a stack of layer IDs we're parsing right now. This is to prevent reference cycles.
     std::forward_list<std::string> stack;
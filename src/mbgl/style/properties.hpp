@@ -311,7 +311,7 @@ public:
             using Evaluator = typename P::EvaluatorType;
             const auto& property = this->template get<P>();
             const bool needEvaluate = parameters.layerChanged || parameters.hasCrossfade || property.hasTransition() ||
-                                      (parameters.zoomChanged && (getDependencies(property) & Dependency::Zoom));
+                                      (parameters.zoomChanged && isZoomDependent(property));
             return needEvaluate ? property.evaluate(Evaluator(parameters, P::defaultValue()), parameters.now)
                                 : oldResult;
         }
@@ -338,6 +338,14 @@ public:
             return result;
         }
 
+        /// Whether a change of zoom may change the possibly-evaluated values. Expressions that depend on the
+        /// feature are possibly-evaluated to themselves whatever the zoom, see `DataDrivenPropertyEvaluator`.
+        bool isZoomDependent() const noexcept {
+            bool result = false;
+            util::ignore({result |= isZoomDependent(this->template get<Ps>())...});
+            return result;
+        }
+
         using GPUExpressions = std::array<gfx::UniqueGPUExpression, UnevaluatedTypes::TypeCount>;
 
         /// Update the GPU expressions, if applicable, for each item in the tuple.
@@ -360,6 +368,22 @@ public:
             return v.getValue().getDependencies();
         }
 
+        template <class V>
+        static bool isZoomDependent(const V& v) noexcept {
+            return v.getDependencies() & Dependency::Zoom;
+        }
+
+        template <class P>
+        static bool isZoomDependent(const PropertyValue<P>& v) noexcept {
+            return (v.getDependencies() & Dependency::Zoom) &&
+                   (!v.isExpression() || v.asExpression().isFeatureConstant());
+        }
+
+        template <class P>
+        static bool isZoomDependent(const Transitioning<P>& v) noexcept {
+            return isZoomDependent(v.getValue());
+        }
+
         template <typename P>
         bool updateGPUExpression(Unevaluated::GPUExpressions& exprs, TimePoint now) const {
             constexpr auto index = TypeIndex<P, Ps...>::value;
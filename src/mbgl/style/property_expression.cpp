@@ -1,5 +1,6 @@
 #include <mbgl/style/property_expression.hpp>
 
+#include <mbgl/platform/settings.hpp>
 #include <mbgl/renderer/paint_property_binder.hpp>
 #include <mbgl/util/convert.hpp>
 
@@ -15,10 +16,24 @@ bool checkGPUCapable(const Expression& expression, const ZoomCurvePtr& zoomCurve
     return (expression.dependencies == Dependency::Zoom) && !zoomCurve.is<std::nullptr_t>() &&
            (expression.getType().is<type::NumberType>() || expression.getType().is<type::ColorType>());
 }
+
+// Define MLN_EXPRESSION_NO_BYTECODE, or set EXPRESSION_TREE_EVALUATION, to always evaluate the expression tree
+std::unique_ptr<Bytecode> compileBytecode([[maybe_unused]] const Expression& expression) {
+#if defined(MLN_EXPRESSION_NO_BYTECODE)
+    return {};
+#else
+    const auto value = platform::Settings::getInstance().get(platform::EXPRESSION_TREE_EVALUATION);
+    if (const auto* treeEvaluation = value.getBool(); treeEvaluation && *treeEvaluation) {
+        return {};
+    }
+    return Bytecode::compile(expression);
+#endif
+}
 } // namespace
 
 PropertyExpressionBase::PropertyExpressionBase(std::unique_ptr<expression::Expression> expression_)
     : expression(std::move(expression_)),
+      bytecode(compileBytecode(*expression)),
       zoomCurve(expression->has(Dependency::Zoom) ? expression::findZoomCurveChecked(*expression) : nullptr),
       useIntegerZoom_(false),
       isZoomConstant_(!expression->has(Dependency::Zoom)),
@@ -32,6 +47,7 @@ PropertyExpressionBase::PropertyExpressionBase(std::unique_ptr<expression::Expre
 
 PropertyExpressionBase::PropertyExpressionBase(PropertyExpressionBase&& other)
     : expression(std::move(other.expression)),
+      bytecode(std::move(other.bytecode)),
       zoomCurve(std::move(other.zoomCurve)),
       useIntegerZoom_(other.useIntegerZoom_),
       isZoomConstant_(other.isZoomConstant_),
@@ -41,6 +57,7 @@ PropertyExpressionBase::PropertyExpressionBase(PropertyExpressionBase&& other)
 
 PropertyExpressionBase::PropertyExpressionBase(const PropertyExpressionBase& other)
     : expression(other.expression),
+      bytecode(other.bytecode),
       zoomCurve(other.zoomCurve),
       useIntegerZoom_(other.useIntegerZoom_),
       isZoomConstant_(other.isZoomConstant_),
@@ -50,6 +67,7 @@ PropertyExpressionBase::PropertyExpressionBase(const PropertyExpressionBase& oth
 
 PropertyExpressionBase& PropertyExpressionBase::operator=(PropertyExpressionBase&& other) {
     expression = std::move(other.expression);
+    bytecode = std::move(other.bytecode);
     zoomCurve = other.zoomCurve;
     useIntegerZoom_ = other.useIntegerZoom_;
     isZoomConstant_ = other.isZoomConstant_;
@@ -61,6 +79,7 @@ PropertyExpressionBase& PropertyExpressionBase::operator=(PropertyExpressionBase
 
 PropertyExpressionBase& PropertyExpressionBase::operator=(const PropertyExpressionBase& other) {
     expression = other.expression;
+    bytecode = other.bytecode;
     zoomCurve = other.zoomCurve;
     useIntegerZoom_ = other.useIntegerZoom_;
     isZoomConstant_ = other.isZoomConstant_;
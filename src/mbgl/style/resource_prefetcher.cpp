@@ -0,0 +1,245 @@
+#include <mbgl/style/resource_prefetcher.hpp>
+
+#include <mbgl/storage/response.hpp>
+#include <mbgl/util/async_request.hpp>
+#include <mbgl/util/font_stack.hpp>
+#include <mbgl/util/instrumentation.hpp>
+#include <mbgl/util/mapbox.hpp>
+#include <mbgl/util/rapidjson.hpp>
+
+#include <cassert>
+#include <chrono>
+#include <optional>
+#include <set>
+
+namespace mbgl {
+namespace style {
+
+namespace {
+
+// Long enough for the style to be parsed and its sources created, even on a slow device
+constexpr Duration prefetchLifetime = std::chrono::seconds(30);
+
+std::optional<std::string> getString(const JSValue& object, const char* name) {
+    const auto it = object.FindMember(name);
+    if (it == object.MemberEnd() || !it->value.IsString()) {
+        return std::nullopt;
+    }
+    return std::string{it->value.GetString(), it->value.GetStringLength()};
+}
+
+// The font stacks the symbol layers spell out, without evaluating the expressions of the others
+std::set<FontStack> literalFontStacks(const JSValue& layers) {
+    std::set<FontStack> fontStacks;
+    for (const auto& layer : layers.GetArray()) {
+        if (!layer.IsObject()) {
+            continue;
+        }
+        const auto layout = layer.FindMember("layout");
+        if (layout == layer.MemberEnd() || !layout->value.IsObject()) {
+            continue;
+        }
+        const auto font = layout->value.FindMember("text-font");
+        if (font == layout->value.MemberEnd() || !font->value.IsArray() || font->value.Empty()) {
+            continue;
+        }
+        FontStack fontStack;
+        for (const auto& name : font->value.GetArray()) {
+            if (!name.IsString()) {
+                fontStack.clear();
+                break;
+            }
+            fontStack.emplace_back(name.GetString(), name.GetStringLength());
+        }
+        if (!fontStack.empty()) {
+            fontStacks.insert(std::move(fontStack));
+        }
+    }
+    return fontStacks;
+}
+
+} // namespace
+
+/// A prefetch, and once taken over the request of a loader
+class ResourcePrefetcher::Prefetch final : public AsyncRequest {
+public:
+    void start(FileSource& fileSource, const Resource& resource) {
+        request = fileSource.request(resource, [this](Response res) { receive(std::move(res)); });
+    }
+
+    void takeOver(Callback callback_) {
+        callback = std::move(callback_);
+        if (response) {
+            // Callbacks are never called from within `request`
+            delivery.start(Duration::zero(), Duration::zero(), [this] {
+                if (response) {
+                    auto res = std::move(*response);
+                    response.reset();
+                    callback(std::move(res));
+                }
+            });
+        }
+    }
+
+private:
+    void receive(Response res) {
+        if (callback && !response) {
+            callback(std::move(res));
+        } else {
+            // Only the latest response matters, as the loaders would have seen it
+            response = std::move(res);
+        }
+    }
+
+    std::unique_ptr<AsyncRequest> request;
+    /// The latest response not passed on yet
+    std::optional<Response> response;
+    Callback callback;
+    util::Timer delivery;
+};
+
+ResourcePrefetcher::ResourcePrefetcher(std::shared_ptr<FileSource> upstream_, float pixelRatio_)
+    : upstream(std::move(upstream_)),
+      pixelRatio(pixelRatio_) {
+    assert(upstream);
+}
+
+ResourcePrefetcher::~ResourcePrefetcher() = default;
+
+void ResourcePrefetcher::prefetch(const std::string& json) {
+    MLN_TRACE_FUNC();
+
+    clear();
+
+    // Errors are left to the style parser to report
+    JSDocument document;
+    document.Parse<0>(json.c_str());
+    if (document.HasParseError() || !document.IsObject()) {
+        return;
+    }
+
+    if (const auto sprite = document.FindMember("sprite"); sprite != document.MemberEnd()) {
+        const auto addSprite = [&](const std::string& url) {
+            add(Resource::spriteJSON(url, pixelRatio));
+            add(Resource::spriteImage(url, pixelRatio));
+        };
+        if (sprite->value.IsString()) {
+            addSprite({sprite->value.GetString(), sprite->value.GetStringLength()});
+        } else if (sprite->value.IsArray()) {
+            for (const auto& entry : sprite->value.GetArray()) {
+                if (entry.IsObject()) {
+                    if (const auto url = getString(entry, "url")) {
+                        addSprite(*url);
+                    }
+                }
+            }
+        }
+    }
+
+    if (const auto sources = document.FindMember("sources");
+        sources != document.MemberEnd() && sources->value.IsObject()) {
+        const auto& tileServerOptions = upstream->getResourceOptions().tileServerOptions();
+        for (const auto& source : sources->value.GetObject()) {
+            if (!source.value.IsObject()) {
+                continue;
+            }
+            if (getString(source.value, "type") == "geojson") {
+                if (const auto data = getString(source.value, "data")) {
+                    add(Resource::source(*data));
+                }
+            } else if (const auto url = getString(source.value, "url")) {
+                add(Resource::source(util::mapbox::canonicalizeSourceURL(tileServerOptions, *url)));
+            }
+        }
+    }
+
+    if (upstream->supportsCacheOnlyRequests()) {
+        const auto glyphURL = getString(document, "glyphs");
+        const auto layers = document.FindMember("layers");
+        if (glyphURL && layers != document.MemberEnd() && layers->value.IsArray()) {
+            for (const auto& fontStack : literalFontStacks(layers->value)) {
+                const auto resource = Resource::glyphs(*glyphURL, fontStack, {0, 255});
+                warming.push_back(upstream->request(resource, [](const Response&) {}));
+            }
+        }
+    }
+
+    expiry.start(prefetchLifetime, Duration::zero(), [this] { clear(); });
+}
+
+void ResourcePrefetcher::add(const Resource& resource) {
+    auto& prefetch = prefetches[{resource.kind, resource.url}];
+    if (!prefetch) {
+        prefetch = std::make_unique<Prefetch>();
+        prefetch->start(*upstream, resource);
+    }
+}
+
+void ResourcePrefetcher::clear() {
+    prefetches.clear();
+    warming.clear();
+    expiry.stop();
+}
+
+std::unique_ptr<AsyncRequest> ResourcePrefetcher::request(const Resource& resource, Callback callback) {
+    if (!prefetches.empty()) {
+        if (auto it = prefetches.find({resource.kind, resource.url}); it != prefetches.end()) {
+            auto prefetch = std::move(it->second);
+            prefetches.erase(it);
+            prefetch->takeOver(std::move(callback));
+            return prefetch;
+        }
+    }
+    return upstream->request(resource, std::move(callback));
+}
+
+void ResourcePrefetcher::forward(const Resource& resource, const Response& response, std::function<void()> callback) {
+    upstream->forward(resource, response, std::move(callback));
+}
+
+bool ResourcePrefetcher::supportsCacheOnlyRequests() const {
+    return upstream->supportsCacheOnlyRequests();
+}
+
+bool ResourcePrefetcher::canRequest(const Resource& resource) const {
+    return upstream->canRequest(resource);
+}
+
+void ResourcePrefetcher::pause() {
+    upstream->pause();
+}
+
+void ResourcePrefetcher::resume() {
+    upstream->resume();
+}
+
+void ResourcePrefetcher::setProperty(const std::string& key, const mapbox::base::Value& value) {
+    upstream->setProperty(key, value);
+}
+
+mapbox::base::Value ResourcePrefetcher::getProperty(const std::string& key) const {
+    return upstream->getProperty(key);
+}
+
+void ResourcePrefetcher::setResourceTransform(ResourceTransform transform) {
+    upstream->setResourceTransform(std::move(transform));
+}
+
+void ResourcePrefetcher::setResourceOptions(ResourceOptions options) {
+    upstream->setResourceOptions(std::move(options));
+}
+
+ResourceOptions ResourcePrefetcher::getResourceOptions() {
+    return upstream->getResourceOptions();
+}
+
+void ResourcePrefetcher::setClientOptions(ClientOptions options) {
+    upstream->setClientOptions(std::move(options));
+}
+
+ClientOptions ResourcePrefetcher::getClientOptions() {
+    return upstream->getClientOptions();
+}
+
+} // namespace style
+} // namespace mbgl
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <mbgl/storage/file_source.hpp>
+#include <mbgl/storage/resource.hpp>
+#include <mbgl/util/timer.hpp>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace mbgl {
+namespace style {
+
+/**
+ * @brief Requests the resources a style loads before its parsing is done, see EXPERIMENTAL_STYLE_RESOURCE_PREFETCH.
+ *
+ * Passes requests on to another file source. The sprites and TileJSON of a style are requested from a quick scan
+ * of its JSON, and the first request for one of them takes over the prefetch, answered or still in flight, so the
+ * loaders don't wait for the style to be parsed and its sources created. The first glyph range of the font stacks
+ * the style spells out is requested too, to warm the cache of the file sources that have one: the renderer
+ * requests glyphs through the map's file source, from its own thread.
+ */
+class ResourcePrefetcher final : public FileSource {
+public:
+    ResourcePrefetcher(std::shared_ptr<FileSource> upstream, float pixelRatio);
+    ~ResourcePrefetcher() override;
+
+    /// Drops what wasn't taken over from the previous style, and requests the resources of the given one
+    void prefetch(const std::string& json);
+
+    std::unique_ptr<AsyncRequest> request(const Resource&, Callback) override;
+    void forward(const Resource&, const Response&, std::function<void()>) override;
+    bool supportsCacheOnlyRequests() const override;
+    bool canRequest(const Resource&) const override;
+    void pause() override;
+    void resume() override;
+    void setProperty(const std::string&, const mapbox::base::Value&) override;
+    mapbox::base::Value getProperty(const std::string&) const override;
+    void setResourceTransform(ResourceTransform) override;
+    void setResourceOptions(ResourceOptions) override;
+    ResourceOptions getResourceOptions() override;
+    void setClientOptions(ClientOptions) override;
+    ClientOptions getClientOptions() override;
+
+private:
+    class Prefetch;
+
+    void add(const Resource&);
+    void clear();
+
+    const std::shared_ptr<FileSource> upstream;
+    const float pixelRatio;
+
+    std::map<std::pair<Resource::Kind, std::string>, std::unique_ptr<Prefetch>> prefetches;
+    /// Requests only made to fill the cache, their responses are ignored
+    std::vector<std::unique_ptr<AsyncRequest>> warming;
+    /// Drops what's left once the loaders had time to take it over
+    util::Timer expiry;
+};
+
+} // namespace style
+} // namespace mbgl
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <mbgl/style/conversion_impl.hpp>
+#include <mbgl/style/conversion/geojson.hpp>
+
+#include <simdjson.h>
+
+#include <cassert>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace mbgl {
+namespace style {
+namespace conversion {
+
+/// Converts out of a simdjson DOM, see MLN_WITH_SIMDJSON. The elements refer to the document of the parser that
+/// produced them, which has to outlive the conversion. Members of arrays are found by walking the array, as those
+/// of objects are by rapidjson, so indexing is linear in the index.
+template <>
+class ConversionTraits<simdjson::dom::element> {
+public:
+    static bool isUndefined(const simdjson::dom::element& value) { return value.is_null(); }
+
+    static bool isArray(const simdjson::dom::element& value) { return value.is_array(); }
+
+    static std::size_t arrayLength(const simdjson::dom::element& value) {
+        return value.get_array().value_unsafe().size();
+    }
+
+    static simdjson::dom::element arrayMember(const simdjson::dom::element& value, std::size_t i) {
+        return value.get_array().value_unsafe().at(i).value_unsafe();
+    }
+
+    static bool isObject(const simdjson::dom::element& value) { return value.is_object(); }
+
+    static std::optional<simdjson::dom::element> objectMember(const simdjson::dom::element& value, const char* name) {
+        simdjson::dom::element member;
+        if (value.get_object().value_unsafe().at_key(name).get(member) != simdjson::SUCCESS) {
+            return {};
+        }
+        return {member};
+    }
+
+    template <class Fn>
+    static std::optional<Error> eachMember(const simdjson::dom::element& value, Fn&& fn) {
+        assert(value.is_object());
+        for (const auto& [key, member] : value.get_object().value_unsafe()) {
+            std::optional<Error> result = fn(std::string(key), member);
+            if (result) {
+                return result;
+            }
+        }
+        return {};
+    }
+
+    static std::optional<bool> toBool(const simdjson::dom::element& value) {
+        bool result;
+        if (value.get_bool().get(result) != simdjson::SUCCESS) {
+            return {};
+        }
+        return result;
+    }
+
+    static std::optional<float> toNumber(const simdjson::dom::element& value) {
+        double result;
+        if (value.get_double().get(result) != simdjson::SUCCESS) {
+            return {};
+        }
+        return static_cast<float>(result);
+    }
+
+    static std::optional<double> toDouble(const simdjson::dom::element& value) {
+        double result;
+        if (value.get_double().get(result) != simdjson::SUCCESS) {
+            return {};
+        }
+        return result;
+    }
+
+    static std::optional<std::string> toString(const simdjson::dom::element& value) {
+        std::string_view result;
+        if (value.get_string().get(result) != simdjson::SUCCESS) {
+            return {};
+        }
+        return {std::string(result)};
+    }
+
+    static std::optional<Value> toValue(const simdjson::dom::element& value) {
+        switch (value.type()) {
+            case simdjson::dom::element_type::NULL_VALUE:
+                return {false};
+
+            case simdjson::dom::element_type::BOOL:
+                return {value.get_bool().value_unsafe()};
+
+            case simdjson::dom::element_type::STRING:
+                return {std::string(value.get_string().value_unsafe())};
+
+            // Unsigned first, as rapidjson_conversion.hpp does, simdjson only reports integers past the range of
+            // int64_t as unsigned
+            case simdjson::dom::element_type::INT64: {
+                const int64_t number = value.get_int64().value_unsafe();
+                if (number >= 0) return {static_cast<uint64_t>(number)};
+                return {number};
+            }
+
+            case simdjson::dom::element_type::UINT64:
+                return {value.get_uint64().value_unsafe()};
+
+            case simdjson::dom::element_type::DOUBLE:
+                return {value.get_double().value_unsafe()};
+
+            default:
+                return {};
+        }
+    }
+
+    static std::optional<GeoJSON> toGeoJSON(const simdjson::dom::element& value, Error& error) {
+        // GeoJSON is read from rapidjson values by mapbox::geojson, and rarely goes through here: sources parse
+        // their data with parseGeoJSON, which stays on rapidjson.
+        return parseGeoJSON(simdjson::minify(value), error);
+    }
+};
+
+} // namespace conversion
+} // namespace style
+} // namespace mbgl
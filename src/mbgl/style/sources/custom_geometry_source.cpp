@@ -9,6 +9,7 @@
 #include <mbgl/style/sources/custom_geometry_source_impl.hpp>
 #include <mbgl/tile/tile.hpp>
 #include <mbgl/tile/tile_id.hpp>
+#include <mbgl/util/thread_pool.hpp>
 #include <tuple>
 
 namespace mbgl {
@@ -16,8 +17,9 @@ namespace style {
 
 CustomGeometrySource::CustomGeometrySource(std::string id, const CustomGeometrySource::Options& options)
     : Source(makeMutable<CustomGeometrySource::Impl>(std::move(id), options)),
+      threadPool(options.threadedFetch ? std::make_shared<ThreadPool>() : nullptr),
       loader(std::make_unique<Actor<CustomTileLoader>>(
-          Scheduler::GetBackground(), options.fetchTileFunction, options.cancelTileFunction)) {}
+          Scheduler::GetBackground(), options.fetchTileFunction, options.cancelTileFunction, threadPool)) {}
 
 CustomGeometrySource::~CustomGeometrySource() = default;
 
@@ -39,6 +41,16 @@ void CustomGeometrySource::setTileData(const CanonicalTileID& tileID, const GeoJ
     loader->self().invoke(&CustomTileLoader::setTileData, tileID, data);
 }
 
+void CustomGeometrySource::setTileData(const std::vector<std::pair<CanonicalTileID, GeoJSON>>& data) {
+    loader->self().invoke(&CustomTileLoader::setTilesData, data);
+}
+
+void CustomGeometrySource::setTileFeatures(const CanonicalTileID& tileID, TileFeatures features) {
+    loader->self().invoke(&CustomTileLoader::setTileFeatures,
+                          tileID,
+                          std::make_shared<const TileFeatures>(std::move(features)));
+}
+
 void CustomGeometrySource::invalidateTile(const CanonicalTileID& tileID) {
     loader->self().invoke(&CustomTileLoader::invalidateTile, tileID);
 }
@@ -1,6 +1,5 @@
 #include <mbgl/storage/file_source.hpp>
 #include <mbgl/style/conversion/geojson.hpp>
-#include <mbgl/style/conversion/json.hpp>
 #include <mbgl/style/layer.hpp>
 #include <mbgl/style/source_observer.hpp>
 #include <mbgl/style/sources/geojson_source.hpp>
@@ -51,6 +50,20 @@ void GeoJSONSource::setGeoJSONData(std::shared_ptr<GeoJSONData> geoJSONData) {
     observer->onSourceChanged(*this);
 }
 
+void GeoJSONSource::updateGeoJSON(const GeoJSONDiff& diff) {
+    auto current = impl().getData().lock();
+    if (!current) {
+        setGeoJSON(diff.add);
+        return;
+    }
+
+    if (auto updated = current->update(diff, sequencedScheduler, impl().getOptions())) {
+        setGeoJSONData(std::move(updated));
+    } else {
+        Log::Warning(Event::General, "GeoJSON source '" + impl().id + "' can only be updated when set to features");
+    }
+}
+
 std::optional<std::string> GeoJSONSource::getURL() const {
     return url;
 }
@@ -88,10 +101,9 @@ void GeoJSONSource::loadDescription(FileSource& fileSource) {
                     assert(data);
                     auto& current = static_cast<const Impl&>(*currentImpl);
                     conversion::Error error;
-                    std::shared_ptr<GeoJSONData> geoJSONData;
-                    if (std::optional<GeoJSON> geoJSON = conversion::convertJSON<GeoJSON>(*data, error)) {
-                        geoJSONData = GeoJSONData::create(*geoJSON, std::move(seqScheduler), current.getOptions());
-                    } else {
+                    std::shared_ptr<GeoJSONData> geoJSONData = GeoJSONData::parse(
+                        *data, std::move(seqScheduler), current.getOptions(), error);
+                    if (!geoJSONData) {
                         // Create an empty GeoJSON VT object to make sure we're not
                         // infinitely waiting for tiles to load.
                         Log::Error(Event::ParseStyle, "Failed to parse GeoJSON data: " + error.message);
@@ -1,3 +1,4 @@
+#include <mbgl/style/conversion/geojson.hpp>
 #include <mbgl/style/sources/geojson_source_impl.hpp>
 #include <mbgl/tile/tile_id.hpp>
 #include <mbgl/util/constants.hpp>
@@ -5,6 +6,10 @@
 #include <mbgl/util/string.hpp>
 #include <mbgl/util/thread_pool.hpp>
 #include <mbgl/util/identity.hpp>
+#include <mbgl/util/parallel_for.hpp>
+#include <mbgl/math/clamp.hpp>
+
+#include <mapbox/geometry/envelope.hpp>
 
 #ifdef _MSC_VER
 #pragma warning(push)
@@ -18,21 +23,238 @@
 #pragma warning(pop)
 #endif
 
+#include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <condition_variable>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
 
 namespace mbgl {
 namespace style {
 
+namespace {
+
+using GeoJSONFeature = GeoJSONData::Features::value_type;
+using Box = mapbox::geometry::box<double>;
+
+mapbox::geojsonvt::Options makeTileIndexOptions(const GeoJSONOptions& options) {
+    constexpr double scale = util::EXTENT / util::tileSize_D;
+    mapbox::geojsonvt::Options vtOptions;
+    vtOptions.maxZoom = options.maxzoom;
+    vtOptions.extent = util::EXTENT;
+    vtOptions.buffer = static_cast<uint16_t>(::round(scale * options.buffer));
+    vtOptions.tolerance = scale * options.tolerance;
+    vtOptions.lineMetrics = options.lineMetrics;
+    return vtOptions;
+}
+
+// Projects to the unit square covered by the zoom 0 tile, the same way geojson-vt does
+double projectX(double lng) {
+    return lng / 360.0 + 0.5;
+}
+
+double projectY(double lat) {
+    const double sine = std::sin(lat * M_PI / 180.0);
+    return util::clamp(0.5 - 0.25 * std::log((1.0 + sine) / (1.0 - sine)) / M_PI, 0.0, 1.0);
+}
+
+void addProjectedBounds(std::vector<Box>& boxes, const GeoJSONFeature& feature) {
+    const auto bounds = mapbox::geometry::envelope(feature.geometry);
+    if (bounds.min.x > bounds.max.x) {
+        return; // Empty geometry
+    }
+    boxes.push_back(
+        {{projectX(bounds.min.x), projectY(bounds.max.y)}, {projectX(bounds.max.x), projectY(bounds.min.y)}});
+}
+
+// Merges the boxes into their bounds once there are more than is worth testing tiles against
+void limitBoxes(std::vector<Box>& boxes) {
+    constexpr std::size_t maxBoxes = 1024;
+    if (boxes.size() <= maxBoxes) {
+        return;
+    }
+
+    Box bounds = boxes.front();
+    for (const auto& box : boxes) {
+        bounds.min.x = std::min(bounds.min.x, box.min.x);
+        bounds.min.y = std::min(bounds.min.y, box.min.y);
+        bounds.max.x = std::max(bounds.max.x, box.max.x);
+        bounds.max.y = std::max(bounds.max.y, box.max.y);
+    }
+    boxes = {bounds};
+}
+
+// The changes of a diff keyed by feature id. Features without an id can be added, but not
+// updated or removed.
+class FeatureChanges {
+public:
+    explicit FeatureChanges(const GeoJSONDiff& diff_)
+        : diff(diff_) {
+        for (const auto& id : diff.remove) {
+            if (!id.is<NullValue>()) {
+                changes[id].remove = true;
+            }
+        }
+        for (const auto& feature : diff.update) {
+            if (!feature.id.is<NullValue>()) {
+                changes[feature.id].update = &feature;
+            }
+        }
+        for (const auto& feature : diff.add) {
+            if (!feature.id.is<NullValue>()) {
+                changes[feature.id].add = &feature;
+            }
+        }
+    }
+
+    // Returns the features with removals and replacements applied, nothing if none of them
+    // matched. The bounds of the features that changed are added to `changed`.
+    std::optional<GeoJSONData::Features> apply(const GeoJSONData::Features& features, std::vector<Box>& changed) {
+        std::optional<GeoJSONData::Features> result;
+        if (changes.empty()) {
+            return result;
+        }
+
+        for (std::size_t i = 0; i < features.size(); ++i) {
+            const auto& feature = features[i];
+            const auto it = feature.id.is<NullValue>() ? changes.end() : changes.find(feature.id);
+            if (it == changes.end()) {
+                if (result) {
+                    result->push_back(feature);
+                }
+                continue;
+            }
+
+            if (!result) {
+                result.emplace();
+                result->reserve(features.size());
+                result->insert(result->end(), features.begin(), features.begin() + i);
+            }
+
+            auto& change = it->second;
+            addProjectedBounds(changed, feature);
+            if (change.remove) {
+                continue;
+            }
+            const auto& replacement = change.add ? *change.add : *change.update;
+            addProjectedBounds(changed, replacement);
+            result->push_back(replacement);
+            change.replaced = true;
+        }
+        return result;
+    }
+
+    // Appends the added features that didn't replace an existing one
+    void appendAdded(GeoJSONData::Features& features, std::vector<Box>& changed) const {
+        for (const auto& feature : diff.add) {
+            if (!feature.id.is<NullValue>()) {
+                const auto& change = changes.at(feature.id);
+                if (change.replaced || change.add != &feature) {
+                    continue;
+                }
+            }
+            addProjectedBounds(changed, feature);
+            features.push_back(feature);
+        }
+    }
+
+private:
+    struct Change {
+        bool remove = false;
+        bool replaced = false;
+        const GeoJSONFeature* update = nullptr;
+        const GeoJSONFeature* add = nullptr;
+    };
+
+    const GeoJSONDiff& diff;
+    std::map<FeatureIdentifier, Change> changes;
+};
+
+// A tile index built by a background task, or by the thread that needs it if the task hasn't
+// started by then, so that waiting for it never depends on the pool having a thread to spare.
+// A failed build is rethrown to the thread waiting for the index.
+class PendingTileIndex {
+public:
+    PendingTileIndex(std::shared_ptr<const GeoJSON> geoJSON_, const mapbox::geojsonvt::Options& options_)
+        : geoJSON(std::move(geoJSON_)),
+          options(options_) {}
+
+    void build() {
+        if (claimed.exchange(true)) {
+            return;
+        }
+        std::shared_ptr<mapbox::geojsonvt::GeoJSONVT> built;
+        std::exception_ptr failure;
+        try {
+            built = std::make_shared<mapbox::geojsonvt::GeoJSONVT>(*geoJSON, options);
+        } catch (...) {
+            failure = std::current_exception();
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        index = std::move(built);
+        error = std::move(failure);
+        done = true;
+        ready.notify_all();
+    }
+
+    std::shared_ptr<mapbox::geojsonvt::GeoJSONVT> get() {
+        build();
+        std::unique_lock<std::mutex> lock(mutex);
+        ready.wait(lock, [&] { return done; });
+        if (error) {
+            std::rethrow_exception(error);
+        }
+        return index;
+    }
+
+    const std::shared_ptr<const GeoJSON> geoJSON;
+
+private:
+    const mapbox::geojsonvt::Options options;
+    std::atomic<bool> claimed{false};
+    std::mutex mutex;
+    std::condition_variable ready;
+    bool done = false;
+    std::shared_ptr<mapbox::geojsonvt::GeoJSONVT> index;
+    std::exception_ptr error;
+};
+
+} // namespace
+
 class GeoJSONVTData final : public GeoJSONData {
+    struct Partition {
+        // What the index was built from, kept to apply diffs to; null unless it's a feature collection
+        std::shared_ptr<const GeoJSON> geoJSON;
+        std::shared_ptr<mapbox::geojsonvt::GeoJSONVT> index;
+    };
+    using Partitions = std::vector<Partition>;
+
+    // The areas, in projected zoom 0 coordinates, of the features that changed since `base`
+    struct Revision {
+        std::weak_ptr<const GeoJSONData> base;
+        std::vector<Box> changed;
+    };
+
+    // Below this, splitting the collection costs more than building the index serially. Smaller
+    // partitions make diffs cheaper to apply, but tiles then have more indexes to be cut from.
+    static constexpr std::size_t minPartitionSize = 8192;
+    static constexpr std::size_t maxPartitions = 16;
+    // How many earlier versions a tile may have been loaded from and still be kept on a diff
+    static constexpr std::size_t maxRevisions = 4;
+
     void getTile(const CanonicalTileID& id, const std::function<void(TileFeatures)>& fn, bool runSynchronously) final {
         assert(fn);
         if (runSynchronously) {
-            fn(this->impl->getTile(id.z, id.x, id.y).features);
+            fn(getTileFeatures(*partitions, id));
         } else {
             sequencedScheduler->scheduleAndReplyValue(
                 util::SimpleIdentity::Empty,
-                [id, geoJSONVT_impl = this->impl]() -> TileFeatures {
-                    return geoJSONVT_impl->getTile(id.z, id.x, id.y).features;
+                [id, geoJSONVT_partitions = this->partitions]() -> TileFeatures {
+                    return getTileFeatures(*geoJSONVT_partitions, id);
                 },
                 fn);
         }
@@ -44,16 +266,170 @@ class GeoJSONVTData final : public GeoJSONData {
 
     std::uint8_t getClusterExpansionZoom(std::uint32_t) final { return 0; }
 
+    std::shared_ptr<GeoJSONData> update(const GeoJSONDiff& diff,
+                                        std::shared_ptr<Scheduler> sequencedScheduler_,
+                                        const Immutable<GeoJSONOptions>& options) final {
+        if (!partitions->front().geoJSON) {
+            return nullptr;
+        }
+
+        // Unchanged partitions keep their index, which is only ever used on the sequenced scheduler
+        auto updated = std::make_shared<Partitions>(*partitions);
+        std::vector<std::size_t> rebuilt;
+        std::vector<Box> changed;
+        FeatureChanges changes(diff);
+        for (std::size_t i = 0; i < updated->size(); ++i) {
+            if (auto features = changes.apply((*updated)[i].geoJSON->get<Features>(), changed)) {
+                (*updated)[i].geoJSON = std::make_shared<const GeoJSON>(std::move(*features));
+                rebuilt.push_back(i);
+            }
+        }
+
+        Features added;
+        changes.appendAdded(added, changed);
+        if (!added.empty()) {
+            const auto& last = updated->back().geoJSON->get<Features>();
+            if (last.size() >= minPartitionSize) {
+                updated->push_back({std::make_shared<const GeoJSON>(std::move(added)), nullptr});
+            } else {
+                added.insert(added.begin(), last.begin(), last.end());
+                updated->back().geoJSON = std::make_shared<const GeoJSON>(std::move(added));
+            }
+            if (rebuilt.empty() || rebuilt.back() != updated->size() - 1) {
+                rebuilt.push_back(updated->size() - 1);
+            }
+        }
+
+        if (options->cluster) {
+            // Clusters can't be kept apart, any change may affect the ones in every tile
+            Features features;
+            for (const auto& partition : *updated) {
+                const auto& partitionFeatures = partition.geoJSON->get<Features>();
+                features.insert(features.end(), partitionFeatures.begin(), partitionFeatures.end());
+            }
+            return GeoJSONData::create(std::move(features), std::move(sequencedScheduler_), options);
+        }
+
+        buildIndexes(*updated, rebuilt, makeTileIndexOptions(*options));
+        const auto isEmpty = [](const Partition& partition) {
+            return partition.geoJSON->get<Features>().empty();
+        };
+        if (!std::all_of(updated->begin(), updated->end(), isEmpty)) {
+            std::erase_if(*updated, isEmpty);
+        }
+
+        std::vector<Revision> updatedRevisions{{weak_from_this(), changed}};
+        for (const auto& revision : revisions) {
+            if (updatedRevisions.size() == maxRevisions) {
+                break;
+            }
+            auto& merged = updatedRevisions.emplace_back(revision);
+            merged.changed.insert(merged.changed.end(), changed.begin(), changed.end());
+        }
+        for (auto& revision : updatedRevisions) {
+            limitBoxes(revision.changed);
+        }
+
+        return std::shared_ptr<GeoJSONData>(
+            new GeoJSONVTData(std::move(updated), std::move(updatedRevisions), buffer, std::move(sequencedScheduler_)));
+    }
+
+    bool isTileChanged(const GeoJSONData& previous, const CanonicalTileID& id) const final {
+        for (const auto& revision : revisions) {
+            if (revision.base.lock().get() != &previous) {
+                continue;
+            }
+
+            const double size = std::ldexp(1.0, -id.z);
+            const double margin = size * buffer;
+            const Box tile{{id.x * size - margin, id.y * size - margin},
+                           {(id.x + 1) * size + margin, (id.y + 1) * size + margin}};
+            return std::any_of(revision.changed.begin(), revision.changed.end(), [&](const Box& box) {
+                if (box.min.y > tile.max.y || box.max.y < tile.min.y) {
+                    return false;
+                }
+                // Features within the buffer of the antimeridian are also cut into the tiles on its other side
+                for (const double shift : {-1.0, 0.0, 1.0}) {
+                    if (box.min.x + shift <= tile.max.x && box.max.x + shift >= tile.min.x) {
+                        return true;
+                    }
+                }
+                return false;
+            });
+        }
+        return true;
+    }
+
+    // Features are clipped and simplified independently of one another, so a tile of the whole
+    // collection is the concatenation of the same tile in each partition, in partition order.
+    static TileFeatures getTileFeatures(const Partitions& partitions_, const CanonicalTileID& id) {
+        if (partitions_.size() == 1) {
+            return partitions_.front().index->getTile(id.z, id.x, id.y).features;
+        }
+
+        TileFeatures features;
+        for (const auto& partition : partitions_) {
+            const auto& partitionFeatures = partition.index->getTile(id.z, id.x, id.y).features;
+            features.insert(features.end(), partitionFeatures.begin(), partitionFeatures.end());
+        }
+        return features;
+    }
+
+    static void buildIndexes(Partitions& partitions_,
+                             const std::vector<std::size_t>& indices,
+                             const mapbox::geojsonvt::Options& options) {
+        util::parallelFor(indices.size(), [&](std::size_t i) {
+            auto& partition = partitions_[indices[i]];
+            partition.index = std::make_shared<mapbox::geojsonvt::GeoJSONVT>(*partition.geoJSON, options);
+        });
+    }
+
+    static std::shared_ptr<const Partitions> createPartitions(const GeoJSON& geoJSON,
+                                                              const mapbox::geojsonvt::Options& options) {
+        auto created = std::make_shared<Partitions>();
+        if (!geoJSON.is<Features>()) {
+            created->push_back({nullptr, std::make_shared<mapbox::geojsonvt::GeoJSONVT>(geoJSON, options)});
+            return created;
+        }
+
+        const auto& features = geoJSON.get<Features>();
+        const auto count = std::clamp<std::size_t>(features.size() / minPartitionSize, 1, maxPartitions);
+        std::vector<std::size_t> indices(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            const auto begin = features.begin() + (features.size() * i / count);
+            const auto end = features.begin() + (features.size() * (i + 1) / count);
+            created->push_back({std::make_shared<const GeoJSON>(Features(begin, end)), nullptr});
+            indices[i] = i;
+        }
+        buildIndexes(*created, indices, options);
+        return created;
+    }
+
     friend GeoJSONData;
     GeoJSONVTData(const GeoJSON& geoJSON,
                   const mapbox::geojsonvt::Options& options,
                   std::shared_ptr<Scheduler> sequencedScheduler_)
-        : impl(std::make_shared<mapbox::geojsonvt::GeoJSONVT>(geoJSON, options)),
+        : partitions(createPartitions(geoJSON, options)),
+          buffer(double(options.buffer) / options.extent),
           sequencedScheduler(std::move(sequencedScheduler_)) {
         assert(sequencedScheduler);
     }
 
-    std::shared_ptr<mapbox::geojsonvt::GeoJSONVT> impl; // Accessed on worker thread.
+    GeoJSONVTData(std::shared_ptr<const Partitions> partitions_,
+                  std::vector<Revision> revisions_,
+                  double buffer_,
+                  std::shared_ptr<Scheduler> sequencedScheduler_)
+        : partitions(std::move(partitions_)),
+          revisions(std::move(revisions_)),
+          buffer(buffer_),
+          sequencedScheduler(std::move(sequencedScheduler_)) {
+        assert(sequencedScheduler);
+    }
+
+    std::shared_ptr<const Partitions> partitions; // Accessed on worker thread.
+    std::vector<Revision> revisions;
+    // Tile buffer as a fraction of the tile size
+    double buffer;
     std::shared_ptr<Scheduler> sequencedScheduler;
 };
 
@@ -63,20 +439,131 @@ class SuperclusterData final : public GeoJSONData {
         fn(impl.getTile(id.z, id.x, id.y));
     }
 
-    Features getChildren(const std::uint32_t cluster_id) final { return impl.getChildren(cluster_id); }
+    Features getChildren(const std::uint32_t cluster_id) final {
+        std::scoped_lock lock(clusterMutex);
+        return getNode(cluster_id).children;
+    }
 
     Features getLeaves(const std::uint32_t cluster_id, const std::uint32_t limit, const std::uint32_t offset) final {
-        return impl.getLeaves(cluster_id, limit, offset);
+        Features leaves;
+        if (limit == 0) {
+            return leaves;
+        }
+        forEachLeaf(cluster_id, offset, [&](const GeoJSONFeature& leaf) {
+            leaves.push_back(leaf);
+            return leaves.size() < limit;
+        });
+        return leaves;
+    }
+
+    void forEachLeaf(const std::uint32_t cluster_id,
+                     const std::uint32_t offset,
+                     const std::function<bool(const GeoJSONFeature&)>& fn) final {
+        std::scoped_lock lock(clusterMutex);
+        std::uint32_t skip = offset;
+        visitLeaves(cluster_id, skip, fn);
     }
 
     std::uint8_t getClusterExpansionZoom(std::uint32_t cluster_id) final {
-        return impl.getClusterExpansionZoom(cluster_id);
+        std::scoped_lock lock(clusterMutex);
+        ClusterNode& first = getNode(cluster_id);
+        if (!first.expansionZoom) {
+            // As supercluster finds it: the zoom at which the cluster splits into more than one child
+            std::uint32_t zoom = (cluster_id % 32) - 1;
+            while (zoom <= maxZoom) {
+                const ClusterNode& node = getNode(cluster_id);
+                zoom++;
+                if (node.clusters.size() != 1 || !node.clusters[0]) break;
+                cluster_id = node.clusters[0]->id;
+            }
+            first.expansionZoom = static_cast<std::uint8_t>(zoom);
+        }
+        return *first.expansionZoom;
+    }
+
+    std::shared_ptr<GeoJSONData> update(const GeoJSONDiff& diff,
+                                        std::shared_ptr<Scheduler> sequencedScheduler,
+                                        const Immutable<GeoJSONOptions>& options) final {
+        // Clusters are rebuilt from scratch, and every tile is requested again
+        std::vector<Box> changed;
+        FeatureChanges changes(diff);
+        auto updated = changes.apply(features, changed).value_or(features);
+        changes.appendAdded(updated, changed);
+        return GeoJSONData::create(std::move(updated), std::move(sequencedScheduler), options);
     }
 
     friend GeoJSONData;
-    SuperclusterData(const Features& features, const mapbox::supercluster::Options& options)
-        : impl(features, options) {}
+    SuperclusterData(const Features& features_, const mapbox::supercluster::Options& options)
+        : features(features_),
+          impl(features, options),
+          maxZoom(options.maxZoom) {}
+
+    // The children of a cluster, kept once a query needed them, so that paging through the leaves of a big
+    // cluster or finding its expansion zoom doesn't build the features of every cluster below it each time
+    struct ClusterNode {
+        struct Cluster {
+            std::uint32_t id;
+            std::uint32_t pointCount;
+        };
+        Features children;
+        // For each child, its ID and size if it's a cluster
+        std::vector<std::optional<Cluster>> clusters;
+        std::optional<std::uint8_t> expansionZoom;
+    };
+
+    // Must be called with `clusterMutex` held. The node stays where it is as others are added.
+    ClusterNode& getNode(std::uint32_t clusterID) {
+        if (auto it = clusterNodes.find(clusterID); it != clusterNodes.end()) {
+            return it->second;
+        }
+        ClusterNode node;
+        node.children = impl.getChildren(clusterID);
+        node.clusters.reserve(node.children.size());
+        for (const auto& child : node.children) {
+            const auto& properties = child.properties;
+            const auto id = properties.find("cluster_id");
+            const auto pointCount = properties.find("point_count");
+            if (properties.contains("cluster") && id != properties.end() && id->second.is<std::uint64_t>() &&
+                pointCount != properties.end() && pointCount->second.is<std::uint64_t>()) {
+                node.clusters.emplace_back(
+                    ClusterNode::Cluster{static_cast<std::uint32_t>(id->second.get<std::uint64_t>()),
+                                         static_cast<std::uint32_t>(pointCount->second.get<std::uint64_t>())});
+            } else {
+                node.clusters.emplace_back(std::nullopt);
+            }
+        }
+        return clusterNodes.emplace(clusterID, std::move(node)).first->second;
+    }
+
+    // Visits the leaves of a cluster in the order supercluster returns them, skipping whole clusters that lie
+    // before the offset. Returns false once `fn` asks to stop.
+    bool visitLeaves(std::uint32_t clusterID,
+                     std::uint32_t& skip,
+                     const std::function<bool(const GeoJSONFeature&)>& fn) {
+        const ClusterNode& node = getNode(clusterID);
+        for (std::size_t i = 0; i < node.children.size(); ++i) {
+            if (const auto& cluster = node.clusters[i]) {
+                if (skip >= cluster->pointCount) {
+                    skip -= cluster->pointCount;
+                } else if (!visitLeaves(cluster->id, skip, fn)) {
+                    return false;
+                }
+            } else if (skip > 0) {
+                --skip;
+            } else if (!fn(node.children[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    Features features;
     mapbox::supercluster::Supercluster impl;
+    const std::uint8_t maxZoom;
+
+    std::mutex clusterMutex;
+    // std::unordered_map keeps references to its elements valid as it grows
+    std::unordered_map<std::uint32_t, ClusterNode> clusterNodes;
 };
 
 template <class T>
@@ -128,13 +615,67 @@ std::shared_ptr<GeoJSONData> GeoJSONData::create(const GeoJSON& geoJSON,
         return std::shared_ptr<GeoJSONData>(new SuperclusterData(geoJSON.get<Features>(), clusterOptions));
     }
 
-    mapbox::geojsonvt::Options vtOptions;
-    vtOptions.maxZoom = options->maxzoom;
-    vtOptions.extent = util::EXTENT;
-    vtOptions.buffer = static_cast<uint16_t>(::round(scale * options->buffer));
-    vtOptions.tolerance = scale * options->tolerance;
-    vtOptions.lineMetrics = options->lineMetrics;
-    return std::shared_ptr<GeoJSONData>(new GeoJSONVTData(geoJSON, vtOptions, std::move(sequencedScheduler)));
+    return std::shared_ptr<GeoJSONData>(
+        new GeoJSONVTData(geoJSON, makeTileIndexOptions(*options), std::move(sequencedScheduler)));
+}
+
+// static
+std::shared_ptr<GeoJSONData> GeoJSONData::parse(const std::string& json,
+                                                std::shared_ptr<Scheduler> sequencedScheduler,
+                                                const Immutable<GeoJSONOptions>& options,
+                                                conversion::Error& error) {
+    const auto vtOptions = makeTileIndexOptions(*options);
+    std::vector<std::shared_ptr<PendingTileIndex>> pending;
+    Features features;
+    std::size_t featureCount = 0;
+
+    const auto onFeatures = [&](Features&& chunk, std::size_t bytesRead) {
+        featureCount += chunk.size();
+        features.insert(features.end(), std::make_move_iterator(chunk.begin()), std::make_move_iterator(chunk.end()));
+        if (options->cluster) {
+            // Clusters are built from all the features at once
+            return;
+        }
+
+        // Size the partitions like `create` would for the feature count the text is heading for
+        const auto estimatedCount = featureCount * json.size() / std::max<std::size_t>(bytesRead, 1);
+        const auto partitionSize = std::max(GeoJSONVTData::minPartitionSize,
+                                            estimatedCount / GeoJSONVTData::maxPartitions);
+        if (features.size() >= partitionSize) {
+            pending.push_back(
+                std::make_shared<PendingTileIndex>(std::make_shared<const GeoJSON>(std::move(features)), vtOptions));
+            features = {};
+            Scheduler::GetBackground()->schedule([index = pending.back()] { index->build(); });
+        }
+    };
+
+    auto geoJSON = conversion::parseGeoJSON(json, GeoJSONVTData::minPartitionSize, onFeatures, error);
+    if (!geoJSON) {
+        return nullptr;
+    }
+    if (pending.empty()) {
+        // Streamed features are all still here, if there were any
+        return create(
+            featureCount ? GeoJSON(std::move(features)) : std::move(*geoJSON), std::move(sequencedScheduler), options);
+    }
+
+    if (!features.empty()) {
+        pending.push_back(
+            std::make_shared<PendingTileIndex>(std::make_shared<const GeoJSON>(std::move(features)), vtOptions));
+    }
+    auto partitions = std::make_shared<GeoJSONVTData::Partitions>();
+    try {
+        for (const auto& index : pending) {
+            partitions->push_back({index->geoJSON, index->get()});
+        }
+    } catch (const std::exception& ex) {
+        error.message = std::string("failed to index GeoJSON: ") + ex.what();
+        return nullptr;
+    }
+    return std::shared_ptr<GeoJSONData>(new GeoJSONVTData(std::move(partitions),
+                                                          {},
+                                                          double(vtOptions.buffer) / vtOptions.extent,
+                                                          std::move(sequencedScheduler)));
 }
 
 GeoJSONSource::Impl::Impl(std::string id_, Immutable<GeoJSONOptions> options_)
@@ -15,7 +15,9 @@
 #include <mbgl/style/layers/raster_layer.hpp>
 #include <mbgl/style/layers/symbol_layer.hpp>
 #include <mbgl/style/observer.hpp>
+#include <mbgl/platform/settings.hpp>
 #include <mbgl/style/parser.hpp>
+#include <mbgl/style/resource_prefetcher.hpp>
 #include <mbgl/style/source_impl.hpp>
 #include <mbgl/style/style_impl.hpp>
 #include <mbgl/style/transition_options.hpp>
@@ -35,6 +37,12 @@ Style::Impl::Impl(std::shared_ptr<FileSource> fileSource_, float pixelRatio, con
       observer(&nullObserver) {
     spriteLoader->setObserver(this);
     light->setObserver(this);
+
+    const auto prefetch = platform::Settings::getInstance().get(platform::EXPERIMENTAL_STYLE_RESOURCE_PREFETCH);
+    if (const auto* enabled = prefetch.getBool(); enabled && *enabled && fileSource) {
+        prefetcher = std::make_shared<ResourcePrefetcher>(fileSource, pixelRatio);
+        fileSource = prefetcher;
+    }
 }
 
 Style::Impl::~Impl() = default;
@@ -85,6 +93,11 @@ void Style::Impl::loadURL(const std::string& url_) {
 }
 
 void Style::Impl::parse(const std::string& json_) {
+    if (prefetcher) {
+        // The requests go out while the layers are parsed
+        prefetcher->prefetch(json_);
+    }
+
     Parser parser;
 
     if (auto error = parser.parse(json_)) {
@@ -450,5 +463,13 @@ Immutable<std::vector<Immutable<Layer::Impl>>> Style::Impl::getLayerImpls() cons
     return layers.getImpls();
 }
 
+std::shared_ptr<const CollectionJournal<Source::Impl>> Style::Impl::takeSourceJournal() {
+    return sources.takeJournal();
+}
+
+std::shared_ptr<const CollectionJournal<Layer::Impl>> Style::Impl::takeLayerJournal() {
+    return layers.takeJournal();
+}
+
 } // namespace style
 } // namespace mbgl
@@ -33,6 +33,8 @@ class SpriteLoader;
 
 namespace style {
 
+class ResourcePrefetcher;
+
 class Style::Impl : public SpriteLoaderObserver,
                     public SourceObserver,
                     public LayerObserver,
@@ -97,6 +99,10 @@ public:
     Immutable<std::vector<Immutable<Source::Impl>>> getSourceImpls() const;
     Immutable<std::vector<Immutable<Layer::Impl>>> getLayerImpls() const;
 
+    // The source and layer changes since the previous call, for the renderer to diff them incrementally
+    std::shared_ptr<const CollectionJournal<Source::Impl>> takeSourceJournal();
+    std::shared_ptr<const CollectionJournal<Layer::Impl>> takeLayerJournal();
+
     void dumpDebugLogs() const;
     bool areSpritesLoaded() const;
 
@@ -107,6 +113,8 @@ private:
     void parse(const std::string&);
 
     std::shared_ptr<FileSource> fileSource;
+    /// Also `fileSource` when set
+    std::shared_ptr<ResourcePrefetcher> prefetcher;
 
     std::string url;
     std::string json;
@@ -13,6 +13,7 @@
 #include <mbgl/renderer/buckets/symbol_bucket.hpp> // For PlacedSymbol: pull out to another location
 
 #include <cmath>
+#include <limits>
 
 namespace mbgl {
 
@@ -93,6 +94,33 @@ CollisionBoundaries CollisionIndex::projectTileBoundaries(const mat4& posMatrix)
     return {{topLeft.x, topLeft.y, bottomRight.x, bottomRight.y}};
 }
 
+bool CollisionIndex::mayReachGrid(const mat4& posMatrix, Point<float> min, Point<float> max, float reach) const {
+    const auto size = transformState.getSize();
+    CollisionBoundaries bounds{{std::numeric_limits<float>::max(),
+                                std::numeric_limits<float>::max(),
+                                std::numeric_limits<float>::lowest(),
+                                std::numeric_limits<float>::lowest()}};
+    float perspectiveRatio = 0.0f;
+    for (const Point<float>& corner : {min, Point<float>{max.x, min.y}, max, Point<float>{min.x, max.y}}) {
+        vec4 p = {{corner.x, corner.y, 0, 1}};
+        matrix::transformMat4(p, p, posMatrix);
+        if (p[3] <= 0) {
+            return true;
+        }
+        // As long as the whole area is in front of the camera, it projects within the bounds of its corners, and
+        // the perspective ratio, with `w` linear across it, is largest at one of them
+        const auto x = static_cast<float>(((p[0] / p[3] + 1) / 2) * size.width + viewportPadding);
+        const auto y = static_cast<float>(((-p[1] / p[3] + 1) / 2) * size.height + viewportPadding);
+        bounds = {{std::min(bounds[0], x), std::min(bounds[1], y), std::max(bounds[2], x), std::max(bounds[3], y)}};
+        perspectiveRatio = std::max(
+            perspectiveRatio,
+            0.5f + 0.5f * static_cast<float>(transformState.getCameraToCenterDistance() / p[3]));
+    }
+
+    const float margin = reach * perspectiveRatio;
+    return isInsideGrid({{bounds[0] - margin, bounds[1] - margin, bounds[2] + margin, bounds[3] + margin}});
+}
+
 // The tile border checks below are only well defined when the tile boundaries
 // are axis-aligned We are relying on it only being used in MapMode::Tile, where
 // that is always the case
@@ -328,6 +356,45 @@ std::pair<bool, bool> CollisionIndex::placeLineFeature(
     return {!collisionDetected && firstAndLastGlyph && inGrid, entirelyOffscreen};
 }
 
+std::pair<bool, bool> CollisionIndex::placeShiftedFeature(
+    std::vector<ProjectedCollisionBox>& projectedBoxes,
+    Point<float> shift,
+    const bool allowOverlap,
+    const std::optional<std::function<bool(const RefIndexedSubfeature&)>>& collisionGroupPredicate) const {
+    bool inGrid = false;
+    bool entirelyOffscreen = true;
+    for (auto& projected : projectedBoxes) {
+        CollisionBoundaries collisionBoundaries;
+        if (projected.isBox()) {
+            const auto& box = projected.box();
+            collisionBoundaries = {box.min.x + shift.x, box.min.y + shift.y, box.max.x + shift.x, box.max.y + shift.y};
+            projected = ProjectedCollisionBox{
+                collisionBoundaries[0], collisionBoundaries[1], collisionBoundaries[2], collisionBoundaries[3]};
+            // Unlike circles, a box has to be fully placeable on its own
+            if (!isInsideGrid(collisionBoundaries) ||
+                (!allowOverlap && collisionGrid.hitTest(projected.box(), collisionGroupPredicate))) {
+                return {false, false};
+            }
+        } else if (projected.isCircle()) {
+            const auto& circle = projected.circle();
+            const float x = circle.center.x + shift.x;
+            const float y = circle.center.y + shift.y;
+            collisionBoundaries = {x - circle.radius, y - circle.radius, x + circle.radius, y + circle.radius};
+            projected = ProjectedCollisionBox{x, y, circle.radius};
+            if (!allowOverlap && collisionGrid.hitTest(projected.circle(), collisionGroupPredicate)) {
+                return {false, false};
+            }
+        } else {
+            // Unused circle of a line label
+            continue;
+        }
+        entirelyOffscreen &= isOffscreen(collisionBoundaries);
+        inGrid |= isInsideGrid(collisionBoundaries);
+    }
+
+    return {inGrid, entirelyOffscreen};
+}
+
 void CollisionIndex::insertFeature(const CollisionFeature& feature,
                                    const std::vector<ProjectedCollisionBox>& projectedBoxes,
                                    bool ignorePlacement,
@@ -52,6 +52,14 @@ public:
         std::vector<ProjectedCollisionBox>& /*out*/
     );
 
+    // Moves boxes projected by an earlier placement by `shift` and tests them against the grid the
+    // way `placeFeature()` would, returning the same {placed, offscreen} pair.
+    std::pair<bool, bool> placeShiftedFeature(
+        std::vector<ProjectedCollisionBox>& projectedBoxes,
+        Point<float> shift,
+        bool allowOverlap,
+        const std::optional<std::function<bool(const RefIndexedSubfeature&)>>& collisionGroupPredicate) const;
+
     void insertFeature(const CollisionFeature& feature,
                        const std::vector<ProjectedCollisionBox>&,
                        bool ignorePlacement,
@@ -62,6 +70,11 @@ public:
 
     CollisionBoundaries projectTileBoundaries(const mat4& posMatrix) const;
 
+    // Whether a point feature anchored within `min`..`max`, in tile units, with boxes reaching no farther than
+    // `reach` viewport pixels from its anchor before the perspective ratio is applied, may be inside the grid.
+    // Conservative: `true` whenever part of the area is behind the camera.
+    bool mayReachGrid(const mat4& posMatrix, Point<float> min, Point<float> max, float reach) const;
+
     const TransformState& getTransformState() const { return transformState; }
 
     float getViewportPadding() const { return viewportPadding; }
@@ -6,8 +6,74 @@
 #include <mbgl/tile/tile.hpp>
 #include <mbgl/util/instrumentation.hpp>
 
+#include <optional>
+
 namespace mbgl {
 
+namespace {
+
+// Scaled coordinates are grouped into cells of 4x4 grid units, the tolerance used when matching
+// a symbol against a parent tile is a single grid unit, so a lookup covers at most four cells.
+constexpr int64_t cellShift = 2;
+
+uint64_t cellKey(int64_t cellX, int64_t cellY) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(cellX)) << 32) | static_cast<uint32_t>(cellY);
+}
+
+std::optional<uint32_t> findMatch(const KeyedSymbolInstances& keyed,
+                                  const Point<int64_t> scaledCoord,
+                                  const int64_t tolerance,
+                                  const std::set<uint32_t>& zoomCrossTileIDs) {
+    // Return any symbol with the same keys whose coordinates are within
+    // 1 grid unit. (with a 4px grid, this covers a 12px by 12px area)
+    const auto matches = [&](uint32_t index) {
+        const IndexedSymbolInstance& thisTileSymbol = keyed.instances[index];
+        return std::abs(thisTileSymbol.coord.x - scaledCoord.x) <= tolerance &&
+               std::abs(thisTileSymbol.coord.y - scaledCoord.y) <= tolerance &&
+               !zoomCrossTileIDs.contains(thisTileSymbol.crossTileID);
+    };
+
+    const int64_t minCellX = (scaledCoord.x - tolerance) >> cellShift;
+    const int64_t maxCellX = (scaledCoord.x + tolerance) >> cellShift;
+    const int64_t minCellY = (scaledCoord.y - tolerance) >> cellShift;
+    const int64_t maxCellY = (scaledCoord.y + tolerance) >> cellShift;
+
+    // Matching against a much deeper child tile has a tolerance spanning many cells, scan the symbols
+    // directly if there are fewer of them than cells to look up
+    const auto cellCount = static_cast<uint64_t>(maxCellX - minCellX + 1) * (maxCellY - minCellY + 1);
+    if (cellCount > 4 && cellCount > keyed.instances.size()) {
+        for (uint32_t i = 0; i < keyed.instances.size(); ++i) {
+            if (matches(i)) {
+                return i;
+            }
+        }
+        return std::nullopt;
+    }
+
+    // Prefer the first match in index order, as the linear scan does, so the result doesn't depend on the grid
+    std::optional<uint32_t> result;
+    for (int64_t cellX = minCellX; cellX <= maxCellX; ++cellX) {
+        for (int64_t cellY = minCellY; cellY <= maxCellY; ++cellY) {
+            const auto cell = keyed.cells.find(cellKey(cellX, cellY));
+            if (cell == keyed.cells.end()) {
+                continue;
+            }
+            for (const auto index : cell->second) {
+                if (result && index >= *result) {
+                    break;
+                }
+                if (matches(index)) {
+                    result = index;
+                    break;
+                }
+            }
+        }
+    }
+    return result;
+}
+
+} // namespace
+
 TileLayerIndex::TileLayerIndex(OverscaledTileID coord_,
                                std::vector<SymbolInstance>& symbolInstances,
                                uint32_t bucketInstanceId_,
@@ -20,8 +86,11 @@ TileLayerIndex::TileLayerIndex(OverscaledTileID coord_,
             symbolInstance.getCrossTileID() == SymbolInstance::invalidCrossTileID) {
             continue;
         }
-        indexedSymbolInstances[symbolInstance.getKey()].emplace_back(symbolInstance.getCrossTileID(),
-                                                                     getScaledCoordinates(symbolInstance, coord));
+        auto& keyed = indexedSymbolInstances[symbolInstance.getKey()];
+        const auto scaledCoord = getScaledCoordinates(symbolInstance, coord);
+        const auto cell = cellKey(scaledCoord.x >> cellShift, scaledCoord.y >> cellShift);
+        keyed.cells[cell].push_back(static_cast<uint32_t>(keyed.instances.size()));
+        keyed.instances.emplace_back(symbolInstance.getCrossTileID(), scaledCoord);
     }
 }
 
@@ -40,9 +109,9 @@ void TileLayerIndex::findMatches(SymbolBucket& bucket,
                                  const OverscaledTileID& newCoord,
                                  std::set<uint32_t>& zoomCrossTileIDs) const {
     auto& symbolInstances = bucket.symbolInstances;
-    float tolerance = coord.canonical.z < newCoord.canonical.z
-                          ? 1.0f
-                          : static_cast<float>(std::pow(2, coord.canonical.z - newCoord.canonical.z));
+    const int64_t tolerance = coord.canonical.z < newCoord.canonical.z
+                                  ? 1
+                                  : int64_t{1} << (coord.canonical.z - newCoord.canonical.z);
 
     if (bucket.bucketLeaderID != bucketLeaderId) return;
 
@@ -60,19 +129,13 @@ void TileLayerIndex::findMatches(SymbolBucket& bucket,
 
         auto scaledSymbolCoord = getScaledCoordinates(symbolInstance, newCoord);
 
-        for (const IndexedSymbolInstance& thisTileSymbol : it->second) {
-            // Return any symbol with the same keys whose coordinates are within
-            // 1 grid unit. (with a 4px grid, this covers a 12px by 12px area)
-            if (std::abs(thisTileSymbol.coord.x - scaledSymbolCoord.x) <= tolerance &&
-                std::abs(thisTileSymbol.coord.y - scaledSymbolCoord.y) <= tolerance &&
-                zoomCrossTileIDs.find(thisTileSymbol.crossTileID) == zoomCrossTileIDs.end()) {
-                // Once we've marked ourselves duplicate against this parent
-                // symbol, don't let any other symbols at the same zoom level
-                // duplicate against the same parent (see issue #10844)
-                zoomCrossTileIDs.insert(thisTileSymbol.crossTileID);
-                symbolInstance.setCrossTileID(thisTileSymbol.crossTileID);
-                break;
-            }
+        if (const auto match = findMatch(it->second, scaledSymbolCoord, tolerance, zoomCrossTileIDs)) {
+            const auto crossTileID = it->second.instances[*match].crossTileID;
+            // Once we've marked ourselves duplicate against this parent
+            // symbol, don't let any other symbols at the same zoom level
+            // duplicate against the same parent (see issue #10844)
+            zoomCrossTileIDs.insert(crossTileID);
+            symbolInstance.setCrossTileID(crossTileID);
         }
     }
 }
@@ -196,12 +259,20 @@ bool CrossTileSymbolLayerIndex::addBucket(const OverscaledTileID& tileID,
 
 void CrossTileSymbolLayerIndex::removeBucketCrossTileIDs(uint8_t zoom, const TileLayerIndex& removedBucket) {
     for (const auto& key : removedBucket.indexedSymbolInstances) {
-        for (auto indexedSymbolInstance : key.second) {
+        for (const auto& indexedSymbolInstance : key.second.instances) {
             usedCrossTileIDs[zoom].erase(indexedSymbolInstance.crossTileID);
         }
     }
 }
 
+std::size_t CrossTileSymbolLayerIndex::getBucketCount() const {
+    std::size_t count = 0;
+    for (const auto& zoomIndexes : indexes) {
+        count += zoomIndexes.second.size();
+    }
+    return count;
+}
+
 bool CrossTileSymbolLayerIndex::removeStaleBuckets(const std::unordered_set<uint32_t>& currentIDs) {
     bool tilesChanged = false;
     for (auto& zoomIndexes : indexes) {
@@ -248,7 +319,12 @@ auto CrossTileSymbolIndex::addLayer(const RenderLayer& layer, float lng) -> AddL
         currentBucketIDs.insert(pair.first);
     }
 
-    if (layerIndex.removeStaleBuckets(currentBucketIDs)) result |= AddLayerResult::BucketsRemoved;
+    // If no bucket was added, every current bucket was already in the index. When the counts also
+    // agree there can't be any stale buckets and the index doesn't need to be walked.
+    if ((result != AddLayerResult::NoChanges || layerIndex.getBucketCount() != currentBucketIDs.size()) &&
+        layerIndex.removeStaleBuckets(currentBucketIDs)) {
+        result |= AddLayerResult::BucketsRemoved;
+    }
 
     return result;
 }
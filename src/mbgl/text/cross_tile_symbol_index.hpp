@@ -12,6 +12,7 @@
 #include <string>
 #include <memory>
 #include <thread>
+#include <unordered_map>
 #include <unordered_set>
 
 namespace mbgl {
@@ -30,6 +31,13 @@ public:
     Point<int64_t> coord;
 };
 
+/// The indexed symbols of one bucket sharing a key, hashed by the grid cell of their scaled coordinates
+class KeyedSymbolInstances {
+public:
+    std::vector<IndexedSymbolInstance> instances;
+    std::unordered_map<uint64_t, std::vector<uint32_t>> cells;
+};
+
 class TileLayerIndex {
 public:
     TileLayerIndex(OverscaledTileID coord,
@@ -43,7 +51,7 @@ public:
     OverscaledTileID coord;
     uint32_t bucketInstanceId;
     std::string bucketLeaderId;
-    std::map<std::u16string, std::vector<IndexedSymbolInstance>> indexedSymbolInstances;
+    std::unordered_map<std::u16string, KeyedSymbolInstances> indexedSymbolInstances;
 };
 
 class CrossTileSymbolLayerIndex {
@@ -52,6 +60,7 @@ public:
     bool addBucket(const OverscaledTileID&, const mat4& tileMatrix, SymbolBucket&);
     bool removeStaleBuckets(const std::unordered_set<uint32_t>& currentIDs);
     void handleWrapJump(float newLng);
+    std::size_t getBucketCount() const;
 
 private:
     void removeBucketCrossTileIDs(uint8_t zoom, const TileLayerIndex& removedBucket);
@@ -4,7 +4,10 @@
 #include <mbgl/text/glyph_manager.hpp>
 #include <mbgl/text/glyph_manager_observer.hpp>
 #include <mbgl/text/glyph_pbf.hpp>
+#include <mbgl/text/glyph_store.hpp>
 #include <mbgl/util/async_request.hpp>
+#include <mbgl/util/hash.hpp>
+#include <mbgl/util/parallel_for.hpp>
 #include <mbgl/util/std.hpp>
 #include <mbgl/util/tiny_sdf.hpp>
 #include <mbgl/util/image.hpp>
@@ -18,8 +21,10 @@ namespace {
 GlyphManagerObserver nullObserver;
 }
 
-GlyphManager::GlyphManager(std::unique_ptr<LocalGlyphRasterizer> localGlyphRasterizer_)
-    : observer(&nullObserver),
+GlyphManager::GlyphManager(std::unique_ptr<LocalGlyphRasterizer> localGlyphRasterizer_,
+                           std::optional<std::string> localFontFamily_)
+    : localFontFamily(std::move(localFontFamily_)),
+      observer(&nullObserver),
       localGlyphRasterizer(std::move(localGlyphRasterizer_)) {}
 
 GlyphManager::~GlyphManager() {
@@ -41,18 +46,31 @@ void GlyphManager::getGlyphs(GlyphRequestor& requestor, GlyphDependencies glyphD
 
             const GlyphIDs& glyphIDs = dependency.second;
             std::unordered_set<GlyphRange> ranges;
+            std::vector<GlyphID> localGlyphIDs;
             for (const auto& glyphID : glyphIDs) {
                 if (localGlyphRasterizer->canRasterizeGlyph(fontStack, glyphID)) {
                     if (entry.glyphs.find(glyphID) == entry.glyphs.end()) {
-                        entry.glyphs.emplace(glyphID, makeMutable<Glyph>(generateLocalSDF(fontStack, glyphID)));
+                        localGlyphIDs.push_back(glyphID);
                     }
                 } else {
                     ranges.insert(getGlyphRange(glyphID));
                 }
             }
 
+            if (!localGlyphIDs.empty()) {
+                auto localGlyphs = rasterizeSDFs(localFaceHash(fontStack), localGlyphIDs, [&](GlyphID glyphID) {
+                    return localGlyphRasterizer->rasterizeGlyph(fontStack, glyphID);
+                });
+                for (std::size_t i = 0; i < localGlyphIDs.size(); ++i) {
+                    entry.glyphs.emplace(localGlyphIDs[i], makeMutable<Glyph>(std::move(localGlyphs[i])));
+                }
+            }
+
             for (const auto& range : ranges) {
                 auto it = entry.ranges.find(range);
+                if (it == entry.ranges.end() && loadSharedRange(entry, fontStack, range)) {
+                    continue;
+                }
                 if (it == entry.ranges.end() || !it->second.parsed) {
                     GlyphRequest& request = entry.ranges[range];
                     request.requestors[&requestor] = dependencies;
@@ -69,10 +87,69 @@ void GlyphManager::getGlyphs(GlyphRequestor& requestor, GlyphDependencies glyphD
     }
 }
 
-Glyph GlyphManager::generateLocalSDF(const FontStack& fontStack, GlyphID glyphID) {
-    Glyph local = localGlyphRasterizer->rasterizeGlyph(fontStack, glyphID);
-    local.bitmap = util::transformRasterToSDF(local.bitmap, 8, .25);
-    return local;
+bool GlyphManager::loadSharedRange(Entry& entry, const FontStack& fontStack, const GlyphRange& range) {
+    if (range.type != GlyphIDType::FontPBF || !GlyphStore::get().isEnabled()) {
+        return false;
+    }
+    const auto shared = GlyphStore::get().find(glyphURL, fontStack, range);
+    if (!shared) {
+        return false;
+    }
+
+    for (const auto& glyph : *shared) {
+        if (!localGlyphRasterizer->canRasterizeGlyph(fontStack, glyph->id)) {
+            entry.glyphs.insert_or_assign(glyph->id, glyph);
+        }
+    }
+    entry.ranges[range].parsed = true;
+    return true;
+}
+
+std::vector<Glyph> GlyphManager::rasterizeSDFs(std::size_t faceHash,
+                                               const std::vector<GlyphID>& glyphIDs,
+                                               const std::function<Glyph(GlyphID)>& rasterize) {
+    MLN_TRACE_FUNC();
+    // Fewer glyphs than this aren't worth scheduling
+    constexpr std::size_t minParallelGlyphs = 8;
+
+    auto& store = GlyphStore::get();
+    const bool diskCache = store.isSDFCacheEnabled();
+
+    std::vector<Glyph> glyphs(glyphIDs.size());
+    std::vector<std::size_t> rasterized;
+    for (std::size_t i = 0; i < glyphIDs.size(); ++i) {
+        if (diskCache) {
+            if (auto cached = store.readSDF(faceHash, glyphIDs[i])) {
+                glyphs[i] = std::move(*cached);
+                continue;
+            }
+        }
+        glyphs[i] = rasterize(glyphIDs[i]);
+        rasterized.push_back(i);
+    }
+
+    const auto transformToSDF = [&](std::size_t i) {
+        auto& glyph = glyphs[rasterized[i]];
+        glyph.bitmap = util::transformRasterToSDF(glyph.bitmap, 8, .25);
+    };
+    if (rasterized.size() >= minParallelGlyphs) {
+        util::parallelFor(rasterized.size(), transformToSDF);
+    } else {
+        for (std::size_t i = 0; i < rasterized.size(); ++i) {
+            transformToSDF(i);
+        }
+    }
+
+    if (diskCache) {
+        for (const auto i : rasterized) {
+            store.writeSDF(faceHash, glyphs[i]);
+        }
+    }
+    return glyphs;
+}
+
+std::size_t GlyphManager::localFaceHash(const FontStack& fontStack) const {
+    return util::hash(FontStackHasher()(fontStack), localFontFamily ? *localFontFamily : std::string());
 }
 
 void GlyphManager::requestRange(GlyphRequest& request,
@@ -138,13 +215,27 @@ void GlyphManager::processResponse(const Response& res, const FontStack& fontSta
                 return;
             }
 
+            // Other maps parsing the same range can take the glyphs from the shared store instead
+            const bool share = range.type == GlyphIDType::FontPBF && GlyphStore::get().isEnabled();
+            auto shared = std::make_shared<GlyphStore::RangeGlyphs>();
+
             for (auto& glyph : glyphs) {
                 auto id = glyph.id;
-                if (!localGlyphRasterizer->canRasterizeGlyph(fontStack, id)) {
+                if (share) {
+                    Immutable<Glyph> immutableGlyph = makeMutable<Glyph>(std::move(glyph));
+                    shared->push_back(immutableGlyph);
+                    if (!localGlyphRasterizer->canRasterizeGlyph(fontStack, id)) {
+                        entry.glyphs.insert_or_assign(id, std::move(immutableGlyph));
+                    }
+                } else if (!localGlyphRasterizer->canRasterizeGlyph(fontStack, id)) {
                     entry.glyphs.erase(id);
                     entry.glyphs.emplace(id, makeMutable<Glyph>(std::move(glyph)));
                 }
             }
+
+            if (share) {
+                GlyphStore::get().insert(glyphURL, fontStack, range, std::move(shared));
+            }
         }
 
         request.parsed = true;
@@ -219,27 +310,67 @@ bool GlyphManager::loadHBShaper(const FontStack& fontStack, GlyphIDType type, co
     auto shaper = std::make_shared<HBShaper>(type, data, ftLibrary);
     if (!shaper->valid()) return false;
     hbShapers[fontStack][type] = shaper;
+    hbShaperHashes[fontStack][type] = std::hash<std::string>()(data);
+
+    // Results shaped with a face this one replaces are stale
+    std::scoped_lock lock(shapingCacheLock);
+    for (auto it = shapingCache.begin(); it != shapingCache.end();) {
+        if (std::get<0>(it->key) == fontStack && std::get<1>(it->key) == type) {
+            shapingCacheStats.bytes -= it->bytes;
+            shapingCacheIndex.erase(it->key);
+            it = shapingCache.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    shapingCacheStats.entries = shapingCache.size();
     return true;
 }
 
 Immutable<Glyph> GlyphManager::getGlyph(const FontStack& fontStack, GlyphID glyphID) {
-    auto& entry = entries[fontStack];
-    if (entry.glyphs.find(glyphID) != entry.glyphs.end()) return entry.glyphs.at(glyphID);
+    return getGlyphs(fontStack, {glyphID}).front();
+}
 
-    if (glyphID.complex.type != FontPBF) {
-        auto shaper = getHBShaper(fontStack, glyphID.complex.type);
-        if (shaper) {
-            auto glyph = shaper->rasterizeGlyph(glyphID);
+std::vector<Immutable<Glyph>> GlyphManager::getGlyphs(const FontStack& fontStack,
+                                                      const std::vector<GlyphID>& glyphIDs) {
+    auto& entry = entries[fontStack];
 
-            glyph.bitmap = util::transformRasterToSDF(glyph.bitmap, 8, .25);
-            entry.glyphs.emplace(glyphID, makeMutable<Glyph>(std::move(glyph)));
-            return entry.glyphs.at(glyphID);
+    std::vector<std::optional<Immutable<Glyph>>> found(glyphIDs.size());
+    std::map<GlyphIDType, std::vector<std::size_t>> missing;
+    for (std::size_t i = 0; i < glyphIDs.size(); ++i) {
+        if (const auto it = entry.glyphs.find(glyphIDs[i]); it != entry.glyphs.end()) {
+            found[i] = it->second;
+        } else if (glyphIDs[i].complex.type != FontPBF) {
+            missing[glyphIDs[i].complex.type].push_back(i);
         }
     }
 
-    Glyph empty;
+    for (const auto& [type, indices] : missing) {
+        auto shaper = getHBShaper(fontStack, type);
+        if (!shaper) {
+            continue;
+        }
+
+        std::vector<GlyphID> shapedIDs;
+        shapedIDs.reserve(indices.size());
+        for (const auto i : indices) {
+            shapedIDs.push_back(glyphIDs[i]);
+        }
+        auto glyphs = rasterizeSDFs(hbShaperHashes[fontStack][type], shapedIDs, [&](GlyphID glyphID) {
+            return shaper->rasterizeGlyph(glyphID);
+        });
+        for (std::size_t i = 0; i < indices.size(); ++i) {
+            const auto it = entry.glyphs.emplace(shapedIDs[i], makeMutable<Glyph>(std::move(glyphs[i]))).first;
+            found[indices[i]] = it->second;
+        }
+    }
 
-    return makeMutable<Glyph>(std::move(empty));
+    std::vector<Immutable<Glyph>> result;
+    result.reserve(glyphIDs.size());
+    for (auto& glyph : found) {
+        result.push_back(glyph ? std::move(*glyph) : makeMutable<Glyph>());
+    }
+    return result;
 }
 
 void GlyphManager::hbShaping(const std::u16string& text,
@@ -248,9 +379,75 @@ void GlyphManager::hbShaping(const std::u16string& text,
                              std::vector<GlyphID>& glyphIDs,
                              std::vector<HBShapeAdjust>& adjusts) {
     auto shaper = getHBShaper(font, type);
-    if (shaper) {
-        shaper->createComplexGlyphIDs(text, glyphIDs, adjusts);
+    if (!shaper) {
+        return;
+    }
+
+    ShapingKey key{font, type, text};
+    {
+        std::scoped_lock lock(shapingCacheLock);
+        if (const auto it = shapingCacheIndex.find(key); it != shapingCacheIndex.end()) {
+            shapingCache.splice(shapingCache.begin(), shapingCache, it->second);
+            const ShapedText& shaped = *it->second;
+            glyphIDs.insert(glyphIDs.end(), shaped.glyphIDs.begin(), shaped.glyphIDs.end());
+            adjusts.insert(adjusts.end(), shaped.adjusts.begin(), shaped.adjusts.end());
+            shapingCacheStats.hits++;
+            return;
+        }
+        shapingCacheStats.misses++;
+    }
+
+    std::vector<GlyphID> shapedGlyphIDs;
+    std::vector<HBShapeAdjust> shapedAdjusts;
+    shaper->createComplexGlyphIDs(text, shapedGlyphIDs, shapedAdjusts);
+    glyphIDs.insert(glyphIDs.end(), shapedGlyphIDs.begin(), shapedGlyphIDs.end());
+    adjusts.insert(adjusts.end(), shapedAdjusts.begin(), shapedAdjusts.end());
+
+    const std::size_t bytes = sizeof(ShapedText) + text.size() * sizeof(char16_t) +
+                              shapedGlyphIDs.size() * sizeof(GlyphID) + shapedAdjusts.size() * sizeof(HBShapeAdjust);
+
+    std::scoped_lock lock(shapingCacheLock);
+    if (shapingCacheIndex.contains(key)) {
+        return;
+    }
+    shapingCache.push_front(ShapedText{key, std::move(shapedGlyphIDs), std::move(shapedAdjusts), bytes});
+    shapingCacheIndex.emplace(std::move(key), shapingCache.begin());
+    shapingCacheStats.bytes += bytes;
+
+    while (shapingCacheStats.bytes > shapingCacheBudget && shapingCache.size() > 1) {
+        const auto& oldest = shapingCache.back();
+        shapingCacheStats.bytes -= oldest.bytes;
+        shapingCacheIndex.erase(oldest.key);
+        shapingCache.pop_back();
+    }
+    shapingCacheStats.entries = shapingCache.size();
+}
+
+GlyphManager::ShapingCacheStats GlyphManager::getShapingCacheStats() const {
+    std::scoped_lock lock(shapingCacheLock);
+    return shapingCacheStats;
+}
+
+void GlyphManager::trimShapingCache(std::size_t targetBytes) {
+    std::scoped_lock lock(shapingCacheLock);
+    while (shapingCacheStats.bytes > targetBytes && !shapingCache.empty()) {
+        const auto& oldest = shapingCache.back();
+        shapingCacheStats.bytes -= oldest.bytes;
+        shapingCacheIndex.erase(oldest.key);
+        shapingCache.pop_back();
+    }
+    shapingCacheStats.entries = shapingCache.size();
+}
+
+MemoryUsage GlyphManager::getMemoryUsage() {
+    std::scoped_lock readWriteLock(rwLock);
+    MemoryUsage usage;
+    for (const auto& [fontStack, entry] : entries) {
+        for (const auto& [id, glyph] : entry.glyphs) {
+            usage.cpu += sizeof(Glyph) + glyph->bitmap.bytes();
+        }
     }
+    return usage;
 }
 
 std::string GlyphManager::getFontFaceURL(GlyphIDType type) {
@@ -6,9 +6,13 @@
 #include <mbgl/text/local_glyph_rasterizer.hpp>
 #include <mbgl/util/font_stack.hpp>
 #include <mbgl/util/immutable.hpp>
+#include <mbgl/util/memory_usage.hpp>
 
+#include <functional>
+#include <list>
 #include <mutex>
 #include <string>
+#include <tuple>
 #include <unordered_map>
 
 #include "harfbuzz.hpp"
@@ -45,7 +49,8 @@ public:
     GlyphManager(const GlyphManager &) = delete;
     GlyphManager &operator=(const GlyphManager &) = delete;
     explicit GlyphManager(
-        std::unique_ptr<LocalGlyphRasterizer> = std::make_unique<LocalGlyphRasterizer>(std::optional<std::string>()));
+        std::unique_ptr<LocalGlyphRasterizer> = std::make_unique<LocalGlyphRasterizer>(std::optional<std::string>()),
+        std::optional<std::string> localFontFamily = std::nullopt);
     ~GlyphManager();
 
     // Workers send a `getGlyphs` message to the main thread once they have
@@ -64,6 +69,8 @@ public:
     void evict(const std::set<FontStack> &);
 
     Immutable<Glyph> getGlyph(const FontStack &, GlyphID);
+    // Batched `getGlyph`, glyphs that need rasterizing are converted to SDFs in parallel
+    std::vector<Immutable<Glyph>> getGlyphs(const FontStack &, const std::vector<GlyphID> &);
 
     void setFontFaces(std::shared_ptr<FontFaces> faces) { fontFaces = faces; }
 
@@ -77,11 +84,33 @@ public:
 
     std::shared_ptr<FontFaces> getFontFaces() { return fontFaces; }
 
+    struct ShapingCacheStats {
+        std::size_t hits = 0;
+        std::size_t misses = 0;
+        std::size_t entries = 0;
+        std::size_t bytes = 0;
+    };
+    // Counters of `hbShaping` calls answered from the shaping cache
+    ShapingCacheStats getShapingCacheStats() const;
+    // Drop the least recently used shaping results until the cache takes at most the given bytes
+    void trimShapingCache(std::size_t targetBytes);
+
+    // Approximate memory held by the glyphs loaded
+    MemoryUsage getMemoryUsage();
+
     std::string getFontFaceURL(GlyphIDType type);
 
 private:
-    Glyph generateLocalSDF(const FontStack &fontStack, GlyphID glyphID);
+    // Rasterizes the glyphs with `rasterize` on the calling thread, as the platform and FreeType
+    // rasterizers aren't thread-safe, then converts them to SDFs on the background scheduler.
+    // Glyphs found in the `GlyphStore` disk cache under `faceHash` skip both steps.
+    std::vector<Glyph> rasterizeSDFs(std::size_t faceHash,
+                                     const std::vector<GlyphID> &,
+                                     const std::function<Glyph(GlyphID)> &rasterize);
+    std::size_t localFaceHash(const FontStack &) const;
+
     std::string glyphURL;
+    std::optional<std::string> localFontFamily;
 
     struct GlyphRequest {
         bool parsed = false;
@@ -96,6 +125,8 @@ private:
 
     std::unordered_map<FontStack, Entry, FontStackHasher> entries;
 
+    // Fill the entry from the process-wide `GlyphStore`, if it is enabled and has the range
+    bool loadSharedRange(Entry &, const FontStack &, const GlyphRange &);
     void requestRange(GlyphRequest &, const FontStack &, const GlyphRange &, FileSource &fileSource);
     void processResponse(const Response &, const FontStack &, const GlyphRange &);
     void notify(GlyphRequestor &, const GlyphDependencies &);
@@ -108,8 +139,26 @@ private:
 
     FreeTypeLibrary ftLibrary;
     std::map<FontStack, std::map<GlyphIDType, std::shared_ptr<HBShaper>>> hbShapers;
+    // Hashes of the font files the shapers were loaded from
+    std::map<FontStack, std::map<GlyphIDType, std::size_t>> hbShaperHashes;
     bool loadHBShaper(const FontStack &fontStack, GlyphIDType type, const std::string &data);
 
+    // Shaped strings, most recently used first. The same place names are shaped again for
+    // every tile and zoom level they appear in. The script and direction of each run are
+    // derived from the text, so the font face and text identify a result.
+    using ShapingKey = std::tuple<FontStack, GlyphIDType, std::u16string>;
+    struct ShapedText {
+        ShapingKey key;
+        std::vector<GlyphID> glyphIDs;
+        std::vector<HBShapeAdjust> adjusts;
+        std::size_t bytes;
+    };
+    static constexpr std::size_t shapingCacheBudget = 4 * 1024 * 1024;
+    std::list<ShapedText> shapingCache;
+    std::map<ShapingKey, std::list<ShapedText>::iterator> shapingCacheIndex;
+    ShapingCacheStats shapingCacheStats;
+    mutable std::mutex shapingCacheLock;
+
     std::recursive_mutex rwLock;
 };
 
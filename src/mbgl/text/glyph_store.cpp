@@ -0,0 +1,186 @@
+#include <mbgl/text/glyph_store.hpp>
+
+#include <mbgl/util/io.hpp>
+#include <mbgl/util/logging.hpp>
+
+#include <cstring>
+#include <filesystem>
+#include <sstream>
+
+namespace mbgl {
+
+namespace {
+
+constexpr uint32_t sdfFileMagic = 0x31464453; // "SDF1"
+
+// Fixed-size header of a cached glyph, followed by its bitmap
+struct SDFFileHeader {
+    uint32_t magic;
+    uint32_t id;
+    GlyphMetrics metrics;
+    uint32_t width;
+    uint32_t height;
+};
+
+std::size_t glyphBytes(const GlyphStore::RangeGlyphs& glyphs) {
+    std::size_t result = 0;
+    for (const auto& glyph : glyphs) {
+        result += sizeof(Glyph) + glyph->bitmap.bytes();
+    }
+    return result;
+}
+
+} // namespace
+
+GlyphStore& GlyphStore::get() {
+    static GlyphStore store;
+    return store;
+}
+
+void GlyphStore::setBudget(std::size_t bytes_) {
+    std::scoped_lock lock(mutex);
+    budget = bytes_;
+    evict();
+}
+
+std::size_t GlyphStore::getBudget() const {
+    std::scoped_lock lock(mutex);
+    return budget;
+}
+
+std::size_t GlyphStore::getBytes() const {
+    std::scoped_lock lock(mutex);
+    return bytes;
+}
+
+std::shared_ptr<const GlyphStore::RangeGlyphs> GlyphStore::find(const std::string& url,
+                                                                const FontStack& fontStack,
+                                                                const GlyphRange& range) {
+    std::scoped_lock lock(mutex);
+    const auto it = index.find(Key{url, fontStack, range});
+    if (it == index.end()) {
+        return nullptr;
+    }
+    items.splice(items.begin(), items, it->second);
+    return it->second->glyphs;
+}
+
+void GlyphStore::insert(const std::string& url,
+                        const FontStack& fontStack,
+                        const GlyphRange& range,
+                        std::shared_ptr<const RangeGlyphs> glyphs) {
+    std::scoped_lock lock(mutex);
+    if (budget == 0 || !glyphs) {
+        return;
+    }
+
+    Key key{url, fontStack, range};
+    if (const auto it = index.find(key); it != index.end()) {
+        // Another map parsed the same range concurrently, keep the one already shared
+        items.splice(items.begin(), items, it->second);
+        return;
+    }
+
+    const auto size = glyphBytes(*glyphs);
+    items.push_front(Item{key, std::move(glyphs), size});
+    index.emplace(std::move(key), items.begin());
+    bytes += size;
+    evict();
+}
+
+void GlyphStore::clear() {
+    std::scoped_lock lock(mutex);
+    items.clear();
+    index.clear();
+    bytes = 0;
+}
+
+void GlyphStore::setSDFCachePath(const std::string& path) {
+    if (!path.empty()) {
+        std::error_code error;
+        std::filesystem::create_directories(path, error);
+        if (error) {
+            Log::Warning(Event::Glyph, "Unable to create the SDF glyph cache directory " + path);
+        }
+    }
+    std::scoped_lock lock(mutex);
+    sdfCachePath = path;
+}
+
+bool GlyphStore::isSDFCacheEnabled() const {
+    std::scoped_lock lock(mutex);
+    return !sdfCachePath.empty();
+}
+
+std::string GlyphStore::sdfPath(std::size_t faceHash, GlyphID id) const {
+    std::ostringstream path;
+    {
+        std::scoped_lock lock(mutex);
+        if (sdfCachePath.empty()) {
+            return {};
+        }
+        path << sdfCachePath << '/';
+    }
+    path << std::hex << faceHash << '-' << static_cast<uint32_t>(id.hash) << ".sdf";
+    return path.str();
+}
+
+std::optional<Glyph> GlyphStore::readSDF(std::size_t faceHash, GlyphID id) const {
+    const auto path = sdfPath(faceHash, id);
+    if (path.empty()) {
+        return std::nullopt;
+    }
+    const auto data = util::readFile(path);
+    if (!data || data->size() < sizeof(SDFFileHeader)) {
+        return std::nullopt;
+    }
+
+    SDFFileHeader header;
+    std::memcpy(&header, data->data(), sizeof(header));
+    const Size size{header.width, header.height};
+    if (header.magic != sdfFileMagic || header.id != static_cast<uint32_t>(id.hash) ||
+        data->size() != sizeof(header) + size.area()) {
+        return std::nullopt;
+    }
+
+    Glyph glyph;
+    glyph.id = id;
+    glyph.metrics = header.metrics;
+    glyph.bitmap = AlphaImage(size, reinterpret_cast<const uint8_t*>(data->data()) + sizeof(header), size.area());
+    return glyph;
+}
+
+void GlyphStore::writeSDF(std::size_t faceHash, const Glyph& glyph) const {
+    const auto path = sdfPath(faceHash, glyph.id);
+    if (path.empty()) {
+        return;
+    }
+
+    const SDFFileHeader header{sdfFileMagic,
+                               static_cast<uint32_t>(glyph.id.hash),
+                               glyph.metrics,
+                               glyph.bitmap.size.width,
+                               glyph.bitmap.size.height};
+    std::string data(sizeof(header) + glyph.bitmap.bytes(), '\0');
+    std::memcpy(data.data(), &header, sizeof(header));
+    if (glyph.bitmap.bytes()) {
+        std::memcpy(data.data() + sizeof(header), glyph.bitmap.data.get(), glyph.bitmap.bytes());
+    }
+
+    try {
+        util::write_file(path, data);
+    } catch (const std::exception& e) {
+        Log::Warning(Event::Glyph, std::string("Unable to cache SDF glyph: ") + e.what());
+    }
+}
+
+void GlyphStore::evict() {
+    while (!items.empty() && bytes > budget) {
+        const auto& item = items.back();
+        bytes -= item.bytes;
+        index.erase(item.key);
+        items.pop_back();
+    }
+}
+
+} // namespace mbgl
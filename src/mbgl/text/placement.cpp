@@ -1,6 +1,7 @@
 #include <mbgl/text/placement.hpp>
 
 #include <mbgl/layout/symbol_layout.hpp>
+#include <mbgl/platform/settings.hpp>
 #include <mbgl/renderer/bucket.hpp>
 #include <mbgl/renderer/buckets/symbol_bucket.hpp>
 #include <mbgl/renderer/render_layer.hpp>
@@ -9,7 +10,9 @@
 #include <mbgl/tile/geometry_tile.hpp>
 #include <mbgl/util/instrumentation.hpp>
 #include <mbgl/util/math.hpp>
+#include <mbgl/util/parallel_for.hpp>
 
+#include <bitset>
 #include <list>
 #include <utility>
 
@@ -190,6 +193,17 @@ Placement::Placement(std::shared_ptr<const UpdateParameters> updateParameters_,
     if (prevPlacement) {
         prevPlacement->get()->prevPlacement = std::nullopt; // Only hold on to one placement back
     }
+    const auto& settings = platform::Settings::getInstance();
+    const auto parallelValue = settings.get(platform::EXPERIMENTAL_PARALLEL_PLACEMENT_PRESORT);
+    if (const auto* parallel = parallelValue.getBool()) {
+        parallelSort = *parallel;
+    }
+    const auto thresholdValue = settings.get(platform::EXPERIMENTAL_INCREMENTAL_PLACEMENT_THRESHOLD);
+    // Static renders have no previous placement to reuse
+    const auto* threshold = thresholdValue.getDouble();
+    if (threshold && updateParameters->mode == MapMode::Continuous) {
+        reuseThreshold = static_cast<float>(*threshold);
+    }
 }
 
 Placement::Placement()
@@ -199,13 +213,42 @@ Placement::Placement()
 Placement::~Placement() = default;
 
 void Placement::placeLayers(const RenderLayerReferences& layers) {
+    if (parallelSort) {
+        presortSymbols(layers);
+    }
     for (auto it = layers.crbegin(); it != layers.crend(); ++it) {
         std::set<uint32_t> seenCrossTileIDs;
         placeLayer(*it, seenCrossTileIDs);
     }
+    presortedSymbols.clear();
     commit();
 }
 
+void Placement::presortSymbols(const RenderLayerReferences& layers) {
+    MLN_TRACE_FUNC();
+    // Sorting only depends on the bucket, the transform and the previous placement, none of which
+    // change while placing, so doing it up front gives the same order the serial path would.
+    std::vector<const BucketPlacementData*> buckets;
+    for (const RenderLayer& layer : layers) {
+        for (const BucketPlacementData& data : layer.getPlacementData()) {
+            buckets.push_back(&data);
+        }
+    }
+    if (buckets.size() < 2) {
+        return;
+    }
+
+    std::vector<SymbolInstanceReferences> sorted(buckets.size());
+    util::parallelFor(buckets.size(), [&](std::size_t i) {
+        sorted[i] = getSortedSymbols(*buckets[i], 0.0f);
+    });
+
+    presortedSymbols.reserve(buckets.size());
+    for (std::size_t i = 0; i < buckets.size(); ++i) {
+        presortedSymbols.emplace(buckets[i], std::move(sorted[i]));
+    }
+}
+
 void Placement::placeLayer(const RenderLayer& layer, std::set<uint32_t>& seenCrossTileIDs) {
     for (const BucketPlacementData& data : layer.getPlacementData()) {
         Bucket& bucket = data.bucket;
@@ -231,6 +274,34 @@ Point<float> calculateVariableLayoutOffset(style::SymbolAnchorType anchor,
     }
     return shift;
 }
+
+std::size_t getSymbolIndex(const SymbolBucket& bucket, const SymbolInstance& symbol) {
+    assert(&symbol >= bucket.symbolInstances.data() &&
+           &symbol < bucket.symbolInstances.data() + bucket.symbolInstances.size());
+    return static_cast<std::size_t>(&symbol - bucket.symbolInstances.data());
+}
+
+using CulledCells = std::bitset<SymbolBucket::cullingGridSize * SymbolBucket::cullingGridSize>;
+
+/// The cells of the bucket whose symbols can't have any box inside the collision grid, so that placing them would
+/// only find that out one symbol at a time
+CulledCells cullCells(const CollisionIndex& collisionIndex, const PlacementContext& ctx) {
+    CulledCells culled;
+    // Symbols shown whatever their placement and those along lines, whose boxes follow the line, are placed as usual
+    if (ctx.placementType != SymbolPlacementType::Point || ctx.alwaysShowText || ctx.alwaysShowIcon ||
+        ctx.getRenderTile().holdForFade()) {
+        return culled;
+    }
+    const auto& cells = ctx.getBucket().cullingCells;
+    for (std::size_t i = 0; i < cells.size(); ++i) {
+        const auto& cell = cells[i];
+        if (!cell.empty() && !collisionIndex.mayReachGrid(
+                                 ctx.getRenderTile().matrix, cell.min, cell.max, cell.reach * ctx.pixelRatio)) {
+            culled.set(i);
+        }
+    }
+    return culled;
+}
 } // namespace
 
 void Placement::placeSymbolBucket(const BucketPlacementData& params, std::set<uint32_t>& seenCrossTileIDs) {
@@ -243,17 +314,46 @@ void Placement::placeSymbolBucket(const BucketPlacementData& params, std::set<ui
                          placementZoom,
                          collisionGroups.get(params.sourceId),
                          getAvoidEdges(symbolBucket, renderTile.matrix)};
-    for (const SymbolInstance& symbol : getSortedSymbols(params, ctx.pixelRatio)) {
+    auto presorted = presortedSymbols.find(&params);
+    const SymbolInstanceReferences sortedSymbols = presorted != presortedSymbols.end()
+                                                       ? std::move(presorted->second)
+                                                       : getSortedSymbols(params, ctx.pixelRatio);
+
+    Point<float> shift;
+    const BucketRecord* previousRecord = nullptr;
+    if (reuseThreshold) {
+        bucketRecord = &bucketRecords[symbolBucket.bucketInstanceId];
+        bucketRecord->tileBoundaries = collisionIndex.projectTileBoundaries(renderTile.matrix);
+        previousRecord = getReusableRecord(symbolBucket, renderTile, bucketRecord->tileBoundaries, shift);
+    }
+
+    // Tile placement reports the boxes of unplaced symbols as well, see TilePlacement::newSymbolPlaced()
+    const CulledCells culledCells = updateParameters->mode != MapMode::Tile ? cullCells(collisionIndex, ctx)
+                                                                            : CulledCells();
+    const auto& cells = symbolBucket.placementFields.cells;
+
+    // Symbols already placed from another tile are skipped without reading their symbol instance
+    const auto& crossTileIDs = symbolBucket.placementFields.crossTileIDs;
+    const bool packedCrossTileIDs = crossTileIDs.size() == symbolBucket.symbolInstances.size();
+    for (const SymbolInstance& symbol : sortedSymbols) {
+        const auto crossTileID = packedCrossTileIDs ? crossTileIDs[getSymbolIndex(symbolBucket, symbol)]
+                                                    : symbol.getCrossTileID();
+        if (seenCrossTileIDs.contains(crossTileID)) continue;
         if (!symbol.check(SYM_GUARD_LOC)) continue;
-        if (seenCrossTileIDs.contains(symbol.getCrossTileID())) continue;
-        placeSymbol(symbol, ctx);
+        if (culledCells.any() && culledCells.test(cells[getSymbolIndex(symbolBucket, symbol)])) {
+            cullSymbol(symbol, ctx);
+        } else if (!previousRecord || !reuseSymbol(symbol, ctx, *previousRecord, shift)) {
+            placeSymbol(symbol, ctx);
+        }
 
         // Prevent a flickering issue while zooming out.
-        if (symbol.getCrossTileID() != SymbolInstance::invalidCrossTileID && !ctx.getRenderTile().holdForFade()) {
-            seenCrossTileIDs.insert(symbol.getCrossTileID());
+        if (crossTileID != SymbolInstance::invalidCrossTileID && !ctx.getRenderTile().holdForFade()) {
+            seenCrossTileIDs.insert(crossTileID);
         }
     }
 
+    bucketRecord = nullptr;
+
     // Prevent a flickering issue when a symbol is moved.
     symbolBucket.justReloaded = false;
 
@@ -265,6 +365,129 @@ void Placement::placeSymbolBucket(const BucketPlacementData& params, std::set<ui
         std::forward_as_tuple(symbolBucket.bucketInstanceId, params.featureIndex, ctx.getOverscaledID()));
 }
 
+const Placement::BucketRecord* Placement::getReusableRecord(const SymbolBucket& bucket,
+                                                            const RenderTile& renderTile,
+                                                            const CollisionBoundaries& tileBoundaries,
+                                                            Point<float>& shift) const {
+    const auto* previousPlacement = getPrevPlacement();
+    if (!previousPlacement || bucket.justReloaded || renderTile.holdForFade() || showCollisionBoxes) {
+        return nullptr;
+    }
+    const auto previous = previousPlacement->bucketRecords.find(bucket.bucketInstanceId);
+    if (previous == previousPlacement->bucketRecords.end()) {
+        return nullptr;
+    }
+
+    // The tile's projected corners bound how far any of its boxes moved since the last placement
+    const auto& previousBoundaries = previous->second.tileBoundaries;
+    for (std::size_t i = 0; i < tileBoundaries.size(); ++i) {
+        if (std::abs(tileBoundaries[i] - previousBoundaries[i]) > *reuseThreshold) {
+            return nullptr;
+        }
+    }
+    shift = {(tileBoundaries[0] + tileBoundaries[2] - previousBoundaries[0] - previousBoundaries[2]) / 2.0f,
+             (tileBoundaries[1] + tileBoundaries[3] - previousBoundaries[1] - previousBoundaries[3]) / 2.0f};
+    return &previous->second;
+}
+
+bool Placement::reuseSymbol(const SymbolInstance& symbolInstance,
+                            const PlacementContext& ctx,
+                            const BucketRecord& previousRecord,
+                            Point<float> shift) {
+    const SymbolBucket& bucket = ctx.getBucket();
+    const auto crossTileID = symbolInstance.getCrossTileID();
+    if (crossTileID == SymbolInstance::invalidCrossTileID) return false;
+
+    const auto previous = previousRecord.symbols.find(getSymbolIndex(bucket, symbolInstance));
+    if (previous == previousRecord.symbols.end()) {
+        // Symbols that didn't fit before get a full placement, whatever blocked them may be gone
+        return false;
+    }
+
+    PlacedSymbolRecord record = previous->second;
+    const auto& collisionGroup = ctx.collisionGroup;
+    const bool placeText = !record.textBoxes.empty();
+    const bool placeIcon = !record.iconBoxes.empty();
+    bool offscreen = true;
+    if (placeText) {
+        const auto placedText = collisionIndex.placeShiftedFeature(
+            record.textBoxes, shift, ctx.textAllowOverlap, collisionGroup.second);
+        if (!placedText.first) return false;
+        offscreen &= placedText.second;
+    }
+    if (placeIcon) {
+        const auto placedIcon = collisionIndex.placeShiftedFeature(
+            record.iconBoxes, shift, ctx.iconAllowOverlap, collisionGroup.second);
+        if (!placedIcon.first) return false;
+        offscreen &= placedIcon.second;
+    }
+
+    if (placeText) {
+        insertTextFeature(symbolInstance, ctx, record.verticalText, record.textBoxes);
+    }
+    if (placeIcon) {
+        insertIconFeature(symbolInstance, ctx, record.verticalIcon, record.iconBoxes);
+    }
+
+    // Keep the anchor and orientation the boxes were projected with
+    const auto* previousPlacement = getPrevPlacement();
+    if (const auto prevOffset = previousPlacement->variableOffsets.find(crossTileID);
+        prevOffset != previousPlacement->variableOffsets.end()) {
+        variableOffsets.insert_or_assign(crossTileID, prevOffset->second);
+    }
+    if (const auto prevOrientation = previousPlacement->placedOrientations.find(crossTileID);
+        prevOrientation != previousPlacement->placedOrientations.end()) {
+        placedOrientations.insert_or_assign(crossTileID, prevOrientation->second);
+    }
+
+    // Same as in placeSymbol(), a result from a fading tile is superseded
+    placements.erase(crossTileID);
+    JointPlacement result(placeText || ctx.alwaysShowText, placeIcon || ctx.alwaysShowIcon, offscreen);
+    placements.emplace(crossTileID, result);
+    newSymbolPlaced(symbolInstance, ctx, result, ctx.placementType, record.textBoxes, record.iconBoxes);
+    bucketRecord->symbols.insert_or_assign(previous->first, std::move(record));
+    return true;
+}
+
+void Placement::cullSymbol(const SymbolInstance& symbolInstance, const PlacementContext& ctx) {
+    const auto crossTileID = symbolInstance.getCrossTileID();
+    if (crossTileID == SymbolInstance::invalidCrossTileID) return;
+
+    // What placeSymbol() gives a symbol none of whose boxes are inside the grid. The previous anchor and
+    // orientation of the symbol, if still fading out, are carried over by commit().
+    placements.erase(crossTileID);
+    const JointPlacement result(false, false, ctx.getBucket().justReloaded);
+    placements.emplace(crossTileID, result);
+    newSymbolPlaced(symbolInstance, ctx, result, ctx.placementType, {}, {});
+    ++culledSymbols;
+}
+
+void Placement::insertTextFeature(const SymbolInstance& symbolInstance,
+                                  const PlacementContext& ctx,
+                                  bool vertical,
+                                  const std::vector<ProjectedCollisionBox>& boxes) {
+    const auto& feature = vertical ? *symbolInstance.getVerticalTextCollisionFeature()
+                                   : symbolInstance.getTextCollisionFeature();
+    collisionIndex.insertFeature(feature,
+                                 boxes,
+                                 ctx.getLayout().get<TextIgnorePlacement>(),
+                                 ctx.getBucket().bucketInstanceId,
+                                 ctx.collisionGroup.first);
+}
+
+void Placement::insertIconFeature(const SymbolInstance& symbolInstance,
+                                  const PlacementContext& ctx,
+                                  bool vertical,
+                                  const std::vector<ProjectedCollisionBox>& boxes) {
+    const auto& feature = vertical ? *symbolInstance.getVerticalIconCollisionFeature()
+                                   : symbolInstance.getIconCollisionFeature();
+    collisionIndex.insertFeature(feature,
+                                 boxes,
+                                 ctx.getLayout().get<IconIgnorePlacement>(),
+                                 ctx.getBucket().bucketInstanceId,
+                                 ctx.collisionGroup.first);
+}
+
 JointPlacement Placement::placeSymbol(const SymbolInstance& symbolInstance, const PlacementContext& ctx) {
     static const JointPlacement kUnplaced(false, false, false);
     if (!symbolInstance.check(SYM_GUARD_LOC)) return kUnplaced;
@@ -370,24 +593,24 @@ JointPlacement Placement::placeSymbol(const SymbolInstance& symbolInstance, cons
             // If this symbol was in the last placement, shift the previously
             // used anchor to the front of the anchor list, only if the previous
             // anchor is still in the anchor list.
+            const VariableOffset* prevOffset = nullptr;
             if (getPrevPlacement()) {
-                auto prevOffset = getPrevPlacement()->variableOffsets.find(symbolInstance.getCrossTileID());
-                if (prevOffset != getPrevPlacement()->variableOffsets.end()) {
-                    const auto prevAnchor = prevOffset->second.anchor;
-                    auto found = std::find(variableTextAnchors.begin(), variableTextAnchors.end(), prevAnchor);
-                    if (found != variableTextAnchors.begin() && found != variableTextAnchors.end()) {
-                        std::vector<style::TextVariableAnchorType> filtered{prevAnchor};
-                        if (!isTiltedView()) {
-                            for (auto anchor : variableTextAnchors) {
-                                if (anchor != prevAnchor) {
-                                    filtered.push_back(anchor);
-                                }
-                            }
-                        }
-                        variableTextAnchors = std::move(filtered);
+                const auto found = getPrevPlacement()->variableOffsets.find(symbolInstance.getCrossTileID());
+                if (found != getPrevPlacement()->variableOffsets.end()) {
+                    prevOffset = &found->second;
+                }
+            }
+            if (prevOffset) {
+                auto found = std::find(variableTextAnchors.begin(), variableTextAnchors.end(), prevOffset->anchor);
+                if (found != variableTextAnchors.begin() && found != variableTextAnchors.end()) {
+                    // In place, keeping the order of the other anchors
+                    std::rotate(variableTextAnchors.begin(), found, found + 1);
+                    if (isTiltedView()) {
+                        variableTextAnchors.resize(1);
                     }
                 }
             }
+            const auto& variableAnchorOffsets = *symbolInstance.getTextVariableAnchorOffset();
 
             const bool doVariableIconPlacement = ctx.hasIconTextFit && !ctx.iconAllowOverlap &&
                                                  symbolInstance.getPlacedIconIndex();
@@ -406,7 +629,7 @@ JointPlacement Placement::placeSymbol(const SymbolInstance& symbolInstance, cons
                     // so this code would not be reached
                     // NOLINTNEXTLINE(clang-analyzer-core.DivideZero)
                     auto anchor = variableTextAnchors[i % anchorsSize];
-                    auto variableTextOffset = symbolInstance.getTextVariableAnchorOffset()->getOffsetByAnchor(anchor);
+                    auto variableTextOffset = variableAnchorOffsets.getOffsetByAnchor(anchor);
                     const bool allowOverlap = (i >= anchorsSize);
                     shift = calculateVariableLayoutOffset(anchor,
                                                           width,
@@ -421,6 +644,7 @@ JointPlacement Placement::placeSymbol(const SymbolInstance& symbolInstance, cons
                             textBox, anchor, shift, variableTextAnchors, posMatrix, ctx.pixelRatio)) {
                         continue;
                     }
+                    ++variableAnchorTests;
 
                     placedFeature = collisionIndex.placeFeature(textCollisionFeature,
                                                                 shift,
@@ -460,17 +684,18 @@ JointPlacement Placement::placeSymbol(const SymbolInstance& symbolInstance, cons
                     if (placedFeature.first) {
                         assert(symbolInstance.getCrossTileID() != 0u);
                         std::optional<style::TextVariableAnchorType> prevAnchor;
+                        if (i == 0 && prevOffset && anchor == prevOffset->anchor) {
+                            ++previousAnchorPlacements;
+                        }
 
                         // If this label was placed in the previous
                         // placement, record the anchor position to allow us
                         // to animate the transition
-                        if (getPrevPlacement()) {
-                            auto prevOffset = getPrevPlacement()->variableOffsets.find(symbolInstance.getCrossTileID());
+                        if (prevOffset) {
                             auto prevPlacements = getPrevPlacement()->placements.find(symbolInstance.getCrossTileID());
-                            if (prevOffset != getPrevPlacement()->variableOffsets.end() &&
-                                prevPlacements != getPrevPlacement()->placements.end() && prevPlacements->second.text) {
+                            if (prevPlacements != getPrevPlacement()->placements.end() && prevPlacements->second.text) {
                                 // TODO: The prevAnchor seems to be unused, needs to be fixed.
-                                prevAnchor = prevOffset->second.anchor;
+                                prevAnchor = prevOffset->anchor;
                             }
                         }
 
@@ -519,11 +744,8 @@ JointPlacement Placement::placeSymbol(const SymbolInstance& symbolInstance, cons
 
             // If we didn't get placed, we still need to copy our position from
             // the last placement for fade animations
-            if (!placeText && getPrevPlacement()) {
-                auto prevOffset = getPrevPlacement()->variableOffsets.find(symbolInstance.getCrossTileID());
-                if (prevOffset != getPrevPlacement()->variableOffsets.end()) {
-                    variableOffsets[symbolInstance.getCrossTileID()] = prevOffset->second;
-                }
+            if (!placeText && prevOffset) {
+                variableOffsets[symbolInstance.getCrossTileID()] = *prevOffset;
             }
         }
     }
@@ -575,36 +797,14 @@ JointPlacement Placement::placeSymbol(const SymbolInstance& symbolInstance, cons
         placeIcon = placeText && placeIcon;
     }
 
+    const bool verticalText = placedVerticalText.first && symbolInstance.getVerticalTextCollisionFeature();
+    const bool verticalIcon = placedVerticalIcon.first && symbolInstance.getVerticalIconCollisionFeature();
     if (placeText) {
-        if (placedVerticalText.first && symbolInstance.getVerticalTextCollisionFeature()) {
-            collisionIndex.insertFeature(*symbolInstance.getVerticalTextCollisionFeature(),
-                                         textBoxes,
-                                         ctx.getLayout().get<TextIgnorePlacement>(),
-                                         bucket.bucketInstanceId,
-                                         collisionGroup.first);
-        } else {
-            collisionIndex.insertFeature(symbolInstance.getTextCollisionFeature(),
-                                         textBoxes,
-                                         ctx.getLayout().get<TextIgnorePlacement>(),
-                                         bucket.bucketInstanceId,
-                                         collisionGroup.first);
-        }
+        insertTextFeature(symbolInstance, ctx, verticalText, textBoxes);
     }
 
     if (placeIcon) {
-        if (placedVerticalIcon.first && symbolInstance.getVerticalIconCollisionFeature()) {
-            collisionIndex.insertFeature(*symbolInstance.getVerticalIconCollisionFeature(),
-                                         iconBoxes,
-                                         ctx.getLayout().get<IconIgnorePlacement>(),
-                                         bucket.bucketInstanceId,
-                                         collisionGroup.first);
-        } else {
-            collisionIndex.insertFeature(symbolInstance.getIconCollisionFeature(),
-                                         iconBoxes,
-                                         ctx.getLayout().get<IconIgnorePlacement>(),
-                                         bucket.bucketInstanceId,
-                                         collisionGroup.first);
-        }
+        insertIconFeature(symbolInstance, ctx, verticalIcon, iconBoxes);
     }
 
     const bool hasIconCollisionCircleData = bucket.hasIconCollisionCircleData();
@@ -638,6 +838,12 @@ JointPlacement Placement::placeSymbol(const SymbolInstance& symbolInstance, cons
     JointPlacement result(
         placeText || ctx.alwaysShowText, placeIcon || ctx.alwaysShowIcon, offscreen || bucket.justReloaded);
     placements.emplace(symbolInstance.getCrossTileID(), result);
+    if (bucketRecord && (placeText || placeIcon)) {
+        PlacedSymbolRecord record{.verticalText = verticalText, .verticalIcon = verticalIcon};
+        if (placeText) record.textBoxes = textBoxes;
+        if (placeIcon) record.iconBoxes = iconBoxes;
+        bucketRecord->symbols.insert_or_assign(getSymbolIndex(bucket, symbolInstance), std::move(record));
+    }
     newSymbolPlaced(symbolInstance, ctx, result, ctx.placementType, textBoxes, iconBoxes);
     return result;
 }
@@ -658,7 +864,7 @@ SymbolInstanceReferences getBucketSymbols(const SymbolBucket& bucket,
 
 } // namespace
 
-SymbolInstanceReferences Placement::getSortedSymbols(const BucketPlacementData& params, float) {
+SymbolInstanceReferences Placement::getSortedSymbols(const BucketPlacementData& params, float) const {
     const auto& bucket = static_cast<const SymbolBucket&>(params.bucket.get());
     SymbolInstanceReferences sortedSymbols = getBucketSymbols(
         bucket, params.sortKeyRange, collisionIndex.getTransformState().getBearing());
@@ -962,9 +1168,16 @@ bool Placement::updateBucketDynamicVertices(SymbolBucket& bucket,
 void Placement::updateBucketOpacities(SymbolBucket& bucket,
                                       const TransformState& state,
                                       std::set<uint32_t>& seenCrossTileIDs) const {
-    if (bucket.hasTextData()) bucket.text.sharedOpacityVertices->clear();
-    if (bucket.hasIconData()) bucket.icon.sharedOpacityVertices->clear();
-    if (bucket.hasSdfIconData()) bucket.sdfIcon.sharedOpacityVertices->clear();
+    // Opacity vertices are rewritten in place rather than cleared, so that only the spans whose
+    // opacity actually changed are marked as modified and uploaded again.
+    std::size_t textOpacityIndex = 0;
+    std::size_t iconOpacityIndex = 0;
+    std::size_t sdfIconOpacityIndex = 0;
+    const auto truncateOpacityVertices = [&] {
+        if (bucket.hasTextData()) bucket.text.opacityVertices().truncate(textOpacityIndex);
+        if (bucket.hasIconData()) bucket.icon.opacityVertices().truncate(iconOpacityIndex);
+        if (bucket.hasSdfIconData()) bucket.sdfIcon.opacityVertices().truncate(sdfIconOpacityIndex);
+    };
     if (bucket.hasIconCollisionBoxData()) bucket.iconCollisionBox->dynamicVertices().clear();
     if (bucket.hasIconCollisionCircleData()) bucket.iconCollisionCircle->dynamicVertices().clear();
     if (bucket.hasTextCollisionBoxData()) bucket.textCollisionBox->dynamicVertices().clear();
@@ -1011,8 +1224,10 @@ void Placement::updateBucketOpacities(SymbolBucket& bucket,
             if (!symbolInstance.checkIndexes(bucket.text.placedSymbols.size(),
                                              bucket.icon.placedSymbols.size(),
                                              bucket.sdfIcon.placedSymbols.size(),
-                                             SYM_GUARD_LOC))
+                                             SYM_GUARD_LOC)) {
+                truncateOpacityVertices();
                 return;
+            }
         }
         if (symbolInstance.hasText()) {
             size_t textOpacityVerticesSize = 0u;
@@ -1039,7 +1254,8 @@ void Placement::updateBucketOpacities(SymbolBucket& bucket,
                     opacityState.isHidden();
             }
 
-            bucket.text.opacityVertices().extend(textOpacityVerticesSize, opacityVertex);
+            bucket.text.opacityVertices().assign(textOpacityIndex, textOpacityVerticesSize, opacityVertex);
+            textOpacityIndex += textOpacityVerticesSize;
 
             style::TextWritingModeType previousOrientation = style::TextWritingModeType::Horizontal;
             if (bucket.allowVerticalPlacement) {
@@ -1060,6 +1276,7 @@ void Placement::updateBucketOpacities(SymbolBucket& bucket,
             const auto& opacityVertex = SymbolBucket::opacityVertex(opacityState.icon.placed,
                                                                     opacityState.icon.opacity);
             auto& iconBuffer = symbolInstance.hasSdfIcon() ? bucket.sdfIcon : bucket.icon;
+            auto& iconIndex = symbolInstance.hasSdfIcon() ? sdfIconOpacityIndex : iconOpacityIndex;
 
             if (symbolInstance.getPlacedIconIndex()) {
                 iconOpacityVerticesSize += symbolInstance.getIconQuadsSize() * 4;
@@ -1071,7 +1288,8 @@ void Placement::updateBucketOpacities(SymbolBucket& bucket,
                 iconBuffer.placedSymbols[*symbolInstance.getPlacedVerticalIconIndex()].hidden = opacityState.isHidden();
             }
 
-            iconBuffer.opacityVertices().extend(iconOpacityVerticesSize, opacityVertex);
+            iconBuffer.opacityVertices().assign(iconIndex, iconOpacityVerticesSize, opacityVertex);
+            iconIndex += iconOpacityVerticesSize;
         }
 
         auto updateIconCollisionBox = [&](const auto& feature, const bool placed, const Point<float>& shift) {
@@ -1165,6 +1383,7 @@ void Placement::updateBucketOpacities(SymbolBucket& bucket,
             updateCollisionCircles(symbolInstance.getTextCollisionFeature(), opacityState.text.placed, true);
         }
     }
+    truncateOpacityVertices();
 
     bucket.sortFeatures(static_cast<float>(state.getBearing()));
     static_cast<Bucket&>(bucket).check(SYM_GUARD_LOC);
@@ -1543,7 +1762,7 @@ void TilePlacement::placeSymbolBucket(const BucketPlacementData& params, std::se
                                          const SymbolInstance& symbol) noexcept -> IntersectStatus {
         IntersectStatus result;
         std::optional<style::TextVariableAnchorType> variableAnchor;
-        auto textVariableAnchorOffset = symbol.getTextVariableAnchorOffset();
+        const auto& textVariableAnchorOffset = symbol.getTextVariableAnchorOffset();
         if (textVariableAnchorOffset && !textVariableAnchorOffset->empty()) {
             variableAnchor = textVariableAnchorOffset->begin()->anchorType;
         }
@@ -138,6 +138,13 @@ public:
 
     const RetainedQueryData& getQueryData(uint32_t bucketInstanceId) const;
 
+    // Number of symbols skipped without being projected, their cell of the tile being outside the collision grid
+    std::size_t getCulledSymbolCount() const { return culledSymbols; }
+    // Number of collision tests of labels at variable anchors, and of labels placed on the first test at the anchor
+    // they had in the previous placement
+    std::size_t getVariableAnchorTestCount() const { return variableAnchorTests; }
+    std::size_t getPreviousAnchorPlacementCount() const { return previousAnchorPlacements; }
+
     // Public constructors are required for makeMutable(), shall not be called directly.
     Placement();
     Placement(std::shared_ptr<const UpdateParameters>, std::optional<Immutable<Placement>> prevPlacement);
@@ -159,7 +166,40 @@ protected:
     virtual std::optional<CollisionBoundaries> getAvoidEdges(const SymbolBucket&, const mat4& /*posMatrix*/) {
         return std::nullopt;
     }
-    SymbolInstanceReferences getSortedSymbols(const BucketPlacementData&, float pixelRatio);
+    SymbolInstanceReferences getSortedSymbols(const BucketPlacementData&, float pixelRatio) const;
+    // Fills `presortedSymbols` for the given layers, sorting the buckets concurrently
+    void presortSymbols(const RenderLayerReferences&);
+
+    // What a placed symbol inserted into the collision index, kept for the next placement
+    struct PlacedSymbolRecord {
+        bool verticalText = false;
+        bool verticalIcon = false;
+        std::vector<ProjectedCollisionBox> textBoxes;
+        std::vector<ProjectedCollisionBox> iconBoxes;
+    };
+    struct BucketRecord {
+        CollisionBoundaries tileBoundaries{};
+        // Keyed by the symbol's index in `SymbolBucket::symbolInstances`
+        std::unordered_map<std::size_t, PlacedSymbolRecord> symbols;
+    };
+    // Returns the previous placement's record of the bucket if its symbols may be reused, along with
+    // the screen offset to apply to their boxes
+    const BucketRecord* getReusableRecord(const SymbolBucket&,
+                                          const RenderTile&,
+                                          const CollisionBoundaries& tileBoundaries,
+                                          Point<float>& shift) const;
+    // Places the symbol with its previous boxes, returns `false` if it needs a full placement
+    bool reuseSymbol(const SymbolInstance&, const PlacementContext&, const BucketRecord&, Point<float> shift);
+    // Marks the symbol unplaced, as placing it outside the collision grid would
+    void cullSymbol(const SymbolInstance&, const PlacementContext&);
+    void insertTextFeature(const SymbolInstance&,
+                           const PlacementContext&,
+                           bool vertical,
+                           const std::vector<ProjectedCollisionBox>&);
+    void insertIconFeature(const SymbolInstance&,
+                           const PlacementContext&,
+                           bool vertical,
+                           const std::vector<ProjectedCollisionBox>&);
     virtual bool canPlaceAtVariableAnchor(const CollisionBox&,
                                           style::TextVariableAnchorType,
                                           Point<float> /*shift*/,
@@ -200,6 +240,17 @@ protected:
     CollisionGroups collisionGroups;
     mutable std::optional<Immutable<Placement>> prevPlacement;
     bool showCollisionBoxes = false;
+    bool parallelSort = false;
+    // Symbols sorted ahead of placement, see `presortSymbols()`
+    std::unordered_map<const BucketPlacementData*, SymbolInstanceReferences> presortedSymbols;
+    // Screen distance within which a tile's symbols reuse their previous placement, unset when disabled
+    std::optional<float> reuseThreshold;
+    std::unordered_map<uint32_t, BucketRecord> bucketRecords;
+    // Record of the bucket being placed, if any
+    BucketRecord* bucketRecord = nullptr;
+    std::size_t culledSymbols = 0;
+    std::size_t variableAnchorTests = 0;
+    std::size_t previousAnchorPlacements = 0;
 
     // Cache being used by placeSymbol()
     std::vector<ProjectedCollisionBox> textBoxes;
@@ -10,15 +10,24 @@ char16_t PUAend = u'\uF8FF';
 
 namespace mbgl {
 
+std::shared_ptr<const FontStack> FontStackInterner::intern(const FontStack &fontStack) {
+    auto &shared = fontStacks[FontStackHasher()(fontStack)];
+    if (!shared || *shared != fontStack) {
+        // On a collision the sections made so far keep the stack they share
+        shared = std::make_shared<const FontStack>(fontStack);
+    }
+    return shared;
+}
+
 void TaggedString::addTextSection(const std::u16string &sectionText,
                                   double scale,
-                                  const FontStack &fontStack,
+                                  std::shared_ptr<const FontStack> fontStack,
                                   GlyphIDType type,
                                   bool keySection,
                                   std::optional<Color> textColor) {
     styledText.first += sectionText;
     auto startIndex = static_cast<uint32_t>(styledText.first.size());
-    sections.emplace_back(scale, fontStack, type, startIndex, std::move(textColor));
+    sections.emplace_back(scale, std::move(fontStack), type, startIndex, std::move(textColor));
     styledText.second.resize(styledText.first.size(), static_cast<uint8_t>(sections.size() - 1));
     supportsVerticalWritingMode = std::nullopt;
     if (type != GlyphIDType::FontPBF) hasNeedShapeTextVal = true;
@@ -27,12 +36,13 @@ void TaggedString::addTextSection(const std::u16string &sectionText,
 
 void TaggedString::addTextSection(const std::u16string &sectionText,
                                   double scale,
-                                  const FontStack &fontStack,
+                                  std::shared_ptr<const FontStack> fontStack,
                                   GlyphIDType type,
                                   std::shared_ptr<std::vector<HBShapeAdjust>> &adjusts,
                                   bool keySection,
                                   std::optional<Color> textColor) {
-    sections.emplace_back(scale, fontStack, type, static_cast<uint32_t>(styledText.first.size()), std::move(textColor));
+    sections.emplace_back(
+        scale, std::move(fontStack), type, static_cast<uint32_t>(styledText.first.size()), std::move(textColor));
     styledText.first += sectionText;
     styledText.second.resize(styledText.first.size(), static_cast<uint8_t>(sections.size() - 1));
     if (type != GlyphIDType::FontPBF) hasNeedShapeTextVal = true;
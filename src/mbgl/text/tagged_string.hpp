@@ -5,23 +5,43 @@
 #include <mbgl/style/expression/formatted.hpp>
 #include <mbgl/util/font_stack.hpp>
 
+#include <memory>
 #include <optional>
+#include <unordered_map>
 
 namespace mbgl {
 
+/// Hands out a single shared copy of each font stack, so that the sections of the labels of a tile don't each
+/// copy the font names, nor do the copies of those sections made for each line of a label
+class FontStackInterner {
+public:
+    std::shared_ptr<const FontStack> intern(const FontStack&);
+
+private:
+    std::unordered_map<FontStackHash, std::shared_ptr<const FontStack>> fontStacks;
+};
+
 struct SectionOptions {
     SectionOptions(double scale_,
-                   FontStack fontStack_,
+                   std::shared_ptr<const FontStack> fontStack_,
                    GlyphIDType type_,
                    uint32_t startIndex_,
                    std::optional<Color> textColor_ = std::nullopt)
         : scale(scale_),
-          fontStack(fontStack_),
-          fontStackHash(FontStackHasher()(std::move(fontStack_))),
+          fontStack(std::move(fontStack_)),
+          fontStackHash(FontStackHasher()(fontStack ? *fontStack : FontStack{})),
           type(type_),
           startIndex(startIndex_),
           textColor(std::move(textColor_)) {}
 
+    SectionOptions(double scale_,
+                   const FontStack& fontStack_,
+                   GlyphIDType type_,
+                   uint32_t startIndex_,
+                   std::optional<Color> textColor_ = std::nullopt)
+        : SectionOptions(
+              scale_, std::make_shared<const FontStack>(fontStack_), type_, startIndex_, std::move(textColor_)) {}
+
     SectionOptions(double scale_,
                    FontStackHash fontStackHash_,
                    GlyphIDType type_,
@@ -39,7 +59,8 @@ struct SectionOptions {
           imageID(std::move(imageID_)) {}
 
     double scale;
-    FontStack fontStack;
+    /// Null for image sections, and for those made from a hash alone
+    std::shared_ptr<const FontStack> fontStack;
     FontStackHash fontStackHash;
 
     GlyphIDType type;
@@ -98,14 +119,14 @@ struct TaggedString {
 
     void addTextSection(const std::u16string& text,
                         double scale,
-                        const FontStack& fontStack,
+                        std::shared_ptr<const FontStack> fontStack,
                         GlyphIDType type,
                         bool keySection = true,
                         std::optional<Color> textColor_ = std::nullopt);
 
     void addTextSection(const std::u16string& text,
                         double scale,
-                        const FontStack& fontStack,
+                        std::shared_ptr<const FontStack> fontStack,
                         GlyphIDType type,
                         std::shared_ptr<std::vector<HBShapeAdjust>>& adjusts,
                         bool keySection = true,
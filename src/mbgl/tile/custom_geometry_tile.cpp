@@ -49,6 +49,11 @@ void CustomGeometryTile::setTileData(const GeoJSON& geoJSON) {
     setData(std::make_unique<GeoJSONTileData>(std::move(featureData)));
 }
 
+void CustomGeometryTile::setTileFeatures(
+    const std::shared_ptr<const style::CustomGeometrySource::TileFeatures>& features) {
+    setData(std::make_unique<GeoJSONTileData>(features));
+}
+
 void CustomGeometryTile::invalidateTileData() {
     stale = true;
     observer->onTileChanged(*this);
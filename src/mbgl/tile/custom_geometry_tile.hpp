@@ -25,6 +25,7 @@ public:
     ~CustomGeometryTile() override;
 
     void setTileData(const GeoJSON& geoJSON);
+    void setTileFeatures(const std::shared_ptr<const style::CustomGeometrySource::TileFeatures>& features);
     void invalidateTileData();
 
     void setNecessity(TileNecessity) final;
@@ -25,27 +25,42 @@ void GeoJSONTile::updateData(std::shared_ptr<style::GeoJSONData> data_, bool nee
     assert(data_);
     data = std::move(data_);
     if (needsRelayout) reset();
+    awaitingData = true;
     data->getTile(
         id.canonical,
         [this, self = weakFactory.makeWeakPtr(), capturedData = data.get()](TileFeatures features) {
             // If the data has changed, a new request is being processed, ignore this one
             if (auto guard = self.lock(); self && data.get() == capturedData) {
+                awaitingData = false;
                 setData(std::make_unique<GeoJSONTileData>(std::move(features)));
             }
         },
         runSynchronously);
 }
 
+void GeoJSONTile::keepData(std::shared_ptr<style::GeoJSONData> data_) {
+    assert(data_);
+    // A pending request keeps its data, the features it brings are still the right ones
+    if (!awaitingData) {
+        data = std::move(data_);
+    }
+}
+
 void GeoJSONTile::querySourceFeatures(std::vector<Feature>& result, const SourceQueryOptions& options) {
     MLN_TRACE_FUNC();
 
     // Ignore the sourceLayer, there is only one
     if (auto tileData = getData()) {
         if (auto layer = tileData->getLayer({})) {
+            const auto box = sourceQueryBox(options);
             auto featureCount = layer->featureCount();
             for (std::size_t i = 0; i < featureCount; i++) {
                 auto feature = layer->getFeature(i);
 
+                if (box && !intersects(*feature, *box)) {
+                    continue;
+                }
+
                 // Apply filter, if any
                 if (options.filter && !(*options.filter)(style::expression::EvaluationContext{
                                           static_cast<float>(this->id.overscaledZ), feature.get()})) {
@@ -20,11 +20,15 @@ public:
                 TileObserver* observer = nullptr);
 
     void updateData(std::shared_ptr<style::GeoJSONData> data, bool needsRelayout, bool runSynchronously);
+    /// Switches to data whose features for this tile are the same as in the current data, without
+    /// requesting them again.
+    void keepData(std::shared_ptr<style::GeoJSONData> data);
 
     void querySourceFeatures(std::vector<Feature>& result, const SourceQueryOptions&) override;
 
 private:
     std::shared_ptr<style::GeoJSONData> data;
+    bool awaitingData = false;
     mapbox::base::WeakPtrFactory<GeoJSONTile> weakFactory{this};
     // Do not add members here, see `WeakPtrFactory`
 };
@@ -33,6 +33,16 @@ public:
         return *geometry;
     }
 
+    std::optional<std::span<const GeometryCoordinate>> getPoints() const override {
+        if (feature.geometry.is<mapbox::geometry::point<int16_t>>()) {
+            return std::span<const GeometryCoordinate>(&feature.geometry.get<mapbox::geometry::point<int16_t>>(), 1);
+        }
+        if (feature.geometry.is<mapbox::geometry::multi_point<int16_t>>()) {
+            return std::span<const GeometryCoordinate>(feature.geometry.get<mapbox::geometry::multi_point<int16_t>>());
+        }
+        return std::nullopt;
+    }
+
     std::optional<Value> getValue(const std::string& key) const override {
         auto it = feature.properties.find(key);
         if (it != feature.properties.end()) {
@@ -75,6 +85,18 @@ public:
         return std::make_unique<GeoJSONTileLayer>(features);
     }
 
+    MemoryUsage getMemoryUsage() const override {
+        MemoryUsage usage;
+        if (features) {
+            usage.cpu = features->size() * sizeof(mapbox::feature::feature<int16_t>);
+            for (const auto& feature : *features) {
+                forEachPoint(feature.geometry, [&](const auto&) { usage.cpu += sizeof(Point<int16_t>); });
+                usage.cpu += feature.properties.size() * sizeof(mapbox::feature::property_map::value_type);
+            }
+        }
+        return usage;
+    }
+
 private:
     std::shared_ptr<const mapbox::feature::feature_collection<int16_t>> features;
 };
@@ -5,6 +5,7 @@
 #include <mbgl/style/layers/custom_layer.hpp>
 #include <mbgl/renderer/layers/render_custom_layer.hpp>
 #include <mbgl/map/transform_state.hpp>
+#include <mbgl/platform/settings.hpp>
 #include <mbgl/renderer/buckets/symbol_bucket.hpp>
 #include <mbgl/renderer/layers/render_background_layer.hpp>
 #include <mbgl/renderer/layers/render_symbol_layer.hpp>
@@ -20,8 +21,10 @@
 #include <mbgl/util/instrumentation.hpp>
 #include <mbgl/util/logging.hpp>
 #include <mbgl/util/thread_pool.hpp>
+#include <mbgl/gfx/texture2d.hpp>
 #include <mbgl/gfx/upload_pass.hpp>
 
+#include <unordered_set>
 #include <utility>
 
 namespace mbgl {
@@ -77,9 +80,11 @@ void populateImagePatches(ImagePositions& imagePositions,
 class GeometryTileRenderData final : public TileRenderData {
 public:
     GeometryTileRenderData(std::shared_ptr<GeometryTile::LayoutResult> layoutResult_,
-                           std::shared_ptr<TileAtlasTextures> atlasTextures_)
+                           std::shared_ptr<TileAtlasTextures> atlasTextures_,
+                           bool discardUploadedGeometry_)
         : TileRenderData(std::move(atlasTextures_)),
-          layoutResult(std::move(layoutResult_)) {}
+          layoutResult(std::move(layoutResult_)),
+          discardUploadedGeometry(discardUploadedGeometry_) {}
 
 private:
     // TileRenderData overrides.
@@ -91,6 +96,7 @@ private:
 
     std::shared_ptr<GeometryTile::LayoutResult> layoutResult;
     std::vector<ImagePatch> imagePatches;
+    const bool discardUploadedGeometry;
 };
 
 using namespace style;
@@ -116,6 +122,10 @@ void GeometryTileRenderData::upload(gfx::UploadPass& uploadPass) {
     auto uploadFn = [&](Bucket& bucket) {
         if (bucket.needsUpload()) {
             bucket.upload(uploadPass);
+        } else if (discardUploadedGeometry) {
+            // The drawables built from the bucket upload their buffers after the tiles, so they're
+            // discarded from the next frame on
+            bucket.discardUploadedData();
         }
     };
 
@@ -226,6 +236,7 @@ GeometryTile::~GeometryTile() {
 
     if (layoutResult) {
         threadPool.runOnRenderThread(
+            TaskPriority::Housekeeping,
             [layoutResult_{std::move(layoutResult)}, atlasTextures_{std::move(atlasTextures)}]() {});
     }
 }
@@ -234,6 +245,60 @@ void GeometryTile::cancel() {
     markObsolete();
 }
 
+void GeometryTile::setTaskPriority(TaskPriority priority) {
+    worker.setPriority(priority);
+}
+
+MemoryUsage GeometryTile::getMemoryUsage() const {
+    MemoryUsage usage;
+    if (layoutResult) {
+        // Layers with identical layout properties share a bucket
+        std::unordered_set<const Bucket*> buckets;
+        for (const auto& [id, renderData] : layoutResult->layerRenderData) {
+            if (renderData.bucket && buckets.insert(renderData.bucket.get()).second) {
+                usage += renderData.bucket->getMemoryUsage();
+            }
+        }
+        if (layoutResult->featureIndex) {
+            usage += layoutResult->featureIndex->getMemoryUsage();
+        }
+    }
+    if (atlasTextures) {
+        for (const auto* texture : {atlasTextures->glyph.get(), atlasTextures->icon.get()}) {
+            if (texture) {
+                usage.gpu += texture->getDataSize();
+            }
+        }
+    }
+    return usage;
+}
+
+void GeometryTile::reportMemoryUsage(MemoryReport::Source& source, std::map<std::string, MemoryUsage>& layers) const {
+    if (layoutResult) {
+        std::unordered_set<const Bucket*> buckets;
+        for (const auto& [id, renderData] : layoutResult->layerRenderData) {
+            if (renderData.bucket && buckets.insert(renderData.bucket.get()).second) {
+                const auto usage = renderData.bucket->getMemoryUsage();
+                source.buckets += usage;
+                layers[id] += usage;
+            }
+        }
+        if (const auto& featureIndex = layoutResult->featureIndex) {
+            source.featureIndexes += featureIndex->getIndexMemoryUsage();
+            if (const auto* data = featureIndex->getData()) {
+                source.tileData += data->getMemoryUsage();
+            }
+        }
+    }
+    if (atlasTextures) {
+        for (const auto* texture : {atlasTextures->glyph.get(), atlasTextures->icon.get()}) {
+            if (texture) {
+                source.tileData.gpu += texture->getDataSize();
+            }
+        }
+    }
+}
+
 void GeometryTile::markObsolete() {
     obsolete = true;
     mailbox->abandon();
@@ -244,7 +309,9 @@ void GeometryTile::setError(std::exception_ptr err) {
     observer->onTileError(*this, std::move(err));
 }
 
-void GeometryTile::setData(std::unique_ptr<const GeometryTileData> data_) {
+void GeometryTile::setData(std::unique_ptr<const GeometryTileData> data_,
+                           std::shared_ptr<const std::string> triangulations,
+                           bool storeTriangulations_) {
     MLN_TRACE_FUNC();
 
     if (obsolete) {
@@ -252,16 +319,20 @@ void GeometryTile::setData(std::unique_ptr<const GeometryTileData> data_) {
     }
 
     if (!pending) {
-        observer->onTileAction(id, sourceID, TileOperation::StartParse);
+        onTileAction(TileOperation::StartParse);
     }
 
     // Mark the tile as pending again if it was complete before to prevent
     // signaling a complete state despite pending parse operations.
     pending = true;
 
-    ++correlationID;
-    worker.self().invoke(
-        &GeometryTileWorker::setData, std::move(data_), imageManager->getAvailableImages(), correlationID);
+    dataCorrelationID = ++correlationID;
+    worker.self().invoke(&GeometryTileWorker::setData,
+                         std::move(data_),
+                         std::move(triangulations),
+                         storeTriangulations_,
+                         imageManager->getAvailableImages(),
+                         correlationID);
 }
 
 void GeometryTile::reset() {
@@ -286,7 +357,13 @@ void GeometryTile::reset() {
 std::unique_ptr<TileRenderData> GeometryTile::createRenderData() {
     MLN_TRACE_FUNC();
 
-    return std::make_unique<GeometryTileRenderData>(layoutResult, atlasTextures);
+    return std::make_unique<GeometryTileRenderData>(layoutResult, atlasTextures, discardUploadedGeometry);
+}
+
+bool GeometryTile::discardUploadedGeometrySetting() {
+    const auto value = platform::Settings::getInstance().get(platform::EXPERIMENTAL_DISCARD_UPLOADED_GEOMETRY);
+    const auto* enabled = value.getBool();
+    return enabled && *enabled;
 }
 
 void GeometryTile::setLayers(const std::vector<Immutable<LayerProperties>>& layers) {
@@ -296,7 +373,7 @@ void GeometryTile::setLayers(const std::vector<Immutable<LayerProperties>>& laye
     // signaling a complete state despite pending parse operations.
     if (!pending) {
         pending = true;
-        observer->onTileAction(id, sourceID, TileOperation::StartParse);
+        onTileAction(TileOperation::StartParse);
     }
 
     std::vector<Immutable<LayerProperties>> impls;
@@ -339,10 +416,14 @@ void GeometryTile::onLayout(std::shared_ptr<LayoutResult> result, const uint64_t
     renderable = true;
     if (resultCorrelationID == correlationID) {
         pending = false;
-        observer->onTileAction(id, sourceID, TileOperation::EndParse);
+        onTileAction(TileOperation::EndParse);
     }
 
     layoutResult = std::move(result);
+    featureStatesApplied = false;
+    if (layoutResult) {
+        rebuildCost = layoutResult->layoutTime;
+    }
     if (!atlasTextures) {
         atlasTextures = std::make_shared<TileAtlasTextures>();
     }
@@ -375,6 +456,13 @@ void GeometryTile::onError(std::exception_ptr err, const uint64_t resultCorrelat
     observer->onTileError(*this, std::move(err));
 }
 
+void GeometryTile::onTriangulations(std::string triangulations, const uint64_t resultDataCorrelationID) {
+    // Those of data replaced since would be stored for the new data
+    if (resultDataCorrelationID == dataCorrelationID) {
+        storeTriangulations(std::move(triangulations));
+    }
+}
+
 void GeometryTile::onGlyphsAvailable(GlyphMap glyphMap, [[maybe_unused]] HBShapeRequests requests) {
     MLN_TRACE_FUNC();
 
@@ -386,6 +474,10 @@ void GeometryTile::onGlyphsAvailable(GlyphMap glyphMap, [[maybe_unused]] HBShape
         for (auto& typesIT : fontTypes) {
             auto type = typesIT.first;
             auto& strs = typesIT.second;
+            const auto fontStackHash = FontStackHasher()(fontStack);
+            auto& glyphs = glyphMap[fontStackHash];
+            // Glyphs missing from the map are rasterized together once every string is shaped
+            GlyphIDs missingGlyphIDs;
 
             for (auto& str : strs) {
                 std::vector<GlyphID> shapedGlyphIDs;
@@ -397,22 +489,21 @@ void GeometryTile::onGlyphsAvailable(GlyphMap glyphMap, [[maybe_unused]] HBShape
                 shapedstr.reserve(shapedGlyphIDs.size());
                 for (auto& glyphID : shapedGlyphIDs) {
                     shapedstr += glyphID.complex.code;
-
-                    auto fontStackHash = FontStackHasher()(fontStack);
-                    bool needShape = true;
-                    if (glyphMap.contains(fontStackHash)) {
-                        auto& glyphs = glyphMap[fontStackHash];
-                        if (glyphs.contains(glyphID)) needShape = false;
-                    }
-                    if (needShape) {
-                        auto glyph = glyphManager->getGlyph(fontStack, glyphID);
-                        glyphMap[fontStackHash].emplace(glyph->id, glyph);
+                    if (!glyphs.contains(glyphID)) {
+                        missingGlyphIDs.insert(glyphID);
                     }
                 }
 
                 results[fontStack][type][str] = HBShapeResult{shapedstr,
                                                               shapedAdjusts}; //.emplace(str, shapedstr, shapedAdjusts);
             }
+
+            if (!missingGlyphIDs.empty()) {
+                const std::vector<GlyphID> glyphIDs(missingGlyphIDs.begin(), missingGlyphIDs.end());
+                for (auto& glyph : glyphManager->getGlyphs(fontStack, glyphIDs)) {
+                    glyphs.emplace(glyph->id, glyph);
+                }
+            }
         }
     }
 #endif // MLN_TEXT_SHAPING_HARFBUZZ
@@ -536,6 +627,7 @@ void GeometryTile::querySourceFeatures(std::vector<Feature>& result, const Sourc
         return;
     }
 
+    const auto box = sourceQueryBox(options);
     for (const auto& sourceLayer : *options.sourceLayers) {
         // Go throught all sourceLayers, if any
         // to gather all the features
@@ -546,13 +638,18 @@ void GeometryTile::querySourceFeatures(std::vector<Feature>& result, const Sourc
             for (std::size_t i = 0; i < featureCount; i++) {
                 auto feature = layer->getFeature(i);
 
+                if (box && !intersects(*feature, *box)) {
+                    continue;
+                }
+
                 // Apply filter, if any
                 if (options.filter && !(*options.filter)(style::expression::EvaluationContext{
                                           static_cast<float>(this->id.overscaledZ), feature.get()})) {
                     continue;
                 }
 
-                result.emplace_back(convertFeature(*feature, id.canonical));
+                auto& converted = result.emplace_back(convertFeature(*feature, id.canonical));
+                converted.sourceLayer = sourceLayer;
             }
         }
     }
@@ -604,6 +701,7 @@ void GeometryTile::setFeatureState(const LayerFeatureStates& states) {
             }
         }
     }
+    featureStatesApplied = true;
 }
 
 } // namespace mbgl
@@ -35,7 +35,11 @@ public:
     ~GeometryTile() override;
 
     void setError(std::exception_ptr);
-    void setData(std::unique_ptr<const GeometryTileData>);
+    /// `triangulations` are ones stored for the same data, see `gfx::TriangulationCache::load`. With
+    /// `storeTriangulations`, those of the data are passed to `storeTriangulations` once laid out.
+    void setData(std::unique_ptr<const GeometryTileData>,
+                 std::shared_ptr<const std::string> triangulations = nullptr,
+                 bool storeTriangulations = false);
     // Resets the tile's data and layers and leaves the tile in pending state,
     // waiting for the new data and layers to come.
     void reset();
@@ -66,6 +70,10 @@ public:
 
     void cancel() override;
 
+    void setTaskPriority(TaskPriority) override;
+    MemoryUsage getMemoryUsage() const override;
+    void reportMemoryUsage(MemoryReport::Source&, std::map<std::string, MemoryUsage>& layers) const override;
+
     class LayoutResult {
     public:
         mbgl::unordered_map<std::string, LayerRenderData> layerRenderData;
@@ -73,6 +81,8 @@ public:
         gfx::GlyphAtlas glyphAtlas;
         gfx::ImageAtlas imageAtlas;
         gfx::DynamicTextureAtlasPtr dynamicTextureAtlas;
+        // Worker time spent producing this result: the parse it's based on and this layout
+        Duration layoutTime = Duration::zero();
 
         LayerRenderData* getLayerRenderData(const style::Layer::Impl&);
 
@@ -92,6 +102,7 @@ public:
     void onLayout(std::shared_ptr<LayoutResult>, uint64_t correlationID);
 
     void onError(std::exception_ptr, uint64_t correlationID);
+    void onTriangulations(std::string, uint64_t dataCorrelationID);
 
     bool holdForFade() const override;
     void markRenderedIdeal() override;
@@ -100,8 +111,12 @@ public:
     std::shared_ptr<FeatureIndex> getFeatureIndex() const;
 
     void setFeatureState(const LayerFeatureStates&) override;
+    bool needsAllFeatureStates() const override { return !featureStatesApplied; }
 
 protected:
+    /// Stores the serialized triangulations of the data last set, when asked to with it
+    virtual void storeTriangulations(std::string) {}
+
     const GeometryTileData* getData() const;
     LayerRenderData* getLayerRenderData(const style::Layer::Impl&);
 
@@ -121,14 +136,22 @@ private:
     const std::shared_ptr<ImageManager> imageManager;
 
     uint64_t correlationID = 0;
+    // The correlation ID of the last data set
+    uint64_t dataCorrelationID = 0;
 
     std::shared_ptr<LayoutResult> layoutResult;
+    // Whether the buckets of `layoutResult` have been given the source's feature states
+    bool featureStatesApplied = false;
     std::shared_ptr<TileAtlasTextures> atlasTextures;
 
     const MapMode mode;
 
     bool showCollisionBoxes;
 
+    // See `EXPERIMENTAL_DISCARD_UPLOADED_GEOMETRY`
+    const bool discardUploadedGeometry = discardUploadedGeometrySetting();
+    static bool discardUploadedGeometrySetting();
+
     enum class FadeState {
         Loaded,
         NeedsFirstPlacement,
@@ -112,7 +112,41 @@ std::vector<GeometryCollection> classifyRings(const GeometryCollection& rings) {
     return polygons;
 }
 
-void limitHoles(GeometryCollection& polygon, uint32_t maxHoles) {
+util::ArenaVector<PolygonRingRefs> classifyRingRefs(const GeometryCollection& rings) {
+    MLN_TRACE_FUNC();
+
+    util::ArenaVector<PolygonRingRefs> polygons;
+
+    if (rings.size() <= 1) {
+        auto& polygon = polygons.emplace_back();
+        polygon.insert(polygon.end(), rings.begin(), rings.end());
+        return polygons;
+    }
+
+    int8_t ccw = 0;
+
+    for (const auto& ring : rings) {
+        double area = signedArea(ring);
+        if (area == 0) continue;
+
+        if (ccw == 0) {
+            ccw = (area < 0 ? -1 : 1);
+        }
+
+        if (polygons.empty() || ccw == (area < 0 ? -1 : 1)) {
+            polygons.emplace_back();
+        }
+
+        polygons.back().emplace_back(ring);
+    }
+
+    return polygons;
+}
+
+namespace {
+
+template <class Polygon>
+void limitHolesByArea(Polygon& polygon, uint32_t maxHoles) {
     MLN_TRACE_FUNC();
 
     if (polygon.size() > 1 + maxHoles) {
@@ -120,10 +154,20 @@ void limitHoles(GeometryCollection& polygon, uint32_t maxHoles) {
             polygon.begin() + 1, polygon.begin() + 1 + maxHoles, polygon.end(), [](const auto& a, const auto& b) {
                 return std::fabs(signedArea(a)) > std::fabs(signedArea(b));
             });
-        polygon.resize(1 + maxHoles);
+        polygon.erase(polygon.begin() + 1 + maxHoles, polygon.end());
     }
 }
 
+} // namespace
+
+void limitHoles(GeometryCollection& polygon, uint32_t maxHoles) {
+    limitHolesByArea(polygon, maxHoles);
+}
+
+void limitHoles(PolygonRingRefs& polygon, uint32_t maxHoles) {
+    limitHolesByArea(polygon, maxHoles);
+}
+
 Feature::geometry_type convertGeometry(const GeometryTileFeature& geometryTileFeature, const CanonicalTileID& tileID) {
     MLN_TRACE_FUNC();
 
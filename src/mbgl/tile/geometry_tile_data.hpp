@@ -2,9 +2,12 @@
 
 #include <mbgl/util/geometry.hpp>
 #include <mbgl/util/feature.hpp>
+#include <mbgl/util/memory_usage.hpp>
+#include <mbgl/util/arena.hpp>
 
 #include <cstdint>
 #include <memory>
+#include <optional>
 #include <span>
 #include <string>
 #include <vector>
@@ -68,6 +71,10 @@ public:
     virtual const PropertyMap& getProperties() const;
     virtual FeatureIdentifier getID() const { return NullValue{}; }
     virtual const GeometryCollection& getGeometries() const;
+
+    // For point features that keep all their points in one array: those points, read in place, as the single
+    // ring `getGeometries()` would return. Lets point buckets skip building the collection. Others return nothing.
+    virtual std::optional<std::span<const GeometryCoordinate>> getPoints() const { return std::nullopt; }
 };
 
 class GeometryTileLayer {
@@ -80,6 +87,12 @@ public:
     virtual std::unique_ptr<GeometryTileFeature> getFeature(std::size_t) const = 0;
 
     virtual std::string getName() const = 0;
+
+    // For layers storing their properties by column: what `getFeature(i)->getValue(key)` returns
+    // for each feature, read without creating the features. Other layers return nothing.
+    virtual std::optional<std::vector<std::optional<Value>>> getPropertyColumn(const std::string&) const {
+        return std::nullopt;
+    }
 };
 
 class GeometryTileData {
@@ -90,6 +103,9 @@ public:
     // Returns the layer with the given name. The returned layer object *may*
     // outlive the data object.
     virtual std::unique_ptr<GeometryTileLayer> getLayer(const std::string&) const = 0;
+
+    // Approximate memory retained by this object. Shared data is counted in full by each holder.
+    virtual MemoryUsage getMemoryUsage() const { return {}; }
 };
 
 // classifies an array of rings into polygons with outer rings and holes
@@ -98,6 +114,35 @@ std::vector<GeometryCollection> classifyRings(const GeometryCollection&);
 // Truncate polygon to the largest `maxHoles` inner rings by area.
 void limitHoles(GeometryCollection&, uint32_t maxHoles);
 
+// A ring of a collection, viewed rather than copied. Indexable like the ring itself, which is
+// what earcut and the bucket builders need.
+class GeometryRingRef {
+public:
+    using value_type = GeometryCoordinate;
+
+    GeometryRingRef(const GeometryCoordinates& ring_) noexcept
+        : ring(&ring_) {}
+
+    operator const GeometryCoordinates&() const noexcept { return *ring; }
+
+    std::size_t size() const noexcept { return ring->size(); }
+    bool empty() const noexcept { return ring->empty(); }
+    const GeometryCoordinate& operator[](std::size_t i) const noexcept { return (*ring)[i]; }
+    auto begin() const noexcept { return ring->begin(); }
+    auto end() const noexcept { return ring->end(); }
+
+private:
+    const GeometryCoordinates* ring;
+};
+
+using PolygonRingRefs = util::ArenaVector<GeometryRingRef>;
+
+// Same as `classifyRings`, referring to the rings of a collection that must outlive the result.
+// The polygons are allocated from the current arena, if any.
+util::ArenaVector<PolygonRingRefs> classifyRingRefs(const GeometryCollection&);
+
+void limitHoles(PolygonRingRefs&, uint32_t maxHoles);
+
 Feature::geometry_type convertGeometry(const GeometryTileFeature& geometryTileFeature, const CanonicalTileID& tileID);
 
 GeometryCollection convertGeometry(const Feature::geometry_type& geometryTileFeature, const CanonicalTileID& tileID);
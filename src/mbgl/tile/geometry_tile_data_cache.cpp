@@ -0,0 +1,64 @@
+#include <mbgl/tile/geometry_tile_data_cache.hpp>
+
+#include <mbgl/util/instrumentation.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <string_view>
+
+namespace mbgl {
+
+GeometryTileDataCache& GeometryTileDataCache::getInstance() {
+    static GeometryTileDataCache instance;
+    return instance;
+}
+
+std::unique_ptr<GeometryTileData> GeometryTileDataCache::get(const std::string& sourceKey,
+                                                              const CanonicalTileID& tileID,
+                                                              const std::shared_ptr<const std::string>& bytes,
+                                                              const Factory& factory) {
+    MLN_TRACE_FUNC();
+
+    assert(bytes);
+    const auto bytesHash = std::hash<std::string_view>{}(*bytes);
+
+    std::scoped_lock lock{mutex};
+
+    auto& entry = entries[std::make_pair(sourceKey, tileID)];
+    if (entry.bytesHash == bytesHash) {
+        const auto entryBytes = entry.bytes.lock();
+        auto data = entry.data.lock();
+        if (entryBytes && data && (entryBytes == bytes || *entryBytes == *bytes)) {
+            return std::make_unique<SharedGeometryTileData>(std::move(data));
+        }
+    }
+
+    // Construction is cheap, parsing is deferred until a worker reads the data
+    std::shared_ptr<const GeometryTileData> data = factory(bytes);
+    entry = Entry{.bytesHash = bytesHash, .bytes = bytes, .data = data};
+
+    if (entries.size() >= sweepThreshold) {
+        removeExpired();
+        sweepThreshold = std::max(minSweepThreshold, entries.size() * 2);
+    }
+
+    return std::make_unique<SharedGeometryTileData>(std::move(data));
+}
+
+std::size_t GeometryTileDataCache::size() const {
+    std::scoped_lock lock{mutex};
+    return static_cast<std::size_t>(
+        std::ranges::count_if(entries, [](const auto& item) { return !item.second.data.expired(); }));
+}
+
+void GeometryTileDataCache::clear() {
+    std::scoped_lock lock{mutex};
+    entries.clear();
+    sweepThreshold = minSweepThreshold;
+}
+
+void GeometryTileDataCache::removeExpired() {
+    std::erase_if(entries, [](const auto& item) { return item.second.data.expired(); });
+}
+
+} // namespace mbgl
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <mbgl/tile/geometry_tile_data.hpp>
+#include <mbgl/tile/tile_id.hpp>
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace mbgl {
+
+/// A process-wide cache of immutable tile data shared by the tiles of all `Map` instances.
+///
+/// Maps rendering the same source load the same bytes and would otherwise each hold and
+/// parse their own copy, as do the overscaled tiles of a map past the source's maximum zoom,
+/// which all load their parent's tile. Entries are weak, so data lives only as long as some
+/// tile uses it. Used by overscaled tiles, and by all tiles with the
+/// `EXPERIMENTAL_SHARED_TILE_DATA` platform setting.
+class GeometryTileDataCache {
+public:
+    using Factory = std::function<std::unique_ptr<const GeometryTileData>(std::shared_ptr<const std::string>)>;
+
+    static GeometryTileDataCache& getInstance();
+
+    /// Get a reference to the shared data for the given tile of a source, identified by its URL templates.
+    /// If the cache has no live entry for the tile, or the entry was made from different bytes, a new one
+    /// is created with `factory`. Overscaled and wrapped tiles share the data of their canonical tile.
+    std::unique_ptr<GeometryTileData> get(const std::string& sourceKey,
+                                          const CanonicalTileID&,
+                                          const std::shared_ptr<const std::string>& bytes,
+                                          const Factory& factory);
+
+    /// Number of entries still referenced by a tile
+    std::size_t size() const;
+
+    void clear();
+
+private:
+    struct Entry {
+        std::size_t bytesHash = 0;
+        /// The bytes the data was made from, compared on a hash match. Weak, as the data keeps them alive.
+        std::weak_ptr<const std::string> bytes;
+        std::weak_ptr<const GeometryTileData> data;
+    };
+
+    void removeExpired();
+
+    mutable std::mutex mutex;
+    std::map<std::pair<std::string, CanonicalTileID>, Entry> entries;
+    std::size_t sweepThreshold = minSweepThreshold;
+
+    static constexpr std::size_t minSweepThreshold = 256;
+};
+
+/// A reference to tile data owned by `GeometryTileDataCache`, clones refer to the same data
+class SharedGeometryTileData final : public GeometryTileData {
+public:
+    SharedGeometryTileData(std::shared_ptr<const GeometryTileData> data_)
+        : data(std::move(data_)) {}
+
+    std::unique_ptr<GeometryTileData> clone() const override {
+        return std::make_unique<SharedGeometryTileData>(data);
+    }
+    std::unique_ptr<GeometryTileLayer> getLayer(const std::string& name) const override {
+        return data->getLayer(name);
+    }
+    MemoryUsage getMemoryUsage() const override { return data->getMemoryUsage(); }
+
+    const std::shared_ptr<const GeometryTileData>& getShared() const { return data; }
+
+private:
+    std::shared_ptr<const GeometryTileData> data;
+};
+
+} // namespace mbgl
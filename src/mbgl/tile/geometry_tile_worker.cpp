@@ -5,8 +5,10 @@
 #include <mbgl/layout/layout.hpp>
 #include <mbgl/layout/symbol_layout.hpp>
 #include <mbgl/layout/pattern_layout.hpp>
+#include <mbgl/platform/settings.hpp>
 #include <mbgl/renderer/bucket_parameters.hpp>
 #include <mbgl/renderer/group_by_layout.hpp>
+#include <mbgl/style/batch_filter.hpp>
 #include <mbgl/style/filter.hpp>
 #include <mbgl/style/layers/symbol_layer_impl.hpp>
 #include <mbgl/renderer/layers/render_fill_layer.hpp>
@@ -14,14 +16,19 @@
 #include <mbgl/renderer/layers/render_line_layer.hpp>
 #include <mbgl/renderer/layers/render_symbol_layer.hpp>
 #include <mbgl/renderer/buckets/symbol_bucket.hpp>
+#include <mbgl/util/arena.hpp>
 #include <mbgl/util/instrumentation.hpp>
 #include <mbgl/util/logging.hpp>
+#include <mbgl/util/parallel_for.hpp>
 #include <mbgl/util/constants.hpp>
 #include <mbgl/util/string.hpp>
 #include <mbgl/util/exception.hpp>
 #include <mbgl/util/stopwatch.hpp>
 #include <mbgl/util/thread_pool.hpp>
 
+#include <algorithm>
+#include <mutex>
+#include <string_view>
 #include <unordered_set>
 #include <utility>
 
@@ -29,6 +36,144 @@ namespace mbgl {
 
 using namespace style;
 
+namespace {
+std::atomic<uint64_t> completedLayouts{0};
+std::atomic<uint64_t> cancelledLayouts{0};
+std::atomic<uint64_t> createdWorkers{0};
+std::atomic<uint64_t> reusedArenas{0};
+std::atomic<uint64_t> createdArenas{0};
+
+// Tiles come and go by the hundred while panning, each with a worker of its own. The arenas of the
+// layout passes outlive them here instead, so that a pass starts out with the warm memory of an
+// earlier one rather than growing a new arena through the heap. A few are enough to serve every
+// thread of the pool.
+constexpr std::size_t maxPooledArenas = 8;
+
+std::mutex arenaPoolMutex;
+std::vector<std::unique_ptr<util::Arena>> arenaPool;
+
+// The arena of a layout pass, taken from the pool and returned to it once the pass is done
+class PooledArena {
+public:
+    PooledArena() {
+        {
+            std::lock_guard<std::mutex> lock(arenaPoolMutex);
+            if (!arenaPool.empty()) {
+                arena = std::move(arenaPool.back());
+                arenaPool.pop_back();
+            }
+        }
+        if (arena) {
+            reusedArenas++;
+        } else {
+            arena = std::make_unique<util::Arena>();
+            createdArenas++;
+        }
+    }
+
+    PooledArena(const PooledArena&) = delete;
+    PooledArena& operator=(const PooledArena&) = delete;
+
+    ~PooledArena() {
+        arena->reset();
+        std::lock_guard<std::mutex> lock(arenaPoolMutex);
+        if (arenaPool.size() < maxPooledArenas) {
+            arenaPool.push_back(std::move(arena));
+        }
+    }
+
+    util::Arena& operator*() const { return *arena; }
+
+private:
+    std::unique_ptr<util::Arena> arena;
+};
+
+// A group of layers sharing a bucket, set up in order on the worker before the buckets are built
+struct LayoutGroup {
+    const std::string& key;
+    const std::vector<Immutable<style::LayerProperties>>& layers;
+    BucketParameters parameters;
+    std::unique_ptr<GeometryTileLayer> geometryLayer;
+    // Symbol layers and layers that support pattern properties
+    std::unique_ptr<Layout> layout;
+
+    // The bucket, and the rings of its features to be inserted into the feature index once every bucket is built.
+    // Left empty for the layouts that make their bucket in `createBucket`, when their images or glyphs are known.
+    std::shared_ptr<Bucket> bucket;
+    std::shared_ptr<const FeatureIndexBatch> featureIndexBatch;
+    bool hasData = false;
+    // Whether the bucket is the one of the previous parse
+    bool reused = false;
+};
+
+// Only touches the group itself, so that the buckets of several groups can be built at once
+void buildBucket(LayoutGroup& group) {
+    if (group.reused) {
+        return;
+    }
+    if (group.layout) {
+        if (!group.layout->hasDependencies()) {
+            auto featureIndexBatch = std::make_shared<FeatureIndexBatch>();
+            group.bucket = group.layout->buildBucket({}, *featureIndexBatch, group.parameters.tileID.canonical);
+            if (group.bucket) {
+                group.featureIndexBatch = std::move(featureIndexBatch);
+                group.hasData = group.bucket->hasData();
+            }
+        }
+        return;
+    }
+
+    const style::Layer::Impl& leaderImpl = *(group.layers.at(0)->baseImpl);
+    const Filter& filter = leaderImpl.filter;
+    const OverscaledTileID& id = group.parameters.tileID;
+    const GeometryTileLayer& geometryLayer = *group.geometryLayer;
+    group.bucket = LayerManager::get()->createBucket(group.parameters, group.layers);
+    auto featureIndexBatch = std::make_shared<FeatureIndexBatch>();
+
+    // With property columns, filter every feature at once and skip creating the rejected ones
+    std::optional<std::vector<bool>> selected;
+    if (const auto* batchFilter = style::BatchFilter::get(filter)) {
+        selected = batchFilter->evaluate(geometryLayer, static_cast<float>(id.overscaledZ), id.canonical);
+    }
+
+    for (std::size_t i = 0; !group.parameters.isCancelled() && i < geometryLayer.featureCount(); i++) {
+        if (selected && !(*selected)[i]) continue;
+
+        std::unique_ptr<GeometryTileFeature> feature = geometryLayer.getFeature(i);
+
+        if (!selected && !filter(expression::EvaluationContext(static_cast<float>(id.overscaledZ), feature.get())
+                                     .withCanonicalTileID(&id.canonical)))
+            continue;
+
+        if (const auto points = feature->getPoints()) {
+            group.bucket->addPointFeature(*feature, *points, i, id.canonical);
+            featureIndexBatch->add(*points, i);
+            continue;
+        }
+
+        const GeometryCollection& geometries = feature->getGeometries();
+        group.bucket->addFeature(*feature, geometries, {}, PatternLayerMap(), i, id.canonical);
+        featureIndexBatch->add(geometries, i);
+    }
+    group.bucket->compactPaintAttributes();
+    group.featureIndexBatch = std::move(featureIndexBatch);
+    group.hasData = group.bucket->hasData();
+}
+
+} // namespace
+
+bool GeometryTileWorker::BuiltBucket::sameLayers(const std::vector<Immutable<LayerProperties>>& group) const {
+    return std::ranges::equal(layers, group, {}, {}, [](const auto& layer) { return layer->baseImpl; });
+}
+
+GeometryTileWorker::LayoutStats GeometryTileWorker::getLayoutStats() {
+    return {.completed = completedLayouts, .cancelled = cancelledLayouts};
+}
+
+GeometryTileWorker::ScratchStats GeometryTileWorker::getScratchStats() {
+    return {.workersCreated = createdWorkers, .arenasReused = reusedArenas, .arenasCreated = createdArenas};
+}
+
 GeometryTileWorker::GeometryTileWorker(OptionalActorRef<GeometryTileWorker> self_,
                                        OptionalActorRef<GeometryTile> parent_,
                                        const TaggedScheduler& scheduler_,
@@ -50,12 +195,14 @@ GeometryTileWorker::GeometryTileWorker(OptionalActorRef<GeometryTileWorker> self
       pixelRatio(pixelRatio_),
       showCollisionBoxes(showCollisionBoxes_),
       dynamicTextureAtlas(dynamicTextureAtlas_),
-      fontFaces(fontFaces_) {}
+      fontFaces(fontFaces_) {
+    createdWorkers++;
+}
 
 GeometryTileWorker::~GeometryTileWorker() {
     MLN_TRACE_FUNC();
 
-    scheduler.runOnRenderThread([renderData_{std::move(renderData)}]() {});
+    scheduler.runOnRenderThread(TaskPriority::Housekeeping, [renderData_{std::move(renderData)}]() {});
 }
 
 /*
@@ -130,13 +277,21 @@ GeometryTileWorker::~GeometryTileWorker() {
 */
 
 void GeometryTileWorker::setData(std::unique_ptr<const GeometryTileData> data_,
+                                 std::shared_ptr<const std::string> storedTriangulations,
+                                 bool storeTriangulations_,
                                  std::set<std::string> availableImages_,
                                  uint64_t correlationID_) {
     MLN_TRACE_FUNC();
 
     try {
         data = std::move(data_);
+        triangulations.clear();
+        // Triangulations that can't be read are made again, and stored in their place
+        storeTriangulations = storeTriangulations_ ||
+                              (storedTriangulations && !triangulations.load(*storedTriangulations));
+        builtBuckets.clear();
         correlationID = correlationID_;
+        dataCorrelationID = correlationID_;
         availableImages = std::move(availableImages_);
 
         switch (state) {
@@ -164,6 +319,10 @@ void GeometryTileWorker::setLayers(std::vector<Immutable<LayerProperties>> layer
     try {
         layers = std::move(layers_);
         correlationID = correlationID_;
+        if (availableImages_ != availableImages) {
+            // Filters and layout properties may depend on the images available
+            builtBuckets.clear();
+        }
         availableImages = std::move(availableImages_);
 
         switch (state) {
@@ -188,6 +347,9 @@ void GeometryTileWorker::setLayers(std::vector<Immutable<LayerProperties>> layer
 void GeometryTileWorker::reset(uint64_t correlationID_) {
     layers = std::nullopt;
     data = std::nullopt;
+    triangulations.clear();
+    storeTriangulations = false;
+    builtBuckets.clear();
     correlationID = correlationID_;
 
     switch (state) {
@@ -414,6 +576,11 @@ void GeometryTileWorker::parse() {
     }
 
     MBGL_TIMING_START(watch)
+    const auto start = Clock::now();
+
+    // Temporary geometry built during the pass comes from here instead of the global heap
+    PooledArena arena;
+    util::Arena::Scope arenaScope(*arena);
 
     std::unordered_map<std::string, std::unique_ptr<SymbolLayout>> symbolLayoutMap;
 
@@ -422,11 +589,6 @@ void GeometryTileWorker::parse() {
 
     featureIndex = std::make_unique<FeatureIndex>(*data ? (*data)->clone() : nullptr);
 
-    // Avoid small reallocations for populated cells.
-    // If we had a total feature count, this could be based on that and the cell count.
-    constexpr auto estimatedElementsPerCell = 8;
-    featureIndex->reserve(estimatedElementsPerCell);
-
     GlyphDependencies glyphDependencies;
     ImageDependencies imageDependencies;
 
@@ -438,9 +600,24 @@ void GeometryTileWorker::parse() {
         groupMap[layoutKey(*layer->baseImpl)].push_back(std::move(layer));
     }
 
+    // Buckets of the previous parse whose group comes back unchanged are reused, so that a change to the filter of
+    // a layer only rebuilds its own bucket
+    auto previousBuckets = std::move(builtBuckets);
+    builtBuckets.clear();
+    bool keepBuckets = true;
+    const auto discardValue = platform::Settings::getInstance().get(platform::EXPERIMENTAL_DISCARD_UPLOADED_GEOMETRY);
+    if (const auto* discard = discardValue.getBool()) {
+        // The drawables of a bucket may have to be built again, from geometry that's discarded once uploaded
+        keepBuckets = !*discard;
+    }
+
+    std::vector<LayoutGroup> groups;
+    groups.reserve(groupMap.size());
+
     for (auto& pair : groupMap) {
         const auto& group = pair.second;
         if (obsolete) {
+            cancelledLayouts++;
             return;
         }
 
@@ -449,8 +626,11 @@ void GeometryTileWorker::parse() {
         }
 
         const style::Layer::Impl& leaderImpl = *(group.at(0)->baseImpl);
-        BucketParameters parameters{
-            .tileID = id, .mode = mode, .pixelRatio = pixelRatio, .layerType = leaderImpl.getTypeInfo()};
+        BucketParameters parameters{.tileID = id,
+                                    .mode = mode,
+                                    .pixelRatio = pixelRatio,
+                                    .layerType = leaderImpl.getTypeInfo(),
+                                    .cancelled = &obsolete};
 
         auto geometryLayer = (*data)->getLayer(leaderImpl.sourceLayer);
         if (!geometryLayer) {
@@ -465,6 +645,18 @@ void GeometryTileWorker::parse() {
 
         featureIndex->setBucketLayerIDs(leaderImpl.id, layerIDs);
 
+        auto& layoutGroup = groups.emplace_back(LayoutGroup{
+            .key = pair.first, .layers = group, .parameters = parameters, .geometryLayer = std::move(geometryLayer)});
+
+        if (const auto previous = previousBuckets.find(pair.first);
+            previous != previousBuckets.end() && previous->second.sameLayers(group)) {
+            layoutGroup.bucket = previous->second.bucket;
+            layoutGroup.featureIndexBatch = previous->second.featureIndexBatch;
+            layoutGroup.hasData = previous->second.hasData;
+            layoutGroup.reused = true;
+            continue;
+        }
+
         // Symbol layers and layers that support pattern properties have an
         // extra step at layout time to figure out what images/glyphs are needed
         // to render the layer. They use the intermediate Layout data structure
@@ -472,42 +664,82 @@ void GeometryTileWorker::parse() {
         // images/glyphs are used, or the Layout is stored until the
         // images/glyphs are available to add the features to the buckets.
         if (leaderImpl.getTypeInfo()->layout == LayerTypeInfo::Layout::Required) {
-            std::unique_ptr<Layout> layout = LayerManager::get()->createLayout({.bucketParameters = parameters,
-                                                                                .fontFaces = fontFaces,
-                                                                                .glyphDependencies = glyphDependencies,
-                                                                                .imageDependencies = imageDependencies,
-                                                                                .availableImages = availableImages},
-                                                                               std::move(geometryLayer),
-                                                                               group);
-            if (layout->hasDependencies()) {
-                layouts.push_back(std::move(layout));
-            } else {
-                layout->createBucket({}, featureIndex, renderData, firstLoad, showCollisionBoxes, id.canonical);
-            }
-        } else {
-            const Filter& filter = leaderImpl.filter;
-            const std::string& sourceLayerID = leaderImpl.sourceLayer;
-            std::shared_ptr<Bucket> bucket = LayerManager::get()->createBucket(parameters, group);
+            layoutGroup.layout = LayerManager::get()->createLayout({.bucketParameters = parameters,
+                                                                    .fontFaces = fontFaces,
+                                                                    .glyphDependencies = glyphDependencies,
+                                                                    .imageDependencies = imageDependencies,
+                                                                    .availableImages = availableImages,
+                                                                    .triangulations = &triangulations},
+                                                                   std::move(layoutGroup.geometryLayer),
+                                                                   group);
+        }
+    }
 
-            for (std::size_t i = 0; !obsolete && i < geometryLayer->featureCount(); i++) {
-                std::unique_ptr<GeometryTileFeature> feature = geometryLayer->getFeature(i);
+    bool parallel = false;
+    const auto parallelValue = platform::Settings::getInstance().get(platform::EXPERIMENTAL_PARALLEL_BUCKETS);
+    if (const auto* enabled = parallelValue.getBool()) {
+        parallel = *enabled;
+    }
 
-                if (!filter(expression::EvaluationContext(static_cast<float>(this->id.overscaledZ), feature.get())
-                                .withCanonicalTileID(&id.canonical)))
-                    continue;
+    if (parallel && groups.size() > 1) {
+        // The groups of a source layer share its triangulations, so they're built one after the other by the same
+        // task, in order
+        std::vector<std::vector<LayoutGroup*>> sourceLayerGroups;
+        mbgl::unordered_map<std::string_view, std::size_t> sourceLayerIndices;
+        for (auto& group : groups) {
+            const auto& sourceLayer = group.layers.at(0)->baseImpl->sourceLayer;
+            const auto index = sourceLayerIndices.try_emplace(sourceLayer, sourceLayerGroups.size()).first->second;
+            if (index == sourceLayerGroups.size()) {
+                sourceLayerGroups.emplace_back();
+            }
+            sourceLayerGroups[index].push_back(&group);
+        }
 
-                const GeometryCollection& geometries = feature->getGeometries();
-                bucket->addFeature(*feature, geometries, {}, PatternLayerMap(), i, id.canonical);
-                featureIndex->insert(geometries, i, sourceLayerID, leaderImpl.id);
+        util::parallelFor(sourceLayerGroups.size(), [&](std::size_t i) {
+            for (auto* group : sourceLayerGroups[i]) {
+                buildBucket(*group);
             }
+        });
+    } else {
+        for (auto& group : groups) {
+            buildBucket(group);
+        }
+    }
 
-            if (!bucket->hasData()) {
-                continue;
+    if (obsolete) {
+        // Don't request dependencies for a tile that will be thrown away
+        cancelledLayouts++;
+        return;
+    }
+
+    // In the order of the groups, so that the feature index comes out the same however the buckets were built
+    for (auto& group : groups) {
+        const style::Layer::Impl& leaderImpl = *(group.layers.at(0)->baseImpl);
+        if (!group.bucket) {
+            if (group.layout->hasDependencies()) {
+                layouts.push_back(std::move(group.layout));
+            } else {
+                group.layout->createBucket({}, featureIndex, renderData, firstLoad, showCollisionBoxes, id.canonical);
             }
+            continue;
+        }
 
-            for (const auto& layer : group) {
-                renderData.emplace(layer->baseImpl->id, LayerRenderData{.bucket = bucket, .layerProperties = layer});
+        featureIndex->insert(*group.featureIndexBatch, leaderImpl.sourceLayer, leaderImpl.id);
+        if (keepBuckets) {
+            BuiltBucket built{
+                .bucket = group.bucket, .featureIndexBatch = group.featureIndexBatch, .hasData = group.hasData};
+            built.layers.reserve(group.layers.size());
+            for (const auto& layer : group.layers) {
+                built.layers.push_back(layer->baseImpl);
             }
+            builtBuckets.emplace(group.key, std::move(built));
+        }
+        if (!group.hasData) {
+            continue;
+        }
+
+        for (const auto& layer : group.layers) {
+            renderData.emplace(layer->baseImpl->id, LayerRenderData{.bucket = group.bucket, .layerProperties = layer});
         }
     }
 
@@ -519,6 +751,7 @@ void GeometryTileWorker::parse() {
                                    << " SourceID: " << sourceID.c_str()
                                    << " Canonical: " << static_cast<int>(id.canonical.z) << "/" << id.canonical.x << "/"
                                    << id.canonical.y << " Time");
+    parseTime = Clock::now() - start;
     finalizeLayout();
 }
 
@@ -543,6 +776,9 @@ void GeometryTileWorker::finalizeLayout() {
     }
 
     MBGL_TIMING_START(watch);
+    const auto start = Clock::now();
+    PooledArena arena;
+    util::Arena::Scope arenaScope(*arena);
     gfx::ImageAtlas imageAtlas;
     gfx::GlyphAtlas glyphAtlas;
     if (dynamicTextureAtlas) {
@@ -553,15 +789,28 @@ void GeometryTileWorker::finalizeLayout() {
             glyphAtlas = dynamicTextureAtlas->uploadGlyphs(glyphMap);
         }
 
-        for (auto& layout : layouts) {
-            if (obsolete) {
+        const auto abandon = [&] {
+            if (dynamicTextureAtlas) {
                 dynamicTextureAtlas->removeTextures(glyphAtlas.textureHandles, glyphAtlas.dynamicTexture);
                 dynamicTextureAtlas->removeTextures(imageAtlas.textureHandles, imageAtlas.dynamicTexture);
+            }
+            cancelledLayouts++;
+        };
+
+        for (auto& layout : layouts) {
+            if (obsolete) {
+                abandon();
                 return;
             }
 
             layout->prepareSymbols(glyphMap, glyphAtlas.glyphPositions, iconMap, imageAtlas.iconPositions);
 
+            // Symbol preparation checks for cancellation as it goes and may have stopped early
+            if (obsolete) {
+                abandon();
+                return;
+            }
+
             if (!layout->hasSymbolInstances()) {
                 continue;
             }
@@ -570,6 +819,11 @@ void GeometryTileWorker::finalizeLayout() {
             layout->createBucket(
                 imageAtlas.patternPositions, featureIndex, renderData, firstLoad, showCollisionBoxes, id.canonical);
         }
+
+        if (obsolete) {
+            abandon();
+            return;
+        }
     }
 
     layouts.clear();
@@ -582,13 +836,25 @@ void GeometryTileWorker::finalizeLayout() {
                                    << " Canonical: " << static_cast<int>(id.canonical.z) << "/" << id.canonical.x << "/"
                                    << id.canonical.y << " Time");
 
-    parent.invoke(&GeometryTile::onLayout,
-                  std::make_shared<GeometryTile::LayoutResult>(std::move(renderData),
+    completedLayouts++;
+
+    featureIndex->pack();
+
+    auto result = std::make_shared<GeometryTile::LayoutResult>(std::move(renderData),
                                                                std::move(featureIndex),
                                                                std::move(glyphAtlas),
                                                                std::move(imageAtlas),
-                                                               dynamicTextureAtlas),
-                  correlationID);
+                                                               dynamicTextureAtlas);
+    // Symbols may be laid out again without parsing, each result counts the last parse once
+    result->layoutTime = parseTime + (Clock::now() - start);
+
+    parent.invoke(&GeometryTile::onLayout, std::move(result), correlationID);
+
+    // Once, for the layers of the first layout, as the data needs no more than that
+    if (storeTriangulations && !triangulations.empty()) {
+        storeTriangulations = false;
+        parent.invoke(&GeometryTile::onTriangulations, triangulations.serialize(), dataCorrelationID);
+    }
 }
 
 } // namespace mbgl
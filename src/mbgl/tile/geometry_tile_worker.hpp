@@ -9,6 +9,7 @@
 #include <mbgl/util/immutable.hpp>
 #include <mbgl/style/layer_properties.hpp>
 #include <mbgl/geometry/feature_index.hpp>
+#include <mbgl/gfx/triangulation_cache.hpp>
 #include <mbgl/renderer/bucket.hpp>
 #include <mbgl/renderer/render_layer.hpp>
 #include <mbgl/tile/tile.hpp>
@@ -51,6 +52,8 @@ public:
                    std::set<std::string> availableImages,
                    uint64_t correlationID);
     void setData(std::unique_ptr<const GeometryTileData>,
+                 std::shared_ptr<const std::string> storedTriangulations,
+                 bool storeTriangulations,
                  std::set<std::string> availableImages,
                  uint64_t correlationID);
     void reset(uint64_t correlationID_);
@@ -63,6 +66,22 @@ public:
                            ImageVersionMap versionMap,
                            uint64_t imageCorrelationID);
 
+    /// Layouts sent to the tile vs. abandoned because the tile became obsolete, across all workers
+    struct LayoutStats {
+        uint64_t completed;
+        uint64_t cancelled;
+    };
+    static LayoutStats getLayoutStats();
+
+    /// Workers created, and the layout passes that reused the scratch memory of an earlier pass
+    /// vs. those that had to allocate it, across all workers
+    struct ScratchStats {
+        uint64_t workersCreated;
+        uint64_t arenasReused;
+        uint64_t arenasCreated;
+    };
+    static ScratchStats getScratchStats();
+
 private:
     void coalesced();
     void parse();
@@ -91,6 +110,8 @@ private:
 
     std::unique_ptr<FeatureIndex> featureIndex;
     mbgl::unordered_map<std::string, LayerRenderData> renderData;
+    // Time spent on the last parse, excluding waits for dependencies
+    Duration parseTime = Duration::zero();
 
     enum State {
         Idle,
@@ -106,6 +127,24 @@ private:
     // Outer std::optional indicates whether we've received it or not.
     std::optional<std::vector<Immutable<style::LayerProperties>>> layers;
     std::optional<std::unique_ptr<const GeometryTileData>> data;
+    // Triangulations of `data`, reused while only the layers change
+    gfx::TriangulationCache triangulations;
+    // Whether to send the triangulations to the tile once laid out, and the correlation ID of the data
+    bool storeTriangulations = false;
+    uint64_t dataCorrelationID = 0;
+
+    // A bucket built by the last parse without waiting on images, with what it was built from
+    struct BuiltBucket {
+        std::vector<Immutable<style::Layer::Impl>> layers;
+        std::shared_ptr<Bucket> bucket;
+        std::shared_ptr<const FeatureIndexBatch> featureIndexBatch;
+        // Read on the worker, the bucket being the renderer's once sent
+        bool hasData;
+
+        bool sameLayers(const std::vector<Immutable<style::LayerProperties>>&) const;
+    };
+    // Buckets of `data` by layout key, reused while their layers stay the same
+    mbgl::unordered_map<std::string, BuiltBucket> builtBuckets;
 
     std::vector<std::unique_ptr<Layout>> layouts;
 
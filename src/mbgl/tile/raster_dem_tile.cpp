@@ -46,7 +46,7 @@ RasterDEMTile::~RasterDEMTile() {
 
     // The bucket has resources that need to be released on the render thread.
     if (bucket) {
-        threadPool.runOnRenderThread([bucket_{std::move(bucket)}]() {});
+        threadPool.runOnRenderThread(TaskPriority::Housekeeping, [bucket_{std::move(bucket)}]() {});
     }
 }
 
@@ -69,7 +69,7 @@ void RasterDEMTile::setData(const std::shared_ptr<const std::string>& data) {
         ++correlationID;
 
         if (!pending) {
-            observer->onTileAction(id, sourceID, TileOperation::StartParse);
+            onTileAction(TileOperation::StartParse);
         }
 
         pending = true;
@@ -77,13 +77,16 @@ void RasterDEMTile::setData(const std::shared_ptr<const std::string>& data) {
     }
 }
 
-void RasterDEMTile::onParsed(std::unique_ptr<HillshadeBucket> result, const uint64_t resultCorrelationID) {
+void RasterDEMTile::onParsed(std::unique_ptr<HillshadeBucket> result,
+                             const uint64_t resultCorrelationID,
+                             const Duration parseTime) {
     if (!obsolete) {
         bucket = std::move(result);
+        rebuildCost = parseTime;
         loaded = true;
         if (resultCorrelationID == correlationID) {
             pending = false;
-            observer->onTileAction(id, sourceID, TileOperation::EndParse);
+            onTileAction(TileOperation::EndParse);
         }
         renderable = static_cast<bool>(bucket);
         observer->onTileChanged(*this);
@@ -127,7 +130,9 @@ void RasterDEMTile::backfillBorder(const RasterDEMTile& borderTile, const DEMTil
         const DEMData& borderDEM = borderBucket->getDEMData();
         DEMData& tileDEM = bucket->getDEMData();
 
+        const auto start = Clock::now();
         tileDEM.backfillBorder(borderDEM, dx, dy);
+        rebuildCost += Clock::now() - start;
         // update the bitmask to indicate that this tiles have been backfilled by flipping the relevant bit
         this->neighboringTiles = this->neighboringTiles | mask;
         // mark HillshadeBucket.prepared as false so it runs through the prepare
@@ -147,6 +152,18 @@ void RasterDEMTile::setNecessity(TileNecessity necessity) {
     loader.setNecessity(necessity);
 }
 
+void RasterDEMTile::setTaskPriority(TaskPriority priority) {
+    worker.setPriority(priority);
+}
+
+void RasterDEMTile::setRequestRank(float rank) {
+    loader.setRequestRank(rank);
+}
+
+MemoryUsage RasterDEMTile::getMemoryUsage() const {
+    return bucket ? bucket->getMemoryUsage() : MemoryUsage{};
+}
+
 void RasterDEMTile::setUpdateParameters(const TileUpdateParameters& params) {
     loader.setUpdateParameters(params);
 }
@@ -2,6 +2,7 @@
 #include <mbgl/tile/raster_dem_tile.hpp>
 #include <mbgl/renderer/buckets/hillshade_bucket.hpp>
 #include <mbgl/actor/actor.hpp>
+#include <mbgl/util/chrono.hpp>
 #include <mbgl/util/premultiply.hpp>
 
 namespace mbgl {
@@ -13,14 +14,14 @@ void RasterDEMTileWorker::parse(const std::shared_ptr<const std::string>& data,
                                 uint64_t correlationID,
                                 Tileset::RasterEncoding encoding) {
     if (!data) {
-        parent.invoke(&RasterDEMTile::onParsed, nullptr,
-                      correlationID); // No data; empty tile.
+        parent.invoke(&RasterDEMTile::onParsed, nullptr, correlationID, Duration::zero()); // No data; empty tile.
         return;
     }
 
     try {
+        const auto start = Clock::now();
         auto bucket = std::make_unique<HillshadeBucket>(decodeImage(*data), encoding);
-        parent.invoke(&RasterDEMTile::onParsed, std::move(bucket), correlationID);
+        parent.invoke(&RasterDEMTile::onParsed, std::move(bucket), correlationID, Duration(Clock::now() - start));
     } catch (...) {
         parent.invoke(&RasterDEMTile::onError, std::current_exception(), correlationID);
     }
@@ -35,7 +35,7 @@ RasterTile::~RasterTile() {
 
     // The bucket has resources that need to be released on the render thread.
     if (bucket) {
-        threadPool.runOnRenderThread([bucket_{std::move(bucket)}]() {});
+        threadPool.runOnRenderThread(TaskPriority::Housekeeping, [bucket_{std::move(bucket)}]() {});
     }
 }
 
@@ -58,7 +58,7 @@ void RasterTile::setData(const std::shared_ptr<const std::string>& data) {
         ++correlationID;
 
         if (!pending) {
-            observer->onTileAction(id, sourceID, TileOperation::StartParse);
+            onTileAction(TileOperation::StartParse);
         }
 
         pending = true;
@@ -66,13 +66,16 @@ void RasterTile::setData(const std::shared_ptr<const std::string>& data) {
     }
 }
 
-void RasterTile::onParsed(std::unique_ptr<RasterBucket> result, const uint64_t resultCorrelationID) {
+void RasterTile::onParsed(std::unique_ptr<RasterBucket> result,
+                          const uint64_t resultCorrelationID,
+                          const Duration parseTime) {
     if (!obsolete) {
         bucket = std::move(result);
+        rebuildCost = parseTime;
         loaded = true;
         if (resultCorrelationID == correlationID) {
             pending = false;
-            observer->onTileAction(id, sourceID, TileOperation::EndParse);
+            onTileAction(TileOperation::EndParse);
         }
         renderable = static_cast<bool>(bucket);
         observer->onTileChanged(*this);
@@ -102,6 +105,18 @@ void RasterTile::setNecessity(TileNecessity necessity) {
     loader.setNecessity(necessity);
 }
 
+void RasterTile::setTaskPriority(TaskPriority priority) {
+    worker.setPriority(priority);
+}
+
+void RasterTile::setRequestRank(float rank) {
+    loader.setRequestRank(rank);
+}
+
+MemoryUsage RasterTile::getMemoryUsage() const {
+    return bucket ? bucket->getMemoryUsage() : MemoryUsage{};
+}
+
 void RasterTile::setUpdateParameters(const TileUpdateParameters& params) {
     loader.setUpdateParameters(params);
 }
@@ -23,6 +23,9 @@ public:
 
     std::unique_ptr<TileRenderData> createRenderData() override;
     void setNecessity(TileNecessity) override;
+    void setTaskPriority(TaskPriority) override;
+    void setRequestRank(float) override;
+    MemoryUsage getMemoryUsage() const override;
     void setUpdateParameters(const TileUpdateParameters&) override;
 
     void setError(std::exception_ptr);
@@ -33,7 +36,7 @@ public:
 
     void setMask(TileMask&&) override;
 
-    void onParsed(std::unique_ptr<RasterBucket> result, uint64_t correlationID);
+    void onParsed(std::unique_ptr<RasterBucket> result, uint64_t correlationID, Duration parseTime = Duration::zero());
     void onError(std::exception_ptr, uint64_t correlationID);
 
     void cancel() override;
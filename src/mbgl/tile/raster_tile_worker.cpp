@@ -2,6 +2,8 @@
 #include <mbgl/tile/raster_tile.hpp>
 #include <mbgl/renderer/buckets/raster_bucket.hpp>
 #include <mbgl/actor/actor.hpp>
+#include <mbgl/util/chrono.hpp>
+#include <mbgl/util/compressed_image.hpp>
 #include <mbgl/util/premultiply.hpp>
 
 namespace mbgl {
@@ -11,14 +13,16 @@ RasterTileWorker::RasterTileWorker(const ActorRef<RasterTileWorker>&, ActorRef<R
 
 void RasterTileWorker::parse(const std::shared_ptr<const std::string>& data, uint64_t correlationID) {
     if (!data) {
-        parent.invoke(&RasterTile::onParsed, nullptr,
-                      correlationID); // No data; empty tile.
+        parent.invoke(&RasterTile::onParsed, nullptr, correlationID, Duration::zero()); // No data; empty tile.
         return;
     }
 
     try {
-        auto bucket = std::make_unique<RasterBucket>(decodeImage(*data));
-        parent.invoke(&RasterTile::onParsed, std::move(bucket), correlationID);
+        const auto start = Clock::now();
+        // KTX tiles hold GPU block-compressed images, which stay compressed in texture memory
+        auto bucket = isKTX(*data) ? std::make_unique<RasterBucket>(decodeKTX(*data))
+                                   : std::make_unique<RasterBucket>(decodeImage(*data));
+        parent.invoke(&RasterTile::onParsed, std::move(bucket), correlationID, Duration(Clock::now() - start));
     } catch (...) {
         parent.invoke(&RasterTile::onError, std::current_exception(), correlationID);
     }
@@ -3,6 +3,12 @@
 #include <mbgl/renderer/query.hpp>
 #include <mbgl/util/string.hpp>
 #include <mbgl/util/logging.hpp>
+#include <mbgl/util/constants.hpp>
+#include <mbgl/util/projection.hpp>
+
+#include <mapbox/geometry/envelope.hpp>
+
+#include <algorithm>
 
 namespace mbgl {
 
@@ -65,7 +71,65 @@ float Tile::getQueryPadding(const std::unordered_map<std::string, const RenderLa
 
 void Tile::querySourceFeatures(std::vector<Feature>&, const SourceQueryOptions&) {}
 
+std::optional<mapbox::geometry::box<double>> Tile::sourceQueryBox(const SourceQueryOptions& options) const {
+    if (!options.bounds) {
+        return std::nullopt;
+    }
+    const auto toTileUnits = [&](const LatLng& latLng) {
+        const auto world = Projection::project(latLng, static_cast<int32_t>(id.canonical.z));
+        return Point<double>{(world.x - id.canonical.x) * util::EXTENT, (world.y - id.canonical.y) * util::EXTENT};
+    };
+    // Tile y grows southwards
+    return mapbox::geometry::box<double>{toTileUnits(options.bounds->northwest()),
+                                         toTileUnits(options.bounds->southeast())};
+}
+
+bool Tile::intersects(const GeometryTileFeature& feature, const mapbox::geometry::box<double>& box) {
+    for (const auto& ring : feature.getGeometries()) {
+        if (ring.empty()) {
+            continue;
+        }
+        const auto envelope = mapbox::geometry::envelope(ring);
+        if (envelope.min.x <= box.max.x && envelope.max.x >= box.min.x && envelope.min.y <= box.max.y &&
+            envelope.max.y >= box.min.y) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void Tile::addLatencies(TileLatencies& latencies, TimePoint renderedAt) const {
+    if (loadedAt) {
+        latencies.load.add(*loadedAt - createdAt);
+    }
+    if (parseStartedAt && parsedAt && *parsedAt >= *parseStartedAt) {
+        const Duration parse = *parsedAt - *parseStartedAt;
+        latencies.parse.add(parse);
+        latencies.parseWait.add(std::max(parse - rebuildCost, Duration::zero()));
+    }
+    if (parsedAt) {
+        latencies.render.add(renderedAt - *parsedAt);
+    }
+    latencies.total.add(renderedAt - createdAt);
+}
+
 void Tile::onTileAction(TileOperation op) {
+    if (!uploaded) {
+        switch (op) {
+            case TileOperation::LoadFromNetwork:
+            case TileOperation::LoadFromCache:
+                loadedAt = Clock::now();
+                break;
+            case TileOperation::StartParse:
+                parseStartedAt = Clock::now();
+                break;
+            case TileOperation::EndParse:
+                parsedAt = Clock::now();
+                break;
+            default:
+                break;
+        }
+    }
     observer->onTileAction(id, sourceID, op);
 };
 
@@ -7,15 +7,20 @@
 #include <mbgl/tile/tile_id.hpp>
 #include <mbgl/tile/tile_necessity.hpp>
 #include <mbgl/tile/tile_loader_observer.hpp>
+#include <mbgl/tile/tile_latency.hpp>
 #include <mbgl/renderer/tile_mask.hpp>
+#include <mbgl/renderer/memory_report.hpp>
 #include <mbgl/renderer/bucket.hpp>
 #include <mbgl/tile/geometry_tile_data.hpp>
 #include <mbgl/storage/resource.hpp>
 #include <mbgl/style/layer_properties.hpp>
 
+#include <mapbox/geometry/box.hpp>
+
 #include <string>
 #include <memory>
 #include <functional>
+#include <map>
 #include <unordered_map>
 #include <optional>
 
@@ -30,6 +35,7 @@ class RenderedQueryOptions;
 class SourceQueryOptions;
 class CollisionIndex;
 class SourceFeatureState;
+enum class TaskPriority : uint8_t;
 
 namespace gfx {
 class UploadPass;
@@ -68,6 +74,20 @@ public:
 
     virtual void setUpdateParameters(const TileUpdateParameters&) {}
 
+    // Set the urgency of the background work needed to prepare this tile.
+    virtual void setTaskPriority(TaskPriority) {}
+
+    // Set the rank of this tile's pending network request, lower ranks are sent first.
+    virtual void setRequestRank(float) {}
+
+    // Approximate memory retained by this tile's buckets, indexes, and source data.
+    virtual MemoryUsage getMemoryUsage() const { return {}; }
+
+    // Add this tile's memory to the report of its source, and its buckets to the layers using them.
+    virtual void reportMemoryUsage(MemoryReport::Source& source, std::map<std::string, MemoryUsage>&) const {
+        source.tileData += getMemoryUsage();
+    }
+
     // Mark this tile as no longer needed and cancel any pending work.
     virtual void cancel() = 0;
 
@@ -103,8 +123,12 @@ public:
 
     // Tile data considered "Renderable" can be used for rendering. Data in
     // partial state is still waiting for network resources but can also
-    // be rendered, although layers will be missing.
-    bool isRenderable() const { return renderable; }
+    // be rendered, although layers will be missing. Tiles held back by the
+    // upload budget aren't renderable until they're admitted.
+    bool isRenderable() const { return renderable && !uploadDeferred; }
+
+    // Whether the tile has data to render that hasn't been uploaded yet
+    bool awaitsUpload() const { return renderable && !uploaded; }
 
     // A tile is "Loaded" when we have received a response from a FileSource,
     // and have attempted to parse the tile (if applicable). Tile
@@ -120,6 +144,13 @@ public:
     // when a raster tile couldn't be loaded, or parsing failed.
     bool isComplete() const { return loaded && !pending; }
 
+    // Background and render thread time spent producing the current contents
+    // of this tile, i.e., roughly what it would cost to build it again.
+    Duration getRebuildCost() const { return rebuildCost; }
+    // Adds how long each stage of the tile's first load took to the given
+    // latencies, the tile being first rendered at `renderedAt`.
+    void addLatencies(TileLatencies&, TimePoint renderedAt) const;
+
     // "holdForFade" is used to keep tiles in the render tree after they're no
     // longer ideal tiles in order to allow symbols to fade out
     virtual bool holdForFade() const { return false; }
@@ -133,6 +164,9 @@ public:
     virtual void performedFadePlacement() {}
 
     virtual void setFeatureState(const LayerFeatureStates&) {}
+    /// Whether the tile has to be given every feature state of its source rather than only the changes,
+    /// because its buckets were built after the states were last applied
+    virtual bool needsAllFeatureStates() const { return false; }
 
     void dumpDebugLogs() const;
 
@@ -147,14 +181,32 @@ public:
     // Indicates whether this tile is used for the currently visible layers on
     // the map. Re-initialized at every source update.
     bool usedByRenderedLayers = false;
+    // Set once the tile has been rendered, i.e., its data has been uploaded.
+    bool uploaded = false;
+    // Set for the frame when the tile hasn't been uploaded yet and doesn't fit
+    // in the upload budget, the tiles around it are rendered in its place.
+    bool uploadDeferred = false;
 
 protected:
+    /// The bounds of a source query in the tile units of this tile's geometry, if it has any
+    std::optional<mapbox::geometry::box<double>> sourceQueryBox(const SourceQueryOptions&) const;
+    /// Whether the envelope of a feature's geometry intersects a box in tile units
+    static bool intersects(const GeometryTileFeature&, const mapbox::geometry::box<double>&);
+
     bool triedOptional = false;
     bool renderable = false;
     bool pending = false;
     bool loaded = false;
+    Duration rebuildCost = Duration::zero();
 
     TileObserver* observer = nullptr;
+
+private:
+    // When the stages of the tile's first load ended, recorded until it's uploaded.
+    const TimePoint createdAt = Clock::now();
+    std::optional<TimePoint> loadedAt;
+    std::optional<TimePoint> parseStartedAt;
+    std::optional<TimePoint> parsedAt;
 };
 
 } // namespace mbgl
@@ -3,7 +3,11 @@
 #include <mbgl/actor/scheduler.hpp>
 #include <mbgl/util/instrumentation.hpp>
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
+#include <limits>
+#include <utility>
 
 namespace mbgl {
 
@@ -13,47 +17,86 @@ TileCache::~TileCache() {
     clear();
     pendingReleases.clear();
 
-    std::unique_lock counterLock{deferredSignalLock};
-    deferredSignal.wait(counterLock, [&]() { return deferredDeletionsPending == 0; });
+    // Anything the pool hasn't picked up yet is destroyed here rather than waited for.
+    // Tasks that start after this find the queue empty and only touch the shared state,
+    // so we only need to wait for those that are already destroying tiles.
+    reclamation->queue.drain();
+
+    std::unique_lock lock{reclamation->finishedLock};
+    reclamation->finished.wait(lock, [&]() { return reclamation->draining == 0; });
 }
 
 void TileCache::setSize(size_t size_) {
     MLN_TRACE_FUNC();
 
     size = size_;
+    evict();
 
-    while (orderedKeys.size() > size) {
-        const auto key = orderedKeys.front();
-        orderedKeys.remove(key);
+    assert(orderedKeys.size() <= size);
+}
+
+void TileCache::setMaxBytes(size_t maxBytes_) {
+    MLN_TRACE_FUNC();
 
-        auto hit = tiles.find(key);
-        if (hit != tiles.end()) {
-            auto tile = std::move(hit->second);
-            tiles.erase(hit);
-            deferredRelease(std::move(tile));
+    maxBytes = maxBytes_;
+    evict();
+}
+
+OverscaledTileID TileCache::selectVictim() const {
+    assert(!orderedKeys.empty());
+
+    // Candidates are visited oldest-first, so ties are broken in LRU order
+    auto victim = orderedKeys.begin();
+    switch (policy) {
+        case EvictionPolicy::LRU:
+            break;
+        case EvictionPolicy::CostWeighted: {
+            double lowest = std::numeric_limits<double>::infinity();
+            for (auto it = orderedKeys.begin(); it != orderedKeys.end(); ++it) {
+                const auto priority = tiles.at(*it).priority;
+                if (priority < lowest) {
+                    lowest = priority;
+                    victim = it;
+                }
+            }
+            break;
+        }
+        case EvictionPolicy::ZoomDistance: {
+            double furthest = -1;
+            for (auto it = orderedKeys.begin(); it != orderedKeys.end(); ++it) {
+                const auto distance = std::abs(static_cast<double>(it->overscaledZ) - cameraZoom);
+                if (distance > furthest) {
+                    furthest = distance;
+                    victim = it;
+                }
+            }
+            break;
         }
     }
+    return *victim;
+}
 
-    assert(orderedKeys.size() <= size);
+void TileCache::evictVictim() {
+    const auto key = selectVictim();
+    if (policy == EvictionPolicy::CostWeighted) {
+        inflation = tiles.at(key).priority;
+    }
+    deferredRelease(pop(key));
 }
 
-namespace {
-/// This exists solely to prevent a problem where temporary lambda captures
-/// are retained for the duration of the scope instead of being destroyed immediately.
-struct CaptureWrapper {
-    CaptureWrapper(std::vector<std::unique_ptr<Tile>>&& items_)
-        : items(items_.size()) {
-        std::ranges::move(items_, items.begin());
+void TileCache::evict() {
+    while (!orderedKeys.empty() && overBudget()) {
+        evictVictim();
     }
-    CaptureWrapper(CaptureWrapper&&) = default;
+}
 
-    /// This copy constructor is required to build, but doesn't seem to be called.
-    CaptureWrapper(const CaptureWrapper& other)
-        : items(other.items) {}
+void TileCache::trim(size_t targetBytes) {
+    MLN_TRACE_FUNC();
 
-    std::vector<std::shared_ptr<Tile>> items;
-};
-} // namespace
+    while (!orderedKeys.empty() && bytes > targetBytes) {
+        evictVictim();
+    }
+}
 
 void TileCache::deferredRelease(std::unique_ptr<Tile>&& tile) {
     MLN_TRACE_FUNC();
@@ -65,38 +108,30 @@ void TileCache::deferredRelease(std::unique_ptr<Tile>&& tile) {
 void TileCache::deferPendingReleases() {
     MLN_TRACE_FUNC();
 
-    constexpr std::size_t scheduleThreshold = 1;
-    if (pendingReleases.size() < scheduleThreshold) {
+    if (pendingReleases.empty()) {
         return;
     }
 
-    // Block destruction until the cleanup task is complete
-    {
-        std::scoped_lock counterLock{deferredSignalLock};
-        deferredDeletionsPending++;
+    // A cleanup task is needed only if the queue was empty, otherwise one is already scheduled
+    // and will pick these up. The task running concurrently with this is fine, as it empties
+    // the queue before destroying anything, and then we see it empty.
+    if (!reclamation->queue.push(std::exchange(pendingReleases, {}))) {
+        return;
     }
 
-    CaptureWrapper wrap{std::move(pendingReleases)};
-    pendingReleases.clear();
-
-    // The `std::function` must be created in a separate statement from the `schedule` call.
-    // Creating a `std::function` from a lambda involves a copy, which is why we must use
-    // `shared_ptr` rather than `unique_ptr` for the capture.  As a result, a temporary holds
-    // a reference until the construction is complete and the lambda is destroyed.
-    // If this temporary outlives the `schedule` call, and the function is executed immediately
-    // by a waiting thread and is already complete, that temporary reference ends up being the
-    // last one and the destruction actually occurs here on this thread.
-    std::function<void()> func{[tile_{CaptureWrapper{std::move(wrap)}}, this]() mutable {
+    threadPool.schedule(TaskPriority::Housekeeping, [reclamation_{reclamation}]() {
         MLN_TRACE_ZONE(deferPendingReleases lambda);
-        MLN_ZONE_VALUE(tile_.items.size());
-        tile_.items.clear();
 
-        std::scoped_lock counterLock(deferredSignalLock);
-        deferredDeletionsPending--;
-        deferredSignal.notify_all();
-    }};
+        // Announce before taking the items, see `~TileCache`
+        reclamation_->draining++;
+        [[maybe_unused]] const auto count = reclamation_->queue.drain();
+        MLN_ZONE_VALUE(count);
 
-    threadPool.schedule(std::move(func));
+        if (--reclamation_->draining == 0) {
+            std::scoped_lock lock{reclamation_->finishedLock};
+            reclamation_->finished.notify_all();
+        }
+    });
 }
 
 void TileCache::add(const OverscaledTileID& key, std::unique_ptr<Tile>&& tile) {
@@ -107,10 +142,15 @@ void TileCache::add(const OverscaledTileID& key, std::unique_ptr<Tile>&& tile) {
         return;
     }
 
-    const auto result = tiles.insert(std::make_pair(key, std::unique_ptr<Tile>{}));
+    const auto result = tiles.insert(std::make_pair(key, Entry{}));
     if (result.second) {
         // inserted
-        result.first->second = std::move(tile);
+        auto& entry = result.first->second;
+        entry.bytes = tile->getMemoryUsage().total();
+        const auto cost = std::chrono::duration<double, std::micro>(tile->getRebuildCost()).count();
+        entry.priority = inflation + cost / static_cast<double>(std::max<size_t>(entry.bytes, 1));
+        entry.tile = std::move(tile);
+        bytes += entry.bytes;
     } else {
         // already present
         // remove existing tile key to move it to the end
@@ -122,10 +162,8 @@ void TileCache::add(const OverscaledTileID& key, std::unique_ptr<Tile>&& tile) {
     // (re-)insert tile key as newest
     orderedKeys.push_back(key);
 
-    // purge oldest key/tile if necessary
-    if (orderedKeys.size() > size) {
-        deferredRelease(pop(orderedKeys.front()));
-    }
+    // purge oldest keys/tiles until we're within budget
+    evict();
 
     assert(orderedKeys.size() <= size);
 }
@@ -133,7 +171,7 @@ void TileCache::add(const OverscaledTileID& key, std::unique_ptr<Tile>&& tile) {
 Tile* TileCache::get(const OverscaledTileID& key) {
     auto it = tiles.find(key);
     if (it != tiles.end()) {
-        return it->second.get();
+        return it->second.tile.get();
     } else {
         return nullptr;
     }
@@ -144,7 +182,10 @@ std::unique_ptr<Tile> TileCache::pop(const OverscaledTileID& key) {
 
     const auto it = tiles.find(key);
     if (it != tiles.end()) {
-        tile = std::move(tiles.extract(it).mapped());
+        auto entry = std::move(tiles.extract(it).mapped());
+        tile = std::move(entry.tile);
+        assert(bytes >= entry.bytes);
+        bytes -= entry.bytes;
         orderedKeys.remove(key);
         assert(tile->isRenderable());
     }
@@ -158,10 +199,18 @@ bool TileCache::has(const OverscaledTileID& key) {
 
 void TileCache::clear() {
     for (auto& item : tiles) {
-        deferredRelease(std::move(item.second));
+        deferredRelease(std::move(item.second.tile));
     }
     orderedKeys.clear();
     tiles.clear();
+    bytes = 0;
+    inflation = 0;
+}
+
+void TileCache::forEachTile(const std::function<void(const Tile&)>& fn) const {
+    for (const auto& item : tiles) {
+        fn(*item.second.tile);
+    }
 }
 
 } // namespace mbgl
@@ -3,7 +3,9 @@
 #include <mbgl/actor/scheduler.hpp>
 #include <mbgl/tile/tile_id.hpp>
 #include <mbgl/tile/tile.hpp>
+#include <mbgl/util/reclamation_queue.hpp>
 
+#include <functional>
 #include <list>
 #include <memory>
 #include <map>
@@ -15,8 +17,20 @@ namespace mbgl {
 
 class TileCache {
 public:
+    /// Decides which tile is evicted when the cache is over its count or byte limit
+    enum class EvictionPolicy : uint8_t {
+        /// The least recently added tile
+        LRU,
+        /// The tile with the lowest rebuild cost per byte, aged by the priority of the last eviction
+        /// (Greedy-Dual-Size). Tiles leave the cache on their first use, so there's no frequency term.
+        CostWeighted,
+        /// The tile whose zoom level is furthest from the camera, the least recently added among equals
+        ZoomDistance,
+    };
+
     TileCache(const TaggedScheduler& threadPool_, size_t size_ = 0)
         : threadPool(threadPool_),
+          reclamation(std::make_shared<Reclamation>()),
           size(size_) {}
     ~TileCache();
 
@@ -26,6 +40,27 @@ public:
     /// Get the maximum size
     size_t getMaxSize() const { return size; }
 
+    /// Change the memory budget of the cache, in bytes, zero for no limit.
+    /// Tiles are evicted oldest-first until both the count and byte limits are met.
+    void setMaxBytes(size_t);
+
+    /// Get the memory budget
+    size_t getMaxBytes() const { return maxBytes; }
+
+    /// Get the memory reported by the cached tiles when they were added
+    size_t getBytes() const { return bytes; }
+
+    /// Evict tiles, in the order of the eviction policy, until the cached tiles take at most the given bytes.
+    /// The limits are left unchanged, so the cache fills up again as tiles are added.
+    void trim(size_t targetBytes);
+
+    /// Change the eviction policy, takes effect on the next eviction
+    void setEvictionPolicy(EvictionPolicy policy_) { policy = policy_; }
+    EvictionPolicy getEvictionPolicy() const { return policy; }
+
+    /// Set the zoom level used by the `ZoomDistance` policy
+    void setCameraZoom(double zoom) { cameraZoom = zoom; }
+
     /// Add a new tile with the given ID.
     /// If a tile with the same ID is already present, it will be retained and the new one will be discarded.
     void add(const OverscaledTileID& key, std::unique_ptr<Tile>&& tile);
@@ -35,21 +70,51 @@ public:
     bool has(const OverscaledTileID& key);
     void clear();
 
+    /// Visit the cached tiles, in no particular order
+    void forEachTile(const std::function<void(const Tile&)>&) const;
+
     /// Set aside a tile to be destroyed later, without blocking
     void deferredRelease(std::unique_ptr<Tile>&&);
 
-    /// Schedule any accumulated deferred tiles to be destroyed
+    /// Schedule any accumulated deferred tiles to be destroyed.
+    /// Lock-free, tiles are destroyed on the thread pool.
     void deferPendingReleases();
 
 private:
-    std::map<OverscaledTileID, std::unique_ptr<Tile>> tiles;
+    struct Entry {
+        std::unique_ptr<Tile> tile;
+        size_t bytes = 0;
+        /// Eviction priority for the `CostWeighted` policy, lowest goes first
+        double priority = 0;
+    };
+
+    bool overBudget() const { return orderedKeys.size() > size || (maxBytes && bytes > maxBytes); }
+    OverscaledTileID selectVictim() const;
+    void evictVictim();
+    void evict();
+
+    std::map<OverscaledTileID, Entry> tiles;
     std::list<OverscaledTileID> orderedKeys;
     TaggedScheduler threadPool;
     std::vector<std::unique_ptr<Tile>> pendingReleases;
-    size_t deferredDeletionsPending{0};
-    std::mutex deferredSignalLock;
-    std::condition_variable deferredSignal;
+
+    /// Shared with the cleanup tasks, so that they don't refer to the cache
+    struct Reclamation {
+        util::ReclamationQueue<Tile> queue;
+        /// Cleanup tasks currently draining the queue
+        std::atomic<size_t> draining{0};
+        /// Only used to wait for the tasks in flight on destruction
+        std::mutex finishedLock;
+        std::condition_variable finished;
+    };
+    const std::shared_ptr<Reclamation> reclamation;
     size_t size;
+    size_t maxBytes = 0;
+    size_t bytes = 0;
+    EvictionPolicy policy = EvictionPolicy::LRU;
+    double cameraZoom = 0;
+    /// Greedy-Dual-Size aging value, the priority of the most recently evicted tile
+    double inflation = 0;
 };
 
 } // namespace mbgl
@@ -0,0 +1,30 @@
+#include <mbgl/tile/tile_latency.hpp>
+
+#include <algorithm>
+#include <bit>
+
+namespace mbgl {
+
+void LatencyHistogram::add(Duration latency) {
+    latency = std::max(latency, Duration::zero());
+    const auto milliseconds = static_cast<uint64_t>(std::chrono::duration_cast<Milliseconds>(latency).count());
+    const auto bucket = std::min<std::size_t>(std::bit_width(milliseconds), bucketCount - 1);
+    ++buckets[bucket];
+    ++count;
+    total += latency;
+    max = std::max(max, latency);
+}
+
+Duration LatencyHistogram::percentile(double fraction) const {
+    const auto rank = static_cast<uint64_t>(std::clamp(fraction, 0.0, 1.0) * count);
+    uint64_t counted = 0;
+    for (std::size_t i = 0; i + 1 < bucketCount; ++i) {
+        counted += buckets[i];
+        if (counted > rank || (counted == count && count > 0)) {
+            return std::min<Duration>(Milliseconds(int64_t{1} << i), max);
+        }
+    }
+    return max;
+}
+
+} // namespace mbgl
@@ -25,6 +25,9 @@ public:
 
     void setNecessity(TileNecessity newNecessity);
     void setUpdateParameters(const TileUpdateParameters&);
+    void setRequestRank(float rank) { resource.rank->store(rank, std::memory_order_relaxed); }
+    /// Stores what layout produced from the data last loaded with the file source, see `FileSource::putTileLayout`
+    void storeLayout(std::string layout);
 
 private:
     // called when the tile is one of the ideal tiles that we want to show
@@ -51,6 +54,7 @@ private:
     Resource resource;
     std::shared_ptr<FileSource> fileSource;
     std::unique_ptr<AsyncRequest> request;
+    std::shared_ptr<const std::string> data;
     TileUpdateParameters updateParameters{.minimumUpdateInterval = Duration::zero(), .isVolatile = false};
 
     /// @brief It's possible for async requests in flight to mess with the request
@@ -32,6 +32,7 @@ TileLoader<T>::TileLoader(T& tile_,
     assert(!request);
 
     shared = std::make_shared<Shared>();
+    resource.rank = std::make_shared<std::atomic<float>>(0.0f);
 
     if (!fileSource) {
         tile.setError(getCantLoadTileError());
@@ -180,7 +181,19 @@ void TileLoader<T>::loadedData(const Response& res, Resource::LoadingMethod meth
         resource.priorExpires = res.expires;
         resource.priorEtag = res.etag;
         tile.setMetadata(res.modified, res.expires);
-        tile.setData(res.noContent ? nullptr : res.data);
+        data = res.noContent ? nullptr : res.data;
+        if constexpr (requires { tile.setStoredLayout(res.layout, true); }) {
+            // Only what the offline database returned could be stored along with it, and for lack of a layout
+            tile.setStoredLayout(res.layout, method == Resource::LoadingMethod::CacheOnly && !res.layout);
+        }
+        tile.setData(data);
+    }
+}
+
+template <typename T>
+void TileLoader<T>::storeLayout(std::string layout) {
+    if (fileSource && data) {
+        fileSource->putTileLayout(resource, data, std::move(layout));
     }
 }
 
@@ -26,7 +26,9 @@ VectorMLTTile::~VectorMLTTile() {
 
 void VectorMLTTile::setData(const std::shared_ptr<const std::string>& data_) {
     if (!obsolete) {
-        GeometryTile::setData(data_ ? std::make_unique<VectorMLTTileData>(data_) : nullptr);
+        setLoadedData(makeData(data_, [](std::shared_ptr<const std::string> bytes) {
+            return std::make_unique<VectorMLTTileData>(std::move(bytes));
+        }));
     }
 }
 
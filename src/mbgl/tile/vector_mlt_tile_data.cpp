@@ -174,20 +174,43 @@ std::string VectorMLTTileLayer::getName() const {
     return layer.getName();
 }
 
+std::optional<std::vector<std::optional<Value>>> VectorMLTTileLayer::getPropertyColumn(const std::string& key) const {
+    const auto& features = layer.getFeatures();
+    std::vector<std::optional<Value>> column(features.size());
+    for (std::size_t i = 0; i < features.size(); ++i) {
+        if (auto prop = features[i].getProperty(key, layer)) {
+            column[i] = std::visit(PropertyVisitor(), *prop);
+        }
+    }
+    return column;
+}
+
 VectorMLTTileData::VectorMLTTileData(std::shared_ptr<const std::string> data_)
-    : data(std::move(data_)) {}
+    : data(std::move(data_)),
+      encodedSize(data ? data->size() : 0) {}
 
 VectorMLTTileData::VectorMLTTileData(const VectorMLTTileData& other)
-    : data(other.data),
-      tile(other.tile) {}
+    : encodedSize(other.encodedSize) {
+    std::scoped_lock lock{other.decodeMutex};
+    data = other.data;
+    tile = other.tile;
+}
 
 std::unique_ptr<GeometryTileData> VectorMLTTileData::clone() const {
     return std::make_unique<VectorMLTTileData>(*this);
 }
 
+MemoryUsage VectorMLTTileData::getMemoryUsage() const {
+    std::scoped_lock lock{decodeMutex};
+    // The decoded form is not measured, use the encoded size as an estimate of it
+    return {.cpu = data ? data->size() : encodedSize};
+}
+
 std::unique_ptr<GeometryTileLayer> VectorMLTTileData::getLayer(const std::string& name) const {
     MLN_TRACE_FUNC();
 
+    // A shared instance may be read by several workers at once
+    std::unique_lock lock{decodeMutex};
     if (data && !tile) {
         try {
             mlt::DataView tileData{data->data(), data->size()};
@@ -199,18 +222,28 @@ std::unique_ptr<GeometryTileLayer> VectorMLTTileData::getLayer(const std::string
         data.reset();
     }
 
-    if (tile) {
-        if (const auto* layer = tile->getLayer(name)) {
-            return std::make_unique<VectorMLTTileLayer>(tile, *layer);
+    const auto decoded = tile;
+    lock.unlock();
+
+    if (decoded) {
+        if (const auto* layer = decoded->getLayer(name)) {
+            return std::make_unique<VectorMLTTileLayer>(decoded, *layer);
         }
     }
     return nullptr;
 }
 
 std::vector<std::string> VectorMLTTileData::layerNames() const {
-    if (data && !data->empty() && !tile) {
+    bool needsDecode = false;
+    {
+        std::scoped_lock lock{decodeMutex};
+        needsDecode = data && !data->empty() && !tile;
+    }
+    if (needsDecode) {
         getLayer({});
     }
+
+    std::scoped_lock lock{decodeMutex};
     if (tile) {
         std::vector<std::string> result(tile->getLayers().size());
         std::ranges::transform(tile->getLayers(), result.begin(), [](const auto& layer) { return layer.getName(); });
@@ -5,6 +5,7 @@
 
 #include <unordered_map>
 #include <functional>
+#include <mutex>
 #include <utility>
 
 namespace mlt {
@@ -60,6 +61,7 @@ public:
     std::size_t featureCount() const override;
     std::unique_ptr<GeometryTileFeature> getFeature(std::size_t i) const override;
     std::string getName() const override;
+    std::optional<std::vector<std::optional<Value>>> getPropertyColumn(const std::string& key) const override;
 
 private:
     const std::shared_ptr<const MapLibreTile> tile;
@@ -70,16 +72,18 @@ class VectorMLTTileData : public GeometryTileData {
 public:
     VectorMLTTileData(std::shared_ptr<const std::string> data);
     VectorMLTTileData(const VectorMLTTileData&);
-    VectorMLTTileData(VectorMLTTileData&&) = default;
 
     std::unique_ptr<GeometryTileData> clone() const override;
     std::unique_ptr<GeometryTileLayer> getLayer(const std::string& name) const override;
+    MemoryUsage getMemoryUsage() const override;
 
     std::vector<std::string> layerNames() const;
 
 private:
     mutable std::shared_ptr<const std::string> data;
     mutable std::shared_ptr<const MapLibreTile> tile;
+    std::size_t encodedSize = 0;
+    mutable std::mutex decodeMutex;
 };
 
 } // namespace mbgl
@@ -4,14 +4,63 @@
 #include <mbgl/util/instrumentation.hpp>
 #include <mbgl/util/logging.hpp>
 
+#include <stdexcept>
+
 #if ANDROID
 #include <mlt/decoder.hpp>
 #endif
 
 namespace mbgl {
 
-VectorMVTTileFeature::VectorMVTTileFeature(const mapbox::vector_tile::layer& layer, const protozero::data_view& view)
-    : feature(view, layer) {}
+namespace {
+
+// Field numbers from the vector tile specification
+enum : protozero::pbf_tag_type {
+    LayerKeys = 3,
+    LayerValues = 4,
+    FeatureTags = 2,
+};
+
+Value parseValue(const protozero::data_view& view) {
+    protozero::pbf_reader reader(view);
+    Value value;
+    while (reader.next()) {
+        switch (reader.tag()) {
+            case 1:
+                value = reader.get_string();
+                break;
+            case 2:
+                value = static_cast<double>(reader.get_float());
+                break;
+            case 3:
+                value = reader.get_double();
+                break;
+            case 4:
+                value = reader.get_int64();
+                break;
+            case 5:
+                value = reader.get_uint64();
+                break;
+            case 6:
+                value = reader.get_sint64();
+                break;
+            case 7:
+                value = reader.get_bool();
+                break;
+            default:
+                reader.skip();
+                break;
+        }
+    }
+    return value;
+}
+
+} // namespace
+
+VectorMVTTileFeature::VectorMVTTileFeature(const VectorMVTTileLayer& tileLayer_, const protozero::data_view& view_)
+    : tileLayer(tileLayer_),
+      view(view_),
+      feature(view_, tileLayer_.layer) {}
 
 FeatureType VectorMVTTileFeature::getType() const {
     switch (feature.getType()) {
@@ -27,8 +76,44 @@ FeatureType VectorMVTTileFeature::getType() const {
 }
 
 std::optional<Value> VectorMVTTileFeature::getValue(const std::string& key) const {
-    const auto value = feature.getValue(key);
-    return value.is<NullValue>() ? std::nullopt : std::optional<Value>{std::move(value)};
+    if (properties) {
+        const auto it = properties->find(key);
+        return it == properties->end() || it->second.is<NullValue>() ? std::nullopt : std::optional<Value>{it->second};
+    }
+
+    // Decode only the requested value, straight from the tile data
+    const auto& table = tileLayer.getPropertyTable();
+    const auto keyIndex = table.keyIndices.find(key);
+    if (keyIndex == table.keyIndices.end()) {
+        return std::nullopt;
+    }
+
+    if (!tags) {
+        tags.emplace();
+        protozero::pbf_reader reader(view);
+        while (reader.next(FeatureTags)) {
+            tags = reader.get_packed_uint32();
+        }
+    }
+
+    for (auto it = tags->begin(); it != tags->end();) {
+        const auto tagKey = *it++;
+        if (tagKey >= table.keyCount) {
+            throw std::runtime_error("feature referenced out of range key");
+        }
+        if (it == tags->end()) {
+            throw std::runtime_error("uneven number of feature tag ids");
+        }
+        const auto tagValue = *it++;
+        if (tagValue >= table.values.size()) {
+            throw std::runtime_error("feature referenced out of range value");
+        }
+        if (tagKey == keyIndex->second) {
+            auto value = parseValue(table.values[tagValue]);
+            return value.is<NullValue>() ? std::nullopt : std::optional<Value>{std::move(value)};
+        }
+    }
+    return std::nullopt;
 }
 
 const PropertyMap& VectorMVTTileFeature::getProperties() const {
@@ -62,22 +147,48 @@ const GeometryCollection& VectorMVTTileFeature::getGeometries() const {
     return *lines;
 }
 
-VectorMVTTileLayer::VectorMVTTileLayer(std::shared_ptr<const std::string> data_, const protozero::data_view& view)
+VectorMVTTileLayer::VectorMVTTileLayer(std::shared_ptr<const std::string> data_, const protozero::data_view& view_)
     : data(std::move(data_)),
-      layer(view) {}
+      view(view_),
+      layer(view_) {}
 
 std::size_t VectorMVTTileLayer::featureCount() const {
     return layer.featureCount();
 }
 
 std::unique_ptr<GeometryTileFeature> VectorMVTTileLayer::getFeature(std::size_t i) const {
-    return std::make_unique<VectorMVTTileFeature>(layer, layer.getFeature(i));
+    return std::make_unique<VectorMVTTileFeature>(*this, layer.getFeature(i));
 }
 
 std::string VectorMVTTileLayer::getName() const {
     return layer.getName();
 }
 
+const VectorMVTTileLayer::PropertyTable& VectorMVTTileLayer::getPropertyTable() const {
+    // Features of the layer may be evaluated on several threads
+    std::call_once(propertyTableParsed, [&] {
+        protozero::pbf_reader reader(view);
+        while (reader.next()) {
+            switch (reader.tag()) {
+                case LayerKeys: {
+                    const auto key = reader.get_view();
+                    // The first of repeated keys wins, as in mapbox::vector_tile::feature
+                    propertyTable.keyIndices.emplace(std::string_view(key.data(), key.size()),
+                                                     static_cast<uint32_t>(propertyTable.keyCount++));
+                    break;
+                }
+                case LayerValues:
+                    propertyTable.values.push_back(reader.get_view());
+                    break;
+                default:
+                    reader.skip();
+                    break;
+            }
+        }
+    });
+    return propertyTable;
+}
+
 VectorMVTTileData::VectorMVTTileData(std::shared_ptr<const std::string> data_)
     : data(std::move(data_)) {}
 
@@ -85,16 +196,18 @@ std::unique_ptr<GeometryTileData> VectorMVTTileData::clone() const {
     return std::make_unique<VectorMVTTileData>(data);
 }
 
+MemoryUsage VectorMVTTileData::getMemoryUsage() const {
+    // Layers and features are views into the raw buffer
+    return {.cpu = data ? data->size() : 0};
+}
+
 std::unique_ptr<GeometryTileLayer> VectorMVTTileData::getLayer(const std::string& name) const {
     MLN_TRACE_FUNC();
 
-    if (!parsed) {
-        // We're parsing this lazily so that we can construct VectorTileData
-        // objects on the main thread without incurring the overhead of parsing
-        // immediately.
-        layers = mapbox::vector_tile::buffer(*data).getLayers();
-        parsed = true;
-    }
+    // We're parsing this lazily so that we can construct VectorTileData
+    // objects on the main thread without incurring the overhead of parsing
+    // immediately. A shared instance may be read by several workers at once.
+    std::call_once(parsed, [&] { layers = mapbox::vector_tile::buffer(*data).getLayers(); });
 
     auto it = layers.find(name);
     if (it != layers.end()) {
@@ -16,13 +16,18 @@
 
 #include <unordered_map>
 #include <functional>
+#include <mutex>
+#include <string_view>
 #include <utility>
+#include <vector>
 
 namespace mbgl {
 
+class VectorMVTTileLayer;
+
 class VectorMVTTileFeature : public GeometryTileFeature {
 public:
-    VectorMVTTileFeature(const mapbox::vector_tile::layer&, const protozero::data_view&);
+    VectorMVTTileFeature(const VectorMVTTileLayer&, const protozero::data_view&);
 
     FeatureType getType() const override;
     std::optional<Value> getValue(const std::string& key) const override;
@@ -31,9 +36,15 @@ public:
     const GeometryCollection& getGeometries() const override;
 
 private:
+    using PackedTags = protozero::iterator_range<protozero::pbf_reader::const_uint32_iterator>;
+
+    const VectorMVTTileLayer& tileLayer;
+    protozero::data_view view;
     mapbox::vector_tile::feature feature;
     mutable std::optional<GeometryCollection> lines;
     mutable std::optional<PropertyMap> properties;
+    // Key and value indices into the layer's tables, read on the first `getValue`
+    mutable std::optional<PackedTags> tags;
 };
 
 class VectorMVTTileLayer : public GeometryTileLayer {
@@ -44,9 +55,23 @@ public:
     std::unique_ptr<GeometryTileFeature> getFeature(std::size_t i) const override;
     std::string getName() const override;
 
+    // The layer's keys and values, viewing the tile data, so that features can decode the value of
+    // one key without building their whole property map
+    struct PropertyTable {
+        std::unordered_map<std::string_view, uint32_t> keyIndices;
+        std::size_t keyCount = 0;
+        std::vector<protozero::data_view> values;
+    };
+    const PropertyTable& getPropertyTable() const;
+
 private:
+    friend class VectorMVTTileFeature;
+
     std::shared_ptr<const std::string> data;
+    protozero::data_view view;
     mapbox::vector_tile::layer layer;
+    mutable std::once_flag propertyTableParsed;
+    mutable PropertyTable propertyTable;
 };
 
 class VectorMVTTileData : public GeometryTileData {
@@ -55,12 +80,13 @@ public:
 
     std::unique_ptr<GeometryTileData> clone() const override;
     std::unique_ptr<GeometryTileLayer> getLayer(const std::string& name) const override;
+    MemoryUsage getMemoryUsage() const override;
 
     std::vector<std::string> layerNames() const;
 
 private:
     std::shared_ptr<const std::string> data;
-    mutable bool parsed = false;
+    mutable std::once_flag parsed;
     mutable std::map<std::string, const protozero::data_view> layers;
 };
 
@@ -1,18 +1,53 @@
 #include <mbgl/tile/vector_mvt_tile.hpp>
 
+#include <mbgl/platform/settings.hpp>
 #include <mbgl/renderer/tile_parameters.hpp>
+#include <mbgl/tile/geometry_tile_data_cache.hpp>
 #include <mbgl/tile/tile_loader_impl.hpp>
 
 #include <utility>
 
 namespace mbgl {
 
+namespace {
+
+std::string makeSharedDataKey(const OverscaledTileID& id, const Tileset& tileset) {
+    if (tileset.tiles.empty()) {
+        return {};
+    }
+    // Overscaled tiles load their parent's tile, and would each decode it again
+    const bool overscaled = id.overscaledZ > id.canonical.z;
+    const auto value = platform::Settings::getInstance().get(platform::EXPERIMENTAL_SHARED_TILE_DATA);
+    if (const auto* enabled = value.getBool(); !overscaled && (!enabled || !*enabled)) {
+        return {};
+    }
+
+    std::string key;
+    key += static_cast<char>('0' + static_cast<int>(tileset.scheme));
+    key += static_cast<char>('0' + static_cast<int>(tileset.vectorEncoding.value_or(Tileset::VectorEncoding::Mapbox)));
+    for (const auto& url : tileset.tiles) {
+        key += '\n';
+        key += url;
+    }
+    return key;
+}
+
+bool canStoreLayouts(const OverscaledTileID& id) {
+    const auto value = platform::Settings::getInstance().get(platform::EXPERIMENTAL_STORE_TILE_LAYOUTS);
+    const auto* enabled = value.getBool();
+    return enabled && *enabled && id.overscaledZ == id.canonical.z;
+}
+
+} // namespace
+
 VectorTile::VectorTile(const OverscaledTileID& id_,
                        std::string sourceID_,
                        const TileParameters& parameters_,
                        const Tileset& tileset,
                        TileObserver* observer_)
     : GeometryTile(id_, std::move(sourceID_), parameters_, observer_),
+      sharedDataKey(makeSharedDataKey(id_, tileset)),
+      storesLayouts(canStoreLayouts(id_)),
       loader(std::make_unique<TileLoader<VectorTile>>(*this, id_, parameters_, tileset)) {}
 
 VectorTile::~VectorTile() {}
@@ -25,6 +60,37 @@ void VectorTile::setUpdateParameters(const TileUpdateParameters& params) {
     loader->setUpdateParameters(params);
 }
 
+void VectorTile::setRequestRank(float rank) {
+    loader->setRequestRank(rank);
+}
+
+std::unique_ptr<const GeometryTileData> VectorTile::makeData(
+    const std::shared_ptr<const std::string>& data_,
+    const std::function<std::unique_ptr<const GeometryTileData>(std::shared_ptr<const std::string>)>& factory) {
+    if (!data_) {
+        return nullptr;
+    }
+    if (sharedDataKey.empty()) {
+        return factory(data_);
+    }
+    return GeometryTileDataCache::getInstance().get(sharedDataKey, id.canonical, data_, factory);
+}
+
+void VectorTile::setStoredLayout(std::shared_ptr<const std::string> layout, bool store) {
+    if (storesLayouts) {
+        storedLayout = std::move(layout);
+        storeLayout = store;
+    }
+}
+
+void VectorTile::setLoadedData(std::unique_ptr<const GeometryTileData> data_) {
+    GeometryTile::setData(std::move(data_), std::move(storedLayout), std::exchange(storeLayout, false));
+}
+
+void VectorTile::storeTriangulations(std::string triangulations) {
+    loader->storeLayout(std::move(triangulations));
+}
+
 void VectorTile::setMetadata(std::optional<Timestamp> modified_, std::optional<Timestamp> expires_) {
     modified = std::move(modified_);
     expires = std::move(expires_);
@@ -3,6 +3,8 @@
 #include <mbgl/tile/geometry_tile.hpp>
 #include <mbgl/tile/tile_loader.hpp>
 
+#include <functional>
+
 namespace mbgl {
 
 class Tileset;
@@ -19,11 +21,30 @@ public:
 
     void setNecessity(TileNecessity) final;
     void setUpdateParameters(const TileUpdateParameters&) final;
+    void setRequestRank(float) final;
     void setMetadata(std::optional<Timestamp> modified, std::optional<Timestamp> expires);
 
     virtual void setData(const std::shared_ptr<const std::string>&) = 0;
+    /// The layout the offline database returned with the data about to be set, see
+    /// EXPERIMENTAL_STORE_TILE_LAYOUTS. With `store`, that of the data is stored once laid out.
+    void setStoredLayout(std::shared_ptr<const std::string> layout, bool store);
 
 protected:
+    /// Wrap the data for sharing with other tiles of the same data if enabled, see `GeometryTileDataCache`
+    std::unique_ptr<const GeometryTileData> makeData(
+        const std::shared_ptr<const std::string>&,
+        const std::function<std::unique_ptr<const GeometryTileData>(std::shared_ptr<const std::string>)>& factory);
+    /// Sets the data along with the layout set before it
+    void setLoadedData(std::unique_ptr<const GeometryTileData>);
+    void storeTriangulations(std::string) override;
+
+    /// Identifies the source in the shared data cache, empty if sharing is disabled for the tile
+    const std::string sharedDataKey;
+    // Overscaled tiles lay out their parent's data, their layout isn't stored for it
+    const bool storesLayouts;
+    std::shared_ptr<const std::string> storedLayout;
+    bool storeLayout = false;
+
     // this needs to be explicitly deleted in the most-derived destructor
     // see `~VectorMVTTile`
     std::unique_ptr<TileLoader<VectorTile>> loader;
@@ -9,8 +9,12 @@
 #include <rapidjson/writer.h>
 
 #include <algorithm>
+#include <cstring>
+#include <functional>
 #include <mutex>
 #include <regex>
+#include <string_view>
+#include <type_traits>
 
 #ifdef __APPLE__
 #include <TargetConditionals.h>
@@ -44,82 +48,243 @@ constexpr auto ACTION_JOURNAL_DIRECTORY_NAME = "action_journal";
 constexpr auto ACTION_JOURNAL_FILE_NAME = "action_journal";
 constexpr auto ACTION_JOURNAL_FILE_EXTENSION = "log";
 
-class MapEnvironmentSnapshot {
-public:
-    MapEnvironmentSnapshot(const ActionJournal::Impl& journal)
-        : time(std::chrono::time_point_cast<std::chrono::milliseconds>(std::chrono::system_clock::now())),
-          clientName(journal.getMap().getClientOptions().name()),
-          clientVersion(journal.getMap().getClientOptions().version()),
-          styleName(journal.getMap().getStyle().getName()),
-          styleURL(journal.getMap().getStyle().getURL()) {}
-
-    const auto& getTime() const { return time; }
-    const auto& getClientName() const { return clientName; }
-    const auto& getClientVersion() const { return clientVersion; }
-    const auto& getStyleName() const { return styleName; }
-    const auto& getStyleURL() const { return styleURL; }
-
-protected:
-    const std::chrono::time_point<std::chrono::system_clock, std::chrono::milliseconds> time;
-    const std::string clientName;
-    const std::string clientVersion;
-    const std::string styleName;
-    const std::string styleURL;
+namespace {
+
+// The binary encoding of an event: its size, sequence number, name and time, and its fields. Names and keys are
+// string literals, stored as pointers, the events are decoded by the process that encoded them.
+enum class FieldType : uint8_t {
+    Int,
+    Double,
+    String,
+    StaticString,
+    StringArray,
 };
 
-class ActionJournalEvent {
-public:
-    ActionJournalEvent(const rapidjson::GenericStringRef<char>& name, const MapEnvironmentSnapshot& env)
-        : json(rapidjson::kObjectType),
-          eventJson(rapidjson::kObjectType) {
-        json.AddMember("name", name, json.GetAllocator());
-        json.AddMember("time", iso8601(env.getTime()), json.GetAllocator());
+using RecordSize = uint32_t;
+using RecordSequence = uint64_t;
 
-        if (!env.getClientName().empty()) {
-            json.AddMember("clientName", env.getClientName(), json.GetAllocator());
-        }
+// Marks the records holding a change of the environment, rather than an event
+constexpr auto ENVIRONMENT_RECORD_NAME = "environment";
 
-        if (!env.getClientVersion().empty()) {
-            json.AddMember("clientVersion", env.getClientVersion(), json.GetAllocator());
-        }
+template <typename T>
+void write(std::string& buffer, const T& value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
 
-        if (!env.getStyleName().empty()) {
-            json.AddMember("styleName", env.getStyleName(), json.GetAllocator());
-        }
+void writeString(std::string& buffer, std::string_view value) {
+    write(buffer, static_cast<uint32_t>(value.size()));
+    buffer.append(value);
+}
 
-        if (!env.getStyleURL().empty()) {
-            json.AddMember("styleURL", env.getStyleURL(), json.GetAllocator());
-        }
+class RecordReader {
+public:
+    explicit RecordReader(std::string_view data_)
+        : data(data_) {}
+
+    bool empty() const { return data.empty(); }
+
+    template <typename T>
+    T read() {
+        T value;
+        assert(data.size() >= sizeof(T));
+        std::memcpy(&value, data.data(), sizeof(T));
+        data.remove_prefix(sizeof(T));
+        return value;
     }
 
-    ~ActionJournalEvent() = default;
+    std::string readString() {
+        const auto size = read<uint32_t>();
+        std::string value{data.substr(0, size)};
+        data.remove_prefix(size);
+        return value;
+    }
+
+private:
+    std::string_view data;
+};
+
+} // namespace
+
+/// An event being encoded, into a buffer the calling thread reuses
+class ActionJournalRecord {
+public:
+    explicit ActionJournalRecord(const char* name)
+        : buffer(scratch()) {
+        buffer.clear();
+        write(buffer, RecordSize{0});
+        write(buffer, RecordSequence{0});
+        write(buffer, name);
+        write(buffer,
+              static_cast<int64_t>(
+                  std::chrono::time_point_cast<std::chrono::milliseconds>(std::chrono::system_clock::now())
+                      .time_since_epoch()
+                      .count()));
+    }
 
     template <typename T>
-    ActionJournalEvent& addEvent(const rapidjson::GenericStringRef<char>& key, const T& value) {
-        eventJson.AddMember(key, value, json.GetAllocator());
+        requires std::is_arithmetic_v<T>
+    ActionJournalRecord& addEvent(const char* key, T value) {
+        addKey(key, std::is_floating_point_v<T> ? FieldType::Double : FieldType::Int);
+        if constexpr (std::is_floating_point_v<T>) {
+            write(buffer, static_cast<double>(value));
+        } else {
+            write(buffer, static_cast<int64_t>(value));
+        }
         return *this;
     }
 
-    ActionJournalEvent& addEventStringArray(const rapidjson::GenericStringRef<char>& key,
-                                            const std::vector<std::string>& value) {
-        rapidjson::Value arrayJson(rapidjson::kArrayType);
+    ActionJournalRecord& addEvent(const char* key, std::string_view value) {
+        addKey(key, FieldType::String);
+        writeString(buffer, value);
+        return *this;
+    }
 
+    ActionJournalRecord& addEventStringArray(const char* key, const std::vector<std::string>& value) {
+        addKey(key, FieldType::StringArray);
+        write(buffer, static_cast<uint32_t>(value.size()));
         for (const auto& elem : value) {
-            rapidjson::Value elemJson(rapidjson::kStringType);
-            elemJson.SetString(elem.c_str(), static_cast<rapidjson::SizeType>(elem.size()));
-            arrayJson.PushBack(elemJson, json.GetAllocator());
+            writeString(buffer, elem);
         }
-
-        eventJson.AddMember(key, arrayJson, json.GetAllocator());
         return *this;
     }
 
     template <typename T>
-    ActionJournalEvent& addEventEnum(const rapidjson::GenericStringRef<char>& key, const T& value) {
-        eventJson.AddMember(key, rapidjson::StringRef(Enum<T>::toString(value)), json.GetAllocator());
+    ActionJournalRecord& addEventEnum(const char* key, const T& value) {
+        addKey(key, FieldType::StaticString);
+        write(buffer, Enum<T>::toString(value));
         return *this;
     }
 
+    /// The encoded record, valid until the next record is started on this thread
+    std::string_view finish(RecordSequence sequence) {
+        const auto size = static_cast<RecordSize>(buffer.size());
+        std::memcpy(buffer.data(), &size, sizeof(size));
+        std::memcpy(buffer.data() + sizeof(size), &sequence, sizeof(sequence));
+        return buffer;
+    }
+
+private:
+    static std::string& scratch() {
+        thread_local std::string buffer;
+        return buffer;
+    }
+
+    void addKey(const char* key, FieldType type) {
+        write(buffer, key);
+        write(buffer, type);
+    }
+
+    std::string& buffer;
+};
+
+/// Events waiting to be written, in a ring filled by one thread and emptied by the scheduler
+class ActionJournal::Impl::ThreadBuffer {
+public:
+    explicit ThreadBuffer(std::size_t capacity)
+        : data(std::max<std::size_t>(capacity, 1)) {}
+
+    bool write(std::string_view record) {
+        const auto writePos = head.load(std::memory_order_relaxed);
+        if (data.size() - (writePos - tail.load(std::memory_order_acquire)) < record.size()) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        const auto offset = writePos % data.size();
+        const auto first = std::min(record.size(), data.size() - offset);
+        std::memcpy(data.data() + offset, record.data(), first);
+        std::memcpy(data.data(), record.data() + first, record.size() - first);
+        head.store(writePos + record.size(), std::memory_order_release);
+        return true;
+    }
+
+    /// Appends the events written so far to `out`
+    void read(std::string& out) {
+        const auto readPos = tail.load(std::memory_order_relaxed);
+        const auto size = head.load(std::memory_order_acquire) - readPos;
+        const auto offset = readPos % data.size();
+        const auto first = std::min(size, data.size() - offset);
+        out.append(data.data() + offset, first);
+        out.append(data.data(), size - first);
+        tail.store(readPos + size, std::memory_order_release);
+    }
+
+    std::atomic<uint64_t> dropped{0};
+    // The events read by the drain in progress, scheduler only
+    std::string drained;
+
+private:
+    std::vector<char> data;
+    std::atomic<std::size_t> head{0};
+    std::atomic<std::size_t> tail{0};
+};
+
+namespace {
+
+std::atomic<uint64_t> nextJournalID{0};
+
+class ActionJournalEvent {
+public:
+    ActionJournalEvent(const char* name,
+                       std::chrono::time_point<std::chrono::system_clock, std::chrono::milliseconds> time,
+                       const std::string& clientName,
+                       const std::string& clientVersion,
+                       const std::string& styleName,
+                       const std::string& styleURL)
+        : json(rapidjson::kObjectType),
+          eventJson(rapidjson::kObjectType) {
+        json.AddMember("name", rapidjson::StringRef(name), json.GetAllocator());
+        json.AddMember("time", iso8601(time), json.GetAllocator());
+
+        if (!clientName.empty()) {
+            json.AddMember("clientName", clientName, json.GetAllocator());
+        }
+
+        if (!clientVersion.empty()) {
+            json.AddMember("clientVersion", clientVersion, json.GetAllocator());
+        }
+
+        if (!styleName.empty()) {
+            json.AddMember("styleName", styleName, json.GetAllocator());
+        }
+
+        if (!styleURL.empty()) {
+            json.AddMember("styleURL", styleURL, json.GetAllocator());
+        }
+    }
+
+    void addFields(RecordReader& reader) {
+        auto& allocator = json.GetAllocator();
+        while (!reader.empty()) {
+            const auto key = rapidjson::StringRef(reader.read<const char*>());
+            switch (reader.read<FieldType>()) {
+                case FieldType::Int:
+                    eventJson.AddMember(key, reader.read<int64_t>(), allocator);
+                    break;
+                case FieldType::Double:
+                    eventJson.AddMember(key, reader.read<double>(), allocator);
+                    break;
+                case FieldType::String: {
+                    rapidjson::Value stringJson(reader.readString(), allocator);
+                    eventJson.AddMember(key, stringJson, allocator);
+                    break;
+                }
+                case FieldType::StaticString:
+                    eventJson.AddMember(key, rapidjson::StringRef(reader.read<const char*>()), allocator);
+                    break;
+                case FieldType::StringArray: {
+                    rapidjson::Value arrayJson(rapidjson::kArrayType);
+                    for (auto count = reader.read<uint32_t>(); count > 0; --count) {
+                        rapidjson::Value elemJson(reader.readString(), allocator);
+                        arrayJson.PushBack(elemJson, allocator);
+                    }
+                    eventJson.AddMember(key, arrayJson, allocator);
+                    break;
+                }
+            }
+        }
+    }
+
     std::string toString() {
         if (!eventJson.ObjectEmpty()) {
             json.AddMember("event", eventJson, json.GetAllocator());
@@ -137,10 +302,24 @@ public:
     rapidjson::Value eventJson;
 };
 
+std::string errorMessage(std::exception_ptr error) {
+    if (error) {
+        try {
+            std::rethrow_exception(error);
+        } catch (const std::exception& e) {
+            return e.what();
+        }
+    }
+    return {};
+}
+
+} // namespace
+
 ActionJournal::Impl::Impl(const Map& map_, const ActionJournalOptions& options_)
     : map(map_),
       options(options_),
       scheduler(Scheduler::GetSequenced()),
+      id(nextJournalID++),
       renderingInfoReportTime(options.renderingStatsReportInterval()) {
     assert(!options.path().empty());
     assert(options.logFileSize() > 0);
@@ -235,6 +414,9 @@ void ActionJournal::Impl::clearLog() {
 }
 
 void ActionJournal::Impl::flush() {
+    if (!drainScheduled.exchange(true)) {
+        scheduler->schedule([this] { drain(); });
+    }
     scheduler->waitForEmpty();
 }
 
@@ -243,33 +425,27 @@ std::string ActionJournal::Impl::getDirectoryName() {
 }
 
 void ActionJournal::Impl::onCameraWillChange(CameraChangeMode mode) {
-    scheduler->schedule([=, this, env = MapEnvironmentSnapshot(*this)]() {
-        log(ActionJournalEvent("onCameraWillChange", env).addEvent("cameraMode", static_cast<int>(mode)));
-    });
+    log(ActionJournalRecord("onCameraWillChange").addEvent("cameraMode", static_cast<int>(mode)));
 }
 
 void ActionJournal::Impl::onCameraDidChange(CameraChangeMode mode) {
-    scheduler->schedule([=, this, env = MapEnvironmentSnapshot(*this)]() {
-        log(ActionJournalEvent("onCameraDidChange", env).addEvent("cameraMode", static_cast<int>(mode)));
-    });
+    log(ActionJournalRecord("onCameraDidChange").addEvent("cameraMode", static_cast<int>(mode)));
 }
 
 void ActionJournal::Impl::onWillStartLoadingMap() {
-    scheduler->schedule(
-        [=, this, env = MapEnvironmentSnapshot(*this)]() { log(ActionJournalEvent("onWillStartLoadingMap", env)); });
+    updateEnvironment();
+    log(ActionJournalRecord("onWillStartLoadingMap"));
 }
 
 void ActionJournal::Impl::onDidFinishLoadingMap() {
-    scheduler->schedule(
-        [=, this, env = MapEnvironmentSnapshot(*this)]() { log(ActionJournalEvent("onDidFinishLoadingMap", env)); });
+    log(ActionJournalRecord("onDidFinishLoadingMap"));
 }
 
 void ActionJournal::Impl::onDidFailLoadingMap(MapLoadError error, const std::string& errorStr) {
-    scheduler->schedule([=, this, env = MapEnvironmentSnapshot(*this)]() {
-        log(ActionJournalEvent("onDidFailLoadingMap", env)
-                .addEvent("error", errorStr)
-                .addEvent("code", static_cast<int>(error)));
-    });
+    updateEnvironment();
+    log(ActionJournalRecord("onDidFailLoadingMap")
+            .addEvent("error", errorStr)
+            .addEvent("code", static_cast<int>(error)));
 }
 
 void ActionJournal::Impl::onDidFinishRenderingFrame(const RenderFrameStatus& frame) {
@@ -278,6 +454,22 @@ void ActionJournal::Impl::onDidFinishRenderingFrame(const RenderFrameStatus& fra
     double elapsedTime = currentFrameTime - previousFrameTime;
     previousFrameTime = currentFrameTime;
 
+    if (options.frameTimingEvents()) {
+        const auto camera = map.getCameraOptions();
+        const auto center = camera.center.value_or(LatLng());
+        log(ActionJournalRecord("onFrameTiming")
+                .addEvent("frameInterval", elapsedTime)
+                .addEvent("encodingTime", frame.renderingStats.encodingTime)
+                .addEvent("renderingTime", frame.renderingStats.renderingTime)
+                .addEvent("placementTime", frame.renderingStats.placementTime)
+                .addEvent("needsRepaint", static_cast<int>(frame.needsRepaint))
+                .addEvent("longitude", center.longitude())
+                .addEvent("latitude", center.latitude())
+                .addEvent("zoom", camera.zoom.value_or(0.0))
+                .addEvent("bearing", camera.bearing.value_or(0.0))
+                .addEvent("pitch", camera.pitch.value_or(0.0)));
+    }
+
     // update rendering stats
     renderingStats.encodingMin = std::min(renderingStats.encodingMin, frame.renderingStats.encodingTime);
 
@@ -303,196 +495,297 @@ void ActionJournal::Impl::onDidFinishRenderingFrame(const RenderFrameStatus& fra
         return;
     }
 
-    scheduler->schedule([=, this, env = MapEnvironmentSnapshot(*this), stats = std::move(renderingStats)]() {
-        log(ActionJournalEvent("renderingStats", env)
-                .addEvent("encodingMin", stats.encodingMin)
-                .addEvent("encodingMax", stats.encodingMax)
-                .addEvent("encodingAvg", stats.encodingTotal / stats.frameCount)
-                .addEvent("renderingMin", stats.renderingMin)
-                .addEvent("renderingMax", stats.renderingMax)
-                .addEvent("renderingAvg", stats.renderingTotal / stats.frameCount));
-    });
+    log(ActionJournalRecord("renderingStats")
+            .addEvent("encodingMin", renderingStats.encodingMin)
+            .addEvent("encodingMax", renderingStats.encodingMax)
+            .addEvent("encodingAvg", renderingStats.encodingTotal / renderingStats.frameCount)
+            .addEvent("renderingMin", renderingStats.renderingMin)
+            .addEvent("renderingMax", renderingStats.renderingMax)
+            .addEvent("renderingAvg", renderingStats.renderingTotal / renderingStats.frameCount));
 
     renderingStats = {};
 }
 
 void ActionJournal::Impl::onWillStartRenderingMap() {
-    scheduler->schedule(
-        [=, this, env = MapEnvironmentSnapshot(*this)]() { log(ActionJournalEvent("onWillStartRenderingMap", env)); });
+    log(ActionJournalRecord("onWillStartRenderingMap"));
 }
 
 void ActionJournal::Impl::onDidFinishRenderingMap(RenderMode) {
-    scheduler->schedule(
-        [=, this, env = MapEnvironmentSnapshot(*this)]() { log(ActionJournalEvent("onDidFinishRenderingMap", env)); });
+    log(ActionJournalRecord("onDidFinishRenderingMap"));
 }
 
 void ActionJournal::Impl::onDidFinishLoadingStyle() {
-    scheduler->schedule(
-        [=, this, env = MapEnvironmentSnapshot(*this)]() { log(ActionJournalEvent("onDidFinishLoadingStyle", env)); });
+    updateEnvironment();
+    log(ActionJournalRecord("onDidFinishLoadingStyle"));
 }
 
 void ActionJournal::Impl::onSourceChanged(style::Source& source) {
-    scheduler->schedule([=, this, env = MapEnvironmentSnapshot(*this), type = source.getType(), id = source.getID()]() {
-        log(ActionJournalEvent("onSourceChanged", env).addEventEnum("type", type).addEvent("id", id));
-    });
+    log(ActionJournalRecord("onSourceChanged").addEventEnum("type", source.getType()).addEvent("id", source.getID()));
 }
 
 void ActionJournal::Impl::onDidBecomeIdle() {
-    scheduler->schedule(
-        [=, this, env = MapEnvironmentSnapshot(*this)]() { log(ActionJournalEvent("onDidBecomeIdle", env)); });
+    log(ActionJournalRecord("onDidBecomeIdle"));
 }
 
-void ActionJournal::Impl::onStyleImageMissing(const std::string& id) {
-    scheduler->schedule([=, this, env = MapEnvironmentSnapshot(*this)]() {
-        log(ActionJournalEvent("onStyleImageMissing", env).addEvent("id", id));
-    });
+void ActionJournal::Impl::onStyleImageMissing(const std::string& id_) {
+    log(ActionJournalRecord("onStyleImageMissing").addEvent("id", id_));
 }
 
 void ActionJournal::Impl::onRegisterShaders(gfx::ShaderRegistry&) {
-    scheduler->schedule(
-        [=, this, env = MapEnvironmentSnapshot(*this)]() { log(ActionJournalEvent("onRegisterShaders", env)); });
+    log(ActionJournalRecord("onRegisterShaders"));
 }
 
-void ActionJournal::Impl::onPreCompileShader(shaders::BuiltIn id, gfx::Backend::Type backend, const std::string&) {
-    scheduler->schedule([=, this, env = MapEnvironmentSnapshot(*this)]() {
-        log(ActionJournalEvent("onPreCompileShader", env)
-                .addEventEnum("shader", id)
-                .addEvent("backend", static_cast<int>(backend)));
-    });
+void ActionJournal::Impl::onPreCompileShader(shaders::BuiltIn shaderID,
+                                             gfx::Backend::Type backend,
+                                             const std::string&) {
+    log(ActionJournalRecord("onPreCompileShader")
+            .addEventEnum("shader", shaderID)
+            .addEvent("backend", static_cast<int>(backend)));
 }
 
-void ActionJournal::Impl::onPostCompileShader(shaders::BuiltIn id, gfx::Backend::Type backend, const std::string&) {
-    scheduler->schedule([=, this, env = MapEnvironmentSnapshot(*this)]() {
-        log(ActionJournalEvent("onPostCompileShader", env)
-                .addEventEnum("shader", id)
-                .addEvent("backend", static_cast<int>(backend)));
-    });
+void ActionJournal::Impl::onPostCompileShader(shaders::BuiltIn shaderID,
+                                              gfx::Backend::Type backend,
+                                              const std::string&) {
+    log(ActionJournalRecord("onPostCompileShader")
+            .addEventEnum("shader", shaderID)
+            .addEvent("backend", static_cast<int>(backend)));
 }
 
-void ActionJournal::Impl::onShaderCompileFailed(shaders::BuiltIn id,
+void ActionJournal::Impl::onShaderCompileFailed(shaders::BuiltIn shaderID,
                                                 gfx::Backend::Type backend,
                                                 const std::string& defines) {
-    scheduler->schedule([=, this, env = MapEnvironmentSnapshot(*this)]() {
-        log(ActionJournalEvent("onShaderCompileFailed", env)
-                .addEventEnum("shader", id)
-                .addEvent("backend", static_cast<int>(backend))
-                .addEvent("defines", defines));
-    });
+    log(ActionJournalRecord("onShaderCompileFailed")
+            .addEventEnum("shader", shaderID)
+            .addEvent("backend", static_cast<int>(backend))
+            .addEvent("defines", defines));
 }
 
 void ActionJournal::Impl::onGlyphsLoaded(const FontStack& fonts, const GlyphRange& range) {
-    scheduler->schedule([=, this, env = MapEnvironmentSnapshot(*this)]() {
-        log(ActionJournalEvent("onGlyphsLoaded", env)
-                .addEventStringArray("fonts", fonts)
-                .addEvent("rangeStart", range.first)
-                .addEvent("rangeEnd", range.second));
-    });
+    log(ActionJournalRecord("onGlyphsLoaded")
+            .addEventStringArray("fonts", fonts)
+            .addEvent("rangeStart", range.first)
+            .addEvent("rangeEnd", range.second));
 }
 
 void ActionJournal::Impl::onGlyphsError(const FontStack& fonts, const GlyphRange& range, std::exception_ptr error) {
-    scheduler->schedule([=, this, env = MapEnvironmentSnapshot(*this)]() {
-        ActionJournalEvent event("onGlyphsError", env);
-
-        event.addEventStringArray("fonts", fonts);
-        event.addEvent("rangeStart", range.first);
-        event.addEvent("rangeEnd", range.second);
-
-        if (error) {
-            try {
-                std::rethrow_exception(error);
-            } catch (const std::exception& e) {
-                event.addEvent("error", std::string(e.what()));
-            }
-        }
+    ActionJournalRecord event("onGlyphsError");
 
-        log(event);
-    });
+    event.addEventStringArray("fonts", fonts);
+    event.addEvent("rangeStart", range.first);
+    event.addEvent("rangeEnd", range.second);
+
+    if (error) {
+        event.addEvent("error", errorMessage(error));
+    }
+
+    log(event);
 }
 
 void ActionJournal::Impl::onGlyphsRequested(const FontStack& fonts, const GlyphRange& range) {
-    scheduler->schedule([=, this, env = MapEnvironmentSnapshot(*this)]() {
-        log(ActionJournalEvent("onGlyphsRequested", env)
-                .addEventStringArray("fonts", fonts)
-                .addEvent("rangeStart", range.first)
-                .addEvent("rangeEnd", range.second));
-    });
-}
-
-void ActionJournal::Impl::onTileAction(TileOperation op, const OverscaledTileID& id, const std::string& sourceID) {
-    scheduler->schedule([=, this, env = MapEnvironmentSnapshot(*this)]() {
-        log(ActionJournalEvent("onTileAction", env)
-                .addEventEnum("action", op)
-                .addEvent("tileX", id.canonical.x)
-                .addEvent("tileY", id.canonical.y)
-                .addEvent("tileZ", id.canonical.z)
-                .addEvent("overscaledZ", id.overscaledZ)
-                .addEvent("sourceID", sourceID));
-    });
+    log(ActionJournalRecord("onGlyphsRequested")
+            .addEventStringArray("fonts", fonts)
+            .addEvent("rangeStart", range.first)
+            .addEvent("rangeEnd", range.second));
+}
+
+void ActionJournal::Impl::onTileAction(TileOperation op, const OverscaledTileID& tileID, const std::string& sourceID) {
+    log(ActionJournalRecord("onTileAction")
+            .addEventEnum("action", op)
+            .addEvent("tileX", tileID.canonical.x)
+            .addEvent("tileY", tileID.canonical.y)
+            .addEvent("tileZ", tileID.canonical.z)
+            .addEvent("overscaledZ", tileID.overscaledZ)
+            .addEvent("sourceID", sourceID));
 }
 
 void ActionJournal::Impl::onSpriteLoaded(const std::optional<style::Sprite>& sprite) {
-    scheduler->schedule([=, this, env = MapEnvironmentSnapshot(*this)]() {
-        ActionJournalEvent event("onSpriteLoaded", *this);
+    ActionJournalRecord event("onSpriteLoaded");
 
-        if (sprite) {
-            event.addEvent("id", sprite.value().id);
-            event.addEvent("url", sprite.value().spriteURL);
-        }
+    if (sprite) {
+        event.addEvent("id", sprite.value().id);
+        event.addEvent("url", sprite.value().spriteURL);
+    }
 
-        log(event);
-    });
+    log(event);
 }
 
 void ActionJournal::Impl::onSpriteError(const std::optional<style::Sprite>& sprite, std::exception_ptr error) {
-    scheduler->schedule([=, this, env = MapEnvironmentSnapshot(*this)]() {
-        ActionJournalEvent event("onSpriteError", env);
+    ActionJournalRecord event("onSpriteError");
 
-        if (sprite) {
-            event.addEvent("id", sprite.value().id);
-            event.addEvent("url", sprite.value().spriteURL);
-        }
+    if (sprite) {
+        event.addEvent("id", sprite.value().id);
+        event.addEvent("url", sprite.value().spriteURL);
+    }
 
-        if (error) {
-            try {
-                std::rethrow_exception(error);
-            } catch (const std::exception& e) {
-                event.addEvent("error", std::string(e.what()));
-            }
-        }
+    if (error) {
+        event.addEvent("error", errorMessage(error));
+    }
 
-        log(event);
-    });
+    log(event);
 }
 
 void ActionJournal::Impl::onSpriteRequested(const std::optional<style::Sprite>& sprite) {
-    scheduler->schedule([=, this, env = MapEnvironmentSnapshot(*this)]() {
-        ActionJournalEvent event("onSpriteRequested", env);
+    ActionJournalRecord event("onSpriteRequested");
 
-        if (sprite) {
-            event.addEvent("id", sprite.value().id);
-            event.addEvent("url", sprite.value().spriteURL);
-        }
+    if (sprite) {
+        event.addEvent("id", sprite.value().id);
+        event.addEvent("url", sprite.value().spriteURL);
+    }
 
-        log(event);
-    });
+    log(event);
 }
 
 void ActionJournal::Impl::onMapCreate() {
-    scheduler->schedule(
-        [=, this, env = MapEnvironmentSnapshot(*this)]() { log(ActionJournalEvent("onMapCreate", env)); });
+    updateEnvironment();
+    log(ActionJournalRecord("onMapCreate"));
 }
 
 void ActionJournal::Impl::onMapDestroy() {
-    scheduler->schedule(
-        [=, this, env = MapEnvironmentSnapshot(*this)]() { log(ActionJournalEvent("onMapDestroy", env)); });
+    log(ActionJournalRecord("onMapDestroy"));
+}
+
+void ActionJournal::Impl::log(ActionJournalRecord& value) {
+    // Numbered in the order the events are raised, across threads, for the drain to restore
+    getThreadBuffer().write(value.finish(nextSequence.fetch_add(1, std::memory_order_relaxed)));
+
+    // Pairs with the fence in `drain`: either the drain sees the event, or the event sees the drain is done
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!drainScheduled.load(std::memory_order_relaxed) && !drainScheduled.exchange(true)) {
+        scheduler->schedule([this] { drain(); });
+    }
 }
 
-void ActionJournal::Impl::log(ActionJournalEvent& value) {
-    logToFile(value.toString());
+void ActionJournal::Impl::log(ActionJournalRecord&& value) {
+    log(value);
 }
 
-void ActionJournal::Impl::log(ActionJournalEvent&& value) {
-    logToFile(value.toString());
+void ActionJournal::Impl::updateEnvironment() {
+    const auto clientOptions = map.getClientOptions();
+    Environment current{
+        clientOptions.name(), clientOptions.version(), map.getStyle().getName(), map.getStyle().getURL()};
+    if (current == recordedEnvironment) {
+        return;
+    }
+
+    recordedEnvironment = std::move(current);
+    log(ActionJournalRecord(ENVIRONMENT_RECORD_NAME)
+            .addEvent("clientName", recordedEnvironment.clientName)
+            .addEvent("clientVersion", recordedEnvironment.clientVersion)
+            .addEvent("styleName", recordedEnvironment.styleName)
+            .addEvent("styleURL", recordedEnvironment.styleURL));
+}
+
+ActionJournal::Impl::ThreadBuffer& ActionJournal::Impl::getThreadBuffer() {
+    // The buffers of the journals the thread logged to, most threads only ever log to one
+    thread_local std::vector<std::pair<uint64_t, std::shared_ptr<ThreadBuffer>>> threadBuffers;
+
+    for (const auto& [journalID, buffer] : threadBuffers) {
+        if (journalID == id) {
+            return *buffer;
+        }
+    }
+
+    // drop those of the journals destroyed since
+    std::erase_if(threadBuffers, [](const auto& entry) { return entry.second.use_count() == 1; });
+
+    auto buffer = std::make_shared<ThreadBuffer>(options.bufferSize());
+    {
+        std::scoped_lock lock(buffersMutex);
+        buffers.push_back(buffer);
+    }
+    threadBuffers.emplace_back(id, buffer);
+    return *buffer;
+}
+
+void ActionJournal::Impl::drain() {
+    drainScheduled = false;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    std::vector<std::shared_ptr<ThreadBuffer>> current;
+    {
+        std::scoped_lock lock(buffersMutex);
+        current = buffers;
+    }
+
+    // The events of each buffer are in order, merge them by sequence number so that the log follows the order
+    // the events were raised in, and each event is logged with the environment recorded before it
+    uint64_t dropped = 0;
+    std::vector<std::string_view> pending;
+    pending.reserve(current.size());
+    for (const auto& buffer : current) {
+        dropped += buffer->dropped.exchange(0, std::memory_order_relaxed);
+
+        buffer->drained.clear();
+        buffer->read(buffer->drained);
+        pending.emplace_back(buffer->drained);
+    }
+
+    const auto sequenceOf = [](std::string_view records) {
+        RecordSequence sequence;
+        std::memcpy(&sequence, records.data() + sizeof(RecordSize), sizeof(sequence));
+        return sequence;
+    };
+    // Min-heap of the next sequence number of each buffer with events left
+    std::vector<std::pair<RecordSequence, std::size_t>> heads;
+    for (std::size_t i = 0; i < pending.size(); ++i) {
+        if (!pending[i].empty()) {
+            heads.emplace_back(sequenceOf(pending[i]), i);
+        }
+    }
+    std::ranges::make_heap(heads, std::greater{});
+
+    while (!heads.empty()) {
+        std::ranges::pop_heap(heads, std::greater{});
+        auto& records = pending[heads.back().second];
+
+        RecordSize size;
+        std::memcpy(&size, records.data(), sizeof(size));
+        RecordReader reader(records.substr(sizeof(size), size - sizeof(size)));
+        records.remove_prefix(size);
+        if (records.empty()) {
+            heads.pop_back();
+        } else {
+            heads.back().first = sequenceOf(records);
+            std::ranges::push_heap(heads, std::greater{});
+        }
+
+        reader.read<RecordSequence>();
+        const auto name = reader.read<const char*>();
+        const auto time = std::chrono::time_point<std::chrono::system_clock, std::chrono::milliseconds>(
+            std::chrono::milliseconds(reader.read<int64_t>()));
+
+        if (name == ENVIRONMENT_RECORD_NAME) {
+            for (auto* field : {&environment.clientName,
+                                &environment.clientVersion,
+                                &environment.styleName,
+                                &environment.styleURL}) {
+                reader.read<const char*>();
+                reader.read<FieldType>();
+                *field = reader.readString();
+            }
+            continue;
+        }
+
+        ActionJournalEvent event(name,
+                                 time,
+                                 environment.clientName,
+                                 environment.clientVersion,
+                                 environment.styleName,
+                                 environment.styleURL);
+        event.addFields(reader);
+        logToFile(event.toString());
+    }
+
+    {
+        std::scoped_lock lock(fileMutex);
+        if (currentFile) {
+            currentFile.flush();
+        }
+    }
+
+    if (dropped > 0) {
+        Log::Warning(Event::General, "Action Journal buffer full, " + std::to_string(dropped) + " events dropped");
+    }
 }
 
 std::string ActionJournal::Impl::getFilepath(uint32_t fileIndex) const {
@@ -618,7 +911,6 @@ void ActionJournal::Impl::logToFile(const std::string& value) {
     }
 
     currentFile << value << "\n";
-    currentFile.flush();
 }
 
 } // namespace util
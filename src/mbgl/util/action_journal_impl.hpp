@@ -4,7 +4,13 @@
 #include <mbgl/util/action_journal_options.hpp>
 #include <mbgl/map/map_observer.hpp>
 
+#include <atomic>
+#include <cstdint>
 #include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
 
 namespace mbgl {
 
@@ -13,7 +19,7 @@ class Scheduler;
 
 namespace util {
 
-class ActionJournalEvent;
+class ActionJournalRecord;
 
 class ActionJournal::Impl : public MapObserver {
 public:
@@ -60,8 +66,28 @@ public:
     void onMapDestroy();
 
 protected:
-    void log(ActionJournalEvent& value);
-    void log(ActionJournalEvent&& value);
+    class ThreadBuffer;
+
+    /// The map and client names the events are logged with
+    struct Environment {
+        std::string clientName;
+        std::string clientVersion;
+        std::string styleName;
+        std::string styleURL;
+
+        bool operator==(const Environment&) const = default;
+    };
+
+    // Copies the event into the buffer of the calling thread, and schedules the buffers to be written out unless
+    // that's already pending
+    void log(ActionJournalRecord& value);
+    void log(ActionJournalRecord&& value);
+    // Records the environment if it changed since the last time, only called on the map thread, from the events
+    // that come along with a change of style
+    void updateEnvironment();
+    ThreadBuffer& getThreadBuffer();
+    // Decodes the events in the buffers and writes them to the log file, on the scheduler
+    void drain();
 
     // file operations
 
@@ -86,7 +112,7 @@ protected:
     bool openFile(uint32_t fileIndex, bool truncate = false);
     // check if the current file can log `size` bytes of info and roll files if needed
     bool prepareFile(size_t size);
-    // log string to file and flush
+    // log string to file, `currentFile` is flushed once a batch of events is written
     void logToFile(const std::string& value);
 
 protected:
@@ -96,6 +122,16 @@ protected:
 
     const std::shared_ptr<Scheduler> scheduler;
 
+    // event buffers, one for each thread the events are raised on
+    const std::uint64_t id;
+    std::mutex buffersMutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    std::atomic<bool> drainScheduled{false};
+    std::atomic<uint64_t> nextSequence{0};
+    Environment recordedEnvironment;
+    // scheduler only, the environment of the events as they are written out in sequence
+    Environment environment;
+
     // log file
     std::mutex fileMutex;
     std::fstream currentFile;
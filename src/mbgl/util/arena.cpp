@@ -0,0 +1,97 @@
+#include <mbgl/util/arena.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+
+namespace mbgl {
+namespace util {
+
+namespace {
+
+thread_local Arena* currentArena = nullptr;
+
+constexpr std::size_t maxBlockSize = 1024 * 1024;
+
+} // namespace
+
+Arena::Arena(std::size_t initialBlockSize)
+    : nextBlockSize(std::max<std::size_t>(initialBlockSize, alignof(std::max_align_t))) {}
+
+Arena::~Arena() {
+    assert(currentArena != this);
+}
+
+void* Arena::allocate(std::size_t size, std::size_t alignment) {
+    assert(alignment != 0 && (alignment & (alignment - 1)) == 0);
+    assert(alignment <= alignof(std::max_align_t));
+
+    if (!blocks.empty()) {
+        auto& block = blocks.back();
+        const std::size_t offset = (used + alignment - 1) & ~(alignment - 1);
+        if (offset <= block.size && size <= block.size - offset) {
+            used = offset + size;
+            return block.data.get() + offset;
+        }
+    }
+
+    // Allocations larger than a block get one of their own. Array new aligns to max_align_t.
+    const std::size_t blockSize = std::max(size, nextBlockSize);
+    nextBlockSize = std::min(nextBlockSize * 2, maxBlockSize);
+    blocks.push_back({std::unique_ptr<std::byte[]>(new std::byte[blockSize]), blockSize});
+    used = size;
+    return blocks.back().data.get();
+}
+
+void Arena::deallocate(void* ptr, std::size_t size) noexcept {
+    if (blocks.empty() || !ptr) {
+        return;
+    }
+    auto* const data = blocks.back().data.get();
+    auto* const bytes = static_cast<std::byte*>(ptr);
+    if (std::less_equal<const std::byte*>()(data, bytes) && bytes + size == data + used) {
+        used = static_cast<std::size_t>(bytes - data);
+    }
+}
+
+void Arena::reset() noexcept {
+    // Blocks of single oversized allocations aren't worth keeping around
+    auto largest = blocks.end();
+    for (auto it = blocks.begin(); it != blocks.end(); ++it) {
+        if (it->size <= maxBlockSize && (largest == blocks.end() || it->size > largest->size)) {
+            largest = it;
+        }
+    }
+    if (largest != blocks.end()) {
+        auto kept = std::move(*largest);
+        blocks.clear();
+        blocks.push_back(std::move(kept));
+    } else {
+        blocks.clear();
+    }
+    used = 0;
+}
+
+std::size_t Arena::capacity() const noexcept {
+    std::size_t total = 0;
+    for (const auto& block : blocks) {
+        total += block.size;
+    }
+    return total;
+}
+
+Arena* Arena::current() noexcept {
+    return currentArena;
+}
+
+Arena::Scope::Scope(Arena& arena) noexcept
+    : previous(currentArena) {
+    currentArena = &arena;
+}
+
+Arena::Scope::~Scope() {
+    currentArena = previous;
+}
+
+} // namespace util
+} // namespace mbgl
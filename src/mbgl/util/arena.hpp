@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace mbgl {
+namespace util {
+
+/**
+    Bump allocator for short-lived data, released all at once when the arena is destroyed.
+
+    Allocations are carved out of blocks that grow geometrically, so building many small
+    temporaries costs a pointer increment each rather than a trip through the global heap, which
+    worker threads otherwise contend on. Freeing is a no-op except for the most recent
+    allocation, which lets a vector that is built and dropped in turn reuse the same memory.
+    An arena is only ever used by one thread at a time.
+ */
+class Arena {
+public:
+    explicit Arena(std::size_t initialBlockSize = 16 * 1024);
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+    ~Arena();
+
+    /// `alignment` must be a power of two no larger than `alignof(std::max_align_t)`
+    void* allocate(std::size_t size, std::size_t alignment);
+    void deallocate(void* ptr, std::size_t size) noexcept;
+
+    /// Releases all allocations at once, keeping the largest regular block to serve the next ones
+    void reset() noexcept;
+
+    /// Bytes held by the arena, used or not
+    std::size_t capacity() const noexcept;
+
+    /// The arena of the innermost `Scope` alive on the calling thread, if any
+    static Arena* current() noexcept;
+
+    /// Makes `arena` the current arena of the calling thread for the lifetime of the scope.
+    class Scope {
+    public:
+        explicit Scope(Arena& arena) noexcept;
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+        ~Scope();
+
+    private:
+        Arena* previous;
+    };
+
+private:
+    struct Block {
+        std::unique_ptr<std::byte[]> data;
+        std::size_t size;
+    };
+
+    std::vector<Block> blocks;
+    // Bytes used in the last block
+    std::size_t used = 0;
+    std::size_t nextBlockSize;
+};
+
+/**
+    Allocates from the arena that was current when the allocator was created, or from the heap
+    when there was none. Containers using it must not outlive that arena.
+ */
+template <class T>
+class ArenaAllocator {
+public:
+    using value_type = T;
+
+    ArenaAllocator() noexcept
+        : arena(Arena::current()) {}
+    template <class U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept
+        : arena(other.arena) {}
+
+    T* allocate(std::size_t n) {
+        if (arena) {
+            return static_cast<T*>(arena->allocate(n * sizeof(T), alignof(T)));
+        }
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* ptr, std::size_t n) noexcept {
+        if (arena) {
+            arena->deallocate(ptr, n * sizeof(T));
+        } else {
+            std::allocator<T>().deallocate(ptr, n);
+        }
+    }
+
+    template <class U>
+    bool operator==(const ArenaAllocator<U>& other) const noexcept {
+        return arena == other.arena;
+    }
+
+private:
+    template <class U>
+    friend class ArenaAllocator;
+
+    Arena* arena;
+};
+
+template <class T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+} // namespace util
+} // namespace mbgl
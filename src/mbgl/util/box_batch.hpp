@@ -0,0 +1,117 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Define MLN_BOX_BATCH_SCALAR to build the portable code path only
+#if defined(MLN_BOX_BATCH_SCALAR)
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MLN_BOX_BATCH_SSE2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define MLN_BOX_BATCH_NEON 1
+#endif
+
+namespace mbgl {
+namespace util {
+
+/**
+    Axis-aligned boxes stored as a structure of arrays, so that intersection tests against a
+    query box run four boxes at a time with SSE2 or NEON, or one at a time where neither is
+    available. Each box carries an id that's reported back on a hit.
+
+    Boxes and the query are closed intervals: touching edges intersect.
+ */
+class BoxBatch {
+public:
+    void push_back(uint32_t id, float minX, float minY, float maxX, float maxY) {
+        ids.push_back(id);
+        minXs.push_back(minX);
+        minYs.push_back(minY);
+        maxXs.push_back(maxX);
+        maxYs.push_back(maxY);
+    }
+
+    void reserve(std::size_t count) {
+        ids.reserve(count);
+        minXs.reserve(count);
+        minYs.reserve(count);
+        maxXs.reserve(count);
+        maxYs.reserve(count);
+    }
+
+    std::size_t size() const { return ids.size(); }
+    bool empty() const { return ids.empty(); }
+
+    uint32_t id(std::size_t i) const { return ids[i]; }
+
+    /// Approximate heap memory used
+    std::size_t bytes() const { return ids.capacity() * sizeof(uint32_t) + 4 * minXs.capacity() * sizeof(float); }
+
+    /// Calls `fn(id)` for every box intersecting the query, in insertion order, until it returns `true`.
+    /// Returns whether `fn` stopped the iteration.
+    template <typename Fn>
+    bool forEachIntersecting(float minX, float minY, float maxX, float maxY, Fn&& fn) const {
+        const std::size_t count = size();
+        std::size_t i = 0;
+#if defined(MLN_BOX_BATCH_SSE2)
+        const __m128 qMinX = _mm_set1_ps(minX);
+        const __m128 qMinY = _mm_set1_ps(minY);
+        const __m128 qMaxX = _mm_set1_ps(maxX);
+        const __m128 qMaxY = _mm_set1_ps(maxY);
+        for (; i + 4 <= count; i += 4) {
+            const __m128 hit = _mm_and_ps(
+                _mm_and_ps(_mm_cmple_ps(qMinX, _mm_loadu_ps(&maxXs[i])), _mm_cmple_ps(qMinY, _mm_loadu_ps(&maxYs[i]))),
+                _mm_and_ps(_mm_cmpge_ps(qMaxX, _mm_loadu_ps(&minXs[i])), _mm_cmpge_ps(qMaxY, _mm_loadu_ps(&minYs[i]))));
+            if (reportHits(i, static_cast<unsigned>(_mm_movemask_ps(hit)), fn)) {
+                return true;
+            }
+        }
+#elif defined(MLN_BOX_BATCH_NEON)
+        const float32x4_t qMinX = vdupq_n_f32(minX);
+        const float32x4_t qMinY = vdupq_n_f32(minY);
+        const float32x4_t qMaxX = vdupq_n_f32(maxX);
+        const float32x4_t qMaxY = vdupq_n_f32(maxY);
+        const uint32x4_t laneBits = {1, 2, 4, 8};
+        for (; i + 4 <= count; i += 4) {
+            const uint32x4_t hit = vandq_u32(
+                vandq_u32(vcleq_f32(qMinX, vld1q_f32(&maxXs[i])), vcleq_f32(qMinY, vld1q_f32(&maxYs[i]))),
+                vandq_u32(vcgeq_f32(qMaxX, vld1q_f32(&minXs[i])), vcgeq_f32(qMaxY, vld1q_f32(&minYs[i]))));
+            if (reportHits(i, vaddvq_u32(vandq_u32(hit, laneBits)), fn)) {
+                return true;
+            }
+        }
+#endif
+        for (; i < count; ++i) {
+            if (minX <= maxXs[i] && minY <= maxYs[i] && maxX >= minXs[i] && maxY >= minYs[i] && fn(ids[i])) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    template <typename Fn>
+    bool reportHits(std::size_t base, unsigned mask, Fn& fn) const {
+        while (mask) {
+            const auto lane = static_cast<std::size_t>(std::countr_zero(mask));
+            if (fn(ids[base + lane])) {
+                return true;
+            }
+            mask &= mask - 1;
+        }
+        return false;
+    }
+
+    std::vector<uint32_t> ids;
+    std::vector<float> minXs;
+    std::vector<float> minYs;
+    std::vector<float> maxXs;
+    std::vector<float> maxYs;
+};
+
+} // namespace util
+} // namespace mbgl
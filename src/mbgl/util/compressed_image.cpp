@@ -0,0 +1,94 @@
+#include <mbgl/util/compressed_image.hpp>
+
+#include <array>
+#include <cstring>
+#include <stdexcept>
+
+namespace mbgl {
+
+namespace {
+
+constexpr std::array<uint8_t, 12> ktxIdentifier = {
+    0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n'};
+constexpr uint32_t ktxEndianness = 0x04030201;
+
+// The header fields following the identifier
+struct KTXHeader {
+    uint32_t endianness;
+    uint32_t glType;
+    uint32_t glTypeSize;
+    uint32_t glFormat;
+    uint32_t glInternalFormat;
+    uint32_t glBaseInternalFormat;
+    uint32_t pixelWidth;
+    uint32_t pixelHeight;
+    uint32_t pixelDepth;
+    uint32_t numberOfArrayElements;
+    uint32_t numberOfFaces;
+    uint32_t numberOfMipmapLevels;
+    uint32_t bytesOfKeyValueData;
+};
+
+CompressedImageFormat formatFor(uint32_t glInternalFormat) {
+    switch (glInternalFormat) {
+        case 0x9274: // GL_COMPRESSED_RGB8_ETC2
+            return CompressedImageFormat::ETC2RGB8;
+        case 0x9278: // GL_COMPRESSED_RGBA8_ETC2_EAC
+            return CompressedImageFormat::ETC2RGBA8;
+        case 0x93B0: // GL_COMPRESSED_RGBA_ASTC_4x4_KHR
+            return CompressedImageFormat::ASTC4x4;
+        case 0x8E8C: // GL_COMPRESSED_RGBA_BPTC_UNORM
+            return CompressedImageFormat::BC7;
+        default:
+            throw std::runtime_error("unsupported KTX texture format " + std::to_string(glInternalFormat));
+    }
+}
+
+std::size_t blockBytes(CompressedImageFormat format) {
+    return format == CompressedImageFormat::ETC2RGB8 ? 8 : 16;
+}
+
+} // namespace
+
+bool isKTX(const std::string& data) {
+    return data.size() >= ktxIdentifier.size() &&
+           std::memcmp(data.data(), ktxIdentifier.data(), ktxIdentifier.size()) == 0;
+}
+
+CompressedImage decodeKTX(const std::string& data) {
+    if (!isKTX(data) || data.size() < ktxIdentifier.size() + sizeof(KTXHeader)) {
+        throw std::runtime_error("invalid KTX file");
+    }
+
+    KTXHeader header;
+    std::memcpy(&header, data.data() + ktxIdentifier.size(), sizeof(header));
+    if (header.endianness != ktxEndianness) {
+        throw std::runtime_error("KTX files of the other endianness aren't supported");
+    }
+    if (header.glType != 0 || header.pixelDepth != 0 || header.numberOfArrayElements != 0 ||
+        header.numberOfFaces != 1 || header.pixelWidth == 0 || header.pixelHeight == 0) {
+        throw std::runtime_error("KTX file isn't a single compressed 2D texture");
+    }
+
+    CompressedImage image;
+    image.format = formatFor(header.glInternalFormat);
+    image.size = {header.pixelWidth, header.pixelHeight};
+
+    std::size_t offset = ktxIdentifier.size() + sizeof(header) + header.bytesOfKeyValueData;
+    uint32_t imageSize = 0;
+    if (offset + sizeof(imageSize) > data.size()) {
+        throw std::runtime_error("truncated KTX file");
+    }
+    std::memcpy(&imageSize, data.data() + offset, sizeof(imageSize));
+    offset += sizeof(imageSize);
+
+    const std::size_t expectedSize = static_cast<std::size_t>((image.size.width + 3) / 4) *
+                                     ((image.size.height + 3) / 4) * blockBytes(image.format);
+    if (imageSize != expectedSize || offset + imageSize > data.size()) {
+        throw std::runtime_error("truncated KTX file");
+    }
+    image.data = data.substr(offset, imageSize);
+    return image;
+}
+
+} // namespace mbgl
@@ -1,6 +1,8 @@
 #include <mbgl/util/geometry_util.hpp>
 
 #include <algorithm>
+#include <cmath>
+#include <type_traits>
 
 namespace mbgl {
 
@@ -140,6 +142,123 @@ bool lineStringWithinPolygons(const LineString<T>& line, const MultiPolygon<T>&
     return false;
 }
 
+template <typename T>
+PolygonEdgeIndex<T>::PolygonEdgeIndex(const Polygon<T>& polygon) {
+    if constexpr (std::is_floating_point_v<T>) {
+        bbox = DefaultDistanceBBox;
+    } else {
+        bbox = DefaultWithinBBox;
+    }
+    std::size_t edgeCount = 0;
+    for (const auto& ring : polygon) {
+        for (const auto& p : ring) {
+            updateBBox(bbox, p);
+        }
+        edgeCount += ring.empty() ? 0 : ring.size() - 1;
+    }
+
+    // Around eight edges a band, more for the edges spanning several bands
+    constexpr std::size_t maxBandCount = 1024;
+    bandCount = std::clamp<std::size_t>(edgeCount / 8, 1, maxBandCount);
+
+    // Counting sort of the edges into the bands they span
+    bandOffsets.assign(bandCount + 1, 0);
+    const auto eachEdge = [&polygon](const auto& fn) {
+        for (const auto& ring : polygon) {
+            for (std::size_t i = 0; i + 1 < ring.size(); ++i) {
+                fn(ring[i], ring[i + 1]);
+            }
+        }
+    };
+    eachEdge([this](const Point<T>& p1, const Point<T>& p2) {
+        for (auto i = band(std::min(p1.y, p2.y)), last = band(std::max(p1.y, p2.y)); i <= last; ++i) {
+            bandOffsets[i + 1]++;
+        }
+    });
+    for (std::size_t i = 0; i < bandCount; ++i) {
+        bandOffsets[i + 1] += bandOffsets[i];
+    }
+    edges.resize(bandOffsets.back());
+    auto next = bandOffsets;
+    eachEdge([this, &next](const Point<T>& p1, const Point<T>& p2) {
+        for (auto i = band(std::min(p1.y, p2.y)), last = band(std::max(p1.y, p2.y)); i <= last; ++i) {
+            edges[next[i]++] = {p1, p2};
+        }
+    });
+}
+
+template <typename T>
+double PolygonEdgeIndex<T>::getBandHeight() const noexcept {
+    const double height = static_cast<double>(bbox[3]) - static_cast<double>(bbox[1]);
+    return height > 0 ? height / static_cast<double>(bandCount) : 0;
+}
+
+template <typename T>
+std::size_t PolygonEdgeIndex<T>::band(T y) const noexcept {
+    // Monotonic in y, which is all the lookups rely on
+    const double height = static_cast<double>(bbox[3]) - static_cast<double>(bbox[1]);
+    if (!(height > 0)) {
+        return 0;
+    }
+    const double offset = (static_cast<double>(y) - static_cast<double>(bbox[1])) / height;
+    const double i = std::floor(offset * static_cast<double>(bandCount));
+    return static_cast<std::size_t>(std::clamp(i, 0.0, static_cast<double>(bandCount - 1)));
+}
+
+template <typename T>
+bool PolygonEdgeIndex<T>::contains(const Point<T>& point, bool trueOnBoundary) const noexcept {
+    // Both the boundary and the ray tests need an edge spanning the y of the point
+    if (point.y < bbox[1] || point.y > bbox[3]) {
+        return false;
+    }
+    const auto i = band(point.y);
+    bool within = false;
+    for (auto edge = edges.begin() + bandOffsets[i], end = edges.begin() + bandOffsets[i + 1]; edge != end; ++edge) {
+        if (pointOnBoundary(point, edge->p1, edge->p2)) return trueOnBoundary;
+        if (rayIntersect(point, edge->p1, edge->p2)) {
+            within = !within;
+        }
+    }
+    return within;
+}
+
+template <typename T>
+bool PolygonEdgeIndex<T>::contains(const LineString<T>& line) const noexcept {
+    const auto length = line.size();
+    for (std::size_t i = 0; i < length; ++i) {
+        if (!contains(line[i])) {
+            return false;
+        }
+    }
+    for (std::size_t i = 0; i + 1 < length; ++i) {
+        if (intersects(line[i], line[i + 1])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename T>
+bool PolygonEdgeIndex<T>::intersects(const Point<T>& p1, const Point<T>& p2) const noexcept {
+    const auto minY = std::min(p1.y, p2.y);
+    const auto maxY = std::max(p1.y, p2.y);
+    if (maxY < bbox[1] || minY > bbox[3]) {
+        return false;
+    }
+    for (auto i = band(minY), last = band(maxY); i <= last; ++i) {
+        for (auto edge = edges.begin() + bandOffsets[i], end = edges.begin() + bandOffsets[i + 1]; edge != end;
+             ++edge) {
+            if (segmentIntersectSegment(p1, p2, edge->p1, edge->p2)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+template class PolygonEdgeIndex<int64_t>;
+template class PolygonEdgeIndex<double>;
+
 template void updateBBox(GeometryBBox<int64_t>& bbox, const Point<int64_t>& p) noexcept;
 template bool boxWithinBox(const GeometryBBox<int64_t>& bbox1, const GeometryBBox<int64_t>& bbox2) noexcept;
 template bool segmentIntersectSegment(const Point<int64_t>& a,
@@ -2,6 +2,7 @@
 
 #include <array>
 #include <limits>
+#include <vector>
 #include <mbgl/util/geometry.hpp>
 
 namespace mbgl {
@@ -50,4 +51,52 @@ bool lineStringWithinPolygon(const LineString<T>& line, const Polygon<T>& polygo
 template <typename T>
 bool lineStringWithinPolygons(const LineString<T>& line, const MultiPolygon<T>& polygons) noexcept;
 
+// The edges of a polygon bucketed into horizontal bands of equal height. An edge can only touch a point
+// or a segment within the bands their y ranges share, so the tests below visit those bands only, and
+// answer like the functions above do over the whole polygon.
+template <typename T>
+class PolygonEdgeIndex {
+public:
+    explicit PolygonEdgeIndex(const Polygon<T>& polygon);
+
+    // bbox of all the points of the polygon
+    const GeometryBBox<T>& getBBox() const noexcept { return bbox; }
+
+    // same as pointWithinPolygon
+    bool contains(const Point<T>& point, bool trueOnBoundary = false) const noexcept;
+
+    // same as lineStringWithinPolygon
+    bool contains(const LineString<T>& line) const noexcept;
+
+    // same as lineIntersectPolygon
+    bool intersects(const Point<T>& p1, const Point<T>& p2) const noexcept;
+
+    std::size_t getBandCount() const noexcept { return bandCount; }
+    double getBandHeight() const noexcept;
+
+    // band of y, the first or the last one for the y outside the bbox
+    std::size_t band(T y) const noexcept;
+
+    // calls fn(p1, p2) for each edge spanning the band
+    template <typename Fn>
+    void eachEdge(std::size_t i, Fn&& fn) const {
+        for (auto edge = edges.begin() + bandOffsets[i], end = edges.begin() + bandOffsets[i + 1]; edge != end;
+             ++edge) {
+            fn(edge->p1, edge->p2);
+        }
+    }
+
+private:
+    struct Edge {
+        Point<T> p1;
+        Point<T> p2;
+    };
+
+    GeometryBBox<T> bbox;
+    std::size_t bandCount = 1;
+    // edges of band i are edges[bandOffsets[i]] up to edges[bandOffsets[i + 1]]
+    std::vector<std::size_t> bandOffsets;
+    std::vector<Edge> edges;
+};
+
 } // namespace mbgl
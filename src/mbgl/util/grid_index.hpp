@@ -3,6 +3,7 @@
 #include <mapbox/geometry/point.hpp>
 #include <mapbox/geometry/box.hpp>
 #include <mbgl/math/minmax.hpp>
+#include <mbgl/util/box_batch.hpp>
 
 #include <cassert>
 #include <cmath>
@@ -51,6 +52,9 @@ constexpr bool operator!=(circle<T> const& lhs, circle<T> const& rhs) {
  at least one cell. As long as the geometries are relatively
  uniformly distributed across the plane, this greatly reduces
  the number of comparisons necessary.
+ Boxes are copied into every cell they touch as a structure of
+ arrays, so a cell's boxes are tested against a query in batches,
+ see `util::BoxBatch`.
 */
 
 template <class T>
@@ -75,6 +79,9 @@ public:
 
     bool empty() const;
 
+    /// Approximate heap memory used by the elements and cells
+    std::size_t bytes() const;
+
 private:
     bool noIntersection(const BBox& queryBBox) const;
     bool completeIntersection(const BBox& queryBBox) const;
@@ -86,7 +93,6 @@ private:
     std::size_t convertToXCellCoord(float x) const;
     std::size_t convertToYCellCoord(float y) const;
 
-    bool boxesCollide(const BBox&, const BBox&) const;
     bool circlesCollide(const BCircle&, const BCircle&) const;
     bool circleAndBoxCollide(const BCircle&, const BBox&) const;
 
@@ -103,7 +109,7 @@ private:
     std::vector<std::pair<T, BBox>> boxElements;
     std::vector<std::pair<T, BCircle>> circleElements;
 
-    std::vector<std::vector<uint32_t>> boxCells;
+    std::vector<util::BoxBatch> boxCells;
     std::vector<std::vector<uint32_t>> circleCells;
 };
 
@@ -137,7 +143,7 @@ void GridIndex<T>::insert(T&& t, const BBox& bbox) {
             if (estimatedElementsPerCell && cell.empty()) {
                 cell.reserve(estimatedElementsPerCell);
             }
-            cell.push_back(uid);
+            cell.push_back(uid, bbox.min.x, bbox.min.y, bbox.max.x, bbox.max.y);
         }
     }
 
@@ -263,19 +269,16 @@ void GridIndex<T>::query(const BBox& queryBBox, std::function<bool(const T&, con
     for (x = cx1; x <= cx2; ++x) {
         for (y = cy1; y <= cy2; ++y) {
             cellIndex = xCellCount * y + x;
-            // Look up other boxes
-            for (auto uid : boxCells[cellIndex]) {
-                if (!seenBoxes.contains(uid)) {
-                    seenBoxes.insert(uid);
-
-                    auto& pair = boxElements.at(uid);
-                    auto& bbox = pair.second;
-                    if (boxesCollide(queryBBox, bbox)) {
-                        if (resultFn(pair.first, bbox)) {
-                            return;
+            // Look up other boxes, a box spanning several cells only gets reported for the first one
+            if (boxCells[cellIndex].forEachIntersecting(
+                    queryBBox.min.x, queryBBox.min.y, queryBBox.max.x, queryBBox.max.y, [&](uint32_t uid) {
+                        if (!seenBoxes.insert(uid).second) {
+                            return false;
                         }
-                    }
-                }
+                        const auto& pair = boxElements[uid];
+                        return resultFn(pair.first, pair.second);
+                    })) {
+                return;
             }
 
             // Look up circles
@@ -328,19 +331,21 @@ void GridIndex<T>::query(const BCircle& queryBCircle, std::function<bool(const T
     for (x = cx1; x <= cx2; ++x) {
         for (y = cy1; y <= cy2; ++y) {
             cellIndex = xCellCount * y + x;
-            // Look up boxes
-            for (auto uid : boxCells[cellIndex]) {
-                if (!seenBoxes.contains(uid)) {
-                    seenBoxes.insert(uid);
-
-                    auto& pair = boxElements.at(uid);
-                    auto& bbox = pair.second;
-                    if (circleAndBoxCollide(queryBCircle, bbox)) {
-                        if (resultFn(pair.first, bbox)) {
-                            return;
-                        }
-                    }
-                }
+            // Look up boxes. Their intersection with the circle's bounding box, padded so that rounding
+            // can't make it reject anything, is a cheap superset of the exact test.
+            if (boxCells[cellIndex].forEachIntersecting(queryBBox.min.x - 1,
+                                                        queryBBox.min.y - 1,
+                                                        queryBBox.max.x + 1,
+                                                        queryBBox.max.y + 1,
+                                                        [&](uint32_t uid) {
+                                                            const auto& pair = boxElements[uid];
+                                                            if (!circleAndBoxCollide(queryBCircle, pair.second) ||
+                                                                !seenBoxes.insert(uid).second) {
+                                                                return false;
+                                                            }
+                                                            return resultFn(pair.first, pair.second);
+                                                        })) {
+                return;
             }
 
             // Look up other circles
@@ -371,12 +376,6 @@ std::size_t GridIndex<T>::convertToYCellCoord(const float y) const {
     return static_cast<size_t>(util::max(0.0, util::min(yCellCount - 1.0, std::floor(y * yScale))));
 }
 
-template <class T>
-bool GridIndex<T>::boxesCollide(const BBox& first, const BBox& second) const {
-    return first.min.x <= second.max.x && first.min.y <= second.max.y && first.max.x >= second.min.x &&
-           first.max.y >= second.min.y;
-}
-
 template <class T>
 bool GridIndex<T>::circlesCollide(const BCircle& first, const BCircle& second) const {
     auto dx = second.center.x - first.center.x;
@@ -413,4 +412,19 @@ bool GridIndex<T>::empty() const {
     return boxElements.empty() && circleElements.empty();
 }
 
+template <class T>
+std::size_t GridIndex<T>::bytes() const {
+    std::size_t result = boxElements.capacity() * sizeof(typename decltype(boxElements)::value_type) +
+                         circleElements.capacity() * sizeof(typename decltype(circleElements)::value_type) +
+                         boxCells.capacity() * sizeof(util::BoxBatch) +
+                         circleCells.capacity() * sizeof(std::vector<uint32_t>);
+    for (const auto& cell : boxCells) {
+        result += cell.bytes();
+    }
+    for (const auto& cell : circleCells) {
+        result += cell.capacity() * sizeof(uint32_t);
+    }
+    return result;
+}
+
 } // namespace mbgl
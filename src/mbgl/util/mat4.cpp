@@ -24,6 +24,20 @@
 
 #include <cmath>
 
+// The vector kernels multiply and add in the order of the scalar code, without fused multiply-adds, so that the
+// results are the same to the bit
+#if defined(MLN_MAT4_SCALAR)
+#elif defined(__AVX__)
+#include <immintrin.h>
+#define MLN_MAT4_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MLN_MAT4_SSE2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define MLN_MAT4_NEON 1
+#endif
+
 namespace mbgl {
 
 namespace matrix {
@@ -341,6 +355,58 @@ void scale(mat4& out, const mat4& a, double x, double y, double z) {
 }
 
 void multiply(mat4& out, const mat4& a, const mat4& b) {
+#if defined(MLN_MAT4_AVX)
+    // Each column of the result is the columns of `a` weighted by a column of `b`. All of `a`, and the column of
+    // `b`, are read before the column is written, as `out` may be either.
+    const __m256d a0 = _mm256_loadu_pd(&a[0]);
+    const __m256d a1 = _mm256_loadu_pd(&a[4]);
+    const __m256d a2 = _mm256_loadu_pd(&a[8]);
+    const __m256d a3 = _mm256_loadu_pd(&a[12]);
+    for (std::size_t i = 0; i < 16; i += 4) {
+        const __m256d b0 = _mm256_set1_pd(b[i]);
+        const __m256d b1 = _mm256_set1_pd(b[i + 1]);
+        const __m256d b2 = _mm256_set1_pd(b[i + 2]);
+        const __m256d b3 = _mm256_set1_pd(b[i + 3]);
+        __m256d column = _mm256_add_pd(_mm256_mul_pd(b0, a0), _mm256_mul_pd(b1, a1));
+        column = _mm256_add_pd(column, _mm256_mul_pd(b2, a2));
+        column = _mm256_add_pd(column, _mm256_mul_pd(b3, a3));
+        _mm256_storeu_pd(&out[i], column);
+    }
+#elif defined(MLN_MAT4_SSE2)
+    __m128d columns[8];
+    for (std::size_t i = 0; i < 8; ++i) {
+        columns[i] = _mm_loadu_pd(&a[i * 2]);
+    }
+    for (std::size_t i = 0; i < 16; i += 4) {
+        const __m128d b0 = _mm_set1_pd(b[i]);
+        const __m128d b1 = _mm_set1_pd(b[i + 1]);
+        const __m128d b2 = _mm_set1_pd(b[i + 2]);
+        const __m128d b3 = _mm_set1_pd(b[i + 3]);
+        for (std::size_t half = 0; half < 2; ++half) {
+            __m128d column = _mm_add_pd(_mm_mul_pd(b0, columns[half]), _mm_mul_pd(b1, columns[2 + half]));
+            column = _mm_add_pd(column, _mm_mul_pd(b2, columns[4 + half]));
+            column = _mm_add_pd(column, _mm_mul_pd(b3, columns[6 + half]));
+            _mm_storeu_pd(&out[i + half * 2], column);
+        }
+    }
+#elif defined(MLN_MAT4_NEON)
+    float64x2_t columns[8];
+    for (std::size_t i = 0; i < 8; ++i) {
+        columns[i] = vld1q_f64(&a[i * 2]);
+    }
+    for (std::size_t i = 0; i < 16; i += 4) {
+        const float64x2_t b0 = vdupq_n_f64(b[i]);
+        const float64x2_t b1 = vdupq_n_f64(b[i + 1]);
+        const float64x2_t b2 = vdupq_n_f64(b[i + 2]);
+        const float64x2_t b3 = vdupq_n_f64(b[i + 3]);
+        for (std::size_t half = 0; half < 2; ++half) {
+            float64x2_t column = vaddq_f64(vmulq_f64(b0, columns[half]), vmulq_f64(b1, columns[2 + half]));
+            column = vaddq_f64(column, vmulq_f64(b2, columns[4 + half]));
+            column = vaddq_f64(column, vmulq_f64(b3, columns[6 + half]));
+            vst1q_f64(&out[i + half * 2], column);
+        }
+    }
+#else
     double a00 = a[0];
     double a01 = a[1];
     double a02 = a[2];
@@ -394,6 +460,7 @@ void multiply(mat4& out, const mat4& a, const mat4& b) {
     out[13] = b0 * a01 + b1 * a11 + b2 * a21 + b3 * a31;
     out[14] = b0 * a02 + b1 * a12 + b2 * a22 + b3 * a32;
     out[15] = b0 * a03 + b1 * a13 + b2 * a23 + b3 * a33;
+#endif
 }
 
 void transformMat4(vec4& out, const vec4& a, const mat4& m) {
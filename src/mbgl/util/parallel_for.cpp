@@ -0,0 +1,97 @@
+#include <mbgl/util/parallel_for.hpp>
+
+#include <mbgl/actor/scheduler.hpp>
+#include <mbgl/util/thread_pool.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+
+namespace mbgl {
+namespace util {
+
+namespace {
+
+struct ParallelForState {
+    ParallelForState(std::size_t count_, const std::function<void(std::size_t)>& fn_)
+        : count(count_),
+          fn(fn_) {}
+
+    // Returns once there is no index left to hand out
+    void run() {
+        for (auto i = next.fetch_add(1, std::memory_order_relaxed); i < count;
+             i = next.fetch_add(1, std::memory_order_relaxed)) {
+            if (!failed.load(std::memory_order_relaxed)) {
+                try {
+                    fn(i);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(finishedLock);
+                    if (!error) {
+                        error = std::current_exception();
+                    }
+                    failed.store(true, std::memory_order_relaxed);
+                }
+            }
+            // Counted either way, so that the caller always wakes up
+            if (done.fetch_add(1, std::memory_order_acq_rel) + 1 == count) {
+                std::lock_guard<std::mutex> lock(finishedLock);
+                finished.notify_all();
+            }
+        }
+    }
+
+    const std::size_t count;
+    // Only called for indices below `count`, which are all taken before the caller returns, so
+    // helpers that start late never touch it once the referenced function is gone.
+    const std::function<void(std::size_t)>& fn;
+    std::atomic<std::size_t> next{0};
+    std::atomic<std::size_t> done{0};
+    // Set once a call threw, the remaining indices are then only counted
+    std::atomic<bool> failed{false};
+    std::mutex finishedLock;
+    std::condition_variable finished;
+    // The first exception thrown, guarded by `finishedLock`
+    std::exception_ptr error;
+};
+
+} // namespace
+
+void parallelFor(Scheduler& scheduler,
+                 std::size_t count,
+                 std::size_t maxHelpers,
+                 const std::function<void(std::size_t)>& fn) {
+    if (count == 0) {
+        return;
+    }
+
+    const auto helpers = std::min(maxHelpers, count - 1);
+    if (helpers == 0) {
+        for (std::size_t i = 0; i < count; ++i) {
+            fn(i);
+        }
+        return;
+    }
+
+    auto state = std::make_shared<ParallelForState>(count, fn);
+    for (std::size_t i = 0; i < helpers; ++i) {
+        scheduler.schedule([state] { state->run(); });
+    }
+
+    state->run();
+
+    std::unique_lock<std::mutex> lock(state->finishedLock);
+    state->finished.wait(lock, [&] { return state->done.load(std::memory_order_acquire) == count; });
+    if (state->error) {
+        std::rethrow_exception(state->error);
+    }
+}
+
+void parallelFor(std::size_t count, const std::function<void(std::size_t)>& fn) {
+    parallelFor(*Scheduler::GetBackground(), count, ThreadPool::threadCount - 1, fn);
+}
+
+} // namespace util
+} // namespace mbgl
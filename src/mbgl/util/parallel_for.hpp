@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+namespace mbgl {
+
+class Scheduler;
+
+namespace util {
+
+/**
+    Calls `fn(i)` for every `i` in `[0, count)` and returns once all the calls have finished.
+
+    The calling thread takes part in the work, so this makes progress even when the scheduler's
+    threads are busy, and up to `maxHelpers` additional tasks are scheduled on `scheduler` to
+    share it. Indices are handed out one at a time, in no particular order; `fn` must be safe to
+    call concurrently. If a call throws, the indices not yet started are skipped, and the first
+    exception is rethrown on the calling thread once every call in progress has finished.
+ */
+void parallelFor(Scheduler& scheduler,
+                 std::size_t count,
+                 std::size_t maxHelpers,
+                 const std::function<void(std::size_t)>& fn);
+
+/**
+    `parallelFor` on `Scheduler::GetBackground()`, with a helper for each thread of the pool but one, which
+    the caller is often running on or waiting for. More helpers would only queue up behind each other.
+ */
+void parallelFor(std::size_t count, const std::function<void(std::size_t)>& fn);
+
+} // namespace util
+} // namespace mbgl
@@ -1,10 +1,79 @@
 #include <mbgl/util/premultiply.hpp>
 
+#include <algorithm>
 #include <cmath>
 
+// Define MLN_PREMULTIPLY_SCALAR to build the portable code path only
+#if defined(MLN_PREMULTIPLY_SCALAR)
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MLN_PREMULTIPLY_SSE2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define MLN_PREMULTIPLY_NEON 1
+#endif
+
 namespace mbgl {
 namespace util {
 
+// The vector paths compute (c * a + 127) / 255 as (x + (x >> 8)) >> 8 with x = c * a + 128, which
+// is exact for all 8 bit inputs.
+void premultiply(uint8_t* rgba, std::size_t pixels) {
+    std::size_t i = 0;
+#if defined(MLN_PREMULTIPLY_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i bias = _mm_set1_epi16(128);
+    const __m128i opaque = _mm_set1_epi32(static_cast<int>(0xFF000000));
+    // Two pixels as 16 bit lanes; the alpha lanes are multiplied by 255, which leaves them unchanged
+    const __m128i colorLanes = _mm_set_epi16(0, -1, -1, -1, 0, -1, -1, -1);
+    const __m128i alphaLanes = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+    const auto multiply = [&](__m128i pixels16) {
+        __m128i alpha = _mm_shufflelo_epi16(pixels16, _MM_SHUFFLE(3, 3, 3, 3));
+        alpha = _mm_shufflehi_epi16(alpha, _MM_SHUFFLE(3, 3, 3, 3));
+        alpha = _mm_or_si128(_mm_and_si128(alpha, colorLanes), alphaLanes);
+        const __m128i x = _mm_add_epi16(_mm_mullo_epi16(pixels16, alpha), bias);
+        return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+    };
+    for (; i + 4 <= pixels; i += 4) {
+        auto* data = reinterpret_cast<__m128i*>(rgba + i * 4);
+        const __m128i pixels8 = _mm_loadu_si128(data);
+        // Opaque pixels, most of them in raster tiles, are left as they are
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(pixels8, opaque), opaque)) == 0xFFFF) {
+            continue;
+        }
+        const __m128i low = multiply(_mm_unpacklo_epi8(pixels8, zero));
+        const __m128i high = multiply(_mm_unpackhi_epi8(pixels8, zero));
+        _mm_storeu_si128(data, _mm_packus_epi16(low, high));
+    }
+#elif defined(MLN_PREMULTIPLY_NEON)
+    for (; i + 8 <= pixels; i += 8) {
+        uint8_t* data = rgba + i * 4;
+        uint8x8x4_t channels = vld4_u8(data);
+        if (vminv_u8(channels.val[3]) == 255) {
+            continue;
+        }
+        const auto multiply = [&](uint8x8_t color) {
+            const uint16x8_t x = vmull_u8(color, channels.val[3]);
+            return vraddhn_u16(x, vrshrq_n_u16(x, 8));
+        };
+        channels.val[0] = multiply(channels.val[0]);
+        channels.val[1] = multiply(channels.val[1]);
+        channels.val[2] = multiply(channels.val[2]);
+        vst4_u8(data, channels);
+    }
+#endif
+    for (; i < pixels; ++i) {
+        uint8_t* pixel = rgba + i * 4;
+        uint8_t& r = pixel[0];
+        uint8_t& g = pixel[1];
+        uint8_t& b = pixel[2];
+        uint8_t& a = pixel[3];
+        r = (r * a + 127) / 255;
+        g = (g * a + 127) / 255;
+        b = (b * a + 127) / 255;
+    }
+}
+
 PremultipliedImage premultiply(UnassociatedImage&& src) {
     PremultipliedImage dst;
 
@@ -12,20 +81,88 @@ PremultipliedImage premultiply(UnassociatedImage&& src) {
     src.size = {0, 0};
     dst.data = std::move(src.data);
 
-    uint8_t* data = dst.data.get();
-    for (size_t i = 0; i < dst.bytes(); i += 4) {
-        uint8_t& r = data[i + 0];
-        uint8_t& g = data[i + 1];
-        uint8_t& b = data[i + 2];
-        uint8_t& a = data[i + 3];
-        r = (r * a + 127) / 255;
-        g = (g * a + 127) / 255;
-        b = (b * a + 127) / 255;
-    }
+    premultiply(dst.data.get(), dst.size.area());
 
     return dst;
 }
 
+// The vector paths divide in single precision, which represents the dividends exactly and is close
+// enough for truncating the quotients to give the integer results.
+void unpremultiply(uint8_t* rgba, std::size_t pixels) {
+    std::size_t i = 0;
+#if defined(MLN_PREMULTIPLY_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i opaque = _mm_set1_epi32(static_cast<int>(0xFF000000));
+    const __m128i channelMask = _mm_set1_epi32(0xFF);
+    const __m128 maxValue = _mm_set1_ps(255.0f);
+    for (; i + 4 <= pixels; i += 4) {
+        auto* data = reinterpret_cast<__m128i*>(rgba + i * 4);
+        const __m128i pixels8 = _mm_loadu_si128(data);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(pixels8, opaque), opaque)) == 0xFFFF) {
+            continue;
+        }
+        const __m128i alpha32 = _mm_srli_epi32(pixels8, 24);
+        const __m128 alpha = _mm_cvtepi32_ps(alpha32);
+        const __m128 halfAlpha = _mm_cvtepi32_ps(_mm_srli_epi32(pixels8, 25));
+        __m128i result = _mm_slli_epi32(alpha32, 24);
+        for (int shift = 0; shift < 24; shift += 8) {
+            const __m128i color = _mm_and_si128(_mm_srl_epi32(pixels8, _mm_cvtsi32_si128(shift)), channelMask);
+            const __m128 dividend = _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(color), maxValue), halfAlpha);
+            const __m128i quotient = _mm_cvttps_epi32(_mm_min_ps(_mm_div_ps(dividend, alpha), maxValue));
+            result = _mm_or_si128(result, _mm_sll_epi32(quotient, _mm_cvtsi32_si128(shift)));
+        }
+        // Pixels without alpha are left as they are
+        const __m128i transparent = _mm_cmpeq_epi32(alpha32, zero);
+        _mm_storeu_si128(data,
+                         _mm_or_si128(_mm_and_si128(transparent, pixels8), _mm_andnot_si128(transparent, result)));
+    }
+#elif defined(MLN_PREMULTIPLY_NEON)
+    const float32x4_t maxValue = vdupq_n_f32(255.0f);
+    for (; i + 8 <= pixels; i += 8) {
+        uint8_t* data = rgba + i * 4;
+        uint8x8x4_t channels = vld4_u8(data);
+        if (vminv_u8(channels.val[3]) == 255) {
+            continue;
+        }
+        const uint16x8_t alpha16 = vmovl_u8(channels.val[3]);
+        const uint16x8_t halfAlpha16 = vshrq_n_u16(alpha16, 1);
+        const float32x4_t alphaLow = vcvtq_f32_u32(vmovl_u16(vget_low_u16(alpha16)));
+        const float32x4_t alphaHigh = vcvtq_f32_u32(vmovl_high_u16(alpha16));
+        const float32x4_t halfAlphaLow = vcvtq_f32_u32(vmovl_u16(vget_low_u16(halfAlpha16)));
+        const float32x4_t halfAlphaHigh = vcvtq_f32_u32(vmovl_high_u16(halfAlpha16));
+        // Pixels without alpha are left as they are
+        const uint8x8_t transparent = vceq_u8(channels.val[3], vdup_n_u8(0));
+        const auto divide = [&](uint8x8_t color) {
+            const uint16x8_t color16 = vmovl_u8(color);
+            const float32x4_t low = vdivq_f32(
+                vmlaq_f32(halfAlphaLow, vcvtq_f32_u32(vmovl_u16(vget_low_u16(color16))), maxValue), alphaLow);
+            const float32x4_t high = vdivq_f32(
+                vmlaq_f32(halfAlphaHigh, vcvtq_f32_u32(vmovl_high_u16(color16)), maxValue), alphaHigh);
+            const uint16x8_t quotient = vcombine_u16(vmovn_u32(vcvtq_u32_f32(vminq_f32(low, maxValue))),
+                                                     vmovn_u32(vcvtq_u32_f32(vminq_f32(high, maxValue))));
+            return vbsl_u8(transparent, color, vmovn_u16(quotient));
+        };
+        channels.val[0] = divide(channels.val[0]);
+        channels.val[1] = divide(channels.val[1]);
+        channels.val[2] = divide(channels.val[2]);
+        vst4_u8(data, channels);
+    }
+#endif
+    for (; i < pixels; ++i) {
+        uint8_t* pixel = rgba + i * 4;
+        uint8_t& r = pixel[0];
+        uint8_t& g = pixel[1];
+        uint8_t& b = pixel[2];
+        uint8_t& a = pixel[3];
+        if (a) {
+            // Colors brighter than their alpha aren't valid premultiplied colors, clamp them
+            r = static_cast<uint8_t>(std::min((255 * r + (a / 2)) / a, 255));
+            g = static_cast<uint8_t>(std::min((255 * g + (a / 2)) / a, 255));
+            b = static_cast<uint8_t>(std::min((255 * b + (a / 2)) / a, 255));
+        }
+    }
+}
+
 UnassociatedImage unpremultiply(PremultipliedImage&& src) {
     UnassociatedImage dst;
 
@@ -33,18 +170,7 @@ UnassociatedImage unpremultiply(PremultipliedImage&& src) {
     src.size = {0, 0};
     dst.data = std::move(src.data);
 
-    uint8_t* data = dst.data.get();
-    for (size_t i = 0; i < dst.bytes(); i += 4) {
-        uint8_t& r = data[i + 0];
-        uint8_t& g = data[i + 1];
-        uint8_t& b = data[i + 2];
-        uint8_t& a = data[i + 3];
-        if (a) {
-            r = static_cast<uint8_t>((255 * r + (a / 2)) / a);
-            g = static_cast<uint8_t>((255 * g + (a / 2)) / a);
-            b = static_cast<uint8_t>((255 * b + (a / 2)) / a);
-        }
-    }
+    unpremultiply(dst.data.get(), dst.size.area());
 
     return dst;
 }
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace mbgl {
+namespace util {
+
+/**
+    A lock-free queue of objects waiting to be destroyed.
+
+    Any thread may add batches with `push`, which is a single compare-and-swap. Any thread may
+    destroy everything queued so far with `drain`, which takes the whole list with one exchange.
+    Since nodes are never removed individually there's no ABA hazard, and no need for hazard
+    pointers or epochs to protect them.
+ */
+template <typename T>
+class ReclamationQueue {
+public:
+    using Batch = std::vector<std::unique_ptr<T>>;
+
+    ReclamationQueue() = default;
+    ReclamationQueue(const ReclamationQueue&) = delete;
+    ReclamationQueue& operator=(const ReclamationQueue&) = delete;
+
+    ~ReclamationQueue() { drain(); }
+
+    /// Add a batch of objects to be destroyed.
+    /// @return true if the queue was empty, in which case the caller should arrange for a `drain`.
+    bool push(Batch&& batch) {
+        auto* node = new Node{std::move(batch), head.load(std::memory_order_relaxed)};
+        while (!head.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed)) {
+        }
+        return node->next == nullptr;
+    }
+
+    /// Destroy the objects queued so far, oldest first.
+    /// @return the number of objects destroyed
+    std::size_t drain() {
+        Node* node = head.exchange(nullptr, std::memory_order_acquire);
+
+        // The list is newest-first, reverse it
+        Node* oldest = nullptr;
+        while (node) {
+            auto* next = node->next;
+            node->next = oldest;
+            oldest = node;
+            node = next;
+        }
+
+        std::size_t count = 0;
+        while (oldest) {
+            auto* next = oldest->next;
+            count += oldest->batch.size();
+            delete oldest;
+            oldest = next;
+        }
+        return count;
+    }
+
+    /// Approximate, the result may be stale by the time it's used
+    bool empty() const { return head.load(std::memory_order_relaxed) == nullptr; }
+
+private:
+    struct Node {
+        Batch batch;
+        Node* next;
+    };
+
+    std::atomic<Node*> head{nullptr};
+};
+
+} // namespace util
+} // namespace mbgl
@@ -1,78 +1,147 @@
 #include <mbgl/util/string_indexer.hpp>
 
+#include <algorithm>
+#include <bit>
 #include <cassert>
+#include <cstring>
+#include <functional>
 #include <memory>
 
 namespace mbgl {
 
 namespace {
 const std::string empty;
-constexpr std::size_t initialCapacity = 100;
-constexpr std::size_t initialBufferCapacity = initialCapacity * 32;
+constexpr std::size_t initialCapacity = 256;
+constexpr std::size_t initialBufferCapacity = 4096;
+
+std::atomic<uint64_t> nextInstance{1};
+
+// Recent lookups on this thread, direct-mapped by hash
+struct CachedLookup {
+    uint64_t instance = 0;
+    const void* entry = nullptr;
+};
+constexpr std::size_t lookupCacheSize = 64;
+thread_local std::array<CachedLookup, lookupCacheSize> lookupCache;
 } // namespace
 
-StringIndexer::StringIndexer() {
-    stringToIdentity.reserve(initialCapacity);
-    identityToString.reserve(initialCapacity);
-    buffer.reserve(initialBufferCapacity);
+StringIndexer::Table::Table(std::size_t capacity)
+    : mask(capacity - 1),
+      slots(std::make_unique<std::atomic<const Entry*>[]>(capacity)) {
+    assert((capacity & mask) == 0);
+}
+
+StringIndexer::StringIndexer()
+    : instance(nextInstance.fetch_add(1, std::memory_order_relaxed)) {
+    tables.push_back(std::make_unique<Table>(initialCapacity));
+    table.store(tables.back().get(), std::memory_order_release);
+}
+
+StringIndexer::~StringIndexer() {
+    for (auto& segment : segments) {
+        delete[] segment.load(std::memory_order_relaxed);
+    }
 }
 
 StringIdentity StringIndexer::get(std::string_view string) {
-    {
-        std::shared_lock<std::shared_mutex> readerLock(sharedMutex);
-        assert(stringToIdentity.size() == identityToString.size());
+    const auto hash = std::hash<std::string_view>()(string);
 
-        if (const auto it = stringToIdentity.find(string); it != stringToIdentity.end()) {
-            return it->second;
+    auto& cached = lookupCache[hash % lookupCacheSize];
+    if (cached.instance == instance) {
+        const auto* entry = static_cast<const Entry*>(cached.entry);
+        if (entry->hash == hash && entry->string == string) {
+            return entry->id;
         }
     }
 
-    {
-        std::unique_lock<std::shared_mutex> writerLock(sharedMutex);
-        assert(stringToIdentity.size() == identityToString.size());
-
-        if (const auto it = stringToIdentity.find(string); it == stringToIdentity.end()) {
-            // this writer to insert
-            const auto previousCapacity = buffer.capacity();
-
-            const StringIdentity id = identityToString.size();
-            identityToString.push_back(buffer.size());
-            buffer.insert(buffer.end(), string.begin(), string.end());
-            buffer.push_back(0);
-            if (buffer.capacity() != previousCapacity) {
-                // reallocation happened
-                stringToIdentity.clear();
-                for (auto iIdentity = identityToString.begin(); iIdentity != identityToString.end(); ++iIdentity) {
-                    stringToIdentity[std::string_view(buffer.data() + *iIdentity)] = iIdentity -
-                                                                                     identityToString.begin();
-                }
-            } else {
-                [[maybe_unused]] auto result = stringToIdentity.insert(
-                    {std::string_view(buffer.data() + identityToString.back()), id});
-                assert(result.second);
-            }
-            return id;
-        } else {
-            // another writer inserted into the map
-            return it->second;
+    const Entry* entry = find(string, hash);
+    if (!entry) {
+        std::lock_guard<std::mutex> writerLock(writerMutex);
+        // Another writer may have inserted it since
+        entry = find(string, hash);
+        if (!entry) {
+            entry = insert(string, hash);
         }
     }
+
+    cached = {instance, entry};
+    return entry->id;
 }
 
 std::string StringIndexer::get(const StringIdentity id) {
-    std::shared_lock<std::shared_mutex> readerLock(sharedMutex);
+    assert(id < size());
 
-    assert(id < identityToString.size());
-
-    return id < identityToString.size() ? (buffer.data() + identityToString[id]) : empty;
+    return id < size() ? std::string(entry(id).string) : empty;
 }
 
 size_t StringIndexer::size() {
-    std::shared_lock<std::shared_mutex> readerLock(sharedMutex);
+    return count.load(std::memory_order_acquire);
+}
+
+const StringIndexer::Entry* StringIndexer::find(std::string_view string, std::size_t hash) const {
+    const Table* current = table.load(std::memory_order_acquire);
+    for (auto i = hash & current->mask;; i = (i + 1) & current->mask) {
+        const Entry* entry = current->slots[i].load(std::memory_order_acquire);
+        if (!entry) {
+            return nullptr;
+        }
+        if (entry->hash == hash && entry->string == string) {
+            return entry;
+        }
+    }
+}
+
+const StringIndexer::Entry* StringIndexer::insert(std::string_view string, std::size_t hash) {
+    if (bufferCapacity - bufferUsed < string.size() + 1) {
+        bufferCapacity = std::max(initialBufferCapacity, string.size() + 1);
+        buffers.push_back(std::make_unique<char[]>(bufferCapacity));
+        bufferUsed = 0;
+    }
+    char* copy = buffers.back().get() + bufferUsed;
+    std::memcpy(copy, string.data(), string.size());
+    copy[string.size()] = 0;
+    bufferUsed += string.size() + 1;
+
+    const StringIdentity id = count.load(std::memory_order_relaxed);
+    const auto segment = static_cast<std::size_t>(std::bit_width(id / segmentBase + 1)) - 1;
+    assert(segment < segmentCount);
+    if (!segments[segment].load(std::memory_order_relaxed)) {
+        segments[segment].store(new Entry[segmentBase << segment], std::memory_order_release);
+    }
+
+    Entry& added = entry(id);
+    added = {std::string_view(copy, string.size()), hash, id};
+
+    Table* current = tables.back().get();
+    if ((id + 1) * 2 > current->mask + 1) {
+        // Keep the table at most half full, and readers of the old one unaffected
+        tables.push_back(std::make_unique<Table>((current->mask + 1) * 2));
+        current = tables.back().get();
+        for (StringIdentity i = 0; i < id; ++i) {
+            insert(*current, entry(i));
+        }
+        insert(*current, added);
+        table.store(current, std::memory_order_release);
+    } else {
+        insert(*current, added);
+    }
+
+    count.store(id + 1, std::memory_order_release);
+    return &added;
+}
 
-    assert(stringToIdentity.size() == identityToString.size());
+void StringIndexer::insert(Table& target, const Entry& added) {
+    auto i = added.hash & target.mask;
+    while (target.slots[i].load(std::memory_order_relaxed)) {
+        i = (i + 1) & target.mask;
+    }
+    target.slots[i].store(&added, std::memory_order_release);
+}
 
-    return identityToString.size();
+StringIndexer::Entry& StringIndexer::entry(StringIdentity id) const {
+    const auto segment = static_cast<std::size_t>(std::bit_width(id / segmentBase + 1)) - 1;
+    const auto offset = id - segmentBase * ((std::size_t{1} << segment) - 1);
+    return segments[segment].load(std::memory_order_acquire)[offset];
 }
 
 StringIndexer& stringIndexer() {
@@ -3,14 +3,90 @@
 #include <mbgl/platform/settings.hpp>
 #include <mbgl/platform/thread.hpp>
 #include <mbgl/util/instrumentation.hpp>
+#include <mbgl/util/logging.hpp>
 #include <mbgl/util/monotonic_timer.hpp>
 #include <mbgl/util/platform.hpp>
 #include <mbgl/util/string.hpp>
 
+#include <algorithm>
+#include <charconv>
+
 namespace mbgl {
 
+namespace {
+
+// Bounds the ranges of a CPU list, well above the CPU count of any device we run on
+constexpr std::size_t maxCPUs = 1024;
+
+std::vector<std::size_t> getCPUListSetting(const char* key) {
+    const auto value = platform::Settings::getInstance().get(key);
+    if (const auto* list = value.getString()) {
+        if (auto cpus = ThreadedSchedulerBase::ThreadOptions::parseCPUList(*list)) {
+            return std::move(*cpus);
+        }
+        Log::Warning(Event::General, "Malformed CPU list '" + *list + "' for " + key);
+    }
+    return {};
+}
+
+} // namespace
+
+ThreadedSchedulerBase::ThreadOptions ThreadedSchedulerBase::ThreadOptions::fromSettings() {
+    ThreadOptions options;
+    options.affinity = getCPUListSetting(platform::EXPERIMENTAL_THREAD_AFFINITY_WORKER);
+    options.housekeepingAffinity = getCPUListSetting(platform::EXPERIMENTAL_THREAD_AFFINITY_HOUSEKEEPING);
+    return options;
+}
+
+std::optional<std::vector<std::size_t>> ThreadedSchedulerBase::ThreadOptions::parseCPUList(std::string_view list) {
+    const auto parse = [](std::string_view digits) -> std::optional<std::size_t> {
+        std::size_t value = 0;
+        const auto end = digits.data() + digits.size();
+        const auto result = std::from_chars(digits.data(), end, value);
+        if (digits.empty() || result.ec != std::errc() || result.ptr != end || value >= maxCPUs) {
+            return std::nullopt;
+        }
+        return value;
+    };
+
+    std::vector<std::size_t> cpus;
+    for (std::size_t start = 0; start <= list.size();) {
+        const auto end = std::min(list.find(',', start), list.size());
+        const auto item = list.substr(start, end - start);
+        const auto dash = item.find('-');
+        const auto first = parse(item.substr(0, dash));
+        const auto last = dash == std::string_view::npos ? first : parse(item.substr(dash + 1));
+        if (!first || !last || *last < *first) {
+            return std::nullopt;
+        }
+        for (auto cpu = *first; cpu <= *last; ++cpu) {
+            cpus.push_back(cpu);
+        }
+        start = end + 1;
+    }
+    return cpus;
+}
+
+ThreadedSchedulerBase::ThreadedSchedulerBase(Mode mode_, std::size_t workerCount, ThreadOptions options_)
+    : mode(mode_),
+      options(std::move(options_)) {
+    if (mode == Mode::WorkStealing) {
+        workers.reserve(workerCount);
+        for (std::size_t i = 0; i < workerCount; ++i) {
+            workers.push_back(std::make_unique<Worker>());
+        }
+    }
+}
+
 ThreadedSchedulerBase::~ThreadedSchedulerBase() = default;
 
+ThreadedSchedulerBase::Worker::~Worker() {
+    // Tasks abandoned at termination
+    while (auto* task = deque.pop()) {
+        delete task;
+    }
+}
+
 void ThreadedSchedulerBase::terminate() {
     {
         std::scoped_lock lock(workerMutex);
@@ -23,10 +99,17 @@ void ThreadedSchedulerBase::terminate() {
 
 std::thread ThreadedSchedulerBase::makeSchedulerThread(size_t index) {
     return std::thread([this, index] {
-        auto& settings = platform::Settings::getInstance();
-        auto value = settings.get(platform::EXPERIMENTAL_THREAD_PRIORITY_WORKER);
-        if (auto* priority = value.getDouble()) {
-            platform::setCurrentThreadPriority(*priority);
+        if (options.priority) {
+            platform::setCurrentThreadPriority(*options.priority);
+        } else {
+            auto& settings = platform::Settings::getInstance();
+            auto value = settings.get(platform::EXPERIMENTAL_THREAD_PRIORITY_WORKER);
+            if (auto* priority = value.getDouble()) {
+                platform::setCurrentThreadPriority(*priority);
+            }
+        }
+        if (!options.affinity.empty()) {
+            platform::setCurrentThreadAffinity(options.affinity);
         }
 
         platform::setCurrentThreadName("Worker " + util::toString(index + 1));
@@ -34,75 +117,221 @@ std::thread ThreadedSchedulerBase::makeSchedulerThread(size_t index) {
 
         owningThreadPool.set(this);
 
-        while (true) {
+        if (mode == Mode::WorkStealing) {
+            runWorkStealing(index);
+        } else {
+            runShared();
+        }
+    });
+}
+
+void ThreadedSchedulerBase::runTask(Queue& q, std::function<void()>& tasklet) {
+    try {
+        tasklet();
+        tasklet = {}; // destroy the function and release its captures before unblocking `waitForEmpty`
+
+        if (!--q.runningCount) {
+            std::scoped_lock lock(q.lock);
+            if (q.idle()) {
+                q.cv.notify_all();
+            }
+        }
+    } catch (...) {
+        std::scoped_lock lock(q.lock);
+        if (handler) {
+            handler(std::current_exception());
+        }
+
+        tasklet = {};
+
+        if (!--q.runningCount && q.idle()) {
+            q.cv.notify_all();
+        }
+
+        if (!handler) {
+            throw;
+        }
+    }
+}
+
+void ThreadedSchedulerBase::moveToCPUs(bool& onHousekeepingCPUs, const TaskPriority priority) const {
+    if (options.housekeepingAffinity.empty()) {
+        return;
+    }
+    // Only switching between housekeeping and other tasks costs a system call
+    const bool housekeeping = priority == TaskPriority::Housekeeping;
+    if (housekeeping != onHousekeepingCPUs) {
+        platform::setCurrentThreadAffinity(housekeeping ? options.housekeepingAffinity : options.affinity);
+        onHousekeepingCPUs = housekeeping;
+    }
+}
+
+bool ThreadedSchedulerBase::Queue::idle() const {
+    return pendingCount == 0 && std::ranges::all_of(queues, [](const auto& queue) { return queue.empty(); });
+}
+
+std::size_t ThreadedSchedulerBase::highestPendingPriority() const {
+    for (std::size_t priority = 0; priority < priorityCount; ++priority) {
+        if (priorityTaskCount[priority] > 0) {
+            return priority;
+        }
+    }
+    return static_cast<std::size_t>(TaskPriority::Normal);
+}
+
+void ThreadedSchedulerBase::runShared() {
+    bool onHousekeepingCPUs = false;
+    while (true) {
+        std::unique_lock<std::mutex> conditionLock(workerMutex);
+        if (!terminated && taskCount == 0) {
+            cvAvailable.wait(conditionLock);
+        }
+
+        if (terminated) {
+            platform::detachThread();
+            break;
+        }
+
+        // Let other threads run
+        conditionLock.unlock();
+
+        std::vector<std::shared_ptr<Queue>> pending;
+        {
+            // 1. Gather buckets for us to visit this iteration
+            std::scoped_lock lock(taggedQueueLock);
+            for (const auto& [tag, queue] : taggedQueue) {
+                pending.push_back(queue);
+            }
+        }
+
+        // 2. Visit a task of the most urgent pending priority from each
+        const auto priority = highestPendingPriority();
+        for (auto& q : pending) {
+            std::function<void()> tasklet;
+            {
+                std::scoped_lock lock(q->lock);
+                auto& queue = q->queues[priority];
+                if (queue.size()) {
+                    q->runningCount++;
+                    tasklet = std::move(queue.front());
+                    queue.pop();
+                }
+                if (!tasklet) continue;
+            }
+
+            assert(taskCount > 0);
+            taskCount--;
+            priorityTaskCount[priority]--;
+
+            moveToCPUs(onHousekeepingCPUs, static_cast<TaskPriority>(priority));
+            runTask(*q, tasklet);
+
+            // 3. Start over if something more urgent came in meanwhile
+            if (highestPendingPriority() < priority) {
+                break;
+            }
+        }
+    }
+}
+
+std::unique_ptr<ThreadedSchedulerBase::Task> ThreadedSchedulerBase::takeTask(Worker& worker,
+                                                                             const std::size_t priority,
+                                                                             const bool own) {
+    if (priority == static_cast<std::size_t>(TaskPriority::Normal)) {
+        // Our own most recent work is likely to still be in cache, while the oldest
+        // work of our peers is the least likely to be taken by them soon.
+        if (auto* task = own ? worker.deque.pop() : worker.deque.steal()) {
+            return std::unique_ptr<Task>(task);
+        }
+    }
+
+    std::unique_lock lock(worker.inboxLock, std::defer_lock);
+    if (own) {
+        lock.lock();
+    } else if (!lock.try_lock()) {
+        return {};
+    }
+
+    auto& inbox = worker.inbox[priority];
+    if (inbox.empty()) {
+        return {};
+    }
+
+    auto task = std::move(inbox.front());
+    inbox.pop_front();
+    return task;
+}
+
+std::unique_ptr<ThreadedSchedulerBase::Task> ThreadedSchedulerBase::takeTask(std::size_t index) {
+    const auto count = workers.size();
+    for (std::size_t priority = 0; priority < priorityCount; ++priority) {
+        if (priorityTaskCount[priority] == 0) {
+            continue;
+        }
+
+        // Look at our own work first, then steal from our peers starting with our neighbor
+        for (std::size_t i = 0; i < count; ++i) {
+            if (auto task = takeTask(*workers[(index + i) % count], priority, i == 0)) {
+                return task;
+            }
+        }
+    }
+
+    return {};
+}
+
+void ThreadedSchedulerBase::runWorkStealing(std::size_t index) {
+    owningWorker.set(workers[index].get());
+
+    bool onHousekeepingCPUs = false;
+    while (true) {
+        {
             std::unique_lock<std::mutex> conditionLock(workerMutex);
             if (!terminated && taskCount == 0) {
                 cvAvailable.wait(conditionLock);
             }
 
             if (terminated) {
+                owningWorker.set(nullptr);
                 platform::detachThread();
                 break;
             }
+        }
 
-            // Let other threads run
-            conditionLock.unlock();
+        auto task = takeTask(index);
+        if (!task) {
+            // Counted but not yet visible, or taken by a peer
+            std::this_thread::yield();
+            continue;
+        }
 
-            std::vector<std::shared_ptr<Queue>> pending;
-            {
-                // 1. Gather buckets for us to visit this iteration
-                std::scoped_lock lock(taggedQueueLock);
-                for (const auto& [tag, queue] : taggedQueue) {
-                    pending.push_back(queue);
-                }
-            }
+        // Count as running before it stops counting as pending, so `waitForEmpty` can't observe a gap
+        auto& q = *task->queue;
+        q.runningCount++;
+        q.pendingCount--;
 
-            // 2. Visit a task from each
-            for (auto& q : pending) {
-                std::function<void()> tasklet;
-                {
-                    std::scoped_lock lock(q->lock);
-                    if (q->queue.size()) {
-                        q->runningCount++;
-                        tasklet = std::move(q->queue.front());
-                        q->queue.pop();
-                    }
-                    if (!tasklet) continue;
-                }
+        assert(taskCount > 0);
+        taskCount--;
+        priorityTaskCount[static_cast<std::size_t>(task->priority)]--;
 
-                assert(taskCount > 0);
-                taskCount--;
-
-                try {
-                    tasklet();
-                    tasklet = {}; // destroy the function and release its captures before unblocking `waitForEmpty`
-
-                    if (!--q->runningCount) {
-                        std::scoped_lock lock(q->lock);
-                        if (q->queue.empty()) {
-                            q->cv.notify_all();
-                        }
-                    }
-                } catch (...) {
-                    std::scoped_lock lock(q->lock);
-                    if (handler) {
-                        handler(std::current_exception());
-                    }
-
-                    tasklet = {};
-
-                    if (!--q->runningCount && q->queue.empty()) {
-                        q->cv.notify_all();
-                    }
-
-                    if (handler) {
-                        continue;
-                    }
-                    throw;
-                }
-            }
-        }
-    });
+        moveToCPUs(onHousekeepingCPUs, task->priority);
+        runTask(q, task->fn);
+    }
+}
+
+std::shared_ptr<ThreadedSchedulerBase::Queue> ThreadedSchedulerBase::getQueue(const util::SimpleIdentity tag) {
+    MLN_TRACE_ZONE(queue);
+    std::scoped_lock lock(taggedQueueLock);
+
+    // find or insert
+    auto result = taggedQueue.insert(std::make_pair(tag, std::shared_ptr<Queue>{}));
+    if (result.second) {
+        // new entry inserted
+        result.first->second = std::make_shared<Queue>();
+    }
+
+    MLN_ZONE_VALUE(taggedQueue.size());
+    return result.first->second;
 }
 
 void ThreadedSchedulerBase::schedule(std::function<void()>&& fn) {
@@ -110,30 +339,44 @@ void ThreadedSchedulerBase::schedule(std::function<void()>&& fn) {
 }
 
 void ThreadedSchedulerBase::schedule(const util::SimpleIdentity tag, std::function<void()>&& fn) {
+    scheduleWithPriority(tag, TaskPriority::Normal, std::move(fn));
+}
+
+void ThreadedSchedulerBase::scheduleWithPriority(const util::SimpleIdentity tag,
+                                                 const TaskPriority priority,
+                                                 std::function<void()>&& fn) {
     MLN_TRACE_FUNC();
     assert(fn);
     if (!fn) return;
 
-    std::shared_ptr<Queue> q;
-    {
-        MLN_TRACE_ZONE(queue);
-        std::scoped_lock lock(taggedQueueLock);
+    const auto level = static_cast<std::size_t>(priority);
+    // Untagged tasks go to the queue `waitForEmpty` waits for without a tag
+    auto q = getQueue(tag.isEmpty() ? uniqueID : tag);
 
-        // find or insert
-        auto result = taggedQueue.insert(std::make_pair(tag, std::shared_ptr<Queue>{}));
-        if (result.second) {
-            // new entry inserted
-            result.first->second = std::make_shared<Queue>();
-        }
-        q = result.first->second;
-
-        MLN_ZONE_VALUE(taggedQueue.size());
-    }
+    if (mode == Mode::WorkStealing) {
+        MLN_TRACE_ZONE(push);
+        // Count before publishing so that a worker taking it never sees a zero count
+        q->pendingCount++;
+        priorityTaskCount[level]++;
+        taskCount++;
 
-    {
+        auto task = std::make_unique<Task>(Task{std::move(fn), std::move(q), priority});
+        auto* worker = owningWorker.get();
+        if (worker && priority == TaskPriority::Normal) {
+            worker->deque.push(task.release());
+        } else {
+            if (!worker) {
+                // Keep each tag on the same worker, so related tasks tend to share a cache
+                worker = workers[std::hash<util::SimpleIdentity>{}(tag) % workers.size()].get();
+            }
+            std::scoped_lock lock(worker->inboxLock);
+            worker->inbox[level].push_back(std::move(task));
+        }
+    } else {
         MLN_TRACE_ZONE(push);
         std::scoped_lock lock(q->lock);
-        q->queue.push(std::move(fn));
+        q->queues[level].push(std::move(fn));
+        priorityTaskCount[level]++;
         taskCount++;
     }
 
@@ -159,7 +402,7 @@ void ThreadedSchedulerBase::waitForEmpty(const util::SimpleIdentity tag) {
         }
 
         std::unique_lock<std::mutex> queueLock(q->lock);
-        while (q->queue.size() + q->runningCount) {
+        while (!q->idle() || q->runningCount) {
             q->cv.wait(queueLock);
         }
 
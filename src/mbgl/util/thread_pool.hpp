@@ -6,10 +6,15 @@
 #include <mbgl/util/containers.hpp>
 #include <mbgl/util/identity.hpp>
 #include <mbgl/util/instrumentation.hpp>
+#include <mbgl/util/work_stealing_deque.hpp>
 
+#include <array>
 #include <condition_variable>
+#include <deque>
 #include <mutex>
+#include <optional>
 #include <queue>
+#include <string_view>
 #include <thread>
 #include <vector>
 
@@ -17,6 +22,33 @@ namespace mbgl {
 
 class ThreadedSchedulerBase : public Scheduler {
 public:
+    /// Strategy used by the worker threads to pick up tasks
+    enum class Mode : uint8_t {
+        /// All workers share the tagged queues and visit one task from each tag in turn
+        Shared,
+        /// Each worker owns a lock-free deque and steals from its peers when idle.
+        /// Tasks scheduled from outside the pool are routed to a worker by tag.
+        /// Applies only to schedulers with more than one thread.
+        WorkStealing,
+    };
+
+    /// How the worker threads are set up
+    struct ThreadOptions {
+        /// Passed to `platform::setCurrentThreadPriority`, which picks the QoS class on Apple platforms.
+        /// If unset, the EXPERIMENTAL_THREAD_PRIORITY_WORKER setting applies.
+        std::optional<double> priority;
+        /// CPUs the workers run on, empty for any
+        std::vector<std::size_t> affinity;
+        /// CPUs a worker moves to while it runs housekeeping tasks, empty to stay on `affinity`
+        std::vector<std::size_t> housekeepingAffinity;
+
+        /// The options of the EXPERIMENTAL_THREAD_AFFINITY_* settings
+        static ThreadOptions fromSettings();
+
+        /// Parses a list of CPUs and CPU ranges, such as "0,4-7", nullopt if it's malformed
+        static std::optional<std::vector<std::size_t>> parseCPUList(std::string_view);
+    };
+
     /// @brief Schedule a generic task not assigned to any particular owner.
     /// The scheduler itself will own the task.
     /// @param fn Task to run
@@ -26,10 +58,22 @@ public:
     /// @param tag Identifier object to indicate ownership of `fn`
     /// @param fn Task to run
     void schedule(const util::SimpleIdentity tag, std::function<void()>&& fn) override;
+
+    /// @brief Schedule a task assigned to the given owner `tag` with the given priority.
+    /// Pending tasks of a more urgent priority are picked up before any less urgent ones,
+    /// regardless of their owner.
+    /// @param tag Identifier object to indicate ownership of `fn`, tasks without an owner share
+    /// the queue of untagged tasks that `waitForEmpty()` waits for
+    /// @param priority Urgency of the task
+    /// @param fn Task to run
+    void scheduleWithPriority(const util::SimpleIdentity tag,
+                              TaskPriority priority,
+                              std::function<void()>&& fn) override;
+
     const util::SimpleIdentity uniqueID;
 
 protected:
-    ThreadedSchedulerBase() = default;
+    ThreadedSchedulerBase(Mode mode = Mode::Shared, std::size_t workerCount = 0, ThreadOptions options = {});
     ~ThreadedSchedulerBase() override;
 
     void terminate();
@@ -51,15 +95,60 @@ protected:
     util::ThreadLocal<ThreadedSchedulerBase> owningThreadPool;
     std::atomic<size_t> taskCount{0};
     bool terminated{false};
+    const Mode mode;
+    const ThreadOptions options;
+
+    static constexpr std::size_t priorityCount = static_cast<std::size_t>(TaskPriority::Housekeeping) + 1;
+
+    // Pending tasks by priority, used to skip empty priority levels
+    std::array<std::atomic<std::size_t>, priorityCount> priorityTaskCount{};
 
     // Task queues bucketed by tag address
     struct Queue {
-        std::atomic<std::size_t> runningCount;   /* running tasks */
-        std::condition_variable cv;              /* queue empty condition */
-        std::mutex lock;                         /* lock */
-        std::queue<std::function<void()>> queue; /* pending task queue */
+        std::atomic<std::size_t> runningCount; /* running tasks */
+        std::atomic<std::size_t> pendingCount; /* tasks held in worker deques (work-stealing mode) */
+        std::condition_variable cv;            /* queue empty condition */
+        std::mutex lock;                       /* lock */
+        /* pending tasks by priority (shared mode) */
+        std::array<std::queue<std::function<void()>>, priorityCount> queues;
+
+        bool idle() const;
     };
     mbgl::unordered_map<util::SimpleIdentity, std::shared_ptr<Queue>> taggedQueue;
+
+private:
+    std::shared_ptr<Queue> getQueue(util::SimpleIdentity tag);
+
+    /// The most urgent priority with pending tasks
+    std::size_t highestPendingPriority() const;
+
+    void runShared();
+    void runWorkStealing(std::size_t index);
+
+    /// Run a task taken from `q`, rethrows its exception if there's no handler
+    void runTask(Queue& q, std::function<void()>& tasklet);
+
+    /// Move the current worker to the CPUs of the task's priority, if it's not already on them
+    void moveToCPUs(bool& onHousekeepingCPUs, TaskPriority priority) const;
+
+    // Work-stealing mode
+    struct Task {
+        std::function<void()> fn;
+        std::shared_ptr<Queue> queue;
+        TaskPriority priority;
+    };
+    struct Worker {
+        ~Worker();
+
+        util::WorkStealingDeque<Task> deque; /* normal priority tasks pushed by the owning thread */
+        std::mutex inboxLock;
+        std::array<std::deque<std::unique_ptr<Task>>, priorityCount> inbox; /* everything else, by priority */
+    };
+    std::unique_ptr<Task> takeTask(std::size_t index);
+    std::unique_ptr<Task> takeTask(Worker&, std::size_t priority, bool own);
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    util::ThreadLocal<Worker> owningWorker;
 };
 
 /**
@@ -67,13 +156,14 @@ protected:
  *
  * @tparam N number of threads
  *
- * Note: If N == 1 all scheduled tasks are guaranteed to execute consequently;
- * otherwise, some of the scheduled tasks might be executed in parallel.
+ * Note: If N == 1 all scheduled tasks of the same priority are guaranteed to execute
+ * consequently; otherwise, some of the scheduled tasks might be executed in parallel.
  */
 class ThreadedScheduler : public ThreadedSchedulerBase {
 public:
-    ThreadedScheduler(std::size_t n)
-        : threads(n) {
+    ThreadedScheduler(std::size_t n, Mode mode_ = Mode::Shared, ThreadOptions options_ = {})
+        : ThreadedSchedulerBase(n > 1 ? mode_ : Mode::Shared, n, std::move(options_)),
+          threads(n) {
         for (std::size_t i = 0u; i < threads.size(); ++i) {
             threads[i] = makeSchedulerThread(i);
         }
@@ -89,6 +179,10 @@ public:
     }
 
     void runOnRenderThread(const util::SimpleIdentity tag, std::function<void()>&& fn) override {
+        runOnRenderThread(tag, TaskPriority::Normal, std::move(fn));
+    }
+
+    void runOnRenderThread(const util::SimpleIdentity tag, TaskPriority priority, std::function<void()>&& fn) override {
         std::shared_ptr<RenderQueue> queue;
         {
             std::scoped_lock lock(taggedRenderQueueLock);
@@ -102,7 +196,7 @@ public:
         }
 
         std::scoped_lock lock(queue->mutex);
-        queue->queue.push(std::move(fn));
+        queue->queues[static_cast<std::size_t>(priority)].push(std::move(fn));
     }
 
     void runRenderJobs(const util::SimpleIdentity tag, bool closeQueue = false) override {
@@ -125,15 +219,7 @@ public:
             return;
         }
 
-        std::scoped_lock taskLock(queue->mutex);
-        while (queue->queue.size()) {
-            auto fn = std::move(queue->queue.front());
-            queue->queue.pop();
-            if (fn) {
-                MLN_TRACE_ZONE(render job);
-                fn();
-            }
-        }
+        runRenderQueue(*queue, std::nullopt);
 
         if (closeQueue) {
             // We hold both locks and can safely remove the queue entry
@@ -141,6 +227,22 @@ public:
         }
     }
 
+    void runRenderJobs(const util::SimpleIdentity tag, Duration budget) override {
+        MLN_TRACE_FUNC();
+        std::shared_ptr<RenderQueue> queue;
+        {
+            std::scoped_lock lock(taggedRenderQueueLock);
+            auto it = taggedRenderQueue.find(tag);
+            if (it != taggedRenderQueue.end()) {
+                queue = it->second;
+            }
+        }
+
+        if (queue) {
+            runRenderQueue(*queue, Clock::now() + budget);
+        }
+    }
+
     mapbox::base::WeakPtr<Scheduler> makeWeakPtr() override { return weakFactory.makeWeakPtr(); }
 
 protected:
@@ -152,9 +254,30 @@ private:
     std::vector<std::thread> threads;
 
     struct RenderQueue {
-        std::queue<std::function<void()>> queue;
+        std::array<std::queue<std::function<void()>>, priorityCount> queues; /* pending jobs by priority */
         std::mutex mutex;
     };
+
+    /// Runs the jobs of `queue` in priority order. Past the deadline, if any, only urgent jobs are run.
+    static void runRenderQueue(RenderQueue& queue, std::optional<TimePoint> deadline) {
+        std::scoped_lock lock(queue.mutex);
+        for (std::size_t priority = 0; priority < priorityCount; ++priority) {
+            auto& jobs = queue.queues[priority];
+            while (!jobs.empty()) {
+                if (deadline && priority != static_cast<std::size_t>(TaskPriority::Urgent) &&
+                    Clock::now() >= *deadline) {
+                    return;
+                }
+                auto fn = std::move(jobs.front());
+                jobs.pop();
+                if (fn) {
+                    MLN_TRACE_ZONE(render job);
+                    fn();
+                }
+            }
+        }
+    }
+
     mbgl::unordered_map<util::SimpleIdentity, std::shared_ptr<RenderQueue>> taggedRenderQueue;
     std::mutex taggedRenderQueueLock;
 
@@ -171,15 +294,17 @@ public:
 
 class ParallelScheduler : public ThreadedScheduler {
 public:
-    ParallelScheduler(std::size_t extra)
-        : ThreadedScheduler(1 + extra) {}
+    ParallelScheduler(std::size_t extra, Mode mode_ = Mode::Shared, ThreadOptions options_ = {})
+        : ThreadedScheduler(1 + extra, mode_, std::move(options_)) {}
     ~ParallelScheduler() override { invalidateWeakPtrsEarly(); }
 };
 
 class ThreadPool final : public ParallelScheduler {
 public:
-    ThreadPool()
-        : ParallelScheduler(3) {}
+    static constexpr std::size_t threadCount = 4;
+
+    ThreadPool(Mode mode_ = Mode::Shared, ThreadOptions options_ = {})
+        : ParallelScheduler(threadCount - 1, mode_, std::move(options_)) {}
     ~ThreadPool() override { invalidateWeakPtrsEarly(); }
 };
 
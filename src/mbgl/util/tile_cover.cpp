@@ -7,6 +7,7 @@
 #include <mbgl/util/tile_cover_impl.hpp>
 
 #include <functional>
+#include <limits>
 #include <list>
 
 using namespace std::numbers;
@@ -192,7 +193,9 @@ std::vector<OverscaledTileID> tileCover(const TileCoverParameters& state,
     const double worldSize = Projection::worldSize(transform.getScale());
     const bool allowVariableZoom = transform.getPitch() > state.tileLodPitchThreshold;
     const uint8_t minZoom = allowVariableZoom ? zoomRange.min : z;
-    const uint8_t maxZoom = ((state.tileLodMode == TileLodMode::Distance) && allowVariableZoom) ? zoomRange.max : z;
+    const bool distanceLod = state.tileLodMode == TileLodMode::Distance;
+    const bool screenSpaceLod = state.tileLodMode == TileLodMode::ScreenSpaceError;
+    const uint8_t maxZoom = (distanceLod && allowVariableZoom) ? zoomRange.max : z;
     const uint8_t overscaledZoom = std::max(overscaledZ.value_or(z), maxZoom);
     const bool flippedY = transform.getViewportMode() == ViewportMode::FlippedY;
 
@@ -206,7 +209,10 @@ std::vector<OverscaledTileID> tileCover(const TileCoverParameters& state,
     const vec3 cameraPositionMercator = *transform.getFreeCameraOptions().position;
     const double nominalScale = std::pow(2.0, z);
     const vec3 cameraCoord = vec3Scale(cameraPositionMercator, nominalScale);
-    const double cameraToCenterDistanceMercator = vec3Length(vec3Sub(cameraCoord, centerCoord)) / worldSize;
+    const double cameraToCenterDistance = vec3Length(vec3Sub(cameraCoord, centerCoord));
+    const double cameraToCenterDistanceMercator = cameraToCenterDistance / worldSize;
+    // Screen pixels covered by one unit of tile coordinates at the distance of the map center
+    const double centerPixelsPerUnit = worldSize / numTiles;
 
     const Frustum frustum = Frustum::fromInvProjMatrix(transform.getInvProjectionMatrix(), worldSize, z, flippedY);
 
@@ -229,72 +235,99 @@ std::vector<OverscaledTileID> tileCover(const TileCoverParameters& state,
     std::vector<ResultTile> result;
     stack.reserve(128);
 
-    // World copies shall be rendered three times on both sides from closest to farthest
-    for (int i = 1; i <= 3; i++) {
-        stack.push_back(newRootTile(-i));
-        stack.push_back(newRootTile(i));
-    }
+    const auto traverse = [&](const double lodScale) {
+        stack.clear();
+        result.clear();
 
-    stack.push_back(newRootTile(0));
+        // World copies shall be rendered three times on both sides from closest to farthest
+        for (int i = 1; i <= 3; i++) {
+            stack.push_back(newRootTile(-i));
+            stack.push_back(newRootTile(i));
+        }
 
-    while (!stack.empty()) {
-        Node node = stack.back();
-        stack.pop_back();
+        stack.push_back(newRootTile(0));
 
-        // Use cached visibility information of ancestor nodes
-        if (!node.fullyVisible) {
-            const IntersectionResult intersection = frustum.intersects(node.aabb);
+        while (!stack.empty()) {
+            Node node = stack.back();
+            stack.pop_back();
 
-            if (intersection == IntersectionResult::Separate) continue;
+            // Use cached visibility information of ancestor nodes
+            if (!node.fullyVisible) {
+                const IntersectionResult intersection = frustum.intersects(node.aabb);
 
-            node.fullyVisible = intersection == IntersectionResult::Contains;
-        }
+                if (intersection == IntersectionResult::Separate) continue;
 
-        bool shouldSplitTile;
-        if (state.tileLodMode == TileLodMode::Distance) {
-            const vec3 camToTileMercator = vec3Scale(node.aabb.distanceXYZ(cameraCoord), 1.0 / worldSize);
-            const double distanceToTileMercator = vec3Length(camToTileMercator);
-            const double cosPitchToTile = std::max(0.0, camToTileMercator[2] / distanceToTileMercator);
-            const double pitchExponent =
-                0.5; // 0: constant screen width, 1/2: constant screen area, 1: constant screen height
-            double tileScale = std::pow(2.0, node.zoom);
-            shouldSplitTile = distanceToTileMercator * tileScale < std::pow(cosPitchToTile, pitchExponent) *
-                                                                       cameraToCenterDistanceMercator /
-                                                                       state.tileLodScale * nominalScale;
-        } else {
-            const vec3 distanceXyz = node.aabb.distanceXYZ(centerCoord);
-            const double* longestDim = std::max_element(distanceXyz.data(), distanceXyz.data() + distanceXyz.size());
-            assert(longestDim);
-
-            // We're using distance based heuristics to determine if a tile should
-            // be split into quadrants or not. radiusOfMaxLvlLodInTiles defines that
-            // there's always a certain number of maxLevel tiles next to the map
-            // center. Using the fact that a parent node in quadtree is twice the
-            // size of its children (per dimension) we can define distance
-            // thresholds for each relative level:
-            // f(k) = offset + 2 + 4 + 8 + 16 + ... + 2^k
-            // This is the same as:
-            // f(k) = offset + 2^(k+1)-2
-            const double distToSplit = radiusOfMaxLvlLodInTiles + (1 << (maxZoom - node.zoom)) - 2;
-            shouldSplitTile = *longestDim * state.tileLodScale < distToSplit;
-        }
+                node.fullyVisible = intersection == IntersectionResult::Contains;
+            }
 
-        // Have we reached the target depth or is the tile too far away to be any split further?
-        if (node.zoom == maxZoom || (!shouldSplitTile && node.zoom >= minZoom)) {
-            // Perform precise intersection test between the frustum and aabb.
-            // This will cull < 1% false positives missed by the original test
-            if (node.fullyVisible || frustum.intersectsPrecise(node.aabb, true) != IntersectionResult::Separate) {
-                const OverscaledTileID id = {
-                    node.zoom == maxZoom ? overscaledZoom : node.zoom, node.wrap, node.zoom, node.x, node.y};
-                vec3 coordToLoadFirst = (state.tileLodMode == TileLodMode::Distance) ? cameraCoord : centerCoord;
-                const double dx = node.wrap * numTiles + node.x + 0.5 - coordToLoadFirst[0];
-                const double dy = node.y + 0.5 - coordToLoadFirst[1];
-
-                result.push_back({id, dx * dx + dy * dy});
+            bool shouldSplitTile;
+            if (distanceLod) {
+                const vec3 camToTileMercator = vec3Scale(node.aabb.distanceXYZ(cameraCoord), 1.0 / worldSize);
+                const double distanceToTileMercator = vec3Length(camToTileMercator);
+                const double cosPitchToTile = std::max(0.0, camToTileMercator[2] / distanceToTileMercator);
+                const double pitchExponent =
+                    0.5; // 0: constant screen width, 1/2: constant screen area, 1: constant screen height
+                double tileScale = std::pow(2.0, node.zoom);
+                shouldSplitTile = distanceToTileMercator * tileScale < std::pow(cosPitchToTile, pitchExponent) *
+                                                                           cameraToCenterDistanceMercator /
+                                                                           lodScale * nominalScale;
+            } else if (screenSpaceLod) {
+                // Split while the tile would be drawn larger than its nominal size, that is while
+                // its texels would be magnified on screen. The projected size shrinks with the
+                // distance from the camera, so tiles toward the horizon settle at lower zooms.
+                const double distanceToTile = vec3Length(node.aabb.distanceXYZ(cameraCoord));
+                const double tileUnits = numTiles / std::pow(2.0, node.zoom);
+                const double projectedSize = tileUnits * centerPixelsPerUnit * cameraToCenterDistance /
+                                             std::max(distanceToTile, std::numeric_limits<double>::epsilon());
+                shouldSplitTile = projectedSize > util::tileSize_D * lodScale;
+            } else {
+                const vec3 distanceXyz = node.aabb.distanceXYZ(centerCoord);
+                const double* longestDim = std::max_element(distanceXyz.data(),
+                                                            distanceXyz.data() + distanceXyz.size());
+                assert(longestDim);
+
+                // We're using distance based heuristics to determine if a tile should
+                // be split into quadrants or not. radiusOfMaxLvlLodInTiles defines that
+                // there's always a certain number of maxLevel tiles next to the map
+                // center. Using the fact that a parent node in quadtree is twice the
+                // size of its children (per dimension) we can define distance
+                // thresholds for each relative level:
+                // f(k) = offset + 2 + 4 + 8 + 16 + ... + 2^k
+                // This is the same as:
+                // f(k) = offset + 2^(k+1)-2
+                const double distToSplit = radiusOfMaxLvlLodInTiles + (1 << (maxZoom - node.zoom)) - 2;
+                shouldSplitTile = *longestDim * lodScale < distToSplit;
             }
-        } else {
-            std::vector<Node> children = childrenOf(node);
-            stack.insert(stack.end(), children.begin(), children.end());
+
+            // Have we reached the target depth or is the tile too far away to be any split further?
+            if (node.zoom == maxZoom || (!shouldSplitTile && node.zoom >= minZoom)) {
+                // Perform precise intersection test between the frustum and aabb.
+                // This will cull < 1% false positives missed by the original test
+                if (node.fullyVisible || frustum.intersectsPrecise(node.aabb, true) != IntersectionResult::Separate) {
+                    const OverscaledTileID id = {
+                        node.zoom == maxZoom ? overscaledZoom : node.zoom, node.wrap, node.zoom, node.x, node.y};
+                    vec3 coordToLoadFirst = (distanceLod || screenSpaceLod) ? cameraCoord : centerCoord;
+                    const double dx = node.wrap * numTiles + node.x + 0.5 - coordToLoadFirst[0];
+                    const double dy = node.y + 0.5 - coordToLoadFirst[1];
+
+                    result.push_back({id, dx * dx + dy * dy});
+                }
+            } else {
+                std::vector<Node> children = childrenOf(node);
+                stack.insert(stack.end(), children.begin(), children.end());
+            }
+        }
+    };
+
+    traverse(state.tileLodScale);
+
+    // Over budget, coarsen the cover one zoom level at a time away from the camera. Only covers with
+    // variable zoom levels can be coarsened, what's left over is cut from the far end below.
+    if (state.tileLodMaxTiles && allowVariableZoom) {
+        double lodScale = state.tileLodScale;
+        for (int32_t level = minZoom; level < maxZoom && result.size() > state.tileLodMaxTiles; ++level) {
+            lodScale *= 2;
+            traverse(lodScale);
         }
     }
 
@@ -302,6 +335,10 @@ std::vector<OverscaledTileID> tileCover(const TileCoverParameters& state,
     std::sort(
         result.begin(), result.end(), [](const ResultTile& a, const ResultTile& b) { return a.sqrDist < b.sqrDist; });
 
+    if (state.tileLodMaxTiles && result.size() > state.tileLodMaxTiles) {
+        result.resize(state.tileLodMaxTiles);
+    }
+
     std::vector<OverscaledTileID> ids;
     ids.reserve(result.size());
 
@@ -359,13 +396,7 @@ uint64_t tileCount(const LatLngBounds& bounds, uint8_t zoom) noexcept {
 }
 
 uint64_t tileCount(const Geometry<double>& geometry, uint8_t z) {
-    uint64_t tileCount = 0;
-
-    TileCover tc(geometry, z, true);
-    while (tc.next()) {
-        tileCount++;
-    };
-    return tileCount;
+    return TileCover(geometry, z, true).count();
 }
 
 TileCover::TileCover(const LatLngBounds& bounds_, uint8_t z) {
@@ -398,5 +429,9 @@ bool TileCover::hasNext() {
     return impl->hasNext();
 }
 
+uint64_t TileCover::count() {
+    return impl->count();
+}
+
 } // namespace util
 } // namespace mbgl
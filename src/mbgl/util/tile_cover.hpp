@@ -27,6 +27,8 @@ public:
 
     std::optional<UnwrappedTileID> next();
     bool hasNext();
+    // Counts the tiles left in the cover, a row span at a time rather than tile by tile
+    uint64_t count();
 
 private:
     class Impl;
@@ -39,6 +41,8 @@ struct TileCoverParameters {
     double tileLodScale = 1;
     double tileLodPitchThreshold = (60.0 / 180.0) * std::numbers::pi;
     TileLodMode tileLodMode = TileLodMode::Default;
+    // Most tiles in a cover, zero for no limit
+    std::size_t tileLodMaxTiles = 0;
 };
 
 int32_t coveringZoomLevel(double z, style::SourceType type, uint16_t tileSize) noexcept;
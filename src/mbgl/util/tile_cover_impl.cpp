@@ -362,5 +362,22 @@ std::optional<UnwrappedTileID> TileCover::Impl::next() {
     return UnwrappedTileID(zoom, x, y);
 }
 
+// Same as calling next() until the cover is exhausted, but skips to the end of each span
+uint64_t TileCover::Impl::count() {
+    uint64_t result = 0;
+    while (hasNext()) {
+        result += static_cast<uint64_t>(tileXSpans.front().second - tileX);
+        tileXSpans.pop();
+        if (tileXSpans.empty()) {
+            tileY++;
+            nextRow();
+        }
+        if (!tileXSpans.empty()) {
+            tileX = tileXSpans.front().first;
+        }
+    }
+    return result;
+}
+
 } // namespace util
 } // namespace mbgl
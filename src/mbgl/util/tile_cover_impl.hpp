@@ -81,6 +81,7 @@ public:
 
     std::optional<UnwrappedTileID> next();
     bool hasNext() const;
+    uint64_t count();
 
 private:
     using TileSpans = std::queue<std::pair<int32_t, int32_t>>;
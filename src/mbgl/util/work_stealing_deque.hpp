@@ -0,0 +1,148 @@
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace mbgl {
+namespace util {
+
+/**
+    A lock-free, single-producer/multi-consumer double-ended queue of pointers
+    (Chase & Lev, "Dynamic Circular Work-Stealing Deque", with the memory orderings
+    from Lê et al., "Correct and Efficient Work-Stealing for Weak Memory Models").
+
+    Only the owning thread may call `push` and `pop`, which operate on the bottom
+    end in LIFO order. Any thread may call `steal`, which takes from the top end
+    in FIFO order. The deque does not own the pointed-to items.
+ */
+template <typename T>
+class WorkStealingDeque {
+public:
+    explicit WorkStealingDeque(std::size_t capacity = 64)
+        : array(new Array(roundUpToPowerOfTwo(capacity))) {}
+
+    ~WorkStealingDeque() {
+        delete array.load(std::memory_order_relaxed);
+        for (auto* retired : retiredArrays) {
+            delete retired;
+        }
+    }
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    /// Add an item at the bottom. Owner thread only.
+    void push(T* item) {
+        const auto b = bottom.load(std::memory_order_relaxed);
+        const auto t = top.load(std::memory_order_acquire);
+        auto* a = array.load(std::memory_order_relaxed);
+
+        if (b - t > static_cast<std::int64_t>(a->capacity) - 1) {
+            // Stealers may still be reading the old array, keep it alive until we're destroyed
+            retiredArrays.push_back(a);
+            a = a->grow(b, t);
+            array.store(a, std::memory_order_release);
+        }
+
+        a->put(b, item);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom.store(b + 1, std::memory_order_relaxed);
+    }
+
+    /// Remove the most recently pushed item, or null if empty. Owner thread only.
+    T* pop() {
+        const auto b = bottom.load(std::memory_order_relaxed) - 1;
+        auto* a = array.load(std::memory_order_relaxed);
+        bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        auto t = top.load(std::memory_order_relaxed);
+
+        T* item = nullptr;
+        if (t <= b) {
+            item = a->get(b);
+            if (t == b) {
+                // Last item, race against stealers for it
+                if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                    item = nullptr;
+                }
+                bottom.store(b + 1, std::memory_order_relaxed);
+            }
+        } else {
+            bottom.store(b + 1, std::memory_order_relaxed);
+        }
+        return item;
+    }
+
+    /// Remove the least recently pushed item, or null if empty or lost a race. Any thread.
+    T* steal() {
+        auto t = top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const auto b = bottom.load(std::memory_order_acquire);
+
+        if (t < b) {
+            const auto* a = array.load(std::memory_order_acquire);
+            T* item = a->get(t);
+            if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                return nullptr;
+            }
+            return item;
+        }
+        return nullptr;
+    }
+
+    /// Approximate, the result may be stale by the time it's used
+    bool empty() const {
+        const auto b = bottom.load(std::memory_order_relaxed);
+        const auto t = top.load(std::memory_order_relaxed);
+        return b <= t;
+    }
+
+private:
+    struct Array {
+        explicit Array(std::size_t capacity_)
+            : capacity(capacity_),
+              mask(capacity_ - 1),
+              slots(std::make_unique<std::atomic<T*>[]>(capacity_)) {
+            assert((capacity & mask) == 0);
+        }
+
+        T* get(std::int64_t i) const {
+            return slots[static_cast<std::size_t>(i) & mask].load(std::memory_order_relaxed);
+        }
+        void put(std::int64_t i, T* item) {
+            slots[static_cast<std::size_t>(i) & mask].store(item, std::memory_order_relaxed);
+        }
+
+        Array* grow(std::int64_t b, std::int64_t t) const {
+            auto* result = new Array(capacity * 2);
+            for (auto i = t; i < b; ++i) {
+                result->put(i, get(i));
+            }
+            return result;
+        }
+
+        const std::size_t capacity;
+        const std::size_t mask;
+        std::unique_ptr<std::atomic<T*>[]> slots;
+    };
+
+    static std::size_t roundUpToPowerOfTwo(std::size_t n) {
+        std::size_t result = 1;
+        while (result < n) {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    alignas(64) std::atomic<std::int64_t> top{0};
+    alignas(64) std::atomic<std::int64_t> bottom{0};
+    std::atomic<Array*> array;
+    std::vector<Array*> retiredArrays;
+};
+
+} // namespace util
+} // namespace mbgl
@@ -11,7 +11,7 @@ namespace vulkan {
 
 CommandEncoder::CommandEncoder(Context& context_, const vk::UniqueCommandBuffer& buffer_)
     : context(context_),
-      commandBuffer(buffer_) {}
+      commandBuffer(&buffer_) {}
 
 CommandEncoder::~CommandEncoder() {}
 
@@ -33,11 +33,15 @@ void CommandEncoder::pushDebugGroup(const char* name) {
 }
 
 void CommandEncoder::pushDebugGroup(const char* name, const std::array<float, 4>& color) {
-    context.getBackend().beginDebugLabel(commandBuffer.get(), name, color);
+    if (debugGroups) {
+        context.getBackend().beginDebugLabel(commandBuffer->get(), name, color);
+    }
 }
 
 void CommandEncoder::popDebugGroup() {
-    context.getBackend().endDebugLabel(commandBuffer.get());
+    if (debugGroups) {
+        context.getBackend().endDebugLabel(commandBuffer->get());
+    }
 }
 
 } // namespace vulkan
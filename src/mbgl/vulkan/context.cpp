@@ -19,6 +19,7 @@
 #include <mbgl/util/traits.hpp>
 #include <mbgl/util/std.hpp>
 #include <mbgl/util/logging.hpp>
+#include <mbgl/util/monotonic_timer.hpp>
 #include <mbgl/util/thread_pool.hpp>
 #include <mbgl/util/hash.hpp>
 
@@ -68,6 +69,7 @@ Context::Context(RendererBackend& backend_)
 Context::~Context() noexcept {
     MBGL_VERIFY_THREAD(tid);
 
+    clearOffscreenTexturePool();
     destroyResources();
 
     {
@@ -124,6 +126,13 @@ void Context::initFrameResources() {
         backend.setDebugName(frame.flightFrameFence.get(), "FrameFence_" + std::to_string(index));
     }
 
+    if (backend.isTimelineSemaphoreSupported()) {
+        auto typeInfo = vk::SemaphoreTypeCreateInfoKHR().setSemaphoreType(vk::SemaphoreType::eTimeline);
+        frameTimeline = device->createSemaphoreUnique(
+            vk::SemaphoreCreateInfo().setPNext(&typeInfo), nullptr, dispatcher);
+        backend.setDebugName(frameTimeline.get(), "FrameTimeline");
+    }
+
     // force placeholder texture upload before any descriptor sets
     (void)getDummyTexture();
 
@@ -240,6 +249,21 @@ void Context::waitFrame() const {
     auto& frame = frameResources[frameResourceIndex];
     constexpr uint64_t timeout = std::numeric_limits<uint64_t>::max();
 
+    if (frameTimeline) {
+        // Nothing to wait for until the frame has been submitted once
+        if (frame.timelineValue == 0) {
+            return;
+        }
+
+        const auto waitInfo = vk::SemaphoreWaitInfoKHR().setSemaphores(frameTimeline.get()).setValues(
+            frame.timelineValue);
+        const vk::Result waitResult = device->waitSemaphoresKHR(waitInfo, timeout, dispatcher);
+        if (waitResult != vk::Result::eSuccess) {
+            mbgl::Log::Error(mbgl::Event::Render, "Wait timeline semaphore failed");
+        }
+        return;
+    }
+
     const vk::Result waitFenceResult = device->waitForFences(
         1, &frame.flightFrameFence.get(), VK_TRUE, timeout, dispatcher);
     if (waitFenceResult != vk::Result::eSuccess) {
@@ -299,10 +323,17 @@ void Context::beginFrame() {
     auto& frame = frameResources[frameResourceIndex];
     constexpr uint64_t timeout = std::numeric_limits<uint64_t>::max();
 
+    const auto startWait = util::MonotonicTimer::now();
     waitFrame();
+    stats.frameWaitTime = (util::MonotonicTimer::now() - startWait).count();
 
     frame.runDeletionQueue(*this);
 
+    for (std::size_t i = 0; i < frame.usedSecondaryCommandBuffers; ++i) {
+        device->resetCommandPool(frame.secondaryCommandBuffers[i].pool.get(), {}, dispatcher);
+    }
+    frame.usedSecondaryCommandBuffers = 0;
+
     if (platformSurface) {
         MLN_TRACE_ZONE(acquireNextImageKHR);
         try {
@@ -333,7 +364,7 @@ void Context::beginFrame() {
     frame.commandBuffer->reset(vk::CommandBufferResetFlagBits::eReleaseResources, dispatcher);
     frame.commandBuffer->begin(vk::CommandBufferBeginInfo(vk::CommandBufferUsageFlagBits::eOneTimeSubmit), dispatcher);
 
-    backend.getThreadPool().runRenderJobs();
+    backend.runRenderJobs();
 }
 
 void Context::endFrame() {}
@@ -346,7 +377,7 @@ void Context::submitFrame() {
 #endif
 
     const auto& dispatcher = backend.getDispatcher();
-    const auto& frame = frameResources[frameResourceIndex];
+    auto& frame = frameResources[frameResourceIndex];
     frame.commandBuffer->end(dispatcher);
 
     const auto& device = backend.getDevice();
@@ -358,18 +389,36 @@ void Context::submitFrame() {
     const vk::PipelineStageFlags waitStageMask[] = {vk::PipelineStageFlagBits::eColorAttachmentOutput};
     auto submitInfo = vk::SubmitInfo().setCommandBuffers(frame.commandBuffer.get());
 
+    std::vector<vk::Semaphore> signalSemaphores;
+    // Binary semaphores ignore their value
+    std::vector<uint64_t> signalValues;
+
     if (platformSurface) {
-        submitInfo.setSignalSemaphores(renderableResource.getPresentSemaphore())
-            .setWaitSemaphores(renderableResource.getAcquireSemaphore())
-            .setWaitDstStageMask(waitStageMask);
+        signalSemaphores.push_back(renderableResource.getPresentSemaphore());
+        signalValues.push_back(0);
+        submitInfo.setWaitSemaphores(renderableResource.getAcquireSemaphore()).setWaitDstStageMask(waitStageMask);
     }
 
-    const vk::Result resetFenceResult = device->resetFences(1, &frame.flightFrameFence.get(), dispatcher);
-    if (resetFenceResult != vk::Result::eSuccess) {
-        mbgl::Log::Error(mbgl::Event::Render, "Reset fence failed");
+    auto timelineInfo = vk::TimelineSemaphoreSubmitInfoKHR();
+    if (frameTimeline) {
+        frame.timelineValue = ++frameTimelineValue;
+        signalSemaphores.push_back(frameTimeline.get());
+        signalValues.push_back(frame.timelineValue);
+        submitInfo.setPNext(&timelineInfo.setSignalSemaphoreValues(signalValues));
     }
 
-    graphicsQueue.submit(submitInfo, frame.flightFrameFence.get(), dispatcher);
+    submitInfo.setSignalSemaphores(signalSemaphores);
+
+    if (frameTimeline) {
+        graphicsQueue.submit(submitInfo, nullptr, dispatcher);
+    } else {
+        const vk::Result resetFenceResult = device->resetFences(1, &frame.flightFrameFence.get(), dispatcher);
+        if (resetFenceResult != vk::Result::eSuccess) {
+            mbgl::Log::Error(mbgl::Event::Render, "Reset fence failed");
+        }
+
+        graphicsQueue.submit(submitInfo, frame.flightFrameFence.get(), dispatcher);
+    }
 
     // present rendered frame
     if (platformSurface) {
@@ -393,6 +442,29 @@ void Context::submitFrame() {
     backend.endFrameCapture();
 }
 
+const vk::UniqueCommandBuffer& Context::acquireSecondaryCommandBuffer() {
+    MBGL_VERIFY_THREAD(tid);
+
+    auto& frame = frameResources[frameResourceIndex];
+    if (frame.usedSecondaryCommandBuffers == frame.secondaryCommandBuffers.size()) {
+        const auto& device = backend.getDevice();
+        const auto& dispatcher = backend.getDispatcher();
+
+        const vk::CommandPoolCreateInfo poolInfo(vk::CommandPoolCreateFlagBits::eTransient,
+                                                 static_cast<uint32_t>(backend.getGraphicsQueueIndex()));
+        auto pool = device->createCommandPoolUnique(poolInfo, nullptr, dispatcher);
+
+        const vk::CommandBufferAllocateInfo allocateInfo(pool.get(), vk::CommandBufferLevel::eSecondary, 1);
+        auto buffers = device->allocateCommandBuffersUnique(allocateInfo, dispatcher);
+
+        backend.setDebugName(buffers.front().get(),
+                             "SecondaryCommandBuffer_" + std::to_string(frame.secondaryCommandBuffers.size()));
+        frame.secondaryCommandBuffers.push_back({std::move(pool), std::move(buffers.front())});
+    }
+
+    return frame.secondaryCommandBuffers[frame.usedSecondaryCommandBuffers++].buffer;
+}
+
 std::unique_ptr<gfx::CommandEncoder> Context::createCommandEncoder() {
     const auto& frame = frameResources[frameResourceIndex];
     return std::make_unique<CommandEncoder>(*this, frame.commandBuffer);
@@ -414,8 +486,13 @@ UniqueShaderProgram Context::createProgram(shaders::BuiltIn shaderID,
 }
 
 void Context::performCleanup() {
+    trimOffscreenTexturePool();
     stats.numDrawCalls = 0;
+    stats.numTriangles = 0;
     ++stats.numFrames;
+    stats.frameUniformUpdateBytes = 0;
+    stats.numUniformBindings = 0;
+    stats.numDescriptorSetUpdates = 0;
 }
 
 gfx::UniqueDrawableBuilder Context::createDrawableBuilder(std::string name) {
@@ -526,6 +603,11 @@ void Context::bindGlobalUniformBuffers(gfx::RenderPass& renderPass) const noexce
     }
 
     context.globalUniformBuffers.bindDescriptorSets(renderPassImpl.getEncoder());
+    renderPassImpl.setGlobalUniformBuffers(&context.globalUniformBuffers);
+}
+
+void Context::unbindGlobalUniformBuffers(gfx::RenderPass& renderPass) const noexcept {
+    static_cast<RenderPass&>(renderPass).setGlobalUniformBuffers(nullptr);
 }
 
 bool Context::renderTileClippingMasks(gfx::RenderPass& renderPass,
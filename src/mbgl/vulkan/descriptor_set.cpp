@@ -7,8 +7,10 @@
 #include <mbgl/util/instrumentation.hpp>
 #include <mbgl/util/monotonic_timer.hpp>
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <iterator>
 
 #define USE_DESCRIPTOR_POOL_RESET
 
@@ -122,6 +124,38 @@ void DescriptorSet::allocate() {
     }
 
     dirty = std::vector(descriptorSets.size(), true);
+    // Sets reused from the pool hold whatever their previous owner wrote
+    writtenContent = std::vector<std::vector<WrittenDescriptor>>(descriptorSets.size());
+}
+
+void DescriptorSet::write(std::span<const vk::WriteDescriptorSet> writes) {
+    const uint8_t frameIndex = context.getCurrentFrameResourceIndex();
+    dirty[frameIndex] = false;
+
+    // Each write updates a single descriptor, at the binding of its index
+    const auto toWritten = [](const vk::WriteDescriptorSet& write) {
+        assert(write.descriptorCount == 1);
+        return WrittenDescriptor{
+            .type = write.descriptorType,
+            .bufferInfo = write.pBufferInfo ? *write.pBufferInfo : vk::DescriptorBufferInfo(),
+            .imageInfo = write.pImageInfo ? *write.pImageInfo : vk::DescriptorImageInfo(),
+        };
+    };
+
+    auto& written = writtenContent[frameIndex];
+    if (std::ranges::equal(written, writes, {}, {}, toWritten)) {
+        return;
+    }
+
+    const auto& backend = context.getBackend();
+    backend.getDevice()->updateDescriptorSets(
+        vk::ArrayProxy<const vk::WriteDescriptorSet>(static_cast<uint32_t>(writes.size()), writes.data()),
+        nullptr,
+        backend.getDispatcher());
+
+    written.clear();
+    std::ranges::transform(writes, std::back_inserter(written), toWritten);
+    context.renderingStats().numDescriptorSetUpdates++;
 }
 
 void DescriptorSet::markDirty() {
@@ -159,11 +193,16 @@ void UniformDescriptorSet::update(const gfx::UniformBufferArray& uniforms,
         return;
     }
 
-    const auto& backend = context.getBackend();
-    const auto& device = backend.getDevice();
+    const auto descriptorCount = descriptorStorageCount + descriptorUniformCount;
+
+    // Reserved up front, the writes point into it
+    std::vector<vk::DescriptorBufferInfo> bufferInfos;
+    bufferInfos.reserve(descriptorCount);
+    std::vector<vk::WriteDescriptorSet> writes;
+    writes.reserve(descriptorCount);
 
-    for (size_t index = 0; index < descriptorStorageCount + descriptorUniformCount; ++index) {
-        vk::DescriptorBufferInfo descriptorBufferInfo;
+    for (size_t index = 0; index < descriptorCount; ++index) {
+        auto& descriptorBufferInfo = bufferInfos.emplace_back();
 
         if (const auto& uniformBuffer = uniforms.get(descriptorStartIndex + index)) {
             const auto& uniformBufferImpl = static_cast<const UniformBuffer&>(*uniformBuffer);
@@ -179,17 +218,15 @@ void UniformDescriptorSet::update(const gfx::UniformBufferArray& uniforms,
         const auto descriptorType = index < descriptorStorageCount ? vk::DescriptorType::eStorageBuffer
                                                                    : vk::DescriptorType::eUniformBuffer;
 
-        const auto writeDescriptorSet = vk::WriteDescriptorSet()
-                                            .setBufferInfo(descriptorBufferInfo)
-                                            .setDescriptorCount(1)
-                                            .setDescriptorType(descriptorType)
-                                            .setDstBinding(static_cast<uint32_t>(index))
-                                            .setDstSet(descriptorSets[frameIndex]);
-
-        device->updateDescriptorSets(writeDescriptorSet, nullptr, backend.getDispatcher());
+        writes.push_back(vk::WriteDescriptorSet()
+                             .setBufferInfo(descriptorBufferInfo)
+                             .setDescriptorCount(1)
+                             .setDescriptorType(descriptorType)
+                             .setDstBinding(static_cast<uint32_t>(index))
+                             .setDstSet(descriptorSets[frameIndex]));
     }
 
-    dirty[frameIndex] = false;
+    write(writes);
 }
 
 ImageDescriptorSet::ImageDescriptorSet(Context& context_)
@@ -211,29 +248,27 @@ void ImageDescriptorSet::update(const std::array<gfx::Texture2DPtr, shaders::max
         return;
     }
 
-    const auto& backend = context.getBackend();
-    const auto& device = backend.getDevice();
+    std::array<vk::DescriptorImageInfo, shaders::maxTextureCountPerShader> imageInfos;
+    std::array<vk::WriteDescriptorSet, shaders::maxTextureCountPerShader> writes;
 
     for (size_t id = 0; id < shaders::maxTextureCountPerShader; ++id) {
         const auto& texture = id < textures.size() ? textures[id] : nullptr;
         auto& textureImpl = texture ? static_cast<Texture2D&>(*texture) : *context.getDummyTexture();
 
-        const auto descriptorImageInfo = vk::DescriptorImageInfo()
-                                             .setImageLayout(textureImpl.getVulkanImageLayout())
-                                             .setImageView(textureImpl.getVulkanImageView().get())
-                                             .setSampler(textureImpl.getVulkanSampler());
-
-        const auto writeDescriptorSet = vk::WriteDescriptorSet()
-                                            .setImageInfo(descriptorImageInfo)
-                                            .setDescriptorCount(1)
-                                            .setDescriptorType(vk::DescriptorType::eCombinedImageSampler)
-                                            .setDstBinding(static_cast<uint32_t>(id))
-                                            .setDstSet(descriptorSets[frameIndex]);
-
-        device->updateDescriptorSets(writeDescriptorSet, nullptr, backend.getDispatcher());
+        imageInfos[id] = vk::DescriptorImageInfo()
+                             .setImageLayout(textureImpl.getVulkanImageLayout())
+                             .setImageView(textureImpl.getVulkanImageView().get())
+                             .setSampler(textureImpl.getVulkanSampler());
+
+        writes[id] = vk::WriteDescriptorSet()
+                         .setImageInfo(imageInfos[id])
+                         .setDescriptorCount(1)
+                         .setDescriptorType(vk::DescriptorType::eCombinedImageSampler)
+                         .setDstBinding(static_cast<uint32_t>(id))
+                         .setDstSet(descriptorSets[frameIndex]);
     }
 
-    dirty[frameIndex] = false;
+    write(writes);
 }
 
 } // namespace vulkan
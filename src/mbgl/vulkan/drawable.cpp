@@ -239,28 +239,23 @@ void Drawable::upload(gfx::UploadPass& uploadPass_) {
 void Drawable::draw(PaintParameters& parameters) const {
     MLN_TRACE_FUNC();
 
-    if (isCustom) {
-        return;
+    if (prepare(parameters)) {
+        record(static_cast<RenderPass&>(*parameters.renderPass).getEncoder());
+    }
+}
+
+bool Drawable::prepare(PaintParameters& parameters) const {
+    MLN_TRACE_FUNC();
+
+    if (isCustom || !shader || impl->vulkanVertexBuffers.empty()) {
+        return false;
     }
 
     auto& context = static_cast<Context&>(parameters.context);
-    auto& dispatcher = context.getBackend().getDispatcher();
     auto& renderPass_ = static_cast<RenderPass&>(*parameters.renderPass);
-    auto& encoder = renderPass_.getEncoder();
-    auto& commandBuffer = encoder.getCommandBuffer();
-
     auto& shaderImpl = static_cast<mbgl::vulkan::ShaderProgram&>(*shader);
 
-    if (!bindAttributes(encoder)) return;
-    if (!bindDescriptors(encoder)) return;
-
-    commandBuffer->pushConstants(
-        context.getGeneralPipelineLayout().get(),
-        vk::ShaderStageFlags() | vk::ShaderStageFlagBits::eVertex | vk::ShaderStageFlagBits::eFragment,
-        0,
-        sizeof(uboIndex),
-        &uboIndex,
-        dispatcher);
+    updateDescriptors(context);
 
     if (enableDepth) {
         if (impl->depthFor3D.has_value()) {
@@ -289,21 +284,64 @@ void Drawable::draw(PaintParameters& parameters) const {
     }
 
     impl->pipelineInfo.setRenderable(renderPass_.getDescriptor().renderable);
+    impl->pipelineInfo.setScissorRect(parameters.scissorRect);
 
-    const auto instances = instanceAttributes ? instanceAttributes->getMinCount() : 1;
+    // update pipeline info with per segment modifiers
+    impl->segmentPipelines.clear();
+    for (const auto& seg : impl->segments) {
+        impl->pipelineInfo.setDrawMode(seg->getMode());
+        impl->segmentPipelines.push_back(shaderImpl.getPipeline(impl->pipelineInfo).get());
+    }
+
+    impl->batchedInstances = 1;
 
+    context.renderingStats().numDrawCalls += static_cast<int>(impl->segments.size());
+    const auto instances = instanceAttributes ? instanceAttributes->getMinCount() : 1;
     for (const auto& seg : impl->segments) {
-        const auto& segment = seg->getSegment();
+        if (seg->getMode().type == gfx::DrawModeType::Triangles) {
+            context.renderingStats().numTriangles += static_cast<int>(seg->getSegment().indexLength / 3 * instances);
+        }
+    }
 
-        // update pipeline info with per segment modifiers
-        impl->pipelineInfo.setDrawMode(seg->getMode());
+    return true;
+}
+
+bool Drawable::batchInstance(const gfx::Drawable& other) const {
+    if (!canBatchInstance(other, impl->batchedInstances)) {
+        return false;
+    }
+    impl->batchedInstances++;
+    return true;
+}
+
+void Drawable::record(CommandEncoder& encoder) const {
+    MLN_TRACE_FUNC();
 
-        impl->pipelineInfo.setScissorRect(parameters.scissorRect);
+    auto& context = encoder.getContext();
+    auto& dispatcher = context.getBackend().getDispatcher();
+    auto& commandBuffer = encoder.getCommandBuffer();
+
+    bindAttributes(encoder);
+    bindDescriptors(encoder);
+
+    commandBuffer->pushConstants(
+        context.getGeneralPipelineLayout().get(),
+        vk::ShaderStageFlags() | vk::ShaderStageFlagBits::eVertex | vk::ShaderStageFlagBits::eFragment,
+        0,
+        sizeof(uboIndex),
+        &uboIndex,
+        dispatcher);
+
+    const auto instances = instanceAttributes ? instanceAttributes->getMinCount() : impl->batchedInstances;
+
+    for (std::size_t i = 0; i < impl->segments.size(); ++i) {
+        const auto& seg = impl->segments[i];
+        const auto& segment = seg->getSegment();
 
+        impl->pipelineInfo.setDrawMode(seg->getMode());
         impl->pipelineInfo.setDynamicValues(context.getBackend(), commandBuffer);
 
-        const auto& pipeline = shaderImpl.getPipeline(impl->pipelineInfo);
-        commandBuffer->bindPipeline(vk::PipelineBindPoint::eGraphics, pipeline.get(), dispatcher);
+        commandBuffer->bindPipeline(vk::PipelineBindPoint::eGraphics, impl->segmentPipelines[i], dispatcher);
 
         if (segment.indexLength) {
             commandBuffer->drawIndexed(static_cast<uint32_t>(segment.indexLength),
@@ -319,8 +357,6 @@ void Drawable::draw(PaintParameters& parameters) const {
                                 0,
                                 dispatcher);
         }
-
-        context.renderingStats().numDrawCalls++;
     }
 }
 
@@ -412,11 +448,9 @@ void Drawable::buildVulkanInputBindings() {
     impl->pipelineInfo.updateVertexInputHash();
 }
 
-bool Drawable::bindAttributes(CommandEncoder& encoder) const {
+void Drawable::bindAttributes(CommandEncoder& encoder) const {
     MLN_TRACE_FUNC();
 
-    if (impl->vulkanVertexBuffers.empty()) return false;
-
     const auto& dispatcher = encoder.getContext().getBackend().getDispatcher();
     const auto& commandBuffer = encoder.getCommandBuffer();
 
@@ -429,23 +463,18 @@ bool Drawable::bindAttributes(CommandEncoder& encoder) const {
                 indexBufferResource.getVulkanBuffer(), 0, vk::IndexType::eUint16, dispatcher);
         }
     }
-
-    return true;
 }
 
-bool Drawable::bindDescriptors(CommandEncoder& encoder) const {
+void Drawable::updateDescriptors(Context& context) const {
     MLN_TRACE_FUNC();
 
-    if (!shader) return false;
-
-    // bind uniforms
-    impl->uniformBuffers.bindDescriptorSets(encoder);
+    impl->uniformBuffers.prepareDescriptorSets(context);
 
     const auto& shaderImpl = static_cast<const mbgl::vulkan::ShaderProgram&>(*shader);
     if (shaderImpl.hasTextures()) {
         // update image set
         if (!impl->imageDescriptorSet) {
-            impl->imageDescriptorSet = std::make_unique<ImageDescriptorSet>(encoder.getContext());
+            impl->imageDescriptorSet = std::make_unique<ImageDescriptorSet>(context);
         }
 
         for (const auto& texture : textures) {
@@ -458,10 +487,18 @@ bool Drawable::bindDescriptors(CommandEncoder& encoder) const {
         }
 
         impl->imageDescriptorSet->update(textures);
-        impl->imageDescriptorSet->bind(encoder);
     }
+}
 
-    return true;
+void Drawable::bindDescriptors(CommandEncoder& encoder) const {
+    MLN_TRACE_FUNC();
+
+    impl->uniformBuffers.bindPreparedDescriptorSets(encoder);
+
+    const auto& shaderImpl = static_cast<const mbgl::vulkan::ShaderProgram&>(*shader);
+    if (shaderImpl.hasTextures()) {
+        impl->imageDescriptorSet->bind(encoder);
+    }
 }
 
 void Drawable::uploadTextures(UploadPass&) const {
@@ -48,6 +48,9 @@ public:
     std::optional<gfx::StencilMode> stencilFor3D;
 
     PipelineInfo pipelineInfo;
+    // One per segment, looked up by `prepare`
+    std::vector<vk::Pipeline> segmentPipelines;
+    uint32_t batchedInstances = 1;
 
     std::vector<vk::Buffer> vulkanVertexBuffers;
     std::vector<vk::DeviceSize> vulkanVertexOffsets;
@@ -43,30 +43,47 @@ void LayerGroup::render(RenderOrchestrator&, PaintParameters& parameters) {
         return;
     }
 
-#if !defined(NDEBUG)
-    const auto debugGroup = parameters.encoder->createDebugGroup(getName() + "-render");
-#endif
-
     auto& renderPass = static_cast<RenderPass&>(*parameters.renderPass);
-    auto& encoder = renderPass.getEncoder();
 
-    bool bindUBOs = false;
+    std::vector<const Drawable*> drawables;
     visitDrawables([&](gfx::Drawable& drawable) {
         if (!drawable.getEnabled() || !drawable.hasRenderPass(parameters.pass)) {
             return;
         }
 
-        if (!bindUBOs) {
-            uniformBuffers.bindDescriptorSets(encoder);
-            bindUBOs = true;
-        }
-
         for (const auto& tweaker : drawable.getTweakers()) {
             tweaker->execute(drawable, parameters);
         }
 
-        drawable.draw(parameters);
+        const auto& drawableImpl = static_cast<const Drawable&>(drawable);
+        if (drawableImpl.prepare(parameters)) {
+            drawables.push_back(&drawableImpl);
+        }
     });
+
+    if (drawables.empty()) {
+        return;
+    }
+
+    uniformBuffers.prepareDescriptorSets(static_cast<Context&>(parameters.context));
+
+    auto record = [this, drawables = std::move(drawables)](CommandEncoder& encoder) {
+#if !defined(NDEBUG)
+        const auto debugGroup = encoder.createDebugGroup(getName() + "-render");
+#endif
+
+        uniformBuffers.bindPreparedDescriptorSets(encoder);
+
+        for (const auto* drawable : drawables) {
+            drawable->record(encoder);
+        }
+    };
+
+    if (renderPass.isRecordingInParallel()) {
+        renderPass.deferRecording(std::move(record));
+    } else {
+        record(renderPass.getEncoder());
+    }
 }
 
 } // namespace vulkan
@@ -3,7 +3,12 @@
 #include <mbgl/vulkan/command_encoder.hpp>
 #include <mbgl/vulkan/renderable_resource.hpp>
 #include <mbgl/vulkan/context.hpp>
+#include <mbgl/vulkan/uniform_buffer.hpp>
+#include <mbgl/util/instrumentation.hpp>
 #include <mbgl/util/logging.hpp>
+#include <mbgl/util/parallel_for.hpp>
+
+#include <cassert>
 
 namespace mbgl {
 namespace vulkan {
@@ -38,8 +43,28 @@ RenderPass::RenderPass(CommandEncoder& commandEncoder_, const char* name, const
 
     pushDebugGroup(name);
 
+    parallel = commandEncoder.getContext().getBackend().getParallelRecording();
+
     commandEncoder.getCommandBuffer()->beginRenderPass(
-        renderPassBeginInfo, vk::SubpassContents::eInline, commandEncoder.getContext().getBackend().getDispatcher());
+        renderPassBeginInfo,
+        parallel ? vk::SubpassContents::eSecondaryCommandBuffers : vk::SubpassContents::eInline,
+        commandEncoder.getContext().getBackend().getDispatcher());
+
+    if (parallel) {
+        inheritanceInfo.setRenderPass(resource.getRenderPass().get())
+            .setSubpass(0)
+            .setFramebuffer(resource.getFramebuffer().get());
+
+        // Only secondary command buffers may be used inside the pass now, so everything recorded through
+        // the encoder goes into one of those, up to the next deferred recording. Debug groups would not be
+        // balanced within those buffers and are left to the deferred recordings.
+        primaryCommandBuffer = commandEncoder.commandBuffer;
+        commandEncoder.debugGroups = false;
+        beginSecondaryCommandBuffer();
+
+        // Created on first use, which must not happen on a recording thread
+        (void)commandEncoder.getContext().getGeneralPipelineLayout();
+    }
 
     commandEncoder.context.performCleanup();
 }
@@ -51,7 +76,81 @@ RenderPass::~RenderPass() {
 }
 
 void RenderPass::endEncoding() {
-    commandEncoder.getCommandBuffer()->endRenderPass(commandEncoder.getContext().getBackend().getDispatcher());
+    const auto& dispatcher = commandEncoder.getContext().getBackend().getDispatcher();
+
+    if (parallel) {
+        commandEncoder.getCommandBuffer()->end(dispatcher);
+        recordDeferred();
+
+        commandEncoder.commandBuffer = primaryCommandBuffer;
+        commandEncoder.debugGroups = true;
+
+        std::vector<vk::CommandBuffer> commandBuffers;
+        commandBuffers.reserve(recordings.size());
+        for (const auto& recording : recordings) {
+            commandBuffers.push_back(recording.commandBuffer.get());
+        }
+        commandEncoder.getCommandBuffer()->executeCommands(commandBuffers, dispatcher);
+    }
+
+    commandEncoder.getCommandBuffer()->endRenderPass(dispatcher);
+}
+
+void RenderPass::deferRecording(std::function<void(CommandEncoder&)>&& record) {
+    assert(parallel);
+    const auto& dispatcher = commandEncoder.getContext().getBackend().getDispatcher();
+
+    commandEncoder.getCommandBuffer()->end(dispatcher);
+    recordings.push_back(
+        {commandEncoder.getContext().acquireSecondaryCommandBuffer(), std::move(record), globalUniformBuffers});
+    beginSecondaryCommandBuffer();
+}
+
+void RenderPass::beginSecondaryCommandBuffer() {
+    const auto& commandBuffer = commandEncoder.getContext().acquireSecondaryCommandBuffer();
+    recordings.push_back({commandBuffer, {}, globalUniformBuffers});
+
+    const auto beginInfo = vk::CommandBufferBeginInfo()
+                               .setFlags(vk::CommandBufferUsageFlagBits::eOneTimeSubmit |
+                                         vk::CommandBufferUsageFlagBits::eRenderPassContinue)
+                               .setPInheritanceInfo(&inheritanceInfo);
+    commandBuffer->begin(beginInfo, commandEncoder.getContext().getBackend().getDispatcher());
+    commandEncoder.commandBuffer = &commandBuffer;
+
+    if (globalUniformBuffers) {
+        globalUniformBuffers->bindPreparedDescriptorSets(commandEncoder);
+    }
+}
+
+void RenderPass::recordDeferred() {
+    MLN_TRACE_FUNC();
+
+    std::vector<const Recording*> deferred;
+    for (const auto& recording : recordings) {
+        if (recording.record) {
+            deferred.push_back(&recording);
+        }
+    }
+
+    auto& context = commandEncoder.getContext();
+    const auto& dispatcher = context.getBackend().getDispatcher();
+    const auto beginInfo = vk::CommandBufferBeginInfo()
+                               .setFlags(vk::CommandBufferUsageFlagBits::eOneTimeSubmit |
+                                         vk::CommandBufferUsageFlagBits::eRenderPassContinue)
+                               .setPInheritanceInfo(&inheritanceInfo);
+
+    util::parallelFor(deferred.size(), [&](std::size_t i) {
+        const auto& commandBuffer = deferred[i]->commandBuffer;
+        commandBuffer->begin(beginInfo, dispatcher);
+
+        CommandEncoder encoder(context, commandBuffer);
+        if (deferred[i]->globalUniformBuffers) {
+            deferred[i]->globalUniformBuffers->bindPreparedDescriptorSets(encoder);
+        }
+        deferred[i]->record(encoder);
+
+        commandBuffer->end(dispatcher);
+    });
 }
 
 void RenderPass::clearStencil(uint32_t value) const {
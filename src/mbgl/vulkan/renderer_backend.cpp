@@ -5,6 +5,7 @@
 #include <mbgl/gfx/backend_scope.hpp>
 #include <mbgl/gfx/shader_registry.hpp>
 #include <mbgl/shaders/shader_source.hpp>
+#include <mbgl/util/io.hpp>
 #include <mbgl/util/logging.hpp>
 
 #include <mbgl/shaders/vulkan/shader_group.hpp>
@@ -29,6 +30,7 @@
 #include <mbgl/shaders/vulkan/widevector.hpp>
 
 #include <cassert>
+#include <cstring>
 #include <string>
 
 #ifdef ENABLE_VULKAN_VALIDATION
@@ -107,6 +109,34 @@ bool checkAvailability(const std::vector<T>& availableValues,
     return true;
 }
 
+// Written ahead of the driver's data so a cache from another device or driver is never handed to
+// it, since not every driver copes with those
+struct PipelineCacheFileHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t vendorID;
+    uint32_t deviceID;
+    uint32_t driverVersion;
+    uint8_t pipelineCacheUUID[VK_UUID_SIZE];
+    uint64_t dataSize;
+};
+
+constexpr uint32_t pipelineCacheMagic = 0x4D4C5043; // "MLPC"
+constexpr uint32_t pipelineCacheVersion = 1;
+
+PipelineCacheFileHeader makePipelineCacheHeader(const vk::PhysicalDeviceProperties& properties, uint64_t dataSize) {
+    PipelineCacheFileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    header.magic = pipelineCacheMagic;
+    header.version = pipelineCacheVersion;
+    header.vendorID = properties.vendorID;
+    header.deviceID = properties.deviceID;
+    header.driverVersion = properties.driverVersion;
+    std::memcpy(header.pipelineCacheUUID, properties.pipelineCacheUUID.data(), VK_UUID_SIZE);
+    header.dataSize = dataSize;
+    return header;
+}
+
 } // namespace
 
 RendererBackend::RendererBackend(const gfx::ContextMode contextMode_)
@@ -400,6 +430,7 @@ void RendererBackend::init() {
     initAllocator();
     initSwapchain();
     initCommandPool();
+    initPipelineCache();
 }
 
 void RendererBackend::initInstance() {
@@ -506,7 +537,7 @@ void RendererBackend::initAllocator() {
 }
 
 void RendererBackend::initDevice() {
-    const auto& extensions = getDeviceExtensions();
+    auto extensions = getDeviceExtensions();
     const auto& layers = getLayers();
     const auto& surface = getDefaultRenderable().getResource<SurfaceRenderableResource>().getPlatformSurface().get();
 
@@ -596,11 +627,26 @@ void RendererBackend::initDevice() {
         mbgl::Log::Error(mbgl::Event::Render, "Feature not available: samplerAnisotropy");
     }
 
+    // Optional, frames are waited for with fences without it
+    timelineSemaphoreSupported = checkAvailability(
+        physicalDevice.enumerateDeviceExtensionProperties(nullptr, dispatcher),
+        {VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME},
+        [](const vk::ExtensionProperties& value) { return value.extensionName.data(); });
+    if (timelineSemaphoreSupported) {
+        extensions.push_back(VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME);
+    }
+
     auto createInfo = vk::DeviceCreateInfo()
                           .setQueueCreateInfos(queueCreateInfos)
                           .setPEnabledExtensionNames(extensions)
                           .setPEnabledFeatures(&physicalDeviceFeatures);
 
+    // The feature is required to be supported along with the extension
+    const auto timelineSemaphoreFeatures = vk::PhysicalDeviceTimelineSemaphoreFeaturesKHR().setTimelineSemaphore(true);
+    if (timelineSemaphoreSupported) {
+        createInfo.setPNext(&timelineSemaphoreFeatures);
+    }
+
     // this is not needed for newer implementations
     createInfo.setPEnabledLayerNames(layers);
 
@@ -614,7 +660,7 @@ void RendererBackend::initSwapchain() {
 
     // buffer resources if rendering to a surface
     // no buffering when using headless
-    maxFrames = renderableResource.getPlatformSurface() ? 2 : 1;
+    maxFrames = renderableResource.getPlatformSurface() ? framesInFlight : 1;
 
     renderableResource.init(size.width, size.height);
 
@@ -631,6 +677,53 @@ void RendererBackend::initCommandPool() {
     commandPool = device->createCommandPoolUnique(createInfo, nullptr, dispatcher);
 }
 
+void RendererBackend::initPipelineCache() {
+    std::string initialData;
+    if (!pipelineCachePath.empty()) {
+        const auto file = util::readFile(pipelineCachePath);
+        if (file && file->size() >= sizeof(PipelineCacheFileHeader)) {
+            PipelineCacheFileHeader header;
+            std::memcpy(&header, file->data(), sizeof(header));
+
+            const auto expected = makePipelineCacheHeader(physicalDeviceProperties,
+                                                          file->size() - sizeof(PipelineCacheFileHeader));
+            if (std::memcmp(&header, &expected, sizeof(header)) == 0) {
+                initialData = file->substr(sizeof(PipelineCacheFileHeader));
+            } else {
+                mbgl::Log::Info(mbgl::Event::Render, "Ignoring pipeline cache saved by another device or driver");
+            }
+        }
+    }
+
+    const auto createInfo = vk::PipelineCacheCreateInfo().setInitialDataSize(initialData.size()).setPInitialData(
+        initialData.data());
+    try {
+        pipelineCache = device->createPipelineCacheUnique(createInfo, nullptr, dispatcher);
+    } catch (const vk::SystemError& e) {
+        mbgl::Log::Warning(mbgl::Event::Render, std::string("Failed to load pipeline cache: ") + e.what());
+        pipelineCache = device->createPipelineCacheUnique(vk::PipelineCacheCreateInfo(), nullptr, dispatcher);
+    }
+    setDebugName(pipelineCache.get(), "PipelineCache");
+}
+
+void RendererBackend::savePipelineCache() const {
+    if (pipelineCachePath.empty() || !pipelineCache) {
+        return;
+    }
+
+    try {
+        const auto data = device->getPipelineCacheData(pipelineCache.get(), dispatcher);
+        const auto header = makePipelineCacheHeader(physicalDeviceProperties, data.size());
+
+        std::string file(sizeof(header) + data.size(), '\0');
+        std::memcpy(file.data(), &header, sizeof(header));
+        std::memcpy(file.data() + sizeof(header), data.data(), data.size());
+        util::write_file(pipelineCachePath, file);
+    } catch (const std::exception& e) {
+        mbgl::Log::Warning(mbgl::Event::Render, std::string("Failed to save pipeline cache: ") + e.what());
+    }
+}
+
 void RendererBackend::destroyResources() {
     if (device) device->waitIdle(dispatcher);
 
@@ -640,6 +733,9 @@ void RendererBackend::destroyResources() {
     context.reset();
     commandPool.reset();
 
+    savePipelineCache();
+    pipelineCache.reset();
+
     vmaDestroyAllocator(allocator);
     allocator = nullptr;
 
@@ -681,6 +777,7 @@ void RendererBackend::initShaders(gfx::ShaderRegistry& shaders, const ProgramPar
     registerTypes<shaders::BuiltIn::BackgroundShader,
                   shaders::BuiltIn::BackgroundPatternShader,
                   shaders::BuiltIn::CircleShader,
+                  shaders::BuiltIn::CircleInstancedShader,
                   shaders::BuiltIn::ClippingMaskProgram,
                   shaders::BuiltIn::CollisionBoxShader,
                   shaders::BuiltIn::CollisionCircleShader,
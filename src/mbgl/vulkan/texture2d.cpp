@@ -6,6 +6,7 @@
 #include <mbgl/vulkan/command_encoder.hpp>
 #include <mbgl/util/logging.hpp>
 
+#include <algorithm>
 #include <cmath>
 
 namespace mbgl {
@@ -412,12 +413,15 @@ void Texture2D::createSampler() {
                                  .setAddressModeV(addressModeV)
                                  .setAddressModeW(vk::SamplerAddressMode::eRepeat);
 
+    const auto& limits = backend.getDeviceProperties().limits;
     if (samplerState.mipmapped) {
-        samplerCreateInfo.setMipmapMode(vk::SamplerMipmapMode::eLinear);
+        samplerCreateInfo.setMipmapMode(vk::SamplerMipmapMode::eLinear)
+            .setMipLodBias(std::clamp(samplerState.lodBias, -limits.maxSamplerLodBias, limits.maxSamplerLodBias));
     }
 
     if (samplerState.maxAnisotropy != 1 && backend.getDeviceFeatures().samplerAnisotropy) {
-        samplerCreateInfo.setAnisotropyEnable(true).setMaxAnisotropy(samplerState.maxAnisotropy);
+        samplerCreateInfo.setAnisotropyEnable(true).setMaxAnisotropy(
+            std::min(static_cast<float>(samplerState.maxAnisotropy), limits.maxSamplerAnisotropy));
     }
 
     sampler = backend.getDevice()->createSampler(samplerCreateInfo, nullptr, backend.getDispatcher());
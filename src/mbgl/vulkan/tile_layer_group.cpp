@@ -45,7 +45,6 @@ void TileLayerGroup::render(RenderOrchestrator&, PaintParameters& parameters) {
     }
 
     auto& renderPass = static_cast<RenderPass&>(*parameters.renderPass);
-    auto& encoder = renderPass.getEncoder();
 
     // `stencilModeFor3D` uses a different stencil mask value each time its called, so if the
     // drawables in this layer use 3D stencil mode, we need to set it up here so that all the
@@ -69,10 +68,6 @@ void TileLayerGroup::render(RenderOrchestrator&, PaintParameters& parameters) {
         });
     }
 
-#if !defined(NDEBUG)
-    const auto debugGroupRender = parameters.encoder->createDebugGroup(getName() + "-render");
-#endif
-
     // If we're doing 3D stenciling and have any features to draw, set up the single-value stencil mask.
     // If we're doing 2D stenciling and have any drawables with tile IDs, render each tile into the stencil buffer with
     // a different value.
@@ -86,24 +81,23 @@ void TileLayerGroup::render(RenderOrchestrator&, PaintParameters& parameters) {
         parameters.renderTileClippingMasks(stencilTiles);
     }
 
-    bool bindUBOs = false;
+    std::vector<const Drawable*> drawables;
     visitDrawables([&](gfx::Drawable& drawable) {
         if (!drawable.getEnabled() || !drawable.hasRenderPass(parameters.pass)) {
             return;
         }
 
-        if (!bindUBOs) {
-            uniformBuffers.bindDescriptorSets(encoder);
-            bindUBOs = true;
-        }
-
         for (const auto& tweaker : drawable.getTweakers()) {
             tweaker->execute(drawable, parameters);
         }
 
-        if (features3d) {
-            auto& drawableImpl = static_cast<Drawable&>(drawable);
+        // Tiles that differ only in their drawable UBO are drawn as instances of the previous one
+        if (!drawables.empty() && drawables.back()->batchInstance(drawable)) {
+            return;
+        }
 
+        auto& drawableImpl = static_cast<Drawable&>(drawable);
+        if (features3d) {
             const auto& depth = drawableImpl.getEnableDepth() ? depthMode3d.value() : gfx::DepthMode::disabled();
             drawableImpl.setDepthModeFor3D(depth);
 
@@ -112,8 +106,34 @@ void TileLayerGroup::render(RenderOrchestrator&, PaintParameters& parameters) {
             drawableImpl.setStencilModeFor3D(stencil);
         }
 
-        drawable.draw(parameters);
+        if (drawableImpl.prepare(parameters)) {
+            drawables.push_back(&drawableImpl);
+        }
     });
+
+    if (drawables.empty()) {
+        return;
+    }
+
+    uniformBuffers.prepareDescriptorSets(static_cast<Context&>(parameters.context));
+
+    auto record = [this, drawables = std::move(drawables)](CommandEncoder& encoder) {
+#if !defined(NDEBUG)
+        const auto debugGroup = encoder.createDebugGroup(getName() + "-render");
+#endif
+
+        uniformBuffers.bindPreparedDescriptorSets(encoder);
+
+        for (const auto* drawable : drawables) {
+            drawable->record(encoder);
+        }
+    };
+
+    if (renderPass.isRecordingInParallel()) {
+        renderPass.deferRecording(std::move(record));
+    } else {
+        record(renderPass.getEncoder());
+    }
 }
 
 } // namespace vulkan
@@ -37,6 +37,7 @@ void UniformBuffer::update(const void* data, std::size_t dataSize) {
 
     buffer.getContext().renderingStats().numUniformUpdates++;
     buffer.getContext().renderingStats().uniformUpdateBytes += dataSize;
+    buffer.getContext().renderingStats().frameUniformUpdateBytes += dataSize;
     buffer.update(data, dataSize, /*offset=*/0);
 }
 
@@ -74,14 +75,19 @@ void UniformBufferArray::bind(gfx::RenderPass& renderPass) {
 }
 
 void UniformBufferArray::bindDescriptorSets(CommandEncoder& encoder) {
+    prepareDescriptorSets(encoder.getContext());
+    bindPreparedDescriptorSets(encoder);
+}
+
+void UniformBufferArray::prepareDescriptorSets(Context& context) {
     if (!descriptorSet) {
-        descriptorSet = std::make_unique<UniformDescriptorSet>(encoder.getContext(), descriptorSetType);
+        descriptorSet = std::make_unique<UniformDescriptorSet>(context, descriptorSetType);
     }
 
     descriptorSet->update(*this, descriptorStartIndex, descriptorStorageCount, descriptorUniformCount);
 
-    const auto frameCount = encoder.getContext().getBackend().getMaxFrames();
-    const int32_t currentIndex = encoder.getContext().getCurrentFrameResourceIndex();
+    const auto frameCount = context.getBackend().getMaxFrames();
+    const int32_t currentIndex = context.getCurrentFrameResourceIndex();
     const int32_t prevIndex = currentIndex == 0 ? frameCount - 1 : currentIndex - 1;
 
     for (uint32_t i = 0; i < descriptorStorageCount + descriptorUniformCount; ++i) {
@@ -93,8 +99,12 @@ void UniformBufferArray::bindDescriptorSets(CommandEncoder& encoder) {
 
         auto& buff = static_cast<UniformBuffer*>(uniformBufferVector[index].get())->mutableBufferResource();
         buff.updateVulkanBuffer(currentIndex, prevIndex);
+        context.renderingStats().numUniformBindings++;
     }
+}
 
+void UniformBufferArray::bindPreparedDescriptorSets(CommandEncoder& encoder) {
+    assert(descriptorSet);
     descriptorSet->bind(encoder);
 }
 
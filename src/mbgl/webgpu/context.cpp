@@ -53,7 +53,9 @@ Context::Context(RendererBackend& backend_)
       backend(backend_),
       globalUniformBuffers(std::make_unique<UniformBufferArray>()) {}
 
-Context::~Context() = default;
+Context::~Context() {
+    clearOffscreenTexturePool();
+}
 
 void Context::beginFrame() {
     // Begin a new frame - WebGPU command recording starts here
@@ -65,10 +67,15 @@ void Context::endFrame() {
 
 void Context::performCleanup() {
     // Clean up unused resources
+    trimOffscreenTexturePool();
+    stats.frameUniformUpdateBytes = 0;
+    stats.numUniformBindings = 0;
+    stats.numRenderBundleReplays = 0;
 }
 
 void Context::reduceMemoryUsage() {
     // Free cached resources to reduce memory
+    clearOffscreenTexturePool();
 }
 
 std::unique_ptr<gfx::OffscreenTexture> Context::createOffscreenTexture(Size size,
@@ -233,6 +233,86 @@ namespace {
 }
 #endif // !defined(NDEBUG)
 
+bool sameBindGroupEntries(const std::vector<WGPUBindGroupEntry>& a, const std::vector<WGPUBindGroupEntry>& b) {
+    return std::equal(a.begin(), a.end(), b.begin(), b.end(), [](const auto& x, const auto& y) {
+        return x.binding == y.binding && x.buffer == y.buffer && x.offset == y.offset && x.size == y.size &&
+               x.sampler == y.sampler && x.textureView == y.textureView;
+    });
+}
+
+// The render pass and the render bundle encoders take the same draw commands
+void setPipeline(WGPURenderPassEncoder encoder, WGPURenderPipeline pipeline) {
+    wgpuRenderPassEncoderSetPipeline(encoder, pipeline);
+}
+void setPipeline(WGPURenderBundleEncoder encoder, WGPURenderPipeline pipeline) {
+    wgpuRenderBundleEncoderSetPipeline(encoder, pipeline);
+}
+void setVertexBuffer(
+    WGPURenderPassEncoder encoder, uint32_t slot, WGPUBuffer buffer, uint64_t offset, uint64_t size) {
+    wgpuRenderPassEncoderSetVertexBuffer(encoder, slot, buffer, offset, size);
+}
+void setVertexBuffer(
+    WGPURenderBundleEncoder encoder, uint32_t slot, WGPUBuffer buffer, uint64_t offset, uint64_t size) {
+    wgpuRenderBundleEncoderSetVertexBuffer(encoder, slot, buffer, offset, size);
+}
+void setIndexBuffer(
+    WGPURenderPassEncoder encoder, WGPUBuffer buffer, WGPUIndexFormat format, uint64_t offset, uint64_t size) {
+    wgpuRenderPassEncoderSetIndexBuffer(encoder, buffer, format, offset, size);
+}
+void setIndexBuffer(
+    WGPURenderBundleEncoder encoder, WGPUBuffer buffer, WGPUIndexFormat format, uint64_t offset, uint64_t size) {
+    wgpuRenderBundleEncoderSetIndexBuffer(encoder, buffer, format, offset, size);
+}
+void setBindGroup(WGPURenderPassEncoder encoder,
+                  uint32_t index,
+                  WGPUBindGroup group,
+                  size_t dynamicOffsetCount,
+                  const uint32_t* dynamicOffsets) {
+    wgpuRenderPassEncoderSetBindGroup(encoder, index, group, dynamicOffsetCount, dynamicOffsets);
+}
+void setBindGroup(WGPURenderBundleEncoder encoder,
+                  uint32_t index,
+                  WGPUBindGroup group,
+                  size_t dynamicOffsetCount,
+                  const uint32_t* dynamicOffsets) {
+    wgpuRenderBundleEncoderSetBindGroup(encoder, index, group, dynamicOffsetCount, dynamicOffsets);
+}
+void drawIndexed(WGPURenderPassEncoder encoder,
+                 uint32_t indexCount,
+                 uint32_t instanceCount,
+                 uint32_t firstIndex,
+                 int32_t baseVertex,
+                 uint32_t firstInstance) {
+    wgpuRenderPassEncoderDrawIndexed(encoder, indexCount, instanceCount, firstIndex, baseVertex, firstInstance);
+}
+void drawIndexed(WGPURenderBundleEncoder encoder,
+                 uint32_t indexCount,
+                 uint32_t instanceCount,
+                 uint32_t firstIndex,
+                 int32_t baseVertex,
+                 uint32_t firstInstance) {
+    wgpuRenderBundleEncoderDrawIndexed(encoder, indexCount, instanceCount, firstIndex, baseVertex, firstInstance);
+}
+
+template <typename Encoder>
+void encodeDraw(Encoder encoder, const Drawable::Impl& impl) {
+    setPipeline(encoder, impl.pipelineState);
+    for (std::size_t slot = 0; slot < impl.vertexBuffers.size(); ++slot) {
+        const auto& binding = impl.vertexBuffers[slot];
+        setVertexBuffer(encoder, static_cast<uint32_t>(slot), binding.buffer, binding.offset, binding.size);
+    }
+    if (impl.indexBuffer) {
+        // Always use Uint16 format for now
+        setIndexBuffer(encoder, impl.indexBuffer, WGPUIndexFormat_Uint16, 0, impl.indexBufferSize);
+    }
+    for (const auto& record : impl.bindGroups) {
+        setBindGroup(encoder, record.slot, record.handle, 0, nullptr);
+    }
+    for (const auto& command : impl.drawCommands) {
+        drawIndexed(encoder, command.indexCount, command.instanceCount, command.firstIndex, command.baseVertex, 0);
+    }
+}
+
 } // namespace
 
 void Drawable::setColorMode(const gfx::ColorMode& value) {
@@ -433,11 +513,25 @@ void Drawable::upload(gfx::UploadPass& uploadPass) {
 }
 
 void Drawable::draw(PaintParameters& parameters) const {
+    if (isCustom || !prepare(parameters)) {
+        return;
+    }
+
+    auto& webgpuRenderPass = static_cast<webgpu::RenderPass&>(*parameters.renderPass);
+    webgpuRenderPass.setScissorRect(parameters.scissorRect);
+    if (impl->stencilReference) {
+        wgpuRenderPassEncoderSetStencilReference(webgpuRenderPass.getEncoder(), *impl->stencilReference);
+    }
+    encode(webgpuRenderPass.getEncoder());
+    parameters.context.renderingStats().numDrawCalls += static_cast<int>(impl->drawCommands.size());
+}
+
+bool Drawable::prepare(PaintParameters& parameters) const {
     static int drawCallCount = 0;
     drawCallCount++;
 
     if (isCustom) {
-        return;
+        return false;
     }
 
     // Get WebGPU context and render pass (following Metal's pattern)
@@ -447,17 +541,17 @@ void Drawable::draw(PaintParameters& parameters) const {
     if (!renderPassEncoder) {
         Log::Error(Event::Render, "No render pass encoder available");
         assert(false);
-        return;
+        return false;
     }
 
     if (!shader) {
         Log::Warning(Event::General, "Missing shader for drawable " + util::toString(getID()) + "/" + getName());
         assert(false);
-        return;
+        return false;
     }
 
     if (!getEnabled()) {
-        return;
+        return false;
     }
 
     // Get WebGPU backend and device
@@ -466,7 +560,7 @@ void Drawable::draw(PaintParameters& parameters) const {
     WGPUQueue queue = static_cast<WGPUQueue>(backend.getQueue());
 
     if (!device || !queue) {
-        return;
+        return false;
     }
 
 #if !defined(NDEBUG)
@@ -485,7 +579,7 @@ void Drawable::draw(PaintParameters& parameters) const {
     // Check index buffer is valid (like Metal does)
     if (impl->indexes && (!impl->indexes->getBuffer() || impl->indexes->getDirty())) {
         assert(!"Index buffer not uploaded");
-        return;
+        return false;
     }
 
     // Build bind groups based on shader metadata
@@ -494,13 +588,7 @@ void Drawable::draw(PaintParameters& parameters) const {
         if (webgpuShader) {
             WGPUDevice deviceHandle = static_cast<WGPUDevice>(backend.getDevice());
 
-            for (auto& record : impl->bindGroups) {
-                if (record.handle) {
-                    wgpuBindGroupRelease(record.handle);
-                }
-            }
-            impl->bindGroups.clear();
-
+            std::vector<Impl::BindGroupRecord> bindGroups;
             if (deviceHandle) {
                 const auto& groupOrder = webgpuShader->getBindGroupOrder();
                 static bool loggedBindGroupOrder = false;
@@ -604,6 +692,7 @@ void Drawable::draw(PaintParameters& parameters) const {
                                 entry.buffer = webgpuUniform->getBuffer();
                                 entry.offset = 0;
                                 entry.size = buffer->getSize();
+                                context.renderingStats().numUniformBindings++;
                                 break;
                             }
                             case ShaderProgram::BindingType::Sampler: {
@@ -651,6 +740,18 @@ void Drawable::draw(PaintParameters& parameters) const {
                         continue;
                     }
 
+                    // Reuse the bind group of the previous draw if nothing changed, so a recorded bundle stays valid
+                    const auto cached = std::find_if(
+                        impl->bindGroups.begin(), impl->bindGroups.end(), [&](const Impl::BindGroupRecord& record) {
+                            return record.handle && record.slot == slot && record.layout == layout &&
+                                   sameBindGroupEntries(record.entries, entries);
+                        });
+                    if (cached != impl->bindGroups.end()) {
+                        bindGroups.push_back(std::move(*cached));
+                        cached->handle = nullptr;
+                        continue;
+                    }
+
                     const std::string label = getName() + " bind-group " + std::to_string(group);
                     WGPUStringView labelView = {label.c_str(), label.length()};
 
@@ -661,9 +762,16 @@ void Drawable::draw(PaintParameters& parameters) const {
                     descriptor.entries = entries.data();
 
                     WGPUBindGroup bindGroup = wgpuDeviceCreateBindGroup(deviceHandle, &descriptor);
-                    impl->bindGroups.push_back({static_cast<uint32_t>(slot), group, bindGroup});
+                    bindGroups.push_back({static_cast<uint32_t>(slot), group, bindGroup, layout, std::move(entries)});
+                }
+            }
+
+            for (auto& record : impl->bindGroups) {
+                if (record.handle) {
+                    wgpuBindGroupRelease(record.handle);
                 }
             }
+            impl->bindGroups = std::move(bindGroups);
         }
     }
 
@@ -828,34 +936,12 @@ void Drawable::draw(PaintParameters& parameters) const {
         }
     }
 
-    if (impl->pipelineState) {
-        if (!renderPassEncoder) {
-            Log::Error(Event::Render, "renderPassEncoder is null!");
-            return;
-        }
-        wgpuRenderPassEncoderSetPipeline(renderPassEncoder, impl->pipelineState);
-        if (getEnableStencil()) {
-            wgpuRenderPassEncoderSetStencilReference(renderPassEncoder, static_cast<uint32_t>(stencilMode.ref));
-        }
-    } else {
+    if (!impl->pipelineState) {
         Log::Warning(Event::Render, "WebGPU: no pipeline available for drawable '" + getName() + "'; draw skipped");
-        return;
-    }
-
-    // Clamp scissor to the current render pass size (not the default renderable,
-    // which may be different during offscreen passes like hillshade prepare).
-    {
-        const auto& webgpuRP = static_cast<const webgpu::RenderPass&>(*parameters.renderPass);
-        const auto rtSize = webgpuRP.getDescriptor().renderable.getSize();
-        const uint32_t sx = static_cast<uint32_t>(parameters.scissorRect.x);
-        const uint32_t sy = static_cast<uint32_t>(parameters.scissorRect.y);
-        const uint32_t sw = (sx < rtSize.width) ? std::min(parameters.scissorRect.width, rtSize.width - sx) : 0;
-        const uint32_t sh = (sy < rtSize.height) ? std::min(parameters.scissorRect.height, rtSize.height - sy) : 0;
-        if (sw > 0 && sh > 0) {
-            wgpuRenderPassEncoderSetScissorRect(renderPassEncoder, sx, sy, sw, sh);
-        }
+        return false;
     }
 
+    impl->vertexBuffers.clear();
     uint32_t bufferSlot = 0;
     for (const auto& binding : uniqueBindings) {
         if (!binding.buffer || !binding.buffer->getBuffer()) {
@@ -870,15 +956,14 @@ void Drawable::draw(PaintParameters& parameters) const {
             continue;
         }
 
-        wgpuRenderPassEncoderSetVertexBuffer(renderPassEncoder,
-                                             bufferSlot,
-                                             binding.buffer->getBuffer(),
-                                             binding.baseOffset,
-                                             bufferSize - binding.baseOffset);
+        impl->vertexBuffers.push_back(
+            {binding.buffer->getBuffer(), binding.baseOffset, bufferSize - binding.baseOffset});
         bufferSlot++;
     }
 
     // Bind index buffer if present
+    impl->indexBuffer = nullptr;
+    impl->indexBufferSize = 0;
     if (impl->indexes && impl->indexes->elements() > 0 && !impl->indexes->getDirty()) {
         // Get the buffer from indexes
         if (const auto* indexBufferBase = impl->indexes->getBuffer()) {
@@ -887,29 +972,22 @@ void Drawable::draw(PaintParameters& parameters) const {
                     const auto& indexBufferRes = webgpuIndexBuffer->buffer->getResource<IndexBufferResource>();
                     const auto& bufferResource = indexBufferRes.getBuffer();
                     if (bufferResource.getBuffer()) {
-                        // Always use Uint16 format for now
-                        WGPUIndexFormat indexFormat = WGPUIndexFormat_Uint16;
-                        wgpuRenderPassEncoderSetIndexBuffer(renderPassEncoder,
-                                                            bufferResource.getBuffer(),
-                                                            indexFormat,
-                                                            0,
-                                                            bufferResource.getSizeInBytes());
+                        impl->indexBuffer = bufferResource.getBuffer();
+                        impl->indexBufferSize = bufferResource.getSizeInBytes();
                     }
                 }
             }
         }
     }
 
-    // Set bind group
-    for (const auto& record : impl->bindGroups) {
-        if (record.handle) {
-            wgpuRenderPassEncoderSetBindGroup(renderPassEncoder, record.slot, record.handle, 0, nullptr);
-        }
-    }
-
     // Handle depth and stencil states (like Metal does)
     // For 3D mode, stenciling is handled by the layer group
-    if (!is3D) {
+    impl->stencilReference.reset();
+    if (is3D) {
+        if (getEnableStencil()) {
+            impl->stencilReference = static_cast<uint32_t>(stencilMode.ref);
+        }
+    } else {
         if (enableStencil) {
             if (tileID) {
                 const auto expectedStencil = parameters.stencilModeForClipping(tileID->toUnwrapped());
@@ -922,11 +1000,13 @@ void Drawable::draw(PaintParameters& parameters) const {
                         "WebGPU drawable stencil mismatch for '" + getName() + "' tile=" + util::toString(*tileID));
                 }
 #endif
-                wgpuRenderPassEncoderSetStencilReference(renderPassEncoder, static_cast<uint32_t>(expectedStencil.ref));
+                impl->stencilReference = static_cast<uint32_t>(expectedStencil.ref);
+            } else {
+                impl->stencilReference = static_cast<uint32_t>(stencilMode.ref);
             }
         } else {
             // Reset the reference so subsequent drawables that re-enable stencilling start from a known value.
-            wgpuRenderPassEncoderSetStencilReference(renderPassEncoder, 0u);
+            impl->stencilReference = 0u;
         }
 
         if (getEnableDepth()) {
@@ -939,39 +1019,54 @@ void Drawable::draw(PaintParameters& parameters) const {
     }
 
     // Draw indexed geometry - loop through segments (exactly like Metal does)
-    // int segmentCount = 0;
+    impl->drawCommands.clear();
     for (const auto& seg_ : impl->segments) {
         const auto& segment = static_cast<DrawSegment&>(*seg_);
         const auto& mlSegment = segment.getSegment();
         if (mlSegment.indexLength > 0) {
             const uint32_t instanceCount = instanceAttributes ? static_cast<uint32_t>(instanceAttributes->getMinCount())
                                                               : 1;
-            const uint32_t indexOffset = static_cast<uint32_t>(mlSegment.indexOffset);
-            const int32_t baseVertex = static_cast<int32_t>(mlSegment.vertexOffset);
-            const uint32_t baseInstance = 0;
-
-            // Check if encoder is valid before drawing
-            if (!renderPassEncoder) {
-                Log::Error(Event::Render, "Render pass encoder became null before draw!");
-                return;
-            }
+            impl->drawCommands.push_back({static_cast<uint32_t>(mlSegment.indexLength),
+                                          instanceCount,
+                                          static_cast<uint32_t>(mlSegment.indexOffset),
+                                          static_cast<int32_t>(mlSegment.vertexOffset)});
+        }
+    }
 
-            // Make sure we have valid indices
-            if (mlSegment.indexLength == 0) {
-                Log::Warning(Event::Render, "Skipping draw with 0 indices");
-                continue;
-            }
+    // Everything a render bundle records, which excludes the stencil reference and the scissor
+    std::size_t hash = util::hash(impl->pipelineState, impl->indexBuffer, impl->indexBufferSize);
+    for (const auto& record : impl->bindGroups) {
+        util::hash_combine(hash, util::hash(record.slot, record.handle));
+    }
+    for (const auto& binding : impl->vertexBuffers) {
+        util::hash_combine(hash, util::hash(binding.buffer, binding.offset, binding.size));
+    }
+    for (const auto& command : impl->drawCommands) {
+        util::hash_combine(
+            hash, util::hash(command.indexCount, command.instanceCount, command.firstIndex, command.baseVertex));
+    }
+    impl->commandHash = hash;
+    return true;
+}
 
-            wgpuRenderPassEncoderDrawIndexed(renderPassEncoder,
-                                             static_cast<uint32_t>(mlSegment.indexLength), // indexCount
-                                             instanceCount,                                // instanceCount
-                                             indexOffset,                                  // firstIndex
-                                             baseVertex,                                   // baseVertex
-                                             baseInstance);                                // firstInstance
+void Drawable::encode(WGPURenderPassEncoder encoder) const {
+    encodeDraw(encoder, *impl);
+}
 
-            context.renderingStats().numDrawCalls++;
-        }
-    }
+void Drawable::encode(WGPURenderBundleEncoder encoder) const {
+    encodeDraw(encoder, *impl);
+}
+
+std::size_t Drawable::getCommandHash() const {
+    return impl->commandHash;
+}
+
+std::optional<uint32_t> Drawable::getStencilReference() const {
+    return impl->stencilReference;
+}
+
+std::size_t Drawable::getDrawCallCount() const {
+    return impl->drawCommands.size();
 }
 
 void Drawable::setIndexData(gfx::IndexVectorBasePtr indices, std::vector<UniqueDrawSegment> segments) {
@@ -17,6 +17,7 @@
 
 #include <cstdint>
 #include <memory>
+#include <optional>
 #include <vector>
 
 namespace mbgl {
@@ -64,12 +65,34 @@ public:
     gfx::StencilMode previousStencilMode;
 
     // WebGPU-specific resources needed for rendering
+    // Bind groups are kept while their layout and entries stay the same
     struct BindGroupRecord {
         uint32_t slot = 0;
         uint32_t group = 0;
         WGPUBindGroup handle = nullptr;
+        WGPUBindGroupLayout layout = nullptr;
+        std::vector<WGPUBindGroupEntry> entries;
     };
     std::vector<BindGroupRecord> bindGroups;
+
+    // The commands of the prepared draw
+    struct VertexBufferBinding {
+        WGPUBuffer buffer = nullptr;
+        uint64_t offset = 0;
+        uint64_t size = 0;
+    };
+    struct DrawCommand {
+        uint32_t indexCount = 0;
+        uint32_t instanceCount = 0;
+        uint32_t firstIndex = 0;
+        int32_t baseVertex = 0;
+    };
+    std::vector<VertexBufferBinding> vertexBuffers;
+    WGPUBuffer indexBuffer = nullptr;
+    uint64_t indexBufferSize = 0;
+    std::vector<DrawCommand> drawCommands;
+    std::optional<uint32_t> stencilReference;
+    std::size_t commandHash = 0;
 };
 
 // WebGPU-specific DrawSegment inheriting from the base gfx::Drawable::DrawSegment
@@ -12,8 +12,10 @@
 #include <mbgl/webgpu/renderer_backend.hpp>
 #include <mbgl/webgpu/renderable_resource.hpp>
 #include <mbgl/gfx/command_encoder.hpp>
+#include <mbgl/gfx/scissor_rect.hpp>
 #include <mbgl/util/logging.hpp>
 
+#include <algorithm>
 #include <cstring> // for strlen
 #include <cstdlib> // for std::getenv
 
@@ -242,6 +244,19 @@ WGPURenderPassEncoder RenderPass::getEncoder() const {
     return impl->encoder;
 }
 
+void RenderPass::setScissorRect(const gfx::ScissorRect& rect) {
+    // Clamp to the current render pass size (not the default renderable,
+    // which may be different during offscreen passes like hillshade prepare).
+    const auto rtSize = descriptor.renderable.getSize();
+    const uint32_t sx = static_cast<uint32_t>(rect.x);
+    const uint32_t sy = static_cast<uint32_t>(rect.y);
+    const uint32_t sw = (sx < rtSize.width) ? std::min(rect.width, rtSize.width - sx) : 0;
+    const uint32_t sh = (sy < rtSize.height) ? std::min(rect.height, rtSize.height - sy) : 0;
+    if (impl->encoder && sw > 0 && sh > 0) {
+        wgpuRenderPassEncoderSetScissorRect(impl->encoder, sx, sy, sw, sh);
+    }
+}
+
 void RenderPass::setGlobalUniformBuffers(const gfx::UniformBufferArray* buffers) {
     impl->globalUniformBuffers = buffers;
 }
@@ -10,10 +10,13 @@
 #include <mbgl/webgpu/context.hpp>
 #include <mbgl/webgpu/drawable.hpp>
 #include <mbgl/webgpu/render_pass.hpp>
+#include <mbgl/webgpu/renderer_backend.hpp>
 #include <mbgl/renderer/paint_parameters.hpp>
 #include <mbgl/util/convert.hpp>
+#include <mbgl/util/hash.hpp>
 #include <mbgl/util/logging.hpp>
 
+#include <algorithm>
 #include <optional>
 
 namespace mbgl {
@@ -22,6 +25,12 @@ namespace webgpu {
 TileLayerGroup::TileLayerGroup(int32_t layerIndex_, std::size_t initialCapacity, std::string name_)
     : mbgl::TileLayerGroup(layerIndex_, initialCapacity, std::move(name_)) {}
 
+TileLayerGroup::~TileLayerGroup() {
+    for (auto& bundles : renderBundles) {
+        releaseRenderBundles(bundles);
+    }
+}
+
 void TileLayerGroup::upload(gfx::UploadPass& uploadPass) {
     if (!enabled || !getDrawableCount()) {
         return;
@@ -78,6 +87,12 @@ void TileLayerGroup::render(RenderOrchestrator&, PaintParameters& parameters) {
         parameters.renderTileClippingMasks(stencilTiles);
     }
 
+    auto& backend = static_cast<RendererBackend&>(parameters.context.getBackend());
+    std::size_t commandHash = util::hash(&renderPass.getDescriptor().renderable,
+                                         static_cast<uint32_t>(backend.getColorFormat()),
+                                         static_cast<uint32_t>(backend.getDepthStencilFormat()));
+    std::vector<const Drawable*> prepared;
+
     // Rely on drawables to provide their shaders; no layer-level override needed.
     bool bindUBOs = false;
     int visitCount = 0;
@@ -131,9 +146,46 @@ void TileLayerGroup::render(RenderOrchestrator&, PaintParameters& parameters) {
             drawableWebGPU.setStencilModeFor3D(stencil);
         }
 
-        drawable.draw(parameters);
+        if (drawableWebGPU.prepare(parameters)) {
+            prepared.push_back(&drawableWebGPU);
+            util::hash_combine(commandHash,
+                               util::hash(drawableWebGPU.getCommandHash(), drawableWebGPU.getStencilReference()));
+        }
     });
 
+    // Replay the drawables' commands if they're the same as in the previous frame, recording them the first time.
+    // Commands that changed are drawn directly, so layers that change every frame don't pay for the recording.
+    auto& bundles = getRenderBundles(parameters.pass);
+    if (bundles.commandHash == commandHash && bundles.runs.empty() && !prepared.empty()) {
+        recordRenderBundles(bundles, prepared, parameters);
+    }
+
+    const auto encoder = renderPass.getEncoder();
+    auto& stats = parameters.context.renderingStats();
+    renderPass.setScissorRect(parameters.scissorRect);
+    if (bundles.commandHash == commandHash && !bundles.runs.empty()) {
+        for (const auto& run : bundles.runs) {
+            if (run.stencilReference) {
+                wgpuRenderPassEncoderSetStencilReference(encoder, *run.stencilReference);
+            }
+            wgpuRenderPassEncoderExecuteBundles(encoder, 1, &run.bundle);
+            stats.numRenderBundleReplays++;
+        }
+        stats.numDrawCalls += static_cast<int>(bundles.drawCallCount);
+    } else {
+        if (bundles.commandHash != commandHash) {
+            releaseRenderBundles(bundles);
+            bundles.commandHash = commandHash;
+        }
+        for (const auto* drawable : prepared) {
+            if (const auto reference = drawable->getStencilReference()) {
+                wgpuRenderPassEncoderSetStencilReference(encoder, *reference);
+            }
+            drawable->encode(encoder);
+            stats.numDrawCalls += static_cast<int>(drawable->getDrawCallCount());
+        }
+    }
+
     const auto finalDrawCalls = parameters.context.renderingStats().numDrawCalls;
     if (drawCount > 0 && finalDrawCalls == initialDrawCalls) {
         mbgl::Log::Warning(
@@ -142,5 +194,81 @@ void TileLayerGroup::render(RenderOrchestrator&, PaintParameters& parameters) {
     }
 }
 
+TileLayerGroup::RenderBundles& TileLayerGroup::getRenderBundles(mbgl::RenderPass pass) {
+    const auto it = std::find_if(
+        renderBundles.begin(), renderBundles.end(), [&](const RenderBundles& bundles) { return bundles.pass == pass; });
+    if (it != renderBundles.end()) {
+        return *it;
+    }
+    renderBundles.push_back({pass});
+    return renderBundles.back();
+}
+
+void TileLayerGroup::recordRenderBundles(RenderBundles& bundles,
+                                         const std::vector<const Drawable*>& drawables,
+                                         PaintParameters& parameters) {
+    auto& backend = static_cast<RendererBackend&>(parameters.context.getBackend());
+    const auto device = static_cast<WGPUDevice>(backend.getDevice());
+    if (!device) {
+        return;
+    }
+
+    // The attachments of the pipelines the drawables were prepared with
+    auto colorFormat = static_cast<WGPUTextureFormat>(backend.getColorFormat());
+    if (colorFormat == WGPUTextureFormat_Undefined) {
+        colorFormat = WGPUTextureFormat_BGRA8Unorm;
+    }
+    const std::string label = getName() + " render bundle";
+    WGPURenderBundleEncoderDescriptor encoderDescriptor = {};
+    encoderDescriptor.label = {label.c_str(), label.length()};
+    encoderDescriptor.colorFormatCount = 1;
+    encoderDescriptor.colorFormats = &colorFormat;
+    encoderDescriptor.depthStencilFormat = static_cast<WGPUTextureFormat>(backend.getDepthStencilFormat());
+    encoderDescriptor.sampleCount = 1;
+
+    // Drawables without a stencil reference don't test the stencil, so they join any run
+    for (auto begin = drawables.begin(); begin != drawables.end();) {
+        std::optional<uint32_t> stencilReference;
+        auto end = begin;
+        for (; end != drawables.end(); ++end) {
+            const auto reference = (*end)->getStencilReference();
+            if (reference && stencilReference && *reference != *stencilReference) {
+                break;
+            }
+            if (reference) {
+                stencilReference = reference;
+            }
+        }
+
+        const auto encoder = wgpuDeviceCreateRenderBundleEncoder(device, &encoderDescriptor);
+        if (!encoder) {
+            releaseRenderBundles(bundles);
+            return;
+        }
+        for (auto it = begin; it != end; ++it) {
+            (*it)->encode(encoder);
+            bundles.drawCallCount += (*it)->getDrawCallCount();
+        }
+        WGPURenderBundleDescriptor bundleDescriptor = {};
+        bundleDescriptor.label = {label.c_str(), label.length()};
+        const auto bundle = wgpuRenderBundleEncoderFinish(encoder, &bundleDescriptor);
+        wgpuRenderBundleEncoderRelease(encoder);
+        if (!bundle) {
+            releaseRenderBundles(bundles);
+            return;
+        }
+        bundles.runs.push_back({stencilReference, bundle});
+        begin = end;
+    }
+}
+
+void TileLayerGroup::releaseRenderBundles(RenderBundles& bundles) {
+    for (const auto& run : bundles.runs) {
+        wgpuRenderBundleRelease(run.bundle);
+    }
+    bundles.runs.clear();
+    bundles.drawCallCount = 0;
+}
+
 } // namespace webgpu
 } // namespace mbgl
@@ -81,6 +81,11 @@ void UniformBuffer::update(const void* data, std::size_t dataSize) {
         WGPUQueue queue = static_cast<WGPUQueue>(backend.getQueue());
         if (queue) {
             wgpuQueueWriteBuffer(queue, buffer, 0, data, dataSize);
+
+            auto& stats = context.renderingStats();
+            stats.numUniformUpdates++;
+            stats.uniformUpdateBytes += dataSize;
+            stats.frameUniformUpdateBytes += dataSize;
         }
     }
 }
@@ -67,9 +67,12 @@ std::unique_ptr<gfx::VertexBufferResource> UploadPass::createVertexBufferResourc
     return std::make_unique<VertexBufferResource>(std::move(buffer));
 }
 
-void UploadPass::updateVertexBufferResource(gfx::VertexBufferResource& resource, const void* data, std::size_t size) {
+void UploadPass::updateVertexBufferResource(gfx::VertexBufferResource& resource,
+                                            const void* data,
+                                            std::size_t size,
+                                            std::size_t offset) {
     auto& buffer = static_cast<VertexBufferResource&>(resource);
-    buffer.update(data, size);
+    buffer.update(data, size, offset);
 }
 
 std::unique_ptr<gfx::IndexBufferResource> UploadPass::createIndexBufferResource(const void* data,
@@ -108,7 +111,17 @@ const gfx::UniqueVertexBufferResource& UploadPass::getBuffer(const gfx::VertexVe
 
             if (rawBufSize <= resource.getSizeInBytes()) {
                 if (forceUpdate || vec->isModifiedAfter(resource.getLastUpdated())) {
-                    updateVertexBufferResource(resource, rawBufPtr, rawBufSize);
+                    const auto range = forceUpdate ? std::nullopt : vec->getModifiedRange();
+                    if (!range) {
+                        updateVertexBufferResource(resource, rawBufPtr, rawBufSize, /*offset=*/0);
+                    } else if (range->second > range->first) {
+                        // Only upload the span that changed
+                        updateVertexBufferResource(resource,
+                                                   static_cast<const uint8_t*>(rawBufPtr) + range->first,
+                                                   range->second - range->first,
+                                                   range->first);
+                    }
+                    vec->clearModifiedRange();
                     resource.setLastUpdated(vec->getLastModified());
                 }
                 return rawData->resource;
@@ -118,6 +131,7 @@ const gfx::UniqueVertexBufferResource& UploadPass::getBuffer(const gfx::VertexVe
             auto buffer_ = std::make_unique<VertexBuffer>();
             buffer_->resource = createVertexBufferResource(rawBufPtr, rawBufSize, usage, /*persistent=*/false);
             vec->setBuffer(std::move(buffer_));
+            vec->clearModifiedRange();
             return static_cast<VertexBuffer*>(vec->getBuffer())->resource;
         }
     }
@@ -4,11 +4,13 @@
 #include <mbgl/test/util.hpp>
 #include <mbgl/util/run_loop.hpp>
 
+#include <array>
 #include <chrono>
 #include <functional>
 #include <future>
 #include <memory>
 #include <thread>
+#include <vector>
 
 using namespace mbgl;
 using namespace std::chrono_literals;
@@ -266,6 +268,88 @@ TEST(Actor, NonConcurrentMailbox) {
     endedFuture.wait();
 }
 
+TEST(Actor, ConcurrentSenders) {
+    // Messages sent from several threads at once all arrive, in order for each sender.
+
+    struct TestActor {
+        std::vector<int> last;
+        int received = 0;
+
+        TestActor(ActorRef<TestActor>, std::size_t senders)
+            : last(senders, -1) {}
+
+        void receive(std::size_t sender, int i) {
+            EXPECT_EQ(last[sender] + 1, i);
+            last[sender] = i;
+            received++;
+        }
+
+        int count() const { return received; }
+    };
+
+    constexpr std::size_t senders = 4;
+    constexpr int messages = 1000;
+    Actor<TestActor> test(Scheduler::GetBackground(), senders);
+
+    std::vector<std::thread> threads;
+    for (std::size_t sender = 0; sender < senders; ++sender) {
+        threads.emplace_back([ref = test.self(), sender]() mutable {
+            for (int i = 0; i < messages; ++i) {
+                ref.invoke(&TestActor::receive, sender, i);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(static_cast<int>(senders) * messages, test.self().ask(&TestActor::count).get());
+}
+
+TEST(Actor, SmallMessagesDontAllocate) {
+    // Messages are stored in their mailbox's slab while it has room
+
+    struct TestActor {
+        int received = 0;
+
+        void receive(int) { received++; }
+        void receiveLarge(std::array<char, 256>) { received++; }
+        int count() const { return received; }
+    };
+
+    {
+        TestActor object;
+        auto mailbox = std::make_shared<Mailbox>();
+        ActorRef<TestActor> ref(object, mailbox);
+
+        for (std::size_t i = 0; i < actor::MessageSlab::blockCount; ++i) {
+            ref.invoke(&TestActor::receive, 1);
+        }
+        EXPECT_EQ(0u, mailbox->messageSlab().overflows());
+
+        // The slab is full, as nothing received the messages
+        ref.invoke(&TestActor::receive, 1);
+        EXPECT_EQ(1u, mailbox->messageSlab().overflows());
+    }
+
+    const auto scheduler = Scheduler::GetBackground();
+    TestActor object;
+    auto mailbox = std::make_shared<Mailbox>(*scheduler);
+    ActorRef<TestActor> ref(object, mailbox);
+    for (int i = 1; i <= 100; ++i) {
+        ref.invoke(&TestActor::receive, i);
+        EXPECT_EQ(i, ref.ask(&TestActor::count).get());
+    }
+    EXPECT_EQ(0u, mailbox->messageSlab().overflows());
+
+    ref.invoke(&TestActor::receiveLarge, std::array<char, 256>{});
+    EXPECT_EQ(101, ref.ask(&TestActor::count).get());
+    EXPECT_EQ(1u, mailbox->messageSlab().overflows());
+
+    // Wait for the last message to be done with the object
+    mailbox->close();
+}
+
 TEST(Actor, Ask) {
     // Asking for a result
 
@@ -2,6 +2,7 @@
 #include <mbgl/algorithm/update_tile_masks.hpp>
 
 #include <algorithm>
+#include <vector>
 
 using namespace mbgl;
 
@@ -115,3 +116,28 @@ TEST(UpdateTileMasks, Complex) {
         {UnwrappedTileID{14, 4114, 5825}, TileMask{CanonicalTileID{0, 0, 0}}},
     });
 }
+
+TEST(UpdateTileMasks, Incremental) {
+    // Tiles appearing and disappearing below and beside others, as while panning and zooming
+    const std::vector<std::vector<UnwrappedTileID>> frames = {
+        {{0, 0, 0}, {1, 0, 1}, {4, 4, 4}},
+        {{0, 0, 0}, {1, 0, 1}, {2, 1, 0}, {4, 4, 4}},
+        {{0, 0, 0}, {2, 1, 0}, {3, 3, 3}, {4, 4, 4}},
+        {{0, 0, 0}, {2, 1, 0}, {3, 3, 3}, UnwrappedTileID{1, {0, 0, 0}}, UnwrappedTileID{1, {1, 1, 1}}},
+        {{1, 1, 1}, {2, 1, 0}, {3, 3, 3}, UnwrappedTileID{1, {0, 0, 0}}},
+        {},
+        {{0, 0, 0}, {4, 4, 4}},
+    };
+
+    algorithm::TileMaskCache cache;
+    for (const auto& frame : frames) {
+        std::map<UnwrappedTileID, FakeTile> expected;
+        for (const auto& id : frame) {
+            expected.emplace(id, TileMask{});
+        }
+        auto actual = expected;
+        algorithm::updateTileMasks(expected);
+        algorithm::updateTileMasks(actual, cache);
+        EXPECT_EQ(expected, actual);
+    }
+}
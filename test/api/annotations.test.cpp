@@ -180,6 +180,22 @@ TEST(Annotations, AddMultiple) {
     test.checkRendering("add_multiple");
 }
 
+TEST(Annotations, AddMultipleBatched) {
+    AnnotationTest test;
+
+    test.map.getStyle().loadJSON(util::read_file("test/fixtures/api/empty.json"));
+    test.map.addAnnotationImage(namedMarker("default_marker"));
+    const auto ids = test.map.addAnnotations({SymbolAnnotation{Point<double>{-10, 0}, "default_marker"},
+                                              SymbolAnnotation{Point<double>{10, 0}, "default_marker"},
+                                              LineAnnotation{LineString<double>{{0, 0}, {45, 45}}}});
+    ASSERT_EQ(3u, ids.size());
+
+    test.frontend.render(test.map);
+
+    test.map.removeAnnotations({ids[2]});
+    test.checkRendering("add_multiple");
+}
+
 TEST(Annotations, NonImmediateAdd) {
     AnnotationTest test;
 
@@ -176,6 +176,55 @@ public:
     void deinitialize() override {}
 };
 
+class FillUpdateTestDrawableLayer : public mbgl::style::CustomDrawableLayerHost {
+public:
+    void initialize() override {}
+
+    void update(Interface& interface) override {
+        using namespace mbgl;
+
+        // the same fill as above, in place of the square built in the first update
+        if (interface.getDrawableCount()) {
+            GeometryCollection geometry{
+                {
+                    {static_cast<int16_t>(util::EXTENT * 0.1f), static_cast<int16_t>(util::EXTENT * 0.2f)},
+                    {static_cast<int16_t>(util::EXTENT * 0.5f), static_cast<int16_t>(util::EXTENT * 0.5f)},
+                    {static_cast<int16_t>(util::EXTENT * 0.7f), static_cast<int16_t>(util::EXTENT * 0.5f)},
+                    {static_cast<int16_t>(util::EXTENT * 0.5f), static_cast<int16_t>(util::EXTENT * 1.0f)},
+                    {static_cast<int16_t>(util::EXTENT * 0.0f), static_cast<int16_t>(util::EXTENT * 0.5f)},
+                    {static_cast<int16_t>(util::EXTENT * 0.1f), static_cast<int16_t>(util::EXTENT * 0.2f)},
+                },
+                {
+                    {static_cast<int16_t>(util::EXTENT * 0.1f), static_cast<int16_t>(util::EXTENT * 0.25f)},
+                    {static_cast<int16_t>(util::EXTENT * 0.15f), static_cast<int16_t>(util::EXTENT * 0.5f)},
+                    {static_cast<int16_t>(util::EXTENT * 0.25f), static_cast<int16_t>(util::EXTENT * 0.45f)},
+                    {static_cast<int16_t>(util::EXTENT * 0.1f), static_cast<int16_t>(util::EXTENT * 0.25f)},
+                },
+            };
+            updated = interface.updateFill(fillID, Interface::prepareFill(geometry));
+            return;
+        }
+
+        interface.setTileID({11, 327, 791});
+        interface.setFillOptions({/*color=*/Color::green(), /*opacity=*/0.5f});
+
+        const std::vector<GeometryCollection> geometries{{{
+            {0, 0},
+            {static_cast<int16_t>(util::EXTENT / 4), 0},
+            {static_cast<int16_t>(util::EXTENT / 4), static_cast<int16_t>(util::EXTENT / 4)},
+            {0, 0},
+        }}};
+        fillID = interface.addFills(geometries).front();
+
+        interface.finish();
+    }
+
+    void deinitialize() override {}
+
+    mbgl::util::SimpleIdentity fillID;
+    bool updated = false;
+};
+
 class SymbolIconTestDrawableLayer : public mbgl::style::CustomDrawableLayerHost {
 public:
     void initialize() override {}
@@ -282,6 +331,33 @@ TEST(CustomDrawableLayer, Fill) {
     test::checkImage("test/fixtures/custom_drawable_layer/fill", frontend.render(map).image, 0.000657, 0.1);
 }
 
+TEST(CustomDrawableLayer, FillUpdatedInPlace) {
+    using namespace mbgl;
+    using namespace mbgl::style;
+
+    util::RunLoop loop;
+
+    HeadlessFrontend frontend{1};
+    Map map(frontend,
+            MapObserver::nullObserver(),
+            MapOptions().withMapMode(MapMode::Static).withSize(frontend.getSize()),
+            ResourceOptions().withCachePath(":memory:").withAssetPath("test/fixtures/api/assets"));
+
+    map.getStyle().loadJSON(util::read_file("test/fixtures/api/simple.json"));
+    map.jumpTo(CameraOptions().withCenter(LatLng{37.8, -122.4426032}).withZoom(10.0));
+
+    auto host = std::make_unique<FillUpdateTestDrawableLayer>();
+    const auto& layer = *host;
+    map.getStyle().addLayer(std::make_unique<CustomDrawableLayer>("custom-drawable", std::move(host)));
+
+    // the first render builds the fill, the second one replaces its vertices
+    frontend.render(map);
+    EXPECT_FALSE(layer.updated);
+    const auto image = frontend.render(map).image;
+    EXPECT_TRUE(layer.updated);
+    test::checkImage("test/fixtures/custom_drawable_layer/fill", image, 0.000657, 0.1);
+}
+
 TEST(CustomDrawableLayer, SymbolIcon) {
     using namespace mbgl;
     using namespace mbgl::style;
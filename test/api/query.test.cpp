@@ -113,6 +113,21 @@ TEST(Query, QueryRenderedFeaturesFilterLayer) {
     EXPECT_EQ(features4.size(), 1u);
 }
 
+TEST(Query, QueryRenderedFeaturesLimit) {
+    QueryTest test;
+
+    auto zz = test.map.pixelForLatLng({0, 0});
+
+    auto features1 = test.frontend.getRenderer()->queryRenderedFeatures(zz, {{}, {}, 2});
+    EXPECT_EQ(features1.size(), 2u);
+
+    auto features2 = test.frontend.getRenderer()->queryRenderedFeatures(zz, {{}, {}, 10});
+    EXPECT_EQ(features2.size(), 4u);
+
+    auto features3 = test.frontend.getRenderer()->queryRenderedFeatures(zz, {{{"layer1"}}, {}, 0});
+    EXPECT_EQ(features3.size(), 0u);
+}
+
 TEST(Query, QueryRenderedFeaturesFilter) {
     using namespace mbgl::style::expression::dsl;
 
@@ -155,6 +170,25 @@ TEST(Query, QuerySourceFeatureStates) {
     ASSERT_EQ(newState, states);
 }
 
+TEST(Query, QuerySourceFeatureStatesBatched) {
+    QueryTest test;
+
+    FeatureState hovered;
+    hovered["hover"] = true;
+    FeatureState selected;
+    selected["selected"] = true;
+    test.frontend.getRenderer()->setFeatureStates("source1", {}, {{"feature1", hovered}, {"feature2", selected}});
+    test.frontend.render(test.map);
+
+    FeatureState states1;
+    test.frontend.getRenderer()->getFeatureState(states1, "source1", {}, "feature1");
+    ASSERT_EQ(hovered, states1);
+
+    FeatureState states2;
+    test.frontend.getRenderer()->getFeatureState(states2, "source1", {}, "feature2");
+    ASSERT_EQ(selected, states2);
+}
+
 TEST(Query, QuerySourceFeaturesOptionValidation) {
     QueryTest test;
 
@@ -189,6 +223,18 @@ TEST(Query, QuerySourceFeaturesFilter) {
     EXPECT_EQ(features3.size(), 1u);
 }
 
+TEST(Query, QuerySourceFeaturesBounds) {
+    QueryTest test;
+
+    const auto around = LatLngBounds::hull({-1, -1}, {1, 1});
+    auto features1 = test.frontend.getRenderer()->querySourceFeatures("source4", {{}, {}, around, true});
+    EXPECT_EQ(features1.size(), 1u);
+
+    const auto aside = LatLngBounds::hull({1, 1}, {2, 2});
+    auto features2 = test.frontend.getRenderer()->querySourceFeatures("source4", {{}, {}, aside});
+    EXPECT_EQ(features2.size(), 0u);
+}
+
 TEST(Query, QueryFeatureExtensionsInvalidExtension) {
     QueryTest test;
 
@@ -29,3 +29,35 @@ TEST(LineAtlas, Random) {
         }
     }
 }
+
+TEST(LineAtlas, SharedRows) {
+    LineAtlas atlas;
+    EXPECT_TRUE(atlas.isEmpty());
+
+    const auto& square = atlas.getDashPatternTexture({1, 2}, {1, 2}, LinePatternCap::Square);
+    const auto& round = atlas.getDashPatternTexture({3, 4}, {5, 6}, LinePatternCap::Round);
+    EXPECT_EQ(&square, &atlas.getDashPatternTexture({1, 2}, {1, 2}, LinePatternCap::Square));
+    EXPECT_EQ(square.getSize(), round.getSize());
+    EXPECT_EQ(atlas.getAtlasImageForTests().size, square.getSize());
+    EXPECT_EQ(256u, square.getSize().width);
+
+    // Each pattern takes its rows and a copy of its edge rows on each side
+    const float height = static_cast<float>(square.getSize().height);
+    EXPECT_FLOAT_EQ(1.5f / height, square.getFrom().y);
+    EXPECT_FLOAT_EQ(1.0f / height, square.getFrom().height);
+    EXPECT_FLOAT_EQ(3.0f, square.getFrom().width);
+    EXPECT_EQ(square.getFrom().y, square.getTo().y);
+    EXPECT_FLOAT_EQ((3.0f + 1.0f + 7.5f) / height, round.getFrom().y);
+    EXPECT_FLOAT_EQ((3.0f + 17.0f + 1.0f + 7.5f) / height, round.getTo().y);
+    EXPECT_FLOAT_EQ(15.0f / height, round.getTo().height);
+    EXPECT_FLOAT_EQ(11.0f, round.getTo().width);
+
+    // Positions follow the atlas as it grows
+    for (float i = 1; i <= 8; ++i) {
+        atlas.getDashPatternTexture({i, 1}, {i, 1}, LinePatternCap::Round);
+    }
+    const float grown = static_cast<float>(square.getSize().height);
+    EXPECT_GT(grown, height);
+    EXPECT_FLOAT_EQ(1.5f / grown, square.getFrom().y);
+    EXPECT_FLOAT_EQ((3.0f + 1.0f + 7.5f) / grown, round.getFrom().y);
+}
@@ -0,0 +1,55 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/gfx/polyline_segments.hpp>
+
+using namespace mbgl;
+using namespace mbgl::gfx;
+
+TEST(PolylineSegments, NormalsAndLengths) {
+    const GeometryCoordinates line{{0, 0}, {3, 4}, {3, 4}, {3, -6}, {-2, -6}};
+
+    PolylineSegments segments;
+    segments.compute(line, 0, line.size());
+
+    EXPECT_EQ(5.0, segments.length(0));
+    EXPECT_DOUBLE_EQ(-0.8, segments.normal(0).x);
+    EXPECT_DOUBLE_EQ(0.6, segments.normal(0).y);
+
+    // A repeated coordinate makes a segment of length zero, with a zero normal
+    EXPECT_EQ(0.0, segments.length(1));
+    EXPECT_EQ(0.0, segments.normal(1).x);
+    EXPECT_EQ(0.0, segments.normal(1).y);
+
+    EXPECT_EQ(10.0, segments.length(2));
+    EXPECT_EQ(1.0, segments.normal(2).x);
+    EXPECT_EQ(0.0, segments.normal(2).y);
+
+    EXPECT_EQ(5.0, segments.length(3));
+    EXPECT_EQ(0.0, segments.normal(3).x);
+    EXPECT_EQ(-1.0, segments.normal(3).y);
+}
+
+TEST(PolylineSegments, SameAsScalar) {
+    GeometryCoordinates line;
+    for (int i = 0; i < 41; ++i) {
+        line.emplace_back(static_cast<int16_t>((i * 7919) % 8192 - 128),
+                          static_cast<int16_t>((i * i * 31) % 8400 - 200));
+        if (i % 5 == 0) {
+            line.push_back(line.back());
+        }
+    }
+
+    // Both even and odd runs, from different starting points
+    for (std::size_t begin = 0; begin < 3; ++begin) {
+        for (std::size_t end = begin; end <= line.size(); end += 3) {
+            PolylineSegments vectorized;
+            PolylineSegments scalar;
+            vectorized.compute(line, begin, end);
+            scalar.computeScalar(line, begin, end);
+            for (std::size_t i = begin; i + 1 < end; ++i) {
+                EXPECT_EQ(scalar.normal(i), vectorized.normal(i)) << begin << " " << end << " " << i;
+                EXPECT_EQ(scalar.length(i), vectorized.length(i)) << begin << " " << end << " " << i;
+            }
+        }
+    }
+}
@@ -0,0 +1,101 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/gfx/fill_generator.hpp>
+#include <mbgl/gfx/triangulation_cache.hpp>
+
+using namespace mbgl;
+using namespace mbgl::gfx;
+
+TEST(TriangulationCache, Scope) {
+    EXPECT_EQ(nullptr, TriangulationCache::current(0));
+
+    TriangulationCache cache;
+    {
+        const TriangulationCache::Scope scope(&cache, "water");
+        auto* feature = TriangulationCache::current(3);
+        ASSERT_NE(nullptr, feature);
+        EXPECT_EQ(feature, TriangulationCache::current(3));
+        EXPECT_NE(feature, TriangulationCache::current(4));
+        {
+            const TriangulationCache::Scope disabled(nullptr, "water");
+            EXPECT_EQ(nullptr, TriangulationCache::current(3));
+        }
+        {
+            const TriangulationCache::Scope other(&cache, "landuse");
+            EXPECT_NE(feature, TriangulationCache::current(3));
+        }
+        EXPECT_EQ(feature, TriangulationCache::current(3));
+    }
+    EXPECT_EQ(nullptr, TriangulationCache::current(3));
+}
+
+TEST(TriangulationCache, Feature) {
+    TriangulationCache::Feature feature;
+    EXPECT_EQ(nullptr, feature.find(0, 4));
+
+    feature.insert(1, 4, {0, 1, 2, 0, 2, 3});
+    EXPECT_EQ(nullptr, feature.find(0, 4));
+    ASSERT_NE(nullptr, feature.find(1, 4));
+    EXPECT_EQ((std::vector<uint16_t>{0, 1, 2, 0, 2, 3}), *feature.find(1, 4));
+
+    // A different vertex count means the geometry changed
+    EXPECT_EQ(nullptr, feature.find(1, 5));
+}
+
+TEST(TriangulationCache, Serialize) {
+    TriangulationCache cache;
+    {
+        const TriangulationCache::Scope scope(&cache, "water");
+        TriangulationCache::current(3)->insert(1, 4, {0, 1, 2, 0, 2, 3});
+    }
+    const auto data = cache.serialize();
+
+    TriangulationCache loaded;
+    ASSERT_TRUE(loaded.load(data));
+    EXPECT_FALSE(loaded.empty());
+    EXPECT_EQ(data, loaded.serialize());
+    {
+        const TriangulationCache::Scope scope(&loaded, "water");
+        const auto* feature = TriangulationCache::current(3);
+        EXPECT_EQ(nullptr, feature->find(0, 4));
+        ASSERT_NE(nullptr, feature->find(1, 4));
+        EXPECT_EQ((std::vector<uint16_t>{0, 1, 2, 0, 2, 3}), *feature->find(1, 4));
+    }
+
+    // Truncated or otherwise damaged data leaves the cache as it was
+    TriangulationCache damaged;
+    EXPECT_FALSE(damaged.load(std::string_view(data).substr(0, data.size() - 1)));
+    EXPECT_FALSE(damaged.load(data + "x"));
+    EXPECT_FALSE(damaged.load({}));
+    EXPECT_TRUE(damaged.empty());
+}
+
+TEST(TriangulationCache, GenerateFillBuffers) {
+    const GeometryCollection geometry{{{0, 0}, {0, 40}, {40, 40}, {40, 0}, {0, 0}},
+                                      {{50, 0}, {50, 10}, {60, 10}, {60, 0}, {50, 0}}};
+
+    const auto generate = [&](TriangulationCache::Feature* triangulations) {
+        gfx::VertexVector<FillLayoutVertex> vertices;
+        gfx::IndexVector<gfx::Triangles> indexes;
+        SegmentVector segments;
+        generateFillBuffers(geometry, vertices, indexes, segments, triangulations);
+        return indexes.vector();
+    };
+
+    TriangulationCache::Feature feature;
+    const auto uncached = generate(nullptr);
+    EXPECT_EQ(nullptr, feature.find(0, 5));
+
+    // The first pass fills the cache in, the next ones produce the same indices from it
+    EXPECT_EQ(uncached, generate(&feature));
+    ASSERT_NE(nullptr, feature.find(0, 5));
+    ASSERT_NE(nullptr, feature.find(1, 5));
+    EXPECT_EQ(uncached, generate(&feature));
+
+    // Cached indices are used as they are
+    feature.insert(1, 5, {0, 1, 2});
+    const auto reused = generate(&feature);
+    ASSERT_EQ(uncached.size() - uncached.size() / 2 + 3, reused.size());
+    EXPECT_EQ((std::vector<uint16_t>(uncached.begin(), uncached.begin() + uncached.size() / 2)),
+              (std::vector<uint16_t>(reused.begin(), reused.end() - 3)));
+}
@@ -0,0 +1,61 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/gfx/index_vector.hpp>
+#include <mbgl/gfx/vertex_vector.hpp>
+
+using namespace mbgl;
+using namespace mbgl::gfx;
+
+namespace {
+
+struct StubVertexBuffer : VertexBufferBase {};
+struct StubIndexBuffer : IndexBufferBase {};
+
+} // namespace
+
+TEST(VertexVector, DiscardUploadedData) {
+    VertexVector<float> vertices;
+    vertices.emplace_back(1.0f);
+    vertices.emplace_back(2.0f);
+
+    // Nothing to discard before the upload
+    vertices.discardUploadedData();
+    EXPECT_FALSE(vertices.isDiscarded());
+
+    // Nor while modifications remain to be uploaded
+    vertices.setBuffer(std::make_unique<StubVertexBuffer>());
+    vertices.discardUploadedData();
+    EXPECT_FALSE(vertices.isDiscarded());
+
+    vertices.clearModifiedRange();
+    vertices.discardUploadedData();
+    EXPECT_TRUE(vertices.isDiscarded());
+    EXPECT_EQ(2u, vertices.elements());
+    EXPECT_EQ(2u, vertices.getRawCount());
+    EXPECT_EQ(2 * sizeof(float), vertices.bytes());
+    EXPECT_TRUE(vertices.vector().empty());
+    EXPECT_EQ(0u, vertices.getMemoryUsage().cpu);
+    EXPECT_EQ(2 * sizeof(float), vertices.getMemoryUsage().gpu);
+
+    vertices.clear();
+    EXPECT_FALSE(vertices.isDiscarded());
+    EXPECT_EQ(0u, vertices.elements());
+}
+
+TEST(IndexVector, DiscardUploadedData) {
+    IndexVector<Triangles> indexes;
+    indexes.emplace_back(0, 1, 2);
+
+    indexes.setBuffer(std::make_unique<StubIndexBuffer>());
+    indexes.discardUploadedData();
+    EXPECT_FALSE(indexes.isDiscarded());
+
+    indexes.setDirty(false);
+    indexes.discardUploadedData();
+    EXPECT_TRUE(indexes.isDiscarded());
+    EXPECT_EQ(3u, indexes.elements());
+    EXPECT_EQ(3 * sizeof(uint16_t), indexes.bytes());
+    EXPECT_FALSE(indexes.empty());
+    EXPECT_TRUE(indexes.vector().empty());
+    EXPECT_EQ(0u, indexes.getMemoryUsage().cpu);
+}
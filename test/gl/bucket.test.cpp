@@ -10,6 +10,7 @@
 #include <mbgl/renderer/buckets/raster_bucket.hpp>
 #include <mbgl/renderer/buckets/symbol_bucket.hpp>
 #include <mbgl/renderer/bucket_parameters.hpp>
+#include <mbgl/style/expression/dsl.hpp>
 #include <mbgl/style/layers/symbol_layer_properties.hpp>
 #include <mbgl/gl/context.hpp>
 #include <mbgl/gl/headless_backend.hpp>
@@ -100,6 +101,31 @@ TEST(Buckets, FillBucket) {
     ASSERT_FALSE(bucket.needsUpload());
 }
 
+TEST(Buckets, FillBucketCoversTile) {
+    FillBucket::PossiblyEvaluatedLayoutProperties layout;
+    const auto coversTile = [&](const GeometryCollection& polygon) {
+        FillBucket bucket{layout, {}, 5.0f, 1};
+        bucket.addFeature(StubGeometryTileFeature{{}, FeatureType::Polygon, polygon, properties},
+                          polygon,
+                          {},
+                          PatternLayerMap(),
+                          0,
+                          CanonicalTileID(0, 0, 0));
+        return bucket.coversTile;
+    };
+
+    // Clipped to the tile and its buffer, with a vertex left along an edge
+    const GeometryCoordinates covering{
+        {-128, -128}, {4096, -128}, {8320, -128}, {8320, 8320}, {-128, 8320}, {-128, -128}};
+    EXPECT_TRUE(coversTile({covering}));
+    EXPECT_FALSE(coversTile({{{0, 0}, {8192, 0}, {8192, 8191}, {0, 8191}, {0, 0}}}));
+    EXPECT_FALSE(coversTile({{{0, 0}, {8192, 0}, {8192, 8192}, {0, 0}}}));
+    // Doubling back along the bounds
+    EXPECT_FALSE(coversTile({{{0, 0}, {8192, 0}, {8192, 8192}, {8192, 0}, {0, 0}}}));
+    // With a hole
+    EXPECT_FALSE(coversTile({covering, {{100, 100}, {100, 200}, {200, 200}, {200, 100}, {100, 100}}}));
+}
+
 TEST(Buckets, LineBucket) {
     gl::HeadlessBackend backend({512, 256});
     gfx::BackendScope scope{backend};
@@ -382,4 +408,37 @@ TEST(Buckets, RasterBucketMaskComplex) {
     EXPECT_EQ(expectedSegments, bucket.segments);
 }
 
+TEST(Buckets, CompactPaintAttributes) {
+    using namespace style;
+    const auto expression = [](const char* json) {
+        return PossiblyEvaluatedPropertyValue<float>(
+            PropertyExpression<float>(expression::dsl::createExpression(json)));
+    };
+
+    CirclePaintProperties::PossiblyEvaluated evaluated;
+    // Every feature gets the default opacity, but not the default radius
+    evaluated.get<CircleOpacity>() = expression(R"(["case", ["has", "opacity"], 0.5, 1])");
+    evaluated.get<CircleRadius>() = expression(R"(["case", ["has", "radius"], 10, 5])");
+    // The default stroke width so far, but feature state may change it
+    evaluated.get<CircleStrokeWidth>() = expression(R"(["case", ["to-boolean", ["feature-state", "hover"]], 2, 0])");
+
+    CircleBinders binders{evaluated, 0};
+    const StubGeometryTileFeature feature{{}, FeatureType::Point, {{{0, 0}}}, {{"radius", 1.0}}};
+    for (std::size_t i = 1; i <= 4; ++i) {
+        binders.populateVertexVectors(feature, i, i - 1, {}, {}, CanonicalTileID(0, 0, 0));
+    }
+    const auto stride = binders.interleavedVertexBuffer.stride;
+    EXPECT_EQ(4u, binders.get<CircleOpacity>()->getVertexCount());
+
+    binders.compactVertexVectors();
+    EXPECT_EQ(0u, binders.get<CircleOpacity>()->getVertexCount());
+    EXPECT_EQ(4u, binders.get<CircleRadius>()->getVertexCount());
+    EXPECT_EQ(4u, binders.get<CircleStrokeWidth>()->getVertexCount());
+    EXPECT_LT(binders.interleavedVertexBuffer.stride, stride);
+    for (std::size_t i = 0; i < 4; ++i) {
+        EXPECT_EQ(10.0f, std::get<0>(binders.get<CircleRadius>()->getVertexValue(i)).a1[0]);
+        EXPECT_EQ(0.0f, std::get<0>(binders.get<CircleStrokeWidth>()->getVertexValue(i)).a1[0]);
+    }
+}
+
 #endif
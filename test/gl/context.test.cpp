@@ -3,9 +3,11 @@
 
 #include <mbgl/gfx/backend_scope.hpp>
 #include <mbgl/gfx/headless_frontend.hpp>
+#include <mbgl/gfx/offscreen_texture.hpp>
 #include <mbgl/gl/context.hpp>
 #include <mbgl/style/layers/custom_layer.hpp>
 #include <mbgl/gl/defines.hpp>
+#include <mbgl/gl/headless_backend.hpp>
 #include <mbgl/gl/renderable_resource.hpp>
 #include <mbgl/map/map.hpp>
 #include <mbgl/map/map_options.hpp>
@@ -19,6 +21,8 @@
 #include <mbgl/util/mat4.hpp>
 #include <mbgl/util/run_loop.hpp>
 
+#include <array>
+
 using namespace mbgl;
 using namespace mbgl::style;
 using namespace mbgl::platform;
@@ -124,4 +128,166 @@ TEST(GLContextMode, Shared) {
     test::checkImage("test/fixtures/shared_context", frontend.render(map).image, 0.5, 0.1);
 }
 
+TEST(GLContext, DeferredShaderVerification) {
+    if (gfx::Backend::GetType() != gfx::Backend::Type::OpenGL) {
+        return;
+    }
+
+    gl::HeadlessBackend backend{{32, 32}};
+    gfx::BackendScope scope{backend};
+    auto& context = backend.getContext<gl::Context>();
+
+    // Errors are only reported once verification is asked for
+    auto vertex = context.createShader(gl::ShaderType::Vertex, {vertexShaderSource}, false);
+    auto fragment = context.createShader(gl::ShaderType::Fragment, {"void main() { error }"}, false);
+    EXPECT_NO_THROW(context.verifyShaderCompilation(vertex));
+    EXPECT_THROW(context.verifyShaderCompilation(fragment), std::runtime_error);
+
+    auto program = context.createProgram(vertex, fragment, "a_pos", false, false);
+    EXPECT_THROW(context.verifyProgramLinkage(program), std::runtime_error);
+
+    EXPECT_FALSE(context.hasPendingShaders());
+}
+
+TEST(GLContext, AsyncFramebufferRead) {
+    if (gfx::Backend::GetType() != gfx::Backend::Type::OpenGL) {
+        return;
+    }
+
+    gl::HeadlessBackend backend{{32, 32}};
+    gfx::BackendScope scope{backend};
+    auto& context = backend.getContext<gl::Context>();
+    backend.getDefaultRenderable().getResource<gl::RenderableResource>().bind();
+
+    const auto clear = [](GLfloat red, GLfloat green) {
+        MBGL_CHECK_ERROR(glClearColor(red, green, 0, 1));
+        MBGL_CHECK_ERROR(glClear(GL_COLOR_BUFFER_BIT));
+    };
+
+    // Both reads are in flight at once and come out in order
+    clear(1, 0);
+    context.beginReadFramebuffer({32, 32});
+    clear(0, 1);
+    context.beginReadFramebuffer({32, 32});
+    EXPECT_EQ(2u, context.pendingFramebufferReads());
+
+    PremultipliedImage image;
+    ASSERT_TRUE(context.finishReadFramebuffer(image));
+    ASSERT_EQ(Size(32, 32), image.size);
+    EXPECT_EQ(255, image.data[0]);
+    EXPECT_EQ(0, image.data[1]);
+
+    // The image keeps its storage
+    const auto* data = image.data.get();
+    ASSERT_TRUE(context.finishReadFramebuffer(image));
+    EXPECT_EQ(data, image.data.get());
+    EXPECT_EQ(0, image.data[0]);
+    EXPECT_EQ(255, image.data[1]);
+
+    EXPECT_FALSE(context.finishReadFramebuffer(image));
+}
+
+TEST(GLContext, GPUSectionTiming) {
+    if (gfx::Backend::GetType() != gfx::Backend::Type::OpenGL) {
+        return;
+    }
+
+    gl::HeadlessBackend backend{{32, 32}};
+    gfx::BackendScope scope{backend};
+    auto& context = backend.getContext<gl::Context>();
+    backend.getDefaultRenderable().getResource<gl::RenderableResource>().bind();
+
+    context.setGPUSectionTimingEnabled(true);
+    for (int frame = 0; frame < 4; ++frame) {
+        context.beginFrame();
+        context.beginGPUSection("frame");
+        context.beginGPUSection("clear");
+        MBGL_CHECK_ERROR(glClear(GL_COLOR_BUFFER_BIT));
+        context.endGPUSection();
+        context.endGPUSection();
+        context.endFrame();
+        MBGL_CHECK_ERROR(glFinish());
+    }
+
+    // Without timestamp queries nothing is measured
+    const auto& times = context.renderingStats().gpuSectionTimes;
+    if (!times.empty()) {
+        ASSERT_EQ(2u, times.size());
+        EXPECT_EQ("frame", times[0].name);
+        EXPECT_EQ("clear", times[1].name);
+        EXPECT_GE(times[0].time, times[1].time);
+    }
+
+    context.setGPUSectionTimingEnabled(false);
+    EXPECT_TRUE(context.renderingStats().gpuSectionTimes.empty());
+}
+
+TEST(GLContext, OffscreenTexturePool) {
+    if (gfx::Backend::GetType() != gfx::Backend::Type::OpenGL) {
+        return;
+    }
+
+    gl::HeadlessBackend backend{{32, 32}};
+    gfx::BackendScope scope{backend};
+    auto& context = backend.getContext<gl::Context>();
+
+    auto texture = context.acquireOffscreenTexture({16, 16}, gfx::TextureChannelDataType::UnsignedByte);
+    const auto* released = texture.get();
+    context.releaseOffscreenTexture(std::move(texture), gfx::TextureChannelDataType::UnsignedByte);
+    EXPECT_EQ(1, context.renderingStats().numPooledOffscreenTextures);
+
+    // Only a texture of the same size and type is reused
+    texture = context.acquireOffscreenTexture({16, 16}, gfx::TextureChannelDataType::HalfFloat);
+    EXPECT_NE(released, texture.get());
+    context.releaseOffscreenTexture(std::move(texture), gfx::TextureChannelDataType::HalfFloat);
+    texture = context.acquireOffscreenTexture({16, 16}, gfx::TextureChannelDataType::UnsignedByte);
+    EXPECT_EQ(released, texture.get());
+    EXPECT_EQ(2, context.renderingStats().numCreatedOffscreenTextures);
+    EXPECT_EQ(1, context.renderingStats().numReusedOffscreenTextures);
+    EXPECT_EQ(1, context.renderingStats().numPooledOffscreenTextures);
+
+    // Textures left in the pool expire
+    for (uint32_t i = 0; i <= gfx::Context::offscreenTexturePoolFrames; ++i) {
+        context.performCleanup();
+    }
+    EXPECT_EQ(0, context.renderingStats().numPooledOffscreenTextures);
+}
+
+TEST(GLContext, UniformBufferBindingCache) {
+    if (gfx::Backend::GetType() != gfx::Backend::Type::OpenGL) {
+        return;
+    }
+
+    gl::HeadlessBackend backend{{32, 32}};
+    gfx::BackendScope scope{backend};
+    auto& context = backend.getContext<gl::Context>();
+
+    const std::array<float, 4> data{};
+    const auto buffer = context.createUniformBuffer(data.data(), sizeof(data));
+    const auto& bufferGL = static_cast<const gl::UniformBufferGL&>(*buffer);
+    const auto redundantCalls = [&] {
+        return context.renderingStats().numRedundantStateCalls;
+    };
+
+    const auto before = redundantCalls();
+    context.bindUniformBuffer(1, bufferGL.getID(), 0, sizeof(data));
+    EXPECT_EQ(before, redundantCalls());
+    context.bindUniformBuffer(1, bufferGL.getID(), 0, sizeof(data));
+    EXPECT_EQ(before + 1, redundantCalls());
+
+    // Another binding point, range or buffer is bound
+    context.bindUniformBuffer(2, bufferGL.getID(), 0, sizeof(data));
+    context.bindUniformBuffer(1, bufferGL.getID(), 0, sizeof(data) / 2);
+    EXPECT_EQ(before + 1, redundantCalls());
+
+    // A deleted buffer is bound again even if its ID is reused
+    context.uniformBufferDeleted(bufferGL.getID());
+    context.bindUniformBuffer(1, bufferGL.getID(), 0, sizeof(data) / 2);
+    EXPECT_EQ(before + 1, redundantCalls());
+
+    context.unbindUniformBuffer(1);
+    context.unbindUniformBuffer(1);
+    EXPECT_EQ(before + 2, redundantCalls());
+}
+
 #endif
@@ -0,0 +1,96 @@
+#if MLN_RENDER_BACKEND_OPENGL
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/gfx/backend_scope.hpp>
+#include <mbgl/gl/context.hpp>
+#include <mbgl/gl/defines.hpp>
+#include <mbgl/gl/headless_backend.hpp>
+#include <mbgl/gl/program_binary_cache.hpp>
+#include <mbgl/platform/gl_functions.hpp>
+#include <mbgl/util/io.hpp>
+
+#include <string>
+
+using namespace mbgl;
+using namespace mbgl::platform;
+
+namespace {
+
+constexpr const char* directory = "test/fixtures/shader_registry";
+
+constexpr const char* vertexSource = R"(#version 300 es
+layout (location = 0) in vec2 a_pos;
+void main() {
+    gl_Position = vec4(a_pos, 0.0, 1.0);
+}
+)";
+
+constexpr const char* fragmentSource = R"(#version 300 es
+out highp vec4 fragColor;
+void main() {
+    fragColor = vec4(1.0);
+}
+)";
+
+gl::UniqueProgram compile(gl::Context& context) {
+    auto vertex = context.createShader(gl::ShaderType::Vertex, {vertexSource});
+    auto fragment = context.createShader(gl::ShaderType::Fragment, {fragmentSource});
+    return context.createProgram(vertex, fragment, "a_pos", true);
+}
+
+} // namespace
+
+TEST(ProgramBinaryCache, RoundTrip) {
+    gl::HeadlessBackend backend{{32, 32}};
+    gfx::BackendScope scope{backend};
+
+    auto& context = backend.getContext<gl::Context>();
+    auto cache = gl::ProgramBinaryCache::create(context, directory);
+    if (!cache) {
+        GTEST_SKIP() << "no program binary formats supported";
+    }
+
+    const auto key = cache->key({vertexSource, fragmentSource});
+    EXPECT_NE(key, cache->key({fragmentSource, vertexSource}));
+
+    const auto program = compile(context);
+    cache->store(program, key);
+
+    const auto loaded = cache->load(key);
+    ASSERT_TRUE(loaded.has_value());
+    GLint status = 0;
+    MBGL_CHECK_ERROR(glGetProgramiv(*loaded, GL_LINK_STATUS, &status));
+    EXPECT_EQ(GL_TRUE, status);
+
+    EXPECT_FALSE(cache->load(key + 1).has_value());
+}
+
+TEST(ProgramBinaryCache, Rejected) {
+    gl::HeadlessBackend backend{{32, 32}};
+    gfx::BackendScope scope{backend};
+
+    auto& context = backend.getContext<gl::Context>();
+    auto cache = gl::ProgramBinaryCache::create(context, directory);
+    if (!cache) {
+        GTEST_SKIP() << "no program binary formats supported";
+    }
+
+    const auto key = cache->key({vertexSource});
+    const auto path = std::string(directory) + "/program-" + std::to_string(key) + ".bin";
+
+    // Too short to hold a binary
+    util::write_file(path, "MLPB");
+    EXPECT_FALSE(cache->load(key).has_value());
+
+    // A valid header for the key with garbage for a binary
+    cache->store(compile(context), key);
+    auto file = util::read_file(path);
+    for (std::size_t i = 16; i < file.size(); ++i) {
+        file[i] = static_cast<char>(~file[i]);
+    }
+    util::write_file(path, file);
+    EXPECT_FALSE(cache->load(key).has_value());
+
+    util::deleteFile(path);
+}
+#endif
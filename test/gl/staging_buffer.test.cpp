@@ -0,0 +1,85 @@
+#if MLN_RENDER_BACKEND_OPENGL
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/gfx/backend_scope.hpp>
+#include <mbgl/gl/context.hpp>
+#include <mbgl/gl/defines.hpp>
+#include <mbgl/gl/headless_backend.hpp>
+#include <mbgl/gl/staging_buffer.hpp>
+#include <mbgl/platform/gl_functions.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <vector>
+
+using namespace mbgl;
+using namespace mbgl::platform;
+
+namespace {
+
+// Streams enough data through `staging` to go around its pages a few times, checking that every
+// copy lands in the destination buffer
+void testCopies(gl::Context& context, gl::StagingBuffer& staging) {
+    constexpr std::size_t chunkSize = 300 * 1024;
+    std::vector<std::uint8_t> data(chunkSize);
+
+    GLuint destination = 0;
+    MBGL_CHECK_ERROR(glGenBuffers(1, &destination));
+    MBGL_CHECK_ERROR(glBindBuffer(GL_COPY_WRITE_BUFFER, destination));
+    MBGL_CHECK_ERROR(glBufferData(GL_COPY_WRITE_BUFFER, chunkSize, nullptr, GL_DYNAMIC_DRAW));
+
+    for (std::uint8_t frame = 0; frame < 4; ++frame) {
+        context.beginFrame();
+        for (std::uint8_t i = 0; i < 8; ++i) {
+            std::iota(data.begin(), data.end(), static_cast<std::uint8_t>(frame * 8 + i));
+            MBGL_CHECK_ERROR(glBindBuffer(GL_COPY_WRITE_BUFFER, destination));
+            if (!staging.copy(GL_COPY_WRITE_BUFFER, 0, data.data(), data.size())) {
+                MBGL_CHECK_ERROR(glBufferSubData(GL_COPY_WRITE_BUFFER, 0, data.size(), data.data()));
+            }
+        }
+        context.endFrame();
+    }
+
+    MBGL_CHECK_ERROR(glBindBuffer(GL_COPY_WRITE_BUFFER, destination));
+    const auto* contents = static_cast<const std::uint8_t*>(
+        MBGL_CHECK_ERROR(glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, chunkSize, GL_MAP_READ_BIT)));
+    ASSERT_NE(nullptr, contents);
+    EXPECT_EQ(0, std::memcmp(contents, data.data(), chunkSize));
+    MBGL_CHECK_ERROR(glUnmapBuffer(GL_COPY_WRITE_BUFFER));
+
+    MBGL_CHECK_ERROR(glDeleteBuffers(1, &destination));
+}
+
+} // namespace
+
+TEST(StagingBuffer, Copy) {
+    gl::HeadlessBackend backend{{32, 32}};
+    gfx::BackendScope scope{backend};
+
+    auto& context = backend.getContext<gl::Context>();
+    testCopies(context, context.getStagingBuffer());
+}
+
+TEST(StagingBuffer, Orphaning) {
+    gl::HeadlessBackend backend{{32, 32}};
+    gfx::BackendScope scope{backend};
+
+    auto& context = backend.getContext<gl::Context>();
+    gl::StagingBuffer staging{context, nullptr};
+    EXPECT_FALSE(staging.isPersistent());
+    testCopies(context, staging);
+}
+
+TEST(StagingBuffer, Oversized) {
+    gl::HeadlessBackend backend{{32, 32}};
+    gfx::BackendScope scope{backend};
+
+    auto& context = backend.getContext<gl::Context>();
+    const std::vector<std::uint8_t> data(gl::StagingBuffer::PageSize + 1);
+
+    context.beginFrame();
+    EXPECT_FALSE(context.getStagingBuffer().copy(GL_COPY_WRITE_BUFFER, 0, data.data(), data.size()));
+    context.endFrame();
+}
+#endif
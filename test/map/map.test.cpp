@@ -814,6 +814,30 @@ TEST(Map, DisabledSources) {
     test::checkImage("test/fixtures/map/disabled_layers/second", test.frontend.render(test.map).image);
 }
 
+TEST(Map, RenderMetatile) {
+    MapTest<> test{2};
+
+    test.map.getStyle().loadJSON(R"STYLE({
+        "version": 8,
+        "sources": {},
+        "layers": [{"id": "background", "type": "background", "paint": {"background-color": "red"}}]
+    })STYLE");
+
+    const auto result = test.frontend.renderMetatile(test.map, {2, 1, 2}, 2, 128);
+    ASSERT_EQ(4u, result.tiles.size());
+    for (const auto& tile : result.tiles) {
+        ASSERT_EQ(Size(256, 256), tile.size);
+        EXPECT_EQ(255, tile.data[0]);
+        EXPECT_EQ(0, tile.data[1]);
+    }
+    EXPECT_GT(result.tilesPerSecond, 0.0);
+    EXPECT_EQ(Size(256, 256), test.frontend.getSize());
+    // 128 pixel tiles of zoom 2 are shown at map zoom 0
+    EXPECT_DOUBLE_EQ(0.0, *test.map.getCameraOptions().zoom);
+
+    EXPECT_THROW(test.frontend.renderMetatile(test.map, {2, 3, 0}, 2), std::invalid_argument);
+}
+
 TEST(Map, DontLoadUnneededTiles) {
     MapTest<> test;
 
@@ -2039,3 +2063,31 @@ TEST(Map, SetFrustumOffset) {
 
     test::checkImage("test/fixtures/map/setFrustumOffset/after", test.frontend.render(test.map).image, 0.0006, 0.1);
 }
+
+TEST(Map, MemoryReport) {
+    MapTest<> test;
+
+    test.map.getStyle().loadJSON(util::read_file("test/fixtures/api/empty.json"));
+
+    mapbox::geojson::polygon polygon{{{-10, -10}, {10, -10}, {10, 10}, {-10, 10}, {-10, -10}}};
+    FeatureCollection features;
+    features.emplace_back(polygon);
+    auto source = std::make_unique<GeoJSONSource>("polygon");
+    source->setGeoJSON(features);
+    test.map.getStyle().addSource(std::move(source));
+    test.map.getStyle().addLayer(std::make_unique<FillLayer>("fill", "polygon"));
+
+    test.frontend.render(test.map);
+
+    const auto report = test.frontend.getRenderer()->getMemoryReport();
+    ASSERT_EQ(1u, report.sources.size());
+    const auto& sourceReport = report.sources.front();
+    EXPECT_EQ("polygon", sourceReport.id);
+    EXPECT_LT(0u, sourceReport.tiles);
+    EXPECT_LT(0u, sourceReport.buckets.total());
+    EXPECT_LT(0u, sourceReport.featureIndexes.cpu);
+
+    ASSERT_EQ(1u, report.layers.size());
+    EXPECT_EQ("fill", report.layers.front().id);
+    EXPECT_EQ(sourceReport.buckets, report.layers.front().buckets);
+}
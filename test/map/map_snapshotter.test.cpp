@@ -174,3 +174,31 @@ TEST(MapSnapshotter, TEST_REQUIRES_SERVER(annotation)) {
 
     runLoop.run();
 }
+
+TEST(MapSnapshotter, Pool) {
+    util::RunLoop runLoop;
+    const std::string styleURL = "http://127.0.0.1:3000/online/style.json";
+    MapSnapshotterPool pool(1, 1.0f, ResourceOptions());
+
+    auto snapshotter = pool.acquire(styleURL, Size{64, 32});
+    MapSnapshotter* warm = snapshotter.get();
+    pool.release(std::move(snapshotter));
+    EXPECT_EQ(1u, pool.size());
+
+    // Only a snapshotter of the same style and size is reused
+    EXPECT_NE(warm, pool.acquire(styleURL, Size{32, 64}).get());
+    EXPECT_EQ(1u, pool.size());
+    snapshotter = pool.acquire(styleURL, Size{64, 32});
+    EXPECT_EQ(warm, snapshotter.get());
+    EXPECT_EQ(0u, pool.size());
+
+    // Beyond the capacity, the least recently released snapshotter is destroyed
+    pool.release(std::move(snapshotter));
+    pool.release(pool.acquire(styleURL, Size{16, 16}));
+    EXPECT_EQ(1u, pool.size());
+
+    // Snapshotters without a style URL aren't kept
+    pool.clear();
+    pool.release(std::make_unique<MapSnapshotter>(Size{16, 16}, 1.0f, ResourceOptions()));
+    EXPECT_EQ(0u, pool.size());
+}
@@ -540,6 +540,34 @@ TEST(Transform, IsPanning) {
     transform.updateTransitions(transform.getTransitionStart() + transform.getTransitionDuration());
 }
 
+TEST(Transform, TransitionTargetState) {
+    Transform transform;
+    transform.resize({1000, 1000});
+    ASSERT_FALSE(transform.getTransitionTargetState());
+
+    transform.jumpTo(CameraOptions().withCenter(LatLng{10, 10}).withZoom(4.0));
+    ASSERT_FALSE(transform.getTransitionTargetState());
+
+    transform.flyTo(CameraOptions().withCenter(LatLng{45, 135}).withZoom(12.0), AnimationOptions(Seconds(1)));
+    ASSERT_TRUE(transform.getTransitionTargetState());
+    EXPECT_NEAR(45, transform.getTransitionTargetState()->getLatLng().latitude(), 1e-6);
+    EXPECT_NEAR(135, transform.getTransitionTargetState()->getLatLng().longitude(), 1e-6);
+    EXPECT_NEAR(12.0, transform.getTransitionTargetState()->getZoom(), 1e-5);
+    // The camera itself hasn't moved yet
+    EXPECT_DOUBLE_EQ(4.0, transform.getZoom());
+
+    transform.updateTransitions(transform.getTransitionStart() + Milliseconds(500));
+    ASSERT_TRUE(transform.getTransitionTargetState());
+    transform.updateTransitions(transform.getTransitionStart() + transform.getTransitionDuration());
+    ASSERT_FALSE(transform.getTransitionTargetState());
+
+    transform.easeTo(CameraOptions().withZoom(8.0), AnimationOptions(Seconds(1)));
+    ASSERT_TRUE(transform.getTransitionTargetState());
+    EXPECT_DOUBLE_EQ(8.0, transform.getTransitionTargetState()->getZoom());
+    transform.cancelTransitions();
+    ASSERT_FALSE(transform.getTransitionTargetState());
+}
+
 TEST(Transform, DefaultTransform) {
     struct TransformObserver : public mbgl::TransformObserver {
         void onCameraWillChange(MapObserver::CameraChangeMode) final { cameraWillChangeCallback(); };
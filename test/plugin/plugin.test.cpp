@@ -47,6 +47,8 @@
 #include <mbgl/plugin/plugin_layer_impl.hpp>
 
 #include <atomic>
+#include <chrono>
+#include <thread>
 
 using namespace mbgl;
 using namespace mbgl::style;
@@ -234,3 +236,65 @@ TEST(Plugin, PluginLayer) {
     ASSERT_TRUE(_layerRendered);
     ASSERT_TRUE(_paintPropertiesFound);
 }
+
+TEST(Plugin, PluginLayerPrepare) {
+    // Shared with the prepare task, which may still run once the test is over
+    struct PrepareCounters {
+        std::atomic<bool> offRenderThread = true;
+        std::atomic<int> count = 0;
+    };
+    const auto counters = std::make_shared<PrepareCounters>();
+    const auto renderThread = std::this_thread::get_id();
+    int uploadCount = 0;
+    bool uploadsInOrder = true;
+    int lastUploaded = -1;
+
+    std::string layerType = "plugin-layer-prepare-test";
+    auto pluginLayerFactory = std::make_unique<PluginLayerFactory>(
+        layerType,
+        mbgl::style::LayerTypeInfo::Source::NotRequired,
+        mbgl::style::LayerTypeInfo::Pass3D::NotRequired,
+        mbgl::style::LayerTypeInfo::Layout::NotRequired,
+        mbgl::style::LayerTypeInfo::FadingTiles::NotRequired,
+        mbgl::style::LayerTypeInfo::CrossTileIndex::NotRequired,
+        mbgl::style::LayerTypeInfo::TileKind::NotRequired);
+    pluginLayerFactory->setOnLayerCreatedEvent([&](mbgl::style::PluginLayer* pluginLayer) {
+        auto pluginLayerImpl = (mbgl::style::PluginLayer::Impl*)pluginLayer->baseImpl.get();
+        pluginLayerImpl->setUpdatePropertiesFunction([](const std::string&) {});
+        pluginLayerImpl->setPrepareFunction([counters, renderThread](const PluginLayer::PrepareParameters& parameters) {
+            if (std::this_thread::get_id() == renderThread) {
+                counters->offRenderThread = false;
+            }
+            ++counters->count;
+            return std::static_pointer_cast<void>(std::make_shared<int>(static_cast<int>(parameters.sequence)));
+        });
+        pluginLayerImpl->setUploadFunction([&](gfx::UploadPass&, const std::shared_ptr<void>& prepared) {
+            const int sequence = *std::static_pointer_cast<int>(prepared);
+            uploadsInOrder = uploadsInOrder && sequence > lastUploaded;
+            lastUploaded = sequence;
+            ++uploadCount;
+        });
+    });
+
+    LayerManager::get()->addLayerTypeCoreOnly(std::move(pluginLayerFactory));
+
+    MapTest<> test{1, MapMode::Continuous};
+    test.map.getStyle().loadJSON(R"STYLE({
+      "version": 8,
+      "layers": [{
+        "id": "plugin-layer-prepare",
+        "type": "plugin-layer-prepare-test"
+      }]
+    })STYLE");
+
+    // The layer keeps repainting, each frame picks up the result prepared since the last one
+    for (int i = 0; i < 1000 && uploadCount < 3; i++) {
+        test.runLoop.runOnce();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    EXPECT_TRUE(counters->offRenderThread);
+    EXPECT_GE(uploadCount, 3);
+    EXPECT_GE(counters->count, uploadCount);
+    EXPECT_TRUE(uploadsInOrder);
+}
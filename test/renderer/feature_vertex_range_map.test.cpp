@@ -0,0 +1,69 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/renderer/feature_vertex_range_map.hpp>
+
+#include <limits>
+#include <vector>
+
+using namespace mbgl;
+
+namespace {
+
+std::vector<std::size_t> starts(FeatureVertexRangeMap& map, const std::string& id) {
+    std::vector<std::size_t> result;
+    for (const auto& range : map.find(id)) {
+        result.push_back(range.start);
+    }
+    return result;
+}
+
+} // namespace
+
+TEST(FeatureVertexRangeMap, FindsByStringForm) {
+    FeatureVertexRangeMap map;
+    EXPECT_TRUE(map.empty());
+
+    map.add(uint64_t(5), {0, 0, 4});
+    map.add(int64_t(-7), {1, 4, 8});
+    map.add(std::string("road"), {2, 8, 12});
+    map.add(NullValue(), {3, 12, 16});
+    EXPECT_FALSE(map.empty());
+
+    EXPECT_EQ(std::vector<std::size_t>{0}, starts(map, "5"));
+    EXPECT_EQ(std::vector<std::size_t>{4}, starts(map, "-7"));
+    EXPECT_EQ(std::vector<std::size_t>{8}, starts(map, "road"));
+    EXPECT_TRUE(starts(map, "05").empty());
+    EXPECT_TRUE(starts(map, "6").empty());
+    EXPECT_TRUE(starts(map, "").empty());
+
+    map.clear();
+    EXPECT_TRUE(map.empty());
+    EXPECT_TRUE(starts(map, "5").empty());
+}
+
+TEST(FeatureVertexRangeMap, GroupsRangesOfAFeature) {
+    FeatureVertexRangeMap map;
+    map.add(uint64_t(1), {0, 0, 4});
+    map.add(std::string("a"), {1, 4, 8});
+    // The string form of an integer ID is the same feature
+    map.add(std::string("1"), {2, 8, 12});
+    EXPECT_EQ((std::vector<std::size_t>{0, 8}), starts(map, "1"));
+
+    // Added after a lookup
+    map.add(std::string("a"), {3, 12, 16});
+    map.add(int64_t(1), {4, 16, 20});
+    EXPECT_EQ((std::vector<std::size_t>{4, 12}), starts(map, "a"));
+    EXPECT_EQ((std::vector<std::size_t>{0, 8, 16}), starts(map, "1"));
+}
+
+TEST(FeatureVertexRangeMap, IntegerID) {
+    EXPECT_EQ(0, FeatureVertexRangeMap::integerID("0"));
+    EXPECT_EQ(-12, FeatureVertexRangeMap::integerID("-12"));
+    EXPECT_EQ(std::numeric_limits<int64_t>::max(), FeatureVertexRangeMap::integerID("9223372036854775807"));
+    EXPECT_FALSE(FeatureVertexRangeMap::integerID("9223372036854775808"));
+    EXPECT_FALSE(FeatureVertexRangeMap::integerID("-0"));
+    EXPECT_FALSE(FeatureVertexRangeMap::integerID("007"));
+    EXPECT_FALSE(FeatureVertexRangeMap::integerID("+7"));
+    EXPECT_FALSE(FeatureVertexRangeMap::integerID("1.5"));
+    EXPECT_FALSE(FeatureVertexRangeMap::integerID("-"));
+}
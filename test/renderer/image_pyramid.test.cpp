@@ -0,0 +1,96 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/renderer/sources/image_pyramid.hpp>
+#include <mbgl/util/run_loop.hpp>
+
+#include <algorithm>
+
+using namespace mbgl;
+
+namespace {
+
+// Odd columns white, even ones transparent
+std::shared_ptr<PremultipliedImage> stripedImage(Size size) {
+    auto image = std::make_shared<PremultipliedImage>(size);
+    for (uint32_t y = 0; y < size.height; ++y) {
+        for (uint32_t x = 0; x < size.width; ++x) {
+            std::fill_n(image->data.get() + y * image->stride() + x * 4, 4, static_cast<uint8_t>(x % 2 ? 255 : 0));
+        }
+    }
+    return image;
+}
+
+} // namespace
+
+TEST(ImagePyramid, Levels) {
+    const ImagePyramid pyramid(stripedImage({1000, 600}), 256, {});
+
+    // 1000, 500 and 250 pixels wide
+    EXPECT_EQ(3u, pyramid.levelCount());
+    EXPECT_EQ(1u, pyramid.tiles(2).size());
+    EXPECT_EQ(4u, pyramid.tiles(1).size());
+    EXPECT_EQ(12u, pyramid.tiles(0).size());
+
+    EXPECT_EQ(0u, pyramid.levelFor(1000));
+    EXPECT_EQ(0u, pyramid.levelFor(2000));
+    EXPECT_EQ(1u, pyramid.levelFor(400));
+    EXPECT_EQ(2u, pyramid.levelFor(250));
+    EXPECT_EQ(2u, pyramid.levelFor(10));
+}
+
+TEST(ImagePyramid, Bounds) {
+    const ImagePyramid pyramid(stripedImage({1000, 600}), 256, {});
+
+    const auto first = pyramid.bounds({1, 0, 0});
+    EXPECT_DOUBLE_EQ(0.0, first.min.x);
+    EXPECT_DOUBLE_EQ(0.0, first.min.y);
+    EXPECT_DOUBLE_EQ(0.512, first.max.x);
+    EXPECT_DOUBLE_EQ(512.0 / 600.0, first.max.y);
+
+    const auto last = pyramid.bounds({1, 1, 1});
+    EXPECT_DOUBLE_EQ(0.512, last.min.x);
+    EXPECT_DOUBLE_EQ(1.0, last.max.x);
+    EXPECT_DOUBLE_EQ(1.0, last.max.y);
+
+    const auto whole = pyramid.bounds({2, 0, 0});
+    EXPECT_DOUBLE_EQ(1.0, whole.max.x);
+    EXPECT_DOUBLE_EQ(1.0, whole.max.y);
+}
+
+TEST(ImagePyramid, Prepare) {
+    util::RunLoop loop;
+    auto pyramid = std::make_shared<ImagePyramid>(stripedImage({1000, 600}), 256, [&] { loop.stop(); });
+
+    EXPECT_FALSE(pyramid->get({1, 1, 1}));
+    loop.run();
+
+    const auto tile = pyramid->peek({1, 1, 1});
+    ASSERT_TRUE(tile);
+    EXPECT_EQ(Size(244, 44), tile->size);
+    // Each pixel averages a white column and a transparent one
+    EXPECT_EQ(128, tile->data[0]);
+    EXPECT_EQ(128, tile->data[tile->bytes() - 1]);
+
+    EXPECT_FALSE(pyramid->get({0, 3, 2}));
+    loop.run();
+    const auto fullTile = pyramid->peek({0, 3, 2});
+    ASSERT_TRUE(fullTile);
+    EXPECT_EQ(Size(232, 88), fullTile->size);
+    EXPECT_EQ(0, fullTile->data[0]);
+    EXPECT_EQ(255, fullTile->data[4]);
+}
+
+TEST(ImagePyramid, Retain) {
+    util::RunLoop loop;
+    auto pyramid = std::make_shared<ImagePyramid>(stripedImage({1000, 600}), 256, [&] { loop.stop(); });
+
+    pyramid->get({2, 0, 0});
+    loop.run();
+    pyramid->get({1, 0, 0});
+    loop.run();
+
+    pyramid->retain({});
+    EXPECT_FALSE(pyramid->peek({1, 0, 0}));
+    // The last level is kept to fall back on
+    EXPECT_TRUE(pyramid->peek({2, 0, 0}));
+}
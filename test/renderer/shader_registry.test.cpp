@@ -2,6 +2,7 @@
 
 #include <mbgl/gfx/shader_registry.hpp>
 #include <mbgl/gfx/shader.hpp>
+#include <mbgl/renderer/renderer_resource_group.hpp>
 
 #include <string_view>
 #include <iostream>
@@ -187,6 +188,28 @@ TEST(ShaderRegistry, RegistryFetch) {
     ASSERT_NE(progB, nullptr);
 }
 
+// Renderers of a resource group share the shaders compiled for their pixel ratio
+TEST(ShaderRegistry, ResourceGroup) {
+    RendererResourceGroup group;
+    int initialized = 0;
+    const auto initialize = [&](gfx::ShaderRegistry& registry) {
+        ++initialized;
+        ASSERT_TRUE(registry.getLegacyGroup().registerShader(std::make_shared<StubProgram_1>()));
+    };
+
+    const auto first = group.getShaders(1.0f, initialize);
+    const auto second = group.getShaders(1.0f, initialize);
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(1, initialized);
+
+    std::shared_ptr<StubProgram_1> program;
+    EXPECT_TRUE(second->getLegacyGroup().populate(program));
+
+    const auto retina = group.getShaders(2.0f, initialize);
+    EXPECT_NE(first, retina);
+    EXPECT_EQ(2, initialized);
+}
+
 // Replace a manually named shader
 TEST(ShaderRegistry, NamedReplace) {
     gfx::ShaderRegistry registry;
@@ -1,7 +1,10 @@
 #include <mbgl/test/util.hpp>
 
 #include <mbgl/renderer/style_diff.hpp>
+#include <mbgl/style/collection.hpp>
 #include <mbgl/style/layer_impl.hpp>
+#include <mbgl/style/layers/background_layer.hpp>
+#include <mbgl/style/layers/fill_layer.hpp>
 
 using namespace mbgl;
 using namespace mbgl::style;
@@ -111,3 +114,48 @@ TEST(StyleDiff, Order) {
     ASSERT_EQ(1, diff.removed.size());
     ASSERT_EQ(0, diff.changed.size());
 }
+
+// Diffing with the journal of a collection only looks at the layers that changed
+TEST(StyleDiff, Journal) {
+    Collection<Layer> layers;
+    layers.add(std::make_unique<BackgroundLayer>("id-1"));
+    layers.add(std::make_unique<BackgroundLayer>("id-2"));
+    layers.add(std::make_unique<BackgroundLayer>("id-3"));
+    layers.takeJournal();
+    const auto a = layers.getImpls();
+
+    // Change one, move one and replace one with a layer of another type
+    auto* layer = layers.get("id-1");
+    layer->setVisibility(VisibilityType::None);
+    layers.update(*layer);
+    layers.add(layers.remove("id-2"), std::string("id-1"));
+    layers.remove("id-3");
+    layers.add(std::make_unique<FillLayer>("id-3", "src-1"));
+    layers.add(std::make_unique<BackgroundLayer>("id-4"));
+    layers.remove("id-4");
+
+    const auto journal = layers.takeJournal();
+    ASSERT_TRUE(journal);
+    const auto b = layers.getImpls();
+
+    const auto diff = diffLayers(a, b, journal.get());
+    EXPECT_EQ(1, diff.changed.size());
+    EXPECT_EQ(1, diff.changed.count("id-1"));
+    EXPECT_EQ(2, diff.added.size());
+    EXPECT_EQ(1, diff.added.count("id-2"));
+    EXPECT_EQ(1, diff.added.count("id-3"));
+    EXPECT_EQ(2, diff.removed.size());
+    EXPECT_EQ(1, diff.removed.count("id-2"));
+    EXPECT_EQ(1, diff.removed.count("id-3"));
+
+    // A journal for other versions is ignored
+    const auto expected = diffLayers(b, a);
+    const auto other = diffLayers(b, a, journal.get());
+    EXPECT_EQ(expected.added.size(), other.added.size());
+    EXPECT_EQ(expected.removed.size(), other.removed.size());
+    EXPECT_EQ(expected.changed.size(), other.changed.size());
+
+    // Clearing the collection isn't recorded
+    layers.clear();
+    EXPECT_FALSE(layers.takeJournal());
+}
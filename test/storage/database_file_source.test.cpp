@@ -55,3 +55,70 @@ TEST(DatabaseFileSource, VolatileResource) {
     });
     loop.run();
 }
+
+TEST(DatabaseFileSource, PendingWrites) {
+    util::RunLoop loop;
+
+    std::shared_ptr<FileSource> dbfs = FileSourceManager::get()->getFileSource(FileSourceType::Database,
+                                                                               ResourceOptions{});
+
+    const Resource resource{
+        Resource::Unknown, "http://127.0.0.1:3000/pending", {}, Resource::LoadingMethod::CacheOnly};
+    Response response;
+    response.data = std::make_shared<std::string>("Cached value");
+    dbfs->forward(resource, response, {});
+
+    // Revalidation only updates the expiration of the queued write
+    Response notModified;
+    notModified.notModified = true;
+    notModified.expires = util::now() + Seconds(60);
+    std::unique_ptr<mbgl::AsyncRequest> req;
+
+    dbfs->forward(resource, notModified, [&] {
+        req = dbfs->request(resource, [&](Response res) {
+            req.reset();
+            EXPECT_EQ(nullptr, res.error);
+            ASSERT_TRUE(res.data.get());
+            EXPECT_EQ("Cached value", *res.data);
+            EXPECT_EQ(notModified.expires, res.expires);
+            loop.stop();
+        });
+    });
+    loop.run();
+}
+
+TEST(DatabaseFileSource, StaleWhileRevalidate) {
+    util::RunLoop loop;
+
+    std::shared_ptr<FileSource> dbfs = FileSourceManager::get()->getFileSource(FileSourceType::Database,
+                                                                               ResourceOptions{});
+
+    const Resource resource{
+        Resource::Unknown, "http://127.0.0.1:3000/stale", {}, Resource::LoadingMethod::CacheOnly};
+    Response response;
+    response.data = std::make_shared<std::string>("Cached value");
+    response.mustRevalidate = true;
+    response.expires = util::now() - Seconds(60);
+    std::unique_ptr<mbgl::AsyncRequest> req;
+
+    dbfs->forward(resource, response, [&] {
+        req = dbfs->request(resource, [&](Response res1) {
+            // Only handed out for the conditional request
+            ASSERT_TRUE(res1.error.get());
+            EXPECT_EQ(Response::Error::Reason::NotFound, res1.error->reason);
+            ASSERT_TRUE(res1.data.get());
+
+            dbfs->setProperty(STALE_WHILE_REVALIDATE_KEY, true);
+            req = dbfs->request(resource, [&](Response res2) {
+                req.reset();
+                dbfs->setProperty(STALE_WHILE_REVALIDATE_KEY, false);
+                EXPECT_EQ(nullptr, res2.error);
+                ASSERT_TRUE(res2.data.get());
+                EXPECT_EQ("Cached value", *res2.data);
+                EXPECT_TRUE(res2.mustRevalidate);
+                loop.stop();
+            });
+        });
+    });
+    loop.run();
+}
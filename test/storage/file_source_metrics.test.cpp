@@ -0,0 +1,91 @@
+#include <mbgl/storage/file_source_manager.hpp>
+#include <mbgl/storage/file_source_metrics.hpp>
+#include <mbgl/storage/resource_options.hpp>
+#include <mbgl/storage/response.hpp>
+#include <mbgl/test/util.hpp>
+#include <mbgl/util/run_loop.hpp>
+
+#include <gtest/gtest.h>
+
+using namespace mbgl;
+using namespace std::chrono_literals;
+
+TEST(FileSourceMetrics, Host) {
+    EXPECT_EQ("example.com", FileSourceMetrics::host("https://example.com/tiles/1/2/3.pbf?key=abc"));
+    EXPECT_EQ("127.0.0.1:3000", FileSourceMetrics::host("http://127.0.0.1:3000/test"));
+    EXPECT_EQ("", FileSourceMetrics::host("not a url"));
+}
+
+TEST(FileSourceMetrics, Histogram) {
+    FileSourceMetrics::Histogram histogram;
+    EXPECT_EQ(0, histogram.percentile(50));
+
+    for (int i = 0; i < 9; i++) {
+        histogram.add(3ms);
+    }
+    histogram.add(700ms);
+
+    EXPECT_EQ(10u, histogram.count);
+    EXPECT_EQ(9u, histogram.buckets[2]);
+    EXPECT_EQ(1u, histogram.buckets[9]);
+    EXPECT_EQ(5, histogram.percentile(50));
+    EXPECT_EQ(5, histogram.percentile(90));
+    EXPECT_EQ(700, histogram.percentile(100));
+    EXPECT_EQ(727, histogram.totalMilliseconds);
+}
+
+TEST(FileSourceMetrics, Record) {
+    FileSourceMetrics metrics;
+    const Resource tile{Resource::Tile, "https://tiles.example.com/1/0/0.pbf"};
+
+    Response hit;
+    hit.data = std::make_shared<std::string>("tile");
+    metrics.record(tile, FileSourceMetrics::Origin::Cache, hit, 1ms);
+
+    Response miss;
+    miss.error = std::make_unique<Response::Error>(Response::Error::Reason::NotFound, "Not found");
+    metrics.record(tile, FileSourceMetrics::Origin::Cache, miss, 1ms);
+
+    Response notModified;
+    notModified.notModified = true;
+    metrics.record(tile, FileSourceMetrics::Origin::Network, notModified, 80ms, 30ms);
+
+    const auto snapshot = metrics.snapshot();
+    ASSERT_EQ(2u, snapshot.size());
+
+    const auto& cache = snapshot.at({Resource::Tile, "tiles.example.com", FileSourceMetrics::Origin::Cache});
+    EXPECT_EQ(2u, cache.responses);
+    EXPECT_EQ(1u, cache.misses);
+    EXPECT_EQ(0u, cache.errors);
+    EXPECT_EQ(4u, cache.bytes);
+    EXPECT_EQ(0u, cache.queueWait.count);
+
+    const auto& network = snapshot.at({Resource::Tile, "tiles.example.com", FileSourceMetrics::Origin::Network});
+    EXPECT_EQ(1u, network.responses);
+    EXPECT_EQ(1u, network.notModified);
+    EXPECT_EQ(80, network.latency.percentile(50));
+    EXPECT_EQ(30, network.queueWait.percentile(50));
+
+    metrics.reset();
+    EXPECT_TRUE(metrics.snapshot().empty());
+}
+
+TEST(FileSourceMetrics, CacheLookups) {
+    util::RunLoop loop;
+    auto& metrics = FileSourceManager::get()->getMetrics();
+    metrics.reset();
+
+    std::shared_ptr<FileSource> dbfs = FileSourceManager::get()->getFileSource(FileSourceType::Database,
+                                                                               ResourceOptions{});
+    const Resource resource{
+        Resource::Unknown, "http://127.0.0.1:3000/metrics", {}, Resource::LoadingMethod::CacheOnly};
+    auto req = dbfs->request(resource, [&](const Response&) { loop.stop(); });
+    loop.run();
+
+    const auto snapshot = metrics.snapshot();
+    const auto it = snapshot.find({Resource::Unknown, "127.0.0.1:3000", FileSourceMetrics::Origin::Cache});
+    ASSERT_NE(snapshot.end(), it);
+    EXPECT_EQ(1u, it->second.responses);
+    EXPECT_EQ(1u, it->second.misses);
+    EXPECT_EQ(1u, it->second.latency.count);
+}
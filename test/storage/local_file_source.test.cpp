@@ -7,6 +7,7 @@
 #include <climits>
 #include <cstdint>
 #include <gtest/gtest.h>
+#include <vector>
 
 #if defined(WIN32)
 #include <Windows.h>
@@ -193,3 +194,31 @@ TEST(LocalFileSource, URLLimit) {
 
     loop.run();
 }
+
+TEST(LocalFileSource, ConcurrentRequests) {
+    util::RunLoop loop;
+
+    LocalFileSource fs(ResourceOptions::Default(), ClientOptions());
+
+    // More than can be in flight at once, alternating whole files and ranges
+    constexpr std::size_t count = 200;
+    std::vector<std::unique_ptr<AsyncRequest>> requests;
+    std::size_t responses = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        Resource resource(Resource::Unknown, toAbsoluteURL("nonempty"));
+        if (i % 2) {
+            resource.dataRange = std::make_pair<uint64_t, uint64_t>(4, 12);
+        }
+        requests.push_back(fs.request(resource, [&, i](Response res) {
+            EXPECT_EQ(nullptr, res.error);
+            ASSERT_TRUE(res.data.get());
+            EXPECT_EQ(i % 2 ? "ent is he" : "content is here\n", *res.data);
+            if (++responses == count) {
+                loop.stop();
+            }
+        }));
+    }
+
+    loop.run();
+    EXPECT_EQ(count, responses);
+}
@@ -5,6 +5,7 @@
 #include <mbgl/util/run_loop.hpp>
 
 #include <filesystem>
+#include <vector>
 
 #include <climits>
 #include <gtest/gtest.h>
@@ -124,3 +125,28 @@ TEST(MBTilesFileSource, NonExistentTile) {
 
     loop.run();
 }
+
+// Concurrent tile requests all get their data
+TEST(MBTilesFileSource, ConcurrentTiles) {
+    util::RunLoop loop;
+
+    MBTilesFileSource mbtiles(ResourceOptions::Default(), ClientOptions());
+
+    const auto url = toAbsoluteURL("geography-class-png.mbtiles?file={z}/{x}/{y}.png");
+    std::vector<std::unique_ptr<AsyncRequest>> reqs;
+    std::size_t responses = 0;
+    for (int i = 0; i < 4; ++i) {
+        reqs.push_back(
+            mbtiles.request(Resource::tile(url, 1.0, 0, 0, 0, Tileset::Scheme::XYZ), [&](Response res) {
+                EXPECT_EQ(nullptr, res.error);
+                EXPECT_TRUE(res.data.get());
+                EXPECT_FALSE(res.noContent);
+                if (++responses == 4) {
+                    loop.stop();
+                }
+            }));
+    }
+
+    loop.run();
+    EXPECT_EQ(4u, responses);
+}
@@ -29,6 +29,7 @@ static void deleteDatabaseFiles() {
     util::deleteFile(filename);
     util::deleteFile(filename + "-wal"s);
     util::deleteFile(filename + "-journal"s);
+    util::deleteFile(filename + "-shm"s);
 }
 
 static std::shared_ptr<std::string> randomString(size_t size) {
@@ -94,6 +95,25 @@ static std::vector<std::string> databaseTableColumns(const std::string& path, co
     return columns;
 }
 
+static int64_t databaseRowCount(const std::string& path, const std::string& table) {
+    mapbox::sqlite::Database db = mapbox::sqlite::Database::open(path, mapbox::sqlite::ReadOnly);
+    const auto sql = "SELECT COUNT(*) FROM " + table;
+    mapbox::sqlite::Statement stmt{db, sql.c_str()};
+    mapbox::sqlite::Query query{stmt};
+    query.run();
+    return query.get<int64_t>(0);
+}
+
+static std::optional<int64_t> databaseAmbientCacheSize(const std::string& path) {
+    mapbox::sqlite::Database db = mapbox::sqlite::Database::open(path, mapbox::sqlite::ReadOnly);
+    mapbox::sqlite::Statement stmt{db, "SELECT size FROM ambient_cache_size"};
+    mapbox::sqlite::Query query{stmt};
+    if (!query.run()) {
+        return std::nullopt;
+    }
+    return query.get<std::optional<int64_t>>(0);
+}
+
 static int databaseAutoVacuum(const std::string& path) {
     mapbox::sqlite::Database db = mapbox::sqlite::Database::open(path, mapbox::sqlite::ReadOnly);
     mapbox::sqlite::Statement stmt{db, "pragma auto_vacuum"};
@@ -236,7 +256,7 @@ TEST(OfflineDatabase, TEST_REQUIRES_WRITE(SchemaVersion)) {
         OfflineDatabase db(filename, fixture::tileServerOptions);
     }
 
-    EXPECT_EQ(6, databaseUserVersion(filename));
+    EXPECT_EQ(10, databaseUserVersion(filename));
 
     OfflineDatabase db(filename, fixture::tileServerOptions);
     // Now try inserting and reading back to make sure we have a valid database.
@@ -366,6 +386,27 @@ TEST(OfflineDatabase, PutAndGetResource) {
     EXPECT_EQ(0u, log.uncheckedCount());
 }
 
+TEST(OfflineDatabase, MeanTileSizes) {
+    FixtureLog log;
+    OfflineDatabase db(":memory:", fixture::tileServerOptions);
+
+    auto putTile = [&](const std::string& urlTemplate, int32_t x, int8_t z, const std::string& data) {
+        Response response;
+        response.data = std::make_shared<std::string>(data);
+        db.put(Resource::tile(urlTemplate, 1, x, 0, z, Tileset::Scheme::XYZ), response);
+    };
+    putTile("http://example.com/{z}-{x}-{y}", 0, 1, "ab");
+    putTile("http://example.com/{z}-{x}-{y}", 1, 1, "abcd");
+    putTile("http://example.com/{z}-{x}-{y}", 0, 3, "abcdef");
+    putTile("http://example.org/{z}-{x}-{y}", 0, 2, "abcdefgh");
+
+    const auto sizes = db.getMeanTileSizes("http://example.com/{z}-{x}-{y}", 1, 0, 4);
+    EXPECT_EQ((std::map<uint8_t, double>{{1, 3.0}, {3, 6.0}}), sizes);
+    EXPECT_TRUE(db.getMeanTileSizes("http://example.com/{z}-{x}-{y}", 2, 0, 4).empty());
+
+    EXPECT_EQ(0u, log.uncheckedCount());
+}
+
 TEST(OfflineDatabase, PutTile) {
     FixtureLog log;
     OfflineDatabase db(":memory:", fixture::tileServerOptions);
@@ -432,6 +473,50 @@ TEST(OfflineDatabase, PutTileNotFound) {
     EXPECT_EQ(0u, log.uncheckedCount());
 }
 
+TEST(OfflineDatabase, GetTiles) {
+    FixtureLog log;
+    OfflineDatabase db(":memory:", fixture::tileServerOptions);
+
+    const auto tile = [](int32_t x, int32_t y, int8_t z) {
+        return Resource::tile("http://example.com/{z}/{x}/{y}", 1, x, y, z, Tileset::Scheme::XYZ);
+    };
+    // The tiles of a diagonal, whose x and y match those of the others in the same rows and columns
+    for (int32_t i = 0; i < 20; ++i) {
+        Response response;
+        response.data = std::make_shared<std::string>("tile " + std::to_string(i));
+        db.put(tile(i, i, 5), response);
+    }
+    Response response;
+    response.data = std::make_shared<std::string>("zoom 6");
+    db.put(tile(1, 1, 6), response);
+
+    // More tiles than a query takes, with some twice and some missing
+    std::vector<Resource> resources;
+    for (int32_t i = 0; i < 20; ++i) {
+        resources.push_back(tile(i, i, 5));
+        resources.push_back(tile(i, 19 - i, 5));
+    }
+    resources.push_back(tile(3, 3, 5));
+    resources.push_back(tile(1, 1, 6));
+    resources.push_back(tile(1, 1, 7));
+
+    const auto responses = db.getTiles(resources);
+    ASSERT_EQ(resources.size(), responses.size());
+    for (std::size_t i = 0; i < resources.size(); ++i) {
+        const auto expected = db.get(resources[i]);
+        ASSERT_EQ(bool(expected), bool(responses[i])) << i;
+        if (expected) {
+            EXPECT_EQ(*expected->data, *responses[i]->data);
+        }
+    }
+    EXPECT_EQ("tile 3", *responses[6]->data);
+    EXPECT_FALSE(responses[7]);
+    EXPECT_EQ("zoom 6", *responses[resources.size() - 2]->data);
+    EXPECT_FALSE(responses.back());
+
+    EXPECT_EQ(0u, log.uncheckedCount());
+}
+
 TEST(OfflineDatabase, CreateRegion) {
     FixtureLog log;
     OfflineDatabase db(":memory:", fixture::tileServerOptions);
@@ -1127,6 +1212,148 @@ TEST(OfflineDatabase, PutReturnsSize) {
     EXPECT_EQ(0u, log.uncheckedCount());
 }
 
+TEST(OfflineDatabase, ZstdTileCompression) {
+    FixtureLog log;
+    OfflineDatabase db(":memory:", fixture::tileServerOptions);
+    db.setZstdTileCompression(true);
+
+    // Tiles sharing a vocabulary, as the tiles of a style do, enough of them to train the dictionary
+    const std::vector<std::string> words{
+        "highway", "residential", "building", "water", "landuse", "name", "class", "rank", "poi", "road"};
+    std::mt19937 random;
+    std::vector<std::shared_ptr<const std::string>> tiles;
+    for (int i = 0; i < 200; ++i) {
+        auto data = std::make_shared<std::string>();
+        while (data->size() < 32 * 1024) {
+            *data += words[random() % words.size()] + util::toString(random() % 100);
+        }
+        tiles.push_back(std::move(data));
+    }
+
+    uint64_t storedSize = 0;
+    for (std::size_t i = 0; i < tiles.size(); ++i) {
+        Response response;
+        response.data = tiles[i];
+        const auto [inserted, size] = db.put(
+            Resource::tile("http://example.com/{z}-{x}-{y}", 1, static_cast<int32_t>(i), 0, 20, Tileset::Scheme::XYZ),
+            response);
+        EXPECT_TRUE(inserted);
+        EXPECT_LT(size, tiles[i]->size());
+        storedSize += size;
+    }
+    EXPECT_GT(storedSize, 0u);
+
+    // Reads return the original tiles, whichever compression they were stored with
+    for (std::size_t i = 0; i < tiles.size(); ++i) {
+        const auto response = db.get(
+            Resource::tile("http://example.com/{z}-{x}-{y}", 1, static_cast<int32_t>(i), 0, 20, Tileset::Scheme::XYZ));
+        ASSERT_TRUE(response && response->data);
+        EXPECT_EQ(*tiles[i], *response->data);
+    }
+
+    // Builds without zstd keep compressing with Deflate
+    log.count({EventSeverity::Warning, Event::Database, -1, "zstd tile compression isn't supported by this build"});
+    EXPECT_EQ(0u, log.uncheckedCount());
+}
+
+TEST(OfflineDatabase, TEST_REQUIRES_WRITE(TileLayouts)) {
+    FixtureLog log;
+    deleteDatabaseFiles();
+
+    Response response;
+    response.data = randomString(4096);
+    const auto tile = [](int32_t x) {
+        return Resource::tile("maptiler://tiles/{z}/{x}/{y}", 1, x, 0, 10, Tileset::Scheme::XYZ);
+    };
+
+    OfflineDatabase db(filename, fixture::tileServerOptions);
+    OfflineTilePyramidRegionDefinition definition{
+        "maptiler://maps/style", LatLngBounds::hull({1, 2}, {3, 4}), 5, 6, 2.0, true};
+    auto region = db.createRegion(definition, {});
+    ASSERT_TRUE(region);
+    db.putRegionResource(region->getID(), tile(0), response);
+    db.put(tile(1), response);
+
+    // Layouts are stored for the tiles of regions only
+    for (int32_t x = 0; x <= 1; ++x) {
+        const auto stored = db.get(tile(x));
+        ASSERT_TRUE(stored && stored->data);
+        EXPECT_FALSE(stored->layout);
+        db.putTileLayout(tile(x), *stored->data, "layout");
+    }
+    EXPECT_EQ(1, databaseRowCount(filename, "tile_layouts"));
+    auto stored = db.get(tile(0));
+    ASSERT_TRUE(stored && stored->layout);
+    EXPECT_EQ("layout", *stored->layout);
+
+    // A layout of other data is left out
+    db.putTileLayout(tile(0), "other data", "other layout");
+    stored = db.get(tile(0));
+    ASSERT_TRUE(stored && stored->data);
+    EXPECT_FALSE(stored->layout);
+
+    db.deleteRegion(std::move(*region));
+    db.clearAmbientCache();
+    EXPECT_EQ(0, databaseRowCount(filename, "tile_layouts"));
+
+    EXPECT_EQ(0u, log.uncheckedCount());
+}
+
+TEST(OfflineDatabase, TEST_REQUIRES_WRITE(SharedTilePayloads)) {
+    FixtureLog log;
+    deleteDatabaseFiles();
+
+    Response ocean;
+    ocean.data = randomString(4096);
+    Response land;
+    land.data = std::make_shared<std::string>(std::string(ocean.data->rbegin(), ocean.data->rend()));
+    const auto tile = [](int32_t x) {
+        return Resource::tile("maptiler://tiles/{z}/{x}/{y}", 1, x, 0, 10, Tileset::Scheme::XYZ);
+    };
+
+    OfflineDatabase db(filename, fixture::tileServerOptions);
+
+    OfflineTilePyramidRegionDefinition definition{
+        "maptiler://maps/style", LatLngBounds::hull({1, 2}, {3, 4}), 5, 6, 2.0, true};
+    auto region1 = db.createRegion(definition, {});
+    auto region2 = db.createRegion(definition, {});
+    ASSERT_TRUE(region1 && region2);
+
+    // Identical payloads are stored once, whichever region they belong to
+    for (int32_t x = 0; x < 10; ++x) {
+        db.putRegionResource(region1->getID(), tile(x), ocean);
+    }
+    db.putRegionResource(region2->getID(), tile(10), ocean);
+    db.putRegionResource(region2->getID(), tile(11), land);
+    EXPECT_EQ(2, databaseRowCount(filename, "tile_blobs"));
+    for (int32_t x = 0; x <= 10; ++x) {
+        const auto response = db.get(tile(x));
+        ASSERT_TRUE(response && response->data);
+        EXPECT_EQ(*ocean.data, *response->data);
+    }
+    EXPECT_EQ(10u * ocean.data->size(), db.getRegionCompletedStatus(region1->getID())->completedTileSize);
+
+    // The tiles of the deleted region go with the ambient cache, the payload stays for the other region
+    db.deleteRegion(std::move(*region1));
+    db.clearAmbientCache();
+    EXPECT_EQ(2, databaseRowCount(filename, "tiles"));
+    EXPECT_EQ(2, databaseRowCount(filename, "tile_blobs"));
+    const auto response = db.get(tile(10));
+    ASSERT_TRUE(response && response->data);
+    EXPECT_EQ(*ocean.data, *response->data);
+
+    // Updating the last tile using a payload releases it
+    db.putRegionResource(region2->getID(), tile(10), land);
+    EXPECT_EQ(1, databaseRowCount(filename, "tile_blobs"));
+
+    db.deleteRegion(std::move(*region2));
+    db.clearAmbientCache();
+    EXPECT_EQ(0, databaseRowCount(filename, "tiles"));
+    EXPECT_EQ(0, databaseRowCount(filename, "tile_blobs"));
+
+    EXPECT_EQ(0u, log.uncheckedCount());
+}
+
 TEST(OfflineDatabase, PutEvictsLeastRecentlyUsedResources) {
     FixtureLog log;
     OfflineDatabase db(":memory:", fixture::tileServerOptions);
@@ -1147,6 +1374,77 @@ TEST(OfflineDatabase, PutEvictsLeastRecentlyUsedResources) {
     EXPECT_EQ(0u, log.uncheckedCount());
 }
 
+TEST(OfflineDatabase, TEST_REQUIRES_WRITE(StoredAmbientCacheSize)) {
+    FixtureLog log;
+    deleteDatabaseFiles();
+
+    Response response;
+    response.data = randomString(1024);
+    const auto resource = [](uint32_t i) {
+        return Resource::style("http://example.com/"s + util::toString(i));
+    };
+
+    {
+        OfflineDatabase db(filename, fixture::tileServerOptions);
+        for (uint32_t i = 1; i <= 10; ++i) {
+            db.put(resource(i), response);
+        }
+    }
+    const auto stored = databaseAmbientCacheSize(filename);
+    ASSERT_TRUE(stored);
+    EXPECT_LT(0, *stored);
+
+    {
+        // Known from the last time the database was closed, and set aside while it's open
+        OfflineDatabase db(filename, fixture::tileServerOptions);
+        EXPECT_FALSE(db.continueAmbientCacheSizing());
+        EXPECT_FALSE(databaseAmbientCacheSize(filename));
+    }
+    EXPECT_EQ(stored, databaseAmbientCacheSize(filename));
+
+    {
+        // Page counts that don't match are the sign of a write the size missed
+        mapbox::sqlite::Database raw = mapbox::sqlite::Database::open(filename, mapbox::sqlite::ReadWriteCreate);
+        raw.exec("UPDATE ambient_cache_size SET page_count = 0");
+    }
+
+    {
+        OfflineDatabase db(filename, fixture::tileServerOptions);
+        EXPECT_TRUE(db.continueAmbientCacheSizing());
+
+        // Neither reads nor writes wait for the rest of the sizing
+        EXPECT_TRUE(bool(db.get(resource(1))));
+        db.put(resource(11), response);
+        EXPECT_TRUE(bool(db.get(resource(11))));
+
+        while (db.continueAmbientCacheSizing()) {
+        }
+    }
+    EXPECT_TRUE(databaseAmbientCacheSize(filename));
+
+    EXPECT_EQ(0u, log.uncheckedCount());
+}
+
+TEST(OfflineDatabase, PutEvictsOnlyWhatIsNeeded) {
+    FixtureLog log;
+    OfflineDatabase db(":memory:", fixture::tileServerOptions);
+    db.setMaximumAmbientCacheSize(1024 * 100);
+
+    Response response;
+    response.data = randomString(1024);
+
+    // These are likely to share their access time, which mustn't make eviction take all of them.
+    for (uint32_t i = 1; i <= 101; ++i) {
+        db.put(Resource::style("http://example.com/"s + util::toString(i)), response);
+    }
+
+    EXPECT_FALSE(bool(db.get(Resource::style("http://example.com/1"))));
+    EXPECT_TRUE(bool(db.get(Resource::style("http://example.com/50"))));
+    EXPECT_TRUE(bool(db.get(Resource::style("http://example.com/101"))));
+
+    EXPECT_EQ(0u, log.uncheckedCount());
+}
+
 TEST(OfflineDatabase, OfflineRegionDoesNotAffectAmbientCacheSize) {
     FixtureLog log;
     OfflineDatabase db(":memory:", fixture::tileServerOptions);
@@ -1413,6 +1711,30 @@ TEST(OfflineDatabase, BatchInsertion) {
     EXPECT_EQ(0u, log.uncheckedCount());
 }
 
+TEST(OfflineDatabase, BatchPut) {
+    FixtureLog log;
+    OfflineDatabase db(":memory:", fixture::tileServerOptions);
+
+    Response response;
+    response.data = randomString(1024);
+    std::list<std::tuple<Resource, Response>> resources;
+
+    for (uint32_t i = 1; i <= 100; i++) {
+        resources.emplace_back(Resource::style("http://example.com/"s + util::toString(i)), response);
+    }
+    resources.emplace_back(fixture::tile, fixture::response);
+
+    EXPECT_EQ(101u, db.put(resources));
+    EXPECT_EQ(0u, db.put(resources));
+
+    for (uint32_t i = 1; i <= 100; i++) {
+        EXPECT_TRUE(bool(db.get(Resource::style("http://example.com/"s + util::toString(i)))));
+    }
+    EXPECT_EQ("first", *db.get(fixture::tile)->data);
+
+    EXPECT_EQ(0u, log.uncheckedCount());
+}
+
 TEST(OfflineDatabase, BatchInsertionMapboxTileCountExceeded) {
     FixtureLog log;
     OfflineDatabase db(":memory:", fixture::tileServerOptions);
@@ -1465,7 +1787,7 @@ TEST(OfflineDatabase, MigrateFromV2Schema) {
         }
     }
 
-    EXPECT_EQ(6, databaseUserVersion(filename));
+    EXPECT_EQ(10, databaseUserVersion(filename));
     EXPECT_LT(databasePageCount(filename), databasePageCount("test/fixtures/offline_database/v2.db"));
 
     EXPECT_EQ(0u, log.uncheckedCount());
@@ -1487,7 +1809,7 @@ TEST(OfflineDatabase, MigrateFromV3Schema) {
         }
     }
 
-    EXPECT_EQ(6, databaseUserVersion(filename));
+    EXPECT_EQ(10, databaseUserVersion(filename));
 
     EXPECT_EQ(0u, log.uncheckedCount());
 }
@@ -1509,7 +1831,7 @@ TEST(OfflineDatabase, MigrateFromV4Schema) {
         }
     }
 
-    EXPECT_EQ(6, databaseUserVersion(filename));
+    EXPECT_EQ(10, databaseUserVersion(filename));
 
     // Journal mode should be DELETE after migration to v5.
     EXPECT_EQ("delete", databaseJournalMode(filename));
@@ -1536,7 +1858,7 @@ TEST(OfflineDatabase, MigrateFromV5Schema) {
         }
     }
 
-    EXPECT_EQ(6, databaseUserVersion(filename));
+    EXPECT_EQ(10, databaseUserVersion(filename));
 
     EXPECT_EQ((std::vector<std::string>{"id",
                                         "url_template",
@@ -1550,12 +1872,18 @@ TEST(OfflineDatabase, MigrateFromV5Schema) {
                                         "data",
                                         "compressed",
                                         "accessed",
-                                        "must_revalidate"}),
+                                        "must_revalidate",
+                                        "blob_id"}),
               databaseTableColumns(filename, "tiles"));
     EXPECT_EQ(
         (std::vector<std::string>{
             "id", "url", "kind", "expires", "modified", "etag", "data", "compressed", "accessed", "must_revalidate"}),
         databaseTableColumns(filename, "resources"));
+    EXPECT_EQ((std::vector<std::string>{"id", "dictionary", "created"}),
+              databaseTableColumns(filename, "compression_dictionaries"));
+    EXPECT_EQ((std::vector<std::string>{"id", "hash", "data"}), databaseTableColumns(filename, "tile_blobs"));
+    EXPECT_EQ((std::vector<std::string>{"tile_id", "data_hash", "layout"}),
+              databaseTableColumns(filename, "tile_layouts"));
 
     EXPECT_EQ(0u, log.uncheckedCount());
 }
@@ -1593,7 +1921,7 @@ TEST(OfflineDatabase, DowngradeSchema) {
         db.setMaximumAmbientCacheSize(0);
     }
 
-    EXPECT_EQ(6, databaseUserVersion(filename));
+    EXPECT_EQ(10, databaseUserVersion(filename));
 
     EXPECT_EQ((std::vector<std::string>{"id",
                                         "url_template",
@@ -1607,7 +1935,8 @@ TEST(OfflineDatabase, DowngradeSchema) {
                                         "data",
                                         "compressed",
                                         "accessed",
-                                        "must_revalidate"}),
+                                        "must_revalidate",
+                                        "blob_id"}),
               databaseTableColumns(filename, "tiles"));
     EXPECT_EQ(
         (std::vector<std::string>{
@@ -1772,6 +2101,26 @@ TEST(OfflineDatabase, MergeDatabaseWithSingleRegion_New) {
     EXPECT_EQ(5u, status->completedTileCount);
 }
 
+TEST(OfflineDatabase, MergeDatabaseProgress) {
+    util::deleteFile(filename_sideload);
+    util::copyFile(filename_sideload, "test/fixtures/offline_database/sideload_sat.db");
+
+    OfflineDatabase db(":memory:", fixture::tileServerOptions);
+    std::vector<std::pair<uint64_t, uint64_t>> progress;
+    auto result = db.mergeDatabase(filename_sideload,
+                                   [&](uint64_t merged, uint64_t total) { progress.emplace_back(merged, total); });
+    ASSERT_TRUE(result);
+
+    // One call per batch of side tiles, ending with all of them
+    ASSERT_FALSE(progress.empty());
+    EXPECT_GT(progress.back().second, 0u);
+    EXPECT_EQ(progress.back().second, progress.back().first);
+    for (std::size_t i = 1; i < progress.size(); ++i) {
+        EXPECT_LT(progress[i - 1].first, progress[i].first);
+    }
+    EXPECT_EQ(5u, db.getRegionCompletedStatus(result->front().getID())->completedTileCount);
+}
+
 TEST(OfflineDatabase, TEST_REQUIRES_WRITE(MergeDatabaseWithSingleRegion_Update)) {
     deleteDatabaseFiles();
     util::deleteFile(filename_sideload);
@@ -2070,3 +2419,53 @@ TEST(OfflineDatabase, TEST_REQUIRES_WRITE(UpdateDatabaseReadOnlyMode)) {
 
     EXPECT_EQ(0u, log.uncheckedCount());
 }
+
+TEST(OfflineDatabase, TEST_REQUIRES_WRITE(CacheGradeDurability)) {
+    FixtureLog log;
+    deleteDatabaseFiles();
+
+    OfflineTilePyramidRegionDefinition definition{
+        "http://example.com/style", LatLngBounds::hull({1, 2}, {3, 4}), 5, 6, 2.0, true};
+    OfflineRegionMetadata metadata{{1, 2, 3}};
+
+    {
+        OfflineDatabase db(filename, fixture::tileServerOptions);
+        db.setCacheGradeDurability(true);
+        EXPECT_EQ("wal", databaseJournalMode(filename));
+
+        // Ambient cache writes are batched, but visible to reads right away
+        db.put(fixture::resource, fixture::response);
+        EXPECT_TRUE(db.hasPendingAmbientWrites());
+        EXPECT_TRUE(bool(db.get(fixture::resource)));
+        db.commitAmbientWrites();
+        EXPECT_FALSE(db.hasPendingAmbientWrites());
+
+        // Batches are committed when full
+        for (auto i = 0; i < 64; i++) {
+            db.put(Resource::style("http://example.com/" + std::to_string(i)), fixture::response);
+        }
+        EXPECT_FALSE(db.hasPendingAmbientWrites());
+
+        // Region writes commit the pending batch first
+        db.put(fixture::tile, fixture::response);
+        auto region = db.createRegion(definition, metadata);
+        ASSERT_TRUE(region);
+        EXPECT_FALSE(db.hasPendingAmbientWrites());
+        db.putRegionResource(region->getID(), Resource::style("http://example.com/region"), fixture::response);
+
+        // Closing the database commits the pending batch
+        db.put(Resource::style("http://example.com/last"), fixture::response);
+        EXPECT_TRUE(db.hasPendingAmbientWrites());
+    }
+
+    {
+        // The default profile switches back to the rollback journal
+        OfflineDatabase db(filename, fixture::tileServerOptions);
+        db.setCacheGradeDurability(false);
+        EXPECT_TRUE(bool(db.get(Resource::style("http://example.com/last"))));
+        EXPECT_TRUE(bool(db.getRegionResource(Resource::style("http://example.com/region"))));
+        EXPECT_EQ("delete", databaseJournalMode(filename));
+    }
+
+    EXPECT_EQ(0u, log.uncheckedCount());
+}
@@ -52,9 +52,14 @@ public:
         if (mapboxTileCountLimitExceededFn) mapboxTileCountLimitExceededFn(limit);
     }
 
+    void downloadRateChanged(OfflineRegionDownloadRate rate) override {
+        if (downloadRateChangedFn) downloadRateChangedFn(rate);
+    }
+
     std::function<void(OfflineRegionStatus)> statusChangedFn;
     std::function<void(Response::Error)> responseErrorFn;
     std::function<void(uint64_t)> mapboxTileCountLimitExceededFn;
+    std::function<void(OfflineRegionDownloadRate)> downloadRateChangedFn;
 };
 
 class OfflineTest {
@@ -398,6 +403,54 @@ TEST(OfflineDownload, DoesNotFloodTheFileSourceWithRequests) {
     EXPECT_EQ(*fileSource.getProperty(MAX_CONCURRENT_REQUESTS_KEY).getUint(), fileSource.requests.size());
 }
 
+TEST(OfflineDownload, BacksOffAfterErrors) {
+    OfflineTest test;
+    FakeOnlineFileSource fileSource;
+    auto region = test.createRegion();
+    ASSERT_TRUE(region);
+    OfflineDownload download(region->getID(),
+                             OfflineTilePyramidRegionDefinition(
+                                 "http://127.0.0.1:3000/style.json", LatLngBounds::world(), 0.0, 0.0, 1.0, true),
+                             test.db,
+                             fileSource);
+
+    auto observer = std::make_unique<MockObserver>();
+    std::vector<OfflineRegionDownloadRate> rates;
+    observer->downloadRateChangedFn = [&](OfflineRegionDownloadRate rate) {
+        rates.push_back(rate);
+    };
+
+    download.setObserver(std::move(observer));
+    download.setState(OfflineRegionDownloadState::Active);
+    test.loop.runOnce();
+
+    fileSource.respond(Resource::Kind::Style, test.response("style.json"));
+    test.loop.runOnce();
+
+    const auto maxConcurrentRequests = *fileSource.getProperty(MAX_CONCURRENT_REQUESTS_KEY).getUint();
+    ASSERT_EQ(maxConcurrentRequests, fileSource.requests.size());
+
+    // A full window of failed attempts halves the number of requests in flight
+    Response failure;
+    failure.error = std::make_unique<Response::Error>(Response::Error::Reason::Connection, "connection refused");
+    while (rates.empty()) {
+        ASSERT_TRUE(fileSource.respond(Resource::Kind::Glyphs, failure));
+    }
+
+    ASSERT_EQ(1u, rates.size());
+    EXPECT_EQ(maxConcurrentRequests / 2, rates[0].concurrentRequests);
+    EXPECT_EQ(0.0, rates[0].bytesPerSecond);
+    EXPECT_EQ(0.0, rates[0].tilesPerSecond);
+
+    // The requests already in flight finish, but aren't replaced until below the new limit
+    for (uint64_t i = 0; i <= maxConcurrentRequests / 2; i++) {
+        ASSERT_TRUE(fileSource.respond(Resource::Kind::Glyphs, test.response("glyph.pbf")));
+    }
+    test.loop.runOnce();
+
+    EXPECT_EQ(maxConcurrentRequests / 2, fileSource.requests.size());
+}
+
 TEST(OfflineDownload, GetStatusNoResources) {
     OfflineTest test;
     auto region = test.createRegion();
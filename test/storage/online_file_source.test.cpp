@@ -603,6 +603,135 @@ TEST(OnlineFileSource, TEST_REQUIRES_SERVER(LowHighPriorityRequestsMany)) {
     loop.run();
 }
 
+TEST(OnlineFileSource, TEST_REQUIRES_SERVER(RankedRequests)) {
+    util::RunLoop loop;
+    std::unique_ptr<FileSource> fs = std::make_unique<OnlineFileSource>(ResourceOptions::Default(), ClientOptions());
+    std::vector<std::string> responses;
+    const std::size_t NUM_REQUESTS = 4;
+
+    NetworkStatus::Set(NetworkStatus::Status::Offline);
+    fs->setProperty(MAX_CONCURRENT_REQUESTS_KEY, 1u);
+    fs->pause();
+
+    std::vector<std::unique_ptr<AsyncRequest>> collector;
+    auto request = [&](Resource resource) {
+        collector.push_back(fs->request(resource, [&, url = resource.url](Response) {
+            responses.push_back(url);
+            if (responses.size() == NUM_REQUESTS) {
+                loop.stop();
+            }
+        }));
+    };
+
+    // Regular request that takes the only connection, the others have to wait for it.
+    request({Resource::Unknown, "http://127.0.0.1:3000/load/0"});
+
+    std::vector<std::shared_ptr<std::atomic<float>>> ranks;
+    for (int i = 1; i < static_cast<int>(NUM_REQUESTS); i++) {
+        Resource resource{Resource::Unknown, "http://127.0.0.1:3000/load/" + std::to_string(i)};
+        resource.setPriority(Resource::Priority::Low);
+        resource.rank = std::make_shared<std::atomic<float>>(static_cast<float>(NUM_REQUESTS - i));
+        ranks.push_back(resource.rank);
+        request(std::move(resource));
+    }
+
+    // Reverse the order after the requests were made, the queue should follow the update.
+    for (std::size_t i = 0; i < ranks.size(); i++) {
+        ranks[i]->store(static_cast<float>(i));
+    }
+
+    fs->resume();
+    NetworkStatus::Set(NetworkStatus::Status::Online);
+    loop.run();
+
+    EXPECT_EQ(std::vector<std::string>({"http://127.0.0.1:3000/load/0",
+                                        "http://127.0.0.1:3000/load/1",
+                                        "http://127.0.0.1:3000/load/2",
+                                        "http://127.0.0.1:3000/load/3"}),
+              responses);
+}
+
+TEST(OnlineFileSource, TEST_REQUIRES_SERVER(RevalidationsYieldToRequests)) {
+    util::RunLoop loop;
+    std::unique_ptr<FileSource> fs = std::make_unique<OnlineFileSource>(ResourceOptions::Default(), ClientOptions());
+    std::vector<std::string> responses;
+    const std::size_t NUM_REQUESTS = 4;
+
+    ASSERT_EQ(*fs->getProperty(MAX_CONCURRENT_REVALIDATIONS_KEY).getUint(), 0u);
+
+    fs->setProperty(MAX_CONCURRENT_REQUESTS_KEY, 1u);
+    fs->setProperty(MAX_CONCURRENT_REVALIDATIONS_KEY, 1u);
+    ASSERT_EQ(*fs->getProperty(MAX_CONCURRENT_REVALIDATIONS_KEY).getUint(), 1u);
+    fs->pause();
+
+    std::vector<std::unique_ptr<AsyncRequest>> collector;
+    auto request = [&](Resource resource) {
+        collector.push_back(fs->request(resource, [&, url = resource.url](Response) {
+            responses.push_back(url);
+            if (responses.size() == NUM_REQUESTS) {
+                loop.stop();
+            }
+        }));
+    };
+
+    // Regular request that takes the only connection.
+    request({Resource::Unknown, "http://127.0.0.1:3000/load/0"});
+
+    // Revalidations of data that was already served, queued behind the regular requests although
+    // they are of regular priority and made first.
+    for (int i = 1; i <= 2; i++) {
+        Resource resource{Resource::Unknown, "http://127.0.0.1:3000/load/" + std::to_string(i)};
+        resource.priorEtag = "snowfall";
+        request(std::move(resource));
+    }
+
+    request({Resource::Unknown, "http://127.0.0.1:3000/load/3"});
+
+    fs->resume();
+    loop.run();
+
+    EXPECT_EQ(std::vector<std::string>({"http://127.0.0.1:3000/load/0",
+                                        "http://127.0.0.1:3000/load/3",
+                                        "http://127.0.0.1:3000/load/1",
+                                        "http://127.0.0.1:3000/load/2"}),
+              responses);
+}
+
+TEST(OnlineFileSource, TEST_REQUIRES_SERVER(NetworkMetrics)) {
+    util::RunLoop loop;
+    std::unique_ptr<FileSource> fs = std::make_unique<OnlineFileSource>(ResourceOptions::Default(), ClientOptions());
+    const std::size_t NUM_REQUESTS = 3;
+    std::size_t responses = 0;
+
+    ASSERT_FALSE(*fs->getProperty(ADAPTIVE_CONCURRENCY_KEY).getBool());
+    fs->setProperty(ADAPTIVE_CONCURRENCY_KEY, true);
+    ASSERT_TRUE(*fs->getProperty(ADAPTIVE_CONCURRENCY_KEY).getBool());
+
+    std::vector<std::unique_ptr<AsyncRequest>> collector;
+    for (std::size_t i = 0; i < NUM_REQUESTS; i++) {
+        collector.push_back(
+            fs->request({Resource::Unknown, "http://127.0.0.1:3000/load/" + std::to_string(i)}, [&](Response res) {
+                EXPECT_EQ(nullptr, res.error);
+                if (++responses == NUM_REQUESTS) {
+                    loop.stop();
+                }
+            }));
+    }
+    loop.run();
+
+    const auto metrics = fs->getProperty(NETWORK_METRICS_KEY);
+    const auto* object = metrics.getObject();
+    ASSERT_TRUE(object);
+    EXPECT_GT(*object->at("rtt-ms").getDouble(), 0.0);
+    const auto concurrency = *object->at("concurrency").getUint();
+    EXPECT_GE(concurrency, 1u);
+    EXPECT_LE(concurrency, 20u);
+
+    const auto& unknown = *object->at("classes").getObject()->at("unknown").getObject();
+    EXPECT_EQ(NUM_REQUESTS, *unknown.at("requests").getUint());
+    EXPECT_GT(*unknown.at("bytes").getUint(), 0u);
+}
+
 TEST(OnlineFileSource, TEST_REQUIRES_SERVER(MaximumConcurrentRequests)) {
     util::RunLoop loop;
     std::unique_ptr<FileSource> fs = std::make_unique<OnlineFileSource>(ResourceOptions::Default(), ClientOptions());
@@ -613,6 +742,39 @@ TEST(OnlineFileSource, TEST_REQUIRES_SERVER(MaximumConcurrentRequests)) {
     ASSERT_EQ(*fs->getProperty(MAX_CONCURRENT_REQUESTS_KEY).getUint(), 10u);
 }
 
+TEST(OnlineFileSource, TEST_REQUIRES_SERVER(CoalesceIdenticalRequests)) {
+    util::RunLoop loop;
+    std::unique_ptr<FileSource> fs = std::make_unique<OnlineFileSource>(ResourceOptions::Default(), ClientOptions());
+    std::vector<Response> responses;
+
+    // Queue all the requests, so that they're in flight at the same time.
+    fs->pause();
+
+    std::vector<std::unique_ptr<AsyncRequest>> requests;
+    for (int i = 0; i < 3; ++i) {
+        requests.emplace_back(fs->request({Resource::Unknown, "http://127.0.0.1:3000/test"}, [&](Response res) {
+            responses.push_back(res);
+            if (responses.size() == 2) {
+                loop.stop();
+            }
+        }));
+    }
+
+    // Cancelling one of them leaves the shared request to the others.
+    requests[1].reset();
+
+    fs->resume();
+    loop.run();
+
+    ASSERT_EQ(2u, responses.size());
+    for (const auto& res : responses) {
+        EXPECT_EQ(nullptr, res.error);
+        ASSERT_TRUE(res.data.get());
+        EXPECT_EQ("Hello World!", *res.data);
+    }
+    EXPECT_EQ(responses[0].data.get(), responses[1].data.get());
+}
+
 TEST(OnlineFileSource, TEST_REQUIRES_SERVER(RequestSameUrlMultipleTimes)) {
     util::RunLoop loop;
     std::unique_ptr<FileSource> fs = std::make_unique<OnlineFileSource>(ResourceOptions::Default(), ClientOptions());
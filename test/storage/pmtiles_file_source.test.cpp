@@ -1,3 +1,4 @@
+#include <mbgl/platform/settings.hpp>
 #include <mbgl/storage/pmtiles_file_source.hpp>
 #include <mbgl/storage/resource.hpp>
 #include <mbgl/storage/resource_options.hpp>
@@ -7,6 +8,7 @@
 #include <filesystem>
 
 #include <climits>
+#include <limits>
 #include <gtest/gtest.h>
 
 namespace {
@@ -16,6 +18,21 @@ std::string toAbsoluteURL(const std::string &fileName) {
     return std::string(mbgl::util::PMTILES_PROTOCOL) + std::string(mbgl::util::FILE_PROTOCOL) + path.string();
 }
 
+mbgl::Response requestOnce(const mbgl::Resource& resource) {
+    mbgl::util::RunLoop loop;
+    mbgl::PMTilesFileSource pmtiles(mbgl::ResourceOptions::Default(), mbgl::ClientOptions());
+
+    mbgl::Response result;
+    std::unique_ptr<mbgl::AsyncRequest> req = pmtiles.request(resource, [&](mbgl::Response res) {
+        req.reset();
+        result = std::move(res);
+        loop.stop();
+    });
+
+    loop.run();
+    return result;
+}
+
 } // namespace
 
 using namespace mbgl;
@@ -143,3 +160,110 @@ TEST(PMTilesFileSource, UncompressedTile) {
 
     loop.run();
 }
+
+// Memory-mapped local archives serve the same data as range requests through the file source
+TEST(PMTilesFileSource, MappedFile) {
+    const std::vector<Resource> resources{
+        {Resource::Unknown, toAbsoluteURL("geography-class-png.pmtiles")},
+        Resource::tile(toAbsoluteURL("geography-class-png.pmtiles"), 1.0, 0, 0, 0, Tileset::Scheme::XYZ),
+        Resource::tile(toAbsoluteURL("geography-class-png.pmtiles"), 1.0, 1, 1, 1, Tileset::Scheme::XYZ),
+        Resource::tile(toAbsoluteURL("geography-class-png.pmtiles"), 1.0, 0, 0, 4, Tileset::Scheme::XYZ),
+        Resource::tile(toAbsoluteURL("uncompressed-tiles.pmtiles"), 1.0, 0, 0, 0, Tileset::Scheme::XYZ),
+    };
+
+    auto& settings = platform::Settings::getInstance();
+    std::vector<Response> expected;
+    for (const auto& resource : resources) {
+        expected.push_back(requestOnce(resource));
+    }
+
+    settings.set(platform::EXPERIMENTAL_PMTILES_MMAP, true);
+    for (std::size_t i = 0; i < resources.size(); ++i) {
+        const auto response = requestOnce(resources[i]);
+        EXPECT_EQ(nullptr, response.error) << i;
+        EXPECT_EQ(expected[i].noContent, response.noContent) << i;
+        ASSERT_EQ(bool(expected[i].data), bool(response.data)) << i;
+        if (response.data) {
+            EXPECT_EQ(*expected[i].data, *response.data) << i;
+        }
+    }
+
+    // Missing files still go through the file source and report it
+    const auto missing = requestOnce({Resource::Unknown, toAbsoluteURL("does_not_exist")});
+    ASSERT_NE(nullptr, missing.error);
+    EXPECT_EQ(Response::Error::Reason::NotFound, missing.error->reason);
+
+    settings.set(platform::EXPERIMENTAL_PMTILES_MMAP, false);
+}
+
+// Ranges requested together share range requests, and the root directory comes with the header
+TEST(PMTilesFileSource, CoalescesRanges) {
+    util::RunLoop loop;
+    PMTilesFileSource pmtiles(ResourceOptions::Default(), ClientOptions());
+
+    std::vector<Resource> resources;
+    for (int32_t x = 0; x < 2; ++x) {
+        for (int32_t y = 0; y < 2; ++y) {
+            resources.push_back(
+                Resource::tile(toAbsoluteURL("geography-class-png.pmtiles"), 1.0, x, y, 1, Tileset::Scheme::XYZ));
+        }
+    }
+
+    std::vector<std::unique_ptr<AsyncRequest>> requests;
+    std::vector<Response> responses(resources.size());
+    std::size_t remaining = resources.size();
+    for (std::size_t i = 0; i < resources.size(); ++i) {
+        requests.push_back(pmtiles.request(resources[i], [&, i](Response res) {
+            responses[i] = std::move(res);
+            if (--remaining == 0) {
+                loop.stop();
+            }
+        }));
+    }
+
+    loop.run();
+
+    for (std::size_t i = 0; i < resources.size(); ++i) {
+        const auto expected = requestOnce(resources[i]);
+        EXPECT_EQ(nullptr, responses[i].error) << i;
+        ASSERT_TRUE(expected.data) << i;
+        ASSERT_TRUE(responses[i].data) << i;
+        EXPECT_EQ(*expected.data, *responses[i].data) << i;
+    }
+
+    // One for the header and root directory, one for the four adjacent tiles
+    const auto rangeRequests = pmtiles.getProperty(PMTILES_RANGE_REQUESTS_KEY);
+    ASSERT_TRUE(rangeRequests.getUint());
+    EXPECT_EQ(2u, *rangeRequests.getUint());
+}
+
+// Decoded directories are shared by all sources within the byte budget
+TEST(PMTilesFileSource, DirectoryCache) {
+    PMTilesFileSource pmtiles(ResourceOptions::Default(), ClientOptions());
+    const auto getCounter = [&](const char* key) {
+        const auto value = pmtiles.getProperty(key);
+        return value.getUint() ? *value.getUint() : std::numeric_limits<uint64_t>::max();
+    };
+    const auto resource =
+        Resource::tile(toAbsoluteURL("geography-class-png.pmtiles"), 1.0, 0, 0, 0, Tileset::Scheme::XYZ);
+    const auto maximumSize = getCounter(PMTILES_DIRECTORY_CACHE_SIZE_KEY);
+
+    const auto hits = getCounter(PMTILES_DIRECTORY_CACHE_HITS_KEY);
+    const auto misses = getCounter(PMTILES_DIRECTORY_CACHE_MISSES_KEY);
+    ASSERT_TRUE(requestOnce(resource).data);
+    ASSERT_TRUE(requestOnce(resource).data);
+
+    // The root directory comes with the header, so the other source finds it too
+    EXPECT_EQ(hits + 2, getCounter(PMTILES_DIRECTORY_CACHE_HITS_KEY));
+    EXPECT_EQ(misses, getCounter(PMTILES_DIRECTORY_CACHE_MISSES_KEY));
+    EXPECT_LT(0u, getCounter(PMTILES_DIRECTORY_CACHE_USAGE_KEY));
+
+    // Without a budget, nothing is kept but tiles still load
+    pmtiles.setProperty(PMTILES_DIRECTORY_CACHE_SIZE_KEY, uint64_t(0));
+    EXPECT_EQ(0u, getCounter(PMTILES_DIRECTORY_CACHE_USAGE_KEY));
+    ASSERT_TRUE(requestOnce(resource).data);
+    EXPECT_EQ(misses + 1, getCounter(PMTILES_DIRECTORY_CACHE_MISSES_KEY));
+    EXPECT_EQ(0u, getCounter(PMTILES_DIRECTORY_CACHE_USAGE_KEY));
+
+    pmtiles.setProperty(PMTILES_DIRECTORY_CACHE_SIZE_KEY, maximumSize);
+}
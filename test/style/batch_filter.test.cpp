@@ -0,0 +1,131 @@
+#include <mbgl/test/util.hpp>
+#include <mbgl/test/stub_geometry_tile_feature.hpp>
+
+#include <mbgl/style/batch_filter.hpp>
+#include <mbgl/style/conversion/filter.hpp>
+#include <mbgl/style/conversion/json.hpp>
+#include <mbgl/style/filter.hpp>
+#include <mbgl/tile/tile_id.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace mbgl;
+using namespace mbgl::style;
+
+namespace {
+
+class ColumnLayer : public GeometryTileLayer {
+public:
+    ColumnLayer(bool columns_)
+        : columns(columns_) {
+        const std::vector<std::string> classes = {"park", "forest", "wood", "water"};
+        for (int i = 0; i < 40; ++i) {
+            PropertyMap properties{{"class", classes[i % classes.size()]}};
+            // Some ranks are strings, making numeric comparisons fail at runtime
+            properties["rank"] = i % 7 == 0 ? Value(std::to_string(i)) : Value(static_cast<int64_t>(i % 5));
+            if (i % 3 == 0) {
+                properties["name"] = "name " + std::to_string(i);
+            }
+            features.push_back(std::move(properties));
+        }
+    }
+
+    std::size_t featureCount() const override { return features.size(); }
+    std::unique_ptr<GeometryTileFeature> getFeature(std::size_t i) const override {
+        return std::make_unique<StubGeometryTileFeature>(features[i]);
+    }
+    std::string getName() const override { return "test"; }
+
+    std::optional<std::vector<std::optional<Value>>> getPropertyColumn(const std::string& key) const override {
+        if (!columns) {
+            return std::nullopt;
+        }
+        std::vector<std::optional<Value>> column;
+        for (const auto& feature : features) {
+            const auto it = feature.find(key);
+            column.push_back(it != feature.end() ? std::optional<Value>(it->second) : std::nullopt);
+        }
+        return column;
+    }
+
+private:
+    bool columns;
+    std::vector<PropertyMap> features;
+};
+
+Filter parse(const char* json) {
+    conversion::Error error;
+    std::optional<Filter> filter = conversion::convertJSON<Filter>(json, error);
+    EXPECT_TRUE(filter) << error.message;
+    return filter ? *filter : Filter();
+}
+
+// The batch result matches evaluating the filter feature by feature
+void expectSameSelection(const char* json) {
+    const Filter filter = parse(json);
+    const auto batchFilter = BatchFilter::compile(filter);
+    ASSERT_TRUE(batchFilter) << json;
+
+    const ColumnLayer layer(true);
+    const CanonicalTileID tileID(10, 0, 0);
+    const auto selected = batchFilter->evaluate(layer, 10.0f, tileID);
+    ASSERT_TRUE(selected);
+    ASSERT_EQ(layer.featureCount(), selected->size());
+
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < layer.featureCount(); ++i) {
+        const auto feature = layer.getFeature(i);
+        EXPECT_EQ(filter(expression::EvaluationContext(10.0f, feature.get()).withCanonicalTileID(&tileID)),
+                  (*selected)[i])
+            << json << " feature " << i;
+        count += (*selected)[i];
+    }
+    EXPECT_GT(count, 0u) << json;
+}
+
+} // namespace
+
+TEST(BatchFilter, MatchesFeatureFilter) {
+    expectSameSelection(R"(["==", ["get", "class"], "park"])");
+    expectSameSelection(R"(["all", ["==", "class", "park"], [">", "rank", 2]])");
+    expectSameSelection(R"(["in", "class", "park", "wood"])");
+    expectSameSelection(R"(["!has", "name"])");
+    expectSameSelection(R"(["any", ["in", ["get", "class"], ["literal", ["park", "forest"]]], ["has", "name"]])");
+    expectSameSelection(R"(["match", ["get", "class"], ["park", "wood"], true, false])");
+    expectSameSelection(R"(["all", ["==", ["get", "class"], "park"], [">=", ["zoom"], 5]])");
+    expectSameSelection(R"(["all", ["!=", ["get", "class"], "water"], ["any", ["has", "name"], ["<", "rank", 2]]])");
+}
+
+TEST(BatchFilter, StopsAtErrors) {
+    // A runtime type error in an earlier child decides `any`, as a later `true` would
+    expectSameSelection(R"(["any", ["<", ["get", "rank"], 3], ["==", ["get", "class"], "forest"]])");
+    expectSameSelection(R"(["all", ["==", ["get", "class"], "park"], ["<", ["get", "rank"], 3]])");
+}
+
+TEST(BatchFilter, Unsupported) {
+    EXPECT_FALSE(BatchFilter::compile(Filter()));
+    EXPECT_FALSE(BatchFilter::compile(parse(R"(["==", ["geometry-type"], "Point"])")));
+    EXPECT_FALSE(BatchFilter::compile(parse(R"(["==", ["get", "class"], ["get", "name"]])")));
+    EXPECT_FALSE(BatchFilter::compile(parse(R"(["all", ["has", "name"], ["==", ["id"], 1]])")));
+
+    // Several properties are fine in separate parts
+    EXPECT_TRUE(BatchFilter::compile(parse(R"(["all", ["has", "name"], ["==", ["get", "class"], "park"]])")));
+
+    // Layers without property columns are left to per-feature evaluation
+    const auto batchFilter = BatchFilter::compile(parse(R"(["==", ["get", "class"], "park"])"));
+    ASSERT_TRUE(batchFilter);
+    EXPECT_FALSE(batchFilter->evaluate(ColumnLayer(false), 10.0f, CanonicalTileID(10, 0, 0)));
+}
+
+TEST(BatchFilter, CompiledOnce) {
+    // Copies of a filter, as held by the layers of a style, share the compiled form
+    const auto filter = parse(R"(["==", ["get", "class"], "park"])");
+    const Filter copy = filter;
+    const auto* batchFilter = BatchFilter::get(filter);
+    ASSERT_TRUE(batchFilter);
+    EXPECT_EQ(batchFilter, BatchFilter::get(copy));
+
+    EXPECT_FALSE(BatchFilter::get(Filter()));
+    EXPECT_FALSE(BatchFilter::get(parse(R"(["==", ["geometry-type"], "Point"])")));
+}
@@ -0,0 +1,98 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/style/conversion/geojson.hpp>
+
+using namespace mbgl;
+using namespace mbgl::style::conversion;
+
+namespace {
+
+const std::string collection = R"JSON({
+    "type": "FeatureCollection",
+    "features": [
+        {"type": "Feature", "id": 1, "geometry": {"type": "Point", "coordinates": [1, 2]},
+         "properties": {"a": [1, {"b": null}]}},
+        {"type": "Feature", "id": 2, "geometry": {"coordinates": [[0, 0], [1, 1]], "type": "LineString"},
+         "properties": {}},
+        {"type": "Feature", "id": "3", "geometry": {"type": "Point", "coordinates": [0, 0]}, "properties": {}},
+        {"type": "Feature", "id": 4, "geometry": {"type": "Point", "coordinates": [-1.5, 2.5]},
+         "properties": {"c": true}},
+        {"type": "Feature", "id": 5, "geometry": {"type": "Point", "coordinates": [3, 4]}, "properties": {"d": -2}}
+    ]
+})JSON";
+
+} // namespace
+
+TEST(GeoJSONConversion, StreamsFeatureCollections) {
+    std::vector<mapbox::geojson::feature> streamed;
+    std::vector<std::size_t> chunkSizes;
+    std::size_t lastBytesRead = 0;
+
+    Error error;
+    const auto result = parseGeoJSON(
+        collection,
+        2,
+        [&](mapbox::geojson::feature_collection&& chunk, std::size_t bytesRead) {
+            EXPECT_GT(bytesRead, lastBytesRead);
+            lastBytesRead = bytesRead;
+            chunkSizes.push_back(chunk.size());
+            streamed.insert(streamed.end(), chunk.begin(), chunk.end());
+        },
+        error);
+    ASSERT_TRUE(result) << error.message;
+    ASSERT_TRUE(result->is<mapbox::geojson::feature_collection>());
+    EXPECT_TRUE(result->get<mapbox::geojson::feature_collection>().empty());
+    EXPECT_EQ((std::vector<std::size_t>{2, 2, 1}), chunkSizes);
+
+    // The same features as parsing the whole document
+    const auto whole = parseGeoJSON(collection, error);
+    ASSERT_TRUE(whole);
+    const auto& expected = whole->get<mapbox::geojson::feature_collection>();
+    ASSERT_EQ(expected.size(), streamed.size());
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(expected[i], streamed[i]);
+    }
+}
+
+TEST(GeoJSONConversion, ReturnsEverythingElseWhole) {
+    std::size_t chunks = 0;
+    const auto onFeatures = [&](mapbox::geojson::feature_collection&&, std::size_t) { ++chunks; };
+    Error error;
+
+    // A collection whose type comes last can only be recognized once it's been read
+    auto result = parseGeoJSON(
+        R"JSON({
+            "features": [{"type": "Feature", "geometry": {"type": "Point", "coordinates": [0, 0]}, "properties": {}}],
+            "type": "FeatureCollection"
+        })JSON",
+        1,
+        onFeatures,
+        error);
+    ASSERT_TRUE(result) << error.message;
+    EXPECT_EQ(1u, result->get<mapbox::geojson::feature_collection>().size());
+
+    result = parseGeoJSON(
+        R"JSON({"type": "Feature", "geometry": {"type": "Point", "coordinates": [1, 2]}, "properties": {}})JSON",
+        1,
+        onFeatures,
+        error);
+    ASSERT_TRUE(result) << error.message;
+    EXPECT_TRUE(result->is<mapbox::geojson::feature>());
+
+    result = parseGeoJSON(R"JSON({"type": "Point", "coordinates": [1, 2]})JSON", 1, onFeatures, error);
+    ASSERT_TRUE(result) << error.message;
+    EXPECT_TRUE(result->is<mapbox::geojson::geometry>());
+    EXPECT_EQ(0u, chunks);
+}
+
+TEST(GeoJSONConversion, StreamingErrors) {
+    const auto onFeatures = [&](mapbox::geojson::feature_collection&&, std::size_t) {};
+    Error error;
+
+    EXPECT_FALSE(parseGeoJSON(R"JSON({"type": "FeatureCollection", "features": [1]})JSON", 1, onFeatures, error));
+    EXPECT_FALSE(error.message.empty());
+
+    error = {};
+    EXPECT_FALSE(parseGeoJSON(R"JSON({"type": "FeatureCollection", "features": [)JSON", 1, onFeatures, error));
+    EXPECT_NE(std::string::npos, error.message.find("at offset"));
+}
@@ -0,0 +1,122 @@
+#include <mbgl/platform/settings.hpp>
+#include <mbgl/style/expression/bytecode.hpp>
+#include <mbgl/style/expression/dsl.hpp>
+#include <mbgl/style/property_expression.hpp>
+#include <mbgl/test/stub_geometry_tile_feature.hpp>
+#include <mbgl/test/util.hpp>
+
+#include <cmath>
+
+using namespace mbgl;
+using namespace mbgl::style::expression;
+
+using namespace std::string_literals;
+
+namespace {
+
+const StubGeometryTileFeature feature{
+    PropertyMap{{"int", int64_t(-3)}, {"uint", uint64_t(7)}, {"double", 2.5}, {"string", "7"s}}};
+
+// Evaluates with both the bytecode and the tree, which must agree on the result or on failing
+void expectSameAsTree(const char* json, std::optional<float> zoom = {}) {
+    SCOPED_TRACE(json);
+    const auto expression = dsl::createExpression(json);
+    ASSERT_TRUE(expression);
+    const auto bytecode = Bytecode::compile(*expression);
+    ASSERT_TRUE(bytecode);
+
+    const EvaluationContext context = zoom ? EvaluationContext(*zoom, &feature) : EvaluationContext(&feature);
+    const auto tree = expression->evaluate(context);
+    if (bytecode->isColor()) {
+        const auto color = bytecode->evaluateColor(context);
+        ASSERT_EQ(bool(tree), bool(color));
+        if (color) {
+            EXPECT_EQ(tree->get<Color>(), *color);
+        }
+        return;
+    }
+
+    const auto number = bytecode->evaluateNumber(context);
+    ASSERT_EQ(bool(tree), bool(number));
+    if (!number) {
+        return;
+    }
+    const double expected = tree->get<double>();
+    if (std::isnan(expected)) {
+        EXPECT_TRUE(std::isnan(*number));
+    } else {
+        EXPECT_EQ(expected, *number);
+        EXPECT_EQ(std::signbit(expected), std::signbit(*number));
+    }
+}
+
+} // namespace
+
+TEST(Bytecode, Arithmetic) {
+    expectSameAsTree(R"(["+", 1, ["get", "double"], ["get", "int"]])");
+    expectSameAsTree(R"(["+", -0, -0])");
+    expectSameAsTree(R"(["-", ["get", "uint"], 0.5])");
+    expectSameAsTree(R"(["-", ["get", "double"]])");
+    expectSameAsTree(R"(["*", 2, ["get", "double"], ["get", "uint"]])");
+    expectSameAsTree(R"(["/", ["get", "double"], 0])");
+    expectSameAsTree(R"(["/", ["-", ["get", "double"]], 0])");
+    expectSameAsTree(R"(["/", 0, 0])");
+    expectSameAsTree(R"(["%", ["get", "uint"], 3])");
+    expectSameAsTree(R"(["^", ["get", "double"], 2])");
+    expectSameAsTree(R"(["min", ["get", "double"], ["sqrt", -1]])");
+    expectSameAsTree(R"(["max", ["get", "int"], ["get", "uint"], 1])");
+    expectSameAsTree(R"(["abs", ["get", "int"]])");
+    expectSameAsTree(R"(["floor", ["get", "double"]])");
+    expectSameAsTree(R"(["ceil", ["get", "double"]])");
+    expectSameAsTree(R"(["round", ["get", "double"]])");
+    expectSameAsTree(R"(["sqrt", ["get", "uint"]])");
+}
+
+TEST(Bytecode, Errors) {
+    // Not a number, missing property, and no zoom in the context
+    expectSameAsTree(R"(["+", 1, ["number", ["get", "string"]]])");
+    expectSameAsTree(R"(["+", 1, ["number", ["get", "missing"]]])");
+    expectSameAsTree(R"(["*", 2, ["zoom"]])");
+}
+
+TEST(Bytecode, Curves) {
+    for (const float zoom : {0.0f, 4.0f, 5.0f, 7.3f, 10.0f, 15.0f, 22.0f, NAN}) {
+        expectSameAsTree(R"(["interpolate", ["linear"], ["zoom"], 5, 1, 10, ["*", 2, ["get", "double"]], 15, 8])",
+                         zoom);
+        expectSameAsTree(R"(["interpolate", ["exponential", 1.5], ["zoom"], 5, 1, 15, 8])", zoom);
+        expectSameAsTree(R"(["interpolate", ["linear"], ["zoom"], 5, "red", 15, "#0000ff80"])", zoom);
+        expectSameAsTree(R"(["step", ["zoom"], 1, 5, 2, 10, ["get", "double"]])", zoom);
+        expectSameAsTree(R"(["step", ["zoom"], "red", 10, "blue"])", zoom);
+    }
+
+    // Only the selected stop outputs are evaluated, an error in another one doesn't matter
+    expectSameAsTree(R"(["step", ["zoom"], 1, 10, ["number", ["get", "string"]]])", 5.0f);
+    expectSameAsTree(R"(["step", ["zoom"], 1, 10, ["number", ["get", "string"]]])", 12.0f);
+
+    // Nested curves
+    expectSameAsTree(R"(["interpolate", ["linear"], ["zoom"],
+        5, ["interpolate", ["linear"], ["get", "double"], 0, 0, 10, 100],
+        10, ["step", ["get", "uint"], 1, 5, 50]])",
+                     7.0f);
+}
+
+TEST(Bytecode, Unsupported) {
+    EXPECT_FALSE(Bytecode::compile(*dsl::createExpression(R"(["to-number", ["get", "string"]])")));
+    EXPECT_FALSE(Bytecode::compile(*dsl::createExpression(R"(["concat", "a", "b"])")));
+    EXPECT_FALSE(Bytecode::compile(*dsl::createExpression(R"(["match", ["get", "string"], "7", 1, 0])")));
+}
+
+#if !defined(MLN_EXPRESSION_NO_BYTECODE)
+TEST(Bytecode, TreeEvaluationSetting) {
+    const auto json = R"(["*", 2, ["get", "double"]])";
+    EXPECT_TRUE(mbgl::style::PropertyExpression<float>(dsl::createExpression(json)).getBytecode());
+
+    auto& settings = platform::Settings::getInstance();
+    settings.set(platform::EXPRESSION_TREE_EVALUATION, true);
+    const mbgl::style::PropertyExpression<float> expression(dsl::createExpression(json));
+    settings.set(platform::EXPRESSION_TREE_EVALUATION, false);
+
+    EXPECT_FALSE(expression.getBytecode());
+    EXPECT_EQ(5.0f, expression.evaluate(EvaluationContext(&feature)));
+}
+#endif
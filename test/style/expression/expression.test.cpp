@@ -2,6 +2,7 @@
 #include <mbgl/style/rapidjson_conversion.hpp>
 #include <mbgl/style/expression/dsl.hpp>
 #include <mbgl/style/expression/is_expression.hpp>
+#include <mbgl/test/stub_geometry_tile_feature.hpp>
 #include <mbgl/test/util.hpp>
 #include <mbgl/util/io.hpp>
 #include <mbgl/util/rapidjson.hpp>
@@ -42,6 +43,44 @@ TEST(Expression, IsExpression) {
     }
 }
 
+TEST(Expression, LiteralGet) {
+    using namespace expression;
+    const StubGeometryTileFeature feature{PropertyMap{{"x", uint64_t(3)}}};
+
+    // A literal key takes the direct path, which must behave like the generic "get"
+    const auto get = dsl::createExpression(R"(["get", "x"])");
+    ASSERT_TRUE(get);
+    EXPECT_EQ(Kind::CompoundExpression, get->getKind());
+    EXPECT_EQ("get", get->getOperator());
+    EXPECT_EQ(expression::Value(3.0), *get->evaluate(EvaluationContext(&feature)));
+    EXPECT_EQ(Null, *dsl::createExpression(R"(["get", "y"])")->evaluate(EvaluationContext(&feature)));
+    EXPECT_FALSE(get->evaluate(EvaluationContext()));
+    EXPECT_TRUE(*get == *dsl::createExpression(R"(["get", ["to-string", ["literal", "x"]]])"));
+    EXPECT_EQ(mbgl::Value(std::vector<mbgl::Value>{std::string("get"), std::string("x")}), get->serialize());
+}
+
+TEST(Expression, InterpolateLiteralStops) {
+    using namespace expression;
+    const StubGeometryTileFeature feature{PropertyMap{{"x", 2.0}}};
+
+    // Literal outputs are evaluated from a stop table, the others through the output expressions
+    const auto literal = dsl::createExpression(R"(["interpolate", ["linear"], ["zoom"], 5, 2, 10, 4, 15, 8])");
+    const auto computed = dsl::createExpression(
+        R"(["interpolate", ["linear"], ["zoom"], 5, ["get", "x"], 10, ["*", 2, ["get", "x"]], 15, 8])");
+    ASSERT_TRUE(literal);
+    ASSERT_TRUE(computed);
+    for (const float zoom : {0.0f, 5.0f, 7.5f, 10.0f, 12.0f, 15.0f, 20.0f}) {
+        EXPECT_EQ(*computed->evaluate(EvaluationContext(zoom, &feature)),
+                  *literal->evaluate(EvaluationContext(zoom, &feature)))
+            << zoom;
+    }
+    EXPECT_FALSE(literal->evaluate(EvaluationContext(NAN, &feature)));
+
+    const auto colors = dsl::createExpression(R"(["interpolate", ["linear"], ["zoom"], 0, "black", 10, "white"])");
+    ASSERT_TRUE(colors);
+    EXPECT_EQ(expression::Value(Color(0.5f, 0.5f, 0.5f, 1.0f)), *colors->evaluate(EvaluationContext(5.0f)));
+}
+
 class ExpressionEqualityTest : public ::testing::TestWithParam<std::string> {};
 
 TEST_P(ExpressionEqualityTest, ExpressionEquality) {
@@ -2,6 +2,7 @@
 
 #include <mbgl/style/properties.hpp>
 #include <mbgl/style/expression/dsl.hpp>
+#include <mbgl/style/layers/circle_layer_properties.hpp>
 #include <mbgl/renderer/property_evaluator.hpp>
 #include <mbgl/renderer/data_driven_property_evaluator.hpp>
 
@@ -94,3 +95,18 @@ TEST(TransitioningDataDrivenPropertyValue, Evaluate) {
            "to the final value (see "
            "https://github.com/mapbox/mapbox-gl-native/issues/8237).";
 }
+
+TEST(Properties, ZoomDependent) {
+    using namespace mbgl::style::expression::dsl;
+    CirclePaintProperties::Transitionable paint;
+    EXPECT_FALSE(paint.untransitioned().isZoomDependent());
+
+    paint.get<CircleRadius>().value = PropertyValue<float>(
+        PropertyExpression<float>(interpolate(linear(), zoom(), 0.0, literal(1.0), 10.0, literal(5.0))));
+    EXPECT_TRUE(paint.untransitioned().isZoomDependent());
+
+    // Evaluated per feature, the zoom at the time of the evaluation doesn't matter
+    paint.get<CircleRadius>().value = PropertyValue<float>(PropertyExpression<float>(
+        interpolate(linear(), zoom(), 0.0, number(get("small")), 10.0, number(get("large")))));
+    EXPECT_FALSE(paint.untransitioned().isZoomDependent());
+}
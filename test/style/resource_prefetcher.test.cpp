@@ -0,0 +1,60 @@
+#include <mbgl/test/stub_file_source.hpp>
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/style/resource_prefetcher.hpp>
+#include <mbgl/util/async_request.hpp>
+#include <mbgl/util/run_loop.hpp>
+#include <mbgl/util/timer.hpp>
+
+#include <memory>
+
+using namespace mbgl;
+using namespace mbgl::style;
+using namespace std::chrono_literals;
+
+TEST(ResourcePrefetcher, TakesOverPrefetches) {
+    util::RunLoop loop;
+    auto fileSource = std::make_shared<StubFileSource>();
+
+    std::size_t upstreamRequests = 0;
+    const auto respond = [&](const Resource& resource) {
+        upstreamRequests++;
+        Response response;
+        response.data = std::make_shared<std::string>(resource.url);
+        return std::optional<Response>(response);
+    };
+    fileSource->spriteJSONResponse = respond;
+    fileSource->spriteImageResponse = respond;
+    fileSource->sourceResponse = respond;
+
+    ResourcePrefetcher prefetcher(fileSource, 1.0f);
+    prefetcher.prefetch(R"({
+        "version": 8,
+        "sprite": "http://example.com/sprite",
+        "sources": {"vector": {"type": "vector", "url": "http://example.com/tiles.json"}},
+        "layers": []
+    })");
+
+    // Taken over while in flight
+    const auto spriteJSON = Resource::spriteJSON("http://example.com/sprite", 1.0f);
+    std::shared_ptr<const std::string> spriteData;
+    auto spriteRequest = prefetcher.request(spriteJSON, [&](const Response& res) { spriteData = res.data; });
+
+    // Taken over once answered
+    std::unique_ptr<AsyncRequest> sourceRequest;
+    util::Timer timer;
+    timer.start(50ms, Duration::zero(), [&] {
+        sourceRequest = prefetcher.request(Resource::source("http://example.com/tiles.json"),
+                                           [&](const Response& res) {
+                                               EXPECT_EQ("http://example.com/tiles.json", *res.data);
+                                               loop.stop();
+                                           });
+    });
+    loop.run();
+
+    ASSERT_TRUE(spriteData);
+    EXPECT_EQ(spriteJSON.url, *spriteData);
+
+    // The sprite image wasn't taken over, but neither loader made a request of its own
+    EXPECT_EQ(3u, upstreamRequests);
+}
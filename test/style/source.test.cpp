@@ -15,6 +15,7 @@
 #include <mbgl/style/source_impl.hpp>
 #include <mbgl/style/sources/custom_geometry_source.hpp>
 #include <mbgl/style/sources/geojson_source.hpp>
+#include <mbgl/style/sources/geojson_source_impl.hpp>
 #include <mbgl/style/sources/image_source.hpp>
 #include <mbgl/style/sources/raster_dem_source.hpp>
 #include <mbgl/style/sources/raster_source.hpp>
@@ -46,7 +47,9 @@
 #include <mbgl/text/glyph_manager.hpp>
 #include <mbgl/gfx/dynamic_texture_atlas.hpp>
 
+#include <cmath>
 #include <cstdint>
+#include <limits>
 #include <optional>
 #include <gmock/gmock.h>
 
@@ -763,6 +766,66 @@ TEST(Source, CustomGeometrySourceSetTileData) {
 
     test.run();
 }
+
+TEST(Source, CustomGeometrySourceSetTileDataBatch) {
+    SourceTest test;
+    CustomGeometrySource source("source", CustomGeometrySource::Options());
+    source.loadDescription(*test.fileSource);
+
+    LineLayer layer("id", "source");
+    Immutable<LayerProperties> layerProperties = makeMutable<LineLayerProperties>(
+        staticImmutableCast<LineLayer::Impl>(layer.baseImpl));
+    std::vector<Immutable<LayerProperties>> layers{layerProperties};
+
+    test.renderSourceObserver.tileChanged = [&](RenderSource&, const OverscaledTileID& tileID) {
+        EXPECT_EQ(OverscaledTileID(0, 0, 0), tileID);
+        test.end();
+    };
+
+    auto renderSource = RenderSource::create(source.baseImpl, test.threadPool);
+    renderSource->setObserver(&test.renderSourceObserver);
+    renderSource->update(source.baseImpl, layers, true, true, test.tileParameters());
+
+    test.loop.invoke([&]() {
+        // Tiles that weren't requested are skipped
+        source.setTileData({{CanonicalTileID(1, 0, 0), GeoJSON{FeatureCollection{}}},
+                            {CanonicalTileID(0, 0, 0), GeoJSON{FeatureCollection{}}}});
+    });
+
+    test.run();
+}
+
+TEST(Source, CustomGeometrySourceSetTileFeatures) {
+    SourceTest test;
+    CustomGeometrySource source("source", CustomGeometrySource::Options());
+    source.loadDescription(*test.fileSource);
+
+    LineLayer layer("id", "source");
+    Immutable<LayerProperties> layerProperties = makeMutable<LineLayerProperties>(
+        staticImmutableCast<LineLayer::Impl>(layer.baseImpl));
+    std::vector<Immutable<LayerProperties>> layers{layerProperties};
+
+    test.renderSourceObserver.tileChanged = [&](RenderSource& source_, const OverscaledTileID&) {
+        EXPECT_EQ("source", source_.baseImpl->id);
+        test.end();
+    };
+
+    test.renderSourceObserver.tileError = [&](RenderSource&, const OverscaledTileID&, std::exception_ptr) {
+        FAIL() << "Should never be called";
+    };
+
+    auto renderSource = RenderSource::create(source.baseImpl, test.threadPool);
+    renderSource->setObserver(&test.renderSourceObserver);
+    renderSource->update(source.baseImpl, layers, true, true, test.tileParameters());
+
+    test.loop.invoke([&]() {
+        CustomGeometrySource::TileFeatures features;
+        features.emplace_back(mapbox::geometry::line_string<int16_t>{{0, 0}, {4096, 4096}});
+        source.setTileFeatures(CanonicalTileID(0, 0, 0), std::move(features));
+    });
+
+    test.run();
+}
 namespace {
 
 class FakeTileSource;
@@ -1013,6 +1076,194 @@ TEST(Source, GeoJSONSourceTilesAfterDataReset) {
     EXPECT_TRUE(renderSource.isLoaded()); // Tiles are reset in static mode.
 }
 
+TEST(Source, GeoJSONSourcePartitionedTileIndex) {
+    // Large enough for the tile index to be built in partitions
+    constexpr std::size_t count = 50000;
+    GeoJSONData::Features features;
+    features.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const double x = -179.0 + 358.0 * double(i) / count;
+        features.emplace_back(Point<double>{x, std::sin(x) * 80.0}, PropertyMap{}, uint64_t(i));
+    }
+
+    auto geoJSONData = GeoJSONData::create(features, Scheduler::GetSequenced());
+    std::optional<GeoJSONData::TileFeatures> tileFeatures;
+    geoJSONData->getTile(
+        CanonicalTileID{0, 0, 0}, [&](GeoJSONData::TileFeatures result) { tileFeatures = std::move(result); }, true);
+
+    ASSERT_TRUE(tileFeatures);
+    ASSERT_EQ(count, tileFeatures->size());
+    for (std::size_t i = 0; i < count; ++i) {
+        ASSERT_EQ(FeatureIdentifier(uint64_t(i)), (*tileFeatures)[i].id);
+    }
+}
+
+namespace {
+
+GeoJSONData::TileFeatures getTileFeatures(GeoJSONData& data, const CanonicalTileID& id) {
+    GeoJSONData::TileFeatures features;
+    data.getTile(id, [&](GeoJSONData::TileFeatures result) { features = std::move(result); }, true);
+    return features;
+}
+
+std::vector<FeatureIdentifier> getIDs(const GeoJSONData::TileFeatures& features) {
+    std::vector<FeatureIdentifier> ids;
+    for (const auto& feature : features) {
+        ids.push_back(feature.id);
+    }
+    return ids;
+}
+
+} // namespace
+
+TEST(Source, GeoJSONSourceDiff) {
+    const auto point = [](uint64_t id, double lng, double lat) {
+        return GeoJSONData::Features::value_type{Point<double>{lng, lat}, PropertyMap{}, id};
+    };
+    auto data = GeoJSONData::create(GeoJSONData::Features{point(1, -100, 60), point(2, 10, 50), point(3, 140, -30)},
+                                    Scheduler::GetSequenced());
+
+    GeoJSONDiff diff;
+    diff.remove = {uint64_t(1)};
+    diff.update = {point(3, 141, -31), point(4, 0, 0)};
+    diff.add = {point(2, 11, 51), point(5, -101, 61)};
+    auto updated = data->update(diff, Scheduler::GetSequenced(), GeoJSONOptions::defaultOptions());
+    ASSERT_TRUE(updated);
+
+    // Feature 4 doesn't exist and isn't updated, added feature 2 replaces the existing one in place
+    const auto features = getTileFeatures(*updated, {0, 0, 0});
+    EXPECT_EQ((std::vector<FeatureIdentifier>{uint64_t(2), uint64_t(3), uint64_t(5)}), getIDs(features));
+    EXPECT_EQ(getTileFeatures(*data, {0, 0, 0}).size(), 3u);
+
+    // Only the tiles around the changed features need to be loaded again
+    EXPECT_TRUE(updated->isTileChanged(*data, {1, 0, 0}));
+    EXPECT_TRUE(updated->isTileChanged(*data, {1, 1, 0}));
+    EXPECT_TRUE(updated->isTileChanged(*data, {1, 1, 1}));
+    EXPECT_FALSE(updated->isTileChanged(*data, {1, 0, 1}));
+    EXPECT_FALSE(updated->isTileChanged(*data, {6, 40, 20}));
+
+    // Chained diffs accumulate the changes, unrelated data is always considered changed
+    diff = {};
+    diff.add = {point(6, -60, -60)};
+    auto next = updated->update(diff, Scheduler::GetSequenced(), GeoJSONOptions::defaultOptions());
+    ASSERT_TRUE(next);
+    EXPECT_TRUE(next->isTileChanged(*updated, {1, 0, 1}));
+    EXPECT_FALSE(next->isTileChanged(*updated, {1, 1, 0}));
+    EXPECT_TRUE(next->isTileChanged(*data, {1, 1, 0}));
+    EXPECT_TRUE(updated->isTileChanged(*next, {1, 0, 1}));
+}
+
+TEST(Source, GeoJSONSourceDiffPartitioned) {
+    constexpr std::size_t count = 50000;
+    GeoJSONData::Features features;
+    for (std::size_t i = 0; i < count; ++i) {
+        const Point<double> position{-170.0 + double(i % 340), -60.0 + double(i % 120)};
+        features.emplace_back(position, PropertyMap{}, uint64_t(i));
+    }
+    auto data = GeoJSONData::create(features, Scheduler::GetSequenced());
+
+    GeoJSONDiff diff;
+    for (std::size_t i = 0; i < count; i += 1000) {
+        diff.remove.emplace_back(uint64_t(i));
+    }
+    diff.add.emplace_back(Point<double>{0.0, 0.0}, PropertyMap{}, uint64_t(count));
+    auto updated = data->update(diff, Scheduler::GetSequenced(), GeoJSONOptions::defaultOptions());
+    ASSERT_TRUE(updated);
+
+    const auto ids = getIDs(getTileFeatures(*updated, {0, 0, 0}));
+    ASSERT_EQ(count - count / 1000 + 1, ids.size());
+    std::size_t expected = 1;
+    for (std::size_t i = 0; i + 1 < ids.size(); ++i, ++expected) {
+        if (expected % 1000 == 0) {
+            ++expected;
+        }
+        ASSERT_EQ(FeatureIdentifier(uint64_t(expected)), ids[i]);
+    }
+    EXPECT_EQ(FeatureIdentifier(uint64_t(count)), ids.back());
+}
+
+TEST(Source, GeoJSONClusterLeavesPaged) {
+    GeoJSONData::Features features;
+    for (std::size_t i = 0; i < 200; ++i) {
+        features.emplace_back(Point<double>{double(i % 20) * 0.01, double(i / 20) * 0.01}, PropertyMap{}, uint64_t(i));
+    }
+    Mutable<GeoJSONOptions> options = makeMutable<GeoJSONOptions>();
+    options->cluster = true;
+    auto data = GeoJSONData::create(features, Scheduler::GetSequenced(), std::move(options));
+
+    const auto clusters = getTileFeatures(*data, {0, 0, 0});
+    ASSERT_EQ(1u, clusters.size());
+    const auto clusterID = std::uint32_t(clusters[0].properties.at("cluster_id").get<uint64_t>());
+    const auto pointCount = clusters[0].properties.at("point_count").get<uint64_t>();
+
+    const auto leaves = data->getLeaves(clusterID, std::numeric_limits<std::uint32_t>::max(), 0);
+    ASSERT_EQ(pointCount, leaves.size());
+    EXPECT_TRUE(data->getLeaves(clusterID, 0, 0).empty());
+
+    // Pages cut through the nested clusters, and put together give the same leaves in the same order
+    std::vector<FeatureIdentifier> paged;
+    for (std::uint32_t offset = 0; offset < leaves.size(); offset += 7) {
+        for (const auto& leaf : data->getLeaves(clusterID, 7, offset)) {
+            paged.push_back(leaf.id);
+        }
+    }
+    EXPECT_EQ(getIDs(leaves), paged);
+
+    // Answered from the cached children the second time
+    const auto zoom = data->getClusterExpansionZoom(clusterID);
+    EXPECT_GT(zoom, 0u);
+    EXPECT_EQ(zoom, data->getClusterExpansionZoom(clusterID));
+    EXPECT_EQ(data->getChildren(clusterID).size(), data->getChildren(clusterID).size());
+}
+
+TEST(Source, GeoJSONDataParse) {
+    // Large enough to be indexed in partitions while it's being read
+    constexpr std::size_t count = 30000;
+    std::string json = R"({"type": "FeatureCollection", "features": [)";
+    for (std::size_t i = 0; i < count; ++i) {
+        const int lng = int(i % 300) - 150;
+        const int lat = int(i % 80);
+        json += (i ? "," : "") + std::string(R"({"type": "Feature", "id": )") + util::toString(i) +
+                R"(, "properties": {}, "geometry": {"type": "Point", "coordinates": [)" + util::toString(lng) + ", " +
+                util::toString(lat) + "]}}";
+    }
+    json += "]}";
+
+    style::conversion::Error error;
+    auto data = GeoJSONData::parse(json, Scheduler::GetSequenced(), GeoJSONOptions::defaultOptions(), error);
+    ASSERT_TRUE(data) << error.message;
+    const auto ids = getIDs(getTileFeatures(*data, {0, 0, 0}));
+    ASSERT_EQ(count, ids.size());
+    for (std::size_t i = 0; i < count; ++i) {
+        ASSERT_EQ(FeatureIdentifier(uint64_t(i)), ids[i]);
+    }
+
+    EXPECT_FALSE(GeoJSONData::parse(R"({"type": "FeatureCollection", "features": [)",
+                                    Scheduler::GetSequenced(),
+                                    GeoJSONOptions::defaultOptions(),
+                                    error));
+    EXPECT_FALSE(error.message.empty());
+}
+
+TEST(Source, GeoJSONSourceUpdateGeoJSON) {
+    SourceTest test;
+    GeoJSONSource source("source");
+    source.setObserver(&test.styleObserver);
+
+    GeoJSONDiff diff;
+    diff.add = {{Point<double>{1.0, 1.0}, PropertyMap{}, uint64_t(1)}};
+    source.updateGeoJSON(diff);
+    auto data = source.impl().getData().lock();
+    ASSERT_TRUE(data);
+
+    diff.add = {{Point<double>{2.0, 2.0}, PropertyMap{}, uint64_t(2)}};
+    source.updateGeoJSON(diff);
+    auto updated = source.impl().getData().lock();
+    ASSERT_TRUE(updated);
+    EXPECT_NE(data, updated);
+    EXPECT_EQ((std::vector<FeatureIdentifier>{uint64_t(1), uint64_t(2)}), getIDs(getTileFeatures(*updated, {0, 0, 0})));
+}
+
 TEST(Source, SetMaxParentOverscaleFactor) {
     SourceTest test;
     test.transform.jumpTo(CameraOptions().withCenter(LatLng()).withZoom(8.0));
@@ -413,3 +413,34 @@ TEST(Layer, SymbolLayerOverrides) {
         EXPECT_FALSE(updated.get<TextColor>().isConstant());
     }
 }
+
+TEST(Layer, EvaluatedLayoutCache) {
+    auto layer = std::make_unique<LineLayer>("line", "source");
+    layer->setLineMiterLimit(
+        PropertyExpression<float>(interpolate(linear(), zoom(), 0.0, literal(0.0), 10.0, literal(10.0))));
+
+    int evaluations = 0;
+    const auto evaluate = [&](const LineLayer::Impl& impl, float z) {
+        return impl.evaluatedLayout.get(z, [&] {
+            ++evaluations;
+            return makeMutable<LineLayoutProperties::PossiblyEvaluated>(
+                impl.layout.evaluate(PropertyEvaluationParameters(z)));
+        });
+    };
+
+    const auto original = staticImmutableCast<LineLayer::Impl>(layer->baseImpl);
+    const auto atFive = evaluate(*original, 5.0f);
+    EXPECT_EQ(5.0f, atFive->get<LineMiterLimit>());
+    EXPECT_EQ(atFive, evaluate(*original, 5.0f));
+    EXPECT_EQ(1, evaluations);
+
+    EXPECT_EQ(8.0f, evaluate(*original, 8.0f)->get<LineMiterLimit>());
+    EXPECT_EQ(2, evaluations);
+
+    // Changing the layer copies its impl, which starts out with an empty cache
+    layer->setLineMiterLimit(1.0f);
+    const auto changed = staticImmutableCast<LineLayer::Impl>(layer->baseImpl);
+    ASSERT_NE(original.get(), changed.get());
+    EXPECT_EQ(1.0f, evaluate(*changed, 5.0f)->get<LineMiterLimit>());
+    EXPECT_EQ(3, evaluations);
+}
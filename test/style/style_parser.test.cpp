@@ -314,3 +314,44 @@ TEST(StyleParser, ZoomCurve) {
     ASSERT_TRUE(expr2);
     ASSERT_TRUE(findZoomCurveChecked(*expr2).is<std::nullptr_t>());
 }
+
+TEST(StyleParser, ParsedLayerCache) {
+    std::string json = R"({"version": 8, "sources": {"vector": {"type": "vector", "tiles": []}}, "layers": [)";
+    for (int i = 0; i < 100; ++i) {
+        json += std::string(i ? "," : "") + R"({"id": "fill)" + util::toString(i) +
+                R"(", "type": "fill", "source": "vector", "paint": {"fill-opacity": 0.5}})";
+    }
+    json += "]}";
+
+    style::Parser first;
+    ASSERT_FALSE(first.parse(json));
+    style::Parser second;
+    ASSERT_FALSE(second.parse(json));
+
+    // The second parse shares the layer impls of the first
+    ASSERT_EQ(100u, second.layers.size());
+    for (std::size_t i = 0; i < second.layers.size(); ++i) {
+        EXPECT_TRUE(first.layers[i]->baseImpl == second.layers[i]->baseImpl);
+        EXPECT_NE(first.layers[i].get(), second.layers[i].get());
+    }
+}
+
+TEST(StyleParser, ParallelLayerConversion) {
+    std::string json = R"({"version": 8, "sources": {"vector": {"type": "vector", "tiles": []}}, "layers": [)";
+    for (int i = 0; i < 40; ++i) {
+        const auto type = i == 20 ? std::string("invalid") : std::string("line");
+        json += R"({"id": "line)" + util::toString(i) + R"(", "type": ")" + type + R"(", "source": "vector"},)";
+    }
+    json += R"({"id": "ref", "ref": "line0", "paint": {"line-width": 2}}]})";
+
+    style::Parser parser;
+    ASSERT_FALSE(parser.parse(json));
+
+    // Layers keep their order, the invalid one is dropped and the ref is resolved
+    ASSERT_EQ(40u, parser.layers.size());
+    for (int i = 0; i < 39; ++i) {
+        EXPECT_EQ("line" + util::toString(i < 20 ? i : i + 1), parser.layers[i]->getID());
+    }
+    EXPECT_EQ("ref", parser.layers.back()->getID());
+    EXPECT_STREQ("line", parser.layers.back()->getTypeInfo()->type);
+}
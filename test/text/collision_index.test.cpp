@@ -0,0 +1,73 @@
+#include <mbgl/map/transform_state.hpp>
+#include <mbgl/test/util.hpp>
+#include <mbgl/text/collision_index.hpp>
+#include <mbgl/util/mat4.hpp>
+
+using namespace mbgl;
+
+namespace {
+
+CollisionFeature makeIconFeature(const IndexedSubfeature& subfeature) {
+    const GeometryCoordinates line;
+    return {line, Anchor(0, 0, 0), std::nullopt, 1.0f, Padding{}, subfeature, 0.0f};
+}
+
+} // namespace
+
+TEST(CollisionIndex, PlaceShiftedFeature) {
+    TransformState state;
+    state.setSize({512, 512});
+    CollisionIndex index(state, MapMode::Continuous);
+
+    std::vector<ProjectedCollisionBox> placed{{150, 150, 170, 170}};
+    EXPECT_EQ(std::make_pair(true, false), index.placeShiftedFeature(placed, {5, 0}, false, std::nullopt));
+    EXPECT_EQ(155, placed[0].box().min.x);
+    EXPECT_EQ(175, placed[0].box().max.x);
+
+    const IndexedSubfeature subfeature(0, {}, {}, 0);
+    index.insertFeature(makeIconFeature(subfeature), placed, false, 1, 0);
+
+    std::vector<ProjectedCollisionBox> blocked{{130, 150, 150, 170}};
+    EXPECT_FALSE(index.placeShiftedFeature(blocked, {10, 0}, false, std::nullopt).first);
+
+    std::vector<ProjectedCollisionBox> overlapping{{130, 150, 150, 170}};
+    EXPECT_TRUE(index.placeShiftedFeature(overlapping, {10, 0}, true, std::nullopt).first);
+
+    // Moved out of the grid
+    std::vector<ProjectedCollisionBox> outside{{130, 150, 150, 170}};
+    EXPECT_FALSE(index.placeShiftedFeature(outside, {-1000, 0}, true, std::nullopt).first);
+}
+
+TEST(CollisionIndex, PlaceShiftedLineFeature) {
+    TransformState state;
+    state.setSize({512, 512});
+    CollisionIndex index(state, MapMode::Continuous);
+
+    // Unused circles are skipped, the offscreen flag covers the circles in use
+    std::vector<ProjectedCollisionBox> circles{{}, {20, 20, 5}, {}};
+    EXPECT_EQ(std::make_pair(true, true), index.placeShiftedFeature(circles, {10, 10}, false, std::nullopt));
+    EXPECT_EQ(30, circles[1].circle().center.x);
+    EXPECT_EQ(30, circles[1].circle().center.y);
+    EXPECT_FALSE(circles[0].isCircle());
+
+    EXPECT_EQ(std::make_pair(true, false), index.placeShiftedFeature(circles, {200, 200}, false, std::nullopt));
+}
+
+TEST(CollisionIndex, MayReachGrid) {
+    TransformState state;
+    state.setSize({512, 512});
+    CollisionIndex index(state, MapMode::Continuous);
+
+    // Projects -1..1 onto the viewport, within the grid's padding of 100 pixels on each side
+    mat4 matrix = matrix::identity4();
+    EXPECT_TRUE(index.mayReachGrid(matrix, {0, 0}, {0, 0}, 0));
+    EXPECT_TRUE(index.mayReachGrid(matrix, {-3, -3}, {3, 3}, 0));
+
+    // Entirely right of the grid, unless the boxes reach back into it
+    EXPECT_FALSE(index.mayReachGrid(matrix, {2, -1}, {3, 1}, 0));
+    EXPECT_TRUE(index.mayReachGrid(matrix, {2, -1}, {3, 1}, 1000));
+
+    // Behind the camera
+    matrix[15] = -1;
+    EXPECT_TRUE(index.mayReachGrid(matrix, {2, -1}, {3, 1}, 0));
+}
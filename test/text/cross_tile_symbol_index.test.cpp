@@ -4,6 +4,8 @@
 #include <mbgl/test/util.hpp>
 #include <mbgl/text/cross_tile_symbol_index.hpp>
 
+#include <numbers>
+
 using namespace mbgl;
 
 SymbolInstance makeSymbolInstance(float x, float y, std::u16string key) {
@@ -319,6 +321,69 @@ TEST(CrossTileSymbolLayerIndex, noDuplicatesWithinZoomLevel) {
               3u); // C' gets new ID
 }
 
+TEST(CrossTileSymbolLayerIndex, matchesAcrossGridCells) {
+    uint32_t maxCrossTileID = 0;
+    uint32_t maxBucketInstanceId = 0;
+    CrossTileSymbolLayerIndex index(maxCrossTileID);
+
+    Immutable<style::SymbolLayoutProperties::PossiblyEvaluated> layout =
+        makeMutable<style::SymbolLayoutProperties::PossiblyEvaluated>();
+    bool iconsNeedLinear = false;
+    bool sortFeaturesByY = false;
+    std::string bucketLeaderID = "test";
+
+    // Both parent symbols are within one grid unit of the child symbol, but in different cells
+    OverscaledTileID mainID(6, 0, 6, 8, 8);
+    std::vector<SymbolInstance> mainInstances;
+    std::vector<SortKeyRange> mainRanges;
+    mainInstances.push_back(makeSymbolInstance(128, 128, u"Windsor")); // A
+    mainInstances.push_back(makeSymbolInstance(96, 96, u"Windsor"));   // B
+    SymbolBucket mainBucket{layout,
+                            {},
+                            16.0f,
+                            1.0f,
+                            0,
+                            iconsNeedLinear,
+                            sortFeaturesByY,
+                            bucketLeaderID,
+                            std::move(mainInstances),
+                            std::move(mainRanges),
+                            1.0f,
+                            false,
+                            {},
+                            false /*iconsInText*/};
+    mainBucket.bucketInstanceId = ++maxBucketInstanceId;
+
+    OverscaledTileID childID(7, 0, 7, 16, 16);
+    std::vector<SymbolInstance> childInstances;
+    std::vector<SortKeyRange> childRanges;
+    childInstances.push_back(makeSymbolInstance(256, 256, u"Windsor")); // A'
+    SymbolBucket childBucket{layout,
+                             {},
+                             16.0f,
+                             1.0f,
+                             0,
+                             iconsNeedLinear,
+                             sortFeaturesByY,
+                             bucketLeaderID,
+                             std::move(childInstances),
+                             std::move(childRanges),
+                             1.0f,
+                             false,
+                             {},
+                             false /*iconsInText*/};
+    childBucket.bucketInstanceId = ++maxBucketInstanceId;
+
+    index.addBucket(mainID, mat4{}, mainBucket);
+    ASSERT_EQ(mainBucket.symbolInstances.at(0).getCrossTileID(), 1u);
+    ASSERT_EQ(mainBucket.symbolInstances.at(1).getCrossTileID(), 2u);
+
+    // matches the first parent symbol in index order, regardless of the cell it falls in
+    index.addBucket(childID, mat4{}, childBucket);
+    ASSERT_EQ(childBucket.symbolInstances.at(0).getCrossTileID(), 1u);
+    ASSERT_EQ(index.getBucketCount(), 2u);
+}
+
 TEST(CrossTileSymbolLayerIndex, bucketReplacement) {
     uint32_t maxCrossTileID = 0;
     uint32_t maxBucketInstanceId = 0;
@@ -441,3 +506,41 @@ TEST(CrossTileSymbolLayerIndex, offscreenSymbols) {
     EXPECT_EQ(symbolBucket.symbolInstances.at(0).getCrossTileID(), 1u);
     EXPECT_EQ(symbolBucket.symbolInstances.at(1).getCrossTileID(), 2u);
 }
+
+TEST(SymbolBucket, SortedSymbols) {
+    Immutable<style::SymbolLayoutProperties::PossiblyEvaluated> layout =
+        makeMutable<style::SymbolLayoutProperties::PossiblyEvaluated>();
+    std::vector<SymbolInstance> instances;
+    instances.push_back(makeSymbolInstance(3000, 1000, u"Chicago"));
+    instances.push_back(makeSymbolInstance(1000, 3000, u"Memphis"));
+    instances.push_back(makeSymbolInstance(2000, 2000, u"St. Louis"));
+    SymbolBucket bucket{layout,
+                        {},
+                        16.0f,
+                        1.0f,
+                        0,
+                        false,
+                        true,
+                        "test",
+                        std::move(instances),
+                        {},
+                        1.0f,
+                        false,
+                        {},
+                        false /*iconsInText*/};
+
+    const auto keys = [](const SymbolInstanceReferences& symbols) {
+        std::vector<std::u16string> result;
+        for (const SymbolInstance& symbol : symbols) {
+            result.push_back(symbol.getKey());
+        }
+        return result;
+    };
+
+    // By viewport Y, which is the anchor's X once rotated by a quarter turn
+    using Keys = std::vector<std::u16string>;
+    EXPECT_EQ((Keys{u"Chicago", u"St. Louis", u"Memphis"}), keys(bucket.getSortedSymbols(0.0f)));
+    const float quarterTurn = std::numbers::pi_v<float> / 2;
+    EXPECT_EQ((Keys{u"Memphis", u"St. Louis", u"Chicago"}), keys(bucket.getSortedSymbols(quarterTurn)));
+    EXPECT_EQ((Keys{u"Chicago", u"St. Louis", u"Memphis"}), keys(bucket.getSortedSymbols(0.0f)));
+}
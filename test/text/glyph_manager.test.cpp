@@ -2,6 +2,7 @@
 #include <mbgl/test/stub_file_source.hpp>
 
 #include <mbgl/text/glyph_manager.hpp>
+#include <mbgl/text/glyph_store.hpp>
 #include <mbgl/util/run_loop.hpp>
 #include <mbgl/util/string.hpp>
 #include <mbgl/util/i18n.hpp>
@@ -200,6 +201,49 @@ TEST(GlyphManager, LoadingSuccess) {
              GlyphDependencies{.glyphs = {{{{"Test Stack"}}, {u'a', u'å', u' '}}}, .shapes = {}});
 }
 
+TEST(GlyphManager, SharedGlyphStore) {
+    GlyphStore::get().setBudget(1024 * 1024);
+    GlyphManagerTest test;
+
+    test.fileSource.glyphsResponse = [&](const Resource&) {
+        Response response;
+        response.data = std::make_shared<std::string>(util::read_file("test/fixtures/resources/glyphs.pbf"));
+        return response;
+    };
+
+    test.requestor.glyphsAvailable = [&](GlyphMap) {
+        test.end();
+    };
+
+    test.run("test/fixtures/resources/glyphs.pbf",
+             GlyphDependencies{.glyphs = {{{{"Test Stack"}}, {u'a', u'å', u' '}}}, .shapes = {}});
+    EXPECT_GT(GlyphStore::get().getBytes(), 0u);
+
+    // A second manager takes the range from the store without requesting it
+    GlyphManager otherManager{std::make_unique<StubLocalGlyphRasterizer>()};
+    otherManager.setURL("test/fixtures/resources/glyphs.pbf");
+    test.fileSource.glyphsResponse = [&](const Resource&) {
+        ADD_FAILURE() << "Glyph range requested again";
+        return Response();
+    };
+
+    bool available = false;
+    StubGlyphRequestor otherRequestor;
+    otherRequestor.glyphsAvailable = [&](GlyphMap glyphs) {
+        const auto& testPositions = glyphs.at(FontStackHasher()({{"Test Stack"}}));
+        ASSERT_EQ(testPositions.count(u'a'), 1u);
+        ASSERT_TRUE(bool(testPositions.at(u'a')));
+        available = true;
+    };
+    otherManager.getGlyphs(otherRequestor,
+                           GlyphDependencies{.glyphs = {{{{"Test Stack"}}, {u'a'}}}, .shapes = {}},
+                           test.fileSource);
+    EXPECT_TRUE(available);
+
+    GlyphStore::get().setBudget(0);
+    EXPECT_EQ(GlyphStore::get().getBytes(), 0u);
+}
+
 TEST(GlyphManager, LoadingFail) {
     GlyphManagerTest test;
 
@@ -42,3 +42,17 @@ TEST(TaggedString, ImageSections) {
     EXPECT_EQ(maxSections.getCharCodeAt(0), u'\uE000');
     EXPECT_EQ(maxSections.getCharCodeAt(6399), u'\uF8FF');
 }
+
+TEST(TaggedString, SharedFontStacks) {
+    FontStackInterner interner;
+    const FontStack regular{"Noto Sans Regular", "Arial Unicode MS Regular"};
+    const auto shared = interner.intern(regular);
+    EXPECT_EQ(shared, interner.intern(FontStack{"Noto Sans Regular", "Arial Unicode MS Regular"}));
+    EXPECT_NE(shared, interner.intern(FontStack{"Noto Sans Bold"}));
+
+    TaggedString string;
+    string.addTextSection(u"first", 1.0, shared, GlyphIDType::FontPBF);
+    string.addTextSection(u"second", 1.0, interner.intern(regular), GlyphIDType::FontPBF);
+    EXPECT_EQ(string.sectionAt(0).fontStack, string.sectionAt(1).fontStack);
+    EXPECT_EQ(FontStackHasher()(regular), string.sectionAt(1).fontStackHash);
+}
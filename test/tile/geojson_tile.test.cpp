@@ -2,6 +2,7 @@
 #include <mbgl/test/fake_file_source.hpp>
 #include <mbgl/test/stub_tile_observer.hpp>
 #include <mbgl/tile/geojson_tile.hpp>
+#include <mbgl/tile/geojson_tile_data.hpp>
 #include <mbgl/tile/tile_loader_impl.hpp>
 
 #include <mbgl/annotation/annotation_manager.hpp>
@@ -10,12 +11,15 @@
 #include <mbgl/renderer/tile_parameters.hpp>
 #include <mbgl/style/layers/circle_layer.hpp>
 #include <mbgl/style/layers/circle_layer_impl.hpp>
+#include <mbgl/style/conversion/filter.hpp>
+#include <mbgl/style/conversion/json.hpp>
 #include <mbgl/style/sources/geojson_source.hpp>
 #include <mbgl/style/style.hpp>
 #include <mbgl/text/glyph_manager.hpp>
 #include <mbgl/util/run_loop.hpp>
 #include <mbgl/gfx/dynamic_texture_atlas.hpp>
 
+#include <algorithm>
 #include <memory>
 
 using namespace mbgl;
@@ -94,6 +98,98 @@ TEST(GeoJSONTile, SynchronousUpdate) {
     ASSERT_TRUE(tile.isRenderable());
 }
 
+TEST(GeoJSONTile, CancelledLayout) {
+    GeoJSONTileTest test;
+
+    CircleLayer layer("circle", "source");
+
+    mapbox::feature::feature_collection<int16_t> features;
+    features.push_back(mapbox::feature::feature<int16_t>{mapbox::geometry::point<int16_t>(0, 0)});
+    auto data = std::make_shared<FakeGeoJSONData>(std::move(features));
+    TileParameters tileParameters = test.tileParameters;
+    tileParameters.isUpdateSynchronous = true;
+    GeoJSONTile tile(OverscaledTileID(0, 0, 0), "source", tileParameters, data);
+    Immutable<LayerProperties> layerProperties = makeMutable<CircleLayerProperties>(
+        staticImmutableCast<CircleLayer::Impl>(layer.baseImpl));
+    std::vector<Immutable<LayerProperties>> layers{layerProperties};
+
+    const auto before = GeometryTileWorker::getLayoutStats();
+
+    // Layout work for an obsolete tile is abandoned
+    tile.cancel();
+    tile.setLayers(layers);
+
+    const auto after = GeometryTileWorker::getLayoutStats();
+    EXPECT_EQ(before.completed, after.completed);
+    EXPECT_EQ(before.cancelled + 1, after.cancelled);
+    EXPECT_FALSE(tile.isRenderable());
+}
+
+TEST(GeoJSONTile, ReusesScratchArenas) {
+    GeoJSONTileTest test;
+
+    CircleLayer layer("circle", "source");
+
+    mapbox::feature::feature_collection<int16_t> features;
+    features.push_back(mapbox::feature::feature<int16_t>{mapbox::geometry::point<int16_t>(0, 0)});
+    auto data = std::make_shared<FakeGeoJSONData>(std::move(features));
+    TileParameters tileParameters = test.tileParameters;
+    tileParameters.isUpdateSynchronous = true;
+    Immutable<LayerProperties> layerProperties = makeMutable<CircleLayerProperties>(
+        staticImmutableCast<CircleLayer::Impl>(layer.baseImpl));
+    std::vector<Immutable<LayerProperties>> layers{layerProperties};
+
+    const auto before = GeometryTileWorker::getScratchStats();
+
+    // The second tile's layout starts out with the arena the first one returned
+    for (uint32_t x = 0; x < 2; ++x) {
+        GeoJSONTile tile(OverscaledTileID(1, x, 0), "source", tileParameters, data);
+        tile.setLayers(layers);
+        EXPECT_TRUE(tile.isRenderable());
+    }
+
+    const auto after = GeometryTileWorker::getScratchStats();
+    EXPECT_EQ(before.workersCreated + 2, after.workersCreated);
+    EXPECT_LE(before.arenasReused + 1, after.arenasReused);
+}
+
+TEST(GeoJSONTile, FilterChangeKeepsOtherBuckets) {
+    GeoJSONTileTest test;
+
+    const auto parseFilter = [](const char* json) {
+        conversion::Error error;
+        return *conversion::convertJSON<Filter>(json, error);
+    };
+    CircleLayer points("points", "source");
+    points.setFilter(parseFilter(R"(["==", "$type", "Point"])"));
+    CircleLayer others("others", "source");
+    others.setFilter(parseFilter(R"(["!=", "$type", "LineString"])"));
+
+    mapbox::feature::feature_collection<int16_t> features;
+    features.push_back(mapbox::feature::feature<int16_t>{mapbox::geometry::point<int16_t>(0, 0)});
+    auto data = std::make_shared<FakeGeoJSONData>(std::move(features));
+    TileParameters tileParameters = test.tileParameters;
+    tileParameters.isUpdateSynchronous = true;
+    GeoJSONTile tile(OverscaledTileID(0, 0, 0), "source", tileParameters, data);
+
+    const auto properties = [](const CircleLayer& layer) -> Immutable<LayerProperties> {
+        return makeMutable<CircleLayerProperties>(staticImmutableCast<CircleLayer::Impl>(layer.baseImpl));
+    };
+    const auto pointsProperties = properties(points);
+    tile.setLayers({pointsProperties, properties(others)});
+    const auto before = tile.createRenderData();
+    ASSERT_TRUE(before->getBucket(*points.baseImpl));
+    ASSERT_TRUE(before->getBucket(*others.baseImpl));
+
+    // Only the layer whose filter changed gets a new bucket
+    others.setFilter(parseFilter(R"(["!=", "$type", "Polygon"])"));
+    tile.setLayers({pointsProperties, properties(others)});
+    const auto after = tile.createRenderData();
+    EXPECT_EQ(before->getBucket(*points.baseImpl), after->getBucket(*points.baseImpl));
+    ASSERT_TRUE(after->getBucket(*others.baseImpl));
+    EXPECT_NE(before->getBucket(*others.baseImpl), after->getBucket(*others.baseImpl));
+}
+
 TEST(GeoJSONTile, Issue7648) {
     GeoJSONTileTest test;
 
@@ -165,3 +261,24 @@ TEST(GeoJSONTile, Issue9927) {
     ASSERT_TRUE(tile.isRenderable());
     ASSERT_TRUE(tile.layerPropertiesUpdated(layerProperties));
 }
+
+TEST(GeoJSONTile, PointsReadInPlace) {
+    mapbox::feature::feature_collection<int16_t> features;
+    features.push_back(mapbox::feature::feature<int16_t>{mapbox::geometry::point<int16_t>(1, 2)});
+    features.push_back(
+        mapbox::feature::feature<int16_t>{mapbox::geometry::multi_point<int16_t>{{3, 4}, {5, 6}, {-7, 8}}});
+    features.push_back(mapbox::feature::feature<int16_t>{mapbox::geometry::line_string<int16_t>{{0, 0}, {1, 1}}});
+    const GeoJSONTileData data(std::move(features));
+    const auto layer = data.getLayer({});
+
+    for (std::size_t i = 0; i < 2; ++i) {
+        const auto feature = layer->getFeature(i);
+        const auto points = feature->getPoints();
+        ASSERT_TRUE(points);
+        // The same points `getGeometries()` converts, without the copy
+        const auto& geometries = feature->getGeometries();
+        ASSERT_EQ(1u, geometries.size());
+        EXPECT_TRUE(std::equal(points->begin(), points->end(), geometries[0].begin(), geometries[0].end()));
+    }
+    EXPECT_FALSE(layer->getFeature(2)->getPoints());
+}
@@ -100,3 +100,36 @@ TEST(GeometryTileData, limitHoles3) {
     ASSERT_EQ(original.at(1), polygon.at(1));
     ASSERT_EQ(original.at(3), polygon.at(2));
 }
+
+TEST(GeometryTileData, classifyRingRefs) {
+    const GeometryCollection rings = {{{0, 0}, {0, 40}, {40, 40}, {40, 0}, {0, 0}},
+                                      {{30, 30}, {32, 30}, {32, 32}, {30, 30}},
+                                      {{10, 10}, {20, 10}, {20, 20}, {10, 10}},
+                                      {{50, 0}, {50, 10}, {60, 10}, {60, 0}, {50, 0}}};
+
+    util::Arena arena;
+    util::Arena::Scope scope(arena);
+    auto polygons = classifyRingRefs(rings);
+    EXPECT_GT(arena.capacity(), 0u);
+
+    // output: 2 polygons, the first one with 2 interior rings, referring to the input rings
+    ASSERT_EQ(polygons.size(), 2u);
+    ASSERT_EQ(polygons[0].size(), 3u);
+    ASSERT_EQ(polygons[1].size(), 1u);
+    EXPECT_EQ(&rings[0], &static_cast<const GeometryCoordinates&>(polygons[0][0]));
+    EXPECT_EQ(&rings[3], &static_cast<const GeometryCoordinates&>(polygons[1][0]));
+
+    // the same rings as `classifyRings` picks
+    const auto copies = classifyRings(rings);
+    ASSERT_EQ(copies.size(), polygons.size());
+    for (std::size_t i = 0; i < copies.size(); ++i) {
+        ASSERT_EQ(copies[i].size(), polygons[i].size());
+        for (std::size_t j = 0; j < copies[i].size(); ++j) {
+            EXPECT_EQ(copies[i][j], static_cast<const GeometryCoordinates&>(polygons[i][j]));
+        }
+    }
+
+    limitHoles(polygons[0], 1);
+    ASSERT_EQ(polygons[0].size(), 2u);
+    EXPECT_EQ(&rings[2], &static_cast<const GeometryCoordinates&>(polygons[0][1]));
+}
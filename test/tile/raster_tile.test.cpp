@@ -95,3 +95,19 @@ TEST(RasterTile, onParsedEmpty) {
     EXPECT_TRUE(tile.isLoaded());
     EXPECT_TRUE(tile.isComplete());
 }
+
+TEST(RasterTile, UploadDeferred) {
+    RasterTileTest test;
+    RasterTile tile(OverscaledTileID(0, 0, 0), "testSource", test.tileParameters, test.tileset);
+    tile.onParsed(std::make_unique<RasterBucket>(PremultipliedImage{}), 0);
+    EXPECT_TRUE(tile.awaitsUpload());
+
+    // Held back by the upload budget, the tile is rendered once admitted
+    tile.uploadDeferred = true;
+    EXPECT_FALSE(tile.isRenderable());
+    tile.uploadDeferred = false;
+    EXPECT_TRUE(tile.isRenderable());
+
+    tile.uploaded = true;
+    EXPECT_FALSE(tile.awaitsUpload());
+}
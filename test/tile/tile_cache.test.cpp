@@ -40,7 +40,11 @@ public:
 
     void setData(const std::shared_ptr<const std::string>&) override {}
 
+    MemoryUsage getMemoryUsage() const override { return memoryUsage; }
+    void setRebuildCost(Duration cost) { rebuildCost = cost; }
+
     util::SimpleIdentity uniqueId;
+    MemoryUsage memoryUsage;
 };
 
 } // namespace
@@ -96,3 +100,140 @@ TEST(TileCache, Issue15926) {
         EXPECT_FALSE(cache.has(id1));
     }
 }
+
+TEST(TileCache, ByteBudget) {
+    VectorTileTest test;
+    {
+        TileCache cache(test.threadPool, 10);
+        cache.setMaxBytes(1000);
+
+        const OverscaledTileID id0(1, 0, 0);
+        const OverscaledTileID id1(1, 0, 1);
+        const OverscaledTileID id2(1, 1, 0);
+        auto makeTile = [&](const OverscaledTileID& id, size_t cpu, size_t gpu) {
+            auto tile = std::make_unique<VectorTileMock>(id, "source", test.tileParameters, test.tileset);
+            tile->memoryUsage = {.cpu = cpu, .gpu = gpu};
+            return tile;
+        };
+
+        cache.add(id0, makeTile(id0, 300, 100));
+        cache.add(id1, makeTile(id1, 200, 200));
+        EXPECT_EQ(800u, cache.getBytes());
+        EXPECT_TRUE(cache.has(id0));
+        EXPECT_TRUE(cache.has(id1));
+
+        // Exceeding the byte budget evicts the oldest tile, though the count limit isn't reached
+        cache.add(id2, makeTile(id2, 300, 0));
+        EXPECT_FALSE(cache.has(id0));
+        EXPECT_TRUE(cache.has(id1));
+        EXPECT_TRUE(cache.has(id2));
+        EXPECT_EQ(700u, cache.getBytes());
+
+        // Removing a tile releases its share of the budget
+        EXPECT_NE(nullptr, cache.pop(id1));
+        EXPECT_EQ(300u, cache.getBytes());
+
+        // Lowering the budget evicts immediately
+        cache.setMaxBytes(100);
+        EXPECT_FALSE(cache.has(id2));
+        EXPECT_EQ(0u, cache.getBytes());
+
+        // A zero budget means no byte limit
+        cache.setMaxBytes(0);
+        cache.add(id0, makeTile(id0, 5000, 5000));
+        EXPECT_TRUE(cache.has(id0));
+        EXPECT_EQ(10000u, cache.getBytes());
+
+        cache.clear();
+        EXPECT_EQ(0u, cache.getBytes());
+    }
+}
+
+TEST(TileCache, Trim) {
+    VectorTileTest test;
+    {
+        TileCache cache(test.threadPool, 10);
+
+        const OverscaledTileID id0(1, 0, 0);
+        const OverscaledTileID id1(1, 0, 1);
+        const OverscaledTileID id2(1, 1, 0);
+        for (const auto& id : {id0, id1, id2}) {
+            auto tile = std::make_unique<VectorTileMock>(id, "source", test.tileParameters, test.tileset);
+            tile->memoryUsage = {.cpu = 100, .gpu = 100};
+            cache.add(id, std::move(tile));
+        }
+        EXPECT_EQ(600u, cache.getBytes());
+
+        // Trimming evicts the oldest tiles until the target is met
+        cache.trim(300);
+        EXPECT_FALSE(cache.has(id0));
+        EXPECT_FALSE(cache.has(id1));
+        EXPECT_TRUE(cache.has(id2));
+        EXPECT_EQ(200u, cache.getBytes());
+
+        // The limits are unchanged
+        EXPECT_EQ(10u, cache.getMaxSize());
+        EXPECT_EQ(0u, cache.getMaxBytes());
+
+        cache.trim(0);
+        EXPECT_FALSE(cache.has(id2));
+        EXPECT_EQ(0u, cache.getBytes());
+    }
+}
+
+TEST(TileCache, CostWeightedEviction) {
+    VectorTileTest test;
+    {
+        TileCache cache(test.threadPool, 2);
+        cache.setEvictionPolicy(TileCache::EvictionPolicy::CostWeighted);
+
+        const OverscaledTileID expensive(1, 0, 0);
+        const OverscaledTileID cheap(1, 0, 1);
+        const OverscaledTileID id2(1, 1, 0);
+        const OverscaledTileID id3(1, 1, 1);
+        auto makeTile = [&](const OverscaledTileID& id, Milliseconds cost) {
+            auto tile = std::make_unique<VectorTileMock>(id, "source", test.tileParameters, test.tileset);
+            tile->memoryUsage = {.cpu = 1000};
+            tile->setRebuildCost(cost);
+            return tile;
+        };
+
+        // The oldest tile survives because it's more expensive to rebuild
+        cache.add(expensive, makeTile(expensive, Milliseconds(50)));
+        cache.add(cheap, makeTile(cheap, Milliseconds(1)));
+        cache.add(id2, makeTile(id2, Milliseconds(10)));
+        EXPECT_TRUE(cache.has(expensive));
+        EXPECT_FALSE(cache.has(cheap));
+        EXPECT_TRUE(cache.has(id2));
+
+        // Of the remaining tiles, the cheapest to rebuild is the next to go
+        cache.add(id3, makeTile(id3, Milliseconds(45)));
+        EXPECT_TRUE(cache.has(expensive));
+        EXPECT_FALSE(cache.has(id2));
+        EXPECT_TRUE(cache.has(id3));
+    }
+}
+
+TEST(TileCache, ZoomDistanceEviction) {
+    VectorTileTest test;
+    {
+        TileCache cache(test.threadPool, 2);
+        cache.setEvictionPolicy(TileCache::EvictionPolicy::ZoomDistance);
+        cache.setCameraZoom(5.5);
+
+        const OverscaledTileID z5(5, 0, 0);
+        const OverscaledTileID z2(2, 0, 0);
+        const OverscaledTileID z6(6, 0, 0);
+        for (const auto& id : {z5, z2, z6}) {
+            cache.add(id, std::make_unique<VectorTileMock>(id, "source", test.tileParameters, test.tileset));
+        }
+        EXPECT_TRUE(cache.has(z5));
+        EXPECT_FALSE(cache.has(z2));
+        EXPECT_TRUE(cache.has(z6));
+
+        // Equally distant tiles are evicted oldest first
+        cache.setSize(1);
+        EXPECT_FALSE(cache.has(z5));
+        EXPECT_TRUE(cache.has(z6));
+    }
+}
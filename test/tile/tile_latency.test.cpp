@@ -0,0 +1,38 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/tile/tile_latency.hpp>
+
+using namespace mbgl;
+using namespace std::chrono_literals;
+
+TEST(LatencyHistogram, Percentiles) {
+    LatencyHistogram histogram;
+    EXPECT_EQ(Duration::zero(), histogram.percentile(0.5));
+    EXPECT_EQ(Duration::zero(), histogram.mean());
+
+    histogram.add(500us);
+    histogram.add(3ms);
+    histogram.add(3ms);
+    histogram.add(100ms);
+
+    EXPECT_EQ(4u, histogram.count);
+    EXPECT_EQ(1u, histogram.buckets[0]);
+    EXPECT_EQ(2u, histogram.buckets[2]);
+    EXPECT_EQ(1u, histogram.buckets[7]);
+    EXPECT_EQ(Duration(100ms), histogram.max);
+    EXPECT_EQ(Duration(26625us), histogram.mean());
+
+    // The upper bound of the bucket, but never more than the largest latency
+    EXPECT_EQ(Duration(4ms), histogram.percentile(0.5));
+    EXPECT_EQ(Duration(100ms), histogram.percentile(1.0));
+}
+
+TEST(LatencyHistogram, Clamped) {
+    LatencyHistogram histogram;
+    histogram.add(-1ms);
+    histogram.add(1h);
+
+    EXPECT_EQ(1u, histogram.buckets.front());
+    EXPECT_EQ(1u, histogram.buckets.back());
+    EXPECT_EQ(Duration(1h), histogram.percentile(1.0));
+}
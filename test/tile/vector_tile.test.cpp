@@ -1,7 +1,9 @@
 #include <mbgl/test/util.hpp>
 #include <mbgl/test/fake_file_source.hpp>
+#include <mbgl/test/stub_tile_observer.hpp>
 #include <mbgl/tile/vector_mvt_tile.hpp>
 #include <mbgl/tile/vector_mvt_tile_data.hpp>
+#include <mbgl/tile/geometry_tile_data_cache.hpp>
 #include <mbgl/tile/tile_loader_impl.hpp>
 #include <mbgl/storage/resource_options.hpp>
 
@@ -9,7 +11,12 @@
 #include <mbgl/util/run_loop.hpp>
 #include <mbgl/map/transform.hpp>
 #include <mbgl/style/style.hpp>
+#include <mbgl/style/layers/circle_layer.hpp>
+#include <mbgl/style/layers/circle_layer_impl.hpp>
 #include <mbgl/style/layers/symbol_layer.hpp>
+#include <mbgl/style/conversion/filter.hpp>
+#include <mbgl/style/conversion/json.hpp>
+#include <mbgl/platform/settings.hpp>
 #include <mbgl/renderer/tile_parameters.hpp>
 #include <mbgl/renderer/buckets/symbol_bucket.hpp>
 #include <mbgl/renderer/query.hpp>
@@ -20,8 +27,10 @@
 #include <mbgl/text/glyph_manager.hpp>
 
 #include <memory>
+#include <stdexcept>
 
 using namespace mbgl;
+using namespace std::string_literals;
 
 TEST(VectorTile, setError) {
     VectorTileTest test;
@@ -51,6 +60,70 @@ TEST(VectorTile, Issue8542) {
     tile.querySourceFeatures(result, {{{"layer"}}, {}});
 }
 
+TEST(VectorTile, OverscaledTilesShareData) {
+    VectorTileTest test;
+    auto& cache = GeometryTileDataCache::getInstance();
+    cache.clear();
+
+    // Past the maximum zoom, children load their parent's tile and decode it once between them
+    const auto bytes = std::make_shared<std::string>(util::read_file("test/fixtures/map/issue12432/0-0-0.mvt"));
+    VectorMVTTile parent(OverscaledTileID(0, 0, 0), "source", test.tileParameters, test.tileset);
+    VectorMVTTile child(OverscaledTileID(1, 0, {0, 0, 0}), "source", test.tileParameters, test.tileset);
+    VectorMVTTile grandchild(OverscaledTileID(2, 0, {0, 0, 0}), "source", test.tileParameters, test.tileset);
+    parent.setData(bytes);
+    EXPECT_EQ(0u, cache.size());
+    child.setData(bytes);
+    grandchild.setData(std::make_shared<std::string>(*bytes));
+    EXPECT_EQ(1u, cache.size());
+
+    cache.clear();
+}
+
+TEST(VectorTile, ParallelBucketsMalformedFeature) {
+    VectorTileTest test;
+    auto& settings = platform::Settings::getInstance();
+    settings.set(platform::EXPERIMENTAL_PARALLEL_BUCKETS, true);
+
+    // Two source layers, each with a point whose tags refer to a second key that the layer doesn't have
+    const auto feature = "\x08\x01\x12\x02\x01\x00\x18\x01\x22\x03\x09\x32\x22"s;
+    const auto layer = [&](const std::string& name) {
+        const auto bytes = "\x78\x02\x0a\x01"s + name + "\x12\x0d"s + feature +
+                           "\x1a\x04name\x22\x03\x0a\x01x\x28\x80\x20"s;
+        return "\x1a"s + static_cast<char>(bytes.size()) + bytes;
+    };
+    const auto data = std::make_shared<std::string>(layer("a") + layer("b"));
+
+    std::vector<Immutable<LayerProperties>> layers;
+    for (const auto* name : {"a", "b"}) {
+        style::CircleLayer circles(name, "source");
+        circles.setSourceLayer(name);
+        conversion::Error filterError;
+        circles.setFilter(*conversion::convertJSON<style::Filter>(R"(["==", "name", "x"])", filterError));
+        layers.push_back(
+            makeMutable<CircleLayerProperties>(staticImmutableCast<style::CircleLayer::Impl>(circles.baseImpl)));
+    }
+
+    VectorMVTTile tile(OverscaledTileID(0, 0, 0), "source", test.tileParameters, test.tileset);
+    StubTileObserver observer;
+    std::exception_ptr error;
+    observer.tileError = [&](Tile&, std::exception_ptr err) {
+        error = std::move(err);
+    };
+    tile.setObserver(&observer);
+    tile.setLayers(layers);
+    tile.setData(data);
+
+    // Reading the feature throws while its bucket is built on the background scheduler, which fails the tile
+    while (!error) {
+        test.loop.runOnce();
+    }
+    settings.set(platform::EXPERIMENTAL_PARALLEL_BUCKETS, false);
+
+    EXPECT_THROW(std::rethrow_exception(error), std::runtime_error);
+    EXPECT_TRUE(tile.isLoaded());
+    EXPECT_FALSE(tile.isRenderable());
+}
+
 TEST(VectorTileData, ParseResults) {
     VectorMVTTileData data(std::make_shared<std::string>(util::read_file("test/fixtures/map/issue12432/0-0-0.mvt")));
 
@@ -85,3 +158,63 @@ TEST(VectorTileData, ParseResults) {
 
     ASSERT_EQ(feature->getValue("invalid"), std::nullopt);
 }
+
+TEST(VectorTileData, GetValueWithoutProperties) {
+    VectorMVTTileData data(std::make_shared<std::string>(util::read_file("test/fixtures/map/issue12432/0-0-0.mvt")));
+
+    for (const auto& name : data.layerNames()) {
+        std::unique_ptr<GeometryTileLayer> layer = data.getLayer(name);
+        for (std::size_t i = 0; i < layer->featureCount(); ++i) {
+            // A separate feature, so values are decoded directly rather than from its property map
+            std::unique_ptr<GeometryTileFeature> feature = layer->getFeature(i);
+            const PropertyMap properties = layer->getFeature(i)->getProperties();
+            for (const auto& [key, value] : properties) {
+                ASSERT_EQ(value, feature->getValue(key).value_or(Value())) << name << " " << i << " " << key;
+            }
+            ASSERT_EQ(std::nullopt, feature->getValue("invalid"));
+        }
+    }
+}
+
+TEST(VectorTileData, SharedCache) {
+    auto& cache = GeometryTileDataCache::getInstance();
+    cache.clear();
+
+    const auto bytes = std::make_shared<std::string>(util::read_file("test/fixtures/map/issue12432/0-0-0.mvt"));
+    size_t created = 0;
+    const auto factory = [&](std::shared_ptr<const std::string> data) {
+        created++;
+        return std::make_unique<VectorMVTTileData>(std::move(data));
+    };
+
+    const CanonicalTileID id(0, 0, 0);
+    auto first = cache.get("source", id, bytes, factory);
+    // Same contents loaded separately by another map
+    auto second = cache.get("source", id, std::make_shared<std::string>(*bytes), factory);
+    EXPECT_EQ(1u, created);
+    EXPECT_EQ(static_cast<SharedGeometryTileData&>(*first).getShared(),
+              static_cast<SharedGeometryTileData&>(*second).getShared());
+    EXPECT_EQ(17154u, second->getLayer("admin")->featureCount());
+
+    // Clones, as retained by the feature index, refer to the same data
+    auto clone = first->clone();
+    EXPECT_EQ(static_cast<SharedGeometryTileData&>(*first).getShared(),
+              static_cast<SharedGeometryTileData&>(*clone).getShared());
+
+    // Other sources, tiles, or contents are not shared
+    cache.get("other", id, bytes, factory);
+    cache.get("source", CanonicalTileID(1, 0, 0), bytes, factory);
+    auto modified = cache.get("source", id, std::make_shared<std::string>(*bytes + " "), factory);
+    EXPECT_EQ(4u, created);
+    EXPECT_NE(static_cast<SharedGeometryTileData&>(*first).getShared(),
+              static_cast<SharedGeometryTileData&>(*modified).getShared());
+
+    // Entries don't keep the data alive
+    first.reset();
+    second.reset();
+    clone.reset();
+    modified.reset();
+    EXPECT_EQ(0u, cache.size());
+
+    cache.clear();
+}
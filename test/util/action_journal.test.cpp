@@ -513,3 +513,35 @@ TEST(ActionJournal, RenderingStats) {
                   false,
                   gfx::RenderingStats{.encodingTime = encodingAvg, .renderingTime = renderingAvg});
 }
+
+TEST(ActionJournal, FrameTimingEvents) {
+    ActionJournalTest test(ActionJournalOptions().enable().withPath(".").withFrameTimingEvents(), MapMode::Continuous);
+
+    test.map->getStyle().loadJSON(util::read_file("test/fixtures/api/empty.json"));
+    test.map->jumpTo(CameraOptions().withCenter(LatLng{40.7, -74.0}).withZoom(12.5).withBearing(30).withPitch(45));
+    test.map->getActionJournal()->impl->flush();
+
+    const auto onDidFinishRenderingFrame =
+        static_cast<void (RendererObserver::*)(RendererObserver::RenderMode, bool, bool, const gfx::RenderingStats&)>(
+            &RendererObserver::onDidFinishRenderingFrame);
+
+    // every frame is logged with the camera it was rendered with, for the camera path benchmarks to replay
+    validateEvent(
+        test,
+        "onFrameTiming",
+        [&](const mbgl::JSValue& json) {
+            EXPECT_DOUBLE_EQ(json["encodingTime"].GetDouble(), 0.01);
+            EXPECT_DOUBLE_EQ(json["renderingTime"].GetDouble(), 0.002);
+            EXPECT_TRUE(json["frameInterval"].IsDouble());
+            EXPECT_NEAR(json["latitude"].GetDouble(), 40.7, 1e-6);
+            EXPECT_NEAR(json["longitude"].GetDouble(), -74.0, 1e-6);
+            EXPECT_NEAR(json["zoom"].GetDouble(), 12.5, 1e-6);
+            EXPECT_NEAR(json["bearing"].GetDouble(), 30, 1e-6);
+            EXPECT_NEAR(json["pitch"].GetDouble(), 45, 1e-6);
+        },
+        onDidFinishRenderingFrame,
+        RendererObserver::RenderMode::Partial,
+        false,
+        false,
+        gfx::RenderingStats{.encodingTime = 0.01, .renderingTime = 0.002});
+}
@@ -0,0 +1,81 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/util/arena.hpp>
+
+#include <cstdint>
+
+using namespace mbgl;
+using namespace mbgl::util;
+
+TEST(Arena, Scope) {
+    EXPECT_EQ(nullptr, Arena::current());
+    {
+        Arena outer;
+        Arena::Scope outerScope(outer);
+        EXPECT_EQ(&outer, Arena::current());
+        {
+            Arena inner;
+            Arena::Scope innerScope(inner);
+            EXPECT_EQ(&inner, Arena::current());
+        }
+        EXPECT_EQ(&outer, Arena::current());
+    }
+    EXPECT_EQ(nullptr, Arena::current());
+}
+
+TEST(Arena, Allocate) {
+    Arena arena(64);
+    EXPECT_EQ(0u, arena.capacity());
+
+    auto* a = static_cast<char*>(arena.allocate(3, 1));
+    auto* b = arena.allocate(8, 8);
+    EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(b) % 8);
+    EXPECT_EQ(a + 8, b);
+    EXPECT_EQ(64u, arena.capacity());
+
+    // Freeing the last allocation makes its memory available again, freeing another one doesn't
+    arena.deallocate(b, 8);
+    EXPECT_EQ(b, arena.allocate(8, 8));
+    arena.deallocate(a, 3);
+    EXPECT_NE(a, arena.allocate(1, 1));
+
+    // Too large for the remaining space: a new, larger block
+    arena.allocate(100, 4);
+    EXPECT_EQ(64u + 128u, arena.capacity());
+}
+
+TEST(Arena, Reset) {
+    Arena arena(64);
+    arena.allocate(3, 1);
+    auto* large = arena.allocate(100, 4);
+    EXPECT_EQ(64u + 128u, arena.capacity());
+
+    // The largest block is kept and serves the allocations after the reset
+    arena.reset();
+    EXPECT_EQ(128u, arena.capacity());
+    EXPECT_EQ(large, arena.allocate(8, 8));
+    EXPECT_EQ(128u, arena.capacity());
+}
+
+TEST(Arena, Vector) {
+    ArenaVector<int> heap;
+    heap.push_back(1);
+
+    Arena arena;
+    {
+        Arena::Scope scope(arena);
+        ArenaVector<int> values;
+        for (int i = 0; i < 1000; ++i) {
+            values.push_back(i);
+        }
+        EXPECT_EQ(999, values.back());
+        EXPECT_LE(values.size() * sizeof(int), arena.capacity());
+
+        // Vectors keep the arena they were created in
+        auto copy = heap;
+        copy.push_back(2);
+        EXPECT_FALSE(copy.get_allocator() == values.get_allocator());
+        EXPECT_TRUE(copy.get_allocator() == heap.get_allocator());
+    }
+    EXPECT_EQ(1, heap.front());
+}
@@ -0,0 +1,61 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/util/box_batch.hpp>
+
+#include <vector>
+
+using namespace mbgl;
+using namespace mbgl::util;
+
+namespace {
+
+std::vector<uint32_t> intersecting(const BoxBatch& batch, float minX, float minY, float maxX, float maxY) {
+    std::vector<uint32_t> result;
+    batch.forEachIntersecting(minX, minY, maxX, maxY, [&](uint32_t id) {
+        result.push_back(id);
+        return false;
+    });
+    return result;
+}
+
+} // namespace
+
+TEST(BoxBatch, ReportsHitsInOrder) {
+    BoxBatch batch;
+    // More than one batch of four, plus a remainder
+    for (uint32_t i = 0; i < 11; ++i) {
+        const auto x = static_cast<float>(i * 10);
+        batch.push_back(100 + i, x, 0, x + 5, 5);
+    }
+
+    EXPECT_EQ((std::vector<uint32_t>{}), intersecting(batch, 6, 0, 9, 5));
+    EXPECT_EQ((std::vector<uint32_t>{101, 102, 103, 104, 105, 106, 107, 108, 109}), intersecting(batch, 12, 2, 91, 3));
+    EXPECT_EQ((std::vector<uint32_t>{110}), intersecting(batch, 102, 0, 103, 1));
+    EXPECT_EQ((std::vector<uint32_t>{}), intersecting(batch, 0, 6, 200, 10));
+}
+
+TEST(BoxBatch, TouchingEdgesIntersect) {
+    BoxBatch batch;
+    batch.push_back(0, 0, 0, 10, 10);
+    batch.push_back(1, 20, 0, 30, 10);
+    batch.push_back(2, 0, 20, 10, 30);
+    batch.push_back(3, 20, 20, 30, 30);
+
+    EXPECT_EQ((std::vector<uint32_t>{0, 1, 2, 3}), intersecting(batch, 10, 10, 20, 20));
+    EXPECT_EQ((std::vector<uint32_t>{1, 3}), intersecting(batch, 30, 0, 40, 30));
+}
+
+TEST(BoxBatch, StopsWhenCallbackReturnsTrue) {
+    BoxBatch batch;
+    for (uint32_t i = 0; i < 8; ++i) {
+        batch.push_back(i, 0, 0, 1, 1);
+    }
+
+    std::vector<uint32_t> seen;
+    EXPECT_TRUE(batch.forEachIntersecting(0, 0, 1, 1, [&](uint32_t id) {
+        seen.push_back(id);
+        return id == 5;
+    }));
+    EXPECT_EQ((std::vector<uint32_t>{0, 1, 2, 3, 4, 5}), seen);
+    EXPECT_FALSE(batch.forEachIntersecting(0, 0, 1, 1, [](uint32_t) { return false; }));
+}
@@ -0,0 +1,60 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/util/compression.hpp>
+
+#include <stdexcept>
+#include <string>
+
+using namespace mbgl;
+
+namespace {
+
+std::string tileLikeData(std::size_t size) {
+    std::string data(size, '\0');
+    for (std::size_t i = 0; i < size; ++i) {
+        data[i] = static_cast<char>((i * 7) % 13);
+    }
+    return data;
+}
+
+} // namespace
+
+TEST(Compression, RoundTrip) {
+    const auto data = tileLikeData(100000);
+    for (const auto format : {util::ZLIB, util::GZIP, util::DEFLATE}) {
+        const auto compressed = util::compress(data, format);
+        EXPECT_LT(compressed.size(), data.size());
+        EXPECT_EQ(data, util::decompress(compressed, format));
+        if (format != util::DEFLATE) {
+            EXPECT_TRUE(util::is_compressed(compressed));
+            EXPECT_EQ(data, util::decompress(compressed));
+        }
+    }
+}
+
+TEST(Compression, HighRatio) {
+    // Much larger than the initial output buffer of a zlib stream
+    const std::string data(10 * 1024 * 1024, 'a');
+    EXPECT_EQ(data, util::decompress(util::compress(data)));
+    EXPECT_EQ(data, util::decompress(util::compress(data, util::GZIP)));
+}
+
+TEST(Compression, Empty) {
+    EXPECT_EQ("", util::decompress(util::compress("")));
+}
+
+TEST(Compression, Corrupt) {
+    auto compressed = util::compress(tileLikeData(1000));
+    compressed.resize(compressed.size() / 2);
+    EXPECT_THROW(util::decompress(compressed), std::runtime_error);
+    // Repeated on the same thread, which reuses the inflate state
+    EXPECT_THROW(util::decompress(compressed), std::runtime_error);
+    EXPECT_EQ(tileLikeData(10), util::decompress(util::compress(tileLikeData(10))));
+}
+
+TEST(Compression, DetectZstd) {
+    // Frame magic number of an empty zstd frame
+    const std::string frame{"\x28\xb5\x2f\xfd\x20\x00\x01\x00\x00", 9};
+    EXPECT_TRUE(util::is_compressed(frame));
+    EXPECT_FALSE(util::is_compressed(frame.substr(0, 3)));
+}
@@ -0,0 +1,64 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/util/geometry_util.hpp>
+
+#include <random>
+
+using namespace mbgl;
+
+namespace {
+
+// Rings of random vertices, which cross themselves and each other plenty
+Polygon<int64_t> randomPolygon(std::mt19937& rng, std::size_t rings, std::size_t vertices) {
+    std::uniform_int_distribution<int64_t> coordinate(0, 1000);
+    Polygon<int64_t> polygon;
+    for (std::size_t r = 0; r < rings; ++r) {
+        LinearRing<int64_t> ring;
+        for (std::size_t i = 0; i < vertices; ++i) {
+            ring.emplace_back(coordinate(rng), coordinate(rng));
+        }
+        ring.push_back(ring.front());
+        polygon.push_back(std::move(ring));
+    }
+    return polygon;
+}
+
+} // namespace
+
+TEST(PolygonEdgeIndex, MatchesWholePolygon) {
+    std::mt19937 rng(42);
+    // Around the polygon, on its vertices now and then
+    std::uniform_int_distribution<int64_t> coordinate(-50, 1050);
+
+    for (const std::size_t vertices : {3u, 20u, 500u}) {
+        const auto polygon = randomPolygon(rng, 2, vertices);
+        const PolygonEdgeIndex<int64_t> index(polygon);
+        for (int i = 0; i < 1000; ++i) {
+            const Point<int64_t> p1(coordinate(rng), coordinate(rng));
+            const Point<int64_t> p2 = i % 10 ? Point<int64_t>(coordinate(rng), coordinate(rng)) : polygon[0][1];
+            EXPECT_EQ(pointWithinPolygon(p1, polygon), index.contains(p1));
+            EXPECT_EQ(pointWithinPolygon(p2, polygon, true), index.contains(p2, true));
+            EXPECT_EQ(lineIntersectPolygon(p1, p2, polygon), index.intersects(p1, p2));
+            EXPECT_EQ(lineStringWithinPolygon(LineString<int64_t>{p1, p2}, polygon),
+                      index.contains(LineString<int64_t>{p1, p2}));
+        }
+    }
+}
+
+TEST(PolygonEdgeIndex, Bands) {
+    const Polygon<double> square{{{0, 0}, {10, 0}, {10, 10}, {0, 10}, {0, 0}}};
+    const PolygonEdgeIndex<double> index(square);
+    EXPECT_EQ((GeometryBBox<double>{{0, 0, 10, 10}}), index.getBBox());
+    ASSERT_EQ(1u, index.getBandCount());
+    EXPECT_EQ(0u, index.band(-5));
+    EXPECT_EQ(0u, index.band(15));
+
+    std::size_t edges = 0;
+    index.eachEdge(0, [&](const auto&, const auto&) { ++edges; });
+    EXPECT_EQ(4u, edges);
+
+    EXPECT_TRUE(index.contains(Point<double>(5, 5)));
+    EXPECT_FALSE(index.contains(Point<double>(10, 5)));
+    EXPECT_TRUE(index.contains(Point<double>(10, 5), true));
+    EXPECT_FALSE(index.contains(Point<double>(5, 11)));
+}
@@ -2,6 +2,9 @@
 
 #include <mbgl/test/util.hpp>
 
+#include <random>
+#include <set>
+
 using namespace mbgl;
 
 TEST(GridIndex, IndexesFeatures) {
@@ -55,3 +58,41 @@ TEST(GridIndex, IndexesFeaturesOverflow) {
     grid.insert(0, {{4500, 4500}, {4900, 4900}});
     EXPECT_EQ(grid.query({{4000, 4000}, {5000, 5000}}), (std::vector<int16_t>{0}));
 }
+
+TEST(GridIndex, MatchesBruteForce) {
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<float> position(-20, 220);
+    std::uniform_real_distribution<float> extent(0, 30);
+
+    GridIndex<int16_t> grid(200, 200, 25);
+    std::vector<GridIndex<int16_t>::BBox> boxes;
+    for (int16_t i = 0; i < 300; ++i) {
+        const float x = position(generator);
+        const float y = position(generator);
+        boxes.push_back({{x, y}, {x + extent(generator), y + extent(generator)}});
+        grid.insert(int16_t(i), boxes.back());
+    }
+
+    for (int i = 0; i < 200; ++i) {
+        const float x = position(generator);
+        const float y = position(generator);
+        const GridIndex<int16_t>::BBox query{{x, y}, {x + extent(generator), y + extent(generator)}};
+
+        std::set<int16_t> expected;
+        for (std::size_t j = 0; j < boxes.size(); ++j) {
+            if (query.min.x <= boxes[j].max.x && query.min.y <= boxes[j].max.y && query.max.x >= boxes[j].min.x &&
+                query.max.y >= boxes[j].min.y) {
+                expected.insert(static_cast<int16_t>(j));
+            }
+        }
+        // Queries outside the grid don't report anything
+        if (query.max.x < 0 || query.min.x >= 200 || query.max.y < 0 || query.min.y >= 200) {
+            expected.clear();
+        }
+
+        const auto result = grid.query(query);
+        EXPECT_EQ(expected.size(), result.size());
+        EXPECT_EQ(expected, std::set<int16_t>(result.begin(), result.end()));
+        EXPECT_EQ(!expected.empty(), grid.hitTest(query));
+    }
+}
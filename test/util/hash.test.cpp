@@ -129,6 +129,7 @@ TEST(OrderIndependentHash, Shaders) {
     checkShaderHashes<BuiltIn::BackgroundShader,
                       BuiltIn::BackgroundPatternShader,
                       BuiltIn::CircleShader,
+                      BuiltIn::CircleInstancedShader,
                       BuiltIn::CollisionBoxShader,
                       BuiltIn::CollisionCircleShader,
                       BuiltIn::CustomGeometryShader,
@@ -1,9 +1,14 @@
 #include <mbgl/test/util.hpp>
 
+#include <mbgl/util/compressed_image.hpp>
 #include <mbgl/util/premultiply.hpp>
 #include <mbgl/util/image.hpp>
 #include <mbgl/util/io.hpp>
 
+#include <algorithm>
+#include <array>
+#include <cstring>
+
 using namespace mbgl;
 
 TEST(Image, PNGRoundTrip) {
@@ -146,6 +151,46 @@ TEST(Image, Move) {
     EXPECT_EQ(1u, moved.size.width);
 }
 
+TEST(Image, PremultiplyRows) {
+    // Every color and alpha combination, past the vector widths and with an unaligned tail
+    UnassociatedImage rgba({256 * 256 + 3, 1});
+    for (std::size_t i = 0; i < rgba.size.area(); ++i) {
+        rgba.data[i * 4 + 0] = static_cast<uint8_t>(i / 256);
+        rgba.data[i * 4 + 1] = static_cast<uint8_t>(255 - i / 256);
+        rgba.data[i * 4 + 2] = static_cast<uint8_t>(i / 512);
+        rgba.data[i * 4 + 3] = static_cast<uint8_t>(i);
+    }
+    UnassociatedImage expected = rgba.clone();
+
+    util::premultiply(rgba.data.get(), rgba.size.area());
+    for (std::size_t i = 0; i < rgba.bytes(); ++i) {
+        const uint8_t alpha = expected.data[i | 3];
+        const uint8_t value = (i & 3) == 3 ? alpha : static_cast<uint8_t>((expected.data[i] * alpha + 127) / 255);
+        ASSERT_EQ(value, rgba.data[i]) << "at byte " << i;
+    }
+}
+
+TEST(Image, UnpremultiplyRows) {
+    // Every color and alpha combination, including colors brighter than their alpha
+    PremultipliedImage rgba({256 * 256 + 3, 1});
+    for (std::size_t i = 0; i < rgba.size.area(); ++i) {
+        rgba.data[i * 4 + 0] = static_cast<uint8_t>(i / 256);
+        rgba.data[i * 4 + 1] = static_cast<uint8_t>(255 - i / 256);
+        rgba.data[i * 4 + 2] = static_cast<uint8_t>(i / 512);
+        rgba.data[i * 4 + 3] = static_cast<uint8_t>(i);
+    }
+    PremultipliedImage expected = rgba.clone();
+
+    util::unpremultiply(rgba.data.get(), rgba.size.area());
+    for (std::size_t i = 0; i < rgba.bytes(); ++i) {
+        const uint8_t alpha = expected.data[i | 3];
+        const uint8_t value = (i & 3) == 3 || alpha == 0
+                                  ? expected.data[i]
+                                  : static_cast<uint8_t>(std::min((255 * expected.data[i] + alpha / 2) / alpha, 255));
+        ASSERT_EQ(value, rgba.data[i]) << "at byte " << i;
+    }
+}
+
 TEST(Image, Premultiply) {
     UnassociatedImage rgba({1, 1});
     rgba.data[0] = 255;
@@ -163,3 +208,25 @@ TEST(Image, Premultiply) {
     EXPECT_EQ(0u, rgba.size.width);
     EXPECT_EQ(0u, rgba.size.height);
 }
+
+TEST(Image, KTX) {
+    // A 6x5 ETC2 RGB texture, 2x2 blocks of 8 bytes, with 4 bytes of key/value data
+    const std::array<uint8_t, 12> identifier = {0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n'};
+    const std::array<uint32_t, 13> header = {0x04030201, 0, 1, 0, 0x9274, 0x1907, 6, 5, 0, 0, 1, 1, 4};
+    const uint32_t imageSize = 32;
+
+    std::string ktx(identifier.begin(), identifier.end());
+    ktx.append(reinterpret_cast<const char*>(header.data()), sizeof(header));
+    ktx.append(4, '\0');
+    ktx.append(reinterpret_cast<const char*>(&imageSize), sizeof(imageSize));
+    ktx.append(imageSize, 'x');
+
+    ASSERT_TRUE(isKTX(ktx));
+    const auto image = decodeKTX(ktx);
+    EXPECT_EQ(CompressedImageFormat::ETC2RGB8, image.format);
+    EXPECT_EQ(Size(6, 5), image.size);
+    EXPECT_EQ(std::string(imageSize, 'x'), image.data);
+
+    EXPECT_FALSE(isKTX("\x89PNG"));
+    EXPECT_THROW(decodeKTX(ktx.substr(0, ktx.size() - 1)), std::runtime_error);
+}
@@ -0,0 +1,47 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/util/mat4.hpp>
+
+using namespace mbgl;
+
+namespace {
+
+mat4 referenceMultiply(const mat4& a, const mat4& b) {
+    mat4 out{};
+    for (std::size_t column = 0; column < 4; ++column) {
+        for (std::size_t row = 0; row < 4; ++row) {
+            double sum = 0;
+            for (std::size_t k = 0; k < 4; ++k) {
+                sum += a[k * 4 + row] * b[column * 4 + k];
+            }
+            out[column * 4 + row] = sum;
+        }
+    }
+    return out;
+}
+
+} // namespace
+
+TEST(Mat4, Multiply) {
+    mat4 projection;
+    matrix::perspective(projection, 0.6435, 1.5, 0.1, 5000.0);
+    mat4 tile = matrix::identity4();
+    matrix::translate(tile, tile, 1.25e6, -3.5e5, 0);
+    matrix::scale(tile, tile, 1024.0 / 8192, 1024.0 / 8192, 1);
+    matrix::rotate_z(tile, tile, 0.3);
+
+    mat4 result;
+    matrix::multiply(result, projection, tile);
+    const auto expected = referenceMultiply(projection, tile);
+    for (std::size_t i = 0; i < 16; ++i) {
+        EXPECT_DOUBLE_EQ(expected[i], result[i]) << i;
+    }
+
+    // The output may be either input
+    mat4 inPlace = tile;
+    matrix::multiply(inPlace, projection, inPlace);
+    EXPECT_EQ(result, inPlace);
+    inPlace = projection;
+    matrix::multiply(inPlace, inPlace, tile);
+    EXPECT_EQ(result, inPlace);
+}
@@ -113,6 +113,27 @@ TEST(MergeLines, CircularLines) {
     }
 }
 
+TEST(MergeLines, NegativeCoordinates) {
+    // mergeLines merges lines in the tile's buffer, and only lines with the same text
+    std::vector<mbgl::SymbolFeature> input4;
+    input4.push_back(
+        SymbolFeatureStub{{}, FeatureType::LineString, {{{-4, -1}, {-3, -1}, {-2, -1}}}, properties, aaa, {}, 0});
+    input4.push_back(SymbolFeatureStub{{}, FeatureType::LineString, {{{-2, -1}, {-1, -1}}}, properties, bbb, {}, 0});
+    input4.push_back(SymbolFeatureStub{{}, FeatureType::LineString, {{{-2, -1}, {0, -1}}}, properties, aaa, {}, 0});
+
+    std::vector<StubGeometryTileFeature> expected4;
+    expected4.emplace_back(StubGeometryTileFeature(
+        {}, FeatureType::LineString, {{{-4, -1}, {-3, -1}, {-2, -1}, {0, -1}}}, properties));
+    expected4.emplace_back(StubGeometryTileFeature({}, FeatureType::LineString, {{{-2, -1}, {-1, -1}}}, properties));
+    expected4.emplace_back(StubGeometryTileFeature({}, FeatureType::LineString, {emptyLine}, properties));
+
+    mbgl::util::mergeLines(input4);
+
+    for (int i = 0; i < 3; i++) {
+        EXPECT_TRUE(input4[i].geometry == expected4[i].getGeometries());
+    }
+}
+
 TEST(MergeLines, EmptyOuterGeometry) {
     std::vector<mbgl::SymbolFeature> input;
     input.push_back(SymbolFeatureStub{{}, FeatureType::LineString, {}, properties, aaa, {}, 0});
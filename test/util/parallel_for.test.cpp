@@ -0,0 +1,85 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/util/parallel_for.hpp>
+#include <mbgl/util/thread_pool.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace mbgl;
+using namespace mbgl::util;
+
+TEST(ParallelFor, CallsEveryIndexOnce) {
+    ThreadPool pool;
+    constexpr std::size_t count = 1000;
+    std::vector<std::atomic<int>> calls(count);
+
+    parallelFor(pool, count, 3, [&](std::size_t i) { calls[i]++; });
+
+    for (std::size_t i = 0; i < count; ++i) {
+        EXPECT_EQ(1, calls[i].load()) << i;
+    }
+}
+
+TEST(ParallelFor, RunsInlineWithoutHelpers) {
+    ThreadPool pool;
+    const auto caller = std::this_thread::get_id();
+    std::vector<std::size_t> order;
+
+    parallelFor(pool, 5, 0, [&](std::size_t i) {
+        EXPECT_EQ(caller, std::this_thread::get_id());
+        order.push_back(i);
+    });
+
+    EXPECT_EQ((std::vector<std::size_t>{0, 1, 2, 3, 4}), order);
+    parallelFor(pool, 0, 3, [&](std::size_t) { FAIL(); });
+}
+
+TEST(ParallelFor, ProgressesWhileSchedulerIsBusy) {
+    ThreadPool pool;
+    std::atomic<bool> release{false};
+    for (int i = 0; i < 4; ++i) {
+        pool.schedule([&] {
+            while (!release) {
+                std::this_thread::yield();
+            }
+        });
+    }
+
+    // All pool threads are blocked, the caller has to do the work by itself
+    std::atomic<std::size_t> calls{0};
+    parallelFor(pool, 100, 3, [&](std::size_t) { calls++; });
+    EXPECT_EQ(100u, calls.load());
+
+    release = true;
+}
+
+TEST(ParallelFor, RethrowsAfterAllCallsFinish) {
+    ThreadPool pool;
+    std::atomic<int> running{0};
+
+    // Whichever thread takes the throwing index, the others are done with the captures by the time it's rethrown
+    for (std::size_t throwing : {std::size_t{0}, std::size_t{37}, std::size_t{99}}) {
+        EXPECT_THROW(parallelFor(pool,
+                                 100,
+                                 3,
+                                 [&](std::size_t i) {
+                                     running++;
+                                     std::this_thread::yield();
+                                     running--;
+                                     if (i == throwing) {
+                                         throw std::runtime_error("index " + std::to_string(i));
+                                     }
+                                 }),
+                     std::runtime_error);
+        EXPECT_EQ(0, running.load());
+    }
+
+    // The pool is still usable
+    std::atomic<std::size_t> calls{0};
+    parallelFor(pool, 100, 3, [&](std::size_t) { calls++; });
+    EXPECT_EQ(100u, calls.load());
+}
@@ -0,0 +1,95 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/util/reclamation_queue.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace mbgl;
+using namespace mbgl::util;
+
+namespace {
+
+struct Counted {
+    Counted(std::atomic<size_t>& destroyed_)
+        : destroyed(destroyed_) {}
+    ~Counted() { destroyed++; }
+
+    std::atomic<size_t>& destroyed;
+};
+
+} // namespace
+
+TEST(ReclamationQueue, DrainsInOrder) {
+    std::vector<int> order;
+    struct Recorder {
+        Recorder(std::vector<int>& order_, int value_)
+            : order(order_),
+              value(value_) {}
+        ~Recorder() { order.push_back(value); }
+
+        std::vector<int>& order;
+        int value;
+    };
+
+    ReclamationQueue<Recorder> queue;
+    EXPECT_TRUE(queue.empty());
+
+    ReclamationQueue<Recorder>::Batch first;
+    first.push_back(std::make_unique<Recorder>(order, 1));
+    first.push_back(std::make_unique<Recorder>(order, 2));
+    EXPECT_TRUE(queue.push(std::move(first)));
+
+    ReclamationQueue<Recorder>::Batch second;
+    second.push_back(std::make_unique<Recorder>(order, 3));
+    EXPECT_FALSE(queue.push(std::move(second)));
+
+    EXPECT_TRUE(order.empty());
+    EXPECT_EQ(3u, queue.drain());
+    EXPECT_EQ((std::vector<int>{1, 2, 3}), order);
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(0u, queue.drain());
+}
+
+TEST(ReclamationQueue, ConcurrentProducers) {
+    constexpr size_t producerCount = 4;
+    constexpr size_t batchCount = 1000;
+    constexpr size_t batchSize = 3;
+
+    std::atomic<size_t> destroyed{0};
+    std::atomic<bool> done{false};
+    size_t drained = 0;
+    {
+        ReclamationQueue<Counted> queue;
+
+        std::thread consumer([&] {
+            while (!done) {
+                drained += queue.drain();
+            }
+        });
+
+        std::vector<std::thread> producers;
+        for (size_t i = 0; i < producerCount; ++i) {
+            producers.emplace_back([&] {
+                for (size_t j = 0; j < batchCount; ++j) {
+                    ReclamationQueue<Counted>::Batch batch;
+                    for (size_t k = 0; k < batchSize; ++k) {
+                        batch.push_back(std::make_unique<Counted>(destroyed));
+                    }
+                    queue.push(std::move(batch));
+                }
+            });
+        }
+        for (auto& producer : producers) {
+            producer.join();
+        }
+
+        done = true;
+        consumer.join();
+        drained += queue.drain();
+    }
+
+    EXPECT_EQ(producerCount * batchCount * batchSize, drained);
+    EXPECT_EQ(producerCount * batchCount * batchSize, destroyed);
+}
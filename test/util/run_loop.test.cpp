@@ -111,3 +111,45 @@ TEST(RunLoop, PlatformIntegration) {
     thread1.join();
     thread2.join();
 }
+
+TEST(RunLoop, CoalescedWakeups) {
+    RunLoop loop(RunLoop::Type::New);
+
+    int count = 0;
+    std::thread thread([&] {
+        for (int i = 0; i < 100; ++i) {
+            loop.invoke([&] { count++; });
+        }
+        loop.stop();
+    });
+    thread.join();
+
+    loop.run();
+
+    // Queued before the loop ran, the tasks are all run on the first wakeup
+    EXPECT_EQ(100, count);
+    EXPECT_EQ(1u, loop.getStats().wakeups);
+    EXPECT_EQ(101u, loop.getStats().tasks);
+}
+
+TEST(RunLoop, TimeSlice) {
+    RunLoop loop(RunLoop::Type::New);
+    loop.setTimeSlice(std::chrono::milliseconds(1));
+
+    std::vector<int> order;
+    for (int i = 0; i < 3; ++i) {
+        loop.invoke([&, i] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            order.push_back(i);
+        });
+    }
+    loop.invoke(RunLoop::Priority::High, [&] { order.push_back(3); });
+    loop.stop();
+
+    loop.run();
+
+    // Each slow task uses up the slice, the rest waits for the next wakeup
+    EXPECT_EQ((std::vector<int>{3, 0, 1, 2}), order);
+    EXPECT_EQ(4u, loop.getStats().wakeups);
+    EXPECT_EQ(5u, loop.getStats().tasks);
+}
@@ -3,6 +3,9 @@
 #include <mbgl/util/string_indexer.hpp>
 
 #include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
 
 using mbgl::stringIndexer;
 
@@ -85,11 +88,40 @@ TEST(StringIndexer, GetOOBIdentity) {
 
     std::string str;
 #ifndef NDEBUG
-    EXPECT_DEATH_IF_SUPPORTED(str = strIndexer.get(42), "id < identityToString.size\\(\\)");
+    EXPECT_DEATH_IF_SUPPORTED(str = strIndexer.get(42), "id < size\\(\\)");
 #endif
     EXPECT_TRUE(str.empty());
 #ifndef NDEBUG
-    EXPECT_DEATH_IF_SUPPORTED(str = strIndexer.get(-1), "id < identityToString.size\\(\\)");
+    EXPECT_DEATH_IF_SUPPORTED(str = strIndexer.get(-1), "id < size\\(\\)");
 #endif
     EXPECT_TRUE(str.empty());
 }
+
+TEST(StringIndexer, ConcurrentAdd) {
+    StringIndexer strIndexer;
+
+    // Every thread adds the same strings in a different order, growing the table while others read it
+    constexpr int threadCount = 4;
+    constexpr int N = 2000;
+    std::vector<std::vector<mbgl::StringIdentity>> ids(threadCount, std::vector<mbgl::StringIdentity>(N));
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&, t] {
+            for (int j = 0; j < N; ++j) {
+                const int i = (j * 7 + t * 500) % N;
+                ids[t][i] = strIndexer.get("concurrent " + std::to_string(i));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(strIndexer.size(), N);
+    for (int i = 0; i < N; ++i) {
+        for (int t = 1; t < threadCount; ++t) {
+            EXPECT_EQ(ids[0][i], ids[t][i]);
+        }
+        EXPECT_EQ(strIndexer.get(ids[0][i]), "concurrent " + std::to_string(i));
+    }
+}
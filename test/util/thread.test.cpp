@@ -5,6 +5,7 @@
 #include <mbgl/platform/settings.hpp>
 #include <mbgl/test/util.hpp>
 #include <mbgl/util/run_loop.hpp>
+#include <mbgl/util/thread_pool.hpp>
 #include <mbgl/util/timer.hpp>
 
 #include <atomic>
@@ -477,3 +478,165 @@ TEST(Thread, TaggedPools) {
     // Same for queue 2
     ASSERT_TRUE(totalRuns2 == runCount2);
 }
+
+TEST(Thread, WorkStealingPoolWait) {
+    std::shared_ptr<Scheduler> pool = std::make_shared<ThreadPool>(ThreadPool::Mode::WorkStealing);
+    const util::SimpleIdentity tag;
+
+    std::atomic<int> executed{0};
+    constexpr int taskCount = 1000;
+    for (int i = 0; i < taskCount; ++i) {
+        pool->schedule(tag, [&] {
+            executed++;
+            // Tasks added from a worker go to that worker's own deque
+            pool->schedule(tag, [&] { executed++; });
+        });
+    }
+
+    pool->waitForEmpty(tag);
+    EXPECT_EQ(2 * taskCount, executed);
+}
+
+TEST(Thread, WorkStealingTaggedPools) {
+    auto scheduler = std::make_shared<ThreadPool>(ThreadPool::Mode::WorkStealing);
+    TaggedScheduler poolTag1{scheduler, {}};
+    TaggedScheduler poolTag2{scheduler, {}};
+
+    std::atomic<bool> stopTasks1{false};
+    std::atomic<bool> stopTasks2{false};
+    std::atomic<size_t> runCount1{0};
+    std::atomic<size_t> runCount2{0};
+
+    for (auto i = 0; i < 50; i++) {
+        poolTag1.schedule(makeCounterThread(poolTag1, &stopTasks1, &runCount1));
+        poolTag2.schedule(makeCounterThread(poolTag2, &stopTasks2, &runCount2));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    // Waiting on one tag doesn't depend on the other tag's tasks
+    stopTasks1 = true;
+    poolTag1.waitForEmpty();
+    const auto totalRuns1 = runCount1.load();
+
+    stopTasks2 = true;
+    poolTag2.waitForEmpty();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    ASSERT_EQ(totalRuns1, runCount1);
+}
+
+TEST(Thread, WorkStealingPoolException) {
+    std::shared_ptr<Scheduler> pool = std::make_shared<ThreadPool>(ThreadPool::Mode::WorkStealing);
+    const util::SimpleIdentity tag;
+
+    std::atomic<int> caught{0};
+    pool->setExceptionHandler([&](const auto) { caught++; });
+
+    constexpr int threadCount = 3;
+    for (int i = 0; i < threadCount; ++i) {
+        pool->schedule(tag, [] { throw std::runtime_error("test"); });
+    }
+
+    pool->waitForEmpty(tag);
+    EXPECT_EQ(threadCount, caught);
+}
+
+TEST(Thread, PoolPriority) {
+    std::shared_ptr<Scheduler> pool = std::make_shared<SequencedScheduler>();
+    const util::SimpleIdentity tag1;
+    const util::SimpleIdentity tag2;
+
+    std::promise<void> blocker;
+    auto blocked = blocker.get_future().share();
+    pool->schedule(tag1, [blocked] { blocked.wait(); });
+
+    std::mutex orderLock;
+    std::vector<int> order;
+    auto record = [&](int value) {
+        return [&, value] {
+            std::scoped_lock lock(orderLock);
+            order.push_back(value);
+        };
+    };
+
+    pool->scheduleWithPriority(tag1, TaskPriority::Housekeeping, record(4));
+    pool->schedule(tag1, record(2));
+    pool->scheduleWithPriority(tag2, TaskPriority::Prefetch, record(3));
+    pool->scheduleWithPriority(tag2, TaskPriority::Urgent, record(1));
+    blocker.set_value();
+
+    pool->waitForEmpty(tag1);
+    pool->waitForEmpty(tag2);
+
+    EXPECT_EQ((std::vector<int>{1, 2, 3, 4}), order);
+}
+
+TEST(Thread, WorkStealingPoolPriority) {
+    std::shared_ptr<Scheduler> pool = std::make_shared<ThreadPool>(ThreadPool::Mode::WorkStealing);
+    const util::SimpleIdentity tag;
+
+    std::atomic<int> executed{0};
+    constexpr int taskCount = 100;
+    for (int i = 0; i < taskCount; ++i) {
+        pool->scheduleWithPriority(tag, static_cast<TaskPriority>(i % 4), [&] {
+            executed++;
+            pool->scheduleWithPriority(tag, TaskPriority::Urgent, [&] { executed++; });
+        });
+    }
+
+    pool->waitForEmpty(tag);
+    EXPECT_EQ(2 * taskCount, executed);
+}
+
+TEST(Thread, PoolThreadOptions) {
+    ThreadPool::ThreadOptions options;
+    options.affinity = {0};
+    options.housekeepingAffinity = {0};
+    std::shared_ptr<Scheduler> pool = std::make_shared<ThreadPool>(ThreadPool::Mode::WorkStealing, options);
+    const util::SimpleIdentity tag;
+
+    // Workers move between the CPUs of housekeeping and other tasks as they run them
+    std::atomic<int> executed{0};
+    constexpr int taskCount = 100;
+    for (int i = 0; i < taskCount; ++i) {
+        const auto priority = i % 2 ? TaskPriority::Housekeeping : TaskPriority::Normal;
+        pool->scheduleWithPriority(tag, priority, [&] { executed++; });
+    }
+
+    pool->waitForEmpty(tag);
+    EXPECT_EQ(taskCount, executed);
+}
+
+TEST(Thread, ParseCPUList) {
+    using Options = ThreadPool::ThreadOptions;
+    EXPECT_EQ((std::vector<std::size_t>{3}), Options::parseCPUList("3"));
+    EXPECT_EQ((std::vector<std::size_t>{0, 4, 5, 6, 7}), Options::parseCPUList("0,4-7"));
+    EXPECT_EQ((std::vector<std::size_t>{2, 2}), Options::parseCPUList("2-2,2"));
+    EXPECT_FALSE(Options::parseCPUList(""));
+    EXPECT_FALSE(Options::parseCPUList("1,"));
+    EXPECT_FALSE(Options::parseCPUList("7-4"));
+    EXPECT_FALSE(Options::parseCPUList("-1"));
+    EXPECT_FALSE(Options::parseCPUList("1-"));
+    EXPECT_FALSE(Options::parseCPUList("a"));
+    EXPECT_FALSE(Options::parseCPUList("0-100000"));
+}
+
+TEST(Thread, RenderJobBudget) {
+    std::shared_ptr<Scheduler> pool = std::make_shared<ThreadPool>();
+    const util::SimpleIdentity tag;
+
+    std::vector<int> order;
+    pool->runOnRenderThread(tag, TaskPriority::Housekeeping, [&] { order.push_back(3); });
+    pool->runOnRenderThread(tag, [&] { order.push_back(2); });
+    pool->runOnRenderThread(tag, TaskPriority::Urgent, [&] { order.push_back(1); });
+
+    // Once the budget is spent, only the urgent jobs run
+    pool->runRenderJobs(tag, Duration::zero());
+    EXPECT_EQ((std::vector<int>{1}), order);
+
+    // The rest are carried over to the next call, in priority order
+    pool->runRenderJobs(tag, std::chrono::seconds(10));
+    EXPECT_EQ((std::vector<int>{1, 2, 3}), order);
+
+    pool->runRenderJobs(tag, true /* closeQueue */);
+}
@@ -169,6 +169,30 @@ TEST(TileCover, PitchWithLargerResultSet) {
               (std::vector<OverscaledTileID>{cover.begin(), cover.begin() + 16}));
 }
 
+TEST(TileCover, ScreenSpaceError) {
+    Transform transform;
+    transform.resize({1024, 768});
+    transform.jumpTo(CameraOptions().withCenter(LatLng{0.1, -0.1}).withZoom(14).withPitch(70.0));
+
+    util::TileCoverParameters params{transform.getState()};
+    params.tileLodPitchThreshold = std::numbers::pi;
+    const auto fullCover = util::tileCover(params, 14, zoomRange);
+
+    params.tileLodPitchThreshold = 0.0;
+    params.tileLodMode = TileLodMode::ScreenSpaceError;
+    const auto cover = util::tileCover(params, 14, zoomRange);
+    ASSERT_FALSE(cover.empty());
+    EXPECT_LT(cover.size(), fullCover.size());
+    // Full detail near the camera, coarser toward the horizon
+    EXPECT_EQ(14, cover.front().canonical.z);
+    EXPECT_TRUE(std::any_of(cover.begin(), cover.end(), [](const auto& id) { return id.canonical.z < 14; }));
+
+    params.tileLodMaxTiles = cover.size() / 2;
+    const auto budgetCover = util::tileCover(params, 14, zoomRange);
+    EXPECT_LE(budgetCover.size(), params.tileLodMaxTiles);
+    EXPECT_FALSE(budgetCover.empty());
+}
+
 TEST(TileCover, WorldZ1) {
     EXPECT_EQ((std::vector<UnwrappedTileID>{
                   {1, 0, 0},
@@ -576,6 +600,40 @@ TEST(TileCount, BoundsCrossingAntimeridian) {
     EXPECT_EQ(8u, util::tileCount(crossingBounds, 4));
 }
 
+TEST(TileCount, GeomMatchesCover) {
+    const auto multiPolygon = MultiPolygon<double>{{{
+                                                       {5.09765625, 53.067626642387374},
+                                                       {2.373046875, 43.389081939117496},
+                                                       {-4.74609375, 48.45835188280866},
+                                                       {-1.494140625, 37.09023980307208},
+                                                       {22.587890625, 36.24427318493909},
+                                                       {31.640625, 46.13417004624326},
+                                                       {17.841796875, 54.7246201949245},
+                                                       {5.09765625, 53.067626642387374},
+                                                   },
+                                                   {{19.6875, 49.66762782262194},
+                                                    {22.8515625, 43.51668853502906},
+                                                    {13.623046875, 45.089035564831036},
+                                                    {16.34765625, 39.095962936305476},
+                                                    {5.185546875, 41.244772343082076},
+                                                    {8.701171874999998, 50.233151832472245},
+                                                    {19.6875, 49.66762782262194}}},
+                                                  {{{59.150390625, 45.460130637921004},
+                                                    {65.126953125, 41.11246878918088},
+                                                    {69.169921875, 47.45780853075031},
+                                                    {63.896484375, 50.064191736659104},
+                                                    {59.150390625, 45.460130637921004}}}};
+    const auto lines = MultiLineString<double>{{{-122.5, 37.76}, {-122.4, 37.76}},
+                                               {{-122.5, 37.72}, {-122.4, 37.72}}};
+    const auto points = MultiPoint<double>{{-122.5, 37.76}, {-122.4, 37.72}, {2.35, 48.85}};
+
+    for (uint8_t z = 0; z <= 12; z++) {
+        EXPECT_EQ(util::tileCover(multiPolygon, z).size(), util::tileCount(multiPolygon, z));
+        EXPECT_EQ(util::tileCover(lines, z).size(), util::tileCount(lines, z));
+        EXPECT_EQ(util::tileCover(points, z).size(), util::tileCount(points, z));
+    }
+}
+
 TEST(TileCover, DISABLED_FuzzPoly) {
     while (true) {
         std::srand(static_cast<uint32_t>(time(nullptr)));